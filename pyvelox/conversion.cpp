@@ -15,6 +15,8 @@
  */
 
 #include "conversion.h"
+#include <pybind11/numpy.h>
+#include <velox/vector/FlatVector.h>
 #include <velox/vector/arrow/Abi.h>
 #include <velox/vector/arrow/Bridge.h>
 #include "context.h"
@@ -23,6 +25,124 @@ namespace facebook::velox::py {
 
 namespace py = pybind11;
 
+namespace {
+
+/// Keeps a Python object alive while a BufferView over its memory exists. The
+/// buffer may be released from a thread not holding the GIL.
+class PyObjectReleaser {
+ public:
+  explicit PyObjectReleaser(PyObject* object) : object_(object) {}
+
+  void addRef() const {
+    py::gil_scoped_acquire acquire;
+    Py_INCREF(object_);
+  }
+
+  void release() const {
+    py::gil_scoped_acquire acquire;
+    Py_DECREF(object_);
+  }
+
+ private:
+  PyObject* const object_;
+};
+
+template <typename T>
+bool hasDtype(const py::array& array) {
+  return array.dtype().equal(py::dtype::of<T>());
+}
+
+template <typename T>
+VectorPtr wrapNumpyArray(const py::array& array, const TypePtr& type) {
+  auto values = BufferView<PyObjectReleaser>::create(
+      reinterpret_cast<const uint8_t*>(array.data()),
+      array.size() * sizeof(T),
+      PyObjectReleaser(array.ptr()));
+  return std::make_shared<FlatVector<T>>(
+      PyVeloxContext::getSingletonInstance().pool(),
+      type,
+      nullptr,
+      array.size(),
+      std::move(values),
+      std::vector<BufferPtr>{});
+}
+
+/// Returns a flat vector over the memory of a one-dimensional, C-contiguous
+/// NumPy array of a native integer or floating point dtype without copying.
+VectorPtr importFromNumpy(const py::array& array) {
+  if (array.ndim() != 1 || !(array.flags() & py::array::c_style)) {
+    throw py::value_error(
+        "Only one-dimensional contiguous arrays are supported");
+  }
+  if (hasDtype<int8_t>(array)) {
+    return wrapNumpyArray<int8_t>(array, TINYINT());
+  }
+  if (hasDtype<int16_t>(array)) {
+    return wrapNumpyArray<int16_t>(array, SMALLINT());
+  }
+  if (hasDtype<int32_t>(array)) {
+    return wrapNumpyArray<int32_t>(array, INTEGER());
+  }
+  if (hasDtype<int64_t>(array)) {
+    return wrapNumpyArray<int64_t>(array, BIGINT());
+  }
+  if (hasDtype<float>(array)) {
+    return wrapNumpyArray<float>(array, REAL());
+  }
+  if (hasDtype<double>(array)) {
+    return wrapNumpyArray<double>(array, DOUBLE());
+  }
+  throw py::type_error(
+      "Unsupported dtype " + py::str(array.dtype()).cast<std::string>());
+}
+
+template <typename T>
+py::array viewAsNumpyArray(const VectorPtr& vector) {
+  // The capsule holds a reference to the vector for the lifetime of the
+  // returned array.
+  auto* holder = new VectorPtr(vector);
+  py::capsule base(
+      holder, [](void* p) { delete reinterpret_cast<VectorPtr*>(p); });
+  py::array_t<T> result(
+      {static_cast<py::ssize_t>(vector->size())},
+      {static_cast<py::ssize_t>(sizeof(T))},
+      vector->asUnchecked<FlatVector<T>>()->rawValues(),
+      base);
+  // The values may be shared with other vectors.
+  result.attr("setflags")(py::arg("write") = false);
+  return std::move(result);
+}
+
+/// Returns a read-only NumPy array over the values of a flat vector of an
+/// integer or floating point type without nulls without copying.
+py::array exportToNumpy(const VectorPtr& input) {
+  auto vector = BaseVector::loadedVectorShared(input);
+  if (!vector->isFlatEncoding()) {
+    throw py::value_error("Only flat vectors can be viewed as NumPy arrays");
+  }
+  if (vector->mayHaveNulls() &&
+      BaseVector::countNulls(vector->nulls(), vector->size()) > 0) {
+    throw py::value_error("Vectors with nulls can't be viewed as NumPy arrays");
+  }
+  switch (vector->typeKind()) {
+    case TypeKind::TINYINT:
+      return viewAsNumpyArray<int8_t>(vector);
+    case TypeKind::SMALLINT:
+      return viewAsNumpyArray<int16_t>(vector);
+    case TypeKind::INTEGER:
+      return viewAsNumpyArray<int32_t>(vector);
+    case TypeKind::BIGINT:
+      return viewAsNumpyArray<int64_t>(vector);
+    case TypeKind::REAL:
+      return viewAsNumpyArray<float>(vector);
+    case TypeKind::DOUBLE:
+      return viewAsNumpyArray<double>(vector);
+    default:
+      throw py::type_error("Unsupported type " + vector->type()->toString());
+  }
+}
+} // namespace
+
 void addConversionBindings(py::module& m, bool asModuleLocalDefinitions) {
   m.def("export_to_arrow", [](VectorPtr& inputVector) {
     auto arrowArray = std::make_unique<ArrowArray>();
@@ -48,5 +168,9 @@ void addConversionBindings(py::module& m, bool asModuleLocalDefinitions) {
     auto pool_ = PyVeloxContext::getSingletonInstance().pool();
     return importFromArrowAsOwner(*arrowSchema, *arrowArray, pool_);
   });
+
+  m.def("from_numpy", &importFromNumpy, py::arg("array"));
+
+  m.def("to_numpy", &exportToNumpy, py::arg("vector"));
 }
 } // namespace facebook::velox::py
@@ -12,6 +12,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import numpy as np
 import pyarrow as pa
 import pyvelox.pyvelox as pv
 import unittest
@@ -351,3 +352,45 @@ class TestVeloxVector(unittest.TestCase):
                 self.assertTrue(velox_vector.dtype(), expected_type)
                 for i in range(0, len(data)):
                     self.assertEqual(velox_vector[i], data[i])
+
+    def test_from_numpy(self):
+        test_cases = [
+            (np.int8, pv.TinyintType()),
+            (np.int32, pv.IntegerType()),
+            (np.int64, pv.BigintType()),
+            (np.float32, pv.RealType()),
+            (np.float64, pv.DoubleType()),
+        ]
+        for dtype, expected_type in test_cases:
+            with self.subTest(dtype=dtype):
+                array = np.arange(10, dtype=dtype)
+                vector = pv.from_numpy(array)
+                self.assertEqual(vector.size(), 10)
+                self.assertEqual(vector.dtype(), expected_type)
+                # The vector shares the memory of the array.
+                array[3] = 7
+                self.assertEqual(vector[3], 7)
+
+        # The vector keeps the array alive.
+        vector = pv.from_numpy(np.arange(5, dtype=np.int64))
+        self.assertListEqual([vector[i] for i in range(5)], [0, 1, 2, 3, 4])
+
+        with self.assertRaises(ValueError):
+            pv.from_numpy(np.arange(10, dtype=np.int64)[::2])
+        with self.assertRaises(TypeError):
+            pv.from_numpy(np.array([True, False]))
+
+    def test_to_numpy(self):
+        array = np.arange(10, dtype=np.int64)
+        result = pv.to_numpy(pv.from_numpy(array))
+        self.assertTrue(np.shares_memory(result, array))
+        self.assertFalse(result.flags.writeable)
+
+        result = pv.to_numpy(pv.from_list([1.5, 2.5]))
+        self.assertEqual(result.dtype, np.float64)
+        self.assertListEqual(result.tolist(), [1.5, 2.5])
+
+        with self.assertRaises(ValueError):
+            pv.to_numpy(pv.from_list([1, None, 3]))
+        with self.assertRaises(TypeError):
+            pv.to_numpy(pv.from_list(["a", "b"]))
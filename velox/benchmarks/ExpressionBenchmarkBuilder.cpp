@@ -88,10 +88,13 @@ void ExpressionBenchmarkBuilder::registerBenchmarks() {
       auto name = fmt::format("{}##{}", setName, exprName);
       auto& inputVector = benchmarkSet.inputRowVetor_;
       auto times = benchmarkSet.itterations_;
+      auto timePerRow = benchmarkSet.timePerRow_;
       // The compiler does not allow capturing exprSet int the lambda
       auto& exprSetLocal = exprSet;
       folly::addBenchmark(
-          __FILE__, name, [this, &inputVector, &exprSetLocal, times]() {
+          __FILE__,
+          name,
+          [this, &inputVector, &exprSetLocal, times, timePerRow]() {
             int cnt = 0;
             folly::BenchmarkSuspender suspender;
             // TODO: shall we cache those.
@@ -113,7 +116,7 @@ void ExpressionBenchmarkBuilder::registerBenchmarks() {
               cnt += results[0]->size();
             }
             folly::doNotOptimizeAway(cnt);
-            return 1;
+            return timePerRow ? cnt : 1;
           });
     }
     BENCHMARK_DRAW_LINE();
@@ -58,6 +58,13 @@ class ExpressionBenchmarkSet {
     return *this;
   }
 
+  // Reports the time per result row instead of the time for all the
+  // iterations.
+  ExpressionBenchmarkSet& withTimePerRow() {
+    timePerRow_ = true;
+    return *this;
+  }
+
  private:
   ExpressionBenchmarkSet(
       ExpressionBenchmarkBuilder& builder,
@@ -92,6 +99,8 @@ class ExpressionBenchmarkSet {
 
   bool disableTesting_ = false;
 
+  bool timePerRow_ = false;
+
   // The builder that this expression set belongs to.
   ExpressionBenchmarkBuilder& builder_;
   friend class ExpressionBenchmarkBuilder;
@@ -17,6 +17,7 @@
 #include <folly/Benchmark.h>
 #include <folly/init/Init.h>
 #include <gflags/gflags.h>
+#include <cmath>
 
 #include "velox/functions/Registerer.h"
 #include "velox/functions/lib/RegistrationHelpers.h"
@@ -45,6 +46,20 @@ struct PlusFunction {
   }
 };
 
+// A comparison that is much more expensive than the built in ones, e.g. like
+// a regular expression match.
+template <typename T>
+struct SlowGtFunction {
+  FOLLY_ALWAYS_INLINE void
+  call(bool& result, const double& a, const double& b) {
+    double x = a;
+    for (auto i = 0; i < 50; ++i) {
+      x = std::sqrt(x * x + 1);
+    }
+    result = x > b;
+  }
+};
+
 class ComparisonBenchmark : public functions::test::FunctionBenchmarkBase {
  public:
   explicit ComparisonBenchmark(size_t vectorSize) : FunctionBenchmarkBase() {
@@ -55,6 +70,7 @@ class ComparisonBenchmark : public functions::test::FunctionBenchmarkBase {
     registerBinaryScalar<LteFunction, bool>({"lte"});
     registerBinaryScalar<GteFunction, bool>({"gte"});
     registerFunction<BetweenFunction, bool, double, double, double>({"btw"});
+    registerFunction<SlowGtFunction, bool, double, double>({"slow_gt"});
 
     // Use it as a baseline.
     registerFunction<PlusFunction, double, double, double>({"plus"});
@@ -109,6 +125,31 @@ class ComparisonBenchmark : public functions::test::FunctionBenchmarkBase {
     return count;
   }
 
+  // Runs `expression` `times` times with adaptive conjunct reordering on or
+  // off, compiling a new ExprSet every `batchesPerExprSet` times like the
+  // drivers and splits of a query do.
+  size_t runReorder(
+      const std::string& expression,
+      bool reorder,
+      size_t batchesPerExprSet,
+      size_t times = 100) {
+    folly::BenchmarkSuspender suspender;
+    queryCtx_->testingOverrideConfigUnsafe(
+        {{core::QueryConfig::kAdaptiveFilterReorderingEnabled,
+          reorder ? "true" : "false"}});
+    SelectivityVector rows(rowVector_->size());
+    size_t count = 0;
+    for (auto i = 0; i < times; i += batchesPerExprSet) {
+      auto exprSet = compileExpression(expression, inputType_);
+      suspender.dismiss();
+      for (auto j = 0; j < batchesPerExprSet; ++j) {
+        count += evaluate(exprSet, rowVector_, rows)->size();
+      }
+      suspender.rehire();
+    }
+    return count;
+  }
+
  private:
   TypePtr inputType_;
   RowVectorPtr rowVector_;
@@ -172,6 +213,24 @@ BENCHMARK(conjunctsNested) {
   benchmark->run("(d OR e) AND ((d AND (neq(d, (d OR e)))) OR (eq(a, b)))");
 }
 
+BENCHMARK_DRAW_LINE();
+
+// An expensive predicate written before a cheap one that drops almost all
+// rows.
+BENCHMARK(mixedConjunctNoReorder) {
+  benchmark->runReorder("slow_gt(a, b) AND eq(a, c)", false, 100);
+}
+
+BENCHMARK_RELATIVE(mixedConjunctReorder) {
+  benchmark->runReorder("slow_gt(a, b) AND eq(a, c)", true, 100);
+}
+
+// A new ExprSet for every batch starts with the order learned by the earlier
+// ones.
+BENCHMARK_RELATIVE(mixedConjunctReorderNewExprSets) {
+  benchmark->runReorder("slow_gt(a, b) AND eq(a, c)", true, 1);
+}
+
 } // namespace
 
 int main(int argc, char* argv[]) {
@@ -18,6 +18,7 @@
 #include <folly/init/Init.h>
 #include <gflags/gflags.h>
 
+#include "velox/expression/EvalCtx.h"
 #include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
 #include "velox/vector/DecodedVector.h"
 #include "velox/vector/fuzzer/VectorFuzzer.h"
@@ -48,6 +49,10 @@ class DecodedVectorBenchmark : public functions::test::FunctionBenchmarkBase {
     for (size_t i = 0; i < 5; ++i) {
       dictionaryNestedVector_ = fuzzer.fuzzDictionary(dictionaryNestedVector_);
     }
+
+    data_ = vectorMaker_.rowVector({dictionaryNestedVector_});
+    exprSet_ = std::make_unique<ExprSet>(
+        compileExpression("c0", asRowType(data_->type())));
   }
 
   // Runs a fast path over a flat vector (no decoding).
@@ -118,6 +123,26 @@ class DecodedVectorBenchmark : public functions::test::FunctionBenchmarkBase {
     DecodedVector decodedVector(*dictionaryNestedVector_, rows_);
   }
 
+  // Measure time to decode a 5-way nested dictionary vector once for each of
+  // 'numExprs' expressions reading it, without sharing the decoded vectors.
+  void decodeDictionary5NestedPerExpr(int32_t numExprs) {
+    EvalCtx context(&execCtx_);
+    for (auto i = 0; i < numExprs; ++i) {
+      LocalDecodedVector decoded(context, *dictionaryNestedVector_, rows_);
+      folly::doNotOptimizeAway(decoded->indices());
+    }
+  }
+
+  // Same as above but with an EvalCtx over an input row with the vector as a
+  // column, which decodes it once and shares the result.
+  void decodeDictionary5NestedCached(int32_t numExprs) {
+    EvalCtx context(&execCtx_, exprSet_.get(), data_.get());
+    for (auto i = 0; i < numExprs; ++i) {
+      LocalDecodedVector decoded(context, *dictionaryNestedVector_, rows_);
+      folly::doNotOptimizeAway(decoded->indices());
+    }
+  }
+
  private:
   void decodedRun(const DecodedVector& decodedVector) {
     size_t sum = 0;
@@ -134,6 +159,9 @@ class DecodedVectorBenchmark : public functions::test::FunctionBenchmarkBase {
   VectorPtr dictionaryVector_;
   VectorPtr dictionaryNestedVector_;
 
+  RowVectorPtr data_;
+  std::unique_ptr<ExprSet> exprSet_;
+
   SelectivityVector rows_;
 };
 
@@ -185,6 +213,17 @@ BENCHMARK(decodeDictionary5Nested) {
   run([&] { benchmark->decodeDictionary5Nested(); });
 }
 
+BENCHMARK_DRAW_LINE();
+
+// Decodes the same input column for 10 expressions of a batch.
+BENCHMARK(decodeDictionary5NestedPerExpr) {
+  run([&] { benchmark->decodeDictionary5NestedPerExpr(10); });
+}
+
+BENCHMARK_RELATIVE(decodeDictionary5NestedCached) {
+  run([&] { benchmark->decodeDictionary5NestedCached(10); });
+}
+
 } // namespace
 
 int main(int argc, char* argv[]) {
@@ -0,0 +1,278 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Benchmarks every registered scalar and aggregate function signature that
+// has concrete primitive argument types, on fuzzed inputs of each of the
+// encodings in --encodings. Reports the time per row in JSON for tracking the
+// trends, e.g.:
+//
+//   velox_benchmark_basic_registered_functions --only "substr,lower"
+//       --null_ratio 0.5 --string_length 100 --encodings flat
+//
+// The benchmark names are <encoding>_<signature>##<function>. Pass
+// --json=false for the usual table output.
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include <gflags/gflags.h>
+
+#include "velox/benchmarks/ExpressionBenchmarkBuilder.h"
+#include "velox/exec/Aggregate.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/expression/SignatureBinder.h"
+#include "velox/functions/FunctionRegistry.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+
+DEFINE_string(
+    only,
+    "",
+    "Comma-separated list of the functions to benchmark. All the registered "
+    "functions are benchmarked if empty (e.g: --only \"substr,lower\").");
+
+DEFINE_bool(aggregates, true, "Benchmark the aggregate functions too");
+
+DEFINE_string(
+    encodings,
+    "flat,dictionary,constant",
+    "Comma-separated list of the encodings of the fuzzed inputs");
+
+DEFINE_int32(batch_size, 1'000, "Number of rows in a fuzzed input vector");
+
+DEFINE_int32(iterations, 100, "Number of input vectors per benchmark run");
+
+DEFINE_double(null_ratio, 0.1, "Chance of a null value in the fuzzed inputs");
+
+DEFINE_int32(string_length, 20, "Maximum length of the fuzzed strings");
+
+DEFINE_int64(fuzzer_seed, 99887766, "Seed for random input dataset generator");
+
+using namespace facebook::velox;
+
+namespace {
+
+std::unordered_set<std::string> splitNames(const std::string& names) {
+  std::vector<std::string> split;
+  folly::split(',', names, split, true);
+  return {split.begin(), split.end()};
+}
+
+VectorFuzzer::Options fuzzerOptions() {
+  VectorFuzzer::Options options;
+  options.vectorSize = FLAGS_batch_size;
+  options.nullRatio = FLAGS_null_ratio;
+  options.stringLength = FLAGS_string_length;
+  options.stringVariableLength = true;
+  return options;
+}
+
+// Returns the argument types of 'signature' if these are concrete primitive
+// types. Signatures with type variables or constant arguments are not
+// benchmarked.
+std::optional<std::vector<TypePtr>> argumentTypes(
+    const exec::FunctionSignature& signature) {
+  if (!signature.variables().empty()) {
+    return std::nullopt;
+  }
+  std::vector<TypePtr> types;
+  for (auto i = 0; i < signature.argumentTypes().size(); ++i) {
+    if (signature.constantArguments()[i]) {
+      return std::nullopt;
+    }
+    auto type = exec::SignatureBinder::tryResolveType(
+        signature.argumentTypes()[i], {}, {});
+    if (!type || !type->isPrimitiveType() ||
+        type->kind() == TypeKind::UNKNOWN) {
+      return std::nullopt;
+    }
+    types.push_back(std::move(type));
+  }
+  return types;
+}
+
+std::string signatureName(
+    const std::string& name,
+    const std::vector<TypePtr>& types) {
+  std::vector<std::string> typeNames;
+  for (auto& type : types) {
+    typeNames.push_back(type->toString());
+  }
+  return fmt::format("{}({})", name, folly::join(", ", typeNames));
+}
+
+// Returns a call of 'name' on the columns of a row of 'numArgs' columns.
+std::string callExpression(const std::string& name, int32_t numArgs) {
+  std::vector<std::string> columns;
+  for (auto i = 0; i < numArgs; ++i) {
+    columns.push_back(fmt::format("c{}", i));
+  }
+  return fmt::format("{}({})", name, folly::join(", ", columns));
+}
+
+RowVectorPtr fuzzInput(
+    VectorFuzzer& fuzzer,
+    test::VectorMaker& vectorMaker,
+    const std::vector<TypePtr>& types,
+    const std::string& encoding) {
+  std::vector<VectorPtr> children;
+  for (auto& type : types) {
+    if (encoding == "flat") {
+      children.push_back(fuzzer.fuzzFlat(type));
+    } else if (encoding == "dictionary") {
+      children.push_back(fuzzer.fuzzDictionary(fuzzer.fuzzFlat(type)));
+    } else if (encoding == "constant") {
+      children.push_back(fuzzer.fuzzConstant(type));
+    } else {
+      VELOX_USER_FAIL("Unsupported encoding: {}", encoding);
+    }
+  }
+  return vectorMaker.rowVector(children);
+}
+
+// Returns the names in 'signatures' that pass --only, in order.
+template <typename SignatureMap>
+std::vector<std::string> functionNames(const SignatureMap& signatures) {
+  const auto only = splitNames(FLAGS_only);
+  std::vector<std::string> names;
+  for (auto& [name, _] : signatures) {
+    if (only.empty() || only.count(name)) {
+      names.push_back(name);
+    }
+  }
+  std::sort(names.begin(), names.end());
+  return names;
+}
+
+// Adds a benchmark set for each scalar function signature and encoding.
+// Functions that fail on the fuzzed input are benchmarked inside try() and
+// are skipped if they still fail.
+void addScalarBenchmarks(
+    ExpressionBenchmarkBuilder& builder,
+    const std::vector<std::string>& encodings) {
+  VectorFuzzer fuzzer(fuzzerOptions(), builder.pool(), FLAGS_fuzzer_seed);
+  auto signatureMap = getFunctionSignatures();
+  std::unordered_set<std::string> setNames;
+  for (auto& name : functionNames(signatureMap)) {
+    for (auto* signature : signatureMap[name]) {
+      auto types = argumentTypes(*signature);
+      if (!types.has_value()) {
+        continue;
+      }
+      for (auto& encoding : encodings) {
+        auto setName =
+            fmt::format("{}_{}", encoding, signatureName(name, *types));
+        if (!setNames.insert(setName).second) {
+          continue;
+        }
+        auto input =
+            fuzzInput(fuzzer, builder.vectorMaker(), *types, encoding);
+        auto call = callExpression(name, types->size());
+        std::optional<std::string> expression;
+        for (auto& candidate : {call, fmt::format("try({})", call)}) {
+          try {
+            auto exprSet = builder.compileExpression(candidate, input->type());
+            builder.evaluate(exprSet, input);
+            expression = candidate;
+            break;
+          } catch (const std::exception& e) {
+            VLOG(1) << "Cannot evaluate " << candidate << ": " << e.what();
+          }
+        }
+        if (!expression.has_value()) {
+          LOG(WARNING) << "Skipping " << setName;
+          continue;
+        }
+        builder.addBenchmarkSet(setName, input)
+            .addExpression(name, expression.value())
+            .withIterations(FLAGS_iterations)
+            .withTimePerRow()
+            .disableTesting();
+      }
+    }
+  }
+}
+
+// Adds a benchmark of a global aggregation over --iterations input vectors
+// for each aggregate function signature and encoding.
+void addAggregateBenchmarks(
+    memory::MemoryPool* pool,
+    test::VectorMaker& vectorMaker,
+    const std::vector<std::string>& encodings) {
+  VectorFuzzer fuzzer(fuzzerOptions(), pool, FLAGS_fuzzer_seed);
+  auto signatureMap = exec::getAggregateFunctionSignatures();
+  for (auto& name : functionNames(signatureMap)) {
+    std::unordered_set<std::string> benchmarkNames;
+    for (auto& signature : signatureMap[name]) {
+      auto types = argumentTypes(*signature);
+      if (!types.has_value()) {
+        continue;
+      }
+      for (auto& encoding : encodings) {
+        auto benchmarkName = fmt::format(
+            "{}_{}##{}", encoding, signatureName(name, *types), name);
+        if (!benchmarkNames.insert(benchmarkName).second) {
+          continue;
+        }
+        auto input = fuzzInput(fuzzer, vectorMaker, *types, encoding);
+        auto plan = exec::test::PlanBuilder()
+                        .values(std::vector<RowVectorPtr>(
+                            FLAGS_iterations, std::move(input)))
+                        .singleAggregation(
+                            {}, {callExpression(name, types->size())})
+                        .planNode();
+        try {
+          exec::test::AssertQueryBuilder(plan).copyResults(pool);
+        } catch (const std::exception& e) {
+          LOG(WARNING) << "Skipping " << benchmarkName << ": " << e.what();
+          continue;
+        }
+        const unsigned numRows = FLAGS_iterations * FLAGS_batch_size;
+        folly::addBenchmark(__FILE__, benchmarkName, [plan, pool, numRows]() {
+          auto result = exec::test::AssertQueryBuilder(plan).copyResults(pool);
+          folly::doNotOptimizeAway(result);
+          return numRows;
+        });
+      }
+    }
+  }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  gflags::SetCommandLineOptionWithMode(
+      "json", "true", gflags::SET_FLAGS_DEFAULT);
+  folly::Init init(&argc, &argv);
+
+  functions::prestosql::registerAllScalarFunctions();
+  aggregate::prestosql::registerAllAggregateFunctions();
+
+  std::vector<std::string> encodings;
+  folly::split(',', FLAGS_encodings, encodings, true);
+
+  ExpressionBenchmarkBuilder benchmarkBuilder;
+  addScalarBenchmarks(benchmarkBuilder, encodings);
+  benchmarkBuilder.registerBenchmarks();
+  if (FLAGS_aggregates) {
+    addAggregateBenchmarks(
+        benchmarkBuilder.pool(), benchmarkBuilder.vectorMaker(), encodings);
+  }
+
+  folly::runBenchmarks();
+  return 0;
+}
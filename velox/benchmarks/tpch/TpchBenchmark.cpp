@@ -19,7 +19,9 @@
 #include <sys/time.h>
 
 #include <folly/Benchmark.h>
+#include <folly/String.h>
 #include <folly/init/Init.h>
+#include <folly/json.h>
 #include <gflags/gflags.h>
 #include <sys/stat.h>
 #include <sys/types.h>
@@ -34,9 +36,11 @@
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/Split.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
+#include "velox/exec/tests/utils/TpcdsQueryBuilder.h"
 #include "velox/exec/tests/utils/TpchQueryBuilder.h"
 #include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
 #include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/functions/prestosql/window/WindowFunctionsRegistration.h"
 #include "velox/parse/TypeResolver.h"
 
 using namespace facebook::velox;
@@ -162,6 +166,38 @@ DEFINE_bool(
     "Runs one warmup of the query before "
     "measured run. Use to run warm after clearing caches.");
 
+DEFINE_string(
+    json_report,
+    "",
+    "If set, runs each query in --json_queries and writes its wall time, CPU "
+    "time, peak memory, spilled bytes, cache hit rate and CPU time per "
+    "operator to this file as JSON. The caches are cleared and warmed up "
+    "before each query as set by --clear_ram_cache, --clear_ssd_cache and "
+    "--warmup_after_clear");
+DEFINE_string(
+    json_queries,
+    "",
+    "Comma separated query numbers to run with --json_report. Runs all "
+    "the queries of the benchmark if empty");
+DEFINE_string(
+    json_baseline,
+    "",
+    "JSON report of an earlier run to compare --json_report with. The "
+    "benchmark exits with 1 if a query regresses by more than the "
+    "thresholds below");
+DEFINE_double(
+    wall_regression_pct,
+    10,
+    "Percentage of wall time over the baseline that is a regression");
+DEFINE_double(
+    cpu_regression_pct,
+    10,
+    "Percentage of CPU time over the baseline that is a regression");
+DEFINE_double(
+    memory_regression_pct,
+    20,
+    "Percentage of peak memory over the baseline that is a regression");
+
 DEFINE_validator(data_path, &notEmpty);
 DEFINE_validator(data_format, &validateDataFormat);
 
@@ -207,6 +243,19 @@ struct ParameterDim {
 };
 
 std::shared_ptr<TpchQueryBuilder> queryBuilder;
+// Set instead of 'queryBuilder' when running TPC-DS.
+std::shared_ptr<TpcdsQueryBuilder> tpcdsQueryBuilder;
+
+TpchPlan getQueryPlan(int32_t queryId) {
+  return tpcdsQueryBuilder ? tpcdsQueryBuilder->getQueryPlan(queryId)
+                           : queryBuilder->getQueryPlan(queryId);
+}
+
+const std::vector<int32_t>& getQueryIds() {
+  static const std::vector<int32_t> kTpchQueryIds = {
+      1, 3, 5, 6, 7, 8, 9, 10, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22};
+  return tpcdsQueryBuilder ? TpcdsQueryBuilder::getQueryIds() : kTpchQueryIds;
+}
 
 class TpchBenchmark {
  public:
@@ -238,6 +287,7 @@ class TpchBenchmark {
     }
     functions::prestosql::registerAllScalarFunctions();
     aggregate::prestosql::registerAllAggregateFunctions();
+    window::prestosql::registerAllWindowFunctions();
     parse::registerTypeResolver();
     filesystems::registerLocalFileSystem();
 
@@ -309,9 +359,12 @@ class TpchBenchmark {
     if (FLAGS_run_query_verbose == -1 && FLAGS_io_meter_column_pct == 0) {
       folly::runBenchmarks();
     } else {
+      VELOX_USER_CHECK(
+          FLAGS_io_meter_column_pct == 0 || queryBuilder,
+          "--io_meter_column_pct is only supported for TPC-H");
       const auto queryPlan = FLAGS_io_meter_column_pct > 0
           ? queryBuilder->getIoMeterPlan(FLAGS_io_meter_column_pct)
-          : queryBuilder->getQueryPlan(FLAGS_run_query_verbose);
+          : getQueryPlan(FLAGS_run_query_verbose);
       auto [cursor, actualResults] = run(queryPlan);
       if (!cursor) {
         LOG(ERROR) << "Query terminated with error. Exiting";
@@ -371,34 +424,38 @@ class TpchBenchmark {
     }
   }
 
-  void runCombinations(int32_t level) {
-    if (level == parameters_.size()) {
-      if (FLAGS_clear_ram_cache) {
+  void clearCaches() {
+    if (FLAGS_clear_ram_cache) {
 #ifdef linux
-        // system("echo 3 >/proc/sys/vm/drop_caches");
-        bool success = false;
-        auto fd = open("/proc//sys/vm/drop_caches", O_WRONLY);
-        if (fd > 0) {
-          success = write(fd, "3", 1) == 1;
-          close(fd);
-        }
-        if (!success) {
-          LOG(ERROR) << "Failed to clear OS disk cache: errno=" << errno;
-        }
+      // system("echo 3 >/proc/sys/vm/drop_caches");
+      bool success = false;
+      auto fd = open("/proc//sys/vm/drop_caches", O_WRONLY);
+      if (fd > 0) {
+        success = write(fd, "3", 1) == 1;
+        close(fd);
+      }
+      if (!success) {
+        LOG(ERROR) << "Failed to clear OS disk cache: errno=" << errno;
+      }
 #endif
 
-        if (cache_) {
-          cache_->clear();
-        }
+      if (cache_) {
+        cache_->clear();
       }
-      if (FLAGS_clear_ssd_cache) {
-        if (cache_) {
-          auto ssdCache = cache_->ssdCache();
-          if (ssdCache) {
-            ssdCache->clear();
-          }
+    }
+    if (FLAGS_clear_ssd_cache) {
+      if (cache_) {
+        auto ssdCache = cache_->ssdCache();
+        if (ssdCache) {
+          ssdCache->clear();
         }
       }
+    }
+  }
+
+  void runCombinations(int32_t level) {
+    if (level == parameters_.size()) {
+      clearCaches();
       if (FLAGS_warmup_after_clear) {
         std::stringstream result;
         RunStats ignore;
@@ -462,6 +519,158 @@ class TpchBenchmark {
     }
   }
 
+  // Runs each query in --json_queries, writes their stats to --json_report
+  // and returns the number of regressions against --json_baseline.
+  int32_t runJsonReport() {
+    std::vector<int32_t> queryIds;
+    if (FLAGS_json_queries.empty()) {
+      queryIds = getQueryIds();
+    } else {
+      folly::split(',', FLAGS_json_queries, queryIds, true);
+    }
+    folly::dynamic report = folly::dynamic::object;
+    for (auto queryId : queryIds) {
+      report[fmt::format("q{}", queryId)] = runQueryJson(queryId);
+    }
+    {
+      std::ofstream out(FLAGS_json_report);
+      VELOX_CHECK(out.good(), "Cannot open {}", FLAGS_json_report);
+      out << folly::toPrettyJson(report) << std::endl;
+    }
+    if (FLAGS_json_baseline.empty()) {
+      return 0;
+    }
+    return compareWithBaseline(report);
+  }
+
+  folly::dynamic runQueryJson(int32_t queryId) {
+    clearCaches();
+    const auto queryPlan = getQueryPlan(queryId);
+    if (FLAGS_warmup_after_clear) {
+      run(queryPlan);
+    }
+    struct rusage start;
+    getrusage(RUSAGE_SELF, &start);
+    uint64_t micros = 0;
+    std::unique_ptr<TaskCursor> cursor;
+    {
+      MicrosecondTimer timer(&micros);
+      cursor = run(queryPlan).first;
+    }
+    struct rusage final;
+    getrusage(RUSAGE_SELF, &final);
+
+    folly::dynamic result = folly::dynamic::object;
+    if (!cursor) {
+      result["error"] = true;
+      return result;
+    }
+    auto tvNanos = [](struct timeval tv) {
+      return tv.tv_sec * 1000000000 + tv.tv_usec * 1000;
+    };
+    // Wall and process CPU time are averaged over --num_repeats, the other
+    // stats are of the last repeat.
+    result["wallMicros"] = micros / FLAGS_num_repeats;
+    result["processCpuNanos"] =
+        (tvNanos(final.ru_utime) - tvNanos(start.ru_utime) +
+         tvNanos(final.ru_stime) - tvNanos(start.ru_stime)) /
+        FLAGS_num_repeats;
+
+    auto task = cursor->task();
+    const auto stats = task->taskStats();
+    int64_t cpuNanos = 0;
+    int64_t spilledBytes = 0;
+    folly::dynamic operatorCpuNanos = folly::dynamic::object;
+    for (const auto& [nodeId, nodeStats] : toPlanStats(stats)) {
+      cpuNanos += nodeStats.cpuWallTiming.cpuNanos;
+      spilledBytes += nodeStats.spilledBytes;
+      for (const auto& [operatorType, operatorStats] :
+           nodeStats.operatorStats) {
+        operatorCpuNanos[fmt::format("{}.{}", nodeId, operatorType)] =
+            operatorStats->cpuWallTiming.cpuNanos;
+      }
+    }
+    result["cpuNanos"] = cpuNanos;
+    result["peakMemoryBytes"] = task->pool()->peakBytes();
+    result["spilledBytes"] = spilledBytes;
+
+    // The scans report how many bytes came from the RAM and SSD caches and
+    // how many from storage.
+    int64_t ramBytes = 0;
+    int64_t ssdBytes = 0;
+    int64_t storageBytes = 0;
+    auto addReadBytes = [](const OperatorStats& operatorStats,
+                           const std::string& name,
+                           int64_t& bytes) {
+      auto it = operatorStats.runtimeStats.find(name);
+      if (it != operatorStats.runtimeStats.end()) {
+        bytes += it->second.sum;
+      }
+    };
+    for (const auto& pipeline : stats.pipelineStats) {
+      for (const auto& operatorStats : pipeline.operatorStats) {
+        addReadBytes(operatorStats, "ramReadBytes", ramBytes);
+        addReadBytes(operatorStats, "localReadBytes", ssdBytes);
+        addReadBytes(operatorStats, "storageReadBytes", storageBytes);
+      }
+    }
+    const auto readBytes = ramBytes + ssdBytes + storageBytes;
+    result["ramReadBytes"] = ramBytes;
+    result["ssdReadBytes"] = ssdBytes;
+    result["storageReadBytes"] = storageBytes;
+    result["cacheHitRate"] =
+        readBytes == 0 ? 0.0 : (ramBytes + ssdBytes) / (double)readBytes;
+    result["operatorCpuNanos"] = std::move(operatorCpuNanos);
+    return result;
+  }
+
+  // Prints the wall time, CPU time and peak memory of each query in 'report'
+  // next to the ones in --json_baseline and returns the number of these that
+  // exceed the baseline by more than their threshold.
+  int32_t compareWithBaseline(const folly::dynamic& report) {
+    std::ifstream in(FLAGS_json_baseline);
+    VELOX_CHECK(in.good(), "Cannot open {}", FLAGS_json_baseline);
+    std::stringstream json;
+    json << in.rdbuf();
+    const auto baseline = folly::parseJson(json.str());
+
+    int32_t numRegressions = 0;
+    for (const auto& [query, stats] : report.items()) {
+      const auto* baselineStats = baseline.get_ptr(query);
+      if (!baselineStats || stats.count("error") ||
+          baselineStats->count("error")) {
+        std::cout << query.asString() << ": no baseline to compare with"
+                  << std::endl;
+        continue;
+      }
+      auto compare = [&](const char* name, double thresholdPct) {
+        const auto* baselineValue = baselineStats->get_ptr(name);
+        if (!baselineValue || baselineValue->asDouble() <= 0) {
+          return;
+        }
+        const auto value = stats.at(name).asDouble();
+        const auto changePct = 100 * (value / baselineValue->asDouble() - 1);
+        const bool regressed = changePct > thresholdPct;
+        std::cout << fmt::format(
+                         "{} {}: {} vs {} ({:+.1f}%){}",
+                         query.asString(),
+                         name,
+                         value,
+                         baselineValue->asDouble(),
+                         changePct,
+                         regressed ? " REGRESSION" : "")
+                  << std::endl;
+        numRegressions += regressed;
+      };
+      compare("wallMicros", FLAGS_wall_regression_pct);
+      compare("cpuNanos", FLAGS_cpu_regression_pct);
+      compare("peakMemoryBytes", FLAGS_memory_regression_pct);
+    }
+    std::cout << numRegressions << " regression(s) against "
+              << FLAGS_json_baseline << std::endl;
+    return numRegressions;
+  }
+
   std::unique_ptr<folly::IOThreadPoolExecutor> ioExecutor_;
   std::unique_ptr<folly::IOThreadPoolExecutor> cacheExecutor_;
   std::shared_ptr<memory::MemoryAllocator> allocator_;
@@ -475,107 +684,28 @@ class TpchBenchmark {
 
 TpchBenchmark benchmark;
 
-BENCHMARK(q1) {
-  const auto planContext = queryBuilder->getQueryPlan(1);
-  benchmark.run(planContext);
-}
-
-BENCHMARK(q3) {
-  const auto planContext = queryBuilder->getQueryPlan(3);
-  benchmark.run(planContext);
-}
-
-BENCHMARK(q5) {
-  const auto planContext = queryBuilder->getQueryPlan(5);
-  benchmark.run(planContext);
-}
-
-BENCHMARK(q6) {
-  const auto planContext = queryBuilder->getQueryPlan(6);
-  benchmark.run(planContext);
-}
-
-BENCHMARK(q7) {
-  const auto planContext = queryBuilder->getQueryPlan(7);
-  benchmark.run(planContext);
-}
-
-BENCHMARK(q8) {
-  const auto planContext = queryBuilder->getQueryPlan(8);
-  benchmark.run(planContext);
-}
-
-BENCHMARK(q9) {
-  const auto planContext = queryBuilder->getQueryPlan(9);
-  benchmark.run(planContext);
-}
-
-BENCHMARK(q10) {
-  const auto planContext = queryBuilder->getQueryPlan(10);
-  benchmark.run(planContext);
-}
-
-BENCHMARK(q12) {
-  const auto planContext = queryBuilder->getQueryPlan(12);
-  benchmark.run(planContext);
-}
-
-BENCHMARK(q13) {
-  const auto planContext = queryBuilder->getQueryPlan(13);
-  benchmark.run(planContext);
-}
-
-BENCHMARK(q14) {
-  const auto planContext = queryBuilder->getQueryPlan(14);
-  benchmark.run(planContext);
-}
-
-BENCHMARK(q15) {
-  const auto planContext = queryBuilder->getQueryPlan(15);
-  benchmark.run(planContext);
-}
-
-BENCHMARK(q16) {
-  const auto planContext = queryBuilder->getQueryPlan(16);
-  benchmark.run(planContext);
-}
-
-BENCHMARK(q17) {
-  const auto planContext = queryBuilder->getQueryPlan(17);
-  benchmark.run(planContext);
-}
-
-BENCHMARK(q18) {
-  const auto planContext = queryBuilder->getQueryPlan(18);
-  benchmark.run(planContext);
-}
-
-BENCHMARK(q19) {
-  const auto planContext = queryBuilder->getQueryPlan(19);
-  benchmark.run(planContext);
-}
-
-BENCHMARK(q20) {
-  const auto planContext = queryBuilder->getQueryPlan(20);
-  benchmark.run(planContext);
-}
-
-BENCHMARK(q21) {
-  const auto planContext = queryBuilder->getQueryPlan(21);
-  benchmark.run(planContext);
-}
-
-BENCHMARK(q22) {
-  const auto planContext = queryBuilder->getQueryPlan(22);
-  benchmark.run(planContext);
-}
-
-int tpchBenchmarkMain() {
+namespace {
+int benchmarkMain(bool tpcds) {
   benchmark.initialize();
-  queryBuilder =
-      std::make_shared<TpchQueryBuilder>(toFileFormat(FLAGS_data_format));
-  queryBuilder->initialize(FLAGS_data_path);
-  if (FLAGS_test_flags_file.empty()) {
+  if (tpcds) {
+    tpcdsQueryBuilder =
+        std::make_shared<TpcdsQueryBuilder>(toFileFormat(FLAGS_data_format));
+    tpcdsQueryBuilder->initialize(FLAGS_data_path);
+  } else {
+    queryBuilder =
+        std::make_shared<TpchQueryBuilder>(toFileFormat(FLAGS_data_format));
+    queryBuilder->initialize(FLAGS_data_path);
+  }
+  for (auto queryId : getQueryIds()) {
+    folly::addBenchmark(__FILE__, fmt::format("q{}", queryId), [queryId]() {
+      benchmark.run(getQueryPlan(queryId));
+      return 1;
+    });
+  }
+  int32_t numRegressions = 0;
+  if (!FLAGS_json_report.empty()) {
+    numRegressions = benchmark.runJsonReport();
+  } else if (FLAGS_test_flags_file.empty()) {
     RunStats ignore;
     benchmark.runMain(std::cout, ignore);
   } else {
@@ -583,5 +713,15 @@ int tpchBenchmarkMain() {
   }
   benchmark.shutdown();
   queryBuilder.reset();
-  return 0;
+  tpcdsQueryBuilder.reset();
+  return numRegressions > 0 ? 1 : 0;
+}
+} // namespace
+
+int tpchBenchmarkMain() {
+  return benchmarkMain(false);
+}
+
+int tpcdsBenchmarkMain() {
+  return benchmarkMain(true);
 }
@@ -15,4 +15,7 @@
  */
 #pragma once
 
-void tpchBenchmarkMain();
+int tpchBenchmarkMain();
+
+/// Runs the TPC-DS queries of TpcdsQueryBuilder with the same flags.
+int tpcdsBenchmarkMain();
@@ -34,6 +34,8 @@ DEFINE_int64(
     5,
     "Specifies memory free for every N operations. If it is 5, then we free one of existing memory allocation for every 5 memory operations");
 
+DECLARE_int32(velox_memory_pool_slab_cache_kb);
+
 using namespace facebook::velox;
 using namespace facebook::velox::memory;
 
@@ -50,8 +52,11 @@ class MemoryPoolAllocationBenchMark {
       Type type,
       uint16_t alignment,
       size_t minSize,
-      size_t maxSize)
+      size_t maxSize,
+      bool slabCache = false)
       : type_(type), minSize_(minSize), maxSize_(maxSize) {
+    gflags::FlagSaver flagSaver;
+    FLAGS_velox_memory_pool_slab_cache_kb = slabCache ? 1 << 10 : 0;
     switch (type_) {
       case Type::kMmap:
         manager_ = std::make_shared<MemoryManager>(
@@ -202,6 +207,16 @@ BENCHMARK_RELATIVE_MULTI(MmapAllocateSmallNoAlignment) {
   return benchmark.runAllocate();
 }
 
+BENCHMARK_RELATIVE_MULTI(StdAllocateSmallSlabCache) {
+  MemoryPoolAllocationBenchMark benchmark(Type::kStd, 16, 128, 3072, true);
+  return benchmark.runAllocate();
+}
+
+BENCHMARK_RELATIVE_MULTI(MmapAllocateSmallSlabCache) {
+  MemoryPoolAllocationBenchMark benchmark(Type::kMmap, 16, 128, 3072, true);
+  return benchmark.runAllocate();
+}
+
 BENCHMARK_MULTI(StdAllocateSmall64) {
   MemoryPoolAllocationBenchMark benchmark(Type::kStd, 64, 128, 3072);
   return benchmark.runAllocate();
@@ -363,6 +378,11 @@ BENCHMARK_RELATIVE_MULTI(MmapReallocateSmallNoAlignment) {
   return benchmark.runReallocate();
 }
 
+BENCHMARK_RELATIVE_MULTI(StdReallocateSmallSlabCache) {
+  MemoryPoolAllocationBenchMark benchmark(Type::kStd, 16, 128, 3072, true);
+  return benchmark.runReallocate();
+}
+
 BENCHMARK_MULTI(StdReallocateSmall64) {
   MemoryPoolAllocationBenchMark benchmark(Type::kStd, 64, 128, 3072);
   return benchmark.runReallocate();
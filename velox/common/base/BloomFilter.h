@@ -61,6 +61,19 @@ class BloomFilter {
     return test(bits_.data(), bits_.size(), value);
   }
 
+  // Returns true if 'value' may be in a filter consisting of the 'bloomSize'
+  // words at 'bloom', e.g. the words returned by bits() of another filter.
+  // 'bloomSize' must be a power of 2.
+  static bool
+  mayContain(const uint64_t* bloom, int32_t bloomSize, uint64_t value) {
+    return test(bloom, bloomSize, value);
+  }
+
+  // Returns the words of the filter. The size is a power of 2.
+  const std::vector<uint64_t, Allocator>& bits() const {
+    return bits_;
+  }
+
   void merge(const char* serialized) {
     common::InputByteStream stream(serialized);
     auto version = stream.read<int8_t>();
@@ -20,6 +20,7 @@
 #include <string>
 #include "folly/Likely.h"
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/base/Status.h"
 
 namespace facebook::velox {
 
@@ -53,33 +54,61 @@ T checkedMultiply(const T& a, const T& b, const char* typeName = "integer") {
   return result;
 }
 
+/// Sets 'result' to 'a' / 'b'. Returns an error instead of throwing on
+/// division by zero or overflow.
 template <typename T>
-T checkedDivide(const T& a, const T& b) {
-  if (b == 0) {
-    VELOX_ARITHMETIC_ERROR("division by zero");
+Status tryCheckedDivide(const T& a, const T& b, T& result) {
+  if (UNLIKELY(b == 0)) {
+    return Status::ArithmeticError("division by zero");
   }
 
   // Type T can not represent abs(std::numeric_limits<T>::min()).
   if constexpr (std::is_integral_v<T>) {
     if (UNLIKELY(a == std::numeric_limits<T>::min() && b == -1)) {
-      VELOX_ARITHMETIC_ERROR("integer overflow: {} / {}", a, b);
+      return Status::ArithmeticError(
+          fmt::format("integer overflow: {} / {}", a, b));
     }
   }
-  return a / b;
+  result = a / b;
+  return Status::OK();
 }
 
 template <typename T>
-T checkedModulus(const T& a, const T& b) {
+T checkedDivide(const T& a, const T& b) {
+  T result;
+  auto status = tryCheckedDivide(a, b, result);
+  if (UNLIKELY(!status.ok())) {
+    VELOX_ARITHMETIC_ERROR(status.message());
+  }
+  return result;
+}
+
+/// Sets 'result' to 'a' % 'b'. Returns an error instead of throwing on
+/// division by zero.
+template <typename T>
+Status tryCheckedModulus(const T& a, const T& b, T& result) {
   if (UNLIKELY(b == 0)) {
-    VELOX_ARITHMETIC_ERROR("Cannot divide by 0");
+    return Status::ArithmeticError("Cannot divide by 0");
   }
   // std::numeric_limits<int64_t>::min() % -1 could crash the program since
   // abs(std::numeric_limits<int64_t>::min()) can not be represented in
   // int64_t.
   if (b == -1) {
-    return 0;
+    result = 0;
+  } else {
+    result = a % b;
+  }
+  return Status::OK();
+}
+
+template <typename T>
+T checkedModulus(const T& a, const T& b) {
+  T result;
+  auto status = tryCheckedModulus(a, b, result);
+  if (UNLIKELY(!status.ok())) {
+    VELOX_ARITHMETIC_ERROR(status.message());
   }
-  return (a % b);
+  return result;
 }
 
 template <typename T>
@@ -15,6 +15,7 @@
  */
 
 #include "velox/common/base/Counters.h"
+#include "velox/common/base/RuntimeMetrics.h"
 #include "velox/common/base/StatsReporter.h"
 
 namespace facebook::velox {
@@ -24,6 +25,29 @@ void registerVeloxCounters() {
   // P50, P90, P99, and P100.
   REPORT_ADD_HISTOGRAM_EXPORT_PERCENTILE(
       kCounterHiveFileHandleGenerateLatencyMs, 10, 0, 100000, 50, 90, 99, 100);
+
+  // Track lookups in AsyncDataCache and the new entries that are made
+  // immediately evictable by admission control.
+  REPORT_ADD_STAT_EXPORT_TYPE(
+      kCounterMemoryCacheNumHits, facebook::velox::StatType::SUM);
+  REPORT_ADD_STAT_EXPORT_TYPE(
+      kCounterMemoryCacheNumMisses, facebook::velox::StatType::SUM);
+  REPORT_ADD_STAT_EXPORT_TYPE(
+      kCounterMemoryCacheNumAdmissionRejects, facebook::velox::StatType::SUM);
+
+  // Keep histograms of the operator runtime stats of individual reads from
+  // data sources, driver queueing, page decompressions and spill writes, and
+  // report them in range of [0, 10s] with p50, p90 and p99.
+  const std::pair<const char*, folly::StringPiece> runtimeHistograms[] = {
+      {"dataSourceWallNanos", kCounterDataSourceWallNanos},
+      {"queuedWallNanos", kCounterQueuedWallNanos},
+      {"decompressionWallNanos", kCounterDecompressionWallNanos},
+      {"spillWriteTime", kCounterSpillWriteTimeNanos}};
+  for (const auto& [name, key] : runtimeHistograms) {
+    registerRuntimeHistogram(name, key.str());
+    REPORT_ADD_HISTOGRAM_EXPORT_PERCENTILE(
+        key, 1'000'000, 0, 10'000'000'000, 50, 90, 99);
+  }
 }
 
 } // namespace facebook::velox
@@ -25,4 +25,25 @@ void registerVeloxCounters();
 
 constexpr folly::StringPiece kCounterHiveFileHandleGenerateLatencyMs{
     "velox.hive_file_handle_generate_latency_ms"};
+
+constexpr folly::StringPiece kCounterMemoryCacheNumHits{
+    "velox.memory_cache_num_hits"};
+
+constexpr folly::StringPiece kCounterMemoryCacheNumMisses{
+    "velox.memory_cache_num_misses"};
+
+constexpr folly::StringPiece kCounterMemoryCacheNumAdmissionRejects{
+    "velox.memory_cache_num_admission_rejects"};
+
+constexpr folly::StringPiece kCounterDataSourceWallNanos{
+    "velox.data_source_wall_nanos"};
+
+constexpr folly::StringPiece kCounterQueuedWallNanos{
+    "velox.queued_wall_nanos"};
+
+constexpr folly::StringPiece kCounterDecompressionWallNanos{
+    "velox.decompression_wall_nanos"};
+
+constexpr folly::StringPiece kCounterSpillWriteTimeNanos{
+    "velox.spill_write_time_nanos"};
 } // namespace facebook::velox
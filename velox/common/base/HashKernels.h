@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include <xsimd/xsimd.hpp>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Nulls.h"
+
+/// Hash functions and loops that hash columns of values, shared by the
+/// hashers of joins and aggregations (VectorHasher), of Presto checksums
+/// (PrestoHasher) and of the Spark hash functions. The loops work on flat
+/// buffers of values with optional null and selection bit masks, so that
+/// flat vectors are hashed without decoding.
+namespace facebook::velox::hashing {
+
+/// Calls 'hashes[row] = hash(values[row], hashes[row])' for the rows in
+/// [begin, end) that are set in 'selected' and not set as null in 'nulls',
+/// and 'hashes[row] = nullHash(hashes[row])' for the null ones. 'selected' ==
+/// nullptr selects all rows and 'nulls' == nullptr means that there are no
+/// nulls. 'hash' gets the previous value in 'hashes' to mix into or to use as
+/// seed. Without nulls and selection, this is a plain loop that the compiler
+/// can vectorize.
+template <typename T, typename THash, typename THashFunc, typename TNullFunc>
+void hashFlat(
+    const T* values,
+    const uint64_t* nulls,
+    const uint64_t* selected,
+    int32_t begin,
+    int32_t end,
+    THash* hashes,
+    THashFunc hash,
+    TNullFunc nullHash) {
+  if (nulls == nullptr) {
+    if (selected == nullptr) {
+      for (auto row = begin; row < end; ++row) {
+        hashes[row] = hash(values[row], hashes[row]);
+      }
+    } else {
+      bits::forEachSetBit(selected, begin, end, [&](int32_t row) {
+        hashes[row] = hash(values[row], hashes[row]);
+      });
+    }
+    return;
+  }
+  auto hashRow = [&](int32_t row) {
+    hashes[row] = bits::isBitNull(nulls, row) ? nullHash(hashes[row])
+                                              : hash(values[row], hashes[row]);
+  };
+  if (selected == nullptr) {
+    for (auto row = begin; row < end; ++row) {
+      hashRow(row);
+    }
+  } else {
+    bits::forEachSetBit(selected, begin, end, hashRow);
+  }
+}
+
+/// Murmur3 x86_32 as implemented by Spark in
+/// src/main/java/org/apache/spark/unsafe/hash/Murmur3_x86_32.java.
+///
+/// Spark's Murmur3 seems slightly different from the original from Austin
+/// Appleby: in particular the fmix function's first line is different. The
+/// original can be found here:
+/// https://github.com/aappleby/smhasher/blob/master/src/MurmurHash3.cpp
+///
+/// Signed integer types have been remapped to unsigned types (as in the
+/// original) to avoid undefined signed integer overflow and sign extension.
+/// The mixing steps are templates that take either uint32_t or an
+/// xsimd::batch<uint32_t>, so that the batch versions hash several values per
+/// instruction and give the same results.
+class Murmur3_32 {
+ public:
+  static uint32_t hashInt32(uint32_t input, uint32_t seed) {
+    return fmix(mixH1(seed, mixK1(input)), 4u);
+  }
+
+  static uint32_t hashInt64(uint64_t input, uint32_t seed) {
+    uint32_t low = input;
+    uint32_t high = input >> 32;
+
+    uint32_t k1 = mixK1(low);
+    uint32_t h1 = mixH1(seed, k1);
+
+    k1 = mixK1(high);
+    h1 = mixH1(h1, k1);
+
+    return fmix(h1, 8u);
+  }
+
+  static uint32_t hashBytes(const char* data, size_t size, uint32_t seed) {
+    const char* i = data;
+    const char* const end = data + size;
+    uint32_t h1 = seed;
+    for (; i + 4 <= end; i += 4) {
+      uint32_t word;
+      std::memcpy(&word, i, sizeof(word));
+      h1 = mixH1(h1, mixK1(word));
+    }
+    for (; i != end; ++i) {
+      // Each remaining byte is sign extended, as in Spark.
+      h1 = mixH1(h1, mixK1(static_cast<uint32_t>(*i)));
+    }
+    return fmix(h1, static_cast<uint32_t>(size));
+  }
+
+  /// Sets 'hashes[i]' to hashInt32(values[i], hashes[i]) for i in [0, size),
+  /// i.e. 'hashes' holds the seeds on input.
+  static void
+  hashInt32Values(const int32_t* values, int32_t size, uint32_t* hashes) {
+    using Batch = xsimd::batch<uint32_t>;
+    constexpr int32_t kBatchSize = Batch::size;
+    int32_t i = 0;
+    for (; i + kBatchSize <= size; i += kBatchSize) {
+      auto input = Batch::load_unaligned(
+          reinterpret_cast<const uint32_t*>(values) + i);
+      auto seed = Batch::load_unaligned(hashes + i);
+      fmix(mixH1(seed, mixK1(input)), Batch(4u)).store_unaligned(hashes + i);
+    }
+    for (; i < size; ++i) {
+      hashes[i] = hashInt32(values[i], hashes[i]);
+    }
+  }
+
+ private:
+  template <typename T>
+  static T rotateLeft(T value, int32_t shift) {
+    return (value << shift) | (value >> (32 - shift));
+  }
+
+  template <typename T>
+  static T mixK1(T k1) {
+    k1 *= T(0xcc9e2d51u);
+    k1 = rotateLeft(k1, 15);
+    k1 *= T(0x1b873593u);
+    return k1;
+  }
+
+  template <typename T>
+  static T mixH1(T h1, T k1) {
+    h1 ^= k1;
+    h1 = rotateLeft(h1, 13);
+    h1 = h1 * T(5u) + T(0xe6546b64u);
+    return h1;
+  }
+
+  // Finalization mix - force all bits of a hash block to avalanche
+  template <typename T>
+  static T fmix(T h1, T length) {
+    h1 ^= length;
+    h1 ^= h1 >> 16;
+    h1 *= T(0x85ebca6bu);
+    h1 ^= h1 >> 13;
+    h1 *= T(0xc2b2ae35u);
+    h1 ^= h1 >> 16;
+    return h1;
+  }
+};
+
+/// XXH64 as implemented by Spark in
+/// src/main/java/org/apache/spark/sql/catalyst/expressions/XXH64.java.
+class XxHash64 {
+ public:
+  static uint64_t hashInt32(uint32_t input, uint64_t seed) {
+    uint64_t hash = seed + kPrime5 + 4;
+    hash ^= static_cast<uint64_t>(input) * kPrime1;
+    hash = bits::rotateLeft64(hash, 23) * kPrime2 + kPrime3;
+    return fmix(hash);
+  }
+
+  static uint64_t hashInt64(uint64_t input, uint64_t seed) {
+    uint64_t hash = seed + kPrime5 + 8;
+    hash ^= bits::rotateLeft64(input * kPrime2, 31) * kPrime1;
+    hash = bits::rotateLeft64(hash, 27) * kPrime1 + kPrime4;
+    return fmix(hash);
+  }
+
+  static uint64_t hashBytes(const char* data, size_t size, uint64_t seed) {
+    const char* i = data;
+    const char* const end = data + size;
+
+    uint64_t hash = hashBytesByWords(data, size, seed);
+    auto offset = i + (size & ~7ul);
+    if (offset + 4 <= end) {
+      uint32_t word;
+      std::memcpy(&word, offset, sizeof(word));
+      hash ^= static_cast<uint64_t>(word) * kPrime1;
+      hash = bits::rotateLeft64(hash, 23) * kPrime2 + kPrime3;
+      offset += 4;
+    }
+
+    while (offset < end) {
+      hash ^= static_cast<uint64_t>(static_cast<uint8_t>(*offset)) * kPrime5;
+      hash = bits::rotateLeft64(hash, 11) * kPrime1;
+      offset++;
+    }
+    return fmix(hash);
+  }
+
+ private:
+  static constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87UL;
+  static constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FUL;
+  static constexpr uint64_t kPrime3 = 0x165667B19E3779F9UL;
+  static constexpr uint64_t kPrime4 = 0x85EBCA77C2B2AE63UL;
+  static constexpr uint64_t kPrime5 = 0x27D4EB2F165667C5UL;
+
+  static uint64_t fmix(uint64_t hash) {
+    hash ^= hash >> 33;
+    hash *= kPrime2;
+    hash ^= hash >> 29;
+    hash *= kPrime3;
+    hash ^= hash >> 32;
+    return hash;
+  }
+
+  static uint64_t load64(const char* data) {
+    uint64_t word;
+    std::memcpy(&word, data, sizeof(word));
+    return word;
+  }
+
+  static uint64_t round(uint64_t acc, uint64_t input) {
+    return bits::rotateLeft64(acc + input * kPrime2, 31) * kPrime1;
+  }
+
+  static uint64_t mergeRound(uint64_t hash, uint64_t v) {
+    hash ^= round(0, v);
+    return hash * kPrime1 + kPrime4;
+  }
+
+  static uint64_t
+  hashBytesByWords(const char* data, size_t size, uint64_t seed) {
+    const char* i = data;
+    const char* const end = data + size;
+    uint64_t hash;
+    if (size >= 32) {
+      uint64_t v1 = seed + kPrime1 + kPrime2;
+      uint64_t v2 = seed + kPrime2;
+      uint64_t v3 = seed;
+      uint64_t v4 = seed - kPrime1;
+      for (; i + 32 <= end; i += 32) {
+        v1 = round(v1, load64(i));
+        v2 = round(v2, load64(i + 8));
+        v3 = round(v3, load64(i + 16));
+        v4 = round(v4, load64(i + 24));
+      }
+      hash = bits::rotateLeft64(v1, 1) + bits::rotateLeft64(v2, 7) +
+          bits::rotateLeft64(v3, 12) + bits::rotateLeft64(v4, 18);
+      hash = mergeRound(hash, v1);
+      hash = mergeRound(hash, v2);
+      hash = mergeRound(hash, v3);
+      hash = mergeRound(hash, v4);
+    } else {
+      hash = seed + kPrime5;
+    }
+
+    hash += size;
+
+    for (; i + 8 <= end; i += 8) {
+      hash ^= round(0, load64(i));
+      hash = bits::rotateLeft64(hash, 27) * kPrime1 + kPrime4;
+    }
+    return hash;
+  }
+};
+
+} // namespace facebook::velox::hashing
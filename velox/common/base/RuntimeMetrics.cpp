@@ -14,7 +14,11 @@
  * limitations under the License.
  */
 
+#include <folly/Synchronized.h>
 #include <folly/ThreadLocal.h>
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
 
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/RuntimeMetrics.h"
@@ -22,11 +26,76 @@
 
 namespace facebook::velox {
 
+// static
+int32_t RuntimeHistogram::bucketIndex(int64_t value) {
+  if (value < 32) {
+    return std::max<int64_t>(value, 0);
+  }
+  // 16 buckets for each power of 2 from 16 up.
+  const int32_t exponent = 63 - __builtin_clzll(value);
+  return 16 * (exponent - 3) + ((value >> (exponent - 4)) & 15);
+}
+
+// static
+int64_t RuntimeHistogram::bucketValue(int32_t index) {
+  if (index < 32) {
+    return index;
+  }
+  const int32_t exponent = index / 16 + 3;
+  const int64_t width = 1LL << (exponent - 4);
+  const int64_t lower = (16 + index % 16) * width;
+  return lower + width / 2;
+}
+
+void RuntimeHistogram::add(int64_t value) {
+  value = std::max<int64_t>(value, 0);
+  ++buckets_[bucketIndex(value)];
+  ++count_;
+  min_ = std::min(min_, value);
+  max_ = std::max(max_, value);
+}
+
+void RuntimeHistogram::merge(const RuntimeHistogram& other) {
+  for (const auto& [index, count] : other.buckets_) {
+    buckets_[index] += count;
+  }
+  count_ += other.count_;
+  min_ = std::min(min_, other.min_);
+  max_ = std::max(max_, other.max_);
+}
+
+int64_t RuntimeHistogram::percentile(double percentile) const {
+  if (count_ == 0) {
+    return 0;
+  }
+  const int64_t rank = std::max<int64_t>(
+      1, std::ceil(std::clamp(percentile, 0.0, 100.0) / 100 * count_));
+  int64_t numSeen = 0;
+  for (const auto& [index, count] : buckets_) {
+    numSeen += count;
+    if (numSeen >= rank) {
+      return std::clamp(bucketValue(index), min_, max_);
+    }
+  }
+  return max_;
+}
+
+std::string RuntimeHistogram::toString() const {
+  return fmt::format(
+      "p50:{}, p90:{}, p99:{}",
+      percentile(50),
+      percentile(90),
+      percentile(99));
+}
+
 void RuntimeMetric::addValue(int64_t value) {
   sum += value;
   count++;
   min = std::min(min, value);
   max = std::max(max, value);
+  if (histogram.has_value()) {
+    histogram->add(value);
+  }
 }
 
 void RuntimeMetric::aggregate() {
@@ -40,27 +109,60 @@ void RuntimeMetric::merge(const RuntimeMetric& other) {
   count += other.count;
   min = std::min(min, other.min);
   max = std::max(max, other.max);
+  if (other.histogram.has_value()) {
+    if (histogram.has_value()) {
+      histogram->merge(*other.histogram);
+    } else {
+      histogram = other.histogram;
+    }
+  }
 }
 
 void RuntimeMetric::printMetric(std::stringstream& stream) const {
-  switch (unit) {
-    case RuntimeCounter::Unit::kNanos:
-      stream << " sum: " << succinctNanos(sum) << ", count: " << count
-             << ", min: " << succinctNanos(min)
-             << ", max: " << succinctNanos(max);
-      break;
-    case RuntimeCounter::Unit::kBytes:
-      stream << " sum: " << succinctBytes(sum) << ", count: " << count
-             << ", min: " << succinctBytes(min)
-             << ", max: " << succinctBytes(max);
-      break;
-    case RuntimeCounter::Unit::kNone:
-    default:
-      stream << " sum: " << sum << ", count: " << count << ", min: " << min
-             << ", max: " << max;
+  auto print = [&](int64_t value) -> std::string {
+    switch (unit) {
+      case RuntimeCounter::Unit::kNanos:
+        return succinctNanos(value);
+      case RuntimeCounter::Unit::kBytes:
+        return succinctBytes(value);
+      case RuntimeCounter::Unit::kNone:
+      default:
+        return std::to_string(value);
+    }
+  };
+  stream << " sum: " << print(sum) << ", count: " << count
+         << ", min: " << print(min) << ", max: " << print(max);
+  if (histogram.has_value() && histogram->count() > 0) {
+    stream << ", p50: " << print(histogram->percentile(50))
+           << ", p90: " << print(histogram->percentile(90))
+           << ", p99: " << print(histogram->percentile(99));
   }
 }
 
+namespace {
+// Maps the names of the runtime stats with histograms to their StatsReporter
+// keys. The nodes of std::unordered_map do not move, so the keys can be
+// referenced after releasing the lock.
+folly::Synchronized<std::unordered_map<std::string, std::string>>&
+runtimeHistograms() {
+  static folly::Synchronized<std::unordered_map<std::string, std::string>>
+      histograms;
+  return histograms;
+}
+} // namespace
+
+void registerRuntimeHistogram(
+    const std::string& name,
+    const std::string& reporterKey) {
+  runtimeHistograms().wlock()->insert_or_assign(name, reporterKey);
+}
+
+const std::string* runtimeHistogramReporterKey(const std::string& name) {
+  auto histograms = runtimeHistograms().rlock();
+  auto it = histograms->find(name);
+  return it == histograms->end() ? nullptr : &it->second;
+}
+
 // Thread local runtime stat writers.
 static thread_local BaseRuntimeStatWriter* localRuntimeStatWriter;
 
@@ -19,6 +19,8 @@
 #include <fmt/format.h>
 #include <folly/CppAttributes.h>
 #include <limits>
+#include <map>
+#include <optional>
 #include <sstream>
 
 namespace facebook::velox {
@@ -32,6 +34,40 @@ struct RuntimeCounter {
       : value(_value), unit(_unit) {}
 };
 
+/// Mergeable histogram of non-negative values for estimating percentiles of
+/// runtime stats. Values below 32 have a bucket each. Larger values go into
+/// 16 buckets per power of 2, so that the estimates are within 1/32 of the
+/// actual values. Negative values count as 0. Only the buckets with values
+/// are stored.
+class RuntimeHistogram {
+ public:
+  void add(int64_t value);
+
+  void merge(const RuntimeHistogram& other);
+
+  int64_t count() const {
+    return count_;
+  }
+
+  /// Returns an estimate of the 'percentile' percentile, e.g. 99 for p99, of
+  /// the values added. Returns 0 if there are no values.
+  int64_t percentile(double percentile) const;
+
+  std::string toString() const;
+
+ private:
+  static int32_t bucketIndex(int64_t value);
+
+  // Returns the value that represents the values in bucket 'index'.
+  static int64_t bucketValue(int32_t index);
+
+  // Number of values in each bucket, by bucket index.
+  std::map<int32_t, int64_t> buckets_;
+  int64_t count_{0};
+  int64_t min_{std::numeric_limits<int64_t>::max()};
+  int64_t max_{0};
+};
+
 struct RuntimeMetric {
   // Sum, min, max have the same unit, count has kNone.
   RuntimeCounter::Unit unit;
@@ -39,6 +75,11 @@ struct RuntimeMetric {
   int64_t count{0};
   int64_t min{std::numeric_limits<int64_t>::max()};
   int64_t max{std::numeric_limits<int64_t>::min()};
+  /// Set for the runtime stats registered with registerRuntimeHistogram().
+  /// Keeps the distribution of the individual values. Is not changed by
+  /// aggregate() so that it describes the individual values also for stats
+  /// that are aggregated per operator.
+  std::optional<RuntimeHistogram> histogram;
 
   explicit RuntimeMetric(
       RuntimeCounter::Unit _unit = RuntimeCounter::Unit::kNone)
@@ -60,11 +101,34 @@ struct RuntimeMetric {
   void merge(const RuntimeMetric& other);
 
   std::string toString() const {
+    if (histogram.has_value()) {
+      return fmt::format(
+          "sum:{}, count:{}, min:{}, max:{}, {}",
+          sum,
+          count,
+          min,
+          max,
+          histogram->toString());
+    }
     return fmt::format(
         "sum:{}, count:{}, min:{}, max:{}", sum, count, min, max);
   }
 };
 
+/// Makes the operator runtime stats called 'name' keep a histogram of their
+/// values, see RuntimeMetric::histogram. If 'reporterKey' is not empty, the
+/// values are also added to the StatsReporter histogram of that key. Is
+/// meant to be called at startup, before running queries.
+void registerRuntimeHistogram(
+    const std::string& name,
+    const std::string& reporterKey = "");
+
+/// Returns the StatsReporter key given to registerRuntimeHistogram() for
+/// 'name' or nullptr if 'name' has no histogram. The key is empty if the
+/// values are not reported.
+const std::string* FOLLY_NULLABLE
+runtimeHistogramReporterKey(const std::string& name);
+
 /// Simple interface to implement writing of runtime stats to Velox Operator
 /// stats.
 /// Inherit a concrete class from this to implement your writing.
@@ -47,6 +47,19 @@ class SelectivityInfo {
     return numOut_;
   }
 
+  uint64_t timeClocks() const {
+    return timeClocks_;
+  }
+
+  // Halves the counts and the time. This keeps timeToDropValue() but gives
+  // the batches measured after this twice the weight of the earlier ones, so
+  // that an order based on 'this' follows changes in the data.
+  void age() {
+    numIn_ /= 2;
+    numOut_ /= 2;
+    timeClocks_ /= 2;
+  }
+
  private:
   uint64_t numIn_ = 0;
   uint64_t numOut_ = 0;
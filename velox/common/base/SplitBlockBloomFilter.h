@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <xsimd/xsimd.hpp>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox {
+
+/// Bloom filter made of 256 bit blocks of 8 32-bit words. A value sets
+/// one bit in each word of a single block, so that an insert or a lookup
+/// touches one cache line and takes a few SIMD instructions. The upper 32
+/// bits of the hash select the block and the lower 32 bits, multiplied by
+/// a different odd constant for each word, select the bits in the block.
+/// The layout and the bit selection are those of the Parquet split block
+/// Bloom filter, so the blocks of a Parquet Bloom filter can be probed
+/// directly with mayContain(blocks, numBlocks, hash). With the default 10
+/// bits per value we get ~1% false positives. Values are hashed by the
+/// caller, e.g. with folly::hasher or XXH64 for Parquet.
+///
+/// The batch insert() and test() prefetch the blocks of a group of hashes
+/// before accessing them, which hides the cache misses of filters that do
+/// not fit in cache.
+template <typename Allocator = std::allocator<uint32_t>>
+class SplitBlockBloomFilter {
+ public:
+  static constexpr int32_t kBlockWords = 8;
+  static constexpr int32_t kBlockBits = kBlockWords * 32;
+  static constexpr int32_t kDefaultBitsPerValue = 10;
+
+  SplitBlockBloomFilter() : blocks_{Allocator()} {}
+  explicit SplitBlockBloomFilter(const Allocator& allocator)
+      : blocks_{allocator} {}
+
+  /// Prepares 'this' for use with an expected 'capacity' entries and
+  /// 'bitsPerValue' bits per entry. Drops any prior content.
+  void reset(int32_t capacity, int32_t bitsPerValue = kDefaultBitsPerValue) {
+    VELOX_CHECK_GT(bitsPerValue, 0);
+    const uint64_t numBits = std::max<uint64_t>(1, capacity) * bitsPerValue;
+    numBlocks_ =
+        bits::nextPowerOfTwo(bits::roundUp(numBits, kBlockBits) / kBlockBits);
+    blocks_.clear();
+    blocks_.resize(numBlocks_ * kBlockWords);
+  }
+
+  bool isSet() const {
+    return numBlocks_ > 0;
+  }
+
+  int32_t numBlocks() const {
+    return numBlocks_;
+  }
+
+  /// Returns the words of the filter, 'kBlockWords' per block.
+  const std::vector<uint32_t, Allocator>& blocks() const {
+    return blocks_;
+  }
+
+  /// Adds a value with hash 'hash'.
+  void insert(uint64_t hash) {
+    set(blocks_.data(), numBlocks_, hash);
+  }
+
+  /// Adds the values with the 'size' hashes at 'hashes'.
+  void insert(const uint64_t* hashes, int32_t size) {
+    auto* blocks = blocks_.data();
+    for (int32_t i = 0; i < size; i += kPrefetchBatch) {
+      const auto end = std::min(size, i + kPrefetchBatch);
+      for (auto j = i; j < end; ++j) {
+        __builtin_prefetch(block(blocks, numBlocks_, hashes[j]));
+      }
+      for (auto j = i; j < end; ++j) {
+        set(blocks, numBlocks_, hashes[j]);
+      }
+    }
+  }
+
+  bool mayContain(uint64_t hash) const {
+    return test(blocks_.data(), numBlocks_, hash);
+  }
+
+  /// Returns true if a value with 'hash' may be in a filter consisting of
+  /// the 'numBlocks' blocks at 'blocks', e.g. the blocks() of another
+  /// filter or the bitset of a Parquet Bloom filter.
+  static bool
+  mayContain(const uint32_t* blocks, int32_t numBlocks, uint64_t hash) {
+    return test(blocks, numBlocks, hash);
+  }
+
+  /// Sets bit i of 'result' if the value with hash 'hashes[i]' may be in
+  /// the filter and clears it otherwise, for i in [0, size). 'result' must
+  /// have space for bits::nwords(size) words. Returns the number of bits
+  /// set.
+  int32_t test(const uint64_t* hashes, int32_t size, uint64_t* result) const {
+    const auto* blocks = blocks_.data();
+    int32_t numHits = 0;
+    for (int32_t i = 0; i < size; i += kPrefetchBatch) {
+      const auto end = std::min(size, i + kPrefetchBatch);
+      for (auto j = i; j < end; ++j) {
+        __builtin_prefetch(block(blocks, numBlocks_, hashes[j]));
+      }
+      uint64_t word = 0;
+      for (auto j = i; j < end; ++j) {
+        word |= static_cast<uint64_t>(test(blocks, numBlocks_, hashes[j]))
+            << (j - i);
+      }
+      result[i / 64] = word;
+      numHits += __builtin_popcountll(word);
+    }
+    return numHits;
+  }
+
+  /// Adds the values of 'other', which must have the same number of
+  /// blocks.
+  void merge(const SplitBlockBloomFilter& other) {
+    VELOX_CHECK_EQ(numBlocks_, other.numBlocks_);
+    for (size_t i = 0; i < blocks_.size(); ++i) {
+      blocks_[i] |= other.blocks_[i];
+    }
+  }
+
+ private:
+  using Batch = xsimd::batch<uint32_t>;
+  static_assert(kBlockWords % Batch::size == 0);
+
+  // Number of hashes for which the blocks are prefetched before they are
+  // accessed. Is also the number of bits of a result word in test().
+  static constexpr int32_t kPrefetchBatch = 64;
+
+  // Odd constants for selecting the bit in each word of a block, from the
+  // Parquet specification.
+  static constexpr uint32_t kSalt[kBlockWords] = {
+      0x47b6137bU,
+      0x44974d91U,
+      0x8824ad5bU,
+      0xa2b7289dU,
+      0x705495c7U,
+      0x2df1424bU,
+      0x9efc4947U,
+      0x5c6bfb31U};
+
+  template <typename T>
+  static T* block(T* blocks, int32_t numBlocks, uint64_t hash) {
+    const auto index = ((hash >> 32) * numBlocks) >> 32;
+    return blocks + index * kBlockWords;
+  }
+
+  // Returns the bits to set in words [offset, offset + Batch::size) of a
+  // block for a value with hash 'hash'.
+  static Batch mask(uint64_t hash, int32_t offset) {
+    const auto salt = Batch::load_unaligned(kSalt + offset);
+    return Batch(1) << ((Batch(static_cast<uint32_t>(hash)) * salt) >> 27);
+  }
+
+  static void set(uint32_t* blocks, int32_t numBlocks, uint64_t hash) {
+    auto* words = block(blocks, numBlocks, hash);
+    for (auto i = 0; i < kBlockWords; i += Batch::size) {
+      (Batch::load_unaligned(words + i) | mask(hash, i))
+          .store_unaligned(words + i);
+    }
+  }
+
+  static bool test(const uint32_t* blocks, int32_t numBlocks, uint64_t hash) {
+    const auto* words = block(blocks, numBlocks, hash);
+    for (auto i = 0; i < kBlockWords; i += Batch::size) {
+      const auto bits = mask(hash, i);
+      if (!xsimd::all((Batch::load_unaligned(words + i) & bits) == bits)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  int32_t numBlocks_{0};
+  std::vector<uint32_t, Allocator> blocks_;
+};
+
+} // namespace facebook::velox
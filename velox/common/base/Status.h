@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox {
+
+/// Outcome of an operation that can fail on bad user input, e.g. a simple
+/// function applied to one row. Lets per-row code report the error without
+/// throwing: the caller records the error for the row, which is much cheaper
+/// than unwinding when many rows fail, e.g. under TRY. A successful Status
+/// holds a null pointer, so creating and checking it is free.
+class [[nodiscard]] Status {
+ public:
+  Status() = default;
+
+  static Status OK() {
+    return Status();
+  }
+
+  /// Error on invalid user input. Converts to a VeloxUserError with error
+  /// code INVALID_ARGUMENT, as thrown by VELOX_USER_FAIL.
+  static Status UserError(std::string message) {
+    return Status(std::move(message), error_code::kInvalidArgument.c_str());
+  }
+
+  /// Converts to a VeloxUserError with error code ARITHMETIC_ERROR, as thrown
+  /// by VELOX_ARITHMETIC_ERROR.
+  static Status ArithmeticError(std::string message) {
+    return Status(std::move(message), error_code::kArithmeticError.c_str());
+  }
+
+  bool ok() const {
+    return state_ == nullptr;
+  }
+
+  /// The error message. Empty if ok().
+  const std::string& message() const {
+    static const std::string kEmpty;
+    return state_ ? state_->message : kEmpty;
+  }
+
+  /// The error code. Empty if ok().
+  const char* errorCode() const {
+    return state_ ? state_->errorCode : "";
+  }
+
+  /// Returns the error as a VeloxUserError. Must not be called if ok().
+  std::exception_ptr toException() const {
+    VELOX_DCHECK(!ok());
+    return std::make_exception_ptr(VeloxUserError(
+        __FILE__,
+        __LINE__,
+        __FUNCTION__,
+        "",
+        state_->message,
+        error_source::kErrorSourceUser.c_str(),
+        state_->errorCode,
+        false));
+  }
+
+ private:
+  struct State {
+    std::string message;
+    const char* errorCode;
+  };
+
+  Status(std::string message, const char* errorCode)
+      : state_(std::make_unique<State>(State{std::move(message), errorCode})) {}
+
+  std::unique_ptr<State> state_;
+};
+
+} // namespace facebook::velox
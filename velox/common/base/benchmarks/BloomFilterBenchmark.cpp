@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/Hash.h>
+#include <folly/init/Init.h>
+
+#include "velox/common/base/BloomFilter.h"
+#include "velox/common/base/SplitBlockBloomFilter.h"
+
+namespace facebook::velox::test {
+namespace {
+
+// Compares the one value at a time BloomFilter with the batch API of
+// SplitBlockBloomFilter, for a filter that fits in cache and one that does
+// not. Half of the probed values are in the filter.
+class BloomFilterBenchmark {
+ public:
+  explicit BloomFilterBenchmark(int32_t numValues) {
+    for (auto i = 0; i < numValues; ++i) {
+      hashes_.push_back(folly::hasher<int64_t>()(i));
+    }
+    for (auto i = 0; i < kNumProbes; ++i) {
+      probes_.push_back(folly::hasher<int64_t>()(i * 2 % (2 * numValues)));
+    }
+    result_.resize(bits::nwords(kNumProbes));
+    bloom_.reset(numValues);
+    splitBlockBloom_.reset(numValues);
+    insertBloom();
+    insertSplitBlockBloom();
+  }
+
+  int32_t insertBloom() {
+    for (auto hash : hashes_) {
+      bloom_.insert(hash);
+    }
+    return hashes_.size();
+  }
+
+  int32_t insertSplitBlockBloom() {
+    splitBlockBloom_.insert(hashes_.data(), hashes_.size());
+    return hashes_.size();
+  }
+
+  int32_t testBloom() {
+    int32_t numHits = 0;
+    for (auto hash : probes_) {
+      numHits += bloom_.mayContain(hash);
+    }
+    folly::doNotOptimizeAway(numHits);
+    return probes_.size();
+  }
+
+  int32_t testSplitBlockBloom() {
+    folly::doNotOptimizeAway(splitBlockBloom_.test(
+        probes_.data(), probes_.size(), result_.data()));
+    return probes_.size();
+  }
+
+ private:
+  static constexpr int32_t kNumProbes = 1'000'000;
+
+  std::vector<uint64_t> hashes_;
+  std::vector<uint64_t> probes_;
+  std::vector<uint64_t> result_;
+  BloomFilter<> bloom_;
+  SplitBlockBloomFilter<> splitBlockBloom_;
+};
+
+std::unique_ptr<BloomFilterBenchmark> small;
+std::unique_ptr<BloomFilterBenchmark> large;
+
+BENCHMARK_MULTI(insertSmall) {
+  return small->insertBloom();
+}
+
+BENCHMARK_RELATIVE_MULTI(insertSmallSplitBlock) {
+  return small->insertSplitBlockBloom();
+}
+
+BENCHMARK_MULTI(testSmall) {
+  return small->testBloom();
+}
+
+BENCHMARK_RELATIVE_MULTI(testSmallSplitBlock) {
+  return small->testSplitBlockBloom();
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_MULTI(insertLarge) {
+  return large->insertBloom();
+}
+
+BENCHMARK_RELATIVE_MULTI(insertLargeSplitBlock) {
+  return large->insertSplitBlockBloom();
+}
+
+BENCHMARK_MULTI(testLarge) {
+  return large->testBloom();
+}
+
+BENCHMARK_RELATIVE_MULTI(testLargeSplitBlock) {
+  return large->testSplitBlockBloom();
+}
+
+} // namespace
+} // namespace facebook::velox::test
+
+int main(int argc, char** argv) {
+  using namespace facebook::velox::test;
+  folly::init(&argc, &argv);
+  small = std::make_unique<BloomFilterBenchmark>(10'000);
+  large = std::make_unique<BloomFilterBenchmark>(10'000'000);
+  folly::runBenchmarks();
+  small.reset();
+  large.reset();
+  return 0;
+}
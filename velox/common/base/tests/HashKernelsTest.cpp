@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/base/HashKernels.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+
+namespace facebook::velox::hashing {
+namespace {
+
+TEST(HashKernelsTest, sparkValues) {
+  // Expected values as returned by Spark's hash() and xxhash64() with the
+  // default seed of 42.
+  EXPECT_EQ(static_cast<int32_t>(Murmur3_32::hashInt32(1, 42)), -559580957);
+  EXPECT_EQ(static_cast<int32_t>(Murmur3_32::hashInt64(1, 42)), -1712319331);
+  EXPECT_EQ(
+      static_cast<int64_t>(XxHash64::hashInt64(1, 42)), -7001672635703045582);
+  EXPECT_EQ(
+      static_cast<int64_t>(XxHash64::hashInt32(0xdeadbeef, 42)),
+      -8041005359684616715);
+}
+
+TEST(HashKernelsTest, xxHash64MatchesXxhashLibrary) {
+  // approx_distinct relies on these giving the same hash as XXH64() of the
+  // value's bytes.
+  for (int64_t value : {0L, 1L, -1L, 0x123456789abcdefL, INT64_MIN}) {
+    EXPECT_EQ(XxHash64::hashInt64(value, 0), XXH64(&value, 8, 0)) << value;
+    EXPECT_EQ(XxHash64::hashInt64(value, 7), XXH64(&value, 8, 7)) << value;
+    int32_t low = value;
+    EXPECT_EQ(XxHash64::hashInt32(low, 0), XXH64(&low, 4, 0)) << low;
+  }
+}
+
+TEST(HashKernelsTest, murmur3BatchMatchesScalar) {
+  // Sizes around the batch width to cover the scalar tail.
+  for (int32_t size : {0, 1, 3, 7, 8, 9, 16, 17, 100}) {
+    std::vector<int32_t> values(size);
+    std::vector<uint32_t> hashes(size);
+    for (int32_t i = 0; i < size; ++i) {
+      values[i] = i * 0x9E3779B1 - 12345;
+      hashes[i] = 42 + i;
+    }
+    Murmur3_32::hashInt32Values(values.data(), size, hashes.data());
+    for (int32_t i = 0; i < size; ++i) {
+      EXPECT_EQ(hashes[i], Murmur3_32::hashInt32(values[i], 42 + i))
+          << "size " << size << ", row " << i;
+    }
+  }
+}
+
+TEST(HashKernelsTest, hashFlatNullsAndSelection) {
+  constexpr int32_t kSize = 130;
+  std::vector<int64_t> values(kSize);
+  std::vector<uint64_t> nulls(bits::nwords(kSize), bits::kNotNull64);
+  std::vector<uint64_t> selected(bits::nwords(kSize), 0);
+  for (int32_t i = 0; i < kSize; ++i) {
+    values[i] = i;
+    if (i % 3 == 0) {
+      bits::setNull(nulls.data(), i);
+    }
+    if (i % 2 == 0) {
+      bits::setBit(selected.data(), i);
+    }
+  }
+  auto hash = [](int64_t value, uint64_t seed) { return seed + value * 10; };
+  auto nullHash = [](uint64_t /*seed*/) { return 7; };
+
+  auto run = [&](const uint64_t* rawNulls, const uint64_t* rawSelected) {
+    std::vector<uint64_t> hashes(kSize, 1);
+    hashFlat(
+        values.data(),
+        rawNulls,
+        rawSelected,
+        1,
+        kSize,
+        hashes.data(),
+        hash,
+        nullHash);
+    for (int32_t i = 0; i < kSize; ++i) {
+      uint64_t expected = 1;
+      if (i >= 1 && (!rawSelected || bits::isBitSet(rawSelected, i))) {
+        expected = rawNulls && bits::isBitNull(rawNulls, i) ? 7 : 1 + i * 10;
+      }
+      EXPECT_EQ(hashes[i], expected) << "row " << i;
+    }
+  };
+
+  run(nullptr, nullptr);
+  run(nulls.data(), nullptr);
+  run(nullptr, selected.data());
+  run(nulls.data(), selected.data());
+}
+
+} // namespace
+} // namespace facebook::velox::hashing
@@ -73,4 +73,86 @@ TEST_F(RuntimeMetricsTest, basic) {
   testMetric(rm3, 0, 0, 0, 0);
 };
 
+TEST_F(RuntimeMetricsTest, histogram) {
+  RuntimeHistogram histogram;
+  EXPECT_EQ(histogram.percentile(50), 0);
+
+  // Small values are exact.
+  for (auto i = 0; i < 10; ++i) {
+    histogram.add(i);
+  }
+  EXPECT_EQ(histogram.percentile(0), 0);
+  EXPECT_EQ(histogram.percentile(50), 4);
+  EXPECT_EQ(histogram.percentile(100), 9);
+
+  // Large values are within 1/32.
+  RuntimeHistogram large;
+  for (int64_t i = 1; i <= 10'000; ++i) {
+    large.add(i * 1'000'000);
+  }
+  for (auto percentile : {1, 10, 50, 90, 99}) {
+    const double expected = percentile * 100 * 1'000'000.0;
+    EXPECT_NEAR(large.percentile(percentile), expected, expected / 32)
+        << percentile;
+  }
+  EXPECT_EQ(large.percentile(100), 10'000'000'000);
+
+  // Merging is the same as adding all values to one histogram.
+  RuntimeHistogram all;
+  RuntimeHistogram even;
+  RuntimeHistogram odd;
+  for (int64_t i = 0; i < 1'000; ++i) {
+    const int64_t value = (i * 7919) % 100'000;
+    all.add(value);
+    (i % 2 == 0 ? even : odd).add(value);
+  }
+  even.merge(odd);
+  EXPECT_EQ(even.count(), all.count());
+  for (auto percentile : {50, 90, 99}) {
+    EXPECT_EQ(even.percentile(percentile), all.percentile(percentile));
+  }
+  EXPECT_EQ(
+      all.toString(),
+      fmt::format(
+          "p50:{}, p90:{}, p99:{}",
+          all.percentile(50),
+          all.percentile(90),
+          all.percentile(99)));
+}
+
+TEST_F(RuntimeMetricsTest, metricWithHistogram) {
+  RuntimeMetric rm1(RuntimeCounter::Unit::kNanos);
+  rm1.histogram.emplace();
+  RuntimeMetric rm2(RuntimeCounter::Unit::kNanos);
+  for (auto i = 1; i <= 20; ++i) {
+    rm1.addValue(i);
+    rm2.addValue(i + 100);
+  }
+  EXPECT_EQ(
+      rm1.toString(),
+      "sum:210, count:20, min:1, max:20, p50:10, p90:18, p99:20");
+
+  // A metric without histogram adds nothing to the histogram of another.
+  rm1.merge(rm2);
+  EXPECT_EQ(rm1.histogram->count(), 20);
+  rm2.merge(rm1);
+  ASSERT_TRUE(rm2.histogram.has_value());
+  EXPECT_EQ(rm2.histogram->count(), 20);
+
+  // aggregate() keeps the distribution of the individual values.
+  rm1.aggregate();
+  testMetric(rm1, 2'420, 1, 2'420, 2'420);
+  EXPECT_EQ(rm1.histogram->percentile(90), 18);
+
+  std::stringstream stream;
+  rm1.printMetric(stream);
+  EXPECT_NE(stream.str().find("p99: 20ns"), std::string::npos) << stream.str();
+
+  EXPECT_EQ(runtimeHistogramReporterKey("unregisteredStat"), nullptr);
+  registerRuntimeHistogram("registeredStat", "velox.registered_stat");
+  ASSERT_NE(runtimeHistogramReporterKey("registeredStat"), nullptr);
+  EXPECT_EQ(
+      *runtimeHistogramReporterKey("registeredStat"), "velox.registered_stat");
+}
+
 } // namespace facebook::velox
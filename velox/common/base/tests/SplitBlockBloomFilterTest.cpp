@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/base/SplitBlockBloomFilter.h"
+
+#include <folly/Hash.h>
+#include <gtest/gtest.h>
+
+using namespace facebook::velox;
+
+namespace {
+std::vector<uint64_t> makeHashes(int32_t begin, int32_t end) {
+  std::vector<uint64_t> hashes;
+  for (auto i = begin; i < end; ++i) {
+    hashes.push_back(folly::hasher<int32_t>()(i));
+  }
+  return hashes;
+}
+} // namespace
+
+class SplitBlockBloomFilterTest : public ::testing::Test {};
+
+TEST_F(SplitBlockBloomFilterTest, basic) {
+  constexpr int32_t kSize = 10'000;
+  SplitBlockBloomFilter bloom;
+  EXPECT_FALSE(bloom.isSet());
+  bloom.reset(kSize);
+  EXPECT_TRUE(bloom.isSet());
+  for (auto i = 0; i < kSize; ++i) {
+    bloom.insert(folly::hasher<int32_t>()(i));
+  }
+  int32_t numFalsePositives = 0;
+  for (auto i = 0; i < kSize; ++i) {
+    EXPECT_TRUE(bloom.mayContain(folly::hasher<int32_t>()(i)));
+    numFalsePositives += bloom.mayContain(folly::hasher<int32_t>()(i + kSize));
+  }
+  EXPECT_GT(2, 100 * numFalsePositives / kSize);
+}
+
+// Checks the bits set against the Parquet split block Bloom filter
+// specification.
+TEST_F(SplitBlockBloomFilterTest, layout) {
+  constexpr uint32_t kSalt[] = {
+      0x47b6137bU,
+      0x44974d91U,
+      0x8824ad5bU,
+      0xa2b7289dU,
+      0x705495c7U,
+      0x2df1424bU,
+      0x9efc4947U,
+      0x5c6bfb31U};
+  SplitBlockBloomFilter bloom;
+  bloom.reset(1'000);
+  const auto numBlocks = bloom.numBlocks();
+  std::vector<uint32_t> expected(numBlocks * 8);
+  for (auto hash : makeHashes(0, 1'000)) {
+    bloom.insert(hash);
+    const uint64_t index = ((hash >> 32) * numBlocks) >> 32;
+    for (auto i = 0; i < 8; ++i) {
+      const uint32_t key = static_cast<uint32_t>(hash) * kSalt[i];
+      expected[index * 8 + i] |= 1U << (key >> 27);
+    }
+  }
+  ASSERT_EQ(expected.size(), bloom.blocks().size());
+  for (auto i = 0; i < expected.size(); ++i) {
+    ASSERT_EQ(expected[i], bloom.blocks()[i]) << i;
+  }
+  EXPECT_TRUE(SplitBlockBloomFilter<>::mayContain(
+      expected.data(), numBlocks, folly::hasher<int32_t>()(10)));
+}
+
+TEST_F(SplitBlockBloomFilterTest, batch) {
+  constexpr int32_t kSize = 1'000;
+  const auto hashes = makeHashes(0, kSize);
+  SplitBlockBloomFilter single;
+  SplitBlockBloomFilter batch;
+  single.reset(kSize);
+  batch.reset(kSize);
+  for (auto hash : hashes) {
+    single.insert(hash);
+  }
+  batch.insert(hashes.data(), hashes.size());
+  EXPECT_EQ(single.blocks(), batch.blocks());
+
+  // Probes with a size that is not a multiple of 64.
+  const auto probes = makeHashes(kSize / 2, kSize * 2 + 17);
+  std::vector<uint64_t> result(bits::nwords(probes.size()), ~0UL);
+  const auto numHits = batch.test(probes.data(), probes.size(), result.data());
+  int32_t expectedHits = 0;
+  for (auto i = 0; i < probes.size(); ++i) {
+    const bool hit = batch.mayContain(probes[i]);
+    expectedHits += hit;
+    ASSERT_EQ(hit, bits::isBitSet(result.data(), i)) << i;
+  }
+  EXPECT_EQ(expectedHits, numHits);
+  EXPECT_LE(kSize / 2, numHits);
+  EXPECT_FALSE(bits::isBitSet(result.data(), probes.size()));
+}
+
+TEST_F(SplitBlockBloomFilterTest, merge) {
+  constexpr int32_t kSize = 1'000;
+  SplitBlockBloomFilter bloom;
+  SplitBlockBloomFilter other;
+  bloom.reset(kSize);
+  other.reset(kSize);
+  const auto hashes = makeHashes(0, kSize);
+  const auto otherHashes = makeHashes(kSize, 2 * kSize);
+  bloom.insert(hashes.data(), hashes.size());
+  other.insert(otherHashes.data(), otherHashes.size());
+  bloom.merge(other);
+  for (auto hash : hashes) {
+    EXPECT_TRUE(bloom.mayContain(hash));
+  }
+  for (auto hash : otherHashes) {
+    EXPECT_TRUE(bloom.mayContain(hash));
+  }
+
+  SplitBlockBloomFilter larger;
+  larger.reset(kSize * 10);
+  EXPECT_THROW(bloom.merge(larger), VeloxRuntimeError);
+}
@@ -20,7 +20,19 @@
 #include "velox/common/caching/SsdCache.h"
 
 #include <folly/executors/QueuedImmediateExecutor.h>
+#include <gflags/gflags.h>
+#include <shared_mutex>
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/common/caching/FileIds.h"
+#include "velox/common/process/TraceTimeline.h"
+#include "velox/common/time/Timer.h"
+
+DEFINE_int32(
+    cache_admission_min_frequency,
+    0,
+    "A new cache entry whose key was accessed fewer times recently is evicted "
+    "before other entries. 0 retains all new entries by their access stats");
 
 namespace facebook::velox::cache {
 
@@ -37,13 +49,19 @@ AsyncDataCacheEntry::~AsyncDataCacheEntry() {
 
 void AsyncDataCacheEntry::setExclusiveToShared() {
   VELOX_CHECK(isExclusive());
-  numPins_ = 1;
   std::unique_ptr<folly::SharedPromise<bool>> promise;
   {
-    std::lock_guard<std::mutex> l(shard_->mutex());
+    std::lock_guard<folly::SharedMutex> l(shard_->mutex());
     // Enter the shard's mutex to make sure a promise is not being added during
     // the move.
     promise = std::move(promise_);
+    // A prefetched entry is admitted on first use.
+    if (!isPrefetch_) {
+      shard_->admitLocked(*this);
+    }
+    // Make the entry shared only after admission so that a lookup holding the
+    // shard mutex in shared mode does not pin an entry that is not admitted.
+    numPins_ = 1;
   }
   if (promise) {
     promise->setValue(true);
@@ -152,14 +170,56 @@ std::unique_ptr<AsyncDataCacheEntry> CacheShard::getFreeEntryWithSize(
   return newEntry;
 }
 
+CachePin CacheShard::findShared(RawFileCacheKey key, uint64_t size) {
+  std::shared_lock<folly::SharedMutex> l(mutex_);
+  auto it = entryMap_.find(key);
+  if (it == entryMap_.end()) {
+    return CachePin();
+  }
+  auto* found = it->second;
+  // Entries are only evicted or removed with 'mutex_' held exclusively, so
+  // 'found' stays valid. Add a pin unless the entry is exclusive. A
+  // successful pin makes the writes done before the entry became shared
+  // visible.
+  auto numPins = found->numPins_.load();
+  do {
+    if (numPins < 0) {
+      return CachePin();
+    }
+  } while (!found->numPins_.compare_exchange_weak(numPins, numPins + 1));
+  if (found->isPrefetch_ || found->size() < size) {
+    // The first use of a prefetched entry and superseding an entry modify
+    // the shard.
+    --found->numPins_;
+    return CachePin();
+  }
+  ++eventCounter_;
+  sketch_.increment(std::hash<RawFileCacheKey>()(key));
+  found->touch();
+  ++numHit_;
+  hitBytes_ += found->size();
+  ++numSharedHits_;
+  CachePin pin;
+  pin.setEntry(found);
+  return pin;
+}
+
 CachePin CacheShard::findOrCreate(
     RawFileCacheKey key,
     uint64_t size,
     folly::SemiFuture<bool>* wait) {
+  if (auto pin = findShared(key, size); !pin.empty()) {
+    return pin;
+  }
   AsyncDataCacheEntry* entryToInit = nullptr;
   {
-    std::lock_guard<std::mutex> l(mutex_);
+    std::unique_lock<folly::SharedMutex> l(mutex_, std::try_to_lock);
+    if (!l.owns_lock()) {
+      l.lock();
+      ++numLockWaits_;
+    }
     ++eventCounter_;
+    sketch_.increment(std::hash<RawFileCacheKey>()(key));
     auto it = entryMap_.find(key);
     if (it != entryMap_.end()) {
       auto found = it->second;
@@ -177,6 +237,7 @@ CachePin CacheShard::findOrCreate(
         if (found->isPrefetch_) {
           found->isFirstUse_ = true;
           found->setPrefetch(false);
+          admitLocked(*found);
         } else {
           ++numHit_;
           hitBytes_ += found->size();
@@ -213,12 +274,31 @@ CachePin CacheShard::findOrCreate(
     VELOX_CHECK_EQ(0, entryToInit->size_);
     entryToInit->size_ = size;
     entryToInit->isFirstUse_ = true;
+    entryToInit->scanOnce_ = false;
   }
   return initEntry(key, entryToInit);
 }
 
+void CacheShard::admitLocked(AsyncDataCacheEntry& entry) {
+  auto minFrequency = FLAGS_cache_admission_min_frequency;
+  if (entry.scanOnce_) {
+    minFrequency = std::max(minFrequency, kScanOnceMinFrequency);
+  }
+  if (minFrequency <= 1 || !entry.key_.fileNum.hasValue()) {
+    return;
+  }
+  const auto frequency = sketch_.estimate(std::hash<RawFileCacheKey>()(
+      RawFileCacheKey{entry.key_.fileNum.id(), entry.key_.offset}));
+  if (frequency >= minFrequency) {
+    return;
+  }
+  entry.makeEvictable();
+  ++numAdmissionRejects_;
+  REPORT_ADD_STAT_VALUE(kCounterMemoryCacheNumAdmissionRejects);
+}
+
 bool CacheShard::exists(RawFileCacheKey key) const {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard<folly::SharedMutex> l(mutex_);
   auto it = entryMap_.find(key);
   if (it != entryMap_.end()) {
     it->second->touch();
@@ -269,6 +349,7 @@ bool CoalescedLoad::loadOrFuture(folly::SemiFuture<bool>* wait) {
     state_ = LoadState::kLoading;
   }
   // Outside of 'mutex_'.
+  process::TraceEvent traceEvent("io", wait ? "Load" : "Prefetch", size());
   try {
     auto pins = loadData(!wait);
     for (auto& pin : pins) {
@@ -300,7 +381,7 @@ void CoalescedLoad::setEndState(LoadState endState) {
 
 std::unique_ptr<folly::SharedPromise<bool>> CacheShard::removeEntry(
     AsyncDataCacheEntry* entry) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard<folly::SharedMutex> l(mutex_);
   removeEntryLocked(entry);
   // After the entry is removed from the hash table, a promise can no longer
   // be made. It is safe to move the promise and realize it.
@@ -340,7 +421,7 @@ void CacheShard::evict(uint64_t bytesToFree, bool evictAllUnpinned) {
   auto now = accessTime();
   std::vector<memory::Allocation> toFree;
   {
-    std::lock_guard<std::mutex> l(mutex_);
+    std::lock_guard<folly::SharedMutex> l(mutex_);
     int size = entries_.size();
     if (!size) {
       return;
@@ -452,7 +533,7 @@ void CacheShard::calibrateThreshold() {
 }
 
 void CacheShard::updateStats(CacheStats& stats) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard<folly::SharedMutex> l(mutex_);
   for (auto& entry : entries_) {
     if (!entry || !entry->key_.fileNum.hasValue()) {
       ++stats.numEmptyEntries;
@@ -479,11 +560,14 @@ void CacheShard::updateStats(CacheStats& stats) {
   stats.numEvictChecks += numEvictChecks_;
   stats.numWaitExclusive += numWaitExclusive_;
   stats.sumEvictScore += sumEvictScore_;
+  stats.numAdmissionRejects += numAdmissionRejects_;
+  stats.numSharedHits += numSharedHits_;
+  stats.numLockWaits += numLockWaits_;
   stats.allocClocks += allocClocks_;
 }
 
 void CacheShard::appendSsdSaveable(std::vector<CachePin>& pins) {
-  std::lock_guard<std::mutex> l(mutex_);
+  std::lock_guard<folly::SharedMutex> l(mutex_);
   // Do not add more than 70% of entries to a write batch.If SSD save
   // is slower than storage read, we must not have a situation where
   // SSD save pins everything and stops reading.
@@ -505,6 +589,33 @@ void CacheShard::appendSsdSaveable(std::vector<CachePin>& pins) {
   }
 }
 
+uint64_t CacheShard::markSsdSaveable() {
+  auto& groupStats = cache_->ssdCache()->groupStats();
+  uint64_t bytes = 0;
+  std::lock_guard<folly::SharedMutex> l(mutex_);
+  for (auto& entry : entries_) {
+    if (entry && entry->key_.fileNum.hasValue() && !entry->ssdFile_ &&
+        !entry->isExclusive() && !entry->ssdSaveable_ &&
+        groupStats.shouldSaveToSsd(entry->groupId_, entry->trackingId_)) {
+      entry->ssdSaveable_ = true;
+      bytes += entry->size_;
+    }
+  }
+  return bytes;
+}
+
+uint64_t CacheShard::appendFileIds(folly::F14FastSet<uint64_t>& fileIds) {
+  uint64_t bytes = 0;
+  std::lock_guard<folly::SharedMutex> l(mutex_);
+  for (auto& entry : entries_) {
+    if (entry && entry->key_.fileNum.hasValue()) {
+      fileIds.insert(entry->key_.fileNum.id());
+      bytes += entry->size_;
+    }
+  }
+  return bytes;
+}
+
 AsyncDataCache::AsyncDataCache(
     memory::MemoryAllocator* allocator,
     std::unique_ptr<SsdCache> ssdCache)
@@ -564,7 +675,15 @@ CachePin AsyncDataCache::findOrCreate(
     uint64_t size,
     folly::SemiFuture<bool>* wait) {
   int shard = std::hash<RawFileCacheKey>()(key) & (kShardMask);
-  return shards_[shard]->findOrCreate(key, size, wait);
+  auto pin = shards_[shard]->findOrCreate(key, size, wait);
+  if (!pin.empty()) {
+    if (pin.checkedEntry()->isExclusive()) {
+      REPORT_ADD_STAT_VALUE(kCounterMemoryCacheNumMisses);
+    } else {
+      REPORT_ADD_STAT_VALUE(kCounterMemoryCacheNumHits);
+    }
+  }
+  return pin;
 }
 
 bool AsyncDataCache::exists(RawFileCacheKey key) const {
@@ -670,6 +789,7 @@ void AsyncDataCache::incrementNew(uint64_t size) {
         std::max<int64_t>(cachedPages_ * memory::AllocationTraits::kPageSize,
                           1UL << 28);
     ssdCache_->groupStats().updateSsdFilter(ssdCache_->maxBytes() * 0.9);
+    promoteToSsd();
   }
 }
 
@@ -700,6 +820,167 @@ void AsyncDataCache::saveToSsd() {
   ssdCache_->write(std::move(pins));
 }
 
+void AsyncDataCache::promoteToSsd() {
+  if (!ssdCache_) {
+    return;
+  }
+  uint64_t bytes = 0;
+  for (auto& shard : shards_) {
+    bytes += shard->markSsdSaveable();
+  }
+  if (bytes > 0) {
+    possibleSsdSave(bytes);
+  }
+}
+
+std::shared_ptr<const CacheSummary> AsyncDataCache::summary(
+    uint64_t maxAgeMs) {
+  std::lock_guard<std::mutex> l(summaryMutex_);
+  const auto nowMs = getCurrentTimeMs();
+  if (!summary_ || nowMs - summaryTimeMs_ > maxAgeMs) {
+    summary_ = makeSummary();
+    summaryTimeMs_ = nowMs;
+  }
+  return summary_;
+}
+
+std::shared_ptr<const CacheSummary> AsyncDataCache::makeSummary() {
+  auto summary = std::make_shared<CacheSummary>();
+  folly::F14FastSet<uint64_t> ids;
+  for (auto& shard : shards_) {
+    summary->memoryBytes += shard->appendFileIds(ids);
+  }
+  if (ssdCache_) {
+    for (auto& entry : ssdCache_->scoredEntries()) {
+      ids.insert(entry.key.fileNum);
+      summary->ssdBytes += entry.run.size();
+    }
+  }
+  summary->files.reset(std::max<int32_t>(1, ids.size()));
+  for (auto id : ids) {
+    // The file may have been evicted after its id was collected.
+    auto name = fileIds().string(id);
+    if (!name.empty()) {
+      summary->files.insert(CacheSummary::hashFileName(name));
+      ++summary->numFiles;
+    }
+  }
+  return summary;
+}
+
+folly::SemiFuture<uint64_t> AsyncDataCache::warmUpFromSsd(
+    folly::Executor* executor,
+    uint64_t maxBytes,
+    uint64_t maxBytesPerSecond) {
+  if (!ssdCache_ || maxBytes == 0) {
+    return folly::makeSemiFuture<uint64_t>(0);
+  }
+  return folly::via(executor, [this, maxBytes, maxBytesPerSecond]() {
+           return loadHottestFromSsd(maxBytes, maxBytesPerSecond);
+         })
+      .semi();
+}
+
+uint64_t AsyncDataCache::loadHottestFromSsd(
+    uint64_t maxBytes,
+    uint64_t maxBytesPerSecond) {
+  constexpr int32_t kMaxBatchEntries = 64;
+  constexpr uint64_t kMaxBatchBytes = 8 << 20;
+  auto entries = ssdCache_->scoredEntries();
+  std::sort(
+      entries.begin(),
+      entries.end(),
+      [](const ScoredSsdEntry& left, const ScoredSsdEntry& right) {
+        return left.score > right.score;
+      });
+  std::vector<ScoredSsdEntry> selected;
+  uint64_t selectedBytes = 0;
+  for (auto& entry : entries) {
+    if (entry.run.compressed()) {
+      continue;
+    }
+    if (selectedBytes + entry.run.size() > maxBytes) {
+      break;
+    }
+    selectedBytes += entry.run.size();
+    selected.push_back(entry);
+  }
+  // Read the selected entries file by file in offset order so that the reads
+  // coalesce.
+  auto fileOf = [&](const ScoredSsdEntry& entry) {
+    return &ssdCache_->file(entry.key.fileNum);
+  };
+  std::sort(
+      selected.begin(),
+      selected.end(),
+      [&](const ScoredSsdEntry& left, const ScoredSsdEntry& right) {
+        const auto leftFile = fileOf(left)->shardId();
+        const auto rightFile = fileOf(right)->shardId();
+        return leftFile < rightFile ||
+            (leftFile == rightFile &&
+             left.run.offset() < right.run.offset());
+      });
+
+  const auto startUs = getCurrentTimeMicro();
+  uint64_t loadedBytes = 0;
+  int32_t begin = 0;
+  while (begin < selected.size()) {
+    auto* file = fileOf(selected[begin]);
+    std::vector<RawFileCacheKey> keys;
+    std::vector<int32_t> sizes;
+    uint64_t batchBytes = 0;
+    for (; begin < selected.size() && keys.size() < kMaxBatchEntries &&
+         batchBytes < kMaxBatchBytes && fileOf(selected[begin]) == file;
+         ++begin) {
+      keys.push_back(selected[begin].key);
+      sizes.push_back(selected[begin].run.size());
+      batchBytes += sizes.back();
+    }
+
+    std::vector<SsdPin> ssdPins;
+    std::vector<CachePin> pins;
+    makePins(
+        keys,
+        [&](int32_t index) { return sizes[index]; },
+        [&](int32_t index, CachePin pin) {
+          // The entry may have been evicted from SSD after it was listed.
+          auto ssdPin = file->find(keys[index]);
+          if (ssdPin.empty() ||
+              !ssdPin.run().covers(pin.checkedEntry()->size())) {
+            return;
+          }
+          pin.checkedEntry()->setPrefetch(true);
+          ssdPins.push_back(std::move(ssdPin));
+          pins.push_back(std::move(pin));
+        });
+    if (pins.empty()) {
+      continue;
+    }
+    try {
+      file->load(ssdPins, pins);
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "SSDCA: Error in warming up from SSD: " << e.what();
+      continue;
+    }
+    for (auto& pin : pins) {
+      loadedBytes += pin.checkedEntry()->size();
+      pin.checkedEntry()->setExclusiveToShared();
+    }
+
+    if (maxBytesPerSecond > 0) {
+      const auto targetUs = loadedBytes * 1'000'000 / maxBytesPerSecond;
+      const auto elapsedUs = getCurrentTimeMicro() - startUs;
+      if (targetUs > elapsedUs) {
+        std::this_thread::sleep_for(
+            std::chrono::microseconds(targetUs - elapsedUs)); // NOLINT
+      }
+    }
+  }
+  LOG(INFO) << "SSDCA: Warmed up " << loadedBytes << " bytes from SSD in "
+            << getCurrentTimeMicro() - startUs << " us";
+  return loadedBytes;
+}
+
 CacheStats AsyncDataCache::refreshStats() const {
   CacheStats stats;
   for (auto& shard : shards_) {
@@ -725,7 +1006,9 @@ std::string AsyncDataCache::toString() const {
           stats.largePadding
       << " bytes\n"
       << "Miss: " << stats.numNew << " Hit " << stats.numHit << " evict "
-      << stats.numEvict << "\n"
+      << stats.numEvict << " admission rejects " << stats.numAdmissionRejects
+      << " shared hits " << stats.numSharedHits << " lock waits "
+      << stats.numLockWaits << "\n"
       << " read pins " << stats.numShared << " write pins "
       << stats.numExclusive << " unused prefetch " << stats.numPrefetch
       << " Alloc Megaclocks " << (stats.allocClocks >> 20)
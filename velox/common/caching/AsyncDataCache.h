@@ -19,18 +19,25 @@
 #include <deque>
 
 #include <fmt/format.h>
+#include <folly/SharedMutex.h>
 #include <folly/chrono/Hardware.h>
+#include <folly/container/F14Set.h>
 #include <folly/futures/SharedPromise.h>
+#include <gflags/gflags.h>
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/CoalesceIo.h"
 #include "velox/common/base/Portability.h"
 #include "velox/common/base/SelectivityInfo.h"
+#include "velox/common/caching/CacheSummary.h"
 #include "velox/common/caching/FileGroupStats.h"
+#include "velox/common/caching/FrequencySketch.h"
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/caching/StringIdMap.h"
 #include "velox/common/file/File.h"
 #include "velox/common/memory/MemoryAllocator.h"
 
+DECLARE_int32(cache_admission_min_frequency);
+
 namespace facebook::velox::cache {
 
 class AsyncDataCache;
@@ -53,9 +60,11 @@ inline AccessTime accessTime() {
   return folly::hardware_timestamp() >> 21;
 }
 
+// The fields are updated by concurrent readers holding the shard mutex in
+// shared mode, so they are relaxed atomics.
 struct AccessStats {
-  AccessTime lastUse{0};
-  int32_t numUses{0};
+  std::atomic<AccessTime> lastUse{0};
+  std::atomic<int32_t> numUses{0};
 
   // Retention score. A higher number means less worth retaining. This
   // works well with a typical formula of time over use count going to
@@ -64,24 +73,25 @@ struct AccessStats {
   // expensive and many entries are checked one after the other. lastUse == 0
   // means explicitly evictable.
   int32_t score(AccessTime now, uint64_t /*size*/) const {
-    if (!lastUse) {
+    const auto last = lastUse.load(std::memory_order_relaxed);
+    if (!last) {
       return std::numeric_limits<int32_t>::max();
     }
-    return (now - lastUse) / (1 + numUses);
+    return (now - last) / (1 + numUses.load(std::memory_order_relaxed));
   }
 
   // Resets the access tracking to not accessed. This is used after
   // evicting the previous contents of the entry, so that the new data
   // does not inherit the history of the previous.
   void reset() {
-    lastUse = accessTime();
-    numUses = 0;
+    lastUse.store(accessTime(), std::memory_order_relaxed);
+    numUses.store(0, std::memory_order_relaxed);
   }
 
   // Updates the last access.
   void touch() {
-    lastUse = accessTime();
-    ++numUses;
+    lastUse.store(accessTime(), std::memory_order_relaxed);
+    numUses.fetch_add(1, std::memory_order_relaxed);
   }
 };
 
@@ -238,9 +248,20 @@ class AsyncDataCacheEntry {
     groupId_ = groupId;
   }
 
+  uint64_t groupId() const {
+    return groupId_;
+  }
+
   /// Sets access stats so that this is immediately evictable.
   void makeEvictable();
 
+  /// Marks 'this' as loaded by a scan that reads its data once, see
+  /// ScanTracker::setScanOnce(). Such an entry is retained only if its key has
+  /// been accessed before. Must be set before setExclusiveToShared().
+  void setScanOnce(bool scanOnce) {
+    scanOnce_ = scanOnce;
+  }
+
   // Moves the promise out of 'this'. Used in order to handle the
   // promise within the lock of the cache shard, so not within private
   // methods of 'this'.
@@ -293,6 +314,9 @@ class AsyncDataCacheEntry {
   // statistics only.
   std::atomic<bool> isFirstUse_{false};
 
+  // True if loaded by a scan that reads its data once.
+  bool scanOnce_{false};
+
   // Group id. Used for deciding if 'this' should be written to SSD.
   uint64_t groupId_{0};
 
@@ -503,6 +527,14 @@ struct CacheStats {
   // Sum of scores of evicted entries. This serves to infer an average
   // lifetime for entries in cache.
   int64_t sumEvictScore{};
+  // Number of new entries that were made immediately evictable because their
+  // keys were not accessed often enough recently.
+  int64_t numAdmissionRejects{};
+  // Number of hits served with the shard mutex held in shared mode.
+  int64_t numSharedHits{};
+  // Number of times a lookup found the shard mutex held and had to wait for
+  // exclusive access.
+  int64_t numLockWaits{};
 
   std::shared_ptr<SsdCacheStats> ssdStats = nullptr;
 };
@@ -513,7 +545,8 @@ struct CacheStats {
 /// and other housekeeping.
 class CacheShard {
  public:
-  explicit CacheShard(AsyncDataCache* FOLLY_NONNULL cache) : cache_(cache) {}
+  explicit CacheShard(AsyncDataCache* FOLLY_NONNULL cache)
+      : cache_(cache), sketch_(kSketchWidth) {}
 
   /// See AsyncDataCache::findOrCreate.
   CachePin findOrCreate(
@@ -528,7 +561,7 @@ class CacheShard {
     return cache_;
   }
 
-  std::mutex& mutex() {
+  folly::SharedMutex& mutex() {
     return mutex_;
   }
 
@@ -559,16 +592,43 @@ class CacheShard {
   // calling this a second time.
   void appendSsdSaveable(std::vector<CachePin>& pins);
 
+  // Sets 'ssdSaveable_' for shared and unpinned entries that are not on SSD
+  // and qualify by the FileGroupStats of the SsdCache. Returns the bytes of
+  // the newly saveable entries.
+  uint64_t markSsdSaveable();
+
+  // Adds the file ids of the entries of 'this' to 'fileIds'. Returns the bytes
+  // of the entries.
+  uint64_t appendFileIds(folly::F14FastSet<uint64_t>& fileIds);
+
   auto& allocClocks() {
     return allocClocks_;
   }
 
+  // Decides if 'entry' is retained by its access stats or made immediately
+  // evictable. This is done when a newly loaded entry becomes shared or, for a
+  // prefetched entry, on its first use. An entry whose key has fewer recent
+  // accesses than FLAGS_cache_admission_min_frequency, or fewer than 2 if
+  // loaded by a scan-once scan, is made evictable. A later hit makes it
+  // retained again. Must be called inside 'mutex_'.
+  void admitLocked(AsyncDataCacheEntry& entry);
+
  private:
   static constexpr uint32_t kMaxFreeEntries = 1 << 10;
   static constexpr int32_t kNoThreshold = std::numeric_limits<int32_t>::max();
+  // Number of counters per row of 'sketch_'.
+  static constexpr int32_t kSketchWidth = 1 << 16;
+  // Minimum access count for retaining an entry of a scan-once scan.
+  static constexpr int32_t kScanOnceMinFrequency = 2;
 
   void calibrateThreshold();
 
+  // Pins the entry for 'key' in shared mode if it is readable, not a
+  // prefetched entry on first use and at least 'size' bytes. Holds 'mutex_' in
+  // shared mode so that hits on shared entries do not serialize. Returns an
+  // empty pin if the lookup must proceed with 'mutex_' held exclusively.
+  CachePin findShared(RawFileCacheKey key, uint64_t size);
+
   void removeEntryLocked(AsyncDataCacheEntry* entry);
 
   // Returns an unused entry if found. 'size' is a hint for selecting an entry
@@ -581,7 +641,9 @@ class CacheShard {
 
   void tryAddFreeEntry(std::unique_ptr<AsyncDataCacheEntry>&& entry);
 
-  mutable std::mutex mutex_;
+  // Held exclusively for any change of 'entryMap_' and 'entries_' and for
+  // eviction. Lookups that hit a shared entry hold it in shared mode.
+  mutable folly::SharedMutex mutex_;
   folly::F14FastMap<RawFileCacheKey, AsyncDataCacheEntry*> entryMap_;
   // Entries associated to a key.
   std::deque<std::unique_ptr<AsyncDataCacheEntry>> entries_;
@@ -594,13 +656,17 @@ class CacheShard {
   // Index in 'entries_' for the next eviction candidate.
   uint32_t clockHand_{};
   // Number of gets  since last stats sampling.
-  uint32_t eventCounter_{};
+  std::atomic<uint32_t> eventCounter_{};
   // Maximum retainable entry score(). Anything above this is evictable.
   int32_t evictionThreshold_{kNoThreshold};
   // Cumulative count of cache hits.
-  uint64_t numHit_{};
+  std::atomic<uint64_t> numHit_{};
   // Sum of bytes in cache hits.
-  uint64_t hitBytes_{};
+  std::atomic<uint64_t> hitBytes_{};
+  // Cumulative count of hits served by findShared().
+  std::atomic<uint64_t> numSharedHits_{};
+  // Cumulative count of lookups that waited for exclusive 'mutex_'.
+  uint64_t numLockWaits_{};
   // Cumulative count of hits on entries held in exclusive mode.
   uint64_t numWaitExclusive_{};
   // Cumulative count of new entry creation.
@@ -616,6 +682,10 @@ class CacheShard {
   // Tracker of time spent in allocating/freeing MemoryAllocator space
   // for backing cached data.
   std::atomic<uint64_t> allocClocks_;
+  // Recent access counts by key for admission.
+  FrequencySketch sketch_;
+  // Count of new entries made evictable by admitLocked().
+  uint64_t numAdmissionRejects_{};
 };
 
 class AsyncDataCache : public memory::Cache {
@@ -741,6 +811,30 @@ class AsyncDataCache : public memory::Cache {
   // Saves all entries with 'ssdSaveable_' to 'ssdCache_'.
   void saveToSsd();
 
+  // Marks the entries in memory that are not on SSD and that qualify for SSD
+  // by the current FileGroupStats of 'ssdCache_' as saveable. Starts a write
+  // to SSD if enough bytes are saveable. This writes data that has become
+  // hot since it was loaded to SSD before it is evicted, so that it is found
+  // on SSD after a restart. Called after each update of the SSD filter.
+  void promoteToSsd();
+
+  // Loads the entries of 'ssdCache_' with the highest region access scores
+  // into memory until 'maxBytes' are loaded. Used after a restart that
+  // recovered the SSD cache from checkpoints, so that the first queries do
+  // not have to wait for memory to refill. Reads at most 'maxBytesPerSecond'
+  // if this is non-0, so that warm-up does not starve other IO. Runs on
+  // 'executor' and returns the number of bytes loaded. Compressed SSD entries
+  // are skipped since their size in memory is not known without reading them.
+  /// Returns a summary of the files cached in memory and on SSD for routing
+  /// splits to workers that cache their files. The summary is remade if the
+  /// previous one is older than 'maxAgeMs'.
+  std::shared_ptr<const CacheSummary> summary(uint64_t maxAgeMs = 10'000);
+
+  folly::SemiFuture<uint64_t> warmUpFromSsd(
+      folly::Executor* FOLLY_NONNULL executor,
+      uint64_t maxBytes,
+      uint64_t maxBytesPerSecond = 0);
+
   tsan_atomic<int32_t>& numSkippedSaves() {
     return numSkippedSaves_;
   }
@@ -751,6 +845,11 @@ class AsyncDataCache : public memory::Cache {
 
   static AsyncDataCache** getInstancePtr();
 
+  std::shared_ptr<const CacheSummary> makeSummary();
+
+  // Synchronous part of warmUpFromSsd().
+  uint64_t loadHottestFromSsd(uint64_t maxBytes, uint64_t maxBytesPerSecond);
+
   // Waits a pseudorandom delay times 'counter'.
   void backoff(int32_t counter);
 
@@ -780,6 +879,12 @@ class AsyncDataCache : public memory::Cache {
   // busy with write.
   tsan_atomic<int32_t> numSkippedSaves_{0};
 
+  // Serializes making 'summary_'.
+  std::mutex summaryMutex_;
+  std::shared_ptr<const CacheSummary> summary_;
+  // Time of making 'summary_'.
+  uint64_t summaryTimeMs_{0};
+
   // Used for pseudorandom backoff after failed allocation
   // attempts. Serialization with a mutex is not allowed for
   // allocations, so use backoff.
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/common/caching/CacheSummary.h"
+
+#include <folly/hash/SpookyHashV2.h>
+
+namespace facebook::velox::cache {
+
+namespace {
+constexpr int8_t kCacheSummaryV1 = 1;
+constexpr int32_t kHeaderSize = sizeof(int8_t) + sizeof(int32_t) +
+    2 * sizeof(uint64_t);
+} // namespace
+
+// static
+uint64_t CacheSummary::hashFileName(std::string_view fileName) {
+  return folly::hash::SpookyHashV2::Hash64(fileName.data(), fileName.size(), 0);
+}
+
+std::string CacheSummary::serialize() const {
+  std::string result(kHeaderSize + files.serializedSize(), '\0');
+  common::OutputByteStream stream(result.data());
+  stream.appendOne(kCacheSummaryV1);
+  stream.appendOne(numFiles);
+  stream.appendOne(memoryBytes);
+  stream.appendOne(ssdBytes);
+  files.serialize(result.data() + stream.offset());
+  return result;
+}
+
+// static
+CacheSummary CacheSummary::deserialize(std::string_view serialized) {
+  VELOX_CHECK_GE(serialized.size(), kHeaderSize);
+  common::InputByteStream stream(serialized.data());
+  VELOX_CHECK_EQ(kCacheSummaryV1, stream.read<int8_t>());
+  CacheSummary summary;
+  summary.numFiles = stream.read<int32_t>();
+  summary.memoryBytes = stream.read<uint64_t>();
+  summary.ssdBytes = stream.read<uint64_t>();
+  summary.files.merge(serialized.data() + stream.offset());
+  return summary;
+}
+
+} // namespace facebook::velox::cache
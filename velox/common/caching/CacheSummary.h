@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "velox/common/base/BloomFilter.h"
+
+namespace facebook::velox::cache {
+
+// Summary of the files that have data in an AsyncDataCache, in memory or on
+// SSD. A scheduler can use the summaries of its workers to send splits of a
+// file to a worker that already caches the file. File names are hashed with a
+// stable hash, so that the summary can be checked with a file path without
+// knowing the file ids of the worker.
+struct CacheSummary {
+  // Returns the hash of 'fileName' as inserted into 'files'.
+  static uint64_t hashFileName(std::string_view fileName);
+
+  // Returns true if 'fileName' may have data in the cache. False positives
+  // are possible.
+  bool mayContain(std::string_view fileName) const {
+    return files.isSet() && files.mayContain(hashFileName(fileName));
+  }
+
+  std::string serialize() const;
+
+  static CacheSummary deserialize(std::string_view serialized);
+
+  // Filter over the hashes of the names of the cached files.
+  BloomFilter<> files;
+  // Number of distinct cached files.
+  int32_t numFiles{0};
+  // Bytes of cached data in memory and on SSD.
+  uint64_t memoryBytes{0};
+  uint64_t ssdBytes{0};
+};
+
+} // namespace facebook::velox::cache
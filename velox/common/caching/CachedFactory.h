@@ -25,6 +25,7 @@
 
 #pragma once
 
+#include <array>
 #include <condition_variable>
 #include <functional>
 #include <memory>
@@ -52,14 +53,21 @@ class CachedFactory {
   // i.e. the cache is large compared to the size of the elements and the number
   // of elements that are pinned. Everything should still work if this is not
   // true, but performance will suffer.
+  //
+  // If 'isValid' is set, a cached value for which it returns false, e.g. an
+  // expired one, is removed from the cache and generated again.
   CachedFactory(
       std::unique_ptr<SimpleLRUCache<Key, Value>> cache,
-      std::unique_ptr<Generator> generator)
-      : cache_(std::move(cache)), generator_(std::move(generator)) {}
+      std::unique_ptr<Generator> generator,
+      std::function<bool(const Value&)> isValid = nullptr)
+      : cache_(std::move(cache)),
+        generator_(std::move(generator)),
+        isValid_(std::move(isValid)) {}
 
   // Returns the generator's output on the given key. If the output is
   // in the cache, returns immediately. Otherwise, blocks until the output
-  // is ready.
+  // is ready. Concurrent calls for the same key run the generator once.
+  // Calls for keys in different pending shards do not wait for each other.
   // The function returns a pair. The boolean in the pair indicates whether a
   // cache hit or miss. The Value is the generator output for the key if cache
   // miss, or Value in the cache if cache hit.
@@ -102,38 +110,67 @@ class CachedFactory {
   CachedFactory& operator=(const CachedFactory&) = delete;
 
  private:
+  // The keys being generated, partitioned on the hash of the key. A call
+  // waits only for the generation of keys in the same shard.
+  struct PendingShard {
+    folly::F14FastSet<Key> keys;
+    std::mutex mu;
+    std::condition_variable cv;
+  };
+
+  static constexpr int32_t kNumPendingShards = 32;
+
+  PendingShard& pendingShard(const Key& key) {
+    return pending_[std::hash<Key>()(key) % kNumPendingShards];
+  }
+
+  // Returns the cached value for 'key'. Removes the value if it is not
+  // valid. Must be called with 'cacheMu_' held.
+  std::optional<Value> getCachedLocked(const Key& key);
+
   std::unique_ptr<SimpleLRUCache<Key, Value>> cache_;
   std::unique_ptr<Generator> generator_;
-  folly::F14FastSet<Key> pending_;
+  const std::function<bool(const Value&)> isValid_;
+  std::array<PendingShard, kNumPendingShards> pending_;
 
   std::mutex cacheMu_;
-  std::mutex pendingMu_;
-  std::condition_variable pendingCv_;
 };
 
 //
 // End of public API. Implementation follows.
 //
 
+template <typename Key, typename Value, typename Generator>
+std::optional<Value> CachedFactory<Key, Value, Generator>::getCachedLocked(
+    const Key& key) {
+  auto value = cache_->get(key);
+  if (value && isValid_ && !isValid_(value.value())) {
+    cache_->remove(key);
+    return std::nullopt;
+  }
+  return value;
+}
+
 template <typename Key, typename Value, typename Generator>
 std::pair<bool, Value> CachedFactory<Key, Value, Generator>::generate(
     const Key& key) {
   process::TraceContext trace("CachedFactory::generate");
-  std::unique_lock<std::mutex> pending_lock(pendingMu_);
+  auto& shard = pendingShard(key);
+  std::unique_lock<std::mutex> pending_lock(shard.mu);
   {
     std::lock_guard<std::mutex> cache_lock(cacheMu_);
-    auto value = cache_->get(key);
+    auto value = getCachedLocked(key);
     if (value) {
       return std::make_pair(true, value.value());
     }
   }
 
-  if (pending_.contains(key)) {
-    pendingCv_.wait(pending_lock, [&]() { return !pending_.contains(key); });
+  if (shard.keys.contains(key)) {
+    shard.cv.wait(pending_lock, [&]() { return !shard.keys.contains(key); });
     // Will normally hit the cache now.
     {
       std::lock_guard<std::mutex> cache_lock(cacheMu_);
-      auto value = cache_->get(key);
+      auto value = getCachedLocked(key);
       if (value) {
         return std::make_pair(true, value.value());
       }
@@ -141,7 +178,7 @@ std::pair<bool, Value> CachedFactory<Key, Value, Generator>::generate(
     pending_lock.unlock();
     return generate(key); // Regenerate in the edge case.
   } else {
-    pending_.insert(key);
+    shard.keys.insert(key);
     pending_lock.unlock();
     Value generatedValue;
     // TODO: consider using folly/ScopeGuard here.
@@ -149,10 +186,10 @@ std::pair<bool, Value> CachedFactory<Key, Value, Generator>::generate(
       generatedValue = (*generator_)(key);
     } catch (const std::exception& e) {
       {
-        std::lock_guard<std::mutex> pending_lock(pendingMu_);
-        pending_.erase(key);
+        std::lock_guard<std::mutex> pending_lock(shard.mu);
+        shard.keys.erase(key);
       }
-      pendingCv_.notify_all();
+      shard.cv.notify_all();
       throw;
     }
     cacheMu_.lock();
@@ -163,10 +200,10 @@ std::pair<bool, Value> CachedFactory<Key, Value, Generator>::generate(
     // inconsistent state. Eventually this code should move to
     // folly:synchronized and rewritten with better primitives.
     {
-      std::lock_guard<std::mutex> pending_lock(pendingMu_);
-      pending_.erase(key);
+      std::lock_guard<std::mutex> pending_lock(shard.mu);
+      shard.keys.erase(key);
     }
-    pendingCv_.notify_all();
+    shard.cv.notify_all();
     return std::make_pair(false, generatedValue);
   }
 }
@@ -178,7 +215,7 @@ void CachedFactory<Key, Value, Generator>::retrieveCached(
     std::vector<Key>* missing) {
   std::lock_guard<std::mutex> cache_lock(cacheMu_);
   for (const Key& key : keys) {
-    auto value = cache_->get(key);
+    auto value = getCachedLocked(key);
     if (value) {
       cached->emplace_back(key, value.value());
     } else {
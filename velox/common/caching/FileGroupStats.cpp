@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/common/caching/FileGroupStats.h"
+
+#include <algorithm>
+#include <sstream>
+
+namespace facebook::velox::cache {
+
+void FileGroupStats::recordReference(
+    uint64_t /*fileId*/,
+    uint64_t groupId,
+    TrackingId trackingId,
+    int32_t bytes) {
+  std::lock_guard<std::mutex> l(mutex_);
+  streams_[StreamKey{groupId, trackingId}].incrementReference(bytes, 0);
+}
+
+void FileGroupStats::recordRead(
+    uint64_t /*fileId*/,
+    uint64_t groupId,
+    TrackingId trackingId,
+    int32_t bytes) {
+  std::lock_guard<std::mutex> l(mutex_);
+  streams_[StreamKey{groupId, trackingId}].incrementRead(bytes);
+}
+
+void FileGroupStats::recordFile(
+    uint64_t /*fileId*/,
+    uint64_t groupId,
+    int32_t numStripes) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto& group = groups_[groupId];
+  ++group.numFiles;
+  group.numStripes += numStripes;
+}
+
+bool FileGroupStats::shouldSaveToSsd(uint64_t groupId, TrackingId trackingId)
+    const {
+  const StreamKey key{groupId, trackingId};
+  std::lock_guard<std::mutex> l(mutex_);
+  if (!hasSsdFilter_ || ssdStreams_.count(key)) {
+    return true;
+  }
+  return streams_.count(key) == 0;
+}
+
+TrackingData FileGroupStats::trackingData(
+    uint64_t groupId,
+    TrackingId trackingId) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = streams_.find(StreamKey{groupId, trackingId});
+  if (it == streams_.end()) {
+    return TrackingData();
+  }
+  auto data = it->second;
+  // References are counted once per region and reads once per load quantum,
+  // so a densely read large stream can have more reads than references.
+  data.numReads = std::min(data.numReads, data.numReferences);
+  return data;
+}
+
+void FileGroupStats::updateSsdFilter(uint64_t ssdSize, int32_t decayPct) {
+  std::lock_guard<std::mutex> l(mutex_);
+  std::vector<std::pair<StreamKey, int64_t>> candidates;
+  candidates.reserve(streams_.size());
+  uint64_t totalBytes = 0;
+  for (auto& [key, data] : streams_) {
+    if (data.readBytes > 0) {
+      candidates.emplace_back(key, data.readBytes);
+      totalBytes += data.readBytes;
+    }
+  }
+  ssdStreams_.clear();
+  hasSsdFilter_ = totalBytes > ssdSize;
+  if (hasSsdFilter_) {
+    std::sort(
+        candidates.begin(),
+        candidates.end(),
+        [](const auto& left, const auto& right) {
+          return left.second > right.second;
+        });
+    uint64_t selectedBytes = 0;
+    for (auto& [key, bytes] : candidates) {
+      if (selectedBytes + bytes > ssdSize) {
+        break;
+      }
+      selectedBytes += bytes;
+      ssdStreams_.insert(key);
+    }
+  }
+
+  if (decayPct > 0) {
+    const auto keepPct = 100 - std::min(decayPct, 100);
+    for (auto it = streams_.begin(); it != streams_.end();) {
+      auto& data = it->second;
+      data.referencedBytes = data.referencedBytes * keepPct / 100;
+      data.readBytes = data.readBytes * keepPct / 100;
+      data.numReferences = data.numReferences * keepPct / 100;
+      data.numReads = data.numReads * keepPct / 100;
+      if (data.numReferences == 0 && data.numReads == 0) {
+        it = streams_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+}
+
+std::string FileGroupStats::toString(uint64_t cacheBytes) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  uint64_t totalBytes = 0;
+  for (auto& [key, data] : streams_) {
+    totalBytes += data.readBytes;
+  }
+  std::stringstream out;
+  out << "<FileGroupStats: " << groups_.size() << " groups "
+      << streams_.size() << " streams, "
+      << (hasSsdFilter_ ? ssdStreams_.size() : streams_.size())
+      << " selected for SSD, "
+      << std::min<uint64_t>(100, (100 * cacheBytes) / (1 + totalBytes))
+      << "% of " << (totalBytes >> 20) << "MB read fits in "
+      << (cacheBytes >> 20) << "MB>";
+  return out.str();
+}
+
+} // namespace facebook::velox::cache
@@ -16,48 +16,82 @@
 
 #pragma once
 
+#include <folly/container/F14Map.h>
+#include <folly/container/F14Set.h>
+
 #include "velox/common/caching/ScanTracker.h"
 
 namespace facebook::velox::cache {
 
-// Dummy implementation of SsdCache admission stats.
+// Access stats of streams by file group, e.g. partition, and column. These are
+// shared by all scans that use the same SsdCache. They select the data that is
+// worth writing to SSD and predict the access density of streams for scans
+// that have not yet collected their own stats in their ScanTracker.
 class FileGroupStats {
  public:
   // Records ScanTracker::recordReference at group level
   void recordReference(
-      uint64_t /*fileId*/,
-      uint64_t /*groupId*/,
-      TrackingId /*trackingId*/,
-      int32_t /*bytes*/) {}
+      uint64_t fileId,
+      uint64_t groupId,
+      TrackingId trackingId,
+      int32_t bytes);
 
   // Records ScanTracker::recordRead at group level
   void recordRead(
-      uint64_t /*fileId*/,
-      uint64_t /*groupId*/,
-      TrackingId /*trackingId*/,
-      int32_t /*bytes*/) {}
+      uint64_t fileId,
+      uint64_t groupId,
+      TrackingId trackingId,
+      int32_t bytes);
 
   // Records the existence of a distinct file inside 'groupId'
-  void recordFile(
-      uint64_t /*fileId*/,
-      uint64_t /*groupId*/,
-      int32_t /*numStripes*/) {}
+  void recordFile(uint64_t fileId, uint64_t groupId, int32_t numStripes);
 
   // Returns true if groupId, trackingId qualify the data to be cached to SSD.
-  bool shouldSaveToSsd(uint64_t /*groupId*/, TrackingId /*trackingId*/) const {
-    return true;
-  }
+  // All data qualifies until the first updateSsdFilter() and data of streams
+  // without stats always qualifies.
+  bool shouldSaveToSsd(uint64_t groupId, TrackingId trackingId) const;
+
+  // Returns the access stats of 'trackingId' in 'groupId' over all scans.
+  TrackingData trackingData(uint64_t groupId, TrackingId trackingId) const;
 
   // Updates the SSD selection criteria. 'ssdsize' is the capacity,
-  // 'decayPct' gives by how much old accesses are discounted.
-  void updateSsdFilter(uint64_t /*ssdSize*/, int32_t /*decayPct*/ = 0) {}
-
-  // Recalculates the best groups and makes a human readable
-  // summary. 'cacheBytes' is used to compute what fraction of the tracked
-  // working set can be cached in 'cacheBytes'.
-  std::string toString(uint64_t /*cacheBytes*/) {
-    return "<dummy FileGroupStats>";
-  }
+  // 'decayPct' gives by how much old accesses are discounted. Streams are
+  // selected in descending order of bytes read until their bytes read add up
+  // to 'ssdSize'.
+  void updateSsdFilter(uint64_t ssdSize, int32_t decayPct = 0);
+
+  // Makes a human readable summary. 'cacheBytes' is used to compute what
+  // fraction of the tracked working set can be cached in 'cacheBytes'.
+  std::string toString(uint64_t cacheBytes) const;
+
+ private:
+  struct StreamKey {
+    uint64_t groupId;
+    TrackingId trackingId;
+
+    bool operator==(const StreamKey& other) const {
+      return groupId == other.groupId && trackingId == other.trackingId;
+    }
+  };
+
+  struct StreamKeyHasher {
+    size_t operator()(const StreamKey& key) const {
+      return bits::hashMix(key.groupId, key.trackingId.hash());
+    }
+  };
+
+  struct GroupData {
+    int32_t numFiles{0};
+    int64_t numStripes{0};
+  };
+
+  mutable std::mutex mutex_;
+  folly::F14FastMap<StreamKey, TrackingData, StreamKeyHasher> streams_;
+  folly::F14FastMap<uint64_t, GroupData> groups_;
+  // Streams selected by the last updateSsdFilter().
+  folly::F14FastSet<StreamKey, StreamKeyHasher> ssdStreams_;
+  // True after the first updateSsdFilter() that found more data than fits.
+  bool hasSsdFilter_{false};
 };
 
 } // namespace facebook::velox::cache
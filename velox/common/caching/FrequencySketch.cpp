@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/FrequencySketch.h"
+
+#include <algorithm>
+
+#include "velox/common/base/BitUtil.h"
+
+namespace facebook::velox::cache {
+
+namespace {
+// Mixed with the key hash to make independent indices for the rows.
+constexpr uint64_t kRowSeeds[FrequencySketch::kDepth] = {
+    0x9e3779b97f4a7c15ULL,
+    0xc2b2ae3d27d4eb4fULL,
+    0x165667b19e3779f9ULL,
+    0x27d4eb2f165667c5ULL};
+} // namespace
+
+FrequencySketch::FrequencySketch(int32_t width)
+    : mask_(bits::nextPowerOfTwo(std::max<int32_t>(width, 16)) - 1),
+      sampleSize_(10 * (mask_ + 1)),
+      counters_(kDepth * (mask_ + 1)) {}
+
+uint32_t FrequencySketch::index(uint64_t hash, int32_t row) const {
+  return row * (mask_ + 1) + (bits::hashMix(hash, kRowSeeds[row]) & mask_);
+}
+
+int32_t FrequencySketch::increment(uint64_t hash) {
+  uint32_t indices[kDepth];
+  int32_t count = kMaxCount;
+  for (auto row = 0; row < kDepth; ++row) {
+    indices[row] = index(hash, row);
+    count = std::min<int32_t>(
+        count, counters_[indices[row]].load(std::memory_order_relaxed));
+  }
+  if (count < kMaxCount) {
+    for (auto row = 0; row < kDepth; ++row) {
+      auto& counter = counters_[indices[row]];
+      if (counter.load(std::memory_order_relaxed) == count) {
+        counter.store(count + 1, std::memory_order_relaxed);
+      }
+    }
+    ++count;
+  }
+  // Only one of concurrent incrementers sees the count reach 'sampleSize_'.
+  if (numIncrements_.fetch_add(1, std::memory_order_relaxed) + 1 ==
+      sampleSize_) {
+    age();
+  }
+  return count;
+}
+
+int32_t FrequencySketch::estimate(uint64_t hash) const {
+  int32_t count = kMaxCount;
+  for (auto row = 0; row < kDepth; ++row) {
+    count = std::min<int32_t>(
+        count, counters_[index(hash, row)].load(std::memory_order_relaxed));
+  }
+  return count;
+}
+
+void FrequencySketch::age() {
+  for (auto& counter : counters_) {
+    counter.store(
+        counter.load(std::memory_order_relaxed) >> 1,
+        std::memory_order_relaxed);
+  }
+  numIncrements_.store(0, std::memory_order_relaxed);
+  numAgings_.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace facebook::velox::cache
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace facebook::velox::cache {
+
+/// Approximate counts of recent accesses to keys, as used by TinyLFU
+/// admission. This is a count-min sketch with 'kDepth' rows of small
+/// saturating counters. A key maps to one counter in each row and its count is
+/// the smallest of these. An increment only advances the smallest counters of
+/// the key, which reduces the overestimate from colliding keys. After a number
+/// of increments proportional to the width all counters are halved, so that
+/// the counts reflect recent accesses.
+///
+/// The sketch may be updated by concurrent threads. The counters are relaxed
+/// atomics, so that concurrent increments of the same key may be lost. This
+/// only makes the counts more approximate.
+class FrequencySketch {
+ public:
+  static constexpr int32_t kDepth = 4;
+  static constexpr int32_t kMaxCount = 15;
+
+  /// Makes a sketch with 'width' counters per row. 'width' is rounded up to a
+  /// power of 2.
+  explicit FrequencySketch(int32_t width);
+
+  /// Counts an access to the key with 'hash' and returns the new count.
+  int32_t increment(uint64_t hash);
+
+  /// Returns the count of the key with 'hash'.
+  int32_t estimate(uint64_t hash) const;
+
+  /// Returns the number of times the counters have been halved.
+  int64_t numAgings() const {
+    return numAgings_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  // Returns the index in 'counters_' of the counter for 'hash' in 'row'.
+  uint32_t index(uint64_t hash, int32_t row) const;
+
+  // Halves all counters.
+  void age();
+
+  const uint32_t mask_;
+  // Number of increments between agings.
+  const uint64_t sampleSize_;
+  std::atomic<uint64_t> numIncrements_{0};
+  std::atomic<int64_t> numAgings_{0};
+  // 'kDepth' rows of 'mask_ + 1' counters.
+  std::vector<std::atomic<uint8_t>> counters_;
+};
+
+} // namespace facebook::velox::cache
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <folly/container/F14Map.h>
+#include <atomic>
 #include <cstdint>
 #include <mutex>
 
@@ -176,6 +177,18 @@ class ScanTracker {
     return fileGroupStats_;
   }
 
+  // Hints that the scan reads its data once, e.g. a large table scan that
+  // is not expected to be repeated. Cache entries loaded by such a scan are
+  // retained only if the data was accessed before, see
+  // AsyncDataCacheEntry::setScanOnce().
+  void setScanOnce(bool scanOnce) {
+    scanOnce_ = scanOnce;
+  }
+
+  bool scanOnce() const {
+    return scanOnce_;
+  }
+
   std::string toString() const;
 
  private:
@@ -191,6 +204,7 @@ class ScanTracker {
   // size is unlimited.
   const int32_t loadQuantum_;
   FileGroupStats* FOLLY_NULLABLE fileGroupStats_;
+  std::atomic<bool> scanOnce_{false};
 };
 
 } // namespace facebook::velox::cache
@@ -133,6 +133,14 @@ SsdCacheStats SsdCache::stats() const {
   return stats;
 }
 
+std::vector<ScoredSsdEntry> SsdCache::scoredEntries() const {
+  std::vector<ScoredSsdEntry> entries;
+  for (auto& file : files_) {
+    file->appendScoredEntries(entries);
+  }
+  return entries;
+}
+
 void SsdCache::clear() {
   for (auto& file : files_) {
     file->clear();
@@ -147,6 +155,10 @@ std::string SsdCache::toString() const {
       << (data.bytesRead >> 20) << "MB Size " << (capacity >> 30)
       << "GB Occupied " << (data.bytesCached >> 30) << "GB";
   out << (data.entriesCached >> 10) << "K entries.";
+  if (data.entriesCompressed > 0) {
+    out << " Compressed " << data.entriesCompressed << " entries saving "
+        << (data.bytesSavedByCompression >> 20) << "MB.";
+  }
   out << "\nGroupStats: " << groupStats_->toString(capacity);
   return out.str();
 }
@@ -75,6 +75,9 @@ class SsdCache {
   // Returns  stats aggregated from all shards.
   SsdCacheStats stats() const;
 
+  // Returns the entries of all shards with the access scores of their regions.
+  std::vector<ScoredSsdEntry> scoredEntries() const;
+
   FileGroupStats& groupStats() const {
     return *groupStats_;
   }
@@ -16,9 +16,16 @@
 
 #include "velox/common/caching/SsdFile.h"
 #include <folly/Executor.h>
+#include <folly/ScopeGuard.h>
+#include <folly/executors/InlineExecutor.h>
+#include <folly/futures/Future.h>
+#include <folly/io/Cursor.h>
 #include <folly/portability/SysUio.h>
 #include "velox/common/base/AsyncSource.h"
+#include "velox/common/base/CoalesceIo.h"
 #include "velox/common/caching/FileIds.h"
+#include "velox/common/file/IoUring.h"
+#include "velox/common/time/Timer.h"
 
 #include <fcntl.h>
 #ifdef linux
@@ -32,6 +39,15 @@
 
 DEFINE_bool(ssd_odirect, true, "Use O_DIRECT for SSD cache IO");
 DEFINE_bool(ssd_verify_write, false, "Read back data after writing to SSD");
+DEFINE_string(
+    ssd_compression,
+    "none",
+    "Compression for SSD cache entries. One of none, lz4 or zstd");
+DEFINE_double(
+    ssd_compression_max_ratio,
+    0.8,
+    "An SSD cache entry is stored compressed if the compressed size is at most "
+    "this fraction of the size");
 
 namespace facebook::velox::cache {
 
@@ -89,10 +105,11 @@ std::string SsdPin::toString() const {
     return "<empty SsdPin>";
   }
   return fmt::format(
-      "SsdPin(shard {} offset {} size {})",
+      "SsdPin(shard {} offset {} size {}{})",
       file_->shardId(),
       run_.offset(),
-      run_.size());
+      run_.size(),
+      run_.compressed() ? " compressed" : "");
 }
 
 SsdFile::SsdFile(
@@ -129,6 +146,10 @@ SsdFile::SsdFile(
   }
 
   readFile_ = std::make_unique<LocalReadFile>(fd_);
+  compressionKind_ = common::stringToCompressionKind(FLAGS_ssd_compression);
+  if (compressionKind_ != common::CompressionKind_NONE) {
+    codec_ = common::compressionKindToCodec(compressionKind_);
+  }
   uint64_t size = lseek(fd_, 0, SEEK_END);
   numRegions_ = size / kRegionSize;
   if (numRegions_ > maxRegions_) {
@@ -182,6 +203,37 @@ void addEntryToIovecs(AsyncDataCacheEntry& entry, std::vector<iovec>& iovecs) {
     };
   }
 }
+
+// Returns the ranges of the first 'entry.size()' bytes of the memory of
+// 'entry'.
+std::vector<folly::Range<char*>> entryRanges(AsyncDataCacheEntry& entry) {
+  std::vector<iovec> iovecs;
+  addEntryToIovecs(entry, iovecs);
+  std::vector<folly::Range<char*>> ranges;
+  ranges.reserve(iovecs.size());
+  for (auto& iovec : iovecs) {
+    ranges.emplace_back(reinterpret_cast<char*>(iovec.iov_base), iovec.iov_len);
+  }
+  return ranges;
+}
+
+// Precedes the compressed bytes of an entry on SSD.
+struct CompressedHeader {
+  // Size of the entry before compression.
+  uint32_t size;
+  common::CompressionKind kind;
+};
+
+// Minimum size of an entry for trying compression.
+constexpr int32_t kMinCompressionSize = 1024;
+
+// Number of entries of a file group that are compressed before deciding on
+// the compression ratio of the group.
+constexpr int32_t kMinCompressionSamples = 8;
+
+// If a group does not compress well, one in this many entries is still
+// compressed to detect changes in the data.
+constexpr int32_t kCompressionResampleInterval = 32;
 } // namespace
 
 SsdPin SsdFile::find(RawFileCacheKey key) {
@@ -225,14 +277,13 @@ CoalesceIoStats SsdFile::load(
   for (auto i = 0; i < pins.size(); ++i) {
     auto runSize = ssdPins[i].run().size();
     auto entry = pins[i].checkedEntry();
-    if (FOLLY_UNLIKELY(runSize < entry->size())) {
+    if (FOLLY_UNLIKELY(!ssdPins[i].run().covers(entry->size()))) {
       ++stats_.readSsdErrors;
       LOG(ERROR) << "IOERR: Requested prefix of SSD cache entry: " << runSize
                  << " entry: " << entry->size();
     }
-    VELOX_CHECK_GE(
-        runSize,
-        entry->size(),
+    VELOX_CHECK(
+        ssdPins[i].run().covers(entry->size()),
         "IOERR SSd cache entry shorter than requested range");
     payloadTotal += entry->size();
     regionRead(regionIndex(ssdPins[i].run().offset()), runSize);
@@ -241,8 +292,12 @@ CoalesceIoStats SsdFile::load(
   }
   // Do coalesced IO for the pins. For short payloads, the break-even
   // between discrete pread calls and a single preadv that discards
-  // gaps is ~25K per gap. For longer payloads this is ~50-100K.
-  auto stats = readPins(
+  // gaps is ~25K per gap. For longer payloads this is ~50-100K. With
+  // io_uring, all the reads are in flight at the same time. Compressed
+  // entries are read into a buffer each and decompressed after the reads.
+  std::vector<std::string> compressedData(pins.size());
+  std::vector<folly::SemiFuture<uint64_t>> reads;
+  auto stats = coalesceIo<CachePin, folly::Range<char*>>(
       pins,
       payloadTotal / pins.size() < 10000 ? 25000 : 50000,
       // Max ranges in one preadv call. Longest gap + longest cache
@@ -250,13 +305,61 @@ CoalesceIoStats SsdFile::load(
       // ranges, coalesce limit of 1000 is safe.
       900,
       [&](int32_t index) { return ssdPins[index].run().offset(); },
+      [&](int32_t index) {
+        const auto run = ssdPins[index].run();
+        return run.compressed() ? run.size()
+                                : pins[index].checkedEntry()->size();
+      },
+      [&](int32_t index) {
+        return ssdPins[index].run().compressed()
+            ? 1
+            : std::max<int32_t>(
+                  1, pins[index].checkedEntry()->data().numRuns());
+      },
+      [&](const CachePin& pin, std::vector<folly::Range<char*>>& ranges) {
+        const auto index = &pin - pins.data();
+        const auto run = ssdPins[index].run();
+        if (run.compressed()) {
+          compressedData[index].resize(run.size());
+          ranges.emplace_back(compressedData[index].data(), run.size());
+          return;
+        }
+        auto entryBuffers = entryRanges(*pin.checkedEntry());
+        ranges.insert(ranges.end(), entryBuffers.begin(), entryBuffers.end());
+      },
+      [&](int32_t size, std::vector<folly::Range<char*>>& ranges) {
+        // A range without data skips 'size' bytes.
+        ranges.push_back(folly::Range<char*>(nullptr, (char*)(uint64_t)size));
+      },
       [&](const std::vector<CachePin>& /*pins*/,
           int32_t /*begin*/,
           int32_t /*end*/,
           uint64_t offset,
           const std::vector<folly::Range<char*>>& buffers) {
-        read(offset, buffers);
+        reads.push_back(read(offset, buffers));
       });
+  for (auto& result : folly::collectAll(std::move(reads)).get()) {
+    if (result.hasException()) {
+      ++stats_.readSsdErrors;
+      result.throwUnlessValue();
+    }
+  }
+  for (auto i = 0; i < pins.size(); ++i) {
+    if (!ssdPins[i].run().compressed()) {
+      continue;
+    }
+    auto* entry = pins[i].checkedEntry();
+    try {
+      decompress(
+          compressedData[i].data(),
+          compressedData[i].size(),
+          entry->size(),
+          entryRanges(*entry));
+    } catch (const std::exception&) {
+      ++stats_.readSsdErrors;
+      throw;
+    }
+  }
 
   for (auto i = 0; i < ssdPins.size(); ++i) {
     pins[i].checkedEntry()->setSsdFile(this, ssdPins[i].run().offset());
@@ -264,14 +367,55 @@ CoalesceIoStats SsdFile::load(
   return stats;
 }
 
-void SsdFile::read(
+folly::SemiFuture<uint64_t> SsdFile::read(
     uint64_t offset,
     const std::vector<folly::Range<char*>>& buffers) {
-  readFile_->preadv(offset, buffers);
+  const auto startUs = ioStarted();
+  return readFile_->preadvAsync(offset, buffers)
+      .via(&folly::InlineExecutor::instance())
+      .ensure([this, startUs]() { ioEnded(startUs); })
+      .semi();
+}
+
+int64_t SsdFile::writeAt(uint64_t offset, const std::vector<iovec>& iovecs) {
+  const auto startUs = ioStarted();
+  SCOPE_EXIT {
+    ioEnded(startUs);
+  };
+  if (auto* ioUring = IoUring::instance()) {
+    try {
+      return ioUring->writev(fd_, offset, iovecs).get();
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "io_uring write to SSD failed: " << e.what();
+      return -1;
+    }
+  }
+  return folly::pwritev(fd_, iovecs.data(), iovecs.size(), offset);
+}
+
+namespace {
+int32_t ioBucket(uint64_t value) {
+  int32_t bucket = 0;
+  while (value > 1 && bucket < SsdCacheStats::kNumIoBuckets - 1) {
+    value >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+} // namespace
+
+uint64_t SsdFile::ioStarted() {
+  stats_.ioQueueDepth[ioBucket(++numIosInFlight_)]++;
+  return getCurrentTimeMicro();
+}
+
+void SsdFile::ioEnded(uint64_t startUs) {
+  --numIosInFlight_;
+  stats_.ioLatencyUs[ioBucket(getCurrentTimeMicro() - startUs)]++;
 }
 
 std::optional<std::pair<uint64_t, int32_t>> SsdFile::getSpace(
-    const std::vector<CachePin>& pins,
+    const std::vector<uint32_t>& sizes,
     int32_t begin) {
   std::lock_guard<std::shared_mutex> l(mutex_);
   for (;;) {
@@ -286,13 +430,12 @@ std::optional<std::pair<uint64_t, int32_t>> SsdFile::getSpace(
     auto offset = regionSize_[region];
     auto available = kRegionSize - offset;
     int64_t toWrite = 0;
-    for (; begin < pins.size(); ++begin) {
-      auto entry = pins[begin].checkedEntry();
-      if (entry->size() > available) {
+    for (; begin < sizes.size(); ++begin) {
+      if (sizes[begin] > available) {
         break;
       }
-      available -= entry->size();
-      toWrite += entry->size();
+      available -= sizes[begin];
+      toWrite += sizes[begin];
     }
     if (toWrite) {
       // At least some pins got space from this region. If the region is full
@@ -363,14 +506,20 @@ void SsdFile::write(std::vector<CachePin>& pins) {
   // in storage is likely adjacent on SSD.
   std::sort(pins.begin(), pins.end());
   uint64_t total = 0;
-  for (auto& pin : pins) {
-    auto entry = pin.checkedEntry();
+  // The bytes to store for each pin if stored compressed.
+  std::vector<std::unique_ptr<folly::IOBuf>> compressed(pins.size());
+  std::vector<uint32_t> storedSizes(pins.size());
+  for (auto i = 0; i < pins.size(); ++i) {
+    auto entry = pins[i].checkedEntry();
     VELOX_CHECK_NULL(entry->ssdFile());
     total += entry->size();
+    compressed[i] = maybeCompress(*entry);
+    storedSizes[i] = compressed[i] ? compressed[i]->computeChainDataLength()
+                                   : entry->size();
   }
   int32_t storeIndex = 0;
   while (storeIndex < pins.size()) {
-    auto space = getSpace(pins, storeIndex);
+    auto space = getSpace(storedSizes, storeIndex);
 
     if (!space.has_value()) {
       // No space can be reclaimed. The pins are freed when the caller is freed.
@@ -381,17 +530,24 @@ void SsdFile::write(std::vector<CachePin>& pins) {
     int32_t bytes = 0;
     std::vector<iovec> iovecs;
     for (auto i = storeIndex; i < pins.size(); ++i) {
-      auto entry = pins[i].checkedEntry();
-      auto entrySize = entry->size();
+      auto entrySize = storedSizes[i];
       if (bytes + entrySize > available) {
         break;
       }
-      addEntryToIovecs(*entry, iovecs);
+      if (compressed[i]) {
+        for (auto range : *compressed[i]) {
+          iovecs.push_back(
+              {const_cast<uint8_t*>(range.data()),
+               static_cast<size_t>(range.size())});
+        }
+      } else {
+        addEntryToIovecs(*pins[i].checkedEntry(), iovecs);
+      }
       bytes += entrySize;
       ++numWritten;
     }
     VELOX_CHECK_GE(fileSize_, offset + bytes);
-    auto rc = folly::pwritev(fd_, iovecs.data(), iovecs.size(), offset);
+    auto rc = writeAt(offset, iovecs);
     if (rc != bytes) {
       LOG(ERROR) << "Failed to write to SSD, file name: " << fileName_
                  << ", fd: " << fd_ << ", size: " << iovecs.size()
@@ -407,17 +563,22 @@ void SsdFile::write(std::vector<CachePin>& pins) {
       for (auto i = storeIndex; i < storeIndex + numWritten; ++i) {
         auto entry = pins[i].checkedEntry();
         entry->setSsdFile(this, offset);
-        auto size = entry->size();
+        const auto size = storedSizes[i];
+        const bool isCompressed = compressed[i] != nullptr;
         FileCacheKey key = {
             entry->key().fileNum, static_cast<uint64_t>(entry->offset())};
-        entries_[std::move(key)] = SsdRun(offset, size);
+        entries_[std::move(key)] = SsdRun(offset, size, isCompressed);
         if (FLAGS_ssd_verify_write) {
-          verifyWrite(*entry, SsdRun(offset, size));
+          verifyWrite(*entry, SsdRun(offset, size, isCompressed));
         }
         offset += size;
         ++stats_.entriesWritten;
         stats_.bytesWritten += size;
         bytesAfterCheckpoint_ += size;
+        if (isCompressed) {
+          ++stats_.entriesCompressed;
+          stats_.bytesSavedByCompression += entry->size() - size;
+        }
       }
     }
     storeIndex += numWritten;
@@ -442,8 +603,19 @@ int32_t indexOfFirstMismatch(char* x, char* y, int n) {
 
 void SsdFile::verifyWrite(AsyncDataCacheEntry& entry, SsdRun ssdRun) {
   auto testData = std::make_unique<char[]>(entry.size());
-  auto rc = pread(fd_, testData.get(), entry.size(), ssdRun.offset());
-  VELOX_CHECK_EQ(rc, entry.size());
+  if (ssdRun.compressed()) {
+    std::string stored(ssdRun.size(), 0);
+    auto rc = pread(fd_, stored.data(), stored.size(), ssdRun.offset());
+    VELOX_CHECK_EQ(rc, stored.size());
+    decompress(
+        stored.data(),
+        stored.size(),
+        entry.size(),
+        {{testData.get(), static_cast<size_t>(entry.size())}});
+  } else {
+    auto rc = pread(fd_, testData.get(), entry.size(), ssdRun.offset());
+    VELOX_CHECK_EQ(rc, entry.size());
+  }
   if (entry.tinyData()) {
     if (0 != memcmp(testData.get(), entry.tinyData(), entry.size())) {
       VELOX_FAIL("bad read back");
@@ -469,6 +641,80 @@ void SsdFile::verifyWrite(AsyncDataCacheEntry& entry, SsdRun ssdRun) {
   }
 }
 
+std::unique_ptr<folly::IOBuf> SsdFile::maybeCompress(
+    const AsyncDataCacheEntry& entry) {
+  if (!codec_ || entry.size() < kMinCompressionSize) {
+    return nullptr;
+  }
+  auto& history = compressionHistory_[entry.groupId()];
+  if (history.numTried >= kMinCompressionSamples &&
+      history.compressedBytes >
+          history.rawBytes * FLAGS_ssd_compression_max_ratio &&
+      ++history.numSkipped % kCompressionResampleInterval != 0) {
+    return nullptr;
+  }
+
+  std::vector<iovec> iovecs;
+  addEntryToIovecs(const_cast<AsyncDataCacheEntry&>(entry), iovecs);
+  auto input = folly::IOBuf::wrapIov(iovecs.data(), iovecs.size());
+  auto output = codec_->compress(input.get());
+  const auto compressedSize =
+      sizeof(CompressedHeader) + output->computeChainDataLength();
+  ++history.numTried;
+  history.rawBytes += entry.size();
+  history.compressedBytes += std::min<uint64_t>(compressedSize, entry.size());
+  if (compressedSize > entry.size() * FLAGS_ssd_compression_max_ratio) {
+    return nullptr;
+  }
+
+  auto header = folly::IOBuf::create(sizeof(CompressedHeader));
+  CompressedHeader value{static_cast<uint32_t>(entry.size()), compressionKind_};
+  memcpy(header->writableData(), &value, sizeof(value));
+  header->append(sizeof(value));
+  header->prependChain(std::move(output));
+  return header;
+}
+
+// static
+void SsdFile::decompress(
+    const char* data,
+    uint32_t size,
+    uint64_t entrySize,
+    const std::vector<folly::Range<char*>>& out) {
+  VELOX_CHECK_GE(size, sizeof(CompressedHeader));
+  CompressedHeader header;
+  memcpy(&header, data, sizeof(header));
+  VELOX_CHECK_GE(
+      header.size,
+      entrySize,
+      "IOERR: Compressed SSD cache entry shorter than requested range");
+  auto codec = common::compressionKindToCodec(header.kind);
+  auto input = folly::IOBuf::wrapBuffer(
+      data + sizeof(header), size - sizeof(header));
+  auto output = codec->uncompress(input.get(), header.size);
+  VELOX_CHECK_EQ(output->computeChainDataLength(), header.size);
+  folly::io::Cursor cursor(output.get());
+  uint64_t bytesLeft = entrySize;
+  for (const auto& range : out) {
+    const auto bytes = std::min<uint64_t>(bytesLeft, range.size());
+    cursor.pull(range.data(), bytes);
+    bytesLeft -= bytes;
+  }
+  VELOX_CHECK_EQ(bytesLeft, 0);
+}
+
+void SsdFile::appendScoredEntries(
+    std::vector<ScoredSsdEntry>& entries) const {
+  std::shared_lock<std::shared_mutex> l(mutex_);
+  entries.reserve(entries.size() + entries_.size());
+  for (auto& [key, run] : entries_) {
+    entries.push_back(
+        {RawFileCacheKey{key.fileNum.id(), key.offset},
+         run,
+         tracker_.regionScore(regionIndex(run.offset()))});
+  }
+}
+
 void SsdFile::updateStats(SsdCacheStats& stats) const {
   // Lock only in tsan build. Incrementing the counters has no synchronized
   // emantics.
@@ -494,6 +740,14 @@ void SsdFile::updateStats(SsdCacheStats& stats) const {
   stats.writeCheckpointErrors += stats_.writeCheckpointErrors;
   stats.readSsdErrors += stats_.readSsdErrors;
   stats.readCheckpointErrors += stats_.readCheckpointErrors;
+
+  stats.entriesCompressed += stats_.entriesCompressed;
+  stats.bytesSavedByCompression += stats_.bytesSavedByCompression;
+
+  for (auto i = 0; i < SsdCacheStats::kNumIoBuckets; ++i) {
+    stats.ioQueueDepth[i] += stats_.ioQueueDepth[i];
+    stats.ioLatencyUs[i] += stats_.ioLatencyUs[i];
+  }
 }
 
 void SsdFile::clear() {
@@ -18,12 +18,16 @@
 
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/caching/SsdFileTracker.h"
+#include "velox/common/compression/Compression.h"
 #include "velox/common/file/File.h"
 
 #include <gflags/gflags.h>
+#include <array>
 
 DECLARE_bool(ssd_odirect);
 DECLARE_bool(ssd_verify_write);
+DECLARE_string(ssd_compression);
+DECLARE_double(ssd_compression_max_ratio);
 
 namespace facebook::velox::cache {
 
@@ -33,12 +37,16 @@ namespace facebook::velox::cache {
 class SsdRun {
  public:
   static constexpr int32_t kSizeBits = 23;
+  // Highest bit. Set if the bytes on SSD are a compressed entry.
+  static constexpr uint64_t kCompressedBit = 1UL << 63;
 
   SsdRun() : bits_(0) {}
 
-  SsdRun(uint64_t offset, uint32_t size)
-      : bits_((offset << kSizeBits) | ((size - 1))) {
-    VELOX_CHECK_LT(offset, 1L << (64 - kSizeBits));
+  SsdRun(uint64_t offset, uint32_t size, bool compressed = false)
+      : bits_(
+            (offset << kSizeBits) | ((size - 1)) |
+            (compressed ? kCompressedBit : 0)) {
+    VELOX_CHECK_LT(offset, 1L << (63 - kSizeBits));
     VELOX_CHECK_LT(size - 1, 1 << kSizeBits);
   }
 
@@ -55,13 +63,25 @@ class SsdRun {
   }
 
   uint64_t offset() const {
-    return (bits_ >> kSizeBits);
+    return (bits_ & ~kCompressedBit) >> kSizeBits;
   }
 
+  // Returns the number of bytes on SSD. For a compressed run this is less
+  // than the size of the cache entry.
   uint32_t size() const {
     return (bits_ & ((1 << kSizeBits) - 1)) + 1;
   }
 
+  bool compressed() const {
+    return bits_ & kCompressedBit;
+  }
+
+  // Returns true if 'this' has the data for a cache entry of 'entrySize'
+  // bytes. A compressed run is checked when it is decompressed.
+  bool covers(uint64_t entrySize) const {
+    return compressed() || size() >= entrySize;
+  }
+
   // Returns raw bits for serialization.
   uint64_t bits() const {
     return bits_;
@@ -118,8 +138,19 @@ class SsdPin {
   SsdRun run_;
 };
 
+// An entry of an SsdFile with the access score of its region. Used for
+// loading the most used entries into memory after a restart.
+struct ScoredSsdEntry {
+  RawFileCacheKey key;
+  SsdRun run;
+  uint64_t score;
+};
+
 // Metrics for SSD cache. Maintained by SsdFile and aggregated by SsdCache.
 struct SsdCacheStats {
+  // Number of power of two buckets in the IO histograms.
+  static constexpr int32_t kNumIoBuckets = 16;
+
   SsdCacheStats() {}
 
   SsdCacheStats(const SsdCacheStats& other) {
@@ -144,6 +175,14 @@ struct SsdCacheStats {
     writeCheckpointErrors = tsanAtomicValue(other.writeCheckpointErrors);
     readSsdErrors = tsanAtomicValue(other.readSsdErrors);
     readCheckpointErrors = tsanAtomicValue(other.readCheckpointErrors);
+
+    entriesCompressed = tsanAtomicValue(other.entriesCompressed);
+    bytesSavedByCompression = tsanAtomicValue(other.bytesSavedByCompression);
+
+    for (auto i = 0; i < kNumIoBuckets; ++i) {
+      ioQueueDepth[i] = tsanAtomicValue(other.ioQueueDepth[i]);
+      ioLatencyUs[i] = tsanAtomicValue(other.ioLatencyUs[i]);
+    }
   }
 
   tsan_atomic<uint64_t> entriesWritten{0};
@@ -163,6 +202,18 @@ struct SsdCacheStats {
   tsan_atomic<uint32_t> writeCheckpointErrors{0};
   tsan_atomic<uint32_t> readSsdErrors{0};
   tsan_atomic<uint32_t> readCheckpointErrors{0};
+
+  // Number of entries written compressed.
+  tsan_atomic<uint64_t> entriesCompressed{0};
+  // Size of the entries written compressed minus their size on SSD.
+  tsan_atomic<uint64_t> bytesSavedByCompression{0};
+
+  // Bucket i counts the reads and writes that had [2^i, 2^(i + 1)) IOs in
+  // flight on the file, including themselves, when issued.
+  std::array<tsan_atomic<uint64_t>, kNumIoBuckets> ioQueueDepth{};
+  // Bucket i counts the reads and writes that took [2^i, 2^(i + 1))
+  // microseconds.
+  std::array<tsan_atomic<uint64_t>, kNumIoBuckets> ioLatencyUs{};
 };
 
 // A shard of SsdCache. Corresponds to one file on SSD.  The data
@@ -239,6 +290,11 @@ class SsdFile {
   // Adds 'stats_' to 'stats'.
   void updateStats(SsdCacheStats& stats) const;
 
+  // Appends the entries of 'this' to 'entries' with the access score of their
+  // region. After recovering a checkpoint the scores are the ones from the
+  // checkpoint.
+  void appendScoredEntries(std::vector<ScoredSsdEntry>& entries) const;
+
   // Resets this' to a post-construction empty state. See SsdCache::clear().
   void clear();
 
@@ -270,13 +326,13 @@ class SsdFile {
     ++regionPins_[regionIndex(offset)];
   }
 
-  // Returns [offset, size] of contiguous space for storing data of a
-  // number of contiguous 'pins' starting with the pin at index
+  // Returns [offset, size] of contiguous space for storing a number of
+  // contiguous entries of 'sizes' starting with the entry at index
   // 'begin'.  Returns nullopt if there is no space. The space does
-  // not necessarily cover all the pins, so multiple calls starting at
-  // the first unwritten pin may be needed.
+  // not necessarily cover all the entries, so multiple calls starting at
+  // the first unwritten entry may be needed.
   std::optional<std::pair<uint64_t, int32_t>> getSpace(
-      const std::vector<CachePin>& pins,
+      const std::vector<uint32_t>& sizes,
       int32_t begin);
 
   // Removes all 'entries_' that reference data in regions described by
@@ -287,12 +343,41 @@ class SsdFile {
   // added to 'writableRegions_'. Returns true if regions could be cleared.
   bool growOrEvictLocked();
 
-  // Reads the backing file with ReadFile::preadv().
-  void read(uint64_t offset, const std::vector<folly::Range<char*>>& buffers);
+  // Reads the backing file with ReadFile::preadvAsync(). The read is
+  // asynchronous if io_uring is enabled.
+  folly::SemiFuture<uint64_t> read(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers);
+
+  // Writes 'iovecs' at 'offset' of the backing file. Returns the number of
+  // bytes written or -1 on error.
+  int64_t writeAt(uint64_t offset, const std::vector<iovec>& iovecs);
+
+  // Records the start of an IO in the queue depth histogram. Returns the start
+  // time to pass to ioEnded().
+  uint64_t ioStarted();
+
+  // Records the end of an IO started at 'startUs'.
+  void ioEnded(uint64_t startUs);
 
   // Verifies that 'entry' has the data at 'run'.
   void verifyWrite(AsyncDataCacheEntry& entry, SsdRun run);
 
+  // Returns the bytes to store on SSD for 'entry' if compression is enabled
+  // for the file group of 'entry' and the compressed size is at most
+  // FLAGS_ssd_compression_max_ratio of the size of 'entry'. Returns nullptr
+  // if 'entry' is to be stored as is.
+  std::unique_ptr<folly::IOBuf> maybeCompress(const AsyncDataCacheEntry& entry);
+
+  // Decompresses 'size' bytes of a compressed run at 'data' into the first
+  // 'entrySize' bytes of 'out'. 'out' is either the tiny data of an entry or
+  // the runs of its allocation.
+  static void decompress(
+      const char* data,
+      uint32_t size,
+      uint64_t entrySize,
+      const std::vector<folly::Range<char*>>& out);
+
   // Deletes checkpoint files. If 'keepLog' is true, truncates and syncs the
   // eviction log and leaves this open.
   void deleteCheckpoint(bool keepLog = false);
@@ -371,6 +456,30 @@ class SsdFile {
   // Counters.
   SsdCacheStats stats_;
 
+  // Number of reads and writes in flight.
+  std::atomic<int32_t> numIosInFlight_{0};
+
+  // Compression for new entries. Set from FLAGS_ssd_compression.
+  common::CompressionKind compressionKind_{common::CompressionKind_NONE};
+
+  // Codec for 'compressionKind_'. Only used by write(), which is not called
+  // concurrently for the same file.
+  std::unique_ptr<folly::io::Codec> codec_;
+
+  // Compression results of entries written for each file group.
+  struct CompressionHistory {
+    uint64_t rawBytes{0};
+    uint64_t compressedBytes{0};
+    // Number of entries of the group that were compressed.
+    uint32_t numTried{0};
+    // Number of entries written without trying compression because of a
+    // poor ratio so far.
+    uint32_t numSkipped{0};
+  };
+
+  // By file group. Only used by write().
+  folly::F14FastMap<uint64_t, CompressionHistory> compressionHistory_;
+
   // Checkpoint after every 'checkpointIntervalBytes_' written into
   // this file. 0 means no checkpointing. This is set to 0 if
   // checkpointing fails.
@@ -61,6 +61,10 @@ class SsdFileTracker {
       int32_t numRegions,
       const std::vector<int32_t>& regionPins);
 
+  uint64_t regionScore(int32_t region) const {
+    return tsanAtomicValue(regionScores_[region]);
+  }
+
   // Expose the region access data. Used in checkpointing cache state.
   std::vector<tsan_atomic<uint64_t>>& regionScores() {
     return regionScores_;
@@ -554,6 +554,83 @@ TEST_F(AsyncDataCacheTest, pin) {
   EXPECT_EQ(0, cache_->incrementPrefetchPages(0));
 }
 
+TEST_F(AsyncDataCacheTest, admission) {
+  constexpr int64_t kSize = 25000;
+  initializeCache(1 << 20);
+  StringIdLease file(fileIds(), std::string_view("admissionfile"));
+  folly::SemiFuture<bool> wait(false);
+  auto load = [&](uint64_t offset, bool scanOnce) {
+    auto pin = cache_->findOrCreate({file.id(), offset}, kSize, &wait);
+    EXPECT_TRUE(pin.checkedEntry()->isExclusive());
+    pin.checkedEntry()->setScanOnce(scanOnce);
+    pin.checkedEntry()->setExclusiveToShared();
+  };
+
+  // All new entries are admitted by default.
+  load(0, false);
+  EXPECT_EQ(0, cache_->refreshStats().numAdmissionRejects);
+
+  // A scan-once entry needs a previous access.
+  load(kSize, true);
+  EXPECT_EQ(1, cache_->refreshStats().numAdmissionRejects);
+
+  FLAGS_cache_admission_min_frequency = 2;
+  // First access.
+  load(2 * kSize, false);
+  EXPECT_EQ(2, cache_->refreshStats().numAdmissionRejects);
+
+  // A second access while the entry is exclusive counts.
+  auto pin = cache_->findOrCreate({file.id(), 3 * kSize}, kSize, &wait);
+  EXPECT_TRUE(cache_->findOrCreate({file.id(), 3 * kSize}, kSize, &wait)
+                  .empty());
+  pin.checkedEntry()->setScanOnce(true);
+  pin.checkedEntry()->setExclusiveToShared();
+  pin.clear();
+  EXPECT_EQ(2, cache_->refreshStats().numAdmissionRejects);
+
+  // Rejected entries stay in cache until evicted.
+  pin = cache_->findOrCreate({file.id(), 2 * kSize}, kSize, &wait);
+  EXPECT_TRUE(pin.checkedEntry()->isShared());
+  pin.clear();
+  FLAGS_cache_admission_min_frequency = 0;
+}
+
+TEST_F(AsyncDataCacheTest, sharedHits) {
+  constexpr int64_t kSize = 25000;
+  constexpr int32_t kNumThreads = 8;
+  initializeCache(1 << 20);
+  StringIdLease file(fileIds(), std::string_view("sharedhitsfile"));
+  folly::SemiFuture<bool> wait(false);
+  auto pin = cache_->findOrCreate({file.id(), 0}, kSize, &wait);
+  ASSERT_TRUE(pin.checkedEntry()->isExclusive());
+  // An exclusive entry is not found in shared mode.
+  EXPECT_TRUE(cache_->findOrCreate({file.id(), 0}, kSize, &wait).empty());
+  EXPECT_EQ(0, cache_->refreshStats().numSharedHits);
+  pin.checkedEntry()->setExclusiveToShared();
+  auto* entry = pin.checkedEntry();
+  pin.clear();
+
+  std::vector<std::thread> threads;
+  for (auto i = 0; i < kNumThreads; ++i) {
+    threads.push_back(std::thread([&]() {
+      for (auto j = 0; j < 100; ++j) {
+        auto hit = cache_->findOrCreate({file.id(), 0}, kSize, &wait);
+        EXPECT_EQ(entry, hit.checkedEntry());
+        EXPECT_TRUE(hit.checkedEntry()->isShared());
+      }
+    }));
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  auto stats = cache_->refreshStats();
+  EXPECT_EQ(kNumThreads * 100, stats.numSharedHits);
+  EXPECT_EQ(kNumThreads * 100, stats.numHit);
+  EXPECT_EQ(0, entry->numPins());
+  EXPECT_EQ(0, stats.numShared);
+  EXPECT_EQ(0, stats.numExclusive);
+}
+
 TEST_F(AsyncDataCacheTest, replace) {
   constexpr int64_t kMaxBytes = 64 << 20;
   FLAGS_velox_exception_user_stacktrace_enabled = false;
@@ -702,6 +779,68 @@ TEST_F(AsyncDataCacheTest, ssd) {
   ASSERT_LT(kSsdBytes / 2, stats2.bytesRead);
 }
 
+TEST_F(AsyncDataCacheTest, ssdWarmUp) {
+  constexpr uint64_t kRamBytes = 32 << 20;
+  constexpr uint64_t kSsdBytes = 256UL << 20;
+  FLAGS_velox_exception_user_stacktrace_enabled = false;
+  initializeCache(kRamBytes, kSsdBytes);
+  cache_->setVerifyHook(
+      [&](const AsyncDataCacheEntry& entry) { checkContents(entry); });
+  runThreads(4, [&](int32_t /*i*/) { loadLoop(0, kSsdBytes / 2); });
+  // Wait for writes to finish and make a checkpoint.
+  cache_->ssdCache()->shutdown();
+  ASSERT_LT(0, cache_->ssdCache()->stats().bytesWritten);
+
+  // Restart from the checkpoint with an empty memory cache.
+  initializeCache(kRamBytes, kSsdBytes);
+  cache_->setVerifyHook(
+      [&](const AsyncDataCacheEntry& entry) { checkContents(entry); });
+  ASSERT_EQ(0, cache_->refreshStats().numEntries);
+  ASSERT_LT(0, cache_->ssdCache()->stats().entriesCached);
+
+  const auto loaded =
+      cache_->warmUpFromSsd(executor(), kRamBytes / 2, 1UL << 30).get();
+  EXPECT_LT(0, loaded);
+  EXPECT_GE(kRamBytes / 2, loaded);
+  auto stats = cache_->refreshStats();
+  EXPECT_LT(0, stats.numEntries);
+  EXPECT_EQ(0, stats.numExclusive);
+  EXPECT_LT(0, cache_->ssdCache()->stats().bytesRead);
+}
+
+TEST_F(AsyncDataCacheTest, summary) {
+  constexpr int64_t kSize = 25000;
+  initializeCache(1 << 20);
+  auto summary = cache_->summary();
+  EXPECT_EQ(0, summary->numFiles);
+  EXPECT_FALSE(summary->mayContain("summaryfile_0"));
+
+  std::vector<StringIdLease> files;
+  for (auto i = 0; i < 3; ++i) {
+    files.emplace_back(fileIds(), fmt::format("summaryfile_{}", i));
+    auto pin = cache_->findOrCreate({files.back().id(), 0}, kSize, nullptr);
+    pin.checkedEntry()->setExclusiveToShared();
+  }
+  // The previous summary is returned until it is older than the max age.
+  EXPECT_EQ(summary, cache_->summary());
+  summary = cache_->summary(0);
+  EXPECT_EQ(3, summary->numFiles);
+  EXPECT_LE(3 * kSize, summary->memoryBytes);
+  EXPECT_EQ(0, summary->ssdBytes);
+
+  auto copy = CacheSummary::deserialize(summary->serialize());
+  EXPECT_EQ(3, copy.numFiles);
+  EXPECT_EQ(summary->memoryBytes, copy.memoryBytes);
+  for (auto i = 0; i < 3; ++i) {
+    EXPECT_TRUE(copy.mayContain(fmt::format("summaryfile_{}", i)));
+  }
+  int32_t numFalsePositives = 0;
+  for (auto i = 3; i < 1000; ++i) {
+    numFalsePositives += copy.mayContain(fmt::format("summaryfile_{}", i));
+  }
+  EXPECT_GT(100, numFalsePositives);
+}
+
 TEST_F(AsyncDataCacheTest, invalidSsdPath) {
   auto testPath = "hdfs:/test/prefix_";
   uint64_t ssdBytes = 256UL << 20;
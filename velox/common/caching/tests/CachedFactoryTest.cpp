@@ -21,6 +21,8 @@
 #include "folly/synchronization/Latch.h"
 #include "gtest/gtest.h"
 
+#include <unordered_set>
+
 using namespace facebook::velox;
 namespace {
 
@@ -200,6 +202,37 @@ TEST(CachedFactoryTest, multiThreadedGenerationAgain) {
   }
 }
 
+TEST(CachedFactoryTest, invalidValues) {
+  auto generator = std::make_unique<DoublerGenerator>();
+  auto* generated = &generator->generated_;
+  // The value of an odd key is valid in its first lookup only.
+  std::unordered_set<int> seen;
+  CachedFactory<int, int, DoublerGenerator> factory(
+      std::make_unique<SimpleLRUCache<int, int>>(1000),
+      std::move(generator),
+      [&](const int& value) {
+        return value % 4 == 0 || seen.insert(value).second;
+      });
+  EXPECT_EQ(factory.generate(1), cacheMiss(2));
+  EXPECT_EQ(factory.generate(2), cacheMiss(4));
+  EXPECT_EQ(factory.generate(1), cacheHit(2));
+  EXPECT_EQ(factory.generate(2), cacheHit(4));
+  EXPECT_EQ(*generated, 2);
+
+  // The value of 1 is now invalid, removed and generated again.
+  EXPECT_EQ(factory.generate(1), cacheMiss(2));
+  EXPECT_EQ(factory.generate(2), cacheHit(4));
+  EXPECT_EQ(*generated, 3);
+
+  std::vector<std::pair<int, int>> cached;
+  std::vector<int> missing;
+  factory.retrieveCached({1, 2}, &cached, &missing);
+  ASSERT_EQ(1, cached.size());
+  EXPECT_EQ(2, cached[0].first);
+  ASSERT_EQ(1, missing.size());
+  EXPECT_EQ(1, missing[0]);
+}
+
 TEST(CachedFactoryTest, retrievedCached) {
   auto generator = std::make_unique<DoublerGenerator>();
   auto* generated = &generator->generated_;
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/common/caching/FileGroupStats.h"
+
+#include "gtest/gtest.h"
+
+using namespace facebook::velox::cache;
+
+TEST(FileGroupStatsTest, trackingData) {
+  FileGroupStats stats;
+  const TrackingId column(1);
+  for (auto i = 0; i < 10; ++i) {
+    stats.recordReference(i, 1, column, 1000);
+    if (i % 2 == 0) {
+      stats.recordRead(i, 1, column, 1000);
+    }
+  }
+  stats.recordFile(1, 1, 10);
+  auto data = stats.trackingData(1, column);
+  EXPECT_EQ(10, data.numReferences);
+  EXPECT_EQ(5, data.numReads);
+  EXPECT_EQ(10'000, data.referencedBytes);
+  EXPECT_EQ(5'000, data.readBytes);
+  EXPECT_EQ(0, stats.trackingData(2, column).numReferences);
+}
+
+TEST(FileGroupStatsTest, ssdFilter) {
+  FileGroupStats stats;
+  // Stream i of group 1 has (i + 1) MB read.
+  for (auto i = 0; i < 4; ++i) {
+    for (auto j = 0; j <= i; ++j) {
+      stats.recordReference(0, 1, TrackingId(i), 1 << 20);
+      stats.recordRead(0, 1, TrackingId(i), 1 << 20);
+    }
+  }
+  // Everything qualifies before the first filter update.
+  EXPECT_TRUE(stats.shouldSaveToSsd(1, TrackingId(0)));
+
+  // All fits.
+  stats.updateSsdFilter(100 << 20);
+  for (auto i = 0; i < 4; ++i) {
+    EXPECT_TRUE(stats.shouldSaveToSsd(1, TrackingId(i)));
+  }
+
+  // Room for the 2 most read streams.
+  stats.updateSsdFilter(8 << 20);
+  EXPECT_TRUE(stats.shouldSaveToSsd(1, TrackingId(3)));
+  EXPECT_TRUE(stats.shouldSaveToSsd(1, TrackingId(2)));
+  EXPECT_FALSE(stats.shouldSaveToSsd(1, TrackingId(1)));
+  EXPECT_FALSE(stats.shouldSaveToSsd(1, TrackingId(0)));
+  // Streams without stats qualify.
+  EXPECT_TRUE(stats.shouldSaveToSsd(2, TrackingId(0)));
+
+  // Decay halves the counts.
+  stats.updateSsdFilter(8 << 20, 50);
+  EXPECT_EQ(2, stats.trackingData(1, TrackingId(3)).numReads);
+  EXPECT_EQ(0, stats.trackingData(1, TrackingId(0)).numReads);
+}
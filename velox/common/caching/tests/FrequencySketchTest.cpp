@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/caching/FrequencySketch.h"
+
+#include "gtest/gtest.h"
+
+using namespace facebook::velox::cache;
+
+TEST(FrequencySketchTest, basic) {
+  FrequencySketch sketch(1024);
+  EXPECT_EQ(0, sketch.estimate(1));
+  for (auto i = 1; i <= 5; ++i) {
+    EXPECT_EQ(i, sketch.increment(1));
+  }
+  EXPECT_EQ(5, sketch.estimate(1));
+  EXPECT_EQ(1, sketch.increment(2));
+  EXPECT_EQ(5, sketch.estimate(1));
+
+  // Counts saturate.
+  for (auto i = 0; i < 2 * FrequencySketch::kMaxCount; ++i) {
+    sketch.increment(3);
+  }
+  EXPECT_EQ(FrequencySketch::kMaxCount, sketch.estimate(3));
+}
+
+TEST(FrequencySketchTest, aging) {
+  constexpr int32_t kWidth = 1024;
+  FrequencySketch sketch(kWidth);
+  for (auto i = 0; i < 8; ++i) {
+    sketch.increment(1);
+  }
+  EXPECT_EQ(8, sketch.estimate(1));
+  EXPECT_EQ(0, sketch.numAgings());
+
+  // Keys seen once make up the rest of the sample. After the sample all
+  // counts are halved.
+  for (uint64_t i = 0; i < 10 * kWidth - 8; ++i) {
+    sketch.increment(1000 + i);
+  }
+  EXPECT_EQ(1, sketch.numAgings());
+  EXPECT_EQ(4, sketch.estimate(1));
+  int32_t numNonZero = 0;
+  for (uint64_t i = 0; i < 100; ++i) {
+    numNonZero += sketch.estimate(1000 + i) > 0;
+  }
+  // Keys seen once are mostly forgotten. A few may collide with others.
+  EXPECT_GT(20, numNonZero);
+}
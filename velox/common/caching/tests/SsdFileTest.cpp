@@ -18,6 +18,8 @@
 #include "velox/common/caching/SsdCache.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 
+#include <folly/Random.h>
+#include <folly/ScopeGuard.h>
 #include <folly/executors/QueuedImmediateExecutor.h>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
@@ -299,6 +301,81 @@ TEST_F(SsdFileTest, writeAndRead) {
   }
 }
 
+TEST_F(SsdFileTest, compression) {
+  FLAGS_ssd_compression = "zstd";
+  SCOPE_EXIT {
+    FLAGS_ssd_compression = "none";
+  };
+  initializeCache(128 * kMB, 4 * SsdFile::kRegionSize);
+  FLAGS_ssd_verify_write = true;
+
+  // Even entries are in a file group with compressible data, odd entries in
+  // one with random data.
+  constexpr int32_t kNumEntries = 40;
+  constexpr int32_t kEntrySize = 64 << 10;
+  auto forEachRun = [](AsyncDataCacheEntry& entry, auto func) {
+    auto& data = entry.data();
+    int64_t offset = 0;
+    for (auto i = 0; i < data.numRuns() && offset < entry.size(); ++i) {
+      auto run = data.runAt(i);
+      auto bytes = std::min<int64_t>(run.numBytes(), entry.size() - offset);
+      func(run.data<char>(), offset, bytes);
+      offset += bytes;
+    }
+  };
+  std::vector<CachePin> pins;
+  std::vector<std::string> expected;
+  for (auto i = 0; i < kNumEntries; ++i) {
+    pins.push_back(cache_->findOrCreate(
+        RawFileCacheKey{fileName_.id(), static_cast<uint64_t>(i) * kEntrySize},
+        kEntrySize,
+        nullptr));
+    auto* entry = pins.back().checkedEntry();
+    ASSERT_TRUE(entry->isExclusive());
+    entry->setGroupId(i % 2);
+    std::string contents(kEntrySize, 0);
+    for (auto j = 0; j < kEntrySize; ++j) {
+      contents[j] = i % 2 == 0 ? 'a' + (j / 100) % 3 : folly::Random::rand32();
+    }
+    forEachRun(*entry, [&](char* data, int64_t offset, int64_t bytes) {
+      memcpy(data, contents.data() + offset, bytes);
+    });
+    expected.push_back(std::move(contents));
+  }
+  ssdFile_->write(pins);
+
+  SsdCacheStats stats;
+  ssdFile_->updateStats(stats);
+  EXPECT_EQ(kNumEntries, stats.entriesWritten);
+  EXPECT_EQ(kNumEntries / 2, stats.entriesCompressed);
+  EXPECT_GT(stats.bytesSavedByCompression, kNumEntries / 2 * kEntrySize / 2);
+  EXPECT_LT(stats.bytesWritten, kNumEntries * kEntrySize);
+
+  // Clears the entries and reads them back from SSD.
+  std::vector<SsdPin> ssdPins;
+  for (auto& pin : pins) {
+    auto* entry = pin.checkedEntry();
+    EXPECT_EQ(ssdFile_.get(), entry->ssdFile());
+    forEachRun(*entry, [&](char* data, int64_t /*offset*/, int64_t bytes) {
+      memset(data, 0, bytes);
+    });
+    ssdPins.push_back(ssdFile_->find(
+        RawFileCacheKey{fileName_.id(), entry->key().offset}));
+    ASSERT_FALSE(ssdPins.back().empty());
+    EXPECT_EQ(
+        entry->key().offset / kEntrySize % 2 == 0,
+        ssdPins.back().run().compressed());
+  }
+  ssdFile_->load(ssdPins, pins);
+  for (auto i = 0; i < kNumEntries; ++i) {
+    forEachRun(
+        *pins[i].checkedEntry(),
+        [&](char* data, int64_t offset, int64_t bytes) {
+          ASSERT_EQ(0, memcmp(data, expected[i].data() + offset, bytes));
+        });
+  }
+}
+
 #ifdef VELOX_SSD_FILE_TEST_SET_NO_COW_FLAG
 TEST_F(SsdFileTest, disabledCow) {
   constexpr int64_t kSsdSize = 16 * SsdFile::kRegionSize;
@@ -16,6 +16,7 @@
 
 #include "velox/common/file/File.h"
 #include "velox/common/base/Fs.h"
+#include "velox/common/file/IoUring.h"
 
 #include <fmt/format.h>
 #include <glog/logging.h>
@@ -135,12 +136,13 @@ LocalReadFile::pread(uint64_t offset, uint64_t length, void* buf) const {
   return {static_cast<char*>(buf), length};
 }
 
-uint64_t LocalReadFile::preadv(
-    uint64_t offset,
-    const std::vector<folly::Range<char*>>& buffers) const {
+// static
+std::vector<struct iovec> LocalReadFile::makeIovecs(
+    const std::vector<folly::Range<char*>>& buffers) {
   // Dropped bytes sized so that a typical dropped range of 50K is not
-  // too many iovecs.
-  static thread_local std::vector<char> droppedBytes(16 * 1024);
+  // too many iovecs. The contents are never read, so the buffer is shared by
+  // all threads and outlives asynchronous reads.
+  static std::vector<char> droppedBytes(16 * 1024);
   std::vector<struct iovec> iovecs;
   iovecs.reserve(buffers.size());
   for (auto& range : buffers) {
@@ -155,9 +157,30 @@ uint64_t LocalReadFile::preadv(
       iovecs.push_back({range.data(), range.size()});
     }
   }
+  return iovecs;
+}
+
+uint64_t LocalReadFile::preadv(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  auto iovecs = makeIovecs(buffers);
   return folly::preadv(fd_, iovecs.data(), iovecs.size(), offset);
 }
 
+folly::SemiFuture<uint64_t> LocalReadFile::preadvAsync(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  auto* ioUring = IoUring::instance();
+  if (!ioUring) {
+    return ReadFile::preadvAsync(offset, buffers);
+  }
+  return ioUring->readv(fd_, offset, makeIovecs(buffers));
+}
+
+bool LocalReadFile::hasPreadvAsync() const {
+  return IoUring::instance() != nullptr;
+}
+
 uint64_t LocalReadFile::size() const {
   return size_;
 }
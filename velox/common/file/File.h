@@ -240,6 +240,14 @@ class LocalReadFile final : public ReadFile {
       uint64_t offset,
       const std::vector<folly::Range<char*>>& buffers) const final;
 
+  // Reads through IoUring::instance() if io_uring is enabled. The file must
+  // stay open until the returned future is complete.
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const final;
+
+  bool hasPreadvAsync() const final;
+
   uint64_t memoryUsage() const final;
 
   bool shouldCoalesce() const final {
@@ -261,6 +269,11 @@ class LocalReadFile final : public ReadFile {
   void preadInternal(uint64_t offset, uint64_t length, char* FOLLY_NONNULL pos)
       const;
 
+  // Returns the iovecs for reading into 'buffers'. Ranges without data are
+  // read into a scratch buffer.
+  static std::vector<struct iovec> makeIovecs(
+      const std::vector<folly::Range<char*>>& buffers);
+
   std::string path_;
   int32_t fd_;
   long size_;
@@ -0,0 +1,354 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/IoUring.h"
+
+#include <folly/String.h>
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/time/Timer.h"
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define VELOX_HAS_IO_URING 1
+#endif
+
+DEFINE_int32(
+    velox_io_uring_queue_depth,
+    0,
+    "Number of entries in the io_uring used for asynchronous local file IO. "
+    "0 disables io_uring and local file IO is synchronous");
+
+namespace facebook::velox {
+
+namespace {
+int32_t bucketOf(uint64_t value) {
+  int32_t bucket = 0;
+  while (value > 1 && bucket < IoUring::kNumBuckets - 1) {
+    value >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+} // namespace
+
+// static
+IoUring* IoUring::instance() {
+  static IoUring* instance = []() -> IoUring* {
+    if (FLAGS_velox_io_uring_queue_depth <= 0) {
+      return nullptr;
+    }
+    try {
+      // Never destroyed. Files may be read until the process exits.
+      return new IoUring(FLAGS_velox_io_uring_queue_depth);
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "io_uring not available, using synchronous IO: "
+                   << e.what();
+      return nullptr;
+    }
+  }();
+  return instance;
+}
+
+#ifdef VELOX_HAS_IO_URING
+
+IoUring::IoUring(int32_t queueDepth) {
+  VELOX_CHECK_GT(queueDepth, 0);
+  io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  ringFd_ = syscall(__NR_io_uring_setup, queueDepth, &params);
+  if (ringFd_ < 0) {
+    ringFd_ = -1;
+    VELOX_FAIL("io_uring_setup failed: {}", folly::errnoStr(errno));
+  }
+  numEntries_ = params.sq_entries;
+
+  sqRingBytes_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  cqRingBytes_ =
+      params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  const bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+  if (singleMmap) {
+    sqRingBytes_ = cqRingBytes_ = std::max(sqRingBytes_, cqRingBytes_);
+  }
+  auto map = [&](size_t bytes, uint64_t offset) {
+    auto* ptr = mmap(
+        nullptr,
+        bytes,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE,
+        ringFd_,
+        offset);
+    if (ptr == MAP_FAILED) {
+      auto error = errno;
+      release();
+      VELOX_FAIL("io_uring mmap failed: {}", folly::errnoStr(error));
+    }
+    return ptr;
+  };
+  sqRing_ = map(sqRingBytes_, IORING_OFF_SQ_RING);
+  cqRing_ = singleMmap ? sqRing_ : map(cqRingBytes_, IORING_OFF_CQ_RING);
+  sqesBytes_ = params.sq_entries * sizeof(io_uring_sqe);
+  sqes_ = map(sqesBytes_, IORING_OFF_SQES);
+
+  auto* sq = reinterpret_cast<char*>(sqRing_);
+  sqTail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+  sqMask_ = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+  sqArray_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+  auto* cq = reinterpret_cast<char*>(cqRing_);
+  cqHead_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+  cqTail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+  cqMask_ = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+  cqes_ = cq + params.cq_off.cqes;
+
+  completionThread_ = std::thread([this]() { completionLoop(); });
+}
+
+IoUring::~IoUring() {
+  if (completionThread_.joinable()) {
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      stop_ = true;
+      // Requests in flight wake up the completion thread when they complete.
+      if (numInFlight_ == 0) {
+        pushLocked(nullptr);
+      }
+    }
+    completionThread_.join();
+  }
+  release();
+}
+
+void IoUring::release() {
+  if (sqes_) {
+    munmap(sqes_, sqesBytes_);
+  }
+  if (cqRing_ && cqRing_ != sqRing_) {
+    munmap(cqRing_, cqRingBytes_);
+  }
+  if (sqRing_) {
+    munmap(sqRing_, sqRingBytes_);
+  }
+  if (ringFd_ >= 0) {
+    close(ringFd_);
+  }
+  sqes_ = cqRing_ = sqRing_ = nullptr;
+  ringFd_ = -1;
+}
+
+void IoUring::pushLocked(Request* request) {
+  const auto tail = *sqTail_;
+  const auto index = tail & *sqMask_;
+  auto* sqe = reinterpret_cast<io_uring_sqe*>(sqes_) + index;
+  memset(sqe, 0, sizeof(*sqe));
+  if (request) {
+    sqe->opcode = request->isWrite ? IORING_OP_WRITEV : IORING_OP_READV;
+    sqe->fd = request->fd;
+    sqe->off = request->offset + request->doneBytes;
+    sqe->addr = reinterpret_cast<uint64_t>(
+        request->iovecs.data() + request->firstIovec);
+    sqe->len = request->iovecs.size() - request->firstIovec;
+  } else {
+    sqe->opcode = IORING_OP_NOP;
+  }
+  sqe->user_data = reinterpret_cast<uint64_t>(request);
+  sqArray_[index] = index;
+  __atomic_store_n(sqTail_, tail + 1, __ATOMIC_RELEASE);
+
+  int32_t result;
+  do {
+    result = syscall(__NR_io_uring_enter, ringFd_, 1, 0, 0, nullptr, 0);
+  } while (result < 0 && errno == EINTR);
+  VELOX_CHECK_EQ(
+      result, 1, "io_uring_enter failed: {}", folly::errnoStr(errno));
+}
+
+void IoUring::completionLoop() {
+  for (;;) {
+    auto result = syscall(
+        __NR_io_uring_enter, ringFd_, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+    if (result < 0 && errno != EINTR) {
+      LOG(ERROR) << "io_uring_enter failed: " << folly::errnoStr(errno);
+    }
+    auto head = *cqHead_;
+    const auto tail = __atomic_load_n(cqTail_, __ATOMIC_ACQUIRE);
+    std::vector<std::pair<Request*, int32_t>> completed;
+    for (; head != tail; ++head) {
+      const auto* cqe =
+          reinterpret_cast<const io_uring_cqe*>(cqes_) + (head & *cqMask_);
+      completed.emplace_back(
+          reinterpret_cast<Request*>(cqe->user_data), cqe->res);
+    }
+    __atomic_store_n(cqHead_, head, __ATOMIC_RELEASE);
+
+    for (auto [request, res] : completed) {
+      if (request) {
+        complete(request, res);
+      }
+    }
+
+    std::lock_guard<std::mutex> l(mutex_);
+    if (stop_ && numInFlight_ == 0 && backlog_.empty()) {
+      return;
+    }
+  }
+}
+
+#else
+
+IoUring::IoUring(int32_t /*queueDepth*/) {
+  VELOX_FAIL("io_uring is not supported on this platform");
+}
+
+IoUring::~IoUring() {}
+
+void IoUring::release() {}
+
+void IoUring::pushLocked(Request* /*request*/) {
+  VELOX_UNREACHABLE();
+}
+
+void IoUring::completionLoop() {
+  VELOX_UNREACHABLE();
+}
+
+#endif
+
+folly::SemiFuture<uint64_t>
+IoUring::readv(int32_t fd, uint64_t offset, std::vector<iovec> iovecs) {
+  auto request = std::make_unique<Request>();
+  request->isWrite = false;
+  request->fd = fd;
+  request->offset = offset;
+  request->iovecs = std::move(iovecs);
+  ++numReads_;
+  return submit(std::move(request));
+}
+
+folly::SemiFuture<uint64_t>
+IoUring::writev(int32_t fd, uint64_t offset, std::vector<iovec> iovecs) {
+  auto request = std::make_unique<Request>();
+  request->isWrite = true;
+  request->fd = fd;
+  request->offset = offset;
+  request->iovecs = std::move(iovecs);
+  ++numWrites_;
+  return submit(std::move(request));
+}
+
+folly::SemiFuture<uint64_t> IoUring::submit(std::unique_ptr<Request> request) {
+  for (const auto& iovec : request->iovecs) {
+    request->totalBytes += iovec.iov_len;
+  }
+  if (request->totalBytes == 0) {
+    return folly::makeSemiFuture<uint64_t>(0);
+  }
+  auto future = request->promise.getSemiFuture();
+  request->startMicros = getCurrentTimeMicro();
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(!stop_, "Submitting to a stopped io_uring");
+  queueDepth_[bucketOf(numInFlight_ + backlog_.size() + 1)]++;
+  submitLocked(request.release());
+  return future;
+}
+
+void IoUring::submitLocked(Request* request) {
+  if (numInFlight_ >= numEntries_) {
+    backlog_.push_back(request);
+    return;
+  }
+  ++numInFlight_;
+  try {
+    pushLocked(request);
+  } catch (const std::exception&) {
+    --numInFlight_;
+    ++numErrors_;
+    request->promise.setException(std::current_exception());
+    delete request;
+  }
+}
+
+void IoUring::complete(Request* request, int32_t result) {
+  bool done = true;
+  try {
+    if (result == -EINTR || result == -EAGAIN) {
+      done = false;
+    } else if (result < 0) {
+      VELOX_FAIL(
+          "io_uring {} failed: {}",
+          request->isWrite ? "writev" : "readv",
+          folly::errnoStr(-result));
+    } else if (result == 0) {
+      // A read of 0 bytes is the end of the file.
+      VELOX_CHECK(!request->isWrite, "io_uring writev made no progress");
+    } else {
+      request->doneBytes += result;
+      // Skips the fully transferred iovecs and trims the partial one.
+      uint64_t remaining = result;
+      while (remaining > 0) {
+        auto& iovec = request->iovecs[request->firstIovec];
+        if (remaining < iovec.iov_len) {
+          iovec.iov_base = reinterpret_cast<char*>(iovec.iov_base) + remaining;
+          iovec.iov_len -= remaining;
+          break;
+        }
+        remaining -= iovec.iov_len;
+        ++request->firstIovec;
+      }
+      done = request->doneBytes >= request->totalBytes;
+    }
+    if (done) {
+      request->promise.setValue(request->doneBytes);
+    }
+  } catch (const std::exception&) {
+    ++numErrors_;
+    request->promise.setException(std::current_exception());
+  }
+  if (done) {
+    latencyUs_[bucketOf(getCurrentTimeMicro() - request->startMicros)]++;
+  }
+
+  std::lock_guard<std::mutex> l(mutex_);
+  --numInFlight_;
+  if (done) {
+    delete request;
+  } else {
+    submitLocked(request);
+  }
+  while (!backlog_.empty() && numInFlight_ < numEntries_) {
+    auto* next = backlog_.front();
+    backlog_.pop_front();
+    submitLocked(next);
+  }
+}
+
+IoUring::Stats IoUring::stats() const {
+  Stats stats;
+  stats.numReads = numReads_;
+  stats.numWrites = numWrites_;
+  stats.numErrors = numErrors_;
+  for (auto i = 0; i < kNumBuckets; ++i) {
+    stats.queueDepth[i] = queueDepth_[i];
+    stats.latencyUs[i] = latencyUs_[i];
+  }
+  return stats;
+}
+
+} // namespace facebook::velox
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <sys/uio.h>
+#include <array>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <folly/futures/Future.h>
+
+namespace facebook::velox {
+
+/// Asynchronous preadv and pwritev on local file descriptors with a Linux
+/// io_uring. Requests are submitted by the calling thread and completed by a
+/// single completion thread that fulfills the returned futures. Many reads can
+/// thus be in flight without holding a thread per read. Short reads and writes
+/// are resubmitted for the remaining bytes. A read that reaches the end of the
+/// file completes with the number of bytes read.
+///
+/// Uses the io_uring system calls directly, so there is no dependency on
+/// liburing. Not available on non-Linux systems or on kernels without
+/// io_uring, in which case instance() returns nullptr and callers use
+/// synchronous IO.
+class IoUring {
+ public:
+  /// Number of power of two buckets in the histograms of Stats.
+  static constexpr int32_t kNumBuckets = 16;
+
+  struct Stats {
+    uint64_t numReads{0};
+    uint64_t numWrites{0};
+    uint64_t numErrors{0};
+    /// Bucket i counts the requests that had [2^i, 2^(i + 1)) requests in
+    /// flight, including themselves, when submitted.
+    std::array<uint64_t, kNumBuckets> queueDepth{};
+    /// Bucket i counts the requests that took [2^i, 2^(i + 1)) microseconds
+    /// from submission to completion.
+    std::array<uint64_t, kNumBuckets> latencyUs{};
+  };
+
+  /// Returns the process wide instance with a queue of
+  /// FLAGS_velox_io_uring_queue_depth entries or nullptr if the flag is 0 or
+  /// io_uring is not available.
+  static IoUring* instance();
+
+  /// Sets up a ring with 'queueDepth' submission queue entries. Throws if
+  /// io_uring is not available.
+  explicit IoUring(int32_t queueDepth);
+
+  /// Waits for the requests in flight and stops the completion thread.
+  ~IoUring();
+
+  /// Reads from 'fd' at 'offset' into 'iovecs'. The memory referenced by
+  /// 'iovecs' must stay valid until the returned future is complete.
+  folly::SemiFuture<uint64_t>
+  readv(int32_t fd, uint64_t offset, std::vector<iovec> iovecs);
+
+  /// Writes 'iovecs' to 'fd' at 'offset'. The memory referenced by 'iovecs'
+  /// must stay valid until the returned future is complete.
+  folly::SemiFuture<uint64_t>
+  writev(int32_t fd, uint64_t offset, std::vector<iovec> iovecs);
+
+  Stats stats() const;
+
+ private:
+  struct Request {
+    bool isWrite;
+    int32_t fd;
+    uint64_t offset;
+    std::vector<iovec> iovecs;
+    // First element of 'iovecs' not yet transferred.
+    size_t firstIovec{0};
+    uint64_t totalBytes{0};
+    uint64_t doneBytes{0};
+    uint64_t startMicros{0};
+    folly::Promise<uint64_t> promise;
+  };
+
+  folly::SemiFuture<uint64_t> submit(std::unique_ptr<Request> request);
+
+  // Puts 'request' in the submission queue or in 'backlog_' if the ring is
+  // full. 'mutex_' must be held.
+  void submitLocked(Request* request);
+
+  // Writes a submission queue entry for 'request' and tells the kernel.
+  // 'request' is nullptr for the no-op that wakes up the completion thread.
+  // 'mutex_' must be held.
+  void pushLocked(Request* request);
+
+  // Handles the completion of 'request' with 'result'.
+  void complete(Request* request, int32_t result);
+
+  void completionLoop();
+
+  // Unmaps the rings and closes 'ringFd_'.
+  void release();
+
+  int32_t ringFd_{-1};
+  uint32_t numEntries_{0};
+
+  void* sqRing_{nullptr};
+  size_t sqRingBytes_{0};
+  void* cqRing_{nullptr};
+  size_t cqRingBytes_{0};
+  void* sqes_{nullptr};
+  size_t sqesBytes_{0};
+
+  unsigned* sqTail_{nullptr};
+  unsigned* sqMask_{nullptr};
+  unsigned* sqArray_{nullptr};
+  unsigned* cqHead_{nullptr};
+  unsigned* cqTail_{nullptr};
+  unsigned* cqMask_{nullptr};
+  void* cqes_{nullptr};
+
+  // Serializes submissions.
+  std::mutex mutex_;
+  // Requests in the ring that have not completed.
+  uint32_t numInFlight_{0};
+  // Requests waiting for space in the ring.
+  std::deque<Request*> backlog_;
+  bool stop_{false};
+
+  std::thread completionThread_;
+
+  std::atomic<uint64_t> numReads_{0};
+  std::atomic<uint64_t> numWrites_{0};
+  std::atomic<uint64_t> numErrors_{0};
+  std::array<std::atomic<uint64_t>, kNumBuckets> queueDepth_{};
+  std::array<std::atomic<uint64_t>, kNumBuckets> latencyUs_{};
+};
+
+} // namespace facebook::velox
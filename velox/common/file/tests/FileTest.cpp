@@ -18,6 +18,7 @@
 
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/file/IoUring.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/exec/tests/utils/TempFilePath.h"
 
@@ -244,6 +245,69 @@ TEST(LocalFile, readFileDestructor) {
   }
 }
 
+TEST(LocalFile, ioUring) {
+  std::unique_ptr<IoUring> ioUring;
+  try {
+    ioUring = std::make_unique<IoUring>(4);
+  } catch (const std::exception& e) {
+    GTEST_SKIP() << "io_uring not available: " << e.what();
+  }
+  auto tempFile = ::exec::test::TempFilePath::create();
+  const auto& filename = tempFile->path;
+  remove(filename.c_str());
+  auto fd = open(filename.c_str(), O_CREAT | O_RDWR, S_IRUSR | S_IWUSR);
+  ASSERT_GE(fd, 0);
+
+  // More writes than entries in the ring.
+  constexpr int32_t kNumBlocks = 20;
+  constexpr int32_t kBlockSize = 4096;
+  std::vector<std::string> blocks;
+  for (auto i = 0; i < kNumBlocks; ++i) {
+    blocks.push_back(std::string(kBlockSize, 'a' + i));
+  }
+  std::vector<folly::SemiFuture<uint64_t>> writes;
+  for (auto i = 0; i < kNumBlocks; ++i) {
+    // Each block is written in two pieces.
+    writes.push_back(ioUring->writev(
+        fd,
+        i * kBlockSize,
+        {{blocks[i].data(), 100}, {blocks[i].data() + 100, kBlockSize - 100}}));
+  }
+  for (auto& write : writes) {
+    ASSERT_EQ(kBlockSize, std::move(write).get());
+  }
+
+  std::vector<std::string> reads(kNumBlocks, std::string(kBlockSize, 0));
+  std::vector<folly::SemiFuture<uint64_t>> readFutures;
+  for (auto i = 0; i < kNumBlocks; ++i) {
+    readFutures.push_back(ioUring->readv(
+        fd, i * kBlockSize, {{reads[i].data(), kBlockSize}}));
+  }
+  for (auto i = 0; i < kNumBlocks; ++i) {
+    ASSERT_EQ(kBlockSize, std::move(readFutures[i]).get());
+    ASSERT_EQ(blocks[i], reads[i]);
+  }
+
+  // A read past the end of the file returns the bytes up to the end.
+  std::string tail(2 * kBlockSize, 0);
+  ASSERT_EQ(
+      kBlockSize,
+      ioUring
+          ->readv(
+              fd, (kNumBlocks - 1) * kBlockSize, {{tail.data(), tail.size()}})
+          .get());
+  ASSERT_EQ(blocks.back(), tail.substr(0, kBlockSize));
+
+  // Reading a bad file descriptor fails.
+  ASSERT_ANY_THROW(ioUring->readv(-1, 0, {{tail.data(), 10}}).get());
+
+  auto stats = ioUring->stats();
+  ASSERT_EQ(kNumBlocks, stats.numWrites);
+  ASSERT_EQ(kNumBlocks + 2, stats.numReads);
+  ASSERT_EQ(1, stats.numErrors);
+  close(fd);
+}
+
 TEST(LocalFile, mkdir) {
   filesystems::registerLocalFileSystem();
   auto tempFolder = ::exec::test::TempDirectoryPath::create();
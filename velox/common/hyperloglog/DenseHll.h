@@ -48,6 +48,11 @@ class DenseHll {
 
   void insertHash(uint64_t hash);
 
+  /// Same as calling insertHash() for each of 'hashes'. Computes the buckets
+  /// and values of a batch of hashes in one loop and skips the values that
+  /// are not greater than the baseline without looking up their buckets.
+  void insertHashes(const uint64_t* hashes, int32_t size);
+
   /// Inserts pre-computed {bucket, value} pair. These value must be compatible
   /// with computeIndex and computeValue methods called with the indexBitLength
   /// value of this HLL. Used by SparseHll.toDense().
@@ -17,6 +17,8 @@
 #include "velox/common/base/IOUtils.h"
 #include "velox/common/hyperloglog/HllUtils.h"
 
+#include <cstring>
+
 namespace facebook::velox::common::hll {
 namespace {
 const int8_t kValueBitLength = 6;
@@ -57,6 +59,32 @@ int searchIndex(
   return -(low + 1);
 }
 
+// Inserts the sparse 'entries' into 'denseHll'.
+void insertIntoDense(
+    const uint32_t* entries,
+    size_t numEntries,
+    DenseHll& denseHll) {
+  auto indexBitLength = denseHll.indexBitLength();
+
+  for (auto i = 0; i < numEntries; i++) {
+    uint32_t entry;
+    std::memcpy(&entry, entries + i, sizeof(entry));
+    auto index = entry >> (32 - indexBitLength);
+    auto shiftedValue = entry << indexBitLength;
+    auto zeros = shiftedValue == 0 ? 32 : __builtin_clz(shiftedValue);
+
+    // If zeros >= kIndexBitLength - indexBitLength, it means all those bits
+    // were zeros, so look at the entry value, which contains the number of
+    // leading 0 *after* kIndexBitLength.
+    auto bits = kIndexBitLength - indexBitLength;
+    if (zeros >= bits) {
+      zeros = bits + decodeValue(entry);
+    }
+
+    denseHll.insert(index, zeros + 1);
+  }
+}
+
 common::InputByteStream initializeInputStream(const char* serialized) {
   common::InputByteStream stream(serialized);
 
@@ -82,6 +110,13 @@ bool SparseHll::insertHash(uint64_t hash) {
     }
   } else {
     auto insertionPosition = -position - 1;
+    if (entries_.size() == entries_.capacity() &&
+        entries_.size() < softNumEntriesLimit_) {
+      // Do not grow past the limit, at which the caller converts to dense, so
+      // that the entries never take more memory than the dense layout.
+      entries_.reserve(std::min<size_t>(
+          std::max<size_t>(2 * entries_.size(), 1), softNumEntriesLimit_));
+    }
     entries_.insert(entries_.begin() + insertionPosition, entry);
   }
 
@@ -162,6 +197,9 @@ SparseHll::SparseHll(const char* serialized, HashStringAllocator* allocator)
 }
 
 void SparseHll::mergeWith(const SparseHll& other) {
+  if (&other == this) {
+    return;
+  }
   auto size = other.entries_.size();
   // This check prevents merge aggregation from being performed on
   // empty_approx_set(), an empty HyperLogLog. The merge function typically does
@@ -187,39 +225,48 @@ void SparseHll::mergeWith(const char* serialized) {
 void SparseHll::mergeWith(size_t otherSize, const uint32_t* otherEntries) {
   VELOX_CHECK_GT(otherSize, 0);
 
-  auto size = entries_.size();
-  std::vector<uint32_t> merged(size + otherSize);
-
-  int pos = 0;
-  int leftPos = 0;
-  int rightPos = 0;
-
-  while (leftPos < size && rightPos < otherSize) {
-    auto left = decodeIndex(entries_[leftPos]);
+  // Merges from the back into the space after the current entries, so that
+  // merging does not allocate a temporary for each input. The merged entries
+  // never overwrite unread entries since there are at least as many free
+  // slots before the write position as unread entries in 'otherEntries'.
+  // Entries with the same index collapse into one, which leaves a gap between
+  // the unmerged head and the merged tail that is closed at the end.
+  const int64_t size = entries_.size();
+  const int64_t mergedSize = size + otherSize;
+  entries_.resize(mergedSize);
+  auto* entries = entries_.data();
+
+  int64_t pos = mergedSize;
+  int64_t leftPos = size - 1;
+  int64_t rightPos = otherSize - 1;
+
+  while (leftPos >= 0 && rightPos >= 0) {
+    auto left = decodeIndex(entries[leftPos]);
     auto right = decodeIndex(otherEntries[rightPos]);
-    if (left < right) {
-      merged[pos++] = entries_[leftPos++];
-    } else if (left > right) {
-      merged[pos++] = otherEntries[rightPos++];
+    if (left > right) {
+      entries[--pos] = entries[leftPos--];
+    } else if (left < right) {
+      entries[--pos] = otherEntries[rightPos--];
     } else {
       auto value = std::max(
-          decodeValue(entries_[leftPos++]),
-          decodeValue(otherEntries[rightPos++]));
-      merged[pos++] = encode(left, value);
+          decodeValue(entries[leftPos--]),
+          decodeValue(otherEntries[rightPos--]));
+      entries[--pos] = encode(left, value);
     }
   }
 
-  while (leftPos < size) {
-    merged[pos++] = entries_[leftPos++];
-  }
-
-  while (rightPos < otherSize) {
-    merged[pos++] = otherEntries[rightPos++];
+  while (rightPos >= 0) {
+    entries[--pos] = otherEntries[rightPos--];
   }
 
-  entries_.resize(pos);
-  for (auto i = 0; i < pos; i++) {
-    entries_[i] = merged[i];
+  // The entries before 'leftPos' + 1 are already in place.
+  const auto numHead = leftPos + 1;
+  if (pos > numHead) {
+    std::memmove(
+        entries + numHead,
+        entries + pos,
+        (mergedSize - pos) * sizeof(uint32_t));
+    entries_.resize(numHead + mergedSize - pos);
   }
 }
 
@@ -237,24 +284,18 @@ void SparseHll::verify() const {
 }
 
 void SparseHll::toDense(DenseHll& denseHll) const {
-  auto indexBitLength = denseHll.indexBitLength();
-
-  for (auto i = 0; i < entries_.size(); i++) {
-    auto entry = entries_[i];
-    auto index = entry >> (32 - indexBitLength);
-    auto shiftedValue = entry << indexBitLength;
-    auto zeros = shiftedValue == 0 ? 32 : __builtin_clz(shiftedValue);
+  insertIntoDense(entries_.data(), entries_.size(), denseHll);
+}
 
-    // If zeros >= kIndexBitLength - indexBitLength, it means all those bits
-    // were zeros, so look at the entry value, which contains the number of
-    // leading 0 *after* kIndexBitLength.
-    auto bits = kIndexBitLength - indexBitLength;
-    if (zeros >= bits) {
-      zeros = bits + decodeValue(entry);
-    }
+// static
+void SparseHll::toDense(const char* serialized, DenseHll& denseHll) {
+  auto stream = initializeInputStream(serialized);
 
-    denseHll.insert(index, zeros + 1);
-  }
+  auto size = stream.read<int16_t>();
+  insertIntoDense(
+      reinterpret_cast<const uint32_t*>(serialized + stream.offset()),
+      size,
+      denseHll);
 }
 
 } // namespace facebook::velox::common::hll
@@ -65,6 +65,10 @@ class SparseHll {
   /// Merges state into provided instance of DenseHll.
   void toDense(DenseHll& denseHll) const;
 
+  /// Merges the state of a serialized SparseHll into 'denseHll' without
+  /// deserializing it.
+  static void toDense(const char* serialized, DenseHll& denseHll);
+
   /// Returns current memory usage.
   int32_t inMemorySize() const;
 
@@ -220,6 +220,24 @@ TEST_P(DenseHllTest, mergeWith) {
   testMergeWith(indexBitLength, sequence(0, 2'000'000), sequence(0, 2'000'000));
 }
 
+TEST_P(DenseHllTest, insertHashes) {
+  int8_t indexBitLength = GetParam();
+
+  for (auto numValues : {10, 1'000, 100'000}) {
+    std::vector<uint64_t> hashes;
+    for (auto i = 0; i < numValues; ++i) {
+      hashes.push_back(hashOne(i));
+    }
+    DenseHll expected{indexBitLength, &allocator_};
+    for (auto hash : hashes) {
+      expected.insertHash(hash);
+    }
+    DenseHll denseHll{indexBitLength, &allocator_};
+    denseHll.insertHashes(hashes.data(), hashes.size());
+    ASSERT_EQ(serialize(denseHll), serialize(expected));
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(
     DenseHllTest,
     DenseHllTest,
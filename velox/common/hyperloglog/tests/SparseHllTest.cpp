@@ -166,6 +166,20 @@ TEST_F(SparseHllTest, mergeWith) {
   // empty sequence
   testMergeWith(sequence(0, 100), {});
   testMergeWith({}, sequence(100, 300));
+
+  // interleaved
+  testMergeWith(sequence(0, 1'000), sequence(500, 600));
+  testMergeWith(sequence(500, 600), sequence(0, 1'000));
+}
+
+TEST_F(SparseHllTest, mergeWithSelf) {
+  SparseHll sparseHll{&allocator_};
+  for (int i = 0; i < 100; i++) {
+    sparseHll.insertHash(hashOne(i));
+  }
+  sparseHll.mergeWith(sparseHll);
+  sparseHll.verify();
+  ASSERT_EQ(100, sparseHll.cardinality());
 }
 
 class SparseHllToDenseTest : public ::testing::TestWithParam<int8_t> {
@@ -197,6 +211,13 @@ TEST_P(SparseHllToDenseTest, toDense) {
   sparseHll.toDense(denseHll);
   ASSERT_EQ(denseHll.cardinality(), expectedHll.cardinality());
   ASSERT_EQ(serialize(denseHll), serialize(expectedHll));
+
+  // Merging the serialized form gives the same result.
+  std::string serialized(sparseHll.serializedSize(), '\0');
+  sparseHll.serialize(indexBitLength, serialized.data());
+  DenseHll fromSerialized{indexBitLength, &allocator_};
+  SparseHll::toDense(serialized.data(), fromSerialized);
+  ASSERT_EQ(serialize(fromSerialized), serialize(expectedHll));
 }
 
 TEST_P(SparseHllToDenseTest, testNumberOfZeros) {
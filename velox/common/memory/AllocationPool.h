@@ -37,6 +37,10 @@ class AllocationPool {
 
   void clear();
 
+  /// Exchanges the allocations of 'this' and 'other'. Both must allocate from
+  /// the same MemoryPool.
+  void swap(AllocationPool& other);
+
   // Allocate a buffer from this pool, optionally aligned.  The alignment can
   // only be power of 2.
   char* allocateFixed(uint64_t bytes, int32_t alignment = 1);
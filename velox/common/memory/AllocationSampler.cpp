@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/common/memory/AllocationSampler.h"
+
+#include <folly/FileUtil.h>
+#include <folly/Random.h>
+#include <fmt/format.h>
+
+#include <cmath>
+#include <map>
+
+#include "velox/common/process/StackTrace.h"
+
+namespace facebook::velox::memory {
+
+namespace {
+// Returns the number of bytes to allocate before the next sample, drawn from
+// an exponential distribution so that each byte is equally likely to be
+// sampled.
+int64_t nextSampleInterval(uint64_t sampleBytes) {
+  const double u = 1 - folly::Random::randDouble01();
+  return std::max<int64_t>(1, -std::log(u) * sampleBytes);
+}
+} // namespace
+
+// static
+AllocationSampler& AllocationSampler::instance() {
+  static AllocationSampler* sampler = new AllocationSampler();
+  return *sampler;
+}
+
+bool AllocationSampler::shouldSampleSlow(uint64_t size, uint64_t sampleBytes) {
+  // Bytes the calling thread allocates before its next sample, 0 before the
+  // first allocation with sampling on.
+  thread_local int64_t bytesToNextSample{0};
+  if (bytesToNextSample == 0) {
+    bytesToNextSample = nextSampleInterval(sampleBytes);
+  }
+  if (static_cast<int64_t>(size) < bytesToNextSample) {
+    bytesToNextSample -= size;
+    return false;
+  }
+  bytesToNextSample = nextSampleInterval(sampleBytes);
+  return true;
+}
+
+void AllocationSampler::recordAlloc(
+    const std::string& poolName,
+    const void* address,
+    uint64_t size) {
+  const auto sampleBytes = std::max<uint64_t>(1, this->sampleBytes());
+  // An allocation of 'size' bytes is sampled with probability
+  // 1 - exp(-size / sampleBytes).
+  const double probability =
+      1 - std::exp(-static_cast<double>(size) / sampleBytes);
+  Sample sample{
+      poolName,
+      size,
+      static_cast<int64_t>(size / std::max(probability, 1e-9)),
+      // Skips the frame of this function.
+      process::StackTrace(1).getStack()};
+  auto& shard = this->shard(address);
+  std::lock_guard<std::mutex> l(shard.mutex);
+  shard.samples.insert_or_assign(
+      reinterpret_cast<uintptr_t>(address), std::move(sample));
+}
+
+bool AllocationSampler::recordFree(const void* address) {
+  auto& shard = this->shard(address);
+  std::lock_guard<std::mutex> l(shard.mutex);
+  return shard.samples.erase(reinterpret_cast<uintptr_t>(address)) > 0;
+}
+
+std::unordered_map<std::string, int64_t> AllocationSampler::liveBytesByPool()
+    const {
+  std::unordered_map<std::string, int64_t> result;
+  for (const auto& shard : shards_) {
+    std::lock_guard<std::mutex> l(shard.mutex);
+    for (const auto& [address, sample] : shard.samples) {
+      result[sample.poolName] += sample.estimatedBytes;
+    }
+  }
+  return result;
+}
+
+std::string AllocationSampler::toPprof(const std::string& poolName) const {
+  struct Totals {
+    int64_t count{0};
+    int64_t bytes{0};
+  };
+  std::map<std::vector<void*>, Totals> stacks;
+  Totals total;
+  for (const auto& shard : shards_) {
+    std::lock_guard<std::mutex> l(shard.mutex);
+    for (const auto& [address, sample] : shard.samples) {
+      if (sample.poolName.compare(0, poolName.size(), poolName) != 0) {
+        continue;
+      }
+      auto& totals = stacks[sample.frames];
+      ++totals.count;
+      totals.bytes += sample.size;
+      ++total.count;
+      total.bytes += sample.size;
+    }
+  }
+
+  // The sampled sizes are reported as is. The heap_v2 header tells pprof the
+  // mean sampling interval, from which it scales them up.
+  std::string out = fmt::format(
+      "heap profile: {}: {} [{}: {}] @ heap_v2/{}\n",
+      total.count,
+      total.bytes,
+      total.count,
+      total.bytes,
+      sampleBytes());
+  for (const auto& [frames, totals] : stacks) {
+    out += fmt::format(
+        "{}: {} [{}: {}] @",
+        totals.count,
+        totals.bytes,
+        totals.count,
+        totals.bytes);
+    for (auto* frame : frames) {
+      out += fmt::format(" {}", frame);
+    }
+    out += '\n';
+  }
+  std::string maps;
+  if (folly::readFile("/proc/self/maps", maps)) {
+    out += "\nMAPPED_LIBRARIES:\n";
+    out += maps;
+  }
+  return out;
+}
+
+size_t AllocationSampler::numSamples() const {
+  size_t count = 0;
+  for (const auto& shard : shards_) {
+    std::lock_guard<std::mutex> l(shard.mutex);
+    count += shard.samples.size();
+  }
+  return count;
+}
+
+void AllocationSampler::testingClear() {
+  for (auto& shard : shards_) {
+    std::lock_guard<std::mutex> l(shard.mutex);
+    shard.samples.clear();
+  }
+}
+
+} // namespace facebook::velox::memory
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/CppAttributes.h>
+#include <folly/container/F14Map.h>
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace facebook::velox::memory {
+
+/// Samples the allocations of memory pools to attribute the live bytes of
+/// each pool to the call stacks that allocated them. Allocations are sampled
+/// with a probability proportional to their size, on average one for every
+/// sampleBytes() bytes allocated, like tcmalloc's heap profiler. Sampling is
+/// off by default and can be turned on and off at runtime. A sampled
+/// allocation records its raw call stack until freed. Sampling is
+/// process-wide and thread safe.
+class AllocationSampler {
+ public:
+  static AllocationSampler& instance();
+
+  /// Sets the mean number of bytes allocated between samples. 0 turns
+  /// sampling off. The allocations sampled before stay recorded until freed.
+  void setSampleBytes(uint64_t bytes) {
+    sampleBytes_ = bytes;
+  }
+
+  uint64_t sampleBytes() const {
+    return sampleBytes_.load(std::memory_order_relaxed);
+  }
+
+  /// Returns true if an allocation of 'size' bytes on the calling thread is
+  /// to be sampled. Costs a relaxed atomic load if sampling is off.
+  bool shouldSample(uint64_t size) {
+    const auto sampleBytes = this->sampleBytes();
+    if (FOLLY_LIKELY(sampleBytes == 0)) {
+      return false;
+    }
+    return shouldSampleSlow(size, sampleBytes);
+  }
+
+  /// Records the sampled allocation of 'size' bytes at 'address' from the
+  /// memory pool 'poolName' with the call stack of the caller.
+  void recordAlloc(
+      const std::string& poolName,
+      const void* address,
+      uint64_t size);
+
+  /// Removes the record of the allocation at 'address'. Returns false if the
+  /// allocation was not sampled.
+  bool recordFree(const void* address);
+
+  /// Returns the estimated live bytes of the sampled pools by pool name.
+  std::unordered_map<std::string, int64_t> liveBytesByPool() const;
+
+  /// Returns the live sampled allocations in the legacy text heap profile
+  /// format that 'pprof' reads, followed by the memory mappings of the
+  /// process for symbolization, e.g. 'pprof --text <binary> <file>'. If
+  /// 'poolName' is not empty, includes only the allocations of pools whose
+  /// name starts with 'poolName'.
+  std::string toPprof(const std::string& poolName = "") const;
+
+  /// Returns the number of live sampled allocations.
+  size_t numSamples() const;
+
+  void testingClear();
+
+ private:
+  static constexpr int32_t kNumShards = 16;
+
+  struct Sample {
+    std::string poolName;
+    uint64_t size;
+    // Estimate of the bytes represented by the sample.
+    int64_t estimatedBytes;
+    std::vector<void*> frames;
+  };
+
+  struct Shard {
+    mutable std::mutex mutex;
+    folly::F14FastMap<uintptr_t, Sample> samples;
+  };
+
+  AllocationSampler() = default;
+
+  bool shouldSampleSlow(uint64_t size, uint64_t sampleBytes);
+
+  Shard& shard(const void* address) {
+    return shards_[(reinterpret_cast<uintptr_t>(address) >> 6) % kNumShards];
+  }
+
+  std::atomic<uint64_t> sampleBytes_{0};
+  std::array<Shard, kNumShards> shards_;
+};
+
+} // namespace facebook::velox::memory
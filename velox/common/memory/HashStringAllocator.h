@@ -324,6 +324,14 @@ class HashStringAllocator : public StreamArena {
     return minFree;
   }
 
+  /// Returns the bytes in free blocks, including their headers. A large
+  /// share of retainedSize() in free blocks that are too small for new
+  /// allocations means that the memory is fragmented, e.g. after many small
+  /// live blocks have been freed and reallocated elsewhere.
+  uint64_t freeBytes() const {
+    return freeBytes_;
+  }
+
   // Frees all memory associated with 'this' and leaves 'this' ready for reuse.
   void clear();
 
@@ -36,7 +36,9 @@ MemoryManager::MemoryManager(const MemoryManagerOptions& options)
            .capacity = std::min(options.queryMemoryCapacity, options.capacity),
            .memoryPoolInitCapacity = options.memoryPoolInitCapacity,
            .memoryPoolTransferCapacity = options.memoryPoolTransferCapacity,
-           .retryArbitrationFailure = options.retryArbitrationFailure})),
+           .retryArbitrationFailure = options.retryArbitrationFailure,
+           .poolPolicy = options.arbitrationPoolPolicy,
+           .arbitrationExecutor = options.arbitrationExecutor})),
       alignment_(std::max(MemoryAllocator::kMinAlignment, options.alignment)),
       checkUsageLeak_(options.checkUsageLeak),
       debugEnabled_(options.debugEnabled),
@@ -164,6 +166,15 @@ bool MemoryManager::growPool(MemoryPool* pool, uint64_t incrementBytes) {
   return arbitrator_->growMemory(pool, getAlivePools(), incrementBytes);
 }
 
+folly::SemiFuture<bool> MemoryManager::growPoolAsync(
+    MemoryPool* pool,
+    uint64_t incrementBytes) {
+  VELOX_CHECK_NOT_NULL(pool);
+  VELOX_CHECK_NE(pool->capacity(), kMaxMemory);
+  return arbitrator_->growMemoryAsync(
+      pool->shared_from_this(), getAlivePools(), incrementBytes);
+}
+
 uint64_t MemoryManager::shrinkPools(uint64_t targetBytes) {
   return arbitrator_->shrinkMemory(getAlivePools(), targetBytes);
 }
@@ -113,6 +113,15 @@ struct MemoryManagerOptions {
   /// same query on all the workers instead of a random victim query which
   /// happens to trigger the failed memory arbitration.
   bool retryArbitrationFailure{true};
+
+  /// Returns the arbitration settings of a root memory pool. See
+  /// MemoryArbitrator::Config::poolPolicy.
+  std::function<MemoryArbitrator::PoolPolicy(const MemoryPool& pool)>
+      arbitrationPoolPolicy;
+
+  /// The executor to run asynchronous memory arbitration requests. See
+  /// MemoryArbitrator::Config::arbitrationExecutor.
+  folly::Executor* arbitrationExecutor{nullptr};
 };
 
 /// 'MemoryManager' is responsible for managing the memory pools. For now, users
@@ -165,6 +174,13 @@ class MemoryManager {
   /// 'incrementBytes'. The function returns true on success, otherwise false.
   bool growPool(MemoryPool* pool, uint64_t incrementBytes);
 
+  /// Asynchronous variant of growPool(). Returns an invalid future if the
+  /// arbitrator does not support asynchronous arbitration. See
+  /// MemoryArbitrator::growMemoryAsync().
+  folly::SemiFuture<bool> growPoolAsync(
+      MemoryPool* pool,
+      uint64_t incrementBytes);
+
   /// Invoked to shrink alive pools to free 'targetBytes' capacity. The function
   /// returns the actual freed memory capacity in bytes.
   uint64_t shrinkPools(uint64_t targetBytes);
@@ -16,8 +16,11 @@
 
 #pragma once
 
+#include <functional>
 #include <vector>
 
+#include <folly/Executor.h>
+
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/future/VeloxPromise.h"
@@ -40,6 +43,17 @@ class MemoryPool;
 /// (see Kind definition below).
 class MemoryArbitrator {
  public:
+  /// The arbitration settings of a root memory pool.
+  struct PoolPolicy {
+    /// Pools with lower priority are reclaimed from and aborted before pools
+    /// with higher priority.
+    int32_t priority{0};
+
+    /// The capacity that is not reclaimed from the pool to grow other pools.
+    /// The pool can still be aborted if the arbitration fails.
+    uint64_t minCapacity{0};
+  };
+
   struct Config {
     /// The string kind of this memory arbitrator.
     ///
@@ -67,6 +81,16 @@ class MemoryArbitrator {
     /// same query on all the workers instead of a random victim query which
     /// happens to trigger the failed memory arbitration.
     bool retryArbitrationFailure{true};
+
+    /// Returns the arbitration settings of a root memory pool, e.g. by the
+    /// query id in the pool name. If not set, all the pools have the default
+    /// settings.
+    std::function<PoolPolicy(const MemoryPool& pool)> poolPolicy;
+
+    /// If set, growMemoryAsync() runs the memory arbitration on this executor
+    /// instead of the requesting thread. The executor must outlive the
+    /// arbitrator.
+    folly::Executor* arbitrationExecutor{nullptr};
   };
 
   using Factory = std::function<std::unique_ptr<MemoryArbitrator>(
@@ -141,6 +165,19 @@ class MemoryArbitrator {
       const std::vector<std::shared_ptr<MemoryPool>>& candidatePools,
       uint64_t targetBytes) = 0;
 
+  /// Asynchronous variant of growMemory() for callers which can wait without
+  /// holding a thread, e.g. a driver blocked on kWaitForMemory. The returned
+  /// future is fulfilled with the result of growMemory() run on the
+  /// arbitration executor. Returns an invalid future if the arbitrator has no
+  /// arbitration executor, in which case the caller falls back to grow the
+  /// memory synchronously on allocation.
+  virtual folly::SemiFuture<bool> growMemoryAsync(
+      std::shared_ptr<MemoryPool> /*unused*/,
+      std::vector<std::shared_ptr<MemoryPool>> /*unused*/,
+      uint64_t /*unused*/) {
+    return folly::SemiFuture<bool>::makeEmpty();
+  }
+
   /// Invoked by the memory manager to shrink memory from a given list of memory
   /// pools. The freed memory capacity is given back to the arbitrator. The
   /// function returns the actual freed memory capacity in bytes.
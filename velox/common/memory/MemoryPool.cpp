@@ -202,7 +202,9 @@ MemoryPool::MemoryPool(
       trackUsage_(options.trackUsage),
       threadSafe_(options.threadSafe),
       checkUsageLeak_(options.checkUsageLeak),
-      debugEnabled_(options.debugEnabled) {
+      debugEnabled_(options.debugEnabled),
+      slabCacheBytes_(options.slabCacheBytes),
+      reservationSlackBytes_(options.reservationSlackBytes) {
   VELOX_CHECK(!isRoot() || !isLeaf());
   VELOX_CHECK_GT(
       maxCapacity_, 0, "Memory pool {} max capacity can't be zero", name_);
@@ -371,6 +373,12 @@ MemoryPoolImpl::MemoryPoolImpl(
       manager_{memoryManager},
       allocator_{&manager_->allocator()},
       destructionCb_(std::move(destructionCb)),
+      slabCache_(
+          isLeaf() && slabCacheBytes_ > 0 &&
+                  alignment_ <= SlabCache::kMinClassBytes
+              ? std::make_unique<SlabCache>(
+                    allocator_, alignment_, slabCacheBytes_, threadSafe_)
+              : nullptr),
       debugPoolNameRegex_(debugEnabled_ ? *(debugPoolNameRegex().rlock()) : ""),
       reclaimer_(std::move(reclaimer)),
       // The memory manager sets the capacity through grow() according to the
@@ -419,29 +427,45 @@ MemoryPool::Stats MemoryPoolImpl::statsLocked() const {
   stats.numReserves = numReserves_;
   stats.numReleases = numReleases_;
   stats.numCollisions = numCollisions_;
+  if (slabCache_ != nullptr) {
+    const auto slabStats = slabCache_->stats();
+    stats.numSlabHits = slabStats.numHits;
+    stats.numSlabMisses = slabStats.numMisses;
+  }
   return stats;
 }
 
 void* MemoryPoolImpl::allocate(int64_t size) {
   CHECK_AND_INC_MEM_OP_STATS(Allocs);
-  const auto alignedSize = sizeAlign(size);
+  const auto alignedSize = allocationBytes(sizeAlign(size));
   reserve(alignedSize);
-  void* buffer = allocator_->allocateBytes(alignedSize, alignment_);
+  void* buffer = allocateBytes(alignedSize);
   if (FOLLY_UNLIKELY(buffer == nullptr)) {
     release(alignedSize);
     VELOX_MEM_ALLOC_ERROR(fmt::format(
         "{} failed with {} bytes from {}", __FUNCTION__, size, toString()));
   }
   DEBUG_RECORD_ALLOC(buffer, size);
+  sampleAlloc(buffer, size);
   return buffer;
 }
 
 void* MemoryPoolImpl::allocateZeroFilled(int64_t numEntries, int64_t sizeEach) {
   CHECK_AND_INC_MEM_OP_STATS(Allocs);
   const auto size = sizeEach * numEntries;
-  const auto alignedSize = sizeAlign(size);
+  const auto alignedSize = allocationBytes(sizeAlign(size));
   reserve(alignedSize);
-  void* buffer = allocator_->allocateZeroFilled(alignedSize);
+  void* buffer;
+  if (slabCache_ != nullptr && SlabCache::classBytes(alignedSize) != 0) {
+    // A buffer of a cached size class may come from 'slabCache_' and must be
+    // allocated with the class size since it is freed with that size.
+    buffer = allocateBytes(alignedSize);
+    if (buffer != nullptr) {
+      ::memset(buffer, 0, size);
+    }
+  } else {
+    buffer = allocator_->allocateZeroFilled(alignedSize);
+  }
   if (FOLLY_UNLIKELY(buffer == nullptr)) {
     release(alignedSize);
     VELOX_MEM_ALLOC_ERROR(fmt::format(
@@ -452,15 +476,16 @@ void* MemoryPoolImpl::allocateZeroFilled(int64_t numEntries, int64_t sizeEach) {
         toString()));
   }
   DEBUG_RECORD_ALLOC(buffer, size);
+  sampleAlloc(buffer, size);
   return buffer;
 }
 
 void* MemoryPoolImpl::reallocate(void* p, int64_t size, int64_t newSize) {
   CHECK_AND_INC_MEM_OP_STATS(Allocs);
-  const auto alignedNewSize = sizeAlign(newSize);
+  const auto alignedNewSize = allocationBytes(sizeAlign(newSize));
   reserve(alignedNewSize);
 
-  void* newP = allocator_->allocateBytes(alignedNewSize, alignment_);
+  void* newP = allocateBytes(alignedNewSize);
   if (FOLLY_UNLIKELY(newP == nullptr)) {
     release(alignedNewSize);
     VELOX_MEM_ALLOC_ERROR(fmt::format(
@@ -471,6 +496,7 @@ void* MemoryPoolImpl::reallocate(void* p, int64_t size, int64_t newSize) {
         toString()));
   }
   DEBUG_RECORD_ALLOC(newP, newSize);
+  sampleAlloc(newP, newSize);
   if (p != nullptr) {
     ::memcpy(newP, p, std::min(size, newSize));
     free(p, size);
@@ -480,12 +506,32 @@ void* MemoryPoolImpl::reallocate(void* p, int64_t size, int64_t newSize) {
 
 void MemoryPoolImpl::free(void* p, int64_t size) {
   CHECK_AND_INC_MEM_OP_STATS(Frees);
-  const auto alignedSize = sizeAlign(size);
+  const auto alignedSize = allocationBytes(sizeAlign(size));
   DEBUG_RECORD_FREE(p, size);
-  allocator_->freeBytes(p, alignedSize);
+  sampleFree(p);
+  freeBytes(p, alignedSize);
   release(alignedSize);
 }
 
+void* MemoryPoolImpl::allocateBytes(uint64_t alignedSize) {
+  if (slabCache_ != nullptr) {
+    if (const auto classBytes = SlabCache::classBytes(alignedSize)) {
+      return slabCache_->allocate(classBytes);
+    }
+  }
+  return allocator_->allocateBytes(alignedSize, alignment_);
+}
+
+void MemoryPoolImpl::freeBytes(void* p, uint64_t alignedSize) {
+  if (slabCache_ != nullptr) {
+    if (const auto classBytes = SlabCache::classBytes(alignedSize)) {
+      slabCache_->free(p, classBytes);
+      return;
+    }
+  }
+  allocator_->freeBytes(p, alignedSize);
+}
+
 void MemoryPoolImpl::allocateNonContiguous(
     MachinePageCount numPages,
     Allocation& out,
@@ -499,6 +545,7 @@ void MemoryPoolImpl::allocateNonContiguous(
       "facebook::velox::common::memory::MemoryPoolImpl::allocateNonContiguous",
       this);
   DEBUG_RECORD_FREE(out);
+  sampleFree(out);
   if (!allocator_->allocateNonContiguous(
           numPages,
           out,
@@ -515,6 +562,7 @@ void MemoryPoolImpl::allocateNonContiguous(
         "{} failed with {} pages from {}", __FUNCTION__, numPages, toString()));
   }
   DEBUG_RECORD_ALLOC(out);
+  sampleAlloc(out);
   VELOX_CHECK(!out.empty());
   VELOX_CHECK_NULL(out.pool());
   out.setPool(this);
@@ -523,6 +571,7 @@ void MemoryPoolImpl::allocateNonContiguous(
 void MemoryPoolImpl::freeNonContiguous(Allocation& allocation) {
   CHECK_AND_INC_MEM_OP_STATS(Frees);
   DEBUG_RECORD_FREE(allocation);
+  sampleFree(allocation);
   const int64_t freedBytes = allocator_->freeNonContiguous(allocation);
   VELOX_CHECK(allocation.empty());
   release(freedBytes);
@@ -546,6 +595,7 @@ void MemoryPoolImpl::allocateContiguous(
   }
   VELOX_CHECK_GT(numPages, 0);
   DEBUG_RECORD_FREE(out);
+  sampleFree(out);
   if (!allocator_->allocateContiguous(
           numPages,
           nullptr,
@@ -563,6 +613,7 @@ void MemoryPoolImpl::allocateContiguous(
         "{} failed with {} pages from {}", __FUNCTION__, numPages, toString()));
   }
   DEBUG_RECORD_ALLOC(out);
+  sampleAlloc(out);
   VELOX_CHECK(!out.empty());
   VELOX_CHECK_NULL(out.pool());
   out.setPool(this);
@@ -572,6 +623,7 @@ void MemoryPoolImpl::freeContiguous(ContiguousAllocation& allocation) {
   CHECK_AND_INC_MEM_OP_STATS(Frees);
   const int64_t bytesToFree = allocation.size();
   DEBUG_RECORD_FREE(allocation);
+  sampleFree(allocation);
   allocator_->freeContiguous(allocation);
   VELOX_CHECK(allocation.empty());
   release(bytesToFree);
@@ -625,7 +677,9 @@ std::shared_ptr<MemoryPool> MemoryPoolImpl::genChild(
           .trackUsage = trackUsage_,
           .threadSafe = threadSafe,
           .checkUsageLeak = checkUsageLeak_,
-          .debugEnabled = debugEnabled_});
+          .debugEnabled = debugEnabled_,
+          .slabCacheBytes = slabCacheBytes_,
+          .reservationSlackBytes = reservationSlackBytes_});
 }
 
 bool MemoryPoolImpl::maybeReserve(uint64_t increment) {
@@ -668,10 +722,11 @@ void MemoryPoolImpl::reserveThreadSafe(uint64_t size, bool reserveOnly) {
 
   int32_t numAttempts = 0;
   int64_t increment = 0;
+  bool withSlack = reservationSlackBytes_ > 0;
   for (;; ++numAttempts) {
     {
       std::lock_guard<std::mutex> l(mutex_);
-      increment = reservationSizeLocked(size);
+      increment = reservationSizeLocked(size, withSlack);
       if (increment == 0) {
         if (reserveOnly) {
           minReservationBytes_ = tsanAtomicValue(reservationBytes_);
@@ -689,6 +744,11 @@ void MemoryPoolImpl::reserveThreadSafe(uint64_t size, bool reserveOnly) {
     try {
       incrementReservationThreadSafe(this, increment);
     } catch (const std::exception& e) {
+      // Retry without the slack before failing the reservation.
+      if (withSlack && !aborted()) {
+        withSlack = false;
+        continue;
+      }
       // When race with concurrent memory reservation free, we might end up with
       // unused reservation but no used reservation if a retry memory
       // reservation attempt run into memory capacity exceeded error.
@@ -783,6 +843,10 @@ bool MemoryPoolImpl::maybeIncrementReservationLocked(uint64_t size) {
 
 void MemoryPoolImpl::release() {
   CHECK_AND_INC_MEM_OP_STATS(Releases);
+  // The cached buffers are not reserved but hold memory of the allocator.
+  if (slabCache_ != nullptr) {
+    slabCache_->clear();
+  }
   release(0, true);
 }
 
@@ -815,7 +879,7 @@ void MemoryPoolImpl::releaseThreadSafe(uint64_t size, bool releaseOnly) {
       usedReservationBytes_ -= size;
       const int64_t newCap =
           std::max(minReservationBytes_, usedReservationBytes_);
-      newQuantized = quantizedSize(newCap);
+      newQuantized = releasedReservationLocked(newCap);
     }
     freeable = reservationBytes_ - newQuantized;
     if (freeable > 0) {
@@ -914,6 +978,11 @@ bool MemoryPoolImpl::reclaimableBytes(uint64_t& reclaimableBytes) const {
 }
 
 uint64_t MemoryPoolImpl::reclaim(uint64_t targetBytes) {
+  // The cached buffers go back to the allocator. They are not counted as
+  // reclaimed since they are not reserved.
+  if (slabCache_ != nullptr) {
+    slabCache_->clear();
+  }
   if (reclaimer() == nullptr) {
     return 0;
   }
@@ -947,6 +1016,13 @@ uint64_t MemoryPoolImpl::shrink(uint64_t targetBytes) {
   return freeBytes;
 }
 
+folly::SemiFuture<bool> MemoryPoolImpl::growCapacityAsync(uint64_t bytes) {
+  if (capacity() == kMaxMemory) {
+    return folly::makeSemiFuture(true);
+  }
+  return manager_->growPoolAsync(this, bytes);
+}
+
 uint64_t MemoryPoolImpl::grow(uint64_t bytes) noexcept {
   if (parent_ != nullptr) {
     return parent_->grow(bytes);
@@ -27,11 +27,15 @@
 #include "velox/common/base/Portability.h"
 #include "velox/common/future/VeloxPromise.h"
 #include "velox/common/memory/Allocation.h"
+#include "velox/common/memory/AllocationSampler.h"
 #include "velox/common/memory/MemoryAllocator.h"
 #include "velox/common/memory/MemoryArbitrator.h"
+#include "velox/common/memory/SlabCache.h"
 
 DECLARE_bool(velox_memory_leak_check_enabled);
 DECLARE_bool(velox_memory_pool_debug_enabled);
+DECLARE_int32(velox_memory_pool_slab_cache_kb);
+DECLARE_int32(velox_memory_pool_reservation_slack_mb);
 
 namespace facebook::velox::memory {
 #define VELOX_MEM_POOL_CAP_EXCEEDED(errorMessage)                   \
@@ -157,6 +161,19 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
     /// If true, tracks the allocation and free call stacks to detect the source
     /// of memory leak for testing purpose.
     bool debugEnabled{FLAGS_velox_memory_pool_debug_enabled};
+
+    /// The capacity in bytes of the cache of freed small buffers of a leaf
+    /// memory pool. See SlabCache. 0 disables the cache.
+    uint64_t slabCacheBytes{
+        static_cast<uint64_t>(FLAGS_velox_memory_pool_slab_cache_kb) << 10};
+
+    /// The max unused reservation in bytes a leaf memory pool keeps on top of
+    /// its used reservation. The slack is capped by the used reservation so
+    /// that a growing pool reserves in increasing quanta and a shrinking pool
+    /// releases lazily. 0 reserves the quantized usage only.
+    uint64_t reservationSlackBytes{
+        static_cast<uint64_t>(FLAGS_velox_memory_pool_reservation_slack_mb)
+        << 20};
   };
 
   /// Constructs a named memory pool with specified 'name', 'parent' and 'kind'.
@@ -373,6 +390,13 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   /// returns the memory pool's capacity after the growth.
   virtual uint64_t grow(uint64_t bytes) noexcept = 0;
 
+  /// Starts to grow the capacity of the root of this memory pool by 'bytes'
+  /// through memory arbitration without blocking the calling thread. The
+  /// returned future is fulfilled with true if the capacity has grown. Returns
+  /// an invalid future if the memory arbitrator can't arbitrate
+  /// asynchronously. See MemoryManager::growPoolAsync().
+  virtual folly::SemiFuture<bool> growCapacityAsync(uint64_t bytes) = 0;
+
   /// Sets the memory reclaimer for this memory pool.
   ///
   /// NOTE: this shall only be called at most once if the memory pool hasn't set
@@ -449,6 +473,10 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
     /// The number of internal memory reservation collisions caused by
     /// concurrent memory requests.
     uint64_t numCollisions{0};
+    /// The number of allocations served from and the number of allocations of
+    /// a cached size that missed the cache of freed small buffers.
+    uint64_t numSlabHits{0};
+    uint64_t numSlabMisses{0};
 
     bool operator==(const Stats& rhs) const;
 
@@ -519,6 +547,8 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   const bool threadSafe_;
   const bool checkUsageLeak_;
   const bool debugEnabled_;
+  const uint64_t slabCacheBytes_;
+  const uint64_t reservationSlackBytes_;
 
   /// Indicates if the memory pool has been aborted by the memory arbitrator or
   /// not.
@@ -627,6 +657,8 @@ class MemoryPoolImpl : public MemoryPool {
 
   uint64_t grow(uint64_t bytes) noexcept override;
 
+  folly::SemiFuture<bool> growCapacityAsync(uint64_t bytes) override;
+
   void abort(const std::exception_ptr& error) override;
 
   bool aborted() const override;
@@ -744,8 +776,9 @@ class MemoryPoolImpl : public MemoryPool {
     VELOX_CHECK(isLeaf());
 
     int32_t numAttempts{0};
+    bool withSlack{reservationSlackBytes_ > 0};
     for (;; ++numAttempts) {
-      int64_t increment = reservationSizeLocked(size);
+      int64_t increment = reservationSizeLocked(size, withSlack);
       if (FOLLY_LIKELY(increment == 0)) {
         if (FOLLY_UNLIKELY(reserveOnly)) {
           minReservationBytes_ = tsanAtomicValue(reservationBytes_);
@@ -757,7 +790,15 @@ class MemoryPoolImpl : public MemoryPool {
         sanityCheckLocked();
         break;
       }
-      incrementReservationNonThreadSafe(this, increment);
+      try {
+        incrementReservationNonThreadSafe(this, increment);
+      } catch (const std::exception&) {
+        // Retry without the slack before failing the reservation.
+        if (!withSlack || aborted()) {
+          throw;
+        }
+        withSlack = false;
+      }
     }
 
     // NOTE: in case of concurrent reserve requests to the same root memory pool
@@ -796,14 +837,38 @@ class MemoryPoolImpl : public MemoryPool {
   }
 
   // Returns the needed reservation size. If there is sufficient unused memory
-  // reservation, this function returns zero.
-  FOLLY_ALWAYS_INLINE int64_t reservationSizeLocked(int64_t size) {
+  // reservation, this function returns zero. If 'withSlack' is true, the
+  // returned size includes the reservation slack for the new usage.
+  FOLLY_ALWAYS_INLINE int64_t
+  reservationSizeLocked(int64_t size, bool withSlack = false) {
     const int64_t neededSize =
         size - (reservationBytes_ - usedReservationBytes_);
     if (neededSize <= 0) {
       return 0;
     }
-    return roundedDelta(reservationBytes_, neededSize);
+    const int64_t slack =
+        withSlack ? reservationSlackLocked(usedReservationBytes_ + size) : 0;
+    return roundedDelta(reservationBytes_, neededSize + slack);
+  }
+
+  // Returns the unused reservation kept on top of 'usedBytes'. Grows with the
+  // usage up to 'reservationSlackBytes_'.
+  FOLLY_ALWAYS_INLINE int64_t reservationSlackLocked(int64_t usedBytes) const {
+    return std::min<int64_t>(reservationSlackBytes_, usedBytes);
+  }
+
+  // Returns the reservation to keep for 'newCap' bytes of needed reservation
+  // after a release. With a reservation slack, the reservation is only shrunk
+  // once the unused part exceeds twice the slack.
+  FOLLY_ALWAYS_INLINE int64_t releasedReservationLocked(int64_t newCap) const {
+    if (reservationSlackBytes_ == 0) {
+      return quantizedSize(newCap);
+    }
+    const int64_t slack = reservationSlackLocked(newCap);
+    if (reservationBytes_ <= quantizedSize(newCap + 2 * slack)) {
+      return reservationBytes_;
+    }
+    return quantizedSize(newCap + slack);
   }
 
   FOLLY_ALWAYS_INLINE void maybeUpdatePeakBytesLocked(int64_t newPeak) {
@@ -842,7 +907,7 @@ class MemoryPoolImpl : public MemoryPool {
       usedReservationBytes_ -= size;
       const int64_t newCap =
           std::max(minReservationBytes_, usedReservationBytes_);
-      newQuantized = quantizedSize(newCap);
+      newQuantized = releasedReservationLocked(newCap);
     }
 
     const int64_t freeable = reservationBytes_ - newQuantized;
@@ -867,6 +932,26 @@ class MemoryPoolImpl : public MemoryPool {
 
   Stats statsLocked() const;
 
+  // Returns the bytes to allocate and reserve for a buffer of 'alignedSize'.
+  // This is the size class of 'slabCache_' if the size is cached, so that a
+  // buffer put in the cache on free is as large as its size class.
+  uint64_t allocationBytes(uint64_t alignedSize) const {
+    if (slabCache_ != nullptr) {
+      if (const auto classBytes = SlabCache::classBytes(alignedSize)) {
+        return classBytes;
+      }
+    }
+    return alignedSize;
+  }
+
+  // Allocates a buffer of 'alignedSize' from 'slabCache_' if the size is
+  // cached, otherwise from the allocator. 'alignedSize' is a value returned by
+  // allocationBytes().
+  void* allocateBytes(uint64_t alignedSize);
+
+  // Frees a buffer allocated by allocateBytes().
+  void freeBytes(void* p, uint64_t alignedSize);
+
   FOLLY_ALWAYS_INLINE std::string toStringLocked() const {
     std::stringstream out;
     out << "Memory Pool[" << name_ << " " << kindString(kind_) << " root["
@@ -932,6 +1017,48 @@ class MemoryPoolImpl : public MemoryPool {
   // Accounts for ContiguousAllocation size change in growContiguous().
   void recordGrowDbg(const void* addr, uint64_t newSize);
 
+  // Records the call stack of a buffer allocation if AllocationSampler
+  // samples it.
+  void sampleAlloc(const void* addr, uint64_t size) {
+    if (FOLLY_UNLIKELY(AllocationSampler::instance().shouldSample(size))) {
+      AllocationSampler::instance().recordAlloc(name_, addr, size);
+      ++numSampledAllocs_;
+    }
+  }
+
+  void sampleAlloc(const Allocation& allocation) {
+    if (!allocation.empty()) {
+      sampleAlloc(allocation.runAt(0).data(), allocation.byteSize());
+    }
+  }
+
+  void sampleAlloc(const ContiguousAllocation& allocation) {
+    if (!allocation.empty()) {
+      sampleAlloc(allocation.data(), allocation.size());
+    }
+  }
+
+  // Removes the record of a buffer allocation if it was sampled. Costs an
+  // atomic load if no allocation of this pool is sampled.
+  void sampleFree(const void* addr) {
+    if (FOLLY_UNLIKELY(numSampledAllocs_ > 0) && addr != nullptr &&
+        AllocationSampler::instance().recordFree(addr)) {
+      --numSampledAllocs_;
+    }
+  }
+
+  void sampleFree(const Allocation& allocation) {
+    if (!allocation.empty()) {
+      sampleFree(allocation.runAt(0).data());
+    }
+  }
+
+  void sampleFree(const ContiguousAllocation& allocation) {
+    if (!allocation.empty()) {
+      sampleFree(allocation.data());
+    }
+  }
+
   // Invoked by memory pool destructor to detect the sources of leaked memory
   // allocations from the call sites which are still recorded in
   // 'debugAllocRecords_'. If there is no memory leaks, 'debugAllocRecords_'
@@ -943,6 +1070,8 @@ class MemoryPoolImpl : public MemoryPool {
   MemoryManager* const manager_;
   MemoryAllocator* const allocator_;
   const DestructionCallback destructionCb_;
+  // Caches freed small buffers of a leaf pool. Null if disabled.
+  const std::unique_ptr<SlabCache> slabCache_;
 
   // Regex for filtering on 'name_' when debug mode is enabled. This allows us
   // to only track the callsites of memory allocations for memory pools whose
@@ -997,6 +1126,10 @@ class MemoryPoolImpl : public MemoryPool {
   // memory reservation requests.
   std::atomic<uint64_t> numCollisions_{0};
 
+  // The number of live allocations of this pool recorded by
+  // AllocationSampler.
+  std::atomic<int64_t> numSampledAllocs_{0};
+
   // Mutex for 'debugAllocRecords_'.
   std::mutex debugAllocMutex_;
 
@@ -20,6 +20,7 @@
 
 #include "velox/common/base/Portability.h"
 #include "velox/common/memory/Memory.h"
+#include "velox/common/process/ProcessBase.h"
 
 namespace facebook::velox::memory {
 MmapAllocator::MmapAllocator(const Options& options)
@@ -34,16 +35,38 @@ MmapAllocator::MmapAllocator(const Options& options)
           AllocationTraits::numPages(options.capacity - mallocReservedBytes_),
           64 * sizeClassSizes_.back())) {
   for (const auto& size : sizeClassSizes_) {
-    sizeClasses_.push_back(std::make_unique<SizeClass>(capacity_ / size, size));
+    sizeClasses_.push_back(std::make_unique<SizeClass>(
+        capacity_ / size, size, options.useMadvFree));
   }
 
   if (useMmapArena_) {
     const auto arenaSizeBytes = bits::roundUp(
         AllocationTraits::pageBytes(capacity_) / options.mmapArenaCapacityRatio,
         AllocationTraits::kPageSize);
-    managedArenas_ = std::make_unique<ManagedMmapArenas>(
-        std::max<uint64_t>(arenaSizeBytes, MmapArena::kMinCapacityBytes));
+    const auto singleArenaCapacity =
+        std::max<uint64_t>(arenaSizeBytes, MmapArena::kMinCapacityBytes);
+    if (options.numaAware && process::numaNodeCount() > 1) {
+      for (auto node = 0; node < process::numaNodeCount(); ++node) {
+        managedArenas_.push_back(std::make_unique<ManagedMmapArenas>(
+            singleArenaCapacity, node, options.useMadvFree));
+      }
+    } else {
+      managedArenas_.push_back(std::make_unique<ManagedMmapArenas>(
+          singleArenaCapacity, -1, options.useMadvFree));
+    }
+  }
+}
+
+ManagedMmapArenas& MmapAllocator::arenasOf(void* address) {
+  if (managedArenas_.size() == 1) {
+    return *managedArenas_[0];
+  }
+  for (auto& arenas : managedArenas_) {
+    if (arenas->contains(address)) {
+      return *arenas;
+    }
   }
+  VELOX_FAIL("Address {} is not in any MmapArena", address);
 }
 
 MmapAllocator::~MmapAllocator() {
@@ -264,7 +287,8 @@ bool MmapAllocator::allocateContiguousImpl(
     useHugePages(allocation, false);
     if (useMmapArena_) {
       std::lock_guard<std::mutex> l(arenaMutex_);
-      managedArenas_->free(allocation.data(), allocation.maxSize());
+      arenasOf(allocation.data())
+          .free(allocation.data(), allocation.maxSize());
     } else {
       if (::munmap(allocation.data(), allocation.maxSize()) < 0) {
         VELOX_MEM_LOG(ERROR) << "munmap got " << folly::errnoStr(errno)
@@ -357,8 +381,13 @@ bool MmapAllocator::allocateContiguousImpl(
     data = nullptr;
   } else {
     if (useMmapArena_) {
+      const auto node = managedArenas_.size() == 1
+          ? 0
+          : std::min<int32_t>(
+                process::currentNumaNode(), managedArenas_.size() - 1);
       std::lock_guard<std::mutex> l(arenaMutex_);
-      data = managedArenas_->allocate(AllocationTraits::pageBytes(maxPages));
+      data = managedArenas_[node]->allocate(
+          AllocationTraits::pageBytes(maxPages));
     } else {
       data = ::mmap(
           nullptr,
@@ -399,7 +428,7 @@ void MmapAllocator::freeContiguousImpl(ContiguousAllocation& allocation) {
   useHugePages(allocation, false);
   if (useMmapArena_) {
     std::lock_guard<std::mutex> l(arenaMutex_);
-    managedArenas_->free(allocation.data(), allocation.maxSize());
+    arenasOf(allocation.data()).free(allocation.data(), allocation.maxSize());
   } else {
     if (::munmap(allocation.data(), allocation.maxSize()) < 0) {
       VELOX_MEM_LOG(ERROR) << "munmap returned " << folly::errnoStr(errno)
@@ -540,9 +569,13 @@ MachinePageCount MmapAllocator::adviseAway(MachinePageCount target) {
   return numAway;
 }
 
-MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
+MmapAllocator::SizeClass::SizeClass(
+    size_t capacity,
+    MachinePageCount unitSize,
+    bool useMadvFree)
     : capacity_(capacity),
       unitSize_(unitSize),
+      useMadvFree_(useMadvFree),
       byteSize_(AllocationTraits::pageBytes(capacity_ * unitSize_)),
       pageBitmapSize_(capacity_ / 64),
       // Min 8 words + 1 bit for every 512 bits in 'pageAllocated_'.
@@ -855,10 +888,10 @@ void MmapAllocator::SizeClass::adviseAway(const Allocation& allocation) {
     if (!isInRange(run.data())) {
       continue;
     }
-    if (::madvise(
+    if (!releasePages(
             run.data(),
             AllocationTraits::pageBytes(run.numPages()),
-            MADV_DONTNEED) < 0) {
+            useMadvFree_)) {
       VELOX_MEM_LOG(ERROR) << "madvise got errno " << folly::errnoStr(errno);
     } else {
       std::lock_guard<std::mutex> l(mutex_);
@@ -61,6 +61,11 @@ class MmapAllocator : public MemoryAllocator {
     /// capacity to single MmapArena capacity ratio.
     int32_t mmapArenaCapacityRatio = 10;
 
+    /// If set true together with 'useMmapArena', there is one set of
+    /// ManagedMmapArenas per NUMA node and large allocations are served from
+    /// the arenas of the NUMA node of the allocating thread.
+    bool numaAware = false;
+
     /// If not zero, reserve 'smallAllocationReservePct'% of space from
     /// 'capacity' for ad hoc small allocations. And those allocations are
     /// delegated to std::malloc.
@@ -75,6 +80,13 @@ class MmapAllocator : public MemoryAllocator {
     /// and 'smallAllocationReservePct' will be automatically set to 0
     /// disregarding any passed in value.
     int32_t maxMallocBytes = 3072;
+
+    /// If true, the memory of size class pages advised away and of freed
+    /// MmapArena allocations is returned to the OS with MADV_FREE instead of
+    /// MADV_DONTNEED. The kernel then takes the pages back only under memory
+    /// pressure, so reusing them soon after is cheap, but they stay resident
+    /// until then.
+    bool useMadvFree = false;
   };
 
   explicit MmapAllocator(const Options& options);
@@ -162,7 +174,7 @@ class MmapAllocator : public MemoryAllocator {
   // 'unitSize_' machine pages.
   class SizeClass {
    public:
-    SizeClass(size_t capacity, MachinePageCount unitSize);
+    SizeClass(size_t capacity, MachinePageCount unitSize, bool useMadvFree);
 
     ~SizeClass();
 
@@ -267,6 +279,9 @@ class MmapAllocator : public MemoryAllocator {
     // Size of one size class page in machine pages.
     const MachinePageCount unitSize_;
 
+    // See Options::useMadvFree.
+    const bool useMadvFree_;
+
     // Size in bytes of the address range.
     const size_t byteSize_;
 
@@ -414,10 +429,15 @@ class MmapAllocator : public MemoryAllocator {
   std::atomic<uint64_t> numAdvisedPages_ = 0;
   std::atomic<uint64_t> numMallocBytes_ = 0;
 
+  // Returns the ManagedMmapArenas that 'address' was allocated from.
+  ManagedMmapArenas& arenasOf(void* address);
+
   // Allocations that are larger than largest size classes will be delegated to
-  // ManagedMmapArenas, to avoid calling mmap on every allocation.
+  // ManagedMmapArenas, to avoid calling mmap on every allocation. If
+  // 'numaAware' is set, there is one element per NUMA node, indexed by node.
+  // Otherwise there is a single element that is not bound to a node.
   std::mutex arenaMutex_;
-  std::unique_ptr<ManagedMmapArenas> managedArenas_;
+  std::vector<std::unique_ptr<ManagedMmapArenas>> managedArenas_;
 
   std::shared_ptr<Cache> cache_;
 };
@@ -19,13 +19,30 @@
 #include <sys/mman.h>
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/memory/Memory.h"
+#include "velox/common/process/ProcessBase.h"
 
 namespace facebook::velox::memory {
 uint64_t MmapArena::roundBytes(uint64_t bytes) {
   return bits::nextPowerOfTwo(bytes);
 }
 
-MmapArena::MmapArena(size_t capacityBytes) : byteSize_(capacityBytes) {
+bool releasePages(void* address, uint64_t bytes, bool lazy) {
+#ifdef MADV_FREE
+  if (lazy) {
+    if (::madvise(address, bytes, MADV_FREE) == 0) {
+      return true;
+    }
+    if (errno != EINVAL) {
+      return false;
+    }
+    // The kernel does not support MADV_FREE.
+  }
+#endif
+  return ::madvise(address, bytes, MADV_DONTNEED) == 0;
+}
+
+MmapArena::MmapArena(size_t capacityBytes, int32_t numaNode, bool useMadvFree)
+    : byteSize_(capacityBytes), useMadvFree_(useMadvFree) {
   VELOX_CHECK_EQ(
       byteSize_ % kMinGrainSizeBytes,
       0,
@@ -46,6 +63,11 @@ MmapArena::MmapArena(size_t capacityBytes) : byteSize_(capacityBytes) {
         capacityBytes);
   }
   address_ = reinterpret_cast<uint8_t*>(ptr);
+  // The pages are not touched yet, so the policy decides where they are
+  // faulted in.
+  if (numaNode >= 0 && process::bindToNumaNode(ptr, capacityBytes, numaNode)) {
+    numaNode_ = numaNode;
+  }
   addFreeBlock(reinterpret_cast<uint64_t>(address_), byteSize_);
   freeBytes_ = byteSize_;
 }
@@ -89,7 +111,7 @@ void MmapArena::free(void* address, uint64_t bytes) {
   }
   bytes = roundBytes(bytes);
 
-  ::madvise(address, bytes, MADV_DONTNEED);
+  releasePages(address, bytes, useMadvFree_);
   freeBytes_ += bytes;
 
   const auto curAddr = reinterpret_cast<uint64_t>(address);
@@ -276,9 +298,15 @@ std::string MmapArena::toString() const {
       freeList_.size());
 }
 
-ManagedMmapArenas::ManagedMmapArenas(uint64_t singleArenaCapacity)
-    : singleArenaCapacity_(singleArenaCapacity) {
-  auto arena = std::make_shared<MmapArena>(singleArenaCapacity);
+ManagedMmapArenas::ManagedMmapArenas(
+    uint64_t singleArenaCapacity,
+    int32_t numaNode,
+    bool useMadvFree)
+    : singleArenaCapacity_(singleArenaCapacity),
+      numaNode_(numaNode),
+      useMadvFree_(useMadvFree) {
+  auto arena = std::make_shared<MmapArena>(
+      singleArenaCapacity, numaNode_, useMadvFree_);
   arenas_.emplace(reinterpret_cast<uint64_t>(arena->address()), arena);
   currentArena_ = arena;
 }
@@ -292,12 +320,23 @@ void* ManagedMmapArenas::allocate(uint64_t bytes) {
   // If first allocation fails we create a new MmapArena for another attempt. If
   // it ever fails again then it means requested bytes is larger than a single
   // MmapArena's capacity. No further attempts will happen.
-  auto newArena = std::make_shared<MmapArena>(singleArenaCapacity_);
+  auto newArena = std::make_shared<MmapArena>(
+      singleArenaCapacity_, numaNode_, useMadvFree_);
   arenas_.emplace(reinterpret_cast<uint64_t>(newArena->address()), newArena);
   currentArena_ = newArena;
   return currentArena_->allocate(bytes);
 }
 
+bool ManagedMmapArenas::contains(void* address) const {
+  const uint64_t addressU64 = reinterpret_cast<uint64_t>(address);
+  auto iter = arenas_.upper_bound(addressU64);
+  if (iter == arenas_.begin()) {
+    return false;
+  }
+  --iter;
+  return addressU64 < iter->first + singleArenaCapacity_;
+}
+
 void ManagedMmapArenas::free(void* address, uint64_t bytes) {
   VELOX_CHECK(!arenas_.empty());
   const uint64_t addressU64 = reinterpret_cast<uint64_t>(address);
@@ -26,6 +26,12 @@
 
 namespace facebook::velox::memory {
 
+/// Returns the memory of 'bytes' at 'address' to the OS. If 'lazy' is true,
+/// uses MADV_FREE so that the kernel takes the pages back only under memory
+/// pressure and reusing them before is cheap. Falls back to MADV_DONTNEED if
+/// MADV_FREE is not supported. Returns false and sets errno on failure.
+bool releasePages(void* address, uint64_t bytes, bool lazy);
+
 class MmapArena {
  public:
   /// Single MmapArena capacity is determined by mmap_arena_capacity_ratio ratio
@@ -36,7 +42,13 @@ class MmapArena {
   /// MmapArena capacity should be multiple of kMinGrainSizeBytes.
   static constexpr uint64_t kMinGrainSizeBytes = 1024 * 1024; // 1M
 
-  MmapArena(size_t capacityBytes);
+  /// If 'numaNode' is not negative, the memory of the arena prefers to be
+  /// placed on NUMA node 'numaNode'. If 'useMadvFree' is true, freed memory is
+  /// returned to the OS lazily. See releasePages().
+  explicit MmapArena(
+      size_t capacityBytes,
+      int32_t numaNode = -1,
+      bool useMadvFree = false);
   ~MmapArena();
 
   void* allocate(uint64_t bytes);
@@ -49,6 +61,12 @@ class MmapArena {
     return byteSize_;
   }
 
+  /// Returns the NUMA node the memory of this arena is bound to or -1 if the
+  /// memory is not bound to a node.
+  int32_t numaNode() const {
+    return numaNode_;
+  }
+
   const std::map<uint64_t, uint64_t>& freeList() const {
     return freeList_;
   }
@@ -107,6 +125,11 @@ class MmapArena {
   // Starting address of this arena.
   uint8_t* address_;
 
+  // NUMA node the memory is bound to or -1.
+  int32_t numaNode_{-1};
+
+  const bool useMadvFree_;
+
   std::atomic<uint64_t> freeBytes_;
 
   // A sorted list with each entry mapping from free block address to size of
@@ -123,12 +146,24 @@ class MmapArena {
 /// fragmentation happens.
 class ManagedMmapArenas {
  public:
-  ManagedMmapArenas(uint64_t singleArenaCapacity);
+  /// If 'numaNode' is not negative, all managed MmapArenas prefer to place
+  /// their memory on NUMA node 'numaNode'.
+  explicit ManagedMmapArenas(
+      uint64_t singleArenaCapacity,
+      int32_t numaNode = -1,
+      bool useMadvFree = false);
 
   void* allocate(uint64_t bytes);
 
   void free(void* address, uint64_t bytes);
 
+  /// Returns true if 'address' is in one of the managed MmapArenas.
+  bool contains(void* address) const;
+
+  int32_t numaNode() const {
+    return numaNode_;
+  }
+
   const std::map<uint64_t, std::shared_ptr<MmapArena>>& arenas() const {
     return arenas_;
   }
@@ -137,6 +172,12 @@ class ManagedMmapArenas {
   // Capacity in bytes for a single MmapArena managed by this.
   const uint64_t singleArenaCapacity_;
 
+  // NUMA node of the managed MmapArenas or -1.
+  const int32_t numaNode_;
+
+  // See MmapArena::MmapArena().
+  const bool useMadvFree_;
+
   // A sorted list of MmapArena by its initial address
   std::map<uint64_t, std::shared_ptr<MmapArena>> arenas_;
 
@@ -17,6 +17,7 @@
 #include "velox/common/memory/SharedArbitrator.h"
 
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/process/TraceTimeline.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/common/time/Timer.h"
 
@@ -61,7 +62,10 @@ std::string memoryPoolAbortMessage(
 } // namespace
 
 SharedArbitrator::SharedArbitrator(const MemoryArbitrator::Config& config)
-    : MemoryArbitrator(config), freeCapacity_(capacity_) {
+    : MemoryArbitrator(config),
+      poolPolicy_(config.poolPolicy),
+      arbitrationExecutor_(config.arbitrationExecutor),
+      freeCapacity_(capacity_) {
   VELOX_CHECK_EQ(kind_, config.kind);
 }
 
@@ -100,6 +104,9 @@ void SharedArbitrator::sortCandidatesByReclaimableMemory(
         if (!rhs.reclaimable) {
           return true;
         }
+        if (lhs.priority != rhs.priority) {
+          return lhs.priority < rhs.priority;
+        }
         return lhs.reclaimableBytes > rhs.reclaimableBytes;
       });
 
@@ -116,18 +123,21 @@ SharedArbitrator::findCandidateWithLargestCapacity(
   VELOX_CHECK(!candidates.empty());
   int32_t candidateIdx{-1};
   int64_t maxCapacity{-1};
+  int32_t minPriority{0};
   for (int32_t i = 0; i < candidates.size(); ++i) {
     const bool isCandidate = candidates[i].pool == requestor;
+    const int32_t priority = candidates[i].priority;
     // For capacity comparison, the requestor's capacity should include both its
     // current capacity and the capacity growth.
     const int64_t capacity =
         candidates[i].pool->capacity() + (isCandidate ? targetBytes : 0);
-    if (i == 0) {
-      candidateIdx = 0;
+    if (i == 0 || priority < minPriority) {
+      candidateIdx = i;
       maxCapacity = capacity;
+      minPriority = priority;
       continue;
     }
-    if (capacity < maxCapacity) {
+    if (priority > minPriority || capacity < maxCapacity) {
       continue;
     }
     if (capacity > maxCapacity) {
@@ -170,18 +180,31 @@ void SharedArbitrator::releaseMemory(MemoryPool* pool) {
 }
 
 std::vector<SharedArbitrator::Candidate> SharedArbitrator::getCandidateStats(
-    const std::vector<std::shared_ptr<MemoryPool>>& pools) {
+    const std::vector<std::shared_ptr<MemoryPool>>& pools) const {
   std::vector<SharedArbitrator::Candidate> candidates;
   candidates.reserve(pools.size());
   for (const auto& pool : pools) {
     uint64_t reclaimableBytes;
     const bool reclaimable = pool->reclaimableBytes(reclaimableBytes);
+    const auto policy = poolPolicy_ ? poolPolicy_(*pool) : PoolPolicy{};
     candidates.push_back(
-        {reclaimable, reclaimableBytes, pool->freeBytes(), pool.get()});
+        {reclaimable,
+         reclaimableBytes,
+         pool->freeBytes(),
+         pool.get(),
+         policy.priority,
+         policy.minCapacity});
   }
   return candidates;
 }
 
+// static
+uint64_t SharedArbitrator::capacityAboveMin(const Candidate& candidate) {
+  const uint64_t capacity = candidate.pool->capacity();
+  return capacity > candidate.minCapacity ? capacity - candidate.minCapacity
+                                          : 0;
+}
+
 bool SharedArbitrator::growMemory(
     MemoryPool* pool,
     const std::vector<std::shared_ptr<MemoryPool>>& candidatePools,
@@ -229,6 +252,28 @@ bool SharedArbitrator::growMemory(
   return false;
 }
 
+folly::SemiFuture<bool> SharedArbitrator::growMemoryAsync(
+    std::shared_ptr<MemoryPool> pool,
+    std::vector<std::shared_ptr<MemoryPool>> candidatePools,
+    uint64_t targetBytes) {
+  if (arbitrationExecutor_ == nullptr) {
+    return folly::SemiFuture<bool>::makeEmpty();
+  }
+  // NOTE: the arbitration runs off the driver thread of the requestor so the
+  // requestor's reclaimer does not enter the driver suspension state. The
+  // driver is blocked on the returned future and is off thread, which allows
+  // the arbitration to pause the requestor's task like any other one.
+  return folly::via(
+             arbitrationExecutor_,
+             [this,
+              pool = std::move(pool),
+              candidatePools = std::move(candidatePools),
+              targetBytes]() {
+               return growMemory(pool.get(), candidatePools, targetBytes);
+             })
+      .semi();
+}
+
 bool SharedArbitrator::checkCapacityGrowth(
     const MemoryPool& pool,
     uint64_t targetBytes) const {
@@ -353,10 +398,11 @@ uint64_t SharedArbitrator::reclaimFreeMemoryFromCandidates(
     if (candidate.freeBytes == 0) {
       break;
     }
-    const int64_t bytesToShrink =
-        std::min<int64_t>(targetBytes - freedBytes, candidate.freeBytes);
+    const int64_t bytesToShrink = std::min<int64_t>(
+        targetBytes - freedBytes,
+        std::min(candidate.freeBytes, capacityAboveMin(candidate)));
     if (bytesToShrink <= 0) {
-      break;
+      continue;
     }
     freedBytes += candidate.pool->shrink(bytesToShrink);
     if (freedBytes >= targetBytes) {
@@ -377,11 +423,21 @@ uint64_t SharedArbitrator::reclaimUsedMemoryFromCandidates(
   int64_t freedBytes{0};
   for (const auto& candidate : candidates) {
     VELOX_CHECK_LT(freedBytes, targetBytes);
-    if (!candidate.reclaimable || candidate.reclaimableBytes == 0) {
+    if (!candidate.reclaimable) {
       break;
     }
-    const int64_t bytesToReclaim = std::max<int64_t>(
+    if (candidate.reclaimableBytes == 0) {
+      continue;
+    }
+    int64_t bytesToReclaim = std::max<int64_t>(
         targetBytes - freedBytes, memoryPoolTransferCapacity_);
+    if (candidate.pool != requestor && candidate.minCapacity > 0) {
+      bytesToReclaim =
+          std::min<int64_t>(bytesToReclaim, capacityAboveMin(candidate));
+      if (bytesToReclaim == 0) {
+        continue;
+      }
+    }
     VELOX_CHECK_GT(bytesToReclaim, 0);
     freedBytes += reclaim(candidate.pool, bytesToReclaim);
     if ((freedBytes >= targetBytes) || requestor->aborted()) {
@@ -537,6 +593,7 @@ void SharedArbitrator::startArbitration(MemoryPool* requestor) {
   if (waitPromise.valid()) {
     uint64_t waitTimeUs{0};
     {
+      process::TraceEvent traceEvent("memory", "Arbitration wait");
       MicrosecondTimer timer(&waitTimeUs);
       waitPromise.wait();
     }
@@ -50,6 +50,14 @@ class SharedArbitrator : public MemoryArbitrator {
       const std::vector<std::shared_ptr<MemoryPool>>& candidatePools,
       uint64_t targetBytes) final;
 
+  /// Runs growMemory() on the arbitration executor if there is one. The
+  /// requestor and the candidate pools are kept alive until the arbitration
+  /// completes.
+  folly::SemiFuture<bool> growMemoryAsync(
+      std::shared_ptr<MemoryPool> pool,
+      std::vector<std::shared_ptr<MemoryPool>> candidatePools,
+      uint64_t targetBytes) final;
+
   uint64_t shrinkMemory(
       const std::vector<std::shared_ptr<MemoryPool>>& /*unused*/,
       uint64_t /*unused*/) override final {
@@ -68,6 +76,9 @@ class SharedArbitrator : public MemoryArbitrator {
     uint64_t reclaimableBytes{0};
     uint64_t freeBytes{0};
     MemoryPool* pool;
+    // See MemoryArbitrator::PoolPolicy.
+    int32_t priority{0};
+    uint64_t minCapacity{0};
 
     std::string toString() const;
   };
@@ -102,17 +113,22 @@ class SharedArbitrator : public MemoryArbitrator {
   bool ensureCapacity(MemoryPool* requestor, uint64_t targetBytes);
 
   // Invoked to capture the candidate memory pools stats for arbitration.
-  static std::vector<Candidate> getCandidateStats(
-      const std::vector<std::shared_ptr<MemoryPool>>& pools);
+  std::vector<Candidate> getCandidateStats(
+      const std::vector<std::shared_ptr<MemoryPool>>& pools) const;
 
+  // Returns the capacity of 'candidate' above its guaranteed minimum.
+  static uint64_t capacityAboveMin(const Candidate& candidate);
+
+  // Sorts the reclaimable candidates first, then by increasing priority and
+  // then by decreasing reclaimable bytes.
   void sortCandidatesByReclaimableMemory(
       std::vector<Candidate>& candidates) const;
 
   void sortCandidatesByFreeCapacity(std::vector<Candidate>& candidates) const;
 
-  // Finds the candidate with the largest capacity. For 'requestor', the
-  // capacity for comparison including its current capacity and the capacity to
-  // grow.
+  // Finds the candidate with the lowest priority and among these the one with
+  // the largest capacity. For 'requestor', the capacity for comparison
+  // including its current capacity and the capacity to grow.
   const Candidate& findCandidateWithLargestCapacity(
       MemoryPool* requestor,
       uint64_t targetBytes,
@@ -181,6 +197,9 @@ class SharedArbitrator : public MemoryArbitrator {
 
   Stats statsLocked() const;
 
+  const std::function<PoolPolicy(const MemoryPool&)> poolPolicy_;
+  folly::Executor* const arbitrationExecutor_;
+
   mutable std::mutex mutex_;
   uint64_t freeCapacity_{0};
   // Indicates if there is a running arbitration request or not.
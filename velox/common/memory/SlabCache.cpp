@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/memory/SlabCache.h"
+
+namespace facebook::velox::memory {
+
+static_assert(
+    SlabCache::kMinClassBytes << (SlabCache::kNumClasses - 1) ==
+    SlabCache::kMaxClassBytes);
+
+SlabCache::SlabCache(
+    MemoryAllocator* allocator,
+    uint16_t alignment,
+    uint64_t capacity,
+    bool threadSafe)
+    : allocator_(allocator),
+      alignment_(alignment),
+      capacity_(capacity),
+      threadSafe_(threadSafe) {
+  VELOX_CHECK_NOT_NULL(allocator_);
+  VELOX_CHECK_LE(alignment_, kMinClassBytes);
+}
+
+SlabCache::~SlabCache() {
+  clearLocked();
+}
+
+void* SlabCache::allocate(uint64_t classBytes) {
+  VELOX_DCHECK_EQ(classBytes, SlabCache::classBytes(classBytes));
+  {
+    auto l = lock();
+    auto& freeList = freeLists_[classIndex(classBytes)];
+    if (!freeList.empty()) {
+      void* buffer = freeList.back();
+      freeList.pop_back();
+      cachedBytes_ -= classBytes;
+      ++numHits_;
+      return buffer;
+    }
+    ++numMisses_;
+  }
+  return allocator_->allocateBytes(classBytes, alignment_);
+}
+
+void SlabCache::free(void* buffer, uint64_t classBytes) {
+  VELOX_DCHECK_EQ(classBytes, SlabCache::classBytes(classBytes));
+  {
+    auto l = lock();
+    if (cachedBytes_ + classBytes <= capacity_) {
+      freeLists_[classIndex(classBytes)].push_back(buffer);
+      cachedBytes_ += classBytes;
+      return;
+    }
+  }
+  allocator_->freeBytes(buffer, classBytes);
+}
+
+void SlabCache::clear() {
+  auto l = lock();
+  clearLocked();
+}
+
+void SlabCache::clearLocked() {
+  for (auto i = 0; i < kNumClasses; ++i) {
+    const uint64_t bytes = kMinClassBytes << i;
+    for (auto* buffer : freeLists_[i]) {
+      allocator_->freeBytes(buffer, bytes);
+    }
+    freeLists_[i].clear();
+  }
+  cachedBytes_ = 0;
+}
+
+SlabCache::Stats SlabCache::stats() const {
+  auto l = lock();
+  return {numHits_, numMisses_, cachedBytes_};
+}
+
+} // namespace facebook::velox::memory
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <mutex>
+#include <vector>
+
+#include "velox/common/memory/MemoryAllocator.h"
+
+namespace facebook::velox::memory {
+
+/// Caches small buffers freed to a leaf memory pool in free lists by power of
+/// two size class, so that a following allocation of the same size class
+/// reuses a buffer instead of going to the memory allocator. The cached
+/// buffers stay allocated from the allocator but not reserved in the memory
+/// pool. The total size of the cached buffers is capped by 'capacity'. The
+/// pool frees them with clear() on release() and reclaim().
+class SlabCache {
+ public:
+  /// The smallest and the largest size class in bytes.
+  static constexpr uint64_t kMinClassBytes = 64;
+  static constexpr uint64_t kMaxClassBytes = 8 << 10;
+  static constexpr int32_t kNumClasses = 8;
+
+  struct Stats {
+    /// The number of allocations served from the cache.
+    uint64_t numHits{0};
+    /// The number of allocations of a cached size class that went to the
+    /// allocator.
+    uint64_t numMisses{0};
+    /// The bytes of the buffers held in the cache.
+    uint64_t cachedBytes{0};
+  };
+
+  /// If 'threadSafe' is false, the cache can only be used by one thread at a
+  /// time, like the non-thread-safe leaf memory pool owning it.
+  SlabCache(
+      MemoryAllocator* allocator,
+      uint16_t alignment,
+      uint64_t capacity,
+      bool threadSafe);
+
+  /// Frees the cached buffers to the allocator.
+  ~SlabCache();
+
+  /// Returns the size class in bytes for a buffer of 'bytes' or 0 if the
+  /// buffer is too large to cache.
+  static uint64_t classBytes(uint64_t bytes) {
+    if (bytes > kMaxClassBytes) {
+      return 0;
+    }
+    return bytes <= kMinClassBytes ? kMinClassBytes
+                                   : 1UL << (64 - __builtin_clzll(bytes - 1));
+  }
+
+  /// Returns a buffer of 'classBytes' from the cache or from the allocator.
+  /// Returns nullptr if the allocator fails. 'classBytes' is a value returned
+  /// by classBytes().
+  void* allocate(uint64_t classBytes);
+
+  /// Puts 'buffer' of 'classBytes' in the cache or frees it to the allocator
+  /// if the cache is full.
+  void free(void* buffer, uint64_t classBytes);
+
+  /// Frees all the cached buffers to the allocator. Called by the owning pool
+  /// when its memory is released or reclaimed.
+  void clear();
+
+  Stats stats() const;
+
+ private:
+  static int32_t classIndex(uint64_t classBytes) {
+    return __builtin_ctzll(classBytes) - __builtin_ctzll(kMinClassBytes);
+  }
+
+  // Locks 'mutex_' if the cache is thread-safe.
+  std::unique_lock<std::mutex> lock() const {
+    return threadSafe_ ? std::unique_lock<std::mutex>(mutex_)
+                       : std::unique_lock<std::mutex>();
+  }
+
+  void clearLocked();
+
+  MemoryAllocator* const allocator_;
+  const uint16_t alignment_;
+  const uint64_t capacity_;
+  const bool threadSafe_;
+
+  mutable std::mutex mutex_;
+  std::array<std::vector<void*>, kNumClasses> freeLists_;
+  uint64_t cachedBytes_{0};
+  uint64_t numHits_{0};
+  uint64_t numMisses_{0};
+};
+
+} // namespace facebook::velox::memory
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/common/memory/AllocationSampler.h"
+#include <gtest/gtest.h>
+#include "velox/common/memory/Memory.h"
+
+namespace facebook::velox::memory {
+namespace {
+
+class AllocationSamplerTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    sampler().testingClear();
+    root_ = manager_.addRootPool("samplerRoot");
+    pool_ = root_->addLeafChild("samplerLeaf");
+  }
+
+  void TearDown() override {
+    sampler().setSampleBytes(0);
+    sampler().testingClear();
+  }
+
+  static AllocationSampler& sampler() {
+    return AllocationSampler::instance();
+  }
+
+  MemoryManager manager_{};
+  std::shared_ptr<MemoryPool> root_;
+  std::shared_ptr<MemoryPool> pool_;
+};
+
+TEST_F(AllocationSamplerTest, off) {
+  auto* buffer = pool_->allocate(1'000);
+  EXPECT_EQ(sampler().numSamples(), 0);
+  pool_->free(buffer, 1'000);
+}
+
+TEST_F(AllocationSamplerTest, allocateAndFree) {
+  // Every allocation is sampled.
+  sampler().setSampleBytes(1);
+  auto* buffer = pool_->allocate(1'000);
+  auto* other = pool_->allocate(2'000);
+  Allocation allocation;
+  pool_->allocateNonContiguous(4, allocation);
+  ContiguousAllocation contiguous;
+  pool_->allocateContiguous(4, contiguous);
+  EXPECT_EQ(sampler().numSamples(), 4);
+  auto liveBytes = sampler().liveBytesByPool();
+  EXPECT_EQ(liveBytes.size(), 1);
+  EXPECT_EQ(
+      liveBytes[pool_->name()],
+      3'000 + allocation.byteSize() + contiguous.size());
+
+  auto profile = sampler().toPprof();
+  EXPECT_EQ(profile.find("heap profile: 4: "), 0) << profile;
+  EXPECT_NE(profile.find("@ heap_v2/1\n"), std::string::npos);
+  EXPECT_NE(profile.find("1: 1000 [1: 1000] @ 0x"), std::string::npos);
+  EXPECT_NE(profile.find("MAPPED_LIBRARIES:"), std::string::npos);
+  EXPECT_EQ(sampler().toPprof("otherPool").find("heap profile: 0: 0 "), 0);
+
+  // Frees remove the samples also when sampling is off.
+  sampler().setSampleBytes(0);
+  pool_->free(buffer, 1'000);
+  other = pool_->reallocate(other, 2'000, 3'000);
+  pool_->freeNonContiguous(allocation);
+  pool_->freeContiguous(contiguous);
+  EXPECT_EQ(sampler().numSamples(), 0);
+  pool_->free(other, 3'000);
+}
+
+TEST_F(AllocationSamplerTest, estimate) {
+  constexpr int32_t kNumBuffers = 10'000;
+  constexpr int32_t kBufferSize = 1'000;
+  sampler().setSampleBytes(16 << 10);
+  std::vector<void*> buffers;
+  for (auto i = 0; i < kNumBuffers; ++i) {
+    buffers.push_back(pool_->allocate(kBufferSize));
+  }
+  const auto numSamples = sampler().numSamples();
+  EXPECT_GT(numSamples, 0);
+  EXPECT_LT(numSamples, kNumBuffers / 4);
+  // About 600 samples, so the estimate is within 20% with high probability.
+  const int64_t estimate = sampler().liveBytesByPool()[pool_->name()];
+  constexpr int64_t kTotalBytes = kNumBuffers * kBufferSize;
+  EXPECT_NEAR(estimate, kTotalBytes, kTotalBytes / 5);
+
+  for (auto* buffer : buffers) {
+    pool_->free(buffer, kBufferSize);
+  }
+  EXPECT_EQ(sampler().numSamples(), 0);
+}
+
+} // namespace
+} // namespace facebook::velox::memory
@@ -38,6 +38,13 @@ DEFINE_uint32(
     num_runs,
     32,
     "The number of benchmark runs and reports the average results");
+DEFINE_uint32(
+    reservation_slack_mb,
+    8,
+    "The reservation slack of the leaf memory pools to compare against no "
+    "slack. 0 only runs without slack");
+
+DECLARE_int32(velox_memory_pool_reservation_slack_mb);
 
 using namespace facebook::velox;
 using namespace facebook::velox::memory;
@@ -66,6 +73,18 @@ class MemoryOperator {
     return clockCount_;
   }
 
+  /// Returns the number of reservation retries caused by concurrent updates
+  /// of the root memory pool.
+  uint64_t numCollisions() const {
+    return pool_->stats().numCollisions;
+  }
+
+  /// Returns the number of reservation changes propagated to the root memory
+  /// pool.
+  uint64_t numReservationUpdates() const {
+    return numReservationUpdates_;
+  }
+
  private:
   struct Allocation {
     void* ptr;
@@ -92,6 +111,7 @@ class MemoryOperator {
   uint64_t allocatedBytes_{0};
   std::deque<Allocation> allocations_;
   uint64_t clockCount_{0};
+  uint64_t numReservationUpdates_{0};
 };
 
 void MemoryOperator::run() {
@@ -105,10 +125,14 @@ void MemoryOperator::allocate() {
   while (full()) {
     free();
   }
+  const auto reservedBytes = pool_->reservedBytes();
   {
     ClockTimer cpuTimer(clockCount_);
     allocations_.emplace_back(pool_->allocate(allocationBytes_));
   }
+  if (pool_->reservedBytes() != reservedBytes) {
+    ++numReservationUpdates_;
+  }
   allocatedBytes_ += allocationBytes_;
 }
 
@@ -117,10 +141,14 @@ void MemoryOperator::free() {
   Allocation freeAllocation = allocations_[freeIdx];
   allocations_[freeIdx] = allocations_.back();
   allocations_.pop_back();
+  const auto reservedBytes = pool_->reservedBytes();
   {
     ClockTimer cpuTimer(clockCount_);
     pool_->free(freeAllocation.ptr, allocationBytes_);
   }
+  if (pool_->reservedBytes() != reservedBytes) {
+    ++numReservationUpdates_;
+  }
   allocatedBytes_ -= allocationBytes_;
 }
 
@@ -185,6 +213,8 @@ class MemoryAllocationBenchMark {
   struct Result {
     uint64_t runTimeUs;
     uint64_t clockCount;
+    uint64_t numCollisions;
+    uint64_t numReservationUpdates;
   };
 
   const Options options_;
@@ -200,6 +230,8 @@ void MemoryAllocationBenchMark::run() {
   operators.reserve(options_.numThreads);
   uint64_t runTimeUs{0};
   uint64_t clockCount{0};
+  uint64_t numCollisions{0};
+  uint64_t numReservationUpdates{0};
   {
     MicrosecondTimer clock(&runTimeUs);
     for (int i = 0; i < options_.numThreads; ++i) {
@@ -218,23 +250,36 @@ void MemoryAllocationBenchMark::run() {
   }
   for (const auto& op : operators) {
     clockCount += op->clockCount();
+    numCollisions += op->numCollisions();
+    numReservationUpdates += op->numReservationUpdates();
   }
 
-  results_.push_back({runTimeUs, clockCount});
+  results_.push_back(
+      {runTimeUs, clockCount, numCollisions, numReservationUpdates});
 }
 
 void MemoryAllocationBenchMark::printStats() {
   double sumRunTumeMs{0};
   double sumClockCount{0};
+  double sumCollisions{0};
+  double sumReservationUpdates{0};
   for (const auto& result : results_) {
     sumRunTumeMs += result.runTimeUs / 1000;
     sumClockCount += result.clockCount;
+    sumCollisions += result.numCollisions;
+    sumReservationUpdates += result.numReservationUpdates;
   }
   const uint64_t avgRunTimeMs = sumRunTumeMs / results_.size();
   const uint64_t avgClockCount = sumClockCount / results_.size();
-  LOG(INFO) << "\n\t\tSIZE\t\tTIME\t\tCLOCK\n\t\t"
+  const uint64_t avgCollisions = sumCollisions / results_.size();
+  const uint64_t avgReservationUpdates =
+      sumReservationUpdates / results_.size();
+  LOG(INFO) << "\n\t\tSIZE\t\tSLACK\t\tTIME\t\tCLOCK\t\tCOLLISIONS"
+            << "\t\tROOT UPDATES\n\t\t"
             << succinctBytes(options_.allocationBytes) << "\t\t"
-            << succinctMillis(avgRunTimeMs) << "\t\t" << avgClockCount;
+            << FLAGS_velox_memory_pool_reservation_slack_mb << "MB\t\t"
+            << succinctMillis(avgRunTimeMs) << "\t\t" << avgClockCount
+            << "\t\t" << avgCollisions << "\t\t" << avgReservationUpdates;
 }
 } // namespace
 
@@ -248,10 +293,18 @@ int main(int argc, char* argv[]) {
       ? MemoryAllocationBenchMark::Type::kMalloc
       : MemoryAllocationBenchMark::Type::kMmap;
   options.numOpsPerThread = FLAGS_num_allocations_per_thread;
-  auto benchmark = std::make_unique<MemoryAllocationBenchMark>(options);
-  for (int i = 0; i < FLAGS_num_runs; ++i) {
-    benchmark->run();
+  std::vector<int32_t> slacks{0};
+  if (FLAGS_reservation_slack_mb > 0) {
+    slacks.push_back(FLAGS_reservation_slack_mb);
+  }
+  for (const auto slack : slacks) {
+    // Leaf pools take the reservation slack from the flag on creation.
+    FLAGS_velox_memory_pool_reservation_slack_mb = slack;
+    auto benchmark = std::make_unique<MemoryAllocationBenchMark>(options);
+    for (int i = 0; i < FLAGS_num_runs; ++i) {
+      benchmark->run();
+    }
+    benchmark->printStats();
   }
-  benchmark->printStats();
   return 0;
 }
@@ -412,6 +412,29 @@ class MemoryAllocatorTest : public testing::TestWithParam<bool> {
   std::atomic<int32_t> sequence_ = {};
 };
 
+TEST_P(MemoryAllocatorTest, numaAwareMmapArenas) {
+  if (!useMmap_) {
+    return;
+  }
+  MmapAllocator::Options options;
+  options.capacity = kCapacityBytes;
+  options.useMmapArena = true;
+  options.numaAware = true;
+  auto mmapAllocator = std::make_shared<MmapAllocator>(options);
+  // Larger than the largest size class, so served from the arenas of the NUMA
+  // node of this thread.
+  const auto numPages = mmapAllocator->sizeClasses().back() * 4;
+  ContiguousAllocation first;
+  ContiguousAllocation second;
+  ASSERT_TRUE(mmapAllocator->allocateContiguous(numPages, nullptr, first));
+  ASSERT_TRUE(mmapAllocator->allocateContiguous(numPages, nullptr, second));
+  memset(first.data(), 1, first.size());
+  memset(second.data(), 1, second.size());
+  mmapAllocator->freeContiguous(first);
+  mmapAllocator->freeContiguous(second);
+  ASSERT_EQ(mmapAllocator->numAllocated(), 0);
+}
+
 TEST_P(MemoryAllocatorTest, mmapAllocatorInit) {
   if (!useMmap_) {
     return;
@@ -1610,6 +1633,25 @@ TEST_F(MmapArenaTest, basic) {
   EXPECT_TRUE(arena->checkConsistency());
 }
 
+TEST_F(MmapArenaTest, releasePages) {
+  const uint64_t bytes = 1 << 20;
+  for (const bool useMadvFree : {false, true}) {
+    SCOPED_TRACE(fmt::format("useMadvFree {}", useMadvFree));
+    auto arena =
+        std::make_unique<MmapArena>(kArenaCapacityBytes, -1, useMadvFree);
+    auto* buffer = reinterpret_cast<char*>(arena->allocate(bytes));
+    memset(buffer, 0xff, bytes);
+    arena->free(buffer, bytes);
+    ASSERT_TRUE(arena->empty());
+    // The released memory is usable again right away.
+    ASSERT_EQ(arena->allocate(bytes), buffer);
+    memset(buffer, 0, bytes);
+    ASSERT_EQ(buffer[bytes - 1], 0);
+    arena->free(buffer, bytes);
+    ASSERT_TRUE(arena->checkConsistency());
+  }
+}
+
 TEST_F(MmapArenaTest, managedMmapArenas) {
   {
     // Test natural growing of ManagedMmapArena
@@ -1808,4 +1850,24 @@ TEST_F(MmapArenaTest, managedMmapArenasFreeError) {
     ASSERT_ANY_THROW(managedArenas->free(alloc2, kArenaCapacityBytes));
   }
 }
+
+TEST_F(MmapArenaTest, numaNode) {
+  auto managedArenas =
+      std::make_unique<ManagedMmapArenas>(kArenaCapacityBytes, 0);
+  ASSERT_EQ(managedArenas->numaNode(), 0);
+  // The binding fails on machines or kernels without NUMA support.
+  for (const auto& [address, arena] : managedArenas->arenas()) {
+    ASSERT_TRUE(arena->numaNode() == 0 || arena->numaNode() == -1);
+  }
+  void* alloc1 = managedArenas->allocate(kArenaCapacityBytes / 2);
+  // Touch the pages to fault them in after the policy is set.
+  memset(alloc1, 1, kArenaCapacityBytes / 2);
+  ASSERT_TRUE(managedArenas->contains(alloc1));
+  int32_t onStack;
+  ASSERT_FALSE(managedArenas->contains(&onStack));
+  managedArenas->free(alloc1, kArenaCapacityBytes / 2);
+
+  auto unbound = std::make_unique<MmapArena>(kArenaCapacityBytes);
+  ASSERT_EQ(unbound->numaNode(), -1);
+}
 } // namespace facebook::velox::memory
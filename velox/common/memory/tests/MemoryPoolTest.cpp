@@ -28,6 +28,8 @@
 DECLARE_bool(velox_memory_leak_check_enabled);
 DECLARE_bool(velox_memory_pool_debug_enabled);
 DECLARE_int32(velox_memory_num_shared_leaf_pools);
+DECLARE_int32(velox_memory_pool_slab_cache_kb);
+DECLARE_int32(velox_memory_pool_reservation_slack_mb);
 
 using namespace ::testing;
 using namespace facebook::velox::cache;
@@ -2810,6 +2812,112 @@ TEST_P(MemoryPoolTest, usageTrackerOptionTest) {
           useMmap_ ? "MMAP" : "MALLOC"));
 }
 
+TEST_P(MemoryPoolTest, slabCache) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_velox_memory_pool_slab_cache_kb = 16;
+  auto manager = getMemoryManager();
+  auto root = manager->addRootPool("slabCache", 4 * GB);
+  auto leaf = root->addLeafChild("leaf", isLeafThreadSafe_);
+
+  void* buffer = leaf->allocate(1000);
+  leaf->free(buffer, 1000);
+  ASSERT_EQ(leaf->currentBytes(), 0);
+  // A freed buffer is reused for an allocation of the same size class.
+  ASSERT_EQ(leaf->allocate(900), buffer);
+  ASSERT_GT(leaf->currentBytes(), 0);
+  leaf->free(buffer, 900);
+  ASSERT_EQ(leaf->stats().numSlabHits, 1);
+  ASSERT_EQ(leaf->stats().numSlabMisses, 1);
+
+  // Zero-filled buffers come from and go to the cache with the size of their
+  // size class.
+  buffer = leaf->allocateZeroFilled(3, 64);
+  ASSERT_EQ(leaf->currentBytes(), 256);
+  for (int i = 0; i < 3 * 64; ++i) {
+    ASSERT_EQ(reinterpret_cast<char*>(buffer)[i], 0);
+  }
+  ::memset(buffer, 1, 3 * 64);
+  leaf->free(buffer, 3 * 64);
+  ASSERT_EQ(leaf->stats().numSlabMisses, 2);
+  void* zeroFilled = leaf->allocateZeroFilled(1, 250);
+  ASSERT_EQ(zeroFilled, buffer);
+  for (int i = 0; i < 250; ++i) {
+    ASSERT_EQ(reinterpret_cast<char*>(zeroFilled)[i], 0);
+  }
+  leaf->free(zeroFilled, 250);
+  ASSERT_EQ(leaf->stats().numSlabHits, 2);
+  ASSERT_EQ(leaf->currentBytes(), 0);
+
+  // Large allocations are not cached.
+  buffer = leaf->allocate(1 << 20);
+  leaf->free(buffer, 1 << 20);
+  ASSERT_EQ(leaf->stats().numSlabMisses, 2);
+
+  // The cache holds up to its capacity and frees the other buffers.
+  const int64_t bufferSize = 8 << 10;
+  std::vector<void*> buffers;
+  for (int i = 0; i < 3; ++i) {
+    buffers.push_back(leaf->allocate(bufferSize));
+  }
+  for (auto* b : buffers) {
+    leaf->free(b, bufferSize);
+  }
+  for (int i = 0; i < 3; ++i) {
+    buffers[i] = leaf->allocate(bufferSize);
+  }
+  ASSERT_EQ(leaf->stats().numSlabHits, 4);
+  ASSERT_EQ(leaf->stats().numSlabMisses, 6);
+  for (auto* b : buffers) {
+    leaf->free(b, bufferSize);
+  }
+  ASSERT_EQ(leaf->currentBytes(), 0);
+
+  // release() and reclaim() free the cached buffers to the allocator.
+  leaf->release();
+  buffer = leaf->allocate(bufferSize);
+  ASSERT_EQ(leaf->stats().numSlabMisses, 7);
+  leaf->free(buffer, bufferSize);
+  ASSERT_EQ(leaf->reclaim(0), 0);
+  buffer = leaf->allocate(bufferSize);
+  ASSERT_EQ(leaf->stats().numSlabHits, 4);
+  ASSERT_EQ(leaf->stats().numSlabMisses, 8);
+  leaf->free(buffer, bufferSize);
+  ASSERT_EQ(leaf->currentBytes(), 0);
+}
+
+TEST_P(MemoryPoolTest, reservationSlack) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_velox_memory_pool_reservation_slack_mb = 8;
+  auto manager = getMemoryManager();
+  auto root = manager->addRootPool("reservationSlack", 4 * GB);
+  auto leaf = root->addLeafChild("leaf", isLeafThreadSafe_);
+
+  // The slack grows with the usage.
+  void* first = leaf->allocate(4 * MB);
+  ASSERT_EQ(leaf->reservedBytes(), 8 * MB);
+  void* second = leaf->allocate(2 * MB);
+  ASSERT_EQ(leaf->reservedBytes(), 8 * MB);
+  void* third = leaf->allocate(4 * MB);
+  ASSERT_EQ(leaf->reservedBytes(), 20 * MB);
+  ASSERT_EQ(root->reservedBytes(), 20 * MB);
+
+  // The reservation is kept until the unused part exceeds twice the slack.
+  leaf->free(third, 4 * MB);
+  ASSERT_EQ(leaf->reservedBytes(), 20 * MB);
+  leaf->free(second, 2 * MB);
+  ASSERT_EQ(leaf->reservedBytes(), 8 * MB);
+  leaf->free(first, 4 * MB);
+  ASSERT_EQ(leaf->reservedBytes(), 0);
+  ASSERT_EQ(root->reservedBytes(), 0);
+
+  // The slack is dropped when the reservation would exceed the capacity.
+  auto smallRoot = manager->addRootPool("smallRoot", 6 * MB);
+  auto smallLeaf = smallRoot->addLeafChild("leaf", isLeafThreadSafe_);
+  void* buffer = smallLeaf->allocate(4 * MB);
+  ASSERT_EQ(smallLeaf->reservedBytes(), 4 * MB);
+  smallLeaf->free(buffer, 4 * MB);
+}
+
 TEST_P(MemoryPoolTest, statsAndToString) {
   auto manager = getMemoryManager();
   auto root = manager->addRootPool("stats", 4 * GB);
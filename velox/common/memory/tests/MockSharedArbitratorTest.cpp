@@ -17,7 +17,9 @@
 #include <gtest/gtest.h>
 
 #include <deque>
+#include <unordered_set>
 
+#include "folly/executors/CPUThreadPoolExecutor.h"
 #include "folly/experimental/EventCount.h"
 #include "folly/futures/Barrier.h"
 #include "velox/common/base/tests/GTestUtils.h"
@@ -398,7 +400,9 @@ class MockSharedArbitrationTest : public testing::Test {
   void setupMemory(
       int64_t memoryCapacity = 0,
       uint64_t memoryPoolInitCapacity = kMaxMemory,
-      uint64_t memoryPoolTransferCapacity = 0) {
+      uint64_t memoryPoolTransferCapacity = 0,
+      std::function<MemoryArbitrator::PoolPolicy(const MemoryPool&)>
+          poolPolicy = nullptr) {
     if (memoryPoolInitCapacity == kMaxMemory) {
       memoryPoolInitCapacity = kMemoryPoolInitCapacity;
     }
@@ -416,6 +420,8 @@ class MockSharedArbitrationTest : public testing::Test {
     options.memoryPoolInitCapacity = memoryPoolInitCapacity;
     options.memoryPoolTransferCapacity = memoryPoolTransferCapacity;
     options.checkUsageLeak = true;
+    options.arbitrationPoolPolicy = std::move(poolPolicy);
+    options.arbitrationExecutor = arbitrationExecutor_;
     manager_ = std::make_unique<MemoryManager>(options);
     ASSERT_EQ(manager_->arbitrator()->kind(), arbitratorKind);
     arbitrator_ = static_cast<SharedArbitrator*>(manager_->arbitrator());
@@ -444,6 +450,7 @@ class MockSharedArbitrationTest : public testing::Test {
   std::shared_ptr<MemoryAllocator> allocator_;
   std::unique_ptr<MemoryManager> manager_;
   SharedArbitrator* arbitrator_;
+  folly::Executor* arbitrationExecutor_{nullptr};
   std::vector<std::shared_ptr<MockTask>> tasks_;
 };
 
@@ -929,6 +936,67 @@ TEST_F(MockSharedArbitrationTest, arbitrateWithMemoryReclaim) {
   }
 }
 
+TEST_F(MockSharedArbitrationTest, arbitrateByPoolPriority) {
+  const uint64_t memoryCapacity = 256 * MB;
+  const uint64_t minPoolCapacity = 8 * MB;
+  const int allocateSize = 8 * MB;
+  std::unordered_set<std::string> highPriorityPools;
+  setupMemory(memoryCapacity, minPoolCapacity, 0, [&](const MemoryPool& pool) {
+    MemoryArbitrator::PoolPolicy policy;
+    if (highPriorityPools.count(pool.name()) != 0) {
+      policy.priority = 1;
+    }
+    return policy;
+  });
+  // The high priority task holds most of the memory but the lower priority
+  // task is reclaimed first.
+  auto* highOp = addMemoryOp();
+  highPriorityPools.insert(highOp->pool()->root()->name());
+  while (highOp->pool()->currentBytes() < memoryCapacity / 2 + 64 * MB) {
+    highOp->allocate(allocateSize);
+  }
+  auto* lowOp = addMemoryOp();
+  while (arbitrator_->stats().freeCapacityBytes > 0) {
+    lowOp->allocate(allocateSize);
+  }
+  auto* arbitrateOp = addMemoryOp();
+  arbitrateOp->allocate(allocateSize);
+  ASSERT_EQ(highOp->reclaimer()->stats().numReclaims, 0);
+  ASSERT_EQ(lowOp->reclaimer()->stats().numReclaims, 1);
+  clearTasks();
+}
+
+TEST_F(MockSharedArbitrationTest, asyncGrowMemory) {
+  const uint64_t memoryCapacity = 256 * MB;
+  const uint64_t minPoolCapacity = 8 * MB;
+  const int allocateSize = 8 * MB;
+  // Without an arbitration executor, the capacity only grows on allocation.
+  setupMemory(memoryCapacity, minPoolCapacity);
+  ASSERT_FALSE(addMemoryOp()->pool()->growCapacityAsync(allocateSize).valid());
+  clearTasks();
+
+  folly::CPUThreadPoolExecutor executor(1);
+  arbitrationExecutor_ = &executor;
+  setupMemory(memoryCapacity, minPoolCapacity);
+  auto* reclaimedOp = addMemoryOp();
+  while (reclaimedOp->pool()->currentBytes() < memoryCapacity) {
+    reclaimedOp->allocate(allocateSize);
+  }
+  auto* arbitrateOp = addMemoryOp();
+  const auto capacity = arbitrateOp->capacity();
+  const auto numRequests = arbitrator_->stats().numRequests;
+  auto future = arbitrateOp->pool()->growCapacityAsync(allocateSize);
+  ASSERT_TRUE(future.valid());
+  ASSERT_TRUE(std::move(future).get());
+  ASSERT_GE(arbitrateOp->capacity(), capacity + allocateSize);
+  ASSERT_EQ(reclaimedOp->reclaimer()->stats().numReclaims, 1);
+  verifyReclaimerStats(arbitrateOp->reclaimer()->stats(), 0, 1);
+  // The grown capacity is used without another arbitration.
+  arbitrateOp->allocate(allocateSize);
+  ASSERT_EQ(arbitrator_->stats().numRequests, numRequests + 1);
+  clearTasks();
+}
+
 TEST_F(MockSharedArbitrationTest, arbitrateBySelfMemoryReclaim) {
   const std::vector<bool> isLeafReclaimables = {true, false};
   for (const auto isLeafReclaimable : isLeafReclaimables) {
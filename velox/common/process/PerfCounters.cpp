@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/common/process/PerfCounters.h"
+
+#include <fmt/format.h>
+#include <glog/logging.h>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace facebook::velox::process {
+
+std::string HardwareCounters::toString() const {
+  return fmt::format(
+      "cycles: {}, instructions: {}, llcMisses: {}, branchMisses: {}",
+      cycles,
+      instructions,
+      llcMisses,
+      branchMisses);
+}
+
+#ifdef __linux__
+namespace {
+
+// A group of counters of the thread that creates it, read together with one
+// read of the group leader.
+class ThreadCounters {
+ public:
+  ThreadCounters() {
+    const uint64_t events[kNumCounters] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES};
+    for (auto i = 0; i < kNumCounters; ++i) {
+      fds_[i] = open(events[i], i == 0 ? -1 : fds_[0]);
+      if (fds_[i] < 0) {
+        LOG_FIRST_N(WARNING, 1)
+            << "Hardware counters are not available: perf_event_open failed "
+            << "with errno " << errno;
+        closeAll();
+        return;
+      }
+    }
+    ioctl(fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  }
+
+  ~ThreadCounters() {
+    closeAll();
+  }
+
+  HardwareCounters read() const {
+    if (fds_[0] < 0) {
+      return {};
+    }
+    // The layout of a read of a group with PERF_FORMAT_GROUP.
+    struct {
+      uint64_t numCounters;
+      uint64_t values[kNumCounters];
+    } data;
+    if (::read(fds_[0], &data, sizeof(data)) != sizeof(data)) {
+      return {};
+    }
+    return {data.values[0], data.values[1], data.values[2], data.values[3]};
+  }
+
+ private:
+  static constexpr int32_t kNumCounters = 4;
+
+  // Opens a counter of hardware event 'config' for the calling thread on any
+  // CPU. The group leader starts disabled.
+  static int open(uint64_t config, int groupFd) {
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = groupFd == -1 ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    return syscall(__NR_perf_event_open, &attr, 0, -1, groupFd, 0);
+  }
+
+  void closeAll() {
+    for (auto& fd : fds_) {
+      if (fd >= 0) {
+        close(fd);
+        fd = -1;
+      }
+    }
+  }
+
+  int fds_[kNumCounters] = {-1, -1, -1, -1};
+};
+
+} // namespace
+
+HardwareCounters threadHardwareCounters() {
+  thread_local ThreadCounters counters;
+  return counters.read();
+}
+#else
+HardwareCounters threadHardwareCounters() {
+  return {};
+}
+#endif
+
+} // namespace facebook::velox::process
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace facebook::velox::process {
+
+/// Hardware event counts of a thread, as counted by the CPU's performance
+/// monitoring unit.
+struct HardwareCounters {
+  uint64_t cycles{0};
+  uint64_t instructions{0};
+  /// Last level cache misses.
+  uint64_t llcMisses{0};
+  uint64_t branchMisses{0};
+
+  void add(const HardwareCounters& other) {
+    cycles += other.cycles;
+    instructions += other.instructions;
+    llcMisses += other.llcMisses;
+    branchMisses += other.branchMisses;
+  }
+
+  HardwareCounters operator-(const HardwareCounters& other) const {
+    return {
+        cycles - other.cycles,
+        instructions - other.instructions,
+        llcMisses - other.llcMisses,
+        branchMisses - other.branchMisses};
+  }
+
+  bool empty() const {
+    return cycles == 0 && instructions == 0;
+  }
+
+  void clear() {
+    *this = {};
+  }
+
+  std::string toString() const;
+};
+
+/// Returns the hardware counters of the calling thread since their first read
+/// on the thread. The counters are opened with perf_event_open on the first
+/// call on each thread and count user space events only. Returns all zeros if
+/// the counters are not available, e.g. on other platforms than Linux, in VMs
+/// without a virtual PMU or if not permitted by
+/// /proc/sys/kernel/perf_event_paranoid. Each call is a read system call.
+HardwareCounters threadHardwareCounters();
+
+/// Reads the hardware counters of the calling thread at construction and
+/// passes the events counted since then to 'func' upon destruction.
+template <typename F>
+class DeltaHardwareCounters {
+ public:
+  explicit DeltaHardwareCounters(F&& func)
+      : start_(threadHardwareCounters()), func_(std::move(func)) {}
+
+  ~DeltaHardwareCounters() {
+    func_(threadHardwareCounters() - start_);
+  }
+
+ private:
+  const HardwareCounters start_;
+  F func_;
+};
+
+} // namespace facebook::velox::process
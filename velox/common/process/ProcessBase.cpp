@@ -20,7 +20,13 @@
 #include <stdlib.h>
 #include <time.h>
 #include <unistd.h>
+#ifdef __linux__
+#include <sched.h>
+#include <sys/syscall.h>
+#endif
 
+#include <fmt/format.h>
+#include <folly/Conv.h>
 #include <folly/CpuId.h>
 #include <folly/FileUtil.h>
 #include <folly/String.h>
@@ -124,6 +130,105 @@ bool hasBmi2() {
 #endif
 }
 
+namespace {
+// Parses a sysfs CPU or node list like "0-3,8,10-11".
+std::vector<int32_t> parseSysfsList(const std::string& list) {
+  std::vector<int32_t> result;
+  std::vector<folly::StringPiece> ranges;
+  folly::split(',', folly::trimWhitespace(list), ranges, true);
+  for (const auto& range : ranges) {
+    folly::StringPiece first;
+    folly::StringPiece last;
+    if (folly::split('-', range, first, last)) {
+      for (auto i = folly::to<int32_t>(first); i <= folly::to<int32_t>(last);
+           ++i) {
+        result.push_back(i);
+      }
+    } else {
+      result.push_back(folly::to<int32_t>(range));
+    }
+  }
+  return result;
+}
+
+std::vector<int32_t> readSysfsList(const std::string& path) {
+  std::string list;
+  if (!folly::readFile(path.c_str(), list)) {
+    return {};
+  }
+  try {
+    return parseSysfsList(list);
+  } catch (const std::exception&) {
+    return {};
+  }
+}
+} // namespace
+
+int32_t numaNodeCount() {
+  static const int32_t count = [] {
+    const auto nodes = readSysfsList("/sys/devices/system/node/online");
+    return nodes.empty() ? 1 : nodes.back() + 1;
+  }();
+  return count;
+}
+
+int32_t currentNumaNode() {
+#if defined(__linux__) && defined(SYS_getcpu)
+  unsigned cpu;
+  unsigned node;
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+    return node;
+  }
+#endif
+  return 0;
+}
+
+std::vector<int32_t> numaNodeCpus(int32_t node) {
+  return readSysfsList(
+      fmt::format("/sys/devices/system/node/node{}/cpulist", node));
+}
+
+bool bindToNumaNode(void* address, size_t bytes, int32_t node) {
+#if defined(__linux__) && defined(SYS_mbind)
+  // MPOL_PREFERRED from <numaif.h>, which is not a dependency.
+  constexpr int kMpolPreferred = 1;
+  constexpr int32_t kMaxNodes = 64;
+  if (node < 0 || node >= kMaxNodes) {
+    return false;
+  }
+  unsigned long nodeMask = 1UL << node;
+  return syscall(
+             SYS_mbind,
+             address,
+             bytes,
+             kMpolPreferred,
+             &nodeMask,
+             kMaxNodes + 1,
+             0) == 0;
+#else
+  return false;
+#endif
+}
+
+bool setThreadNumaNode(int32_t node) {
+#ifdef __linux__
+  const auto cpus = numaNodeCpus(node);
+  if (cpus.empty()) {
+    return false;
+  }
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  for (auto cpu : cpus) {
+    if (cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &cpuSet);
+    }
+  }
+  return pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet) == 0;
+#else
+  return false;
+#endif
+}
+
 } // namespace process
 } // namespace velox
 } // namespace facebook
@@ -63,6 +63,26 @@ bool hasAvx2();
 // flag.
 bool hasBmi2();
 
+// Returns the number of NUMA nodes of the machine. Returns 1 if the machine has
+// no NUMA topology or it cannot be read.
+int32_t numaNodeCount();
+
+// Returns the NUMA node of the CPU the calling thread runs on or 0 if unknown.
+int32_t currentNumaNode();
+
+// Returns the CPUs of NUMA node 'node'. Returns an empty vector if unknown.
+std::vector<int32_t> numaNodeCpus(int32_t node);
+
+// Sets the memory policy of the pages in ['address', 'address' + 'bytes') to
+// prefer NUMA node 'node'. The range must be page aligned. Returns false if
+// the policy could not be set. Pages that are already faulted in keep their
+// placement.
+bool bindToNumaNode(void* address, size_t bytes, int32_t node);
+
+// Restricts the calling thread to the CPUs of NUMA node 'node'. Returns false
+// if the CPUs of 'node' are unknown or the affinity could not be set.
+bool setThreadNumaNode(int32_t node);
+
 } // namespace process
 } // namespace velox
 } // namespace facebook
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/common/process/TraceTimeline.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <utility>
+
+#include <folly/json.h>
+#include <folly/system/ThreadId.h>
+#include <glog/logging.h>
+
+namespace facebook::velox::process {
+
+TraceTimeline::TraceTimeline(size_t capacity) {
+  CHECK_GT(capacity, 0);
+  events_.resize(capacity);
+}
+
+// static
+uint64_t TraceTimeline::nowMicros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void TraceTimeline::record(
+    const char* category,
+    std::string name,
+    uint64_t startMicros,
+    uint64_t endMicros,
+    int64_t arg) {
+  record(
+      category,
+      std::move(name),
+      startMicros,
+      endMicros,
+      folly::getOSThreadID(),
+      arg);
+}
+
+void TraceTimeline::record(
+    const char* category,
+    std::string name,
+    uint64_t startMicros,
+    uint64_t endMicros,
+    uint64_t threadId,
+    int64_t arg) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto& event = events_[numRecorded_++ % events_.size()];
+  event.category = category;
+  event.name = std::move(name);
+  event.startMicros = startMicros;
+  event.durationMicros = endMicros > startMicros ? endMicros - startMicros : 0;
+  event.threadId = threadId;
+  event.arg = arg;
+}
+
+std::vector<TraceTimeline::Event> TraceTimeline::events() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  const auto capacity = events_.size();
+  std::vector<Event> result;
+  if (numRecorded_ <= capacity) {
+    result.assign(events_.begin(), events_.begin() + numRecorded_);
+    return result;
+  }
+  result.reserve(capacity);
+  const auto oldest = numRecorded_ % capacity;
+  result.insert(result.end(), events_.begin() + oldest, events_.end());
+  result.insert(result.end(), events_.begin(), events_.begin() + oldest);
+  return result;
+}
+
+uint64_t TraceTimeline::numDropped() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return numRecorded_ > events_.size() ? numRecorded_ - events_.size() : 0;
+}
+
+std::string TraceTimeline::toChromeTraceJson(const std::string& label) const {
+  const auto allEvents = events();
+  uint64_t base = std::numeric_limits<uint64_t>::max();
+  for (const auto& event : allEvents) {
+    base = std::min(base, event.startMicros);
+  }
+
+  folly::dynamic traceEvents = folly::dynamic::array;
+  traceEvents.push_back(folly::dynamic::object("name", "process_name")(
+      "ph", "M")("pid", 1)("args", folly::dynamic::object("name", label)));
+  for (const auto& event : allEvents) {
+    folly::dynamic obj = folly::dynamic::object;
+    obj["name"] = event.name;
+    obj["cat"] = event.category;
+    obj["ph"] = "X";
+    obj["ts"] = event.startMicros - base;
+    obj["dur"] = event.durationMicros;
+    obj["pid"] = 1;
+    obj["tid"] = event.threadId;
+    if (event.arg != 0) {
+      obj["args"] = folly::dynamic::object("value", event.arg);
+    }
+    traceEvents.push_back(std::move(obj));
+  }
+  folly::dynamic trace = folly::dynamic::object;
+  trace["traceEvents"] = std::move(traceEvents);
+  trace["displayTimeUnit"] = "ms";
+  return folly::toJson(trace);
+}
+
+// static
+std::shared_ptr<TraceTimeline>& TraceTimeline::currentRef() {
+  thread_local std::shared_ptr<TraceTimeline> timeline;
+  return timeline;
+}
+
+// static
+const std::shared_ptr<TraceTimeline>& TraceTimeline::current() {
+  return currentRef();
+}
+
+ScopedTraceTimeline::ScopedTraceTimeline(
+    std::shared_ptr<TraceTimeline> timeline) {
+  auto& current = TraceTimeline::currentRef();
+  if (timeline == nullptr && current == nullptr) {
+    return;
+  }
+  saved_ = std::exchange(current, std::move(timeline));
+  changed_ = true;
+}
+
+ScopedTraceTimeline::~ScopedTraceTimeline() {
+  if (changed_) {
+    TraceTimeline::currentRef() = std::move(saved_);
+  }
+}
+
+} // namespace facebook::velox::process
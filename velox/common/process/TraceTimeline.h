@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace facebook::velox::process {
+
+/// Records a timeline of what the threads working on a task do: the
+/// intervals drivers run on a thread and are blocked off thread, IO loads,
+/// spill writes and memory arbitration waits. Events go into a ring buffer of
+/// fixed capacity so that the oldest events are overwritten on long running
+/// tasks. The timeline is exported in the Chrome trace event format, which
+/// chrome://tracing and Perfetto open. Thread safe.
+class TraceTimeline {
+ public:
+  struct Event {
+    /// Static string, e.g. "driver", "io", "spill" or "memory".
+    const char* category{nullptr};
+    std::string name;
+    /// Microseconds since an arbitrary start point, see nowMicros().
+    uint64_t startMicros{0};
+    uint64_t durationMicros{0};
+    /// OS thread id of the thread recording the event or the track of
+    /// events that do not happen on any one thread, see driverTrack().
+    uint64_t threadId{0};
+    /// Event specific value, e.g. bytes read or written. Exported if not 0.
+    int64_t arg{0};
+  };
+
+  /// Creates a timeline that keeps the last 'capacity' events.
+  explicit TraceTimeline(size_t capacity);
+
+  /// Returns the time in microseconds from a monotonic clock.
+  static uint64_t nowMicros();
+
+  /// Returns the track for the off thread intervals of a driver. These do
+  /// not collide with OS thread ids in practice and stay below 2^53 so that
+  /// JSON readers do not round them.
+  static uint64_t driverTrack(int32_t pipelineId, int32_t driverId) {
+    return (1ULL << 40) | (static_cast<uint64_t>(pipelineId & 0xfffff) << 20) |
+        (driverId & 0xfffff);
+  }
+
+  /// Records an event on the calling thread.
+  void record(
+      const char* category,
+      std::string name,
+      uint64_t startMicros,
+      uint64_t endMicros,
+      int64_t arg = 0);
+
+  /// Records an event on the track 'threadId'.
+  void record(
+      const char* category,
+      std::string name,
+      uint64_t startMicros,
+      uint64_t endMicros,
+      uint64_t threadId,
+      int64_t arg);
+
+  /// Returns the recorded events from oldest to newest.
+  std::vector<Event> events() const;
+
+  /// Returns the number of events dropped because the ring was full.
+  uint64_t numDropped() const;
+
+  /// Returns the events as a Chrome trace JSON object with complete ("X")
+  /// events. The timestamps are relative to the first event. 'label' names
+  /// the process track, e.g. the task id.
+  std::string toChromeTraceJson(const std::string& label) const;
+
+  /// Returns the timeline of the calling thread or nullptr if none. Events
+  /// are recorded only on threads that have a timeline.
+  static const std::shared_ptr<TraceTimeline>& current();
+
+ private:
+  friend class ScopedTraceTimeline;
+
+  static std::shared_ptr<TraceTimeline>& currentRef();
+
+  mutable std::mutex mutex_;
+  std::vector<Event> events_;
+  // Total number of events recorded. The next event goes to
+  // events_[numRecorded_ % capacity].
+  uint64_t numRecorded_{0};
+};
+
+/// Sets the timeline of the calling thread for the lifetime of 'this' and
+/// restores the previous one at destruction. Is a no-op if 'timeline' is
+/// nullptr and the thread has no timeline. Used by drivers and by background
+/// work started from drivers, e.g. prefetches and asynchronous spill writes.
+class ScopedTraceTimeline {
+ public:
+  explicit ScopedTraceTimeline(std::shared_ptr<TraceTimeline> timeline);
+
+  ~ScopedTraceTimeline();
+
+ private:
+  std::shared_ptr<TraceTimeline> saved_;
+  bool changed_{false};
+};
+
+/// Records an event for the lifetime of 'this' in the timeline of the
+/// calling thread. Costs a thread local read if the thread has no timeline.
+class TraceEvent {
+ public:
+  TraceEvent(const char* category, const char* name, int64_t arg = 0)
+      : timeline_(TraceTimeline::current().get()),
+        category_(category),
+        name_(name),
+        arg_(arg),
+        startMicros_(timeline_ ? TraceTimeline::nowMicros() : 0) {}
+
+  ~TraceEvent() {
+    if (timeline_) {
+      timeline_->record(
+          category_, name_, startMicros_, TraceTimeline::nowMicros(), arg_);
+    }
+  }
+
+  /// Sets the value exported with the event, e.g. when known only at the end.
+  void setArg(int64_t arg) {
+    arg_ = arg;
+  }
+
+ private:
+  TraceTimeline* const timeline_;
+  const char* const category_;
+  const char* const name_;
+  int64_t arg_;
+  const uint64_t startMicros_;
+};
+
+} // namespace facebook::velox::process
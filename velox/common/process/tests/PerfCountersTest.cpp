@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/common/process/PerfCounters.h"
+#include <glog/logging.h>
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace facebook::velox::process;
+
+namespace {
+int64_t busyLoop(int64_t n) {
+  int64_t sum = 0;
+  for (int64_t i = 0; i < n; ++i) {
+    sum += i * i % 7;
+    asm volatile("" : "+r"(sum));
+  }
+  return sum;
+}
+} // namespace
+
+TEST(PerfCountersTest, delta) {
+  HardwareCounters delta;
+  {
+    DeltaHardwareCounters counters(
+        [&](const HardwareCounters& counted) { delta = counted; });
+    busyLoop(1'000'000);
+  }
+  if (threadHardwareCounters().empty()) {
+    // No counters in this environment. The delta is then all zeros.
+    EXPECT_TRUE(delta.empty());
+    return;
+  }
+  EXPECT_GT(delta.cycles, 0);
+  EXPECT_GT(delta.instructions, 1'000'000);
+  LOG(INFO) << delta.toString();
+}
+
+TEST(PerfCountersTest, perThread) {
+  if (threadHardwareCounters().empty()) {
+    return;
+  }
+  // Events counted on another thread do not show in the counters of this
+  // thread.
+  const auto start = threadHardwareCounters();
+  HardwareCounters otherThreadDelta;
+  std::thread([&]() {
+    const auto otherStart = threadHardwareCounters();
+    busyLoop(10'000'000);
+    otherThreadDelta = threadHardwareCounters() - otherStart;
+  }).join();
+  const auto delta = threadHardwareCounters() - start;
+  EXPECT_GT(otherThreadDelta.instructions, 10'000'000);
+  EXPECT_LT(delta.instructions, otherThreadDelta.instructions);
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/common/process/TraceTimeline.h"
+#include <folly/json.h>
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace facebook::velox::process;
+
+TEST(TraceTimelineTest, ring) {
+  TraceTimeline timeline(3);
+  for (auto i = 0; i < 5; ++i) {
+    timeline.record("test", std::to_string(i), i * 10, i * 10 + 5, i);
+  }
+  EXPECT_EQ(timeline.numDropped(), 2);
+  auto events = timeline.events();
+  ASSERT_EQ(events.size(), 3);
+  for (auto i = 0; i < 3; ++i) {
+    EXPECT_EQ(events[i].name, std::to_string(i + 2));
+    EXPECT_EQ(events[i].startMicros, (i + 2) * 10);
+    EXPECT_EQ(events[i].durationMicros, 5);
+    EXPECT_EQ(events[i].arg, i + 2);
+  }
+}
+
+TEST(TraceTimelineTest, scoped) {
+  auto timeline = std::make_shared<TraceTimeline>(100);
+  {
+    // Not recorded without a timeline on the thread.
+    TraceEvent event("test", "none");
+  }
+  EXPECT_EQ(TraceTimeline::current(), nullptr);
+  {
+    ScopedTraceTimeline scoped(timeline);
+    EXPECT_EQ(TraceTimeline::current(), timeline);
+    TraceEvent outer("test", "outer", 1);
+    {
+      ScopedTraceTimeline none(nullptr);
+      TraceEvent event("test", "none");
+    }
+    // Background work started from a thread with a timeline.
+    std::thread([timeline = TraceTimeline::current()]() {
+      ScopedTraceTimeline scoped(timeline);
+      TraceEvent event("test", "background");
+    }).join();
+  }
+  EXPECT_EQ(TraceTimeline::current(), nullptr);
+
+  auto events = timeline->events();
+  ASSERT_EQ(events.size(), 2);
+  EXPECT_EQ(events[0].name, "background");
+  EXPECT_EQ(events[1].name, "outer");
+  EXPECT_EQ(events[1].arg, 1);
+  EXPECT_NE(events[0].threadId, events[1].threadId);
+}
+
+TEST(TraceTimelineTest, chromeTrace) {
+  TraceTimeline timeline(10);
+  timeline.record("driver", "run", 1'000, 1'500);
+  timeline.record(
+      "driver",
+      "kWaitForSplit",
+      1'500,
+      2'000,
+      TraceTimeline::driverTrack(1, 2),
+      0);
+  timeline.record("io", "Load", 1'200, 1'300, 4096);
+
+  auto trace = folly::parseJson(timeline.toChromeTraceJson("task.1"));
+  const auto& events = trace["traceEvents"];
+  ASSERT_EQ(events.size(), 4);
+  EXPECT_EQ(events[0]["ph"], "M");
+  EXPECT_EQ(events[0]["args"]["name"], "task.1");
+
+  EXPECT_EQ(events[1]["name"], "run");
+  EXPECT_EQ(events[1]["cat"], "driver");
+  EXPECT_EQ(events[1]["ph"], "X");
+  EXPECT_EQ(events[1]["ts"], 0);
+  EXPECT_EQ(events[1]["dur"], 500);
+  EXPECT_EQ(events[1].count("args"), 0);
+
+  EXPECT_EQ(events[2]["ts"], 500);
+  EXPECT_EQ(events[2]["tid"], TraceTimeline::driverTrack(1, 2));
+
+  EXPECT_EQ(events[3]["ts"], 200);
+  EXPECT_EQ(events[3]["args"]["value"], 4096);
+}
@@ -16,7 +16,46 @@
 
 #include "velox/common/time/CpuWallTimer.h"
 
+#include <folly/Random.h>
+
 namespace facebook::velox {
+namespace {
+// Returns the nanoseconds per tick of folly::hardware_timestamp() over a short
+// busy wait.
+double calibrateNanosPerTick() {
+  constexpr std::chrono::microseconds kCalibrationTime{2'000};
+  const auto wallStart = std::chrono::steady_clock::now();
+  const auto ticksStart = folly::hardware_timestamp();
+  auto wallEnd = wallStart;
+  while (wallEnd - wallStart < kCalibrationTime) {
+    wallEnd = std::chrono::steady_clock::now();
+  }
+  const auto ticks = folly::hardware_timestamp() - ticksStart;
+  const auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                         wallEnd - wallStart)
+                         .count();
+  return ticks > 0 ? static_cast<double>(nanos) / ticks : 1;
+}
+} // namespace
+
+uint64_t hardwareTicksToNanos(uint64_t ticks) {
+  static const double nanosPerTick = calibrateNanosPerTick();
+  if (static_cast<int64_t>(ticks) <= 0) {
+    return 0;
+  }
+  return ticks * nanosPerTick;
+}
+
+bool sampleThreadCpuTime() {
+  // A xorshift generator, so that timers that repeat in a fixed pattern are
+  // all sampled.
+  thread_local uint32_t state = folly::Random::rand32() | 1;
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return state % kCpuTimeSamplingRate == 0;
+}
+
 CpuWallTimer::CpuWallTimer(CpuWallTiming& timing) : timing_(timing) {
   ++timing_.count;
   cpuTimeStart_ = process::threadCpuNanos();
@@ -16,6 +16,7 @@
 #pragma once
 
 #include <fmt/format.h>
+#include <folly/chrono/Hardware.h>
 #include <chrono>
 #include "velox/common/process/ProcessBase.h"
 
@@ -85,4 +86,87 @@ class DeltaCpuWallTimer {
   F func_;
 };
 
+// The sampled timers below measure the thread CPU time on one in this many
+// timers.
+constexpr uint64_t kCpuTimeSamplingRate = 16;
+
+// Returns the nanoseconds in 'ticks' of folly::hardware_timestamp(), i.e. of
+// rdtsc on x86 and cntvct on ARM. The tick rate is calibrated against
+// std::chrono::steady_clock on first use. 'ticks' is a difference of two
+// timestamps and is taken as 0 if negative, which may happen if the thread
+// moved to a core with a slightly different counter.
+uint64_t hardwareTicksToNanos(uint64_t ticks);
+
+// Returns true for a random one in kCpuTimeSamplingRate calls on the calling
+// thread.
+bool sampleThreadCpuTime();
+
+// Like CpuWallTimer but cheap enough for timing each call of a short
+// operation. The wall time comes from the CPU cycle counter. The thread CPU
+// time takes a system call, so after the first call on 'timing' it is only
+// measured by a random one in kCpuTimeSamplingRate timers, which add
+// kCpuTimeSamplingRate times their CPU time. The CPU time is thus an estimate
+// that gets accurate over many calls.
+class SampledCpuWallTimer {
+ public:
+  explicit SampledCpuWallTimer(CpuWallTiming& timing)
+      : timing_(timing),
+        cpuTimeScale_(cpuTimeScale(timing)),
+        cpuTimeStart_(cpuTimeScale_ ? process::threadCpuNanos() : 0),
+        wallTicksStart_(folly::hardware_timestamp()) {}
+
+  ~SampledCpuWallTimer() {
+    ++timing_.count;
+    timing_.wallNanos +=
+        hardwareTicksToNanos(folly::hardware_timestamp() - wallTicksStart_);
+    if (cpuTimeScale_) {
+      timing_.cpuNanos +=
+          (process::threadCpuNanos() - cpuTimeStart_) * cpuTimeScale_;
+    }
+  }
+
+ private:
+  static uint64_t cpuTimeScale(const CpuWallTiming& timing) {
+    if (timing.count == 0) {
+      return 1;
+    }
+    return sampleThreadCpuTime() ? kCpuTimeSamplingRate : 0;
+  }
+
+  CpuWallTiming& timing_;
+  // Multiplier of the measured CPU time. 0 if the CPU time is not measured.
+  const uint64_t cpuTimeScale_;
+  const uint64_t cpuTimeStart_;
+  const uint64_t wallTicksStart_;
+};
+
+// DeltaCpuWallTimer with the time measurement of SampledCpuWallTimer. There is
+// no accumulated timing to tell the first call, so the CPU time of every call
+// is sampled.
+template <typename F>
+class SampledDeltaCpuWallTimer {
+ public:
+  explicit SampledDeltaCpuWallTimer(F&& func)
+      : sampleCpu_(sampleThreadCpuTime()),
+        cpuTimeStart_(sampleCpu_ ? process::threadCpuNanos() : 0),
+        wallTicksStart_(folly::hardware_timestamp()),
+        func_(std::move(func)) {}
+
+  ~SampledDeltaCpuWallTimer() {
+    const CpuWallTiming deltaTiming{
+        1,
+        hardwareTicksToNanos(folly::hardware_timestamp() - wallTicksStart_),
+        sampleCpu_
+            ? (process::threadCpuNanos() - cpuTimeStart_) * kCpuTimeSamplingRate
+            : 0};
+    func_(deltaTiming);
+  }
+
+ private:
+  const bool sampleCpu_;
+  const uint64_t cpuTimeStart_;
+  const uint64_t wallTicksStart_;
+  F func_;
+};
+
 } // namespace facebook::velox
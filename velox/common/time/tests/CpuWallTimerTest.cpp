@@ -135,4 +135,57 @@ TEST_F(CpuWallTimerTest, deltaCpuWallTimer) {
   EXPECT_LT(cpuFirstTime, timing.cpuNanos);
 }
 
+TEST_F(CpuWallTimerTest, hardwareTicksToNanos) {
+  constexpr std::chrono::nanoseconds sleepTime{100'000'000};
+  const auto wallStart = std::chrono::steady_clock::now();
+  const auto ticksStart = folly::hardware_timestamp();
+  workAndSleep(sleepTime);
+  const auto nanos =
+      hardwareTicksToNanos(folly::hardware_timestamp() - ticksStart);
+  const auto wallNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::steady_clock::now() - wallStart)
+                             .count();
+  EXPECT_LT(sleepTime.count(), nanos * 1.1);
+  EXPECT_LT(nanos, wallNanos * 1.1);
+}
+
+TEST_F(CpuWallTimerTest, sampledCpuWallTimer) {
+  CpuWallTiming timing;
+  constexpr std::chrono::nanoseconds sleepTime{100'000'000};
+  {
+    SampledCpuWallTimer timer{timing};
+    workAndSleep(sleepTime);
+  }
+  // The first timer always measures the CPU time.
+  EXPECT_EQ(1, timing.count);
+  EXPECT_LT(sleepTime.count() * 0.9, timing.wallNanos);
+  EXPECT_LT(0, timing.cpuNanos);
+  const auto cpuFirstTime = timing.cpuNanos;
+
+  // The CPU time is measured on some of many timers.
+  constexpr int32_t kNumTimers = 2'000;
+  for (auto i = 0; i < kNumTimers; ++i) {
+    SampledCpuWallTimer timer{timing};
+    workAndSleep(std::chrono::nanoseconds(0));
+  }
+  EXPECT_EQ(kNumTimers + 1, timing.count);
+  EXPECT_LT(cpuFirstTime, timing.cpuNanos);
+}
+
+TEST_F(CpuWallTimerTest, sampledDeltaCpuWallTimer) {
+  CpuWallTiming timing;
+  constexpr int32_t kNumTimers = 2'000;
+  for (auto i = 0; i < kNumTimers; ++i) {
+    SampledDeltaCpuWallTimer timer{[&](const CpuWallTiming& deltaTiming) {
+      EXPECT_EQ(1, deltaTiming.count);
+      EXPECT_EQ(0, deltaTiming.cpuNanos % kCpuTimeSamplingRate);
+      timing.add(deltaTiming);
+    }};
+    workAndSleep(std::chrono::nanoseconds(0));
+  }
+  EXPECT_EQ(kNumTimers, timing.count);
+  EXPECT_LT(0, timing.wallNanos);
+  EXPECT_LT(0, timing.cpuNanos);
+}
+
 } // namespace facebook::velox::test
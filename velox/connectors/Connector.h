@@ -148,6 +148,17 @@ class DataSink {
   virtual std::vector<std::string> finish() const = 0;
 
   virtual void close() = 0;
+
+  /// Returns true if the sink can free memory on request of the memory
+  /// arbitrator by writing out buffered data early.
+  virtual bool canReclaim() const {
+    return false;
+  }
+
+  /// Writes out buffered data to free at least 'targetBytes' of memory, or as
+  /// much as possible if 'targetBytes' is 0. Only called if canReclaim() is
+  /// true and never concurrently with appendData().
+  virtual void reclaim(uint64_t /*targetBytes*/) {}
 };
 
 class DataSource {
@@ -211,6 +222,12 @@ class DataSource {
   virtual int64_t estimatedRowSize() {
     return kUnknownRowSize;
   }
+
+  // Hints that the consumer needs no more than 'limit' rows in total from
+  // the splits of 'this', e.g. for a Limit right above the scan. Called
+  // before the first addSplit(). The source may then read smaller batches,
+  // skip read-ahead and end the splits once 'limit' rows are returned.
+  virtual void setRowLimit(uint64_t /*limit*/) {}
 };
 
 /// Collection of context data for use in a DataSource or DataSink. One instance
@@ -350,10 +367,11 @@ class Connector {
   // Returns a ScanTracker for 'id'. 'id' uniquely identifies the
   // tracker and different threads will share the same
   // instance. 'loadQuantum' is the largest single IO for the query
-  // being tracked.
+  // being tracked. 'fileGroupStats' is given the accesses of a new tracker.
   static std::shared_ptr<cache::ScanTracker> getTracker(
       const std::string& scanId,
-      int32_t loadQuantum);
+      int32_t loadQuantum,
+      cache::FileGroupStats* FOLLY_NULLABLE fileGroupStats = nullptr);
 
   virtual folly::Executor* FOLLY_NULLABLE executor() const {
     return nullptr;
@@ -38,13 +38,42 @@ std::shared_ptr<FileHandle> FileHandleGenerator::operator()(
   // We have seen cases where drivers are stuck when creating file handles.
   // Adding a trace here to spot this more easily in future.
   process::TraceContext trace("FileHandleGenerator::operator()");
+  if (negativeCacheMs_ > 0) {
+    std::exception_ptr error;
+    openFailures_.withWLock([&](auto& failures) {
+      auto it = failures.find(filename);
+      if (it == failures.end()) {
+        return;
+      }
+      if (getCurrentTimeMs() - it->second.timeMs < negativeCacheMs_) {
+        error = it->second.error;
+      } else {
+        failures.erase(it);
+      }
+    });
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
   uint64_t elapsedTimeUs{0};
   std::shared_ptr<FileHandle> fileHandle;
   {
     MicrosecondTimer timer(&elapsedTimeUs);
     fileHandle = std::make_shared<FileHandle>();
-    fileHandle->file = filesystems::getFileSystem(filename, properties_)
-                           ->openFileForRead(filename);
+    try {
+      fileHandle->file = filesystems::getFileSystem(filename, properties_)
+                             ->openFileForRead(filename);
+    } catch (const std::exception&) {
+      if (negativeCacheMs_ > 0) {
+        auto failures = openFailures_.wlock();
+        if (failures->size() >= kMaxOpenFailures) {
+          failures->clear();
+        }
+        (*failures)[filename] = {getCurrentTimeMs(), std::current_exception()};
+      }
+      throw;
+    }
+    fileHandle->openTimeMs = getCurrentTimeMs();
     fileHandle->uuid = StringIdLease(fileIds(), filename);
     fileHandle->groupId = StringIdLease(fileIds(), groupName(filename));
     VLOG(1) << "Generating file handle for: " << filename
@@ -58,4 +87,9 @@ std::shared_ptr<FileHandle> FileHandleGenerator::operator()(
   return fileHandle;
 }
 
+bool isFileHandleValid(const FileHandle& fileHandle, uint64_t expirationMs) {
+  return expirationMs == 0 ||
+      getCurrentTimeMs() - fileHandle.openTimeMs < expirationMs;
+}
+
 } // namespace facebook::velox
@@ -29,10 +29,14 @@
 #include <memory>
 #include <string>
 
+#include <folly/Synchronized.h>
+
 #include "velox/common/caching/CachedFactory.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/file/File.h"
 #include "velox/dwio/common/InputStream.h"
+#include "velox/dwio/common/Statistics.h"
+#include "velox/type/Type.h"
 
 namespace facebook::velox {
 
@@ -52,6 +56,26 @@ struct FileHandle {
   // example to decide placing on SSD.
   StringIdLease groupId;
 
+  // Time of opening 'file' in ms since epoch. See isFileHandleValid().
+  uint64_t openTimeMs{0};
+
+  // File-level statistics of a top-level column of the file.
+  struct ColumnStatistics {
+    TypePtr type;
+    std::shared_ptr<dwio::common::ColumnStatistics> statistics;
+  };
+
+  // Statistics of the file kept from earlier reads of its footer. Later
+  // splits of the file, also of other queries, test their filters against
+  // these before reading the footer again. Set when a split of the file is
+  // opened. 'columns' has the columns looked at by the filters of the splits
+  // opened so far.
+  struct Statistics {
+    std::optional<uint64_t> numRows;
+    std::unordered_map<std::string, ColumnStatistics> columns;
+  };
+  folly::Synchronized<Statistics> statistics;
+
   // We'll want to have a hash map here to record the identifier->byte range
   // mappings. Different formats may have different identifiers, so we may need
   // a union of maps. For example in orc you need 3 integers (I think, to be
@@ -62,17 +86,41 @@ struct FileHandle {
 using FileHandleCache = SimpleLRUCache<std::string, FileHandle>;
 
 // Creates FileHandles via the Generator interface the CachedFactory requires.
+//
+// A failure to open a file is kept for 'negativeCacheMs' if this is non-zero.
+// Opening the file again in this time throws the same error without calling
+// the file system, e.g. for splits of a file that has been deleted.
 class FileHandleGenerator {
  public:
   FileHandleGenerator() {}
-  FileHandleGenerator(std::shared_ptr<const Config> properties)
-      : properties_(std::move(properties)) {}
+  FileHandleGenerator(
+      std::shared_ptr<const Config> properties,
+      uint64_t negativeCacheMs = 0)
+      : properties_(std::move(properties)),
+        negativeCacheMs_(negativeCacheMs) {}
   std::shared_ptr<FileHandle> operator()(const std::string& filename);
 
  private:
+  // A failed open of a file.
+  struct OpenFailure {
+    uint64_t timeMs;
+    std::exception_ptr error;
+  };
+
+  // Maximum number of kept failures. All are dropped when this is exceeded.
+  static constexpr int32_t kMaxOpenFailures = 10'000;
+
   const std::shared_ptr<const Config> properties_;
+  const uint64_t negativeCacheMs_{0};
+  folly::Synchronized<std::unordered_map<std::string, OpenFailure>>
+      openFailures_;
 };
 
+// Returns true if 'fileHandle' was opened less than 'expirationMs' ago. An
+// 'expirationMs' of 0 means that handles do not expire. Used as the validity
+// check of a FileHandleFactory.
+bool isFileHandleValid(const FileHandle& fileHandle, uint64_t expirationMs);
+
 using FileHandleFactory = CachedFactory<
     std::string,
     std::shared_ptr<FileHandle>,
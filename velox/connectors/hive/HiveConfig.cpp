@@ -125,6 +125,21 @@ std::string HiveConfig::s3IAMRoleSessionName(const Config* config) {
   return config->get(kS3IamRoleSessionName, std::string("velox-session"));
 }
 
+// static
+uint32_t HiveConfig::s3MaxConnections(const Config* config) {
+  return config->get<uint32_t>(kS3MaxConnections, 64);
+}
+
+// static
+uint32_t HiveConfig::s3ReadParallelism(const Config* config) {
+  return config->get<uint32_t>(kS3ReadParallelism, 16);
+}
+
+// static
+uint64_t HiveConfig::s3ReadPartSize(const Config* config) {
+  return config->get<uint64_t>(kS3ReadPartSize, 8 << 20);
+}
+
 // static
 std::string HiveConfig::gcsEndpoint(const Config* config) {
   return config->get<std::string>(kGCSEndpoint, std::string(""));
@@ -160,4 +175,19 @@ int32_t HiveConfig::numCacheFileHandles(const Config* config) {
   return config->get<int32_t>(kNumCacheFileHandles, 20'000);
 }
 
+// static.
+uint64_t HiveConfig::fileHandleExpirationMs(const Config* config) {
+  return config->get<uint64_t>(kFileHandleExpirationMs, 0);
+}
+
+// static.
+uint64_t HiveConfig::fileHandleNegativeCacheMs(const Config* config) {
+  return config->get<uint64_t>(kFileHandleNegativeCacheMs, 0);
+}
+
+// static.
+uint32_t HiveConfig::sortWriterMaxOutputRows(const Config* config) {
+  return config->get<uint32_t>(kSortWriterMaxOutputRows, 1024);
+}
+
 } // namespace facebook::velox::connector::hive
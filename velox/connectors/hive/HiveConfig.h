@@ -80,6 +80,19 @@ class HiveConfig {
   static constexpr const char* kS3IamRoleSessionName =
       "hive.s3.iam-role-session-name";
 
+  /// Maximum number of open HTTP connections of the S3 client, shared by all
+  /// files of the file system.
+  static constexpr const char* kS3MaxConnections = "hive.s3.max-connections";
+
+  /// Number of threads of the S3 client that issue the ranged GET requests
+  /// of reads in parallel and of ReadFile::preadvAsync(). 0 reads on the
+  /// calling thread.
+  static constexpr const char* kS3ReadParallelism = "hive.s3.read-parallelism";
+
+  /// Reads larger than this are split into ranged GET requests of this size
+  /// that run in parallel.
+  static constexpr const char* kS3ReadPartSize = "hive.s3.read-part-size";
+
   // The GCS storage endpoint server.
   static constexpr const char* kGCSEndpoint = "hive.gcs.endpoint";
 
@@ -103,6 +116,22 @@ class HiveConfig {
   /// Maximum number of entries in the file handle cache.
   static constexpr const char* kNumCacheFileHandles = "num_cached_file_handles";
 
+  /// Time in ms after which a cached file handle is opened again, e.g. to see
+  /// a file that has been replaced. 0 means that cached handles are used
+  /// until evicted.
+  static constexpr const char* kFileHandleExpirationMs =
+      "file-handle-expiration-ms";
+
+  /// Time in ms for which a failure to open a file is kept and returned for
+  /// later opens of the file without calling the file system. 0 disables.
+  static constexpr const char* kFileHandleNegativeCacheMs =
+      "file-handle-negative-cache-ms";
+
+  /// Maximum number of rows in a batch of sorted rows written to a file of a
+  /// table with sorted-by columns.
+  static constexpr const char* kSortWriterMaxOutputRows =
+      "sort_writer_max_output_rows";
+
   static InsertExistingPartitionsBehavior insertExistingPartitionsBehavior(
       const Config* config);
 
@@ -128,6 +157,12 @@ class HiveConfig {
 
   static std::string s3IAMRoleSessionName(const Config* config);
 
+  static uint32_t s3MaxConnections(const Config* config);
+
+  static uint32_t s3ReadParallelism(const Config* config);
+
+  static uint64_t s3ReadPartSize(const Config* config);
+
   static std::string gcsEndpoint(const Config* config);
 
   static std::string gcsScheme(const Config* config);
@@ -141,6 +176,12 @@ class HiveConfig {
   static int32_t maxCoalescedDistanceBytes(const Config* config);
 
   static int32_t numCacheFileHandles(const Config* config);
+
+  static uint64_t fileHandleExpirationMs(const Config* config);
+
+  static uint64_t fileHandleNegativeCacheMs(const Config* config);
+
+  static uint32_t sortWriterMaxOutputRows(const Config* config);
 };
 
 } // namespace facebook::velox::connector::hive
@@ -54,6 +54,14 @@ int32_t numCachedFileHandles(const Config* properties) {
   return properties ? HiveConfig::numCacheFileHandles(properties) : 20'000;
 }
 
+uint64_t fileHandleExpirationMs(const Config* properties) {
+  return properties ? HiveConfig::fileHandleExpirationMs(properties) : 0;
+}
+
+uint64_t fileHandleNegativeCacheMs(const Config* properties) {
+  return properties ? HiveConfig::fileHandleNegativeCacheMs(properties) : 0;
+}
+
 HiveConnector::HiveConnector(
     const std::string& id,
     std::shared_ptr<const Config> properties,
@@ -63,7 +71,12 @@ HiveConnector::HiveConnector(
           std::make_unique<
               SimpleLRUCache<std::string, std::shared_ptr<FileHandle>>>(
               numCachedFileHandles(properties.get())),
-          std::make_unique<FileHandleGenerator>(properties)),
+          std::make_unique<FileHandleGenerator>(
+              properties, fileHandleNegativeCacheMs(properties.get())),
+          [expirationMs = fileHandleExpirationMs(properties.get())](
+              const std::shared_ptr<FileHandle>& fileHandle) {
+            return isFileHandleValid(*fileHandle, expirationMs);
+          }),
       executor_(executor) {
   LOG(INFO) << "Hive connector " << connectorId() << " created with maximum of "
             << numCachedFileHandles(properties.get())
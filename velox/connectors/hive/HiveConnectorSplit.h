@@ -22,6 +22,15 @@
 
 namespace facebook::velox::connector::hive {
 
+/// A file of positional deletes for the data file of a HiveConnectorSplit. The
+/// file has a BIGINT column 'pos' with the positions of the deleted rows in the
+/// data file, 0 for the first row, sorted in ascending order. The deleted rows
+/// are removed while reading the data file.
+struct HiveDeleteFile {
+  std::string filePath;
+  dwio::common::FileFormat fileFormat;
+};
+
 struct HiveConnectorSplit : public connector::ConnectorSplit {
   const std::string filePath;
   dwio::common::FileFormat fileFormat;
@@ -32,6 +41,7 @@ struct HiveConnectorSplit : public connector::ConnectorSplit {
   std::optional<int32_t> tableBucketNumber;
   std::unordered_map<std::string, std::string> customSplitInfo;
   std::shared_ptr<std::string> extraFileInfo;
+  std::vector<HiveDeleteFile> deleteFiles;
 
   HiveConnectorSplit(
       const std::string& connectorId,
@@ -43,7 +53,8 @@ struct HiveConnectorSplit : public connector::ConnectorSplit {
           _partitionKeys = {},
       std::optional<int32_t> _tableBucketNumber = std::nullopt,
       const std::unordered_map<std::string, std::string>& _customSplitInfo = {},
-      const std::shared_ptr<std::string>& _extraFileInfo = {})
+      const std::shared_ptr<std::string>& _extraFileInfo = {},
+      const std::vector<HiveDeleteFile>& _deleteFiles = {})
       : ConnectorSplit(connectorId),
         filePath(_filePath),
         fileFormat(_fileFormat),
@@ -52,7 +63,8 @@ struct HiveConnectorSplit : public connector::ConnectorSplit {
         partitionKeys(_partitionKeys),
         tableBucketNumber(_tableBucketNumber),
         customSplitInfo(_customSplitInfo),
-        extraFileInfo(_extraFileInfo) {}
+        extraFileInfo(_extraFileInfo),
+        deleteFiles(_deleteFiles) {}
 
   std::string toString() const override {
     if (tableBucketNumber.has_value()) {
@@ -19,6 +19,7 @@
 #include "velox/common/base/Fs.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/HivePartitionFunction.h"
+#include "velox/connectors/hive/SortingWriter.h"
 #include "velox/core/ITypedExpr.h"
 #include "velox/dwio/dwrf/writer/Writer.h"
 
@@ -302,8 +303,6 @@ HiveDataSink::HiveDataSink(
                        : nullptr),
       writerFactory_(dwio::common::getWriterFactory(
           insertTableHandle_->tableStorageFormat())) {
-  VELOX_USER_CHECK(
-      !isBucketed() || isPartitioned(), "A bucket table must be partitioned");
   if (isBucketed()) {
     VELOX_USER_CHECK_LT(
         bucketCount_, maxBucketCount(), "bucketCount exceeds the limit");
@@ -316,15 +315,17 @@ HiveDataSink::HiveDataSink(
 }
 
 void HiveDataSink::appendData(RowVectorPtr input) {
-  // Write to unpartitioned table.
-  if (!isPartitioned()) {
+  // Write to unpartitioned and unbucketed table.
+  if (!isPartitioned() && !isBucketed()) {
     const auto index = ensureWriter(HiveWriterId::unpartitionedId());
     writers_[index]->write(input);
     writerInfo_[index]->numWrittenRows += input->size();
     return;
   }
 
-  // Write to partitioned table.
+  // Write to partitioned or bucketed table. The rows are routed to the writer
+  // of their (bucketed) partition, so no local exchange on the bucket columns
+  // is needed in front of the table writer.
   computePartitionAndBucketIds(input);
 
   // Lazy load all the input columns.
@@ -341,7 +342,7 @@ void HiveDataSink::appendData(RowVectorPtr input) {
     return;
   }
 
-  splitInputRowsAndEnsureWriters();
+  splitInputRowsAndEnsureWriters(input->size());
 
   for (auto index = 0; index < writers_.size(); ++index) {
     const vector_size_t partitionSize = partitionSizes_[index];
@@ -358,8 +359,10 @@ void HiveDataSink::appendData(RowVectorPtr input) {
 }
 
 void HiveDataSink::computePartitionAndBucketIds(const RowVectorPtr& input) {
-  VELOX_CHECK(isPartitioned());
-  partitionIdGenerator_->run(input, partitionIds_);
+  VELOX_CHECK(isPartitioned() || isBucketed());
+  if (isPartitioned()) {
+    partitionIdGenerator_->run(input, partitionIds_);
+  }
   if (isBucketed()) {
     bucketFunction_->partition(*input, bucketIds_);
   }
@@ -412,6 +415,33 @@ void HiveDataSink::close() {
   }
 }
 
+bool HiveDataSink::canReclaim() const {
+  return !isSorted();
+}
+
+void HiveDataSink::reclaim(uint64_t targetBytes) {
+  VELOX_CHECK(canReclaim());
+  std::vector<std::pair<int64_t, uint32_t>> writerBytes;
+  writerBytes.reserve(writers_.size());
+  for (auto i = 0; i < writers_.size(); ++i) {
+    writerBytes.emplace_back(writerInfo_[i]->writerPool->currentBytes(), i);
+  }
+  std::sort(writerBytes.begin(), writerBytes.end(), std::greater<>());
+
+  uint64_t reclaimedBytes = 0;
+  for (const auto& [bytes, index] : writerBytes) {
+    if (bytes == 0 || (targetBytes != 0 && reclaimedBytes >= targetBytes)) {
+      break;
+    }
+    writers_[index]->flush();
+    ++writerInfo_[index]->numReclaimFlushes;
+    const auto bytesAfterFlush = writerInfo_[index]->writerPool->currentBytes();
+    if (bytesAfterFlush < bytes) {
+      reclaimedBytes += bytes - bytesAfterFlush;
+    }
+  }
+}
+
 uint32_t HiveDataSink::ensureWriter(const HiveWriterId& id) {
   auto it = writerIndexMap_.find(id);
   if (it != writerIndexMap_.end()) {
@@ -438,22 +468,25 @@ uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
   auto writerParameters = getWriterParameters(partitionName, id.bucketId);
   const auto writePath = fs::path(writerParameters.writeDirectory()) /
       writerParameters.writeFileName();
-  writerInfo_.emplace_back(
-      std::make_shared<HiveWriterInfo>(std::move(writerParameters)));
+  auto* connectorPool = connectorQueryCtx_->connectorMemoryPool();
+  writerInfo_.emplace_back(std::make_shared<HiveWriterInfo>(
+      std::move(writerParameters),
+      connectorPool->addAggregateChild(fmt::format(
+          "{}.writer.{}", connectorPool->name(), writers_.size()))));
 
   dwio::common::WriterOptions options;
   options.schema = inputType_;
-  options.memoryPool = connectorQueryCtx_->connectorMemoryPool();
+  options.memoryPool = writerInfo_.back()->writerPool.get();
   options.compressionKind = insertTableHandle_->compressionKind();
   ioStats_.emplace_back(std::make_shared<dwio::common::IoStatistics>());
-  writers_.emplace_back(writerFactory_->createWriter(
+  writers_.emplace_back(maybeCreateSortingWriter(writerFactory_->createWriter(
       dwio::common::FileSink::create(
           writePath,
           {.bufferWrite = false,
            .pool = connectorQueryCtx_->memoryPool(),
            .metricLogger = dwio::common::MetricsLog::voidLog(),
            .stats = ioStats_.back().get()}),
-      options));
+      options)));
   // Extends the buffer used for partition rows calculations.
   partitionSizes_.emplace_back(0);
   partitionRows_.emplace_back(nullptr);
@@ -463,20 +496,83 @@ uint32_t HiveDataSink::appendWriter(const HiveWriterId& id) {
   return writerIndexMap_[id];
 }
 
-void HiveDataSink::splitInputRowsAndEnsureWriters() {
-  VELOX_CHECK(isPartitioned());
+bool HiveDataSink::isSorted() const {
+  return insertTableHandle_->bucketProperty() != nullptr &&
+      !insertTableHandle_->bucketProperty()->sortedBy().empty();
+}
+
+std::unique_ptr<dwio::common::Writer> HiveDataSink::maybeCreateSortingWriter(
+    std::unique_ptr<dwio::common::Writer> writer) const {
+  if (!isSorted()) {
+    return writer;
+  }
+  const auto& sortedBy = insertTableHandle_->bucketProperty()->sortedBy();
+  std::vector<column_index_t> sortColumnIndices;
+  std::vector<CompareFlags> sortCompareFlags;
+  sortColumnIndices.reserve(sortedBy.size());
+  sortCompareFlags.reserve(sortedBy.size());
+  for (const auto& sortColumn : sortedBy) {
+    const auto channel =
+        inputType_->getChildIdxIfExists(sortColumn->sortColumn());
+    VELOX_USER_CHECK(
+        channel.has_value(),
+        "Sorted-by column {} is not in the table: {}",
+        sortColumn->sortColumn(),
+        inputType_->toString());
+    sortColumnIndices.push_back(channel.value());
+    const auto& sortOrder = sortColumn->sortOrder();
+    sortCompareFlags.push_back(
+        {sortOrder.isNullsFirst(),
+         sortOrder.isAscending(),
+         false,
+         CompareFlags::NullHandlingMode::NoStop});
+  }
+  // The sort buffer is not given a spill config: the rows of each open file are
+  // held in memory until the file is closed.
+  auto sortBuffer = std::make_unique<exec::SortBuffer>(
+      inputType_,
+      sortColumnIndices,
+      sortCompareFlags,
+      connectorQueryCtx_->memoryPool());
+  return std::make_unique<SortingWriter>(
+      std::move(writer),
+      std::move(sortBuffer),
+      HiveConfig::sortWriterMaxOutputRows(connectorQueryCtx_->config()));
+}
+
+uint32_t HiveDataSink::writerIndex(vector_size_t row) {
+  uint32_t partitionId{0};
+  if (isPartitioned()) {
+    VELOX_CHECK_LT(partitionIds_[row], std::numeric_limits<uint32_t>::max());
+    partitionId = static_cast<uint32_t>(partitionIds_[row]);
+  }
+  const uint32_t bucketId = isBucketed() ? bucketIds_[row] : 0;
+  const size_t key =
+      static_cast<size_t>(partitionId) * std::max(bucketCount_, 1) + bucketId;
+  if (FOLLY_UNLIKELY(key >= writerIndices_.size())) {
+    writerIndices_.resize(
+        std::max(key + 1, 2 * writerIndices_.size()), kNoWriter);
+  }
+  if (FOLLY_UNLIKELY(writerIndices_[key] == kNoWriter)) {
+    writerIndices_[key] = ensureWriter(
+        isBucketed() ? HiveWriterId{partitionId, bucketId}
+                     : HiveWriterId{partitionId});
+  }
+  return writerIndices_[key];
+}
+
+void HiveDataSink::splitInputRowsAndEnsureWriters(vector_size_t numRows) {
+  VELOX_CHECK(isPartitioned() || isBucketed());
+  if (isPartitioned()) {
+    VELOX_CHECK_EQ(partitionIds_.size(), numRows);
+  }
   if (isBucketed()) {
-    VELOX_CHECK_EQ(bucketIds_.size(), partitionIds_.size());
+    VELOX_CHECK_EQ(bucketIds_.size(), numRows);
   }
   std::fill(partitionSizes_.begin(), partitionSizes_.end(), 0);
 
-  const auto numRows = partitionIds_.size();
   for (auto row = 0; row < numRows; ++row) {
-    VELOX_CHECK_LT(partitionIds_[row], std::numeric_limits<uint32_t>::max());
-    const uint32_t partitionId = static_cast<uint32_t>(partitionIds_[row]);
-    const auto id = isBucketed() ? HiveWriterId{partitionId, bucketIds_[row]}
-                                 : HiveWriterId{partitionId};
-    const uint32_t index = ensureWriter(id);
+    const uint32_t index = writerIndex(row);
     VELOX_DCHECK_LT(index, partitionSizes_.size());
     VELOX_DCHECK_EQ(partitionSizes_.size(), partitionRows_.size());
     VELOX_DCHECK_EQ(partitionRows_.size(), rawPartitionRows_.size());
@@ -339,11 +339,19 @@ class HiveWriterParameters {
 };
 
 struct HiveWriterInfo {
-  explicit HiveWriterInfo(HiveWriterParameters parameters)
-      : writerParameters(std::move(parameters)) {}
+  HiveWriterInfo(
+      HiveWriterParameters parameters,
+      std::shared_ptr<memory::MemoryPool> _writerPool)
+      : writerParameters(std::move(parameters)),
+        writerPool(std::move(_writerPool)) {}
 
   const HiveWriterParameters writerParameters;
+  /// The memory pool of the file writer. Used to pick the writers that free
+  /// the most memory on reclaim.
+  const std::shared_ptr<memory::MemoryPool> writerPool;
   int64_t numWrittenRows = 0;
+  /// Number of times the writer was flushed early to reclaim memory.
+  int64_t numReclaimFlushes = 0;
 };
 
 /// Identifies a hive writer.
@@ -405,6 +413,14 @@ class HiveDataSink : public DataSink {
 
   void close() override;
 
+  /// The buffered data of the file writers can be flushed early unless the
+  /// rows of a file are sorted, which needs all of them before writing.
+  bool canReclaim() const override;
+
+  /// Flushes the buffered stripes of the writers in decreasing order of their
+  /// memory usage until 'targetBytes' are freed.
+  void reclaim(uint64_t targetBytes) override;
+
  private:
   // Returns true if the table is partitioned.
   FOLLY_ALWAYS_INLINE bool isPartitioned() const {
@@ -427,7 +443,12 @@ class HiveDataSink : public DataSink {
   // to each corresponding (bucketed) partition based on the partition and
   // bucket ids calculated by 'computePartitionAndBucketIds'. The function also
   // ensures that there is a writer created for each (bucketed) partition.
-  void splitInputRowsAndEnsureWriters();
+  void splitInputRowsAndEnsureWriters(vector_size_t numRows);
+
+  // Returns the index in 'writers_' of the writer of 'row' and creates the
+  // writer if needed. Looks the writer up in 'writerIndices_' by the partition
+  // and bucket ids of the row instead of hashing its writer id.
+  uint32_t writerIndex(vector_size_t row);
 
   // Makes sure to create one writer for the given writer id. The function
   // returns the corresponding index in 'writers_'.
@@ -437,6 +458,15 @@ class HiveDataSink : public DataSink {
   // the newly created writer in 'writers_'.
   uint32_t appendWriter(const HiveWriterId& id);
 
+  // Returns true if the rows of each file are sorted on the sorted-by columns
+  // of the bucket property.
+  bool isSorted() const;
+
+  // Wraps 'writer' in a writer that sorts the rows on the sorted-by columns
+  // before writing them.
+  std::unique_ptr<dwio::common::Writer> maybeCreateSortingWriter(
+      std::unique_ptr<dwio::common::Writer> writer) const;
+
   HiveWriterParameters getWriterParameters(
       const std::optional<std::string>& partition,
       std::optional<uint32_t> bucketId) const;
@@ -485,6 +515,13 @@ class HiveDataSink : public DataSink {
 
   // Reusable buffers for bucket id calculations.
   std::vector<uint32_t> bucketIds_;
+
+  static constexpr uint32_t kNoWriter = std::numeric_limits<uint32_t>::max();
+
+  // The writer index of each (partition id, bucket id) at partition id *
+  // bucket count + bucket id, or kNoWriter if there is no writer yet. Grows
+  // with the number of partitions.
+  std::vector<uint32_t> writerIndices_;
 };
 
 } // namespace facebook::velox::connector::hive
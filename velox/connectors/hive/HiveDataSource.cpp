@@ -16,10 +16,12 @@
 
 #include "velox/connectors/hive/HiveDataSource.h"
 
+#include <cmath>
 #include <string>
 #include <unordered_map>
 
 #include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/caching/SsdCache.h"
 #include "velox/dwio/common/CachedBufferedInput.h"
 #include "velox/dwio/common/ReaderFactory.h"
 #include "velox/expression/ExprToSubfieldFilter.h"
@@ -204,14 +206,76 @@ void addSubfields(
   }
 }
 
-bool testFilters(
+// Returns false if no row of a split with 'partitionKey' values passes the
+// filters of 'scanSpec' on the partition keys. Needs no access to the file.
+bool testPartitionFilters(
     common::ScanSpec* scanSpec,
-    dwio::common::Reader* reader,
-    const std::string& filePath,
     const std::unordered_map<std::string, std::optional<std::string>>&
         partitionKey,
     std::unordered_map<std::string, std::shared_ptr<HiveColumnHandle>>&
         partitionKeysHandle) {
+  for (const auto& child : scanSpec->children()) {
+    if (!child->filter()) {
+      continue;
+    }
+    auto iter = partitionKey.find(child->fieldName());
+    if (iter == partitionKey.end()) {
+      continue;
+    }
+    if (!iter->second.has_value()) {
+      if (child->filter()->isDeterministic() &&
+          !child->filter()->testNull()) {
+        return false;
+      }
+    } else if (!applyPartitionFilter(
+                   partitionKeysHandle[child->fieldName()]->dataType()->kind(),
+                   iter->second.value(),
+                   child->filter())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns false if the statistics of the file of 'fileHandle' kept from
+// earlier splits show that no row passes the filters of 'scanSpec'. Columns
+// without kept statistics pass.
+bool testCachedStatistics(
+    common::ScanSpec* scanSpec,
+    const FileHandle& fileHandle) {
+  auto statistics = fileHandle.statistics.rlock();
+  if (!statistics->numRows.has_value()) {
+    return true;
+  }
+  for (const auto& child : scanSpec->children()) {
+    if (!child->filter()) {
+      continue;
+    }
+    auto it = statistics->columns.find(child->fieldName());
+    if (it != statistics->columns.end() && it->second.statistics &&
+        !testFilter(
+            child->filter(),
+            it->second.statistics.get(),
+            statistics->numRows.value(),
+            it->second.type)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns false if the statistics in the footer of the file of 'reader' show
+// that no row passes the filters of 'scanSpec'. Adds the statistics of the
+// filtered columns to 'fileHandle' for testCachedStatistics() of later
+// splits of the file. Filters on partition keys are tested by
+// testPartitionFilters().
+bool testFilters(
+    common::ScanSpec* scanSpec,
+    dwio::common::Reader* reader,
+    FileHandle& fileHandle,
+    const std::string& filePath,
+    const std::unordered_map<std::string, std::optional<std::string>>&
+        partitionKey) {
   auto totalRows = reader->numberOfRows();
   const auto& fileTypeWithId = reader->typeWithId();
   const auto& rowType = reader->rowType();
@@ -219,13 +283,8 @@ bool testFilters(
     if (child->filter()) {
       const auto& name = child->fieldName();
       if (!rowType->containsChild(name)) {
-        // If missing column is partition key.
-        auto iter = partitionKey.find(name);
-        if (iter != partitionKey.end() && iter->second.has_value()) {
-          return applyPartitionFilter(
-              partitionKeysHandle[name]->dataType()->kind(),
-              iter->second.value(),
-              child->filter());
+        if (partitionKey.count(name) > 0) {
+          continue;
         }
         // Column is missing. Most likely due to schema evolution.
         if (child->filter()->isDeterministic() &&
@@ -234,7 +293,13 @@ bool testFilters(
         }
       } else {
         const auto& typeWithId = fileTypeWithId->childByName(name);
-        auto columnStats = reader->columnStatistics(typeWithId->id());
+        std::shared_ptr<dwio::common::ColumnStatistics> columnStats =
+            reader->columnStatistics(typeWithId->id());
+        {
+          auto statistics = fileHandle.statistics.wlock();
+          statistics->numRows = totalRows;
+          statistics->columns[name] = {typeWithId->type(), columnStats};
+        }
         if (columnStats != nullptr &&
             !testFilter(
                 child->filter(),
@@ -253,6 +318,29 @@ bool testFilters(
   return true;
 }
 
+// Returns true if a column of 'fileType' in a file of 'format' is read as
+// 'outputType' by reading each field of 'outputType' from the key of the same
+// name of a DWRF flat map. The file must write the column as a flat map.
+bool readsMapAsStruct(
+    dwio::common::FileFormat format,
+    const Type& fileType,
+    const Type& outputType) {
+  if (format != dwio::common::FileFormat::DWRF || !fileType.isMap() ||
+      !outputType.isRow() || outputType.size() == 0) {
+    return false;
+  }
+  auto& mapType = fileType.asMap();
+  if (!mapType.keyType()->isVarchar() && !mapType.keyType()->isVarbinary()) {
+    return false;
+  }
+  for (auto& child : outputType.asRow().children()) {
+    if (!child->equivalent(*mapType.valueType())) {
+      return false;
+    }
+  }
+  return true;
+}
+
 template <TypeKind ToKind>
 velox::variant convertFromString(const std::optional<std::string>& value) {
   if (value.has_value()) {
@@ -334,6 +422,38 @@ const std::string& getColumnName(const common::Subfield& subfield) {
   return field->name();
 }
 
+// Adds the position of a filter in the evaluation order, its rows in and out
+// and its time per dropped row to 'stats'.
+void addFilterStats(
+    const std::string& prefix,
+    int32_t rank,
+    const SelectivityInfo& selectivity,
+    std::unordered_map<std::string, RuntimeCounter>& stats) {
+  stats.insert(
+      {{prefix + ".rank", RuntimeCounter(rank)},
+       {prefix + ".rowsIn", RuntimeCounter(selectivity.numIn())},
+       {prefix + ".rowsOut", RuntimeCounter(selectivity.numOut())},
+       {prefix + ".clocksPerDroppedRow",
+        RuntimeCounter(std::llround(selectivity.timeToDropValue()))}});
+}
+// Returns true if the statistics of integers answer min and max of 'type'.
+bool hasIntegerStatistics(const Type& type) {
+  switch (type.kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+      return !type.isDecimal();
+    default:
+      return false;
+  }
+}
+
+template <TypeKind Kind>
+void setIntegerValue(BaseVector& vector, int64_t value) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  vector.asFlatVector<T>()->set(0, value);
+}
 } // namespace
 
 core::TypedExprPtr HiveDataSource::extractFiltersFromRemainingFilter(
@@ -419,11 +539,37 @@ HiveDataSource::HiveDataSource(
     }
   }
 
+  auto hiveTableHandle =
+      std::dynamic_pointer_cast<HiveTableHandle>(tableHandle);
+  VELOX_CHECK(
+      hiveTableHandle != nullptr,
+      "TableHandle must be an instance of HiveTableHandle");
+  statsAggregates_ = hiveTableHandle->statsAggregates();
+
   std::vector<std::string> readerRowNames;
-  auto readerRowTypes = outputType_->children();
+  std::vector<TypePtr> readerRowTypes;
   folly::F14FastMap<std::string, std::vector<const common::Subfield*>>
       subfields;
-  for (auto& outputName : outputType->names()) {
+  for (auto i = 0; i < outputType->size(); ++i) {
+    const auto& outputName = outputType->nameOf(i);
+    if (auto it = statsAggregates_.find(outputName);
+        it != statsAggregates_.end()) {
+      // The aggregated columns are read when the statistics of a split do
+      // not answer the aggregates.
+      statsPartitionKeys_.emplace_back();
+      const auto& column = it->second.column;
+      if (!column.empty() &&
+          std::find(readerRowNames.begin(), readerRowNames.end(), column) ==
+              readerRowNames.end()) {
+        VELOX_USER_CHECK_NOT_NULL(
+            hiveTableHandle->dataColumns(),
+            "Aggregates from file statistics require the data columns");
+        readerRowNames.push_back(column);
+        readerRowTypes.push_back(
+            hiveTableHandle->dataColumns()->findChild(column));
+      }
+      continue;
+    }
     auto it = columnHandles.find(outputName);
     VELOX_CHECK(
         it != columnHandles.end(),
@@ -431,7 +577,16 @@ HiveDataSource::HiveDataSource(
         outputName);
 
     auto* handle = static_cast<const HiveColumnHandle*>(it->second.get());
+    VELOX_USER_CHECK(
+        statsAggregates_.empty() || handle->isPartitionKey(),
+        "Aggregates from file statistics allow only partition keys next to "
+        "the aggregates: {}",
+        outputName);
+    if (!statsAggregates_.empty()) {
+      statsPartitionKeys_.push_back(handle->name());
+    }
     readerRowNames.push_back(handle->name());
+    readerRowTypes.push_back(outputType->childAt(i));
     for (auto& subfield : handle->requiredSubfields()) {
       VELOX_USER_CHECK_EQ(
           getColumnName(subfield),
@@ -440,12 +595,6 @@ HiveDataSource::HiveDataSource(
       subfields[handle->name()].push_back(&subfield);
     }
   }
-
-  auto hiveTableHandle =
-      std::dynamic_pointer_cast<HiveTableHandle>(tableHandle);
-  VELOX_CHECK(
-      hiveTableHandle != nullptr,
-      "TableHandle must be an instance of HiveTableHandle");
   if (readerOpts_.isFileColumnNamesReadAsLowerCase()) {
     checkColumnNameLowerCase(outputType);
     checkColumnNameLowerCase(hiveTableHandle->subfieldFilters());
@@ -487,6 +636,19 @@ HiveDataSource::HiveDataSource(
     }
     remainingFilter = hiveTableHandle->remainingFilter();
   }
+  if (!statsAggregates_.empty()) {
+    VELOX_USER_CHECK_NULL(
+        remainingFilter,
+        "Aggregates from file statistics do not allow a remaining filter");
+    for (auto& [field, _] : filters) {
+      VELOX_USER_CHECK(
+          field.path().size() == 1 &&
+              partitionKeys_.count(getColumnName(field)) > 0,
+          "Aggregates from file statistics allow filters on partition keys "
+          "only: {}",
+          field.toString());
+    }
+  }
 
   std::vector<common::Subfield> remainingFilterSubfields;
   if (remainingFilter) {
@@ -528,6 +690,8 @@ HiveDataSource::HiveDataSource(
   }
 
   readerOpts_.setFileSchema(hiveTableHandle->dataColumns());
+  readerOpts_.setFileMetadataCache(
+      dwio::common::FileMetadataCache::getInstance());
   rowReaderOpts_.setScanSpec(scanSpec_);
   rowReaderOpts_.setMetadataFilter(metadataFilter_);
 
@@ -542,8 +706,30 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
   VELOX_CHECK(split_, "Wrong type of split");
 
   VLOG(1) << "Adding split " << split_->toString();
+  deleteFileReaders_.clear();
+  statsAggregatesRow_.reset();
+  readsStatsAggregateRows_ = false;
+  if (rowLimit_ == 0) {
+    // The consumer needs no more rows. The file is not opened.
+    emptySplit_ = true;
+    return;
+  }
+
+  // Filters, also the ones added by addDynamicFilter(), are tested against
+  // the partition keys and the statistics kept from earlier splits of the
+  // file before the footer of the file is read.
+  if (!testPartitionFilters(
+          scanSpec_.get(), split_->partitionKeys, partitionKeys_)) {
+    skipSplitBeforeOpen();
+    return;
+  }
 
   fileHandle_ = fileHandleFactory_->generate(split_->filePath).second;
+  if (!testCachedStatistics(scanSpec_.get(), *fileHandle_)) {
+    skipSplitBeforeOpen();
+    return;
+  }
+
   auto input = createBufferedInput(*fileHandle_, readerOpts_);
 
   if (readerOpts_.getFileFormat() != dwio::common::FileFormat::UNKNOWN) {
@@ -569,18 +755,30 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
   if (!testFilters(
           scanSpec_.get(),
           reader_.get(),
+          *fileHandle_,
           split_->filePath,
-          split_->partitionKeys,
-          partitionKeys_)) {
+          split_->partitionKeys)) {
     emptySplit_ = true;
     ++runtimeStats_.skippedSplits;
     runtimeStats_.skippedSplitBytes += split_->length;
     return;
   }
 
+  if (!statsAggregates_.empty()) {
+    statsAggregatesRow_ = statsAggregatesFromFile();
+    if (statsAggregatesRow_) {
+      ++numStatsAggregatedSplits_;
+      return;
+    }
+    statsAggregatesRow_ = makeStatsAggregatesRow();
+    readsStatsAggregateRows_ = true;
+  }
+
   auto& fileType = reader_->rowType();
 
   std::vector<TypePtr> columnTypes = fileType->children();
+  // Map columns read as structs of their keys, with the names of the keys.
+  std::unordered_map<std::string, std::vector<std::string>> mapsAsStruct;
   for (int i = 0; i < readerOutputType_->size(); i++) {
     auto fieldName = readerOutputType_->nameOf(i);
     auto scanChildSpec = scanSpec_->childByName(fieldName);
@@ -603,9 +801,18 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
       setNullConstantValue(scanChildSpec, readerOutputType_->childAt(i));
     } else {
       // We know the fieldName exists in the file, make the type at that
-      // position match what we expect in the output.
-      columnTypes[fileType->getChildIdx(fieldName)] =
-          readerOutputType_->childAt(i);
+      // position match what we expect in the output. A flat map read as a
+      // struct keeps its file type and the reader makes a flat child per key.
+      const auto fileIndex = fileType->getChildIdx(fieldName);
+      const auto& outputType = readerOutputType_->childAt(i);
+      if (readsMapAsStruct(
+              readerOpts_.getFileFormat(),
+              *fileType->childAt(fileIndex),
+              *outputType)) {
+        mapsAsStruct[fieldName] = outputType->asRow().names();
+      } else {
+        columnTypes[fileIndex] = outputType;
+      }
       scanChildSpec->setConstantValue(nullptr);
     }
   }
@@ -632,10 +839,200 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
         velox::variant(split_->tableBucketNumber.value()));
   }
   scanSpec_->resetCachedValues(false);
-  configureRowReaderOptions(
-      rowReaderOpts_,
-      ROW(std::vector<std::string>(fileType->names()), std::move(columnTypes)));
+  auto requestedType =
+      ROW(std::vector<std::string>(fileType->names()), std::move(columnTypes));
+  // The readers look up flat maps to read as structs by their node id in the
+  // requested type.
+  std::unordered_map<uint32_t, std::vector<std::string>> flatMapNodeIds;
+  if (!mapsAsStruct.empty()) {
+    auto requestedTypeWithId = dwio::common::TypeWithId::create(requestedType);
+    for (auto& [name, keys] : mapsAsStruct) {
+      flatMapNodeIds[requestedTypeWithId->childByName(name)->id()] =
+          std::move(keys);
+    }
+  }
+  rowReaderOpts_.setFlatmapNodeIdsAsStruct(std::move(flatMapNodeIds));
+  configureRowReaderOptions(rowReaderOpts_, requestedType);
   rowReader_ = createRowReader(rowReaderOpts_);
+
+  for (const auto& deleteFile : split_->deleteFiles) {
+    deleteFileReaders_.push_back(std::make_unique<PositionalDeleteFileReader>(
+        deleteFile, fileHandleFactory_, pool_));
+  }
+}
+
+uint64_t HiveDataSource::readNextWithDeletes(uint64_t size) {
+  const auto rowsToRead = rowReader_->nextReadSize(size);
+  if (rowsToRead == dwio::common::RowReader::kAtEnd) {
+    return 0;
+  }
+  const auto baseRow = rowReader_->nextRowNumber();
+  const auto numWords = bits::nwords(rowsToRead);
+  if (deletedRows_ == nullptr ||
+      deletedRows_->capacity() < numWords * sizeof(uint64_t)) {
+    deletedRows_ = AlignedBuffer::allocate<uint64_t>(numWords, pool_);
+  }
+  auto* rawDeletedRows = deletedRows_->asMutable<uint64_t>();
+  std::fill_n(rawDeletedRows, numWords, 0);
+  // The deletes of all the files are merged into one bit mask.
+  for (auto& reader : deleteFileReaders_) {
+    reader->readDeletedRows(baseRow, rowsToRead, rawDeletedRows);
+  }
+  dwio::common::Mutation mutation;
+  mutation.deletedRows = rawDeletedRows;
+  return rowReader_->next(rowsToRead, output_, &mutation);
+}
+
+RowVectorPtr HiveDataSource::makeStatsAggregatesRow() const {
+  std::vector<VectorPtr> columns;
+  columns.reserve(outputType_->size());
+  for (auto i = 0; i < outputType_->size(); ++i) {
+    const auto& type = outputType_->childAt(i);
+    auto it = statsAggregates_.find(outputType_->nameOf(i));
+    if (it == statsAggregates_.end()) {
+      const auto& partitionKey = statsPartitionKeys_[i];
+      auto valueIt = split_->partitionKeys.find(partitionKey);
+      VELOX_CHECK(
+          valueIt != split_->partitionKeys.end(),
+          "Partition key {} is missing in split {}",
+          partitionKey,
+          split_->filePath);
+      columns.push_back(partitionValue(partitionKey, valueIt->second));
+    } else if (it->second.kind == HiveStatsAggregate::Kind::kCount) {
+      auto count = BaseVector::create<FlatVector<int64_t>>(BIGINT(), 1, pool_);
+      count->set(0, 0);
+      columns.push_back(std::move(count));
+    } else {
+      columns.push_back(BaseVector::create(type, 1, pool_));
+      columns.back()->setNull(0, true);
+    }
+  }
+  return std::make_shared<RowVector>(
+      pool_, outputType_, nullptr, 1, std::move(columns));
+}
+
+RowVectorPtr HiveDataSource::statsAggregatesFromFile() const {
+  // File statistics do not answer the aggregates of a part of the file or of
+  // the rows left after deletes.
+  if (!split_->deleteFiles.empty() || split_->start > 0 ||
+      split_->start + split_->length < fileHandle_->file->size()) {
+    return nullptr;
+  }
+  const auto numRows = reader_->numberOfRows();
+  if (!numRows.has_value()) {
+    return nullptr;
+  }
+  auto row = makeStatsAggregatesRow();
+  const auto& fileType = reader_->typeWithId();
+  for (auto i = 0; i < outputType_->size(); ++i) {
+    auto it = statsAggregates_.find(outputType_->nameOf(i));
+    if (it == statsAggregates_.end()) {
+      continue;
+    }
+    const auto& aggregate = it->second;
+    auto& result = row->childAt(i);
+    if (aggregate.column.empty()) {
+      result->asFlatVector<int64_t>()->set(0, numRows.value());
+      continue;
+    }
+    if (!reader_->rowType()->containsChild(aggregate.column)) {
+      // A column missing in the file is all nulls.
+      continue;
+    }
+    const auto nodeId = fileType->childByName(aggregate.column)->id();
+    auto stats = reader_->columnStatistics(nodeId);
+    if (!stats) {
+      return nullptr;
+    }
+    const auto numValues = stats->getNumberOfValues();
+    if (aggregate.kind == HiveStatsAggregate::Kind::kCount) {
+      if (!numValues.has_value()) {
+        return nullptr;
+      }
+      result->asFlatVector<int64_t>()->set(0, numValues.value());
+      continue;
+    }
+    if (numValues == 0) {
+      continue;
+    }
+    auto* integerStats =
+        dynamic_cast<const dwio::common::IntegerColumnStatistics*>(
+            stats.get());
+    if (!integerStats || !hasIntegerStatistics(*result->type())) {
+      return nullptr;
+    }
+    const auto value = aggregate.kind == HiveStatsAggregate::Kind::kMin
+        ? integerStats->getMinimum()
+        : integerStats->getMaximum();
+    if (!value.has_value()) {
+      return nullptr;
+    }
+    VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+        setIntegerValue, result->typeKind(), *result, value.value());
+  }
+  return row;
+}
+
+void HiveDataSource::addRowsToStatsAggregates() {
+  auto* rows = output_->asUnchecked<RowVector>();
+  const auto numRows = rows->size();
+  for (auto i = 0; i < outputType_->size(); ++i) {
+    auto it = statsAggregates_.find(outputType_->nameOf(i));
+    if (it == statsAggregates_.end()) {
+      continue;
+    }
+    const auto& aggregate = it->second;
+    auto& result = statsAggregatesRow_->childAt(i);
+    if (aggregate.column.empty()) {
+      auto* count = result->asFlatVector<int64_t>();
+      count->set(0, count->valueAt(0) + numRows);
+      continue;
+    }
+    const auto* values =
+        rows->childAt(readerOutputType_->getChildIdx(aggregate.column))
+            ->loadedVector();
+    if (aggregate.kind == HiveStatsAggregate::Kind::kCount) {
+      auto* count = result->asFlatVector<int64_t>();
+      int64_t numValues = 0;
+      for (vector_size_t row = 0; row < numRows; ++row) {
+        numValues += !values->isNullAt(row);
+      }
+      count->set(0, count->valueAt(0) + numValues);
+      continue;
+    }
+    const auto sign = aggregate.kind == HiveStatsAggregate::Kind::kMin ? 1 : -1;
+    for (vector_size_t row = 0; row < numRows; ++row) {
+      if (values->isNullAt(row)) {
+        continue;
+      }
+      if (result->isNullAt(0) ||
+          sign * values->compare(result.get(), row, 0, {}).value() < 0) {
+        result->copy(values, 0, row, 1);
+      }
+    }
+  }
+}
+
+std::optional<RowVectorPtr> HiveDataSource::nextStatsAggregates(
+    uint64_t size) {
+  if (readsStatsAggregateRows_) {
+    if (!output_) {
+      output_ = BaseVector::create(readerOutputType_, 0, pool_);
+    }
+    const auto rowsScanned = readNext(size);
+    completedRows_ += rowsScanned;
+    if (rowsScanned > 0) {
+      addRowsToStatsAggregates();
+      return RowVector::createEmpty(outputType_, pool_);
+    }
+    rowReader_->updateRuntimeStats(runtimeStats_);
+    readsStatsAggregateRows_ = false;
+  }
+  if (statsAggregatesRow_) {
+    return std::move(statsAggregatesRow_);
+  }
+  resetSplit();
+  return nullptr;
 }
 
 std::optional<RowVectorPtr> HiveDataSource::next(
@@ -647,6 +1044,19 @@ std::optional<RowVectorPtr> HiveDataSource::next(
     return nullptr;
   }
 
+  if (!statsAggregates_.empty()) {
+    return nextStatsAggregates(size);
+  }
+
+  if (rowLimit_.has_value()) {
+    if (rowLimit_.value() == 0) {
+      rowReader_->updateRuntimeStats(runtimeStats_);
+      resetSplit();
+      return nullptr;
+    }
+    size = std::min(size, rowLimit_.value());
+  }
+
   if (!output_) {
     output_ = BaseVector::create(readerOutputType_, 0, pool_);
   }
@@ -688,6 +1098,11 @@ std::optional<RowVectorPtr> HiveDataSource::next(
       }
     }
 
+    if (rowLimit_.has_value()) {
+      rowLimit_ = rowLimit_.value() -
+          std::min<uint64_t>(rowsRemaining, rowLimit_.value());
+    }
+
     if (outputType_->size() == 0) {
       return exec::wrap(rowsRemaining, remainingIndices, rowVector);
     }
@@ -755,6 +1170,32 @@ std::unordered_map<std::string, RuntimeCounter> HiveDataSource::runtimeStats() {
             ioStats_->rawOverreadBytes(), RuntimeCounter::Unit::kBytes)},
        {"queryThreadIoLatency",
         RuntimeCounter(ioStats_->queryThreadIoLatency().count())}});
+  // The position of each filter in the evaluation order and its time per
+  // dropped row, which the order is based on. The remaining filter is always
+  // evaluated after the pushed down filters.
+  int32_t rank = 0;
+  for (const auto& child : scanSpec_->children()) {
+    if (!child->hasFilter()) {
+      continue;
+    }
+    addFilterStats(
+        fmt::format("filter.{}", child->fieldName()),
+        rank++,
+        child->selectivity(),
+        res);
+  }
+  if (remainingFilterExprSet_) {
+    addFilterStats("remainingFilter", rank, remainingFilterSelectivity_, res);
+  }
+  if (!statsAggregates_.empty()) {
+    res.insert(
+        {"statsAggregatedSplits", RuntimeCounter(numStatsAggregatedSplits_)});
+  }
+  if (numSplitsSkippedBeforeOpen_ > 0) {
+    res.insert(
+        {"skippedSplitsBeforeOpen",
+         RuntimeCounter(numSplitsSkippedBeforeOpen_)});
+  }
   return res;
 }
 
@@ -764,6 +1205,10 @@ void HiveDataSource::setFromDataSource(
   VELOX_CHECK(source, "Bad DataSource type");
   emptySplit_ = source->emptySplit_;
   split_ = std::move(source->split_);
+  statsAggregatesRow_ = std::move(source->statsAggregatesRow_);
+  readsStatsAggregateRows_ = source->readsStatsAggregateRows_;
+  numStatsAggregatedSplits_ += source->numStatsAggregatedSplits_;
+  numSplitsSkippedBeforeOpen_ += source->numSplitsSkippedBeforeOpen_;
   if (emptySplit_) {
     return;
   }
@@ -771,12 +1216,20 @@ void HiveDataSource::setFromDataSource(
   scanSpec_ = std::move(source->scanSpec_);
   reader_ = std::move(source->reader_);
   rowReader_ = std::move(source->rowReader_);
+  deleteFileReaders_ = std::move(source->deleteFileReaders_);
   // New io will be accounted on the stats of 'source'. Add the existing
   // balance to that.
   source->ioStats_->merge(*ioStats_);
   ioStats_ = std::move(source->ioStats_);
 }
 
+void HiveDataSource::setRowLimit(uint64_t limit) {
+  rowLimit_ = limit;
+  // The rows after the limit are not needed. The next stripe is not read
+  // ahead while decoding the current one.
+  rowReaderOpts_.setMaxPrefetchStripeBytes(0);
+}
+
 int64_t HiveDataSource::estimatedRowSize() {
   if (!rowReader_) {
     return kUnknownRowSize;
@@ -866,12 +1319,16 @@ HiveDataSource::createBufferedInput(
     const FileHandle& fileHandle,
     const dwio::common::ReaderOptions& readerOpts) {
   if (cache_) {
+    auto* ssdCache = cache_->ssdCache();
     return std::make_unique<dwio::common::CachedBufferedInput>(
         fileHandle.file,
         dwio::common::MetricsLog::voidLog(),
         fileHandle.uuid.id(),
         cache_,
-        Connector::getTracker(scanId_, readerOpts.loadQuantum()),
+        Connector::getTracker(
+            scanId_,
+            readerOpts.loadQuantum(),
+            ssdCache ? &ssdCache->groupStats() : nullptr),
         fileHandle.groupId.id(),
         ioStats_,
         executor_,
@@ -887,10 +1344,13 @@ HiveDataSource::createBufferedInput(
 vector_size_t HiveDataSource::evaluateRemainingFilter(RowVectorPtr& rowVector) {
   filterRows_.resize(output_->size());
 
+  SelectivityTimer timer(remainingFilterSelectivity_, output_->size());
   expressionEvaluator_->evaluate(
       remainingFilterExprSet_.get(), filterRows_, *rowVector, filterResult_);
-  return exec::processFilterResults(
+  auto numPassed = exec::processFilterResults(
       filterResult_, filterRows_, filterEvalCtx_, pool_);
+  remainingFilterSelectivity_.addOutput(numPassed);
+  return numPassed;
 }
 
 void HiveDataSource::setConstantValue(
@@ -906,8 +1366,7 @@ void HiveDataSource::setNullConstantValue(
   spec->setConstantValue(BaseVector::createNullConstant(type, 1, pool_));
 }
 
-void HiveDataSource::setPartitionValue(
-    common::ScanSpec* spec,
+VectorPtr HiveDataSource::partitionValue(
     const std::string& partitionKey,
     const std::optional<std::string>& value) const {
   auto it = partitionKeys_.find(partitionKey);
@@ -917,7 +1376,24 @@ void HiveDataSource::setPartitionValue(
       partitionKey);
   auto constValue = VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
       convertFromString, it->second->dataType()->kind(), value);
-  setConstantValue(spec, it->second->dataType(), constValue);
+  return BaseVector::createConstant(
+      it->second->dataType(), constValue, 1, pool_);
+}
+
+void HiveDataSource::setPartitionValue(
+    common::ScanSpec* spec,
+    const std::string& partitionKey,
+    const std::optional<std::string>& value) const {
+  spec->setConstantValue(partitionValue(partitionKey, value));
+}
+
+void HiveDataSource::skipSplitBeforeOpen() {
+  VLOG(1) << "Skipping " << split_->filePath
+          << " based on partition keys or cached file statistics";
+  emptySplit_ = true;
+  ++runtimeStats_.skippedSplits;
+  runtimeStats_.skippedSplitBytes += split_->length;
+  ++numSplitsSkippedBeforeOpen_;
 }
 
 void HiveDataSource::resetSplit() {
@@ -18,6 +18,7 @@
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/FileHandle.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
+#include "velox/connectors/hive/PositionalDeleteFileReader.h"
 #include "velox/connectors/hive/TableHandle.h"
 #include "velox/dwio/common/BufferedInput.h"
 #include "velox/dwio/common/Reader.h"
@@ -69,6 +70,8 @@ class HiveDataSource : public DataSource {
 
   int64_t estimatedRowSize() override;
 
+  void setRowLimit(uint64_t limit) override;
+
   // Internal API, made public to be accessible in unit tests.  Do not use in
   // other places.
   static std::shared_ptr<common::ScanSpec> makeScanSpec(
@@ -90,6 +93,9 @@ class HiveDataSource : public DataSource {
 
  protected:
   virtual uint64_t readNext(uint64_t size) {
+    if (!deleteFileReaders_.empty()) {
+      return readNextWithDeletes(size);
+    }
     return rowReader_->next(size, output_);
   }
 
@@ -126,11 +132,36 @@ class HiveDataSource : public DataSource {
       common::ScanSpec* FOLLY_NONNULL spec,
       const TypePtr& type) const;
 
+  // Returns 'value' of 'partitionKey' as a constant vector of 1 row.
+  VectorPtr partitionValue(
+      const std::string& partitionKey,
+      const std::optional<std::string>& value) const;
+
   void setPartitionValue(
       common::ScanSpec* FOLLY_NONNULL spec,
       const std::string& partitionKey,
       const std::optional<std::string>& value) const;
 
+  // Returns a row of 'outputType_' with the partition keys of the split,
+  // counts of 0 and null minima and maxima.
+  RowVectorPtr makeStatsAggregatesRow() const;
+
+  // Returns the row of the aggregates of the split from the statistics of the
+  // file, or nullptr if the statistics do not answer all aggregates.
+  RowVectorPtr statsAggregatesFromFile() const;
+
+  // Adds the rows in 'output_' to 'statsAggregatesRow_'.
+  void addRowsToStatsAggregates();
+
+  // next() for a table handle with stats aggregates. Returns empty results
+  // while reading the rows of a split whose aggregates are not answered by
+  // the statistics, then the row of aggregates.
+  std::optional<RowVectorPtr> nextStatsAggregates(uint64_t size);
+
+  // Marks the current split as empty and counts it in the runtime stats when
+  // its filters exclude it before the file footer is read.
+  void skipSplitBeforeOpen();
+
   // Clear split_ after split has been fully processed.  Keep readers around to
   // hold adaptation.
   void resetSplit();
@@ -139,6 +170,11 @@ class HiveDataSource : public DataSource {
       dwio::common::RowReaderOptions&,
       const RowTypePtr& rowType) const;
 
+  // Reads the next batch of up to 'size' rows without the rows deleted by the
+  // delete files of the split. Returns the number of rows scanned, including
+  // the deleted ones.
+  uint64_t readNextWithDeletes(uint64_t size);
+
   const RowTypePtr outputType_;
   // Column handles for the partition key columns keyed on partition key column
   // name.
@@ -150,14 +186,42 @@ class HiveDataSource : public DataSource {
   dwio::common::RowReaderOptions rowReaderOpts_;
   std::unique_ptr<dwio::common::Reader> reader_;
   std::unique_ptr<exec::ExprSet> remainingFilterExprSet_;
+  // Rows in and out of the remaining filter and the time to evaluate it,
+  // including loading the LazyVectors it accesses. Reported next to the
+  // pushed down filters in runtimeStats().
+  SelectivityInfo remainingFilterSelectivity_;
   bool emptySplit_;
 
   dwio::common::RuntimeStatistics runtimeStats_;
 
   std::shared_ptr<FileHandle> fileHandle_;
+
+  // Readers of the positional delete files of the split and the bit mask of
+  // the deleted rows of the batch being read.
+  std::vector<std::unique_ptr<PositionalDeleteFileReader>> deleteFileReaders_;
+  BufferPtr deletedRows_;
   core::ExpressionEvaluator* expressionEvaluator_;
   uint64_t completedRows_ = 0;
 
+  // Aggregates returned instead of the rows, keyed on output column name.
+  // See HiveTableHandle.
+  HiveStatsAggregates statsAggregates_;
+  // The partition key of each output column if there are stats aggregates,
+  // empty for the aggregates.
+  std::vector<std::string> statsPartitionKeys_;
+  // The aggregates of the current split, returned after all rows to read are
+  // added.
+  RowVectorPtr statsAggregatesRow_;
+  // True if the rows of the current split are read to compute the aggregates.
+  bool readsStatsAggregateRows_{false};
+  // Number of splits answered from the file statistics.
+  int64_t numStatsAggregatedSplits_{0};
+  // Number of splits skipped by their filters before reading the file footer.
+  int64_t numSplitsSkippedBeforeOpen_{0};
+
+  // Rows still needed by the consumer if set by setRowLimit().
+  std::optional<uint64_t> rowLimit_;
+
   // Reusable memory for remaining filter evaluation.
   VectorPtr filterResult_;
   SelectivityVector filterRows_;
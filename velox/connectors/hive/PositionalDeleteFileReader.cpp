@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/connectors/hive/PositionalDeleteFileReader.h"
+#include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/ReaderFactory.h"
+
+namespace facebook::velox::connector::hive {
+
+PositionalDeleteFileReader::PositionalDeleteFileReader(
+    const HiveDeleteFile& deleteFile,
+    FileHandleFactory* fileHandleFactory,
+    memory::MemoryPool* pool)
+    : filePath_(deleteFile.filePath), pool_(pool) {
+  fileHandle_ = fileHandleFactory->generate(filePath_).second;
+  dwio::common::ReaderOptions readerOpts(pool_);
+  readerOpts.setFileFormat(deleteFile.fileFormat);
+  reader_ = dwio::common::getReaderFactory(deleteFile.fileFormat)
+                ->createReader(
+                    std::make_unique<dwio::common::BufferedInput>(
+                        fileHandle_->file, *pool_),
+                    readerOpts);
+
+  const auto& fileType = reader_->rowType();
+  auto index = fileType->getChildIdxIfExists(kPositionColumn);
+  VELOX_USER_CHECK(
+      index.has_value() &&
+          fileType->childAt(index.value())->kind() == TypeKind::BIGINT,
+      "Positional delete file {} must have a BIGINT column '{}': {}",
+      filePath_,
+      kPositionColumn,
+      fileType->toString());
+
+  scanSpec_ = std::make_shared<common::ScanSpec>("root");
+  scanSpec_->addFieldRecursively(kPositionColumn, *BIGINT(), 0);
+  dwio::common::RowReaderOptions rowReaderOpts;
+  rowReaderOpts.setScanSpec(scanSpec_);
+  rowReaderOpts.select(std::make_shared<dwio::common::ColumnSelector>(
+      fileType, std::vector<std::string>{kPositionColumn}));
+  rowReader_ = reader_->createRowReader(rowReaderOpts);
+}
+
+bool PositionalDeleteFileReader::readNextPositions() {
+  static constexpr uint64_t kBatchSize = 10'000;
+  while (!atEnd_) {
+    if (positions_ == nullptr) {
+      positions_ = BaseVector::create(
+          ROW({kPositionColumn}, {BIGINT()}), 0, pool_);
+    }
+    if (rowReader_->next(kBatchSize, positions_) == 0) {
+      atEnd_ = true;
+      break;
+    }
+    numPositions_ = positions_->size();
+    if (numPositions_ == 0) {
+      continue;
+    }
+    const auto& column = positions_->as<RowVector>()->childAt(0);
+    decodedPositions_.decode(*column->loadedVector());
+    positionIndex_ = 0;
+    return true;
+  }
+  numPositions_ = 0;
+  positionIndex_ = 0;
+  return false;
+}
+
+void PositionalDeleteFileReader::readDeletedRows(
+    int64_t baseRow,
+    uint64_t numRows,
+    uint64_t* deletedRows) {
+  const int64_t endRow = baseRow + numRows;
+  for (;;) {
+    if (positionIndex_ == numPositions_ && !readNextPositions()) {
+      return;
+    }
+    VELOX_USER_CHECK(
+        !decodedPositions_.isNullAt(positionIndex_),
+        "Null position in positional delete file {}",
+        filePath_);
+    const auto position = decodedPositions_.valueAt<int64_t>(positionIndex_);
+    VELOX_USER_CHECK_GE(
+        position,
+        lastPosition_,
+        "Positions in positional delete file {} are not sorted",
+        filePath_);
+    if (position >= endRow) {
+      return;
+    }
+    if (position >= baseRow) {
+      bits::setBit(deletedRows, position - baseRow);
+    }
+    lastPosition_ = position;
+    ++positionIndex_;
+  }
+}
+
+} // namespace facebook::velox::connector::hive
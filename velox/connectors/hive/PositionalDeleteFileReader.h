@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/connectors/hive/FileHandle.h"
+#include "velox/connectors/hive/HiveConnectorSplit.h"
+#include "velox/dwio/common/Reader.h"
+#include "velox/dwio/common/ScanSpec.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::connector::hive {
+
+/// Streams the sorted positions of a positional delete file alongside the
+/// reads of its data file and turns them into the deleted row bit masks of
+/// dwio::common::Mutation. Reads the delete file one batch at a time, so the
+/// memory usage does not depend on the number of deleted rows.
+class PositionalDeleteFileReader {
+ public:
+  /// Name of the column with the deleted positions.
+  static constexpr const char* kPositionColumn = "pos";
+
+  PositionalDeleteFileReader(
+      const HiveDeleteFile& deleteFile,
+      FileHandleFactory* fileHandleFactory,
+      memory::MemoryPool* pool);
+
+  /// Sets the bits of the deleted rows of the data file in ['baseRow',
+  /// 'baseRow' + 'numRows') in 'deletedRows', bit 0 for 'baseRow'. The
+  /// ranges of consecutive calls must be increasing. The deleted positions
+  /// before 'baseRow' are skipped.
+  void readDeletedRows(
+      int64_t baseRow,
+      uint64_t numRows,
+      uint64_t* deletedRows);
+
+ private:
+  // Reads the next batch of positions into 'positions_'. Returns false if
+  // there are no more positions.
+  bool readNextPositions();
+
+  const std::string filePath_;
+  memory::MemoryPool* const pool_;
+  std::shared_ptr<FileHandle> fileHandle_;
+  std::shared_ptr<common::ScanSpec> scanSpec_;
+  std::unique_ptr<dwio::common::Reader> reader_;
+  std::unique_ptr<dwio::common::RowReader> rowReader_;
+
+  // The last batch of positions read and the index of the next position in
+  // it.
+  VectorPtr positions_;
+  DecodedVector decodedPositions_;
+  vector_size_t numPositions_{0};
+  vector_size_t positionIndex_{0};
+
+  // The last position seen, to check that the positions are sorted.
+  int64_t lastPosition_{-1};
+  bool atEnd_{false};
+};
+
+} // namespace facebook::velox::connector::hive
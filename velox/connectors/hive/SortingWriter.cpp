@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "velox/connectors/hive/SortingWriter.h"
+
+namespace facebook::velox::connector::hive {
+
+SortingWriter::SortingWriter(
+    std::unique_ptr<dwio::common::Writer> outputWriter,
+    std::unique_ptr<exec::SortBuffer> sortBuffer,
+    vector_size_t maxOutputRowsConfig)
+    : maxOutputRowsConfig_(maxOutputRowsConfig),
+      outputWriter_(std::move(outputWriter)),
+      sortBuffer_(std::move(sortBuffer)) {
+  VELOX_CHECK_GT(maxOutputRowsConfig_, 0);
+}
+
+void SortingWriter::write(const VectorPtr& data) {
+  sortBuffer_->addInput(data);
+}
+
+void SortingWriter::flush() {}
+
+void SortingWriter::close() {
+  sortBuffer_->noMoreInput();
+  while (auto output = sortBuffer_->getOutput(maxOutputRowsConfig_)) {
+    outputWriter_->write(output);
+  }
+  sortBuffer_.reset();
+  outputWriter_->close();
+}
+
+void SortingWriter::abort() {
+  sortBuffer_.reset();
+  outputWriter_->abort();
+}
+
+} // namespace facebook::velox::connector::hive
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#pragma once
+
+#include "velox/dwio/common/Writer.h"
+#include "velox/exec/SortBuffer.h"
+
+namespace facebook::velox::connector::hive {
+
+/// Wraps a file writer and writes the rows it is given sorted on a set of key
+/// columns. The rows are buffered in a SortBuffer and written out in sorted
+/// order when the writer is closed.
+class SortingWriter : public dwio::common::Writer {
+ public:
+  SortingWriter(
+      std::unique_ptr<dwio::common::Writer> outputWriter,
+      std::unique_ptr<exec::SortBuffer> sortBuffer,
+      vector_size_t maxOutputRowsConfig);
+
+  void write(const VectorPtr& data) override;
+
+  /// No-op since the rows are only written in sorted order at close().
+  void flush() override;
+
+  void close() override;
+
+  void abort() override;
+
+ private:
+  const vector_size_t maxOutputRowsConfig_;
+  std::unique_ptr<dwio::common::Writer> outputWriter_;
+  std::unique_ptr<exec::SortBuffer> sortBuffer_;
+};
+
+} // namespace facebook::velox::connector::hive
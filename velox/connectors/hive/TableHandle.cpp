@@ -28,6 +28,15 @@ columnTypeNames() {
   };
 }
 
+std::unordered_map<HiveStatsAggregate::Kind, std::string>
+statsAggregateKindNames() {
+  return {
+      {HiveStatsAggregate::Kind::kCount, "count"},
+      {HiveStatsAggregate::Kind::kMin, "min"},
+      {HiveStatsAggregate::Kind::kMax, "max"},
+  };
+}
+
 template <typename K, typename V>
 std::unordered_map<V, K> invertMap(const std::unordered_map<K, V>& mapping) {
   std::unordered_map<V, K> inverted;
@@ -102,19 +111,34 @@ void HiveColumnHandle::registerSerDe() {
   registry.Register("HiveColumnHandle", HiveColumnHandle::create);
 }
 
+std::string HiveStatsAggregate::kindName(Kind kind) {
+  static const auto names = statsAggregateKindNames();
+  return names.at(kind);
+}
+
+HiveStatsAggregate::Kind HiveStatsAggregate::kindFromName(
+    const std::string& name) {
+  static const auto kinds = invertMap(statsAggregateKindNames());
+  auto it = kinds.find(name);
+  VELOX_USER_CHECK(it != kinds.end(), "Invalid stats aggregate: {}", name);
+  return it->second;
+}
+
 HiveTableHandle::HiveTableHandle(
     std::string connectorId,
     const std::string& tableName,
     bool filterPushdownEnabled,
     SubfieldFilters subfieldFilters,
     const core::TypedExprPtr& remainingFilter,
-    const RowTypePtr& dataColumns)
+    const RowTypePtr& dataColumns,
+    HiveStatsAggregates statsAggregates)
     : ConnectorTableHandle(std::move(connectorId)),
       tableName_(tableName),
       filterPushdownEnabled_(filterPushdownEnabled),
       subfieldFilters_(std::move(subfieldFilters)),
       remainingFilter_(remainingFilter),
-      dataColumns_(dataColumns) {}
+      dataColumns_(dataColumns),
+      statsAggregates_(std::move(statsAggregates)) {}
 
 std::string HiveTableHandle::toString() const {
   std::stringstream out;
@@ -142,6 +166,24 @@ std::string HiveTableHandle::toString() const {
   if (dataColumns_) {
     out << ", data columns: " << dataColumns_->toString();
   }
+  if (!statsAggregates_.empty()) {
+    std::map<std::string, const HiveStatsAggregate*> orderedAggregates;
+    for (const auto& [name, aggregate] : statsAggregates_) {
+      orderedAggregates[name] = &aggregate;
+    }
+    out << ", stats aggregates: [";
+    bool notFirstAggregate = false;
+    for (const auto& [name, aggregate] : orderedAggregates) {
+      if (notFirstAggregate) {
+        out << ", ";
+      }
+      out << name << " := " << HiveStatsAggregate::kindName(aggregate->kind)
+          << "(" << (aggregate->column.empty() ? "*" : aggregate->column)
+          << ")";
+      notFirstAggregate = true;
+    }
+    out << "]";
+  }
   return out.str();
 }
 
@@ -165,6 +207,17 @@ folly::dynamic HiveTableHandle::serialize() const {
   if (dataColumns_) {
     obj["dataColumns"] = dataColumns_->serialize();
   }
+  if (!statsAggregates_.empty()) {
+    folly::dynamic statsAggregates = folly::dynamic::array;
+    for (const auto& [name, aggregate] : statsAggregates_) {
+      folly::dynamic aggregateObj = folly::dynamic::object;
+      aggregateObj["name"] = name;
+      aggregateObj["kind"] = HiveStatsAggregate::kindName(aggregate.kind);
+      aggregateObj["column"] = aggregate.column;
+      statsAggregates.push_back(aggregateObj);
+    }
+    obj["statsAggregates"] = statsAggregates;
+  }
 
   return obj;
 }
@@ -197,13 +250,23 @@ ConnectorTableHandlePtr HiveTableHandle::create(
     dataColumns = ISerializable::deserialize<RowType>(it->second, context);
   }
 
+  HiveStatsAggregates statsAggregates;
+  if (auto it = obj.find("statsAggregates"); it != obj.items().end()) {
+    for (const auto& aggregate : it->second) {
+      statsAggregates[aggregate["name"].asString()] = {
+          HiveStatsAggregate::kindFromName(aggregate["kind"].asString()),
+          aggregate["column"].asString()};
+    }
+  }
+
   return std::make_shared<const HiveTableHandle>(
       connectorId,
       tableName,
       filterPushdownEnabled,
       std::move(subfieldFilters),
       remainingFilter,
-      dataColumns);
+      dataColumns,
+      std::move(statsAggregates));
 }
 
 void HiveTableHandle::registerSerDe() {
@@ -35,6 +35,12 @@ class HiveColumnHandle : public ColumnHandle {
   /// be the same type, and the table scan needs to do data coercion if needs.
   /// The table writer also needs to respect the type difference when processing
   /// input data such as bucket id calculation.
+  ///
+  /// A map column with string keys in DWRF files written as flat maps can be
+  /// read with a struct 'dataType'. Each field is read from the key of the
+  /// same name into its own flat vector without making the map, so that
+  /// subscripts with constant keys can be planned as dereferences of the
+  /// struct. Keys missing in the file read as nulls.
   HiveColumnHandle(
       const std::string& name,
       ColumnType columnType,
@@ -112,15 +118,40 @@ class HiveColumnHandle : public ColumnHandle {
   const std::vector<common::Subfield> requiredSubfields_;
 };
 
+/// An aggregate over the rows of a split that the scan computes instead of
+/// returning the rows. Answered from the statistics in the file footer when
+/// these cover the split, otherwise from the rows read.
+struct HiveStatsAggregate {
+  enum class Kind { kCount, kMin, kMax };
+
+  Kind kind;
+  /// Name of the aggregated column in the file. Empty for count(*).
+  std::string column;
+
+  static std::string kindName(Kind kind);
+
+  static Kind kindFromName(const std::string& name);
+};
+
+/// Aggregates keyed on the name of their output column.
+using HiveStatsAggregates =
+    std::unordered_map<std::string, HiveStatsAggregate>;
+
 class HiveTableHandle : public ConnectorTableHandle {
  public:
+  /// If 'statsAggregates' is not empty, the scan returns one row per split
+  /// with the aggregates and the partition keys in the output, e.g. the
+  /// intermediate results of count, min and max in a global aggregation or
+  /// one grouped on partition keys only. The filters must then be on the
+  /// partition keys only.
   HiveTableHandle(
       std::string connectorId,
       const std::string& tableName,
       bool filterPushdownEnabled,
       SubfieldFilters subfieldFilters,
       const core::TypedExprPtr& remainingFilter,
-      const RowTypePtr& dataColumns = nullptr);
+      const RowTypePtr& dataColumns = nullptr,
+      HiveStatsAggregates statsAggregates = {});
 
   const std::string& tableName() const {
     return tableName_;
@@ -143,6 +174,10 @@ class HiveTableHandle : public ConnectorTableHandle {
     return dataColumns_;
   }
 
+  const HiveStatsAggregates& statsAggregates() const {
+    return statsAggregates_;
+  }
+
   std::string toString() const override;
 
   folly::dynamic serialize() const override;
@@ -159,6 +194,7 @@ class HiveTableHandle : public ConnectorTableHandle {
   const SubfieldFilters subfieldFilters_;
   const core::TypedExprPtr remainingFilter_;
   const RowTypePtr dataColumns_;
+  const HiveStatsAggregates statsAggregates_;
 };
 
 } // namespace facebook::velox::connector::hive
@@ -62,6 +62,7 @@ class HivePartitionFunctionBenchmark
     manyBucketsFunction_ = createHivePartitionFunction(100);
 
     partitions_.resize(vectorSize);
+    bucketRows_.resize(100);
   }
 
   template <TypeKind KIND>
@@ -74,6 +75,24 @@ class HivePartitionFunctionBenchmark
     run<KIND>(manyBucketsFunction_.get());
   }
 
+  // Routes the rows to the writers of their buckets like HiveDataSink. With
+  // 'localExchange' the bucket ids are computed twice as with a LocalPartition
+  // on the bucket columns in front of the table writer.
+  template <TypeKind KIND>
+  void runWriter(bool localExchange) {
+    if (localExchange) {
+      run<KIND>(manyBucketsFunction_.get());
+    }
+    run<KIND>(manyBucketsFunction_.get());
+    for (auto& rows : bucketRows_) {
+      rows.clear();
+    }
+    for (vector_size_t row = 0; row < partitions_.size(); ++row) {
+      bucketRows_[partitions_[row]].push_back(row);
+    }
+    folly::doNotOptimizeAway(bucketRows_);
+  }
+
  private:
   std::unique_ptr<HivePartitionFunction> createHivePartitionFunction(
       size_t bucketCount) {
@@ -98,6 +117,7 @@ class HivePartitionFunctionBenchmark
   std::unique_ptr<HivePartitionFunction> fewBucketsFunction_;
   std::unique_ptr<HivePartitionFunction> manyBucketsFunction_;
   std::vector<uint32_t> partitions_;
+  std::vector<std::vector<vector_size_t>> bucketRows_;
 };
 
 std::unique_ptr<HivePartitionFunctionBenchmark> benchmarkFew;
@@ -263,6 +283,24 @@ BENCHMARK_RELATIVE(timestampManyRowsManyBuckets) {
   benchmarkMany->runMany<TypeKind::TIMESTAMP>();
 }
 
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(bigintWriterWithLocalExchange) {
+  benchmarkMany->runWriter<TypeKind::BIGINT>(true);
+}
+
+BENCHMARK_RELATIVE(bigintWriter) {
+  benchmarkMany->runWriter<TypeKind::BIGINT>(false);
+}
+
+BENCHMARK(varcharWriterWithLocalExchange) {
+  benchmarkMany->runWriter<TypeKind::VARCHAR>(true);
+}
+
+BENCHMARK_RELATIVE(varcharWriter) {
+  benchmarkMany->runWriter<TypeKind::VARCHAR>(false);
+}
+
 BENCHMARK_DRAW_LINE();
 } // namespace
 
@@ -15,12 +15,15 @@
  */
 
 #include "velox/connectors/hive/storage_adapters/s3fs/S3FileSystem.h"
+#include "velox/buffer/Buffer.h"
 #include "velox/common/file/File.h"
+#include "velox/common/memory/Memory.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3Util.h"
 #include "velox/core/Config.h"
 
 #include <fmt/format.h>
+#include <folly/futures/Future.h>
 #include <glog/logging.h>
 #include <memory>
 #include <stdexcept>
@@ -30,6 +33,7 @@
 #include <aws/core/http/HttpResponse.h>
 #include <aws/core/utils/logging/ConsoleLogSystem.h>
 #include <aws/core/utils/stream/PreallocatedStreamBuf.h>
+#include <aws/core/utils/threading/Executor.h>
 #include <aws/identity-management/auth/STSAssumeRoleCredentialsProvider.h>
 #include <aws/s3/S3Client.h>
 #include <aws/s3/model/GetObjectRequest.h>
@@ -62,8 +66,20 @@ Aws::IOStreamFactory AwsWriteableStreamFactory(void* data, int64_t nbytes) {
 
 class S3ReadFile final : public ReadFile {
  public:
-  S3ReadFile(const std::string& path, Aws::S3::S3Client* client)
-      : client_(client) {
+  // Reads larger than 'partSize' are split into requests of 'partSize' bytes.
+  // If 'parallel', the requests of a read run in parallel on the executor of
+  // 'client' and preadvAsync() is asynchronous. The temporary buffers of
+  // preadv() are allocated from 'pool'.
+  S3ReadFile(
+      const std::string& path,
+      Aws::S3::S3Client* client,
+      bool parallel,
+      uint64_t partSize,
+      std::shared_ptr<memory::MemoryPool> pool)
+      : client_(client),
+        parallel_(parallel),
+        partSize_(partSize),
+        pool_(std::move(pool)) {
     bucketAndKeyFromS3Path(path, bucket_, key_);
   }
 
@@ -88,41 +104,59 @@ class S3ReadFile final : public ReadFile {
 
   std::string_view pread(uint64_t offset, uint64_t length, void* buffer)
       const override {
-    preadInternal(offset, length, static_cast<char*>(buffer));
+    std::vector<ReadPart> parts;
+    addParts(offset, length, static_cast<char*>(buffer), parts);
+    readParts(parts);
     return {static_cast<char*>(buffer), length};
   }
 
   std::string pread(uint64_t offset, uint64_t length) const override {
     std::string result(length, 0);
-    char* position = result.data();
-    preadInternal(offset, length, position);
+    pread(offset, length, result.data());
     return result;
   }
 
   uint64_t preadv(
       uint64_t offset,
       const std::vector<folly::Range<char*>>& buffers) const override {
-    // 'buffers' contains Ranges(data, size)  with some gaps (data = nullptr) in
-    // between. This call must populate the ranges (except gap ranges)
-    // sequentially starting from 'offset'. AWS S3 GetObject does not support
-    // multi-range. AWS S3 also charges by number of read requests and not size.
-    // The idea here is to use a single read spanning all the ranges and then
-    // populate individual ranges. We pre-allocate a buffer to support this.
-    size_t length = 0;
-    for (const auto range : buffers) {
-      length += range.size();
+    auto plan = makeReadPlan(offset, buffers);
+    readParts(plan->parts);
+    plan->copyToBuffers(buffers);
+    return plan->numBytes;
+  }
+
+  // Issues the requests of a preadv() on the executor of the S3 client,
+  // without a thread waiting for each. 'buffers' must stay live until the
+  // result is ready.
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const override {
+    if (!parallel_) {
+      return ReadFile::preadvAsync(offset, buffers);
     }
-    // TODO: allocate from a memory pool
-    std::string result(length, 0);
-    preadInternal(offset, length, static_cast<char*>(result.data()));
-    size_t resultOffset = 0;
-    for (auto range : buffers) {
-      if (range.data()) {
-        memcpy(range.data(), &(result.data()[resultOffset]), range.size());
-      }
-      resultOffset += range.size();
+    std::shared_ptr<ReadPlan> plan;
+    try {
+      plan = makeReadPlan(offset, buffers);
+    } catch (const std::exception& e) {
+      return folly::makeSemiFuture<uint64_t>(e);
+    }
+    std::vector<folly::SemiFuture<folly::Unit>> futures;
+    futures.reserve(plan->parts.size());
+    for (const auto& part : plan->parts) {
+      futures.push_back(getObjectRangeAsync(part));
     }
-    return length;
+    return folly::collectAll(std::move(futures))
+        .deferValue([plan, buffers](auto&& results) {
+          for (auto& result : results) {
+            result.throwUnlessValue();
+          }
+          plan->copyToBuffers(buffers);
+          return plan->numBytes;
+        });
+  }
+
+  bool hasPreadvAsync() const override {
+    return parallel_;
   }
 
   uint64_t size() const override {
@@ -148,25 +182,187 @@ class S3ReadFile final : public ReadFile {
   }
 
  private:
-  // The assumption here is that "position" has space for at least "length"
-  // bytes.
-  void preadInternal(uint64_t offset, uint64_t length, char* position) const {
+  // Gaps between the ranges of a preadv() of at least this many bytes are not
+  // read. A smaller gap takes less time to transfer than a request.
+  static constexpr uint64_t kMinGapBytes = 1 << 20;
+
+  // Consecutive ranges of a preadv() that are read together.
+  struct Region {
+    uint64_t offset;
+    uint64_t length;
+    // Range of the preadv() buffers in the region.
+    size_t beginBuffer;
+    size_t endBuffer;
+
+    uint64_t end() const {
+      return offset + length;
+    }
+  };
+
+  // A ranged GET request.
+  struct ReadPart {
+    uint64_t offset;
+    uint64_t length;
+    char* data;
+  };
+
+  // The regions, temporary buffers and requests of a preadv().
+  struct ReadPlan {
+    // Keeps the pool of 'regionBuffers' live while the plan is.
+    std::shared_ptr<memory::MemoryPool> pool;
+    std::vector<Region> regions;
+    // Buffer of each region that is not read in place.
+    std::vector<BufferPtr> regionBuffers;
+    std::vector<ReadPart> parts;
+    // Bytes covered by the preadv() ranges, including gaps.
+    uint64_t numBytes{0};
+
+    // Copies the regions read into 'regionBuffers' to the preadv() ranges.
+    void copyToBuffers(const std::vector<folly::Range<char*>>& buffers) const {
+      for (auto i = 0; i < regions.size(); ++i) {
+        const auto& region = regions[i];
+        if (regionBuffers[i] == nullptr) {
+          continue;
+        }
+        size_t regionOffset = 0;
+        for (auto j = region.beginBuffer; j < region.endBuffer; ++j) {
+          const auto& range = buffers[j];
+          if (range.data()) {
+            memcpy(
+                range.data(),
+                regionBuffers[i]->as<char>() + regionOffset,
+                range.size());
+          }
+          regionOffset += range.size();
+        }
+      }
+    }
+  };
+
+  // 'buffers' contains Ranges(data, size)  with some gaps (data = nullptr) in
+  // between. This call must populate the ranges (except gap ranges)
+  // sequentially starting from 'offset'. AWS S3 GetObject does not support
+  // multi-range. AWS S3 also charges by number of read requests and not size.
+  // Ranges with gaps below kMinGapBytes between them make one region that is
+  // read with the gaps into a temporary buffer. A region of a single range
+  // is read in place. The regions are split into parts of 'partSize_' and
+  // all parts are read in parallel.
+  std::shared_ptr<ReadPlan> makeReadPlan(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const {
+    auto plan = std::make_shared<ReadPlan>();
+    plan->pool = pool_;
+    auto& regions = plan->regions;
+    uint64_t position = offset;
+    for (auto i = 0; i < buffers.size(); ++i) {
+      const auto& range = buffers[i];
+      if (range.data()) {
+        if (regions.empty() ||
+            position - regions.back().end() >= kMinGapBytes) {
+          regions.push_back({position, 0, i, 0});
+        }
+        auto& region = regions.back();
+        region.length = position + range.size() - region.offset;
+        region.endBuffer = i + 1;
+      }
+      position += range.size();
+    }
+    plan->numBytes = position - offset;
+
+    plan->regionBuffers.resize(regions.size());
+    for (auto i = 0; i < regions.size(); ++i) {
+      const auto& region = regions[i];
+      char* data;
+      if (region.endBuffer - region.beginBuffer == 1) {
+        data = buffers[region.beginBuffer].data();
+      } else {
+        plan->regionBuffers[i] =
+            AlignedBuffer::allocate<char>(region.length, pool_.get());
+        data = plan->regionBuffers[i]->asMutable<char>();
+      }
+      addParts(region.offset, region.length, data, plan->parts);
+    }
+    return plan;
+  }
+
+  // Adds the requests for reading 'length' bytes at 'offset' into 'data'.
+  void addParts(
+      uint64_t offset,
+      uint64_t length,
+      char* data,
+      std::vector<ReadPart>& parts) const {
+    const auto partSize = partSize_ > 0 ? partSize_ : length;
+    for (uint64_t begin = 0; begin < length; begin += partSize) {
+      parts.push_back(
+          {offset + begin, std::min(partSize, length - begin), data + begin});
+    }
+  }
+
+  // Issues the requests of 'parts', in parallel if 'parallel_'. Returns after
+  // all requests are done. Throws the error of a failed request.
+  void readParts(const std::vector<ReadPart>& parts) const {
+    if (!parallel_ || parts.size() <= 1) {
+      for (const auto& part : parts) {
+        auto outcome = client_->GetObject(makeRequest(part));
+        VELOX_CHECK_AWS_OUTCOME(
+            outcome, "Failed to get S3 object", bucket_, key_);
+      }
+      return;
+    }
+    std::vector<folly::SemiFuture<folly::Unit>> futures;
+    futures.reserve(parts.size());
+    for (const auto& part : parts) {
+      futures.push_back(getObjectRangeAsync(part));
+    }
+    // The buffers must not be released while a request is writing them.
+    auto results = folly::collectAll(std::move(futures)).get();
+    for (auto& result : results) {
+      result.throwUnlessValue();
+    }
+  }
+
+  // The assumption here is that 'part.data' has space for at least
+  // 'part.length' bytes.
+  Aws::S3::Model::GetObjectRequest makeRequest(const ReadPart& part) const {
     // Read the desired range of bytes.
     Aws::S3::Model::GetObjectRequest request;
-    Aws::S3::Model::GetObjectResult result;
-
     request.SetBucket(awsString(bucket_));
     request.SetKey(awsString(key_));
     std::stringstream ss;
-    ss << "bytes=" << offset << "-" << offset + length - 1;
+    ss << "bytes=" << part.offset << "-" << part.offset + part.length - 1;
     request.SetRange(awsString(ss.str()));
     request.SetResponseStreamFactory(
-        AwsWriteableStreamFactory(position, length));
-    auto outcome = client_->GetObject(request);
-    VELOX_CHECK_AWS_OUTCOME(outcome, "Failed to get S3 object", bucket_, key_);
+        AwsWriteableStreamFactory(part.data, part.length));
+    return request;
+  }
+
+  // Issues the request for 'part' on the executor of the S3 client.
+  folly::SemiFuture<folly::Unit> getObjectRangeAsync(
+      const ReadPart& part) const {
+    auto [promise, future] = folly::makePromiseContract<folly::Unit>();
+    // The handler must be copyable.
+    auto sharedPromise =
+        std::make_shared<folly::Promise<folly::Unit>>(std::move(promise));
+    client_->GetObjectAsync(
+        makeRequest(part),
+        [sharedPromise, bucket = bucket_, key = key_](
+            const Aws::S3::S3Client* /*client*/,
+            const Aws::S3::Model::GetObjectRequest& /*request*/,
+            auto outcome,
+            const auto& /*context*/) {
+          sharedPromise->setTry(folly::makeTryWith([&]() {
+            VELOX_CHECK_AWS_OUTCOME(
+                outcome, "Failed to get S3 object", bucket, key);
+            return folly::unit;
+          }));
+        });
+    return std::move(future);
   }
 
   Aws::S3::S3Client* client_;
+  const bool parallel_;
+  const uint64_t partSize_;
+  const std::shared_ptr<memory::MemoryPool> pool_;
   std::string bucket_;
   std::string key_;
   int64_t length_ = -1;
@@ -201,7 +397,8 @@ namespace filesystems {
 using namespace connector::hive;
 class S3FileSystem::Impl {
  public:
-  Impl(const Config* config) : config_(config) {
+  Impl(const Config* config)
+      : config_(config), pool_(memory::addDefaultLeafMemoryPool()) {
     const size_t origCount = initCounter_++;
     if (origCount == 0) {
       Aws::SDKOptions awsOptions;
@@ -304,6 +501,18 @@ class S3FileSystem::Impl {
     } else {
       clientConfig.scheme = Aws::Http::Scheme::HTTP;
     }
+    // The connections are kept alive and reused by all files.
+    clientConfig.maxConnections = HiveConfig::s3MaxConnections(config_);
+
+    // The asynchronous requests of all files run on the threads of the
+    // client.
+    if (const auto parallelism = HiveConfig::s3ReadParallelism(config_);
+        parallelism > 0) {
+      clientConfig.executor =
+          Aws::MakeShared<Aws::Utils::Threading::PooledThreadExecutor>(
+              "S3Read", parallelism);
+      parallelReads_ = true;
+    }
 
     auto credentialsProvider = getCredentialsProvider();
 
@@ -321,6 +530,21 @@ class S3FileSystem::Impl {
     return client_.get();
   }
 
+  // True if the requests of a read run in parallel on the executor of the
+  // client.
+  bool parallelReads() const {
+    return parallelReads_;
+  }
+
+  uint64_t readPartSize() const {
+    return HiveConfig::s3ReadPartSize(config_);
+  }
+
+  // Pool of the temporary buffers of the reads of all files.
+  const std::shared_ptr<memory::MemoryPool>& pool() const {
+    return pool_;
+  }
+
   std::string getLogLevelName() const {
     return GetLogLevelName(inferS3LogLevel(HiveConfig::s3GetLogLevel(config_)));
   }
@@ -328,6 +552,8 @@ class S3FileSystem::Impl {
  private:
   const Config* config_;
   std::shared_ptr<Aws::S3::S3Client> client_;
+  bool parallelReads_{false};
+  const std::shared_ptr<memory::MemoryPool> pool_;
   static std::atomic<size_t> initCounter_;
 };
 
@@ -350,7 +576,12 @@ std::unique_ptr<ReadFile> S3FileSystem::openFileForRead(
     std::string_view path,
     const FileOptions& /*unused*/) {
   const std::string file = s3Path(path);
-  auto s3file = std::make_unique<S3ReadFile>(file, impl_->s3Client());
+  auto s3file = std::make_unique<S3ReadFile>(
+      file,
+      impl_->s3Client(),
+      impl_->parallelReads(),
+      impl_->readPartSize(),
+      impl_->pool());
   s3file->initialize();
   return s3file;
 }
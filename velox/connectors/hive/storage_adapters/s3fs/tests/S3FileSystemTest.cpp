@@ -119,6 +119,42 @@ TEST_F(S3FileSystemTest, writeAndRead) {
   readData(readFile.get());
 }
 
+TEST_F(S3FileSystemTest, parallelRead) {
+  const char* bucketName = "data-parallel";
+  const char* file = "test.txt";
+  const std::string filename = localPath(bucketName) + "/" + file;
+  const std::string s3File = s3URI(bucketName, file);
+  addBucket(bucketName);
+  {
+    LocalWriteFile writeFile(filename);
+    writeData(&writeFile);
+  }
+  for (const auto* parallelism : {"0", "4"}) {
+    SCOPED_TRACE(fmt::format("parallelism {}", parallelism));
+    // Splits the 1MB read and the 500KB gap of preadv() into many requests.
+    auto hiveConfig = minioServer_->hiveConfig(
+        {{"hive.s3.read-parallelism", parallelism},
+         {"hive.s3.read-part-size", "100000"},
+         {"hive.s3.max-connections", "8"}});
+    filesystems::S3FileSystem s3fs(hiveConfig);
+    s3fs.initializeClient();
+    auto readFile = s3fs.openFileForRead(s3File);
+    readData(readFile.get());
+
+    ASSERT_EQ(readFile->hasPreadvAsync(), std::string(parallelism) != "0");
+    char head[12];
+    char tail[7];
+    std::vector<folly::Range<char*>> buffers = {
+        folly::Range<char*>(head, sizeof(head)),
+        folly::Range<char*>(
+            nullptr, (char*)(uint64_t)(kOneMB + 15 - sizeof(head) - 7)),
+        folly::Range<char*>(tail, sizeof(tail))};
+    ASSERT_EQ(readFile->preadvAsync(0, buffers).get(), kOneMB + 15);
+    ASSERT_EQ(std::string_view(head, sizeof(head)), "aaaaabbbbbcc");
+    ASSERT_EQ(std::string_view(tail, sizeof(tail)), "ccddddd");
+  }
+}
+
 TEST_F(S3FileSystemTest, viaRegistry) {
   const char* bucketName = "data2";
   const char* file = "test.txt";
@@ -20,6 +20,7 @@
 #include "velox/common/caching/SimpleLRUCache.h"
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/time/Timer.h"
 #include "velox/exec/tests/utils/TempFilePath.h"
 
 using namespace facebook::velox;
@@ -48,3 +49,34 @@ TEST(FileHandleTest, localFile) {
   // Clean up
   remove(filename.c_str());
 }
+
+TEST(FileHandleTest, negativeCache) {
+  filesystems::registerLocalFileSystem();
+
+  auto tempFile = ::exec::test::TempFilePath::create();
+  const auto& filename = tempFile->path;
+  remove(filename.c_str());
+
+  FileHandleGenerator generator(nullptr, 1'000'000);
+  FileHandleGenerator uncachedGenerator(nullptr);
+  EXPECT_ANY_THROW(generator(filename));
+  EXPECT_ANY_THROW(uncachedGenerator(filename));
+
+  {
+    LocalWriteFile writeFile(filename);
+    writeFile.append("foo");
+  }
+  // The failure is kept and the file is not opened again.
+  EXPECT_ANY_THROW(generator(filename));
+  EXPECT_EQ(uncachedGenerator(filename)->file->size(), 3);
+
+  remove(filename.c_str());
+}
+
+TEST(FileHandleTest, expiration) {
+  FileHandle fileHandle;
+  fileHandle.openTimeMs = getCurrentTimeMs() - 2'000;
+  EXPECT_TRUE(isFileHandleValid(fileHandle, 0));
+  EXPECT_TRUE(isFileHandleValid(fileHandle, 60'000));
+  EXPECT_FALSE(isFileHandleValid(fileHandle, 1'000));
+}
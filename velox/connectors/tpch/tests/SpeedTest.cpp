@@ -31,7 +31,10 @@ namespace {
 /// generated table, scale factor, number of splits, and number of threads
 /// (drivers) using the flags defined below.
 
-DEFINE_string(table, "lineitem", "TPC-H table name to generate.");
+DEFINE_string(
+    table,
+    "lineitem",
+    "TPC-H table name to generate, or 'all' to generate each table in turn.");
 
 DEFINE_int32(
     scale_factor,
@@ -110,6 +113,14 @@ class TpchSpeedTest {
     LOG(INFO) << "\tTotal rows generated: " << totalRows_;
     LOG(INFO) << "\tTotal bytes generated: " << totalBytes_;
     LOG(INFO) << "\tTotal time spent: " << elapsed.count() << "s";
+    // Splits are generated independently of each other, so the rate per
+    // driver tells how well generation scales with the number of threads.
+    const auto numDrivers =
+        std::min<size_t>(FLAGS_max_drivers, std::max<size_t>(numSplits, 1));
+    LOG(INFO) << "\tRows/s per driver: "
+              << static_cast<size_t>(
+                     totalRows_ / elapsed.count() / numDrivers)
+              << " (" << numDrivers << " drivers)";
   }
 
  private:
@@ -182,6 +193,20 @@ int main(int argc, char** argv) {
   folly::init(&argc, &argv, false);
 
   TpchSpeedTest speedTest;
+  if (FLAGS_table == "all") {
+    for (auto table :
+         {tpch::Table::TBL_PART,
+          tpch::Table::TBL_SUPPLIER,
+          tpch::Table::TBL_PARTSUPP,
+          tpch::Table::TBL_CUSTOMER,
+          tpch::Table::TBL_ORDERS,
+          tpch::Table::TBL_LINEITEM,
+          tpch::Table::TBL_NATION,
+          tpch::Table::TBL_REGION}) {
+      speedTest.run(table, FLAGS_scale_factor, FLAGS_num_splits);
+    }
+    return 0;
+  }
   speedTest.run(
       tpch::fromTableName(FLAGS_table), FLAGS_scale_factor, FLAGS_num_splits);
   return 0;
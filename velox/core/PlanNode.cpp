@@ -925,6 +925,97 @@ PlanNodePtr MergeJoinNode::create(const folly::dynamic& obj, void* context) {
       outputType);
 }
 
+AsofJoinNode::AsofJoinNode(
+    const PlanNodeId& id,
+    JoinType joinType,
+    const std::vector<FieldAccessTypedExprPtr>& leftKeys,
+    const std::vector<FieldAccessTypedExprPtr>& rightKeys,
+    Comparison comparison,
+    PlanNodePtr left,
+    PlanNodePtr right,
+    RowTypePtr outputType)
+    : AbstractJoinNode(
+          id,
+          joinType,
+          leftKeys,
+          rightKeys,
+          nullptr,
+          std::move(left),
+          std::move(right),
+          std::move(outputType)),
+      comparison_(comparison) {
+  VELOX_USER_CHECK(
+      isInnerJoin() || isLeftJoin(),
+      "ASOF join supports only inner and left joins, not {}",
+      joinTypeName(joinType_));
+}
+
+namespace {
+std::unordered_map<AsofJoinNode::Comparison, std::string> comparisonNames() {
+  return {
+      {AsofJoinNode::Comparison::kGreaterThanOrEqual, ">="},
+      {AsofJoinNode::Comparison::kGreaterThan, ">"},
+      {AsofJoinNode::Comparison::kLessThanOrEqual, "<="},
+      {AsofJoinNode::Comparison::kLessThan, "<"},
+  };
+}
+} // namespace
+
+// static
+const char* AsofJoinNode::comparisonName(Comparison comparison) {
+  static const auto kComparisons = comparisonNames();
+  return kComparisons.at(comparison).c_str();
+}
+
+// static
+AsofJoinNode::Comparison AsofJoinNode::comparisonFromName(
+    const std::string& name) {
+  static const auto kComparisons = invertMap(comparisonNames());
+  auto it = kComparisons.find(name);
+  VELOX_USER_CHECK(
+      it != kComparisons.end(), "Invalid ASOF join comparison: {}", name);
+  return it->second;
+}
+
+void AsofJoinNode::addDetails(std::stringstream& stream) const {
+  stream << joinTypeName(joinType_) << " ";
+  const auto numKeys = leftKeys_.size();
+  for (auto i = 0; i < numKeys; ++i) {
+    if (i > 0) {
+      stream << " AND ";
+    }
+    stream << leftKeys_[i]->name()
+           << (i == numKeys - 1 ? comparisonName(comparison_) : "=")
+           << rightKeys_[i]->name();
+  }
+}
+
+folly::dynamic AsofJoinNode::serialize() const {
+  auto obj = serializeBase();
+  obj["comparison"] = comparisonName(comparison_);
+  return obj;
+}
+
+// static
+PlanNodePtr AsofJoinNode::create(const folly::dynamic& obj, void* context) {
+  auto sources = deserializeSources(obj, context);
+  VELOX_CHECK_EQ(2, sources.size());
+
+  auto leftKeys = deserializeFields(obj["leftKeys"], context);
+  auto rightKeys = deserializeFields(obj["rightKeys"], context);
+  auto outputType = deserializeRowType(obj["outputType"]);
+
+  return std::make_shared<AsofJoinNode>(
+      deserializePlanNodeId(obj),
+      joinTypeFromName(obj["joinType"].asString()),
+      std::move(leftKeys),
+      std::move(rightKeys),
+      comparisonFromName(obj["comparison"].asString()),
+      sources[0],
+      sources[1],
+      outputType);
+}
+
 NestedLoopJoinNode::NestedLoopJoinNode(
     const PlanNodeId& id,
     JoinType joinType,
@@ -1105,12 +1196,14 @@ WindowNode::WindowNode(
     std::vector<SortOrder> sortingOrders,
     std::vector<std::string> windowColumnNames,
     std::vector<Function> windowFunctions,
+    bool inputsSorted,
     PlanNodePtr source)
     : PlanNode(std::move(id)),
       partitionKeys_(std::move(partitionKeys)),
       sortingKeys_(std::move(sortingKeys)),
       sortingOrders_(std::move(sortingOrders)),
       windowFunctions_(std::move(windowFunctions)),
+      inputsSorted_(inputsSorted),
       sources_{std::move(source)},
       outputType_(getWindowOutputType(
           sources_[0]->outputType(),
@@ -1137,6 +1230,10 @@ void WindowNode::addDetails(std::stringstream& stream) const {
   addSortingKeys(sortingKeys_, sortingOrders_, stream);
   stream << "] ";
 
+  if (inputsSorted_) {
+    stream << "STREAMING ";
+  }
+
   auto numInputCols = sources_[0]->outputType()->size();
   auto numOutputCols = outputType_->size();
   for (auto i = numInputCols; i < numOutputCols; i++) {
@@ -1262,6 +1359,7 @@ folly::dynamic WindowNode::serialize() const {
     windowNames.push_back(outputType_->nameOf(i));
   }
   obj["names"] = ISerializable::serialize(windowNames);
+  obj["inputsSorted"] = inputsSorted_;
 
   return obj;
 }
@@ -1288,6 +1386,7 @@ PlanNodePtr WindowNode::create(const folly::dynamic& obj, void* context) {
       sortingOrders,
       windowNames,
       functions,
+      obj.getDefault("inputsSorted", false).asBool(),
       source);
 }
 
@@ -1945,6 +2044,7 @@ void PlanNode::registerSerDe() {
   registry.Register("HashJoinNode", HashJoinNode::create);
   registry.Register("MergeExchangeNode", MergeExchangeNode::create);
   registry.Register("MergeJoinNode", MergeJoinNode::create);
+  registry.Register("AsofJoinNode", AsofJoinNode::create);
   registry.Register("NestedLoopJoinNode", NestedLoopJoinNode::create);
   registry.Register("LimitNode", LimitNode::create);
   registry.Register("LocalMergeNode", LocalMergeNode::create);
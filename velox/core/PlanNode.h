@@ -564,12 +564,18 @@ class AggregationNode : public PlanNode {
   }
 
   bool canSpill(const QueryConfig& queryConfig) const override {
-    // NOTE: as for now, we don't allow spilling for distinct aggregation
-    // (https://github.com/facebookincubator/velox/issues/3263) and pre-grouped
-    // aggregation (https://github.com/facebookincubator/velox/issues/3264). We
-    // will add support later to re-enable.
-    return (isFinal() || isSingle()) && !(aggregates().empty()) &&
-        preGroupedKeys().empty() && queryConfig.aggregationSpillEnabled();
+    // NOTE: as for now, we don't allow spilling for pre-grouped aggregation
+    // (https://github.com/facebookincubator/velox/issues/3264). We will add
+    // support later to re-enable. Partial aggregation spills only if
+    // explicitly enabled.
+    return (isFinal() || isSingle() ||
+            (isPartial() && queryConfig.partialAggregationSpillEnabled())) &&
+        !(aggregates().empty()) && preGroupedKeys().empty() &&
+        queryConfig.aggregationSpillEnabled();
+  }
+
+  bool isPartial() const {
+    return step_ == Step::kPartial;
   }
 
   bool isFinal() const {
@@ -1560,9 +1566,64 @@ class MergeJoinNode : public AbstractJoinNode {
     return "MergeJoin";
   }
 
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    return queryConfig.mergeJoinSpillEnabled();
+  }
+
+  folly::dynamic serialize() const override;
+
+  static PlanNodePtr create(const folly::dynamic& obj, void* context);
+};
+
+/// Represents an inner or left ASOF join of two inputs sorted in ascending
+/// order on the join keys. The last pair of keys is compared with
+/// 'comparison' and the other pairs for equality. Each left side row is
+/// joined with at most one right side row: the one with equal keys whose last
+/// key is the closest to the last left key among the rows satisfying the
+/// comparison, e.g. the latest version of a dimension row valid at the time of
+/// an event for 'event.ts >= dim.valid_from'. Rows with null keys do not
+/// match. Translates to an exec::AsofJoin operator. Like for MergeJoinNode, an
+/// exec::MergeJoinSource is produced for the right side.
+class AsofJoinNode : public AbstractJoinNode {
+ public:
+  /// Comparison of the last left key with the last right key.
+  enum class Comparison {
+    kGreaterThanOrEqual,
+    kGreaterThan,
+    kLessThanOrEqual,
+    kLessThan,
+  };
+
+  AsofJoinNode(
+      const PlanNodeId& id,
+      JoinType joinType,
+      const std::vector<FieldAccessTypedExprPtr>& leftKeys,
+      const std::vector<FieldAccessTypedExprPtr>& rightKeys,
+      Comparison comparison,
+      PlanNodePtr left,
+      PlanNodePtr right,
+      RowTypePtr outputType);
+
+  std::string_view name() const override {
+    return "AsofJoin";
+  }
+
+  Comparison comparison() const {
+    return comparison_;
+  }
+
+  static const char* comparisonName(Comparison comparison);
+
+  static Comparison comparisonFromName(const std::string& name);
+
   folly::dynamic serialize() const override;
 
   static PlanNodePtr create(const folly::dynamic& obj, void* context);
+
+ private:
+  void addDetails(std::stringstream& stream) const override;
+
+  const Comparison comparison_;
 };
 
 /// Represents inner/outer nested loop joins. Translates to an
@@ -1599,6 +1660,13 @@ class NestedLoopJoinNode : public PlanNode {
     return outputType_;
   }
 
+  /// The build side can spill for the joins which don't need to output the
+  /// mismatched build side rows.
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    return !isRightJoin(joinType_) && !isFullJoin(joinType_) &&
+        queryConfig.nestedLoopJoinSpillEnabled();
+  }
+
   std::string_view name() const override {
     return "NestedLoopJoin";
   }
@@ -1737,6 +1805,10 @@ class TopNNode : public PlanNode {
     return isPartial_;
   }
 
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    return queryConfig.topNSpillEnabled();
+  }
+
   std::string_view name() const override {
     return "TopN";
   }
@@ -2027,6 +2099,10 @@ class WindowNode : public PlanNode {
   /// @param windowColumnNames specifies the output column
   /// names for each window function column. So
   /// windowColumnNames.length() = windowFunctions.length().
+  /// @param inputsSorted specifies if the input is already sorted by
+  /// (partition keys + sorting keys). If true, the window operator emits the
+  /// output of each partition as soon as the partition boundary is seen
+  /// instead of buffering all the input.
   WindowNode(
       PlanNodeId id,
       std::vector<FieldAccessTypedExprPtr> partitionKeys,
@@ -2034,6 +2110,7 @@ class WindowNode : public PlanNode {
       std::vector<SortOrder> sortingOrders,
       std::vector<std::string> windowColumnNames,
       std::vector<Function> windowFunctions,
+      bool inputsSorted,
       PlanNodePtr source);
 
   const std::vector<PlanNodePtr>& sources() const override {
@@ -2062,10 +2139,23 @@ class WindowNode : public PlanNode {
     return windowFunctions_;
   }
 
+  bool inputsSorted() const {
+    return inputsSorted_;
+  }
+
   std::string_view name() const override {
     return "Window";
   }
 
+  /// NOTE: a window without partition keys is not spillable as the whole input
+  /// forms a single partition that must be fully loaded in memory anyway. A
+  /// window over sorted inputs only buffers one partition at a time so it
+  /// doesn't need spilling.
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    return !partitionKeys_.empty() && !inputsSorted_ &&
+        queryConfig.windowSpillEnabled();
+  }
+
   folly::dynamic serialize() const override;
 
   static PlanNodePtr create(const folly::dynamic& obj, void* context);
@@ -2080,6 +2170,8 @@ class WindowNode : public PlanNode {
 
   const std::vector<Function> windowFunctions_;
 
+  const bool inputsSorted_;
+
   const std::vector<PlanNodePtr> sources_;
 
   const RowTypePtr outputType_;
@@ -2125,6 +2217,10 @@ class RowNumberNode : public PlanNode {
     return outputType_->size() > sources_[0]->outputType()->size();
   }
 
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    return !partitionKeys_.empty() && queryConfig.rowNumberSpillEnabled();
+  }
+
   std::string_view name() const override {
     return "RowNumber";
   }
@@ -2167,6 +2263,10 @@ class MarkDistinctNode : public PlanNode {
     return outputType_;
   }
 
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    return queryConfig.markDistinctSpillEnabled();
+  }
+
   std::string_view name() const override {
     return "MarkDistinct";
   }
@@ -2245,6 +2345,10 @@ class TopNRowNumberNode : public PlanNode {
     return outputType_->size() > sources_[0]->outputType()->size();
   }
 
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    return queryConfig.topNRowNumberSpillEnabled();
+  }
+
   std::string_view name() const override {
     return "TopNRowNumber";
   }
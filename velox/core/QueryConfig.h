@@ -37,6 +37,11 @@ class QueryConfig {
 
   static constexpr const char* kCodegenLazyLoading = "codegen.lazy_loading";
 
+  // Compiles the generated code in the background. The tasks run the
+  // interpreted expressions until the compiled ones are ready.
+  static constexpr const char* kCodegenAsyncCompilation =
+      "codegen.async_compilation";
+
   // User provided session timezone. Stores a string with the actual timezone
   // name, e.g: "America/Los_Angeles".
   static constexpr const char* kSessionTimezone = "session_timezone";
@@ -64,11 +69,52 @@ class QueryConfig {
   static constexpr const char* kExprTrackCpuUsage =
       "expression.track_cpu_usage";
 
+  /// Comma separated names of deterministic functions whose results are cached
+  /// by the values of their arguments across batches, so that repeated values
+  /// are not evaluated again. Meant for expensive functions over low
+  /// cardinality columns, e.g. regexp_extract or url_extract_host. The
+  /// arguments and the result of a cached call must be of primitive types.
+  /// Empty by default.
+  static constexpr const char* kExprValueCacheFunctions =
+      "expression.value_cache_functions";
+
+  /// Max number of distinct argument values cached per function call in an
+  /// expression. See kExprValueCacheFunctions.
+  static constexpr const char* kExprValueCacheMaxEntries =
+      "expression.value_cache_max_entries";
+
   // Whether to track CPU usage for stages of individual operators. True by
   // default. Can be expensive when processing small batches, e.g. < 10K rows.
   static constexpr const char* kOperatorTrackCpuUsage =
       "track_operator_cpu_usage";
 
+  /// Whether to count cycles, instructions, last level cache misses and
+  /// branch misses of the calls to individual operators with hardware
+  /// counters. False by default. Reading the counters is a system call per
+  /// operator call. See process::threadHardwareCounters().
+  static constexpr const char* kOperatorTrackHardwareCounters =
+      "track_operator_hardware_counters";
+
+  /// The number of most recent events kept in the trace timeline of each
+  /// task: driver on and off thread intervals, IO loads, spill writes and
+  /// memory arbitration waits. 0, the default, disables the timeline. See
+  /// Task::traceTimeline().
+  static constexpr const char* kTaskTraceTimelineCapacity =
+      "task_trace_timeline_capacity";
+
+  /// The max wall time in milliseconds that a Driver runs on an executor
+  /// thread before it yields and goes back to the executor queue. The
+  /// Driver yields between operator calls, so one call can take longer. If
+  /// it is 0, then Drivers run until blocked or out of work.
+  static constexpr const char* kDriverTimeSliceMs = "driver_time_slice_ms";
+
+  /// The relative share of the executor CPU for the Drivers of this query.
+  /// The CPU time that a task has used is divided by this share before
+  /// mapping it to an executor priority, so a query with share 2 drops
+  /// priority at twice the CPU time of a query with share 1. Only applies
+  /// to executors with more than one priority.
+  static constexpr const char* kQueryCpuShare = "query_cpu_share";
+
   // Flags used to configure the CAST operator:
 
   // This flag makes the Row conversion to by applied in a way that the casting
@@ -85,6 +131,12 @@ class QueryConfig {
   static constexpr const char* kMaxLocalExchangeBufferSize =
       "max_local_exchange_buffer_size";
 
+  /// If true, hash repartitioning local exchange copies the rows for each
+  /// destination into flat vectors of about preferred_output_batch_rows rows
+  /// instead of wrapping each input in a dictionary per destination.
+  static constexpr const char* kLocalExchangeCopyPartitions =
+      "local_exchange_copy_partitions";
+
   /// Maximum size in bytes to accumulate in ExchangeQueue. Enforced
   /// approximately, not strictly.
   static constexpr const char* kMaxExchangeBufferSize =
@@ -102,9 +154,66 @@ class QueryConfig {
   static constexpr const char* kAbandonPartialAggregationMinPct =
       "abandon_partial_aggregation_min_pct";
 
+  /// The number of input rows over which a partial aggregation estimates the
+  /// number of distinct grouping keys with a HyperLogLog, before its hash
+  /// table gets large. If the estimated percentage of unique rows is at least
+  /// 'abandon_partial_aggregation_min_pct', the partial aggregation is
+  /// abandoned right away. If it is at least half of that, the partial
+  /// aggregation continues with a small hash table that is flushed whenever
+  /// full. 0 disables the estimate.
+  static constexpr const char* kAbandonPartialAggregationSampleRows =
+      "abandon_partial_aggregation_sample_rows";
+
+  /// The number of hash table partitions a final or single aggregation inserts
+  /// into in parallel on the query executor. The input rows are partitioned on
+  /// a hash of the grouping keys. 0 or 1 inserts into a single hash table.
+  static constexpr const char* kAggregationNumParallelPartitions =
+      "aggregation_num_parallel_partitions";
+
+  /// If true, the drivers of a single aggregation in one task aggregate their
+  /// input into tables of their own and the last driver to finish merges the
+  /// tables into one final table. This replaces a partial aggregation followed
+  /// by a local exchange and a final aggregation. The merged aggregations do
+  /// not spill. Aggregations with sorted or distinct inputs or pre-grouped keys
+  /// are not merged.
+  static constexpr const char* kAggregationIntraTaskMerge =
+      "aggregation_intra_task_merge";
+
   static constexpr const char* kMaxPartitionedOutputBufferSize =
       "max_page_partitioning_buffer_size";
 
+  /// If not 0, PartitionedOutput with this many or more destinations
+  /// serializes each input one column at a time into the pages of all
+  /// destinations instead of one destination at a time.
+  static constexpr const char* kPartitionedOutputScatterMinDestinations =
+      "partitioned_output_scatter_min_destinations";
+
+  /// If true, PartitionedOutput serializes dictionary and constant columns as
+  /// dictionary and RLE blocks when all rows of the column in a page come
+  /// from the same dictionary or constant, instead of one value per row. The
+  /// consumers then get dictionary and constant vectors. Requires the Presto
+  /// serde.
+  static constexpr const char* kPartitionedOutputPreserveEncodings =
+      "partitioned_output_preserve_encodings";
+
+  /// The compression algorithm of the pages sent by PartitionedOutput and
+  /// read by Exchange and MergeExchange: none, zlib, snappy, lzo, zstd, lz4
+  /// or gzip. Producers and consumers of an exchange must use the same codec.
+  /// Requires the Presto serde.
+  static constexpr const char* kExchangeCompressionKind =
+      "exchange_compression_codec";
+
+  /// If true, PartitionedOutput sends the pages that compress poorly
+  /// uncompressed and stops trying to compress pages for a while after
+  /// several of them. Applies only if kExchangeCompressionKind is not 'none'.
+  static constexpr const char* kExchangeAdaptiveCompression =
+      "exchange_adaptive_compression";
+
+  /// Name of the named vector serde, see registerNamedVectorSerde(), that
+  /// PartitionedOutput, Exchange and MergeExchange use for pages, e.g.
+  /// 'arrow' for ArrowVectorSerde. Uses the default vector serde if empty.
+  static constexpr const char* kExchangeSerde = "exchange_serde";
+
   /// Preferred size of batches in bytes to be returned by operators from
   /// Operator::getOutput. It is used when an estimate of average row size is
   /// known. Otherwise kPreferredOutputBatchRows is used.
@@ -124,6 +233,13 @@ class QueryConfig {
   /// output rows.
   static constexpr const char* kMaxOutputBatchRows = "max_output_batch_rows";
 
+  /// If true, operators that do not know the size of their output rows up
+  /// front, e.g. HashProbe, MergeJoin and Unnest, size their output batches
+  /// by kPreferredOutputBatchBytes using the average size of the rows they
+  /// have produced so far instead of using kPreferredOutputBatchRows.
+  static constexpr const char* kAdaptiveOutputBatchSizing =
+      "adaptive_output_batch_sizing";
+
   /// If false, the 'group by' code is forced to use generic hash mode
   /// hashtable.
   static constexpr const char* kHashAdaptivityEnabled =
@@ -134,6 +250,12 @@ class QueryConfig {
   static constexpr const char* kAdaptiveFilterReorderingEnabled =
       "adaptive_filter_reordering_enabled";
 
+  /// If true, FilterProject moves the values of the rows that pass the filter
+  /// to the front of the flat projection results of primitive types instead of
+  /// wrapping these in a dictionary.
+  static constexpr const char* kFilterProjectCompactResults =
+      "filter_project_compact_results";
+
   /// Global enable spilling flag.
   static constexpr const char* kSpillEnabled = "spill_enabled";
 
@@ -141,12 +263,57 @@ class QueryConfig {
   static constexpr const char* kAggregationSpillEnabled =
       "aggregation_spill_enabled";
 
+  /// Partial aggregation spilling flag, only applies if "spill_enabled" and
+  /// "aggregation_spill_enabled" flags are set. If true, a partial
+  /// aggregation that reaches its memory limit spills its accumulators and
+  /// merges them at the end of input instead of flushing partial results or
+  /// abandoning the aggregation.
+  static constexpr const char* kPartialAggregationSpillEnabled =
+      "partial_aggregation_spill_enabled";
+
   /// Join spilling flag, only applies if "spill_enabled" flag is set.
   static constexpr const char* kJoinSpillEnabled = "join_spill_enabled";
 
   /// OrderBy spilling flag, only applies if "spill_enabled" flag is set.
   static constexpr const char* kOrderBySpillEnabled = "order_by_spill_enabled";
 
+  /// Window spilling flag, only applies if "spill_enabled" flag is set.
+  static constexpr const char* kWindowSpillEnabled = "window_spill_enabled";
+
+  /// TopN spilling flag, only applies if "spill_enabled" flag is set.
+  static constexpr const char* kTopNSpillEnabled = "topn_spill_enabled";
+
+  /// TopNRowNumber spilling flag, only applies if "spill_enabled" flag is set.
+  static constexpr const char* kTopNRowNumberSpillEnabled =
+      "topn_row_number_spill_enabled";
+
+  /// RowNumber spilling flag, only applies if "spill_enabled" flag is set.
+  static constexpr const char* kRowNumberSpillEnabled =
+      "row_number_spill_enabled";
+
+  /// MarkDistinct spilling flag, only applies if "spill_enabled" flag is set.
+  static constexpr const char* kMarkDistinctSpillEnabled =
+      "mark_distinct_spill_enabled";
+
+  /// NestedLoopJoin spilling flag, only applies if "spill_enabled" flag is set.
+  static constexpr const char* kNestedLoopJoinSpillEnabled =
+      "nested_loop_join_spill_enabled";
+
+  /// MergeJoin spilling flag, only applies if "spill_enabled" flag is set.
+  static constexpr const char* kMergeJoinSpillEnabled =
+      "merge_join_spill_enabled";
+
+  /// PartitionedOutput spilling flag, only applies if "spill_enabled" flag is
+  /// set. If true, the output buffer of a task writes unacknowledged pages to
+  /// disk instead of blocking its producers when it is full.
+  static constexpr const char* kPartitionedOutputSpillEnabled =
+      "partitioned_output_spill_enabled";
+
+  /// TableWriter memory reclaim flag, only applies if "spill_enabled" flag is
+  /// set. If true, the memory arbitrator can reclaim memory from a table
+  /// writer by flushing the buffered data of its file writers early.
+  static constexpr const char* kWriterSpillEnabled = "writer_spill_enabled";
+
   /// The max memory that a final aggregation can use before spilling. If it 0,
   /// then there is no limit.
   static constexpr const char* kAggregationSpillMemoryThreshold =
@@ -162,6 +329,23 @@ class QueryConfig {
   static constexpr const char* kOrderBySpillMemoryThreshold =
       "order_by_spill_memory_threshold";
 
+  /// The max memory that a nested loop join build operator can use to buffer
+  /// the build side data before spilling. If it 0, then there is no limit.
+  static constexpr const char* kNestedLoopJoinSpillMemoryThreshold =
+      "nested_loop_join_spill_memory_threshold";
+
+  /// The max memory that a nested loop join probe operator uses to load the
+  /// spilled build side data. The probe side makes one pass over the spilled
+  /// build side data for each probe input, loading this much at a time.
+  static constexpr const char* kNestedLoopJoinSpillReadBufferSize =
+      "nested_loop_join_spill_read_buffer_size";
+
+  /// The max memory that a merge join operator can use to buffer the right
+  /// side rows that match the current join key before spilling them. If it 0,
+  /// then there is no limit.
+  static constexpr const char* kMergeJoinSpillMemoryThreshold =
+      "merge_join_spill_memory_threshold";
+
   static constexpr const char* kTestingSpillPct = "testing.spill_pct";
 
   /// The max allowed spilling level with zero being the initial spilling level.
@@ -194,6 +378,26 @@ class QueryConfig {
   static constexpr const char* kJoinSpillPartitionBits =
       "join_spiller_partition_bits";
 
+  /// The min fraction of the build side rows of a hash join that a single
+  /// join key must account for to be treated as a skewed key when spilling.
+  /// The spill partitions with skewed keys are kept in memory and only
+  /// spilled if spilling the other partitions does not free enough memory.
+  /// This keeps the matching probe rows of the skewed keys from being
+  /// spilled into a single partition. If it is 0, then there is no skewed
+  /// key detection.
+  static constexpr const char* kJoinSpillSkewedKeyFraction =
+      "join_spill_skewed_key_fraction";
+
+  /// The max size in bytes of the spill files in a block of a hash join spill
+  /// partition that can not be split further, either because of the max spill
+  /// level or because of a skewed key. Such a partition is joined one block
+  /// at a time, each block probed with all the probe rows of the partition,
+  /// instead of building one hash table from all of it. Only applies to inner,
+  /// right and right semi joins. If it is 0, then the partition is restored
+  /// as a whole.
+  static constexpr const char* kJoinSpillFallbackBlockSize =
+      "join_spill_fallback_block_size";
+
   static constexpr const char* kAggregationSpillPartitionBits =
       "aggregation_spiller_partition_bits";
 
@@ -238,6 +442,59 @@ class QueryConfig {
   static constexpr const char* kMinTableRowsForParallelJoinBuild =
       "min_table_rows_for_parallel_join_build";
 
+  /// The min number of entries of a group by hash table from which growing
+  /// the table moves the entries to the new table a slice at a time during
+  /// the following inputs instead of all at once. This avoids long pauses in
+  /// large aggregations but keeps the old table until all entries are moved.
+  /// 0 disables the incremental rehash.
+  static constexpr const char* kMinTableSizeForIncrementalRehash =
+      "min_table_size_for_incremental_rehash";
+
+  /// If not 0, a final aggregation moves the variable length data of its
+  /// groups, e.g. strings and array_agg or map_agg accumulators, to a new
+  /// arena once at least this percentage of the arena is free. This gives
+  /// its memory back when updates of variable width accumulators leave free
+  /// blocks that are too small for new data.
+  static constexpr const char* kAggregationCompactionFreePct =
+      "aggregation_compaction_free_pct";
+
+  /// The min size of the variable length data of a final aggregation for
+  /// compacting it. See kAggregationCompactionFreePct.
+  static constexpr const char* kAggregationCompactionMinBytes =
+      "aggregation_compaction_min_bytes";
+
+  /// If true, hash join build sides store the values of fixed width non-key
+  /// columns column-wise in blocks instead of in the rows. This makes the
+  /// rows of wide build sides smaller and extracting the build side columns
+  /// of the probe output reads only the values of the projected columns.
+  static constexpr const char* kHashJoinColumnarDependents =
+      "hash_join_columnar_dependents";
+
+  /// If true, the hash tables of aggregations and hash join build sides
+  /// store each distinct string key value once and the rows refer to the
+  /// shared copy. Saves memory and copying when string keys repeat, e.g.
+  /// for the build side of a join with many matches per key.
+  static constexpr const char* kInternStringKeys = "intern_string_keys";
+
+  /// The max size in bytes of a bloom filter built on a hash join key to push
+  /// down into the probe side table scan. The bloom filters are built for the
+  /// join keys that can't be pushed down as a range or a list of values. No
+  /// bloom filter is built if it would exceed this size. 0 disables the bloom
+  /// filter push down.
+  static constexpr const char* kHashJoinBloomFilterMaxSize =
+      "hash_join_bloom_filter_max_size";
+
+  /// The target false positive rate of the hash join bloom filters. Used to
+  /// size the bloom filters from the number of distinct join keys.
+  static constexpr const char* kHashJoinBloomFilterFalsePositiveRate =
+      "hash_join_bloom_filter_false_positive_rate";
+
+  /// The min number of rows of a window partition from which the Window
+  /// operator evaluates the window functions of the partition in parallel on
+  /// the query executor, one function per thread. 0 disables it.
+  static constexpr const char* kWindowParallelFunctionsMinRows =
+      "window_parallel_functions_min_rows";
+
   uint64_t maxPartialAggregationMemoryUsage() const {
     static constexpr uint64_t kDefault = 1L << 24;
     return get<uint64_t>(kMaxPartialAggregationMemory, kDefault);
@@ -256,6 +513,18 @@ class QueryConfig {
     return get<int32_t>(kAbandonPartialAggregationMinPct, 80);
   }
 
+  int32_t abandonPartialAggregationSampleRows() const {
+    return get<int32_t>(kAbandonPartialAggregationSampleRows, 0);
+  }
+
+  int32_t aggregationNumParallelPartitions() const {
+    return get<int32_t>(kAggregationNumParallelPartitions, 0);
+  }
+
+  bool aggregationIntraTaskMerge() const {
+    return get<bool>(kAggregationIntraTaskMerge, false);
+  }
+
   uint64_t aggregationSpillMemoryThreshold() const {
     static constexpr uint64_t kDefault = 0;
     return get<uint64_t>(kAggregationSpillMemoryThreshold, kDefault);
@@ -271,6 +540,21 @@ class QueryConfig {
     return get<uint64_t>(kOrderBySpillMemoryThreshold, kDefault);
   }
 
+  uint64_t nestedLoopJoinSpillMemoryThreshold() const {
+    static constexpr uint64_t kDefault = 0;
+    return get<uint64_t>(kNestedLoopJoinSpillMemoryThreshold, kDefault);
+  }
+
+  uint64_t nestedLoopJoinSpillReadBufferSize() const {
+    static constexpr uint64_t kDefault = 64UL << 20;
+    return get<uint64_t>(kNestedLoopJoinSpillReadBufferSize, kDefault);
+  }
+
+  uint64_t mergeJoinSpillMemoryThreshold() const {
+    static constexpr uint64_t kDefault = 0;
+    return get<uint64_t>(kMergeJoinSpillMemoryThreshold, kDefault);
+  }
+
   // Returns the target size for a Task's buffered output. The
   // producer Drivers are blocked when the buffered size exceeds
   // this. The Drivers are resumed when the buffered size goes below
@@ -280,11 +564,37 @@ class QueryConfig {
     return get<uint64_t>(kMaxPartitionedOutputBufferSize, kDefault);
   }
 
+  /// Returns the minimum number of destinations for which PartitionedOutput
+  /// serializes column by column into all destinations. 0 disables this.
+  int32_t partitionedOutputScatterMinDestinations() const {
+    return get<int32_t>(kPartitionedOutputScatterMinDestinations, 0);
+  }
+
+  bool partitionedOutputPreserveEncodings() const {
+    return get<bool>(kPartitionedOutputPreserveEncodings, false);
+  }
+
+  std::string exchangeCompressionKind() const {
+    return get<std::string>(kExchangeCompressionKind, "none");
+  }
+
+  bool exchangeAdaptiveCompression() const {
+    return get<bool>(kExchangeAdaptiveCompression, false);
+  }
+
+  std::string exchangeSerde() const {
+    return get<std::string>(kExchangeSerde, "");
+  }
+
   uint64_t maxLocalExchangeBufferSize() const {
     static constexpr uint64_t kDefault = 32UL << 20;
     return get<uint64_t>(kMaxLocalExchangeBufferSize, kDefault);
   }
 
+  bool localExchangeCopyPartitions() const {
+    return get<bool>(kLocalExchangeCopyPartitions, false);
+  }
+
   uint64_t maxExchangeBufferSize() const {
     static constexpr uint64_t kDefault = 32UL << 20;
     return get<uint64_t>(kMaxExchangeBufferSize, kDefault);
@@ -303,6 +613,10 @@ class QueryConfig {
     return get<uint32_t>(kMaxOutputBatchRows, 10'000);
   }
 
+  bool adaptiveOutputBatchSizing() const {
+    return get<bool>(kAdaptiveOutputBatchSizing, false);
+  }
+
   bool hashAdaptivityEnabled() const {
     return get<bool>(kHashAdaptivityEnabled, true);
   }
@@ -321,6 +635,10 @@ class QueryConfig {
     return get<bool>(kAdaptiveFilterReorderingEnabled, true);
   }
 
+  bool filterProjectCompactResults() const {
+    return get<bool>(kFilterProjectCompactResults, false);
+  }
+
   bool isMatchStructByName() const {
     return get<bool>(kCastMatchStructByName, false);
   }
@@ -341,6 +659,10 @@ class QueryConfig {
     return get<bool>(kCodegenLazyLoading, true);
   }
 
+  bool codegenAsyncCompilation() const {
+    return get<bool>(kCodegenAsyncCompilation, false);
+  }
+
   bool adjustTimestampToTimezone() const {
     return get<bool>(kAdjustTimestampToTimezone, false);
   }
@@ -364,6 +686,12 @@ class QueryConfig {
     return get<bool>(kAggregationSpillEnabled, true);
   }
 
+  /// Returns 'is partial aggregation spilling enabled' flag. Must also check
+  /// the spillEnabled() and aggregationSpillEnabled()!
+  bool partialAggregationSpillEnabled() const {
+    return get<bool>(kPartialAggregationSpillEnabled, false);
+  }
+
   /// Returns 'is join spilling enabled' flag. Must also check the
   /// spillEnabled()!
   bool joinSpillEnabled() const {
@@ -376,6 +704,60 @@ class QueryConfig {
     return get<bool>(kOrderBySpillEnabled, true);
   }
 
+  /// Returns 'is window spilling enabled' flag. Must also check the
+  /// spillEnabled()!
+  bool windowSpillEnabled() const {
+    return get<bool>(kWindowSpillEnabled, true);
+  }
+
+  /// Returns 'is topN spilling enabled' flag. Must also check the
+  /// spillEnabled()!
+  bool topNSpillEnabled() const {
+    return get<bool>(kTopNSpillEnabled, true);
+  }
+
+  /// Returns 'is topN row number spilling enabled' flag. Must also check the
+  /// spillEnabled()!
+  bool topNRowNumberSpillEnabled() const {
+    return get<bool>(kTopNRowNumberSpillEnabled, true);
+  }
+
+  /// Returns 'is row number spilling enabled' flag. Must also check the
+  /// spillEnabled()!
+  bool rowNumberSpillEnabled() const {
+    return get<bool>(kRowNumberSpillEnabled, true);
+  }
+
+  /// Returns 'is mark distinct spilling enabled' flag. Must also check the
+  /// spillEnabled()!
+  bool markDistinctSpillEnabled() const {
+    return get<bool>(kMarkDistinctSpillEnabled, true);
+  }
+
+  /// Returns 'is nested loop join spilling enabled' flag. Must also check the
+  /// spillEnabled()!
+  bool nestedLoopJoinSpillEnabled() const {
+    return get<bool>(kNestedLoopJoinSpillEnabled, true);
+  }
+
+  /// Returns 'is merge join spilling enabled' flag. Must also check the
+  /// spillEnabled()!
+  bool mergeJoinSpillEnabled() const {
+    return get<bool>(kMergeJoinSpillEnabled, true);
+  }
+
+  /// Returns 'is partitioned output spilling enabled' flag. Must also check
+  /// the spillEnabled()!
+  bool partitionedOutputSpillEnabled() const {
+    return get<bool>(kPartitionedOutputSpillEnabled, true);
+  }
+
+  /// Returns 'is table writer memory reclaim enabled' flag. Must also check
+  /// the spillEnabled()!
+  bool writerSpillEnabled() const {
+    return get<bool>(kWriterSpillEnabled, true);
+  }
+
   // Returns a percentage of aggregation or join input batches that
   // will be forced to spill for testing. 0 means no extra spilling.
   int32_t testingSpillPct() const {
@@ -407,6 +789,17 @@ class QueryConfig {
         kMaxBits, get<uint8_t>(kJoinSpillPartitionBits, kDefaultBits));
   }
 
+  double joinSpillSkewedKeyFraction() const {
+    static constexpr double kDefault = 0.1;
+    return get<double>(kJoinSpillSkewedKeyFraction, kDefault);
+  }
+
+  uint64_t joinSpillFallbackBlockSize() const {
+    static constexpr uint64_t kDefault = 256UL << 20;
+    return get<uint64_t>(kJoinSpillFallbackBlockSize, kDefault);
+  }
+
+
   /// Returns the number of bits used to calculate the spilling partition
   /// number for hash join. The number of spilling partitions will be power of
   /// two.
@@ -478,10 +871,34 @@ class QueryConfig {
     return get<bool>(kExprTrackCpuUsage, false);
   }
 
+  std::string exprValueCacheFunctions() const {
+    return get<std::string>(kExprValueCacheFunctions, "");
+  }
+
+  uint32_t exprValueCacheMaxEntries() const {
+    return get<uint32_t>(kExprValueCacheMaxEntries, 10'000);
+  }
+
   bool operatorTrackCpuUsage() const {
     return get<bool>(kOperatorTrackCpuUsage, true);
   }
 
+  bool operatorTrackHardwareCounters() const {
+    return get<bool>(kOperatorTrackHardwareCounters, false);
+  }
+
+  uint32_t taskTraceTimelineCapacity() const {
+    return get<uint32_t>(kTaskTraceTimelineCapacity, 0);
+  }
+
+  uint64_t driverTimeSliceMs() const {
+    return get<uint64_t>(kDriverTimeSliceMs, 0);
+  }
+
+  double queryCpuShare() const {
+    return get<double>(kQueryCpuShare, 1.0);
+  }
+
   uint32_t taskWriterCount() const {
     return get<uint32_t>(kTaskWriterCount, 4);
   }
@@ -499,6 +916,40 @@ class QueryConfig {
     return get<uint32_t>(kMinTableRowsForParallelJoinBuild, 1'000);
   }
 
+  uint64_t minTableSizeForIncrementalRehash() const {
+    return get<uint64_t>(kMinTableSizeForIncrementalRehash, 0);
+  }
+
+  int32_t aggregationCompactionFreePct() const {
+    return get<int32_t>(kAggregationCompactionFreePct, 0);
+  }
+
+  uint64_t aggregationCompactionMinBytes() const {
+    static constexpr uint64_t kDefault = 64UL << 20;
+    return get<uint64_t>(kAggregationCompactionMinBytes, kDefault);
+  }
+
+  bool hashJoinColumnarDependents() const {
+    return get<bool>(kHashJoinColumnarDependents, false);
+  }
+
+  bool internStringKeys() const {
+    return get<bool>(kInternStringKeys, false);
+  }
+
+  uint64_t hashJoinBloomFilterMaxSize() const {
+    static constexpr uint64_t kDefault = 8UL << 20;
+    return get<uint64_t>(kHashJoinBloomFilterMaxSize, kDefault);
+  }
+
+  double hashJoinBloomFilterFalsePositiveRate() const {
+    return get<double>(kHashJoinBloomFilterFalsePositiveRate, 0.03);
+  }
+
+  int32_t windowParallelFunctionsMinRows() const {
+    return get<int32_t>(kWindowParallelFunctionsMinRows, 0);
+  }
+
   template <typename T>
   T get(const std::string& key, const T& defaultValue) const {
     return config_->get<T>(key, defaultValue);
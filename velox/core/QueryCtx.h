@@ -16,6 +16,8 @@
 #pragma once
 
 #include <folly/Executor.h>
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
 #include <folly/executors/CPUThreadPoolExecutor.h>
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/memory/Memory.h"
@@ -116,6 +118,26 @@ class QueryCtx {
     pool_ = std::move(pool);
   }
 
+  /// Records the evaluation order of the inputs of the AND or OR expression
+  /// 'key' learned by adaptive filter reordering, so that the expressions
+  /// compiled later for the query, e.g. by other drivers or for the next
+  /// splits, start with it instead of the order in the plan.
+  void setConjunctOrder(const std::string& key, std::vector<int32_t> order) {
+    conjunctOrders_.wlock()->insert_or_assign(key, std::move(order));
+  }
+
+  /// Returns the order recorded by setConjunctOrder() for 'key' or
+  /// std::nullopt if none.
+  std::optional<std::vector<int32_t>> conjunctOrder(
+      const std::string& key) const {
+    auto orders = conjunctOrders_.rlock();
+    auto it = orders->find(key);
+    if (it == orders->end()) {
+      return std::nullopt;
+    }
+    return it->second;
+  }
+
  private:
   static Config* getEmptyConfig() {
     static const std::unique_ptr<Config> kEmptyConfig =
@@ -139,6 +161,8 @@ class QueryCtx {
   folly::Executor::KeepAlive<> executorKeepalive_;
   QueryConfig queryConfig_;
   std::shared_ptr<folly::Executor> spillExecutor_;
+  folly::Synchronized<folly::F14FastMap<std::string, std::vector<int32_t>>>
+      conjunctOrders_;
 };
 
 // Represents the state of one thread of query execution.
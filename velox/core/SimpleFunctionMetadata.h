@@ -19,6 +19,7 @@
 #include <folly/Likely.h>
 
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/base/Status.h"
 #include "velox/core/CoreTypeSystem.h"
 #include "velox/core/Metaprogramming.h"
 #include "velox/core/QueryConfig.h"
@@ -458,6 +459,8 @@ template <typename Fun, typename Exec, typename TReturn, typename... TArgs>
 class UDFHolder final
     : public core::SimpleFunctionMetadata<Fun, TReturn, TArgs...> {
   Fun instance_;
+  // Error of the last call() that returned a Status.
+  Status status_;
 
  public:
   using udf_struct_t = Fun;
@@ -494,12 +497,13 @@ class UDFHolder final
   // Check which flavor of the call() method is provided by the UDF object. UDFs
   // are required to provide at least one of the following methods:
   //
-  // - bool|void call(...)
+  // - bool|void|Status call(...)
   // - bool|void callNullable(...)
   // - bool|void callNullFree(...)
   //
   // Each of these methods can return either bool or void. Returning void means
-  // that the UDF is assumed never to return null values.
+  // that the UDF is assumed never to return null values. call() can also
+  // return a Status to report an error for the row without throwing.
   //
   // Optionally, UDFs can also provide the following methods:
   //
@@ -519,11 +523,19 @@ class UDFHolder final
       void,
       exec_return_type,
       const exec_arg_type<TArgs>&...>::value;
-  static constexpr bool udf_has_call =
-      udf_has_call_return_bool | udf_has_call_return_void;
+  static constexpr bool udf_has_call_return_status = util::has_method<
+      Fun,
+      call_method_resolver,
+      Status,
+      exec_return_type,
+      const exec_arg_type<TArgs>&...>::value;
+  static constexpr bool udf_has_call = udf_has_call_return_bool |
+      udf_has_call_return_void | udf_has_call_return_status;
   static_assert(
-      !(udf_has_call_return_bool && udf_has_call_return_void),
-      "Provided call() methods need to return either void OR bool.");
+      udf_has_call_return_bool + udf_has_call_return_void +
+              udf_has_call_return_status <=
+          1,
+      "Provided call() methods need to return either void, bool OR Status.");
 
   // callNullable():
   static constexpr bool udf_has_callNullable_return_bool = util::has_method<
@@ -620,7 +632,7 @@ class UDFHolder final
   // a function return void.
   static constexpr bool can_produce_null_output = udf_has_call_return_bool |
       udf_has_callNullable_return_bool | udf_has_callNullFree_return_bool |
-      udf_has_callAscii_return_bool;
+      udf_has_callAscii_return_bool | udf_has_call_return_status;
 
   // This is true when callNullFree is implemented, but not call or
   // callNullable. In this case if any input is NULL or any complex type in
@@ -714,6 +726,24 @@ class UDFHolder final
     }
   }
 
+  // Returns true if the last call() returned an error Status. The result of
+  // that call() is null.
+  FOLLY_ALWAYS_INLINE bool hasError() const {
+    return !status_.ok();
+  }
+
+  // Returns and clears the error of the last call().
+  Status takeStatus() {
+    return std::move(status_);
+  }
+
+  // Forwards to the callBatch() of the UDF. See udf_has_call_batch in
+  // SimpleFunctionAdapter.h.
+  template <typename... TValues>
+  FOLLY_ALWAYS_INLINE void callBatch(TValues... values) {
+    instance_.callBatch(values...);
+  }
+
   // Helper functions to handle void vs bool return type.
 
   FOLLY_ALWAYS_INLINE bool callImpl(
@@ -722,6 +752,13 @@ class UDFHolder final
     static_assert(udf_has_call);
     if constexpr (udf_has_call_return_bool) {
       return instance_.call(out, args...);
+    } else if constexpr (udf_has_call_return_status) {
+      auto status = instance_.call(out, args...);
+      if (UNLIKELY(!status.ok())) {
+        status_ = std::move(status);
+        return false;
+      }
+      return true;
     } else {
       instance_.call(out, args...);
       return true;
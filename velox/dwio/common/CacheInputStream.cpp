@@ -197,6 +197,7 @@ void CacheInputStream::loadSync(Region region) {
       // missed, fall back to remote fetching.
       entry->setGroupId(groupId_);
       entry->setTrackingId(trackingId_);
+      entry->setScanOnce(tracker_ && tracker_->scanOnce());
       if (loadFromSsd(region, *entry)) {
         return;
       }
@@ -232,7 +233,7 @@ bool CacheInputStream::loadFromSsd(
   if (ssdPin.empty()) {
     return false;
   }
-  if (ssdPin.run().size() < entry.size()) {
+  if (!ssdPin.run().covers(entry.size())) {
     LOG(INFO) << fmt::format(
         "IOERR: Ssd entry for {} shorter than requested {}",
         entry.toString(),
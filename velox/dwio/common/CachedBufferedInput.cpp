@@ -17,6 +17,8 @@
 #include "velox/dwio/common/CachedBufferedInput.h"
 #include "velox/common/memory/Allocation.h"
 #include "velox/common/process/TraceContext.h"
+#include "velox/common/process/TraceTimeline.h"
+#include "velox/common/time/Timer.h"
 #include "velox/dwio/common/CacheInputStream.h"
 
 DEFINE_int32(
@@ -180,6 +182,13 @@ void CachedBufferedInput::load(const LogType) {
           request.trackingId.id() == StreamIdentifier::sequentialFile().id_;
       if (!prefetchAnyway && tracker_) {
         trackingData = tracker_->trackingData(request.trackingId);
+        // A scan that has not yet seen the stream uses the stats of previous
+        // scans of the same file group. This prefetches the streams that are
+        // commonly read, e.g. from SSD after a restart.
+        auto* groupStats = tracker_->fileGroupStats();
+        if (groupStats && trackingData.numReferences < 2) {
+          trackingData = groupStats->trackingData(groupId_, request.trackingId);
+        }
       }
       if (prefetchAnyway || adjustedReadPct(trackingData) >= readPct) {
         request.processed = true;
@@ -192,7 +201,7 @@ void CachedBufferedInput::load(const LogType) {
           if (ssdFile) {
             part->ssdPin = ssdFile->find(part->key);
             if (!part->ssdPin.empty() &&
-                part->ssdPin.run().size() < part->size) {
+                !part->ssdPin.run().covers(part->size)) {
               LOG(INFO) << "IOERR: Ignoring SSD shorter than requested: "
                         << part->ssdPin.run().size() << " vs " << part->size;
               part->ssdPin.clear();
@@ -218,7 +227,7 @@ void CachedBufferedInput::makeLoads(
     return;
   }
   bool isSsd = !requests[0]->ssdPin.empty();
-  int32_t maxDistance = isSsd ? 20000 : options_.maxCoalesceDistance();
+  int32_t maxDistance = isSsd ? 20000 : coalesceDistance();
   std::sort(
       requests.begin(),
       requests.end(),
@@ -272,8 +281,10 @@ void CachedBufferedInput::makeLoads(
       auto& load = allCoalescedLoads_[i];
       if (load->state() == LoadState::kPlanned) {
         prefetchSize_ += load->size();
-        executor_->add([pendingLoad = load]() {
+        executor_->add([pendingLoad = load,
+                        timeline = process::TraceTimeline::current()]() {
           process::TraceContext trace("Read Ahead");
+          process::ScopedTraceTimeline scopedTimeline(timeline);
           pendingLoad->loadOrFuture(nullptr);
         });
       } else {
@@ -297,11 +308,13 @@ class DwioCoalescedLoadBase : public cache::CoalescedLoad {
       cache::AsyncDataCache& cache,
       std::shared_ptr<IoStatistics> ioStats,
       uint64_t groupId,
-      std::vector<CacheRequest*> requests)
+      std::vector<CacheRequest*> requests,
+      bool scanOnce)
       : CoalescedLoad(makeKeys(requests), makeSizes(requests)),
         cache_(cache),
         ioStats_(std::move(ioStats)),
-        groupId_(groupId) {
+        groupId_(groupId),
+        scanOnce_(scanOnce) {
     for (auto& request : requests) {
       size_ += request->size;
       requests_.push_back(std::move(*request));
@@ -369,6 +382,8 @@ class DwioCoalescedLoadBase : public cache::CoalescedLoad {
   std::vector<CacheRequest> requests_;
   std::shared_ptr<IoStatistics> ioStats_;
   const uint64_t groupId_;
+  // True if the entries are loaded for a scan that reads its data once.
+  const bool scanOnce_;
   int64_t size_{0};
 };
 
@@ -381,8 +396,14 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
       std::shared_ptr<IoStatistics> ioStats,
       uint64_t groupId,
       std::vector<CacheRequest*> requests,
+      bool scanOnce,
       int32_t maxCoalesceDistance)
-      : DwioCoalescedLoadBase(cache, ioStats, groupId, std::move(requests)),
+      : DwioCoalescedLoadBase(
+            cache,
+            ioStats,
+            groupId,
+            std::move(requests),
+            scanOnce),
         input_(std::move(input)),
         maxCoalesceDistance_(maxCoalesceDistance) {}
 
@@ -396,6 +417,7 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
           if (isPrefetch) {
             pin.checkedEntry()->setPrefetch(true);
           }
+          pin.checkedEntry()->setScanOnce(scanOnce_);
           pins.push_back(std::move(pin));
         });
     if (pins.empty()) {
@@ -411,7 +433,18 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
             int32_t /*end*/,
             uint64_t offset,
             const std::vector<folly::Range<char*>>& buffers) {
-          input_->read(buffers, offset, LogType::FILE);
+          uint64_t usec = 0;
+          {
+            MicrosecondTimer timer(&usec);
+            input_->read(buffers, offset, LogType::FILE);
+          }
+          if (ioStats_) {
+            uint64_t bytes = 0;
+            for (const auto& buffer : buffers) {
+              bytes += buffer.size();
+            }
+            ioStats_->storageCostModel().recordRead(bytes, usec);
+          }
         });
     updateStats(stats, isPrefetch, false);
     return pins;
@@ -428,8 +461,14 @@ class SsdLoad : public DwioCoalescedLoadBase {
       cache::AsyncDataCache& cache,
       std::shared_ptr<IoStatistics> ioStats,
       uint64_t groupId,
-      std::vector<CacheRequest*> requests)
-      : DwioCoalescedLoadBase(cache, ioStats, groupId, std::move(requests)) {}
+      std::vector<CacheRequest*> requests,
+      bool scanOnce)
+      : DwioCoalescedLoadBase(
+            cache,
+            ioStats,
+            groupId,
+            std::move(requests),
+            scanOnce) {}
 
   std::vector<CachePin> loadData(bool isPrefetch) override {
     std::vector<SsdPin> ssdPins;
@@ -441,6 +480,7 @@ class SsdLoad : public DwioCoalescedLoadBase {
           if (isPrefetch) {
             pin.checkedEntry()->setPrefetch(true);
           }
+          pin.checkedEntry()->setScanOnce(scanOnce_);
           pins.push_back(std::move(pin));
           ssdPins.push_back(std::move(requests_[index].ssdPin));
         });
@@ -463,8 +503,10 @@ void CachedBufferedInput::readRegion(
     return;
   }
   std::shared_ptr<cache::CoalescedLoad> load;
+  const bool scanOnce = tracker_ && tracker_->scanOnce();
   if (!requests[0]->ssdPin.empty()) {
-    load = std::make_shared<SsdLoad>(*cache_, ioStats_, groupId_, requests);
+    load = std::make_shared<SsdLoad>(
+        *cache_, ioStats_, groupId_, requests, scanOnce);
   } else {
     load = std::make_shared<DwioCoalescedLoad>(
         *cache_,
@@ -472,7 +514,8 @@ void CachedBufferedInput::readRegion(
         ioStats_,
         groupId_,
         requests,
-        options_.maxCoalesceDistance());
+        scanOnce,
+        coalesceDistance());
   }
   allCoalescedLoads_.push_back(load);
   coalescedLoads_.withWLock([&](auto& loads) {
@@ -482,6 +525,26 @@ void CachedBufferedInput::readRegion(
   });
 }
 
+int32_t CachedBufferedInput::coalesceDistance() const {
+  const int32_t configured = options_.maxCoalesceDistance();
+  if (!options_.adaptiveCoalesce() || !ioStats_) {
+    return configured;
+  }
+  const auto breakEven = ioStats_->storageCostModel().breakEvenBytes();
+  if (!breakEven.has_value()) {
+    return configured;
+  }
+  // A gap is worth reading if its transfer is cheaper than the latency of
+  // another request. The gap is bounded by half of a coalesced load so that
+  // some of each load is payload.
+  return std::max<int64_t>(
+      configured,
+      std::min<int64_t>(
+          {static_cast<int64_t>(breakEven.value()),
+           options_.maxCoalesceBytes() / 2,
+           std::numeric_limits<int32_t>::max()}));
+}
+
 std::shared_ptr<cache::CoalescedLoad> CachedBufferedInput::coalescedLoad(
     const SeekableInputStream* stream) {
   return coalescedLoads_.withWLock(
@@ -175,6 +175,11 @@ class CachedBufferedInput : public BufferedInput {
 
   void readRegion(std::vector<CacheRequest*> requests, bool prefetch);
 
+  // Returns the largest gap between requests to read in the same IO. This is
+  // the configured distance or, if 'ioStats_' has measured the storage, the
+  // gap whose transfer takes as long as the latency of a request.
+  int32_t coalesceDistance() const;
+
   cache::AsyncDataCache* FOLLY_NONNULL cache_;
   const uint64_t fileNum_;
   std::shared_ptr<cache::ScanTracker> tracker_;
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FileMetadataCache.h"
+
+#include <fmt/format.h>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::dwio::common {
+
+std::string FileMetadataCache::Stats::toString() const {
+  return fmt::format(
+      "FileMetadataCache: {} entries, {} bytes, {} hits, {} misses, "
+      "{} evictions, hit rate {:.2f}",
+      numEntries,
+      cachedBytes,
+      numHits,
+      numMisses,
+      numEvictions,
+      hitRate());
+}
+
+FileMetadataCache::FileMetadataCache(
+    uint64_t capacityBytes,
+    std::shared_ptr<memory::MemoryPool> pool)
+    : capacityBytes_(capacityBytes),
+      pool_(
+          pool ? std::move(pool)
+               : memory::defaultMemoryManager().addLeafPool(
+                     "FileMetadataCache")) {}
+
+// static
+FileMetadataCache* FileMetadataCache::getInstance() {
+  return *getInstancePtr();
+}
+
+// static
+void FileMetadataCache::setInstance(FileMetadataCache* cache) {
+  *getInstancePtr() = cache;
+}
+
+// static
+FileMetadataCache** FileMetadataCache::getInstancePtr() {
+  static FileMetadataCache* cache_{nullptr};
+  return &cache_;
+}
+
+std::shared_ptr<const FileMetadata> FileMetadataCache::find(
+    const FileMetadataKey& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    ++numMisses_;
+    return nullptr;
+  }
+  ++numHits_;
+  lru_.splice(lru_.begin(), lru_, it->second);
+  return it->second->second;
+}
+
+void FileMetadataCache::put(
+    const FileMetadataKey& key,
+    std::shared_ptr<const FileMetadata> metadata) {
+  VELOX_CHECK_NOT_NULL(metadata);
+  const auto bytes = metadata->sizeBytes();
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(key);
+  if (it != entries_.end()) {
+    removeLocked(it->second);
+  }
+  if (bytes > capacityBytes_) {
+    return;
+  }
+  while (cachedBytes_ + bytes > capacityBytes_) {
+    removeLocked(std::prev(lru_.end()));
+    ++numEvictions_;
+  }
+  lru_.emplace_front(key, std::move(metadata));
+  entries_[key] = lru_.begin();
+  cachedBytes_ += bytes;
+}
+
+void FileMetadataCache::removeLocked(std::list<Entry>::iterator it) {
+  cachedBytes_ -= it->second->sizeBytes();
+  entries_.erase(it->first);
+  lru_.erase(it);
+}
+
+void FileMetadataCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  entries_.clear();
+  lru_.clear();
+  cachedBytes_ = 0;
+}
+
+FileMetadataCache::Stats FileMetadataCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  Stats stats;
+  stats.numHits = numHits_;
+  stats.numMisses = numMisses_;
+  stats.numEvictions = numEvictions_;
+  stats.numEntries = entries_.size();
+  stats.cachedBytes = cachedBytes_;
+  return stats;
+}
+
+} // namespace facebook::velox::dwio::common
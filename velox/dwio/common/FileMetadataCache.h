@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include <folly/container/F14Map.h>
+#include <folly/hash/Hash.h>
+
+#include "velox/common/memory/Memory.h"
+
+namespace facebook::velox::dwio::common {
+
+/// Identifies a version of a file. A file that is rewritten with a different
+/// size or modification time gets a different key.
+struct FileMetadataKey {
+  std::string fileName;
+  uint64_t fileSize{0};
+  /// 0 if not known to the reader.
+  int64_t modificationTime{0};
+
+  bool operator==(const FileMetadataKey& other) const {
+    return fileName == other.fileName && fileSize == other.fileSize &&
+        modificationTime == other.modificationTime;
+  }
+};
+
+struct FileMetadataKeyHasher {
+  size_t operator()(const FileMetadataKey& key) const {
+    return folly::hash::hash_combine(
+        key.fileName, key.fileSize, key.modificationTime);
+  }
+};
+
+/// The parsed footer of a file, e.g. the PostScript and Footer of a DWRF
+/// file or the FileMetaData of a Parquet file. Immutable once cached, so that
+/// it can be shared by all readers of the file.
+class FileMetadata {
+ public:
+  virtual ~FileMetadata() = default;
+
+  /// Returns the memory held by 'this' in bytes.
+  virtual uint64_t sizeBytes() const = 0;
+};
+
+/// Process wide LRU cache of the parsed footers of files so that scanning a
+/// file again, e.g. for another split of the same file, does not read and
+/// parse the tail again. Holds up to 'capacityBytes' of FileMetadata. The
+/// buffers that a FileMetadata allocates from pool() are charged to the
+/// dedicated memory pool of the cache. Thread safe.
+class FileMetadataCache {
+ public:
+  struct Stats {
+    uint64_t numHits{0};
+    uint64_t numMisses{0};
+    uint64_t numEvictions{0};
+    uint64_t numEntries{0};
+    uint64_t cachedBytes{0};
+
+    double hitRate() const {
+      const auto numLookups = numHits + numMisses;
+      return numLookups == 0 ? 0 : static_cast<double>(numHits) / numLookups;
+    }
+
+    std::string toString() const;
+  };
+
+  /// Creates a cache with a leaf pool of the default memory manager if 'pool'
+  /// is not given.
+  explicit FileMetadataCache(
+      uint64_t capacityBytes,
+      std::shared_ptr<memory::MemoryPool> pool = nullptr);
+
+  /// Returns the process wide cache or nullptr if not set.
+  static FileMetadataCache* getInstance();
+
+  static void setInstance(FileMetadataCache* cache);
+
+  /// Returns the metadata of 'key' if it is cached as a T and makes it the
+  /// most recently used entry. Counts a hit or a miss.
+  template <typename T>
+  std::shared_ptr<const T> get(const FileMetadataKey& key) {
+    return std::dynamic_pointer_cast<const T>(find(key));
+  }
+
+  /// Adds 'metadata' for 'key', replacing an earlier entry, and evicts the
+  /// least recently used entries over the capacity. Metadata larger than the
+  /// capacity is not cached.
+  void put(
+      const FileMetadataKey& key,
+      std::shared_ptr<const FileMetadata> metadata);
+
+  /// Drops all entries. Readers that hold an entry keep it alive.
+  void clear();
+
+  Stats stats() const;
+
+  /// Pool for the buffers of the cached metadata. FileMetadata that allocate
+  /// from it must keep it alive.
+  const std::shared_ptr<memory::MemoryPool>& pool() const {
+    return pool_;
+  }
+
+  uint64_t capacityBytes() const {
+    return capacityBytes_;
+  }
+
+ private:
+  using Entry =
+      std::pair<FileMetadataKey, std::shared_ptr<const FileMetadata>>;
+
+  static FileMetadataCache** getInstancePtr();
+
+  std::shared_ptr<const FileMetadata> find(const FileMetadataKey& key);
+
+  void removeLocked(std::list<Entry>::iterator it);
+
+  const uint64_t capacityBytes_;
+  const std::shared_ptr<memory::MemoryPool> pool_;
+
+  mutable std::mutex mutex_;
+  // Most recently used first.
+  std::list<Entry> lru_;
+  folly::F14FastMap<
+      FileMetadataKey,
+      std::list<Entry>::iterator,
+      FileMetadataKeyHasher>
+      entries_;
+  uint64_t cachedBytes_{0};
+  uint64_t numHits_{0};
+  uint64_t numMisses_{0};
+  uint64_t numEvictions_{0};
+};
+
+} // namespace facebook::velox::dwio::common
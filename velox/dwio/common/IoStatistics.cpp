@@ -94,6 +94,54 @@ IoStatistics::operationStats() const {
   return operationStats_;
 }
 
+void IoCostModel::recordRead(uint64_t bytes, uint64_t micros) {
+  const double x = bytes;
+  const double y = micros;
+  std::lock_guard<std::mutex> l(mutex_);
+  ++numSamples_;
+  sumBytes_ += x;
+  sumMicros_ += y;
+  sumBytesSquared_ += x * x;
+  sumBytesMicros_ += x * y;
+}
+
+std::optional<uint64_t> IoCostModel::breakEvenBytes() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (numSamples_ < kMinSamples) {
+    return std::nullopt;
+  }
+  const double n = numSamples_;
+  const double denominator = n * sumBytesSquared_ - sumBytes_ * sumBytes_;
+  // All reads of about the same size do not separate latency from transfer.
+  if (denominator <= 1e-6 * n * sumBytesSquared_) {
+    return std::nullopt;
+  }
+  const double microsPerByte =
+      (n * sumBytesMicros_ - sumBytes_ * sumMicros_) / denominator;
+  const double latencyMicros = (sumMicros_ - microsPerByte * sumBytes_) / n;
+  if (microsPerByte <= 0 || latencyMicros < 1) {
+    return std::nullopt;
+  }
+  return latencyMicros / microsPerByte;
+}
+
+int64_t IoCostModel::numSamples() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return numSamples_;
+}
+
+void IoCostModel::merge(const IoCostModel& other) {
+  if (&other == this) {
+    return;
+  }
+  std::scoped_lock l(mutex_, other.mutex_);
+  numSamples_ += other.numSamples_;
+  sumBytes_ += other.sumBytes_;
+  sumMicros_ += other.sumMicros_;
+  sumBytesSquared_ += other.sumBytesSquared_;
+  sumBytesMicros_ += other.sumBytesMicros_;
+}
+
 void IoStatistics::merge(const IoStatistics& other) {
   rawBytesRead_ += other.rawBytesRead_;
   rawBytesWritten_ += other.rawBytesWritten_;
@@ -105,6 +153,7 @@ void IoStatistics::merge(const IoStatistics& other) {
   ramHit_.merge(other.ramHit_);
   ssdRead_.merge(other.ssdRead_);
   queryThreadIoLatency_.merge(other.queryThreadIoLatency_);
+  storageCostModel_.merge(other.storageCostModel_);
   std::lock_guard<std::mutex> l(operationStatsMutex_);
   for (auto& item : other.operationStats_) {
     operationStats_[item.first].merge(item.second);
@@ -19,6 +19,7 @@
 #include <atomic>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <unordered_map>
 
@@ -63,6 +64,34 @@ class IoCounter {
   std::atomic<uint64_t> sum_{0};
 };
 
+/// Fits the time of reads from storage to a fixed latency per request plus a
+/// transfer time per byte, by least squares over the reads recorded so far.
+class IoCostModel {
+ public:
+  /// Minimum number of recorded reads for an estimate.
+  static constexpr int32_t kMinSamples = 8;
+
+  void recordRead(uint64_t bytes, uint64_t micros);
+
+  /// Returns the number of bytes whose transfer takes as long as the latency
+  /// of a request. Reading a gap shorter than this between two ranges is
+  /// cheaper than issuing a separate request. Returns std::nullopt if there
+  /// are too few reads or the reads do not fit the model.
+  std::optional<uint64_t> breakEvenBytes() const;
+
+  int64_t numSamples() const;
+
+  void merge(const IoCostModel& other);
+
+ private:
+  mutable std::mutex mutex_;
+  int64_t numSamples_{0};
+  double sumBytes_{0};
+  double sumMicros_{0};
+  double sumBytesSquared_{0};
+  double sumBytesMicros_{0};
+};
+
 class IoStatistics {
  public:
   uint64_t rawBytesRead() const;
@@ -99,6 +128,14 @@ class IoStatistics {
     return queryThreadIoLatency_;
   }
 
+  IoCostModel& storageCostModel() {
+    return storageCostModel_;
+  }
+
+  const IoCostModel& storageCostModel() const {
+    return storageCostModel_;
+  }
+
   void incOperationCounters(
       const std::string& operation,
       const uint64_t resourceThrottleCount,
@@ -139,6 +176,9 @@ class IoStatistics {
   // issued IO or for an in-progress read-ahead to finish.
   IoCounter queryThreadIoLatency_;
 
+  // Latency and bandwidth of the coalesced reads from storage.
+  IoCostModel storageCostModel_;
+
   std::unordered_map<std::string, OperationCounters> operationStats_;
   mutable std::mutex operationStatsMutex_;
 };
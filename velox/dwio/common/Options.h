@@ -24,6 +24,7 @@
 #include "velox/common/memory/Memory.h"
 #include "velox/dwio/common/ColumnSelector.h"
 #include "velox/dwio/common/ErrorTolerance.h"
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/common/FlatMapHelper.h"
 #include "velox/dwio/common/FlushPolicy.h"
 #include "velox/dwio/common/InputStream.h"
@@ -111,6 +112,12 @@ class RowReaderOptions {
   // operations.
   std::shared_ptr<folly::Executor> decodingExecutor_;
   std::shared_ptr<folly::Executor> ioExecutor_;
+  // Largest stripe that is read ahead on 'ioExecutor_' while the previous
+  // stripe is decoded. Bounds the memory held by the read ahead.
+  uint64_t maxPrefetchStripeBytes_ = 256 << 20;
+  // Maximum compressed bytes of the streams of a stripe that are decompressed
+  // up front when the stripe is loaded. 0 decompresses while reading.
+  uint64_t maxDecompressStripeBytes_ = 0;
   bool appendRowNumberColumn_ = false;
   // Function to populate metrics related to feature projection stats
   // in Koski. This gets fired in FlatMapColumnReader.
@@ -280,6 +287,34 @@ class RowReaderOptions {
     ioExecutor_ = executor;
   }
 
+  /*
+   * If stripes are preloaded and there is an IO executor, the next stripe is
+   * read on the IO executor while the current one is decoded if it is at most
+   * 'bytes' long.
+   */
+  void setMaxPrefetchStripeBytes(uint64_t bytes) {
+    maxPrefetchStripeBytes_ = bytes;
+  }
+
+  uint64_t getMaxPrefetchStripeBytes() const {
+    return maxPrefetchStripeBytes_;
+  }
+
+  /*
+   * Decompresses the selected streams of each stripe up front, in parallel
+   * on the IO executor if there is one, into buffers that the column readers
+   * then read without further decompression. Streams are taken until their
+   * compressed size adds up to 'bytes'. The decompressed streams of a
+   * stripe stay in memory until the next stripe. 0 disables this.
+   */
+  void setMaxDecompressStripeBytes(uint64_t bytes) {
+    maxDecompressStripeBytes_ = bytes;
+  }
+
+  uint64_t getMaxDecompressStripeBytes() const {
+    return maxDecompressStripeBytes_;
+  }
+
   /*
    * Set to true, if you want to add a new column to the results containing the
    * row numbers.  These row numbers are relative to the beginning of file (0 as
@@ -363,6 +398,9 @@ class ReaderOptions {
   int32_t loadQuantum_{kDefaultLoadQuantum};
   int32_t maxCoalesceDistance_{kDefaultCoalesceDistance};
   int64_t maxCoalesceBytes_{kDefaultCoalesceBytes};
+  bool adaptiveCoalesce_{true};
+  FileMetadataCache* fileMetadataCache_{nullptr};
+  int64_t fileModificationTime_{0};
   SerDeOptions serDeOptions;
   std::shared_ptr<encryption::DecrypterFactory> decrypterFactory_;
   uint64_t directorySizeGuess{kDefaultDirectorySizeGuess};
@@ -406,6 +444,9 @@ class ReaderOptions {
     fileColumnNamesReadAsLowerCase = other.fileColumnNamesReadAsLowerCase;
     maxCoalesceDistance_ = other.maxCoalesceDistance_;
     maxCoalesceBytes_ = other.maxCoalesceBytes_;
+    adaptiveCoalesce_ = other.adaptiveCoalesce_;
+    fileMetadataCache_ = other.fileMetadataCache_;
+    fileModificationTime_ = other.fileModificationTime_;
     return *this;
   }
 
@@ -492,6 +533,34 @@ class ReaderOptions {
     return *this;
   }
 
+  /**
+   * Modify whether the load coalesce distance grows with the measured latency
+   * and bandwidth of the storage. The distance is never below
+   * maxCoalesceDistance().
+   */
+  ReaderOptions& setAdaptiveCoalesce(bool adaptive) {
+    adaptiveCoalesce_ = adaptive;
+    return *this;
+  }
+
+  /**
+   * Modify the cache of parsed file footers. The footer is read and parsed
+   * for every reader if not set.
+   */
+  ReaderOptions& setFileMetadataCache(FileMetadataCache* cache) {
+    fileMetadataCache_ = cache;
+    return *this;
+  }
+
+  /**
+   * Modify the modification time of the file, which is part of the key in
+   * the file metadata cache.
+   */
+  ReaderOptions& setFileModificationTime(int64_t modificationTime) {
+    fileModificationTime_ = modificationTime;
+    return *this;
+  }
+
   /**
    * Modify the serialization-deserialization options.
    */
@@ -571,6 +640,18 @@ class ReaderOptions {
     return maxCoalesceBytes_;
   }
 
+  bool adaptiveCoalesce() const {
+    return adaptiveCoalesce_;
+  }
+
+  FileMetadataCache* fileMetadataCache() const {
+    return fileMetadataCache_;
+  }
+
+  int64_t fileModificationTime() const {
+    return fileModificationTime_;
+  }
+
   SerDeOptions& getSerDeOptions() {
     return serDeOptions;
   }
@@ -601,6 +682,9 @@ struct WriterOptions {
   TypePtr schema;
   velox::memory::MemoryPool* memoryPool;
   std::optional<velox::common::CompressionKind> compressionKind = {};
+  /// Executor for encoding and compressing the columns of a file in parallel.
+  /// Formats that do not support it ignore it.
+  std::shared_ptr<folly::Executor> flushExecutor;
 };
 
 } // namespace common
@@ -67,6 +67,13 @@ uint64_t ScanSpec::newRead() {
   if (!numReads_) {
     reorder();
   } else if (enableFilterReorder_) {
+    if (numReads_ % kSelectivityAgingReads == 0) {
+      for (auto& child : children_) {
+        if (child->filter_) {
+          child->selectivity_.age();
+        }
+      }
+    }
     for (auto i = 1; i < children_.size(); ++i) {
       if (!children_[i]->filter_) {
         break;
@@ -417,7 +424,15 @@ std::shared_ptr<ScanSpec> ScanSpec::removeChild(const ScanSpec* child) {
 }
 
 void ScanSpec::addFilter(const Filter& filter) {
-  filter_ = filter_ ? filter_->mergeWith(&filter) : filter.clone();
+  if (filter_ == nullptr) {
+    filter_ = filter.clone();
+  } else if (filter.kind() == FilterKind::kBloomFilterValues) {
+    // Bloom filters carry the filters they are merged with, which the other
+    // filter kinds do not know how to merge with.
+    filter_ = filter.mergeWith(filter_.get());
+  } else {
+    filter_ = filter_->mergeWith(&filter);
+  }
 }
 
 ScanSpec* ScanSpec::addField(const std::string& name, column_index_t channel) {
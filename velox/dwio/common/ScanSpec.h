@@ -346,6 +346,11 @@ class ScanSpec {
   void addAllChildFields(const Type&);
 
  private:
+  // Number of reads between halving the selectivity history of the filtered
+  // children, so that the filter order adapts when the data changes, e.g.
+  // from one split to the next.
+  static constexpr uint64_t kSelectivityAgingReads = 128;
+
   void reorder();
 
   // Serializes stableChildren().
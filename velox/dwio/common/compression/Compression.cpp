@@ -20,12 +20,14 @@
 #include "velox/dwio/common/compression/PagedInputStream.h"
 #include "velox/dwio/common/compression/PagedOutputStream.h"
 
+#include <folly/Synchronized.h>
 #include <folly/logging/xlog.h>
 #include <lz4.h>
 #include <snappy.h>
 #include <zlib.h>
 #include <zstd.h>
 #include <zstd_errors.h>
+#include <unordered_map>
 
 namespace facebook::velox::dwio::common::compression {
 
@@ -346,6 +348,9 @@ class ZlibDecompressionStream : public PagedInputStream,
 };
 
 bool ZlibDecompressionStream::Next(const void** data, int32_t* size) {
+  if (decompressed_) {
+    return nextDecompressed(data, size);
+  }
   // if the user pushed back, return them the partial buffer
   if (outputBufferLength_) {
     *data = outputBufferPtr_;
@@ -479,6 +484,45 @@ std::unique_ptr<BufferedOutputStream> createCompressor(
       encrypter);
 }
 
+namespace {
+folly::Synchronized<std::unordered_map<int64_t, DecompressorFactory>>&
+decompressorFactories() {
+  static folly::Synchronized<std::unordered_map<int64_t, DecompressorFactory>>
+      factories;
+  return factories;
+}
+} // namespace
+
+void registerDecompressorFactory(
+    CompressionKind kind,
+    DecompressorFactory factory) {
+  VELOX_CHECK_NOT_NULL(factory);
+  (*decompressorFactories().wlock())[kind] = std::move(factory);
+}
+
+void unregisterDecompressorFactory(CompressionKind kind) {
+  decompressorFactories().wlock()->erase(kind);
+}
+
+std::unique_ptr<Decompressor> createRegisteredDecompressor(
+    CompressionKind kind,
+    uint64_t blockSize,
+    const std::string& streamDebugInfo) {
+  DecompressorFactory factory;
+  {
+    auto factories = decompressorFactories().rlock();
+    if (factories->empty()) {
+      return nullptr;
+    }
+    auto it = factories->find(kind);
+    if (it == factories->end()) {
+      return nullptr;
+    }
+    factory = it->second;
+  }
+  return factory(blockSize, streamDebugInfo);
+}
+
 std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
     CompressionKind kind,
     std::unique_ptr<dwio::common::SeekableInputStream> input,
@@ -486,7 +530,16 @@ std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
     MemoryPool& pool,
     const std::string& streamDebugInfo,
     const Decrypter* decrypter) {
-  std::unique_ptr<Decompressor> decompressor;
+  std::unique_ptr<Decompressor> decompressor =
+      createRegisteredDecompressor(kind, blockSize, streamDebugInfo);
+  if (decompressor) {
+    return std::make_unique<PagedInputStream>(
+        std::move(input),
+        pool,
+        std::move(decompressor),
+        decrypter,
+        streamDebugInfo);
+  }
   switch (static_cast<int64_t>(kind)) {
     case CompressionKind::CompressionKind_NONE:
       if (!decrypter) {
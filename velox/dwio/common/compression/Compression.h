@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include "velox/common/compression/Compression.h"
 #include "velox/dwio/common/OutputStream.h"
 #include "velox/dwio/common/SeekableInputStream.h"
@@ -60,6 +62,36 @@ class Decompressor {
   const std::string streamDebugInfo_;
 };
 
+/// Makes a Decompressor for blocks of at most 'blockSize' bytes of a stream,
+/// e.g. one that offloads to a hardware accelerator. 'blockSize' is 0 if the
+/// size of the blocks is not fixed, as for Parquet pages, which are
+/// decompressed with their uncompressed size as 'destLength'. Returns nullptr
+/// if the backend cannot take the stream, e.g. when the device is not
+/// present, in which case the built-in CPU decompressor is used. A backend
+/// that cannot take a block, e.g. with a full submission queue, must
+/// decompress it on the CPU itself.
+using DecompressorFactory = std::function<std::unique_ptr<Decompressor>(
+    uint64_t blockSize,
+    const std::string& streamDebugInfo)>;
+
+/// Registers 'factory' to make the decompressors for 'kind' in place of the
+/// built-in ones in DWRF streams and Parquet pages. Replaces an earlier
+/// factory for 'kind'. Meant to be called at startup.
+void registerDecompressorFactory(
+    facebook::velox::common::CompressionKind kind,
+    DecompressorFactory factory);
+
+/// Removes the factory registered for 'kind', if any.
+void unregisterDecompressorFactory(
+    facebook::velox::common::CompressionKind kind);
+
+/// Returns a decompressor made by the factory registered for 'kind', or
+/// nullptr if there is no factory or it does not take the stream.
+std::unique_ptr<Decompressor> createRegisteredDecompressor(
+    facebook::velox::common::CompressionKind kind,
+    uint64_t blockSize,
+    const std::string& streamDebugInfo);
+
 /**
  * Create a decompressor for the given compression kind.
  * @param kind the compression type to implement
@@ -104,6 +104,9 @@ const char* PagedInputStream::ensureInput(size_t availableInputBytes) {
 }
 
 bool PagedInputStream::Next(const void** data, int32_t* size) {
+  if (decompressed_) {
+    return nextDecompressed(data, size);
+  }
   // if the user pushed back, return them the partial buffer
   if (outputBufferLength_) {
     *data = outputBufferPtr_;
@@ -188,6 +191,11 @@ bool PagedInputStream::Next(const void** data, int32_t* size) {
 }
 
 void PagedInputStream::BackUp(int32_t count) {
+  if (decompressed_) {
+    VELOX_CHECK_LE(static_cast<uint64_t>(count), bytesReturned_);
+    bytesReturned_ -= count;
+    return;
+  }
   DWIO_ENSURE(
       outputBufferPtr_ != nullptr,
       "Backup without previous Next in ",
@@ -208,6 +216,11 @@ void PagedInputStream::BackUp(int32_t count) {
 }
 
 bool PagedInputStream::Skip(int32_t count) {
+  if (decompressed_) {
+    auto available = decompressed_->size() - bytesReturned_;
+    bytesReturned_ += std::min<uint64_t>(count, available);
+    return static_cast<uint64_t>(count) <= available;
+  }
   // this is a stupid implementation for now.
   // should skip entire blocks without decompressing
   while (count > 0) {
@@ -239,6 +252,24 @@ void PagedInputStream::seekToPosition(
   auto compressedOffset = positionProvider.next();
   auto uncompressedOffset = positionProvider.next();
 
+  if (decompressed_) {
+    auto it = std::lower_bound(
+        decompressedBlocks_.begin(),
+        decompressedBlocks_.end(),
+        compressedOffset,
+        [](const auto& block, uint64_t offset) {
+          return block.first < offset;
+        });
+    DWIO_ENSURE(
+        it != decompressedBlocks_.end() && it->first == compressedOffset,
+        getName(),
+        ", no block at compressed offset ",
+        compressedOffset);
+    bytesReturned_ = it->second + uncompressedOffset;
+    DWIO_ENSURE_LE(bytesReturned_, decompressed_->size(), getName());
+    return;
+  }
+
   // If we are directly returning views into input, we can only backup
   // to the beginning of the last view or last header, whichever is
   // later. If we are returning views into the decompression buffer,
@@ -270,4 +301,52 @@ void PagedInputStream::seekToPosition(
   }
 }
 
+void PagedInputStream::decompressAll() {
+  if (decompressed_ || bytesReturned_ > 0 || state_ != State::HEADER) {
+    return;
+  }
+  auto decompressed = std::make_unique<dwio::common::DataBuffer<char>>(pool_);
+  std::vector<std::pair<uint64_t, uint64_t>> blocks;
+  const void* data;
+  int32_t size;
+  while (Next(&data, &size)) {
+    if (blocks.empty() || blocks.back().first != lastHeaderOffset_) {
+      blocks.emplace_back(lastHeaderOffset_, bytesReturnedAtLastHeaderOffset_);
+    }
+    decompressed->extendAppend(
+        decompressed->size(), static_cast<const char*>(data), size);
+  }
+  // A position at the end of the stream has the compressed length as offset.
+  if (blocks.empty() || blocks.back().first < input_->ByteCount()) {
+    blocks.emplace_back(input_->ByteCount(), decompressed->size());
+  }
+  decompressed_ = std::move(decompressed);
+  decompressedBlocks_ = std::move(blocks);
+  bytesReturned_ = 0;
+  outputBuffer_.reset();
+}
+
+bool PagedInputStream::nextDecompressed(const void** data, int32_t* size) {
+  auto available = decompressed_->size() - bytesReturned_;
+  if (available == 0) {
+    return false;
+  }
+  // Returns the rest of the block at 'bytesReturned_', like Next() on the
+  // compressed stream.
+  auto nextBlock = std::upper_bound(
+      decompressedBlocks_.begin(),
+      decompressedBlocks_.end(),
+      bytesReturned_,
+      [](uint64_t offset, const auto& block) {
+        return offset < block.second;
+      });
+  if (nextBlock != decompressedBlocks_.end()) {
+    available = std::min(available, nextBlock->second - bytesReturned_);
+  }
+  *data = decompressed_->data() + bytesReturned_;
+  *size = static_cast<int32_t>(available);
+  bytesReturned_ += *size;
+  return true;
+}
+
 } // namespace facebook::velox::dwio::common::compression
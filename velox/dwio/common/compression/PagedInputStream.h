@@ -66,6 +66,25 @@ class PagedInputStream : public dwio::common::SeekableInputStream {
     return 2;
   }
 
+  /// Decompresses the whole stream into one buffer. Next(), BackUp(), Skip()
+  /// and seekToPosition() then return ranges of the buffer and do no more
+  /// decompression. Does nothing if the stream has already been read from.
+  /// May run on another thread than the reader of the stream but not
+  /// concurrently with it.
+  void decompressAll();
+
+  /// Makes 'this' decrypt with 'decrypter', which it owns, in place of the
+  /// decrypter given at construction. Used with decompressAll() on another
+  /// thread, since a Decrypter is not safe to use from several threads at a
+  /// time. Must be called before the first read.
+  void setOwnedDecrypter(
+      std::unique_ptr<dwio::common::encryption::Decrypter> decrypter) {
+    DWIO_ENSURE_NOT_NULL(decrypter_, "stream is not encrypted");
+    DWIO_ENSURE_NOT_NULL(decrypter);
+    ownedDecrypter_ = std::move(decrypter);
+    decrypter_ = ownedDecrypter_.get();
+  }
+
  protected:
   // Special constructor used by ZlibDecompressionStream
   PagedInputStream(
@@ -89,6 +108,9 @@ class PagedInputStream : public dwio::common::SeekableInputStream {
 
   void clearDecompressionState();
 
+  // Next() for a stream decompressed by decompressAll().
+  bool nextDecompressed(const void** data, int32_t* size);
+
   enum class State { HEADER, START, ORIGINAL, END };
 
   // make sure input is contiguous for decompression/decryption
@@ -148,6 +170,18 @@ class PagedInputStream : public dwio::common::SeekableInputStream {
   // decrypter
   const dwio::common::encryption::Decrypter* decrypter_;
 
+  // Set by setOwnedDecrypter().
+  std::unique_ptr<dwio::common::encryption::Decrypter> ownedDecrypter_;
+
+  // The whole stream after decompressAll(). The data of the blocks is
+  // contiguous.
+  std::unique_ptr<dwio::common::DataBuffer<char>> decompressed_;
+
+  // Offset in 'input_' of the header of each block of 'decompressed_' and the
+  // offset of the data of the block in 'decompressed_'. The last entry is the
+  // end of the stream.
+  std::vector<std::pair<uint64_t, uint64_t>> decompressedBlocks_;
+
  private:
   // Stream Debug Info
   const std::string streamDebugInfo_;
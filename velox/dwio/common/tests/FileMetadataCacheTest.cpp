@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "velox/dwio/common/FileMetadataCache.h"
+
+using namespace facebook::velox::dwio::common;
+
+namespace {
+struct TestMetadata : public FileMetadata {
+  explicit TestMetadata(uint64_t _bytes) : bytes(_bytes) {}
+
+  uint64_t sizeBytes() const override {
+    return bytes;
+  }
+
+  const uint64_t bytes;
+};
+
+struct OtherMetadata : public TestMetadata {
+  using TestMetadata::TestMetadata;
+};
+} // namespace
+
+TEST(FileMetadataCacheTest, hitsAndMisses) {
+  FileMetadataCache cache(1'000);
+  const FileMetadataKey key{"/a", 100, 1};
+  EXPECT_EQ(cache.get<TestMetadata>(key), nullptr);
+  auto metadata = std::make_shared<TestMetadata>(100);
+  cache.put(key, metadata);
+  EXPECT_EQ(cache.get<TestMetadata>(key), metadata);
+
+  // Another size or modification time is another version of the file.
+  EXPECT_EQ(cache.get<TestMetadata>({"/a", 101, 1}), nullptr);
+  EXPECT_EQ(cache.get<TestMetadata>({"/a", 100, 2}), nullptr);
+  // Metadata of another format is not returned.
+  EXPECT_EQ(cache.get<OtherMetadata>(key), nullptr);
+
+  auto stats = cache.stats();
+  EXPECT_EQ(stats.numHits, 2);
+  EXPECT_EQ(stats.numMisses, 3);
+  EXPECT_EQ(stats.numEntries, 1);
+  EXPECT_EQ(stats.cachedBytes, 100);
+  EXPECT_DOUBLE_EQ(stats.hitRate(), 0.4);
+
+  cache.clear();
+  EXPECT_EQ(cache.get<TestMetadata>(key), nullptr);
+  EXPECT_EQ(cache.stats().cachedBytes, 0);
+}
+
+TEST(FileMetadataCacheTest, evictLeastRecentlyUsed) {
+  FileMetadataCache cache(1'000);
+  for (auto i = 0; i < 4; ++i) {
+    cache.put(
+        {fmt::format("/{}", i), 100, 0}, std::make_shared<TestMetadata>(300));
+  }
+  // 0 was evicted for 3.
+  EXPECT_EQ(cache.get<TestMetadata>({"/0", 100, 0}), nullptr);
+  EXPECT_NE(cache.get<TestMetadata>({"/1", 100, 0}), nullptr);
+
+  // 2 is now the least recently used.
+  cache.put({"/4", 100, 0}, std::make_shared<TestMetadata>(300));
+  EXPECT_EQ(cache.get<TestMetadata>({"/2", 100, 0}), nullptr);
+  EXPECT_NE(cache.get<TestMetadata>({"/1", 100, 0}), nullptr);
+  EXPECT_NE(cache.get<TestMetadata>({"/3", 100, 0}), nullptr);
+  EXPECT_NE(cache.get<TestMetadata>({"/4", 100, 0}), nullptr);
+
+  // Replacing an entry does not count its old size.
+  cache.put({"/4", 100, 0}, std::make_shared<TestMetadata>(100));
+  auto stats = cache.stats();
+  EXPECT_EQ(stats.numEvictions, 2);
+  EXPECT_EQ(stats.numEntries, 3);
+  EXPECT_EQ(stats.cachedBytes, 700);
+
+  // Larger than the capacity.
+  cache.put({"/5", 100, 0}, std::make_shared<TestMetadata>(2'000));
+  EXPECT_EQ(cache.get<TestMetadata>({"/5", 100, 0}), nullptr);
+  EXPECT_EQ(cache.stats().cachedBytes, 700);
+}
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include "velox/dwio/common/IoStatistics.h"
+
+using namespace facebook::velox::dwio::common;
+
+TEST(IoStatisticsTest, costModel) {
+  IoCostModel model;
+  // Reads of 50ms latency at 100MB/s.
+  auto micros = [](uint64_t bytes) { return 50'000 + bytes / 100; };
+  for (auto i = 1; i < IoCostModel::kMinSamples; ++i) {
+    model.recordRead(i << 20, micros(i << 20));
+    EXPECT_FALSE(model.breakEvenBytes().has_value());
+  }
+  model.recordRead(8 << 20, micros(8 << 20));
+  ASSERT_TRUE(model.breakEvenBytes().has_value());
+  EXPECT_NEAR(model.breakEvenBytes().value(), 5'000'000, 1'000);
+
+  IoStatistics stats;
+  stats.storageCostModel().merge(model);
+  EXPECT_EQ(stats.storageCostModel().numSamples(), IoCostModel::kMinSamples);
+  EXPECT_NEAR(
+      stats.storageCostModel().breakEvenBytes().value(), 5'000'000, 1'000);
+}
+
+TEST(IoStatisticsTest, costModelWithoutFit) {
+  IoCostModel sameSize;
+  for (auto i = 0; i < 2 * IoCostModel::kMinSamples; ++i) {
+    sameSize.recordRead(1 << 20, 10'000 + i);
+  }
+  EXPECT_FALSE(sameSize.breakEvenBytes().has_value());
+
+  // No latency.
+  IoCostModel bandwidthOnly;
+  for (auto i = 1; i <= IoCostModel::kMinSamples; ++i) {
+    bandwidthOnly.recordRead(i << 20, i << 10);
+  }
+  EXPECT_FALSE(bandwidthOnly.breakEvenBytes().has_value());
+}
@@ -78,6 +78,7 @@ class ByteRleEncoderImpl : public ByteRleEncoder {
   char* buffer;
 
   void writeByte(char c);
+  void writeBytes(const char* data, int32_t size);
   void writeValues();
   void write(char c);
 };
@@ -94,6 +95,24 @@ void ByteRleEncoderImpl::writeByte(char c) {
   buffer[bufferPosition++] = c;
 }
 
+void ByteRleEncoderImpl::writeBytes(const char* data, int32_t size) {
+  while (size > 0) {
+    if (bufferPosition == bufferLength) {
+      int32_t addedSize = 0;
+      DWIO_ENSURE(
+          outputStream->Next(reinterpret_cast<void**>(&buffer), &addedSize),
+          "Allocation failure");
+      bufferPosition = 0;
+      bufferLength = addedSize;
+    }
+    const int32_t numBytes = std::min(size, bufferLength - bufferPosition);
+    memcpy(buffer + bufferPosition, data, numBytes);
+    bufferPosition += numBytes;
+    data += numBytes;
+    size -= numBytes;
+  }
+}
+
 uint64_t ByteRleEncoderImpl::add(
     const char* data,
     const common::Ranges& ranges,
@@ -107,9 +126,30 @@ uint64_t ByteRleEncoderImpl::add(
       }
     }
   } else {
-    for (auto& pos : ranges) {
-      write(data[pos]);
-      ++count;
+    for (const auto [start, end] : ranges.getRanges()) {
+      auto pos = start;
+      while (pos < end) {
+        if (repeat) {
+          // Consumes the rest of the run with a tight compare loop instead of
+          // going through write() for every byte.
+          const auto runEnd =
+              std::min<size_t>(end, pos + RLE_MAXIMUM_REPEAT - numLiterals);
+          auto runPos = pos;
+          while (runPos < runEnd && data[runPos] == literals[0]) {
+            ++runPos;
+          }
+          if (runPos > pos) {
+            numLiterals += runPos - pos;
+            if (numLiterals == RLE_MAXIMUM_REPEAT) {
+              writeValues();
+            }
+            pos = runPos;
+            continue;
+          }
+        }
+        write(data[pos++]);
+      }
+      count += end - start;
     }
   }
   return count;
@@ -143,9 +183,7 @@ void ByteRleEncoderImpl::writeValues() {
       writeByte(literals[0]);
     } else {
       writeByte(static_cast<char>(-numLiterals));
-      for (int32_t i = 0; i < numLiterals; ++i) {
-        writeByte(literals[i]);
-      }
+      writeBytes(literals.data(), numLiterals);
     }
     repeat = false;
     tailRunLength = 0;
@@ -16,10 +16,10 @@
 
 #pragma once
 
+#include "velox/common/base/Crc.h"
 #include "velox/dwio/common/exception/Exception.h"
 #include "velox/dwio/dwrf/common/wrap/dwrf-proto-wrapper.h"
 
-#include <boost/crc.hpp>
 #define XXH_INLINE_ALL
 #include <xxhash.h>
 
@@ -43,25 +43,22 @@ class Checksum {
   proto::ChecksumAlgorithm type_;
 };
 
+// The state is inlined, so creating and resetting a checksum does not
+// allocate.
 class XxHash : public Checksum {
  public:
-  XxHash()
-      : Checksum{proto::ChecksumAlgorithm::XXHASH},
-        state_{XXH64_createState()} {
-    DWIO_ENSURE_NOT_NULL(state_, "failed to initialize xxhash");
+  XxHash() : Checksum{proto::ChecksumAlgorithm::XXHASH} {
     reset();
   }
 
-  ~XxHash() override {
-    XXH64_freeState(state_);
-  }
+  ~XxHash() override = default;
 
   void update(const void* input, size_t len) override {
-    DWIO_ENSURE_NE(XXH64_update(state_, input, len), XXH_ERROR);
+    DWIO_ENSURE_NE(XXH64_update(&state_, input, len), XXH_ERROR);
   }
 
   int64_t getDigest(bool reset) override {
-    auto ret = static_cast<int64_t>(XXH64_digest(state_));
+    auto ret = static_cast<int64_t>(XXH64_digest(&state_));
     if (reset) {
       this->reset();
     }
@@ -69,40 +66,43 @@ class XxHash : public Checksum {
   }
 
  private:
-  XXH64_state_t* state_;
+  XXH64_state_t state_;
   unsigned long long seed_ = 0; // dwrf java uses seed 0
 
   void reset() {
-    DWIO_ENSURE_NE(XXH64_reset(state_, seed_), XXH_ERROR);
+    DWIO_ENSURE_NE(XXH64_reset(&state_, seed_), XXH_ERROR);
   }
 };
 
+// CRC-32 as computed by boost::crc_32_type. Uses the SSE4.2/PCLMUL code path
+// of folly when the CPU supports it.
 class Crc32 : public Checksum {
  public:
-  Crc32() : Checksum{proto::ChecksumAlgorithm::CRC32} {
-    reset();
-  }
+  Crc32() : Checksum{proto::ChecksumAlgorithm::CRC32} {}
 
   ~Crc32() override = default;
 
   void update(const void* input, size_t len) override {
-    crc_->process_bytes(input, len);
+    constexpr size_t kMaxChunk = std::numeric_limits<int32_t>::max();
+    auto* bytes = static_cast<const char*>(input);
+    while (len > 0) {
+      const auto chunk = std::min(len, kMaxChunk);
+      crc_.process_bytes(bytes, chunk);
+      bytes += chunk;
+      len -= chunk;
+    }
   }
 
   int64_t getDigest(bool reset) override {
-    auto ret = crc_->checksum();
+    int64_t ret = crc_.checksum();
     if (reset) {
-      this->reset();
+      crc_.reset();
     }
     return ret;
   }
 
  private:
-  std::unique_ptr<boost::crc_32_type> crc_;
-
-  void reset() {
-    crc_ = std::make_unique<boost::crc_32_type>();
-  }
+  bits::Crc32 crc_;
 };
 
 class ChecksumFactory {
@@ -39,6 +39,10 @@ class Config : public common::ConfigBase<Config> {
   static Entry<uint32_t> COMPRESSION_THRESHOLD;
   static Entry<bool> CREATE_INDEX;
   static Entry<uint32_t> ROW_INDEX_STRIDE;
+  /// Top level columns, by index, for which to write a bloom filter of the
+  /// values of each row index stride. Only used for integer and varchar
+  /// columns and if the index is created.
+  static Entry<const std::vector<uint32_t>> BLOOM_FILTER_COLUMNS;
   static Entry<proto::ChecksumAlgorithm> CHECKSUM_ALGORITHM;
   static Entry<StripeCacheMode> STRIPE_CACHE_MODE;
   static Entry<uint32_t> STRIPE_CACHE_SIZE;
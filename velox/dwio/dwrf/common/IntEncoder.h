@@ -180,11 +180,27 @@ class IntEncoder {
   }
   FOLLY_ALWAYS_INLINE void writeLongLE(int64_t val);
 
+  // Varint encodes 'numValues' values from 'data', zigzag encoded if signed.
+  template <typename T>
+  void writeVarints(const T* data, int32_t numValues);
+
  private:
+  // Number of values checked together for fitting in a single varint byte.
+  static constexpr int32_t kVarintBatch = 8;
+
   template <typename T>
   uint64_t
   addImpl(const T* data, const common::Ranges& ranges, const uint64_t* nulls);
 
+  template <typename T>
+  FOLLY_ALWAYS_INLINE static uint64_t toVarintValue(T value) {
+    if constexpr (isSigned) {
+      return ZigZag::encode(value);
+    } else {
+      return static_cast<uint64_t>(static_cast<int64_t>(value));
+    }
+  }
+
   FOLLY_ALWAYS_INLINE void writeBuffer(char* start, char* end) {
     int32_t valsToWrite = end - start;
     while (valsToWrite) {
@@ -254,6 +270,14 @@ uint64_t IntEncoder<isSigned>::addImpl(
     const T* data,
     const common::Ranges& ranges,
     const uint64_t* nulls) {
+  if (useVInts_ && !nulls) {
+    uint64_t count = 0;
+    for (const auto [start, end] : ranges.getRanges()) {
+      writeVarints(data + start, end - start);
+      count += end - start;
+    }
+    return count;
+  }
   if (!useVInts_) {
     WRITE_INTS(writeLongLE);
   } else {
@@ -266,6 +290,47 @@ uint64_t IntEncoder<isSigned>::addImpl(
 }
 
 #undef WRITE_INTS
+
+template <bool isSigned>
+template <typename T>
+void IntEncoder<isSigned>::writeVarints(const T* data, int32_t numValues) {
+  char buffer[1024];
+  char* writeLoc = buffer;
+  // Leaves room for a full batch of maximum length varints.
+  char* const endBuf =
+      buffer + sizeof(buffer) - kVarintBatch * folly::kMaxVarintLength64;
+  int32_t i = 0;
+  for (; i + kVarintBatch <= numValues; i += kVarintBatch) {
+    // Small values are the common case for lengths, ids and deltas. If the
+    // whole batch fits in one byte per value, store it without the per value
+    // length dispatch. The loops are branch free and vectorize.
+    uint64_t values[kVarintBatch];
+    uint64_t anyBits = 0;
+    for (int32_t j = 0; j < kVarintBatch; ++j) {
+      values[j] = toVarintValue(data[i + j]);
+      anyBits |= values[j];
+    }
+    if (anyBits < 0x80) {
+      for (int32_t j = 0; j < kVarintBatch; ++j) {
+        writeLoc[j] = static_cast<char>(values[j]);
+      }
+      writeLoc += kVarintBatch;
+    } else {
+      for (int32_t j = 0; j < kVarintBatch; ++j) {
+        writeLoc += write64Varint(values[j], writeLoc);
+      }
+    }
+    if (writeLoc > endBuf) {
+      writeBuffer(buffer, writeLoc);
+      writeLoc = buffer;
+    }
+  }
+  for (; i < numValues; ++i) {
+    writeLoc += write64Varint(toVarintValue(data[i]), writeLoc);
+  }
+  writeBuffer(buffer, writeLoc);
+}
+
 template <bool isSigned>
 void IntEncoder<isSigned>::writeByte(char c) {
   if (UNLIKELY(bufferPosition_ == bufferLength_)) {
@@ -227,9 +227,30 @@ uint64_t RleEncoderV1<isSigned>::addImpl(
       }
     }
   } else {
-    for (auto& pos : ranges) {
-      write(data[pos]);
-      ++count;
+    for (const auto [start, end] : ranges.getRanges()) {
+      auto pos = start;
+      while (pos < end) {
+        if (repeat && delta == 0) {
+          // Consumes the rest of a constant run with a tight compare loop
+          // instead of going through write() for every value.
+          const auto runEnd =
+              std::min<size_t>(end, pos + RLE_MAXIMUM_REPEAT - numLiterals);
+          auto runPos = pos;
+          while (runPos < runEnd && data[runPos] == literals[0]) {
+            ++runPos;
+          }
+          if (runPos > pos) {
+            numLiterals += runPos - pos;
+            if (numLiterals == RLE_MAXIMUM_REPEAT) {
+              writeValues();
+            }
+            pos = runPos;
+            continue;
+          }
+        }
+        write(data[pos++]);
+      }
+      count += end - start;
     }
   }
   return count;
@@ -18,6 +18,8 @@
 #include "velox/dwio/common/SeekableInputStream.h"
 #include "velox/dwio/dwrf/common/Common.h"
 
+#include <folly/lang/Bits.h>
+
 namespace facebook::velox::dwrf {
 
 using memory::MemoryPool;
@@ -119,6 +121,88 @@ int64_t RleDecoderV2<isSigned>::readLongBE(uint64_t bsz) {
   return ret;
 }
 
+namespace {
+// Unpacks 'numValues' big endian 'width' bit values starting 'bitOffset' bits
+// into 'input'. Each value is extracted from the 8 bytes at its first byte and,
+// if it spans more than 8 bytes, the next byte, so the caller must make sure
+// that 9 bytes are readable from the first byte of the last value.
+template <bool kWide>
+void unpackBigEndian(
+    const char* input,
+    uint64_t bitOffset,
+    uint32_t width,
+    uint64_t numValues,
+    int64_t* result) {
+  const uint32_t shiftRight = 64 - width;
+  for (uint64_t i = 0; i < numValues; ++i) {
+    const auto* bytes = input + (bitOffset >> 3);
+    const uint32_t shift = bitOffset & 7;
+    uint64_t value =
+        (folly::Endian::big(folly::loadUnaligned<uint64_t>(bytes)) << shift) >>
+        shiftRight;
+    if constexpr (kWide) {
+      // The last 'shift + width - 64' bits are in the 9th byte.
+      if (shift + width > 64) {
+        value |= static_cast<uint8_t>(bytes[8]) >> (72 - shift - width);
+      }
+    }
+    result[i] = static_cast<int64_t>(value);
+    bitOffset += width;
+  }
+}
+} // namespace
+
+template <bool isSigned>
+uint64_t RleDecoderV2<isSigned>::unpackLongs(
+    int64_t* const data,
+    uint64_t len,
+    uint32_t fb) {
+  auto& bufferStart = dwio::common::IntDecoder<isSigned>::bufferStart;
+  const auto* bufferEnd = dwio::common::IntDecoder<isSigned>::bufferEnd;
+  if (len == 0 || fb == 0 || bufferStart == nullptr) {
+    return 0;
+  }
+  // The unread low bits of 'curByte' are the first bits of the values and
+  // 'curByte' is the last byte read from the current buffer.
+  const char* input = bufferStart;
+  uint64_t bitOffset = 0;
+  if (bitsLeft > 0) {
+    --input;
+    VELOX_DCHECK_EQ(static_cast<uint8_t>(*input), curByte);
+    bitOffset = 8 - bitsLeft;
+  }
+  const uint64_t available = bufferEnd - input;
+  if (available < 9) {
+    return 0;
+  }
+  // Value i can be read if its first bit is before the last 9 bytes.
+  const uint64_t limit = (available - 8) * 8 - bitOffset;
+  const uint64_t numValues = std::min<uint64_t>(len, (limit + fb - 1) / fb);
+  if (fb > 56) {
+    unpackBigEndian<true>(input, bitOffset, fb, numValues, data);
+  } else {
+    unpackBigEndian<false>(input, bitOffset, fb, numValues, data);
+  }
+  const uint64_t endBit = bitOffset + numValues * fb;
+  bufferStart = input + bits::roundUp(endBit, 8) / 8;
+  if (endBit % 8 == 0) {
+    resetReadLongs();
+  } else {
+    curByte = static_cast<uint8_t>(input[endBit / 8]);
+    bitsLeft = 8 - endBit % 8;
+  }
+  return numValues;
+}
+
+template uint64_t RleDecoderV2<true>::unpackLongs(
+    int64_t* const data,
+    uint64_t len,
+    uint32_t fb);
+template uint64_t RleDecoderV2<false>::unpackLongs(
+    int64_t* const data,
+    uint64_t len,
+    uint32_t fb);
+
 template <bool isSigned>
 RleDecoderV2<isSigned>::RleDecoderV2(
     std::unique_ptr<dwio::common::SeekableInputStream> input,
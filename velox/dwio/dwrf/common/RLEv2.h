@@ -169,8 +169,12 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
       uint64_t fb,
       const uint64_t* nulls = nullptr) {
     uint64_t ret = 0;
+    if (!nulls) {
+      ret = unpackLongs(data + offset, len, fb);
+      offset += ret;
+      len -= ret;
+    }
 
-    // TODO: unroll to improve performance
     for (uint64_t i = offset; i < (offset + len); i++) {
       // skip null positions
       if (nulls && bits::isBitNull(nulls, i)) {
@@ -199,6 +203,12 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
     return ret;
   }
 
+  // Decodes up to 'len' 'fb' bit values into 'data' a word at a time while
+  // they are in the current buffer of the input stream. Returns the number
+  // of values decoded. The rest are left to the byte at a time loop of
+  // readLongs() which also reads across buffers.
+  uint64_t unpackLongs(int64_t* data, uint64_t len, uint32_t fb);
+
   uint64_t nextShortRepeats(
       int64_t* data,
       uint64_t offset,
@@ -16,10 +16,86 @@
 
 #include "velox/dwio/dwrf/reader/DwrfData.h"
 
+#include "velox/common/base/BloomFilter.h"
 #include "velox/dwio/common/BufferUtil.h"
 
 namespace facebook::velox::dwrf {
 
+namespace {
+// Returns the hashes to look up in the bloom filters of the row groups if
+// 'filter' passes only the values of an equality or IN list. Returns an empty
+// vector for other filters and filters that pass nulls, which the bloom
+// filters do not record.
+std::vector<uint64_t> bloomFilterHashes(const common::Filter& filter) {
+  std::vector<uint64_t> hashes;
+  if (filter.testNull()) {
+    return hashes;
+  }
+  auto addInt64s = [&](const std::vector<int64_t>& values) {
+    hashes.reserve(values.size());
+    for (auto value : values) {
+      hashes.push_back(common::BloomFilterValues::hashInt64(value));
+    }
+  };
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange: {
+      auto& range = static_cast<const common::BigintRange&>(filter);
+      if (range.isSingleValue()) {
+        hashes.push_back(common::BloomFilterValues::hashInt64(range.lower()));
+      }
+      break;
+    }
+    case common::FilterKind::kBigintValuesUsingHashTable:
+      addInt64s(
+          static_cast<const common::BigintValuesUsingHashTable&>(filter)
+              .values());
+      break;
+    case common::FilterKind::kBigintValuesUsingBitmask:
+      addInt64s(
+          static_cast<const common::BigintValuesUsingBitmask&>(filter)
+              .values());
+      break;
+    case common::FilterKind::kBytesRange: {
+      auto& range = static_cast<const common::BytesRange&>(filter);
+      if (range.isSingleValue()) {
+        hashes.push_back(common::BloomFilterValues::hashBytes(
+            range.lower().data(), range.lower().size()));
+      }
+      break;
+    }
+    case common::FilterKind::kBytesValues: {
+      auto& values = static_cast<const common::BytesValues&>(filter).values();
+      hashes.reserve(values.size());
+      for (const auto& value : values) {
+        hashes.push_back(
+            common::BloomFilterValues::hashBytes(value.data(), value.size()));
+      }
+      break;
+    }
+    default:
+      break;
+  }
+  return hashes;
+}
+
+// Returns false if none of the values with 'hashes' is in the row group of
+// 'bloomFilter'. Bloom filters not written by the velox writer are not used.
+bool mayContainAny(
+    const proto::BloomFilter& bloomFilter,
+    const std::vector<uint64_t>& hashes) {
+  const auto size = bloomFilter.bitset_size();
+  if (!bloomFilter.blocked() || size == 0 || !bits::isPowerOfTwo(size)) {
+    return true;
+  }
+  for (auto hash : hashes) {
+    if (BloomFilter<>::mayContain(bloomFilter.bitset().data(), size, hash)) {
+      return true;
+    }
+  }
+  return false;
+}
+} // namespace
+
 DwrfData::DwrfData(
     std::shared_ptr<const dwio::common::TypeWithId> nodeType,
     StripeStreams& stripe,
@@ -47,6 +123,10 @@ DwrfData::DwrfData(
       encodingKey.forKind(proto::Stream_Kind_ROW_INDEX),
       streamLabels.label(),
       false);
+  bloomFilterStream_ = stripe.getStream(
+      encodingKey.forKind(proto::Stream_Kind_BLOOM_FILTER_UTF8),
+      streamLabels.label(),
+      false);
 }
 
 uint64_t DwrfData::skipNulls(uint64_t numValues, bool /*nullsOnly*/) {
@@ -89,6 +169,15 @@ void DwrfData::ensureRowGroupIndex() {
   }
 }
 
+const proto::BloomFilterIndex* FOLLY_NULLABLE
+DwrfData::ensureBloomFilterIndex() {
+  if (bloomFilterStream_) {
+    bloomFilterIndex_ = ProtoUtils::readProto<proto::BloomFilterIndex>(
+        std::move(bloomFilterStream_));
+  }
+  return bloomFilterIndex_.get();
+}
+
 dwio::common::PositionProvider DwrfData::seekToRowGroup(uint32_t index) {
   ensureRowGroupIndex();
   tempPositions_ = toPositionsInner(index_->entry(index));
@@ -157,6 +246,15 @@ void DwrfData::filterRowGroups(
     result.metadataFilterResults.emplace_back(
         scanSpec.metadataFilterNodeAt(i), std::vector<uint64_t>(nwords));
   }
+  // The bloom filters are decoded only for filters they can evaluate.
+  std::vector<uint64_t> hashes;
+  const proto::BloomFilterIndex* bloomFilters = nullptr;
+  if (filter && (bloomFilterIndex_ || bloomFilterStream_)) {
+    hashes = bloomFilterHashes(*filter);
+    if (!hashes.empty()) {
+      bloomFilters = ensureBloomFilterIndex();
+    }
+  }
   for (auto i = 0; i < index_->entry_size(); i++) {
     const auto& entry = index_->entry(i);
     auto columnStats =
@@ -168,6 +266,13 @@ void DwrfData::filterRowGroups(
       bits::setBit(result.filterResult.data(), i);
       continue;
     }
+    if (bloomFilters && i < bloomFilters->bloomfilter_size() &&
+        !mayContainAny(bloomFilters->bloomfilter(i), hashes)) {
+      VLOG(1) << "Drop stride " << i << " by bloom filter on "
+              << scanSpec.toString();
+      bits::setBit(result.filterResult.data(), i);
+      continue;
+    }
     for (int j = 0; j < scanSpec.numMetadataFilters(); ++j) {
       auto* metadataFilter = scanSpec.metadataFilterAt(j);
       if (!testFilter(
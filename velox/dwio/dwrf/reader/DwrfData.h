@@ -89,6 +89,10 @@ class DwrfData : public dwio::common::FormatData {
     return *index_;
   }
 
+  // Decodes the bloom filters of the row groups of 'this' in the stripe, if
+  // not already decoded. Returns nullptr if there are no bloom filters.
+  const proto::BloomFilterIndex* FOLLY_NULLABLE ensureBloomFilterIndex();
+
  private:
   static std::vector<uint64_t> toPositionsInner(
       const proto::RowIndexEntry& entry) {
@@ -102,6 +106,8 @@ class DwrfData : public dwio::common::FormatData {
   std::unique_ptr<ByteRleDecoder> notNullDecoder_;
   std::unique_ptr<dwio::common::SeekableInputStream> indexStream_;
   std::unique_ptr<proto::RowIndex> index_;
+  std::unique_ptr<dwio::common::SeekableInputStream> bloomFilterStream_;
+  std::unique_ptr<proto::BloomFilterIndex> bloomFilterIndex_;
   // Number of rows in a row group. Last row group may have fewer rows.
   uint32_t rowsPerRowGroup_;
 
@@ -435,9 +435,25 @@ void DwrfRowReader::startNextStripe() {
     VLOG(1) << "[DWRF] Load read plan for stripe " << currentStripe;
     stripeStreams.loadReadPlan();
   }
+  stripeStreams.decompressStreams();
 
   stripeDictionaryCache_ = stripeStreams.getStripeDictionaryCache();
   newStripeLoaded = true;
+  maybePrefetchNextStripe();
+}
+
+void DwrfRowReader::maybePrefetchNextStripe() {
+  auto& executor = options_.getIOExecutor();
+  if (!options_.getPreloadStripe() || !executor ||
+      currentStripe + 1 >= lastStripe) {
+    return;
+  }
+  auto nextStripeInfo = getReader().getFooter().stripes(currentStripe + 1);
+  const auto bytes = nextStripeInfo.indexLength() +
+      nextStripeInfo.dataLength() + nextStripeInfo.footerLength();
+  if (bytes <= options_.getMaxPrefetchStripeBytes()) {
+    prefetchStripe(currentStripe + 1, *executor);
+  }
 }
 
 size_t DwrfRowReader::estimatedReaderMemory() const {
@@ -569,7 +585,9 @@ DwrfReader::DwrfReader(
           options.getFilePreloadThreshold(),
           options.getFileFormat() == FileFormat::ORC ? FileFormat::ORC
                                                      : FileFormat::DWRF,
-          options.isFileColumnNamesReadAsLowerCase())),
+          options.isFileColumnNamesReadAsLowerCase(),
+          options.fileMetadataCache(),
+          options.fileModificationTime())),
       options_(options) {}
 
 std::unique_ptr<StripeInformation> DwrfReader::getStripe(
@@ -152,6 +152,10 @@ class DwrfRowReader : public StrideIndexProvider,
 
   // internal methods
 
+  // Starts reading the stripe after the current one on the IO executor if
+  // stripes are preloaded and the stripe is within the prefetch limit.
+  void maybePrefetchNextStripe();
+
   std::optional<size_t> estimatedRowSizeHelper(
       const FooterWrapper& footer,
       const dwio::common::Statistics& stats,
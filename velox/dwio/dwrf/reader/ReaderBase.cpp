@@ -93,19 +93,83 @@ ReaderBase::ReaderBase(
     uint64_t directorySizeGuess,
     uint64_t filePreloadThreshold,
     FileFormat fileFormat,
-    bool fileColumnNamesReadAsLowerCase)
+    bool fileColumnNamesReadAsLowerCase,
+    dwio::common::FileMetadataCache* fileMetadataCache,
+    int64_t fileModificationTime)
     : pool_{pool},
       arena_(std::make_unique<google::protobuf::Arena>()),
       decryptorFactory_(decryptorFactory),
       directorySizeGuess_(directorySizeGuess),
       filePreloadThreshold_(filePreloadThreshold),
       input_(std::move(input)) {
-  // read last bytes into buffer to get PostScript
-  // If file is small, load the entire file.
-  // TODO: make a config
   fileLength_ = input_->getReadFile()->size();
   DWIO_ENSURE(fileLength_ > 0, "ORC file is empty");
 
+  std::shared_ptr<const DwrfFileMetadata> metadata;
+  dwio::common::FileMetadataKey key;
+  if (fileMetadataCache) {
+    key = {
+        input_->getReadFile()->getName(), fileLength_, fileModificationTime};
+    metadata = fileMetadataCache->get<DwrfFileMetadata>(key);
+    const auto expectedFormat = fileFormat == FileFormat::DWRF
+        ? DwrfFormat::kDwrf
+        : DwrfFormat::kOrc;
+    if (metadata && metadata->postScript->format() != expectedFormat) {
+      metadata = nullptr;
+    }
+  }
+  if (metadata) {
+    psLength_ = metadata->psLength;
+    if (metadata->stripeCache) {
+      cache_ = std::make_unique<StripeMetadataCache>(
+          metadata->postScript->cacheMode(),
+          *metadata->footer,
+          metadata->stripeCache);
+    }
+  } else {
+    auto tail = readTail(
+        fileFormat,
+        fileMetadataCache ? fileMetadataCache->pool() : nullptr);
+    if (fileMetadataCache) {
+      fileMetadataCache->put(key, tail);
+    }
+    metadata = std::move(tail);
+  }
+  postScript_ = std::shared_ptr<const PostScript>(
+      metadata, metadata->postScript.get());
+  footer_ =
+      std::shared_ptr<const FooterWrapper>(metadata, metadata->footer.get());
+
+  schema_ = std::dynamic_pointer_cast<const RowType>(
+      convertType(*footer_, 0, fileColumnNamesReadAsLowerCase));
+  DWIO_ENSURE_NOT_NULL(schema_, "invalid schema");
+
+  if (!cache_ && input_->shouldPrefetchStripes()) {
+    auto numStripes = getFooter().stripesSize();
+    for (auto i = 0; i < numStripes; i++) {
+      const auto stripe = getFooter().stripes(i);
+      input_->enqueue(
+          {stripe.offset() + stripe.indexLength() + stripe.dataLength(),
+           stripe.footerLength(),
+           "stripe_footer"});
+    }
+    if (numStripes) {
+      input_->load(LogType::FOOTER);
+    }
+  }
+  // initialize file decrypter
+  handler_ = DecryptionHandler::create(*footer_, decryptorFactory_.get());
+}
+
+std::shared_ptr<DwrfFileMetadata> ReaderBase::readTail(
+    FileFormat fileFormat,
+    const std::shared_ptr<MemoryPool>& stripeCachePool) {
+  auto metadata = std::make_shared<DwrfFileMetadata>();
+  metadata->arena = std::make_unique<google::protobuf::Arena>();
+
+  // read last bytes into buffer to get PostScript
+  // If file is small, load the entire file.
+  // TODO: make a config
   auto preloadFile = fileLength_ <= filePreloadThreshold_;
   uint64_t readSize =
       preloadFile ? fileLength_ : std::min(fileLength_, directorySizeGuess_);
@@ -127,16 +191,20 @@ ReaderBase::ReaderBase(
       psLength_ + 4, // 1 byte for post script len, 3 byte "ORC" header.
       fileLength_,
       "Corrupted file, Post script size is invalid");
+  metadata->psLength = psLength_;
 
   if (fileFormat == FileFormat::DWRF) {
     auto postScript = ProtoUtils::readProto<proto::PostScript>(
         input_->read(fileLength_ - psLength_ - 1, psLength_, LogType::FOOTER));
-    postScript_ = std::make_unique<PostScript>(std::move(postScript));
+    metadata->postScript = std::make_unique<PostScript>(std::move(postScript));
   } else {
     auto postScript = ProtoUtils::readProto<proto::orc::PostScript>(
         input_->read(fileLength_ - psLength_ - 1, psLength_, LogType::FOOTER));
-    postScript_ = std::make_unique<PostScript>(std::move(postScript));
+    metadata->postScript = std::make_unique<PostScript>(std::move(postScript));
   }
+  // createDecompressedStream() reads the compression from 'postScript_'.
+  postScript_ = std::shared_ptr<const PostScript>(
+      metadata, metadata->postScript.get());
 
   uint64_t footerSize = postScript_->footerLength();
   uint64_t cacheSize =
@@ -167,58 +235,49 @@ ReaderBase::ReaderBase(
   auto footerStream = input_->read(
       fileLength_ - psLength_ - footerSize - 1, footerSize, LogType::FOOTER);
   if (fileFormat == FileFormat::DWRF) {
-    auto footer =
-        google::protobuf::Arena::CreateMessage<proto::Footer>(arena_.get());
+    auto footer = google::protobuf::Arena::CreateMessage<proto::Footer>(
+        metadata->arena.get());
     ProtoUtils::readProtoInto<proto::Footer>(
         createDecompressedStream(std::move(footerStream), "File Footer"),
         footer);
-    footer_ = std::make_unique<FooterWrapper>(footer);
+    metadata->footer = std::make_unique<FooterWrapper>(footer);
   } else {
     auto footer = google::protobuf::Arena::CreateMessage<proto::orc::Footer>(
-        arena_.get());
+        metadata->arena.get());
     ProtoUtils::readProtoInto<proto::orc::Footer>(
         createDecompressedStream(std::move(footerStream), "File Footer"),
         footer);
-    footer_ = std::make_unique<FooterWrapper>(footer);
+    metadata->footer = std::make_unique<FooterWrapper>(footer);
   }
 
-  schema_ = std::dynamic_pointer_cast<const RowType>(
-      convertType(*footer_, 0, fileColumnNamesReadAsLowerCase));
-  DWIO_ENSURE_NOT_NULL(schema_, "invalid schema");
-
   // load stripe index/footer cache
   if (cacheSize > 0) {
     DWIO_ENSURE_EQ(format(), DwrfFormat::kDwrf);
-    if (input_->shouldPrefetchStripes()) {
+    if (stripeCachePool) {
+      // Copied into memory of the metadata cache, which outlives the input.
+      metadata->pool = stripeCachePool;
+      metadata->stripeCache = std::make_shared<dwio::common::DataBuffer<char>>(
+          *stripeCachePool, cacheSize);
+      input_->read(fileLength_ - tailSize, cacheSize, LogType::FOOTER)
+          ->readFully(metadata->stripeCache->data(), cacheSize);
+      cache_ = std::make_unique<StripeMetadataCache>(
+          postScript_->cacheMode(), *metadata->footer, metadata->stripeCache);
+    } else if (input_->shouldPrefetchStripes()) {
       cache_ = std::make_unique<StripeMetadataCache>(
           postScript_->cacheMode(),
-          *footer_,
+          *metadata->footer,
           input_->read(fileLength_ - tailSize, cacheSize, LogType::FOOTER));
       input_->load(LogType::FOOTER);
     } else {
       auto cacheBuffer =
-          std::make_shared<dwio::common::DataBuffer<char>>(pool, cacheSize);
+          std::make_shared<dwio::common::DataBuffer<char>>(pool_, cacheSize);
       input_->read(fileLength_ - tailSize, cacheSize, LogType::FOOTER)
           ->readFully(cacheBuffer->data(), cacheSize);
       cache_ = std::make_unique<StripeMetadataCache>(
-          postScript_->cacheMode(), *footer_, std::move(cacheBuffer));
+          postScript_->cacheMode(), *metadata->footer, std::move(cacheBuffer));
     }
   }
-  if (!cache_ && input_->shouldPrefetchStripes()) {
-    auto numStripes = getFooter().stripesSize();
-    for (auto i = 0; i < numStripes; i++) {
-      const auto stripe = getFooter().stripes(i);
-      input_->enqueue(
-          {stripe.offset() + stripe.indexLength() + stripe.dataLength(),
-           stripe.footerLength(),
-           "stripe_footer"});
-    }
-    if (numStripes) {
-      input_->load(LogType::FOOTER);
-    }
-  }
-  // initialize file decrypter
-  handler_ = DecryptionHandler::create(*footer_, decryptorFactory_.get());
+  return metadata;
 }
 
 std::vector<uint64_t> ReaderBase::getRowsPerStripe() const {
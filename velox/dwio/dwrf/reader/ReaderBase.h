@@ -59,9 +59,29 @@ class FooterStatisticsImpl : public dwio::common::Statistics {
   }
 };
 
+/// Parsed tail of a DWRF or ORC file. Shared by the readers of a file
+/// through the dwio::common::FileMetadataCache.
+struct DwrfFileMetadata : public dwio::common::FileMetadata {
+  // Owns the footer.
+  std::unique_ptr<google::protobuf::Arena> arena;
+  std::unique_ptr<PostScript> postScript;
+  std::unique_ptr<FooterWrapper> footer;
+  uint64_t psLength{0};
+  // Keeps the pool of 'stripeCache' alive.
+  std::shared_ptr<memory::MemoryPool> pool;
+  // Stripe index and footer cache of the file, if any.
+  std::shared_ptr<dwio::common::DataBuffer<char>> stripeCache;
+
+  uint64_t sizeBytes() const override {
+    return sizeof(*this) + arena->SpaceUsed() +
+        (stripeCache ? stripeCache->capacity() : 0);
+  }
+};
+
 class ReaderBase {
  public:
-  // create reader base from buffered input
+  // create reader base from buffered input. Reuses the parsed tail from
+  // 'fileMetadataCache' if given and caches the tail on a miss.
   ReaderBase(
       memory::MemoryPool& pool,
       std::unique_ptr<dwio::common::BufferedInput> input,
@@ -72,7 +92,9 @@ class ReaderBase {
       uint64_t filePreloadThreshold =
           dwio::common::ReaderOptions::kDefaultFilePreloadThreshold,
       dwio::common::FileFormat fileFormat = dwio::common::FileFormat::DWRF,
-      bool fileColumnNamesReadAsLowerCase = false);
+      bool fileColumnNamesReadAsLowerCase = false,
+      dwio::common::FileMetadataCache* fileMetadataCache = nullptr,
+      int64_t fileModificationTime = 0);
 
   ReaderBase(
       memory::MemoryPool& pool,
@@ -235,10 +257,18 @@ class ReaderBase {
       uint32_t index = 0,
       bool fileColumnNamesReadAsLowerCase = false);
 
+  // Reads and parses the tail of the file. Reads the stripe metadata cache
+  // into memory of 'stripeCachePool' if given and into 'cache_' otherwise.
+  std::shared_ptr<DwrfFileMetadata> readTail(
+      dwio::common::FileFormat fileFormat,
+      const std::shared_ptr<memory::MemoryPool>& stripeCachePool);
+
   memory::MemoryPool& pool_;
   std::unique_ptr<google::protobuf::Arena> arena_;
-  std::unique_ptr<PostScript> postScript_;
-  std::unique_ptr<FooterWrapper> footer_ = nullptr;
+  // Share the ownership of a DwrfFileMetadata unless given to the
+  // constructor.
+  std::shared_ptr<const PostScript> postScript_;
+  std::shared_ptr<const FooterWrapper> footer_ = nullptr;
   std::unique_ptr<StripeMetadataCache> cache_;
   // Keeps factory alive for possibly async prefetch.
   std::shared_ptr<dwio::common::encryption::DecrypterFactory> decryptorFactory_;
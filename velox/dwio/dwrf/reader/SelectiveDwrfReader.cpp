@@ -93,6 +93,11 @@ std::unique_ptr<SelectiveColumnReader> SelectiveDwrfReader::build(
         return createSelectiveFlatMapColumnReader(
             requestedType, dataType, params, scanSpec);
       }
+      VELOX_USER_CHECK_EQ(
+          stripe.getRowReaderOptions().getMapColumnIdAsStruct().count(
+              requestedType->id()),
+          0,
+          "Reading a map column as a struct requires flat map encoding");
       return std::make_unique<SelectiveMapColumnReader>(
           requestedType, dataType, params, scanSpec);
     case TypeKind::REAL:
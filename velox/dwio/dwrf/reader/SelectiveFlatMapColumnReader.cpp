@@ -198,6 +198,11 @@ class SelectiveFlatMapAsStructReader : public SelectiveStructColumnReaderBase {
     VELOX_CHECK(
         !keyNodes_.empty(),
         "For struct encoding, keys to project must be configured");
+    // Keys not in this stripe read as nulls. The subscripts may be left from
+    // the previous stripe.
+    for (auto& childSpec : scanSpec.children()) {
+      childSpec->setSubscript(kConstantChildSpecSubscript);
+    }
     children_.resize(keyNodes_.size());
     for (int i = 0; i < keyNodes_.size(); ++i) {
       keyNodes_[i].reader->scanSpec()->setSubscript(i);
@@ -33,26 +33,17 @@ StripeInformationWrapper StripeReaderBase::loadStripe(
   uint64_t offset = stripe.offset();
   uint64_t length =
       stripe.indexLength() + stripe.dataLength() + stripe.footerLength();
+  auto prefetched = takePrefetch(index);
   if (reader_->getBufferedInput().isBuffered(offset, length)) {
     // if file is preloaded, return stripe is preloaded
     preload = true;
+  } else if (prefetched && preload) {
+    stripeInput_ = std::move(prefetched);
   } else {
     stripeInput_ = reader_->getBufferedInput().clone();
 
     if (preload) {
-      // If metadata cache exists, adjust read position to avoid re-reading
-      // metadata sections
-      if (cache) {
-        if (cache->has(StripeCacheMode::INDEX, index)) {
-          offset += stripe.indexLength();
-          length -= stripe.indexLength();
-        }
-        if (cache->has(StripeCacheMode::FOOTER, index)) {
-          length -= stripe.footerLength();
-        }
-      }
-
-      stripeInput_->enqueue({offset, length, "stripe"});
+      enqueueStripe(index, *stripeInput_);
       stripeInput_->load(LogType::STRIPE);
     }
   }
@@ -88,6 +79,77 @@ StripeInformationWrapper StripeReaderBase::loadStripe(
   return stripe;
 }
 
+StripeReaderBase::~StripeReaderBase() {
+  try {
+    waitForPrefetch();
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Error in stripe prefetch: " << e.what();
+  }
+}
+
+void StripeReaderBase::enqueueStripe(
+    uint32_t index,
+    dwio::common::BufferedInput& input) const {
+  auto stripe = reader_->getFooter().stripes(index);
+  auto& cache = reader_->getMetadataCache();
+  uint64_t offset = stripe.offset();
+  uint64_t length =
+      stripe.indexLength() + stripe.dataLength() + stripe.footerLength();
+  // If metadata cache exists, adjust read position to avoid re-reading
+  // metadata sections
+  if (cache) {
+    if (cache->has(StripeCacheMode::INDEX, index)) {
+      offset += stripe.indexLength();
+      length -= stripe.indexLength();
+    }
+    if (cache->has(StripeCacheMode::FOOTER, index)) {
+      length -= stripe.footerLength();
+    }
+  }
+  input.enqueue({offset, length, "stripe"});
+}
+
+void StripeReaderBase::prefetchStripe(
+    uint32_t index,
+    folly::Executor& executor) {
+  DWIO_ENSURE(canLoad_);
+  if (prefetchInput_) {
+    return;
+  }
+  auto stripe = reader_->getFooter().stripes(index);
+  if (reader_->getBufferedInput().isBuffered(
+          stripe.offset(),
+          stripe.indexLength() + stripe.dataLength() +
+              stripe.footerLength())) {
+    return;
+  }
+  prefetchInput_ = reader_->getBufferedInput().clone();
+  enqueueStripe(index, *prefetchInput_);
+  prefetchIndex_ = index;
+  prefetchFuture_ = folly::via(&executor, [input = prefetchInput_.get()]() {
+    input->load(LogType::STRIPE);
+  });
+}
+
+void StripeReaderBase::waitForPrefetch() {
+  if (prefetchFuture_.valid()) {
+    std::move(prefetchFuture_).get();
+  }
+}
+
+std::unique_ptr<dwio::common::BufferedInput> StripeReaderBase::takePrefetch(
+    uint32_t index) {
+  if (!prefetchInput_) {
+    return nullptr;
+  }
+  // The input must stay live until the read is done, also if it fails.
+  auto input = std::move(prefetchInput_);
+  const bool match = prefetchIndex_ == index;
+  prefetchIndex_.reset();
+  waitForPrefetch();
+  return match ? std::move(input) : nullptr;
+}
+
 void StripeReaderBase::loadEncryptionKeys(uint32_t index) {
   if (!handler_->isEncrypted()) {
     return;
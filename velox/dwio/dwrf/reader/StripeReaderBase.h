@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <folly/futures/Future.h>
+
 #include "velox/dwio/common/BufferedInput.h"
 #include "velox/dwio/common/Options.h"
 #include "velox/dwio/dwrf/common/Decryption.h"
@@ -44,10 +46,16 @@ class StripeReaderBase {
     DWIO_ENSURE(footer->GetArena());
   }
 
-  virtual ~StripeReaderBase() = default;
+  virtual ~StripeReaderBase();
 
   StripeInformationWrapper loadStripe(uint32_t index, bool& preload);
 
+  // Starts reading all of stripe 'index' into a new input on 'executor'. A
+  // following loadStripe() of 'index' with 'preload' set waits for the read
+  // and uses its input instead of reading the stripe on the calling thread.
+  // Does nothing if the file is buffered or a prefetch is in progress.
+  void prefetchStripe(uint32_t index, folly::Executor& executor);
+
   const proto::StripeFooter& getStripeFooter() const {
     DWIO_ENSURE_NOT_NULL(footer_, "stripe not loaded");
     return *footer_;
@@ -77,8 +85,26 @@ class StripeReaderBase {
   std::optional<uint32_t> lastStripeIndex_;
   bool canLoad_{true};
 
+  // Input and stripe of the prefetch started by prefetchStripe() and the read
+  // on the executor.
+  std::unique_ptr<dwio::common::BufferedInput> prefetchInput_;
+  std::optional<uint32_t> prefetchIndex_;
+  folly::Future<folly::Unit> prefetchFuture_{
+      folly::Future<folly::Unit>::makeEmpty()};
+
   void loadEncryptionKeys(uint32_t index);
 
+  // Enqueues the part of stripe 'index' that is not in the metadata cache in
+  // 'input'.
+  void enqueueStripe(uint32_t index, dwio::common::BufferedInput& input) const;
+
+  // Waits for the read of a prefetch in progress. Rethrows its error.
+  void waitForPrefetch();
+
+  // Waits for a prefetch in progress and returns its input if it is for
+  // stripe 'index'. Drops the prefetch otherwise.
+  std::unique_ptr<dwio::common::BufferedInput> takePrefetch(uint32_t index);
+
   friend class StripeLoadKeysTest;
 };
 
@@ -16,6 +16,7 @@
 
 #include <folly/ScopeGuard.h>
 #include <folly/container/F14Set.h>
+#include <folly/futures/Future.h>
 
 #include "velox/common/base/BitSet.h"
 #include "velox/dwio/common/exception/Exception.h"
@@ -296,10 +297,51 @@ std::unique_ptr<dwio::common::SeekableInputStream> StripeStreamsImpl::getStream(
 
   auto streamDebugInfo =
       fmt::format("Stripe {} Stream {}", stripeIndex_, si.toString());
-  return reader_.getReader().createDecompressedStream(
-      std::move(streamRead),
-      streamDebugInfo,
-      getDecrypter(si.encodingKey().node()));
+  const auto* decrypter = getDecrypter(si.encodingKey().node());
+  auto decompressed = reader_.getReader().createDecompressedStream(
+      std::move(streamRead), streamDebugInfo, decrypter);
+  if (!readPlanLoaded_ &&
+      decompressStreamBytes_ + info.getLength() <=
+          opts_.getMaxDecompressStripeBytes()) {
+    using dwio::common::compression::PagedInputStream;
+    if (auto* paged = dynamic_cast<PagedInputStream*>(decompressed.get())) {
+      if (decrypter) {
+        // The streams of an encryption group share its decrypter. Each
+        // stream decrypted by decompressStreams() gets its own copy.
+        paged->setOwnedDecrypter(decrypter->clone());
+      }
+      decompressStreams_.push_back(paged);
+      decompressStreamBytes_ += info.getLength();
+    }
+  }
+  return decompressed;
+}
+
+void StripeStreamsImpl::decompressStreams() {
+  if (decompressStreams_.empty()) {
+    return;
+  }
+  SCOPE_EXIT {
+    decompressStreams_.clear();
+    decompressStreamBytes_ = 0;
+  };
+  auto& executor = opts_.getIOExecutor();
+  if (!executor || decompressStreams_.size() == 1) {
+    for (auto* stream : decompressStreams_) {
+      stream->decompressAll();
+    }
+    return;
+  }
+  std::vector<folly::SemiFuture<folly::Unit>> futures;
+  futures.reserve(decompressStreams_.size());
+  for (auto* stream : decompressStreams_) {
+    futures.push_back(folly::via(executor.get(), [stream]() {
+                        stream->decompressAll();
+                      }).semi());
+  }
+  for (auto& result : folly::collectAll(std::move(futures)).get()) {
+    result.throwUnlessValue();
+  }
 }
 
 uint32_t StripeStreamsImpl::visitStreamsOfNode(
@@ -19,6 +19,7 @@
 #include "velox/dwio/common/ColumnSelector.h"
 #include "velox/dwio/common/Options.h"
 #include "velox/dwio/common/SeekableInputStream.h"
+#include "velox/dwio/common/compression/PagedInputStream.h"
 #include "velox/dwio/dwrf/common/Common.h"
 #include "velox/dwio/dwrf/reader/StreamLabels.h"
 #include "velox/dwio/dwrf/reader/StripeDictionaryCache.h"
@@ -225,6 +226,13 @@ class StripeStreamsImpl : public StripeStreamsBase {
   folly::F14FastMap<EncodingKey, proto::ColumnEncoding, EncodingKeyHash>
       decryptedEncodings_;
 
+  // Streams returned by getStream() to decompress in decompressStreams(). The
+  // streams are owned by the column readers of the stripe.
+  mutable std::vector<dwio::common::compression::PagedInputStream*>
+      decompressStreams_;
+  // Compressed bytes of 'decompressStreams_'.
+  mutable uint64_t decompressStreamBytes_{0};
+
  public:
   StripeStreamsImpl(
       const StripeReaderBase& reader,
@@ -275,6 +283,12 @@ class StripeStreamsImpl : public StripeStreamsBase {
   // load data into buffer according to read plan
   void loadReadPlan();
 
+  // Decompresses the streams returned by getStream() up to
+  // RowReaderOptions::getMaxDecompressStripeBytes() of compressed data, in
+  // parallel on the IO executor if there is one. Called after the column
+  // readers are made and before they read.
+  void decompressStreams();
+
   std::unique_ptr<dwio::common::SeekableInputStream> getCompressedStream(
       const DwrfStreamIdentifier& si,
       std::string_view label) const;
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <boost/crc.hpp>
 #include <gtest/gtest.h>
 #include "velox/dwio/dwrf/common/Checksum.h"
 
@@ -61,3 +62,25 @@ TEST_F(ChecksumTests, xxHash) {
 TEST_F(ChecksumTests, Crc32) {
   runTest(proto::ChecksumAlgorithm::CRC32, 4133052486, 3074245904);
 }
+
+TEST_F(ChecksumTests, unalignedUpdates) {
+  boost::crc_32_type expectedCrc;
+  expectedCrc.process_bytes(data.data(), data.size());
+  for (auto type :
+       {proto::ChecksumAlgorithm::XXHASH, proto::ChecksumAlgorithm::CRC32}) {
+    auto checksum = ChecksumFactory::create(type);
+    checksum->update(data.data(), data.size());
+    const auto expected = checksum->getDigest();
+    if (type == proto::ChecksumAlgorithm::CRC32) {
+      ASSERT_EQ(expected, expectedCrc.checksum());
+    }
+    // Splits the data at positions that are not multiples of the word size.
+    size_t offset = 0;
+    for (size_t size = 1; offset < data.size(); size = size * 3 + 1) {
+      const auto length = std::min(size, data.size() - offset);
+      checksum->update(data.data() + offset, length);
+      offset += length;
+    }
+    ASSERT_EQ(checksum->getDigest(), expected);
+  }
+}
@@ -15,6 +15,7 @@
  */
 
 #include <folly/Random.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <random>
 #include "velox/dwio/common/Options.h"
 #include "velox/dwio/common/Statistics.h"
@@ -897,6 +898,46 @@ TEST_F(E2EWriterTests, OversizeBatches) {
       false);
 }
 
+TEST_F(E2EWriterTests, parallelFlush) {
+  HiveTypeParser parser;
+  auto type = parser.parse(
+      "struct<"
+      "long_val:bigint,"
+      "string_val:string,"
+      "double_val:double,"
+      "array_val:array<int>,"
+      "struct_val:struct<a:float,b:string>"
+      ">");
+  auto config = std::make_shared<Config>();
+  config->set(Config::COMPRESSION, velox::common::CompressionKind_ZSTD);
+  auto batches = E2EWriterTestUtil::generateBatches(
+      type, 10, 1'000, /* seed */ 1411367325, *leafPool_);
+
+  const auto write = [&](std::shared_ptr<folly::Executor> executor) {
+    auto sink = std::make_unique<MemorySink>(
+        200 * kSizeMB, FileSink::Options{.pool = leafPool_.get()});
+    auto* sinkPtr = sink.get();
+    dwrf::WriterOptions options;
+    options.config = config;
+    options.schema = type;
+    options.flushPolicyFactory =
+        E2EWriterTestUtil::simpleFlushPolicyFactory(true);
+    options.flushExecutor = std::move(executor);
+    Writer writer(std::move(sink), options, rootPool_);
+    for (const auto& batch : batches) {
+      writer.write(batch);
+    }
+    writer.close();
+    return std::string(sinkPtr->data(), sinkPtr->size());
+  };
+
+  // The columns flushed in parallel produce the same file.
+  const auto expected = write(nullptr);
+  const auto actual = write(std::make_shared<folly::CPUThreadPoolExecutor>(4));
+  ASSERT_EQ(expected.size(), actual.size());
+  EXPECT_TRUE(expected == actual);
+}
+
 TEST_F(E2EWriterTests, OverflowLengthIncrements) {
   auto pool = facebook::velox::memory::addDefaultLeafMemoryPool();
 
@@ -1180,6 +1221,43 @@ TEST_F(E2EEncryptionTest, EncryptSelectedFields) {
   validateFileContent(*reader);
 }
 
+TEST_F(E2EEncryptionTest, decryptStreamsInParallel) {
+  auto spec =
+      std::make_shared<EncryptionSpecification>(EncryptionProvider::Unknown);
+  spec->withEncryptedField(
+          FieldEncryptionSpecification{}.withIndex(1).withEncryptionProperties(
+              std::make_shared<TestEncryptionProperties>("key1")))
+      .withEncryptedField(
+          FieldEncryptionSpecification{}.withIndex(2).withEncryptionProperties(
+              std::make_shared<TestEncryptionProperties>("key1")))
+      .withEncryptedField(
+          FieldEncryptionSpecification{}.withIndex(3).withEncryptionProperties(
+              std::make_shared<TestEncryptionProperties>("key2")))
+      .withEncryptedField(
+          FieldEncryptionSpecification{}.withIndex(4).withEncryptionProperties(
+              std::make_shared<TestEncryptionProperties>("key2")));
+  batchSize_ = 1'000;
+  auto reader = writeAndRead(
+      "struct<a:int,b:bigint,c:string,d:double,e:array<int>>", spec);
+  ASSERT_EQ(getDecryptionHandler(*reader).getEncryptionGroupCount(), 2);
+
+  // The streams of each stripe are decrypted up front on the IO executor,
+  // each with its own clone of the decrypter of its encryption group.
+  auto executor = std::make_shared<folly::CPUThreadPoolExecutor>(4);
+  for (auto i = 0; i < 3; ++i) {
+    RowReaderOptions rowReaderOpts;
+    rowReaderOpts.setMaxDecompressStripeBytes(64 << 20);
+    rowReaderOpts.setIOExecutor(executor);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    VectorPtr batch;
+    for (auto& expected : batches_) {
+      ASSERT_TRUE(rowReader->next(batchSize_, batch));
+      compareBatches(batch, expected);
+    }
+    ASSERT_FALSE(rowReader->next(batchSize_, batch));
+  }
+}
+
 TEST_F(E2EEncryptionTest, EncryptEmptyFile) {
   auto spec =
       std::make_shared<EncryptionSpecification>(EncryptionProvider::Unknown);
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/init/Init.h>
+
+#include "velox/common/file/File.h"
+#include "velox/dwio/common/encryption/TestProvider.h"
+#include "velox/dwio/dwrf/reader/DwrfReader.h"
+#include "velox/dwio/dwrf/writer/Writer.h"
+#include "velox/vector/FlatVector.h"
+
+// Compares scans of plaintext columns with scans of encrypted columns of the
+// same data, decrypted while reading or up front for each stripe. Uses the
+// test cipher of TestProvider.h. The cost of a real cipher comes from the
+// DecrypterFactory of the application.
+
+using namespace facebook::velox;
+using namespace facebook::velox::dwio::common;
+using namespace facebook::velox::dwio::common::encryption;
+using namespace facebook::velox::dwio::common::encryption::test;
+using namespace facebook::velox::dwrf;
+using namespace facebook::velox::dwrf::encryption;
+
+namespace {
+constexpr int32_t kNumBatches = 100;
+constexpr int32_t kBatchSize = 10'000;
+
+std::shared_ptr<memory::MemoryPool> rootPool;
+std::shared_ptr<memory::MemoryPool> leafPool;
+std::shared_ptr<folly::Executor> ioExecutor;
+// Owns the MemorySink with the file.
+std::unique_ptr<Writer> writer;
+MemorySink* sink;
+
+// Writes 4 bigint columns, of which c0 and c1 are encrypted.
+void writeFile() {
+  auto type = ROW(
+      {"c0", "c1", "c2", "c3"}, {BIGINT(), BIGINT(), BIGINT(), BIGINT()});
+  auto spec =
+      std::make_shared<EncryptionSpecification>(EncryptionProvider::Unknown);
+  for (auto i = 0; i < 2; ++i) {
+    spec->withEncryptedField(
+        FieldEncryptionSpecification{}.withIndex(i).withEncryptionProperties(
+            std::make_shared<TestEncryptionProperties>("key")));
+  }
+  auto memorySink = std::make_unique<MemorySink>(
+      512 << 20, FileSink::Options{.pool = leafPool.get()});
+  sink = memorySink.get();
+  WriterOptions options;
+  options.config = std::make_shared<Config>();
+  options.schema = type;
+  options.encryptionSpec = spec;
+  options.encrypterFactory = std::make_shared<TestEncrypterFactory>();
+  writer = std::make_unique<Writer>(std::move(memorySink), options, rootPool);
+  for (auto i = 0; i < kNumBatches; ++i) {
+    auto batch =
+        BaseVector::create<RowVector>(type, kBatchSize, leafPool.get());
+    for (auto column = 0; column < type->size(); ++column) {
+      // Columns 0 and 2, and 1 and 3 have the same values.
+      auto* values = batch->childAt(column)->asFlatVector<int64_t>();
+      for (auto row = 0; row < kBatchSize; ++row) {
+        values->set(row, (i * kBatchSize + row) * (1 + column % 2) % 100'000);
+      }
+    }
+    writer->write(batch);
+  }
+  writer->close();
+}
+
+uint64_t readColumns(
+    const std::vector<std::string>& columns,
+    uint64_t maxDecompressStripeBytes) {
+  ReaderOptions readerOpts{leafPool.get()};
+  readerOpts.setDecrypterFactory(std::make_shared<TestDecrypterFactory>());
+  std::string_view data(sink->data(), sink->size());
+  auto reader = std::make_unique<DwrfReader>(
+      readerOpts,
+      std::make_unique<BufferedInput>(
+          std::make_shared<InMemoryReadFile>(data),
+          readerOpts.getMemoryPool()));
+  RowReaderOptions rowReaderOpts;
+  rowReaderOpts.select(
+      std::make_shared<ColumnSelector>(reader->rowType(), columns));
+  rowReaderOpts.setMaxDecompressStripeBytes(maxDecompressStripeBytes);
+  rowReaderOpts.setIOExecutor(ioExecutor);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+  VectorPtr batch;
+  uint64_t numRows = 0;
+  while (rowReader->next(kBatchSize, batch)) {
+    numRows += batch->size();
+  }
+  return numRows;
+}
+} // namespace
+
+BENCHMARK(plaintext) {
+  folly::doNotOptimizeAway(readColumns({"c2", "c3"}, 0));
+}
+
+BENCHMARK_RELATIVE(encrypted) {
+  folly::doNotOptimizeAway(readColumns({"c0", "c1"}, 0));
+}
+
+BENCHMARK_RELATIVE(encryptedUpFront) {
+  folly::doNotOptimizeAway(readColumns({"c0", "c1"}, 256 << 20));
+}
+
+int32_t main(int32_t argc, char* argv[]) {
+  folly::init(&argc, &argv);
+  rootPool = memory::defaultMemoryManager().addRootPool("EncryptedScan");
+  leafPool = rootPool->addLeafChild("leaf");
+  ioExecutor = std::make_shared<folly::CPUThreadPoolExecutor>(8);
+  writeFile();
+  folly::runBenchmarks();
+  writer.reset();
+  return 0;
+}
@@ -203,6 +203,90 @@ BENCHMARK_RELATIVE(GenerateAutoIdNew_64) {
   }
 }
 
+// Encodes 'count' values produced by 'valueAt' either one value at a time or
+// in batches of 1024 with add().
+template <typename ValueAt>
+static size_t encodeValues(
+    bool rle,
+    bool batched,
+    int64_t count,
+    ValueAt valueAt) {
+  size_t capacity = count * folly::kMaxVarintLength64;
+  auto pool = memory::addDefaultLeafMemoryPool();
+  DataBufferHolder holder{*pool, capacity};
+  auto output = std::make_unique<BufferedOutputStream>(holder);
+  auto encoder = rle
+      ? createRleEncoder<true>(
+            RleVersion_1, std::move(output), true, sizeof(int64_t))
+      : createDirectEncoder<true>(std::move(output), true, sizeof(int64_t));
+
+  int64_t buffer[1024];
+  for (int64_t i = 0; i < count; i += 1024) {
+    int64_t bufCount = std::min(count - i, (int64_t)1024);
+    for (int64_t j = 0; j < bufCount; ++j) {
+      buffer[j] = valueAt(i + j);
+    }
+    if (batched) {
+      encoder->add(buffer, common::Ranges::of(0, bufCount), nullptr);
+    } else {
+      for (int64_t j = 0; j < bufCount; ++j) {
+        encoder->writeValue(buffer[j]);
+      }
+    }
+  }
+  return encoder->flush();
+}
+
+static int64_t smallValue(int64_t i) {
+  return (i * 7) % 60;
+}
+
+static int64_t runValue(int64_t i) {
+  return (i / 500) % 60;
+}
+
+BENCHMARK(directSmallValuesOld) {
+  for (int64_t i = 0; i < iters; i++) {
+    auto result = encodeValues(false, false, 100'000, smallValue);
+    folly::doNotOptimizeAway(result);
+  }
+}
+
+BENCHMARK_RELATIVE(directSmallValuesNew) {
+  for (int64_t i = 0; i < iters; i++) {
+    auto result = encodeValues(false, true, 100'000, smallValue);
+    folly::doNotOptimizeAway(result);
+  }
+}
+
+BENCHMARK(rleV1LiteralsOld) {
+  for (int64_t i = 0; i < iters; i++) {
+    auto result = encodeValues(true, false, 100'000, smallValue);
+    folly::doNotOptimizeAway(result);
+  }
+}
+
+BENCHMARK_RELATIVE(rleV1LiteralsNew) {
+  for (int64_t i = 0; i < iters; i++) {
+    auto result = encodeValues(true, true, 100'000, smallValue);
+    folly::doNotOptimizeAway(result);
+  }
+}
+
+BENCHMARK(rleV1RunsOld) {
+  for (int64_t i = 0; i < iters; i++) {
+    auto result = encodeValues(true, false, 100'000, runValue);
+    folly::doNotOptimizeAway(result);
+  }
+}
+
+BENCHMARK_RELATIVE(rleV1RunsNew) {
+  for (int64_t i = 0; i < iters; i++) {
+    auto result = encodeValues(true, true, 100'000, runValue);
+    folly::doNotOptimizeAway(result);
+  }
+}
+
 int32_t main(int32_t argc, char* argv[]) {
   folly::init(&argc, &argv);
   folly::runBenchmarks();
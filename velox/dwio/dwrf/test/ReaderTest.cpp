@@ -18,6 +18,7 @@
 #include <gtest/gtest.h>
 #include <velox/buffer/Buffer.h>
 #include "folly/Random.h"
+#include "folly/executors/IOThreadPoolExecutor.h"
 #include "folly/lang/Assume.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/dwio/common/FileSink.h"
@@ -524,6 +525,33 @@ TEST(TestReader, testStatsCallbackFiredWithFiltering) {
   EXPECT_EQ(selectedKeyStreamsAggregate, 4);
 }
 
+TEST(TestReader, prefetchStripe) {
+  const std::string fmSmall(getExampleFilePath("fm_small.orc"));
+  ReaderOptions readerOptions{defaultPool.get()};
+  auto reader = DwrfReader::create(
+      createFileBufferedInput(fmSmall, readerOptions.getMemoryPool()),
+      readerOptions);
+  auto executor = std::make_shared<folly::IOThreadPoolExecutor>(2);
+  RowReaderOptions rowReaderOptions;
+  auto rowReader = reader->createRowReader(rowReaderOptions);
+  rowReaderOptions.setPreloadStripe(true);
+  rowReaderOptions.setIOExecutor(executor);
+  auto prefetchReader = reader->createRowReader(rowReaderOptions);
+
+  VectorPtr expected;
+  VectorPtr actual;
+  int32_t numRows = 0;
+  while (rowReader->next(100, expected) > 0) {
+    ASSERT_EQ(prefetchReader->next(100, actual), expected->size());
+    for (auto i = 0; i < expected->size(); ++i) {
+      ASSERT_TRUE(actual->equalValueAt(expected.get(), i, i)) << numRows + i;
+    }
+    numRows += expected->size();
+  }
+  EXPECT_EQ(prefetchReader->next(100, actual), 0);
+  EXPECT_GT(numRows, 0);
+}
+
 TEST(TestReader, testEstimatedSize) {
   const std::string fmSmall(getExampleFilePath("fm_small.orc"));
 
@@ -1379,6 +1407,61 @@ TEST(TestReader, testEmptyFile) {
   EXPECT_FALSE(batch);
 }
 
+TEST(TestReader, fileMetadataCache) {
+  auto pool = memory::addDefaultLeafMemoryPool();
+  auto type = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  VectorMaker maker(pool.get());
+  auto batch = maker.rowVector(
+      {maker.flatVector<int64_t>({1, 2, 3}),
+       maker.flatVector<std::string>({"a", "b", "c"})});
+  auto sink = std::make_unique<MemorySink>(
+      1 << 20, FileSink::Options{.pool = pool.get()});
+  auto* sinkPtr = sink.get();
+  auto config = std::make_shared<Config>();
+  // Owns the sink.
+  auto writer =
+      E2EWriterTestUtil::writeData(std::move(sink), type, {batch}, config);
+  std::string_view data(sinkPtr->data(), sinkPtr->size());
+
+  FileMetadataCache cache(1 << 20);
+  auto read = [&](int64_t modificationTime) {
+    ReaderOptions readerOpts{pool.get()};
+    readerOpts.setFileMetadataCache(&cache);
+    readerOpts.setFileModificationTime(modificationTime);
+    auto reader = DwrfReader::create(
+        std::make_unique<BufferedInput>(
+            std::make_shared<InMemoryReadFile>(data), *pool),
+        readerOpts);
+    EXPECT_EQ(reader->numberOfRows(), 3);
+    EXPECT_TRUE(reader->rowType()->equivalent(*type));
+    auto rowReader = reader->createRowReader(RowReaderOptions{});
+    VectorPtr result;
+    ASSERT_TRUE(rowReader->next(10, result));
+    ASSERT_EQ(result->size(), batch->size());
+    for (auto i = 0; i < batch->size(); ++i) {
+      EXPECT_TRUE(batch->equalValueAt(result.get(), i, i));
+    }
+  };
+
+  read(1);
+  auto stats = cache.stats();
+  EXPECT_EQ(stats.numMisses, 1);
+  EXPECT_EQ(stats.numHits, 0);
+  EXPECT_EQ(stats.numEntries, 1);
+  EXPECT_GT(stats.cachedBytes, 0);
+
+  read(1);
+  stats = cache.stats();
+  EXPECT_EQ(stats.numMisses, 1);
+  EXPECT_EQ(stats.numHits, 1);
+
+  // A new version of the file does not hit the old footer.
+  read(2);
+  stats = cache.stats();
+  EXPECT_EQ(stats.numMisses, 2);
+  EXPECT_EQ(stats.numEntries, 2);
+}
+
 namespace {
 
 using IteraterCallback =
@@ -1832,7 +1915,8 @@ void verifyRowNumbers(
 std::pair<std::unique_ptr<dwrf::Writer>, std::unique_ptr<DwrfReader>>
 createWriterReader(
     const std::vector<VectorPtr>& batches,
-    memory::MemoryPool& pool) {
+    memory::MemoryPool& pool,
+    std::shared_ptr<Config> config = std::make_shared<Config>()) {
   auto sink =
       std::make_unique<MemorySink>(1 << 20, FileSink::Options{.pool = &pool});
   auto* sinkPtr = sink.get();
@@ -1840,7 +1924,7 @@ createWriterReader(
       std::move(sink),
       asRowType(batches[0]->type()),
       batches,
-      std::make_shared<Config>(),
+      std::move(config),
       E2EWriterTestUtil::simpleFlushPolicyFactory(true));
   std::string_view data(sinkPtr->data(), sinkPtr->size());
   auto input = std::make_unique<BufferedInput>(
@@ -1980,3 +2064,77 @@ TEST(TestReader, failToReuseReaderNulls) {
     ASSERT_TRUE(result->equalValueAt(data.get(), i, i)) << result->toString(i);
   }
 }
+
+TEST(TestReader, bloomFilterSkipsStrides) {
+  auto* pool = defaultPool.get();
+  VectorMaker maker(pool);
+  // The values of each stride of 1000 rows span almost the whole range of
+  // the values so that the min and max do not skip any stride.
+  constexpr int32_t kNumRows = 4'000;
+  auto value = [](auto row) { return row * 7 % kNumRows; };
+  auto data = maker.rowVector({
+      maker.flatVector<int64_t>(kNumRows, value),
+      maker.flatVector<std::string>(
+          kNumRows, [&](auto row) { return fmt::format("s{}", value(row)); }),
+      maker.flatVector<int32_t>(kNumRows, value),
+  });
+  auto schema = asRowType(data->type());
+  auto config = std::make_shared<Config>();
+  config->set(Config::ROW_INDEX_STRIDE, 1'000u);
+  config->set<const std::vector<uint32_t>>(
+      Config::BLOOM_FILTER_COLUMNS, {0, 1});
+  auto writerAndReader = createWriterReader({data}, *pool, config);
+  auto& reader = writerAndReader.second;
+
+  auto read = [&](const std::string& column,
+                  std::unique_ptr<common::Filter> filter,
+                  int64_t expectedSkippedStrides) {
+    auto spec = std::make_shared<common::ScanSpec>("<root>");
+    spec->addAllChildFields(*schema);
+    spec->childByName(column)->setFilter(std::move(filter));
+    RowReaderOptions rowReaderOpts;
+    rowReaderOpts.setScanSpec(spec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+    auto result = BaseVector::create(schema, 0, pool);
+    std::vector<int64_t> values;
+    while (rowReader->next(kNumRows, result) > 0) {
+      auto* c0 = result->asUnchecked<RowVector>()
+                     ->childAt(0)
+                     ->loadedVector()
+                     ->asFlatVector<int64_t>();
+      for (auto i = 0; i < result->size(); ++i) {
+        values.push_back(c0->valueAt(i));
+      }
+    }
+    dwio::common::RuntimeStatistics stats;
+    rowReader->updateRuntimeStats(stats);
+    EXPECT_EQ(stats.skippedStrides, expectedSkippedStrides);
+    return values;
+  };
+
+  // Rows 0, 3 and 6 in the first stride have 0, 21 and 42. Rows 2286 and 2287
+  // in the third stride have 2 and 9.
+  EXPECT_EQ(
+      read("c0", std::make_unique<common::BigintRange>(21, 21, false), 3),
+      std::vector<int64_t>({21}));
+  EXPECT_EQ(
+      read("c0", common::createBigintValues({0, 42, 1'000'000}, false), 3),
+      std::vector<int64_t>({0, 42}));
+  EXPECT_EQ(
+      read("c0", common::createBigintValues({21, 2, 9}, false), 2),
+      std::vector<int64_t>({21, 2, 9}));
+  EXPECT_EQ(
+      read(
+          "c1",
+          std::make_unique<common::BytesValues>(
+              std::vector<std::string>{"s0", "s1"}, false),
+          2),
+      std::vector<int64_t>({0, 1}));
+  // Ranges and columns without bloom filters do not skip strides.
+  EXPECT_EQ(
+      read("c0", std::make_unique<common::BigintRange>(20, 21, false), 0),
+      std::vector<int64_t>({21, 20}));
+  EXPECT_EQ(
+      read("c2", std::make_unique<common::BigintRange>(21, 21, false), 0),
+      std::vector<int64_t>({21}));
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include <folly/init/Init.h>
+#include "velox/common/memory/Memory.h"
+#include "velox/dwio/common/SeekableInputStream.h"
+#include "velox/dwio/dwrf/common/DecoderUtil.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::dwrf;
+
+namespace {
+
+constexpr uint32_t kRunLength = 512;
+constexpr uint32_t kNumRuns = 2'000;
+constexpr uint32_t kBatchSize = 1'000;
+
+// Returns kNumRuns DIRECT runs of 'width' bit unsigned values. 'encodedWidth'
+// is the width as encoded in the run header.
+std::vector<unsigned char> makeDirectRuns(
+    uint32_t width,
+    uint8_t encodedWidth) {
+  std::vector<unsigned char> bytes;
+  for (auto run = 0; run < kNumRuns; ++run) {
+    bytes.push_back(0x40 | (encodedWidth << 1) | ((kRunLength - 1) >> 8));
+    bytes.push_back((kRunLength - 1) & 0xff);
+    uint64_t bitsInByte = 0;
+    for (auto i = 0; i < kRunLength; ++i) {
+      const uint64_t value = folly::Random::rand64() >> (64 - width);
+      for (int32_t bit = width - 1; bit >= 0; --bit) {
+        if (bitsInByte == 0) {
+          bytes.push_back(0);
+        }
+        bytes.back() |= ((value >> bit) & 1) << (7 - bitsInByte);
+        bitsInByte = (bitsInByte + 1) % 8;
+      }
+    }
+  }
+  return bytes;
+}
+
+void decode(uint32_t iterations, uint32_t width, uint8_t encodedWidth) {
+  std::vector<unsigned char> bytes;
+  BENCHMARK_SUSPEND {
+    bytes = makeDirectRuns(width, encodedWidth);
+  }
+  auto pool = memory::addDefaultLeafMemoryPool();
+  std::vector<int64_t> data(kBatchSize);
+  for (auto i = 0; i < iterations; ++i) {
+    auto decoder = createRleDecoder<false>(
+        std::make_unique<dwio::common::SeekableArrayInputStream>(
+            bytes.data(), bytes.size()),
+        RleVersion_2,
+        *pool,
+        true,
+        dwio::common::INT_BYTE_SIZE);
+    for (auto row = 0; row < kRunLength * kNumRuns; row += kBatchSize) {
+      decoder->next(data.data(), kBatchSize, nullptr);
+      folly::doNotOptimizeAway(data);
+    }
+  }
+}
+
+} // namespace
+
+BENCHMARK_NAMED_PARAM(decode, direct_1, 1, 0);
+BENCHMARK_NAMED_PARAM(decode, direct_4, 4, 3);
+BENCHMARK_NAMED_PARAM(decode, direct_13, 13, 12);
+BENCHMARK_NAMED_PARAM(decode, direct_24, 24, 23);
+BENCHMARK_NAMED_PARAM(decode, direct_32, 32, 27);
+BENCHMARK_NAMED_PARAM(decode, direct_48, 48, 29);
+BENCHMARK_NAMED_PARAM(decode, direct_64, 64, 31);
+
+int32_t main(int32_t argc, char* argv[]) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -213,3 +213,44 @@ TEST(BooleanRleEncoder, random_bits_aligned_with_null) {
   delete[] data;
   delete[] nulls;
 }
+
+TEST(ByteRleEncoder, batchedRunsMatchSingleValueWrites) {
+  std::vector<char> data;
+  for (auto runLength : {1, 2, 3, 7, 129, 130, 131, 400}) {
+    data.insert(data.end(), runLength, static_cast<char>(runLength));
+    for (auto i = 0; i < 20; ++i) {
+      data.push_back(static_cast<char>(i * 7));
+    }
+  }
+
+  auto pool = memory::addDefaultLeafMemoryPool();
+  uint64_t block = 1024;
+  MemorySink expectedSink(DEFAULT_MEM_STREAM_SIZE, {.pool = pool.get()});
+  DataBufferHolder expectedHolder{
+      *pool, block, 0, DEFAULT_PAGE_GROW_RATIO, &expectedSink};
+  auto expectedEncoder = createByteRleEncoder(
+      std::make_unique<BufferedOutputStream>(expectedHolder));
+  // The std::function overload has no batched run detection.
+  expectedEncoder->add(
+      [&](vector_size_t i) { return data[i]; },
+      common::Ranges::of(0, data.size()),
+      nullptr);
+  expectedEncoder->flush();
+
+  MemorySink memSink(DEFAULT_MEM_STREAM_SIZE, {.pool = pool.get()});
+  DataBufferHolder holder{*pool, block, 0, DEFAULT_PAGE_GROW_RATIO, &memSink};
+  auto encoder =
+      createByteRleEncoder(std::make_unique<BufferedOutputStream>(holder));
+  // Splits the input so that runs continue across add() calls.
+  for (size_t begin = 0; begin < data.size(); begin += 97) {
+    encoder->add(
+        data.data(),
+        common::Ranges::of(begin, std::min(begin + 97, data.size())),
+        nullptr);
+  }
+  encoder->flush();
+
+  ASSERT_EQ(expectedSink.size(), memSink.size());
+  EXPECT_EQ(0, memcmp(expectedSink.data(), memSink.data(), memSink.size()));
+  decodeAndVerify(memSink, data.data(), data.size(), nullptr);
+}
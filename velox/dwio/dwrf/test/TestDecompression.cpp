@@ -22,6 +22,7 @@
 #include "velox/common/base/BitUtil.h"
 #include "velox/dwio/common/InputStream.h"
 #include "velox/dwio/common/compression/Compression.h"
+#include "velox/dwio/common/compression/PagedInputStream.h"
 #include "velox/dwio/dwrf/test/OrcTest.h"
 
 #include <cstdio>
@@ -797,7 +798,8 @@ compress(char* buf, size_t size, char* output, size_t offset, Codec& codec) {
 class TestSeek : public ::testing::Test {
  public:
   ~TestSeek() override {}
-  static void runTest(Codec& codec, CompressionKind kind) {
+  static void
+  runTest(Codec& codec, CompressionKind kind, bool decompressAll = false) {
     constexpr size_t inputSize = 1024;
     constexpr size_t outputSize = 4096;
     char output[outputSize];
@@ -816,6 +818,13 @@ class TestSeek : public ::testing::Test {
         *pool,
         "TestSeek Decompressor",
         nullptr);
+    if (decompressAll) {
+      auto* paged =
+          dynamic_cast<dwio::common::compression::PagedInputStream*>(
+              stream.get());
+      ASSERT_NE(paged, nullptr);
+      paged->decompressAll();
+    }
 
     const void* data;
     int32_t size;
@@ -869,6 +878,67 @@ TEST_F(TestSeek, Snappy) {
   runTest(*codec, CompressionKind_SNAPPY);
 }
 
+TEST_F(TestSeek, decompressAll) {
+  auto zlibCodec = zlib::getCodec(
+      zlib::Options(zlib::Options::Format::RAW), COMPRESSION_LEVEL_DEFAULT);
+  runTest(*zlibCodec, CompressionKind_ZLIB, true);
+  runTest(*getCodec(CodecType::ZSTD), CompressionKind_ZSTD, true);
+  runTest(*getCodec(CodecType::SNAPPY), CompressionKind_SNAPPY, true);
+}
+
+namespace {
+// Decompresses with a folly codec and counts the decompressed blocks. Stands
+// in for a hardware backend.
+class CountingDecompressor : public dwio::common::compression::Decompressor {
+ public:
+  CountingDecompressor(uint64_t blockSize, int32_t& numBlocks)
+      : Decompressor(blockSize, "counting"),
+        codec_(getCodec(CodecType::ZSTD)),
+        numBlocks_(numBlocks) {}
+
+  uint64_t decompress(
+      const char* src,
+      uint64_t srcLength,
+      char* dest,
+      uint64_t destLength) override {
+    ++numBlocks_;
+    auto output = codec_->uncompress(folly::StringPiece(src, srcLength));
+    VELOX_CHECK_LE(output.size(), destLength);
+    memcpy(dest, output.data(), output.size());
+    return output.size();
+  }
+
+ private:
+  std::unique_ptr<Codec> codec_;
+  int32_t& numBlocks_;
+};
+} // namespace
+
+TEST_F(TestSeek, registeredDecompressor) {
+  int32_t numBlocks = 0;
+  dwio::common::compression::registerDecompressorFactory(
+      CompressionKind_ZSTD,
+      [&](uint64_t blockSize, const std::string& /*streamDebugInfo*/) {
+        return std::make_unique<CountingDecompressor>(blockSize, numBlocks);
+      });
+  auto codec = getCodec(CodecType::ZSTD);
+  runTest(*codec, CompressionKind_ZSTD);
+  EXPECT_LT(0, numBlocks);
+
+  // A factory that does not take the stream falls back to the built-in
+  // decompressor.
+  numBlocks = 0;
+  dwio::common::compression::registerDecompressorFactory(
+      CompressionKind_ZSTD,
+      [](uint64_t /*blockSize*/, const std::string& /*streamDebugInfo*/) {
+        return nullptr;
+      });
+  runTest(*codec, CompressionKind_ZSTD);
+  EXPECT_EQ(0, numBlocks);
+  dwio::common::compression::unregisterDecompressorFactory(
+      CompressionKind_ZSTD);
+}
+
 TEST_F(TestSeek, uncompressed) {
   constexpr int32_t kSize = 1000;
   constexpr int32_t kHeaderSize = 3;
@@ -350,4 +350,45 @@ TEST(RleEncoderV1Test, backfillPosition) {
   }
 }
 
+TEST(RleEncoderV1Test, batchedRunsMatchSingleValueWrites) {
+  // Constant runs of varying length, some longer than the maximum repeat,
+  // interleaved with short literal sequences of small and large values.
+  std::vector<int64_t> data;
+  for (auto runLength : {1, 2, 3, 7, 129, 130, 131, 400}) {
+    data.insert(data.end(), runLength, runLength * 1'000);
+    for (auto i = 0; i < 20; ++i) {
+      data.push_back(i % 3 == 0 ? -i : i * 1'000'000'007L);
+    }
+  }
+
+  auto pool = memory::addDefaultLeafMemoryPool();
+  uint64_t block = 1024;
+  MemorySink expectedSink(DEFAULT_MEM_STREAM_SIZE, {.pool = pool.get()});
+  DataBufferHolder expectedHolder{
+      *pool, block, 0, DEFAULT_PAGE_GROW_RATIO, &expectedSink};
+  RleEncoderV1<true> expectedEncoder(
+      std::make_unique<BufferedOutputStream>(expectedHolder), true, 8);
+  for (auto value : data) {
+    expectedEncoder.writeValue(value);
+  }
+  expectedEncoder.flush();
+
+  MemorySink memSink(DEFAULT_MEM_STREAM_SIZE, {.pool = pool.get()});
+  DataBufferHolder holder{*pool, block, 0, DEFAULT_PAGE_GROW_RATIO, &memSink};
+  RleEncoderV1<true> encoder(
+      std::make_unique<BufferedOutputStream>(holder), true, 8);
+  // Splits the input so that runs continue across add() calls.
+  for (size_t begin = 0; begin < data.size(); begin += 97) {
+    encoder.add(
+        data.data(),
+        common::Ranges::of(begin, std::min(begin + 97, data.size())),
+        nullptr);
+  }
+  encoder.flush();
+
+  ASSERT_EQ(expectedSink.size(), memSink.size());
+  EXPECT_EQ(0, memcmp(expectedSink.data(), memSink.data(), memSink.size()));
+  decodeAndVerify<true>(memSink, data.data(), data.size(), nullptr);
+}
+
 } // namespace facebook::velox::dwrf
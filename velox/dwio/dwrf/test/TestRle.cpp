@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <folly/Random.h>
 #include <gtest/gtest.h>
 
 #include "velox/common/base/Nulls.h"
@@ -548,6 +549,65 @@ TEST(RLEv2, mixedPatchedAndShortRepeats) {
       values.size());
 };
 
+TEST(RLEv2, directAllBitWidths) {
+  auto pool = memory::addDefaultLeafMemoryPool();
+  // The widths a DIRECT run can have and their encoded form.
+  std::vector<std::pair<uint32_t, uint8_t>> widths;
+  for (uint32_t width = 1; width <= 24; ++width) {
+    widths.emplace_back(width, width - 1);
+  }
+  uint8_t encoded = 24;
+  for (uint32_t width : {26, 28, 30, 32, 40, 48, 56, 64}) {
+    widths.emplace_back(width, encoded++);
+  }
+  constexpr uint32_t kRunLength = 300;
+  for (const auto& [width, encodedWidth] : widths) {
+    // Big endian packed unsigned values, one DIRECT run after another.
+    std::vector<unsigned char> bytes;
+    std::vector<int64_t> values;
+    for (auto run = 0; run < 3; ++run) {
+      bytes.push_back(0x40 | (encodedWidth << 1) | ((kRunLength - 1) >> 8));
+      bytes.push_back((kRunLength - 1) & 0xff);
+      uint64_t bitsInByte = 0;
+      for (auto i = 0; i < kRunLength; ++i) {
+        const uint64_t value = folly::Random::rand64() >> (64 - width);
+        values.push_back(value);
+        for (int32_t bit = width - 1; bit >= 0; --bit) {
+          if (bitsInByte == 0) {
+            bytes.push_back(0);
+          }
+          bytes.back() |= ((value >> bit) & 1) << (7 - bitsInByte);
+          bitsInByte = (bitsInByte + 1) % 8;
+        }
+      }
+    }
+    // Small blocks make values span the buffers of the input stream.
+    for (uint64_t blockSize : {0, 7, 100}) {
+      for (size_t batchSize : {1, 17, 1000}) {
+        auto rle = createRleDecoder<false>(
+            std::make_unique<dwio::common::SeekableArrayInputStream>(
+                bytes.data(), bytes.size(), blockSize),
+            RleVersion_2,
+            *pool,
+            true /* doesn't matter */,
+            dwio::common::INT_BYTE_SIZE /* doesn't matter */);
+        std::vector<int64_t> data(values.size());
+        for (size_t i = 0; i < values.size(); i += batchSize) {
+          rle->next(
+              data.data() + i,
+              std::min(batchSize, values.size() - i),
+              nullptr);
+        }
+        for (auto i = 0; i < values.size(); ++i) {
+          ASSERT_EQ(values[i], data[i]) << width << " bits, row " << i
+                                        << ", blockSize " << blockSize
+                                        << ", batchSize " << batchSize;
+        }
+      }
+    }
+  }
+}
+
 TEST(RLEv2, basicDirectSeek) {
   auto pool = memory::addDefaultLeafMemoryPool();
   // 0,1 repeated 10 times (signed ints) followed by
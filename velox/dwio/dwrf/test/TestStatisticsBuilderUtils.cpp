@@ -187,6 +187,92 @@ TEST(TestStatisticsBuilderUtils, addStringValues) {
   }
 }
 
+TEST(TestStatisticsBuilderUtils, addIntegerValuesInBatches) {
+  auto pool = memory::addDefaultLeafMemoryPool();
+  size_t size = 10;
+  auto values = AlignedBuffer::allocate<int64_t>(size, pool.get());
+  auto* valuesPtr = values->asMutable<int64_t>();
+  for (size_t i = 0; i < size; ++i) {
+    valuesPtr[i] = i * 10 - 30;
+  }
+  auto vec = makeFlatVectorNoNulls<int64_t>(pool.get(), size, values);
+
+  // Ranges skip the minimum and the maximum.
+  common::Ranges ranges;
+  ranges.add(1, 4);
+  ranges.add(6, 9);
+  {
+    IntegerStatisticsBuilder builder{options};
+    StatisticsBuilderUtils::addValues<int64_t>(builder, vec, ranges);
+    auto stats = builder.build();
+    auto intStats = dynamic_cast<IntegerColumnStatistics*>(stats.get());
+    EXPECT_EQ(6, intStats->getNumberOfValues());
+    EXPECT_EQ(-20, intStats->getMinimum().value());
+    EXPECT_EQ(50, intStats->getMaximum().value());
+    EXPECT_EQ(90, intStats->getSum().value());
+  }
+
+  // The sum is dropped on overflow but min and max are kept.
+  valuesPtr[5] = std::numeric_limits<int64_t>::max();
+  {
+    IntegerStatisticsBuilder builder{options};
+    StatisticsBuilderUtils::addValues<int64_t>(
+        builder, vec, common::Ranges::of(0, size));
+    auto stats = builder.build();
+    auto intStats = dynamic_cast<IntegerColumnStatistics*>(stats.get());
+    EXPECT_EQ(10, intStats->getNumberOfValues());
+    EXPECT_EQ(-30, intStats->getMinimum().value());
+    EXPECT_EQ(
+        std::numeric_limits<int64_t>::max(), intStats->getMaximum().value());
+    EXPECT_FALSE(intStats->getSum().has_value());
+  }
+}
+
+TEST(TestStatisticsBuilderUtils, addDoubleValuesWithNaN) {
+  DoubleStatisticsBuilder builder{options};
+  auto pool = memory::addDefaultLeafMemoryPool();
+  size_t size = 10;
+  auto values = AlignedBuffer::allocate<double>(size, pool.get());
+  auto* valuesPtr = values->asMutable<double>();
+  for (size_t i = 0; i < size; ++i) {
+    valuesPtr[i] = i + 1;
+  }
+  valuesPtr[7] = std::nan("");
+  auto vec = makeFlatVectorNoNulls<double>(pool.get(), size, values);
+
+  StatisticsBuilderUtils::addValues<double>(
+      builder, vec, common::Ranges::of(0, size));
+  auto stats = builder.build();
+  auto doubleStats = dynamic_cast<DoubleColumnStatistics*>(stats.get());
+  EXPECT_EQ(10, doubleStats->getNumberOfValues());
+  EXPECT_FALSE(doubleStats->getMinimum().has_value());
+  EXPECT_FALSE(doubleStats->getMaximum().has_value());
+  EXPECT_FALSE(doubleStats->getSum().has_value());
+}
+
+TEST(TestStatisticsBuilderUtils, addStringValuesWithCommonPrefix) {
+  StringStatisticsBuilder builder{options};
+  auto pool = memory::addDefaultLeafMemoryPool();
+  std::vector<std::string> strings{
+      "prefix_bb", "prefix_a", "prefix_ba", "prefix_c", "prefix_ab"};
+  auto values = AlignedBuffer::allocate<StringView>(strings.size(), pool.get());
+  auto* valuesPtr = values->asMutable<StringView>();
+  for (size_t i = 0; i < strings.size(); ++i) {
+    valuesPtr[i] = StringView(strings[i]);
+  }
+  auto vec =
+      makeFlatVectorNoNulls<StringView>(pool.get(), strings.size(), values);
+
+  StatisticsBuilderUtils::addValues(
+      builder, vec, common::Ranges::of(0, strings.size()));
+  auto stats = builder.build();
+  auto strStats = dynamic_cast<StringColumnStatistics*>(stats.get());
+  EXPECT_EQ(5, strStats->getNumberOfValues());
+  EXPECT_EQ("prefix_a", strStats->getMinimum().value());
+  EXPECT_EQ("prefix_c", strStats->getMaximum().value());
+  EXPECT_EQ(43, strStats->getTotalLength().value());
+}
+
 TEST(TestStatisticsBuilderUtils, addBooleanValues) {
   BooleanStatisticsBuilder builder{options};
 
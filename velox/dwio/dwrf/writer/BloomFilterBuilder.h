@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Set.h>
+
+#include "velox/common/base/BloomFilter.h"
+#include "velox/dwio/common/OutputStream.h"
+#include "velox/dwio/dwrf/common/wrap/dwrf-proto-wrapper.h"
+#include "velox/type/Filter.h"
+
+namespace facebook::velox::dwrf {
+
+/// Builds the BLOOM_FILTER_UTF8 stream of a column: a BloomFilterIndex with
+/// one bloom filter of the values of each row index stride. The filters are
+/// velox BloomFilters of the hashes of BloomFilterValues::hashInt64() and
+/// hashBytes(), so that the reader can test the values of equality and IN
+/// filters against them.
+class BloomFilterBuilder {
+ public:
+  /// The number of bit positions tested per value. Recorded in the index.
+  static constexpr uint32_t kNumHashFunctions = 4;
+
+  explicit BloomFilterBuilder(
+      std::unique_ptr<dwio::common::BufferedOutputStream> out)
+      : out_{std::move(out)} {}
+
+  void add(int64_t value) {
+    hashes_.insert(common::BloomFilterValues::hashInt64(value));
+  }
+
+  void add(StringView value) {
+    hashes_.insert(
+        common::BloomFilterValues::hashBytes(value.data(), value.size()));
+  }
+
+  /// Adds the filter of the values added since the previous entry. The filter
+  /// is sized for the number of distinct values of the stride.
+  void addEntry() {
+    BloomFilter<> filter;
+    filter.reset(hashes_.size());
+    for (auto hash : hashes_) {
+      filter.insert(hash);
+    }
+    auto* entry = index_.add_bloomfilter();
+    entry->set_numhashfunctions(kNumHashFunctions);
+    entry->set_blocked(true);
+    const auto& bits = filter.bits();
+    entry->mutable_bitset()->Add(bits.begin(), bits.end());
+    hashes_.clear();
+  }
+
+  void flush() {
+    index_.SerializeToZeroCopyStream(out_.get());
+    out_->flush();
+    index_.Clear();
+    hashes_.clear();
+  }
+
+ private:
+  std::unique_ptr<dwio::common::BufferedOutputStream> out_;
+  proto::BloomFilterIndex index_;
+  // Hashes of the distinct values of the current stride.
+  folly::F14FastSet<uint64_t> hashes_;
+};
+
+} // namespace facebook::velox::dwrf
@@ -15,7 +15,9 @@
  */
 
 #include "velox/dwio/dwrf/writer/ColumnWriter.h"
+#include <folly/futures/Future.h>
 #include <velox/dwio/common/exception/Exception.h>
+#include <deque>
 #include "velox/dwio/common/ChainedBuffer.h"
 #include "velox/dwio/dwrf/common/EncoderUtil.h"
 #include "velox/dwio/dwrf/writer/DictionaryEncodingUtils.h"
@@ -300,6 +302,9 @@ class IntegerColumnWriter : public BaseColumnWriter {
     // Add entry with stats for either case.
     indexBuilder_->addEntry(*indexStatsBuilder_);
     indexStatsBuilder_->reset();
+    if (bloomFilterBuilder_) {
+      bloomFilterBuilder_->addEntry();
+    }
     BaseColumnWriter::recordPosition();
     // TODO: the only way useDictionaryEncoding_ right now is
     // through abandonDictionary, so we already have the stream initialization
@@ -510,6 +515,9 @@ uint64_t IntegerColumnWriter<T>::writeDict(
     T value = decodedVector.valueAt<T>(pos);
     rows_.unsafeAppend(dictEncoder_.addKey(value));
     statsBuilder.addValues(value);
+    if (bloomFilterBuilder_) {
+      bloomFilterBuilder_->add(value);
+    }
   };
 
   uint64_t nullCount = 0;
@@ -552,6 +560,13 @@ uint64_t IntegerColumnWriter<T>::writeDirect(
       dynamic_cast<IntegerStatisticsBuilder&>(*indexStatsBuilder_),
       slice,
       ranges);
+  if (bloomFilterBuilder_) {
+    for (auto& pos : ranges) {
+      if (!nulls || !bits::isBitNull(nulls, pos)) {
+        bloomFilterBuilder_->add(vals[pos]);
+      }
+    }
+  }
   auto rawSize = count * sizeof(T) + (ranges.size() - count) * NULL_SIZE;
   indexStatsBuilder_->increaseRawSize(rawSize);
   return rawSize;
@@ -729,6 +744,39 @@ FOLLY_ALWAYS_INLINE int64_t formatNanos(uint64_t nanos) {
     return (nanos << 3) | trailingZeros;
   }
 }
+
+// Tracks the min, max and total length of the strings added in one write.
+// The StringViews compare on their inlined prefixes first, and the stats
+// builder copies only the final min and max instead of every new extreme.
+class StringBatchStats {
+ public:
+  void add(const StringView& value) {
+    if (count_ == 0 || value < min_) {
+      min_ = value;
+    }
+    if (count_ == 0 || value > max_) {
+      max_ = value;
+    }
+    totalLength_ += value.size();
+    ++count_;
+  }
+
+  void addTo(StringStatisticsBuilder& builder) const {
+    if (count_ > 0) {
+      builder.addBatch(
+          folly::StringPiece{min_},
+          folly::StringPiece{max_},
+          totalLength_,
+          count_);
+    }
+  }
+
+ private:
+  StringView min_;
+  StringView max_;
+  uint64_t totalLength_{0};
+  uint64_t count_{0};
+};
 } // namespace
 
 uint64_t TimestampColumnWriter::write(
@@ -894,6 +942,9 @@ class StringColumnWriter : public BaseColumnWriter {
     // Add entry with stats for either case.
     indexBuilder_->addEntry(*indexStatsBuilder_);
     indexStatsBuilder_->reset();
+    if (bloomFilterBuilder_) {
+      bloomFilterBuilder_->addEntry();
+    }
     BaseColumnWriter::recordPosition();
     // TODO: the only way useDictionaryEncoding_ right now is
     // through abandonDictionary, so we already have the stream initialization
@@ -1109,10 +1160,14 @@ uint64_t StringColumnWriter::writeDict(
   rows_.reserve(rows_.size() + ranges.size());
   size_t strideIndex = strideOffsets_.size() - 1;
   uint64_t rawSize = 0;
+  StringBatchStats batchStats;
   auto processRow = [&](size_t pos) {
     auto sp = decodedVector.valueAt<StringView>(pos);
     rows_.unsafeAppend(dictEncoder_.addKey(sp, strideIndex));
-    statsBuilder.addValues(sp);
+    batchStats.add(sp);
+    if (bloomFilterBuilder_) {
+      bloomFilterBuilder_->add(sp);
+    }
     rawSize += sp.size();
   };
 
@@ -1131,6 +1186,7 @@ uint64_t StringColumnWriter::writeDict(
     }
   }
 
+  batchStats.addTo(statsBuilder);
   if (nullCount > 0) {
     statsBuilder.setHasNull();
     rawSize += nullCount * NULL_SIZE;
@@ -1153,11 +1209,15 @@ uint64_t StringColumnWriter::writeDirect(
   lengths.reserve(ranges.size());
 
   uint64_t rawSize = 0;
+  StringBatchStats batchStats;
   auto processRow = [&](size_t pos) {
     auto sp = decodedVector.valueAt<StringView>(pos);
     auto size = sp.size();
     dataDirect_->write(sp.data(), size);
-    statsBuilder.addValues(sp);
+    batchStats.add(sp);
+    if (bloomFilterBuilder_) {
+      bloomFilterBuilder_->add(sp);
+    }
     rawSize += size;
     lengths.unsafeAppend(size);
   };
@@ -1181,6 +1241,7 @@ uint64_t StringColumnWriter::writeDirect(
         lengths.data(), common::Ranges::of(0, lengths.size()), nullptr);
   }
 
+  batchStats.addTo(statsBuilder);
   if (nullCount > 0) {
     statsBuilder.setHasNull();
     rawSize += nullCount * NULL_SIZE;
@@ -1399,10 +1460,8 @@ uint64_t FloatColumnWriter<T>::write(
         }
       }
     } else {
-      for (auto& pos : ranges) {
-        statsBuilder.addValues(data[pos]);
-      }
       for (const auto& [start, end] : ranges.getRanges()) {
+        statsBuilder.addBatch(data + start, end - start);
         const char* srcPtr = reinterpret_cast<const char*>(data + start);
         size_t sz = end - start;
         data_.write(srcPtr, sz * sizeof(T));
@@ -1588,18 +1647,58 @@ class StructColumnWriter : public BaseColumnWriter {
       std::function<proto::ColumnEncoding&(uint32_t)> encodingFactory,
       std::function<void(proto::ColumnEncoding&)> encodingOverride) override {
     BaseColumnWriter::flush(encodingFactory, encodingOverride);
+    if (isRoot() && context_.flushExecutor() && children_.size() > 1) {
+      flushChildrenInParallel(encodingFactory);
+      return;
+    }
     for (auto& c : children_) {
       c->flush(encodingFactory);
     }
   }
 
  private:
+  // Flushes the top level columns on the flush executor of the context. The
+  // encodings are added to the footer in column order when all are done, so
+  // that the file is the same as with a serial flush.
+  void flushChildrenInParallel(
+      const std::function<proto::ColumnEncoding&(uint32_t)>& encodingFactory);
+
   uint64_t writeChildrenAndStats(
       const RowVector* rowSlice,
       const common::Ranges& ranges,
       uint64_t nullCount);
 };
 
+void StructColumnWriter::flushChildrenInParallel(
+    const std::function<proto::ColumnEncoding&(uint32_t)>& encodingFactory) {
+  // The encodings of each column, in the order the column asked for them.
+  // std::deque keeps the references handed out valid as it grows.
+  std::vector<std::deque<std::pair<uint32_t, proto::ColumnEncoding>>>
+      encodings(children_.size());
+  std::vector<folly::SemiFuture<folly::Unit>> flushes;
+  flushes.reserve(children_.size());
+  for (auto i = 0; i < children_.size(); ++i) {
+    flushes.push_back(
+        folly::via(context_.flushExecutor(), [this, i, &encodings]() {
+          auto& childEncodings = encodings[i];
+          children_[i]->flush(
+              [&](uint32_t nodeId) -> proto::ColumnEncoding& {
+                return childEncodings
+                    .emplace_back(nodeId, proto::ColumnEncoding{})
+                    .second;
+              });
+        }));
+  }
+  for (auto& result : folly::collectAll(std::move(flushes)).get()) {
+    result.throwUnlessValue();
+  }
+  for (auto& childEncodings : encodings) {
+    for (auto& [nodeId, encoding] : childEncodings) {
+      encodingFactory(nodeId) = std::move(encoding);
+    }
+  }
+}
+
 uint64_t StructColumnWriter::writeChildrenAndStats(
     const RowVector* rowSlice,
     const common::Ranges& ranges,
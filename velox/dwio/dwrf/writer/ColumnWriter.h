@@ -21,6 +21,7 @@
 #include "velox/dwio/dwrf/common/ByteRLE.h"
 #include "velox/dwio/dwrf/common/Common.h"
 #include "velox/dwio/dwrf/common/IntEncoder.h"
+#include "velox/dwio/dwrf/writer/BloomFilterBuilder.h"
 #include "velox/dwio/dwrf/writer/IndexBuilder.h"
 #include "velox/dwio/dwrf/writer/StatisticsBuilder.h"
 #include "velox/dwio/dwrf/writer/WriterContext.h"
@@ -84,6 +85,9 @@ class BaseColumnWriter : public ColumnWriter {
     fileStatsBuilder_->merge(*indexStatsBuilder_, /*ignoreSize=*/true);
     indexBuilder_->addEntry(*indexStatsBuilder_);
     indexStatsBuilder_->reset();
+    if (bloomFilterBuilder_) {
+      bloomFilterBuilder_->addEntry();
+    }
     recordPosition();
     for (auto& child : children_) {
       child->createIndexEntry();
@@ -117,6 +121,9 @@ class BaseColumnWriter : public ColumnWriter {
     setEncoding(encoding);
     encodingOverride(encoding);
     indexBuilder_->flush();
+    if (bloomFilterBuilder_) {
+      bloomFilterBuilder_->flush();
+    }
   }
 
   uint64_t writeFileStats(std::function<proto::ColumnStatistics&(uint32_t)>
@@ -172,6 +179,32 @@ class BaseColumnWriter : public ColumnWriter {
         StatisticsBuilderOptions::fromConfig(context.getConfigs());
     indexStatsBuilder_ = StatisticsBuilder::create(*type.type(), options);
     fileStatsBuilder_ = StatisticsBuilder::create(*type.type(), options);
+    if (writesBloomFilter()) {
+      bloomFilterBuilder_ = std::make_unique<BloomFilterBuilder>(
+          newStream(StreamKind::StreamKind_BLOOM_FILTER_UTF8));
+    }
+  }
+
+  // Returns true if the BLOOM_FILTER_UTF8 stream is written for this column.
+  // This is the case for integer and varchar top level columns listed in
+  // Config::BLOOM_FILTER_COLUMNS.
+  bool writesBloomFilter() const {
+    if (!isIndexEnabled() || sequence_ != 0 || type_.parent() == nullptr ||
+        type_.parent()->id() != 0) {
+      return false;
+    }
+    switch (type_.type()->kind()) {
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+      case TypeKind::BIGINT:
+      case TypeKind::VARCHAR:
+        break;
+      default:
+        return false;
+    }
+    const auto& columns = getConfig(Config::BLOOM_FILTER_COLUMNS);
+    return std::find(columns.begin(), columns.end(), type_.column()) !=
+        columns.end();
   }
 
   uint64_t writeNulls(const VectorPtr& slice, const common::Ranges& ranges) {
@@ -262,6 +295,8 @@ class BaseColumnWriter : public ColumnWriter {
   std::unique_ptr<IndexBuilder> indexBuilder_;
   std::unique_ptr<StatisticsBuilder> indexStatsBuilder_;
   std::unique_ptr<StatisticsBuilder> fileStatsBuilder_;
+  // Set if writesBloomFilter().
+  std::unique_ptr<BloomFilterBuilder> bloomFilterBuilder_;
   std::unique_ptr<ByteRleEncoder> present_;
   bool hasNull_ = false;
   // callback used to inject the logic that captures positions for flat map
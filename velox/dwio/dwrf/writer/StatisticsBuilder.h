@@ -231,6 +231,48 @@ class IntegerStatisticsBuilder : public StatisticsBuilder,
     addWithOverflowCheck(sum_, value, count);
   }
 
+  // Adds 'size' non-null values. Equivalent to calling addValues() for each
+  // value but computes min and max with branch free loops that vectorize.
+  template <typename T>
+  void addBatch(const T* values, int32_t size) {
+    if (size == 0) {
+      return;
+    }
+    increaseValueCount(size);
+    T batchMin = values[0];
+    T batchMax = values[0];
+    for (int32_t i = 1; i < size; ++i) {
+      batchMin = std::min(batchMin, values[i]);
+      batchMax = std::max(batchMax, values[i]);
+    }
+    if (min_.has_value() && batchMin < min_.value()) {
+      min_ = batchMin;
+    }
+    if (max_.has_value() && batchMax > max_.value()) {
+      max_ = batchMax;
+    }
+    if (!sum_.has_value()) {
+      return;
+    }
+    if constexpr (sizeof(T) < sizeof(int64_t)) {
+      // A batch of 32 bit or narrower values cannot overflow an int64_t.
+      int64_t sum = 0;
+      for (int32_t i = 0; i < size; ++i) {
+        sum += values[i];
+      }
+      addWithOverflowCheck<int64_t>(sum_, sum, 1);
+    } else {
+      int64_t sum = sum_.value();
+      for (int32_t i = 0; i < size; ++i) {
+        if (__builtin_add_overflow(sum, values[i], &sum)) {
+          sum_.reset();
+          return;
+        }
+      }
+      sum_ = sum;
+    }
+  }
+
   void merge(
       const dwio::common::ColumnStatistics& other,
       bool ignoreSize = false) override;
@@ -290,6 +332,48 @@ class DoubleStatisticsBuilder : public StatisticsBuilder,
     }
   }
 
+  // Adds 'size' non-null values. Equivalent to calling addValues() for each
+  // value. The sum is accumulated in input order so that it matches adding
+  // the values one at a time.
+  template <typename T>
+  void addBatch(const T* values, int32_t size) {
+    if (size == 0) {
+      return;
+    }
+    increaseValueCount(size);
+    bool hasNaN = false;
+    double batchMin = std::numeric_limits<double>::infinity();
+    double batchMax = -std::numeric_limits<double>::infinity();
+    for (int32_t i = 0; i < size; ++i) {
+      const double value = values[i];
+      hasNaN |= std::isnan(value);
+      batchMin = value < batchMin ? value : batchMin;
+      batchMax = value > batchMax ? value : batchMax;
+    }
+    // min/max/sum is defined only when none of the values added is NaN
+    if (hasNaN) {
+      clear();
+      return;
+    }
+    if (min_.has_value() && batchMin < min_.value()) {
+      min_ = batchMin;
+    }
+    if (max_.has_value() && batchMax > max_.value()) {
+      max_ = batchMax;
+    }
+    if (sum_.has_value()) {
+      double sum = sum_.value();
+      for (int32_t i = 0; i < size; ++i) {
+        sum += values[i];
+      }
+      if (std::isnan(sum)) {
+        sum_.reset();
+      } else {
+        sum_ = sum;
+      }
+    }
+  }
+
   void merge(
       const dwio::common::ColumnStatistics& other,
       bool ignoreSize = false) override;
@@ -346,6 +430,35 @@ class StringStatisticsBuilder : public StatisticsBuilder,
     addWithOverflowCheck<uint64_t>(length_, value.size(), count);
   }
 
+  // Adds 'count' non-null values whose minimum and maximum are 'min' and
+  // 'max' and whose lengths add up to 'totalLength'. Lets callers find the
+  // extremes of a batch by comparing StringViews and copy only the final
+  // min and max instead of every intermediate one.
+  void addBatch(
+      folly::StringPiece min,
+      folly::StringPiece max,
+      uint64_t totalLength,
+      uint64_t count) {
+    if (count == 0) {
+      return;
+    }
+    auto isSelfEmpty = isEmpty(*this);
+    increaseValueCount(count);
+    if (isSelfEmpty) {
+      min_ = min;
+      max_ = max;
+    } else {
+      if (min_.has_value() && min < folly::StringPiece{min_.value()}) {
+        min_ = min;
+      }
+      if (max_.has_value() && max > folly::StringPiece{max_.value()}) {
+        max_ = max;
+      }
+    }
+
+    addWithOverflowCheck<uint64_t>(length_, totalLength, 1);
+  }
+
   void merge(
       const dwio::common::ColumnStatistics& other,
       bool ignoreSize = false) override;
@@ -80,20 +80,32 @@ void StatisticsBuilderUtils::addValues(
     StringStatisticsBuilder& builder,
     const VectorPtr& vector,
     const common::Ranges& ranges) {
-  auto nulls = vector->rawNulls();
+  auto nulls = vector->mayHaveNulls() ? vector->rawNulls() : nullptr;
   auto data = vector->asFlatVector<StringView>()->rawValues();
-  if (vector->mayHaveNulls()) {
-    for (auto& pos : ranges) {
-      if (bits::isBitNull(nulls, pos)) {
-        builder.setHasNull();
-      } else {
-        builder.addValues(folly::StringPiece{data[pos]});
-      }
+  // Finds the batch min and max on StringViews, which compare the inlined
+  // prefixes before the full strings, and copies only those into the builder.
+  const StringView* min = nullptr;
+  const StringView* max = nullptr;
+  uint64_t totalLength = 0;
+  uint64_t count = 0;
+  for (auto& pos : ranges) {
+    if (nulls && bits::isBitNull(nulls, pos)) {
+      builder.setHasNull();
+      continue;
     }
-  } else {
-    for (auto& pos : ranges) {
-      builder.addValues(folly::StringPiece{data[pos]});
+    const auto& value = data[pos];
+    if (!min || value < *min) {
+      min = &value;
     }
+    if (!max || value > *max) {
+      max = &value;
+    }
+    totalLength += value.size();
+    ++count;
+  }
+  if (count > 0) {
+    builder.addBatch(
+        folly::StringPiece{*min}, folly::StringPiece{*max}, totalLength, count);
   }
 }
 
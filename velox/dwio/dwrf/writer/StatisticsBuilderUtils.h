@@ -67,30 +67,47 @@ class StatisticsBuilderUtils {
       BinaryStatisticsBuilder& builder,
       const VectorPtr& vector,
       const common::Ranges& ranges);
+
+ private:
+  // Adds the values of a flat fixed width vector. Ranges without nulls go
+  // through the builder's addBatch(), the others are added value by value.
+  template <typename T, typename Builder>
+  static void addFlatValues(
+      Builder& builder,
+      const VectorPtr& vector,
+      const common::Ranges& ranges);
 };
 
-template <typename INT>
-void StatisticsBuilderUtils::addValues(
-    IntegerStatisticsBuilder& builder,
+template <typename T, typename Builder>
+void StatisticsBuilderUtils::addFlatValues(
+    Builder& builder,
     const VectorPtr& vector,
     const common::Ranges& ranges) {
-  auto nulls = vector->rawNulls();
-  auto vals = vector->asFlatVector<INT>()->rawValues();
-  if (vector->mayHaveNulls()) {
-    for (auto& pos : ranges) {
+  auto nulls = vector->mayHaveNulls() ? vector->rawNulls() : nullptr;
+  auto vals = vector->asFlatVector<T>()->rawValues();
+  for (const auto [start, end] : ranges.getRanges()) {
+    if (!nulls || bits::isAllSet(nulls, start, end, bits::kNotNull)) {
+      builder.addBatch(vals + start, end - start);
+      continue;
+    }
+    for (auto pos = start; pos < end; ++pos) {
       if (bits::isBitNull(nulls, pos)) {
         builder.setHasNull();
       } else {
         builder.addValues(vals[pos]);
       }
     }
-  } else {
-    for (auto& pos : ranges) {
-      builder.addValues(vals[pos]);
-    }
   }
 }
 
+template <typename INT>
+void StatisticsBuilderUtils::addValues(
+    IntegerStatisticsBuilder& builder,
+    const VectorPtr& vector,
+    const common::Ranges& ranges) {
+  addFlatValues<INT>(builder, vector, ranges);
+}
+
 template <typename INT>
 void StatisticsBuilderUtils::addValues(
     IntegerStatisticsBuilder& builder,
@@ -116,21 +133,7 @@ void StatisticsBuilderUtils::addValues(
     DoubleStatisticsBuilder& builder,
     const VectorPtr& vector,
     const common::Ranges& ranges) {
-  auto nulls = vector->rawNulls();
-  auto vals = vector->asFlatVector<FLOAT>()->rawValues();
-  if (vector->mayHaveNulls()) {
-    for (auto& pos : ranges) {
-      if (bits::isBitNull(nulls, pos)) {
-        builder.setHasNull();
-      } else {
-        builder.addValues(vals[pos]);
-      }
-    }
-  } else {
-    for (auto& pos : ranges) {
-      builder.addValues(vals[pos]);
-    }
-  }
+  addFlatValues<FLOAT>(builder, vector, ranges);
 }
 
 } // namespace facebook::velox::dwrf
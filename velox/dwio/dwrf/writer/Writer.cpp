@@ -74,6 +74,13 @@ Writer::Writer(
   writerBase_->initContext(options.config, std::move(pool), std::move(handler));
   auto& context = writerBase_->getContext();
   context.buildPhysicalSizeAggregators(*schema_);
+  // The value writers of flat maps share dictionary encoders and streams in
+  // the context and the streams of a column share an encrypter, so files with
+  // flat maps or encryption are flushed serially.
+  if (context.getConfig(Config::MAP_FLAT_COLS).empty() &&
+      !context.getEncryptionHandler().isEncrypted()) {
+    context.setFlushExecutor(options.flushExecutor);
+  }
   if (options.flushPolicyFactory == nullptr) {
     flushPolicy_ = std::make_unique<DefaultFlushPolicy>(
         context.stripeSizeFlushThreshold(),
@@ -540,6 +547,7 @@ dwrf::WriterOptions getDwrfOptions(const dwio::common::WriterOptions& options) {
   dwrfOptions.config = Config::fromMap(configs);
   dwrfOptions.schema = options.schema;
   dwrfOptions.memoryPool = options.memoryPool;
+  dwrfOptions.flushExecutor = options.flushExecutor;
   return dwrfOptions;
 }
 
@@ -46,6 +46,10 @@ struct WriterOptions {
       WriterContext& context,
       const velox::dwio::common::TypeWithId& type)>
       columnWriterFactory;
+  /// If set, the top level columns are flushed in parallel on this executor
+  /// at the end of each stripe. Not used for files with flat map columns or
+  /// encryption.
+  std::shared_ptr<folly::Executor> flushExecutor;
 };
 
 class Writer : public dwio::common::Writer {
@@ -16,7 +16,9 @@
 
 #pragma once
 
+#include <folly/Executor.h>
 #include <limits>
+#include <mutex>
 #include "velox/common/base/GTestMacros.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/dwio/dwrf/common/Common.h"
@@ -76,8 +78,9 @@ class WriterContext : public CompressionBufferPool {
     }
     validateConfigs();
     VLOG(2) << fmt::format("Compression config: {}", compression_);
-    compressionBuffer_ = std::make_unique<dwio::common::DataBuffer<char>>(
-        *generalPool_, compressionBlockSize_ + PAGE_HEADER_SIZE);
+    compressionBuffers_.push_back(
+        std::make_unique<dwio::common::DataBuffer<char>>(
+            *generalPool_, compressionBlockSize_ + PAGE_HEADER_SIZE));
   }
 
   bool hasStream(const DwrfStreamIdentifier& stream) const {
@@ -273,16 +276,34 @@ class WriterContext : public CompressionBufferPool {
 
   std::unique_ptr<dwio::common::DataBuffer<char>> getBuffer(
       uint64_t size) override {
-    DWIO_ENSURE_NOT_NULL(compressionBuffer_);
-    DWIO_ENSURE_GE(compressionBuffer_->size(), size);
-    return std::move(compressionBuffer_);
+    DWIO_ENSURE_GE(compressionBlockSize_ + PAGE_HEADER_SIZE, size);
+    std::lock_guard<std::mutex> l(compressionBufferMutex_);
+    if (compressionBuffers_.empty()) {
+      // Columns flushed in parallel compress pages at the same time.
+      return std::make_unique<dwio::common::DataBuffer<char>>(
+          *generalPool_, compressionBlockSize_ + PAGE_HEADER_SIZE);
+    }
+    auto buffer = std::move(compressionBuffers_.back());
+    compressionBuffers_.pop_back();
+    return buffer;
   }
 
   void returnBuffer(
       std::unique_ptr<dwio::common::DataBuffer<char>> buffer) override {
     DWIO_ENSURE_NOT_NULL(buffer);
-    DWIO_ENSURE(!compressionBuffer_);
-    compressionBuffer_ = std::move(buffer);
+    std::lock_guard<std::mutex> l(compressionBufferMutex_);
+    compressionBuffers_.push_back(std::move(buffer));
+  }
+
+  /// Sets the executor on which the top level columns are flushed in
+  /// parallel at the end of a stripe. If not set, the columns are flushed on
+  /// the calling thread.
+  void setFlushExecutor(std::shared_ptr<folly::Executor> executor) {
+    flushExecutor_ = std::move(executor);
+  }
+
+  folly::Executor* flushExecutor() const {
+    return flushExecutor_.get();
   }
 
   void incrementNodeSize(uint32_t node, uint64_t size) {
@@ -630,7 +651,12 @@ class WriterContext : public CompressionBufferPool {
   std::function<std::unique_ptr<IndexBuilder>(
       std::unique_ptr<BufferedOutputStream>)>
       indexBuilderFactory_;
-  std::unique_ptr<dwio::common::DataBuffer<char>> compressionBuffer_;
+  // Free compression buffers. There is one unless columns are flushed in
+  // parallel.
+  std::vector<std::unique_ptr<dwio::common::DataBuffer<char>>>
+      compressionBuffers_;
+  std::mutex compressionBufferMutex_;
+  std::shared_ptr<folly::Executor> flushExecutor_;
   // A pool of reusable DecodedVectors.
   std::vector<std::unique_ptr<velox::DecodedVector>> decodedVectorPool_;
   // Reusable SelectivityVector
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/BloomFilter.h"
+
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+
+namespace facebook::velox::parquet {
+
+namespace {
+// The odd constants that select the bit in each word of a block.
+constexpr uint32_t kSalt[8] = {
+    0x47b6137bU,
+    0x44974d91U,
+    0x8824ad5bU,
+    0xa2b7289dU,
+    0x705495c7U,
+    0x2df1424bU,
+    0x9efc4947U,
+    0x5c6bfb31U};
+
+// Tests an integer filter value against 'bloomFilter'. The value is plain
+// encoded for 'physicalType', which is INT32 or INT64.
+bool mayContain(
+    int64_t value,
+    thrift::Type::type physicalType,
+    const SplitBlockBloomFilter& bloomFilter) {
+  if (physicalType == thrift::Type::INT64) {
+    return bloomFilter.mayContain(
+        SplitBlockBloomFilter::hash(&value, sizeof(value)));
+  }
+  const int32_t narrowValue = value;
+  if (narrowValue != value) {
+    // The column cannot have a value out of the range of its type.
+    return false;
+  }
+  return bloomFilter.mayContain(
+      SplitBlockBloomFilter::hash(&narrowValue, sizeof(narrowValue)));
+}
+
+template <typename Values>
+bool mayContainAny(
+    const Values& values,
+    thrift::Type::type physicalType,
+    const SplitBlockBloomFilter& bloomFilter) {
+  for (auto value : values) {
+    if (mayContain(value, physicalType, bloomFilter)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool mayContain(
+    const std::string& value,
+    const SplitBlockBloomFilter& bloomFilter) {
+  return bloomFilter.mayContain(
+      SplitBlockBloomFilter::hash(value.data(), value.size()));
+}
+} // namespace
+
+SplitBlockBloomFilter::SplitBlockBloomFilter(uint32_t* bitset, int32_t numBytes)
+    : bitset_(bitset), numBlocks_(numBytes / kBytesPerBlock) {
+  VELOX_CHECK_GT(numBlocks_, 0);
+  VELOX_CHECK_EQ(numBytes % kBytesPerBlock, 0);
+}
+
+// static
+uint64_t SplitBlockBloomFilter::hash(const void* data, size_t size) {
+  return XXH64(data, size, 0);
+}
+
+void SplitBlockBloomFilter::insert(uint64_t hash) {
+  auto* block = blockFor(hash);
+  const uint32_t key = hash;
+  for (auto i = 0; i < 8; ++i) {
+    block[i] |= 1U << ((key * kSalt[i]) >> 27);
+  }
+}
+
+bool SplitBlockBloomFilter::mayContain(uint64_t hash) const {
+  const auto* block = blockFor(hash);
+  const uint32_t key = hash;
+  for (auto i = 0; i < 8; ++i) {
+    if (!(block[i] & (1U << ((key * kSalt[i]) >> 27)))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool testFilter(
+    const common::Filter& filter,
+    thrift::Type::type physicalType,
+    const SplitBlockBloomFilter& bloomFilter) {
+  if (filter.testNull()) {
+    // Nulls are not in the Bloom filter.
+    return true;
+  }
+  const bool isInteger = physicalType == thrift::Type::INT32 ||
+      physicalType == thrift::Type::INT64;
+  const bool isBytes = physicalType == thrift::Type::BYTE_ARRAY ||
+      physicalType == thrift::Type::FIXED_LEN_BYTE_ARRAY;
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange: {
+      auto& range = static_cast<const common::BigintRange&>(filter);
+      if (!isInteger || !range.isSingleValue()) {
+        return true;
+      }
+      return mayContain(range.lower(), physicalType, bloomFilter);
+    }
+    case common::FilterKind::kBigintValuesUsingHashTable:
+      if (!isInteger) {
+        return true;
+      }
+      return mayContainAny(
+          static_cast<const common::BigintValuesUsingHashTable&>(filter)
+              .values(),
+          physicalType,
+          bloomFilter);
+    case common::FilterKind::kBigintValuesUsingBitmask:
+      if (!isInteger) {
+        return true;
+      }
+      return mayContainAny(
+          static_cast<const common::BigintValuesUsingBitmask&>(filter)
+              .values(),
+          physicalType,
+          bloomFilter);
+    case common::FilterKind::kBytesRange: {
+      auto& range = static_cast<const common::BytesRange&>(filter);
+      if (!isBytes || !range.isSingleValue()) {
+        return true;
+      }
+      return mayContain(range.lower(), bloomFilter);
+    }
+    case common::FilterKind::kBytesValues:
+      if (!isBytes) {
+        return true;
+      }
+      for (auto& value :
+           static_cast<const common::BytesValues&>(filter).values()) {
+        if (mayContain(value, bloomFilter)) {
+          return true;
+        }
+      }
+      return false;
+    default:
+      return true;
+  }
+}
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/type/Filter.h"
+
+namespace facebook::velox::parquet {
+
+/// A Parquet split block Bloom filter over the xxHash64 of the plain encoded
+/// values of a column chunk. The bitset is a sequence of 32 byte blocks of 8
+/// words. A value sets one bit in each word of the block selected by the high
+/// half of its hash. Does not own the bitset.
+class SplitBlockBloomFilter {
+ public:
+  static constexpr int32_t kBytesPerBlock = 32;
+
+  /// 'numBytes' is a multiple of kBytesPerBlock.
+  SplitBlockBloomFilter(uint32_t* bitset, int32_t numBytes);
+
+  /// Returns the hash of 'size' bytes of plain encoded value at 'data'.
+  static uint64_t hash(const void* data, size_t size);
+
+  void insert(uint64_t hash);
+
+  /// False if no value with 'hash' was inserted.
+  bool mayContain(uint64_t hash) const;
+
+ private:
+  uint32_t* blockFor(uint64_t hash) const {
+    return bitset_ + (((hash >> 32) * numBlocks_) >> 32) * 8;
+  }
+
+  uint32_t* const bitset_;
+  const uint64_t numBlocks_;
+};
+
+/// False if the Bloom filter shows that no value of 'physicalType' in the
+/// column chunk passes 'filter'. Only equality and IN filters are tested, all
+/// other filters and filters that pass nulls return true.
+bool testFilter(
+    const common::Filter& filter,
+    thrift::Type::type physicalType,
+    const SplitBlockBloomFilter& bloomFilter);
+
+} // namespace facebook::velox::parquet
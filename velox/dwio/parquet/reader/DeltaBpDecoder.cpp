@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
+
+#include <folly/Varint.h>
+#include "velox/common/base/BitUtil.h"
+#include "velox/dwio/common/BitPackDecoder.h"
+
+namespace facebook::velox::parquet {
+
+namespace {
+// Returns the 'bitWidth' bits starting at bit 'bitOffset' of the little endian
+// bit stream at 'data'. Used for deltas wider than 32 bits.
+uint64_t readBits(const uint8_t* data, uint64_t bitOffset, uint8_t bitWidth) {
+  data += bitOffset / 8;
+  int32_t shift = bitOffset % 8;
+  uint64_t value = 0;
+  int32_t numRead = 0;
+  while (numRead < bitWidth) {
+    value |= static_cast<uint64_t>(*data++ >> shift) << numRead;
+    numRead += 8 - shift;
+    shift = 0;
+  }
+  return bitWidth == 64 ? value : value & bits::lowMask(bitWidth);
+}
+} // namespace
+
+template <typename T>
+const char* decodeDeltaBinaryPacked(
+    const char* begin,
+    const char* end,
+    raw_vector<T>& values) {
+  using U = std::make_unsigned_t<T>;
+  folly::ByteRange range(
+      reinterpret_cast<const uint8_t*>(begin),
+      reinterpret_cast<const uint8_t*>(end));
+  const auto blockSize = folly::decodeVarint(range);
+  const auto numMiniblocks = folly::decodeVarint(range);
+  const auto numValues = folly::decodeVarint(range);
+  U last = folly::decodeZigZag(folly::decodeVarint(range));
+  VELOX_CHECK(
+      numMiniblocks > 0 && blockSize % numMiniblocks == 0 &&
+          blockSize / numMiniblocks % 32 == 0,
+      "Bad DELTA_BINARY_PACKED block size {} with {} miniblocks",
+      blockSize,
+      numMiniblocks);
+  const auto valuesPerMiniblock = blockSize / numMiniblocks;
+  values.resize(numValues);
+  if (numValues == 0) {
+    return reinterpret_cast<const char*>(range.begin());
+  }
+  values[0] = last;
+  raw_vector<uint32_t> deltas(valuesPerMiniblock);
+  uint64_t numDecoded = 1;
+  while (numDecoded < numValues) {
+    const U minDelta = folly::decodeZigZag(folly::decodeVarint(range));
+    VELOX_CHECK_LE(numMiniblocks, range.size());
+    const auto* bitWidths = range.begin();
+    range.advance(numMiniblocks);
+    for (auto i = 0; i < numMiniblocks && numDecoded < numValues; ++i) {
+      const auto bitWidth = bitWidths[i];
+      VELOX_CHECK_LE(bitWidth, sizeof(T) * 8);
+      const auto miniblockBytes = valuesPerMiniblock * bitWidth / 8;
+      VELOX_CHECK_LE(miniblockBytes, range.size());
+      const auto count =
+          std::min<uint64_t>(valuesPerMiniblock, numValues - numDecoded);
+      if (bitWidth == 0) {
+        for (auto j = 0; j < count; ++j) {
+          last += minDelta;
+          values[numDecoded++] = last;
+        }
+      } else if (bitWidth <= 32) {
+        const auto* input = range.begin();
+        auto* output = deltas.data();
+        dwio::common::unpack<uint32_t>(
+            input, miniblockBytes, valuesPerMiniblock, bitWidth, output);
+        for (auto j = 0; j < count; ++j) {
+          last += minDelta + static_cast<U>(deltas[j]);
+          values[numDecoded++] = last;
+        }
+      } else {
+        for (auto j = 0; j < count; ++j) {
+          last += minDelta +
+              static_cast<U>(readBits(range.begin(), j * bitWidth, bitWidth));
+          values[numDecoded++] = last;
+        }
+      }
+      range.advance(miniblockBytes);
+    }
+  }
+  return reinterpret_cast<const char*>(range.begin());
+}
+
+template const char* decodeDeltaBinaryPacked<int32_t>(
+    const char* begin,
+    const char* end,
+    raw_vector<int32_t>& values);
+
+template const char* decodeDeltaBinaryPacked<int64_t>(
+    const char* begin,
+    const char* end,
+    raw_vector<int64_t>& values);
+
+} // namespace facebook::velox::parquet
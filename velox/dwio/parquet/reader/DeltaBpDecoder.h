@@ -0,0 +1,35 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/common/base/RawVector.h"
+
+namespace facebook::velox::parquet {
+
+/// Decodes the DELTA_BINARY_PACKED values starting at 'begin' into 'values'.
+/// The values are stored as the deltas between consecutive values, bit packed
+/// in miniblocks of a width given per miniblock. 'end' is the end of the page
+/// data. Returns the first byte after the encoded values. T is int32_t or
+/// int64_t. Deltas of up to 32 bits, which include all deltas of int32_t
+/// values, are unpacked 8 at a time with the SIMD unpack of BitPackDecoder.
+template <typename T>
+const char* FOLLY_NONNULL decodeDeltaBinaryPacked(
+    const char* FOLLY_NONNULL begin,
+    const char* FOLLY_NONNULL end,
+    raw_vector<T>& values);
+
+} // namespace facebook::velox::parquet
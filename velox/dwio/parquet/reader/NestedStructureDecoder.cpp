@@ -31,8 +31,9 @@ int64_t NestedStructureDecoder::readOffsetsAndNulls(
     BufferPtr& lengthsBuffer,
     BufferPtr& nullsBuffer,
     memory::MemoryPool& pool) {
-  dwio::common::ensureCapacity<uint8_t>(
-      nullsBuffer, bits::nbytes(numValues), &pool);
+  // The nulls are stored a word at a time, so round the buffer up to words.
+  dwio::common::ensureCapacity<uint64_t>(
+      nullsBuffer, bits::nwords(numValues), &pool);
   dwio::common::ensureCapacity<vector_size_t>(
       offsetsBuffer, numValues + 1, &pool);
   dwio::common::ensureCapacity<vector_size_t>(lengthsBuffer, numValues, &pool);
@@ -42,9 +43,11 @@ int64_t NestedStructureDecoder::readOffsetsAndNulls(
   auto nulls = nullsBuffer->asMutable<uint64_t>();
 
   int64_t offset = 0;
-  int64_t lastOffset = 0;
   bool wasLastCollectionNull = definitionLevels[0] == (maxDefinition - 1);
-  bits::setNull(nulls, 0, wasLastCollectionNull);
+  // The null bits of the word containing 'outputIndex' are accumulated in a
+  // register and stored when 'outputIndex' moves to the next word. This
+  // avoids a branchy read-modify-write of the nulls per level.
+  uint64_t nullWord = wasLastCollectionNull ? 0 : 1;
   offsets[0] = 0;
 
   int64_t outputIndex = 1;
@@ -61,21 +64,33 @@ int64_t NestedStructureDecoder::readOffsetsAndNulls(
 
     offset += isEntryBegin & !wasLastCollectionNull;
     offsets[outputIndex] = offset;
-    lengths[outputIndex - 1] = offset - offsets[outputIndex - 1];
-    bits::setNull(nulls, outputIndex, isNull);
+    const auto bit = outputIndex & 63;
+    nullWord = (nullWord & ~(1ULL << bit)) |
+        (static_cast<uint64_t>(!isNull) << bit);
 
     // Always update the outputs, but only increase the outputIndex when the
     // current entry is the begin of a new collection, and it's not empty.
     // Benchmark shows skipping non-collection-begin rows is worse than this
     // solution by nearly 2x because of extra branchings added for skipping.
     outputIndex += isCollectionBegin;
+    if (UNLIKELY(isCollectionBegin && (outputIndex & 63) == 0)) {
+      nulls[(outputIndex >> 6) - 1] = nullWord;
+      nullWord = 0;
+    }
     wasLastCollectionNull = isEmpty ? wasLastCollectionNull : isNull;
-    lastOffset = isCollectionBegin ? offset : lastOffset;
   }
 
   offset += !wasLastCollectionNull;
   offsets[outputIndex] = offset;
-  lengths[outputIndex - 1] = offset - lastOffset;
+  if (outputIndex & 63) {
+    nulls[outputIndex >> 6] = nullWord;
+  }
+
+  // The lengths are the differences of consecutive offsets. Computing them in
+  // a separate pass keeps the loop above short and lets this one vectorize.
+  for (int64_t i = 0; i < outputIndex; ++i) {
+    lengths[i] = offsets[i + 1] - offsets[i];
+  }
 
   return outputIndex;
 }
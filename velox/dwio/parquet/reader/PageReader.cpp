@@ -15,9 +15,12 @@
  */
 
 #include "velox/dwio/parquet/reader/PageReader.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/common/compression/LzoDecompressor.h"
+#include "velox/common/testutil/TestValue.h"
 #include "velox/dwio/common/BufferUtil.h"
 #include "velox/dwio/common/ColumnVisitors.h"
+#include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
 #include "velox/dwio/parquet/reader/NestedStructureDecoder.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
 #include "velox/vector/FlatVector.h"
@@ -30,6 +33,7 @@
 
 namespace facebook::velox::parquet {
 
+using common::testutil::TestValue;
 using thrift::Encoding;
 using thrift::PageHeader;
 
@@ -57,7 +61,7 @@ void PageReader::seekToPage(int64_t row) {
         prepareDataPageV2(pageHeader, row);
         break;
       case thrift::PageType::DICTIONARY_PAGE:
-        if (row == kRepDefOnly) {
+        if (row == kRepDefOnly || dictionaryPreset_) {
           skipBytes(
               pageHeader.compressed_page_size,
               inputStream_.get(),
@@ -65,7 +69,15 @@ void PageReader::seekToPage(int64_t row) {
               bufferEnd_);
           continue;
         }
-        prepareDictionary(pageHeader);
+        if (row == rowOfPage_) {
+          // The first data page after the dictionary is read, so the
+          // dictionary is decoded right away instead of copied aside.
+          prepareDictionary(
+              pageHeader,
+              readBytes(pageHeader.compressed_page_size, pageBuffer_));
+        } else {
+          deferDictionary(pageHeader);
+        }
         continue;
       default:
         break; // ignore INDEX page type and any other custom extensions
@@ -221,10 +233,49 @@ const char* FOLLY_NONNULL decompressLz4AndLzo(
   return uncompressedData->as<char>();
 }
 
+namespace {
+// Returns the compression kind of a factory registered with
+// registerDecompressorFactory() that decompresses pages of 'codec'. Parquet
+// LZ4 and LZO pages have a framing of their own and are always decompressed
+// here.
+std::optional<common::CompressionKind> registeredCompressionKind(
+    thrift::CompressionCodec::type codec) {
+  switch (codec) {
+    case thrift::CompressionCodec::SNAPPY:
+      return common::CompressionKind_SNAPPY;
+    case thrift::CompressionCodec::ZSTD:
+      return common::CompressionKind_ZSTD;
+    case thrift::CompressionCodec::GZIP:
+      return common::CompressionKind_GZIP;
+    default:
+      return std::nullopt;
+  }
+}
+} // namespace
+
 const char* FOLLY_NONNULL PageReader::uncompressData(
     const char* pageData,
     uint32_t compressedSize,
     uint32_t uncompressedSize) {
+  if (!registeredDecompressorChecked_) {
+    registeredDecompressorChecked_ = true;
+    if (auto kind = registeredCompressionKind(codec_)) {
+      registeredDecompressor_ =
+          dwio::common::compression::createRegisteredDecompressor(
+              kind.value(), 0, "parquet page");
+    }
+  }
+  if (registeredDecompressor_) {
+    dwio::common::ensureCapacity<char>(
+        uncompressedData_, uncompressedSize, &pool_);
+    auto size = registeredDecompressor_->decompress(
+        pageData,
+        compressedSize,
+        uncompressedData_->asMutable<char>(),
+        uncompressedSize);
+    VELOX_CHECK_EQ(size, uncompressedSize);
+    return uncompressedData_->as<char>();
+  }
   switch (codec_) {
     case thrift::CompressionCodec::UNCOMPRESSED:
       return pageData;
@@ -363,6 +414,9 @@ void PageReader::prepareDataPageV1(const PageHeader& pageHeader, int64_t row) {
 
     return;
   }
+  if (row != kRepDefOnly) {
+    loadDictionaryIfNeeded(pageHeader.data_page_header.encoding);
+  }
   pageData_ = readBytes(pageHeader.compressed_page_size, pageBuffer_);
   pageData_ = uncompressData(
       pageData_,
@@ -418,6 +472,9 @@ void PageReader::prepareDataPageV2(const PageHeader& pageHeader, int64_t row) {
         bufferEnd_);
     return;
   }
+  if (row != kRepDefOnly) {
+    loadDictionaryIfNeeded(pageHeader.data_page_header_v2.encoding);
+  }
 
   uint32_t defineLength = maxDefine_ > 0
       ? pageHeader.data_page_header_v2.definition_levels_byte_length
@@ -465,7 +522,72 @@ void PageReader::prepareDataPageV2(const PageHeader& pageHeader, int64_t row) {
   }
 }
 
-void PageReader::prepareDictionary(const PageHeader& pageHeader) {
+namespace {
+// Bytes of an INT96 timestamp: nanoseconds of the day followed by the Julian
+// day.
+constexpr int32_t kInt96Bytes = 12;
+
+// Converts 'numValues' INT96 timestamps at 'input' to nanoseconds since the
+// epoch at 'output'. 'output' may be the same as 'input'.
+void int96ToNanos(const char* input, int32_t numValues, int64_t* output) {
+  constexpr int64_t kJulianEpochDay = 2'440'588;
+  constexpr int64_t kNanosPerDay = 86'400'000'000'000;
+  for (auto i = 0; i < numValues; ++i) {
+    const auto* value = input + i * kInt96Bytes;
+    int64_t nanosOfDay;
+    int32_t julianDay;
+    memcpy(&nanosOfDay, value, sizeof(nanosOfDay));
+    memcpy(&julianDay, value + sizeof(nanosOfDay), sizeof(julianDay));
+    int64_t nanos;
+    if (__builtin_mul_overflow(
+            julianDay - kJulianEpochDay, kNanosPerDay, &nanos) ||
+        __builtin_add_overflow(nanos, nanosOfDay, &nanos)) {
+      VELOX_USER_FAIL(
+          "INT96 timestamp out of the range of 64 bit nanoseconds: day {}",
+          julianDay);
+    }
+    output[i] = nanos;
+  }
+}
+} // namespace
+
+void PageReader::deferDictionary(const PageHeader& pageHeader) {
+  const auto size = pageHeader.compressed_page_size;
+  auto* data = readBytes(size, pageBuffer_);
+  // The bytes returned by readBytes() are only valid until the next read from
+  // 'inputStream_'.
+  dwio::common::ensureCapacity<char>(dictionaryPage_, size, &pool_);
+  memcpy(dictionaryPage_->asMutable<char>(), data, size);
+  dictionaryHeader_ = pageHeader;
+  dictionaryPending_ = true;
+}
+
+const dwio::common::DictionaryValues& PageReader::readDictionaryPage() {
+  VELOX_CHECK_EQ(pageStart_, 0);
+  if (chunkSize_ > 0) {
+    auto pageHeader = readPageHeader();
+    if (pageHeader.type == thrift::PageType::DICTIONARY_PAGE) {
+      prepareDictionary(
+          pageHeader, readBytes(pageHeader.compressed_page_size, pageBuffer_));
+    }
+  }
+  return dictionary_;
+}
+
+void PageReader::loadDictionaryIfNeeded(thrift::Encoding::type encoding) {
+  if (dictionaryPending_ &&
+      (encoding == Encoding::PLAIN_DICTIONARY ||
+       encoding == Encoding::RLE_DICTIONARY)) {
+    dictionaryPending_ = false;
+    prepareDictionary(dictionaryHeader_, dictionaryPage_->as<char>());
+  }
+}
+
+void PageReader::prepareDictionary(
+    const PageHeader& pageHeader,
+    const char* pageData) {
+  TestValue::adjust(
+      "facebook::velox::parquet::PageReader::prepareDictionary", this);
   dictionary_.numValues = pageHeader.dictionary_page_header.num_values;
   dictionaryEncoding_ = pageHeader.dictionary_page_header.encoding;
   dictionary_.sorted = pageHeader.dictionary_page_header.__isset.is_sorted &&
@@ -474,13 +596,10 @@ void PageReader::prepareDictionary(const PageHeader& pageHeader) {
       dictionaryEncoding_ == Encoding::PLAIN_DICTIONARY ||
       dictionaryEncoding_ == Encoding::PLAIN);
 
-  if (codec_ != thrift::CompressionCodec::UNCOMPRESSED) {
-    pageData_ = readBytes(pageHeader.compressed_page_size, pageBuffer_);
-    pageData_ = uncompressData(
-        pageData_,
-        pageHeader.compressed_page_size,
-        pageHeader.uncompressed_page_size);
-  }
+  pageData_ = uncompressData(
+      pageData,
+      pageHeader.compressed_page_size,
+      pageHeader.uncompressed_page_size);
 
   auto parquetType = type_->parquetType_.value();
   switch (parquetType) {
@@ -502,16 +621,7 @@ void PageReader::prepareDictionary(const PageHeader& pageHeader) {
       } else {
         dictionary_.values = AlignedBuffer::allocate<char>(numBytes, &pool_);
       }
-      if (pageData_) {
-        memcpy(dictionary_.values->asMutable<char>(), pageData_, numBytes);
-      } else {
-        dwio::common::readBytes(
-            numBytes,
-            inputStream_.get(),
-            dictionary_.values->asMutable<char>(),
-            bufferStart_,
-            bufferEnd_);
-      }
+      memcpy(dictionary_.values->asMutable<char>(), pageData_, numBytes);
       if (type_->type()->isShortDecimal() &&
           parquetType == thrift::Type::INT32) {
         auto values = dictionary_.values->asMutable<int64_t>();
@@ -531,12 +641,7 @@ void PageReader::prepareDictionary(const PageHeader& pageHeader) {
       auto values = dictionary_.values->asMutable<StringView>();
       dictionary_.strings = AlignedBuffer::allocate<char>(numBytes, &pool_);
       auto strings = dictionary_.strings->asMutable<char>();
-      if (pageData_) {
-        memcpy(strings, pageData_, numBytes);
-      } else {
-        dwio::common::readBytes(
-            numBytes, inputStream_.get(), strings, bufferStart_, bufferEnd_);
-      }
+      memcpy(strings, pageData_, numBytes);
       auto header = strings;
       for (auto i = 0; i < dictionary_.numValues; ++i) {
         auto length = *reinterpret_cast<const int32_t*>(header);
@@ -553,17 +658,7 @@ void PageReader::prepareDictionary(const PageHeader& pageHeader) {
       auto numVeloxBytes = dictionary_.numValues * veloxTypeLength;
       dictionary_.values = AlignedBuffer::allocate<char>(numVeloxBytes, &pool_);
       auto data = dictionary_.values->asMutable<char>();
-      // Read the data bytes.
-      if (pageData_) {
-        memcpy(data, pageData_, numParquetBytes);
-      } else {
-        dwio::common::readBytes(
-            numParquetBytes,
-            inputStream_.get(),
-            data,
-            bufferStart_,
-            bufferEnd_);
-      }
+      memcpy(data, pageData_, numParquetBytes);
       if (type_->type()->isShortDecimal()) {
         // Parquet decimal values have a fixed typeLength_ and are in big-endian
         // layout.
@@ -614,7 +709,16 @@ void PageReader::prepareDictionary(const PageHeader& pageHeader) {
       VELOX_UNSUPPORTED(
           "Parquet type {} not supported for dictionary", parquetType);
     }
-    case thrift::Type::INT96:
+    case thrift::Type::INT96: {
+      // The values are converted in place to nanoseconds since the epoch.
+      auto numBytes = dictionary_.numValues * kInt96Bytes;
+      dictionary_.values = AlignedBuffer::allocate<char>(numBytes, &pool_);
+      auto data = dictionary_.values->asMutable<char>();
+      memcpy(data, pageData_, numBytes);
+      int96ToNanos(
+          data, dictionary_.numValues, reinterpret_cast<int64_t*>(data));
+      break;
+    }
     default:
       VELOX_UNSUPPORTED(
           "Parquet type {} not supported for dictionary", parquetType);
@@ -696,6 +800,18 @@ void PageReader::decodeRepDefs(int32_t numTopLevelRows) {
   int32_t topFound = 0;
   int32_t i = repDefBegin_;
   if (maxRepeat_ > 0) {
+    // Top level rows start at repetition level 0. Count them a SIMD batch at
+    // a time and find the exact end of the range only in the last batch.
+    using Batch = xsimd::batch<int16_t>;
+    const auto* levels = repetitionLevels_.data();
+    for (; i + Batch::size <= numLevels; i += Batch::size) {
+      const auto numStarts = __builtin_popcount(
+          simd::toBitMask(Batch::load_unaligned(levels + i) == Batch(0)));
+      if (topFound + numStarts > numTopLevelRows) {
+        break;
+      }
+      topFound += numStarts;
+    }
     for (; i < numLevels; ++i) {
       if (repetitionLevels_[i] == 0) {
         ++topFound;
@@ -784,6 +900,9 @@ void PageReader::makeDecoder() {
               type_->typeLength_,
               true);
           break;
+        case thrift::Type::INT96:
+          makeInt96Decoder();
+          break;
         default: {
           directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
               std::make_unique<dwio::common::SeekableArrayInputStream>(
@@ -793,12 +912,119 @@ void PageReader::makeDecoder() {
         }
       }
       break;
+    case Encoding::DELTA_LENGTH_BYTE_ARRAY:
+    case Encoding::DELTA_BYTE_ARRAY:
+      if (parquetType != thrift::Type::BYTE_ARRAY) {
+        VELOX_UNSUPPORTED(
+            "Encoding {} is only supported for BYTE_ARRAY",
+            thrift::to_string(encoding_));
+      }
+      makeDeltaStringDecoder();
+      break;
+    case Encoding::BYTE_STREAM_SPLIT:
+      makeByteStreamSplitDecoder();
+      break;
     case Encoding::DELTA_BINARY_PACKED:
     default:
       VELOX_UNSUPPORTED("Encoding not supported yet");
   }
 }
 
+void PageReader::makeDeltaStringDecoder() {
+  const auto* end = pageData_ + encodedDataSize_;
+  if (encoding_ == Encoding::DELTA_LENGTH_BYTE_ARRAY) {
+    // The lengths are followed by the concatenated values.
+    const auto* values =
+        decodeDeltaBinaryPacked(pageData_, end, stringLengths_);
+    stringDecoder_ =
+        std::make_unique<StringDecoder>(values, end, stringLengths_.data());
+    return;
+  }
+  // The prefix lengths are followed by the suffixes encoded as
+  // DELTA_LENGTH_BYTE_ARRAY. A value is the prefix of the previous value
+  // followed by the suffix.
+  const auto* suffixes =
+      decodeDeltaBinaryPacked(pageData_, end, prefixLengths_);
+  const auto* suffix = decodeDeltaBinaryPacked(suffixes, end, stringLengths_);
+  const auto numValues = stringLengths_.size();
+  VELOX_CHECK_EQ(prefixLengths_.size(), numValues);
+  uint64_t totalSize = 0;
+  for (auto i = 0; i < numValues; ++i) {
+    totalSize += prefixLengths_[i] + stringLengths_[i];
+  }
+  dwio::common::ensureCapacity<char>(decodedValues_, totalSize, &pool_);
+  auto* values = decodedValues_->asMutable<char>();
+  auto* value = values;
+  int32_t previousLength = 0;
+  for (auto i = 0; i < numValues; ++i) {
+    const auto prefixLength = prefixLengths_[i];
+    const auto suffixLength = stringLengths_[i];
+    VELOX_CHECK_LE(prefixLength, previousLength);
+    VELOX_CHECK_LE(suffixLength, end - suffix);
+    memcpy(value, value - previousLength, prefixLength);
+    memcpy(value + prefixLength, suffix, suffixLength);
+    suffix += suffixLength;
+    previousLength = prefixLength + suffixLength;
+    stringLengths_[i] = previousLength;
+    value += previousLength;
+  }
+  stringDecoder_ =
+      std::make_unique<StringDecoder>(values, value, stringLengths_.data());
+}
+
+namespace {
+// Interleaves the 'kWidth' byte streams of 'numValues' values at 'input' into
+// plain values at 'output'.
+template <int32_t kWidth>
+void decodeByteStreamSplit(const char* input, int32_t numValues, char* output) {
+  for (auto i = 0; i < numValues; ++i) {
+    for (auto stream = 0; stream < kWidth; ++stream) {
+      output[i * kWidth + stream] = input[stream * numValues + i];
+    }
+  }
+}
+} // namespace
+
+void PageReader::makeByteStreamSplitDecoder() {
+  const auto parquetType = type_->parquetType_.value();
+  if (parquetType != thrift::Type::FLOAT &&
+      parquetType != thrift::Type::DOUBLE &&
+      parquetType != thrift::Type::INT32 &&
+      parquetType != thrift::Type::INT64) {
+    VELOX_UNSUPPORTED(
+        "BYTE_STREAM_SPLIT is not supported for {}",
+        thrift::to_string(parquetType));
+  }
+  const int32_t width = parquetTypeBytes(parquetType);
+  VELOX_CHECK_EQ(encodedDataSize_ % width, 0);
+  const auto numValues = encodedDataSize_ / width;
+  dwio::common::ensureCapacity<char>(decodedValues_, encodedDataSize_, &pool_);
+  auto* values = decodedValues_->asMutable<char>();
+  if (width == 4) {
+    decodeByteStreamSplit<4>(pageData_, numValues, values);
+  } else {
+    decodeByteStreamSplit<8>(pageData_, numValues, values);
+  }
+  directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
+      std::make_unique<dwio::common::SeekableArrayInputStream>(
+          values, encodedDataSize_),
+      false,
+      width);
+}
+
+void PageReader::makeInt96Decoder() {
+  VELOX_CHECK_EQ(encodedDataSize_ % kInt96Bytes, 0);
+  const auto numValues = encodedDataSize_ / kInt96Bytes;
+  dwio::common::ensureCapacity<int64_t>(decodedValues_, numValues, &pool_);
+  auto* values = decodedValues_->asMutable<int64_t>();
+  int96ToNanos(pageData_, numValues, values);
+  directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
+      std::make_unique<dwio::common::SeekableArrayInputStream>(
+          reinterpret_cast<const char*>(values), numValues * sizeof(int64_t)),
+      false,
+      sizeof(int64_t));
+}
+
 void PageReader::skip(int64_t numRows) {
   if (!numRows && firstUnvisited_ != rowOfPage_ + numRowsInPage_) {
     // Return if no skip and position not at end of page or before first page.
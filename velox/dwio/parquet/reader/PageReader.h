@@ -20,6 +20,7 @@
 #include "velox/dwio/common/BitConcatenation.h"
 #include "velox/dwio/common/DirectDecoder.h"
 #include "velox/dwio/common/SelectiveColumnReader.h"
+#include "velox/dwio/common/compression/Compression.h"
 #include "velox/dwio/parquet/reader/BooleanDecoder.h"
 #include "velox/dwio/parquet/reader/ParquetTypeWithId.h"
 #include "velox/dwio/parquet/reader/RleBpDataDecoder.h"
@@ -120,6 +121,20 @@ class PageReader {
     dictionaryValues_.reset();
   }
 
+  /// Reads and decodes the dictionary page at the start of the column chunk.
+  /// Returns the dictionary, which has no values if the chunk does not start
+  /// with a dictionary page. Reads nothing past the dictionary page.
+  const dwio::common::DictionaryValues& readDictionaryPage();
+
+  /// Sets the dictionary of the column chunk, e.g. one returned by
+  /// readDictionaryPage() of another PageReader on the same chunk. The
+  /// dictionary page is then skipped instead of decoded.
+  void setDictionary(dwio::common::DictionaryValues dictionary) {
+    dictionary_ = std::move(dictionary);
+    dictionaryValues_.reset();
+    dictionaryPreset_ = true;
+  }
+
   /// Returns the range of repdefs for the top level rows covered by the last
   /// decoderepDefs().
   std::pair<int32_t, int32_t> repDefRange() const {
@@ -183,9 +198,43 @@ class PageReader {
 
   void prepareDataPageV1(const thrift::PageHeader& pageHeader, int64_t row);
   void prepareDataPageV2(const thrift::PageHeader& pageHeader, int64_t row);
-  void prepareDictionary(const thrift::PageHeader& pageHeader);
+
+  // Decompresses and decodes the dictionary page of 'pageHeader' from the
+  // compressed bytes at 'pageData'.
+  void prepareDictionary(
+      const thrift::PageHeader& pageHeader,
+      const char* pageData);
+
+  // Copies the dictionary page at the current position into
+  // 'dictionaryPage_' without decompressing or decoding it. Used when the
+  // first data page after the dictionary may be skipped. The dictionary is
+  // decoded by loadDictionaryIfNeeded() when the first data page that is not
+  // skipped uses it. A column chunk whose rows are all skipped, e.g. a lazily
+  // loaded column with no surviving rows in the chunk, never decodes its
+  // dictionary.
+  void deferDictionary(const thrift::PageHeader& pageHeader);
+
+  // Decodes the deferred dictionary page if a data page with 'encoding' is
+  // about to be decoded. Called before the data page is decompressed since
+  // both use 'pageData_' and 'uncompressedData_'.
+  void loadDictionaryIfNeeded(thrift::Encoding::type encoding);
+
   void makeDecoder();
 
+  // Makes 'stringDecoder_' for a DELTA_LENGTH_BYTE_ARRAY or DELTA_BYTE_ARRAY
+  // page. The lengths are decoded into 'stringLengths_'. The values of a
+  // DELTA_BYTE_ARRAY page are decoded into 'decodedValues_' since each value
+  // starts with a prefix of the previous one.
+  void makeDeltaStringDecoder();
+
+  // Makes 'directDecoder_' for a BYTE_STREAM_SPLIT page. The byte streams are
+  // interleaved into plain values in 'decodedValues_'.
+  void makeByteStreamSplitDecoder();
+
+  // Makes 'directDecoder_' for a PLAIN INT96 page. The timestamps are
+  // converted to nanoseconds since the epoch in 'decodedValues_'.
+  void makeInt96Decoder();
+
   // For a non-top level leaf, reads the defs and sets 'leafNulls_' and
   // 'numRowsInPage_' accordingly. This is used for non-top level leaves when
   // 'hasChunkRepDefs_' is false.
@@ -408,6 +457,24 @@ class PageReader {
   // Uncompressed data for the page. Rep-def-data in V1, data alone in V2.
   BufferPtr uncompressedData_;
 
+  // Decompressor made by a factory registered for 'codec_', e.g. for a
+  // hardware accelerator. Null if the pages are decompressed on the CPU.
+  // Looked up for the first compressed page.
+  std::unique_ptr<dwio::common::compression::Decompressor>
+      registeredDecompressor_;
+  bool registeredDecompressorChecked_{false};
+
+  // Values of the page transcoded to a form read by the decoders for
+  // encodings that cannot be read in place.
+  BufferPtr decodedValues_;
+
+  // Lengths of the strings of a DELTA_LENGTH_BYTE_ARRAY or DELTA_BYTE_ARRAY
+  // page.
+  raw_vector<int32_t> stringLengths_;
+
+  // Prefix lengths of the strings of a DELTA_BYTE_ARRAY page.
+  raw_vector<int32_t> prefixLengths_;
+
   // First byte of uncompressed encoded data. Contains the encoded data as a
   // contiguous run of bytes.
   const char* FOLLY_NULLABLE pageData_{nullptr};
@@ -416,6 +483,15 @@ class PageReader {
   dwio::common::DictionaryValues dictionary_;
   thrift::Encoding::type dictionaryEncoding_;
 
+  // Header and compressed bytes of the dictionary page of the column chunk
+  // if it has not been decoded yet.
+  thrift::PageHeader dictionaryHeader_;
+  BufferPtr dictionaryPage_;
+  bool dictionaryPending_{false};
+
+  // True if 'dictionary_' was set by setDictionary().
+  bool dictionaryPreset_{false};
+
   // Offset of current page's header from start of ColumnChunk.
   uint64_t pageStart_{0};
 
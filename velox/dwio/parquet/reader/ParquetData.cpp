@@ -15,12 +15,118 @@
  */
 
 #include "velox/dwio/parquet/reader/ParquetData.h"
+#include "velox/dwio/common/StreamUtil.h"
+#include "velox/dwio/parquet/reader/BloomFilter.h"
 #include "velox/dwio/parquet/reader/Statistics.h"
 
 namespace facebook::velox::parquet {
 
 using thrift::RowGroup;
 
+namespace {
+// Reads and deserializes the thrift struct at 'offset'. 'length' is the size
+// of the struct or a larger size that is readable. Returns the size of the
+// struct.
+template <typename T>
+uint32_t readThrift(
+    dwio::common::BufferedInput& input,
+    int64_t offset,
+    int32_t length,
+    T& value) {
+  auto stream = input.read(offset, length, dwio::common::LogType::STRIPE_INDEX);
+  std::vector<char> copy(length);
+  const char* bufferStart = nullptr;
+  const char* bufferEnd = nullptr;
+  dwio::common::readBytes(
+      length, stream.get(), copy.data(), bufferStart, bufferEnd);
+  std::shared_ptr<thrift::ThriftTransport> transport =
+      std::make_shared<thrift::ThriftBufferedTransport>(copy.data(), length);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport> protocol(
+      transport);
+  return value.read(&protocol);
+}
+
+bool isDictionaryEncoding(thrift::Encoding::type encoding) {
+  return encoding == thrift::Encoding::PLAIN_DICTIONARY ||
+      encoding == thrift::Encoding::RLE_DICTIONARY;
+}
+
+// Returns true if all data pages of the column chunk described by 'metaData'
+// are dictionary encoded, so that the dictionary has all the values.
+bool isFullyDictionaryEncoded(const thrift::ColumnMetaData& metaData) {
+  if (metaData.__isset.encoding_stats) {
+    bool hasDataPages = false;
+    for (auto& stats : metaData.encoding_stats) {
+      if (stats.page_type != thrift::PageType::DATA_PAGE &&
+          stats.page_type != thrift::PageType::DATA_PAGE_V2) {
+        continue;
+      }
+      if (stats.count > 0 && !isDictionaryEncoding(stats.encoding)) {
+        return false;
+      }
+      hasDataPages = true;
+    }
+    return hasDataPages;
+  }
+  // Without page encoding stats, the chunk may have fallen back to plain
+  // encoding if there is any value encoding other than the dictionary. RLE and
+  // BIT_PACKED are used for the levels.
+  bool hasDictionary = false;
+  for (auto encoding : metaData.encodings) {
+    if (isDictionaryEncoding(encoding)) {
+      hasDictionary = true;
+    } else if (
+        encoding != thrift::Encoding::RLE &&
+        encoding != thrift::Encoding::BIT_PACKED) {
+      return false;
+    }
+  }
+  return hasDictionary;
+}
+
+bool isDictionaryFilter(const common::Filter& filter) {
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange:
+    case common::FilterKind::kBigintValuesUsingHashTable:
+    case common::FilterKind::kBigintValuesUsingBitmask:
+    case common::FilterKind::kBytesRange:
+    case common::FilterKind::kBytesValues:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Returns true if some of the 'numValues' entries of 'dictionary' passes
+// 'filter'.
+template <typename T>
+bool anyIntegerPasses(
+    const common::Filter& filter,
+    const BufferPtr& dictionary,
+    int32_t numValues) {
+  auto* values = dictionary->as<T>();
+  for (auto i = 0; i < numValues; ++i) {
+    if (filter.testInt64(values[i])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool anyStringPasses(
+    const common::Filter& filter,
+    const BufferPtr& dictionary,
+    int32_t numValues) {
+  auto* values = dictionary->as<StringView>();
+  for (auto i = 0; i < numValues; ++i) {
+    if (filter.testBytes(values[i].data(), values[i].size())) {
+      return true;
+    }
+  }
+  return false;
+}
+} // namespace
+
 std::unique_ptr<dwio::common::FormatData> ParquetParams::toFormatData(
     const std::shared_ptr<const dwio::common::TypeWithId>& type,
     const common::ScanSpec& /*scanSpec*/) {
@@ -82,6 +188,180 @@ bool ParquetData::rowGroupMatches(
   return true;
 }
 
+bool ParquetData::bloomFilterMatches(
+    uint32_t index,
+    common::Filter* filter,
+    dwio::common::BufferedInput& input) const {
+  // The header is a few bytes in front of the bitset.
+  constexpr uint64_t kMaxHeaderSize = 64;
+  auto& metaData = rowGroups_[index].columns[type_->column()].meta_data;
+  if (!filter || !metaData.__isset.bloom_filter_offset) {
+    return true;
+  }
+  const uint64_t offset = metaData.bloom_filter_offset;
+  const auto fileSize = input.getReadFile()->size();
+  VELOX_CHECK_LT(offset, fileSize);
+  thrift::BloomFilterHeader header;
+  const auto headerSize = readThrift(
+      input, offset, std::min(kMaxHeaderSize, fileSize - offset), header);
+  if (!header.algorithm.__isset.BLOCK || !header.hash.__isset.XXHASH ||
+      !header.compression.__isset.UNCOMPRESSED || header.numBytes <= 0 ||
+      header.numBytes % SplitBlockBloomFilter::kBytesPerBlock != 0) {
+    return true;
+  }
+  std::vector<uint32_t> bitset(header.numBytes / sizeof(uint32_t));
+  auto stream = input.read(
+      offset + headerSize,
+      header.numBytes,
+      dwio::common::LogType::STRIPE_INDEX);
+  const char* bufferStart = nullptr;
+  const char* bufferEnd = nullptr;
+  dwio::common::readBytes(
+      header.numBytes, stream.get(), bitset.data(), bufferStart, bufferEnd);
+  return testFilter(
+      *filter,
+      metaData.type,
+      SplitBlockBloomFilter(bitset.data(), header.numBytes));
+}
+
+bool ParquetData::dictionaryMatches(
+    uint32_t index,
+    common::Filter* filter,
+    dwio::common::BufferedInput& input) {
+  auto& metaData = rowGroups_[index].columns[type_->column()].meta_data;
+  // Null rows are not in the dictionary, so a filter that passes nulls cannot
+  // be decided from the dictionary.
+  if (!filter || !isDictionaryFilter(*filter) ||
+      (filter->testNull() && maxDefine_ > 0) ||
+      !metaData.__isset.dictionary_page_offset ||
+      metaData.dictionary_page_offset < 4 ||
+      metaData.data_page_offset <= metaData.dictionary_page_offset ||
+      !isFullyDictionaryEncoded(metaData)) {
+    return true;
+  }
+  const auto parquetType = type_->parquetType_.value();
+  const auto kind = type_->type()->kind();
+  const bool isBytesFilter =
+      filter->kind() == common::FilterKind::kBytesRange ||
+      filter->kind() == common::FilterKind::kBytesValues;
+  if (isBytesFilter) {
+    if (parquetType != thrift::Type::BYTE_ARRAY ||
+        (kind != TypeKind::VARCHAR && kind != TypeKind::VARBINARY)) {
+      return true;
+    }
+  } else if (
+      (parquetType != thrift::Type::INT32 &&
+       parquetType != thrift::Type::INT64) ||
+      (kind != TypeKind::TINYINT && kind != TypeKind::SMALLINT &&
+       kind != TypeKind::INTEGER && kind != TypeKind::BIGINT)) {
+    return true;
+  }
+  // The dictionary page is the first page of the chunk and is followed by the
+  // data pages.
+  const auto dictionarySize =
+      metaData.data_page_offset - metaData.dictionary_page_offset;
+  PageReader reader(
+      input.read(
+          metaData.dictionary_page_offset,
+          dictionarySize,
+          dwio::common::LogType::STREAM),
+      pool_,
+      type_,
+      metaData.codec,
+      dictionarySize);
+  auto& dictionary = reader.readDictionaryPage();
+  if (!dictionary.values) {
+    return true;
+  }
+  bool matches;
+  if (isBytesFilter) {
+    matches = anyStringPasses(*filter, dictionary.values, dictionary.numValues);
+  } else if (
+      parquetType == thrift::Type::INT32 && !type_->type()->isShortDecimal()) {
+    matches = anyIntegerPasses<int32_t>(
+        *filter, dictionary.values, dictionary.numValues);
+  } else {
+    // INT64 values and INT32 decimals, which are widened to 64 bits.
+    matches = anyIntegerPasses<int64_t>(
+        *filter, dictionary.values, dictionary.numValues);
+  }
+  if (matches) {
+    dictionaries_.resize(rowGroups_.size());
+    dictionaries_[index] = dictionary;
+  }
+  return matches;
+}
+
+void ParquetData::filterPages(
+    uint32_t index,
+    common::Filter* filter,
+    dwio::common::BufferedInput& input,
+    std::vector<RowRange>& skippedRows) const {
+  auto& rowGroup = rowGroups_[index];
+  auto& chunk = rowGroup.columns[type_->column()];
+  if (!filter || !chunk.__isset.column_index_offset ||
+      !chunk.__isset.offset_index_offset) {
+    return;
+  }
+  thrift::ColumnIndex columnIndex;
+  readThrift(
+      input, chunk.column_index_offset, chunk.column_index_length, columnIndex);
+  thrift::OffsetIndex offsetIndex;
+  readThrift(
+      input, chunk.offset_index_offset, chunk.offset_index_length, offsetIndex);
+  filterPages(
+      filter,
+      type_->type(),
+      columnIndex,
+      offsetIndex,
+      rowGroup.num_rows,
+      skippedRows);
+}
+
+// static
+void ParquetData::filterPages(
+    common::Filter* filter,
+    const TypePtr& type,
+    const thrift::ColumnIndex& columnIndex,
+    const thrift::OffsetIndex& offsetIndex,
+    int64_t numRows,
+    std::vector<RowRange>& skippedRows) {
+  const auto& pages = offsetIndex.page_locations;
+  const auto numPages = pages.size();
+  if (columnIndex.null_pages.size() != numPages ||
+      columnIndex.min_values.size() != numPages ||
+      columnIndex.max_values.size() != numPages) {
+    return;
+  }
+  const bool hasNullCounts = columnIndex.__isset.null_counts &&
+      columnIndex.null_counts.size() == numPages;
+  for (auto i = 0; i < numPages; ++i) {
+    const auto begin = pages[i].first_row_index;
+    const auto end = i + 1 < numPages ? pages[i + 1].first_row_index : numRows;
+    const auto numPageRows = end - begin;
+    // The page stats have the same encoding as the column chunk stats.
+    thrift::Statistics stats;
+    if (hasNullCounts) {
+      stats.__set_null_count(columnIndex.null_counts[i]);
+    } else if (columnIndex.null_pages[i]) {
+      stats.__set_null_count(numPageRows);
+    }
+    if (!columnIndex.null_pages[i]) {
+      stats.__set_min_value(columnIndex.min_values[i]);
+      stats.__set_max_value(columnIndex.max_values[i]);
+    }
+    auto pageStats = buildColumnStatisticsFromThrift(stats, *type, numPageRows);
+    if (testFilter(filter, pageStats.get(), numPageRows, type)) {
+      continue;
+    }
+    if (!skippedRows.empty() && skippedRows.back().end == begin) {
+      skippedRows.back().end = end;
+    } else {
+      skippedRows.push_back({begin, end});
+    }
+  }
+}
+
 void ParquetData::enqueueRowGroup(
     uint32_t index,
     dwio::common::BufferedInput& input) {
@@ -120,6 +400,10 @@ dwio::common::PositionProvider ParquetData::seekToRowGroup(uint32_t index) {
       type_,
       metadata.codec,
       metadata.total_compressed_size);
+  if (index < dictionaries_.size() && dictionaries_[index].values) {
+    reader_->setDictionary(std::move(dictionaries_[index]));
+    dictionaries_[index].clear();
+  }
   return dwio::common::PositionProvider(empty);
 }
 
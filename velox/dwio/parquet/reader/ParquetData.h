@@ -38,6 +38,12 @@ class ParquetParams : public dwio::common::FormatParams {
   const thrift::FileMetaData& metaData_;
 };
 
+/// A range of rows [begin, end) in a row group.
+struct RowRange {
+  int64_t begin;
+  int64_t end;
+};
+
 /// Format-specific data created for each leaf column of a Parquet rowgroup.
 class ParquetData : public dwio::common::FormatData {
  public:
@@ -66,6 +72,47 @@ class ParquetData : public dwio::common::FormatData {
       const dwio::common::StatsContext& writerContext,
       FilterRowGroupsResult&) override;
 
+  /// Reads the Bloom filter of the column chunk of 'this' in 'index'th row
+  /// group from 'input'. Returns false if the Bloom filter shows that no value
+  /// passes 'filter', true if there may be hits or there is no Bloom filter.
+  bool bloomFilterMatches(
+      uint32_t index,
+      common::Filter* filter,
+      dwio::common::BufferedInput& input) const;
+
+  /// Reads the dictionary page of the column chunk of 'this' in 'index'th row
+  /// group from 'input'. Returns false if no dictionary entry passes 'filter'
+  /// and all data pages of the chunk are dictionary encoded, true otherwise.
+  /// Only equality, IN and range filters on integer and string columns are
+  /// tested. If the row group may have hits, the dictionary is kept and used
+  /// when reading the row group.
+  bool dictionaryMatches(
+      uint32_t index,
+      common::Filter* filter,
+      dwio::common::BufferedInput& input);
+
+  /// Reads the page index of the column chunk of 'this' in 'index'th row group
+  /// from 'input' and appends to 'skippedRows' the row ranges of the pages
+  /// that cannot have hits for 'filter'. Does nothing if the column chunk has
+  /// no page index.
+  void filterPages(
+      uint32_t index,
+      common::Filter* filter,
+      dwio::common::BufferedInput& input,
+      std::vector<RowRange>& skippedRows) const;
+
+  /// Appends to 'skippedRows' the row ranges of the pages in 'offsetIndex'
+  /// whose min, max and null counts in 'columnIndex' show that no value of
+  /// 'type' passes 'filter'. 'numRows' is the number of rows in the row group.
+  /// Adjacent ranges are coalesced.
+  static void filterPages(
+      common::Filter* filter,
+      const TypePtr& type,
+      const thrift::ColumnIndex& columnIndex,
+      const thrift::OffsetIndex& offsetIndex,
+      int64_t numRows,
+      std::vector<RowRange>& skippedRows);
+
   PageReader* FOLLY_NONNULL reader() const {
     return reader_.get();
   }
@@ -193,6 +240,10 @@ class ParquetData : public dwio::common::FormatData {
   int64_t rowsInRowGroup_;
   std::unique_ptr<PageReader> reader_;
 
+  // Dictionaries read by dictionaryMatches(), by row group. Moved to the
+  // PageReader of the row group in seekToRowGroup().
+  std::vector<dwio::common::DictionaryValues> dictionaries_;
+
   // Nulls derived from leaf repdefs for non-leaf readers.
   BufferPtr presetNulls_;
 
@@ -18,6 +18,7 @@
 #include <thrift/protocol/TCompactProtocol.h> //@manual
 #include "velox/dwio/common/MetricsLog.h"
 #include "velox/dwio/common/TypeUtils.h"
+#include "velox/dwio/parquet/reader/Statistics.h"
 #include "velox/dwio/parquet/reader/StructColumnReader.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
 
@@ -28,8 +29,75 @@ DEFINE_int32(
     "prefetch. 1 means prefetch the next row group before decoding "
     "the current one");
 
+DEFINE_bool(
+    parquet_use_bloom_filter,
+    true,
+    "Skip the row groups where the Bloom filter of a column shows that no "
+    "value passes an equality or IN filter");
+
+DEFINE_bool(
+    parquet_use_dictionary_filter,
+    true,
+    "Skip the row groups where the dictionary of a column shows that no "
+    "value passes the filter");
+
+DEFINE_bool(
+    parquet_use_page_index,
+    true,
+    "Skip the pages where the column index shows that no row can pass the "
+    "filters");
+
 namespace facebook::velox::parquet {
 
+namespace {
+// The footer of a Parquet file in the FileMetadataCache.
+struct ParquetFileMetadata : public dwio::common::FileMetadata {
+  // The decoded Thrift structs take about this many times the bytes of the
+  // serialized footer.
+  static constexpr uint64_t kExpansion = 4;
+
+  explicit ParquetFileMetadata(uint64_t _footerLength)
+      : footerLength(_footerLength) {}
+
+  uint64_t sizeBytes() const override {
+    return sizeof(*this) + footerLength * kExpansion;
+  }
+
+  const uint64_t footerLength;
+  thrift::FileMetaData fileMetaData;
+};
+
+// Returns the logical type of 'schemaElement'. Files from older writers have
+// only the converted type of a timestamp, which is translated to the logical
+// type.
+std::optional<thrift::LogicalType> logicalTypeOf(
+    const thrift::SchemaElement& schemaElement) {
+  if (schemaElement.__isset.logicalType) {
+    return schemaElement.logicalType;
+  }
+  if (!schemaElement.__isset.converted_type) {
+    return std::nullopt;
+  }
+  thrift::TimeUnit unit;
+  switch (schemaElement.converted_type) {
+    case thrift::ConvertedType::TIMESTAMP_MILLIS:
+      unit.__set_MILLIS(thrift::MilliSeconds());
+      break;
+    case thrift::ConvertedType::TIMESTAMP_MICROS:
+      unit.__set_MICROS(thrift::MicroSeconds());
+      break;
+    default:
+      return std::nullopt;
+  }
+  thrift::TimestampType timestamp;
+  timestamp.__set_isAdjustedToUTC(true);
+  timestamp.__set_unit(unit);
+  thrift::LogicalType logicalType;
+  logicalType.__set_TIMESTAMP(timestamp);
+  return logicalType;
+}
+} // namespace
+
 /// Metadata and options for reading Parquet.
 class ReaderBase {
  public:
@@ -112,7 +180,8 @@ class ReaderBase {
   const dwio::common::ReaderOptions options_;
   std::shared_ptr<velox::dwio::common::BufferedInput> input_;
   uint64_t fileLength_;
-  std::unique_ptr<thrift::FileMetaData> fileMetaData_;
+  // Shared with other readers of the file through the FileMetadataCache.
+  std::shared_ptr<const thrift::FileMetaData> fileMetaData_;
   RowTypePtr schema_;
   std::shared_ptr<const dwio::common::TypeWithId> schemaWithId_;
 
@@ -140,6 +209,20 @@ ReaderBase::ReaderBase(
 }
 
 void ReaderBase::loadFileMetaData() {
+  auto* metadataCache = options_.fileMetadataCache();
+  dwio::common::FileMetadataKey key;
+  if (metadataCache) {
+    key = {
+        input_->getReadFile()->getName(),
+        fileLength_,
+        options_.fileModificationTime()};
+    if (auto cached = metadataCache->get<ParquetFileMetadata>(key)) {
+      fileMetaData_ = std::shared_ptr<const thrift::FileMetaData>(
+          cached, &cached->fileMetaData);
+      return;
+    }
+  }
+
   bool preloadFile =
       fileLength_ <= std::max(filePreloadThreshold_, directorySizeGuess_);
   uint64_t readSize = preloadFile ? fileLength_ : directorySizeGuess_;
@@ -186,8 +269,13 @@ void ReaderBase::loadFileMetaData() {
   auto thriftProtocol = std::make_unique<
       apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>>(
       thriftTransport);
-  fileMetaData_ = std::make_unique<thrift::FileMetaData>();
-  fileMetaData_->read(thriftProtocol.get());
+  auto metadata = std::make_shared<ParquetFileMetadata>(footerLength);
+  metadata->fileMetaData.read(thriftProtocol.get());
+  if (metadataCache) {
+    metadataCache->put(key, metadata);
+  }
+  fileMetaData_ = std::shared_ptr<const thrift::FileMetaData>(
+      metadata, &metadata->fileMetaData);
 }
 
 void ReaderBase::initializeSchema() {
@@ -364,9 +452,7 @@ std::shared_ptr<const ParquetTypeWithId> ReaderBase::getParquetColumnInfo(
         schemaElement.__isset.type_length ? schemaElement.type_length : 0;
     std::vector<std::shared_ptr<const dwio::common::TypeWithId>> children;
     const std::optional<thrift::LogicalType> logicalType_ =
-        schemaElement.__isset.logicalType
-        ? std::optional<thrift::LogicalType>(schemaElement.logicalType)
-        : std::nullopt;
+        logicalTypeOf(schemaElement);
     std::shared_ptr<const ParquetTypeWithId> leafTypePtr =
         std::make_shared<const ParquetTypeWithId>(
             veloxType,
@@ -526,9 +612,14 @@ TypePtr ReaderBase::convertType(
       case thrift::Type::type::INT32:
         return INTEGER();
       case thrift::Type::type::INT64:
+        // A timestamp in nanoseconds has a logical type but no converted type.
+        if (schemaElement.__isset.logicalType &&
+            schemaElement.logicalType.__isset.TIMESTAMP) {
+          return TIMESTAMP();
+        }
         return BIGINT();
       case thrift::Type::type::INT96:
-        return DOUBLE(); // TODO: Lose precision
+        return TIMESTAMP();
       case thrift::Type::type::FLOAT:
         return REAL();
       case thrift::Type::type::DOUBLE:
@@ -679,7 +770,14 @@ void ParquetRowReader::filterRowGroups() {
          fileOffset < options_.getLimit());
     // A skipped row group is one that is in range and is in the excluded list.
     if (rowGroupInRange) {
-      if (i < res.totalCount && bits::isBitSet(res.filterResult.data(), i)) {
+      if ((i < res.totalCount &&
+           bits::isBitSet(res.filterResult.data(), i)) ||
+          (FLAGS_parquet_use_bloom_filter &&
+           !static_cast<StructColumnReader&>(*columnReader_)
+                .bloomFiltersMatch(i, readerBase_->bufferedInput())) ||
+          (FLAGS_parquet_use_dictionary_filter &&
+           !static_cast<StructColumnReader&>(*columnReader_)
+                .dictionariesMatch(i, readerBase_->bufferedInput()))) {
         ++skippedRowGroups_;
       } else {
         rowGroupIds_.push_back(i);
@@ -691,9 +789,15 @@ void ParquetRowReader::filterRowGroups() {
 }
 
 int64_t ParquetRowReader::nextRowNumber() {
-  if (currentRowInGroup_ >= rowsInCurrentRowGroup_ &&
-      !advanceToNextRowGroup()) {
-    return kAtEnd;
+  for (;;) {
+    if (currentRowInGroup_ >= rowsInCurrentRowGroup_ &&
+        !advanceToNextRowGroup()) {
+      return kAtEnd;
+    }
+    skipFilteredPages();
+    if (currentRowInGroup_ < rowsInCurrentRowGroup_) {
+      break;
+    }
   }
   return firstRowOfRowGroup_[nextRowGroupIdsIdx_ - 1] + currentRowInGroup_;
 }
@@ -703,7 +807,27 @@ int64_t ParquetRowReader::nextReadSize(uint64_t size) {
   if (nextRowNumber() == kAtEnd) {
     return kAtEnd;
   }
-  return std::min(size, rowsInCurrentRowGroup_ - currentRowInGroup_);
+  const uint64_t end = nextSkippedRows_ < skippedRows_.size()
+      ? skippedRows_[nextSkippedRows_].begin
+      : rowsInCurrentRowGroup_;
+  return std::min(size, end - currentRowInGroup_);
+}
+
+void ParquetRowReader::skipFilteredPages() {
+  for (; nextSkippedRows_ < skippedRows_.size(); ++nextSkippedRows_) {
+    const auto& range = skippedRows_[nextSkippedRows_];
+    const int64_t row = currentRowInGroup_;
+    if (row < range.begin) {
+      return;
+    }
+    if (row < range.end) {
+      // The column readers skip to the new offset on their next read. The
+      // pages in between are not decompressed or decoded.
+      columnReader_->setReadOffset(
+          columnReader_->readOffset() + range.end - row);
+      currentRowInGroup_ = range.end;
+    }
+  }
 }
 
 uint64_t ParquetRowReader::next(
@@ -736,6 +860,13 @@ bool ParquetRowReader::advanceToNextRowGroup() {
   currentRowInGroup_ = 0;
   nextRowGroupIdsIdx_++;
   columnReader_->seekToRowGroup(nextRowGroupIndex);
+  skippedRows_.clear();
+  nextSkippedRows_ = 0;
+  if (FLAGS_parquet_use_page_index) {
+    static_cast<StructColumnReader&>(*columnReader_)
+        .filterPages(
+            nextRowGroupIndex, readerBase_->bufferedInput(), skippedRows_);
+  }
   return true;
 }
 
@@ -765,6 +896,62 @@ std::optional<uint64_t> ParquetReader::numberOfRows() const {
   return readerBase_->fileNumRows();
 }
 
+std::unique_ptr<dwio::common::ColumnStatistics>
+ParquetReader::columnStatistics(uint32_t nodeId) const {
+  const auto& schema = *readerBase_->schemaWithId();
+  const ParquetTypeWithId* column = nullptr;
+  for (auto i = 0; i < schema.size(); ++i) {
+    if (schema.childAt(i)->id() == nodeId) {
+      column = static_cast<const ParquetTypeWithId*>(schema.childAt(i).get());
+      break;
+    }
+  }
+  if (!column || !column->isLeaf() || column->type()->isDecimal()) {
+    return nullptr;
+  }
+  const auto kind = column->type()->kind();
+  if (kind != TypeKind::TINYINT && kind != TypeKind::SMALLINT &&
+      kind != TypeKind::INTEGER && kind != TypeKind::BIGINT) {
+    return nullptr;
+  }
+
+  uint64_t numValues = 0;
+  bool hasNull = false;
+  std::optional<int64_t> min;
+  std::optional<int64_t> max;
+  for (const auto& rowGroup : readerBase_->fileMetaData().row_groups) {
+    const auto& chunk = rowGroup.columns[column->column()];
+    if (!chunk.__isset.meta_data || !chunk.meta_data.__isset.statistics) {
+      return nullptr;
+    }
+    auto stats = buildColumnStatisticsFromThrift(
+        chunk.meta_data.statistics, *column->type(), rowGroup.num_rows);
+    auto* integerStats =
+        dynamic_cast<const dwio::common::IntegerColumnStatistics*>(
+            stats.get());
+    if (!integerStats || !integerStats->getNumberOfValues().has_value()) {
+      return nullptr;
+    }
+    const auto rowGroupValues = integerStats->getNumberOfValues().value();
+    numValues += rowGroupValues;
+    hasNull |= rowGroupValues < static_cast<uint64_t>(rowGroup.num_rows);
+    if (rowGroupValues == 0) {
+      continue;
+    }
+    const auto rowGroupMin = integerStats->getMinimum();
+    const auto rowGroupMax = integerStats->getMaximum();
+    if (!rowGroupMin.has_value() || !rowGroupMax.has_value()) {
+      return nullptr;
+    }
+    min = min.has_value() ? std::min(min.value(), rowGroupMin.value())
+                          : rowGroupMin.value();
+    max = max.has_value() ? std::max(max.value(), rowGroupMax.value())
+                          : rowGroupMax.value();
+  }
+  return std::make_unique<dwio::common::IntegerColumnStatistics>(
+      numValues, hasNull, std::nullopt, std::nullopt, min, max, std::nullopt);
+}
+
 const velox::RowTypePtr& ParquetReader::rowType() const {
   return readerBase_->schema();
 }
@@ -20,6 +20,7 @@
 #include "velox/dwio/common/Reader.h"
 #include "velox/dwio/common/ReaderFactory.h"
 #include "velox/dwio/common/SelectiveColumnReader.h"
+#include "velox/dwio/parquet/reader/ParquetData.h"
 #include "velox/dwio/parquet/reader/ParquetTypeWithId.h"
 #include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
 
@@ -73,6 +74,10 @@ class ParquetRowReader : public dwio::common::RowReader {
   // by filterRowGroups().
   bool advanceToNextRowGroup();
 
+  // Advances past the rows of the current row group in 'skippedRows_' that
+  // start at or before 'currentRowInGroup_'.
+  void skipFilteredPages();
+
   memory::MemoryPool& pool_;
   const std::shared_ptr<ReaderBase> readerBase_;
   const dwio::common::RowReaderOptions options_;
@@ -88,6 +93,12 @@ class ParquetRowReader : public dwio::common::RowReader {
   uint64_t rowsInCurrentRowGroup_;
   uint64_t currentRowInGroup_;
 
+  // Row ranges of the current row group that the page indexes show to have no
+  // hits for the filters.
+  std::vector<RowRange> skippedRows_;
+  // Index of the first range in 'skippedRows_' not yet skipped.
+  size_t nextSkippedRows_{0};
+
   // Number of row groups skipped based on stats.
   int32_t skippedRowGroups_{0};
 
@@ -107,10 +118,11 @@ class ParquetReader : public dwio::common::Reader {
 
   std::optional<uint64_t> numberOfRows() const override;
 
+  /// Returns the statistics of the top level integer column 'nodeId' combined
+  /// over all row groups, or nullptr for other columns or if a row group has
+  /// no statistics for the column.
   std::unique_ptr<dwio::common::ColumnStatistics> columnStatistics(
-      uint32_t index) const override {
-    return nullptr;
-  }
+      uint32_t nodeId) const override;
 
   const velox::RowTypePtr& rowType() const override;
 
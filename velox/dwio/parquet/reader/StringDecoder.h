@@ -24,12 +24,18 @@
 
 namespace facebook::velox::parquet {
 
+/// Decodes BYTE_ARRAY values. The values are either PLAIN encoded, each
+/// preceded by its length, or consecutive with 'lengths' given separately, as
+/// for the DELTA_LENGTH_BYTE_ARRAY and the decoded DELTA_BYTE_ARRAY encodings.
 class StringDecoder {
  public:
-  StringDecoder(const char* FOLLY_NONNULL start, const char* FOLLY_NONNULL end)
+  StringDecoder(
+      const char* FOLLY_NONNULL start,
+      const char* FOLLY_NONNULL end,
+      const int32_t* FOLLY_NULLABLE lengths = nullptr)
       : bufferStart_(start),
         bufferEnd_(end),
-
+        lengths_(lengths),
         lastSafeWord_(end - simd::kPadding) {}
 
   void skip(uint64_t numValues) {
@@ -45,7 +51,7 @@ class StringDecoder {
       numValues = bits::countNonNulls(nulls, current, current + numValues);
     }
     for (auto i = 0; i < numValues; ++i) {
-      bufferStart_ += lengthAt(bufferStart_) + sizeof(int32_t);
+      bufferStart_ += readLength();
     }
   }
 
@@ -85,17 +91,24 @@ class StringDecoder {
   }
 
  private:
-  int32_t lengthAt(const char* FOLLY_NONNULL buffer) {
-    return *reinterpret_cast<const int32_t*>(buffer);
+  // Returns the length of the next value and moves past the length.
+  int32_t readLength() {
+    if (lengths_) {
+      return *lengths_++;
+    }
+    auto length = *reinterpret_cast<const int32_t*>(bufferStart_);
+    bufferStart_ += sizeof(int32_t);
+    return length;
   }
 
   folly::StringPiece readString() {
-    auto length = lengthAt(bufferStart_);
-    bufferStart_ += length + sizeof(int32_t);
+    auto length = readLength();
+    bufferStart_ += length;
     return folly::StringPiece(bufferStart_ - length, length);
   }
   const char* FOLLY_NONNULL bufferStart_;
   const char* FOLLY_NONNULL bufferEnd_;
+  const int32_t* FOLLY_NULLABLE lengths_;
   const char* FOLLY_NONNULL const lastSafeWord_;
 };
 
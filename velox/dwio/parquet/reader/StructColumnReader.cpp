@@ -157,6 +157,88 @@ void StructColumnReader::seekToEndOfPresetNulls() {
   formatData_->as<ParquetData>().skipNulls(numUnread, false);
 }
 
+bool StructColumnReader::bloomFiltersMatch(
+    uint32_t index,
+    dwio::common::BufferedInput& input) const {
+  for (auto& childSpec : scanSpec_->children()) {
+    if (isChildConstant(*childSpec) || !childSpec->filter()) {
+      continue;
+    }
+    auto* child = children_[childSpec->subscript()];
+    auto& childType = static_cast<const ParquetTypeWithId&>(child->fileType());
+    if (childType.column() == ParquetTypeWithId::kNonLeaf ||
+        childType.maxRepeat_ > 0) {
+      continue;
+    }
+    if (!child->formatData().as<ParquetData>().bloomFilterMatches(
+            index, childSpec->filter(), input)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool StructColumnReader::dictionariesMatch(
+    uint32_t index,
+    dwio::common::BufferedInput& input) const {
+  for (auto& childSpec : scanSpec_->children()) {
+    if (isChildConstant(*childSpec) || !childSpec->filter()) {
+      continue;
+    }
+    auto* child = children_[childSpec->subscript()];
+    auto& childType = static_cast<const ParquetTypeWithId&>(child->fileType());
+    if (childType.column() == ParquetTypeWithId::kNonLeaf ||
+        childType.maxRepeat_ > 0) {
+      continue;
+    }
+    if (!child->formatData().as<ParquetData>().dictionaryMatches(
+            index, childSpec->filter(), input)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void StructColumnReader::filterPages(
+    uint32_t index,
+    dwio::common::BufferedInput& input,
+    std::vector<RowRange>& skippedRows) const {
+  auto& childSpecs = scanSpec_->children();
+  for (auto& childSpec : childSpecs) {
+    if (isChildConstant(*childSpec)) {
+      continue;
+    }
+    auto& childType = static_cast<const ParquetTypeWithId&>(
+        children_[childSpec->subscript()]->fileType());
+    if (childType.column() == ParquetTypeWithId::kNonLeaf ||
+        childType.maxRepeat_ > 0) {
+      return;
+    }
+  }
+  std::vector<RowRange> ranges;
+  for (auto& childSpec : childSpecs) {
+    if (isChildConstant(*childSpec) || !childSpec->filter()) {
+      continue;
+    }
+    children_[childSpec->subscript()]
+        ->formatData()
+        .as<ParquetData>()
+        .filterPages(index, childSpec->filter(), input, ranges);
+  }
+  // The filters of all children must pass, so a row is skipped if it is in a
+  // skipped range of any child.
+  std::sort(ranges.begin(), ranges.end(), [](auto& left, auto& right) {
+    return left.begin < right.begin;
+  });
+  for (auto& range : ranges) {
+    if (!skippedRows.empty() && range.begin <= skippedRows.back().end) {
+      skippedRows.back().end = std::max(skippedRows.back().end, range.end);
+    } else {
+      skippedRows.push_back(range);
+    }
+  }
+}
+
 void StructColumnReader::setNullsFromRepDefs(PageReader& pageReader) {
   if (levelInfo_.def_level == 0) {
     return;
@@ -61,6 +61,27 @@ class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
   /// positioned at the end of the last set of nulls/lengths.
   void seekToEndOfPresetNulls();
 
+  /// Returns false if the Bloom filter of some filtered top level primitive
+  /// child shows that no row of 'index'th row group passes the filter.
+  bool bloomFiltersMatch(uint32_t index, dwio::common::BufferedInput& input)
+      const;
+
+  /// Returns false if the dictionary of some filtered top level primitive child
+  /// shows that no row of 'index'th row group passes the filter. See
+  /// ParquetData::dictionaryMatches().
+  bool dictionariesMatch(uint32_t index, dwio::common::BufferedInput& input)
+      const;
+
+  /// Appends to 'skippedRows' the row ranges of 'index'th row group where the
+  /// page index of some filtered child shows that no row can pass the filter.
+  /// The ranges are sorted and do not overlap. Only produces ranges if all the
+  /// read children are top level primitive columns, so that skipping rows
+  /// does not need repdefs.
+  void filterPages(
+      uint32_t index,
+      dwio::common::BufferedInput& input,
+      std::vector<RowRange>& skippedRows) const;
+
   void filterRowGroups(
       uint64_t rowGroupSize,
       const dwio::common::StatsContext&,
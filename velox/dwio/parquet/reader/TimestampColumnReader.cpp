@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/TimestampColumnReader.h"
+
+namespace facebook::velox::parquet {
+
+namespace {
+constexpr int64_t kNanosPerSecond = 1'000'000'000;
+
+int64_t unitsPerSecond(const ParquetTypeWithId& type) {
+  if (type.parquetType_ == thrift::Type::INT96) {
+    return kNanosPerSecond;
+  }
+  VELOX_CHECK(
+      type.parquetType_ == thrift::Type::INT64 && type.logicalType_ &&
+          type.logicalType_->__isset.TIMESTAMP,
+      "Parquet timestamp must be INT96 or INT64 with a TIMESTAMP type: {}",
+      type.name_);
+  const auto& unit = type.logicalType_->TIMESTAMP.unit;
+  if (unit.__isset.MILLIS) {
+    return 1'000;
+  }
+  if (unit.__isset.MICROS) {
+    return 1'000'000;
+  }
+  VELOX_CHECK(unit.__isset.NANOS, "Unknown timestamp unit: {}", type.name_);
+  return kNanosPerSecond;
+}
+
+// Returns 'timestamp' in units of 'unitsPerSecond', rounded up if 'roundUp'
+// and down otherwise. Saturates at the limits of int64_t.
+int64_t toUnits(
+    const Timestamp& timestamp,
+    int64_t unitsPerSecond,
+    bool roundUp) {
+  const int64_t nanosPerUnit = kNanosPerSecond / unitsPerSecond;
+  int64_t units = timestamp.getNanos() / nanosPerUnit;
+  if (roundUp && timestamp.getNanos() % nanosPerUnit != 0) {
+    ++units;
+  }
+  int64_t result;
+  if (__builtin_mul_overflow(timestamp.getSeconds(), unitsPerSecond, &result) ||
+      __builtin_add_overflow(result, units, &result)) {
+    return timestamp.getSeconds() < 0 ? std::numeric_limits<int64_t>::min()
+                                      : std::numeric_limits<int64_t>::max();
+  }
+  return result;
+}
+
+template <int64_t kUnitsPerSecond>
+void toTimestamps(const int64_t* values, int32_t numValues, Timestamp* result) {
+  for (auto i = 0; i < numValues; ++i) {
+    if constexpr (kUnitsPerSecond == 1'000) {
+      result[i] = Timestamp::fromMillis(values[i]);
+    } else if constexpr (kUnitsPerSecond == 1'000'000) {
+      result[i] = Timestamp::fromMicros(values[i]);
+    } else {
+      result[i] = Timestamp::fromNanos(values[i]);
+    }
+  }
+}
+} // namespace
+
+TimestampColumnReader::TimestampColumnReader(
+    const std::shared_ptr<const dwio::common::TypeWithId>& requestedType,
+    std::shared_ptr<const dwio::common::TypeWithId> dataType,
+    ParquetParams& params,
+    common::ScanSpec& scanSpec)
+    : SelectiveIntegerColumnReader(
+          requestedType->type(),
+          params,
+          scanSpec,
+          dataType),
+      unitsPerSecond_(
+          unitsPerSecond(static_cast<const ParquetTypeWithId&>(*dataType))) {}
+
+common::Filter* TimestampColumnReader::encodedFilter() {
+  auto* filter = scanSpec_->filter();
+  if (!filter) {
+    return &dwio::common::alwaysTrue();
+  }
+  if (filter == filter_) {
+    return encodedFilter_ ? encodedFilter_.get() : filter;
+  }
+  filter_ = filter;
+  encodedFilter_.reset();
+  switch (filter->kind()) {
+    case common::FilterKind::kAlwaysTrue:
+    case common::FilterKind::kAlwaysFalse:
+    case common::FilterKind::kIsNull:
+    case common::FilterKind::kIsNotNull:
+      return filter;
+    case common::FilterKind::kTimestampRange: {
+      auto* range = static_cast<const common::TimestampRange*>(filter);
+      const auto lower = toUnits(range->lower(), unitsPerSecond_, true);
+      const auto upper = toUnits(range->upper(), unitsPerSecond_, false);
+      if (lower > upper) {
+        // No value in the unit of the column is in the range.
+        if (filter->nullAllowed()) {
+          encodedFilter_ = std::make_unique<common::IsNull>();
+        } else {
+          encodedFilter_ = std::make_unique<common::AlwaysFalse>();
+        }
+      } else {
+        encodedFilter_ = std::make_unique<common::BigintRange>(
+            lower, upper, filter->nullAllowed());
+      }
+      return encodedFilter_.get();
+    }
+    default:
+      VELOX_UNSUPPORTED(
+          "Unsupported filter on Parquet timestamp column {}: {}",
+          static_cast<const ParquetTypeWithId&>(*fileType_).name_,
+          filter->toString());
+  }
+}
+
+void TimestampColumnReader::read(
+    vector_size_t offset,
+    RowSet rows,
+    const uint64_t* /*incomingNulls*/) {
+  prepareRead<int64_t>(offset, rows, nullptr);
+  auto* filter = encodedFilter();
+  const bool isDense = rows.back() == rows.size() - 1;
+  if (scanSpec_->keepValues()) {
+    dwio::common::ExtractToReader extractValues(this);
+    if (isDense) {
+      processFilter<TimestampColumnReader, true>(filter, extractValues, rows);
+    } else {
+      processFilter<TimestampColumnReader, false>(filter, extractValues, rows);
+    }
+  } else {
+    if (isDense) {
+      processFilter<TimestampColumnReader, true>(
+          filter, dwio::common::DropValues(), rows);
+    } else {
+      processFilter<TimestampColumnReader, false>(
+          filter, dwio::common::DropValues(), rows);
+    }
+  }
+  readOffset_ += rows.back() + 1;
+}
+
+void TimestampColumnReader::getValues(RowSet rows, VectorPtr* result) {
+  if (values_) {
+    // The values of null rows are arbitrary integers, which also convert to a
+    // valid Timestamp.
+    auto timestamps =
+        AlignedBuffer::allocate<Timestamp>(numValues_, &memoryPool_);
+    auto* rawTimestamps = timestamps->asMutable<Timestamp>();
+    const auto* encoded = values_->as<int64_t>();
+    switch (unitsPerSecond_) {
+      case 1'000:
+        toTimestamps<1'000>(encoded, numValues_, rawTimestamps);
+        break;
+      case 1'000'000:
+        toTimestamps<1'000'000>(encoded, numValues_, rawTimestamps);
+        break;
+      default:
+        toTimestamps<kNanosPerSecond>(encoded, numValues_, rawTimestamps);
+        break;
+    }
+    values_ = std::move(timestamps);
+    rawValues_ = values_->asMutable<char>();
+    valueSize_ = sizeof(Timestamp);
+  }
+  getFlatValues<Timestamp, Timestamp>(rows, result, requestedType_, true);
+}
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/common/SelectiveIntegerColumnReader.h"
+#include "velox/dwio/parquet/reader/ParquetData.h"
+
+namespace facebook::velox::parquet {
+
+/// Reads INT64 timestamps in milliseconds, microseconds or nanoseconds and
+/// INT96 timestamps. The values are decoded as 64 bit integers in the unit of
+/// the column, INT96 values as nanoseconds, and converted to Timestamp in
+/// getValues(). A TimestampRange filter is translated to a BigintRange on the
+/// integers so that it is evaluated in the decoders and on the dictionary.
+class TimestampColumnReader
+    : public dwio::common::SelectiveIntegerColumnReader {
+ public:
+  TimestampColumnReader(
+      const std::shared_ptr<const dwio::common::TypeWithId>& requestedType,
+      std::shared_ptr<const dwio::common::TypeWithId> dataType,
+      ParquetParams& params,
+      common::ScanSpec& scanSpec);
+
+  bool hasBulkPath() const override {
+    return true;
+  }
+
+  void seekToRowGroup(uint32_t index) override {
+    SelectiveIntegerColumnReader::seekToRowGroup(index);
+    scanState().clear();
+    readOffset_ = 0;
+    formatData_->as<ParquetData>().seekToRowGroup(index);
+  }
+
+  uint64_t skip(uint64_t numValues) override {
+    formatData_->as<ParquetData>().skip(numValues);
+    return numValues;
+  }
+
+  void read(
+      vector_size_t offset,
+      RowSet rows,
+      const uint64_t* /*incomingNulls*/) override;
+
+  void getValues(RowSet rows, VectorPtr* result) override;
+
+  template <typename ColumnVisitor>
+  void readWithVisitor(RowSet /*rows*/, ColumnVisitor visitor) {
+    formatData_->as<ParquetData>().readWithVisitor(visitor);
+  }
+
+ private:
+  // Returns the filter of the scan spec on the encoded integers.
+  common::Filter* encodedFilter();
+
+  // Number of encoded units in a second, e.g. 1'000 for milliseconds.
+  const int64_t unitsPerSecond_;
+
+  // The scan spec filter 'encodedFilter_' was made for.
+  const common::Filter* filter_{nullptr};
+  std::unique_ptr<common::Filter> encodedFilter_;
+};
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+using namespace facebook::velox;
+using namespace facebook::velox::parquet;
+
+namespace {
+void appendVarint(uint64_t value, std::vector<uint8_t>& out) {
+  while (value >= 0x80) {
+    out.push_back((value & 0x7f) | 0x80);
+    value >>= 7;
+  }
+  out.push_back(value);
+}
+
+uint64_t zigzag(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^ (value >> 63);
+}
+
+// Encodes 'values' as DELTA_BINARY_PACKED with blocks of 128 values in 4
+// miniblocks. The deltas are computed in the width of T.
+template <typename T>
+std::vector<uint8_t> encode(const std::vector<int64_t>& values) {
+  using U = std::make_unsigned_t<T>;
+  constexpr int32_t kBlockSize = 128;
+  constexpr int32_t kNumMiniblocks = 4;
+  constexpr int32_t kMiniblockSize = kBlockSize / kNumMiniblocks;
+  std::vector<uint8_t> out;
+  appendVarint(kBlockSize, out);
+  appendVarint(kNumMiniblocks, out);
+  appendVarint(values.size(), out);
+  appendVarint(zigzag(static_cast<T>(values[0])), out);
+  for (auto begin = 1; begin < values.size(); begin += kBlockSize) {
+    const auto end = std::min<int32_t>(begin + kBlockSize, values.size());
+    std::vector<U> deltas;
+    for (auto i = begin; i < end; ++i) {
+      deltas.push_back(
+          static_cast<U>(values[i]) - static_cast<U>(values[i - 1]));
+    }
+    const U minDelta = *std::min_element(
+        deltas.begin(), deltas.end(), [](auto left, auto right) {
+          return static_cast<T>(left) < static_cast<T>(right);
+        });
+    appendVarint(zigzag(static_cast<T>(minDelta)), out);
+    const auto widthOffset = out.size();
+    out.resize(out.size() + kNumMiniblocks, 0);
+    for (auto first = 0; first < deltas.size(); first += kMiniblockSize) {
+      const auto last =
+          std::min<int32_t>(first + kMiniblockSize, deltas.size());
+      uint64_t maxDelta = 0;
+      for (auto i = first; i < last; ++i) {
+        maxDelta = std::max<uint64_t>(maxDelta, U(deltas[i] - minDelta));
+      }
+      const int32_t width = maxDelta ? 64 - __builtin_clzll(maxDelta) : 0;
+      out[widthOffset + first / kMiniblockSize] = width;
+      const auto bitOffset = out.size() * 8;
+      out.resize(out.size() + kMiniblockSize * width / 8, 0);
+      for (auto i = first; i < last; ++i) {
+        const uint64_t delta = U(deltas[i] - minDelta);
+        for (auto bit = 0; bit < width; ++bit) {
+          if ((delta >> bit) & 1) {
+            const auto position = bitOffset + (i - first) * width + bit;
+            out[position / 8] |= 1 << (position % 8);
+          }
+        }
+      }
+    }
+  }
+  return out;
+}
+
+template <typename T>
+void testRoundTrip(const std::vector<int64_t>& values) {
+  auto encoded = encode<T>(values);
+  // Data after the values must not be consumed.
+  encoded.push_back(0xff);
+  const auto* begin = reinterpret_cast<const char*>(encoded.data());
+  raw_vector<T> decoded;
+  const auto* end =
+      decodeDeltaBinaryPacked<T>(begin, begin + encoded.size(), decoded);
+  EXPECT_EQ(end, begin + encoded.size() - 1);
+  ASSERT_EQ(decoded.size(), values.size());
+  for (auto i = 0; i < values.size(); ++i) {
+    ASSERT_EQ(decoded[i], static_cast<T>(values[i])) << "at " << i;
+  }
+}
+} // namespace
+
+TEST(DeltaBpDecoderTest, specExample) {
+  // 7, 5, 3, 1, 2, 3, 4, 5 from the Parquet encodings spec.
+  const std::vector<uint8_t> encoded = {
+      128, 1, 4, 8, 14, 3, 2, 0, 0, 0, 192, 63, 0, 0, 0, 0, 0, 0};
+  const auto* begin = reinterpret_cast<const char*>(encoded.data());
+  raw_vector<int32_t> values;
+  const auto* end =
+      decodeDeltaBinaryPacked<int32_t>(begin, begin + encoded.size(), values);
+  EXPECT_EQ(end, begin + encoded.size());
+  EXPECT_EQ(
+      std::vector<int32_t>(values.begin(), values.end()),
+      (std::vector<int32_t>{7, 5, 3, 1, 2, 3, 4, 5}));
+}
+
+TEST(DeltaBpDecoderTest, roundTrip) {
+  std::mt19937 rng(1);
+  // Single value, constant deltas, narrow and wide deltas over several blocks.
+  testRoundTrip<int32_t>({42});
+  std::vector<int64_t> values;
+  for (auto i = 0; i < 300; ++i) {
+    values.push_back(i * 3);
+  }
+  testRoundTrip<int32_t>(values);
+  values.clear();
+  for (auto i = 0; i < 1'000; ++i) {
+    values.push_back(static_cast<int32_t>(rng()) >> (i % 31));
+  }
+  testRoundTrip<int32_t>(values);
+  values.clear();
+  for (auto i = 0; i < 1'000; ++i) {
+    values.push_back(
+        static_cast<int64_t>((static_cast<uint64_t>(rng()) << 32) | rng()) >>
+        (i % 63));
+  }
+  testRoundTrip<int64_t>(values);
+}
@@ -14,23 +14,31 @@
  * limitations under the License.
  */
 
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/testutil/TestValue.h"
 #include "velox/dwio/common/tests/E2EFilterTestBase.h"
+#include "velox/dwio/parquet/reader/PageReader.h"
 #include "velox/dwio/parquet/reader/ParquetReader.h"
+#include "velox/dwio/parquet/writer/NativeWriter.h"
 #include "velox/dwio/parquet/writer/Writer.h"
 
 #include <folly/init/Init.h>
 
+DECLARE_bool(parquet_use_dictionary_filter);
+
 using namespace facebook::velox;
 using namespace facebook::velox::common;
 using namespace facebook::velox::dwio::common;
 using namespace facebook::velox::parquet;
 
 using dwio::common::MemorySink;
+using facebook::velox::common::testutil::TestValue;
 
 class E2EFilterTest : public E2EFilterTestBase {
  protected:
   void SetUp() override {
     E2EFilterTestBase::SetUp();
+    TestValue::enable();
   }
 
   void testWithTypes(
@@ -70,8 +78,12 @@ class E2EFilterTest : public E2EFilterTestBase {
           });
     };
 
-    writer_ = std::make_unique<facebook::velox::parquet::Writer>(
-        std::move(sink), options_);
+    if (useNativeWriter_) {
+      writer_ = std::make_unique<NativeWriter>(std::move(sink), options_);
+    } else {
+      writer_ = std::make_unique<facebook::velox::parquet::Writer>(
+          std::move(sink), options_);
+    }
     for (auto& batch : batches) {
       writer_->write(batch);
     }
@@ -85,8 +97,89 @@ class E2EFilterTest : public E2EFilterTestBase {
     return std::make_unique<ParquetReader>(std::move(input), opts);
   }
 
-  std::unique_ptr<facebook::velox::parquet::Writer> writer_;
+  // Writes row groups of 'rowsInRowGroup_' rows with a bigint column "k" of
+  // 2 * row and a varchar column "v" of 'makeValue(row)'.
+  void writeKeysAndValues(
+      int32_t numRows,
+      std::function<std::string(int32_t)> makeValue) {
+    rowType_ = ROW({"k", "v"}, {BIGINT(), VARCHAR()});
+    std::vector<RowVectorPtr> batches;
+    for (auto start = 0; start < numRows; start += rowsInRowGroup_) {
+      const auto size = std::min<int32_t>(rowsInRowGroup_, numRows - start);
+      auto keys = BaseVector::create<FlatVector<int64_t>>(
+          BIGINT(), size, leafPool_.get());
+      auto values = BaseVector::create<FlatVector<StringView>>(
+          VARCHAR(), size, leafPool_.get());
+      for (auto i = 0; i < size; ++i) {
+        keys->set(i, 2 * (start + i));
+        const auto value = makeValue(start + i);
+        values->set(i, StringView(value));
+      }
+      batches.push_back(std::make_shared<RowVector>(
+          leafPool_.get(),
+          rowType_,
+          nullptr,
+          size,
+          std::vector<VectorPtr>{keys, values}));
+    }
+    writeToMemory(rowType_, batches, true);
+  }
+
+  // Reads the data written by writeKeysAndValues() with 'filter' on "k" and
+  // returns the values of "v" in the rows that pass. "v" has no filter, so it
+  // is loaded lazily for the passing rows only.
+  std::vector<std::string> readValues(std::unique_ptr<Filter> filter) {
+    auto spec = std::make_shared<ScanSpec>("<root>");
+    spec->addAllChildFields(*rowType_);
+    if (filter) {
+      spec->childByName("k")->setFilter(std::move(filter));
+    }
+    dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+    std::string_view data(sinkPtr_->data(), sinkPtr_->size());
+    auto input = std::make_unique<BufferedInput>(
+        std::make_shared<InMemoryReadFile>(data), readerOpts.getMemoryPool());
+    auto reader = makeReader(readerOpts, std::move(input));
+    dwio::common::RowReaderOptions rowReaderOpts;
+    setUpRowReaderOptions(rowReaderOpts, spec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+
+    std::vector<std::string> values;
+    auto result = BaseVector::create(rowType_, 0, leafPool_.get());
+    while (rowReader->next(1'000, result)) {
+      auto* strings = result->as<RowVector>()
+                          ->childAt(1)
+                          ->loadedVector()
+                          ->as<SimpleVector<StringView>>();
+      for (auto i = 0; i < strings->size(); ++i) {
+        values.push_back(std::string(strings->valueAt(i)));
+      }
+    }
+    return values;
+  }
+
+  // Checks that "v" is read correctly for all rows and for every 7th row.
+  void testReadValues(
+      int32_t numRows,
+      std::function<std::string(int32_t)> makeValue) {
+    writeKeysAndValues(numRows, makeValue);
+    std::vector<std::string> expected;
+    for (auto i = 0; i < numRows; ++i) {
+      expected.push_back(makeValue(i));
+    }
+    EXPECT_EQ(expected, readValues(nullptr));
+
+    std::vector<int64_t> keys;
+    expected.clear();
+    for (auto i = 0; i < numRows; i += 7) {
+      keys.push_back(2 * i);
+      expected.push_back(makeValue(i));
+    }
+    EXPECT_EQ(expected, readValues(createBigintValues(keys, false)));
+  }
+
+  std::unique_ptr<dwio::common::Writer> writer_;
   facebook::velox::parquet::WriterOptions options_;
+  bool useNativeWriter_{false};
   uint64_t rowsInRowGroup_ = 10'000;
   int64_t bytesInRowGroup_ = 128 * 1'024 * 1'024;
 };
@@ -615,6 +708,281 @@ TEST_F(E2EFilterTest, combineRowGroup) {
   EXPECT_EQ(parquetReader.numberOfRows(), 5);
 }
 
+TEST(ParquetFlushPolicyTest, fileSizeAndMemoryCap) {
+  RowGroupSizeEstimator estimator;
+  // Without a written row group the buffered size is the estimate.
+  EXPECT_EQ(estimator.estimateFileBytes(1'000), 1'000);
+  estimator.recordRowGroup(0, 100);
+  EXPECT_EQ(estimator.estimateFileBytes(1'000), 1'000);
+  estimator.recordRowGroup(4'000, 1'000);
+  EXPECT_EQ(estimator.estimateFileBytes(1'000), 250);
+  estimator.recordRowGroup(4'000, 3'000);
+  EXPECT_EQ(estimator.estimateFileBytes(1'000), 500);
+
+  auto progress = [](uint64_t rows, int64_t memory, int64_t fileBytes) {
+    return StripeProgress{
+        .stripeRowCount = rows,
+        .totalMemoryUsage = memory,
+        .stripeSizeEstimate = fileBytes};
+  };
+  DefaultFlushPolicy policy(1'000, 100, 1'000);
+  EXPECT_EQ(policy.maxBufferedBytes(), 1'000);
+  EXPECT_FALSE(policy.shouldFlush(progress(10, 999, 99)));
+  EXPECT_TRUE(policy.shouldFlush(progress(1'000, 0, 0)));
+  EXPECT_TRUE(policy.shouldFlush(progress(10, 999, 100)));
+  EXPECT_TRUE(policy.shouldFlush(progress(10, 1'000, 0)));
+
+  EXPECT_EQ(DefaultFlushPolicy(10, 100).maxBufferedBytes(), 400);
+  EXPECT_EQ(
+      DefaultFlushPolicy(10, std::numeric_limits<int64_t>::max())
+          .maxBufferedBytes(),
+      std::numeric_limits<int64_t>::max());
+}
+
+TEST_F(E2EFilterTest, nativeWriterIntegerAndFloat) {
+  useNativeWriter_ = true;
+  for (auto enableDictionary : {true, false}) {
+    options_.enableDictionary = enableDictionary;
+    options_.dataPageSize = 4 * 1024;
+    testWithTypes(
+        "boolean_val:boolean,"
+        "tiny_val:tinyint,"
+        "short_val:smallint,"
+        "int_val:int,"
+        "long_val:bigint,"
+        "float_val:float,"
+        "double_val:double,"
+        "long_null:bigint",
+        [&]() {
+          makeAllNulls("long_null");
+          makeIntDistribution<int64_t>(
+              "long_val", 10, 100, 22, 19, -999, 3000, true);
+          makeQuantizedFloat<double>("double_val", 522, true);
+        },
+        false,
+        {"short_val", "int_val", "long_val", "float_val", "double_val"},
+        20);
+  }
+}
+
+TEST_F(E2EFilterTest, nativeWriterString) {
+  useNativeWriter_ = true;
+  testWithTypes(
+      "string_val:string,"
+      "string_val_2:string,"
+      "string_const: string",
+      [&]() {
+        makeStringDistribution("string_val", 100, true, false);
+        makeStringDistribution("string_val_2", 170, false, true);
+        makeStringDistribution("string_const", 1, true, false);
+      },
+      false,
+      {"string_val", "string_val_2"},
+      20);
+}
+
+TEST_F(E2EFilterTest, nativeWriterDedictionarize) {
+  // Dictionaries that outgrow the limit fall back to plain pages in the
+  // middle of the column chunk.
+  useNativeWriter_ = true;
+  options_.dictionaryPageSizeLimit = 20'000;
+  options_.enableBloomFilter = true;
+  testWithTypes(
+      "long_val: bigint,"
+      "string_val:string,"
+      "string_val_2:string",
+      [&]() {
+        makeStringDistribution("string_val", 10000000, true, false);
+        makeStringDistribution("string_val_2", 1700000, false, true);
+      },
+      false,
+      {"long_val", "string_val", "string_val_2"},
+      20);
+}
+
+TEST_F(E2EFilterTest, nativeWriterDictionaryFilter) {
+  // Few distinct values per row group, so that filters on values outside of
+  // the dictionary skip row groups without reading the data pages.
+  useNativeWriter_ = true;
+  for (const bool useDictionaryFilter : {false, true}) {
+    SCOPED_TRACE(fmt::format("useDictionaryFilter={}", useDictionaryFilter));
+    FLAGS_parquet_use_dictionary_filter = useDictionaryFilter;
+    testWithTypes(
+        "int_val:int,"
+        "long_val:bigint,"
+        "string_val:string",
+        [&]() {
+          makeIntDistribution<int32_t>(
+              "int_val", 10, 20, 22, 19, -999, 30000, true);
+          makeIntDistribution<int64_t>(
+              "long_val", 100, 110, 22, 19, -999, 30000, true);
+          makeStringDistribution("string_val", 50, true, false);
+        },
+        false,
+        {"int_val", "long_val", "string_val"},
+        20);
+  }
+  FLAGS_parquet_use_dictionary_filter = true;
+}
+
+TEST_F(E2EFilterTest, nativeWriterCompression) {
+  useNativeWriter_ = true;
+  for (const auto compression :
+       {common::CompressionKind_SNAPPY,
+        common::CompressionKind_ZSTD,
+        common::CompressionKind_GZIP}) {
+    options_.compression = compression;
+    testWithTypes(
+        "short_val:smallint,"
+        "int_val:int,"
+        "long_val:bigint",
+        [&]() {},
+        false,
+        {"short_val", "int_val", "long_val"},
+        3);
+  }
+}
+
+TEST_F(E2EFilterTest, nativeWriterDate) {
+  useNativeWriter_ = true;
+  testWithTypes(
+      "date_val:date",
+      [&]() {
+        makeIntDistribution<int32_t>(
+            "date_val", 10, 100, 22, 19, -999, 30000, true);
+      },
+      false,
+      {"date_val"},
+      20);
+}
+
+TEST_F(E2EFilterTest, nativeWriterTimestamp) {
+  useNativeWriter_ = true;
+  testWithTypes(
+      "timestamp_val:timestamp,"
+      "timestamp_null:timestamp,"
+      "long_val:bigint",
+      [&]() { makeAllNulls("timestamp_null"); },
+      false,
+      {"long_val"},
+      20);
+}
+
+TEST_F(E2EFilterTest, timestampRangeFilter) {
+  // Row i is i seconds and i microseconds after the epoch and every tenth row
+  // is null.
+  constexpr int32_t kNumRows = 10'000;
+  useNativeWriter_ = true;
+  options_.dataPageSize = 4 * 1024;
+  rowType_ = ROW({"ts"}, {TIMESTAMP()});
+  auto timestamps = BaseVector::create<FlatVector<Timestamp>>(
+      TIMESTAMP(), kNumRows, leafPool_.get());
+  for (auto i = 0; i < kNumRows; ++i) {
+    if (i % 10 == 0) {
+      timestamps->setNull(i, true);
+    } else {
+      timestamps->set(i, Timestamp(i, i * 1'000));
+    }
+  }
+  std::vector<RowVectorPtr> batches{std::make_shared<RowVector>(
+      leafPool_.get(),
+      rowType_,
+      nullptr,
+      kNumRows,
+      std::vector<VectorPtr>{timestamps})};
+
+  for (auto enableDictionary : {true, false}) {
+    SCOPED_TRACE(fmt::format("enableDictionary={}", enableDictionary));
+    options_.enableDictionary = enableDictionary;
+    writeToMemory(rowType_, batches, false);
+    auto spec = std::make_shared<ScanSpec>("<root>");
+    spec->addAllChildFields(*rowType_);
+    spec->childByName("ts")->setFilter(std::make_unique<TimestampRange>(
+        Timestamp(1'000, 500'000), Timestamp(2'000, 2'000'000), false));
+
+    dwio::common::ReaderOptions readerOpts{leafPool_.get()};
+    std::string_view data(sinkPtr_->data(), sinkPtr_->size());
+    auto input = std::make_unique<BufferedInput>(
+        std::make_shared<InMemoryReadFile>(data), readerOpts.getMemoryPool());
+    auto reader = makeReader(readerOpts, std::move(input));
+    dwio::common::RowReaderOptions rowReaderOpts;
+    setUpRowReaderOptions(rowReaderOpts, spec);
+    auto rowReader = reader->createRowReader(rowReaderOpts);
+
+    // The rows from 1000 to 2000 that are not null pass.
+    std::vector<Timestamp> expected;
+    for (auto i = 1'000; i <= 2'000; ++i) {
+      if (i % 10 != 0) {
+        expected.push_back(Timestamp(i, i * 1'000));
+      }
+    }
+    std::vector<Timestamp> actual;
+    auto result = BaseVector::create(rowType_, 0, leafPool_.get());
+    while (rowReader->next(1'000, result)) {
+      auto* values = result->as<RowVector>()
+                         ->childAt(0)
+                         ->loadedVector()
+                         ->as<SimpleVector<Timestamp>>();
+      for (auto i = 0; i < values->size(); ++i) {
+        ASSERT_FALSE(values->isNullAt(i));
+        actual.push_back(values->valueAt(i));
+      }
+    }
+    EXPECT_EQ(expected, actual);
+  }
+}
+
+DEBUG_ONLY_TEST_F(E2EFilterTest, dictionaryOfSkippedChunkNotDecoded) {
+  // Two row groups with dictionary encoded "k" and "v". The filter on "k"
+  // passes the first row group by statistics but no row passes in the second,
+  // so that no row is read from the second chunk of "v".
+  rowsInRowGroup_ = 1'000;
+  writeKeysAndValues(2'000, [](auto row) {
+    return fmt::format("dictionary value {}", row % 10);
+  });
+  int32_t numDecoded = 0;
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::parquet::PageReader::prepareDictionary",
+      std::function<void(PageReader*)>(
+          [&](PageReader* /*reader*/) { ++numDecoded; }));
+  FLAGS_parquet_use_dictionary_filter = false;
+  EXPECT_EQ(
+      std::vector<std::string>{"dictionary value 5"},
+      readValues(createBigintValues({10, 2'501}, false)));
+  FLAGS_parquet_use_dictionary_filter = true;
+  // The dictionaries of both chunks of "k" and of the first chunk of "v".
+  EXPECT_EQ(3, numDecoded);
+}
+
+TEST_F(E2EFilterTest, dictionaryFallbackToPlain) {
+  // The dictionary of "v" fills up after a few pages and the rest of the
+  // chunk is PLAIN encoded.
+  rowsInRowGroup_ = 5'000;
+  options_.dictionaryPageSizeLimit = 2'000;
+  options_.dataPageSize = 1'024;
+  testReadValues(10'000, [](auto row) {
+    return fmt::format("unique value number {}", row);
+  });
+}
+
+TEST_F(E2EFilterTest, dictionaryCompression) {
+  rowsInRowGroup_ = 5'000;
+  options_.dataPageSize = 1'024;
+  for (const auto compression :
+       {common::CompressionKind_NONE,
+        common::CompressionKind_SNAPPY,
+        common::CompressionKind_ZSTD}) {
+    if (!facebook::velox::parquet::Writer::isCodecAvailable(compression)) {
+      continue;
+    }
+    SCOPED_TRACE(compressionKindToString(compression));
+    options_.compression = compression;
+    testReadValues(10'000, [](auto row) {
+      return fmt::format("dictionary value {}", row % 100);
+    });
+  }
+}
+
 // Define main so that gflags get processed.
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
@@ -64,12 +64,10 @@ class NestedStructureDecoderBenchmark {
   }
 };
 
-BENCHMARK(randomDefs) {
+void decodeRandomDefs(uint16_t maxDefinition, uint16_t maxRepetition) {
   folly::BenchmarkSuspender suspender;
 
   auto numValues = 1'000'000;
-  auto maxDefinition = 9;
-  auto maxRepetition = 4;
 
   NestedStructureDecoderBenchmark benchmark(numValues);
   benchmark.setUp(maxDefinition, maxRepetition);
@@ -90,6 +88,24 @@ BENCHMARK(randomDefs) {
   folly::doNotOptimizeAway(numCollections);
 }
 
+BENCHMARK(randomDefs) {
+  decodeRandomDefs(9, 4);
+}
+
+// Levels of a column nested 'depth' lists deep, with nullable lists and
+// elements, range over [0, 2 * depth + 1) for definition and [0, depth + 1)
+// for repetition.
+void decodeAtDepth(uint32_t iters, uint16_t depth) {
+  for (uint32_t i = 0; i < iters; ++i) {
+    decodeRandomDefs(2 * depth + 1, depth + 1);
+  }
+}
+
+BENCHMARK_NAMED_PARAM(decodeAtDepth, depth1, 1);
+BENCHMARK_NAMED_PARAM(decodeAtDepth, depth2, 2);
+BENCHMARK_NAMED_PARAM(decodeAtDepth, depth4, 4);
+BENCHMARK_NAMED_PARAM(decodeAtDepth, depth8, 8);
+
 int main(int /*argc*/, char** /*argv*/) {
   folly::runBenchmarks();
   return 0;
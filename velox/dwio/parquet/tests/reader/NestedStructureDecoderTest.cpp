@@ -263,3 +263,40 @@ TEST_F(NestedStructureDecoderTest, emptyRowAtEnd) {
   assertStructure(
       defs, reps, 4, 3, 2, expectedOffsets, expectedLengths, expectedNulls);
 }
+
+// ------------------------
+// ARRAY<INTEGER> with enough rows for the nulls to span several words.
+// Every third row is NULL, the others have 1 to 4 elements.
+TEST_F(NestedStructureDecoderTest, oneLevelManyRows) {
+  constexpr int32_t kNumRows = 200;
+  std::vector<uint8_t> defs;
+  std::vector<uint8_t> reps;
+  std::vector<vector_size_t> expectedOffsets({0});
+  std::vector<vector_size_t> expectedLengths;
+  std::vector<bool> expectedNulls;
+  for (auto row = 0; row < kNumRows; ++row) {
+    const bool isNull = row % 3 == 0;
+    const int32_t length = isNull ? 0 : row % 4 + 1;
+    if (isNull) {
+      defs.push_back(0);
+      reps.push_back(0);
+    }
+    for (auto i = 0; i < length; ++i) {
+      defs.push_back(3);
+      reps.push_back(i == 0 ? 0 : 1);
+    }
+    expectedOffsets.push_back(expectedOffsets.back() + length);
+    expectedLengths.push_back(length);
+    expectedNulls.push_back(isNull);
+  }
+
+  assertStructure(
+      defs.data(),
+      reps.data(),
+      defs.size(),
+      1,
+      1,
+      expectedOffsets,
+      expectedLengths,
+      expectedNulls);
+}
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include "velox/dwio/parquet/reader/BloomFilter.h"
 #include "velox/dwio/parquet/reader/ParquetReader.h"
 #include "velox/dwio/parquet/tests/ParquetReaderTestBase.h"
 #include "velox/expression/ExprToSubfieldFilter.h"
@@ -630,3 +631,81 @@ TEST_F(ParquetReaderTest, preloadSmallFile) {
     ASSERT_EQ(file->bytesRead(), 0);
   }
 }
+
+TEST_F(ParquetReaderTest, filterPagesByColumnIndex) {
+  // Four pages of 100 rows with values 0-99, 100-199, 200-299 and nulls.
+  auto encode = [](int64_t value) {
+    return std::string(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+  thrift::ColumnIndex columnIndex;
+  thrift::OffsetIndex offsetIndex;
+  for (auto i = 0; i < 4; ++i) {
+    const bool nullPage = i == 3;
+    columnIndex.null_pages.push_back(nullPage);
+    columnIndex.min_values.push_back(nullPage ? "" : encode(i * 100));
+    columnIndex.max_values.push_back(nullPage ? "" : encode(i * 100 + 99));
+    columnIndex.null_counts.push_back(nullPage ? 100 : 0);
+    thrift::PageLocation location;
+    location.__set_first_row_index(i * 100);
+    offsetIndex.page_locations.push_back(location);
+  }
+  columnIndex.__isset.null_counts = true;
+
+  auto skippedRows = [&](std::unique_ptr<Filter> filter) {
+    std::vector<RowRange> ranges;
+    ParquetData::filterPages(
+        filter.get(), BIGINT(), columnIndex, offsetIndex, 400, ranges);
+    std::vector<std::pair<int64_t, int64_t>> result;
+    for (auto& range : ranges) {
+      result.emplace_back(range.begin, range.end);
+    }
+    return result;
+  };
+  using Ranges = std::vector<std::pair<int64_t, int64_t>>;
+  EXPECT_EQ(
+      skippedRows(exec::between(120, 250)), (Ranges{{0, 100}, {300, 400}}));
+  EXPECT_EQ(skippedRows(exec::equal(50)), (Ranges{{100, 400}}));
+  EXPECT_EQ(skippedRows(exec::isNull()), (Ranges{{0, 300}}));
+  EXPECT_EQ(skippedRows(exec::between(0, 299)), (Ranges{{300, 400}}));
+
+  // Without null counts a null page is still known to have only nulls.
+  columnIndex.__isset.null_counts = false;
+  columnIndex.null_counts.clear();
+  EXPECT_EQ(skippedRows(exec::isNull()), Ranges{});
+  EXPECT_EQ(skippedRows(exec::equal(350)), (Ranges{{0, 400}}));
+}
+
+TEST_F(ParquetReaderTest, bloomFilter) {
+  // A large bitset makes false positives for the few values unlikely.
+  constexpr int32_t kNumBytes = 64 << 10;
+  std::vector<uint32_t> bitset(kNumBytes / sizeof(uint32_t));
+  SplitBlockBloomFilter bloomFilter(bitset.data(), kNumBytes);
+  for (int64_t i = 1; i <= 10; ++i) {
+    bloomFilter.insert(SplitBlockBloomFilter::hash(&i, sizeof(i)));
+    const auto id = fmt::format("id-{}", i);
+    bloomFilter.insert(SplitBlockBloomFilter::hash(id.data(), id.size()));
+  }
+  const int32_t narrow = 20;
+  bloomFilter.insert(SplitBlockBloomFilter::hash(&narrow, sizeof(narrow)));
+
+  auto test = [&](const Filter& filter, thrift::Type::type type) {
+    return testFilter(filter, type, bloomFilter);
+  };
+  EXPECT_TRUE(test(*exec::equal(5), thrift::Type::INT64));
+  EXPECT_FALSE(test(*exec::equal(50), thrift::Type::INT64));
+  EXPECT_FALSE(test(*exec::equal(5), thrift::Type::INT32));
+  EXPECT_TRUE(test(*exec::equal(20), thrift::Type::INT32));
+  EXPECT_FALSE(test(*exec::equal(1LL << 40), thrift::Type::INT32));
+  EXPECT_TRUE(test(*exec::in({30, 40, 7}), thrift::Type::INT64));
+  EXPECT_FALSE(test(*exec::in({30, 40, 50}), thrift::Type::INT64));
+  // Filters that pass nulls or ranges cannot be tested.
+  EXPECT_TRUE(test(*exec::equal(50, true), thrift::Type::INT64));
+  EXPECT_TRUE(test(*exec::between(50, 60), thrift::Type::INT64));
+
+  EXPECT_TRUE(test(*exec::equal("id-3"), thrift::Type::BYTE_ARRAY));
+  EXPECT_FALSE(test(*exec::equal("id-30"), thrift::Type::BYTE_ARRAY));
+  EXPECT_TRUE(test(*exec::in({"x", "id-10"}), thrift::Type::BYTE_ARRAY));
+  EXPECT_FALSE(test(*exec::in({"x", "y"}), thrift::Type::BYTE_ARRAY));
+  // A string filter on an integer column is not tested.
+  EXPECT_TRUE(test(*exec::in({"x", "y"}), thrift::Type::INT64));
+}
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FileSink.h"
+#include "velox/dwio/common/tests/utils/DataSetBuilder.h"
+#include "velox/dwio/parquet/writer/NativeWriter.h"
+#include "velox/dwio/parquet/writer/Writer.h"
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+using namespace facebook::velox;
+using namespace facebook::velox::dwio::common;
+using namespace facebook::velox::test;
+
+namespace {
+
+constexpr uint32_t kNumBatches = 50;
+constexpr uint32_t kNumRows = 10'000;
+
+// Compares the Arrow based Parquet writer with NativeWriter on the same
+// batches.
+class ParquetWriterBenchmark {
+ public:
+  ParquetWriterBenchmark() {
+    rootPool_ =
+        memory::defaultMemoryManager().addRootPool("ParquetWriterBenchmark");
+    leafPool_ = rootPool_->addLeafChild("ParquetWriterBenchmark");
+  }
+
+  std::vector<RowVectorPtr> makeBatches(const TypePtr& type, bool dictionary) {
+    auto rowType = ROW({"c0"}, {type});
+    DataSetBuilder builder(*leafPool_, 0);
+    builder.makeDataset(rowType, kNumBatches, kNumRows)
+        .withNullsForField(common::Subfield("c0"), 10);
+    if (type->isVarchar()) {
+      builder.withStringDistributionForField(
+          common::Subfield("c0"), 1'000, true, false);
+    }
+    auto batches = std::move(*builder.build());
+    if (!dictionary) {
+      return batches;
+    }
+    // Wraps the first 1000 rows of each batch in a dictionary with repeated
+    // indices, as an aggregation or join output would be.
+    for (auto& batch : batches) {
+      auto indices = allocateIndices(kNumRows, leafPool_.get());
+      auto* rawIndices = indices->asMutable<vector_size_t>();
+      for (auto i = 0; i < kNumRows; ++i) {
+        rawIndices[i] = (i * 7) % 1'000;
+      }
+      auto wrapped = BaseVector::wrapInDictionary(
+          nullptr, indices, kNumRows, batch->childAt(0));
+      batch = std::make_shared<RowVector>(
+          leafPool_.get(),
+          rowType,
+          nullptr,
+          kNumRows,
+          std::vector<VectorPtr>{wrapped});
+    }
+    return batches;
+  }
+
+  void write(
+      const std::vector<RowVectorPtr>& batches,
+      bool native,
+      bool enableDictionary) {
+    auto sink = std::make_unique<MemorySink>(
+        200 * 1024 * 1024, FileSink::Options{.pool = leafPool_.get()});
+    parquet::WriterOptions options;
+    options.enableDictionary = enableDictionary;
+    options.memoryPool = rootPool_.get();
+    std::unique_ptr<Writer> writer;
+    if (native) {
+      writer =
+          std::make_unique<parquet::NativeWriter>(std::move(sink), options);
+    } else {
+      writer = std::make_unique<parquet::Writer>(std::move(sink), options);
+    }
+    for (auto& batch : batches) {
+      writer->write(batch);
+    }
+    writer->close();
+  }
+
+ private:
+  std::shared_ptr<memory::MemoryPool> rootPool_;
+  std::shared_ptr<memory::MemoryPool> leafPool_;
+};
+
+void run(
+    uint32_t,
+    const TypePtr& type,
+    bool native,
+    bool enableDictionary,
+    bool dictionaryInput) {
+  std::vector<RowVectorPtr> batches;
+  ParquetWriterBenchmark benchmark;
+  BENCHMARK_SUSPEND {
+    batches = benchmark.makeBatches(type, dictionaryInput);
+  }
+  benchmark.write(batches, native, enableDictionary);
+}
+
+} // namespace
+
+#define PARQUET_WRITER_BENCHMARK(_type_, _name_, _native_, _dict_, _input_) \
+  BENCHMARK_NAMED_PARAM(run, _name_, _type_, _native_, _dict_, _input_);
+
+#define PARQUET_WRITER_RELATIVE_BENCHMARK(                               \
+    _type_, _name_, _native_, _dict_, _input_)                           \
+  BENCHMARK_RELATIVE_NAMED_PARAM(                                        \
+      run, _name_, _type_, _native_, _dict_, _input_);
+
+#define PARQUET_WRITER_BENCHMARKS(_type_, _name_, _input_, _inputName_) \
+  PARQUET_WRITER_BENCHMARK(                                             \
+      _type_, _name_##_##_inputName_##_arrow_dict, false, true, _input_) \
+  PARQUET_WRITER_RELATIVE_BENCHMARK(                                    \
+      _type_, _name_##_##_inputName_##_native_dict, true, true, _input_) \
+  PARQUET_WRITER_BENCHMARK(                                             \
+      _type_, _name_##_##_inputName_##_arrow_plain, false, false, _input_) \
+  PARQUET_WRITER_RELATIVE_BENCHMARK(                                    \
+      _type_, _name_##_##_inputName_##_native_plain, true, false, _input_) \
+  BENCHMARK_DRAW_LINE();
+
+PARQUET_WRITER_BENCHMARKS(BIGINT(), BigInt, false, flat);
+PARQUET_WRITER_BENCHMARKS(BIGINT(), BigInt, true, dictionary);
+PARQUET_WRITER_BENCHMARKS(DOUBLE(), Double, false, flat);
+PARQUET_WRITER_BENCHMARKS(DOUBLE(), Double, true, dictionary);
+PARQUET_WRITER_BENCHMARKS(VARCHAR(), Varchar, false, flat);
+PARQUET_WRITER_BENCHMARKS(VARCHAR(), Varchar, true, dictionary);
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
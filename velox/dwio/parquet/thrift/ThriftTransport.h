@@ -18,6 +18,7 @@
 
 #include <thrift/transport/TVirtualTransport.h>
 #include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/DataBuffer.h"
 
 namespace facebook::velox::parquet::thrift {
 
@@ -92,4 +93,21 @@ class ThriftBufferedTransport : public ThriftTransport {
   uint64_t offset_;
 };
 
+/// Appends the bytes written by a thrift protocol to a DataBuffer.
+class ThriftDataBufferTransport
+    : public apache::thrift::transport::TVirtualTransport<
+          ThriftDataBufferTransport> {
+ public:
+  explicit ThriftDataBufferTransport(dwio::common::DataBuffer<char>& buffer)
+      : buffer_(buffer) {}
+
+  void write(const uint8_t* inputBuf, uint32_t len) {
+    buffer_.extendAppend(
+        buffer_.size(), reinterpret_cast<const char*>(inputBuf), len);
+  }
+
+ private:
+  dwio::common::DataBuffer<char>& buffer_;
+};
+
 } // namespace facebook::velox::parquet::thrift
@@ -0,0 +1,755 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/writer/ColumnWriter.h"
+#include "velox/common/base/BitUtil.h"
+
+#include <folly/ScopeGuard.h>
+#include <folly/container/F14Map.h>
+#include <snappy.h>
+#include <zlib.h>
+#include <zstd.h>
+#include <cmath>
+#include <deque>
+
+namespace facebook::velox::parquet {
+
+using dwio::common::DataBuffer;
+
+namespace {
+
+// Bit packed values are written in groups of 8.
+constexpr int32_t kGroupSize = 8;
+
+// Min and max values longer than this are left out of the statistics.
+constexpr int32_t kMaxStatisticsBytes = 4'096;
+
+// Bounds of the size of a Bloom filter.
+constexpr int64_t kMinBloomFilterBytes = SplitBlockBloomFilter::kBytesPerBlock;
+constexpr int64_t kMaxBloomFilterBytes = 128 << 20;
+
+void append(DataBuffer<char>& out, const void* data, uint64_t size) {
+  out.extendAppend(out.size(), reinterpret_cast<const char*>(data), size);
+}
+
+// Empties 'buffer' and keeps its memory. A buffer without memory is empty.
+void reset(DataBuffer<char>& buffer) {
+  if (buffer.capacity() > 0) {
+    buffer.resize(0);
+  }
+}
+
+void appendVarint(DataBuffer<char>& out, uint64_t value) {
+  while (value >= 0x80) {
+    out.append(static_cast<char>(value | 0x80));
+    value >>= 7;
+  }
+  out.append(static_cast<char>(value));
+}
+
+// Appends the low 'bitWidth' bits of each of 'numValues' values, least
+// significant bit first, padded with zero bits to a whole byte.
+void bitPack(
+    const uint32_t* values,
+    int32_t numValues,
+    int32_t bitWidth,
+    DataBuffer<char>& out) {
+  uint64_t buffer = 0;
+  int32_t numBits = 0;
+  for (auto i = 0; i < numValues; ++i) {
+    buffer |= static_cast<uint64_t>(values[i]) << numBits;
+    numBits += bitWidth;
+    while (numBits >= 8) {
+      out.append(static_cast<char>(buffer));
+      buffer >>= 8;
+      numBits -= 8;
+    }
+  }
+  if (numBits > 0) {
+    out.append(static_cast<char>(buffer));
+  }
+}
+
+// Appends 'values' in the RLE/bit packed hybrid encoding. Runs of at least a
+// group of equal values are run length encoded and the rest is bit packed in
+// groups of 8.
+void encodeRleBp(
+    const std::vector<uint32_t>& values,
+    int32_t bitWidth,
+    DataBuffer<char>& out) {
+  const int32_t numValues = values.size();
+  const int32_t valueBytes = (bitWidth + 7) / 8;
+  auto runLength = [&](int32_t begin) {
+    auto end = begin + 1;
+    while (end < numValues && values[end] == values[begin]) {
+      ++end;
+    }
+    return end - begin;
+  };
+
+  int32_t i = 0;
+  while (i < numValues) {
+    const auto run = runLength(i);
+    if (run >= kGroupSize) {
+      appendVarint(out, static_cast<uint64_t>(run) << 1);
+      append(out, &values[i], valueBytes);
+      i += run;
+      continue;
+    }
+    // Bit packs groups until a run starts at a group boundary.
+    const auto begin = i;
+    do {
+      i += kGroupSize;
+    } while (i < numValues && runLength(i) < kGroupSize);
+    const auto numGroups = (i - begin) / kGroupSize;
+    appendVarint(out, (static_cast<uint64_t>(numGroups) << 1) | 1);
+    const auto end = std::min(i, numValues);
+    const auto packedBytes = out.size();
+    bitPack(values.data() + begin, end - begin, bitWidth, out);
+    // The last group is padded with zeros.
+    const auto paddedSize = packedBytes + numGroups * bitWidth;
+    while (out.size() < paddedSize) {
+      out.append(0);
+    }
+  }
+}
+
+thrift::CompressionCodec::type toThriftCodec(common::CompressionKind kind) {
+  switch (kind) {
+    case common::CompressionKind_NONE:
+      return thrift::CompressionCodec::UNCOMPRESSED;
+    case common::CompressionKind_SNAPPY:
+      return thrift::CompressionCodec::SNAPPY;
+    case common::CompressionKind_ZSTD:
+      return thrift::CompressionCodec::ZSTD;
+    case common::CompressionKind_GZIP:
+      return thrift::CompressionCodec::GZIP;
+    default:
+      VELOX_UNSUPPORTED(
+          "Unsupported compression in native Parquet writer: {}",
+          common::compressionKindToString(kind));
+  }
+}
+
+void compress(
+    thrift::CompressionCodec::type codec,
+    const char* data,
+    uint64_t size,
+    DataBuffer<char>& out) {
+  switch (codec) {
+    case thrift::CompressionCodec::SNAPPY: {
+      out.resize(snappy::MaxCompressedLength(size));
+      size_t compressedSize;
+      snappy::RawCompress(data, size, out.data(), &compressedSize);
+      out.resize(compressedSize);
+      return;
+    }
+    case thrift::CompressionCodec::ZSTD: {
+      out.resize(ZSTD_compressBound(size));
+      auto ret = ZSTD_compress(
+          out.data(), out.size(), data, size, ZSTD_CLEVEL_DEFAULT);
+      VELOX_CHECK(
+          !ZSTD_isError(ret),
+          "ZSTD returned an error: ",
+          ZSTD_getErrorName(ret));
+      out.resize(ret);
+      return;
+    }
+    case thrift::CompressionCodec::GZIP: {
+      z_stream stream;
+      memset(&stream, 0, sizeof(stream));
+      // 15 bits of window and 16 for a gzip header.
+      constexpr int kWindowBits = 15 | 16;
+      auto ret = deflateInit2(
+          &stream,
+          Z_DEFAULT_COMPRESSION,
+          Z_DEFLATED,
+          kWindowBits,
+          8,
+          Z_DEFAULT_STRATEGY);
+      VELOX_CHECK_EQ(ret, Z_OK, "zlib deflateInit failed");
+      auto deflateEndGuard = folly::makeGuard([&] { deflateEnd(&stream); });
+      out.resize(deflateBound(&stream, size));
+      stream.next_in = const_cast<Bytef*>(reinterpret_cast<const Bytef*>(data));
+      stream.avail_in = static_cast<uInt>(size);
+      stream.next_out = reinterpret_cast<Bytef*>(out.data());
+      stream.avail_out = static_cast<uInt>(out.size());
+      ret = deflate(&stream, Z_FINISH);
+      VELOX_CHECK_EQ(ret, Z_STREAM_END, "zlib deflate failed");
+      out.resize(stream.total_out);
+      return;
+    }
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+// Min and max of the non-null values of a page or a column chunk.
+template <typename T>
+struct MinMax {
+  template <typename V>
+  void update(const V& value) {
+    if constexpr (std::is_floating_point_v<V>) {
+      if (std::isnan(value)) {
+        return;
+      }
+    }
+    if (!min.has_value() || value < *min) {
+      min = T(value);
+    }
+    if (!max.has_value() || *max < value) {
+      max = T(value);
+    }
+  }
+
+  void merge(const MinMax& other) {
+    if (other.min.has_value()) {
+      update(*other.min);
+      update(*other.max);
+    }
+  }
+
+  std::optional<T> min;
+  std::optional<T> max;
+};
+
+template <typename T>
+std::string encodeStatistic(const T& value) {
+  if constexpr (std::is_same_v<T, std::string>) {
+    return value;
+  } else if constexpr (std::is_same_v<T, bool>) {
+    return std::string(1, value ? 1 : 0);
+  } else {
+    return std::string(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+}
+
+// Writes column values of Velox type 'S' as values of the C++ type 'T' of
+// their Parquet physical type. Strings have 'S' and 'T' StringView. Timestamps
+// are written as INT64 nanoseconds.
+template <typename S, typename T>
+class TypedColumnWriter : public ColumnWriter {
+ public:
+  TypedColumnWriter(
+      const std::string& name,
+      thrift::Type::type physicalType,
+      const WriterOptions& options,
+      memory::MemoryPool& pool)
+      : ColumnWriter(name, physicalType, options, pool) {}
+
+ protected:
+  static constexpr bool kIsString = std::is_same_v<T, StringView>;
+
+  // Strings are compared and hashed as std::string_view, floating point values
+  // by their bits, so that a NaN finds itself.
+  using Key = std::conditional_t<
+      kIsString,
+      std::string_view,
+      std::conditional_t<
+          std::is_floating_point_v<T>,
+          std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>,
+          T>>;
+
+  using Statistic = std::conditional_t<kIsString, std::string, T>;
+
+  void writeValues(
+      const DecodedVector& decoded,
+      vector_size_t begin,
+      vector_size_t end) override {
+    // The ids of the distinct values of a dictionary or constant input are
+    // looked up once per batch.
+    const bool cacheIds = useDictionary_ && !decoded.isIdentityMapping() &&
+        (decoded.isConstantMapping() || decoded.base()->size() <= end - begin);
+    if (cacheIds) {
+      baseIds_.assign(
+          decoded.isConstantMapping() ? 1 : decoded.base()->size(), kNoId);
+    }
+    for (auto row = begin; row < end; ++row) {
+      if (decoded.isNullAt(row)) {
+        appendNull();
+        continue;
+      }
+      const T value = toPhysical(decoded.valueAt<S>(row));
+      // Looking up a new value may finish the page, so the value is added to
+      // the statistics after that.
+      uint32_t id = kNoId;
+      if (useDictionary_) {
+        if (cacheIds) {
+          auto& cachedId =
+              baseIds_[decoded.isConstantMapping() ? 0 : decoded.index(row)];
+          if (cachedId == kNoId) {
+            cachedId = dictionaryId(value);
+          }
+          id = cachedId;
+        } else {
+          id = dictionaryId(value);
+        }
+      }
+      if constexpr (kIsString) {
+        pageStatistics_.update(std::string_view(value));
+      } else {
+        pageStatistics_.update(value);
+      }
+      if (id != kNoId) {
+        appendId(id);
+      } else {
+        appendValue(value);
+      }
+    }
+  }
+
+  bool finishPageStatistics(std::string& min, std::string& max) override {
+    if (!pageStatistics_.min.has_value()) {
+      return false;
+    }
+    min = encodeStatistic(*pageStatistics_.min);
+    max = encodeStatistic(*pageStatistics_.max);
+    chunkStatistics_.merge(pageStatistics_);
+    pageStatistics_ = {};
+    return true;
+  }
+
+  bool finishChunkStatistics(std::string& min, std::string& max) override {
+    if (!chunkStatistics_.min.has_value()) {
+      return false;
+    }
+    min = encodeStatistic(*chunkStatistics_.min);
+    max = encodeStatistic(*chunkStatistics_.max);
+    chunkStatistics_ = {};
+    return true;
+  }
+
+  void clearDictionary() override {
+    dictionaryIds_.clear();
+    dictionaryStrings_.clear();
+  }
+
+ private:
+  static T toPhysical(const S& value) {
+    if constexpr (std::is_same_v<S, Timestamp>) {
+      return value.toNanos();
+    } else {
+      return value;
+    }
+  }
+
+  // Returns the dictionary id of 'value', adding it to the dictionary if new.
+  uint32_t dictionaryId(T value) {
+    Key key;
+    if constexpr (kIsString) {
+      key = std::string_view(value);
+    } else if constexpr (std::is_floating_point_v<T>) {
+      memcpy(&key, &value, sizeof(T));
+    } else {
+      key = value;
+    }
+    auto it = dictionaryIds_.find(key);
+    if (it != dictionaryIds_.end()) {
+      return it->second;
+    }
+    uint32_t id;
+    if constexpr (kIsString) {
+      id = addToDictionary(key);
+      if (id != kNoId) {
+        // The key refers to the copy in the dictionary, not to the vector.
+        key = dictionaryStrings_.emplace_back(key);
+      }
+    } else {
+      id = addToDictionary(&value, sizeof(T));
+    }
+    if (id != kNoId) {
+      dictionaryIds_.emplace(key, id);
+      hash(value);
+    }
+    return id;
+  }
+
+  void hash(T value) {
+    if constexpr (kIsString) {
+      addHash(value.data(), value.size());
+    } else if constexpr (!std::is_same_v<T, bool>) {
+      addHash(&value, sizeof(T));
+    }
+  }
+
+  void appendValue(T value) {
+    hash(value);
+    if constexpr (kIsString) {
+      appendPlain(std::string_view(value));
+    } else if constexpr (std::is_same_v<T, bool>) {
+      appendBit(value);
+    } else {
+      appendPlain(&value, sizeof(T));
+    }
+  }
+
+  MinMax<Statistic> pageStatistics_;
+  MinMax<Statistic> chunkStatistics_;
+
+  folly::F14FastMap<Key, uint32_t> dictionaryIds_;
+  // Backs the string keys of 'dictionaryIds_'. Elements of a deque do not
+  // move.
+  std::deque<std::string> dictionaryStrings_;
+  // Dictionary ids by index in the base vector of the current input.
+  std::vector<uint32_t> baseIds_;
+};
+
+} // namespace
+
+// static
+std::unique_ptr<ColumnWriter> ColumnWriter::create(
+    const std::string& name,
+    const TypePtr& type,
+    const WriterOptions& options,
+    memory::MemoryPool& pool) {
+  if (type->isDecimal() || type->isIntervalDayTime() ||
+      type->isIntervalYearMonth()) {
+    VELOX_UNSUPPORTED(
+        "Native Parquet writer does not support {}", type->toString());
+  }
+  std::unique_ptr<ColumnWriter> writer;
+  std::optional<thrift::ConvertedType::type> convertedType;
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+      writer = std::make_unique<TypedColumnWriter<bool, bool>>(
+          name, thrift::Type::BOOLEAN, options, pool);
+      break;
+    case TypeKind::TINYINT:
+      writer = std::make_unique<TypedColumnWriter<int8_t, int32_t>>(
+          name, thrift::Type::INT32, options, pool);
+      convertedType = thrift::ConvertedType::INT_8;
+      break;
+    case TypeKind::SMALLINT:
+      writer = std::make_unique<TypedColumnWriter<int16_t, int32_t>>(
+          name, thrift::Type::INT32, options, pool);
+      convertedType = thrift::ConvertedType::INT_16;
+      break;
+    case TypeKind::INTEGER:
+      writer = std::make_unique<TypedColumnWriter<int32_t, int32_t>>(
+          name, thrift::Type::INT32, options, pool);
+      if (type->isDate()) {
+        convertedType = thrift::ConvertedType::DATE;
+      }
+      break;
+    case TypeKind::BIGINT:
+      writer = std::make_unique<TypedColumnWriter<int64_t, int64_t>>(
+          name, thrift::Type::INT64, options, pool);
+      break;
+    case TypeKind::TIMESTAMP: {
+      writer = std::make_unique<TypedColumnWriter<Timestamp, int64_t>>(
+          name, thrift::Type::INT64, options, pool);
+      // Nanoseconds have a logical type but no converted type.
+      thrift::TimeUnit unit;
+      unit.__set_NANOS(thrift::NanoSeconds());
+      thrift::TimestampType timestamp;
+      timestamp.__set_isAdjustedToUTC(false);
+      timestamp.__set_unit(unit);
+      thrift::LogicalType logicalType;
+      logicalType.__set_TIMESTAMP(timestamp);
+      writer->schemaElement_.__set_logicalType(logicalType);
+      break;
+    }
+    case TypeKind::REAL:
+      writer = std::make_unique<TypedColumnWriter<float, float>>(
+          name, thrift::Type::FLOAT, options, pool);
+      break;
+    case TypeKind::DOUBLE:
+      writer = std::make_unique<TypedColumnWriter<double, double>>(
+          name, thrift::Type::DOUBLE, options, pool);
+      break;
+    case TypeKind::VARCHAR:
+      writer = std::make_unique<TypedColumnWriter<StringView, StringView>>(
+          name, thrift::Type::BYTE_ARRAY, options, pool);
+      convertedType = thrift::ConvertedType::UTF8;
+      break;
+    case TypeKind::VARBINARY:
+      writer = std::make_unique<TypedColumnWriter<StringView, StringView>>(
+          name, thrift::Type::BYTE_ARRAY, options, pool);
+      break;
+    default:
+      VELOX_UNSUPPORTED(
+          "Native Parquet writer does not support {}", type->toString());
+  }
+  if (convertedType.has_value()) {
+    writer->schemaElement_.__set_converted_type(convertedType.value());
+  }
+  return writer;
+}
+
+ColumnWriter::ColumnWriter(
+    const std::string& name,
+    thrift::Type::type physicalType,
+    const WriterOptions& options,
+    memory::MemoryPool& pool)
+    : options_(options),
+      pool_(pool),
+      useDictionary_(
+          options.enableDictionary && physicalType != thrift::Type::BOOLEAN),
+      physicalType_(physicalType),
+      codec_(toThriftCodec(options.compression)),
+      values_(pool),
+      page_(pool),
+      compressed_(pool),
+      pages_(pool),
+      dictionary_(pool) {
+  schemaElement_.__set_type(physicalType);
+  schemaElement_.__set_repetition_type(thrift::FieldRepetitionType::OPTIONAL);
+  schemaElement_.__set_name(name);
+}
+
+void ColumnWriter::write(
+    const BaseVector& vector,
+    vector_size_t begin,
+    vector_size_t end) {
+  decoded_.decode(vector);
+  writeValues(decoded_, begin, end);
+}
+
+int64_t ColumnWriter::bufferedBytes() const {
+  return pages_.size() + dictionary_.size() + pageBytes();
+}
+
+int32_t ColumnWriter::idBitWidth() const {
+  return numDictionaryIds_ <= 2 ? 1 : 32 - __builtin_clz(numDictionaryIds_ - 1);
+}
+
+int64_t ColumnWriter::pageBytes() const {
+  const int64_t levelBytes = levels_.size() / 8;
+  if (physicalType_ == thrift::Type::BOOLEAN) {
+    return levelBytes + ids_.size() / 8;
+  }
+  if (useDictionary_) {
+    return levelBytes + ids_.size() * idBitWidth() / 8;
+  }
+  return levelBytes + values_.size();
+}
+
+uint32_t ColumnWriter::addToDictionary(const void* data, int32_t size) {
+  if (dictionary_.size() + size > options_.dictionaryPageSizeLimit) {
+    // The pages so far stay dictionary encoded.
+    finishPage();
+    useDictionary_ = false;
+    return kNoId;
+  }
+  append(dictionary_, data, size);
+  return numDictionaryIds_++;
+}
+
+uint32_t ColumnWriter::addToDictionary(std::string_view value) {
+  const uint32_t length = value.size();
+  if (dictionary_.size() + sizeof(length) + length >
+      options_.dictionaryPageSizeLimit) {
+    finishPage();
+    useDictionary_ = false;
+    return kNoId;
+  }
+  append(dictionary_, &length, sizeof(length));
+  append(dictionary_, value.data(), length);
+  return numDictionaryIds_++;
+}
+
+void ColumnWriter::appendPage(
+    thrift::PageHeader& header,
+    const DataBuffer<char>& data,
+    DataBuffer<char>& out) {
+  const char* pageData = data.data();
+  uint64_t pageSize = data.size();
+  if (codec_ != thrift::CompressionCodec::UNCOMPRESSED) {
+    compress(codec_, data.data(), data.size(), compressed_);
+    pageData = compressed_.data();
+    pageSize = compressed_.size();
+  }
+  header.__set_uncompressed_page_size(data.size());
+  header.__set_compressed_page_size(pageSize);
+  const auto headerSize = appendThrift(header, out);
+  append(out, pageData, pageSize);
+  uncompressedBytes_ += headerSize + data.size();
+}
+
+void ColumnWriter::finishPage() {
+  if (numPageRows_ == 0) {
+    return;
+  }
+  // The definition levels have a 4 byte length.
+  page_.resize(sizeof(uint32_t));
+  encodeRleBp(levels_, 1, page_);
+  const uint32_t levelsSize = page_.size() - sizeof(uint32_t);
+  memcpy(page_.data(), &levelsSize, sizeof(levelsSize));
+
+  thrift::Encoding::type encoding = thrift::Encoding::PLAIN;
+  if (physicalType_ == thrift::Type::BOOLEAN) {
+    bitPack(ids_.data(), ids_.size(), 1, page_);
+  } else if (useDictionary_ && !ids_.empty()) {
+    encoding = thrift::Encoding::RLE_DICTIONARY;
+    const auto bitWidth = idBitWidth();
+    page_.append(static_cast<char>(bitWidth));
+    encodeRleBp(ids_, bitWidth, page_);
+  } else {
+    append(page_, values_.data(), values_.size());
+  }
+  encodings_.insert(encoding);
+
+  thrift::PageHeader header;
+  header.__set_type(thrift::PageType::DATA_PAGE);
+  thrift::DataPageHeader dataHeader;
+  dataHeader.__set_num_values(numPageRows_);
+  dataHeader.__set_encoding(encoding);
+  dataHeader.__set_definition_level_encoding(thrift::Encoding::RLE);
+  dataHeader.__set_repetition_level_encoding(thrift::Encoding::RLE);
+  header.__set_data_page_header(dataHeader);
+
+  Page page;
+  page.offset = pages_.size();
+  appendPage(header, page_, pages_);
+  page.size = pages_.size() - page.offset;
+  page.firstRow = numChunkRows_;
+  page.numNulls = numPageNulls_;
+  page.hasValues = finishPageStatistics(page.min, page.max);
+  if (page.min.size() > kMaxStatisticsBytes ||
+      page.max.size() > kMaxStatisticsBytes) {
+    hasColumnIndex_ = false;
+  }
+  pageInfos_.push_back(std::move(page));
+
+  numChunkRows_ += numPageRows_;
+  numChunkNulls_ += numPageNulls_;
+  levels_.clear();
+  ids_.clear();
+  reset(values_);
+  numPageRows_ = 0;
+  numPageNulls_ = 0;
+}
+
+void ColumnWriter::flush(
+    int64_t offset,
+    DataBuffer<char>& out,
+    thrift::ColumnChunk& chunk,
+    thrift::ColumnIndex& columnIndex,
+    thrift::OffsetIndex& offsetIndex) {
+  finishPage();
+  const int64_t chunkOffset = offset + out.size();
+  thrift::ColumnMetaData metaData;
+  metaData.__set_type(physicalType_);
+  metaData.__set_path_in_schema({schemaElement_.name});
+  metaData.__set_codec(codec_);
+  metaData.__set_num_values(numChunkRows_);
+
+  if (numDictionaryIds_ > 0) {
+    thrift::PageHeader header;
+    header.__set_type(thrift::PageType::DICTIONARY_PAGE);
+    thrift::DictionaryPageHeader dictionaryHeader;
+    dictionaryHeader.__set_num_values(numDictionaryIds_);
+    dictionaryHeader.__set_encoding(thrift::Encoding::PLAIN);
+    header.__set_dictionary_page_header(dictionaryHeader);
+    appendPage(header, dictionary_, out);
+    metaData.__set_dictionary_page_offset(chunkOffset);
+    encodings_.insert(thrift::Encoding::PLAIN);
+  }
+  const int64_t dataOffset = offset + out.size();
+  metaData.__set_data_page_offset(dataOffset);
+  append(out, pages_.data(), pages_.size());
+
+  encodings_.insert(thrift::Encoding::RLE);
+  metaData.__set_encodings({encodings_.begin(), encodings_.end()});
+  metaData.__set_total_uncompressed_size(uncompressedBytes_);
+  metaData.__set_total_compressed_size(offset + out.size() - chunkOffset);
+
+  thrift::Statistics statistics;
+  statistics.__set_null_count(numChunkNulls_);
+  std::string min;
+  std::string max;
+  if (finishChunkStatistics(min, max) && min.size() <= kMaxStatisticsBytes &&
+      max.size() <= kMaxStatisticsBytes) {
+    statistics.__set_min_value(min);
+    statistics.__set_max_value(max);
+  }
+  metaData.__set_statistics(statistics);
+  chunk.__set_meta_data(metaData);
+  chunk.__set_file_offset(chunkOffset);
+
+  for (const auto& page : pageInfos_) {
+    thrift::PageLocation location;
+    location.__set_offset(dataOffset + page.offset);
+    location.__set_compressed_page_size(page.size);
+    location.__set_first_row_index(page.firstRow);
+    offsetIndex.page_locations.push_back(location);
+    if (hasColumnIndex_) {
+      columnIndex.null_pages.push_back(!page.hasValues);
+      columnIndex.min_values.push_back(page.min);
+      columnIndex.max_values.push_back(page.max);
+      columnIndex.null_counts.push_back(page.numNulls);
+    }
+  }
+  if (hasColumnIndex_) {
+    columnIndex.__set_boundary_order(thrift::BoundaryOrder::UNORDERED);
+    columnIndex.__isset.null_counts = true;
+  }
+
+  reset(pages_);
+  pageInfos_.clear();
+  reset(dictionary_);
+  clearDictionary();
+  numDictionaryIds_ = 0;
+  useDictionary_ =
+      options_.enableDictionary && physicalType_ != thrift::Type::BOOLEAN;
+  encodings_.clear();
+  numChunkRows_ = 0;
+  numChunkNulls_ = 0;
+  uncompressedBytes_ = 0;
+  hasColumnIndex_ = true;
+}
+
+void ColumnWriter::flushBloomFilter(
+    int64_t offset,
+    DataBuffer<char>& out,
+    thrift::ColumnChunk& chunk) {
+  if (hashes_.empty()) {
+    return;
+  }
+  // The optimal number of bits per value for a split block Bloom filter.
+  const double bitsPerValue =
+      -8 / std::log(1 - std::pow(options_.bloomFilterFpp, 1.0 / 8));
+  const int64_t numBytes = std::clamp<int64_t>(
+      bits::roundUp(
+          static_cast<int64_t>(std::ceil(hashes_.size() * bitsPerValue / 8)),
+          SplitBlockBloomFilter::kBytesPerBlock),
+      kMinBloomFilterBytes,
+      kMaxBloomFilterBytes);
+  std::vector<uint32_t> bitset(numBytes / sizeof(uint32_t));
+  SplitBlockBloomFilter bloomFilter(bitset.data(), numBytes);
+  for (auto hash : hashes_) {
+    bloomFilter.insert(hash);
+  }
+  hashes_.clear();
+
+  thrift::BloomFilterHeader header;
+  header.__set_numBytes(numBytes);
+  thrift::BloomFilterAlgorithm algorithm;
+  algorithm.__set_BLOCK(thrift::SplitBlockAlgorithm());
+  header.__set_algorithm(algorithm);
+  thrift::BloomFilterHash hash;
+  hash.__set_XXHASH(thrift::XxHash());
+  header.__set_hash(hash);
+  thrift::BloomFilterCompression compression;
+  compression.__set_UNCOMPRESSED(thrift::Uncompressed());
+  header.__set_compression(compression);
+
+  chunk.meta_data.__set_bloom_filter_offset(offset + out.size());
+  appendThrift(header, out);
+  append(out, bitset.data(), numBytes);
+}
+
+} // namespace facebook::velox::parquet
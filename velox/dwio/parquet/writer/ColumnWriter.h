@@ -0,0 +1,252 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Set.h>
+#include <set>
+
+#include "velox/dwio/common/DataBuffer.h"
+#include "velox/dwio/parquet/reader/BloomFilter.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+#include "velox/dwio/parquet/writer/Writer.h"
+#include "velox/vector/DecodedVector.h"
+
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+
+namespace facebook::velox::parquet {
+
+/// Appends the compact protocol encoding of thrift struct 'value' to 'out'.
+/// Returns the number of bytes appended.
+template <typename T>
+uint32_t appendThrift(const T& value, dwio::common::DataBuffer<char>& out) {
+  auto transport = std::make_shared<thrift::ThriftDataBufferTransport>(out);
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftDataBufferTransport>
+      protocol(transport);
+  return value.write(&protocol);
+}
+
+/// Encodes one top level column into the pages of a column chunk. Every
+/// column is OPTIONAL, so the pages are data pages v1 with RLE encoded
+/// definition levels of width 1 and no repetition levels. The values are
+/// dictionary encoded while the plain encoded dictionary stays under
+/// WriterOptions::dictionaryPageSizeLimit and plain encoded after that. A page
+/// is cut when its values reach WriterOptions::dataPageSize bytes. The pages
+/// are buffered until flush() appends the column chunk at the end of a row
+/// group.
+class ColumnWriter {
+ public:
+  /// Returns a writer for column 'name' of 'type'. Throws for types that have
+  /// no native encoding.
+  static std::unique_ptr<ColumnWriter> create(
+      const std::string& name,
+      const TypePtr& type,
+      const WriterOptions& options,
+      memory::MemoryPool& pool);
+
+  virtual ~ColumnWriter() = default;
+
+  const thrift::SchemaElement& schemaElement() const {
+    return schemaElement_;
+  }
+
+  /// Appends rows [begin, end) of 'vector'.
+  void write(const BaseVector& vector, vector_size_t begin, vector_size_t end);
+
+  /// Returns the estimated size in bytes of the column chunk buffered since
+  /// the last flush().
+  int64_t bufferedBytes() const;
+
+  /// Appends the buffered column chunk to 'out' and fills 'chunk' with its
+  /// metadata. 'offset' is the file offset of the first byte of 'out'. Fills
+  /// 'offsetIndex' with the locations of the data pages and 'columnIndex' with
+  /// their statistics. 'columnIndex' is left empty if some page has no
+  /// statistics.
+  void flush(
+      int64_t offset,
+      dwio::common::DataBuffer<char>& out,
+      thrift::ColumnChunk& chunk,
+      thrift::ColumnIndex& columnIndex,
+      thrift::OffsetIndex& offsetIndex);
+
+  /// Appends the Bloom filter of the values in the column chunk written by the
+  /// last flush() to 'out' and sets its offset in 'chunk'. Does nothing if
+  /// Bloom filters are disabled or the chunk has only nulls.
+  void flushBloomFilter(
+      int64_t offset,
+      dwio::common::DataBuffer<char>& out,
+      thrift::ColumnChunk& chunk);
+
+ protected:
+  static constexpr uint32_t kNoId = ~0U;
+
+  ColumnWriter(
+      const std::string& name,
+      thrift::Type::type physicalType,
+      const WriterOptions& options,
+      memory::MemoryPool& pool);
+
+  // Appends rows [begin, end) of 'decoded' to the current page.
+  virtual void writeValues(
+      const DecodedVector& decoded,
+      vector_size_t begin,
+      vector_size_t end) = 0;
+
+  // Sets 'min' and 'max' to the plain encoded min and max of the values of the
+  // current page and merges them into the statistics of the column chunk.
+  // Returns false if the page has no non-null values.
+  virtual bool finishPageStatistics(std::string& min, std::string& max) = 0;
+
+  // Sets 'min' and 'max' for the column chunk and clears its statistics.
+  // Returns false if the chunk has no non-null values.
+  virtual bool finishChunkStatistics(std::string& min, std::string& max) = 0;
+
+  // Clears the dictionary of the column chunk.
+  virtual void clearDictionary() = 0;
+
+  void appendNull() {
+    levels_.push_back(0);
+    ++numPageNulls_;
+    endRow();
+  }
+
+  void appendId(uint32_t id) {
+    levels_.push_back(1);
+    ids_.push_back(id);
+    endRow();
+  }
+
+  void appendPlain(const void* data, int32_t size) {
+    levels_.push_back(1);
+    values_.extendAppend(
+        values_.size(), reinterpret_cast<const char*>(data), size);
+    endRow();
+  }
+
+  // Appends a BYTE_ARRAY with its 4 byte length.
+  void appendPlain(std::string_view value) {
+    const uint32_t length = value.size();
+    values_.extendAppend(
+        values_.size(), reinterpret_cast<const char*>(&length), sizeof(length));
+    appendPlain(value.data(), value.size());
+  }
+
+  // Appends a BOOLEAN. Plain encoded booleans are bit packed.
+  void appendBit(bool value) {
+    appendId(value);
+  }
+
+  // Adds the plain encoded 'size' bytes at 'data' to the dictionary page and
+  // returns the new dictionary id. Returns kNoId and switches to plain
+  // encoding if the dictionary page would exceed its size limit.
+  uint32_t addToDictionary(const void* data, int32_t size);
+
+  // Adds a BYTE_ARRAY with its 4 byte length to the dictionary page.
+  uint32_t addToDictionary(std::string_view value);
+
+  // Adds the xxHash64 of the plain encoded value at 'data' to the values of
+  // the Bloom filter.
+  void addHash(const void* data, int32_t size) {
+    if (options_.enableBloomFilter) {
+      hashes_.insert(SplitBlockBloomFilter::hash(data, size));
+    }
+  }
+
+  const WriterOptions& options_;
+  memory::MemoryPool& pool_;
+  thrift::SchemaElement schemaElement_;
+
+  // True while the values of the chunk are dictionary encoded.
+  bool useDictionary_;
+  uint32_t numDictionaryIds_{0};
+
+ private:
+  struct Page {
+    // Offset of the page header in 'pages_'.
+    int64_t offset;
+    // Bytes of the header and the compressed page.
+    int32_t size;
+    int64_t firstRow;
+    int64_t numNulls;
+    // False if the page has only nulls.
+    bool hasValues;
+    std::string min;
+    std::string max;
+  };
+
+  void endRow() {
+    if (++numPageRows_ >= kMaxPageRows ||
+        pageBytes() >= options_.dataPageSize) {
+      finishPage();
+    }
+  }
+
+  // Estimated encoded size of the values of the current page.
+  int64_t pageBytes() const;
+
+  // Encodes the current page and appends it to 'pages_'.
+  void finishPage();
+
+  // Compresses 'data' with 'codec_', completes 'header' with the sizes and
+  // appends both to 'out'.
+  void appendPage(
+      thrift::PageHeader& header,
+      const dwio::common::DataBuffer<char>& data,
+      dwio::common::DataBuffer<char>& out);
+
+  // Bit width of the dictionary ids.
+  int32_t idBitWidth() const;
+
+  // Keeps the column index selective and the decoding of a skipped page
+  // cheap.
+  static constexpr int32_t kMaxPageRows = 20'000;
+
+  const thrift::Type::type physicalType_;
+  const thrift::CompressionCodec::type codec_;
+
+  DecodedVector decoded_;
+
+  // Definition levels of the current page.
+  std::vector<uint32_t> levels_;
+  // Dictionary ids or booleans of the current page.
+  std::vector<uint32_t> ids_;
+  // Plain encoded values of the current page.
+  dwio::common::DataBuffer<char> values_;
+  int32_t numPageRows_{0};
+  int64_t numPageNulls_{0};
+
+  // Uncompressed and compressed page.
+  dwio::common::DataBuffer<char> page_;
+  dwio::common::DataBuffer<char> compressed_;
+
+  // Data pages of the column chunk with their headers.
+  dwio::common::DataBuffer<char> pages_;
+  std::vector<Page> pageInfos_;
+  // Plain encoded values of the dictionary page.
+  dwio::common::DataBuffer<char> dictionary_;
+  std::set<thrift::Encoding::type> encodings_;
+  int64_t numChunkRows_{0};
+  int64_t numChunkNulls_{0};
+  int64_t uncompressedBytes_{0};
+  // False if some page has a min or max too long for the column index.
+  bool hasColumnIndex_{true};
+
+  // Hashes of the distinct values of the column chunk for the Bloom filter.
+  folly::F14FastSet<uint64_t> hashes_;
+};
+
+} // namespace facebook::velox::parquet
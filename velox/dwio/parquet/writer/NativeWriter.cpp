@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/writer/NativeWriter.h"
+#include "velox/dwio/parquet/writer/ColumnWriter.h"
+
+#include <folly/Random.h>
+
+namespace facebook::velox::parquet {
+
+namespace {
+constexpr std::string_view kMagic = "PAR1";
+} // namespace
+
+NativeWriter::NativeWriter(
+    std::unique_ptr<dwio::common::FileSink> sink,
+    const WriterOptions& options,
+    std::shared_ptr<memory::MemoryPool> pool)
+    : options_(options),
+      pool_(std::move(pool)),
+      generalPool_{pool_->addLeafChild(".general")},
+      sink_(std::move(sink)),
+      buffer_(*generalPool_) {
+  if (options_.flushPolicyFactory) {
+    flushPolicy_ = options_.flushPolicyFactory();
+  } else {
+    flushPolicy_ = std::make_unique<DefaultFlushPolicy>();
+  }
+  buffer_.extendAppend(0, kMagic.data(), kMagic.size());
+}
+
+NativeWriter::NativeWriter(
+    std::unique_ptr<dwio::common::FileSink> sink,
+    const WriterOptions& options)
+    : NativeWriter{
+          std::move(sink),
+          options,
+          options.memoryPool->addAggregateChild(fmt::format(
+              "writer_node_{}",
+              folly::to<std::string>(folly::Random::rand64())))} {}
+
+NativeWriter::~NativeWriter() = default;
+
+void NativeWriter::createColumns(const RowTypePtr& type) {
+  type_ = type;
+  for (auto i = 0; i < type->size(); ++i) {
+    columns_.push_back(ColumnWriter::create(
+        type->nameOf(i), type->childAt(i), options_, *generalPool_));
+  }
+}
+
+int64_t NativeWriter::bufferedBytes() const {
+  int64_t bytes = 0;
+  for (const auto& column : columns_) {
+    bytes += column->bufferedBytes();
+  }
+  return bytes;
+}
+
+void NativeWriter::write(const VectorPtr& data) {
+  VELOX_CHECK(!closed_, "Cannot write to a closed Parquet writer");
+  auto* input = data->as<RowVector>();
+  VELOX_CHECK_NOT_NULL(input, "Parquet writer expects a RowVector");
+  if (!type_) {
+    createColumns(asRowType(data->type()));
+  }
+  VELOX_CHECK_EQ(input->childrenSize(), columns_.size());
+
+  const auto rowsInRowGroup = flushPolicy_->rowsInRowGroup();
+  vector_size_t begin = 0;
+  while (begin < input->size()) {
+    const auto buffered = bufferedBytes();
+    const dwio::common::StripeProgress progress{
+        .stripeRowCount = bufferedRows_,
+        .totalMemoryUsage = buffered,
+        .stripeSizeEstimate = sizeEstimator_.estimateFileBytes(buffered)};
+    if (bufferedRows_ >= rowsInRowGroup ||
+        flushPolicy_->shouldFlush(progress)) {
+      flush();
+    }
+    const vector_size_t end = begin +
+        std::min<uint64_t>(
+            input->size() - begin, rowsInRowGroup - bufferedRows_);
+    for (auto i = 0; i < columns_.size(); ++i) {
+      columns_[i]->write(*input->childAt(i), begin, end);
+    }
+    bufferedRows_ += end - begin;
+    begin = end;
+  }
+}
+
+void NativeWriter::flush() {
+  if (bufferedRows_ == 0) {
+    return;
+  }
+  const auto buffered = bufferedBytes();
+  thrift::RowGroup rowGroup;
+  rowGroup.columns.resize(columns_.size());
+  auto& columnIndexes = columnIndexes_.emplace_back(columns_.size());
+  auto& offsetIndexes = offsetIndexes_.emplace_back(columns_.size());
+  const auto rowGroupOffset = fileOffset();
+  int64_t totalByteSize = 0;
+  for (auto i = 0; i < columns_.size(); ++i) {
+    columns_[i]->flush(
+        bytesWritten_,
+        buffer_,
+        rowGroup.columns[i],
+        columnIndexes[i],
+        offsetIndexes[i]);
+    totalByteSize += rowGroup.columns[i].meta_data.total_uncompressed_size;
+  }
+  // The Bloom filters follow the column chunks so that the row group is
+  // contiguous.
+  const auto totalCompressedSize = fileOffset() - rowGroupOffset;
+  sizeEstimator_.recordRowGroup(buffered, totalCompressedSize);
+  for (auto i = 0; i < columns_.size(); ++i) {
+    columns_[i]->flushBloomFilter(bytesWritten_, buffer_, rowGroup.columns[i]);
+  }
+  rowGroup.__set_num_rows(bufferedRows_);
+  rowGroup.__set_total_byte_size(totalByteSize);
+  rowGroup.__set_file_offset(rowGroupOffset);
+  rowGroup.__set_total_compressed_size(totalCompressedSize);
+  rowGroup.__set_ordinal(rowGroups_.size());
+  rowGroups_.push_back(std::move(rowGroup));
+  numRows_ += bufferedRows_;
+  bufferedRows_ = 0;
+  writeBuffer();
+}
+
+void NativeWriter::writeBuffer() {
+  if (buffer_.size() > 0) {
+    bytesWritten_ += buffer_.size();
+    sink_->write(std::move(buffer_));
+  }
+}
+
+void NativeWriter::close() {
+  if (closed_) {
+    return;
+  }
+  flush();
+
+  // The page indexes of all row groups are together after the row groups:
+  // first the column indexes and then the offset indexes.
+  for (auto i = 0; i < rowGroups_.size(); ++i) {
+    for (auto j = 0; j < columns_.size(); ++j) {
+      if (columnIndexes_[i][j].null_pages.empty()) {
+        continue;
+      }
+      auto& chunk = rowGroups_[i].columns[j];
+      chunk.__set_column_index_offset(fileOffset());
+      chunk.__set_column_index_length(
+          appendThrift(columnIndexes_[i][j], buffer_));
+    }
+  }
+  for (auto i = 0; i < rowGroups_.size(); ++i) {
+    for (auto j = 0; j < columns_.size(); ++j) {
+      auto& chunk = rowGroups_[i].columns[j];
+      chunk.__set_offset_index_offset(fileOffset());
+      chunk.__set_offset_index_length(
+          appendThrift(offsetIndexes_[i][j], buffer_));
+    }
+  }
+
+  thrift::FileMetaData metaData;
+  metaData.__set_version(1);
+  thrift::SchemaElement root;
+  root.__set_name("schema");
+  root.__set_num_children(columns_.size());
+  metaData.schema.push_back(root);
+  for (const auto& column : columns_) {
+    metaData.schema.push_back(column->schemaElement());
+  }
+  metaData.__set_num_rows(numRows_);
+  metaData.__set_row_groups(rowGroups_);
+  metaData.__set_created_by("velox");
+  const uint32_t footerSize = appendThrift(metaData, buffer_);
+  buffer_.extendAppend(
+      buffer_.size(),
+      reinterpret_cast<const char*>(&footerSize),
+      sizeof(footerSize));
+  buffer_.extendAppend(buffer_.size(), kMagic.data(), kMagic.size());
+  writeBuffer();
+  sink_->close();
+  closed_ = true;
+}
+
+void NativeWriter::abort() {
+  closed_ = true;
+  columns_.clear();
+  buffer_.clear();
+  if (sink_) {
+    sink_->close();
+    sink_ = nullptr;
+  }
+}
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/dwio/parquet/writer/Writer.h"
+
+namespace facebook::velox::parquet {
+
+class ColumnWriter;
+
+/// Writes Velox vectors into a FileSink as Parquet without converting them to
+/// Arrow. The columns are encoded directly from flat, constant and dictionary
+/// vectors and the ids of the distinct values of a dictionary vector are
+/// looked up once per batch. Each column chunk has a column index and an
+/// offset index and, if WriterOptions::enableBloomFilter is set, a Bloom
+/// filter. Supports top level columns of BOOLEAN, TINYINT, SMALLINT, INTEGER,
+/// BIGINT, REAL, DOUBLE, VARCHAR, VARBINARY, DATE and TIMESTAMP. Timestamps
+/// are written as INT64 nanoseconds.
+class NativeWriter : public dwio::common::Writer {
+ public:
+  NativeWriter(
+      std::unique_ptr<dwio::common::FileSink> sink,
+      const WriterOptions& options,
+      std::shared_ptr<memory::MemoryPool> pool);
+
+  NativeWriter(
+      std::unique_ptr<dwio::common::FileSink> sink,
+      const WriterOptions& options);
+
+  ~NativeWriter() override;
+
+  /// Appends 'data', a RowVector with the same type as the first one. A row
+  /// group ends when the flush policy says so or when it reaches
+  /// DefaultFlushPolicy::rowsInRowGroup() rows.
+  void write(const VectorPtr& data) override;
+
+  /// Ends the current row group and writes it to the sink.
+  void flush() override;
+
+  /// Writes the page indexes and the footer and closes the sink.
+  void close() override;
+
+  /// Drops the buffered data and closes the sink without a footer.
+  void abort() override;
+
+ private:
+  void createColumns(const RowTypePtr& type);
+
+  int64_t bufferedBytes() const;
+
+  // File offset of the next byte appended to 'buffer_'.
+  int64_t fileOffset() const {
+    return bytesWritten_ + buffer_.size();
+  }
+
+  // Writes 'buffer_' to 'sink_'.
+  void writeBuffer();
+
+  const WriterOptions options_;
+  std::shared_ptr<memory::MemoryPool> pool_;
+  std::shared_ptr<memory::MemoryPool> generalPool_;
+  std::unique_ptr<dwio::common::FileSink> sink_;
+  std::unique_ptr<DefaultFlushPolicy> flushPolicy_;
+  RowGroupSizeEstimator sizeEstimator_;
+
+  RowTypePtr type_;
+  std::vector<std::unique_ptr<ColumnWriter>> columns_;
+
+  // Output not yet written to 'sink_'.
+  dwio::common::DataBuffer<char> buffer_;
+  int64_t bytesWritten_{0};
+  uint64_t bufferedRows_{0};
+  int64_t numRows_{0};
+
+  std::vector<thrift::RowGroup> rowGroups_;
+  // Page indexes by row group and column, written at close().
+  std::vector<std::vector<thrift::ColumnIndex>> columnIndexes_;
+  std::vector<std::vector<thrift::OffsetIndex>> offsetIndexes_;
+
+  bool closed_{false};
+};
+
+} // namespace facebook::velox::parquet
@@ -18,9 +18,16 @@
 
 #include <arrow/c/bridge.h>
 #include <arrow/table.h>
+#include <gflags/gflags.h>
 #include <parquet/arrow/writer.h>
+#include "velox/dwio/parquet/writer/NativeWriter.h"
 #include "velox/dwio/parquet/writer/Writer.h"
 
+DEFINE_bool(
+    parquet_native_writer,
+    false,
+    "Write Parquet files with the native writer instead of the Arrow writer");
+
 namespace facebook::velox::parquet {
 
 // Utility for buffering Arrow output with a DataBuffer.
@@ -169,6 +176,7 @@ void Writer::flush() {
           &arrowContext_->writer));
     }
 
+    const auto fileOffset = stream_->Tell().ValueOrDie();
     auto fields = arrowContext_->schema->fields();
     std::vector<std::shared_ptr<arrow::ChunkedArray>> chunks;
     for (int colIdx = 0; colIdx < fields.size(); colIdx++) {
@@ -186,6 +194,9 @@ void Writer::flush() {
     PARQUET_THROW_NOT_OK(arrowContext_->writer->WriteTable(
         *table, static_cast<int64_t>(flushPolicy_->rowsInRowGroup())));
     PARQUET_THROW_NOT_OK(stream_->Flush());
+    sizeEstimator_.recordRowGroup(
+        arrowContext_->stagingBytes,
+        stream_->Tell().ValueOrDie() - fileOffset);
     for (auto& chunk : arrowContext_->stagingChunks) {
       chunk.clear();
     }
@@ -196,16 +207,20 @@ void Writer::flush() {
 
 dwio::common::StripeProgress getStripeProgress(
     uint64_t stagingRows,
-    int64_t stagingBytes) {
+    int64_t stagingBytes,
+    const RowGroupSizeEstimator& sizeEstimator) {
   return dwio::common::StripeProgress{
-      .stripeRowCount = stagingRows, .stripeSizeEstimate = stagingBytes};
+      .stripeRowCount = stagingRows,
+      .totalMemoryUsage = stagingBytes,
+      .stripeSizeEstimate = sizeEstimator.estimateFileBytes(stagingBytes)};
 }
 
 /**
  * This method would cache input `ColumnarBatch` to make the size of row group
  * big. It would flush when:
  * - the cached numRows bigger than `rowsInRowGroup_`
- * - the cached bytes bigger than `bytesInRowGroup_`
+ * - the estimated file bytes of the cached data bigger than `bytesInRowGroup_`
+ * - the cached bytes bigger than `maxBufferedBytes_`
  *
  * This method assumes each input `ColumnarBatch` have same schema.
  */
@@ -228,7 +243,9 @@ void Writer::write(const VectorPtr& data) {
   auto bytes = data->estimateFlatSize();
   auto numRows = data->size();
   if (flushPolicy_->shouldFlush(getStripeProgress(
-          arrowContext_->stagingRows, arrowContext_->stagingBytes))) {
+          arrowContext_->stagingRows,
+          arrowContext_->stagingBytes,
+          sizeEstimator_))) {
     flush();
   }
 
@@ -279,6 +296,9 @@ std::unique_ptr<dwio::common::Writer> ParquetWriterFactory::createWriter(
     std::unique_ptr<dwio::common::FileSink> sink,
     const dwio::common::WriterOptions& options) {
   auto parquetOptions = getParquetOptions(options);
+  if (FLAGS_parquet_native_writer) {
+    return std::make_unique<NativeWriter>(std::move(sink), parquetOptions);
+  }
   return std::make_unique<Writer>(std::move(sink), parquetOptions);
 }
 
@@ -31,17 +31,41 @@ class ArrowDataBufferSink;
 
 struct ArrowContext;
 
+/// Ends a row group when it has 'rowsInRowGroup' rows, when its estimated
+/// size in the file reaches 'bytesInRowGroup' or when the writer buffers
+/// 'maxBufferedBytes' for it. The writers pass the size of the buffered data
+/// scaled by the ratio of file bytes to buffered bytes of the previous row
+/// groups as StripeProgress::stripeSizeEstimate and the buffered bytes as
+/// StripeProgress::totalMemoryUsage, so that row groups of well compressed
+/// columns are not cut short and the ones of incompressible columns do not
+/// buffer more than the cap.
 class DefaultFlushPolicy : public dwio::common::FlushPolicy {
  public:
   DefaultFlushPolicy()
-      : rowsInRowGroup_(1'024 * 1'024), bytesInRowGroup_(128 * 1'024 * 1'024) {}
+      : DefaultFlushPolicy(1'024 * 1'024, 128 * 1'024 * 1'024) {}
+
+  /// Caps the buffered bytes at 4 times 'bytesInRowGroup'.
   DefaultFlushPolicy(uint64_t rowsInRowGroup, int64_t bytesInRowGroup)
-      : rowsInRowGroup_(rowsInRowGroup), bytesInRowGroup_(bytesInRowGroup) {}
+      : DefaultFlushPolicy(
+            rowsInRowGroup,
+            bytesInRowGroup,
+            bytesInRowGroup > std::numeric_limits<int64_t>::max() / 4
+                ? std::numeric_limits<int64_t>::max()
+                : 4 * bytesInRowGroup) {}
+
+  DefaultFlushPolicy(
+      uint64_t rowsInRowGroup,
+      int64_t bytesInRowGroup,
+      int64_t maxBufferedBytes)
+      : rowsInRowGroup_(rowsInRowGroup),
+        bytesInRowGroup_(bytesInRowGroup),
+        maxBufferedBytes_(maxBufferedBytes) {}
 
   bool shouldFlush(
       const dwio::common::StripeProgress& stripeProgress) override {
     return stripeProgress.stripeRowCount >= rowsInRowGroup_ ||
-        stripeProgress.stripeSizeEstimate >= bytesInRowGroup_;
+        stripeProgress.stripeSizeEstimate >= bytesInRowGroup_ ||
+        stripeProgress.totalMemoryUsage >= maxBufferedBytes_;
   }
 
   void onClose() override {
@@ -56,9 +80,39 @@ class DefaultFlushPolicy : public dwio::common::FlushPolicy {
     return bytesInRowGroup_;
   }
 
+  int64_t maxBufferedBytes() const {
+    return maxBufferedBytes_;
+  }
+
  private:
   const uint64_t rowsInRowGroup_;
   const int64_t bytesInRowGroup_;
+  const int64_t maxBufferedBytes_;
+};
+
+/// Estimates the size in the file of buffered row group data from the row
+/// groups written so far. Until the first row group is written, the estimate
+/// is the buffered size.
+class RowGroupSizeEstimator {
+ public:
+  /// Records that a row group of 'bufferedBytes' took 'fileBytes' in the file.
+  void recordRowGroup(int64_t bufferedBytes, int64_t fileBytes) {
+    if (bufferedBytes > 0) {
+      bufferedBytes_ += bufferedBytes;
+      fileBytes_ += fileBytes;
+    }
+  }
+
+  int64_t estimateFileBytes(int64_t bufferedBytes) const {
+    if (bufferedBytes_ == 0) {
+      return bufferedBytes;
+    }
+    return bufferedBytes * static_cast<double>(fileBytes_) / bufferedBytes_;
+  }
+
+ private:
+  int64_t bufferedBytes_{0};
+  int64_t fileBytes_{0};
 };
 
 class LambdaFlushPolicy : public DefaultFlushPolicy {
@@ -90,6 +144,11 @@ struct WriterOptions {
   // folly/FBVector(https://github.com/facebook/folly/blob/main/folly/docs/FBVector.md#memory-handling).
   double bufferGrowRatio = 1.5;
   common::CompressionKind compression = common::CompressionKind_NONE;
+  // Writes a split block Bloom filter for each column chunk. Only used by
+  // NativeWriter.
+  bool enableBloomFilter = false;
+  // False positive probability the Bloom filters are sized for.
+  double bloomFilterFpp = 0.01;
   velox::memory::MemoryPool* memoryPool;
   // The default factory allows the writer to construct the default flush
   // policy with the configs in its ctor.
@@ -142,6 +201,8 @@ class Writer : public dwio::common::Writer {
   std::shared_ptr<ArrowContext> arrowContext_;
 
   std::unique_ptr<DefaultFlushPolicy> flushPolicy_;
+
+  RowGroupSizeEstimator sizeEstimator_;
 };
 
 class ParquetWriterFactory : public dwio::common::WriterFactory {
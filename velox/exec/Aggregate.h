@@ -23,6 +23,7 @@
 #include "velox/exec/AggregateUtil.h"
 #include "velox/expression/FunctionSignature.h"
 #include "velox/vector/BaseVector.h"
+#include "velox/vector/LazyVector.h"
 
 namespace facebook::velox::exec {
 
@@ -76,6 +77,14 @@ class Aggregate {
     return true;
   }
 
+  /// Returns the bytes allocated by 'this' for state shared by all groups,
+  /// i.e. outside of the group rows and the HashStringAllocator. These count
+  /// towards the memory of the aggregation, e.g. for flushing a partial
+  /// aggregation.
+  virtual uint64_t sharedAllocatedBytes() const {
+    return 0;
+  }
+
   /// Returns true if toIntermediate() is supported.
   virtual bool supportsToIntermediate() const {
     return false;
@@ -133,6 +142,26 @@ class Aggregate {
       const std::vector<VectorPtr>& args,
       bool mayPushdown) = 0;
 
+  // Optional fast path of addRawInput() for group by with the hash table in
+  // array mode, where each group has a dense slot number.
+  // @param groups Same as in addRawInput().
+  // @param slots The slot of the group of each row, i.e. 'groups[row]' is the
+  // group of slot 'slots[row]'. All slots are below 'numSlots'.
+  // @param rows Same as in addRawInput().
+  // @param args Same as in addRawInput().
+  // Aggregates that support this first combine the rows of each slot in
+  // column-wise buffers indexed by slot and then update each group once,
+  // instead of updating a group row for each input row. Returns false if not
+  // supported for 'args', in which case the caller uses addRawInput().
+  virtual bool addRawInputBySlot(
+      char** /*groups*/,
+      const uint64_t* /*slots*/,
+      uint64_t /*numSlots*/,
+      const SelectivityVector& /*rows*/,
+      const std::vector<VectorPtr>& /*args*/) {
+    return false;
+  }
+
   // Updates final accumulators from intermediate results.
   // @param groups Pointers to the start of the group rows. These are aligned
   // with the 'args', e.g. data in the i-th row of the 'args' goes to the i-th
@@ -184,6 +213,31 @@ class Aggregate {
       const std::vector<VectorPtr>& args,
       bool mayPushdown) = 0;
 
+  /// Returns true if retractSingleGroupRawInput() is supported, e.g. the
+  /// aggregate is invertible and removing previously added input restores
+  /// the accumulator to the state it had before that input was added. Window
+  /// functions use this to slide frames without recomputing the aggregation
+  /// for each row.
+  virtual bool supportsRetract() const {
+    return false;
+  }
+
+  /// Removes raw input previously added to the single group via
+  /// addSingleGroupRawInput(). Rows with null arguments are ignored, as they
+  /// are when adding input. The null flag of the group is not updated: the
+  /// caller is expected to re-initialize the group once all the non-null
+  /// input has been removed.
+  /// @param group Pointer to the start of the group row.
+  /// @param rows Rows of the 'args' to remove from the accumulator. 'rows' is
+  /// guaranteed to have at least one active row.
+  /// @param args Raw input to remove from the accumulator.
+  virtual void retractSingleGroupRawInput(
+      char* /*group*/,
+      const SelectivityVector& /*rows*/,
+      const std::vector<VectorPtr>& /*args*/) {
+    VELOX_NYI("retractSingleGroupRawInput not supported");
+  }
+
   // Extracts final results (used for final and single aggregations).
   // @param groups Pointers to the start of the group rows.
   // @param numGroups Number of groups to extract results from.
@@ -341,6 +395,62 @@ class Aggregate {
     }
   }
 
+  // Loads the lazy vector 'arg' for 'rows' into a THook, which adds the values
+  // to 'groups' without materializing them. THook is an AggregationHook.
+  // 'hookArgs' are passed to the constructor of THook after the arguments of
+  // AggregationHook.
+  template <typename THook, typename... HookArgs>
+  void pushdown(
+      char** groups,
+      const SelectivityVector& rows,
+      const VectorPtr& arg,
+      HookArgs&&... hookArgs) {
+    DecodedVector decoded(*arg, rows, false);
+    const vector_size_t* indices = decoded.indices();
+    THook hook(
+        offset_,
+        nullByte_,
+        nullMask_,
+        groups,
+        &numNulls_,
+        std::forward<HookArgs>(hookArgs)...);
+    // The decoded vector does not really keep the info from the 'rows', except
+    // for the 'upper bound' of it. In case not all rows are selected we need to
+    // generate proper indices, which we 'indirect' through the ones we got from
+    // the decoded vector.
+    vector_size_t numIndices{arg->size()};
+    if (not rows.isAllSelected()) {
+      const auto numSelected = rows.countSelected();
+      if (numSelected != arg->size()) {
+        pushdownCustomIndices_.resize(numSelected);
+        vector_size_t tgtIndex{0};
+        rows.template applyToSelected([&](vector_size_t i) {
+          pushdownCustomIndices_[tgtIndex++] = indices[i];
+        });
+        indices = pushdownCustomIndices_.data();
+        numIndices = numSelected;
+      }
+    }
+
+    decoded.base()->as<const LazyVector>()->load(
+        RowSet(indices, numIndices), &hook);
+  }
+
+  // Same as pushdown() for the global aggregation of 'group'.
+  template <typename THook, typename... HookArgs>
+  void pushdownSingleGroup(
+      char* group,
+      const SelectivityVector& rows,
+      const VectorPtr& arg,
+      HookArgs&&... hookArgs) {
+    pushdownGroups_.assign(arg->size(), group);
+    pushdown<THook>(
+        pushdownGroups_.data(),
+        rows,
+        arg,
+        std::forward<HookArgs>(hookArgs)...);
+  }
+
   const TypePtr resultType_;
 
   // Byte position of null flag in group row.
@@ -368,6 +478,9 @@ class Aggregate {
   // sequential.
   std::vector<vector_size_t> pushdownCustomIndices_;
 
+  // The group of each row in pushdownSingleGroup().
+  std::vector<char*> pushdownGroups_;
+
   bool validateIntermediateInputs_ = false;
 };
 
@@ -15,6 +15,9 @@
  */
 
 #include "velox/exec/AggregateWindow.h"
+
+#include <numeric>
+
 #include "velox/common/base/Exceptions.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/WindowFunction.h"
@@ -39,12 +42,13 @@ class AggregateWindowFunction : public exec::WindowFunction {
       velox::memory::MemoryPool* pool,
       HashStringAllocator* stringAllocator,
       const core::QueryConfig& config)
-      : WindowFunction(resultType, pool, stringAllocator) {
+      : WindowFunction(resultType, pool, stringAllocator), name_(name) {
     VELOX_USER_CHECK(
         !ignoreNulls, "Aggregate window functions do not support IGNORE NULLS");
     argTypes_.reserve(args.size());
     argIndices_.reserve(args.size());
     argVectors_.reserve(args.size());
+    decodedArgs_.resize(args.size());
     for (const auto& arg : args) {
       argTypes_.push_back(arg.type);
       if (arg.constantValue) {
@@ -161,14 +165,34 @@ class AggregateWindowFunction : public exec::WindowFunction {
           result);
     } else {
       fillArgVectors(frameMetadata.firstRow, frameMetadata.lastRow);
-      simpleAggregation(
-          validRows,
-          frameMetadata.firstRow,
-          frameMetadata.lastRow,
-          rawFrameStarts,
-          rawFrameEnds,
-          resultOffset,
-          result);
+      if (frameMetadata.slidingAggregation && aggregate_->supportsRetract()) {
+        slidingAggregation(
+            validRows,
+            frameMetadata.firstRow,
+            frameMetadata.lastRow,
+            rawFrameStarts,
+            rawFrameEnds,
+            resultOffset,
+            result);
+      } else if (useSegmentTree(validRows, rawFrameStarts, rawFrameEnds)) {
+        segmentTreeAggregation(
+            validRows,
+            frameMetadata.firstRow,
+            frameMetadata.lastRow,
+            rawFrameStarts,
+            rawFrameEnds,
+            resultOffset,
+            result);
+      } else {
+        simpleAggregation(
+            validRows,
+            frameMetadata.firstRow,
+            frameMetadata.lastRow,
+            rawFrameStarts,
+            rawFrameEnds,
+            resultOffset,
+            result);
+      }
     }
     previousFrameMetadata_ = frameMetadata;
   }
@@ -189,6 +213,11 @@ class AggregateWindowFunction : public exec::WindowFunction {
 
     // Resume incremental aggregation from the prior block.
     bool usePreviousAggregate;
+
+    // If both the frame start and the frame end rows are non-decreasing, then
+    // an aggregate that supports retraction can slide the frame by adding the
+    // rows entering it and retracting the rows leaving it.
+    bool slidingAggregation;
   };
 
   bool handleAllEmptyFrames(
@@ -221,9 +250,11 @@ class AggregateWindowFunction : public exec::WindowFunction {
     vector_size_t firstRow = rawFrameStarts[firstValidRow];
     vector_size_t fixedFrameStartRow = firstRow;
     vector_size_t lastRow = rawFrameEnds[firstValidRow];
+    vector_size_t prevFrameStarts = firstRow;
     vector_size_t prevFrameEnds = lastRow;
 
     bool incrementalAggregation = true;
+    bool slidingAggregation = true;
     validRows.applyToSelected([&](auto i) {
       firstRow = std::min(firstRow, rawFrameStarts[i]);
       lastRow = std::max(lastRow, rawFrameEnds[i]);
@@ -233,6 +264,12 @@ class AggregateWindowFunction : public exec::WindowFunction {
       // ii) The frame end values are non-decreasing.
       incrementalAggregation &= (rawFrameStarts[i] == fixedFrameStartRow);
       incrementalAggregation &= rawFrameEnds[i] >= prevFrameEnds;
+
+      // Sliding aggregation can be done if both the frame start and the frame
+      // end values are non-decreasing.
+      slidingAggregation &= rawFrameStarts[i] >= prevFrameStarts;
+      slidingAggregation &= rawFrameEnds[i] >= prevFrameEnds;
+      prevFrameStarts = rawFrameStarts[i];
       prevFrameEnds = rawFrameEnds[i];
     });
 
@@ -250,7 +287,12 @@ class AggregateWindowFunction : public exec::WindowFunction {
       }
     }
 
-    return {firstRow, lastRow, incrementalAggregation, usePreviousAggregate};
+    return {
+        firstRow,
+        lastRow,
+        incrementalAggregation,
+        usePreviousAggregate,
+        slidingAggregation};
   }
 
   void fillArgVectors(vector_size_t firstRow, vector_size_t lastRow) {
@@ -327,9 +369,8 @@ class AggregateWindowFunction : public exec::WindowFunction {
       // This is a very naive algorithm.
       // It evaluates the entire aggregation for each row by iterating over
       // input rows from frameStart to frameEnd in the SelectivityVector.
-      // TODO : Try to re-use previous computations by advancing and retracting
-      // the aggregation based on the frame changes with each row. This would
-      // require adding new APIs to the Aggregate framework.
+      // Sliding frames of retractable aggregates and large frames are handled
+      // by slidingAggregation and segmentTreeAggregation instead.
       aggregate_->clear();
       aggregate_->initializeNewGroups(&rawSingleGroupRow_, kSingleGroup);
       aggregateInitialized_ = true;
@@ -344,6 +385,260 @@ class AggregateWindowFunction : public exec::WindowFunction {
     setNullEmptyFramesResults(validRows, resultOffset, result);
   }
 
+  // Frees any out of line state of the single group and initializes it again.
+  // Unlike aggregate_->clear(), this leaves the null count of the aggregate
+  // alone, so it is safe to use while other groups (segment tree nodes) hold
+  // null accumulators.
+  void resetSingleGroup() {
+    static const std::vector<vector_size_t> kSingleGroup{0};
+    if (aggregateInitialized_) {
+      aggregate_->destroy(folly::Range(&rawSingleGroupRow_, 1));
+    }
+    aggregate_->initializeNewGroups(&rawSingleGroupRow_, kSingleGroup);
+    aggregateInitialized_ = true;
+  }
+
+  void extractSingleGroupValue(
+      vector_size_t resultRow,
+      const VectorPtr& result) {
+    BaseVector::prepareForReuse(aggregateResultVector_, 1);
+    aggregate_->extractValues(&rawSingleGroupRow_, 1, &aggregateResultVector_);
+    result->copy(aggregateResultVector_.get(), resultRow, 0, 1);
+  }
+
+  // Returns the number of rows in [begin, end) of the argument vectors that
+  // have no null arguments. Aggregates ignore the other rows.
+  vector_size_t countNonNullRows(vector_size_t begin, vector_size_t end) {
+    if (!argsMayHaveNulls_) {
+      return end - begin;
+    }
+    vector_size_t count = 0;
+    for (auto row = begin; row < end; ++row) {
+      bool isNull = false;
+      for (const auto& decoded : decodedArgs_) {
+        if (decoded.isNullAt(row)) {
+          isNull = true;
+          break;
+        }
+      }
+      count += !isNull;
+    }
+    return count;
+  }
+
+  // Evaluates frames with non-decreasing frame starts and ends by adding the
+  // rows that enter the frame and retracting the rows that leave it, so each
+  // input row is added and removed at most once. Requires an aggregate that
+  // supports retraction.
+  void slidingAggregation(
+      const SelectivityVector& validRows,
+      vector_size_t minFrame,
+      vector_size_t maxFrame,
+      const vector_size_t* frameStartsVector,
+      const vector_size_t* frameEndsVector,
+      vector_size_t resultOffset,
+      const VectorPtr& result) {
+    const auto numRows = maxFrame + 1 - minFrame;
+    SelectivityVector rows(numRows);
+    argsMayHaveNulls_ = false;
+    for (auto i = 0; i < argVectors_.size(); ++i) {
+      decodedArgs_[i].decode(*argVectors_[i], rows);
+      argsMayHaveNulls_ |= decodedArgs_[i].mayHaveNulls();
+    }
+
+    aggregate_->clear();
+    resetSingleGroup();
+
+    // The rows of the current frame are [frameBegin, frameEnd) relative to
+    // minFrame.
+    vector_size_t frameBegin = 0;
+    vector_size_t frameEnd = 0;
+    vector_size_t numNonNullRows = 0;
+    validRows.applyToSelected([&](auto i) {
+      const auto begin = frameStartsVector[i] - minFrame;
+      const auto end = frameEndsVector[i] - minFrame + 1;
+      if (begin >= frameEnd) {
+        // The frame doesn't overlap the previous one. Start over.
+        if (numNonNullRows > 0) {
+          resetSingleGroup();
+          numNonNullRows = 0;
+        }
+        frameEnd = begin;
+      } else if (begin > frameBegin) {
+        rows.clearAll();
+        rows.setValidRange(frameBegin, begin, true);
+        rows.updateBounds();
+        aggregate_->retractSingleGroupRawInput(
+            rawSingleGroupRow_, rows, argVectors_);
+        numNonNullRows -= countNonNullRows(frameBegin, begin);
+      }
+
+      if (end > frameEnd) {
+        rows.clearAll();
+        rows.setValidRange(frameEnd, end, true);
+        rows.updateBounds();
+        aggregate_->addSingleGroupRawInput(
+            rawSingleGroupRow_, rows, argVectors_, false);
+        numNonNullRows += countNonNullRows(frameEnd, end);
+      }
+      frameBegin = begin;
+      frameEnd = end;
+
+      // Retraction doesn't restore the null flag of the accumulator. Once the
+      // frame has no input left, start from a fresh accumulator so that the
+      // result is the one for no input, e.g. null for sum.
+      if (numNonNullRows == 0) {
+        resetSingleGroup();
+      }
+      extractSingleGroupValue(resultOffset + i, result);
+    });
+
+    // Set null values for empty (non valid) frames in the output block.
+    setNullEmptyFramesResults(validRows, resultOffset, result);
+  }
+
+  // Returns true if most frames of the block are large enough that combining
+  // O(log n) nodes of a segment tree per frame is cheaper than aggregating all
+  // the rows of each frame.
+  bool useSegmentTree(
+      const SelectivityVector& validRows,
+      const vector_size_t* frameStartsVector,
+      const vector_size_t* frameEndsVector) {
+    int64_t numFrameRows = 0;
+    validRows.applyToSelected([&](auto i) {
+      numFrameRows += frameEndsVector[i] - frameStartsVector[i] + 1;
+    });
+    return numFrameRows >=
+        kMinSegmentTreeAverageFrameSize * validRows.countSelected();
+  }
+
+  // Extracts the accumulators of 'groups' into intermediateVector_.
+  void extractIntermediate(char** groups, vector_size_t numGroups) {
+    if (!intermediateVector_) {
+      intermediateVector_ = BaseVector::create(
+          Aggregate::intermediateType(name_, argTypes_), 0, pool_);
+    }
+    BaseVector::prepareForReuse(intermediateVector_, numGroups);
+    aggregate_->extractAccumulators(groups, numGroups, &intermediateVector_);
+  }
+
+  // Builds a segment tree over the 'numRows' rows of the argument vectors.
+  // Leaf j is node numRows + j and node i combines the accumulators of nodes
+  // 2 * i and 2 * i + 1, in that order, so that order sensitive aggregates
+  // see their input in row order. Node 0 is unused.
+  void buildSegmentTree(vector_size_t numRows) {
+    const auto numNodes = 2 * numRows;
+    const auto nodeSize = bits::roundUp(
+        singleGroupRowSize_, aggregate_->accumulatorAlignmentSize());
+    if (!segmentTreeBuffer_ ||
+        segmentTreeBuffer_->capacity() < numNodes * nodeSize) {
+      segmentTreeBuffer_ =
+          AlignedBuffer::allocate<char>(numNodes * nodeSize, pool_);
+    }
+    auto* rawNodes = segmentTreeBuffer_->asMutable<char>();
+    memset(rawNodes, 0, numNodes * nodeSize);
+    segmentTreeNodes_.resize(numNodes);
+    for (auto i = 0; i < numNodes; ++i) {
+      segmentTreeNodes_[i] = rawNodes + i * nodeSize;
+    }
+
+    std::vector<vector_size_t> nodeIndices(numNodes - 1);
+    std::iota(nodeIndices.begin(), nodeIndices.end(), 1);
+    aggregate_->initializeNewGroups(segmentTreeNodes_.data(), nodeIndices);
+
+    SelectivityVector rows(numRows);
+    aggregate_->addRawInput(
+        segmentTreeNodes_.data() + numRows, rows, argVectors_, false);
+
+    // Combine the children into the parents one level at a time. All nodes in
+    // [begin, end) have their children at or after 'end'.
+    for (auto end = numRows; end > 1;) {
+      const auto begin = std::max<vector_size_t>(1, (end + 1) / 2);
+      const auto numParents = end - begin;
+      rows.resize(numParents);
+      rows.setAll();
+      for (auto child = 0; child < 2; ++child) {
+        groupsToCombine_.resize(numParents);
+        for (auto i = 0; i < numParents; ++i) {
+          groupsToCombine_[i] = segmentTreeNodes_[2 * (begin + i) + child];
+        }
+        extractIntermediate(groupsToCombine_.data(), numParents);
+        aggregate_->addIntermediateResults(
+            segmentTreeNodes_.data() + begin,
+            rows,
+            {intermediateVector_},
+            false);
+      }
+      end = begin;
+    }
+  }
+
+  void destroySegmentTree() {
+    aggregate_->destroy(folly::Range(
+        segmentTreeNodes_.data() + 1, segmentTreeNodes_.size() - 1));
+    segmentTreeNodes_.clear();
+  }
+
+  // Computes the aggregate over rows [begin, end) of the segment tree by
+  // combining the nodes covering the range in row order.
+  void querySegmentTree(
+      vector_size_t numRows,
+      vector_size_t begin,
+      vector_size_t end) {
+    groupsToCombine_.clear();
+    rightNodes_.clear();
+    for (auto left = begin + numRows, right = end + numRows; left < right;
+         left /= 2, right /= 2) {
+      if (left & 1) {
+        groupsToCombine_.push_back(segmentTreeNodes_[left++]);
+      }
+      if (right & 1) {
+        rightNodes_.push_back(segmentTreeNodes_[--right]);
+      }
+    }
+    groupsToCombine_.insert(
+        groupsToCombine_.end(), rightNodes_.rbegin(), rightNodes_.rend());
+
+    extractIntermediate(groupsToCombine_.data(), groupsToCombine_.size());
+    SelectivityVector rows(groupsToCombine_.size());
+    resetSingleGroup();
+    aggregate_->addSingleGroupIntermediateResults(
+        rawSingleGroupRow_, rows, {intermediateVector_}, false);
+  }
+
+  // Evaluates each frame by combining the O(log n) segment tree nodes that
+  // cover it. Used for large frames of aggregates that do not support
+  // retraction, e.g. min and max.
+  void segmentTreeAggregation(
+      const SelectivityVector& validRows,
+      vector_size_t minFrame,
+      vector_size_t maxFrame,
+      const vector_size_t* frameStartsVector,
+      const vector_size_t* frameEndsVector,
+      vector_size_t resultOffset,
+      const VectorPtr& result) {
+    const auto numRows = maxFrame + 1 - minFrame;
+    aggregate_->clear();
+    buildSegmentTree(numRows);
+    validRows.applyToSelected([&](auto i) {
+      querySegmentTree(
+          numRows,
+          frameStartsVector[i] - minFrame,
+          frameEndsVector[i] - minFrame + 1);
+      extractSingleGroupValue(resultOffset + i, result);
+    });
+    destroySegmentTree();
+
+    // Set null values for empty (non valid) frames in the output block.
+    setNullEmptyFramesResults(validRows, resultOffset, result);
+  }
+
+  // Frames with at least this many rows on average are evaluated with a
+  // segment tree if the aggregate does not support retraction.
+  static constexpr int64_t kMinSegmentTreeAverageFrameSize = 32;
+
+  const std::string name_;
+
   // Aggregate function object required for this window function evaluation.
   std::unique_ptr<exec::Aggregate> aggregate_;
 
@@ -374,6 +669,22 @@ class AggregateWindowFunction : public exec::WindowFunction {
   // Stores metadata about the previous output block of the partition
   // to optimize aggregate computation and reading argument vectors.
   std::optional<FrameMetadata> previousFrameMetadata_;
+
+  // Decoded argVectors_ used to find the rows the aggregate ignores when
+  // sliding frames.
+  std::vector<DecodedVector> decodedArgs_;
+  bool argsMayHaveNulls_{false};
+
+  // Accumulators extracted from segment tree nodes to combine them.
+  VectorPtr intermediateVector_;
+
+  // Group rows of the segment tree nodes of the current output block.
+  BufferPtr segmentTreeBuffer_;
+  std::vector<char*> segmentTreeNodes_;
+
+  // Nodes to combine for a parent node or for a frame.
+  std::vector<char*> groupsToCombine_;
+  std::vector<char*> rightNodes_;
 };
 
 } // namespace
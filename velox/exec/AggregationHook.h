@@ -57,6 +57,28 @@ class AggregationHook : public ValueHook {
     return false;
   }
 
+  /// Returns true if the column readers pass the values of columns of 'type'
+  /// to hooks. Readers of different formats pass strings as different types,
+  /// so only hooks that do not look at the values, e.g. 'CountHook', support
+  /// strings.
+  static bool supportsPushdown(const Type& type, bool readsValues = true) {
+    switch (type.kind()) {
+      case TypeKind::BOOLEAN:
+      case TypeKind::TINYINT:
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+      case TypeKind::BIGINT:
+      case TypeKind::REAL:
+      case TypeKind::DOUBLE:
+        return !type.isDecimal();
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+        return !readsValues;
+      default:
+        return false;
+    }
+  }
+
   // Fallback implementation of fast path. Prefer defining special
   // cases for all subclasses.
   void addValues(
@@ -176,6 +198,67 @@ class SimpleCallableHook final : public AggregationHook {
   UpdateSingleValue updateSingleValue_;
 };
 
+/// Calls 'update' with the group of each row and the value of the row, after
+/// clearing the null flag of the group. For accumulators that are not single
+/// numbers, e.g. the sum and count of avg.
+template <typename TValue, typename Update>
+class GroupCallableHook final : public AggregationHook {
+ public:
+  GroupCallableHook(
+      int32_t offset,
+      int32_t nullByte,
+      uint8_t nullMask,
+      char** groups,
+      uint64_t* numNulls,
+      Update update)
+      : AggregationHook(offset, nullByte, nullMask, groups, numNulls),
+        update_(update) {}
+
+  Kind kind() const override {
+    return kGeneric;
+  }
+
+  void addValue(vector_size_t row, const void* value) override {
+    auto group = findGroup(row);
+    clearNull(group);
+    update_(group, *reinterpret_cast<const TValue*>(value));
+  }
+
+ private:
+  Update update_;
+};
+
+/// Counts the non-null values of each group in an int64_t accumulator that is
+/// never null.
+class CountHook final : public AggregationHook {
+ public:
+  CountHook(
+      int32_t offset,
+      int32_t nullByte,
+      uint8_t nullMask,
+      char** groups,
+      uint64_t* numNulls)
+      : AggregationHook(offset, nullByte, nullMask, groups, numNulls) {}
+
+  Kind kind() const override {
+    return kGeneric;
+  }
+
+  void addValue(vector_size_t row, const void* /*value*/) override {
+    ++*reinterpret_cast<int64_t*>(findGroup(row) + offset_);
+  }
+
+  void addValues(
+      const vector_size_t* rows,
+      const void* /*values*/,
+      vector_size_t size,
+      uint8_t /*valueWidth*/) override {
+    for (auto i = 0; i < size; ++i) {
+      ++*reinterpret_cast<int64_t*>(findGroup(rows[i]) + offset_);
+    }
+  }
+};
+
 template <typename T, bool isMin>
 class MinMaxHook final : public AggregationHook {
  public:
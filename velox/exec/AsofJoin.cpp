@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/AsofJoin.h"
+#include "velox/exec/Task.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+bool hasNullKey(
+    const RowVectorPtr& rowVector,
+    vector_size_t index,
+    const std::vector<column_index_t>& keys) {
+  for (auto key : keys) {
+    if (rowVector->childAt(key)->isNullAt(index)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void copyRow(
+    const RowVectorPtr& source,
+    vector_size_t sourceIndex,
+    const RowVectorPtr& target,
+    vector_size_t targetIndex,
+    const std::vector<IdentityProjection>& projections) {
+  for (const auto& projection : projections) {
+    const auto& sourceChild = source->childAt(projection.inputChannel);
+    const auto& targetChild = target->childAt(projection.outputChannel);
+    targetChild->copy(sourceChild.get(), targetIndex, sourceIndex, 1);
+  }
+}
+} // namespace
+
+AsofJoin::AsofJoin(
+    int32_t operatorId,
+    DriverCtx* driverCtx,
+    const std::shared_ptr<const core::AsofJoinNode>& joinNode)
+    : Operator(
+          driverCtx,
+          joinNode->outputType(),
+          operatorId,
+          joinNode->id(),
+          "AsofJoin"),
+      outputBatchSize_{outputBatchRows()},
+      joinType_{joinNode->joinType()},
+      comparison_{joinNode->comparison()},
+      matchesPrecedingRow_{
+          comparison_ ==
+              core::AsofJoinNode::Comparison::kGreaterThanOrEqual ||
+          comparison_ == core::AsofJoinNode::Comparison::kGreaterThan},
+      numKeys_{joinNode->leftKeys().size()} {
+  leftKeys_.reserve(numKeys_);
+  rightKeys_.reserve(numKeys_);
+
+  const auto& leftType = joinNode->sources()[0]->outputType();
+  for (const auto& key : joinNode->leftKeys()) {
+    leftKeys_.push_back(leftType->getChildIdx(key->name()));
+  }
+
+  const auto& rightType = joinNode->sources()[1]->outputType();
+  for (const auto& key : joinNode->rightKeys()) {
+    rightKeys_.push_back(rightType->getChildIdx(key->name()));
+  }
+
+  for (auto i = 0; i < leftType->size(); ++i) {
+    auto outIndex = outputType_->getChildIdxIfExists(leftType->nameOf(i));
+    if (outIndex.has_value()) {
+      leftProjections_.emplace_back(i, outIndex.value());
+    }
+  }
+
+  for (auto i = 0; i < rightType->size(); ++i) {
+    auto outIndex = outputType_->getChildIdxIfExists(rightType->nameOf(i));
+    if (outIndex.has_value()) {
+      rightProjections_.emplace_back(i, outIndex.value());
+    }
+  }
+}
+
+BlockingReason AsofJoin::isBlocked(ContinueFuture* future) {
+  if (futureRightSideInput_.valid()) {
+    *future = std::move(futureRightSideInput_);
+    return BlockingReason::kWaitForMergeJoinRightSide;
+  }
+  return BlockingReason::kNotBlocked;
+}
+
+void AsofJoin::close() {
+  if (rightSource_) {
+    rightSource_->close();
+  }
+  Operator::close();
+}
+
+void AsofJoin::addInput(RowVectorPtr input) {
+  input_ = std::move(input);
+  index_ = 0;
+}
+
+bool AsofJoin::isFinished() {
+  return noMoreInput_ && input_ == nullptr;
+}
+
+int32_t AsofJoin::compareKeys(
+    size_t begin,
+    size_t end,
+    const RowVectorPtr& right,
+    vector_size_t rightIndex) const {
+  for (auto i = begin; i < end; ++i) {
+    auto result = right->childAt(rightKeys_[i])
+                      ->compare(
+                          input_->childAt(leftKeys_[i]).get(),
+                          rightIndex,
+                          index_);
+    if (result != 0) {
+      return result;
+    }
+  }
+  return 0;
+}
+
+bool AsofJoin::isBeforeMatch() const {
+  const auto result = compareEqualityKeys(rightInput_, rightIndex_);
+  if (result != 0) {
+    return result < 0;
+  }
+  const auto asofResult =
+      compareKeys(numKeys_ - 1, numKeys_, rightInput_, rightIndex_);
+  switch (comparison_) {
+    case core::AsofJoinNode::Comparison::kGreaterThanOrEqual:
+    case core::AsofJoinNode::Comparison::kLessThan:
+      return asofResult <= 0;
+    case core::AsofJoinNode::Comparison::kGreaterThan:
+    case core::AsofJoinNode::Comparison::kLessThanOrEqual:
+      return asofResult < 0;
+  }
+  VELOX_UNREACHABLE();
+}
+
+void AsofJoin::advanceRight() {
+  do {
+    ++rightIndex_;
+  } while (rightIndex_ < rightInput_->size() &&
+           hasNullKey(rightInput_, rightIndex_, rightKeys_));
+  if (rightIndex_ == rightInput_->size()) {
+    rightInput_ = nullptr;
+  }
+}
+
+bool AsofJoin::fetchRightInput() {
+  if (!rightSource_) {
+    rightSource_ = operatorCtx_->task()->getMergeJoinSource(
+        operatorCtx_->driverCtx()->splitGroupId, planNodeId());
+  }
+  while (!noMoreRightInput_ && !rightInput_) {
+    auto blockingReason =
+        rightSource_->next(&futureRightSideInput_, &rightInput_);
+    if (blockingReason != BlockingReason::kNotBlocked) {
+      return false;
+    }
+    if (rightInput_) {
+      // Moves the cursor to the first row without null keys.
+      rightIndex_ = -1;
+      advanceRight();
+    } else {
+      noMoreRightInput_ = true;
+    }
+  }
+  return true;
+}
+
+bool AsofJoin::advanceToMatch() {
+  while (rightInput_ != nullptr) {
+    if (!isBeforeMatch()) {
+      return true;
+    }
+    if (matchesPrecedingRow_) {
+      precedingInput_ = rightInput_;
+      precedingIndex_ = rightIndex_;
+    }
+    advanceRight();
+  }
+  return noMoreRightInput_;
+}
+
+std::pair<RowVectorPtr, vector_size_t> AsofJoin::match() const {
+  if (matchesPrecedingRow_) {
+    if (precedingInput_ != nullptr &&
+        compareEqualityKeys(precedingInput_, precedingIndex_) == 0) {
+      return {precedingInput_, precedingIndex_};
+    }
+  } else if (
+      rightInput_ != nullptr &&
+      compareEqualityKeys(rightInput_, rightIndex_) == 0) {
+    return {rightInput_, rightIndex_};
+  }
+  return {nullptr, 0};
+}
+
+void AsofJoin::prepareOutput() {
+  if (output_ == nullptr) {
+    output_ = BaseVector::create<RowVector>(
+        outputType_, outputBatchSize_, operatorCtx_->pool());
+    outputSize_ = 0;
+  }
+}
+
+void AsofJoin::addOutputRow(
+    const RowVectorPtr& right,
+    vector_size_t rightIndex) {
+  copyRow(input_, index_, output_, outputSize_, leftProjections_);
+  if (right != nullptr) {
+    copyRow(right, rightIndex, output_, outputSize_, rightProjections_);
+  } else {
+    for (const auto& projection : rightProjections_) {
+      output_->childAt(projection.outputChannel)->setNull(outputSize_, true);
+    }
+  }
+  ++outputSize_;
+}
+
+RowVectorPtr AsofJoin::getOutput() {
+  // Make sure to have is-blocked or needs-input as true if returning null
+  // output. Otherwise, Driver assumes the operator is finished.
+  for (;;) {
+    if (input_ == nullptr) {
+      return nullptr;
+    }
+
+    if (!rightInput_ && !noMoreRightInput_) {
+      if (!fetchRightInput()) {
+        return nullptr;
+      }
+      continue;
+    }
+
+    prepareOutput();
+    for (; index_ < input_->size(); ++index_) {
+      if (outputSize_ == outputBatchSize_) {
+        return std::move(output_);
+      }
+      if (hasNullKey(input_, index_, leftKeys_)) {
+        if (isLeftJoin(joinType_)) {
+          addOutputRow(nullptr, 0);
+        }
+        continue;
+      }
+      if (!advanceToMatch()) {
+        // Needs the next right side batch to find the match.
+        break;
+      }
+      auto [right, rightIndex] = match();
+      if (right != nullptr || isLeftJoin(joinType_)) {
+        addOutputRow(right, rightIndex);
+      }
+    }
+
+    if (index_ == input_->size()) {
+      // The output of a left side batch is returned when the batch is done.
+      input_ = nullptr;
+      if (outputSize_ == 0) {
+        return nullptr;
+      }
+      output_->resize(outputSize_);
+      return std::move(output_);
+    }
+  }
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/MergeSource.h"
+#include "velox/exec/Operator.h"
+
+namespace facebook::velox::exec {
+
+/// Implements core::AsofJoinNode. Both inputs are sorted in ascending order on
+/// the join keys, so the operator walks them once like MergeJoin: the right
+/// side cursor only moves forward and each left row is joined with at most one
+/// right row. For '>=' and '>' comparisons the match is the last right row the
+/// cursor passed over, for '<=' and '<' it is the row under the cursor. The
+/// right side is read from a MergeJoinSource fed by the right side pipeline.
+class AsofJoin : public Operator {
+ public:
+  AsofJoin(
+      int32_t operatorId,
+      DriverCtx* driverCtx,
+      const std::shared_ptr<const core::AsofJoinNode>& joinNode);
+
+  BlockingReason isBlocked(ContinueFuture* future) override;
+
+  bool needsInput() const override {
+    return input_ == nullptr;
+  }
+
+  void addInput(RowVectorPtr input) override;
+
+  RowVectorPtr getOutput() override;
+
+  bool isFinished() override;
+
+  void close() override;
+
+ private:
+  // Compares the keys at positions ['begin', 'end') of 'leftKeys_' and
+  // 'rightKeys_' of rows 'rightIndex' of 'right' and 'index_' of 'input_'.
+  int32_t compareKeys(
+      size_t begin,
+      size_t end,
+      const RowVectorPtr& right,
+      vector_size_t rightIndex) const;
+
+  // Compares the equality keys of right row 'rightIndex' of 'right' and of
+  // the left row 'index_'.
+  int32_t compareEqualityKeys(
+      const RowVectorPtr& right,
+      vector_size_t rightIndex) const {
+    return compareKeys(0, numKeys_ - 1, right, rightIndex);
+  }
+
+  // Returns true if the right row under the cursor comes before the match of
+  // the left row 'index_', i.e. the cursor needs to move past it.
+  bool isBeforeMatch() const;
+
+  // Moves the right side cursor to the next row without null keys. Clears
+  // 'rightInput_' if there is none in the batch.
+  void advanceRight();
+
+  // Reads the next right side batch into 'rightInput_'. Returns false if
+  // blocked waiting for the right side.
+  bool fetchRightInput();
+
+  // Moves the right side cursor to the match of the left row 'index_'.
+  // Returns false if more right side input is needed.
+  bool advanceToMatch();
+
+  // Returns the batch and index of the match of the left row 'index_' if any
+  // after advanceToMatch().
+  std::pair<RowVectorPtr, vector_size_t> match() const;
+
+  // Initializes 'output_' if it is null.
+  void prepareOutput();
+
+  // Adds the left row 'index_' joined with 'rightIndex' of 'right' to
+  // 'output_'. The right side columns are null if 'right' is null.
+  void addOutputRow(const RowVectorPtr& right, vector_size_t rightIndex);
+
+  // Maximum number of rows in the output batch.
+  const uint32_t outputBatchSize_;
+
+  const core::JoinType joinType_;
+
+  const core::AsofJoinNode::Comparison comparison_;
+
+  // True if the match is the last right row the cursor passed over, which is
+  // the case for '>=' and '>' comparisons.
+  const bool matchesPrecedingRow_;
+
+  // Number of join keys, including the last key compared with 'comparison_'.
+  const size_t numKeys_;
+
+  std::vector<column_index_t> leftKeys_;
+  std::vector<column_index_t> rightKeys_;
+  std::vector<IdentityProjection> leftProjections_;
+  std::vector<IdentityProjection> rightProjections_;
+
+  // Pulls batches of right side input from the right side pipeline.
+  std::shared_ptr<MergeJoinSource> rightSource_;
+
+  // The right side batch under the cursor and the index of the row under the
+  // cursor.
+  RowVectorPtr rightInput_;
+  vector_size_t rightIndex_{0};
+
+  // The last right row the cursor passed over when 'matchesPrecedingRow_'.
+  // Keeps its batch alive after the cursor moved to the next batch.
+  RowVectorPtr precedingInput_;
+  vector_size_t precedingIndex_{0};
+
+  // The left row of 'input_' to process next.
+  vector_size_t index_{0};
+
+  RowVectorPtr output_;
+
+  // Number of rows accumulated in 'output_'.
+  vector_size_t outputSize_{0};
+
+  // A future that will be completed when right side input becomes available.
+  ContinueFuture futureRightSideInput_{ContinueFuture::makeEmpty()};
+
+  // True if all the right side data has been received.
+  bool noMoreRightInput_{false};
+};
+} // namespace facebook::velox::exec
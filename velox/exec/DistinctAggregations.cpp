@@ -49,9 +49,16 @@ class TypedDistinctAggregations : public DistinctAggregations {
                 reinterpret_cast<AccumulatorType*>(group + offset_);
             accumulator->free(*allocator_);
           }
+        },
+        [this](folly::Range<char**> groups, VectorPtr& result) {
+          extractForSpill(groups, result);
         }};
   }
 
+  TypePtr spillType() const override {
+    return ARRAY(inputType_);
+  }
+
   void initializeNewGroups(
       char** groups,
       folly::Range<const vector_size_t*> indices) override {
@@ -99,6 +106,23 @@ class TypedDistinctAggregations : public DistinctAggregations {
     inputForAccumulator_.reset();
   }
 
+  void addSingleGroupSpillInput(
+      char* group,
+      const VectorPtr& input,
+      vector_size_t index) override {
+    decodedSpillInput_.decode(*input);
+    auto* arrayVector = decodedSpillInput_.base()->asUnchecked<ArrayVector>();
+    decodedInput_.decode(*arrayVector->elements());
+
+    auto* accumulator = reinterpret_cast<AccumulatorType*>(group + offset_);
+    RowSizeTracker<char, uint32_t> tracker(group[rowSizeOffset_], *allocator_);
+    accumulator->addValues(
+        *arrayVector,
+        decodedSpillInput_.index(index),
+        decodedInput_,
+        allocator_);
+  }
+
   void extractValues(folly::Range<char**> groups, const RowVectorPtr& result)
       override {
     SelectivityVector rows;
@@ -135,6 +159,43 @@ class TypedDistinctAggregations : public DistinctAggregations {
   }
 
  private:
+  // Copies the unique inputs of 'groups' into 'result' of spillType().
+  void extractForSpill(folly::Range<char**> groups, VectorPtr& result) const {
+    if (result == nullptr) {
+      result = BaseVector::create(spillType(), groups.size(), pool_);
+    } else {
+      result->resize(groups.size());
+    }
+    auto* arrayVector = result->asUnchecked<ArrayVector>();
+    arrayVector->clearNulls(0, groups.size());
+    auto* rawOffsets = arrayVector->mutableOffsets(groups.size())
+                           ->template asMutable<vector_size_t>();
+    auto* rawSizes = arrayVector->mutableSizes(groups.size())
+                         ->template asMutable<vector_size_t>();
+
+    vector_size_t numValues = 0;
+    for (auto i = 0; i < groups.size(); ++i) {
+      auto* accumulator =
+          reinterpret_cast<AccumulatorType*>(groups[i] + offset_);
+      rawOffsets[i] = numValues;
+      rawSizes[i] = accumulator->size();
+      numValues += accumulator->size();
+    }
+
+    auto& elements = arrayVector->elements();
+    elements->resize(numValues);
+    for (auto i = 0; i < groups.size(); ++i) {
+      auto* accumulator =
+          reinterpret_cast<AccumulatorType*>(groups[i] + offset_);
+      if constexpr (std::is_same_v<T, ComplexType>) {
+        accumulator->extractValues(*elements, rawOffsets[i]);
+      } else {
+        accumulator->extractValues(
+            *(elements->template as<FlatVector<T>>()), rawOffsets[i]);
+      }
+    }
+  }
+
   bool isSingleInputAggregate() const {
     return aggregates_[0]->inputs.size() == 1;
   }
@@ -188,6 +249,7 @@ class TypedDistinctAggregations : public DistinctAggregations {
 
   DecodedVector decodedInput_;
   VectorPtr inputForAccumulator_;
+  DecodedVector decodedSpillInput_;
 };
 
 } // namespace
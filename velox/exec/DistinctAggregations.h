@@ -41,6 +41,10 @@ class DistinctAggregations {
 
   virtual Accumulator accumulator() const = 0;
 
+  /// Returns the type of the accumulator when spilled: an array of the unique
+  /// inputs of each group.
+  virtual TypePtr spillType() const = 0;
+
   /// Aggregate-like APIs to aggregate input rows per group.
   void setAllocator(HashStringAllocator* allocator) {
     allocator_ = allocator;
@@ -71,6 +75,13 @@ class DistinctAggregations {
       const RowVectorPtr& input,
       const SelectivityVector& rows) = 0;
 
+  /// Adds the unique inputs spilled for one group in row 'index' of 'input'
+  /// to 'group'. 'input' is of spillType().
+  virtual void addSingleGroupSpillInput(
+      char* group,
+      const VectorPtr& input,
+      vector_size_t index) = 0;
+
   /// Computes aggregations and stores results in the specified 'result' vector.
   virtual void extractValues(
       folly::Range<char**> groups,
@@ -19,6 +19,7 @@
 #include <folly/executors/QueuedImmediateExecutor.h>
 #include <folly/executors/thread_factory/InitThreadFactory.h>
 #include <gflags/gflags.h>
+#include "velox/common/process/ProcessBase.h"
 #include "velox/common/process/TraceContext.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/common/time/Timer.h"
@@ -62,6 +63,11 @@ std::optional<Spiller::Config> DriverCtx::makeSpillConfig(
   if (task->spillDirectory().empty()) {
     return std::nullopt;
   }
+  std::vector<std::string> extraFilePaths;
+  for (const auto& directory : task->extraSpillDirectories()) {
+    extraFilePaths.push_back(
+        makeOperatorSpillPath(directory, pipelineId, driverId, operatorId));
+  }
   return Spiller::Config(
       makeOperatorSpillPath(
           task->spillDirectory(), pipelineId, driverId, operatorId),
@@ -74,7 +80,8 @@ std::optional<Spiller::Config> DriverCtx::makeSpillConfig(
       queryConfig.aggregationSpillPartitionBits(),
       queryConfig.maxSpillLevel(),
       queryConfig.testingSpillPct(),
-      queryConfig.spillCompressionKind());
+      queryConfig.spillCompressionKind(),
+      std::move(extraFilePaths));
 }
 
 std::atomic_uint64_t BlockingState::numBlockedDrivers_{0};
@@ -107,6 +114,22 @@ void BlockingState::setResume(std::shared_ptr<BlockingState> state) {
         auto& driver = state->driver_;
         auto& task = driver->task();
 
+        if (const auto& timeline = task->traceTimeline()) {
+          // 'sinceMicros_' is from a different clock.
+          const auto blockedMicros =
+              getCurrentTimeMicro() - state->sinceMicros_;
+          const auto endMicros = process::TraceTimeline::nowMicros();
+          const auto* ctx = driver->driverCtx();
+          timeline->record(
+              "driver",
+              blockingReasonToString(state->reason_),
+              endMicros - std::min(blockedMicros, endMicros),
+              endMicros,
+              process::TraceTimeline::driverTrack(
+                  ctx->pipelineId, ctx->driverId),
+              0);
+        }
+
         std::lock_guard<std::mutex> l(task->mutex());
         if (!driver->state().isTerminated) {
           state->operator_->recordBlockingTime(
@@ -195,6 +218,26 @@ std::ostream& operator<<(std::ostream& out, const StopReason& reason) {
   return out << stopReasonString(reason);
 }
 
+namespace {
+// Returns the executor priority for a Driver of a task that has spent
+// 'cpuNanos' on threads, divided by the CPU share of its query. A task starts
+// at folly::Executor::MID_PRI and drops one priority each time its CPU time
+// crosses a threshold, so that the Drivers of short tasks run ahead of the
+// ones of long running tasks.
+int8_t driverPriority(uint64_t cpuNanos) {
+  static constexpr uint64_t kLevelThresholdsNanos[] = {
+      1'000'000'000, 10'000'000'000, 60'000'000'000, 300'000'000'000};
+  int8_t priority = folly::Executor::MID_PRI;
+  for (auto threshold : kLevelThresholdsNanos) {
+    if (cpuNanos < threshold) {
+      break;
+    }
+    --priority;
+  }
+  return priority;
+}
+} // namespace
+
 // static
 void Driver::enqueue(std::shared_ptr<Driver> driver) {
   // This is expected to be called inside the Driver's Tasks's mutex.
@@ -202,8 +245,14 @@ void Driver::enqueue(std::shared_ptr<Driver> driver) {
   if (driver->closed_) {
     return;
   }
-  driver->task()->queryCtx()->executor()->add(
-      [driver]() { Driver::run(driver); });
+  auto* executor = driver->task()->queryCtx()->executor();
+  if (executor->getNumPriorities() > 1) {
+    const auto priority =
+        driverPriority(driver->task()->driverCpuNanos() / driver->cpuShare_);
+    executor->addWithPriority([driver]() { Driver::run(driver); }, priority);
+    return;
+  }
+  executor->add([driver]() { Driver::run(driver); });
 }
 
 void Driver::init(
@@ -215,6 +264,12 @@ void Driver::init(
   operators_ = std::move(operators);
   curOpIndex_ = operators_.size() - 1;
   trackOperatorCpuUsage_ = ctx_->queryConfig().operatorTrackCpuUsage();
+  trackOperatorHardwareCounters_ =
+      ctx_->queryConfig().operatorTrackHardwareCounters();
+  timeSliceMicros_ = ctx_->queryConfig().driverTimeSliceMs() * 1'000;
+  cpuShare_ = ctx_->queryConfig().queryCpuShare();
+  VELOX_USER_CHECK_GT(
+      cpuShare_, 0, "{} must be positive", core::QueryConfig::kQueryCpuShare);
 }
 
 namespace {
@@ -284,8 +339,9 @@ RowVectorPtr Driver::next(std::shared_ptr<BlockingState>& blockingState) {
   auto self = shared_from_this();
   facebook::velox::process::ScopedThreadDebugInfo scopedInfo(
       self->driverCtx()->threadDebugInfo);
+  process::ScopedTraceTimeline scopedTimeline(self->task()->traceTimeline());
   RowVectorPtr result;
-  auto stop = runInternal(self, blockingState, result);
+  auto stop = runInternal(self, blockingState, result, false);
 
   // We get kBlock if 'result' was produced; kAtEnd if pipeline has finished
   // processing and no more results will be produced; kAlreadyTerminated on
@@ -321,7 +377,8 @@ void Driver::enqueueInternal() {
 StopReason Driver::runInternal(
     std::shared_ptr<Driver>& self,
     std::shared_ptr<BlockingState>& blockingState,
-    RowVectorPtr& result) {
+    RowVectorPtr& result,
+    bool timeSliced) {
   TestValue::adjust("facebook::velox::exec::Driver::runInternal", self.get());
   const auto now = getCurrentTimeMicro();
   const auto queuedTime = (now - queueTimeStartMicros_) * 1'000;
@@ -369,6 +426,9 @@ StopReason Driver::runInternal(
     close();
   });
 
+  const uint64_t sliceEndMicros =
+      timeSliced && timeSliceMicros_ != 0 ? now + timeSliceMicros_ : 0;
+
   try {
     int32_t numOperators = operators_.size();
     ContinueFuture future;
@@ -381,6 +441,13 @@ StopReason Driver::runInternal(
           return stop;
         }
 
+        if (sliceEndMicros != 0 && getCurrentTimeMicro() >= sliceEndMicros) {
+          // Go back to the executor queue so that other Drivers get to run.
+          operators_[i]->addRuntimeStat("timeSliceYields", RuntimeCounter(1));
+          guard.notThrown();
+          return StopReason::kYield;
+        }
+
         auto op = operators_[i].get();
         // In case we are blocked, this index will point to the operator, whose
         // queuedTime we should update.
@@ -421,6 +488,10 @@ StopReason Driver::runInternal(
                   [op](const CpuWallTiming& deltaTiming) {
                     op->stats().wlock()->getOutputTiming.add(deltaTiming);
                   });
+              auto counters = createDeltaHardwareCounters(
+                  [op](const process::HardwareCounters& delta) {
+                    op->stats().wlock()->hardwareCounters.add(delta);
+                  });
               RuntimeStatWriterScopeGuard statsWriterGuard(op);
               CALL_OPERATOR(result = op->getOutput(), op, "getOutput");
               if (result) {
@@ -442,6 +513,10 @@ StopReason Driver::runInternal(
                   [nextOp](const CpuWallTiming& timing) {
                     nextOp->stats().wlock()->addInputTiming.add(timing);
                   });
+              auto counters = createDeltaHardwareCounters(
+                  [nextOp](const process::HardwareCounters& delta) {
+                    nextOp->stats().wlock()->hardwareCounters.add(delta);
+                  });
               {
                 auto lockedStats = nextOp->stats().wlock();
                 lockedStats->addInputVector(resultBytes, result->size());
@@ -483,6 +558,10 @@ StopReason Driver::runInternal(
                     createDeltaCpuWallTimer([op](const CpuWallTiming& timing) {
                       op->stats().wlock()->finishTiming.add(timing);
                     });
+                auto counters = createDeltaHardwareCounters(
+                    [op](const process::HardwareCounters& delta) {
+                      op->stats().wlock()->hardwareCounters.add(delta);
+                    });
                 RuntimeStatWriterScopeGuard statsWriterGuard(nextOp);
                 TestValue::adjust(
                     "facebook::velox::exec::Driver::runInternal::noMoreInput",
@@ -502,6 +581,10 @@ StopReason Driver::runInternal(
                 createDeltaCpuWallTimer([op](const CpuWallTiming& timing) {
                   op->stats().wlock()->getOutputTiming.add(timing);
                 });
+            auto counters = createDeltaHardwareCounters(
+                [op](const process::HardwareCounters& delta) {
+                  op->stats().wlock()->hardwareCounters.add(delta);
+                });
             CALL_OPERATOR(result = op->getOutput(), op, "getOutput");
             if (result) {
               VELOX_CHECK(
@@ -545,13 +628,48 @@ StopReason Driver::runInternal(
 #undef CALL_OPERATOR
 
 // static
+void Driver::recordNumaNode() {
+  if (process::numaNodeCount() <= 1 || operators_.empty()) {
+    return;
+  }
+  const auto node = process::currentNumaNode();
+  if (numaNode_ < 0) {
+    numaNode_ = node;
+  } else if (node != numaNode_) {
+    operators_[0]->addRuntimeStat("numaRemoteRuns", RuntimeCounter(1));
+  }
+}
+
 void Driver::run(std::shared_ptr<Driver> self) {
   process::TraceContext trace("Driver::run");
   facebook::velox::process::ScopedThreadDebugInfo scopedInfo(
       self->driverCtx()->threadDebugInfo);
+  const auto& timeline = self->task()->traceTimeline();
+  process::ScopedTraceTimeline scopedTimeline(timeline);
+  const auto runStartMicros =
+      timeline ? process::TraceTimeline::nowMicros() : 0;
+  self->recordNumaNode();
   std::shared_ptr<BlockingState> blockingState;
   RowVectorPtr nullResult;
-  auto reason = self->runInternal(self, blockingState, nullResult);
+  StopReason reason;
+  {
+    DeltaCpuWallTimer timer([task = self->task()](const CpuWallTiming& timing) {
+      task->addDriverCpuNanos(timing.cpuNanos);
+    });
+    reason = self->runInternal(self, blockingState, nullResult, true);
+  }
+  if (timeline) {
+    const auto* ctx = self->driverCtx();
+    timeline->record(
+        "driver",
+        fmt::format(
+            "Driver {}.{} {}",
+            ctx->pipelineId,
+            ctx->driverId,
+            stopReasonString(reason)),
+        runStartMicros,
+        process::TraceTimeline::nowMicros());
+  }
 
   // When Driver runs on an executor, the last operator (sink) must not produce
   // any results.
@@ -614,6 +732,7 @@ void Driver::closeOperators() {
 
   // Add operator stats to the task.
   for (auto& op : operators_) {
+    op->recordVectorPoolStats();
     auto stats = op->stats(true);
     stats.memoryStats.update(op->pool());
     stats.numDrivers = 1;
@@ -799,6 +918,8 @@ std::string blockingReasonToString(BlockingReason reason) {
       return "kWaitForConnector";
     case BlockingReason::kWaitForSpill:
       return "kWaitForSpill";
+    case BlockingReason::kWaitForPeers:
+      return "kWaitForPeers";
   }
   VELOX_UNREACHABLE();
   return "";
@@ -20,6 +20,7 @@
 #include <memory>
 
 #include "velox/common/future/VeloxPromise.h"
+#include "velox/common/process/PerfCounters.h"
 #include "velox/common/process/ThreadDebugInfo.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/connectors/Connector.h"
@@ -161,6 +162,9 @@ enum class BlockingReason {
   /// Build operator is blocked waiting for all its peers to stop to run group
   /// spill on all of them.
   kWaitForSpill,
+  /// Aggregation operator is blocked waiting for the last of its peers to
+  /// merge the hash tables of all peers.
+  kWaitForPeers,
 };
 
 std::string blockingReasonToString(BlockingReason reason);
@@ -329,25 +333,51 @@ class Driver : public std::enable_shared_from_this<Driver> {
 
   static void run(std::shared_ptr<Driver> self);
 
+  // Runs the operators until blocked, out of work or stopped by the Task. If
+  // 'timeSliced' is true, also returns kYield after 'timeSliceMicros_' on
+  // thread.
   StopReason runInternal(
       std::shared_ptr<Driver>& self,
       std::shared_ptr<BlockingState>& blockingState,
-      RowVectorPtr& result);
+      RowVectorPtr& result,
+      bool timeSliced);
 
   void close();
 
+  // On a machine with more than one NUMA node, remembers the node of the first
+  // run on an executor thread and counts the runs on other nodes in the
+  // 'numaRemoteRuns' runtime stat of the first operator. Memory allocated by
+  // the operators during the first run is likely on the first node, so these
+  // runs are likely to access remote memory.
+  void recordNumaNode();
+
   // Push down dynamic filters produced by the operator at the specified
   // position in the pipeline.
   void pushdownFilters(int operatorIndex);
 
   /// If 'trackOperatorCpuUsage_' is true, returns initialized timer object to
-  /// track cpu and wall time of an operation. Returns null otherwise.
+  /// track cpu and wall time of an operation. Returns empty otherwise.
   /// The delta CpuWallTiming object would be passes to 'func' upon
-  /// destruction of the timer.
+  /// destruction of the timer. The cpu time is sampled, see
+  /// SampledCpuWallTimer.
+  template <typename F>
+  std::optional<SampledDeltaCpuWallTimer<F>> createDeltaCpuWallTimer(
+      F&& func) {
+    if (!trackOperatorCpuUsage_) {
+      return std::nullopt;
+    }
+    return std::optional<SampledDeltaCpuWallTimer<F>>(
+        std::in_place, std::move(func));
+  }
+
+  /// If 'trackOperatorHardwareCounters_' is true, returns an object that
+  /// passes the hardware counters of the calling thread from its construction
+  /// to its destruction to 'func'. Returns null otherwise.
   template <typename F>
-  std::unique_ptr<DeltaCpuWallTimer<F>> createDeltaCpuWallTimer(F&& func) {
-    return trackOperatorCpuUsage_
-        ? std::make_unique<DeltaCpuWallTimer<F>>(std::move(func))
+  std::unique_ptr<process::DeltaHardwareCounters<F>>
+  createDeltaHardwareCounters(F&& func) {
+    return trackOperatorHardwareCounters_
+        ? std::make_unique<process::DeltaHardwareCounters<F>>(std::move(func))
         : nullptr;
   }
 
@@ -370,6 +400,18 @@ class Driver : public std::enable_shared_from_this<Driver> {
 
   bool trackOperatorCpuUsage_;
 
+  bool trackOperatorHardwareCounters_;
+
+  // The max time a Driver runs on an executor thread before yielding. 0 means
+  // no limit.
+  uint64_t timeSliceMicros_{0};
+
+  // The CPU share of the query. See QueryConfig::kQueryCpuShare.
+  double cpuShare_{1};
+
+  // NUMA node of the first run on an executor thread or -1.
+  int32_t numaNode_{-1};
+
   // Indicates that a DriverAdapter can rearrange Operators. Set to false at end
   // of DriverFactory::createDriver().
   bool isAdaptable_{true};
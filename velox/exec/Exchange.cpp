@@ -18,6 +18,39 @@
 
 namespace facebook::velox::exec {
 
+std::unique_ptr<VectorSerde::Options> makeExchangeSerdeOptions(
+    const core::QueryConfig& config,
+    serializer::presto::PrestoVectorSerde::CompressionStats* stats) {
+  const auto compressionKind =
+      common::stringToCompressionKind(config.exchangeCompressionKind());
+  if (compressionKind == common::CompressionKind_NONE) {
+    return nullptr;
+  }
+  auto options =
+      std::make_unique<serializer::presto::PrestoVectorSerde::PrestoOptions>();
+  options->compressionKind = compressionKind;
+  options->compressionStats = stats;
+  return options;
+}
+
+VectorSerde* getExchangeSerde(const core::QueryConfig& config) {
+  const auto name = config.exchangeSerde();
+  return name.empty() ? getVectorSerde() : getNamedVectorSerde(name);
+}
+
+void recordDecompressionStats(
+    serializer::presto::PrestoVectorSerde::CompressionStats& stats,
+    Operator& op) {
+  if (stats.decompressionTimeUs == 0) {
+    return;
+  }
+  op.addRuntimeStat(
+      "decompressionWallNanos",
+      RuntimeCounter(
+          stats.decompressionTimeUs * 1'000, RuntimeCounter::Unit::kNanos));
+  stats.decompressionTimeUs = 0;
+}
+
 bool Exchange::getSplits(ContinueFuture* future) {
   if (!processSplits_) {
     return false;
@@ -108,7 +141,11 @@ RowVectorPtr Exchange::getOutput() {
   }
 
   getSerde()->deserialize(
-      inputStream_.get(), operatorCtx_->pool(), outputType_, &result_);
+      inputStream_.get(),
+      operatorCtx_->pool(),
+      outputType_,
+      &result_,
+      serdeOptions_.get());
 
   {
     auto lockedStats = stats_.wlock();
@@ -128,6 +165,7 @@ void Exchange::close() {
   SourceOperator::close();
   currentPage_ = nullptr;
   result_ = nullptr;
+  recordDecompressionStats(compressionStats_, *this);
   if (exchangeClient_) {
     recordExchangeClientStats();
     exchangeClient_->close();
@@ -148,7 +186,7 @@ void Exchange::recordExchangeClientStats() {
 }
 
 VectorSerde* Exchange::getSerde() {
-  return getVectorSerde();
+  return serde_;
 }
 
 } // namespace facebook::velox::exec
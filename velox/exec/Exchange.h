@@ -17,6 +17,7 @@
 
 #include "velox/exec/ExchangeClient.h"
 #include "velox/exec/Operator.h"
+#include "velox/serializers/PrestoSerializer.h"
 
 namespace facebook::velox::exec {
 
@@ -31,6 +32,23 @@ struct RemoteConnectorSplit : public connector::ConnectorSplit {
   }
 };
 
+/// Returns the options for deserializing exchange pages compressed with
+/// QueryConfig::exchangeCompressionKind(), which add their decompression time
+/// to 'stats'. Returns nullptr if exchange pages are not compressed.
+std::unique_ptr<VectorSerde::Options> makeExchangeSerdeOptions(
+    const core::QueryConfig& config,
+    serializer::presto::PrestoVectorSerde::CompressionStats* stats);
+
+/// Adds the decompression time in 'stats' to the runtime stats of 'op' and
+/// resets it.
+void recordDecompressionStats(
+    serializer::presto::PrestoVectorSerde::CompressionStats& stats,
+    Operator& op);
+
+/// Returns the named vector serde of QueryConfig::exchangeSerde() or the
+/// default vector serde if the name is empty.
+VectorSerde* getExchangeSerde(const core::QueryConfig& config);
+
 class Exchange : public SourceOperator {
  public:
   Exchange(
@@ -46,6 +64,9 @@ class Exchange : public SourceOperator {
             exchangeNode->id(),
             operatorType),
         processSplits_{operatorCtx_->driverCtx()->driverId == 0},
+        serde_{getExchangeSerde(ctx->queryConfig())},
+        serdeOptions_{
+            makeExchangeSerdeOptions(ctx->queryConfig(), &compressionStats_)},
         exchangeClient_{std::move(exchangeClient)} {}
 
   ~Exchange() override {
@@ -86,6 +107,15 @@ class Exchange : public SourceOperator {
   /// there are more splits available or no-more-splits signal has arrived.
   ContinueFuture splitFuture_{ContinueFuture::makeEmpty()};
 
+  VectorSerde* const serde_;
+
+  /// Decompression time of the pages. Declared before 'serdeOptions_' which
+  /// points to it.
+  serializer::presto::PrestoVectorSerde::CompressionStats compressionStats_;
+  /// Options for deserializing the pages. nullptr if pages are not
+  /// compressed.
+  const std::unique_ptr<VectorSerde::Options> serdeOptions_;
+
   RowVectorPtr result_;
   std::shared_ptr<ExchangeClient> exchangeClient_;
   std::unique_ptr<SerializedPage> currentPage_;
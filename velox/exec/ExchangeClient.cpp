@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/ExchangeClient.h"
+#include "velox/common/time/Timer.h"
 
 namespace facebook::velox::exec {
 
@@ -101,6 +102,21 @@ folly::F14FastMap<std::string, RuntimeMetric> ExchangeClient::stats() const {
   stats["numReceivedPages"] = RuntimeMetric(queue_->receivedPages());
   stats["averageReceivedPageBytes"] = RuntimeMetric(
       queue_->averageReceivedPageBytes(), RuntimeCounter::Unit::kBytes);
+  stats["pageWaitWallNanos"] = RuntimeMetric(
+      queue_->pageWaitTimeUs() * 1'000, RuntimeCounter::Unit::kNanos);
+  stats["maxPageWaitWallNanos"] = RuntimeMetric(
+      queue_->maxPageWaitTimeUs() * 1'000, RuntimeCounter::Unit::kNanos);
+  // One value per source, so that min and max show the slowest and fastest
+  // producer.
+  RuntimeMetric requestWait(RuntimeCounter::Unit::kNanos);
+  for (const auto& source : sources_) {
+    auto it = requestWaitTimeUs_.find(source.get());
+    requestWait.addValue(
+        it == requestWaitTimeUs_.end() ? 0 : it->second * 1'000);
+  }
+  if (requestWait.count > 0) {
+    stats["sourceRequestWaitWallNanos"] = requestWait;
+  }
 
   return stats;
 }
@@ -132,13 +148,16 @@ std::unique_ptr<SerializedPage> ExchangeClient::next(
 
 void ExchangeClient::request(const RequestSpec& requestSpec) {
   for (auto& source : requestSpec.sources) {
+    const auto startUs = getCurrentTimeMicro();
     auto future = source->request(requestSpec.maxBytes);
     if (future.valid()) {
       auto& exec = folly::QueuedImmediateExecutor::instance();
       std::move(future)
           .via(&exec)
-          .thenValue(
-              [&](auto&& /* unused */) { request(pickSourcesToRequest()); })
+          .thenValue([&, source, startUs](auto&& /* unused */) {
+            addRequestWaitTime(source.get(), startUs);
+            request(pickSourcesToRequest());
+          })
           .thenError(
               folly::tag_t<std::exception>{},
               [&](const std::exception& e) { queue_->setError(e.what()); });
@@ -146,6 +165,14 @@ void ExchangeClient::request(const RequestSpec& requestSpec) {
   }
 }
 
+void ExchangeClient::addRequestWaitTime(
+    const ExchangeSource* source,
+    uint64_t startUs) {
+  const auto nowUs = getCurrentTimeMicro();
+  std::lock_guard<std::mutex> l(queue_->mutex());
+  requestWaitTimeUs_[source] += nowUs > startUs ? nowUs - startUs : 0;
+}
+
 int32_t ExchangeClient::countPendingSourcesLocked() {
   int32_t numPending = 0;
   for (auto& source : sources_) {
@@ -171,17 +198,37 @@ int64_t ExchangeClient::getAveragePageSize() {
   return averagePageSize;
 }
 
-int32_t ExchangeClient::getNumSourcesToRequestLocked(int64_t averagePageSize) {
+int64_t ExchangeClient::maxQueuedBytesLocked(int64_t averagePageSize) {
+  int64_t maxQueuedBytes = maxQueuedBytes_;
+  const auto drainRate =
+      queue_->drainBytesPerSecondLocked(getCurrentTimeMicro());
+  if (drainRate.has_value()) {
+    const double drainBytes = *drainRate * kMaxQueuedDrainTimeUs / 1'000'000;
+    if (drainBytes < maxQueuedBytes) {
+      maxQueuedBytes = drainBytes;
+    }
+  }
+  // The queued pages are not allocated from 'pool_' but take memory all the
+  // same. Leave room for the rest of the query.
+  const auto* root = pool_->root();
+  const auto freeBytes = root->maxCapacity() - root->currentBytes();
+  maxQueuedBytes = std::min<int64_t>(maxQueuedBytes, freeBytes / 2);
+  return std::max(maxQueuedBytes, averagePageSize);
+}
+
+int32_t ExchangeClient::getNumSourcesToRequestLocked(
+    int64_t averagePageSize,
+    int64_t maxQueuedBytes) {
   if (!allSourcesSupportFlowControl_) {
     return sources_.size();
   }
 
-  // Figure out how many more 'averagePageSize' fit into 'maxQueuedBytes_'.
+  // Figure out how many more 'averagePageSize' fit into 'maxQueuedBytes'.
   // Make sure to leave room for 'numPending' pages.
   const auto numPending = countPendingSourcesLocked();
 
   auto numToRequest = std::max<int32_t>(
-      1, (maxQueuedBytes_ - queue_->totalBytes()) / averagePageSize);
+      1, (maxQueuedBytes - queue_->totalBytes()) / averagePageSize);
   if (numToRequest <= numPending) {
     return 0;
   }
@@ -195,7 +242,12 @@ ExchangeClient::RequestSpec ExchangeClient::pickSourcesToRequestLocked() {
   }
 
   const auto averagePageSize = getAveragePageSize();
-  const auto numToRequest = getNumSourcesToRequestLocked(averagePageSize);
+  const auto maxQueuedBytes = maxQueuedBytesLocked(averagePageSize);
+  if (queue_->totalBytes() >= maxQueuedBytes) {
+    return {};
+  }
+  const auto numToRequest =
+      getNumSourcesToRequestLocked(averagePageSize, maxQueuedBytes);
 
   if (numToRequest == 0) {
     return {};
@@ -27,6 +27,10 @@ class ExchangeClient {
  public:
   static constexpr int32_t kDefaultMaxQueuedBytes = 32 << 20; // 32 MB.
 
+  // The queued bytes are limited to what the consumer is measured to drain in
+  // this many microseconds.
+  static constexpr uint64_t kMaxQueuedDrainTimeUs = 1'000'000;
+
   ExchangeClient(
       std::string taskId,
       int destination,
@@ -82,7 +86,15 @@ class ExchangeClient {
 
   int64_t getAveragePageSize();
 
-  int32_t getNumSourcesToRequestLocked(int64_t averagePageSize);
+  // Returns the bytes up to which to fill the queue. This is
+  // 'maxQueuedBytes_' reduced to what the consumer drains in
+  // kMaxQueuedDrainTimeUs and to half the memory left in the root pool of
+  // 'pool_', but at least 'averagePageSize'.
+  int64_t maxQueuedBytesLocked(int64_t averagePageSize);
+
+  int32_t getNumSourcesToRequestLocked(
+      int64_t averagePageSize,
+      int64_t maxQueuedBytes);
 
   RequestSpec pickSourcesToRequest();
 
@@ -92,6 +104,9 @@ class ExchangeClient {
 
   void request(const RequestSpec& requestSpec);
 
+  // Adds the time since 'startUs' to the request wait time of 'source'.
+  void addRequestWaitTime(const ExchangeSource* source, uint64_t startUs);
+
   // Handy for ad-hoc logging.
   const std::string taskId_;
   const int destination_;
@@ -100,6 +115,8 @@ class ExchangeClient {
   std::shared_ptr<ExchangeQueue> queue_;
   std::unordered_set<std::string> taskIds_;
   std::vector<std::shared_ptr<ExchangeSource>> sources_;
+  // Total time in microseconds each source took to respond to requests.
+  folly::F14FastMap<const ExchangeSource*, uint64_t> requestWaitTimeUs_;
   bool allSourcesSupportFlowControl_{true};
   uint32_t nextSourceIndex_{0};
   bool closed_{false};
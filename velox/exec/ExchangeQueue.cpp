@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/ExchangeQueue.h"
+#include "velox/common/time/Timer.h"
 
 namespace facebook::velox::exec {
 
@@ -40,9 +41,42 @@ SerializedPage::~SerializedPage() {
 }
 
 void SerializedPage::prepareStreamForDeserialize(ByteStream* input) {
+  VELOX_CHECK(!isSpilled(), "Cannot deserialize a spilled page");
   input->resetInput(std::move(ranges_));
 }
 
+std::unique_ptr<folly::IOBuf> SerializedPage::getIOBuf() const {
+  std::function<std::unique_ptr<folly::IOBuf>()> loader;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (loader_ == nullptr) {
+      return iobuf_->clone();
+    }
+    loader = loader_;
+  }
+  return loader();
+}
+
+void SerializedPage::startSpill() {
+  VELOX_CHECK(canSpill());
+  spilled_ = true;
+}
+
+void SerializedPage::setSpilled(
+    std::function<std::unique_ptr<folly::IOBuf>()> loader) {
+  VELOX_CHECK(spilled_);
+  VELOX_CHECK_NOT_NULL(loader);
+  // Frees the data outside of 'mutex_'.
+  std::unique_ptr<folly::IOBuf> iobuf;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK_NULL(loader_);
+    loader_ = std::move(loader);
+    ranges_.clear();
+    iobuf = std::move(iobuf_);
+  }
+}
+
 void ExchangeQueue::noMoreSources() {
   std::vector<ContinuePromise> promises;
   {
@@ -83,7 +117,12 @@ void ExchangeQueue::enqueueLocked(
   ++receivedPages_;
   receivedBytes_ += page->size();
 
+  const auto nowUs = getCurrentTimeMicro();
+  if (queue_.empty()) {
+    backlogStartUs_ = nowUs;
+  }
   queue_.push_back(std::move(page));
+  enqueueTimesUs_.push_back(nowUs);
   if (!promises_.empty()) {
     // Resume one of the waiting drivers.
     promises.push_back(std::move(promises_.back()));
@@ -109,13 +148,45 @@ std::unique_ptr<SerializedPage> ExchangeQueue::dequeueLocked(
     }
     return nullptr;
   }
+  const auto nowUs = getCurrentTimeMicro();
+  const auto waitTimeUs = elapsedUs(enqueueTimesUs_.front(), nowUs);
+  pageWaitTimeUs_ += waitTimeUs;
+  maxPageWaitTimeUs_ = std::max(maxPageWaitTimeUs_, waitTimeUs);
   auto page = std::move(queue_.front());
   queue_.pop_front();
+  enqueueTimesUs_.pop_front();
   *atEnd = false;
   totalBytes_ -= page->size();
+
+  windowBytes_ += page->size();
+  if (queue_.empty()) {
+    windowBacklogUs_ += elapsedUs(backlogStartUs_, nowUs);
+  }
+  const auto backlogUs = backlogTimeUsLocked(nowUs);
+  if (backlogUs >= kDrainRateWindowUs) {
+    drainBytesPerSecond_ = windowBytes_ * 1'000'000.0 / backlogUs;
+    windowBytes_ = 0;
+    windowBacklogUs_ = 0;
+    backlogStartUs_ = nowUs;
+  }
   return page;
 }
 
+std::optional<double> ExchangeQueue::drainBytesPerSecondLocked(
+    uint64_t nowUs) const {
+  const auto backlogUs = backlogTimeUsLocked(nowUs);
+  if (backlogUs < kDrainRateWindowUs) {
+    return drainBytesPerSecond_;
+  }
+  // The consumer has not completed the current window in time, e.g. it is
+  // blocked on something else. The partial window is then the better
+  // estimate if it is lower.
+  const double current = windowBytes_ * 1'000'000.0 / backlogUs;
+  return drainBytesPerSecond_.has_value()
+      ? std::min(*drainBytesPerSecond_, current)
+      : current;
+}
+
 void ExchangeQueue::setError(const std::string& error) {
   std::vector<ContinuePromise> promises;
   {
@@ -128,6 +199,7 @@ void ExchangeQueue::setError(const std::string& error) {
     // NOTE: clear the serialized page queue as we won't consume from an
     // errored queue.
     queue_.clear();
+    enqueueTimesUs_.clear();
     promises = clearAllPromisesLocked();
   }
   clearPromises(promises);
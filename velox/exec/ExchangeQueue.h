@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <optional>
+
 #include "velox/common/memory/ByteStream.h"
 
 namespace facebook::velox::exec {
@@ -39,8 +41,28 @@ class SerializedPage {
   // VectorStreamGroup::read().
   void prepareStreamForDeserialize(ByteStream* input);
 
-  std::unique_ptr<folly::IOBuf> getIOBuf() const {
-    return iobuf_->clone();
+  // Returns a shallow copy of the data, or reads it back if spilled. May run
+  // concurrently with setSpilled().
+  std::unique_ptr<folly::IOBuf> getIOBuf() const;
+
+  /// Returns true if the data can be moved out of memory with startSpill().
+  bool canSpill() const {
+    return !spilled_ && !onDestructionCb_;
+  }
+
+  /// Marks the page as being moved out of memory. The data stays in memory
+  /// until setSpilled(). Must be serialized with canSpill() and isSpilled() by
+  /// the owner.
+  void startSpill();
+
+  /// Frees the in-memory data after it has been written elsewhere, e.g. to
+  /// disk. getIOBuf() then gets the data from 'loader'. A spilled page cannot
+  /// be deserialized in place.
+  void setSpilled(std::function<std::unique_ptr<folly::IOBuf>()> loader);
+
+  /// Returns true from startSpill() on.
+  bool isSpilled() const {
+    return spilled_;
   }
 
  private:
@@ -55,9 +77,17 @@ class SerializedPage {
   // Buffers containing the serialized data. The memory is owned by 'iobuf_'.
   std::vector<ByteRange> ranges_;
 
-  // IOBuf holding the data in 'ranges_.
+  // IOBuf holding the data in 'ranges_. nullptr if spilled.
   std::unique_ptr<folly::IOBuf> iobuf_;
 
+  // Returns the data of a spilled page.
+  std::function<std::unique_ptr<folly::IOBuf>()> loader_;
+
+  // Serializes getIOBuf() with setSpilled().
+  mutable std::mutex mutex_;
+
+  bool spilled_{false};
+
   // Number of payload bytes in 'iobuf_'.
   const int64_t iobufBytes_;
 
@@ -125,6 +155,24 @@ class ExchangeQueue {
     return receivedPages_ > 0 ? receivedBytes_ / receivedPages_ : 0;
   }
 
+  /// Returns the total time in microseconds the dequeued pages spent in 'this'
+  /// waiting for the consumer.
+  uint64_t pageWaitTimeUs() const {
+    return pageWaitTimeUs_;
+  }
+
+  /// Returns the longest time in microseconds a dequeued page spent in 'this'.
+  uint64_t maxPageWaitTimeUs() const {
+    return maxPageWaitTimeUs_;
+  }
+
+  /// Returns the rate in bytes per second at which the consumer dequeues pages
+  /// while there are pages to dequeue, or std::nullopt until the consumer has
+  /// been measured for kDrainRateWindowUs. Time with an empty queue does not
+  /// count, so a slow producer does not look like a slow consumer. 'nowUs' is
+  /// the current time in microseconds.
+  std::optional<double> drainBytesPerSecondLocked(uint64_t nowUs) const;
+
   void addSourceLocked() {
     VELOX_CHECK(!noMoreSources_, "addSource called after noMoreSources");
     numSources_++;
@@ -135,8 +183,26 @@ class ExchangeQueue {
   void close();
 
  private:
+  // Length of the window over which drainBytesPerSecondLocked() measures the
+  // consumer.
+  static constexpr uint64_t kDrainRateWindowUs = 1'000'000;
+
+  // Returns the microseconds from 'startUs' to 'endUs', or 0 if the clock
+  // went back.
+  static uint64_t elapsedUs(uint64_t startUs, uint64_t endUs) {
+    return endUs > startUs ? endUs - startUs : 0;
+  }
+
+  // Returns the time in microseconds in the current drain rate window during
+  // which 'queue_' was not empty.
+  uint64_t backlogTimeUsLocked(uint64_t nowUs) const {
+    return windowBacklogUs_ +
+        (queue_.empty() ? 0 : elapsedUs(backlogStartUs_, nowUs));
+  }
+
   std::vector<ContinuePromise> closeLocked() {
     queue_.clear();
+    enqueueTimesUs_.clear();
     return clearAllPromisesLocked();
   }
 
@@ -174,6 +240,8 @@ class ExchangeQueue {
 
   std::mutex mutex_;
   std::deque<std::unique_ptr<SerializedPage>> queue_;
+  // Time in microseconds when each page in 'queue_' was enqueued.
+  std::deque<uint64_t> enqueueTimesUs_;
   std::vector<ContinuePromise> promises_;
   // When set, all promises will be realized and the next dequeue will
   // throw an exception with this message.
@@ -187,5 +255,17 @@ class ExchangeQueue {
   int64_t receivedBytes_{0};
   // Maximum value of totalBytes_.
   int64_t peakBytes_{0};
+  // Total and maximum time dequeued pages spent in 'queue_'.
+  uint64_t pageWaitTimeUs_{0};
+  uint64_t maxPageWaitTimeUs_{0};
+  // Drain rate of the last complete window, if any.
+  std::optional<double> drainBytesPerSecond_;
+  // Bytes dequeued in the current window.
+  uint64_t windowBytes_{0};
+  // Time in the current window with a non-empty 'queue_', excluding the time
+  // since 'backlogStartUs_' if 'queue_' is not empty.
+  uint64_t windowBacklogUs_{0};
+  // Time when 'queue_' last became non-empty or the current window started.
+  uint64_t backlogStartUs_{0};
 };
 } // namespace facebook::velox::exec
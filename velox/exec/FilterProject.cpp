@@ -17,6 +17,7 @@
 #include "velox/core/Expressions.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/FieldReference.h"
+#include "velox/vector/FlatVector.h"
 
 namespace facebook::velox::exec {
 namespace {
@@ -39,6 +40,45 @@ bool checkAddIdentityProjection(
 
   return false;
 }
+
+// Returns true if 'result' is a flat vector of a primitive type that is
+// referenced only by 'result' and can be modified in place.
+bool canCompact(const VectorPtr& result) {
+  if (!result || !result.unique() || !result->isFlatEncoding() ||
+      result->isCodegenOutput() || !result->type()->isPrimitiveType() ||
+      result->typeKind() == TypeKind::UNKNOWN) {
+    return false;
+  }
+  const auto& values = result->values();
+  const auto& nulls = result->nulls();
+  return values && values->isMutable() && (!nulls || nulls->isMutable());
+}
+
+// Moves the values at 'indices' of the flat 'result' to its first 'size' rows
+// and resizes it to 'size'. 'indices' are increasing, so that no value is
+// overwritten before it is moved.
+template <TypeKind kind>
+void compactFlat(
+    BaseVector& result,
+    const vector_size_t* indices,
+    vector_size_t size) {
+  using T = typename TypeTraits<kind>::NativeType;
+  auto* flat = result.asUnchecked<FlatVector<T>>();
+  if (!flat->mayHaveNulls()) {
+    for (auto i = 0; i < size; ++i) {
+      flat->set(i, flat->valueAtFast(indices[i]));
+    }
+  } else {
+    for (auto i = 0; i < size; ++i) {
+      if (flat->isNullAt(indices[i])) {
+        flat->setNull(i, true);
+      } else {
+        flat->set(i, flat->valueAtFast(indices[i]));
+      }
+    }
+  }
+  result.resize(size);
+}
 } // namespace
 
 FilterProject::FilterProject(
@@ -52,7 +92,8 @@ FilterProject::FilterProject(
           operatorId,
           project ? project->id() : filter->id(),
           "FilterProject"),
-      hasFilter_(filter != nullptr) {
+      hasFilter_(filter != nullptr),
+      compactResults_(driverCtx->queryConfig().filterProjectCompactResults()) {
   std::vector<core::TypedExprPtr> allExprs;
   if (hasFilter_) {
     allExprs.push_back(filter->filter());
@@ -102,7 +143,10 @@ void FilterProject::addInput(RowVectorPtr input) {
     for (auto& result : results_) {
       if (result && result.unique() && result->isFlatEncoding()) {
         BaseVector::prepareForReuse(result, 0);
-      } else {
+      } else if (result) {
+        // Row, array and map results go back to the vector pool for the
+        // expressions to pick up.
+        operatorCtx_->vectorPool().release(result);
         result.reset();
       }
     }
@@ -179,10 +223,41 @@ RowVectorPtr FilterProject::getOutput() {
     project(*rows, evalCtx);
   }
 
+  if (compactResults_ && !allRowsSelected && !isIdentityProjection_) {
+    return fillCompactedOutput(numOut, filterEvalCtx_.selectedIndices);
+  }
   return fillOutput(
       numOut, allRowsSelected ? nullptr : filterEvalCtx_.selectedIndices);
 }
 
+RowVectorPtr FilterProject::fillCompactedOutput(
+    vector_size_t size,
+    const BufferPtr& mapping) {
+  const auto* indices = mapping->as<vector_size_t>();
+  std::vector<VectorPtr> children(outputType_->size());
+  for (const auto& projection : identityProjections_) {
+    children[projection.outputChannel] =
+        wrapChild(size, mapping, input_->childAt(projection.inputChannel));
+  }
+  vector_size_t numCompacted = 0;
+  for (const auto& projection : resultProjections_) {
+    auto& result = results_[projection.inputChannel];
+    if (canCompact(result)) {
+      VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+          compactFlat, result->typeKind(), *result, indices, size);
+      children[projection.outputChannel] = result;
+      ++numCompacted;
+    } else {
+      children[projection.outputChannel] = wrapChild(size, mapping, result);
+    }
+  }
+  if (numCompacted > 0) {
+    addRuntimeStat("numCompactedResults", RuntimeCounter(numCompacted));
+  }
+  return std::make_shared<RowVector>(
+      operatorCtx_->pool(), outputType_, nullptr, size, std::move(children));
+}
+
 void FilterProject::project(const SelectivityVector& rows, EvalCtx& evalCtx) {
   exprs_->eval(
       hasFilter_ ? 1 : 0, numExprs_, !hasFilter_, rows, evalCtx, results_);
@@ -84,8 +84,19 @@ class FilterProject : public Operator {
   // pre-condition: !isIdentityProjection_
   void project(const SelectivityVector& rows, EvalCtx& evalCtx);
 
+  // Returns the 'size' rows of the output at 'mapping'. Compacts the results_
+  // that are flat and singly referenced in place and wraps the other columns
+  // in a dictionary.
+  RowVectorPtr fillCompactedOutput(
+      vector_size_t size,
+      const BufferPtr& mapping);
+
   // If true exprs_[0] is a filter and the other expressions are projections
   const bool hasFilter_{false};
+  // Compact the projection results to the rows passing the filter instead of
+  // wrapping them in a dictionary. See
+  // QueryConfig::kFilterProjectCompactResults.
+  const bool compactResults_;
   std::unique_ptr<ExprSet> exprs_;
   int32_t numExprs_;
 
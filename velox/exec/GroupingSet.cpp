@@ -14,7 +14,9 @@
  * limitations under the License.
  */
 #include "velox/exec/GroupingSet.h"
+#include "velox/common/base/AsyncSource.h"
 #include "velox/exec/Aggregate.h"
+#include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
 
 namespace facebook::velox::exec {
@@ -70,6 +72,18 @@ GroupingSet::GroupingSet(
       spillMemoryThreshold_(operatorCtx->driverCtx()
                                 ->queryConfig()
                                 .aggregationSpillMemoryThreshold()),
+      minTableSizeForIncrementalRehash_(
+          operatorCtx->driverCtx()
+              ->queryConfig()
+              .minTableSizeForIncrementalRehash()),
+      internStringKeys_(
+          operatorCtx->driverCtx()->queryConfig().internStringKeys()),
+      compactionFreePct_(operatorCtx->driverCtx()
+                             ->queryConfig()
+                             .aggregationCompactionFreePct()),
+      compactionMinBytes_(operatorCtx->driverCtx()
+                              ->queryConfig()
+                              .aggregationCompactionMinBytes()),
       spillConfig_(spillConfig),
       numSpillRuns_(numSpillRuns),
       nonReclaimableSection_(nonReclaimableSection),
@@ -130,6 +144,24 @@ GroupingSet::GroupingSet(
       distinctAggregations_.push_back(nullptr);
     }
   }
+
+  // Partitioned parallel insert is for final aggregations over many groups.
+  // Partial aggregations flush when full and are not worth partitioning.
+  // Spilling and pre-grouped keys assume a single table.
+  const auto numParallelPartitions = operatorCtx->driverCtx()
+                                         ->queryConfig()
+                                         .aggregationNumParallelPartitions();
+  auto* executor = operatorCtx->task()->queryCtx()->executor();
+  if (numParallelPartitions > 1 && executor != nullptr && !isGlobal_ &&
+      !isPartial_ && spillConfig_ == nullptr &&
+      preGroupedKeyChannels_.empty()) {
+    partitionExecutor_ = executor;
+    numParallelPartitions_ = numParallelPartitions;
+    for (const auto& hasher : hashers_) {
+      partitionHashers_.push_back(
+          std::make_unique<VectorHasher>(hasher->type(), hasher->channel()));
+    }
+  }
 }
 
 GroupingSet::~GroupingSet() {
@@ -138,25 +170,6 @@ GroupingSet::~GroupingSet() {
   }
 }
 
-std::unique_ptr<GroupingSet> GroupingSet::createForMarkDistinct(
-    const RowTypePtr& inputType,
-    std::vector<std::unique_ptr<VectorHasher>>&& hashers,
-    OperatorCtx* operatorCtx,
-    tsan_atomic<bool>* nonReclaimableSection) {
-  return std::make_unique<GroupingSet>(
-      inputType,
-      std::move(hashers),
-      /*preGroupedKeys*/ std::vector<column_index_t>{},
-      /*aggregates*/ std::vector<AggregateInfo>{},
-      /*ignoreNullKeys*/ false,
-      /*isPartial*/ false,
-      /*isRawInput*/ false,
-      /*spillConfig*/ nullptr,
-      /*numSpillRuns*/ nullptr,
-      nonReclaimableSection,
-      operatorCtx);
-};
-
 namespace {
 bool equalKeys(
     const std::vector<column_index_t>& keys,
@@ -204,6 +217,77 @@ void GroupingSet::addInput(const RowVectorPtr& input, bool mayPushdown) {
   activeRows_.setAll();
 
   addInputForActiveRows(input, mayPushdown);
+  maybeCompact();
+}
+
+std::pair<uint64_t, uint64_t> GroupingSet::variableLengthBytes() const {
+  if (!table_) {
+    return {0, 0};
+  }
+  const auto& allocator = table_->rows()->stringAllocator();
+  return {allocator.retainedSize(), allocator.freeBytes()};
+}
+
+void GroupingSet::maybeCompact() {
+  if (compactionFreePct_ == 0 || isPartial_ || !table_ ||
+      !partitionTables_.empty() || spiller_ != nullptr ||
+      sortedAggregations_ != nullptr) {
+    return;
+  }
+  for (const auto& aggregation : distinctAggregations_) {
+    if (aggregation != nullptr) {
+      return;
+    }
+  }
+  auto* rows = table_->rows();
+  if (rows->internsStringKeys() ||
+      rows->stringAllocatorShared().use_count() > 1) {
+    return;
+  }
+  const auto [retainedBytes, freeBytes] = variableLengthBytes();
+  if (retainedBytes < compactionMinBytes_ ||
+      freeBytes * 100 < retainedBytes * compactionFreePct_) {
+    return;
+  }
+  compact();
+}
+
+void GroupingSet::compact() {
+  auto* rows = table_->rows();
+  auto* oldAllocator = &rows->stringAllocator();
+  auto newAllocator = std::make_shared<HashStringAllocator>(&pool_);
+
+  constexpr int32_t kBatch = 1'000;
+  std::vector<char*> groups(kBatch);
+  std::vector<vector_size_t> indices(kBatch);
+  std::iota(indices.begin(), indices.end(), 0);
+  RowContainerIterator iter;
+  while (auto numGroups = rows->listRows(&iter, kBatch, groups.data())) {
+    const folly::Range<char**> range(groups.data(), numGroups);
+    rows->moveVariableWidthData(range, *newAllocator);
+    const SelectivityVector selected(numGroups);
+    for (auto& aggregate : aggregates_) {
+      auto& function = aggregate.function;
+      std::vector<VectorPtr> intermediate{
+          BaseVector::create(aggregate.intermediateType, numGroups, &pool_)};
+      function->extractAccumulators(
+          groups.data(), numGroups, &intermediate[0]);
+      function->destroy(range);
+      function->setAllocator(newAllocator.get());
+      function->initializeNewGroups(
+          groups.data(),
+          folly::Range<const vector_size_t*>(indices.data(), numGroups));
+      function->addIntermediateResults(
+          groups.data(), selected, intermediate, false);
+      function->setAllocator(oldAllocator);
+    }
+  }
+  // Frees the old allocator.
+  rows->setStringAllocator(std::move(newAllocator));
+  for (auto& aggregate : aggregates_) {
+    aggregate.function->setAllocator(&rows->stringAllocator());
+  }
+  ++numCompactions_;
 }
 
 void GroupingSet::noMoreInput() {
@@ -239,12 +323,20 @@ void GroupingSet::addInputForActiveRows(
   auto guard = folly::makeGuard([this]() { *nonReclaimableSection_ = false; });
   *nonReclaimableSection_ = true;
 
-  table_->prepareForProbe(*lookup_, input, activeRows_, ignoreNullKeys_);
-  table_->groupProbe(*lookup_);
+  if (partitionExecutor_ != nullptr) {
+    parallelGroupProbe(input);
+  } else {
+    table_->prepareForProbe(*lookup_, input, activeRows_, ignoreNullKeys_);
+    table_->groupProbe(*lookup_);
+  }
   masks_.addInput(input, activeRows_);
 
   auto* groups = lookup_->hits.data();
   const auto& newGroups = lookup_->newGroups;
+  // In array mode the lookup hashes are the dense slots of the groups.
+  const bool addBySlot = isRawInput_ && partitionExecutor_ == nullptr &&
+      table_->hashMode() == BaseHashTable::HashMode::kArray &&
+      table_->capacity() <= kMaxSlotsForAddBySlot;
 
   for (auto i = 0; i < aggregates_.size(); ++i) {
     if (!aggregates_[i].sortingKeys.empty()) {
@@ -281,7 +373,15 @@ void GroupingSet::addInputForActiveRows(
     const bool canPushdown = (&rows == &activeRows_) && mayPushdown &&
         mayPushdown_[i] && areAllLazyNotLoaded(tempVectors_);
     if (isRawInput_) {
-      function->addRawInput(groups, rows, tempVectors_, canPushdown);
+      if (!addBySlot || canPushdown ||
+          !function->addRawInputBySlot(
+              groups,
+              lookup_->hashes.data(),
+              table_->capacity(),
+              rows,
+              tempVectors_)) {
+        function->addRawInput(groups, rows, tempVectors_, canPushdown);
+      }
     } else {
       function->addIntermediateResults(groups, rows, tempVectors_, canPushdown);
     }
@@ -296,6 +396,89 @@ void GroupingSet::addInputForActiveRows(
   }
 }
 
+void GroupingSet::parallelGroupProbe(const RowVectorPtr& input) {
+  for (auto& hasher : partitionHashers_) {
+    auto key = input->childAt(hasher->channel())->loadedVector();
+    hasher->decode(*key, activeRows_);
+  }
+  if (ignoreNullKeys_) {
+    deselectRowsWithNulls(partitionHashers_, activeRows_);
+  }
+  partitionHashes_.resize(activeRows_.end());
+  for (auto i = 0; i < partitionHashers_.size(); ++i) {
+    partitionHashers_[i]->hash(activeRows_, i > 0, partitionHashes_);
+  }
+
+  // The tables hash the keys with the same function. The partition hash is
+  // remixed so that the rows of a partition do not all share the low bits
+  // that select the bucket in the partition table.
+  partitionRows_.resize(numParallelPartitions_);
+  for (auto& rows : partitionRows_) {
+    rows.resizeFill(activeRows_.end(), false);
+  }
+  activeRows_.applyToSelected([&](auto row) {
+    const auto partition = folly::hasher<uint64_t>()(partitionHashes_[row]) %
+        numParallelPartitions_;
+    partitionRows_[partition].setValid(row, true);
+  });
+
+  std::vector<std::shared_ptr<AsyncSource<bool>>> probeSteps;
+  auto sync = folly::makeGuard([&]() {
+    // This is executed on returning path, possibly in unwinding, so must not
+    // throw. The steps reference 'input' and the partition tables.
+    for (auto& step : probeSteps) {
+      try {
+        step->move();
+      } catch (const std::exception& e) {
+        LOG(ERROR) << "Error in parallel group by: " << e.what();
+      }
+    }
+  });
+  for (auto i = 0; i < numParallelPartitions_; ++i) {
+    auto& rows = partitionRows_[i];
+    rows.updateBounds();
+    if (!rows.hasSelections()) {
+      continue;
+    }
+    probeSteps.push_back(std::make_shared<AsyncSource<bool>>(
+        [this, i, table = partitionTable(i), &input, &rows]() {
+          auto& lookup = *partitionLookups_[i];
+          // Nulls are already deselected from 'rows' if 'ignoreNullKeys_'.
+          table->prepareForProbe(lookup, input, rows, false);
+          table->groupProbe(lookup);
+          return std::make_unique<bool>(true);
+        }));
+    partitionExecutor_->add([step = probeSteps.back()]() { step->prepare(); });
+  }
+  std::exception_ptr error;
+  for (auto& step : probeSteps) {
+    try {
+      step->move();
+    } catch (const std::exception&) {
+      error = std::current_exception();
+    }
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+
+  lookup_->reset(activeRows_.end());
+  auto* groups = lookup_->hits.data();
+  for (auto i = 0; i < numParallelPartitions_; ++i) {
+    if (!partitionRows_[i].hasSelections()) {
+      continue;
+    }
+    const auto& lookup = *partitionLookups_[i];
+    for (auto row : lookup.rows) {
+      groups[row] = lookup.hits[row];
+    }
+    lookup_->newGroups.insert(
+        lookup_->newGroups.end(),
+        lookup.newGroups.begin(),
+        lookup.newGroups.end());
+  }
+}
+
 void GroupingSet::addRemainingInput() {
   activeRows_.resize(remainingInput_->size());
   activeRows_.clearAll();
@@ -357,15 +540,35 @@ std::vector<Accumulator> GroupingSet::accumulators(bool excludeToIntermediate) {
 void GroupingSet::createHashTable() {
   if (ignoreNullKeys_) {
     table_ = HashTable<true>::createForAggregation(
-        std::move(hashers_), accumulators(false), &pool_);
+        std::move(hashers_),
+        accumulators(false),
+        &pool_,
+        minTableSizeForIncrementalRehash_);
   } else {
     table_ = HashTable<false>::createForAggregation(
-        std::move(hashers_), accumulators(false), &pool_);
+        std::move(hashers_),
+        accumulators(false),
+        &pool_,
+        minTableSizeForIncrementalRehash_);
   }
 
   RowContainer& rows = *table_->rows();
+  if (internStringKeys_) {
+    rows.internStringKeys();
+  }
   initializeAggregates(aggregates_, rows, false);
+  initializeSortedAndDistinctAggregations(rows);
 
+  lookup_ = std::make_unique<HashLookup>(table_->hashers());
+  if (!isAdaptive_ && table_->hashMode() != BaseHashTable::HashMode::kHash) {
+    table_->forceGenericHashMode();
+  }
+  if (partitionExecutor_ != nullptr) {
+    createPartitionTables();
+  }
+}
+
+void GroupingSet::initializeSortedAndDistinctAggregations(RowContainer& rows) {
   auto numColumns = rows.keyTypes().size() + aggregates_.size();
 
   if (sortedAggregations_) {
@@ -394,10 +597,39 @@ void GroupingSet::createHashTable() {
       ++numColumns;
     }
   }
+}
 
-  lookup_ = std::make_unique<HashLookup>(table_->hashers());
-  if (!isAdaptive_ && table_->hashMode() != BaseHashTable::HashMode::kHash) {
-    table_->forceGenericHashMode();
+void GroupingSet::createPartitionTables() {
+  partitionLookups_.push_back(std::make_unique<HashLookup>(table_->hashers()));
+  for (auto i = 1; i < numParallelPartitions_; ++i) {
+    std::vector<std::unique_ptr<VectorHasher>> hashers;
+    for (const auto& hasher : table_->hashers()) {
+      hashers.push_back(
+          std::make_unique<VectorHasher>(hasher->type(), hasher->channel()));
+    }
+    if (ignoreNullKeys_) {
+      partitionTables_.push_back(HashTable<true>::createForAggregation(
+          std::move(hashers),
+          accumulators(false),
+          &pool_,
+          minTableSizeForIncrementalRehash_));
+    } else {
+      partitionTables_.push_back(HashTable<false>::createForAggregation(
+          std::move(hashers),
+          accumulators(false),
+          &pool_,
+          minTableSizeForIncrementalRehash_));
+    }
+    auto& table = partitionTables_.back();
+    if (internStringKeys_) {
+      table->rows()->internStringKeys();
+    }
+    VELOX_CHECK_EQ(
+        table->rows()->fixedRowSize(), table_->rows()->fixedRowSize());
+    partitionLookups_.push_back(std::make_unique<HashLookup>(table->hashers()));
+    if (!isAdaptive_ && table->hashMode() != BaseHashTable::HashMode::kHash) {
+      table->forceGenericHashMode();
+    }
   }
 }
 
@@ -644,11 +876,30 @@ bool GroupingSet::getOutput(
 
   // @lint-ignore CLANGTIDY
   char* groups[batchSize];
-  int32_t numGroups =
-      table_ ? table_->rows()->listRows(&iterator, batchSize, groups) : 0;
+  int32_t numGroups = 0;
+  if (table_) {
+    // Lists the groups of one partition table after the other.
+    for (;;) {
+      numGroups = partitionTable(outputTablePartition_)
+                      ->rows()
+                      ->listRows(&iterator, batchSize, groups);
+      if (numGroups || outputTablePartition_ == partitionTables_.size()) {
+        break;
+      }
+      ++outputTablePartition_;
+      iterator.reset();
+    }
+  }
   if (!numGroups) {
     if (table_) {
+      // The aggregates of all partitions allocate from 'table_', which is
+      // cleared last.
+      for (auto& table : partitionTables_) {
+        table->clear();
+      }
       table_->clear();
+      clearAggregates();
+      outputTablePartition_ = 0;
     }
     return false;
   }
@@ -663,6 +914,8 @@ void GroupingSet::extractGroups(
   if (groups.empty()) {
     return;
   }
+  // The partition tables have the same layout as 'table_', so the columns of
+  // groups of any partition are extracted with the RowContainer of 'table_'.
   RowContainer& rows = table_ ? *table_->rows() : *rowsWhileReadingSpill_;
   auto totalKeys = rows.keyTypes().size();
   for (int32_t i = 0; i < totalKeys; ++i) {
@@ -698,6 +951,13 @@ void GroupingSet::extractGroups(
 void GroupingSet::resetPartial() {
   if (table_ != nullptr) {
     table_->clear();
+    clearAggregates();
+  }
+}
+
+void GroupingSet::clearAggregates() {
+  for (auto& aggregate : aggregates_) {
+    aggregate.function->clear();
   }
 }
 
@@ -722,12 +982,57 @@ bool GroupingSet::isPartialFull(int64_t maxBytes) {
   return allocatedBytes() > maxBytes;
 }
 
+int64_t GroupingSet::numDistinct() const {
+  if (!table_) {
+    return 0;
+  }
+  int64_t numDistinct = table_->numDistinct();
+  for (const auto& table : partitionTables_) {
+    numDistinct += table->numDistinct();
+  }
+  return numDistinct;
+}
+
+HashTableStats GroupingSet::hashTableStats() const {
+  if (!table_) {
+    return HashTableStats{};
+  }
+  auto stats = table_->stats();
+  for (const auto& table : partitionTables_) {
+    const auto partitionStats = table->stats();
+    stats.capacity += partitionStats.capacity;
+    stats.numRehashes += partitionStats.numRehashes;
+    stats.numDistinct += partitionStats.numDistinct;
+    stats.numTombstones += partitionStats.numTombstones;
+  }
+  return stats;
+}
+
+int64_t GroupingSet::numRows() const {
+  if (!table_) {
+    return 0;
+  }
+  int64_t numRows = table_->rows()->numRows();
+  for (const auto& table : partitionTables_) {
+    numRows += table->rows()->numRows();
+  }
+  return numRows;
+}
+
 uint64_t GroupingSet::allocatedBytes() const {
+  uint64_t bytes = 0;
+  for (const auto& aggregate : aggregates_) {
+    bytes += aggregate.function->sharedAllocatedBytes();
+  }
   if (table_) {
-    return table_->allocatedBytes();
+    bytes += table_->allocatedBytes();
+    for (const auto& table : partitionTables_) {
+      bytes += table->allocatedBytes();
+    }
+    return bytes;
   }
 
-  return stringAllocator_.retainedSize() + rows_.allocatedBytes();
+  return bytes + stringAllocator_.retainedSize() + rows_.allocatedBytes();
 }
 
 const HashLookup& GroupingSet::hashLookup() const {
@@ -836,6 +1141,16 @@ void GroupingSet::spill(int64_t targetRows, int64_t targetBytes) {
     for (const auto& aggregate : aggregates_) {
       types.push_back(aggregate.intermediateType);
     }
+    // Sorted and distinct aggregations spill their accumulated inputs, one
+    // array per group, which the merge adds back to the merged groups.
+    if (sortedAggregations_) {
+      types.push_back(sortedAggregations_->spillType());
+    }
+    for (const auto& aggregation : distinctAggregations_) {
+      if (aggregation != nullptr) {
+        types.push_back(aggregation->spillType());
+      }
+    }
     std::vector<std::string> names;
     for (auto i = 0; i < types.size(); ++i) {
       names.push_back(fmt::format("s{}", i));
@@ -857,12 +1172,18 @@ void GroupingSet::spill(int64_t targetRows, int64_t targetBytes) {
         spillConfig_->minSpillRunSize,
         spillConfig_->compressionKind,
         Spiller::pool(),
-        spillConfig_->executor);
+        spillConfig_->executor,
+        spillConfig_->extraFilePaths);
   }
   ++(*numSpillRuns_);
   spiller_->spill(targetRows, targetBytes);
-  if (table_->rows()->numRows() == 0) {
+  auto* rows = table_->rows();
+  if (rows->numRows() == 0) {
     table_->clear();
+  } else if (rows->numFreeRows() >= rows->numRows()) {
+    // Most rows are spilled. Moves the rest so that the memory of the spilled
+    // rows goes back to the pool instead of staying on the free list.
+    table_->compactRows();
   }
 }
 
@@ -908,8 +1229,12 @@ bool GroupingSet::getOutputWithSpill(
     nonSpilledIndex_ += numGroups;
     return true;
   }
+  // The non-spilled groups are done, so that the sorted and distinct
+  // aggregations can switch to the layout of 'mergeRows_'.
+  initializeSortedAndDistinctAggregations(*mergeRows_);
   while (outputPartition_ < spiller_->state().maxPartitions()) {
     if (!merge_) {
+      pendingMergeRows_.clear();
       merge_ = spiller_->startMerge(outputPartition_);
     }
     // NOTE: 'merge_' might be nullptr if 'outputPartition_' is empty.
@@ -949,13 +1274,21 @@ void GroupingSet::initializeRow(SpillMergeStream& keys, char* row) {
     mergeRows_->store(keys.decoded(i), keys.currentIndex(), mergeState_, i);
   }
   vector_size_t zero = 0;
-  for (auto& aggregate : aggregates_) {
-    aggregate.function->initializeNewGroups(
-        &row, folly::Range<const vector_size_t*>(&zero, 1));
+  const folly::Range<const vector_size_t*> newGroup(&zero, 1);
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    if (distinctAggregations_[i] != nullptr) {
+      distinctAggregations_[i]->initializeNewGroups(&row, newGroup);
+    } else if (aggregates_[i].sortingKeys.empty()) {
+      aggregates_[i].function->initializeNewGroups(&row, newGroup);
+    }
+  }
+  if (sortedAggregations_) {
+    sortedAggregations_->initializeNewGroups(&row, newGroup);
   }
 }
 
 void GroupingSet::extractSpillResult(const RowVectorPtr& result) {
+  addAllPendingMergeRows();
   std::vector<char*> rows(mergeRows_->numRows());
   RowContainerIterator iter;
   if (!rows.empty()) {
@@ -967,18 +1300,63 @@ void GroupingSet::extractSpillResult(const RowVectorPtr& result) {
 }
 
 void GroupingSet::updateRow(SpillMergeStream& input, char* row) {
-  if (input.currentIndex() >= mergeSelection_.size()) {
-    mergeSelection_.resize(bits::roundUp(input.currentIndex() + 1, 64));
-    mergeSelection_.clearAll();
+  bool isLastRow;
+  const auto index = input.currentIndex(&isLastRow);
+  auto& pending = pendingMergeRows_[&input];
+  if (index >= pending.rows.size()) {
+    pending.rows.resize(bits::roundUp(index + 1, 64), false);
+  }
+  if (index >= pending.groups.size()) {
+    pending.groups.resize(input.current().size());
+  }
+  pending.rows.setValid(index, true);
+  pending.groups[index] = row;
+
+  auto column = keyChannels_.size() + aggregates_.size();
+  if (sortedAggregations_) {
+    sortedAggregations_->addSingleGroupSpillInput(
+        row, input.current().childAt(column), input.currentIndex());
+    ++column;
+  }
+  for (const auto& aggregation : distinctAggregations_) {
+    if (aggregation != nullptr) {
+      aggregation->addSingleGroupSpillInput(
+          row, input.current().childAt(column), input.currentIndex());
+      ++column;
+    }
+  }
+  if (isLastRow) {
+    addPendingMergeRows(input);
+  }
+}
+
+void GroupingSet::addPendingMergeRows(SpillMergeStream& input) {
+  auto it = pendingMergeRows_.find(&input);
+  if (it == pendingMergeRows_.end()) {
+    return;
+  }
+  auto& pending = it->second;
+  pending.rows.updateBounds();
+  if (!pending.rows.hasSelections()) {
+    return;
   }
-  mergeSelection_.setValid(input.currentIndex(), true);
-  mergeSelection_.updateBounds();
   for (auto i = 0; i < aggregates_.size(); ++i) {
+    // Sorted and distinct aggregations are computed from their inputs, which
+    // are merged in updateRow().
+    if (aggregates_[i].distinct || !aggregates_[i].sortingKeys.empty()) {
+      continue;
+    }
     mergeArgs_[0] = input.current().childAt(i + keyChannels_.size());
-    aggregates_[i].function->addSingleGroupIntermediateResults(
-        row, mergeSelection_, mergeArgs_, false);
+    aggregates_[i].function->addIntermediateResults(
+        pending.groups.data(), pending.rows, mergeArgs_, false);
+  }
+  pending.rows.clearAll();
+}
+
+void GroupingSet::addAllPendingMergeRows() {
+  for (auto& [input, _] : pendingMergeRows_) {
+    addPendingMergeRows(*input);
   }
-  mergeSelection_.setValid(input.currentIndex(), false);
 }
 
 void GroupingSet::abandonPartialAggregation() {
@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <folly/container/F14Map.h>
+
 #include "velox/exec/AggregateInfo.h"
 #include "velox/exec/AggregationMasks.h"
 #include "velox/exec/DistinctAggregations.h"
@@ -43,13 +45,6 @@ class GroupingSet {
 
   ~GroupingSet();
 
-  // Used by MarkDistinct operator to identify rows with unique values.
-  static std::unique_ptr<GroupingSet> createForMarkDistinct(
-      const RowTypePtr& inputType,
-      std::vector<std::unique_ptr<VectorHasher>>&& hashers,
-      OperatorCtx* operatorCtx,
-      tsan_atomic<bool>* nonReclaimableSection);
-
   void addInput(const RowVectorPtr& input, bool mayPushdown);
 
   void noMoreInput();
@@ -82,16 +77,16 @@ class GroupingSet {
   bool isPartialFull(int64_t maxBytes);
 
   /// Returns the count of the hash table, if any.
-  int64_t numDistinct() const {
-    return table_ ? table_->numDistinct() : 0;
-  }
+  int64_t numDistinct() const;
 
   const HashLookup& hashLookup() const;
 
   /// Spills content until under 'targetRows' and under 'targetBytes'
   /// of out of line data are left. If targetRows is 0, spills
   /// everything and physically frees the data in the
-  /// 'table_->rows()'. This leaves 'table_' initialized and 'this'
+  /// 'table_->rows()'. Otherwise, if at least half of the rows were spilled,
+  /// moves the remaining rows into new allocations to free the memory of the
+  /// spilled rows. This leaves 'table_' initialized and 'this'
   /// ready to accumulate more input. This is called by ensureInputFits
   /// or by external memory management. In the latter case, the Driver
   /// of this will be in a paused state and off thread.
@@ -105,14 +100,21 @@ class GroupingSet {
     return spiller_->stats();
   }
 
-  /// Returns the hashtable stats.
-  HashTableStats hashTableStats() const {
-    return table_ ? table_->stats() : HashTableStats{};
-  }
+  /// Returns the hashtable stats, summed over all partitions if the hash
+  /// table is partitioned.
+  HashTableStats hashTableStats() const;
 
   /// Return the number of rows kept in memory.
-  int64_t numRows() const {
-    return table_ ? table_->rows()->numRows() : 0;
+  int64_t numRows() const;
+
+  /// Returns the retained bytes of the variable length data of the groups
+  /// and how many of these are in free blocks.
+  std::pair<uint64_t, uint64_t> variableLengthBytes() const;
+
+  /// Returns the number of times the variable length data of the groups has
+  /// been compacted. See QueryConfig::kAggregationCompactionFreePct.
+  int32_t numCompactions() const {
+    return numCompactions_;
   }
 
   // Frees hash tables and other state when giving up partial aggregation as
@@ -131,6 +133,15 @@ class GroupingSet {
 
   void addRemainingInput();
 
+  // Compacts the variable length data of the groups if enough of it is free.
+  void maybeCompact();
+
+  // Moves the variable length data of the keys and accumulators of the
+  // groups to a new HashStringAllocator and frees the old one. The
+  // accumulators are moved by extracting them as intermediate results and
+  // adding these to reinitialized accumulators.
+  void compact();
+
   void initializeGlobalAggregation();
 
   void destroyGlobalAggregations();
@@ -145,6 +156,30 @@ class GroupingSet {
 
   void createHashTable();
 
+  // Clears the state the aggregate functions keep outside of the groups after
+  // all groups have been freed.
+  void clearAggregates();
+
+  // Points 'sortedAggregations_' and 'distinctAggregations_' to their
+  // accumulators in the rows of 'rows'.
+  void initializeSortedAndDistinctAggregations(RowContainer& rows);
+
+  // Creates 'partitionTables_' and 'partitionLookups_' for inserting into
+  // 'numParallelPartitions_' tables in parallel.
+  void createPartitionTables();
+
+  // Returns the table of partition 'partition'. Partition 0 is 'table_'.
+  BaseHashTable* partitionTable(int32_t partition) const {
+    return partition == 0 ? table_.get()
+                          : partitionTables_[partition - 1].get();
+  }
+
+  // Inserts the grouping keys of 'activeRows_' of 'input' into the partition
+  // tables in parallel. Each row goes to the partition given by a hash of its
+  // keys. Leaves the groups and the new groups of 'input' in 'lookup_' as
+  // groupProbe() does for a single table.
+  void parallelGroupProbe(const RowVectorPtr& input);
+
   void populateTempVectors(int32_t aggregateIndex, const RowVectorPtr& input);
 
   // If the given aggregation has mask, the method returns reference to the
@@ -187,9 +222,20 @@ class GroupingSet {
   void initializeRow(SpillMergeStream& keys, char* row);
 
   // Updates the accumulators in 'row' with the intermediate type data from
-  // 'keys'. This is called for each row received from a merge of spilled data.
+  // 'keys' and adds the spilled inputs of sorted and distinct aggregations.
+  // This is called for each row received from a merge of spilled data. The
+  // intermediate results are added in batches by addPendingMergeRows().
   void updateRow(SpillMergeStream& keys, char* row);
 
+  // Adds the intermediate results of the rows of the current batch of 'input'
+  // that updateRow() has recorded to their groups in 'mergeRows_'. This must
+  // be called before 'input' moves to its next batch and before the groups
+  // are extracted.
+  void addPendingMergeRows(SpillMergeStream& input);
+
+  // Calls addPendingMergeRows() for all the streams of 'merge_'.
+  void addAllPendingMergeRows();
+
   // Copies the finalized state from 'mergeRows' to 'result' and clears
   // 'mergeRows'. Used for producing a batch of results when aggregating spilled
   // groups.
@@ -222,6 +268,21 @@ class GroupingSet {
   // If it is zero, then there is no such limit.
   const uint64_t spillMemoryThreshold_;
 
+  // The min capacity from which the hash tables grow with an incremental
+  // rehash. 0 means never.
+  const uint64_t minTableSizeForIncrementalRehash_;
+
+  // True if the string keys of the hash tables are interned. See
+  // RowContainer::internStringKeys().
+  const bool internStringKeys_;
+
+  // The min percentage of free variable length data and the min size of
+  // this data for compacting it. 0 percent means never.
+  const int32_t compactionFreePct_;
+  const uint64_t compactionMinBytes_;
+
+  int32_t numCompactions_{0};
+
   const Spiller::Config* const spillConfig_;
 
   uint32_t* const numSpillRuns_;
@@ -236,12 +297,44 @@ class GroupingSet {
 
   std::vector<bool> mayPushdown_;
 
+  // Max number of slots of a hash table in array mode for which raw input is
+  // added with Aggregate::addRawInputBySlot(). The per-slot buffers of larger
+  // tables would not stay in cache.
+  static constexpr uint64_t kMaxSlotsForAddBySlot = 4096;
+
   // Place for the arguments of the aggregate being updated.
   std::vector<VectorPtr> tempVectors_;
   std::unique_ptr<BaseHashTable> table_;
   std::unique_ptr<HashLookup> lookup_;
   SelectivityVector activeRows_;
 
+  // Executor for inserting into partitioned hash tables in parallel. nullptr
+  // if the keys are inserted into 'table_' only.
+  folly::Executor* partitionExecutor_{nullptr};
+
+  // Number of hash table partitions if 'partitionExecutor_' is set.
+  int32_t numParallelPartitions_{1};
+
+  // Hashers for assigning input rows to partitions. Separate from the hashers
+  // of the tables, which each decide their own hash mode.
+  std::vector<std::unique_ptr<VectorHasher>> partitionHashers_;
+  raw_vector<uint64_t> partitionHashes_;
+
+  // The input rows of each partition.
+  std::vector<SelectivityVector> partitionRows_;
+
+  // The tables of partitions 1 and up. Partition 0 is 'table_'. All tables
+  // have the same row layout, so that the aggregates can be updated on groups
+  // of any partition. The aggregates allocate from the string allocator of
+  // 'table_'. These are declared after 'table_' so as to be destroyed first.
+  std::vector<std::unique_ptr<BaseHashTable>> partitionTables_;
+
+  // Lookup for each partition, including partition 0.
+  std::vector<std::unique_ptr<HashLookup>> partitionLookups_;
+
+  // The partition producing output in getOutput().
+  int32_t outputTablePartition_{0};
+
   // Used to allocate memory for a single row accumulating results of global
   // aggregation
   HashStringAllocator stringAllocator_;
@@ -277,9 +370,16 @@ class GroupingSet {
   // Intermediate vector for passing arguments to aggregate in merging spill.
   std::vector<VectorPtr> mergeArgs_;
 
-  // Indicates the element in mergeArgs_[0] that corresponds to the accumulator
-  // to merge.
-  SelectivityVector mergeSelection_;
+  // The rows of the current batch of a spill merge stream whose intermediate
+  // results are not yet added to the groups in 'mergeRows_'. 'groups' is
+  // indexed by row number in the batch.
+  struct PendingMergeRows {
+    SelectivityVector rows;
+    std::vector<char*> groups;
+  };
+
+  // The pending rows of each stream of 'merge_'.
+  folly::F14FastMap<SpillMergeStream*, PendingMergeRows> pendingMergeRows_;
 
   // True if 'merge_' indicates that the next key is the same as the current
   // one.
@@ -15,6 +15,7 @@
  */
 #include "velox/exec/HashAggregation.h"
 #include <optional>
+#include <folly/ScopeGuard.h>
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/SortedAggregations.h"
@@ -23,6 +24,16 @@
 namespace facebook::velox::exec {
 
 namespace {
+// Number of index bits of the HyperLogLog for estimating the number of distinct
+// grouping keys of a partial aggregation. 2^11 buckets give a standard error
+// of about 2.3%.
+constexpr int8_t kSampleHllIndexBitLength = 11;
+
+// Max memory of a partial aggregation that is predicted to reduce the
+// cardinality only partially. The small table stays cache resident and catches
+// the keys that repeat in nearby input rows.
+constexpr int64_t kSmallTablePartialAggregationMemory = 1L << 20;
+
 std::vector<TypePtr> populateAggregateInputs(
     const core::AggregationNode::Aggregate& aggregate,
     const RowType& inputType,
@@ -59,6 +70,24 @@ std::vector<TypePtr> populateAggregateInputs(
 
   return argTypes;
 }
+
+// Returns true if the drivers of 'node' aggregate into tables of their own
+// that the last driver merges. See QueryConfig::kAggregationIntraTaskMerge.
+bool isIntraTaskMerge(
+    const core::AggregationNode& node,
+    const core::QueryConfig& config) {
+  if (!config.aggregationIntraTaskMerge() ||
+      node.step() != core::AggregationNode::Step::kSingle ||
+      !node.preGroupedKeys().empty()) {
+    return false;
+  }
+  for (const auto& aggregate : node.aggregates()) {
+    if (aggregate.distinct || !aggregate.sortingKeys.empty()) {
+      return false;
+    }
+  }
+  return true;
+}
 } // namespace
 
 HashAggregation::HashAggregation(
@@ -73,12 +102,17 @@ HashAggregation::HashAggregation(
           aggregationNode->step() == core::AggregationNode::Step::kPartial
               ? "PartialAggregation"
               : "Aggregation",
-          aggregationNode->canSpill(driverCtx->queryConfig())
+          aggregationNode->canSpill(driverCtx->queryConfig()) &&
+                  !isIntraTaskMerge(
+                      *aggregationNode, driverCtx->queryConfig())
               ? driverCtx->makeSpillConfig(operatorId)
               : std::nullopt),
+      aggregationNode_(aggregationNode),
       isPartialOutput_(isPartialOutput(aggregationNode->step())),
       isGlobal_(aggregationNode->groupingKeys().empty()),
       isDistinct_(!isGlobal_ && aggregationNode->aggregates().empty()),
+      intraTaskMerge_(
+          isIntraTaskMerge(*aggregationNode, driverCtx->queryConfig())),
       maxExtendedPartialAggregationMemoryUsage_(
           driverCtx->queryConfig().maxExtendedPartialAggregationMemoryUsage()),
       maxPartialAggregationMemoryUsage_(
@@ -86,7 +120,11 @@ HashAggregation::HashAggregation(
       abandonPartialAggregationMinRows_(
           driverCtx->queryConfig().abandonPartialAggregationMinRows()),
       abandonPartialAggregationMinPct_(
-          driverCtx->queryConfig().abandonPartialAggregationMinPct()) {
+          driverCtx->queryConfig().abandonPartialAggregationMinPct()),
+      abandonPartialAggregationSampleRows_(
+          isPartialOutput_ && !isGlobal_
+              ? driverCtx->queryConfig().abandonPartialAggregationSampleRows()
+              : 0) {
   VELOX_CHECK(pool()->trackUsage());
 
   auto inputType = aggregationNode->sources()[0]->outputType();
@@ -105,6 +143,7 @@ HashAggregation::HashAggregation(
   auto numAggregates = aggregationNode->aggregates().size();
   std::vector<AggregateInfo> aggregateInfos;
   aggregateInfos.reserve(numAggregates);
+  std::vector<TypePtr> intermediateTypes;
 
   for (auto i = 0; i < numAggregates; i++) {
     const auto& aggregate = aggregationNode->aggregates()[i];
@@ -132,6 +171,7 @@ HashAggregation::HashAggregation(
       }
     }
 
+    intermediateTypes.push_back(info.intermediateType);
     const auto& resultType = outputType_->childAt(numHashers + i);
     info.function = Aggregate::create(
         aggregate.call->name(),
@@ -166,19 +206,42 @@ HashAggregation::HashAggregation(
         core::AggregationNode::stepName(aggregationNode->step()));
   }
 
-  if (isDistinct_) {
+  if (isDistinct_ && !intraTaskMerge_) {
     for (auto i = 0; i < hashers.size(); ++i) {
       identityProjections_.emplace_back(hashers[i]->channel(), i);
     }
   }
 
+  if (intraTaskMerge_) {
+    // The tables of all drivers are merged as intermediate results, i.e. the
+    // grouping keys followed by the accumulators.
+    auto names = outputType_->names();
+    std::vector<TypePtr> types;
+    for (auto i = 0; i < numHashers; ++i) {
+      types.push_back(outputType_->childAt(i));
+    }
+    types.insert(
+        types.end(), intermediateTypes.begin(), intermediateTypes.end());
+    intermediateType_ = ROW(std::move(names), std::move(types));
+  }
+
+  if (abandonPartialAggregationSampleRows_ > 0) {
+    for (const auto& hasher : hashers) {
+      sampleHashers_.push_back(
+          std::make_unique<VectorHasher>(hasher->type(), hasher->channel()));
+    }
+    sampleAllocator_ = std::make_unique<HashStringAllocator>(pool());
+    sampleHll_ = std::make_unique<common::hll::DenseHll>(
+        kSampleHllIndexBitLength, sampleAllocator_.get());
+  }
+
   groupingSet_ = std::make_unique<GroupingSet>(
       inputType,
       std::move(hashers),
       std::move(preGroupedChannels),
       std::move(aggregateInfos),
       aggregationNode->ignoreNullKeys(),
-      isPartialOutput_,
+      isPartialOutput_ || intraTaskMerge_,
       isRawInput(aggregationNode->step()),
       spillConfig_.has_value() ? &spillConfig_.value() : nullptr,
       &numSpillRuns_,
@@ -188,10 +251,49 @@ HashAggregation::HashAggregation(
 
 bool HashAggregation::abandonPartialAggregationEarly(int64_t numOutput) const {
   VELOX_CHECK(isPartialOutput_ && !isGlobal_);
+  if (sampledNonReducing_) {
+    return true;
+  }
   return numInputRows_ > abandonPartialAggregationMinRows_ &&
       100 * numOutput / numInputRows_ >= abandonPartialAggregationMinPct_;
 }
 
+void HashAggregation::samplePartialAggregation(const RowVectorPtr& input) {
+  const SelectivityVector rows(input->size());
+  sampleHashes_.resize(input->size());
+  for (auto i = 0; i < sampleHashers_.size(); ++i) {
+    auto& hasher = sampleHashers_[i];
+    hasher->decode(*input->childAt(hasher->channel())->loadedVector(), rows);
+    hasher->hash(rows, i > 0, sampleHashes_);
+  }
+  for (auto i = 0; i < input->size(); ++i) {
+    // The HLL takes its bucket and value from the high and low bits. Remix the
+    // key hash so that both are well distributed.
+    sampleHll_->insertHash(folly::hasher<uint64_t>()(sampleHashes_[i]));
+  }
+  numSampledRows_ += input->size();
+  if (numSampledRows_ < abandonPartialAggregationSampleRows_) {
+    return;
+  }
+
+  const auto uniquePct = std::min<int64_t>(
+      100, 100 * sampleHll_->cardinality() / numSampledRows_);
+  addRuntimeStat(
+      "partialAggregationSampledUniquePct", RuntimeCounter(uniquePct));
+  if (uniquePct >= abandonPartialAggregationMinPct_) {
+    sampledNonReducing_ = true;
+  } else if (uniquePct >= abandonPartialAggregationMinPct_ / 2) {
+    smallTablePartialAggregation_ = true;
+    maxPartialAggregationMemoryUsage_ = std::min<int64_t>(
+        maxPartialAggregationMemoryUsage_, kSmallTablePartialAggregationMemory);
+    addRuntimeStat("smallTablePartialAggregation", RuntimeCounter(1));
+  }
+  sampleHll_.reset();
+  sampleAllocator_.reset();
+  sampleHashers_.clear();
+  sampleHashes_.clear();
+}
+
 void HashAggregation::addInput(RowVectorPtr input) {
   if (!pushdownChecked_) {
     mayPushdown_ = operatorCtx_->driver()->mayPushdownAggregation(this);
@@ -202,6 +304,9 @@ void HashAggregation::addInput(RowVectorPtr input) {
     numInputRows_ += input->size();
     return;
   }
+  if (sampleHll_ != nullptr) {
+    samplePartialAggregation(input);
+  }
   groupingSet_->addInput(input, mayPushdown_);
   numInputRows_ += input->size();
 
@@ -210,15 +315,25 @@ void HashAggregation::addInput(RowVectorPtr input) {
   // NOTE: we should not trigger partial output flush in case of global
   // aggregation as the final aggregator will handle it the same way as the
   // partial aggregator. Hence, we have to use more memory anyway.
+  //
+  // A partial aggregation that has spilled keeps spilling and never flushes
+  // or abandons as the spilled groups are merged and produced only after all
+  // input is received.
+  const bool spilled = groupingSet_->spilledStats().has_value();
   const bool abandonPartialEarly = isPartialOutput_ && !isGlobal_ &&
-      abandonPartialAggregationEarly(groupingSet_->numDistinct());
+      !spilled && abandonPartialAggregationEarly(groupingSet_->numDistinct());
   if (isPartialOutput_ && !isGlobal_ &&
       (abandonPartialEarly ||
        groupingSet_->isPartialFull(maxPartialAggregationMemoryUsage_))) {
-    partialFull_ = true;
+    if (!abandonPartialEarly && spillConfig_.has_value() &&
+        (spilled || !smallTablePartialAggregation_)) {
+      spillPartialAggregation();
+    } else {
+      partialFull_ = true;
+    }
   }
 
-  if (isDistinct_) {
+  if (isDistinct_ && !intraTaskMerge_) {
     newDistincts_ = !groupingSet_->hashLookup().newGroups.empty();
 
     if (newDistincts_) {
@@ -233,6 +348,14 @@ void HashAggregation::addInput(RowVectorPtr input) {
   }
 }
 
+void HashAggregation::spillPartialAggregation() {
+  groupingSet_->spill(0, 0);
+  VELOX_CHECK_EQ(groupingSet_->numRows(), 0);
+  addRuntimeStat("partialAggregationSpills", RuntimeCounter(1));
+  // Release the memory reserved to extend the partial aggregation.
+  pool()->release();
+}
+
 void HashAggregation::updateRuntimeStats() {
   // Report range sizes and number of distinct values for the group-by keys.
   const auto& hashers = groupingSet_->hashLookup().hashers;
@@ -260,6 +383,16 @@ void HashAggregation::updateRuntimeStats() {
       RuntimeMetric(hashTableStats.numDistinct);
   runtimeStats["hashtable.numTombstones"] =
       RuntimeMetric(hashTableStats.numTombstones);
+
+  const auto [retainedBytes, freeBytes] = groupingSet_->variableLengthBytes();
+  if (retainedBytes > 0) {
+    runtimeStats["stringAllocator.freePct"] =
+        RuntimeMetric(100 * freeBytes / retainedBytes);
+  }
+  if (groupingSet_->numCompactions() > 0) {
+    runtimeStats["stringAllocator.numCompactions"] =
+        RuntimeMetric(groupingSet_->numCompactions());
+  }
 }
 
 void HashAggregation::recordSpillStats() {
@@ -322,6 +455,9 @@ void HashAggregation::maybeIncreasePartialAggregationMemoryUsage(
     abandonedPartialAggregation_ = true;
     return;
   }
+  if (smallTablePartialAggregation_) {
+    return;
+  }
   const int64_t extendedPartialAggregationMemoryUsage = std::min(
       maxPartialAggregationMemoryUsage_ * 2,
       maxExtendedPartialAggregationMemoryUsage_);
@@ -348,6 +484,14 @@ RowVectorPtr HashAggregation::getOutput() {
     input_ = nullptr;
     return nullptr;
   }
+  if (intraTaskMerge_ && !mergedPeers_) {
+    // Only the last driver to finish produces output. The others are done once
+    // they are released from waiting for the merge of their tables.
+    if (noMoreInput_ && !future_.valid()) {
+      finished_ = true;
+    }
+    return nullptr;
+  }
   if (abandonedPartialAggregation_) {
     if (noMoreInput_) {
       finished_ = true;
@@ -373,7 +517,7 @@ RowVectorPtr HashAggregation::getOutput() {
     return nullptr;
   }
 
-  if (isDistinct_) {
+  if (isDistinct_ && !intraTaskMerge_) {
     if (!newDistincts_) {
       if (noMoreInput_) {
         finished_ = true;
@@ -417,12 +561,119 @@ RowVectorPtr HashAggregation::getOutput() {
   return output_;
 }
 
+BlockingReason HashAggregation::isBlocked(ContinueFuture* future) {
+  if (future_.valid()) {
+    *future = std::move(future_);
+    return BlockingReason::kWaitForPeers;
+  }
+  return BlockingReason::kNotBlocked;
+}
+
 void HashAggregation::noMoreInput() {
   groupingSet_->noMoreInput();
   Operator::noMoreInput();
   recordSpillStats();
   // Release the extra reserved memory right after processing all the inputs.
   pool()->release();
+  if (intraTaskMerge_) {
+    mergePeers();
+  }
+}
+
+void HashAggregation::mergePeers() {
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<Driver>> peers;
+  // The last driver to finish merges the tables of all drivers and produces
+  // the output. The other drivers wait until their tables are merged and
+  // then finish without output.
+  if (!operatorCtx_->task()->allPeersFinished(
+          planNodeId(), operatorCtx_->driver(), &future_, promises, peers)) {
+    return;
+  }
+
+  auto promisesGuard = folly::makeGuard([&]() {
+    peers.clear();
+    for (auto& promise : promises) {
+      promise.setValue();
+    }
+  });
+
+  auto mergeSet = createMergeGroupingSet();
+  mergeInto(*groupingSet_, *mergeSet);
+  groupingSet_ = std::move(mergeSet);
+  for (auto& peer : peers) {
+    auto* aggregation =
+        dynamic_cast<HashAggregation*>(peer->findOperator(planNodeId()));
+    VELOX_CHECK_NOT_NULL(aggregation);
+    mergeInto(*aggregation->groupingSet_, *groupingSet_);
+    // Frees the table of the peer right away. The peer finishes once
+    // released.
+    aggregation->groupingSet_.reset();
+  }
+  groupingSet_->noMoreInput();
+  mergedPeers_ = true;
+  updateRuntimeStats();
+}
+
+std::unique_ptr<GroupingSet> HashAggregation::createMergeGroupingSet() {
+  const auto numKeys = aggregationNode_->groupingKeys().size();
+  std::vector<std::unique_ptr<VectorHasher>> hashers;
+  for (auto i = 0; i < numKeys; ++i) {
+    hashers.push_back(VectorHasher::create(intermediateType_->childAt(i), i));
+  }
+
+  const auto& aggregates = aggregationNode_->aggregates();
+  std::vector<AggregateInfo> aggregateInfos;
+  aggregateInfos.reserve(aggregates.size());
+  for (auto i = 0; i < aggregates.size(); ++i) {
+    const auto channel = numKeys + i;
+    AggregateInfo info;
+    info.inputs.push_back(channel);
+    info.constantInputs.push_back(nullptr);
+    info.intermediateType = intermediateType_->childAt(channel);
+    info.function = Aggregate::create(
+        aggregates[i].call->name(),
+        core::AggregationNode::Step::kFinal,
+        {info.intermediateType},
+        outputType_->childAt(channel),
+        operatorCtx_->driverCtx()->queryConfig());
+    info.output = channel;
+    aggregateInfos.push_back(std::move(info));
+  }
+
+  return std::make_unique<GroupingSet>(
+      intermediateType_,
+      std::move(hashers),
+      std::vector<column_index_t>{},
+      std::move(aggregateInfos),
+      aggregationNode_->ignoreNullKeys(),
+      false,
+      false,
+      nullptr,
+      &numSpillRuns_,
+      &nonReclaimableSection_,
+      operatorCtx_.get());
+}
+
+void HashAggregation::mergeInto(GroupingSet& source, GroupingSet& target) {
+  const auto batchSize =
+      isGlobal_ ? 1 : outputBatchRows(source.estimateRowSize());
+  RowContainerIterator iterator;
+  RowVectorPtr batch;
+  for (;;) {
+    if (batch != nullptr) {
+      VectorPtr vector = std::move(batch);
+      BaseVector::prepareForReuse(vector, batchSize);
+      batch = std::static_pointer_cast<RowVector>(vector);
+    } else {
+      batch = std::static_pointer_cast<RowVector>(
+          BaseVector::create(intermediateType_, batchSize, pool()));
+    }
+    if (!source.getOutput(batchSize, iterator, batch)) {
+      break;
+    }
+    target.addInput(batch, false);
+  }
 }
 
 bool HashAggregation::isFinished() {
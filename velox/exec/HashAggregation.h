@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/hyperloglog/DenseHll.h"
 #include "velox/exec/GroupingSet.h"
 #include "velox/exec/Operator.h"
 
@@ -37,9 +38,7 @@ class HashAggregation : public Operator {
 
   void noMoreInput() override;
 
-  BlockingReason isBlocked(ContinueFuture* /* unused */) override {
-    return BlockingReason::kNotBlocked;
-  }
+  BlockingReason isBlocked(ContinueFuture* future) override;
 
   bool isFinished() override;
 
@@ -52,6 +51,11 @@ class HashAggregation : public Operator {
  private:
   void updateRuntimeStats();
 
+  // Invoked when a partial aggregation with spilling enabled reaches its
+  // memory limit. Spills all the groups instead of flushing them. The spilled
+  // groups are merged and produced after all input is received.
+  void spillPartialAggregation();
+
   void prepareOutput(vector_size_t size);
 
   // Invoked to reset partial aggregation state if it was full and has been
@@ -73,9 +77,32 @@ class HashAggregation : public Operator {
   // the inputs.
   void recordSpillStats();
 
+  // Adds the grouping keys of 'input' to 'sampleHll_'. After
+  // 'abandonPartialAggregationSampleRows_' rows, decides from the estimated
+  // number of distinct keys whether to abandon the partial aggregation or to
+  // continue with a small hash table, and frees the sampling state.
+  void samplePartialAggregation(const RowVectorPtr& input);
+
+  // Invoked on no more input in intra-task merge mode. The last driver to
+  // finish merges the tables of all drivers into one final table. The other
+  // drivers wait on 'future_' until then.
+  void mergePeers();
+
+  // Returns a grouping set for merging the intermediate results of the
+  // drivers. Its input has the layout of 'intermediateType_'.
+  std::unique_ptr<GroupingSet> createMergeGroupingSet();
+
+  // Adds the groups of 'source' to 'target' as intermediate results.
+  void mergeInto(GroupingSet& source, GroupingSet& target);
+
+  const std::shared_ptr<const core::AggregationNode> aggregationNode_;
+
   const bool isPartialOutput_;
   const bool isGlobal_;
   const bool isDistinct_;
+  // True if the drivers aggregate into tables of their own that the last driver
+  // merges. See QueryConfig::kAggregationIntraTaskMerge.
+  const bool intraTaskMerge_;
   const int64_t maxExtendedPartialAggregationMemoryUsage_;
 
   int64_t maxPartialAggregationMemoryUsage_;
@@ -95,6 +122,28 @@ class HashAggregation : public Operator {
   // are unique, the partial aggregation is not worthwhile.
   const int32_t abandonPartialAggregationMinPct_;
 
+  // Number of input rows to estimate the unique rows pct of a partial
+  // aggregation over. 0 if not estimating.
+  const int32_t abandonPartialAggregationSampleRows_;
+
+  // Hashers, allocator and HyperLogLog for estimating the number of distinct
+  // grouping keys in the first 'abandonPartialAggregationSampleRows_' rows.
+  // Freed after the estimate is made.
+  std::vector<std::unique_ptr<VectorHasher>> sampleHashers_;
+  std::unique_ptr<HashStringAllocator> sampleAllocator_;
+  std::unique_ptr<common::hll::DenseHll> sampleHll_;
+  raw_vector<uint64_t> sampleHashes_;
+  int64_t numSampledRows_{0};
+
+  // True if the sampled input predicts that partial aggregation does not
+  // reduce the cardinality enough. The aggregation is abandoned at the next
+  // flush.
+  bool sampledNonReducing_{false};
+
+  // True if the sampled input predicts a partial reduction. The aggregation
+  // uses a small hash table that is flushed whenever full and is not extended.
+  bool smallTablePartialAggregation_{false};
+
   RowContainerIterator resultIterator_;
   bool pushdownChecked_ = false;
   bool mayPushdown_ = false;
@@ -108,6 +157,17 @@ class HashAggregation : public Operator {
 
   // Possibly reusable output vector.
   RowVectorPtr output_;
+
+  // Grouping keys followed by the intermediate types of the aggregates. Set in
+  // intra-task merge mode.
+  RowTypePtr intermediateType_;
+
+  // Set if waiting for the last driver to merge the tables of all drivers.
+  ContinueFuture future_{ContinueFuture::makeEmpty()};
+
+  // True if this is the last driver and has merged the tables of all drivers
+  // into 'groupingSet_'.
+  bool mergedPeers_{false};
 };
 
 } // namespace facebook::velox::exec
@@ -41,6 +41,77 @@ BlockingReason fromStateToBlockingReason(HashBuild::State state) {
       VELOX_UNREACHABLE(HashBuild::stateName(state));
   }
 }
+
+// Returns true if a bloom filter can be built on a join key of 'type'.
+bool canBuildBloomFilter(const TypePtr& type) {
+  if (type->isDecimal()) {
+    return false;
+  }
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return true;
+    default:
+      return false;
+  }
+}
+
+template <TypeKind Kind>
+void insertIntoBloomFilter(
+    const BaseVector& keys,
+    vector_size_t numRows,
+    BloomFilter<>& bloomFilter) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  const auto* flatKeys = keys.asUnchecked<FlatVector<T>>();
+  for (auto row = 0; row < numRows; ++row) {
+    if (flatKeys->isNullAt(row)) {
+      continue;
+    }
+    if constexpr (std::is_same_v<T, StringView>) {
+      const auto value = flatKeys->valueAt(row);
+      bloomFilter.insert(
+          common::BloomFilterValues::hashBytes(value.data(), value.size()));
+    } else {
+      bloomFilter.insert(
+          common::BloomFilterValues::hashInt64(flatKeys->valueAt(row)));
+    }
+  }
+}
+
+void insertIntoBloomFilter(
+    const BaseVector& keys,
+    vector_size_t numRows,
+    BloomFilter<>& bloomFilter) {
+  switch (keys.typeKind()) {
+    case TypeKind::TINYINT:
+      return insertIntoBloomFilter<TypeKind::TINYINT>(
+          keys, numRows, bloomFilter);
+    case TypeKind::SMALLINT:
+      return insertIntoBloomFilter<TypeKind::SMALLINT>(
+          keys, numRows, bloomFilter);
+    case TypeKind::INTEGER:
+      return insertIntoBloomFilter<TypeKind::INTEGER>(
+          keys, numRows, bloomFilter);
+    case TypeKind::BIGINT:
+      return insertIntoBloomFilter<TypeKind::BIGINT>(
+          keys, numRows, bloomFilter);
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return insertIntoBloomFilter<TypeKind::VARCHAR>(
+          keys, numRows, bloomFilter);
+    default:
+      VELOX_UNREACHABLE("Unexpected bloom filter key type: {}", keys.type());
+  }
+}
+} // namespace
+
+namespace {
+// The number of distinct key hashes tracked to find the skewed keys.
+constexpr int kSkewedKeysCapacity = 64;
 } // namespace
 
 HashBuild::HashBuild(
@@ -63,8 +134,12 @@ HashBuild::HashBuild(
           operatorCtx_->driverCtx()->splitGroupId,
           planNodeId())),
       spillMemoryThreshold_(
-          operatorCtx_->driverCtx()->queryConfig().joinSpillMemoryThreshold()) {
+          operatorCtx_->driverCtx()->queryConfig().joinSpillMemoryThreshold()),
+      skewedKeyFraction_(operatorCtx_->driverCtx()
+                             ->queryConfig()
+                             .joinSpillSkewedKeyFraction()) {
   VELOX_CHECK(pool()->trackUsage());
+  skewedKeys_.setCapacity(kSkewedKeysCapacity);
   VELOX_CHECK_NOT_NULL(joinBridge_);
 
   spillGroup_ = spillEnabled()
@@ -74,6 +149,16 @@ HashBuild::HashBuild(
 
   joinBridge_->addBuilder();
 
+  // The unsplittable spill partitions are joined block by block if the output
+  // for each build row does not depend on the other blocks.
+  const auto blockSize =
+      operatorCtx_->driverCtx()->queryConfig().joinSpillFallbackBlockSize();
+  if (spillEnabled() && blockSize > 0 && !nullAware_ &&
+      (isInnerJoin(joinType_) || isRightJoin(joinType_) ||
+       isRightSemiFilterJoin(joinType_) || isRightSemiProjectJoin(joinType_))) {
+    joinBridge_->enableBlockJoin(spillConfig_.value(), blockSize);
+  }
+
   auto inputType = joinNode_->sources()[1]->outputType();
 
   auto numKeys = joinNode_->rightKeys().size();
@@ -139,6 +224,8 @@ void HashBuild::setupTable() {
   for (int i = numKeys; i < tableType_->size(); ++i) {
     dependentTypes.emplace_back(tableType_->childAt(i));
   }
+  const bool columnarDependents =
+      operatorCtx_->driverCtx()->queryConfig().hashJoinColumnarDependents();
   if (joinNode_->isRightJoin() || joinNode_->isFullJoin() ||
       joinNode_->isRightSemiProjectJoin()) {
     // Do not ignore null keys.
@@ -150,7 +237,8 @@ void HashBuild::setupTable() {
         operatorCtx_->driverCtx()
             ->queryConfig()
             .minTableRowsForParallelJoinBuild(),
-        pool());
+        pool(),
+        columnarDependents);
   } else {
     // (Left) semi and anti join with no extra filter only needs to know whether
     // there is a match. Hence, no need to store entries with duplicate keys.
@@ -170,7 +258,8 @@ void HashBuild::setupTable() {
           operatorCtx_->driverCtx()
               ->queryConfig()
               .minTableRowsForParallelJoinBuild(),
-          pool());
+          pool(),
+          columnarDependents);
     } else {
       // Ignore null keys
       table_ = HashTable<true>::createForJoin(
@@ -181,13 +270,19 @@ void HashBuild::setupTable() {
           operatorCtx_->driverCtx()
               ->queryConfig()
               .minTableRowsForParallelJoinBuild(),
-          pool());
+          pool(),
+          columnarDependents);
     }
   }
+  if (operatorCtx_->driverCtx()->queryConfig().internStringKeys()) {
+    table_->rows()->internStringKeys();
+  }
   analyzeKeys_ = table_->hashMode() != BaseHashTable::HashMode::kHash;
 }
 
-void HashBuild::setupSpiller(SpillPartition* spillPartition) {
+void HashBuild::setupSpiller(
+    SpillPartition* spillPartition,
+    bool unsplittable) {
   VELOX_CHECK_NULL(spiller_);
   VELOX_CHECK_NULL(spillInputReader_);
 
@@ -208,8 +303,10 @@ void HashBuild::setupSpiller(SpillPartition* spillPartition) {
     const auto startBit = spillPartition->id().partitionBitOffset() +
         spillConfig.joinPartitionBits;
     // Disable spilling if exceeding the max spill level and the query might run
-    // out of memory if the restored partition still can't fit in memory.
-    if (spillConfig.exceedJoinSpillLevelLimit(startBit)) {
+    // out of memory if the restored partition still can't fit in memory. An
+    // unsplittable partition is restored one block at a time instead, each
+    // expected to fit in memory.
+    if (unsplittable || spillConfig.exceedJoinSpillLevelLimit(startBit)) {
       return;
     }
     hashBits = HashBitRange(startBit, startBit + spillConfig.joinPartitionBits);
@@ -228,7 +325,8 @@ void HashBuild::setupSpiller(SpillPartition* spillPartition) {
       spillConfig.minSpillRunSize,
       spillConfig.compressionKind,
       Spiller::pool(),
-      spillConfig.executor);
+      spillConfig.executor,
+      spillConfig.extraFilePaths);
 
   const int32_t numPartitions = spiller_->hashBits().numPartitions();
   spillInputIndicesBuffers_.resize(numPartitions);
@@ -360,6 +458,7 @@ void HashBuild::addInput(RowVectorPtr input) {
     return;
   }
 
+  trackSkewedKeys();
   spillInput(input);
   if (!activeRows_.hasSelections()) {
     return;
@@ -572,7 +671,7 @@ void HashBuild::prepareInputIndicesBuffers(
   std::fill(numSpillInputs_.begin(), numSpillInputs_.end(), 0);
 }
 
-void HashBuild::computeSpillPartitions(const RowVectorPtr& input) {
+void HashBuild::computeHashes() {
   if (hashes_.size() < activeRows_.end()) {
     hashes_.resize(activeRows_.end());
   }
@@ -585,6 +684,36 @@ void HashBuild::computeSpillPartitions(const RowVectorPtr& input) {
       hashers[i]->hashPrecomputed(activeRows_, i > 0, hashes_);
     }
   }
+}
+
+void HashBuild::trackSkewedKeys() {
+  if (!spillEnabled() || skewedKeyFraction_ == 0 ||
+      !activeRows_.hasSelections()) {
+    return;
+  }
+  computeHashes();
+  activeRows_.applyToSelected(
+      [&](auto row) { skewedKeys_.insert(hashes_[row]); });
+  numSkewedKeyRows_ += activeRows_.countSelected();
+}
+
+SpillPartitionNumSet HashBuild::skewedSpillPartitions() const {
+  SpillPartitionNumSet partitions;
+  if (numSkewedKeyRows_ == 0) {
+    return partitions;
+  }
+  const auto minCount = skewedKeyFraction_ * numSkewedKeyRows_;
+  for (auto i = 0; i < skewedKeys_.size(); ++i) {
+    if (skewedKeys_.counts()[i] >= minCount) {
+      partitions.insert(
+          spiller_->hashBits().partition(skewedKeys_.values()[i]));
+    }
+  }
+  return partitions;
+}
+
+void HashBuild::computeSpillPartitions(const RowVectorPtr& input) {
+  computeHashes();
 
   spillPartitions_.resize(input->size());
   for (auto i = 0; i < spillPartitions_.size(); ++i) {
@@ -644,12 +773,15 @@ void HashBuild::runSpill(const std::vector<Operator*>& spillOperators) {
   uint64_t targetBytes = 0;
   std::vector<Spiller*> spillers;
   spillers.reserve(spillOperators.size());
+  SpillPartitionNumSet skewedPartitions;
   for (auto& spillOp : spillOperators) {
     HashBuild* build = dynamic_cast<HashBuild*>(spillOp);
     VELOX_CHECK_NOT_NULL(build);
     ++build->numSpillRuns_;
     spillers.push_back(build->spiller_.get());
     build->addAndClearSpillTarget(targetRows, targetBytes);
+    const auto partitions = build->skewedSpillPartitions();
+    skewedPartitions.insert(partitions.begin(), partitions.end());
   }
   VELOX_CHECK_GT(targetRows, 0);
   VELOX_CHECK_GT(targetBytes, 0);
@@ -660,7 +792,10 @@ void HashBuild::runSpill(const std::vector<Operator*>& spillOperators) {
     spiller->fillSpillRuns(spillableStats);
   }
 
-  // Sort the partitions based on the amount of spillable data.
+  // Sort the partitions based on the amount of spillable data. The partitions
+  // with skewed keys go last so that they stay in memory if spilling the
+  // others is enough. Otherwise the probe rows of a skewed key would all be
+  // spilled into one partition and processed by a single driver on restore.
   SpillPartitionNumSet partitionsToSpill;
   std::vector<int32_t> partitionIndices(spillableStats.size());
   std::iota(partitionIndices.begin(), partitionIndices.end(), 0);
@@ -668,13 +803,18 @@ void HashBuild::runSpill(const std::vector<Operator*>& spillOperators) {
       partitionIndices.begin(),
       partitionIndices.end(),
       [&](int32_t lhs, int32_t rhs) {
+        const bool lhsSkewed = skewedPartitions.count(lhs) != 0;
+        const bool rhsSkewed = skewedPartitions.count(rhs) != 0;
+        if (lhsSkewed != rhsSkewed) {
+          return rhsSkewed;
+        }
         return spillableStats[lhs].numBytes > spillableStats[rhs].numBytes;
       });
   int64_t numRows = 0;
   int64_t numBytes = 0;
   for (auto partitionNum : partitionIndices) {
     if (spillableStats[partitionNum].numBytes == 0) {
-      break;
+      continue;
     }
     partitionsToSpill.insert(partitionNum);
     numRows += spillableStats[partitionNum].numRows;
@@ -685,6 +825,18 @@ void HashBuild::runSpill(const std::vector<Operator*>& spillOperators) {
   }
   VELOX_CHECK(!partitionsToSpill.empty());
 
+  uint64_t numSkewedInMemory = 0;
+  for (auto partitionNum : skewedPartitions) {
+    if (spillableStats[partitionNum].numBytes != 0 &&
+        partitionsToSpill.count(partitionNum) == 0) {
+      ++numSkewedInMemory;
+    }
+  }
+  if (numSkewedInMemory != 0) {
+    stats_.wlock()->addRuntimeStat(
+        "skewedPartitionsInMemory", RuntimeCounter(numSkewedInMemory));
+  }
+
   // TODO: consider to offload the partition spill processing to an executor to
   // run in parallel.
   for (auto* spiller : spillers) {
@@ -816,8 +968,14 @@ bool HashBuild::finishHashBuild() {
       allowParallelJoinBuild ? operatorCtx_->task()->queryCtx()->executor()
                              : nullptr);
   addRuntimeStats();
+  auto bloomFilters = spillPartitions.empty() && !isInputFromSpill()
+      ? createBloomFilters()
+      : std::vector<std::shared_ptr<common::Filter>>{};
   if (joinBridge_->setHashTable(
-          std::move(table_), std::move(spillPartitions), joinHasNullKeys_)) {
+          std::move(table_),
+          std::move(spillPartitions),
+          joinHasNullKeys_,
+          std::move(bloomFilters))) {
     spillGroup_->restart();
   }
 
@@ -827,6 +985,90 @@ bool HashBuild::finishHashBuild() {
   return true;
 }
 
+std::vector<std::shared_ptr<common::Filter>> HashBuild::createBloomFilters() {
+  const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
+  const uint64_t maxSize = queryConfig.hashJoinBloomFilterMaxSize();
+  if (maxSize == 0 || table_->numDistinct() == 0 ||
+      !(isInnerJoin(joinType_) || isLeftSemiFilterJoin(joinType_) ||
+        isRightSemiFilterJoin(joinType_) ||
+        isRightSemiProjectJoin(joinType_))) {
+    return {};
+  }
+  const double falsePositiveRate =
+      queryConfig.hashJoinBloomFilterFalsePositiveRate();
+  VELOX_USER_CHECK(
+      falsePositiveRate > 0 && falsePositiveRate < 1,
+      "Invalid hash join bloom filter false positive rate: {}",
+      falsePositiveRate);
+
+  // 'BloomFilter' sets 4 bits per value and allocates 16 bits per unit of
+  // capacity. Size it so that the number of bits per distinct key gives the
+  // target false positive rate.
+  const double bitsPerValue =
+      -4 / std::log(1 - std::pow(falsePositiveRate, 0.25));
+  const uint64_t capacity =
+      std::ceil(table_->numDistinct() * bitsPerValue / 16);
+  const uint64_t size =
+      std::max<uint64_t>(4, bits::nextPowerOfTwo(capacity) / 4) *
+      sizeof(uint64_t);
+  if (size > maxSize) {
+    return {};
+  }
+
+  const auto& hashers = table_->hashers();
+  std::vector<std::unique_ptr<BloomFilter<>>> bloomFilters(hashers.size());
+  std::vector<VectorPtr> keys(hashers.size());
+  bool hasBloomFilter{false};
+  for (auto i = 0; i < hashers.size(); ++i) {
+    // Skip the keys that can be pushed down as a range or a list of values.
+    if (!canBuildBloomFilter(hashers[i]->type()) ||
+        (table_->hashMode() != BaseHashTable::HashMode::kHash &&
+         hashers[i]->getFilter(false) != nullptr)) {
+      continue;
+    }
+    bloomFilters[i] = std::make_unique<BloomFilter<>>();
+    bloomFilters[i]->reset(capacity);
+    keys[i] = BaseVector::create(hashers[i]->type(), 0, pool());
+    hasBloomFilter = true;
+  }
+  if (!hasBloomFilter) {
+    return {};
+  }
+
+  static constexpr int32_t kBatchSize = 1'024;
+  std::vector<char*> rows(kBatchSize);
+  BaseHashTable::RowsIterator iter;
+  int32_t numRows;
+  while ((numRows = table_->listAllRows(
+              &iter, kBatchSize, RowContainer::kUnlimited, rows.data())) > 0) {
+    for (auto i = 0; i < bloomFilters.size(); ++i) {
+      if (bloomFilters[i] == nullptr) {
+        continue;
+      }
+      keys[i]->resize(numRows);
+      table_->rows()->extractColumn(rows.data(), numRows, i, keys[i]);
+      insertIntoBloomFilter(*keys[i], numRows, *bloomFilters[i]);
+    }
+  }
+
+  std::vector<std::shared_ptr<common::Filter>> filters(hashers.size());
+  int32_t numBloomFilters{0};
+  for (auto i = 0; i < bloomFilters.size(); ++i) {
+    if (bloomFilters[i] != nullptr) {
+      filters[i] = std::make_shared<common::BloomFilterValues>(
+          std::move(bloomFilters[i]), false);
+      ++numBloomFilters;
+    }
+  }
+  auto lockedStats = stats_.wlock();
+  lockedStats->addRuntimeStat(
+      "bloomFilters", RuntimeCounter(numBloomFilters));
+  lockedStats->addRuntimeStat(
+      "bloomFilterSize",
+      RuntimeCounter(numBloomFilters * size, RuntimeCounter::Unit::kBytes));
+  return filters;
+}
+
 void HashBuild::recordSpillStats() {
   VELOX_CHECK_NOT_NULL(spiller_);
   const auto spillStats = spiller_->stats();
@@ -890,6 +1132,9 @@ void HashBuild::setupSpillInput(HashJoinBridge::SpillInput spillInput) {
   table_.reset();
   spiller_.reset();
   spillInputReader_.reset();
+  skewedKeys_ = functions::ApproxMostFrequentStreamSummary<uint64_t>();
+  skewedKeys_.setCapacity(kSkewedKeysCapacity);
+  numSkewedKeyRows_ = 0;
 
   // Reset the key and dependent channels as the spilled data columns have
   // already been ordered.
@@ -900,7 +1145,11 @@ void HashBuild::setupSpillInput(HashJoinBridge::SpillInput spillInput) {
       keyChannels_.size());
 
   setupTable();
-  setupSpiller(spillInput.spillPartition.get());
+  setupSpiller(spillInput.spillPartition.get(), spillInput.unsplittable);
+  if (spillInput.unsplittable) {
+    stats_.wlock()->addRuntimeStat(
+        "unsplittableSpillInputs", RuntimeCounter(1));
+  }
 
   // Start to process spill input.
   processSpillInput();
@@ -24,6 +24,7 @@
 #include "velox/exec/UnorderedStreamReader.h"
 #include "velox/exec/VectorHasher.h"
 #include "velox/expression/Expr.h"
+#include "velox/functions/lib/ApproxMostFrequentStreamSummary.h"
 
 namespace facebook::velox::exec {
 
@@ -130,8 +131,11 @@ class HashBuild final : public Operator {
   // is not null, then the input is from the spilled data instead of from build
   // source. The function will need to setup a spill input reader to read input
   // from the spilled data for restoring. If the spilled data can't still fit
-  // in memory, then we will recursively spill part(s) of its data on disk.
-  void setupSpiller(SpillPartition* spillPartition = nullptr);
+  // in memory, then we will recursively spill part(s) of its data on disk,
+  // unless 'unsplittable' is true, see HashJoinBridge::enableBlockJoin().
+  void setupSpiller(
+      SpillPartition* spillPartition = nullptr,
+      bool unsplittable = false);
 
   // Invoked when either there is no more input from the build source or from
   // the spill input reader during the restoring.
@@ -178,6 +182,18 @@ class HashBuild final : public Operator {
   // enabled. The computed partition numbers are stored in 'spillPartitions_'.
   void computeSpillPartitions(const RowVectorPtr& input);
 
+  // Computes the hashes of the join keys of 'activeRows_' into 'hashes_'. The
+  // hashes are the ones used to compute the spill partition numbers.
+  void computeHashes();
+
+  // Invoked to add the key hashes of 'activeRows_' to 'skewedKeys_' if disk
+  // spilling is enabled and 'skewedKeyFraction_' is not zero.
+  void trackSkewedKeys();
+
+  // Returns the spill partitions of the keys that account for at least
+  // 'skewedKeyFraction_' of the rows tracked in 'skewedKeys_'.
+  SpillPartitionNumSet skewedSpillPartitions() const;
+
   // Invoked to set up 'spillChildVectors_' for spill if 'input' is from build
   // source.
   void maybeSetupSpillChildVectors(const RowVectorPtr& input);
@@ -233,6 +249,15 @@ class HashBuild final : public Operator {
 
   void addRuntimeStats();
 
+  // Invoked by the last build driver after the join table has been built to
+  // create the bloom filters to push down into the probe side table scan. The
+  // bloom filters are only built for the join keys which can't be pushed down
+  // as a range or a list of values, and are bounded in size by
+  // 'hash_join_bloom_filter_max_size'. Returns one entry per join key, which
+  // is null if there is no bloom filter on the key, or an empty vector if no
+  // bloom filter has been built.
+  std::vector<std::shared_ptr<common::Filter>> createBloomFilters();
+
   // Invoked to check if it needs to trigger spilling for test purpose only.
   bool testingTriggerSpill();
 
@@ -307,6 +332,17 @@ class HashBuild final : public Operator {
   std::vector<vector_size_t*> rawSpillInputIndicesBuffers_;
   std::vector<VectorPtr> spillChildVectors_;
 
+  // The min fraction of the tracked build rows that a key must account for
+  // to be treated as skewed. Zero disables the skewed key tracking.
+  const double skewedKeyFraction_;
+
+  // The approximate most frequent key hashes of the build input and the
+  // number of rows added to it. The spill partitions of the skewed keys are
+  // spilled last by 'runSpill()' so that the probe rows with these keys don't
+  // all end up in the same spilled partition.
+  functions::ApproxMostFrequentStreamSummary<uint64_t> skewedKeys_;
+  uint64_t numSkewedKeyRows_{0};
+
   // Indicates whether the filter is null-propagating.
   bool filterPropagatesNulls_{false};
 
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <algorithm>
 #include <re2/re2.h>
 
 #include "velox/exec/HashJoinBridge.h"
@@ -38,10 +39,38 @@ void HashJoinBridge::addBuilder() {
   ++numBuilders_;
 }
 
+void HashJoinBridge::enableBlockJoin(
+    const Spiller::Config& spillConfig,
+    uint64_t blockSize) {
+  VELOX_CHECK_GT(blockSize, 0);
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(!started_);
+  blockJoinSpillConfig_ = spillConfig;
+  blockJoinBlockSize_ = blockSize;
+}
+
+bool HashJoinBridge::isUnsplittable(const SpillPartition& partition) const {
+  if (!blockJoinSpillConfig_.has_value()) {
+    return false;
+  }
+  const auto& config = blockJoinSpillConfig_.value();
+  if (config.exceedJoinSpillLevelLimit(
+          partition.id().partitionBitOffset() + config.joinPartitionBits)) {
+    return true;
+  }
+  // Most of the data went into the same partition when the restoring
+  // partition was split, so splitting it again will not help either. This
+  // only matters if the partition does not fit in one block.
+  const auto size = partition.size();
+  return restoringSpillPartitionId_.has_value() && size > blockJoinBlockSize_ &&
+      size >= kUnsplittableSizeRatio * restoringSpillPartitionSize_;
+}
+
 bool HashJoinBridge::setHashTable(
     std::unique_ptr<BaseHashTable> table,
     SpillPartitionSet spillPartitionSet,
-    bool hasNullKeys) {
+    bool hasNullKeys,
+    std::vector<std::shared_ptr<common::Filter>> bloomFilters) {
   VELOX_CHECK_NOT_NULL(table, "setHashTable called with null table");
 
   auto spillPartitionIdSet = toSpillPartitionIdSet(spillPartitionSet);
@@ -65,16 +94,23 @@ bool HashJoinBridge::setHashTable(
     for (auto& partitionEntry : spillPartitionSet) {
       const auto id = partitionEntry.first;
       VELOX_CHECK_EQ(spillPartitionSets_.count(id), 0);
+      if (isUnsplittable(*partitionEntry.second)) {
+        unsplittablePartitionIds_.insert(id);
+      }
       spillPartitionSets_.emplace(id, std::move(partitionEntry.second));
     }
     buildResult_ = HashBuildResult(
         std::move(table),
         std::move(restoringSpillPartitionId_),
         std::move(spillPartitionIdSet),
-        hasNullKeys);
+        hasNullKeys,
+        std::move(bloomFilters),
+        !restoringSpillBlocks_.empty());
     restoringSpillPartitionId_.reset();
+    restoringUnsplittable_ = false;
 
-    hasSpillData = !spillPartitionSets_.empty();
+    hasSpillData =
+        !spillPartitionSets_.empty() || !restoringSpillBlocks_.empty();
     promises = std::move(promises_);
   }
   notify(std::move(promises));
@@ -92,6 +128,9 @@ void HashJoinBridge::setAntiJoinHasNullKeys() {
 
     buildResult_ = HashBuildResult{};
     restoringSpillPartitionId_.reset();
+    restoringUnsplittable_ = false;
+    restoringSpillBlocks_.clear();
+    unsplittablePartitionIds_.clear();
     spillPartitions.swap(spillPartitionSets_);
     promises = std::move(promises_);
   }
@@ -133,13 +172,33 @@ bool HashJoinBridge::probeFinished() {
     // table from the next spill partition now.
     buildResult_.reset();
 
-    if (!spillPartitionSets_.empty()) {
+    std::unique_ptr<SpillPartition> partition;
+    if (!restoringSpillBlocks_.empty()) {
+      // The next block of the partition of the table just probed.
+      partition = std::move(restoringSpillBlocks_.back());
+      restoringSpillBlocks_.pop_back();
+      restoringUnsplittable_ = true;
+    } else if (!spillPartitionSets_.empty()) {
+      auto iter = spillPartitionSets_.begin();
+      partition = std::move(iter->second);
+      restoringUnsplittable_ = unsplittablePartitionIds_.erase(iter->first) > 0;
+      spillPartitionSets_.erase(iter);
+      restoringSpillPartitionSize_ = partition->size();
+      if (restoringUnsplittable_ &&
+          restoringSpillPartitionSize_ > blockJoinBlockSize_) {
+        restoringSpillBlocks_ = partition->splitBlocks(blockJoinBlockSize_);
+        std::reverse(
+            restoringSpillBlocks_.begin(), restoringSpillBlocks_.end());
+        partition = std::move(restoringSpillBlocks_.back());
+        restoringSpillBlocks_.pop_back();
+      }
+    }
+
+    if (partition != nullptr) {
       hasSpillInput = true;
-      restoringSpillPartitionId_ = spillPartitionSets_.begin()->first;
-      restoringSpillShards_ =
-          spillPartitionSets_.begin()->second->split(numBuilders_);
+      restoringSpillPartitionId_ = partition->id();
+      restoringSpillShards_ = partition->split(numBuilders_);
       VELOX_CHECK_EQ(restoringSpillShards_.size(), numBuilders_);
-      spillPartitionSets_.erase(spillPartitionSets_.begin());
       promises = std::move(promises_);
     } else {
       VELOX_CHECK(promises_.empty());
@@ -158,7 +217,7 @@ std::optional<HashJoinBridge::SpillInput> HashJoinBridge::spillInputOrFuture(
       !restoringSpillPartitionId_.has_value() || !buildResult_.has_value());
 
   if (!restoringSpillPartitionId_.has_value()) {
-    if (spillPartitionSets_.empty()) {
+    if (spillPartitionSets_.empty() && restoringSpillBlocks_.empty()) {
       return HashJoinBridge::SpillInput{};
     } else {
       promises_.emplace_back("HashJoinBridge::spillInputOrFuture");
@@ -169,7 +228,7 @@ std::optional<HashJoinBridge::SpillInput> HashJoinBridge::spillInputOrFuture(
   VELOX_CHECK(!restoringSpillShards_.empty());
   auto spillShard = std::move(restoringSpillShards_.back());
   restoringSpillShards_.pop_back();
-  return SpillInput(std::move(spillShard));
+  return SpillInput(std::move(spillShard), restoringUnsplittable_);
 }
 
 bool isLeftNullAwareJoinWithFilter(
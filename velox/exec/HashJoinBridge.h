@@ -18,6 +18,7 @@
 #include "velox/exec/HashTable.h"
 #include "velox/exec/JoinBridge.h"
 #include "velox/exec/Spill.h"
+#include "velox/exec/Spiller.h"
 
 namespace facebook::velox::exec {
 
@@ -34,14 +35,37 @@ class HashJoinBridge : public JoinBridge {
   /// HashBuild operators to parallelize the restoring operation.
   void addBuilder();
 
+  /// Invoked by HashBuild operator ctor to join the spill partitions that can
+  /// not be split further one block at a time. A spill partition can not be
+  /// split further if restoring it with 'spillConfig' would exceed the max
+  /// spill level, or if it is larger than 'blockSize' and holds at least
+  /// kUnsplittableSizeRatio of the spill data of the partition it was split
+  /// from, e.g. because of a single hot key. Such a partition is split into
+  /// blocks of at most 'blockSize' bytes
+  /// of spill files. The HashBuild operators build a hash table from each
+  /// block without spilling, and the HashProbe operators probe each table
+  /// with all the probe rows of the partition. This is only correct for the
+  /// join types that produce the output of a probe row from the matches of
+  /// each build row independently, i.e. inner, right and right semi joins.
+  void enableBlockJoin(const Spiller::Config& spillConfig, uint64_t blockSize);
+
+  /// The min ratio of the size of a spill partition to the size of the
+  /// partition it was split from for the partition to be considered not
+  /// splittable.
+  static constexpr double kUnsplittableSizeRatio = 0.9;
+
   /// 'spillPartitionSet' contains the spilled partitions while building
   /// 'table'. The function returns true if there is spill data to restore
   /// after HashProbe operators process 'table', otherwise false. This only
-  /// applies if the disk spilling is enabled.
+  /// applies if the disk spilling is enabled. 'bloomFilters' contains the
+  /// bloom filters built on the join keys of 'table' to push down into the
+  /// probe side, one per join key with null for the keys without a bloom
+  /// filter. It is empty if no bloom filter has been built.
   bool setHashTable(
       std::unique_ptr<BaseHashTable> table,
       SpillPartitionSet spillPartitionSet,
-      bool hasNullKeys);
+      bool hasNullKeys,
+      std::vector<std::shared_ptr<common::Filter>> bloomFilters = {});
 
   void setAntiJoinHasNullKeys();
 
@@ -51,16 +75,25 @@ class HashJoinBridge : public JoinBridge {
   /// a build side entry with a null in a join key makes the join return
   /// nothing. In this case, HashBuild operators finishes early without
   /// processing all the input and without finishing building the hash table.
+  ///
+  /// If 'restoredPartitionHasMoreBlocks' is true, then the table is built from
+  /// a block of the restored partition which is followed by other blocks, and
+  /// the HashProbe operators must keep the probe rows of the partition to probe
+  /// the tables of the next blocks with.
   struct HashBuildResult {
     HashBuildResult(
         std::shared_ptr<BaseHashTable> _table,
         std::optional<SpillPartitionId> _restoredPartitionId,
         SpillPartitionIdSet _spillPartitionIds,
-        bool _hasNullKeys)
+        bool _hasNullKeys,
+        std::vector<std::shared_ptr<common::Filter>> _bloomFilters = {},
+        bool _restoredPartitionHasMoreBlocks = false)
         : hasNullKeys(_hasNullKeys),
           table(std::move(_table)),
           restoredPartitionId(std::move(_restoredPartitionId)),
-          spillPartitionIds(std::move(_spillPartitionIds)) {}
+          spillPartitionIds(std::move(_spillPartitionIds)),
+          bloomFilters(std::move(_bloomFilters)),
+          restoredPartitionHasMoreBlocks(_restoredPartitionHasMoreBlocks) {}
 
     HashBuildResult() : hasNullKeys(true) {}
 
@@ -68,6 +101,8 @@ class HashJoinBridge : public JoinBridge {
     std::shared_ptr<BaseHashTable> table;
     std::optional<SpillPartitionId> restoredPartitionId;
     SpillPartitionIdSet spillPartitionIds;
+    std::vector<std::shared_ptr<common::Filter>> bloomFilters;
+    bool restoredPartitionHasMoreBlocks{false};
   };
 
   /// Invoked by HashProbe operator to get the table to probe which is built by
@@ -86,13 +121,18 @@ class HashJoinBridge : public JoinBridge {
 
   /// Contains the spill input for one HashBuild operator: a shard of previously
   /// spilled partition data. 'spillPartition' is null if there is no more spill
-  /// data to restore.
+  /// data to restore. 'unsplittable' is true if the partition can not be split
+  /// further and the shard is part of a block to build a table from without
+  /// spilling, see enableBlockJoin().
   struct SpillInput {
     explicit SpillInput(
-        std::unique_ptr<SpillPartition> spillPartition = nullptr)
-        : spillPartition(std::move(spillPartition)) {}
+        std::unique_ptr<SpillPartition> spillPartition = nullptr,
+        bool unsplittable = false)
+        : spillPartition(std::move(spillPartition)),
+          unsplittable(unsplittable) {}
 
     std::unique_ptr<SpillPartition> spillPartition;
+    bool unsplittable;
   };
 
   /// Invoked by HashBuild operator to get one of previously spilled partition
@@ -105,6 +145,10 @@ class HashJoinBridge : public JoinBridge {
       ContinueFuture* FOLLY_NONNULL future);
 
  private:
+  // Returns true if 'partition', which is split from the restoring partition
+  // if any, can not be split further. See enableBlockJoin().
+  bool isUnsplittable(const SpillPartition& partition) const;
+
   uint32_t numBuilders_{0};
 
   std::optional<HashBuildResult> buildResult_;
@@ -123,6 +167,26 @@ class HashJoinBridge : public JoinBridge {
   // of spill files and will be processed by one of the HashBuild operator.
   std::vector<std::unique_ptr<SpillPartition>> restoringSpillShards_;
 
+  // The size of the spill data of the restoring partition, used to detect the
+  // partitions split from it that can not be split further.
+  uint64_t restoringSpillPartitionSize_{0};
+
+  // True if the restoring partition can not be split further.
+  bool restoringUnsplittable_{false};
+
+  // The blocks of the restoring partition which remain to be restored after
+  // the current one, in reverse order, if the partition can not be split
+  // further.
+  std::vector<std::unique_ptr<SpillPartition>> restoringSpillBlocks_;
+
+  // Set by enableBlockJoin().
+  std::optional<Spiller::Config> blockJoinSpillConfig_;
+  uint64_t blockJoinBlockSize_{0};
+
+  // The ids of the partitions in 'spillPartitionSets_' that can not be split
+  // further.
+  SpillPartitionIdSet unsplittablePartitionIds_;
+
   // The spill partitions remaining to restore. This set is populated using
   // information provided by the HashBuild operators if spilling is enabled.
   // This set can grow if HashBuild operator cannot load full partition in
@@ -74,6 +74,74 @@ void extractColumns(
   }
 }
 
+// Extracts a build side column for the rows of a batch of probe output on
+// first use. Downstream filters and limits load only the rows they pass, so
+// that the build side values of the other rows are not copied. Keeps the
+// table alive and shares the row pointers with the loaders of the other
+// columns of the batch.
+class BuildColumnLoader : public VectorLoader {
+ public:
+  BuildColumnLoader(
+      std::shared_ptr<BaseHashTable> table,
+      std::shared_ptr<const std::vector<char*>> rows,
+      column_index_t column,
+      TypePtr type,
+      memory::MemoryPool* pool)
+      : table_(std::move(table)),
+        rows_(std::move(rows)),
+        column_(column),
+        type_(std::move(type)),
+        pool_(pool) {}
+
+  void loadInternal(RowSet rows, ValueHook* hook, VectorPtr* result) override {
+    VELOX_CHECK_NULL(hook, "BuildColumnLoader doesn't support ValueHook");
+    const auto size = rows.empty() ? 0 : rows.back() + 1;
+    VELOX_CHECK_LE(size, rows_->size());
+    *result = BaseVector::create(type_, size, pool_);
+    if (rows.size() == size) {
+      table_->rows()->extractColumn(rows_->data(), size, column_, *result);
+      return;
+    }
+    // Null row pointers extract nulls for the rows not to load.
+    std::vector<char*> selectedRows(size, nullptr);
+    for (auto row : rows) {
+      selectedRows[row] = (*rows_)[row];
+    }
+    table_->rows()->extractColumn(selectedRows.data(), size, column_, *result);
+  }
+
+ private:
+  const std::shared_ptr<BaseHashTable> table_;
+  const std::shared_ptr<const std::vector<char*>> rows_;
+  const column_index_t column_;
+  const TypePtr type_;
+  memory::MemoryPool* const pool_;
+};
+
+// Sets the children of 'result' for 'projections' to lazy vectors that
+// extract the values of 'rows' of 'table' when loaded.
+void makeLazyColumns(
+    const std::shared_ptr<BaseHashTable>& table,
+    folly::Range<char**> rows,
+    folly::Range<const IdentityProjection*> projections,
+    memory::MemoryPool* pool,
+    const RowVectorPtr& result) {
+  if (projections.empty()) {
+    return;
+  }
+  auto sharedRows =
+      std::make_shared<const std::vector<char*>>(rows.begin(), rows.end());
+  for (auto projection : projections) {
+    const auto& type = result->type()->childAt(projection.outputChannel);
+    result->childAt(projection.outputChannel) = std::make_shared<LazyVector>(
+        pool,
+        type,
+        rows.size(),
+        std::make_unique<BuildColumnLoader>(
+            table, sharedRows, projection.inputChannel, type, pool));
+  }
+}
+
 BlockingReason fromStateToBlockingReason(ProbeOperatorState state) {
   switch (state) {
     case ProbeOperatorState::kRunning:
@@ -212,7 +280,8 @@ void HashProbe::initializeFilter(
 
 void HashProbe::maybeSetupSpillInput(
     const std::optional<SpillPartitionId>& restoredPartitionId,
-    const SpillPartitionIdSet& spillPartitionIds) {
+    const SpillPartitionIdSet& spillPartitionIds,
+    bool restoredPartitionHasMoreBlocks) {
   VELOX_CHECK_NULL(spillInputReader_);
 
   // If 'restoredPartitionId' is not null, then 'table_' is built from the
@@ -221,10 +290,14 @@ void HashProbe::maybeSetupSpillInput(
   if (restoredPartitionId.has_value()) {
     auto iter = spillPartitionSet_.find(restoredPartitionId.value());
     VELOX_CHECK(iter != spillPartitionSet_.end());
-    auto partition = std::move(iter->second);
-    VELOX_CHECK_EQ(partition->id(), restoredPartitionId.value());
-    spillInputReader_ = partition->createReader();
-    spillPartitionSet_.erase(iter);
+    VELOX_CHECK_EQ(iter->second->id(), restoredPartitionId.value());
+    if (restoredPartitionHasMoreBlocks) {
+      spillInputReader_ = iter->second->createSharedReader();
+    } else {
+      auto partition = std::move(iter->second);
+      spillInputReader_ = partition->createReader();
+      spillPartitionSet_.erase(iter);
+    }
   }
 
   VELOX_CHECK_NULL(spiller_);
@@ -249,7 +322,8 @@ void HashProbe::maybeSetupSpillInput(
       spillConfig.minSpillRunSize,
       spillConfig.compressionKind,
       Spiller::pool(),
-      spillConfig.executor);
+      spillConfig.executor,
+      spillConfig.extraFilePaths);
   // Set the spill partitions to the corresponding ones at the build side. The
   // hash probe operator itself won't trigger any spilling.
   spiller_->setPartitionsSpilled(toPartitionNumSet(spillInputPartitionIds_));
@@ -289,7 +363,9 @@ void HashProbe::asyncWaitForHashTable() {
   VELOX_CHECK_NOT_NULL(table_);
 
   maybeSetupSpillInput(
-      hashBuildResult->restoredPartitionId, hashBuildResult->spillPartitionIds);
+      hashBuildResult->restoredPartitionId,
+      hashBuildResult->spillPartitionIds,
+      hashBuildResult->restoredPartitionHasMoreBlocks);
 
   if (table_->numDistinct() == 0) {
     if (skipProbeOnEmptyBuild()) {
@@ -307,24 +383,36 @@ void HashProbe::asyncWaitForHashTable() {
   } else if (
       (isInnerJoin(joinType_) || isLeftSemiFilterJoin(joinType_) ||
        isRightSemiFilterJoin(joinType_) || isRightSemiProjectJoin(joinType_)) &&
-      table_->hashMode() != BaseHashTable::HashMode::kHash && !isSpillInput() &&
-      !hasMoreSpillData()) {
+      (table_->hashMode() != BaseHashTable::HashMode::kHash ||
+       !hashBuildResult->bloomFilters.empty()) &&
+      !isSpillInput() && !hasMoreSpillData()) {
     // Find out whether there are any upstream operators that can accept
     // dynamic filters on all or a subset of the join keys. Create dynamic
-    // filters to push down.
+    // filters to push down. The join keys which can't be expressed as a range
+    // or a list of values use the bloom filters built by the build side if
+    // any.
     //
     // NOTE: this optimization is not applied in the following cases: (1) if the
     // probe input is read from spilled data and there is no upstream operators
     // involved; (2) if there is spill data to restore, then we can't filter
     // probe inputs solely based on the current table's join keys.
     const auto& buildHashers = table_->hashers();
+    const auto& bloomFilters = hashBuildResult->bloomFilters;
     auto channels = operatorCtx_->driverCtx()->driver->canPushdownFilters(
         this, keyChannels_);
     for (auto i = 0; i < keyChannels_.size(); i++) {
-      if (channels.find(keyChannels_[i]) != channels.end()) {
-        if (auto filter = buildHashers[i]->getFilter(false)) {
-          dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
-        }
+      if (channels.find(keyChannels_[i]) == channels.end()) {
+        continue;
+      }
+      std::shared_ptr<common::Filter> filter;
+      if (table_->hashMode() != BaseHashTable::HashMode::kHash) {
+        filter = buildHashers[i]->getFilter(false);
+      }
+      if (filter == nullptr && !bloomFilters.empty()) {
+        filter = bloomFilters[i];
+      }
+      if (filter != nullptr) {
+        dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
       }
     }
   }
@@ -484,9 +572,12 @@ void HashProbe::clearDynamicFilters() {
   // The join can be completely replaced with a pushed down
   // filter when the following conditions are met:
   //  * hash table has a single key with unique values,
-  //  * build side has no dependent columns.
+  //  * build side has no dependent columns,
+  //  * the pushed down filter is exact, i.e. not a bloom filter.
   if (keyChannels_.size() == 1 && !table_->hasDuplicateKeys() &&
-      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty()) {
+      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty() &&
+      dynamicFilters_.begin()->second->kind() !=
+          common::FilterKind::kBloomFilterValues) {
     canReplaceWithDynamicFilter_ = true;
   }
 
@@ -515,6 +606,7 @@ void HashProbe::addInput(RowVectorPtr input) {
     return;
   }
   input_ = std::move(input);
+  outputBatchSize_ = adaptiveOutputBatchRows();
 
   if (input_->size() > 0) {
     noInput_ = false;
@@ -700,8 +792,8 @@ void HashProbe::fillOutput(vector_size_t size) {
   if (isLeftSemiProjectJoin(joinType_)) {
     fillLeftSemiProjectMatchColumn(size);
   } else {
-    extractColumns(
-        table_.get(),
+    makeLazyColumns(
+        table_,
         folly::Range<char**>(outputTableRows_.data(), size),
         tableOutputProjections_,
         pool(),
@@ -85,10 +85,13 @@ class HashProbe : public Operator {
   // 'restoredSpillPartitionId' is not null. If 'spillPartitionIds' is not
   // empty, then spilling has been triggered at the build side and the function
   // will set up a spiller and the associated data structures to spill probe
-  // inputs.
+  // inputs. If 'restoredPartitionHasMoreBlocks' is true, then the spilled
+  // probe partition is read without consuming it, to probe the tables of the
+  // next blocks of the restored partition with.
   void maybeSetupSpillInput(
       const std::optional<SpillPartitionId>& restoredSpillPartitionId,
-      const SpillPartitionIdSet& spillPartitionIds);
+      const SpillPartitionIdSet& spillPartitionIds,
+      bool restoredPartitionHasMoreBlocks);
 
   // Sets up 'filter_' and related members.p
   void initializeFilter(
@@ -238,8 +241,9 @@ class HashProbe : public Operator {
         spillInputPartitionIds_.empty();
   }
 
-  // TODO: Define batch size as bytes based on RowContainer row sizes.
-  const uint32_t outputBatchSize_;
+  // Maximum number of rows in an output batch. Is updated for each input
+  // batch from the measured size of the output rows.
+  uint32_t outputBatchSize_;
 
   const std::shared_ptr<const core::HashJoinNode> joinNode_;
 
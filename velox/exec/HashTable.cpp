@@ -50,9 +50,12 @@ HashTable<ignoreNullKeys>::HashTable(
     bool isJoinBuild,
     bool hasProbedFlag,
     uint32_t minTableSizeForParallelJoinBuild,
-    memory::MemoryPool* pool)
+    memory::MemoryPool* pool,
+    uint64_t minTableSizeForIncrementalRehash,
+    bool columnarDependents)
     : BaseHashTable(std::move(hashers)),
       minTableSizeForParallelJoinBuild_(minTableSizeForParallelJoinBuild),
+      minTableSizeForIncrementalRehash_(minTableSizeForIncrementalRehash),
       isJoinBuild_(isJoinBuild) {
   std::vector<TypePtr> keys;
   for (auto& hasher : hashers_) {
@@ -71,8 +74,50 @@ HashTable<ignoreNullKeys>::HashTable(
       isJoinBuild,
       hasProbedFlag,
       hashMode_ != HashMode::kHash,
-      pool);
+      pool,
+      nullptr, // stringAllocator
+      columnarDependents);
   nextOffset_ = rows_->nextOffset();
+  setupPackedKeys();
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::setupPackedKeys() {
+  constexpr int32_t kPackedKeyBytes = 2 * sizeof(uint64_t);
+  if (rows_->fixedRowSize() < kPackedKeyBytes) {
+    return;
+  }
+  int32_t offset = 0;
+  for (auto i = 0; i < hashers_.size(); ++i) {
+    switch (hashers_[i]->typeKind()) {
+      case TypeKind::TINYINT:
+      case TypeKind::SMALLINT:
+      case TypeKind::INTEGER:
+      case TypeKind::BIGINT:
+        break;
+      default:
+        return;
+    }
+    const auto column = rows_->columnAt(i);
+    if (column.offset() != offset) {
+      return;
+    }
+    if constexpr (!ignoreNullKeys) {
+      if (i > 0 && column.nullByte() != keyNullByte_) {
+        return;
+      }
+      keyNullByte_ = column.nullByte();
+      keyNullMask_ |= column.nullMask();
+    }
+    offset += typeKindSize(hashers_[i]->typeKind());
+  }
+  if (offset > kPackedKeyBytes) {
+    return;
+  }
+  const auto numBits = offset * 8;
+  packedKeyMask_[0] = numBits >= 64 ? ~0UL : bits::lowMask(numBits);
+  packedKeyMask_[1] = numBits <= 64 ? 0 : bits::lowMask(numBits - 64);
+  hasPackedKeys_ = true;
 }
 
 class ProbeState {
@@ -321,6 +366,51 @@ char* HashTable<ignoreNullKeys>::insertEntry(
   return group;
 }
 
+template <bool ignoreNullKeys>
+char* HashTable<ignoreNullKeys>::insertGroup(
+    HashLookup& lookup,
+    int32_t index,
+    vector_size_t row) {
+  if (oldTable_ != nullptr) {
+    if (auto* group = removeFromOldTable(lookup, row)) {
+      storeRowPointer(index, lookup.hashes[row], group);
+      return group;
+    }
+  }
+  return insertEntry(lookup, index, row);
+}
+
+template <bool ignoreNullKeys>
+char* HashTable<ignoreNullKeys>::removeFromOldTable(
+    HashLookup& lookup,
+    vector_size_t row) {
+  const auto hash = lookup.hashes[row];
+  const auto wantedTags = TagVector::broadcast(hashTag(hash));
+  const auto emptyTags = TagVector::broadcast(ProbeState::kEmptyTag);
+  auto* oldTable = reinterpret_cast<uint8_t*>(oldTable_);
+  auto offset = bucketOffset(hash) & oldSizeMask_;
+  for (;;) {
+    const auto tags = BaseHashTable::loadTags(oldTable, offset);
+    auto hits = simd::toBitMask(tags == wantedTags) & ProbeState::kFullMask;
+    auto* bucket = reinterpret_cast<Bucket*>(oldTable + offset);
+    while (hits) {
+      const auto slot = bits::getAndClearLastSetBit(hits);
+      char* group = bucket->pointerAt(slot);
+      const bool isMatch = hashMode_ == HashMode::kNormalizedKey
+          ? RowContainer::normalizedKey(group) == lookup.normalizedKeys[row]
+          : compareKeys(group, lookup, row);
+      if (isMatch) {
+        bucket->setTag(slot, ProbeState::kTombstoneTag);
+        return group;
+      }
+    }
+    if (simd::toBitMask(tags == emptyTags) & ProbeState::kFullMask) {
+      return nullptr;
+    }
+    offset = (offset + kBucketSize) & oldSizeMask_;
+  }
+}
+
 template <bool ignoreNullKeys>
 bool HashTable<ignoreNullKeys>::compareKeys(
     const char* group,
@@ -355,7 +445,7 @@ bool HashTable<ignoreNullKeys>::compareKeys(
 }
 
 template <bool ignoreNullKeys>
-template <bool isJoin, bool isNormalizedKey>
+template <bool isJoin, bool isNormalizedKey, bool isPackedKey>
 FOLLY_ALWAYS_INLINE void HashTable<ignoreNullKeys>::fullProbe(
     HashLookup& lookup,
     ProbeState& state,
@@ -372,7 +462,22 @@ FOLLY_ALWAYS_INLINE void HashTable<ignoreNullKeys>::fullProbe(
               lookup.normalizedKeys[row];
         },
         [&](int32_t index, int32_t row) {
-          return isJoin ? nullptr : insertEntry(lookup, row, index);
+          return isJoin ? nullptr : insertGroup(lookup, row, index);
+        },
+        numTombstones_,
+        !isJoin && extraCheck);
+    return;
+  }
+  if constexpr (isPackedKey) {
+    // NOLINT
+    lookup.hits[state.row()] = state.fullProbe<op>(
+        *this,
+        0,
+        [&](char* group, int32_t row) INLINE_LAMBDA {
+          return packedKeysEqual(group, lookup.packedKeys.data() + 2 * row);
+        },
+        [&](int32_t index, int32_t row) {
+          return isJoin ? nullptr : insertGroup(lookup, row, index);
         },
         numTombstones_,
         !isJoin && extraCheck);
@@ -384,7 +489,7 @@ FOLLY_ALWAYS_INLINE void HashTable<ignoreNullKeys>::fullProbe(
       0,
       [&](char* group, int32_t row) { return compareKeys(group, lookup, row); },
       [&](int32_t index, int32_t row) {
-        return isJoin ? nullptr : insertEntry(lookup, row, index);
+        return isJoin ? nullptr : insertGroup(lookup, row, index);
       },
       numTombstones_,
       !isJoin && extraCheck);
@@ -419,8 +524,64 @@ void populateNormalizedKeys(HashLookup& lookup, int8_t sizeBits) {
     hashes[row] = mixNormalizedKey(hash, sizeBits);
   }
 }
+
+template <typename T>
+void packKeys(
+    const DecodedVector& decoded,
+    const raw_vector<vector_size_t>& rows,
+    int32_t offset,
+    char* keys) {
+  for (auto row : rows) {
+    const T value = decoded.valueAt<T>(row);
+    memcpy(keys + row * 2 * sizeof(uint64_t) + offset, &value, sizeof(T));
+  }
+}
 } // namespace
 
+template <bool ignoreNullKeys>
+bool HashTable<ignoreNullKeys>::populatePackedKeys(HashLookup& lookup) {
+  const auto numKeys = lookup.hashers.size();
+  for (auto i = 0; i < numKeys; ++i) {
+    const auto& decoded = lookup.hashers[i]->decodedVector();
+    if (!decoded.mayHaveNulls()) {
+      continue;
+    }
+    for (auto row : lookup.rows) {
+      if (decoded.isNullAt(row)) {
+        return false;
+      }
+    }
+  }
+  lookup.packedKeys.resize(2 * (lookup.rows.back() + 1));
+  uint64_t* keys = lookup.packedKeys.data();
+  for (auto row : lookup.rows) {
+    keys[2 * row] = 0;
+    keys[2 * row + 1] = 0;
+  }
+  auto* keyBytes = reinterpret_cast<char*>(keys);
+  for (auto i = 0; i < numKeys; ++i) {
+    const auto& decoded = lookup.hashers[i]->decodedVector();
+    const auto offset = rows_->columnAt(i).offset();
+    switch (hashers_[i]->typeKind()) {
+      case TypeKind::TINYINT:
+        packKeys<int8_t>(decoded, lookup.rows, offset, keyBytes);
+        break;
+      case TypeKind::SMALLINT:
+        packKeys<int16_t>(decoded, lookup.rows, offset, keyBytes);
+        break;
+      case TypeKind::INTEGER:
+        packKeys<int32_t>(decoded, lookup.rows, offset, keyBytes);
+        break;
+      case TypeKind::BIGINT:
+        packKeys<int64_t>(decoded, lookup.rows, offset, keyBytes);
+        break;
+      default:
+        VELOX_UNREACHABLE();
+    }
+  }
+  return true;
+}
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::groupProbe(HashLookup& lookup) {
   incrementProbes(lookup.rows.size());
@@ -432,11 +593,20 @@ void HashTable<ignoreNullKeys>::groupProbe(HashLookup& lookup) {
   // Do size-based rehash before mixing hashes from normalized keys
   // because the size of the table affects the mixing.
   checkSize(lookup.rows.size());
+  if (oldTable_ != nullptr) {
+    // Moves 2 slots per probed row, so that all entries are moved well before
+    // the new table fills up.
+    continueIncrementalRehash(2 * lookup.rows.size());
+  }
   if (hashMode_ == HashMode::kNormalizedKey) {
     populateNormalizedKeys(lookup, sizeBits_);
     groupNormalizedKeyProbe(lookup);
     return;
   }
+  if (hasPackedKeys_ && populatePackedKeys(lookup)) {
+    groupPackedKeyProbe(lookup);
+    return;
+  }
   ProbeState state1;
   ProbeState state2;
   ProbeState state3;
@@ -509,6 +679,41 @@ void HashTable<ignoreNullKeys>::groupNormalizedKeyProbe(HashLookup& lookup) {
   }
 }
 
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::groupPackedKeyProbe(HashLookup& lookup) {
+  ProbeState state1;
+  ProbeState state2;
+  ProbeState state3;
+  ProbeState state4;
+  int32_t probeIndex = 0;
+  int32_t numProbes = lookup.rows.size();
+  auto rows = lookup.rows.data();
+  for (; probeIndex + 4 <= numProbes; probeIndex += 4) {
+    int32_t row = rows[probeIndex];
+    state1.preProbe(*this, lookup.hashes[row], row);
+    row = rows[probeIndex + 1];
+    state2.preProbe(*this, lookup.hashes[row], row);
+    row = rows[probeIndex + 2];
+    state3.preProbe(*this, lookup.hashes[row], row);
+    row = rows[probeIndex + 3];
+    state4.preProbe(*this, lookup.hashes[row], row);
+    state1.firstProbe<ProbeState::Operation::kInsert>(*this, 0);
+    state2.firstProbe<ProbeState::Operation::kInsert>(*this, 0);
+    state3.firstProbe<ProbeState::Operation::kInsert>(*this, 0);
+    state4.firstProbe<ProbeState::Operation::kInsert>(*this, 0);
+    fullProbe<false, false, true>(lookup, state1, false);
+    fullProbe<false, false, true>(lookup, state2, true);
+    fullProbe<false, false, true>(lookup, state3, true);
+    fullProbe<false, false, true>(lookup, state4, true);
+  }
+  for (; probeIndex < numProbes; ++probeIndex) {
+    int32_t row = rows[probeIndex];
+    state1.preProbe(*this, lookup.hashes[row], row);
+    state1.firstProbe(*this, 0);
+    fullProbe<false, false, true>(lookup, state1, false);
+  }
+}
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::arrayGroupProbe(HashLookup& lookup) {
   VELOX_DCHECK(!lookup.hashes.empty());
@@ -572,39 +777,57 @@ void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
     joinNormalizedKeyProbe(lookup);
     return;
   }
-  int32_t probeIndex = 0;
-  int32_t numProbes = lookup.rows.size();
-  const vector_size_t* rows = lookup.rows.data();
-  ProbeState state1;
-  ProbeState state2;
-  ProbeState state3;
-  ProbeState state4;
-  for (; probeIndex + 4 <= numProbes; probeIndex += 4) {
-    int32_t row = rows[probeIndex];
-    state1.preProbe(*this, lookup.hashes[row], row);
-    row = rows[probeIndex + 1];
-    state2.preProbe(*this, lookup.hashes[row], row);
-    row = rows[probeIndex + 2];
-    state3.preProbe(*this, lookup.hashes[row], row);
-    row = rows[probeIndex + 3];
-    state4.preProbe(*this, lookup.hashes[row], row);
-    state1.firstProbe(*this, 0);
-    state2.firstProbe(*this, 0);
-    state3.firstProbe(*this, 0);
-    state4.firstProbe(*this, 0);
-    fullProbe<true>(lookup, state1, false);
-    fullProbe<true>(lookup, state2, false);
-    fullProbe<true>(lookup, state3, false);
-    fullProbe<true>(lookup, state4, false);
+  if (hasPackedKeys_ && populatePackedKeys(lookup)) {
+    joinPackedKeyProbe(lookup);
+    return;
   }
-  for (; probeIndex < numProbes; ++probeIndex) {
-    int32_t row = rows[probeIndex];
-    state1.preProbe(*this, lookup.hashes[row], row);
-    state1.firstProbe(*this, 0);
-    fullProbe<true>(lookup, state1, false);
+  joinProbeInGroups(lookup, 0, [&](ProbeState& state) INLINE_LAMBDA {
+    fullProbe<true>(lookup, state, false);
+  });
+}
+
+template <bool ignoreNullKeys>
+template <typename FullProbe>
+void HashTable<ignoreNullKeys>::joinProbeInGroups(
+    HashLookup& lookup,
+    int32_t firstKey,
+    FullProbe fullProbe) {
+  const int32_t numProbes = lookup.rows.size();
+  const vector_size_t* rows = lookup.rows.data();
+  const uint64_t* hashes = lookup.hashes.data();
+  const auto groupSize = probeGroupSize_;
+  auto prefetchBuckets = [&](int32_t begin, int32_t end) INLINE_LAMBDA {
+    for (auto i = begin; i < end; ++i) {
+      __builtin_prefetch(
+          reinterpret_cast<char*>(table_) + bucketOffset(hashes[rows[i]]));
+    }
+  };
+  ProbeState states[kMaxProbeGroupSize];
+  prefetchBuckets(0, std::min(groupSize, numProbes));
+  for (int32_t begin = 0; begin < numProbes; begin += groupSize) {
+    const auto end = std::min(begin + groupSize, numProbes);
+    const auto size = end - begin;
+    prefetchBuckets(end, std::min(end + groupSize, numProbes));
+    for (auto i = 0; i < size; ++i) {
+      const auto row = rows[begin + i];
+      states[i].preProbe(*this, hashes[row], row);
+    }
+    for (auto i = 0; i < size; ++i) {
+      states[i].firstProbe(*this, firstKey);
+    }
+    for (auto i = 0; i < size; ++i) {
+      fullProbe(states[i]);
+    }
   }
 }
 
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::joinPackedKeyProbe(HashLookup& lookup) {
+  joinProbeInGroups(lookup, 0, [&](ProbeState& state) INLINE_LAMBDA {
+    fullProbe<true, false, true>(lookup, state, false);
+  });
+}
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::arrayJoinProbe(HashLookup& lookup) {
   // Rows are nearly always consecutive.
@@ -649,42 +872,14 @@ void HashTable<ignoreNullKeys>::arrayJoinProbe(HashLookup& lookup) {
 
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::joinNormalizedKeyProbe(HashLookup& lookup) {
-  int32_t probeIndex = 0;
-  int32_t numProbes = lookup.rows.size();
-  const vector_size_t* rows = lookup.rows.data();
-  ProbeState state1;
-  ProbeState state2;
-  ProbeState state3;
-  ProbeState state4;
   const uint64_t* keys = lookup.normalizedKeys.data();
-  const uint64_t* hashes = lookup.hashes.data();
   char** hits = lookup.hits.data();
-  constexpr int32_t kKeyOffset =
-      -static_cast<int32_t>(sizeof(normalized_key_t));
-  for (; probeIndex + 4 <= numProbes; probeIndex += 4) {
-    int32_t row = rows[probeIndex];
-    state1.preProbe(*this, hashes[row], row);
-    row = rows[probeIndex + 1];
-    state2.preProbe(*this, hashes[row], row);
-    row = rows[probeIndex + 2];
-    state3.preProbe(*this, hashes[row], row);
-    row = rows[probeIndex + 3];
-    state4.preProbe(*this, hashes[row], row);
-    state1.firstProbe(*this, kKeyOffset);
-    state2.firstProbe(*this, kKeyOffset);
-    state3.firstProbe(*this, kKeyOffset);
-    state4.firstProbe(*this, kKeyOffset);
-    hits[state1.row()] = state1.joinNormalizedKeyFullProbe(*this, keys);
-    hits[state2.row()] = state2.joinNormalizedKeyFullProbe(*this, keys);
-    hits[state3.row()] = state3.joinNormalizedKeyFullProbe(*this, keys);
-    hits[state4.row()] = state4.joinNormalizedKeyFullProbe(*this, keys);
-  }
-  for (; probeIndex < numProbes; ++probeIndex) {
-    int32_t row = rows[probeIndex];
-    state1.preProbe(*this, lookup.hashes[row], row);
-    state1.firstProbe(*this, 0);
-    hits[row] = state1.joinNormalizedKeyFullProbe(*this, keys);
-  }
+  joinProbeInGroups(
+      lookup,
+      -static_cast<int32_t>(sizeof(normalized_key_t)),
+      [&](ProbeState& state) INLINE_LAMBDA {
+        hits[state.row()] = state.joinNormalizedKeyFullProbe(*this, keys);
+      });
 }
 
 template <bool ignoreNullKeys>
@@ -708,6 +903,7 @@ void HashTable<ignoreNullKeys>::allocateTables(uint64_t size) {
 
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::clear() {
+  freeOldTable();
   rows_->clear();
   if (table_) {
     // All modes have 8 bytes per slot.
@@ -746,6 +942,10 @@ void HashTable<ignoreNullKeys>::checkSize(int32_t numNew) {
     // NOTE: we need to plus one here as number itself could be power of two.
     const auto newCapacity = bits::nextPowerOfTwo(
         std::max(newNumDistincts, capacity_ - numTombstones_) + 1);
+    if (rehashesIncrementally()) {
+      startIncrementalRehash(newCapacity);
+      return;
+    }
     allocateTables(newCapacity);
     rehash();
   }
@@ -1125,6 +1325,30 @@ FOLLY_ALWAYS_INLINE void HashTable<ignoreNullKeys>::buildFullProbe(
         numTombstones_,
         extraCheck,
         partitionEnd);
+  } else if (hasPackedKeys_) {
+    // The keys of 'inserted' are compared as two masked words. Rows with a
+    // null key go through the regular per-key compare.
+    uint64_t key[2];
+    memcpy(key, inserted, sizeof(key));
+    const bool hasNullKey =
+        !ignoreNullKeys && (inserted[keyNullByte_] & keyNullMask_);
+    state.fullProbe<ProbeState::Operation::kInsert>(
+        *this,
+        0,
+        [&](char* group, int32_t /*row*/) {
+          if (UNLIKELY(hasNullKey) ? compareKeys(group, inserted)
+                                   : packedKeysEqual(group, key)) {
+            if (nextOffset_) {
+              pushNext(group, inserted);
+            }
+            return true;
+          }
+          return false;
+        },
+        insertFn,
+        numTombstones_,
+        extraCheck,
+        partitionEnd);
   } else {
     state.fullProbe<ProbeState::Operation::kInsert>(
         *this,
@@ -1182,6 +1406,9 @@ void HashTable<ignoreNullKeys>::insertForJoin(
 
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::rehash() {
+  // All entries are inserted from the RowContainers, also the ones not yet
+  // moved from 'oldTable_'.
+  freeOldTable();
   ++numRehashes_;
   constexpr int32_t kHashBatchSize = 1024;
   if (canApplyParallelJoinBuild()) {
@@ -1210,9 +1437,72 @@ void HashTable<ignoreNullKeys>::rehash() {
   }
 }
 
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::startIncrementalRehash(uint64_t newCapacity) {
+  VELOX_CHECK_NULL(oldTable_);
+  ++numRehashes_;
+  oldTableAllocation_ = std::move(tableAllocation_);
+  oldTable_ = table_;
+  oldSizeMask_ = sizeMask_;
+  rehashOffset_ = 0;
+  allocateTables(newCapacity);
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::continueIncrementalRehash(int64_t numSlots) {
+  constexpr int32_t kHashBatchSize = 1024;
+  constexpr int32_t kSlotsPerBucket = sizeof(TagVector);
+  const int64_t oldTableBytes = oldSizeMask_ + 1;
+  const int64_t numBuckets = std::min<int64_t>(
+      numSlots / kSlotsPerBucket + 1,
+      (oldTableBytes - rehashOffset_) / kBucketSize);
+  const int64_t endOffset = rehashOffset_ + numBuckets * kBucketSize;
+  auto* oldTable = reinterpret_cast<uint8_t*>(oldTable_);
+  raw_vector<uint64_t> hashes;
+  hashes.resize(kHashBatchSize);
+  char* groups[kHashBatchSize];
+  while (rehashOffset_ < endOffset) {
+    int32_t numGroups = 0;
+    for (; rehashOffset_ < endOffset &&
+         numGroups + kSlotsPerBucket <= kHashBatchSize;
+         rehashOffset_ += kBucketSize) {
+      // Tombstones and empty slots do not have the high bit of the tag set.
+      auto occupied = simd::toBitMask(TagVector::batch_bool_type(
+                          BaseHashTable::loadTags(oldTable, rehashOffset_))) &
+          ProbeState::kFullMask;
+      auto* bucket = reinterpret_cast<Bucket*>(oldTable + rehashOffset_);
+      while (occupied) {
+        const auto slot = bits::getAndClearLastSetBit(occupied);
+        groups[numGroups++] = bucket->pointerAt(slot);
+        bucket->setTag(slot, ProbeState::kTombstoneTag);
+      }
+    }
+    // The hashes do not depend on the table size. Normalized keys are read
+    // from the rows.
+    VELOX_CHECK(hashRows(folly::Range(groups, numGroups), false, hashes));
+    insertForGroupBy(groups, hashes.data(), numGroups);
+  }
+  if (rehashOffset_ >= oldTableBytes) {
+    freeOldTable();
+  }
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::freeOldTable() {
+  if (oldTable_ == nullptr) {
+    return;
+  }
+  oldTableAllocation_.pool()->freeContiguous(oldTableAllocation_);
+  oldTable_ = nullptr;
+  oldSizeMask_ = 0;
+  rehashOffset_ = 0;
+}
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::setHashMode(HashMode mode, int32_t numNew) {
   VELOX_CHECK_NE(hashMode_, HashMode::kHash);
+  // The new table is made from the RowContainer.
+  freeOldTable();
   if (mode == HashMode::kArray) {
     const auto bytes = capacity_ * tableSlotSize();
     const auto numPages = memory::AllocationTraits::numPages(bytes);
@@ -1458,6 +1748,9 @@ std::string HashTable<ignoreNullKeys>::toString() {
   if (table_ == nullptr) {
     out << "(no table) ";
   }
+  if (oldTable_ != nullptr) {
+    out << "(rehash in progress) ";
+  }
   for (auto& hasher : hashers_) {
     out << hasher->toString();
   }
@@ -1516,6 +1809,7 @@ template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::prepareJoinTable(
     std::vector<std::unique_ptr<BaseHashTable>> tables,
     folly::Executor* executor) {
+  finishIncrementalRehash();
   buildExecutor_ = executor;
   otherTables_.reserve(tables.size());
   for (auto& table : tables) {
@@ -1795,6 +2089,7 @@ template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::eraseWithHashes(
     folly::Range<char**> rows,
     uint64_t* hashes) {
+  finishIncrementalRehash();
   auto numRows = rows.size();
   if (hashMode_ == HashMode::kArray) {
     for (auto i = 0; i < numRows; ++i) {
@@ -1839,12 +2134,47 @@ void HashTable<ignoreNullKeys>::eraseWithHashes(
   }
 }
 
+template <bool ignoreNullKeys>
+bool HashTable<ignoreNullKeys>::compactRows() {
+  VELOX_CHECK(!isJoinBuild_, "Rows of a hash join build cannot be moved");
+  if (!rows_->canCompact()) {
+    return false;
+  }
+  // The table is rebuilt from the moved rows. This also drops the
+  // tombstones.
+  freeOldTable();
+  rows_->compact();
+  if (table_ == nullptr) {
+    return true;
+  }
+  if (hashMode_ == HashMode::kArray) {
+    memset(table_, 0, capacity_ * sizeof(char*));
+    numTombstones_ = 0;
+  } else {
+    allocateTables(newHashTableEntries(numDistinct_, 0));
+  }
+  if (numDistinct_ > 0) {
+    rehash();
+  }
+  return true;
+}
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::checkConsistency() const {
   VELOX_CHECK_GE(capacity_, numDistinct_);
   if (hashMode_ == BaseHashTable::HashMode::kArray) {
     return;
   }
+  // Entries not yet moved from 'oldTable_' are not in 'table_'.
+  uint64_t numOldEntries = 0;
+  for (auto start = 0; oldTable_ != nullptr && start < oldSizeMask_;
+       start += kBucketSize) {
+    const auto tags = BaseHashTable::loadTags(
+        reinterpret_cast<uint8_t*>(oldTable_), start);
+    numOldEntries += __builtin_popcount(
+        simd::toBitMask(TagVector::batch_bool_type(tags)) &
+        ProbeState::kFullMask);
+  }
   uint64_t numEmpty = 0;
   uint64_t numTombstone = 0;
   for (auto start = 0; start < sizeMask_; start += kBucketSize) {
@@ -1861,13 +2191,15 @@ void HashTable<ignoreNullKeys>::checkConsistency() const {
     }
   }
   VELOX_CHECK_EQ(
-      numEmpty + numTombstone + numDistinct_,
+      numEmpty + numTombstone + numDistinct_ - numOldEntries,
       capacity_,
-      "capacity: {}, numEmpty: {}, numTombstone: {}, numDistinct: {}",
+      "capacity: {}, numEmpty: {}, numTombstone: {}, numDistinct: {}, "
+      "numOldEntries: {}",
       capacity_,
       numEmpty,
       numTombstone,
-      numDistinct_);
+      numDistinct_,
+      numOldEntries);
 }
 
 template class HashTable<true>;
@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <folly/lang/Bits.h>
+
 #include "velox/common/base/Portability.h"
 #include "velox/common/memory/MemoryAllocator.h"
 #include "velox/exec/Operator.h"
@@ -44,6 +46,9 @@ struct HashLookup {
   raw_vector<uint64_t> hashes;
   // If using valueIds, list of concatenated valueIds. 1:1 with 'hashes'.
   raw_vector<uint64_t> normalizedKeys;
+  // If the table has packed keys, the fixed width keys of each row laid out
+  // as in the RowContainer, 2 words per row. 1:1 with 'hashes'.
+  raw_vector<uint64_t> packedKeys;
   // Hit for each row of input. nullptr if no hit. Points to the
   // corresponding group row.
   raw_vector<char*> hits;
@@ -247,6 +252,14 @@ class BaseHashTable {
   // and be unique.
   virtual void erase(folly::Range<char**> rows) = 0;
 
+  /// Moves the rows of a group by table into new allocations without the
+  /// erased rows, frees the previous allocations and rebuilds the table with
+  /// the moved rows. Shrinks the table to fit the remaining rows unless in
+  /// array mode. Invalidates all pointers to the rows. Returns false without
+  /// changing anything if the rows cannot be moved. See
+  /// RowContainer::compact().
+  virtual bool compactRows() = 0;
+
   /// Returns a brief description for use in debugging.
   virtual std::string toString() = 0;
 
@@ -323,6 +336,12 @@ class HashTable : public BaseHashTable {
   // not occur. In this case the row does not need a link to the next
   // match. 'hasProbedFlag' adds an extra bit in every row for tracking rows
   // that matches join condition for right and full outer joins.
+  // 'minTableSizeForIncrementalRehash' is the min capacity of a group by
+  // table in kHash or kNormalizedKey mode from which growing the table moves
+  // the entries to the new table a slice at a time during the following
+  // group probes instead of all at once. 0 means never.
+  // 'columnarDependents' stores the fixed width dependent columns of a build
+  // side column-wise. See RowContainer.
   HashTable(
       std::vector<std::unique_ptr<VectorHasher>>&& hashers,
       const std::vector<Accumulator>& accumulators,
@@ -331,12 +350,15 @@ class HashTable : public BaseHashTable {
       bool isJoinBuild,
       bool hasProbedFlag,
       uint32_t minTableSizeForParallelJoinBuild,
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      uint64_t minTableSizeForIncrementalRehash = 0,
+      bool columnarDependents = false);
 
   static std::unique_ptr<HashTable> createForAggregation(
       std::vector<std::unique_ptr<VectorHasher>>&& hashers,
       const std::vector<Accumulator>& accumulators,
-      memory::MemoryPool* pool) {
+      memory::MemoryPool* pool,
+      uint64_t minTableSizeForIncrementalRehash = 0) {
     return std::make_unique<HashTable>(
         std::move(hashers),
         accumulators,
@@ -345,7 +367,8 @@ class HashTable : public BaseHashTable {
         false, // isJoinBuild
         false, // hasProbedFlag
         0, // minTableSizeForParallelJoinBuild
-        pool);
+        pool,
+        minTableSizeForIncrementalRehash);
   }
 
   static std::unique_ptr<HashTable> createForJoin(
@@ -354,7 +377,8 @@ class HashTable : public BaseHashTable {
       bool allowDuplicates,
       bool hasProbedFlag,
       uint32_t minTableSizeForParallelJoinBuild,
-      memory::MemoryPool* pool) {
+      memory::MemoryPool* pool,
+      bool columnarDependents = false) {
     return std::make_unique<HashTable>(
         std::move(hashers),
         std::vector<Accumulator>{},
@@ -363,7 +387,9 @@ class HashTable : public BaseHashTable {
         true, // isJoinBuild
         hasProbedFlag,
         minTableSizeForParallelJoinBuild,
-        pool);
+        pool,
+        0, // minTableSizeForIncrementalRehash
+        columnarDependents);
   }
 
   void groupProbe(HashLookup& lookup) override;
@@ -404,7 +430,8 @@ class HashTable : public BaseHashTable {
   int64_t allocatedBytes() const override {
     // For each row: sizeof(char*) per table entry + memory
     // allocated with MemoryAllocator for fixed-width rows and strings.
-    return sizeof(char*) * capacity_ + rows_->allocatedBytes();
+    return sizeof(char*) * capacity_ + oldTableAllocation_.size() +
+        rows_->allocatedBytes();
   }
 
   HashStringAllocator* stringAllocator() override {
@@ -437,6 +464,8 @@ class HashTable : public BaseHashTable {
 
   void erase(folly::Range<char**> rows) override;
 
+  bool compactRows() override;
+
   // Moves the contents of 'tables' into 'this' and prepares 'this'
   // for use in hash join probe. A hash join build side is prepared as
   // follows: 1. Each build side thread gets a random selection of the
@@ -455,8 +484,9 @@ class HashTable : public BaseHashTable {
     if (numDistinct_ + numNewDistinct > rehashSize()) {
       // If rehashed, the table adds size_ entries (i.e. doubles),
       // adding one pointer worth for each new position.  (16 tags, 16 6 byte
-      // pointers, 16 bytes padding).
-      return capacity_ * tableSlotSize();
+      // pointers, 16 bytes padding). An incremental rehash keeps the old
+      // table until its entries are moved, so the whole new table is added.
+      return (rehashesIncrementally() ? 2 : 1) * capacity_ * tableSlotSize();
     }
     return 0;
   }
@@ -495,6 +525,30 @@ class HashTable : public BaseHashTable {
     return otherTables_;
   }
 
+  /// Returns true if entries of the table before the last growth are still
+  /// to be moved to the current table.
+  bool testingRehashInProgress() const {
+    return oldTable_ != nullptr;
+  }
+
+  /// Default and maximum number of rows probed together by joinProbe() in
+  /// kHash and kNormalizedKey modes.
+  static constexpr int32_t kDefaultProbeGroupSize = 16;
+  static constexpr int32_t kMaxProbeGroupSize = 64;
+
+  /// Sets the number of rows probed together by joinProbe(). Each step of the
+  /// probe is done for all rows of a group before the next, so that the cache
+  /// misses of the rows of a group overlap.
+  void setProbeGroupSize(int32_t size) {
+    VELOX_CHECK_GT(size, 0);
+    VELOX_CHECK_LE(size, kMaxProbeGroupSize);
+    probeGroupSize_ = size;
+  }
+
+  int32_t probeGroupSize() const {
+    return probeGroupSize_;
+  }
+
  private:
   // Enables debug stats for collisions for debug build.
 #ifdef NDEBUG
@@ -611,6 +665,43 @@ class HashTable : public BaseHashTable {
   void clearUseRange(std::vector<bool>& useRange);
 
   void rehash();
+
+  // True if the next growth of the table is to move the entries to the new
+  // table incrementally. See 'minTableSizeForIncrementalRehash_'.
+  bool rehashesIncrementally() const {
+    return minTableSizeForIncrementalRehash_ > 0 &&
+        capacity_ >= minTableSizeForIncrementalRehash_ && !isJoinBuild_ &&
+        hashMode_ != HashMode::kArray && otherTables_.empty() &&
+        oldTable_ == nullptr;
+  }
+
+  // Allocates a table of 'newCapacity' entries and keeps the current table
+  // as 'oldTable_'. The entries of 'oldTable_' are moved to the new table by
+  // continueIncrementalRehash() and by probes that miss the new table.
+  void startIncrementalRehash(uint64_t newCapacity);
+
+  // Moves the entries of the next 'numSlots' slots of 'oldTable_' to
+  // 'table_'. Frees 'oldTable_' after moving its last slot.
+  void continueIncrementalRehash(int64_t numSlots);
+
+  // Moves all the remaining entries of 'oldTable_', if any, to 'table_'.
+  void finishIncrementalRehash() {
+    if (oldTable_ != nullptr) {
+      continueIncrementalRehash(std::numeric_limits<int64_t>::max());
+    }
+  }
+
+  void freeOldTable();
+
+  // Finds the key of 'row' in 'lookup' in 'oldTable_'. If found, marks its
+  // slot as a tombstone and returns the row of the key, otherwise nullptr.
+  char* removeFromOldTable(HashLookup& lookup, vector_size_t row);
+
+  // Inserts the key of 'row' in 'lookup' at slot 'index' of 'table_'. Moves
+  // the row of the key from 'oldTable_' if found there, otherwise inserts a
+  // new row.
+  char* insertGroup(HashLookup& lookup, int32_t index, vector_size_t row);
+
   void storeKeys(HashLookup& lookup, vector_size_t row);
 
   void storeRowPointer(int32_t index, uint64_t hash, char* row);
@@ -701,18 +792,62 @@ class HashTable : public BaseHashTable {
 
   bool compareKeys(const char* group, const char* inserted);
 
-  template <bool isJoin, bool isNormalizedKey = false>
+  template <
+      bool isJoin,
+      bool isNormalizedKey = false,
+      bool isPackedKey = false>
   void fullProbe(HashLookup& lookup, ProbeState& state, bool extraCheck);
 
   // Shortcut path for group by with normalized keys.
   void groupNormalizedKeyProbe(HashLookup& lookup);
 
+  // Shortcut path for group by in kHash mode with packed keys.
+  void groupPackedKeyProbe(HashLookup& lookup);
+
   // Array probe with SIMD.
   void arrayJoinProbe(HashLookup& lookup);
 
+  // Probes 'lookup.rows' in groups of 'probeGroupSize_' rows. The buckets of
+  // the next group are prefetched while a group is probed. For all rows of a
+  // group, first the tags are loaded, then compared to the tag of the row,
+  // which prefetches the first candidate row, and last 'fullProbe' compares
+  // the keys. 'firstKey' is the offset of the key bytes from the row pointer.
+  template <typename FullProbe>
+  void
+  joinProbeInGroups(HashLookup& lookup, int32_t firstKey, FullProbe fullProbe);
+
   // Shortcut for probe with normalized keys.
   void joinNormalizedKeyProbe(HashLookup& lookup);
 
+  // Shortcut for probe in kHash mode with packed keys.
+  void joinPackedKeyProbe(HashLookup& lookup);
+
+  // Sets 'hasPackedKeys_' if all keys are fixed width integers that fit
+  // in the first 16 bytes of a row. Such keys are compared with two masked
+  // word compares instead of a compare per key.
+  void setupPackedKeys();
+
+  // Copies the keys of 'lookup.rows' into 'lookup.packedKeys'. Returns
+  // false if any of the rows has a null key. These go through the regular
+  // per-key compare.
+  bool populatePackedKeys(HashLookup& lookup);
+
+  // Returns true if the keys of 'group' are equal to 'key', which is two
+  // words laid out like the start of a row.
+  bool packedKeysEqual(const char* group, const uint64_t* key) const {
+    const auto diff =
+        ((folly::loadUnaligned<uint64_t>(group) ^ key[0]) &
+         packedKeyMask_[0]) |
+        ((folly::loadUnaligned<uint64_t>(group + sizeof(uint64_t)) ^
+          key[1]) &
+         packedKeyMask_[1]);
+    if constexpr (ignoreNullKeys) {
+      return diff == 0;
+    } else {
+      return diff == 0 && !(group[keyNullByte_] & keyNullMask_);
+    }
+  }
+
   // Adds a row to a hash join table in kArray hash mode. Returns true
   // if a new entry was made and false if the row was added to an
   // existing set of rows with the same key.
@@ -800,6 +935,10 @@ class HashTable : public BaseHashTable {
   // The min table size in row to trigger parallel join table build.
   const uint32_t minTableSizeForParallelJoinBuild_;
 
+  // The min capacity of a group by table from which the table grows with an
+  // incremental rehash. 0 means never.
+  const uint64_t minTableSizeForIncrementalRehash_;
+
   int8_t sizeBits_;
   bool isJoinBuild_ = false;
 
@@ -830,6 +969,18 @@ class HashTable : public BaseHashTable {
   // Counts the number of rehash() calls.
   int64_t numRehashes_{0};
   HashMode hashMode_ = HashMode::kArray;
+
+  // True if the keys can be compared as two masked words at the start of
+  // the row. Set at construction from the key layout of 'rows_'. Used in
+  // kHash mode only.
+  bool hasPackedKeys_{false};
+  // Masks of the key bytes in the first and second word of a row.
+  uint64_t packedKeyMask_[2]{0, 0};
+  // Byte and mask of the key null flags if keys are nullable. All key null
+  // flags are in the same byte if 'hasPackedKeys_' is set.
+  int32_t keyNullByte_{0};
+  uint8_t keyNullMask_{0};
+
   // Owns the memory of multiple build side hash join tables that are
   // combined into a single probe hash table.
   std::vector<std::unique_ptr<HashTable<ignoreNullKeys>>> otherTables_;
@@ -865,6 +1016,19 @@ class HashTable : public BaseHashTable {
 
   // If true, avoids using VectorHasher value ranges with kArray hash mode.
   bool disableRangeArrayHash_{false};
+
+  // Number of rows probed together by joinProbe().
+  int32_t probeGroupSize_{kDefaultProbeGroupSize};
+
+  // The table before the last growth while an incremental rehash is in
+  // progress, nullptr otherwise. The entries in 'oldTable_' are not in
+  // 'table_' and the entries moved to 'table_' are tombstones in 'oldTable_'.
+  // 'oldSizeMask_' is the 'sizeMask_' of 'oldTable_'.
+  memory::ContiguousAllocation oldTableAllocation_;
+  char** oldTable_{nullptr};
+  int64_t oldSizeMask_{0};
+  // Byte offset of the first bucket of 'oldTable_' not yet moved.
+  int64_t rehashOffset_{0};
 };
 
 } // namespace facebook::velox::exec
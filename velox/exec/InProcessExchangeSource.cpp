@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/InProcessExchangeSource.h"
+#include "velox/exec/PartitionedOutputBufferManager.h"
+
+namespace facebook::velox::exec {
+namespace {
+
+class InProcessExchangeSource : public ExchangeSource {
+ public:
+  InProcessExchangeSource(
+      const std::string& taskId,
+      int destination,
+      std::shared_ptr<ExchangeQueue> queue,
+      memory::MemoryPool* pool,
+      std::weak_ptr<PartitionedOutputBufferManager> bufferManager)
+      : ExchangeSource(taskId, destination, std::move(queue), pool),
+        bufferManager_(std::move(bufferManager)) {}
+
+  bool supportsFlowControl() const override {
+    return true;
+  }
+
+  bool shouldRequestLocked() override {
+    if (atEnd_) {
+      return false;
+    }
+    return !requestPending_.exchange(true);
+  }
+
+  ContinueFuture request(uint32_t maxBytes) override {
+    auto [promise, future] =
+        makeVeloxContinuePromiseContract("InProcessExchangeSource::request");
+    {
+      std::lock_guard<std::mutex> l(queue_->mutex());
+      promise_ = std::move(promise);
+    }
+
+    auto buffers = bufferManager_.lock();
+    if (buffers == nullptr) {
+      fail("PartitionedOutputBufferManager is gone");
+      return std::move(future);
+    }
+    VELOX_CHECK(requestPending_);
+    const auto requestedSequence = sequence_;
+    auto self = shared_from_this();
+    const bool found = buffers->getData(
+        taskId_,
+        destination_,
+        maxBytes,
+        requestedSequence,
+        // The callback may outlive 'this', so it holds 'self'.
+        [self, requestedSequence, this](
+            std::vector<std::unique_ptr<folly::IOBuf>> data, int64_t sequence) {
+          processData(std::move(data), sequence, requestedSequence);
+        });
+    if (!found) {
+      fail(fmt::format("Output buffers of task {} not found", taskId_));
+    }
+    return std::move(future);
+  }
+
+  void close() override {
+    fulfillRequestPromise();
+    if (auto buffers = bufferManager_.lock()) {
+      buffers->deleteResults(taskId_, destination_);
+    }
+  }
+
+  folly::F14FastMap<std::string, int64_t> stats() const override {
+    return {
+        {"inProcessExchangeSource.numPages", numPages_},
+        {"inProcessExchangeSource.totalBytes", totalBytes_}};
+  }
+
+ private:
+  void processData(
+      std::vector<std::unique_ptr<folly::IOBuf>> data,
+      int64_t sequence,
+      int64_t requestedSequence) {
+    if (requestedSequence > sequence) {
+      // Drops the pages that were received by an earlier request.
+      const int64_t numExtra = requestedSequence - sequence;
+      VELOX_CHECK_LT(numExtra, data.size());
+      data.erase(data.begin(), data.begin() + numExtra);
+      sequence = requestedSequence;
+    }
+    std::vector<std::unique_ptr<SerializedPage>> pages;
+    bool atEnd = false;
+    for (auto& iobuf : data) {
+      if (iobuf == nullptr) {
+        atEnd = true;
+        // There may be more than one end marker.
+        continue;
+      }
+      // The producer's buffers come from its memory pool, which may go away
+      // before the consumer is done with the page.
+      iobuf->unshare();
+      totalBytes_ += iobuf->computeChainDataLength();
+      pages.push_back(std::make_unique<SerializedPage>(std::move(iobuf)));
+    }
+    numPages_ += pages.size();
+
+    int64_t ackSequence;
+    ContinuePromise requestPromise;
+    {
+      std::vector<ContinuePromise> queuePromises;
+      {
+        std::lock_guard<std::mutex> l(queue_->mutex());
+        requestPending_ = false;
+        requestPromise = std::move(promise_);
+        for (auto& page : pages) {
+          queue_->enqueueLocked(std::move(page), queuePromises);
+        }
+        if (atEnd) {
+          queue_->enqueueLocked(nullptr, queuePromises);
+          atEnd_ = true;
+        }
+        ackSequence = sequence_ = sequence + pages.size();
+      }
+      for (auto& promise : queuePromises) {
+        promise.setValue();
+      }
+    }
+
+    // Outside of the queue mutex.
+    if (auto buffers = bufferManager_.lock()) {
+      if (atEnd_) {
+        buffers->deleteResults(taskId_, destination_);
+      } else {
+        buffers->acknowledge(taskId_, destination_, ackSequence);
+      }
+    }
+    if (requestPromise.valid() && !requestPromise.isFulfilled()) {
+      requestPromise.setValue();
+    }
+  }
+
+  void fail(const std::string& error) {
+    {
+      std::lock_guard<std::mutex> l(queue_->mutex());
+      requestPending_ = false;
+    }
+    queue_->setError(error);
+    fulfillRequestPromise();
+  }
+
+  void fulfillRequestPromise() {
+    ContinuePromise promise;
+    {
+      std::lock_guard<std::mutex> l(queue_->mutex());
+      promise = std::move(promise_);
+    }
+    if (promise.valid() && !promise.isFulfilled()) {
+      promise.setValue();
+    }
+  }
+
+  const std::weak_ptr<PartitionedOutputBufferManager> bufferManager_;
+  ContinuePromise promise_{ContinuePromise::makeEmpty()};
+  // Number and total bytes of the pages fetched from the producer.
+  int64_t numPages_{0};
+  int64_t totalBytes_{0};
+};
+
+} // namespace
+
+std::shared_ptr<ExchangeSource> createInProcessExchangeSource(
+    const std::string& taskId,
+    int destination,
+    std::shared_ptr<ExchangeQueue> queue,
+    memory::MemoryPool* pool) {
+  auto bufferManager = PartitionedOutputBufferManager::getInstance();
+  auto buffers = bufferManager.lock();
+  if (buffers == nullptr || buffers->getBufferIfExists(taskId) == nullptr) {
+    return nullptr;
+  }
+  return std::make_shared<InProcessExchangeSource>(
+      taskId, destination, std::move(queue), pool, std::move(bufferManager));
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,39 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/ExchangeSource.h"
+
+namespace facebook::velox::exec {
+
+/// ExchangeSource factory for producer tasks running in this process. Returns
+/// a source that fetches pages directly from the PartitionedOutputBufferManager
+/// if 'taskId' has output buffers there, or nullptr otherwise so that the next
+/// factory, e.g. an HTTP one, is tried. Pages are not sent over the network
+/// but are copied out of the producer's memory, so they stay valid after the
+/// producer task is gone. Register this before any remote factory:
+///
+///   ExchangeSource::registerFactory(createInProcessExchangeSource);
+///
+/// A producer task must have initialized its output buffers before a consumer
+/// adds it as a remote task for the in-process path to be taken.
+std::shared_ptr<ExchangeSource> createInProcessExchangeSource(
+    const std::string& taskId,
+    int destination,
+    std::shared_ptr<ExchangeQueue> queue,
+    memory::MemoryPool* pool);
+
+} // namespace facebook::velox::exec
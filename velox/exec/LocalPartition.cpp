@@ -199,6 +199,10 @@ bool LocalExchangeQueue::isFinished() {
   return queue_.withWLock([&](auto& queue) { return isFinishedLocked(queue); });
 }
 
+bool LocalExchangeQueue::isClosed() {
+  return queue_.withWLock([&](auto& /*queue*/) { return closed_; });
+}
+
 void LocalExchangeQueue::close() {
   std::vector<ContinuePromise> producerPromises;
   std::vector<ContinuePromise> consumerPromises;
@@ -285,8 +289,15 @@ LocalPartition::LocalPartition(
       partitionFunction_(
           numPartitions_ == 1
               ? nullptr
-              : planNode->partitionFunctionSpec().create(numPartitions_)) {
+              : planNode->partitionFunctionSpec().create(numPartitions_)),
+      copyPartitions_(
+          numPartitions_ > 1 &&
+          ctx->queryConfig().localExchangeCopyPartitions()) {
   VELOX_CHECK(numPartitions_ == 1 || partitionFunction_ != nullptr);
+  if (copyPartitions_) {
+    partitionVectors_.resize(numPartitions_);
+    partitionRanges_.resize(numPartitions_);
+  }
 
   for (auto& queue : queues_) {
     queue->addProducer();
@@ -331,6 +342,14 @@ wrapChildren(const RowVectorPtr& input, vector_size_t size, BufferPtr indices) {
 } // namespace
 
 void LocalPartition::addInput(RowVectorPtr input) {
+  if (std::all_of(queues_.begin(), queues_.end(), [](const auto& queue) {
+        return queue->isClosed();
+      })) {
+    // No consumer needs more data, e.g. after a limit downstream.
+    consumersFinished_ = true;
+    return;
+  }
+
   {
     auto lockedStats = stats_.wlock();
     lockedStats->addOutputVector(input->estimateFlatSize(), input->size());
@@ -344,25 +363,19 @@ void LocalPartition::addInput(RowVectorPtr input) {
   input_ = std::move(input);
 
   if (numPartitions_ == 1) {
-    ContinueFuture future;
-    auto blockingReason = queues_[0]->enqueue(input_, &future);
-    if (blockingReason != BlockingReason::kNotBlocked) {
-      blockingReasons_.push_back(blockingReason);
-      futures_.push_back(std::move(future));
-    }
+    enqueue(0, input_);
     return;
   }
 
   const auto singlePartition =
       partitionFunction_->partition(*input_, partitions_);
   if (singlePartition.has_value()) {
-    ContinueFuture future;
-    auto blockingReason =
-        queues_[singlePartition.value()]->enqueue(input_, &future);
-    if (blockingReason != BlockingReason::kNotBlocked) {
-      blockingReasons_.push_back(blockingReason);
-      futures_.push_back(std::move(future));
-    }
+    enqueue(singlePartition.value(), input_);
+    return;
+  }
+
+  if (copyPartitions_) {
+    copyToPartitions();
     return;
   }
 
@@ -384,14 +397,56 @@ void LocalPartition::addInput(RowVectorPtr input) {
       continue;
     }
     indexBuffers[i]->setSize(partitionSize * sizeof(vector_size_t));
-    auto partitionData =
-        wrapChildren(input_, partitionSize, std::move(indexBuffers[i]));
-
-    ContinueFuture future;
-    auto reason = queues_[i]->enqueue(partitionData, &future);
-    if (reason != BlockingReason::kNotBlocked) {
-      blockingReasons_.push_back(reason);
-      futures_.push_back(std::move(future));
+    enqueue(
+        i, wrapChildren(input_, partitionSize, std::move(indexBuffers[i])));
+  }
+}
+
+void LocalPartition::enqueue(int32_t partition, RowVectorPtr data) {
+  ContinueFuture future;
+  auto reason = queues_[partition]->enqueue(std::move(data), &future);
+  if (reason != BlockingReason::kNotBlocked) {
+    blockingReasons_.push_back(reason);
+    futures_.push_back(std::move(future));
+  }
+}
+
+void LocalPartition::copyToPartitions() {
+  const auto numInput = input_->size();
+  for (auto& ranges : partitionRanges_) {
+    ranges.clear();
+  }
+  // Consecutive rows of a partition are copied as one range.
+  for (auto row = 0; row < numInput; ++row) {
+    auto& ranges = partitionRanges_[partitions_[row]];
+    if (!ranges.empty() &&
+        ranges.back().sourceIndex + ranges.back().count == row) {
+      ++ranges.back().count;
+    } else {
+      ranges.push_back({row, 0, 1});
+    }
+  }
+
+  const auto maxRows = outputBatchRows();
+  for (auto i = 0; i < numPartitions_; ++i) {
+    auto& ranges = partitionRanges_[i];
+    if (ranges.empty()) {
+      continue;
+    }
+    auto& target = partitionVectors_[i];
+    if (target == nullptr) {
+      target = std::static_pointer_cast<RowVector>(
+          BaseVector::create(input_->type(), 0, pool()));
+    }
+    vector_size_t size = target->size();
+    for (auto& range : ranges) {
+      range.targetIndex = size;
+      size += range.count;
+    }
+    target->resize(size);
+    target->copyRanges(input_.get(), ranges);
+    if (size >= maxRows) {
+      enqueue(i, std::move(target));
     }
   }
 }
@@ -410,12 +465,20 @@ BlockingReason LocalPartition::isBlocked(ContinueFuture* future) {
 
 void LocalPartition::noMoreInput() {
   Operator::noMoreInput();
+  for (auto i = 0; i < partitionVectors_.size(); ++i) {
+    if (partitionVectors_[i] != nullptr) {
+      enqueue(i, std::move(partitionVectors_[i]));
+    }
+  }
   for (const auto& queue : queues_) {
     queue->noMoreData();
   }
 }
 
 bool LocalPartition::isFinished() {
+  if (consumersFinished_) {
+    return true;
+  }
   if (!futures_.empty() || !noMoreInput_) {
     return false;
   }
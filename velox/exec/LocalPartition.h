@@ -92,6 +92,11 @@ class LocalExchangeQueue {
 
   bool isFinished();
 
+  /// Returns true if close() has been called, e.g. because the consumer
+  /// finished before fetching all the data. The producers can then stop
+  /// without producing the rest of their data.
+  bool isClosed();
+
   /// Drop remaining data from the queue and notify consumers and producers if
   /// called before all the data has been processed. No-op otherwise.
   void close();
@@ -154,6 +159,13 @@ class LocalExchange : public SourceOperator {
 
 /// Hash partitions the data using specified keys. The number of partitions is
 /// determined by the number of LocalExchangeQueues(s) found in the task.
+///
+/// An input that goes to a single partition is enqueued as is. Otherwise, each
+/// partition gets a dictionary over the input by default. If
+/// QueryConfig::kLocalExchangeCopyPartitions is set, the rows for each
+/// partition are instead copied into a flat vector that is enqueued once it
+/// has 'outputBatchRows()' rows, so that consumers get full size flat batches
+/// and inputs are not kept alive by small dictionaries.
 class LocalPartition : public Operator {
  public:
   LocalPartition(
@@ -184,6 +196,15 @@ class LocalPartition : public Operator {
   bool isFinished() override;
 
  private:
+  // Enqueues 'data' to the queue of 'partition' and records the blocking
+  // reason and future if the queue is full.
+  void enqueue(int32_t partition, RowVectorPtr data);
+
+  // Copies the rows of 'input_' to 'partitionVectors_' according to
+  // 'partitions_'. Enqueues the partitions that have reached
+  // 'outputBatchRows()' rows.
+  void copyToPartitions();
+
   const std::vector<std::shared_ptr<LocalExchangeQueue>> queues_;
   const size_t numPartitions_;
   std::unique_ptr<core::PartitionFunction> partitionFunction_;
@@ -193,6 +214,21 @@ class LocalPartition : public Operator {
 
   /// Reusable memory for hash calculation.
   std::vector<uint32_t> partitions_;
+
+  // True if rows are copied into a flat vector per partition. See
+  // QueryConfig::kLocalExchangeCopyPartitions.
+  const bool copyPartitions_;
+
+  // True if all the queues were closed by their consumers before this
+  // finished producing. See LocalExchangeQueue::isClosed().
+  bool consumersFinished_{false};
+
+  // Rows copied for each partition and not yet enqueued. Used if
+  // 'copyPartitions_' is true.
+  std::vector<RowVectorPtr> partitionVectors_;
+
+  // Reusable ranges of 'input_' to copy to each partition.
+  std::vector<std::vector<BaseVector::CopyRange>> partitionRanges_;
 };
 
 } // namespace facebook::velox::exec
@@ -16,6 +16,7 @@
 #include "velox/exec/LocalPlanner.h"
 #include "velox/core/PlanFragment.h"
 #include "velox/exec/ArrowStream.h"
+#include "velox/exec/AsofJoin.h"
 #include "velox/exec/AssignUniqueId.h"
 #include "velox/exec/CallbackSink.h"
 #include "velox/exec/EnforceSingleRow.h"
@@ -115,8 +116,8 @@ OperatorSupplier makeConsumerSupplier(
     };
   }
 
-  if (auto join =
-          std::dynamic_pointer_cast<const core::MergeJoinNode>(planNode)) {
+  if (std::dynamic_pointer_cast<const core::MergeJoinNode>(planNode) ||
+      std::dynamic_pointer_cast<const core::AsofJoinNode>(planNode)) {
     auto planNodeId = planNode->id();
     return [planNodeId](int32_t operatorId, DriverCtx* ctx) {
       auto source =
@@ -164,8 +165,9 @@ void plan(
 // Sometimes consumer limits the number of drivers its producer can run.
 uint32_t maxDriversForConsumer(
     const std::shared_ptr<const core::PlanNode>& node) {
-  if (std::dynamic_pointer_cast<const core::MergeJoinNode>(node)) {
-    // MergeJoinNode must run single-threaded.
+  if (std::dynamic_pointer_cast<const core::MergeJoinNode>(node) ||
+      std::dynamic_pointer_cast<const core::AsofJoinNode>(node)) {
+    // MergeJoinNode and AsofJoinNode must run single-threaded.
     return 1;
   }
   return std::numeric_limits<uint32_t>::max();
@@ -222,6 +224,9 @@ uint32_t maxDrivers(
     } else if (std::dynamic_pointer_cast<const core::MergeJoinNode>(node)) {
       // Merge join must run single-threaded.
       return 1;
+    } else if (std::dynamic_pointer_cast<const core::AsofJoinNode>(node)) {
+      // ASOF join must run single-threaded.
+      return 1;
     } else if (
         auto tableWrite =
             std::dynamic_pointer_cast<const core::TableWriteNode>(node)) {
@@ -487,6 +492,14 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
     } else if (
         auto limitNode =
             std::dynamic_pointer_cast<const core::LimitNode>(planNode)) {
+      // A scan right below the limit needs to return no more than the rows
+      // the limit takes.
+      auto* tableScan = operators.empty()
+          ? nullptr
+          : dynamic_cast<TableScan*>(operators.back().get());
+      if (tableScan) {
+        tableScan->setRowLimit(limitNode->offset() + limitNode->count());
+      }
       operators.push_back(std::make_unique<Limit>(id, ctx.get(), limitNode));
     } else if (
         auto orderByNode =
@@ -525,6 +538,12 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
       auto mergeJoinOp = std::make_unique<MergeJoin>(id, ctx.get(), mergeJoin);
       ctx->task->createMergeJoinSource(ctx->splitGroupId, mergeJoin->id());
       operators.push_back(std::move(mergeJoinOp));
+    } else if (
+        auto asofJoin =
+            std::dynamic_pointer_cast<const core::AsofJoinNode>(planNode)) {
+      auto asofJoinOp = std::make_unique<AsofJoin>(id, ctx.get(), asofJoin);
+      ctx->task->createMergeJoinSource(ctx->splitGroupId, asofJoin->id());
+      operators.push_back(std::move(asofJoinOp));
     } else if (
         auto localPartitionNode =
             std::dynamic_pointer_cast<const core::LocalPartitionNode>(
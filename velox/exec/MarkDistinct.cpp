@@ -16,6 +16,7 @@
 
 #include "velox/exec/MarkDistinct.h"
 #include "velox/common/base/Range.h"
+#include "velox/exec/OperatorUtils.h"
 #include "velox/vector/FlatVector.h"
 
 #include <algorithm>
@@ -32,8 +33,12 @@ MarkDistinct::MarkDistinct(
           planNode->outputType(),
           operatorId,
           planNode->id(),
-          "MarkDistinct") {
-  const auto& inputType = planNode->sources()[0]->outputType();
+          "MarkDistinct",
+          planNode->canSpill(driverCtx->queryConfig())
+              ? driverCtx->makeSpillConfig(operatorId)
+              : std::nullopt),
+      inputType_{planNode->sources()[0]->outputType()} {
+  const auto& inputType = inputType_;
 
   // Set all input columns as identity projection.
   for (auto i = 0; i < inputType->size(); ++i) {
@@ -43,23 +48,254 @@ MarkDistinct::MarkDistinct(
   // We will use result[0] for distinct mask output.
   resultProjections_.emplace_back(0, inputType->size());
 
-  groupingSet_ = GroupingSet::createForMarkDistinct(
-      inputType,
+  table_ = HashTable<false>::createForAggregation(
       createVectorHashers(inputType, planNode->distinctKeys()),
-      operatorCtx_.get(),
-      &nonReclaimableSection_);
+      std::vector<Accumulator>{},
+      pool());
+  lookup_ = std::make_unique<HashLookup>(table_->hashers());
+
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  for (const auto& hasher : table_->hashers()) {
+    keyChannels_.push_back(hasher->channel());
+    names.push_back(inputType->nameOf(hasher->channel()));
+    types.push_back(hasher->type());
+  }
+  tableType_ = ROW(std::move(names), std::move(types));
 
   results_.resize(1);
 }
 
 void MarkDistinct::addInput(RowVectorPtr input) {
-  groupingSet_->addInput(input, false /*mayPushdown*/);
+  ensureInputFits(input);
+  if (inputSpiller_ != nullptr) {
+    spillInput(input);
+    return;
+  }
+
+  addInputInternal(std::move(input));
+}
+
+void MarkDistinct::addInputInternal(RowVectorPtr input) {
+  {
+    // Prevents the memory arbitrator to reclaim memory from this operator
+    // during the execution below.
+    NonReclaimableSection guard(this);
+
+    SelectivityVector rows(input->size());
+    table_->prepareForProbe(*lookup_, input, rows, false);
+    table_->groupProbe(*lookup_);
+  }
 
   input_ = std::move(input);
 }
 
+void MarkDistinct::noMoreInput() {
+  Operator::noMoreInput();
+
+  if (inputSpiller_ == nullptr) {
+    return;
+  }
+
+  spiller_->finishSpill(spillHashTablePartitionSet_);
+  inputSpiller_->finishSpill(spillInputPartitionSet_);
+  recordSpillStats(spiller_->stats());
+  recordSpillStats(inputSpiller_->stats());
+  spiller_.reset();
+  inputSpiller_.reset();
+
+  restoreNextSpillPartition();
+}
+
+void MarkDistinct::ensureInputFits(const RowVectorPtr& input) {
+  // Check if spilling is enabled or not.
+  if (!spillConfig_.has_value() || inputSpiller_ != nullptr) {
+    return;
+  }
+
+  if (shouldSpillToFitInput(
+          *table_->rows(),
+          input->size(),
+          input->estimateFlatSize(),
+          table_->hashTableSizeIncrease(input->size()),
+          spillConfig_.value(),
+          spillTestCounter_,
+          pool())) {
+    spill();
+  }
+}
+
+void MarkDistinct::reclaim(uint64_t /*targetBytes*/) {
+  VELOX_CHECK(canReclaim());
+
+  // NOTE: a mark distinct operator is reclaimable if it hasn't started to
+  // restore the spilled partitions and is not under non-reclaimable execution
+  // section.
+  if (noMoreInput_ || nonReclaimableSection_) {
+    LOG(WARNING) << "Can't reclaim from mark distinct operator, noMoreInput_["
+                 << noMoreInput_ << "], nonReclaimableSection_["
+                 << nonReclaimableSection_ << "], " << toString();
+    return;
+  }
+
+  if (inputSpiller_ != nullptr || table_->numDistinct() == 0) {
+    // Already spilled or nothing to spill.
+    return;
+  }
+
+  spill();
+  // Release the minimum reserved memory.
+  pool()->release();
+}
+
+void MarkDistinct::spill() {
+  VELOX_CHECK_NULL(spiller_);
+  VELOX_CHECK_NULL(inputSpiller_);
+
+  ++numSpillRuns_;
+  const auto& spillConfig = spillConfig_.value();
+  const HashBitRange hashBits(
+      spillConfig.startPartitionBit,
+      spillConfig.startPartitionBit + spillConfig.aggregationPartitionBits);
+  spiller_ = std::make_unique<Spiller>(
+      Spiller::Type::kHashJoinBuild,
+      table_->rows(),
+      [&](folly::Range<char**> rows) { table_->erase(rows); },
+      tableType_,
+      hashBits,
+      keyChannels_.size(),
+      std::vector<CompareFlags>(),
+      spillConfig.filePath,
+      spillConfig.maxFileSize,
+      spillConfig.minSpillRunSize,
+      spillConfig.compressionKind,
+      Spiller::pool(),
+      spillConfig.executor,
+      spillConfig.extraFilePaths);
+  std::vector<Spiller::SpillableStats> spillableStats(
+      hashBits.numPartitions());
+  spiller_->fillSpillRuns(spillableStats);
+  spiller_->spill();
+  VELOX_CHECK(spiller_->isAllSpilled());
+  table_->clear();
+
+  inputSpiller_ = std::make_unique<Spiller>(
+      Spiller::Type::kHashJoinProbe,
+      inputType_,
+      hashBits,
+      spillConfig.filePath,
+      spillConfig.maxFileSize,
+      spillConfig.minSpillRunSize,
+      spillConfig.compressionKind,
+      Spiller::pool(),
+      spillConfig.executor,
+      spillConfig.extraFilePaths);
+  inputSpiller_->setPartitionsSpilled(spiller_->spilledPartitionSet());
+  spillHashFunction_ = std::make_unique<HashPartitionFunction>(
+      hashBits, inputType_, keyChannels_);
+}
+
+void MarkDistinct::spillInput(const RowVectorPtr& input) {
+  const auto numInput = input->size();
+  std::vector<uint32_t> spillPartitions(numInput);
+  spillHashFunction_->partition(*input, spillPartitions);
+
+  const auto numPartitions = spillHashFunction_->numPartitions();
+  std::vector<BufferPtr> partitionIndices(numPartitions);
+  std::vector<vector_size_t*> rawPartitionIndices(numPartitions);
+  std::vector<vector_size_t> numPartitionInputs(numPartitions, 0);
+  for (auto row = 0; row < numInput; ++row) {
+    const auto partition = spillPartitions[row];
+    if (partitionIndices[partition] == nullptr) {
+      partitionIndices[partition] = allocateIndices(numInput, pool());
+      rawPartitionIndices[partition] =
+          partitionIndices[partition]->asMutable<vector_size_t>();
+    }
+    rawPartitionIndices[partition][numPartitionInputs[partition]++] = row;
+  }
+
+  // Ensure vector are lazy loaded before spilling.
+  for (auto i = 0; i < input->childrenSize(); ++i) {
+    input->childAt(i)->loadedVector();
+  }
+
+  for (auto partition = 0; partition < numPartitions; ++partition) {
+    const auto numPartitionInput = numPartitionInputs[partition];
+    if (numPartitionInput == 0) {
+      continue;
+    }
+    inputSpiller_->spill(
+        partition,
+        wrap(numPartitionInput, partitionIndices[partition], input));
+  }
+}
+
+void MarkDistinct::addSpillInput() {
+  VELOX_CHECK_NULL(input_);
+
+  while (spillInputReader_ != nullptr) {
+    RowVectorPtr spillInput;
+    if (spillInputReader_->nextBatch(spillInput)) {
+      addInputInternal(std::move(spillInput));
+      return;
+    }
+    restoreNextSpillPartition();
+  }
+}
+
+void MarkDistinct::restoreNextSpillPartition() {
+  spillInputReader_.reset();
+  if (spillInputPartitionSet_.empty()) {
+    return;
+  }
+
+  // The partitions without spilled input don't produce any output.
+  auto it = spillInputPartitionSet_.begin();
+  spillInputReader_ = it->second->createReader();
+
+  table_->clear();
+  auto tableIt = spillHashTablePartitionSet_.find(it->first);
+  if (tableIt != spillHashTablePartitionSet_.end()) {
+    auto reader = tableIt->second->createReader();
+    RowVectorPtr data;
+    while (reader->nextBatch(data)) {
+      restoreHashTable(data);
+    }
+    spillHashTablePartitionSet_.erase(tableIt);
+  }
+  spillInputPartitionSet_.erase(it);
+}
+
+void MarkDistinct::restoreHashTable(const RowVectorPtr& data) {
+  const auto size = data->size();
+
+  // The hashers read the keys from their channels in the input, so place the
+  // spilled keys at the same channels.
+  std::vector<VectorPtr> children(inputType_->size());
+  for (auto i = 0; i < keyChannels_.size(); ++i) {
+    children[keyChannels_[i]] = data->childAt(i);
+  }
+  for (auto i = 0; i < children.size(); ++i) {
+    if (children[i] == nullptr) {
+      children[i] =
+          BaseVector::createNullConstant(inputType_->childAt(i), size, pool());
+    }
+  }
+  auto keys = std::make_shared<RowVector>(
+      pool(), inputType_, nullptr, size, std::move(children));
+
+  SelectivityVector rows(size);
+  table_->prepareForProbe(*lookup_, keys, rows, false);
+  table_->groupProbe(*lookup_);
+  VELOX_CHECK_EQ(lookup_->newGroups.size(), size);
+}
+
 RowVectorPtr MarkDistinct::getOutput() {
-  if (isFinished() || !input_) {
+  if (input_ == nullptr && spillInputReader_ != nullptr) {
+    addSpillInput();
+  }
+
+  if (input_ == nullptr) {
     return nullptr;
   }
 
@@ -79,7 +315,7 @@ RowVectorPtr MarkDistinct::getOutput() {
       results_[0]->as<FlatVector<bool>>()->mutableRawValues<uint64_t>();
 
   bits::fillBits(resultBits, 0, outputSize, false);
-  for (const auto i : groupingSet_->hashLookup().newGroups) {
+  for (const auto i : lookup_->newGroups) {
     bits::setBit(resultBits, i, true);
   }
   auto output = fillOutput(outputSize, nullptr);
@@ -92,6 +328,6 @@ RowVectorPtr MarkDistinct::getOutput() {
 }
 
 bool MarkDistinct::isFinished() {
-  return noMoreInput_ && !input_;
+  return noMoreInput_ && !input_ && spillInputReader_ == nullptr;
 }
 } // namespace facebook::velox::exec
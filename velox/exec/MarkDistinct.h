@@ -16,8 +16,10 @@
 
 #pragma once
 
-#include "velox/exec/GroupingSet.h"
+#include "velox/exec/HashPartitionFunction.h"
+#include "velox/exec/HashTable.h"
 #include "velox/exec/Operator.h"
+#include "velox/exec/Spiller.h"
 
 namespace facebook::velox::exec {
 
@@ -40,14 +42,76 @@ class MarkDistinct : public Operator {
 
   RowVectorPtr getOutput() override;
 
+  void noMoreInput() override;
+
   BlockingReason isBlocked(ContinueFuture* /*future*/) override {
     return BlockingReason::kNotBlocked;
   }
 
   bool isFinished() override;
 
+  void reclaim(uint64_t targetBytes) override;
+
  private:
-  // TODO: Document spilling configuration in spilling.rst.
-  std::unique_ptr<GroupingSet> groupingSet_;
+  // Probes the hash table with 'input'. The new groups in 'lookup_' are the
+  // distinct rows.
+  void addInputInternal(RowVectorPtr input);
+
+  // Checks if input will fit in the existing memory and increases reservation
+  // if not. If reservation cannot be increased, spills the hash table.
+  void ensureInputFits(const RowVectorPtr& input);
+
+  // Spills all the hash table partitions and clears the hash table. All the
+  // subsequent input is spilled to the same hash partitions. This is called by
+  // ensureInputFits or by external memory management. In the latter case, the
+  // Driver of this will be in a paused state and off thread.
+  void spill();
+
+  // Spills 'input' rows to their hash partitions.
+  void spillInput(const RowVectorPtr& input);
+
+  // Reads the next batch of the spilled input into 'input_'. Restores the
+  // next spilled partition if the current one is exhausted. Sets
+  // 'spillInputReader_' to null if all the spilled partitions are processed.
+  void addSpillInput();
+
+  // Restores the hash table of the next spilled partition and sets up
+  // 'spillInputReader_' to read its spilled input.
+  void restoreNextSpillPartition();
+
+  // Inserts the spilled distinct keys from 'data' into the hash table.
+  void restoreHashTable(const RowVectorPtr& data);
+
+  const RowTypePtr inputType_;
+
+  // The channels of the distinct keys in the input.
+  std::vector<column_index_t> keyChannels_;
+
+  // The distinct keys. This is the type of the spilled hash table rows.
+  RowTypePtr tableType_;
+
+  // Hash table of the distinct keys seen so far.
+  std::unique_ptr<BaseHashTable> table_;
+  std::unique_ptr<HashLookup> lookup_;
+
+  // Spills the hash table rows. Set when spilling is triggered. All the hash
+  // partitions are spilled together.
+  std::unique_ptr<Spiller> spiller_;
+
+  // Spills the input received after 'spiller_' is set up by hash partition.
+  std::unique_ptr<Spiller> inputSpiller_;
+  std::unique_ptr<HashPartitionFunction> spillHashFunction_;
+
+  // Counts input batches and triggers spilling if folly hash of this % 100 <=
+  // 'testSpillPct_';.
+  uint64_t spillTestCounter_{0};
+
+  // The spilled hash table rows and input by spill partition. The partitions
+  // are restored one at a time after no more input.
+  SpillPartitionSet spillHashTablePartitionSet_;
+  SpillPartitionSet spillInputPartitionSet_;
+
+  // Reads the spilled input of the partition being restored.
+  std::unique_ptr<UnorderedStreamReader<BatchStream>> spillInputReader_;
 };
 } // namespace facebook::velox::exec
@@ -305,7 +305,16 @@ MergeExchange::MergeExchange(
           mergeExchangeNode->sortingKeys(),
           mergeExchangeNode->sortingOrders(),
           mergeExchangeNode->id(),
-          "MergeExchange") {}
+          "MergeExchange"),
+      serde_(getExchangeSerde(driverCtx->queryConfig())),
+      serdeOptions_(makeExchangeSerdeOptions(
+          driverCtx->queryConfig(),
+          &compressionStats_)) {}
+
+void MergeExchange::close() {
+  Merge::close();
+  recordDecompressionStats(compressionStats_, *this);
+}
 
 BlockingReason MergeExchange::addMergeSources(ContinueFuture* future) {
   if (operatorCtx_->driverCtx()->driverId != 0) {
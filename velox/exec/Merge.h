@@ -191,10 +191,28 @@ class MergeExchange : public Merge {
       DriverCtx* driverCtx,
       const std::shared_ptr<const core::MergeExchangeNode>& orderByNode);
 
+  void close() override;
+
+  /// Serde of the pages of the sources. See QueryConfig::kExchangeSerde.
+  VectorSerde* serde() const {
+    return serde_;
+  }
+
+  /// Options for deserializing the pages of the sources. nullptr if pages are
+  /// not compressed.
+  const VectorSerde::Options* serdeOptions() const {
+    return serdeOptions_.get();
+  }
+
  protected:
   BlockingReason addMergeSources(ContinueFuture* future) override;
 
  private:
+  VectorSerde* const serde_;
+  // Decompression time of the pages of all sources. Declared before
+  // 'serdeOptions_' which points to it.
+  serializer::presto::PrestoVectorSerde::CompressionStats compressionStats_;
+  const std::unique_ptr<VectorSerde::Options> serdeOptions_;
   bool noMoreSplits_ = false;
   size_t numSplits_{0}; // Number of splits we took to process so far.
 };
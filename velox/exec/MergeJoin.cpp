@@ -29,10 +29,22 @@ MergeJoin::MergeJoin(
           joinNode->outputType(),
           operatorId,
           joinNode->id(),
-          "MergeJoin"),
+          "MergeJoin",
+          joinNode->canSpill(driverCtx->queryConfig())
+              ? driverCtx->makeSpillConfig(operatorId)
+              : std::nullopt),
+      maxOutputBatchSize_{
+          driverCtx->queryConfig().adaptiveOutputBatchSizing()
+              ? std::max(
+                    driverCtx->queryConfig().maxOutputBatchRows(),
+                    driverCtx->queryConfig().preferredOutputBatchRows())
+              : outputBatchRows()},
       outputBatchSize_{outputBatchRows()},
       joinType_{joinNode->joinType()},
-      numKeys_{joinNode->leftKeys().size()} {
+      numKeys_{joinNode->leftKeys().size()},
+      rightType_{joinNode->sources()[1]->outputType()},
+      spillMemoryThreshold_{
+          driverCtx->queryConfig().mergeJoinSpillMemoryThreshold()} {
   VELOX_USER_CHECK(
       joinNode->isInnerJoin() || joinNode->isLeftJoin(),
       "Merge join supports only inner and left joins. Other join types are not supported yet.");
@@ -70,7 +82,7 @@ MergeJoin::MergeJoin(
     initializeFilter(joinNode->filter(), leftType, rightType);
 
     if (joinNode->isLeftJoin()) {
-      leftJoinTracker_ = LeftJoinTracker(outputBatchSize_, pool());
+      leftJoinTracker_ = LeftJoinTracker(maxOutputBatchSize_, pool());
     }
   }
 }
@@ -124,6 +136,18 @@ BlockingReason MergeJoin::isBlocked(ContinueFuture* future) {
   return BlockingReason::kNotBlocked;
 }
 
+void MergeJoin::close() {
+  if (rightSource_) {
+    rightSource_->close();
+  }
+  spiller_.reset();
+  spillReader_.reset();
+  if (noMoreInput_ && spillStats_.spilledRows != 0) {
+    recordSpillStats(spillStats_);
+  }
+  Operator::close();
+}
+
 bool MergeJoin::needsInput() const {
   return input_ == nullptr;
 }
@@ -193,6 +217,114 @@ bool MergeJoin::findEndOfMatch(
   return true;
 }
 
+namespace {
+// Returns rows [start, end) of 'input' with lazy vectors loaded.
+RowVectorPtr loadedRange(
+    const RowVectorPtr& input,
+    vector_size_t start,
+    vector_size_t end) {
+  std::vector<VectorPtr> children;
+  children.reserve(input->childrenSize());
+  for (const auto& child : input->children()) {
+    auto loaded = BaseVector::loadedVectorShared(child);
+    if (start != 0 || end != input->size()) {
+      loaded = loaded->slice(start, end - start);
+    }
+    children.push_back(std::move(loaded));
+  }
+  return std::make_shared<RowVector>(
+      input->pool(), input->type(), nullptr, end - start, std::move(children));
+}
+} // namespace
+
+void MergeJoin::maybeSpillRightMatch(size_t numOldInputs) {
+  auto& match = rightMatch_.value();
+  const auto numInputs = match.inputs.size();
+  for (auto i = numOldInputs; i < numInputs; ++i) {
+    const auto& input = match.inputs[i];
+    const auto start = i == 0 ? match.startIndex : 0;
+    const auto end = i == numInputs - 1 ? match.endIndex : input->size();
+    rightMatchRows_ += end - start;
+    rightMatchBytes_ += input->retainedSize();
+  }
+
+  if (match.complete && rightMatchRows_ > maxRightMatchRows_) {
+    maxRightMatchRows_ = rightMatchRows_;
+    stats_.wlock()->runtimeStats["maxRightMatchRows"] =
+        RuntimeMetric(maxRightMatchRows_);
+  }
+
+  // A match within a single batch doesn't buffer any batch of its own.
+  if (spiller_ == nullptr && (numInputs == 1 || !needSpillRightMatch())) {
+    return;
+  }
+  spillRightMatch();
+
+  if (match.complete) {
+    SpillPartitionSet spillPartitionSet;
+    spiller_->finishSpill(spillPartitionSet);
+    spillStats_ += spiller_->stats();
+    spiller_.reset();
+    VELOX_CHECK_EQ(spillPartitionSet.size(), 1);
+    match.spillPartition = std::move(spillPartitionSet.begin()->second);
+  }
+}
+
+bool MergeJoin::needSpillRightMatch() {
+  if (!spillConfig_.has_value()) {
+    return false;
+  }
+
+  // Test-only spill path.
+  const auto& spillConfig = spillConfig_.value();
+  if (spillConfig.testSpillPct &&
+      (folly::hasher<uint64_t>()(++spillTestCounter_)) % 100 <=
+          spillConfig.testSpillPct) {
+    return true;
+  }
+
+  return spillMemoryThreshold_ != 0 &&
+      rightMatchBytes_ > spillMemoryThreshold_;
+}
+
+void MergeJoin::spillRightMatch() {
+  auto& match = rightMatch_.value();
+  if (spiller_ == nullptr) {
+    // The rows of a match are read back in the order they were written, so
+    // there is no sorting and a single partition.
+    const auto& spillConfig = spillConfig_.value();
+    spiller_ = std::make_unique<Spiller>(
+        Spiller::Type::kHashJoinProbe,
+        rightType_,
+        HashBitRange(
+            spillConfig.startPartitionBit, spillConfig.startPartitionBit),
+        spillConfig.filePath,
+        spillConfig.maxFileSize,
+        spillConfig.minSpillRunSize,
+        spillConfig.compressionKind,
+        Spiller::pool(),
+        spillConfig.executor,
+        spillConfig.extraFilePaths);
+    VELOX_CHECK_EQ(spiller_->hashBits().numPartitions(), 1);
+    spiller_->setPartitionsSpilled({0});
+  }
+
+  const auto numInputs = match.inputs.size();
+  for (auto i = match.numSpilledInputs; i < numInputs; ++i) {
+    const auto& input = match.inputs[i];
+    const auto start = i == 0 ? match.startIndex : 0;
+    const auto end = i == numInputs - 1 ? match.endIndex : input->size();
+    if (end > start) {
+      spiller_->spill(0, loadedRange(input, start, end));
+    }
+  }
+
+  // Keep the last batch to find the end of the match in the next batch.
+  match.inputs.erase(match.inputs.begin(), match.inputs.end() - 1);
+  match.numSpilledInputs = 1;
+  rightMatchBytes_ = match.inputs.back()->retainedSize();
+}
+
 namespace {
 void copyRow(
     const RowVectorPtr& source,
@@ -251,6 +383,12 @@ void MergeJoin::addOutputRow(
 
 void MergeJoin::prepareOutput() {
   if (output_ == nullptr) {
+    outputBatchSize_ =
+        std::min(adaptiveOutputBatchRows(), maxOutputBatchSize_);
+    if (filterInput_ != nullptr && filterInput_->size() < outputBatchSize_) {
+      filterInput_ = nullptr;
+    }
+
     std::vector<VectorPtr> localColumns(outputType_->size());
     for (auto i = 0; i < outputType_->size(); ++i) {
       localColumns[i] = BaseVector::create(
@@ -300,6 +438,10 @@ void MergeJoin::prepareOutput() {
 }
 
 bool MergeJoin::addToOutput() {
+  if (rightMatch_->spillPartition != nullptr) {
+    return addSpilledToOutput();
+  }
+
   prepareOutput();
 
   size_t firstLeftBatch;
@@ -354,6 +496,60 @@ bool MergeJoin::addToOutput() {
   return outputSize_ == outputBatchSize_;
 }
 
+bool MergeJoin::addSpilledToOutput() {
+  prepareOutput();
+
+  const bool resume = leftMatch_->cursor.has_value();
+  size_t firstLeftBatch;
+  vector_size_t leftStartIndex;
+  if (resume) {
+    firstLeftBatch = leftMatch_->cursor->batchIndex;
+    leftStartIndex = leftMatch_->cursor->index;
+  } else {
+    firstLeftBatch = 0;
+    leftStartIndex = leftMatch_->startIndex;
+  }
+
+  size_t numLefts = leftMatch_->inputs.size();
+  for (size_t l = firstLeftBatch; l < numLefts; ++l) {
+    auto left = leftMatch_->inputs[l];
+    auto leftStart = l == firstLeftBatch ? leftStartIndex : 0;
+    auto leftEnd = l == numLefts - 1 ? leftMatch_->endIndex : left->size();
+
+    for (auto i = leftStart; i < leftEnd; ++i) {
+      if (!resume || l != firstLeftBatch || i != leftStart) {
+        // Start a new pass over the spilled rows for this left side row.
+        spillReader_ = rightMatch_->spillPartition->createSharedReader();
+        spillInput_ = nullptr;
+        spillIndex_ = 0;
+      }
+
+      for (;;) {
+        if (spillInput_ == nullptr || spillIndex_ == spillInput_->size()) {
+          if (!spillReader_->nextBatch(spillInput_)) {
+            spillInput_ = nullptr;
+            break;
+          }
+          spillIndex_ = 0;
+          continue;
+        }
+        if (outputSize_ == outputBatchSize_) {
+          leftMatch_->setCursor(l, i);
+          rightMatch_->setCursor(0, 0);
+          return true;
+        }
+        addOutputRow(left, i, spillInput_, spillIndex_++);
+      }
+    }
+  }
+
+  spillReader_.reset();
+  leftMatch_.reset();
+  rightMatch_.reset();
+
+  return outputSize_ == outputBatchSize_;
+}
+
 namespace {
 vector_size_t firstNonNull(
     const RowVectorPtr& rowVector,
@@ -469,7 +665,12 @@ RowVectorPtr MergeJoin::doGetOutput() {
     }
 
     if (rightInput_) {
-      if (!findEndOfMatch(rightMatch_.value(), rightInput_, rightKeys_)) {
+      if (!rightMatch_->complete) {
+        const auto numInputs = rightMatch_->inputs.size();
+        findEndOfMatch(rightMatch_.value(), rightInput_, rightKeys_);
+        maybeSpillRightMatch(numInputs);
+      }
+      if (!rightMatch_->complete) {
         // Continue looking for the end of the match.
         rightInput_ = nullptr;
         return nullptr;
@@ -482,7 +683,10 @@ RowVectorPtr MergeJoin::doGetOutput() {
         }
       }
     } else if (noMoreRightInput_) {
-      rightMatch_->complete = true;
+      if (!rightMatch_->complete) {
+        rightMatch_->complete = true;
+        maybeSpillRightMatch(rightMatch_->inputs.size());
+      }
     } else {
       // Need more input.
       return nullptr;
@@ -601,6 +805,9 @@ RowVectorPtr MergeJoin::doGetOutput() {
           endRightIndex,
           endRightIndex < rightInput_->size(),
           std::nullopt};
+      rightMatchRows_ = 0;
+      rightMatchBytes_ = 0;
+      maybeSpillRightMatch(0);
 
       if (!leftMatch_->complete || !rightMatch_->complete) {
         if (!leftMatch_->complete) {
@@ -16,6 +16,7 @@
 #pragma once
 #include "velox/exec/MergeSource.h"
 #include "velox/exec/Operator.h"
+#include "velox/exec/Spiller.h"
 
 namespace facebook::velox::exec {
 class MergeJoin : public Operator {
@@ -35,12 +36,7 @@ class MergeJoin : public Operator {
 
   bool isFinished() override;
 
-  void close() override {
-    if (rightSource_) {
-      rightSource_->close();
-    }
-    Operator::close();
-  }
+  void close() override;
 
  private:
   // Sets up 'filter_' and related member variables.
@@ -134,6 +130,15 @@ class MergeJoin : public Operator {
     void setCursor(size_t batchIndex, vector_size_t index) {
       cursor = Cursor{batchIndex, index};
     }
+
+    /// Number of leading batches in 'inputs' whose matching rows have been
+    /// spilled. Only a right side match spills. The last spilled batch is
+    /// kept to compare the keys of the next batch with.
+    size_t numSpilledInputs{0};
+
+    /// The spilled rows of a complete right side match. If set, all the rows
+    /// of the match are read from here and not from 'inputs'.
+    std::unique_ptr<SpillPartition> spillPartition;
   };
 
   /// Given a partial set of rows with matching keys (match) finds all rows from
@@ -147,6 +152,19 @@ class MergeJoin : public Operator {
       const RowVectorPtr& input,
       const std::vector<column_index_t>& keys);
 
+  /// Accounts for the batches of 'rightMatch_' after the first
+  /// 'numOldInputs' and spills the buffered rows of
+  /// 'rightMatch_' if these exceed the spill memory threshold or the
+  /// match has spilled before. Finishes the spill if the match is complete.
+  void maybeSpillRightMatch(size_t numOldInputs);
+
+  /// Returns true if the buffered rows of 'rightMatch_' need to be spilled.
+  bool needSpillRightMatch();
+
+  /// Writes the matching rows of the batches of 'rightMatch_' not spilled yet
+  /// to 'spiller_'.
+  void spillRightMatch();
+
   /// Initialize 'output_' vector using 'ouputType_' and 'outputBatchSize_' if
   /// it is null.
   void prepareOutput();
@@ -160,6 +178,10 @@ class MergeJoin : public Operator {
   // rightMatchCursor_ if output_ filled up before all rows were added.
   bool addToOutput();
 
+  // Same as addToOutput() for a right side match whose rows have spilled. The
+  // spilled rows are read back once for each left side row of the match.
+  bool addSpilledToOutput();
+
   // Adds one row of output by copying values from left and right batches at the
   // specified rows. Advances outputSize_. Assumes that output_ has room.
   //
@@ -335,8 +357,13 @@ class MergeJoin : public Operator {
 
   std::optional<LeftJoinTracker> leftJoinTracker_{std::nullopt};
 
-  /// Maximum number of rows in the output batch.
-  const uint32_t outputBatchSize_;
+  /// Upper bound of 'outputBatchSize_'. 'leftJoinTracker_' is sized for this
+  /// many rows.
+  const uint32_t maxOutputBatchSize_;
+
+  /// Maximum number of rows in the current output batch. Is updated at the
+  /// start of each batch from the measured size of the output rows.
+  uint32_t outputBatchSize_;
 
   /// Type of join.
   const core::JoinType joinType_;
@@ -395,5 +422,37 @@ class MergeJoin : public Operator {
 
   /// True if all the right side data has been received.
   bool noMoreRightInput_{false};
+
+  const RowTypePtr rightType_;
+
+  /// The max bytes of right side rows of a match to buffer before spilling
+  /// the match. 0 means no limit.
+  const uint64_t spillMemoryThreshold_;
+
+  /// Number of rows and retained bytes of the batches of 'rightMatch_'.
+  uint64_t rightMatchRows_{0};
+  uint64_t rightMatchBytes_{0};
+
+  /// Largest number of right side rows of a match seen so far. Reported in
+  /// runtime stats.
+  uint64_t maxRightMatchRows_{0};
+
+  /// Spills the rows of 'rightMatch_'. Set while an incomplete right side
+  /// match is being spilled.
+  std::unique_ptr<Spiller> spiller_;
+
+  /// Reads back the spilled rows of 'rightMatch_' for the left side row being
+  /// joined. 'spillInput_' is the batch being read and 'spillIndex_' the next
+  /// row in it.
+  std::unique_ptr<UnorderedStreamReader<BatchStream>> spillReader_;
+  RowVectorPtr spillInput_;
+  vector_size_t spillIndex_{0};
+
+  /// Counts right side batches of a match and triggers spilling if folly
+  /// hash of this % 100 <= 'testSpillPct'.
+  uint64_t spillTestCounter_{0};
+
+  /// Spill stats of all the spilled right side matches.
+  SpillStats spillStats_;
 };
 } // namespace facebook::velox::exec
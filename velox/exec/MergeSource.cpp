@@ -155,17 +155,18 @@ class MergeExchangeSource : public MergeSource {
     }
 
     if (!inputStream_->atEnd()) {
-      VectorStreamGroup::read(
+      mergeExchange_->serde()->deserialize(
           inputStream_.get(),
           mergeExchange_->pool(),
           mergeExchange_->outputType(),
-          &data);
+          &data,
+          mergeExchange_->serdeOptions());
 
       auto lockedStats = mergeExchange_->stats().wlock();
       lockedStats->addInputVector(data->estimateFlatSize(), data->size());
     }
 
-    // Since VectorStreamGroup::read() may cause inputStream to be at end,
+    // Since deserialize() may cause inputStream to be at end,
     // check again and reset currentPage_ and inputStream_ here.
     if (inputStream_->atEnd()) {
       // Reached end of the stream.
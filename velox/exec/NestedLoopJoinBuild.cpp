@@ -18,12 +18,15 @@
 
 namespace facebook::velox::exec {
 
-void NestedLoopJoinBridge::setData(std::vector<RowVectorPtr> buildVectors) {
+void NestedLoopJoinBridge::setData(
+    std::vector<RowVectorPtr> buildVectors,
+    std::unique_ptr<SpillPartition> spillPartition) {
   std::vector<ContinuePromise> promises;
   {
     std::lock_guard<std::mutex> l(mutex_);
     VELOX_CHECK(!buildVectors_.has_value(), "setData must be called only once");
     buildVectors_ = std::move(buildVectors);
+    spillPartition_ = std::move(spillPartition);
     promises = std::move(promises_);
   }
   notify(std::move(promises));
@@ -50,7 +53,13 @@ NestedLoopJoinBuild::NestedLoopJoinBuild(
           nullptr,
           operatorId,
           joinNode->id(),
-          "NestedLoopJoinBuild") {}
+          "NestedLoopJoinBuild",
+          joinNode->canSpill(driverCtx->queryConfig())
+              ? driverCtx->makeSpillConfig(operatorId)
+              : std::nullopt),
+      buildType_(joinNode->sources()[1]->outputType()),
+      spillMemoryThreshold_(
+          driverCtx->queryConfig().nestedLoopJoinSpillMemoryThreshold()) {}
 
 void NestedLoopJoinBuild::addInput(RowVectorPtr input) {
   if (input->size() > 0) {
@@ -58,8 +67,78 @@ void NestedLoopJoinBuild::addInput(RowVectorPtr input) {
     for (auto& child : input->children()) {
       child->loadedVector();
     }
+    dataBytes_ += input->retainedSize();
     dataVectors_.emplace_back(std::move(input));
+    if (needSpill()) {
+      spill();
+    }
+  }
+}
+
+bool NestedLoopJoinBuild::needSpill() {
+  if (!spillConfig_.has_value()) {
+    return false;
+  }
+
+  // Test-only spill path.
+  const auto& spillConfig = spillConfig_.value();
+  if (spillConfig.testSpillPct &&
+      (folly::hasher<uint64_t>()(++spillTestCounter_)) % 100 <=
+          spillConfig.testSpillPct) {
+    return true;
+  }
+
+  return spillMemoryThreshold_ != 0 && dataBytes_ > spillMemoryThreshold_;
+}
+
+void NestedLoopJoinBuild::reclaim(uint64_t /*targetBytes*/) {
+  VELOX_CHECK(canReclaim());
+
+  // NOTE: a nested loop join build operator is reclaimable if it hasn't handed
+  // over the build side data to the probe side and is not under
+  // non-reclaimable execution section.
+  if (noMoreInput_ || nonReclaimableSection_) {
+    LOG(WARNING) << "Can't reclaim from nested loop join build operator, "
+                 << "noMoreInput_[" << noMoreInput_
+                 << "], nonReclaimableSection_[" << nonReclaimableSection_
+                 << "], " << toString();
+    return;
+  }
+
+  spill();
+}
+
+void NestedLoopJoinBuild::spill() {
+  if (dataVectors_.empty()) {
+    return;
   }
+
+  ++numSpillRuns_;
+  if (spiller_ == nullptr) {
+    // The build side data is not partitioned as every probe row needs to be
+    // matched against all the build rows.
+    const auto& spillConfig = spillConfig_.value();
+    spiller_ = std::make_unique<Spiller>(
+        Spiller::Type::kHashJoinProbe,
+        buildType_,
+        HashBitRange(
+            spillConfig.startPartitionBit, spillConfig.startPartitionBit),
+        spillConfig.filePath,
+        spillConfig.maxFileSize,
+        spillConfig.minSpillRunSize,
+        spillConfig.compressionKind,
+        Spiller::pool(),
+        spillConfig.executor,
+        spillConfig.extraFilePaths);
+    VELOX_CHECK_EQ(spiller_->hashBits().numPartitions(), 1);
+    spiller_->setPartitionsSpilled({0});
+  }
+
+  for (const auto& vector : dataVectors_) {
+    spiller_->spill(0, vector);
+  }
+  dataVectors_.clear();
+  dataBytes_ = 0;
 }
 
 BlockingReason NestedLoopJoinBuild::isBlocked(ContinueFuture* future) {
@@ -84,6 +163,13 @@ void NestedLoopJoinBuild::noMoreInput() {
     return;
   }
 
+  SpillPartitionSet spillPartitionSet;
+  if (spiller_ != nullptr) {
+    spiller_->finishSpill(spillPartitionSet);
+    recordSpillStats(spiller_->stats());
+    spiller_.reset();
+  }
+
   {
     auto promisesGuard = folly::makeGuard([&]() {
       // Realize the promises so that the other Drivers (which were not
@@ -102,13 +188,25 @@ void NestedLoopJoinBuild::noMoreInput() {
           dataVectors_.begin(),
           build->dataVectors_.begin(),
           build->dataVectors_.end());
+      if (build->spiller_ != nullptr) {
+        // All the spilled build side data goes to the same spill partition.
+        build->spiller_->finishSpill(spillPartitionSet);
+        build->recordSpillStats(build->spiller_->stats());
+        build->spiller_.reset();
+      }
     }
   }
 
+  std::unique_ptr<SpillPartition> spillPartition;
+  if (!spillPartitionSet.empty()) {
+    VELOX_CHECK_EQ(spillPartitionSet.size(), 1);
+    spillPartition = std::move(spillPartitionSet.begin()->second);
+  }
+
   operatorCtx_->task()
       ->getNestedLoopJoinBridge(
           operatorCtx_->driverCtx()->splitGroupId, planNodeId())
-      ->setData(std::move(dataVectors_));
+      ->setData(std::move(dataVectors_), std::move(spillPartition));
 }
 
 bool NestedLoopJoinBuild::isFinished() {
@@ -17,17 +17,29 @@
 
 #include "velox/exec/JoinBridge.h"
 #include "velox/exec/Operator.h"
+#include "velox/exec/Spiller.h"
 
 namespace facebook::velox::exec {
 
 class NestedLoopJoinBridge : public JoinBridge {
  public:
-  void setData(std::vector<RowVectorPtr> buildVectors);
+  /// Sets the build side data. 'spillPartition' contains the spilled build
+  /// side data if the build side has spilled, otherwise it is null.
+  void setData(
+      std::vector<RowVectorPtr> buildVectors,
+      std::unique_ptr<SpillPartition> spillPartition = nullptr);
 
   std::optional<std::vector<RowVectorPtr>> dataOrFuture(ContinueFuture* future);
 
+  /// Returns the spilled build side data or null if the build side hasn't
+  /// spilled. Must be called after dataOrFuture() has returned the data.
+  const SpillPartition* spillPartition() const {
+    return spillPartition_.get();
+  }
+
  private:
   std::optional<std::vector<RowVectorPtr>> buildVectors_;
+  std::unique_ptr<SpillPartition> spillPartition_;
 };
 
 class NestedLoopJoinBuild : public Operator {
@@ -53,14 +65,42 @@ class NestedLoopJoinBuild : public Operator {
 
   bool isFinished() override;
 
+  void reclaim(uint64_t targetBytes) override;
+
   void close() override {
     dataVectors_.clear();
+    spiller_.reset();
     Operator::close();
   }
 
  private:
+  // Returns true if the buffered build side data needs to be spilled.
+  bool needSpill();
+
+  // Spills all the buffered build side data. This is called from addInput or
+  // by external memory management. In the latter case, the Driver of this will
+  // be in a paused state and off thread.
+  void spill();
+
+  const RowTypePtr buildType_;
+
+  // The max bytes of build side data to buffer before spilling. 0 means no
+  // limit.
+  const uint64_t spillMemoryThreshold_;
+
   std::vector<RowVectorPtr> dataVectors_;
 
+  // The retained bytes of 'dataVectors_'.
+  uint64_t dataBytes_{0};
+
+  // Spills the build side data to a single partition. Set when spilling is
+  // first triggered.
+  std::unique_ptr<Spiller> spiller_;
+
+  // Counts input batches and triggers spilling if folly hash of this % 100 <=
+  // 'testSpillPct_';.
+  uint64_t spillTestCounter_{0};
+
   // Future for synchronizing with other Drivers of the same pipeline. All build
   // Drivers must be completed before making data available for the probe side.
   ContinueFuture future_{ContinueFuture::makeEmpty()};
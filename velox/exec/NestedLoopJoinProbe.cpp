@@ -55,7 +55,9 @@ NestedLoopJoinProbe::NestedLoopJoinProbe(
           joinNode->id(),
           "NestedLoopJoinProbe"),
       outputBatchSize_{outputBatchRows()},
-      joinType_(joinNode->joinType()) {
+      joinType_(joinNode->joinType()),
+      spillReadBufferSize_(
+          driverCtx->queryConfig().nestedLoopJoinSpillReadBufferSize()) {
   auto probeType = joinNode->sources()[0]->outputType();
   auto buildType = joinNode->sources()[1]->outputType();
   identityProjections_ = extractProjections(probeType, outputType_);
@@ -102,6 +104,8 @@ void NestedLoopJoinProbe::close() {
     joinCondition_->clear();
   }
   buildVectors_.reset();
+  inMemoryBuildVectors_.clear();
+  spillReader_.reset();
   Operator::close();
 }
 
@@ -117,6 +121,9 @@ void NestedLoopJoinProbe::addInput(RowVectorPtr input) {
   if (needsProbeMismatch(joinType_)) {
     probeMatched_.resizeFill(input_->size(), false);
   }
+  if (buildVectors_->empty()) {
+    loadSpilledBuildVectors();
+  }
 }
 
 RowVectorPtr NestedLoopJoinProbe::getOutput() {
@@ -250,6 +257,12 @@ void NestedLoopJoinProbe::finishProbeInput() {
   VELOX_CHECK_NOT_NULL(input_);
   input_.reset();
   buildIndex_ = 0;
+  if (spillPartition_ != nullptr) {
+    // Start over from the in-memory build side data for the next probe input.
+    spillReader_.reset();
+    spillPassFinished_ = false;
+    buildVectors_ = inMemoryBuildVectors_;
+  }
   if (!noMoreInput_) {
     return;
   }
@@ -304,22 +317,56 @@ void NestedLoopJoinProbe::beginBuildMismatch() {
 bool NestedLoopJoinProbe::getBuildData(ContinueFuture* future) {
   VELOX_CHECK(!buildVectors_.has_value());
 
-  auto buildData =
-      operatorCtx_->task()
-          ->getNestedLoopJoinBridge(
-              operatorCtx_->driverCtx()->splitGroupId, planNodeId())
-          ->dataOrFuture(future);
+  auto bridge = operatorCtx_->task()->getNestedLoopJoinBridge(
+      operatorCtx_->driverCtx()->splitGroupId, planNodeId());
+  auto buildData = bridge->dataOrFuture(future);
   if (!buildData.has_value()) {
     return false;
   }
 
   buildVectors_ = std::move(buildData);
-  if (buildVectors_->empty()) {
+  spillPartition_ = bridge->spillPartition();
+  if (spillPartition_ != nullptr) {
+    VELOX_CHECK(!needsBuildMismatch(joinType_));
+    inMemoryBuildVectors_ = buildVectors_.value();
+  }
+  if (buildVectors_->empty() && spillPartition_ == nullptr) {
     buildSideEmpty_ = true;
   }
   return true;
 }
 
+bool NestedLoopJoinProbe::loadSpilledBuildVectors() {
+  if (spillPartition_ == nullptr || spillPassFinished_) {
+    return false;
+  }
+  if (spillReader_ == nullptr) {
+    spillReader_ = spillPartition_->createSharedReader();
+  }
+
+  std::vector<RowVectorPtr> vectors;
+  uint64_t numBytes{0};
+  while (numBytes < spillReadBufferSize_) {
+    RowVectorPtr vector;
+    if (!spillReader_->nextBatch(vector)) {
+      spillReader_.reset();
+      spillPassFinished_ = true;
+      break;
+    }
+    if (vector->size() == 0) {
+      continue;
+    }
+    numBytes += vector->retainedSize();
+    vectors.push_back(std::move(vector));
+  }
+  if (vectors.empty()) {
+    return false;
+  }
+  buildVectors_ = std::move(vectors);
+  buildIndex_ = 0;
+  return true;
+}
+
 vector_size_t NestedLoopJoinProbe::getNumProbeRows() const {
   VELOX_CHECK_NOT_NULL(input_);
   VELOX_CHECK(!hasProbedAllBuildData());
@@ -393,6 +440,9 @@ bool NestedLoopJoinProbe::advanceProbeRows(vector_size_t probeCnt) {
     ++buildIndex_;
   } while (!hasProbedAllBuildData() &&
            !buildVectors_.value()[buildIndex_]->size());
+  if (hasProbedAllBuildData()) {
+    loadSpilledBuildVectors();
+  }
   return hasProbedAllBuildData();
 }
 
@@ -56,6 +56,12 @@ class NestedLoopJoinProbe : public Operator {
 
   bool getBuildData(ContinueFuture* future);
 
+  // Loads the next chunk of the spilled build side data into 'buildVectors_'
+  // for the current probe input. Returns false if the current probe input has
+  // been matched against all the spilled build side data or the build side
+  // hasn't spilled.
+  bool loadSpilledBuildVectors();
+
   // Calculates the number of probe rows to match with the build side vectors
   // given the output batch size limit.
   vector_size_t getNumProbeRows() const;
@@ -153,6 +159,19 @@ class NestedLoopJoinProbe : public Operator {
   std::vector<IdentityProjection> buildProjections_;
   BufferPtr buildIndices_;
 
+  // The spilled build side data if the build side has spilled. Each probe
+  // input is matched against the in-memory build side data in
+  // 'inMemoryBuildVectors_' first. It is then matched against the spilled
+  // build side data, which is read back up to 'spillReadBufferSize_' bytes at
+  // a time.
+  const SpillPartition* spillPartition_{nullptr};
+  const uint64_t spillReadBufferSize_;
+  std::vector<RowVectorPtr> inMemoryBuildVectors_;
+  std::unique_ptr<UnorderedStreamReader<BatchStream>> spillReader_;
+  // Set if the current probe input has been matched against all the spilled
+  // build side data.
+  bool spillPassFinished_{false};
+
   // Represents whether probe build rows have been matched.
   std::vector<SelectivityVector> buildMatched_;
   std::vector<IdentityProjection> filterBuildProjections_;
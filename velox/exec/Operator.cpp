@@ -16,6 +16,7 @@
 #include "velox/exec/Operator.h"
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/common/time/Timer.h"
 #include "velox/exec/Driver.h"
 #include "velox/exec/HashJoinBridge.h"
 #include "velox/exec/OperatorUtils.h"
@@ -230,6 +231,18 @@ OperatorStats Operator::stats(bool clear) {
   return ret;
 }
 
+void Operator::recordVectorPoolStats() {
+  const auto* poolStats = operatorCtx_->vectorPoolStats();
+  if (poolStats == nullptr || poolStats->numGets == 0) {
+    return;
+  }
+  auto lockedStats = stats_.wlock();
+  lockedStats->addRuntimeStat(
+      "vectorPool.numGets", RuntimeCounter(poolStats->numGets));
+  lockedStats->addRuntimeStat(
+      "vectorPool.numReused", RuntimeCounter(poolStats->numReused));
+}
+
 uint32_t Operator::outputBatchRows(
     std::optional<uint64_t> averageRowSize) const {
   const auto& queryConfig = operatorCtx_->task()->queryCtx()->queryConfig();
@@ -254,6 +267,22 @@ uint32_t Operator::outputBatchRows(
       queryConfig.preferredOutputBatchBytes() / rowSize, 1);
 }
 
+uint32_t Operator::adaptiveOutputBatchRows() const {
+  const auto& queryConfig = operatorCtx_->task()->queryCtx()->queryConfig();
+  if (!queryConfig.adaptiveOutputBatchSizing()) {
+    return outputBatchRows();
+  }
+
+  std::optional<uint64_t> averageRowSize;
+  {
+    auto lockedStats = stats_.rlock();
+    if (lockedStats->outputPositions > 0) {
+      averageRowSize = lockedStats->outputBytes / lockedStats->outputPositions;
+    }
+  }
+  return outputBatchRows(averageRowSize);
+}
+
 void Operator::recordBlockingTime(uint64_t start, BlockingReason reason) {
   uint64_t now =
       std::chrono::duration_cast<std::chrono::microseconds>(
@@ -335,6 +364,31 @@ void Operator::recordSpillStats(const SpillStats& spillStats) {
   }
 }
 
+void Operator::growMemoryAsync(uint64_t bytes) {
+  if (memoryFuture_.valid() || pool()->root()->freeBytes() >= bytes) {
+    return;
+  }
+  auto future = pool()->growCapacityAsync(bytes);
+  if (!future.valid() || future.isReady()) {
+    return;
+  }
+  // NOTE: a failed arbitration is not an error here. The next allocation
+  // retries the arbitration synchronously and spills or fails there.
+  memoryFuture_ = std::move(future).defer([](folly::Try<bool>&& /*unused*/) {});
+}
+
+BlockingReason Operator::waitForMemory(ContinueFuture* future) {
+  if (!memoryFuture_.valid()) {
+    return BlockingReason::kNotBlocked;
+  }
+  if (memoryFuture_.isReady()) {
+    memoryFuture_ = ContinueFuture::makeEmpty();
+    return BlockingReason::kNotBlocked;
+  }
+  *future = std::move(memoryFuture_);
+  return BlockingReason::kWaitForMemory;
+}
+
 std::string Operator::toString() const {
   std::stringstream out;
   if (auto task = operatorCtx_->task()) {
@@ -427,6 +481,7 @@ void OperatorStats::add(const OperatorStats& other) {
   blockedWallNanos += other.blockedWallNanos;
 
   finishTiming.add(other.finishTiming);
+  hardwareCounters.add(other.hardwareCounters);
 
   memoryStats.add(other.memoryStats);
 
@@ -463,6 +518,7 @@ void OperatorStats::clear() {
   blockedWallNanos = 0;
 
   finishTiming.clear();
+  hardwareCounters.clear();
 
   memoryStats.clear();
 
@@ -496,6 +552,7 @@ void Operator::MemoryReclaimer::enterArbitration() {
     // mutate the operator state.g
     return;
   }
+  arbitrationStartUs_ = getCurrentTimeMicro();
   if (driver->task()->enterSuspended(driver->state()) != StopReason::kNone) {
     // There is no need for arbitration if the associated task has already
     // terminated.
@@ -514,6 +571,8 @@ void Operator::MemoryReclaimer::leaveArbitration() noexcept {
     // NOTE: see the comment in enterArbitration.
     return;
   }
+  driver->task()->addMemoryArbitrationTime(
+      getCurrentTimeMicro() - arbitrationStartUs_);
   driver->task()->leaveSuspended(driver->state());
 }
 
@@ -16,6 +16,7 @@
 #pragma once
 #include <folly/Synchronized.h>
 #include "velox/common/base/RuntimeMetrics.h"
+#include "velox/common/process/PerfCounters.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/core/PlanNode.h"
 #include "velox/exec/Driver.h"
@@ -124,6 +125,10 @@ struct OperatorStats {
 
   CpuWallTiming finishTiming;
 
+  /// Hardware counters of addInput, getOutput and finish, if enabled by
+  /// QueryConfig::kOperatorTrackHardwareCounters.
+  process::HardwareCounters hardwareCounters;
+
   MemoryStats memoryStats;
 
   // Total bytes written for spilling.
@@ -209,6 +214,18 @@ class OperatorCtx {
 
   core::ExecCtx* execCtx() const;
 
+  /// Returns the pool of recyclable vectors shared by the operator and the
+  /// expressions it evaluates.
+  VectorPool& vectorPool() const {
+    return execCtx()->vectorPool();
+  }
+
+  /// Returns the stats of the vector pool or nullptr if the pool was never
+  /// created.
+  const VectorPool::Stats* vectorPoolStats() const {
+    return execCtx_ ? &execCtx_->vectorPool().stats() : nullptr;
+  }
+
   /// Makes an extract of QueryCtx for use in a connector. 'planNodeId'
   /// is the id of the calling TableScan. This and the task id identify the scan
   /// for column access tracking. 'connectorPool' is an aggregate memory pool
@@ -400,6 +417,10 @@ class Operator : public BaseRuntimeStatWriter {
   /// clears the operator stats after retrieval.
   OperatorStats stats(bool clear);
 
+  /// Adds the get and reuse counts of the vector pool of 'operatorCtx_' to the
+  /// runtime stats. Called once when the operator is closed.
+  void recordVectorPoolStats();
+
   /// Add a single runtime stat to the operator stats under the write lock.
   /// This member overrides BaseRuntimeStatWriter's member.
   void addRuntimeStat(const std::string& name, const RuntimeCounter& value)
@@ -536,6 +557,8 @@ class Operator : public BaseRuntimeStatWriter {
 
     const std::weak_ptr<Driver> driver_;
     Operator* const op_;
+    // Time when the driver thread entered the current memory arbitration.
+    uint64_t arbitrationStartUs_{0};
   };
 
   /// The scoped object to mark a reclaimable operator is under non-reclaimable
@@ -584,9 +607,30 @@ class Operator : public BaseRuntimeStatWriter {
   uint32_t outputBatchRows(
       std::optional<uint64_t> averageRowSize = std::nullopt) const;
 
+  /// Returns outputBatchRows() for the average size of the rows this operator
+  /// has produced so far, as measured by the Driver, or for no size before the
+  /// first output. Used by operators that cannot estimate the size of their
+  /// output rows up front, e.g. joins and unnest, to steer their batches
+  /// toward preferredOutputBatchBytes. Returns outputBatchRows() if
+  /// QueryConfig::adaptiveOutputBatchSizing() is false.
+  uint32_t adaptiveOutputBatchRows() const;
+
   /// Invoked to record spill stats in operator stats.
   void recordSpillStats(const SpillStats& spillStats);
 
+  /// Starts to grow the capacity of the query memory pool by 'bytes' on the
+  /// memory arbitration executor if the pool has less free capacity. Until the
+  /// arbitration completes, waitForMemory() returns kWaitForMemory so that the
+  /// driver does not hold its thread while other queries are spilled. Does
+  /// nothing if the memory manager has no arbitration executor, in which case
+  /// the capacity grows synchronously on allocation.
+  void growMemoryAsync(uint64_t bytes);
+
+  /// Returns kWaitForMemory and sets 'future' if an arbitration started by
+  /// growMemoryAsync() is pending. Operators using growMemoryAsync() call this
+  /// from isBlocked().
+  BlockingReason waitForMemory(ContinueFuture* future);
+
   const std::unique_ptr<OperatorCtx> operatorCtx_;
   const RowTypePtr outputType_;
   /// Contains the disk spilling related configs if spilling is enabled (e.g.
@@ -621,6 +665,9 @@ class Operator : public BaseRuntimeStatWriter {
 
   /// The number of times that spilling run on this operator.
   uint32_t numSpillRuns_{0};
+
+  /// Completes when the arbitration started by growMemoryAsync() is done.
+  ContinueFuture memoryFuture_{ContinueFuture::makeEmpty()};
 };
 
 /// Given a row type returns indices for the specified subset of columns.
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/OperatorUtils.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/exec/VectorHasher.h"
 #include "velox/expression/EvalCtx.h"
 #include "velox/vector/ConstantVector.h"
@@ -368,12 +369,24 @@ void addOperatorRuntimeStats(
     const std::string& name,
     const RuntimeCounter& value,
     std::unordered_map<std::string, RuntimeMetric>& stats) {
-  if (UNLIKELY(stats.count(name) == 0)) {
-    stats.insert(std::pair(name, RuntimeMetric(value.unit)));
+  auto it = stats.find(name);
+  if (UNLIKELY(it == stats.end())) {
+    it = stats.insert(std::pair(name, RuntimeMetric(value.unit))).first;
+    if (runtimeHistogramReporterKey(name) != nullptr) {
+      it->second.histogram.emplace();
+    }
   } else {
-    VELOX_CHECK_EQ(stats.at(name).unit, value.unit);
+    VELOX_CHECK_EQ(it->second.unit, value.unit);
+  }
+  auto& metric = it->second;
+  metric.addValue(value.value);
+  if (metric.histogram.has_value()) {
+    const auto* reporterKey = runtimeHistogramReporterKey(name);
+    if (reporterKey != nullptr && !reporterKey->empty()) {
+      REPORT_ADD_HISTOGRAM_VALUE(
+          *reporterKey, std::max<int64_t>(value.value, 0));
+    }
   }
-  stats.at(name).addValue(value.value);
 }
 
 void aggregateOperatorRuntimeStats(
@@ -416,4 +429,103 @@ void projectChildren(
         wrapChild(size, mapping, src[projection.inputChannel]);
   }
 }
+
+std::vector<IdentityProjection> keyColumnsFirst(
+    const RowTypePtr& type,
+    const std::vector<core::FieldAccessTypedExprPtr>& keys) {
+  std::vector<IdentityProjection> columnMap;
+  columnMap.reserve(type->size());
+  std::unordered_set<column_index_t> keyChannelSet;
+  for (const auto& key : keys) {
+    const auto channel = exprToChannel(key.get(), type);
+    VELOX_CHECK(
+        channel != kConstantChannel,
+        "Constant keys are not allowed: {}",
+        key->toString());
+    columnMap.emplace_back(columnMap.size(), channel);
+    keyChannelSet.emplace(channel);
+  }
+  for (column_index_t channel = 0; channel < type->size(); ++channel) {
+    if (keyChannelSet.count(channel) == 0) {
+      columnMap.emplace_back(columnMap.size(), channel);
+    }
+  }
+  return columnMap;
+}
+
+RowTypePtr projectRowType(
+    const RowTypePtr& type,
+    const std::vector<IdentityProjection>& columnMap) {
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  names.reserve(columnMap.size());
+  types.reserve(columnMap.size());
+  for (const auto& projection : columnMap) {
+    names.push_back(type->nameOf(projection.outputChannel));
+    types.push_back(type->childAt(projection.outputChannel));
+  }
+  return ROW(std::move(names), std::move(types));
+}
+
+bool shouldSpillToFitInput(
+    const RowContainer& rows,
+    vector_size_t numNewRows,
+    int64_t flatInputBytes,
+    int64_t extraIncrementBytes,
+    const Spiller::Config& spillConfig,
+    uint64_t& spillTestCounter,
+    memory::MemoryPool* pool,
+    int64_t* spillBytes) {
+  const int64_t numRows = rows.numRows();
+  if (numRows == 0) {
+    // 'rows' is empty. Nothing to spill.
+    return false;
+  }
+  auto [freeRows, outOfLineFreeBytes] = rows.freeSpace();
+  const int64_t outOfLineBytes =
+      rows.stringAllocator().retainedSize() - outOfLineFreeBytes;
+
+  // Test-only spill path. A partial spill frees a tenth of the rows.
+  if (spillConfig.testSpillPct &&
+      (folly::hasher<uint64_t>()(++spillTestCounter)) % 100 <=
+          spillConfig.testSpillPct) {
+    if (spillBytes != nullptr) {
+      *spillBytes = std::max<int64_t>(1, numRows / 10) *
+          (rows.fixedRowSize() + outOfLineBytes / numRows);
+    }
+    return true;
+  }
+
+  if (extraIncrementBytes == 0 && freeRows > numNewRows &&
+      (outOfLineBytes == 0 || outOfLineFreeBytes >= flatInputBytes)) {
+    // Enough free rows for the new rows and enough variable length free
+    // space for the flat size of the whole input. If outOfLineBytes is 0
+    // there is no need for variable length space.
+    return false;
+  }
+
+  // If there is variable length data we take the flat size of the input as a
+  // cap on the new variable length data needed.
+  const int64_t incrementBytes = extraIncrementBytes +
+      rows.sizeIncrement(numNewRows, outOfLineBytes ? flatInputBytes : 0);
+
+  // There must be at least 2x the increment in reservation.
+  if (pool->availableReservation() > 2 * incrementBytes) {
+    return false;
+  }
+
+  // Check if can increase reservation. The increment is the larger of twice the
+  // maximum increment from this input and 'spillableReservationGrowthPct' of
+  // the current reservation.
+  const auto targetIncrementBytes = std::max<int64_t>(
+      incrementBytes * 2,
+      pool->currentBytes() * spillConfig.spillableReservationGrowthPct / 100);
+  if (pool->maybeReserve(targetIncrementBytes)) {
+    return false;
+  }
+  if (spillBytes != nullptr) {
+    *spillBytes = targetIncrementBytes;
+  }
+  return true;
+}
 } // namespace facebook::velox::exec
@@ -155,4 +155,37 @@ void projectChildren(
     int32_t size,
     const BufferPtr& mapping);
 
+/// Returns the map from the columns of 'type' (outputChannel) to the columns
+/// of a row container (inputChannel) that stores the 'keys' columns first,
+/// followed by the rest of the columns of 'type' in their original order. This
+/// enables to use the sorting facility provided by the row container and to
+/// spill its content as sorted runs.
+std::vector<IdentityProjection> keyColumnsFirst(
+    const RowTypePtr& type,
+    const std::vector<core::FieldAccessTypedExprPtr>& keys);
+
+/// Returns the row type of the row container columns described by
+/// 'columnMap', as returned by keyColumnsFirst().
+RowTypePtr projectRowType(
+    const RowTypePtr& type,
+    const std::vector<IdentityProjection>& columnMap);
+
+/// Checks if 'pool' has the reservation for adding 'numNewRows' rows with
+/// 'flatInputBytes' of flat input data to 'rows', plus 'extraIncrementBytes'
+/// for other structures, e.g. a hash table, and tries to increase the
+/// reservation if not. Returns true if the reservation cannot be increased and
+/// the caller should spill, or if the test-only spill path selected by
+/// 'spillConfig.testSpillPct' and 'spillTestCounter' is taken. In that case
+/// sets 'spillBytes', if not null, to the bytes a partial spill needs to free.
+/// Returns false if 'rows' is empty.
+bool shouldSpillToFitInput(
+    const RowContainer& rows,
+    vector_size_t numNewRows,
+    int64_t flatInputBytes,
+    int64_t extraIncrementBytes,
+    const Spiller::Config& spillConfig,
+    uint64_t& spillTestCounter,
+    memory::MemoryPool* pool,
+    int64_t* spillBytes = nullptr);
+
 } // namespace facebook::velox::exec
@@ -15,6 +15,7 @@
  */
 
 #include "velox/exec/PartitionedOutput.h"
+#include "velox/exec/Exchange.h"
 #include "velox/exec/PartitionedOutputBufferManager.h"
 #include "velox/exec/Task.h"
 
@@ -66,13 +67,13 @@ void Destination::serialize(
     vector_size_t begin,
     vector_size_t end) {
   if (!current_) {
-    current_ = std::make_unique<VectorStreamGroup>(pool_);
+    current_ = std::make_unique<VectorStreamGroup>(pool_, serde_);
     auto rowType = asRowType(output->type());
     vector_size_t numRows = 0;
     for (vector_size_t i = begin; i < end; i++) {
       numRows += rows_[i].size;
     }
-    current_->createStreamTree(rowType, numRows);
+    current_->createStreamTree(rowType, numRows, serdeOptions_);
   }
   current_->append(output, folly::Range(&rows_[begin], end - begin));
 }
@@ -95,6 +96,7 @@ BlockingReason Destination::flush(
   current_->flush(&stream);
   current_.reset();
   bytesInCurrent_ = 0;
+  rowsInCurrent_ = 0;
   setTargetSizePct();
 
   bool blocked = bufferManager.enqueue(
@@ -105,8 +107,58 @@ BlockingReason Destination::flush(
   return blocked ? BlockingReason::kWaitForConsumer
                  : BlockingReason::kNotBlocked;
 }
+
+VectorStreamGroup* Destination::streamGroup(
+    const RowTypePtr& type,
+    vector_size_t numRows) {
+  if (!current_) {
+    current_ = std::make_unique<VectorStreamGroup>(pool_, serde_);
+    current_->createStreamTree(type, numRows, serdeOptions_);
+  }
+  return current_.get();
+}
+
+BlockingReason Destination::flushIfFull(
+    uint64_t maxBytes,
+    PartitionedOutputBufferManager& bufferManager,
+    const std::function<void()>& bufferReleaseFn,
+    ContinueFuture* future) {
+  const uint32_t adjustedMaxBytes = (maxBytes * targetSizePct_) / 100;
+  if (bytesInCurrent_ >= adjustedMaxBytes ||
+      rowsInCurrent_ >= targetNumRows_) {
+    return flush(bufferManager, bufferReleaseFn, future);
+  }
+  return BlockingReason::kNotBlocked;
+}
 } // namespace detail
 
+namespace {
+// Pages that do not compress to at least 1 / kMinCompressionRatio of their
+// size are sent uncompressed with adaptive compression.
+constexpr float kMinCompressionRatio = 1.2;
+
+std::unique_ptr<VectorSerde::Options> makeSerdeOptions(
+    const core::QueryConfig& config,
+    serializer::presto::PrestoVectorSerde::CompressionStats* stats) {
+  const auto compressionKind =
+      common::stringToCompressionKind(config.exchangeCompressionKind());
+  if (!config.partitionedOutputPreserveEncodings() &&
+      compressionKind == common::CompressionKind_NONE) {
+    return nullptr;
+  }
+  auto options =
+      std::make_unique<serializer::presto::PrestoVectorSerde::PrestoOptions>();
+  options->preserveEncodings = config.partitionedOutputPreserveEncodings();
+  options->compressionKind = compressionKind;
+  options->compressionStats = stats;
+  if (compressionKind != common::CompressionKind_NONE &&
+      config.exchangeAdaptiveCompression()) {
+    options->minCompressionRatio = kMinCompressionRatio;
+  }
+  return options;
+}
+} // namespace
+
 PartitionedOutput::PartitionedOutput(
     int32_t operatorId,
     DriverCtx* ctx,
@@ -136,7 +188,15 @@ PartitionedOutput::PartitionedOutput(
       bufferReleaseFn_([task = operatorCtx_->task()]() {}),
       maxBufferedBytes_(ctx->task->queryCtx()
                             ->queryConfig()
-                            .maxPartitionedOutputBufferSize()) {
+                            .maxPartitionedOutputBufferSize()),
+      scatter_(
+          !replicateNullsAndAny_ && numDestinations_ > 1 &&
+          ctx->queryConfig().partitionedOutputScatterMinDestinations() > 0 &&
+          numDestinations_ >=
+              ctx->queryConfig().partitionedOutputScatterMinDestinations()),
+      serde_(getExchangeSerde(ctx->queryConfig())),
+      serdeOptions_(
+          makeSerdeOptions(ctx->queryConfig(), &compressionStats_)) {
   if (!planNode->isPartitioned()) {
     VELOX_USER_CHECK_EQ(numDestinations_, 1);
   }
@@ -178,7 +238,8 @@ void PartitionedOutput::initializeDestinations() {
     auto taskId = operatorCtx_->taskId();
     for (int i = 0; i < numDestinations_; ++i) {
       destinations_.push_back(
-          std::make_unique<detail::Destination>(taskId, i, pool()));
+          std::make_unique<detail::Destination>(
+              taskId, i, pool(), serdeOptions_.get(), serde_));
     }
   }
 }
@@ -204,7 +265,7 @@ void PartitionedOutput::estimateRowSizes() {
   auto numInput = input_->size();
   std::fill(rowSize_.begin(), rowSize_.end(), 0);
   for (int i = 0; i < output_->childrenSize(); ++i) {
-    VectorStreamGroup::estimateSerializedSize(
+    serde_->estimateSerializedSize(
         output_->childAt(i),
         folly::Range(topLevelRanges_.data(), numInput),
         sizePointers_.data());
@@ -212,6 +273,15 @@ void PartitionedOutput::estimateRowSizes() {
 }
 
 void PartitionedOutput::addInput(RowVectorPtr input) {
+  if (auto bufferManager = bufferManager_.lock();
+      bufferManager &&
+      bufferManager->consumersFinished(operatorCtx_->task()->taskId())) {
+    // No consumer needs more data, e.g. after a limit downstream. Finish
+    // without serializing the rest of the input.
+    finished_ = true;
+    return;
+  }
+
   // TODO Report outputBytes as bytes after serialization
   {
     auto lockedStats = stats_.wlock();
@@ -264,6 +334,8 @@ void PartitionedOutput::addInput(RowVectorPtr input) {
       if (singlePartition.has_value()) {
         destinations_[singlePartition.value()]->addRows(
             IndexRange{0, numInput});
+      } else if (scatter_) {
+        scatterToDestinations();
       } else {
         for (vector_size_t i = 0; i < numInput; ++i) {
           destinations_[partitions_[i]]->addRow(i);
@@ -296,6 +368,24 @@ void PartitionedOutput::collectNullRows() {
   nullRows_.updateBounds();
 }
 
+void PartitionedOutput::scatterToDestinations() {
+  const auto numInput = input_->size();
+  const auto rowType = asRowType(output_->type());
+  // Space for the expected number of rows per destination.
+  const vector_size_t numRows = numInput / numDestinations_ + 1;
+  streamGroups_.resize(numDestinations_);
+  for (auto i = 0; i < numDestinations_; ++i) {
+    streamGroups_[i] = destinations_[i]->streamGroup(rowType, numRows);
+  }
+  for (vector_size_t i = 0; i < numInput; ++i) {
+    destinations_[partitions_[i]]->addSerializedRow(rowSize_[i]);
+  }
+  VectorStreamGroup::appendScattered(
+      output_,
+      folly::Range(partitions_.data(), numInput),
+      folly::Range(streamGroups_.data(), streamGroups_.size()));
+}
+
 RowVectorPtr PartitionedOutput::getOutput() {
   if (finished_) {
     return nullptr;
@@ -313,8 +403,21 @@ RowVectorPtr PartitionedOutput::getOutput() {
       kMinDestinationSize,
       std::min<uint64_t>(kMaxPageSize, maxBufferedBytes_ / numDestinations_));
 
-  bool workLeft;
-  do {
+  if (scatter_) {
+    // The input is already serialized into the pages in progress. Flush the
+    // ones that are full.
+    for (auto& destination : destinations_) {
+      blockingReason_ = destination->flushIfFull(
+          maxPageSize, *bufferManager, bufferReleaseFn_, &future_);
+      if (blockingReason_ != BlockingReason::kNotBlocked) {
+        blockedDestination = destination.get();
+        break;
+      }
+    }
+  }
+
+  bool workLeft = blockedDestination == nullptr;
+  while (workLeft) {
     workLeft = false;
     for (auto& destination : destinations_) {
       bool atEnd = false;
@@ -338,7 +441,7 @@ RowVectorPtr PartitionedOutput::getOutput() {
         workLeft = true;
       }
     }
-  } while (workLeft);
+  }
 
   if (blockedDestination) {
     // If we are going off-thread, we may as well make the output in
@@ -378,4 +481,33 @@ bool PartitionedOutput::isFinished() {
   return finished_;
 }
 
+void PartitionedOutput::close() {
+  destinations_.clear();
+  if (compressionStats_.compressionInputBytes == 0 &&
+      compressionStats_.numSkippedPages == 0) {
+    return;
+  }
+  addRuntimeStat(
+      "compressionInputBytes",
+      RuntimeCounter(
+          compressionStats_.compressionInputBytes,
+          RuntimeCounter::Unit::kBytes));
+  addRuntimeStat(
+      "compressedBytes",
+      RuntimeCounter(
+          compressionStats_.compressedBytes, RuntimeCounter::Unit::kBytes));
+  addRuntimeStat(
+      "compressionWallNanos",
+      RuntimeCounter(
+          compressionStats_.compressionTimeUs * 1'000,
+          RuntimeCounter::Unit::kNanos));
+  addRuntimeStat(
+      "compressionSkippedPages",
+      RuntimeCounter(compressionStats_.numSkippedPages));
+  addRuntimeStat(
+      "uncompressedPages",
+      RuntimeCounter(compressionStats_.numUncompressedPages));
+  compressionStats_ = {};
+}
+
 } // namespace facebook::velox::exec
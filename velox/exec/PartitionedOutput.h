@@ -18,6 +18,7 @@
 #include <folly/Random.h>
 #include "velox/exec/Operator.h"
 #include "velox/exec/PartitionedOutputBufferManager.h"
+#include "velox/serializers/PrestoSerializer.h"
 #include "velox/vector/VectorStream.h"
 
 namespace facebook::velox::exec {
@@ -25,11 +26,20 @@ namespace facebook::velox::exec {
 namespace detail {
 class Destination {
  public:
+  /// 'serdeOptions' are passed to the serializer of each page. May be
+  /// nullptr. Pages are serialized with 'serde', or with the default vector
+  /// serde if nullptr.
   Destination(
       const std::string& taskId,
       int destination,
-      memory::MemoryPool* pool)
-      : taskId_(taskId), destination_(destination), pool_(pool) {
+      memory::MemoryPool* pool,
+      const VectorSerde::Options* serdeOptions = nullptr,
+      VectorSerde* serde = nullptr)
+      : taskId_(taskId),
+        destination_(destination),
+        pool_(pool),
+        serdeOptions_(serdeOptions),
+        serde_(serde) {
     setTargetSizePct();
   }
 
@@ -61,6 +71,26 @@ class Destination {
       const std::function<void()>& bufferReleaseFn,
       ContinueFuture* future);
 
+  // Returns the stream group of the page in progress for rows of 'type'.
+  // Creates the stream group with space for 'numRows' if there is no page in
+  // progress. Used for appending rows outside of advance().
+  VectorStreamGroup* streamGroup(const RowTypePtr& type, vector_size_t numRows);
+
+  // Records a row of 'bytes' estimated serialized size appended to
+  // streamGroup().
+  void addSerializedRow(vector_size_t bytes) {
+    bytesInCurrent_ += bytes;
+    ++rowsInCurrent_;
+  }
+
+  // Flushes the page in progress if it has reached the target size in bytes
+  // or rows.
+  BlockingReason flushIfFull(
+      uint64_t maxBytes,
+      PartitionedOutputBufferManager& bufferManager,
+      const std::function<void()>& bufferReleaseFn,
+      ContinueFuture* future);
+
   bool isFinished() const {
     return finished_;
   }
@@ -93,7 +123,11 @@ class Destination {
   const std::string taskId_;
   const int destination_;
   memory::MemoryPool* const pool_;
+  const VectorSerde::Options* const serdeOptions_;
+  VectorSerde* const serde_;
   uint64_t bytesInCurrent_{0};
+  // Number of rows added with addSerializedRow() to the page in progress.
+  vector_size_t rowsInCurrent_{0};
   std::vector<IndexRange> rows_;
 
   // First row of 'rows_' that is not appended to 'current_'
@@ -159,9 +193,7 @@ class PartitionedOutput : public Operator {
 
   bool isFinished() override;
 
-  void close() override {
-    destinations_.clear();
-  }
+  void close() override;
 
  private:
   void initializeInput(RowVectorPtr input);
@@ -175,6 +207,10 @@ class PartitionedOutput : public Operator {
   /// Collect all rows with null keys into nullRows_.
   void collectNullRows();
 
+  // Serializes all rows of 'output_' into the destinations given by
+  // 'partitions_' one column at a time.
+  void scatterToDestinations();
+
   const std::vector<column_index_t> keyChannels_;
   const int numDestinations_;
   const bool replicateNullsAndAny_;
@@ -184,6 +220,19 @@ class PartitionedOutput : public Operator {
   const std::weak_ptr<exec::PartitionedOutputBufferManager> bufferManager_;
   const std::function<void()> bufferReleaseFn_;
   const int64_t maxBufferedBytes_;
+  // True if input is serialized with scatterToDestinations(). See
+  // QueryConfig::kPartitionedOutputScatterMinDestinations.
+  const bool scatter_;
+  // Serde of the pages of all destinations. See
+  // QueryConfig::kExchangeSerde.
+  VectorSerde* const serde_;
+  // Compression counters of the pages of all destinations. Declared before
+  // 'serdeOptions_' which points to it.
+  serializer::presto::PrestoVectorSerde::CompressionStats compressionStats_;
+  // Options for serializing the pages of all destinations. Set if
+  // QueryConfig::kPartitionedOutputPreserveEncodings is true or
+  // QueryConfig::kExchangeCompressionKind is not none, nullptr otherwise.
+  const std::unique_ptr<VectorSerde::Options> serdeOptions_;
 
   BlockingReason blockingReason_{BlockingReason::kNotBlocked};
   ContinueFuture future_;
@@ -203,6 +252,7 @@ class PartitionedOutput : public Operator {
   SelectivityVector nullRows_;
   std::vector<uint32_t> partitions_;
   std::vector<DecodedVector> decodedVectors_;
+  std::vector<VectorStreamGroup*> streamGroups_;
 };
 
 } // namespace facebook::velox::exec
@@ -14,12 +14,97 @@
  * limitations under the License.
  */
 #include "velox/exec/PartitionedOutputBuffer.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/common/testutil/TestValue.h"
 #include "velox/exec/Task.h"
 
+using facebook::velox::common::testutil::TestValue;
+
 namespace facebook::velox::exec {
 
 using core::PartitionedOutputNode;
 
+// A file that buffered pages are written to. Is shared by its pages and
+// removed with the last of them.
+class SpilledPageFile {
+ public:
+  explicit SpilledPageFile(std::string path)
+      : path_(std::move(path)),
+        fs_(filesystems::getFileSystem(path_, nullptr)),
+        output_(fs_->openFileForWrite(path_)) {}
+
+  ~SpilledPageFile() {
+    try {
+      output_->close();
+      fs_->remove(path_);
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Failed to remove output spill file " << path_ << ": "
+                   << e.what();
+    }
+  }
+
+  uint64_t size() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return output_->size();
+  }
+
+  // Appends 'iobuf' and returns its offset in the file.
+  uint64_t write(const folly::IOBuf& iobuf) {
+    std::lock_guard<std::mutex> l(mutex_);
+    const auto offset = output_->size();
+    for (auto range : iobuf) {
+      output_->append(std::string_view(
+          reinterpret_cast<const char*>(range.data()), range.size()));
+    }
+    flushed_ = false;
+    return offset;
+  }
+
+  std::unique_ptr<folly::IOBuf> read(uint64_t offset, uint64_t size) {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (!flushed_) {
+      output_->flush();
+      flushed_ = true;
+    }
+    // The file may have grown since 'input_' was opened.
+    if (input_ == nullptr || offset + size > input_->size()) {
+      input_ = fs_->openFileForRead(path_);
+    }
+    auto iobuf = folly::IOBuf::create(size);
+    input_->pread(offset, size, iobuf->writableData());
+    iobuf->append(size);
+    return iobuf;
+  }
+
+ private:
+  const std::string path_;
+  const std::shared_ptr<filesystems::FileSystem> fs_;
+  mutable std::mutex mutex_;
+  const std::unique_ptr<WriteFile> output_;
+  std::unique_ptr<ReadFile> input_;
+  bool flushed_{true};
+};
+
+void FetchedPages::add(const std::shared_ptr<SerializedPage>& page) {
+  if (page != nullptr && page->isSpilled()) {
+    iobufs_.push_back(nullptr);
+    spilledPages_.push_back(page);
+    return;
+  }
+  iobufs_.push_back(page != nullptr ? page->getIOBuf() : nullptr);
+  spilledPages_.push_back(nullptr);
+}
+
+std::vector<std::unique_ptr<folly::IOBuf>> FetchedPages::load() {
+  for (auto i = 0; i < spilledPages_.size(); ++i) {
+    if (spilledPages_[i] != nullptr) {
+      iobufs_[i] = spilledPages_[i]->getIOBuf();
+    }
+  }
+  spilledPages_.clear();
+  return std::move(iobufs_);
+}
+
 void ArbitraryBuffer::noMoreData() {
   // Drop duplicate end markers.
   if (!pages_.empty() && pages_.back() == nullptr) {
@@ -55,6 +140,14 @@ std::vector<std::shared_ptr<SerializedPage>> ArbitraryBuffer::getPages(
   return pages;
 }
 
+void ArbitraryBuffer::spillPages(const SpillPageCallback& spillPage) {
+  for (auto it = pages_.rbegin(); it != pages_.rend(); ++it) {
+    if (*it != nullptr && !spillPage(*it)) {
+      return;
+    }
+  }
+}
+
 std::string ArbitraryBuffer::toString() const {
   return fmt::format(
       "[ARBITRARY_BUFFER PAGES[{}] NO MORE DATA[{}]]",
@@ -62,7 +155,7 @@ std::string ArbitraryBuffer::toString() const {
       hasNoMoreData());
 }
 
-std::vector<std::unique_ptr<folly::IOBuf>> DestinationBuffer::getData(
+FetchedPages DestinationBuffer::getData(
     uint64_t maxBytes,
     int64_t sequence,
     DataAvailableCallback notify,
@@ -89,16 +182,16 @@ std::vector<std::unique_ptr<folly::IOBuf>> DestinationBuffer::getData(
     return {};
   }
 
-  std::vector<std::unique_ptr<folly::IOBuf>> result;
+  FetchedPages result;
   uint64_t resultBytes = 0;
   for (auto i = sequence - sequence_; i < data_.size(); ++i) {
     // nullptr is used as end marker
     if (data_[i] == nullptr) {
       VELOX_CHECK_EQ(i, data_.size() - 1, "null marker found in the middle");
-      result.push_back(nullptr);
+      result.add(nullptr);
       break;
     }
-    result.push_back(data_[i]->getIOBuf());
+    result.add(data_[i]);
     resultBytes += data_[i]->size();
     if (resultBytes >= maxBytes) {
       break;
@@ -130,6 +223,14 @@ DataAvailable DestinationBuffer::getAndClearNotify() {
   return result;
 }
 
+void DestinationBuffer::spillPages(const SpillPageCallback& spillPage) {
+  for (auto it = data_.rbegin(); it != data_.rend(); ++it) {
+    if (*it != nullptr && !spillPage(*it)) {
+      return;
+    }
+  }
+}
+
 void DestinationBuffer::maybeLoadData(ArbitraryBuffer* buffer) {
   VELOX_CHECK(!buffer->empty() || buffer->hasNoMoreData());
   if (notify_ == nullptr) {
@@ -231,6 +332,10 @@ PartitionedOutputBuffer::PartitionedOutputBuffer(
       continueSize_((maxSize_ * kContinuePct) / 100),
       arbitraryBuffer_(
           isArbitrary() ? std::make_unique<ArbitraryBuffer>() : nullptr),
+      spillEnabled_(
+          task_->queryCtx()->queryConfig().spillEnabled() &&
+          task_->queryCtx()->queryConfig().partitionedOutputSpillEnabled()),
+      maxSpillFileSize_(task_->queryCtx()->queryConfig().maxSpillFileSize()),
       numDrivers_(numDrivers) {
   buffers_.reserve(numDestinations);
   for (int i = 0; i < numDestinations; i++) {
@@ -313,6 +418,7 @@ bool PartitionedOutputBuffer::enqueue(
   VELOX_CHECK(
       task_->isRunning(), "Task is terminated, cannot add data to output.");
   std::vector<DataAvailable> dataAvailableCallbacks;
+  std::vector<std::shared_ptr<SerializedPage>> spillPages;
   bool blocked = false;
   {
     std::lock_guard<std::mutex> l(mutex_);
@@ -336,7 +442,10 @@ bool PartitionedOutputBuffer::enqueue(
         VELOX_UNREACHABLE(PartitionedOutputNode::kindString(kind_));
     }
 
-    if (totalSize_ > maxSize_ && future) {
+    if (totalSize_ > maxSize_) {
+      spillPages = pickSpillPagesLocked();
+    }
+    if (totalSize_ - spillingBytes_ > maxSize_ && future) {
       promises_.emplace_back("PartitionedOutputBuffer::enqueue");
       *future = promises_.back().getSemiFuture();
       blocked = true;
@@ -347,6 +456,7 @@ bool PartitionedOutputBuffer::enqueue(
   for (auto& callback : dataAvailableCallbacks) {
     callback.notify();
   }
+  spill(std::move(spillPages));
 
   return blocked;
 }
@@ -358,6 +468,10 @@ void PartitionedOutputBuffer::enqueueBroadcastOutputLocked(
   VELOX_CHECK_NULL(arbitraryBuffer_);
   VELOX_DCHECK(dataAvailableCbs.empty());
 
+  // All destinations share one page. getData() hands out IOBuf clones of it,
+  // so the serialized bytes exist once however many destinations there are.
+  // The page counts once towards 'totalSize_' and is freed when the last
+  // destination acknowledges it.
   std::shared_ptr<SerializedPage> sharedData(data.release());
   for (auto& buffer : buffers_) {
     if (buffer != nullptr) {
@@ -420,6 +534,99 @@ void PartitionedOutputBuffer::enqueuePartitionedOutputLocked(
   }
 }
 
+std::vector<std::shared_ptr<SerializedPage>>
+PartitionedOutputBuffer::pickSpillPagesLocked() {
+  std::vector<std::shared_ptr<SerializedPage>> pages;
+  if (!spillEnabled_ || task_->spillDirectory().empty()) {
+    return pages;
+  }
+  // The picked pages stay in 'totalSize_' until written. Acknowledging them
+  // meanwhile does not change 'totalSize_' since they are marked spilled.
+  auto pickPage = [&](const std::shared_ptr<SerializedPage>& page) {
+    if (totalSize_ - spillingBytes_ <= continueSize_) {
+      return false;
+    }
+    // A broadcast page is shared by all destinations and may have been
+    // picked through another one.
+    if (!page->canSpill()) {
+      return true;
+    }
+    page->startSpill();
+    spillingBytes_ += page->size();
+    pages.push_back(page);
+    return true;
+  };
+
+  if (arbitraryBuffer_ != nullptr) {
+    arbitraryBuffer_->spillPages(pickPage);
+  }
+  for (auto it = dataToBroadcast_.rbegin(); it != dataToBroadcast_.rend();
+       ++it) {
+    if (!pickPage(*it)) {
+      return pages;
+    }
+  }
+  for (auto& buffer : buffers_) {
+    if (buffer != nullptr) {
+      buffer->spillPages(pickPage);
+    }
+  }
+  return pages;
+}
+
+void PartitionedOutputBuffer::spill(
+    std::vector<std::shared_ptr<SerializedPage>> pages) {
+  if (pages.empty()) {
+    return;
+  }
+  TestValue::adjust(
+      "facebook::velox::exec::PartitionedOutputBuffer::spill", this);
+
+  std::shared_ptr<SpilledPageFile> file;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    file = spillFile_;
+  }
+  uint64_t pickedBytes{0};
+  uint64_t writtenBytes{0};
+  for (auto& page : pages) {
+    const auto size = page->size();
+    pickedBytes += size;
+    // The page was acknowledged by all its destinations after it was picked.
+    if (page.use_count() == 1) {
+      continue;
+    }
+    if (file == nullptr ||
+        (maxSpillFileSize_ > 0 && file->size() >= maxSpillFileSize_)) {
+      file = std::make_shared<SpilledPageFile>(fmt::format(
+          "{}/partitioned-output-{}",
+          task_->spillDirectory(),
+          numSpillFiles_++));
+    }
+    const auto offset = file->write(*page->getIOBuf());
+    page->setSpilled(
+        [file, offset, size]() { return file->read(offset, size); });
+    writtenBytes += size;
+  }
+
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    spillFile_ = std::move(file);
+    totalSize_ -= pickedBytes;
+    spillingBytes_ -= pickedBytes;
+    spilledBytes_ += writtenBytes;
+    if (totalSize_ < continueSize_) {
+      promises = std::move(promises_);
+    }
+  }
+  // Frees the pages acknowledged while being written outside of 'mutex_'.
+  pages.clear();
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+}
+
 void PartitionedOutputBuffer::noMoreData() {
   // Increment number of finished drivers.
   checkIfDone(true);
@@ -488,6 +695,16 @@ bool PartitionedOutputBuffer::isFinishedLocked() {
   return true;
 }
 
+bool PartitionedOutputBuffer::consumersFinished() {
+  std::lock_guard<std::mutex> l(mutex_);
+  // Destinations of a broadcast or arbitrary buffer can be added until
+  // noMoreBuffers_ is set.
+  if (!isPartitioned() && !noMoreBuffers_) {
+    return false;
+  }
+  return isFinishedLocked();
+}
+
 void PartitionedOutputBuffer::acknowledge(int destination, int64_t sequence) {
   std::vector<std::shared_ptr<SerializedPage>> freed;
   std::vector<ContinuePromise> promises;
@@ -511,7 +728,9 @@ void PartitionedOutputBuffer::updateAfterAcknowledgeLocked(
     std::vector<ContinuePromise>& promises) {
   uint64_t totalFreed = 0;
   for (const auto& free : freed) {
-    if (free.unique()) {
+    // Spilled pages no longer count towards 'totalSize_'. The ones being
+    // written are subtracted by spill().
+    if (free.use_count() == 1 && !free->isSpilled()) {
       totalFreed += free->size();
     }
   }
@@ -572,7 +791,7 @@ void PartitionedOutputBuffer::getData(
     uint64_t maxBytes,
     int64_t sequence,
     DataAvailableCallback notify) {
-  std::vector<std::unique_ptr<folly::IOBuf>> data;
+  FetchedPages data;
   std::vector<std::shared_ptr<SerializedPage>> freed;
   std::vector<ContinuePromise> promises;
   {
@@ -594,8 +813,9 @@ void PartitionedOutputBuffer::getData(
     data = buffer->getData(maxBytes, sequence, notify, arbitraryBuffer_.get());
   }
   releaseAfterAcknowledge(freed, promises);
+  // Spilled pages are read outside of mutex_.
   if (!data.empty()) {
-    notify(std::move(data), sequence);
+    notify(data.load(), sequence);
   }
 }
 
@@ -620,6 +840,7 @@ std::string PartitionedOutputBuffer::toString() {
 std::string PartitionedOutputBuffer::toStringLocked() const {
   std::stringstream out;
   out << "[PartitionedOutputBuffer[" << kind_ << "] totalSize_=" << totalSize_
+      << "b, spilled=" << spilledBytes_
       << "b, num producers blocked=" << promises_.size()
       << ", completed=" << numFinished_ << "/" << numDrivers_ << ", "
       << (atEnd_ ? "at end, " : "") << "destinations: " << std::endl;
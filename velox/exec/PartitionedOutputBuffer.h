@@ -20,6 +20,11 @@
 
 namespace facebook::velox::exec {
 
+/// Called on buffered pages, newest first, to pick the ones to move out of
+/// memory. Returns false to stop.
+using SpillPageCallback =
+    std::function<bool(const std::shared_ptr<SerializedPage>& page)>;
+
 /// nullptr in pages indicates that there is no more data.
 /// sequence is the same as specified in BufferManager::getData call. The
 /// caller is expected to advance sequence by the number of entries in groups
@@ -27,14 +32,35 @@ namespace facebook::velox::exec {
 using DataAvailableCallback = std::function<
     void(std::vector<std::unique_ptr<folly::IOBuf>> pages, int64_t sequence)>;
 
+/// The pages returned by DestinationBuffer::getData(). The pages in memory are
+/// cloned when added, under the lock of the output buffer. The spilled pages
+/// are read back by load(), after the lock is released.
+class FetchedPages {
+ public:
+  /// Adds 'page', or the end marker if 'page' is nullptr.
+  void add(const std::shared_ptr<SerializedPage>& page);
+
+  bool empty() const {
+    return iobufs_.empty();
+  }
+
+  /// Returns the data of the pages, reading the spilled ones from disk.
+  std::vector<std::unique_ptr<folly::IOBuf>> load();
+
+ private:
+  std::vector<std::unique_ptr<folly::IOBuf>> iobufs_;
+  // The spilled page for each entry of 'iobufs_', nullptr if in memory.
+  std::vector<std::shared_ptr<SerializedPage>> spilledPages_;
+};
+
 struct DataAvailable {
   DataAvailableCallback callback;
   int64_t sequence;
-  std::vector<std::unique_ptr<folly::IOBuf>> data;
+  FetchedPages data;
 
   void notify() {
     if (callback) {
-      callback(std::move(data), sequence);
+      callback(data.load(), sequence);
     }
   }
 };
@@ -68,6 +94,8 @@ class ArbitraryBuffer {
   /// there are sufficient buffered pages.
   std::vector<std::shared_ptr<SerializedPage>> getPages(uint64_t maxBytes);
 
+  void spillPages(const SpillPageCallback& spillPage);
+
   std::string toString() const;
 
  private:
@@ -91,9 +119,10 @@ class DestinationBuffer {
   void loadData(ArbitraryBuffer* buffer, uint64_t maxBytes);
 
   // Returns a shallow copy (folly::IOBuf::clone) of the data starting at
-  // 'sequence', stopping after exceeding 'maxBytes'. If there is no data,
-  // 'notify' is installed so that this gets called when data is added.
-  std::vector<std::unique_ptr<folly::IOBuf>> getData(
+  // 'sequence', stopping after exceeding 'maxBytes'. The spilled pages are
+  // read by FetchedPages::load(). If there is no data, 'notify' is installed
+  // so that this gets called when data is added.
+  FetchedPages getData(
       uint64_t maxBytes,
       int64_t sequence,
       DataAvailableCallback notify,
@@ -114,6 +143,10 @@ class DestinationBuffer {
   // the callback.
   DataAvailable getAndClearNotify();
 
+  // Calls 'spillPage' on the pages not yet fetched or acknowledged, newest
+  // first, because the oldest are the next to be fetched.
+  void spillPages(const SpillPageCallback& spillPage);
+
   std::string toString();
 
  private:
@@ -127,6 +160,7 @@ class DestinationBuffer {
 };
 
 class Task;
+class SpilledPageFile;
 
 class PartitionedOutputBuffer {
  public:
@@ -164,6 +198,11 @@ class PartitionedOutputBuffer {
 
   bool isFinishedLocked();
 
+  // Returns true if all destinations have been deleted and no more can be
+  // added, so that the producers can stop before all their input is
+  // processed.
+  bool consumersFinished();
+
   void acknowledge(int destination, int64_t sequence);
 
   // Deletes all data for 'destination'. Returns true if all
@@ -191,6 +230,11 @@ class PartitionedOutputBuffer {
   // producers.
   bool isOverutilized() const;
 
+  // Returns the bytes of the pages written to disk so far.
+  uint64_t spilledBytes() const {
+    return spilledBytes_;
+  }
+
  private:
   // Percentage of maxSize below which a blocked producer should
   // be unblocked.
@@ -224,6 +268,17 @@ class PartitionedOutputBuffer {
       std::unique_ptr<SerializedPage> data,
       std::vector<DataAvailable>& dataAvailableCbs);
 
+  // Picks buffered pages to write to disk until 'totalSize_' minus the bytes
+  // being written is below 'continueSize_', so that producers do not block on
+  // slow consumers. Returns no pages if spilling is disabled or the task has
+  // no spill directory.
+  std::vector<std::shared_ptr<SerializedPage>> pickSpillPagesLocked();
+
+  // Writes 'pages' from pickSpillPagesLocked() to disk and frees their
+  // memory. Runs outside of 'mutex_', which is taken only to update the
+  // sizes, so that producers and consumers do not wait for the disk.
+  void spill(std::vector<std::shared_ptr<SerializedPage>> pages);
+
   std::string toStringLocked() const;
 
   FOLLY_ALWAYS_INLINE bool isBroadcast() const {
@@ -247,6 +302,10 @@ class PartitionedOutputBuffer {
   // resumed.
   const uint64_t continueSize_;
   const std::unique_ptr<ArbitraryBuffer> arbitraryBuffer_;
+  // True if pages are spilled instead of blocking the producers.
+  const bool spillEnabled_;
+  // Max size of a spill file. 0 means no limit.
+  const uint64_t maxSpillFileSize_;
 
   // Total number of drivers expected to produce results. This number will
   // decrease in the end of grouped execution, when we understand the real
@@ -265,6 +324,8 @@ class PartitionedOutputBuffer {
   std::mutex mutex_;
   // Actual data size in 'buffers_'.
   uint64_t totalSize_ = 0;
+  // Bytes of the pages in 'totalSize_' that are being written to disk.
+  uint64_t spillingBytes_{0};
   std::vector<ContinuePromise> promises_;
   // The next buffer index in 'buffers_' to load data from arbitrary buffer
   // which is only used by arbitrary output type.
@@ -275,6 +336,11 @@ class PartitionedOutputBuffer {
   // When this reaches buffers_.size(), 'this' can be freed.
   int numFinalAcknowledges_ = 0;
   bool atEnd_ = false;
+  // The file being spilled to. Each spilled page holds a reference to its
+  // file, which is deleted when the last of its pages is freed.
+  std::shared_ptr<SpilledPageFile> spillFile_;
+  std::atomic<int32_t> numSpillFiles_{0};
+  uint64_t spilledBytes_{0};
 };
 
 } // namespace facebook::velox::exec
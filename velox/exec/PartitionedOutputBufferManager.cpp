@@ -63,6 +63,12 @@ bool PartitionedOutputBufferManager::isFinished(const std::string& taskId) {
   return getBuffer(taskId)->isFinished();
 }
 
+bool PartitionedOutputBufferManager::consumersFinished(
+    const std::string& taskId) {
+  auto buffer = getBufferIfExists(taskId);
+  return buffer != nullptr && buffer->consumersFinished();
+}
+
 void PartitionedOutputBufferManager::acknowledge(
     const std::string& taskId,
     int destination,
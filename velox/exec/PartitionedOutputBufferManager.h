@@ -53,6 +53,11 @@ class PartitionedOutputBufferManager {
   // have been fetched and acknowledged.
   bool isFinished(const std::string& taskId);
 
+  // Returns true if the consumers of all destinations of the buffer for
+  // 'taskId' have deleted their results, so that no more output is needed,
+  // e.g. after a limit downstream. Returns false if there is no such buffer.
+  bool consumersFinished(const std::string& taskId);
+
   // Removes data with sequence number < 'sequence' from the queue for
   // 'destination_'.
   void
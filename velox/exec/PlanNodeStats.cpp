@@ -46,6 +46,7 @@ void PlanNodeStats::addTotals(const OperatorStats& stats) {
   cpuWallTiming.add(stats.addInputTiming);
   cpuWallTiming.add(stats.getOutputTiming);
   cpuWallTiming.add(stats.finishTiming);
+  hardwareCounters.add(stats.hardwareCounters);
 
   blockedWallNanos += stats.blockedWallNanos;
 
@@ -94,6 +95,13 @@ std::string PlanNodeStats::toString(bool includeInputStats) const {
       << ", Peak memory: " << succinctBytes(peakMemoryBytes)
       << ", Memory allocations: " << numMemoryAllocations;
 
+  if (!hardwareCounters.empty()) {
+    out << ", Cycles: " << hardwareCounters.cycles
+        << ", Instructions: " << hardwareCounters.instructions
+        << ", LLC misses: " << hardwareCounters.llcMisses
+        << ", Branch misses: " << hardwareCounters.branchMisses;
+  }
+
   if (numDrivers > 0) {
     out << ", Threads: " << numDrivers;
   }
@@ -142,6 +150,10 @@ folly::dynamic toPlanStatsJson(const facebook::velox::exec::TaskStats& stats) {
       stat["outputVectors"] = operatorStat.second->outputVectors;
       stat["outputBytes"] = operatorStat.second->outputBytes;
       stat["cpuWallTiming"] = operatorStat.second->cpuWallTiming.toString();
+      if (!operatorStat.second->hardwareCounters.empty()) {
+        stat["hardwareCounters"] =
+            operatorStat.second->hardwareCounters.toString();
+      }
       stat["blockedWallNanos"] = operatorStat.second->blockedWallNanos;
       stat["peakMemoryBytes"] = operatorStat.second->peakMemoryBytes;
       stat["numMemoryAllocations"] = operatorStat.second->numMemoryAllocations;
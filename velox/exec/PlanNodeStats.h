@@ -78,6 +78,10 @@ struct PlanNodeStats {
   /// up.
   CpuWallTiming cpuWallTiming;
 
+  /// Sum of the hardware counters of all operators. All zeros unless
+  /// QueryConfig::kOperatorTrackHardwareCounters is set.
+  process::HardwareCounters hardwareCounters;
+
   /// Sum of blocked wall time for all corresponding operators.
   uint64_t blockedWallNanos{0};
 
@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/PrefixSort.h"
+
+#include <folly/lang/Bits.h>
+
+namespace facebook::velox::exec {
+
+namespace {
+
+// A row pointer with the encoded prefix of its keys as two words that compare
+// in the same order as the prefix bytes.
+struct PrefixEntry {
+  uint64_t prefix[2];
+  char* row;
+};
+
+// Returns the number of bytes for the value of a key of 'kind' or 0 if
+// there is no fixed width prefix encoding for 'kind'.
+int32_t fixedValueBytes(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+      return 1;
+    case TypeKind::SMALLINT:
+      return 2;
+    case TypeKind::INTEGER:
+    case TypeKind::REAL:
+      return 4;
+    case TypeKind::BIGINT:
+    case TypeKind::DOUBLE:
+      return 8;
+    default:
+      return 0;
+  }
+}
+
+// Writes the low 'numBytes' bytes of 'value' to 'out', most significant first.
+inline void storeBigEndian(uint64_t value, int32_t numBytes, uint8_t* out) {
+  for (auto i = numBytes - 1; i >= 0; --i) {
+    out[i] = value & 0xff;
+    value >>= 8;
+  }
+}
+
+// Maps a signed integer to an unsigned one with the same order.
+template <typename T>
+inline uint64_t encodeSigned(T value) {
+  using U = std::make_unsigned_t<T>;
+  return static_cast<U>(value) ^ (static_cast<U>(1) << (sizeof(T) * 8 - 1));
+}
+
+// Maps a float or double to an unsigned integer with the order of
+// RowContainer::comparePrimitiveAsc: -0.0 is equal to 0.0 and all NaNs are
+// equal and larger than any other value.
+template <typename T, typename U>
+inline uint64_t encodeFloatingPoint(T value) {
+  constexpr U kSignBit = static_cast<U>(1) << (sizeof(T) * 8 - 1);
+  if (std::isnan(value)) {
+    return std::numeric_limits<U>::max();
+  }
+  if (value == 0) {
+    return kSignBit;
+  }
+  U bits;
+  memcpy(&bits, &value, sizeof(T));
+  return (bits & kSignBit) ? ~bits : bits | kSignBit;
+}
+} // namespace
+
+// static
+std::vector<PrefixSort::KeyEncoding> PrefixSort::makeEncodings(
+    const RowContainer& container,
+    const std::vector<CompareFlags>& compareFlags,
+    int32_t& numFullyEncoded) {
+  std::vector<KeyEncoding> encodings;
+  numFullyEncoded = 0;
+  const auto& keyTypes = container.keyTypes();
+  int32_t offset = 0;
+  for (auto i = 0; i < keyTypes.size(); ++i) {
+    const auto kind = keyTypes[i]->kind();
+    const auto column = container.columnAt(i);
+    const bool nullable = column.nullMask() != 0;
+    const int32_t nullBytes = nullable ? 1 : 0;
+    const auto flags = compareFlags.empty() ? CompareFlags() : compareFlags[i];
+    const auto remaining = kPrefixBytes - offset;
+    if (auto valueBytes = fixedValueBytes(kind)) {
+      if (nullBytes + valueBytes > remaining) {
+        break;
+      }
+      encodings.push_back({kind, column, flags, offset, valueBytes, nullable});
+      offset += nullBytes + valueBytes;
+      ++numFullyEncoded;
+      continue;
+    }
+    if ((kind == TypeKind::VARCHAR || kind == TypeKind::VARBINARY) &&
+        remaining > nullBytes) {
+      // A string is truncated to the rest of the prefix. Equal prefixes then
+      // do not imply equal strings, so no key after this one is encoded.
+      encodings.push_back(
+          {kind, column, flags, offset, remaining - nullBytes, nullable});
+    }
+    break;
+  }
+  return encodings;
+}
+
+// static
+void PrefixSort::encodeKey(
+    const KeyEncoding& encoding,
+    const char* row,
+    uint8_t* prefix) {
+  auto* out = prefix + encoding.prefixOffset;
+  if (encoding.nullable) {
+    if (RowContainer::isNullAt(
+            row, encoding.column.nullByte(), encoding.column.nullMask())) {
+      // Nulls go before or after all values regardless of the sort order.
+      *out = encoding.flags.nullsFirst ? 0 : 2;
+      return;
+    }
+    *out++ = 1;
+  }
+
+  const auto* value = row + encoding.column.offset();
+  switch (encoding.kind) {
+    case TypeKind::BOOLEAN:
+      *out = *reinterpret_cast<const bool*>(value) ? 1 : 0;
+      break;
+    case TypeKind::TINYINT:
+      storeBigEndian(
+          encodeSigned(*reinterpret_cast<const int8_t*>(value)), 1, out);
+      break;
+    case TypeKind::SMALLINT:
+      storeBigEndian(
+          encodeSigned(*reinterpret_cast<const int16_t*>(value)), 2, out);
+      break;
+    case TypeKind::INTEGER:
+      storeBigEndian(
+          encodeSigned(*reinterpret_cast<const int32_t*>(value)), 4, out);
+      break;
+    case TypeKind::BIGINT:
+      storeBigEndian(
+          encodeSigned(*reinterpret_cast<const int64_t*>(value)), 8, out);
+      break;
+    case TypeKind::REAL:
+      storeBigEndian(
+          encodeFloatingPoint<float, uint32_t>(
+              *reinterpret_cast<const float*>(value)),
+          4,
+          out);
+      break;
+    case TypeKind::DOUBLE:
+      storeBigEndian(
+          encodeFloatingPoint<double, uint64_t>(
+              *reinterpret_cast<const double*>(value)),
+          8,
+          out);
+      break;
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY: {
+      std::string storage;
+      auto view = HashStringAllocator::contiguousString(
+          *reinterpret_cast<const StringView*>(value), storage);
+      // Bytes past the end of a shorter string stay 0 so that a string sorts
+      // before its extensions.
+      memcpy(
+          out,
+          view.data(),
+          std::min<int32_t>(view.size(), encoding.valueBytes));
+      break;
+    }
+    default:
+      VELOX_UNREACHABLE();
+  }
+
+  if (!encoding.flags.ascending) {
+    for (auto i = 0; i < encoding.valueBytes; ++i) {
+      out[i] = ~out[i];
+    }
+  }
+}
+
+// static
+void PrefixSort::sort(
+    RowContainer& container,
+    const std::vector<CompareFlags>& compareFlags,
+    folly::Range<char**> rows) {
+  const auto numKeys = container.keyTypes().size();
+  VELOX_DCHECK(compareFlags.empty() || compareFlags.size() == numKeys);
+  auto compareFrom = [&](const char* left, const char* right, int32_t first) {
+    for (auto i = first; i < numKeys; ++i) {
+      if (auto result = container.compare(
+              left,
+              right,
+              i,
+              compareFlags.empty() ? CompareFlags() : compareFlags[i])) {
+        return result;
+      }
+    }
+    return 0;
+  };
+
+  int32_t numFullyEncoded;
+  const auto encodings =
+      makeEncodings(container, compareFlags, numFullyEncoded);
+  if (encodings.empty()) {
+    std::sort(rows.begin(), rows.end(), [&](const char* l, const char* r) {
+      return compareFrom(l, r, 0) < 0;
+    });
+    return;
+  }
+
+  std::vector<PrefixEntry> entries(rows.size());
+  for (auto i = 0; i < rows.size(); ++i) {
+    uint8_t prefix[kPrefixBytes] = {};
+    for (const auto& encoding : encodings) {
+      encodeKey(encoding, rows[i], prefix);
+    }
+    auto& entry = entries[i];
+    entry.prefix[0] =
+        folly::Endian::big(folly::loadUnaligned<uint64_t>(prefix));
+    entry.prefix[1] =
+        folly::Endian::big(folly::loadUnaligned<uint64_t>(prefix + 8));
+    entry.row = rows[i];
+  }
+
+  // Equal prefixes over the fully encoded keys imply equal values for these
+  // keys, so the tie break starts after them.
+  const bool needTieBreak = numFullyEncoded < numKeys;
+  std::sort(
+      entries.begin(),
+      entries.end(),
+      [&](const PrefixEntry& left, const PrefixEntry& right) {
+        if (left.prefix[0] != right.prefix[0]) {
+          return left.prefix[0] < right.prefix[0];
+        }
+        if (left.prefix[1] != right.prefix[1]) {
+          return left.prefix[1] < right.prefix[1];
+        }
+        return needTieBreak &&
+            compareFrom(left.row, right.row, numFullyEncoded) < 0;
+      });
+
+  for (auto i = 0; i < rows.size(); ++i) {
+    rows[i] = entries[i].row;
+  }
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/RowContainer.h"
+
+namespace facebook::velox::exec {
+
+/// Sorts pointers to rows of a RowContainer on the keys of the container.
+/// The leading keys are encoded into a fixed width prefix that compares as
+/// unsigned bytes in the same order as the keys. The prefix is stored next to
+/// each row pointer so that most comparisons touch only the sorted array and
+/// not the rows. The full keys are compared only for rows with equal
+/// prefixes. Keys of types without a prefix encoding are sorted with
+/// RowContainer::compareRows.
+class PrefixSort {
+ public:
+  /// Number of bytes of encoded keys kept next to each row pointer.
+  static constexpr int32_t kPrefixBytes = 16;
+
+  /// Sorts 'rows' from 'container' on all keys of 'container' using
+  /// 'compareFlags'. 'compareFlags' is either empty, meaning the default
+  /// flags for all keys, or has one entry per key.
+  static void sort(
+      RowContainer& container,
+      const std::vector<CompareFlags>& compareFlags,
+      folly::Range<char**> rows);
+
+ private:
+  // Describes how one key is encoded into the prefix.
+  struct KeyEncoding {
+    TypeKind kind;
+    RowColumn column;
+    CompareFlags flags;
+    // Offset of the encoding of the key in the prefix.
+    int32_t prefixOffset;
+    // Number of bytes for the value after the null byte. For strings this is
+    // the number of leading bytes of the value that fit in the prefix.
+    int32_t valueBytes;
+    // True if the key has a null byte in front of the value.
+    bool nullable;
+  };
+
+  // Returns the encodings for the leading keys of 'container' that fit in
+  // 'kPrefixBytes'. Sets 'numFullyEncoded' to the number of leading keys for
+  // which equal prefixes imply equal keys.
+  static std::vector<KeyEncoding> makeEncodings(
+      const RowContainer& container,
+      const std::vector<CompareFlags>& compareFlags,
+      int32_t& numFullyEncoded);
+
+  // Writes the encoding of the key described by 'encoding' for 'row' into
+  // 'prefix'.
+  static void encodeKey(
+      const KeyEncoding& encoding,
+      const char* row,
+      uint8_t* prefix);
+};
+
+} // namespace facebook::velox::exec
@@ -36,6 +36,24 @@ static int32_t typeKindSize(TypeKind kind) {
   return VELOX_DYNAMIC_TYPE_DISPATCH(kindSize, kind);
 }
 
+// Returns true if the values of a dependent column of 'kind' can be stored
+// column-wise.
+bool isColumnarKind(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
 #if defined(__has_feature)
 #if __has_feature(thread_sanitizer)
 __attribute__((__no_sanitize__("thread")))
@@ -65,12 +83,14 @@ Accumulator::Accumulator(
     int32_t fixedSize,
     bool usesExternalMemory,
     int32_t alignment,
-    std::function<void(folly::Range<char**> groups)> destroyFunction)
+    std::function<void(folly::Range<char**> groups)> destroyFunction,
+    SpillFunction spillFunction)
     : isFixedSize_{isFixedSize},
       fixedSize_{fixedSize},
       usesExternalMemory_{usesExternalMemory},
       alignment_{alignment},
-      destroyFunction_{destroyFunction} {}
+      destroyFunction_{destroyFunction},
+      spillFunction_{std::move(spillFunction)} {}
 
 bool Accumulator::isFixedSize() const {
   return isFixedSize_;
@@ -92,6 +112,17 @@ void Accumulator::destroy(folly::Range<char**> groups) {
   destroyFunction_(groups);
 }
 
+void Accumulator::extractForSpill(
+    folly::Range<char**> groups,
+    VectorPtr& result) const {
+  if (aggregate_ != nullptr) {
+    aggregate_->extractAccumulators(groups.data(), groups.size(), &result);
+    return;
+  }
+  VELOX_CHECK(spillFunction_ != nullptr, "Accumulator does not support spill");
+  spillFunction_(groups, result);
+}
+
 // static
 int32_t RowContainer::combineAlignments(int32_t a, int32_t b) {
   VELOX_CHECK_EQ(__builtin_popcount(a), 1, "Alignment can only be power of 2");
@@ -109,7 +140,8 @@ RowContainer::RowContainer(
     bool hasProbedFlag,
     bool hasNormalizedKeys,
     memory::MemoryPool* pool,
-    std::shared_ptr<HashStringAllocator> stringAllocator)
+    std::shared_ptr<HashStringAllocator> stringAllocator,
+    bool columnarDependents)
     : keyTypes_(keyTypes),
       nullableKeys_(nullableKeys),
       isJoinBuild_(isJoinBuild),
@@ -118,7 +150,11 @@ RowContainer::RowContainer(
       rows_(pool),
       stringAllocator_(
           stringAllocator ? stringAllocator
-                          : std::make_shared<HashStringAllocator>(pool)) {
+                          : std::make_shared<HashStringAllocator>(pool)),
+      columnarBlocks_(pool) {
+  VELOX_CHECK(
+      isJoinBuild || !columnarDependents,
+      "Columnar dependents are only supported for hash join build sides");
   // Compute the layout of the payload row.  The row has keys, null
   // flags, accumulators, dependent fields. All fields are fixed
   // width. If variable width data is referenced, this is done with
@@ -135,7 +171,10 @@ RowContainer::RowContainer(
   // length columns or accumulators, i.e. ones that allocate extra space, this
   // space is tracked by a uint32_t after the dependent columns. If this is a
   // hash join build side, the pointer to the next row with the same key is
-  // after the optional row size.
+  // after the optional row size. If 'columnarDependents' is true, the values
+  // of the fixed width dependent columns are not in the row. A word after
+  // the other dependent columns refers to their position in a block of
+  // column-wise values.
   //
   // In most cases, rows are prefixed with a normalized_key_t at index
   // -1, 8 bytes below the pointer. This space is reserved for a 64
@@ -198,10 +237,27 @@ RowContainer::RowContainer(
     offsets_.push_back(offset);
     offset += accumulator.fixedWidthSize();
   }
+  columnarOffsets_.resize(offsets_.size(), -1);
+  std::vector<int32_t> columnarColumns;
   for (auto& type : dependentTypes) {
+    if (columnarDependents && isColumnarKind(type->kind())) {
+      columnarColumns.push_back(offsets_.size());
+      offsets_.push_back(0);
+      columnarOffsets_.push_back(columnarRowSize_ * kColumnarBlockRows);
+      columnarRowSize_ += typeKindSize(type->kind());
+      continue;
+    }
     offsets_.push_back(offset);
+    columnarOffsets_.push_back(-1);
     offset += typeKindSize(type->kind());
   }
+  if (!columnarColumns.empty()) {
+    columnarSlotOffset_ = offset;
+    offset += sizeof(uint64_t);
+    for (auto column : columnarColumns) {
+      offsets_[column] = columnarSlotOffset_;
+    }
+  }
   if (isVariableWidth) {
     rowSizeOffset_ = offset;
     offset += sizeof(uint32_t);
@@ -246,19 +302,49 @@ char* RowContainer::newRow() {
   VELOX_DCHECK(mutable_, "Can't add row into an immutable row container");
   ++numRows_;
   char* row;
+  // A free row keeps its position in the columnar values.
+  uint64_t columnarSlot = 0;
   if (firstFreeRow_) {
     row = firstFreeRow_;
     VELOX_CHECK(bits::isBitSet(row, freeFlagOffset_));
     firstFreeRow_ = nextFree(row);
     --numFreeRows_;
+    if (columnarSlotOffset_) {
+      columnarSlot = valueAt<uint64_t>(row, columnarSlotOffset_);
+    }
   } else {
     row = rows_.allocateFixed(fixedRowSize_ + normalizedKeySize_, alignment_) +
         normalizedKeySize_;
     if (normalizedKeySize_) {
       ++numRowsWithNormalizedKey_;
     }
+    if (columnarSlotOffset_) {
+      columnarSlot = newColumnarSlot();
+    }
+  }
+  row = initializeRow(row, false /* reuse */);
+  if (columnarSlotOffset_) {
+    valueAt<uint64_t>(row, columnarSlotOffset_) = columnarSlot;
   }
-  return initializeRow(row, false /* reuse */);
+  return row;
+}
+
+uint64_t RowContainer::newColumnarSlot() {
+  if (numColumnarBlockRows_ == kColumnarBlockRows) {
+    columnarBlock_ = columnarBlocks_.allocateFixed(
+        static_cast<uint64_t>(columnarRowSize_) * kColumnarBlockRows,
+        sizeof(int128_t));
+    // Checked in release builds too. A block above 2^48, e.g. with 5-level
+    // paging or tagged pointers, would make 'columnarValue' read the wrong
+    // memory. Once per block.
+    VELOX_CHECK_EQ(
+        reinterpret_cast<uintptr_t>(columnarBlock_) & ~kColumnarBlockMask,
+        0,
+        "Columnar block address does not fit in 48 bits");
+    numColumnarBlockRows_ = 0;
+  }
+  return reinterpret_cast<uintptr_t>(columnarBlock_) |
+      static_cast<uint64_t>(numColumnarBlockRows_++) << 48;
 }
 
 char* RowContainer::initializeRow(char* row, bool reuse) {
@@ -297,6 +383,46 @@ void RowContainer::eraseRows(folly::Range<char**> rows) {
   numFreeRows_ += rows.size();
 }
 
+bool RowContainer::canCompact() const {
+  if (!mutable_ || nextOffset_ != 0) {
+    return false;
+  }
+  for (const auto& accumulator : accumulators_) {
+    if (!accumulator.isFixedSize() || accumulator.usesExternalMemory()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void RowContainer::compact() {
+  VELOX_CHECK(canCompact(), "RowContainer rows cannot be moved");
+  if (numFreeRows_ == 0) {
+    return;
+  }
+  // Normalized keys are disabled for good once the table leaves the
+  // normalized key mode. Until then all rows have one.
+  VELOX_DCHECK(
+      normalizedKeySize_ == 0 ||
+      numRowsWithNormalizedKey_ == numRows_ + numFreeRows_);
+  const auto rowSize = fixedRowSize_ + normalizedKeySize_;
+  memory::AllocationPool newRows(rows_.pool());
+  newRows.setHugePageThreshold(rows_.hugePageThreshold());
+  constexpr int32_t kBatch = 1000;
+  std::vector<char*> rows(kBatch);
+  RowContainerIterator iter;
+  while (auto numRows = listRows(&iter, kBatch, rows.data())) {
+    for (auto i = 0; i < numRows; ++i) {
+      auto* newRow = newRows.allocateFixed(rowSize, alignment_);
+      memcpy(newRow, rows[i] - normalizedKeySize_, rowSize);
+    }
+  }
+  rows_.swap(newRows);
+  numRowsWithNormalizedKey_ = normalizedKeySize_ == 0 ? 0 : numRows_;
+  firstFreeRow_ = nullptr;
+  numFreeRows_ = 0;
+}
+
 int32_t RowContainer::findRows(folly::Range<char**> rows, char** result) {
   raw_vector<folly::Range<char*>> ranges;
   ranges.resize(rows_.numRanges());
@@ -342,6 +468,10 @@ int32_t RowContainer::findRows(folly::Range<char**> rows, char** result) {
 
 void RowContainer::freeVariableWidthFields(folly::Range<char**> rows) {
   for (auto i = 0; i < types_.size(); ++i) {
+    if (isInterned(i)) {
+      // The interned copies are shared and freed in clear().
+      continue;
+    }
     switch (typeKinds_[i]) {
       case TypeKind::VARCHAR:
       case TypeKind::VARBINARY:
@@ -367,6 +497,56 @@ void RowContainer::freeVariableWidthFields(folly::Range<char**> rows) {
   }
 }
 
+void RowContainer::moveVariableWidthData(
+    folly::Range<char**> rows,
+    HashStringAllocator& allocator) {
+  VELOX_CHECK(
+      !internsStringKeys(), "Cannot move the data of interned string keys");
+  if (rowSizeOffset_ == 0) {
+    return;
+  }
+  std::vector<int32_t> columns;
+  for (auto i = 0; i < types_.size(); ++i) {
+    switch (typeKinds_[i]) {
+      case TypeKind::VARCHAR:
+      case TypeKind::VARBINARY:
+      case TypeKind::ROW:
+      case TypeKind::ARRAY:
+      case TypeKind::MAP:
+        columns.push_back(i);
+        break;
+      default:;
+    }
+  }
+  std::string storage;
+  for (auto* row : rows) {
+    variableRowSize(row) = 0;
+    RowSizeTracker tracker(row[rowSizeOffset_], allocator);
+    for (auto i : columns) {
+      const auto column = columnAt(i);
+      if (isNullAt(row, column.nullByte(), column.nullMask())) {
+        continue;
+      }
+      auto& view = valueAt<StringView>(row, column.offset());
+      if (view.isInline()) {
+        continue;
+      }
+      // Copies from the old allocation, which is freed with the old
+      // allocator.
+      view = HashStringAllocator::contiguousString(view, storage);
+      allocator.copyMultipart(row, column.offset());
+    }
+  }
+}
+
+void RowContainer::setStringAllocator(
+    std::shared_ptr<HashStringAllocator> allocator) {
+  VELOX_CHECK(
+      !internsStringKeys(), "Cannot move the data of interned string keys");
+  VELOX_CHECK_NOT_NULL(allocator);
+  stringAllocator_ = std::move(allocator);
+}
+
 void RowContainer::checkConsistency() {
   constexpr int32_t kBatch = 1000;
   std::vector<char*> rows(kBatch);
@@ -406,6 +586,15 @@ void RowContainer::store(
     char* row,
     int32_t column) {
   auto numKeys = keyTypes_.size();
+  if (isInterned(column)) {
+    storeInterned(decoded, index, row, column);
+    return;
+  }
+  if (isColumnar(column)) {
+    VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+        storeColumnar, typeKinds_[column], decoded, index, row, column);
+    return;
+  }
   if (column < numKeys && !nullableKeys_) {
     VELOX_DYNAMIC_TYPE_DISPATCH(
         storeNoNulls,
@@ -429,6 +618,151 @@ void RowContainer::store(
   }
 }
 
+void RowContainer::internStringKeys() {
+  VELOX_CHECK_EQ(numRows_, 0, "Keys must be interned from the first row");
+  if (internedStrings_) {
+    return;
+  }
+  internedColumns_.resize(keyTypes_.size());
+  for (auto i = 0; i < keyTypes_.size(); ++i) {
+    internedColumns_[i] = typeKinds_[i] == TypeKind::VARCHAR ||
+        typeKinds_[i] == TypeKind::VARBINARY;
+  }
+  internedStrings_ = std::make_unique<InternedStringSet>(
+      AlignedStlAllocator<StringView, 16>(stringAllocator_.get()));
+}
+
+void RowContainer::storeInterned(
+    const DecodedVector& decoded,
+    vector_size_t index,
+    char* row,
+    int32_t column) {
+  auto& value = valueAt<StringView>(row, offsets_[column]);
+  if (decoded.isNullAt(index)) {
+    VELOX_DCHECK(nullableKeys_);
+    const auto rowColumn = rowColumns_[column];
+    row[rowColumn.nullByte()] |= rowColumn.nullMask();
+    value = StringView();
+    return;
+  }
+  value = decoded.valueAt<StringView>(index);
+  if (!value.isInline()) {
+    value = intern(value);
+  }
+}
+
+StringView RowContainer::intern(StringView value) {
+  auto it = internedStrings_->find(value);
+  if (it != internedStrings_->end()) {
+    return *it;
+  }
+  // The copy is in one piece, so that it can be read and extracted without
+  // gathering it from several allocations.
+  auto* header = stringAllocator_->allocate(value.size());
+  memcpy(header->begin(), value.data(), value.size());
+  StringView copy(header->begin(), value.size());
+  internedStrings_->insert(copy);
+  return copy;
+}
+
+void RowContainer::freeInternedStrings() {
+  if (!internedStrings_) {
+    return;
+  }
+  for (const auto& value : *internedStrings_) {
+    stringAllocator_->free(HashStringAllocator::headerOf(value.data()));
+  }
+  // Replaces the set to also free its table.
+  internedStrings_ = std::make_unique<InternedStringSet>(
+      AlignedStlAllocator<StringView, 16>(stringAllocator_.get()));
+}
+
+template <TypeKind Kind>
+void RowContainer::storeColumnar(
+    const DecodedVector& decoded,
+    vector_size_t index,
+    char* row,
+    int32_t columnIndex) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  auto* value = columnarValue<T>(row, columnIndex);
+  if (decoded.isNullAt(index)) {
+    const auto rowColumn = rowColumns_[columnIndex];
+    row[rowColumn.nullByte()] |= rowColumn.nullMask();
+    *value = T();
+    return;
+  }
+  *value = decoded.valueAt<T>(index);
+}
+
+void RowContainer::extractColumnarColumn(
+    const char* const* rows,
+    folly::Range<const vector_size_t*> rowNumbers,
+    int32_t numRows,
+    int32_t columnIndex,
+    int32_t resultOffset,
+    const VectorPtr& result) const {
+  VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+      extractColumnarTyped,
+      typeKinds_[columnIndex],
+      rows,
+      rowNumbers,
+      numRows,
+      columnIndex,
+      resultOffset,
+      result);
+}
+
+template <TypeKind Kind>
+void RowContainer::extractColumnarTyped(
+    const char* const* rows,
+    folly::Range<const vector_size_t*> rowNumbers,
+    int32_t numRows,
+    int32_t columnIndex,
+    int32_t resultOffset,
+    const VectorPtr& result) const {
+  if (rowNumbers.size() > 0) {
+    extractColumnarTypedInternal<true, Kind>(
+        rows, rowNumbers, numRows, columnIndex, resultOffset, result);
+  } else {
+    extractColumnarTypedInternal<false, Kind>(
+        rows, rowNumbers, numRows, columnIndex, resultOffset, result);
+  }
+}
+
+template <bool useRowNumbers, TypeKind Kind>
+void RowContainer::extractColumnarTypedInternal(
+    const char* const* rows,
+    folly::Range<const vector_size_t*> rowNumbers,
+    int32_t numRows,
+    int32_t columnIndex,
+    int32_t resultOffset,
+    const VectorPtr& result) const {
+  using T = typename TypeTraits<Kind>::NativeType;
+  result->resize(numRows + resultOffset);
+  auto* flatResult = result->as<FlatVector<T>>();
+  const auto maxRows = numRows + resultOffset;
+  auto* nulls = flatResult->mutableNulls(maxRows)->asMutable<uint64_t>();
+  auto values = flatResult->mutableValues(maxRows)->asMutableRange<T>();
+  const auto column = rowColumns_[columnIndex];
+  for (auto i = 0; i < numRows; ++i) {
+    const char* row;
+    if constexpr (useRowNumbers) {
+      const auto rowNumber = rowNumbers[i];
+      row = rowNumber >= 0 ? rows[rowNumber] : nullptr;
+    } else {
+      row = rows[i];
+    }
+    const auto resultIndex = resultOffset + i;
+    if (row == nullptr ||
+        isNullAt(row, column.nullByte(), column.nullMask())) {
+      bits::setNull(nulls, resultIndex, true);
+    } else {
+      bits::setNull(nulls, resultIndex, false);
+      values[resultIndex] = *columnarValue<T>(row, columnIndex);
+    }
+  }
+}
+
 void RowContainer::prepareRead(
     const char* row,
     int32_t offset,
@@ -610,6 +944,10 @@ void RowContainer::clear() {
     }
   }
   rows_.clear();
+  columnarBlocks_.clear();
+  columnarBlock_ = nullptr;
+  numColumnarBlockRows_ = kColumnarBlockRows;
+  freeInternedStrings();
   if (!sharedStringAllocator) {
     if (checkFree_) {
       stringAllocator_->checkEmpty();
@@ -675,7 +1013,8 @@ std::optional<int64_t> RowContainer::estimateRowSize() const {
   }
   int64_t freeBytes = rows_.freeBytes() + fixedRowSize_ * numFreeRows_;
   int64_t usedSize = rows_.allocatedBytes() - freeBytes +
-      stringAllocator_->retainedSize() - stringAllocator_->freeSpace();
+      stringAllocator_->retainedSize() - stringAllocator_->freeSpace() +
+      columnarRowSize_ * numRows_;
   int64_t rowSize = usedSize / numRows_;
   VELOX_CHECK_GT(
       rowSize, 0, "Estimated row size of the RowContainer must be positive.");
@@ -691,7 +1030,9 @@ int64_t RowContainer::sizeIncrement(
   int32_t needRows = std::max<int64_t>(0, numRows - numFreeRows_);
   int64_t needBytes =
       std::max<int64_t>(0, variableLengthBytes - stringAllocator_->freeSpace());
-  return bits::roundUp(needRows * fixedRowSize_, kAllocUnit) +
+  return bits::roundUp(
+             needRows * (int64_t)(fixedRowSize_ + columnarRowSize_),
+             kAllocUnit) +
       bits::roundUp(needBytes, kAllocUnit);
 }
 
@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <folly/container/F14Set.h>
+
 #include "velox/common/memory/HashStringAllocator.h"
 #include "velox/common/memory/MemoryAllocator.h"
 #include "velox/core/PlanNode.h"
@@ -29,12 +31,18 @@ class Aggregate;
 
 class Accumulator {
  public:
+  /// Copies the state of 'groups' into 'result' for spilling.
+  using SpillFunction =
+      std::function<void(folly::Range<char**> groups, VectorPtr& result)>;
+
+  /// 'spillFunction' is needed if the containing RowContainer is spilled.
   Accumulator(
       bool isFixedSize,
       int32_t fixedSize,
       bool usesExternalMemory,
       int32_t alignment,
-      std::function<void(folly::Range<char**> groups)> destroyFunction);
+      std::function<void(folly::Range<char**> groups)> destroyFunction,
+      SpillFunction spillFunction = nullptr);
 
   explicit Accumulator(Aggregate* aggregate);
 
@@ -48,11 +56,9 @@ class Accumulator {
 
   void destroy(folly::Range<char**> groups);
 
-  /// Used only for spilling. Do not introduce other usages.
-  Aggregate* aggregateForSpill() const {
-    VELOX_CHECK_NOT_NULL(aggregate_);
-    return aggregate_;
-  }
+  /// Extracts the accumulators of 'groups' into 'result'. Used only for
+  /// spilling. Do not introduce other usages.
+  void extractForSpill(folly::Range<char**> groups, VectorPtr& result) const;
 
  private:
   const bool isFixedSize_;
@@ -60,6 +66,7 @@ class Accumulator {
   const bool usesExternalMemory_;
   const int32_t alignment_;
   std::function<void(folly::Range<char**> groups)> destroyFunction_;
+  SpillFunction spillFunction_;
   Aggregate* aggregate_{nullptr};
 };
 
@@ -210,6 +217,12 @@ class RowContainer {
   /// another RowContainer. this is
   // needed for spilling where the same aggregates are used for
   // reading one container and merging into another.
+  /// 'columnarDependents' stores the values of fixed width scalar dependent
+  /// columns of a hash join build side in column-wise blocks of
+  /// kColumnarBlockRows rows instead of in the rows. The rows keep the null
+  /// flags and a reference to the values. This makes the rows narrower and
+  /// extracting a column touches only the values of that column. See
+  /// isColumnar().
   RowContainer(
       const std::vector<TypePtr>& keyTypes,
       bool nullableKeys,
@@ -220,7 +233,11 @@ class RowContainer {
       bool hasProbedFlag,
       bool hasNormalizedKey,
       memory::MemoryPool* FOLLY_NONNULL pool,
-      std::shared_ptr<HashStringAllocator> stringAllocator = nullptr);
+      std::shared_ptr<HashStringAllocator> stringAllocator = nullptr,
+      bool columnarDependents = false);
+
+  /// Number of rows in a block of values of columnar dependent columns.
+  static constexpr int32_t kColumnarBlockRows = 4096;
 
   // Allocates a new row and initializes possible aggregates to null.
   char* FOLLY_NONNULL newRow();
@@ -251,6 +268,16 @@ class RowContainer {
   // variable length data.
   void eraseRows(folly::Range<char**> rows);
 
+  /// Returns true if compact() can move the rows of 'this'. Rows can be
+  /// moved if no other row points to them and their accumulators are plain
+  /// values that do not allocate memory.
+  bool canCompact() const;
+
+  /// Moves the rows of 'this' into new allocations without the free rows and
+  /// frees the previous allocations. Invalidates all pointers to the rows.
+  /// Needs memory for the rows that are not free while moving them.
+  void compact();
+
   // Copies elements of 'rows' where the char* points to a row inside 'this' to
   // 'result' and returns the number copied. 'result' should have space for
   // 'rows.size()'.
@@ -283,12 +310,46 @@ class RowContainer {
     return stringAllocator_;
   }
 
+  /// Makes the VARCHAR and VARBINARY keys of the rows added after this refer
+  /// to a single copy of each distinct value that is not inline instead of
+  /// each having its own. The copies live until clear(). Two keys that refer
+  /// to the same copy are equal without comparing the contents. Must be
+  /// called before adding rows.
+  void internStringKeys();
+
+  bool internsStringKeys() const {
+    return internedStrings_ != nullptr;
+  }
+
+  /// Copies the out of line key and dependent values of 'rows' into
+  /// 'allocator' and makes 'rows' refer to the copies. Resets the variable
+  /// length size of 'rows' to the size of the copies. Used together with
+  /// setStringAllocator() to compact the variable length data. The caller
+  /// moves the data of the accumulators. Not supported with interned keys.
+  void moveVariableWidthData(
+      folly::Range<char**> rows,
+      HashStringAllocator& allocator);
+
+  /// Replaces the allocator of the variable length data, which must have the
+  /// data of all rows. See moveVariableWidthData().
+  void setStringAllocator(std::shared_ptr<HashStringAllocator> allocator);
+
+  /// Returns the number of distinct interned key values.
+  uint64_t numInternedStrings() const {
+    return internedStrings_ ? internedStrings_->size() : 0;
+  }
+
   // Returns the number of used rows in 'this'. This is the number of
   // rows a RowContainerIterator would access.
   int64_t numRows() const {
     return numRows_;
   }
 
+  /// Returns the number of erased rows that can be reused by newRow().
+  uint64_t numFreeRows() const {
+    return numFreeRows_;
+  }
+
   /// Copies the values at 'col' into 'result' (starting at 'resultOffset')
   /// for the 'numRows' rows pointed to by 'rows'. If a 'row' is null, sets
   /// corresponding row in 'result' to null.
@@ -339,7 +400,7 @@ class RowContainer {
       int32_t numRows,
       int32_t columnIndex,
       const VectorPtr& result) {
-    extractColumn(rows, numRows, columnAt(columnIndex), result);
+    extractColumn(rows, numRows, columnIndex, 0, result);
   }
 
   /// Copies the values at 'columnIndex' into 'result' (starting at
@@ -351,6 +412,11 @@ class RowContainer {
       int32_t columnIndex,
       int32_t resultOffset,
       const VectorPtr& result) {
+    if (isColumnar(columnIndex)) {
+      extractColumnarColumn(
+          rows, {}, numRows, columnIndex, resultOffset, result);
+      return;
+    }
     extractColumn(rows, numRows, columnAt(columnIndex), resultOffset, result);
   }
 
@@ -367,6 +433,16 @@ class RowContainer {
       int32_t columnIndex,
       const vector_size_t resultOffset,
       const VectorPtr& result) {
+    if (isColumnar(columnIndex)) {
+      extractColumnarColumn(
+          rows,
+          rowNumbers,
+          rowNumbers.size(),
+          columnIndex,
+          resultOffset,
+          result);
+      return;
+    }
     extractColumn(
         rows, rowNumbers, columnAt(columnIndex), resultOffset, result);
   }
@@ -561,10 +637,19 @@ class RowContainer {
     normalizedKeySize_ = 0;
   }
 
+  /// Returns the offsets of the column 'index'. The null flag of a columnar
+  /// column is in the row but its value is not. Use the member
+  /// extractColumn() functions for reading these.
   RowColumn columnAt(int32_t index) const {
     return rowColumns_[index];
   }
 
+  /// Returns true if the values of the dependent column 'columnIndex' are
+  /// stored column-wise outside of the rows.
+  bool isColumnar(int32_t columnIndex) const {
+    return columnarSlotOffset_ != 0 && columnarOffsets_[columnIndex] >= 0;
+  }
+
   // Bit offset of the probed flag for a full or right outer join  payload.
   // 0 if not applicable.
   int32_t probedFlagOffset() const {
@@ -593,7 +678,8 @@ class RowContainer {
       uint64_t* FOLLY_NONNULL result);
 
   uint64_t allocatedBytes() const {
-    return rows_.allocatedBytes() + stringAllocator_->retainedSize();
+    return rows_.allocatedBytes() + columnarBlocks_.allocatedBytes() +
+        stringAllocator_->retainedSize();
   }
 
   // Returns the number of fixed size rows that can be allocated
@@ -768,6 +854,59 @@ class RowContainer {
     return *reinterpret_cast<uint32_t*>(row + rowSizeOffset_);
   }
 
+  // Returns the address of the value of the columnar column 'columnIndex' of
+  // 'row'. The row refers to its position in a block of columnar values by a
+  // word with the address of the block in the low 48 bits and the row's index
+  // in the block in the high 16 bits. newColumnarSlot() checks that the block
+  // address fits. A block number would not do: the rows of the peer tables of
+  // a parallel join build are read through the first table's container.
+  template <typename T>
+  T* columnarValue(const char* FOLLY_NONNULL row, int32_t columnIndex) const {
+    const auto slot = valueAt<uint64_t>(row, columnarSlotOffset_);
+    auto* block = reinterpret_cast<char*>(slot & kColumnarBlockMask);
+    return reinterpret_cast<T*>(block + columnarOffsets_[columnIndex]) +
+        (slot >> 48);
+  }
+
+  // Returns a reference to the next free position in the current block of
+  // columnar values. Starts a new block if the current one is full.
+  uint64_t newColumnarSlot();
+
+  // Copies the values of the columnar column 'columnIndex' of 'rows' into
+  // 'result'. 'rowNumbers' is as in extractColumn().
+  void extractColumnarColumn(
+      const char* FOLLY_NONNULL const* FOLLY_NONNULL rows,
+      folly::Range<const vector_size_t*> rowNumbers,
+      int32_t numRows,
+      int32_t columnIndex,
+      int32_t resultOffset,
+      const VectorPtr& result) const;
+
+  template <TypeKind Kind>
+  void extractColumnarTyped(
+      const char* FOLLY_NONNULL const* FOLLY_NONNULL rows,
+      folly::Range<const vector_size_t*> rowNumbers,
+      int32_t numRows,
+      int32_t columnIndex,
+      int32_t resultOffset,
+      const VectorPtr& result) const;
+
+  template <bool useRowNumbers, TypeKind Kind>
+  void extractColumnarTypedInternal(
+      const char* FOLLY_NONNULL const* FOLLY_NONNULL rows,
+      folly::Range<const vector_size_t*> rowNumbers,
+      int32_t numRows,
+      int32_t columnIndex,
+      int32_t resultOffset,
+      const VectorPtr& result) const;
+
+  template <TypeKind Kind>
+  void storeColumnar(
+      const DecodedVector& decoded,
+      vector_size_t index,
+      char* FOLLY_NONNULL row,
+      int32_t columnIndex);
+
   template <TypeKind Kind>
   inline void storeWithNulls(
       const DecodedVector& decoded,
@@ -998,6 +1137,11 @@ class RowContainer {
     if (Kind == TypeKind::VARCHAR || Kind == TypeKind::VARBINARY) {
       auto leftValue = valueAt<StringView>(left, leftOffset);
       auto rightValue = valueAt<StringView>(right, rightOffset);
+      if (!leftValue.isInline() && leftValue.data() == rightValue.data() &&
+          leftValue.size() == rightValue.size()) {
+        // Both refer to the same copy, e.g. an interned key.
+        return 0;
+      }
       auto result = compareStringAsc(leftValue, rightValue);
       return flags.ascending ? result : result * -1;
     }
@@ -1110,6 +1254,25 @@ class RowContainer {
   // Free any variable-width fields associated with the 'rows'.
   void freeVariableWidthFields(folly::Range<char**> rows);
 
+  bool isInterned(int32_t column) const {
+    return column < internedColumns_.size() && internedColumns_[column];
+  }
+
+  // Stores the 'index'th value of 'decoded' into the interned key column
+  // 'column' of 'row'.
+  void storeInterned(
+      const DecodedVector& decoded,
+      vector_size_t index,
+      char* FOLLY_NONNULL row,
+      int32_t column);
+
+  // Returns the interned copy of 'value', which is not inline. Makes the
+  // copy if there is none.
+  StringView intern(StringView value);
+
+  // Frees the interned copies.
+  void freeInternedStrings();
+
   // Free any aggregates associated with the 'rows'.
   void freeAggregates(folly::Range<char**> rows);
 
@@ -1171,6 +1334,36 @@ class RowContainer {
   memory::AllocationPool rows_;
   std::shared_ptr<HashStringAllocator> stringAllocator_;
 
+  using InternedStringSet = folly::F14FastSet<
+      StringView,
+      folly::hasher<StringView>,
+      std::equal_to<StringView>,
+      AlignedStlAllocator<StringView, 16>>;
+
+  // The single copies of the interned key values, allocated from
+  // 'stringAllocator_'. nullptr if keys are not interned. Declared after
+  // 'stringAllocator_' so that it is destroyed first.
+  std::unique_ptr<InternedStringSet> internedStrings_;
+  // True for the key columns whose values are interned.
+  std::vector<bool> internedColumns_;
+
+  static constexpr uint64_t kColumnarBlockMask = (1UL << 48) - 1;
+
+  // Offset of the reference to the columnar values of the row. 0 if no
+  // column is columnar.
+  int32_t columnarSlotOffset_ = 0;
+  // Offset of the values of each column in a block of columnar values. -1
+  // for the columns stored in the rows. Corresponds pairwise to
+  // 'rowColumns_'.
+  std::vector<int32_t> columnarOffsets_;
+  // Bytes of the values of all columnar columns for one row.
+  int32_t columnarRowSize_ = 0;
+  // The block new rows get their columnar values from and the number of rows
+  // that have a position in it.
+  char* FOLLY_NULLABLE columnarBlock_ = nullptr;
+  int32_t numColumnarBlockRows_ = kColumnarBlockRows;
+  memory::AllocationPool columnarBlocks_;
+
   int alignment_ = 1;
 };
 
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/RowNumber.h"
+#include "velox/exec/OperatorUtils.h"
 
 namespace facebook::velox::exec {
 
@@ -26,10 +27,14 @@ RowNumber::RowNumber(
           rowNumberNode->outputType(),
           operatorId,
           rowNumberNode->id(),
-          "RowNumber"),
+          "RowNumber",
+          rowNumberNode->canSpill(driverCtx->queryConfig())
+              ? driverCtx->makeSpillConfig(operatorId)
+              : std::nullopt),
       limit_{rowNumberNode->limit()},
-      generateRowNumber_{rowNumberNode->generateRowNumber()} {
-  const auto& inputType = rowNumberNode->sources()[0]->outputType();
+      generateRowNumber_{rowNumberNode->generateRowNumber()},
+      inputType_{rowNumberNode->sources()[0]->outputType()} {
+  const auto& inputType = inputType_;
   const auto& keys = rowNumberNode->partitionKeys();
   const auto numKeys = keys.size();
 
@@ -47,6 +52,19 @@ RowNumber::RowNumber(
 
     const auto numRowsColumn = table_->rows()->columnAt(numKeys);
     numRowsOffset_ = numRowsColumn.offset();
+
+    std::vector<std::string> names;
+    std::vector<TypePtr> types;
+    names.reserve(numKeys + 1);
+    types.reserve(numKeys + 1);
+    for (const auto& hasher : table_->hashers()) {
+      keyChannels_.push_back(hasher->channel());
+      names.push_back(inputType->nameOf(hasher->channel()));
+      types.push_back(hasher->type());
+    }
+    names.push_back("numRows");
+    types.push_back(BIGINT());
+    tableType_ = ROW(std::move(names), std::move(types));
   }
 
   identityProjections_.reserve(inputType->size());
@@ -61,9 +79,25 @@ RowNumber::RowNumber(
 }
 
 void RowNumber::addInput(RowVectorPtr input) {
+  if (table_) {
+    ensureInputFits(input);
+    if (inputSpiller_ != nullptr) {
+      spillInput(input);
+      return;
+    }
+  }
+
+  addInputInternal(std::move(input));
+}
+
+void RowNumber::addInputInternal(RowVectorPtr input) {
   const auto numInput = input->size();
 
   if (table_) {
+    // Prevents the memory arbitrator to reclaim memory from this operator
+    // during the execution below.
+    NonReclaimableSection guard(this);
+
     SelectivityVector rows(numInput);
     table_->prepareForProbe(*lookup_, input, rows, false);
     table_->groupProbe(*lookup_);
@@ -77,6 +111,218 @@ void RowNumber::addInput(RowVectorPtr input) {
   input_ = std::move(input);
 }
 
+void RowNumber::noMoreInput() {
+  Operator::noMoreInput();
+
+  if (inputSpiller_ == nullptr) {
+    return;
+  }
+
+  spiller_->finishSpill(spillHashTablePartitionSet_);
+  inputSpiller_->finishSpill(spillInputPartitionSet_);
+  recordSpillStats(spiller_->stats());
+  recordSpillStats(inputSpiller_->stats());
+  spiller_.reset();
+  inputSpiller_.reset();
+
+  restoreNextSpillPartition();
+}
+
+void RowNumber::ensureInputFits(const RowVectorPtr& input) {
+  // Check if spilling is enabled or not.
+  if (!spillConfig_.has_value() || inputSpiller_ != nullptr) {
+    return;
+  }
+
+  if (shouldSpillToFitInput(
+          *table_->rows(),
+          input->size(),
+          input->estimateFlatSize(),
+          table_->hashTableSizeIncrease(input->size()),
+          spillConfig_.value(),
+          spillTestCounter_,
+          pool())) {
+    spill();
+  }
+}
+
+void RowNumber::reclaim(uint64_t /*targetBytes*/) {
+  VELOX_CHECK(canReclaim());
+
+  // NOTE: a row number operator is reclaimable if it hasn't started to
+  // restore the spilled partitions and is not under non-reclaimable execution
+  // section.
+  if (noMoreInput_ || nonReclaimableSection_) {
+    LOG(WARNING) << "Can't reclaim from row number operator, noMoreInput_["
+                 << noMoreInput_ << "], nonReclaimableSection_["
+                 << nonReclaimableSection_ << "], " << toString();
+    return;
+  }
+
+  if (inputSpiller_ != nullptr || table_->numDistinct() == 0) {
+    // Already spilled or nothing to spill.
+    return;
+  }
+
+  spill();
+  if (input_ != nullptr) {
+    // The row counts of the pending input have not been updated yet, so it
+    // can be processed after the restore of its spilled partitions.
+    spillInput(input_);
+    input_ = nullptr;
+  }
+  // Release the minimum reserved memory.
+  pool()->release();
+}
+
+void RowNumber::spill() {
+  VELOX_CHECK_NULL(spiller_);
+  VELOX_CHECK_NULL(inputSpiller_);
+
+  ++numSpillRuns_;
+  const auto& spillConfig = spillConfig_.value();
+  const HashBitRange hashBits(
+      spillConfig.startPartitionBit,
+      spillConfig.startPartitionBit + spillConfig.aggregationPartitionBits);
+  spiller_ = std::make_unique<Spiller>(
+      Spiller::Type::kHashJoinBuild,
+      table_->rows(),
+      [&](folly::Range<char**> rows) { table_->erase(rows); },
+      tableType_,
+      hashBits,
+      keyChannels_.size(),
+      std::vector<CompareFlags>(),
+      spillConfig.filePath,
+      spillConfig.maxFileSize,
+      spillConfig.minSpillRunSize,
+      spillConfig.compressionKind,
+      Spiller::pool(),
+      spillConfig.executor,
+      spillConfig.extraFilePaths);
+  std::vector<Spiller::SpillableStats> spillableStats(
+      hashBits.numPartitions());
+  spiller_->fillSpillRuns(spillableStats);
+  spiller_->spill();
+  VELOX_CHECK(spiller_->isAllSpilled());
+  table_->clear();
+
+  inputSpiller_ = std::make_unique<Spiller>(
+      Spiller::Type::kHashJoinProbe,
+      inputType_,
+      hashBits,
+      spillConfig.filePath,
+      spillConfig.maxFileSize,
+      spillConfig.minSpillRunSize,
+      spillConfig.compressionKind,
+      Spiller::pool(),
+      spillConfig.executor,
+      spillConfig.extraFilePaths);
+  inputSpiller_->setPartitionsSpilled(spiller_->spilledPartitionSet());
+  spillHashFunction_ = std::make_unique<HashPartitionFunction>(
+      hashBits, inputType_, keyChannels_);
+}
+
+void RowNumber::spillInput(const RowVectorPtr& input) {
+  const auto numInput = input->size();
+  std::vector<uint32_t> spillPartitions(numInput);
+  spillHashFunction_->partition(*input, spillPartitions);
+
+  const auto numPartitions = spillHashFunction_->numPartitions();
+  std::vector<BufferPtr> partitionIndices(numPartitions);
+  std::vector<vector_size_t*> rawPartitionIndices(numPartitions);
+  std::vector<vector_size_t> numPartitionInputs(numPartitions, 0);
+  for (auto row = 0; row < numInput; ++row) {
+    const auto partition = spillPartitions[row];
+    if (partitionIndices[partition] == nullptr) {
+      partitionIndices[partition] = allocateIndices(numInput, pool());
+      rawPartitionIndices[partition] =
+          partitionIndices[partition]->asMutable<vector_size_t>();
+    }
+    rawPartitionIndices[partition][numPartitionInputs[partition]++] = row;
+  }
+
+  // Ensure vector are lazy loaded before spilling.
+  for (auto i = 0; i < input->childrenSize(); ++i) {
+    input->childAt(i)->loadedVector();
+  }
+
+  for (auto partition = 0; partition < numPartitions; ++partition) {
+    const auto numPartitionInput = numPartitionInputs[partition];
+    if (numPartitionInput == 0) {
+      continue;
+    }
+    inputSpiller_->spill(
+        partition,
+        wrap(numPartitionInput, partitionIndices[partition], input));
+  }
+}
+
+void RowNumber::addSpillInput() {
+  VELOX_CHECK_NULL(input_);
+
+  while (spillInputReader_ != nullptr) {
+    RowVectorPtr spillInput;
+    if (spillInputReader_->nextBatch(spillInput)) {
+      addInputInternal(std::move(spillInput));
+      return;
+    }
+    restoreNextSpillPartition();
+  }
+}
+
+void RowNumber::restoreNextSpillPartition() {
+  spillInputReader_.reset();
+  if (spillInputPartitionSet_.empty()) {
+    return;
+  }
+
+  // The partitions without spilled input don't produce any output.
+  auto it = spillInputPartitionSet_.begin();
+  spillInputReader_ = it->second->createReader();
+
+  table_->clear();
+  auto tableIt = spillHashTablePartitionSet_.find(it->first);
+  if (tableIt != spillHashTablePartitionSet_.end()) {
+    auto reader = tableIt->second->createReader();
+    RowVectorPtr data;
+    while (reader->nextBatch(data)) {
+      restoreHashTable(data);
+    }
+    spillHashTablePartitionSet_.erase(tableIt);
+  }
+  spillInputPartitionSet_.erase(it);
+}
+
+void RowNumber::restoreHashTable(const RowVectorPtr& data) {
+  const auto size = data->size();
+  const auto numKeys = keyChannels_.size();
+
+  // The hashers read the keys from their channels in the input, so place the
+  // spilled keys at the same channels.
+  std::vector<VectorPtr> children(inputType_->size());
+  for (auto i = 0; i < numKeys; ++i) {
+    children[keyChannels_[i]] = data->childAt(i);
+  }
+  for (auto i = 0; i < children.size(); ++i) {
+    if (children[i] == nullptr) {
+      children[i] =
+          BaseVector::createNullConstant(inputType_->childAt(i), size, pool());
+    }
+  }
+  auto keys = std::make_shared<RowVector>(
+      pool(), inputType_, nullptr, size, std::move(children));
+
+  SelectivityVector rows(size);
+  table_->prepareForProbe(*lookup_, keys, rows, false);
+  table_->groupProbe(*lookup_);
+  VELOX_CHECK_EQ(lookup_->newGroups.size(), size);
+
+  DecodedVector numRowsDecoded(*data->childAt(numKeys), rows);
+  for (auto i = 0; i < size; ++i) {
+    setNumRows(lookup_->hits[i], numRowsDecoded.valueAt<int64_t>(i));
+  }
+}
+
 FlatVector<int64_t>& RowNumber::getOrCreateRowNumberVector(vector_size_t size) {
   VectorPtr& result = results_[0];
   if (result && result.unique()) {
@@ -88,6 +334,10 @@ FlatVector<int64_t>& RowNumber::getOrCreateRowNumberVector(vector_size_t size) {
 }
 
 RowVectorPtr RowNumber::getOutput() {
+  if (input_ == nullptr && spillInputReader_ != nullptr) {
+    addSpillInput();
+  }
+
   if (input_ == nullptr) {
     return nullptr;
   }
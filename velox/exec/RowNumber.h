@@ -15,8 +15,10 @@
  */
 #pragma once
 
+#include "velox/exec/HashPartitionFunction.h"
 #include "velox/exec/HashTable.h"
 #include "velox/exec/Operator.h"
+#include "velox/exec/Spiller.h"
 
 namespace facebook::velox::exec {
 
@@ -31,6 +33,8 @@ class RowNumber : public Operator {
 
   RowVectorPtr getOutput() override;
 
+  void noMoreInput() override;
+
   bool needsInput() const override {
     return !noMoreInput_ && !finishedEarly_;
   }
@@ -40,9 +44,13 @@ class RowNumber : public Operator {
   }
 
   bool isFinished() override {
-    return (noMoreInput_ && input_ == nullptr) || finishedEarly_;
+    return (noMoreInput_ && input_ == nullptr &&
+            spillInputReader_ == nullptr) ||
+        finishedEarly_;
   }
 
+  void reclaim(uint64_t targetBytes) override;
+
  private:
   int64_t numRows(char* partition);
 
@@ -52,6 +60,37 @@ class RowNumber : public Operator {
 
   FlatVector<int64_t>& getOrCreateRowNumberVector(vector_size_t size);
 
+  // Probes the hash table with 'input' and initializes new partitions with
+  // zero row counts.
+  void addInputInternal(RowVectorPtr input);
+
+  // Checks if input will fit in the existing memory and increases reservation
+  // if not. If reservation cannot be increased, spills the hash table.
+  void ensureInputFits(const RowVectorPtr& input);
+
+  // Spills all the hash table partitions together with their row counts and
+  // clears the hash table. All the subsequent input is spilled to the same
+  // hash partitions. This is called by ensureInputFits or by external memory
+  // management. In the latter case, the Driver of this will be in a paused
+  // state and off thread.
+  void spill();
+
+  // Spills 'input' rows to their hash partitions.
+  void spillInput(const RowVectorPtr& input);
+
+  // Reads the next batch of the spilled input into 'input_'. Restores the
+  // next spilled partition if the current one is exhausted. Sets
+  // 'spillInputReader_' to null if all the spilled partitions are processed.
+  void addSpillInput();
+
+  // Restores the hash table of the next spilled partition and sets up
+  // 'spillInputReader_' to read its spilled input.
+  void restoreNextSpillPartition();
+
+  // Inserts the spilled partition keys and row counts from 'data' into the
+  // hash table.
+  void restoreHashTable(const RowVectorPtr& data);
+
   const std::optional<int32_t> limit_;
   const bool generateRowNumber_;
 
@@ -61,6 +100,34 @@ class RowNumber : public Operator {
   std::unique_ptr<HashLookup> lookup_;
   int32_t numRowsOffset_;
 
+  // The input type and the channels of the partition keys in the input.
+  const RowTypePtr inputType_;
+  std::vector<column_index_t> keyChannels_;
+
+  // The partition keys followed by the number of rows seen so far. This is
+  // the type of the spilled hash table rows.
+  RowTypePtr tableType_;
+
+  // Spills the hash table rows. Set when spilling is triggered. All the hash
+  // partitions are spilled together.
+  std::unique_ptr<Spiller> spiller_;
+
+  // Spills the input received after 'spiller_' is set up by hash partition.
+  std::unique_ptr<Spiller> inputSpiller_;
+  std::unique_ptr<HashPartitionFunction> spillHashFunction_;
+
+  // Counts input batches and triggers spilling if folly hash of this % 100 <=
+  // 'testSpillPct_';.
+  uint64_t spillTestCounter_{0};
+
+  // The spilled hash table rows and input by spill partition. The partitions
+  // are restored one at a time after no more input.
+  SpillPartitionSet spillHashTablePartitionSet_;
+  SpillPartitionSet spillInputPartitionSet_;
+
+  // Reads the spilled input of the partition being restored.
+  std::unique_ptr<UnorderedStreamReader<BatchStream>> spillInputReader_;
+
   /// Total number of input rows. Used when there are no partitioning keys and
   /// therefore no hash table.
   int64_t numTotalInput_{0};
@@ -16,6 +16,9 @@
 #pragma once
 
 #include <folly/container/F14Set.h>
+#include <folly/hash/Hash.h>
+#include <xsimd/xsimd.hpp>
+#include "velox/common/base/SimdUtil.h"
 #include "velox/common/memory/HashStringAllocator.h"
 #include "velox/exec/AddressableNonNullValueList.h"
 #include "velox/exec/Strings.h"
@@ -95,6 +98,185 @@ struct SetAccumulator {
   }
 };
 
+/// Maintains a set of unique integers, like SetAccumulator, without a hash
+/// table for small sets. The first kInlineSize values are kept in the
+/// accumulator itself. Larger sets are kept in an open addressing table of
+/// 'capacity' slots allocated from the HashStringAllocator. An empty slot holds
+/// 0 and the 0 value is tracked by 'hasZero'. The table is divided into buckets
+/// of one SIMD batch. A value is looked up and inserted by comparing a whole
+/// bucket at a time, starting at the bucket given by its hash.
+template <typename T>
+struct IntegerSetAccumulator {
+  using Batch = xsimd::batch<T>;
+  static constexpr int32_t kBatchSize = Batch::size;
+  static constexpr int32_t kInlineSize = 16 / sizeof(T);
+  static constexpr uint32_t kInitialCapacity =
+      std::max<uint32_t>(2 * kBatchSize, 4 * kInlineSize);
+
+  bool hasNull{false};
+
+  /// True if 0 is in the set. Used only when 'table' is set.
+  bool hasZero{false};
+
+  /// Number of unique non-null values.
+  uint32_t numValues{0};
+
+  /// Number of slots in 'table'. 0 while the values are inline.
+  uint32_t capacity{0};
+
+  T* table{nullptr};
+
+  T inlineValues[kInlineSize];
+
+  IntegerSetAccumulator(
+      const TypePtr& /*type*/,
+      HashStringAllocator* /*allocator*/) {}
+
+  /// Adds value if new. No-op if the value was added before.
+  void addValue(
+      const DecodedVector& decoded,
+      vector_size_t index,
+      HashStringAllocator* allocator) {
+    if (decoded.isNullAt(index)) {
+      hasNull = true;
+    } else {
+      insert(decoded.valueAt<T>(index), allocator);
+    }
+  }
+
+  /// Adds new values from an array.
+  void addValues(
+      const ArrayVector& arrayVector,
+      vector_size_t index,
+      const DecodedVector& values,
+      HashStringAllocator* allocator) {
+    const auto size = arrayVector.sizeAt(index);
+    const auto offset = arrayVector.offsetAt(index);
+
+    for (auto i = 0; i < size; ++i) {
+      addValue(values, offset + i, allocator);
+    }
+  }
+
+  /// Returns number of unique values including null.
+  size_t size() const {
+    return numValues + (hasNull ? 1 : 0);
+  }
+
+  /// Copies the unique values and null into the specified vector starting at
+  /// the specified offset.
+  vector_size_t extractValues(FlatVector<T>& values, vector_size_t offset) {
+    vector_size_t index = offset;
+    if (table == nullptr) {
+      for (auto i = 0; i < numValues; ++i) {
+        values.set(index++, inlineValues[i]);
+      }
+    } else {
+      for (auto i = 0; i < capacity; ++i) {
+        if (table[i] != 0) {
+          values.set(index++, table[i]);
+        }
+      }
+      if (hasZero) {
+        values.set(index++, 0);
+      }
+    }
+
+    if (hasNull) {
+      values.setNull(index++, true);
+    }
+
+    return index - offset;
+  }
+
+  void free(HashStringAllocator& allocator) {
+    if (table != nullptr) {
+      AlignedStlAllocator<T, 16>(&allocator).deallocate(table, capacity);
+      table = nullptr;
+      capacity = 0;
+    }
+  }
+
+ private:
+  void insert(T value, HashStringAllocator* allocator) {
+    if (table == nullptr) {
+      for (auto i = 0; i < numValues; ++i) {
+        if (inlineValues[i] == value) {
+          return;
+        }
+      }
+      if (numValues < kInlineSize) {
+        inlineValues[numValues++] = value;
+        return;
+      }
+      rehash(kInitialCapacity, allocator);
+    }
+
+    if (value == 0) {
+      if (!hasZero) {
+        hasZero = true;
+        ++numValues;
+      }
+      return;
+    }
+    // Keep the load factor under 3/4.
+    const auto numInTable = numValues - (hasZero ? 1 : 0);
+    if ((numInTable + 1) * 4 > capacity * 3) {
+      rehash(capacity * 2, allocator);
+    }
+    if (insertIntoTable(value)) {
+      ++numValues;
+    }
+  }
+
+  // Inserts a non-zero 'value' into 'table'. Returns false if it was there.
+  bool insertIntoTable(T value) {
+    const auto bucketMask = capacity / kBatchSize - 1;
+    auto bucket = folly::hasher<T>()(value) & bucketMask;
+    const auto target = Batch::broadcast(value);
+    const auto empty = Batch::broadcast(0);
+    for (;;) {
+      auto* slots = table + bucket * kBatchSize;
+      const auto values = Batch::load_unaligned(slots);
+      if (simd::toBitMask(values == target)) {
+        return false;
+      }
+      const auto emptySlots = simd::toBitMask(values == empty);
+      if (emptySlots) {
+        slots[__builtin_ctz(emptySlots)] = value;
+        return true;
+      }
+      bucket = (bucket + 1) & bucketMask;
+    }
+  }
+
+  // Moves the values to a new table of 'newCapacity' slots.
+  void rehash(uint32_t newCapacity, HashStringAllocator* allocator) {
+    auto* oldTable = table;
+    const auto oldCapacity = capacity;
+    table = AlignedStlAllocator<T, 16>(allocator).allocate(newCapacity);
+    capacity = newCapacity;
+    std::memset(table, 0, newCapacity * sizeof(T));
+
+    if (oldTable == nullptr) {
+      for (auto i = 0; i < numValues; ++i) {
+        if (inlineValues[i] == 0) {
+          hasZero = true;
+        } else {
+          insertIntoTable(inlineValues[i]);
+        }
+      }
+      return;
+    }
+    for (auto i = 0; i < oldCapacity; ++i) {
+      if (oldTable[i] != 0) {
+        insertIntoTable(oldTable[i]);
+      }
+    }
+    AlignedStlAllocator<T, 16>(allocator).deallocate(oldTable, oldCapacity);
+  }
+};
+
 /// Maintains a set of unique strings.
 struct StringViewSetAccumulator {
   /// A set of unique StringViews pointing to storage managed by 'strings'.
@@ -226,7 +408,10 @@ struct ComplexTypeSetAccumulator {
 
 template <typename T>
 struct SetAccumulatorTypeTraits {
-  using AccumulatorType = SetAccumulator<T>;
+  using AccumulatorType = std::conditional_t<
+      std::is_integral_v<T> && !std::is_same_v<T, bool>,
+      IntegerSetAccumulator<T>,
+      SetAccumulator<T>>;
 };
 
 template <>
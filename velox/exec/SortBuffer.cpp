@@ -0,0 +1,378 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#include "velox/exec/SortBuffer.h"
+#include "velox/exec/OperatorUtils.h"
+#include "velox/exec/PrefixSort.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+// Sets 'flag', if not null, for the lifetime of the guard.
+class FlagGuard {
+ public:
+  explicit FlagGuard(tsan_atomic<bool>* flag) : flag_(flag) {
+    if (flag_) {
+      VELOX_CHECK(!*flag_);
+      *flag_ = true;
+    }
+  }
+
+  ~FlagGuard() {
+    if (flag_) {
+      *flag_ = false;
+    }
+  }
+
+ private:
+  tsan_atomic<bool>* const flag_;
+};
+} // namespace
+
+SortBuffer::SortBuffer(
+    const RowTypePtr& inputType,
+    const std::vector<column_index_t>& sortColumnIndices,
+    const std::vector<CompareFlags>& sortCompareFlags,
+    memory::MemoryPool* pool,
+    tsan_atomic<bool>* nonReclaimableSection,
+    uint32_t* numSpillRuns,
+    const Spiller::Config* spillConfig,
+    uint64_t spillMemoryThreshold)
+    : inputType_(inputType),
+      pool_(pool),
+      nonReclaimableSection_(nonReclaimableSection),
+      numSpillRuns_(numSpillRuns),
+      spillConfig_(spillConfig),
+      spillMemoryThreshold_(spillMemoryThreshold),
+      sortCompareFlags_(sortCompareFlags) {
+  VELOX_CHECK_EQ(sortColumnIndices.size(), sortCompareFlags.size());
+  VELOX_CHECK(pool_->trackUsage());
+
+  std::vector<TypePtr> keyTypes;
+  std::vector<TypePtr> dependentTypes;
+  std::vector<TypePtr> types;
+  std::vector<std::string> names;
+  // Stores the sort key columns first in the row container. This enables to
+  // use the sorting facility provided by the row container. It also
+  // facilitates the sort merge read handling required by disk spilling.
+  std::unordered_set<column_index_t> keyChannelSet;
+  columnMap_.reserve(inputType_->size());
+  for (column_index_t i = 0; i < sortColumnIndices.size(); ++i) {
+    const auto channel = sortColumnIndices[i];
+    VELOX_CHECK_LT(channel, inputType_->size());
+    columnMap_.emplace_back(i, channel);
+    keyTypes.push_back(inputType_->childAt(channel));
+    types.push_back(keyTypes.back());
+    names.push_back(inputType_->nameOf(channel));
+    keyChannelSet.emplace(channel);
+  }
+
+  // Stores the non-key columns as dependents in the row container.
+  for (column_index_t channel = 0, nextColumn = sortColumnIndices.size();
+       channel < inputType_->size();
+       ++channel) {
+    if (keyChannelSet.count(channel) != 0) {
+      continue;
+    }
+    columnMap_.emplace_back(nextColumn++, channel);
+    dependentTypes.push_back(inputType_->childAt(channel));
+    types.push_back(dependentTypes.back());
+    names.push_back(inputType_->nameOf(channel));
+  }
+
+  data_ = std::make_unique<RowContainer>(keyTypes, dependentTypes, pool_);
+  spillerStoreType_ = ROW(std::move(names), std::move(types));
+}
+
+void SortBuffer::addInput(const VectorPtr& input) {
+  VELOX_CHECK(!noMoreInput_);
+  ensureInputFits(input);
+
+  // Prevents the memory arbitrator from reclaiming memory from the owner of
+  // this buffer while the rows are stored.
+  FlagGuard guard(nonReclaimableSection_);
+
+  SelectivityVector allRows(input->size());
+  std::vector<char*> rows(input->size());
+  for (int row = 0; row < input->size(); ++row) {
+    rows[row] = data_->newRow();
+  }
+  auto* inputRow = input->as<RowVector>();
+  VELOX_CHECK_NOT_NULL(inputRow);
+  for (const auto& columnProjection : columnMap_) {
+    DecodedVector decoded(
+        *inputRow->childAt(columnProjection.outputChannel), allRows);
+    for (int i = 0; i < input->size(); ++i) {
+      data_->store(decoded, i, rows[i], columnProjection.inputChannel);
+    }
+  }
+  numInputRows_ += allRows.size();
+}
+
+void SortBuffer::noMoreInput() {
+  VELOX_CHECK(!noMoreInput_);
+  noMoreInput_ = true;
+
+  if (numInputRows_ == 0) {
+    return;
+  }
+
+  if (spiller_ == nullptr) {
+    VELOX_CHECK_EQ(numInputRows_, data_->numRows());
+    // Sort the pointers to the rows in RowContainer (data_) instead of sorting
+    // the rows. The pointers are sorted on a normalized prefix of the keys.
+    sortedRows_.resize(numInputRows_);
+    RowContainerIterator iter;
+    data_->listRows(&iter, numInputRows_, sortedRows_.data());
+    PrefixSort::sort(
+        *data_,
+        sortCompareFlags_,
+        folly::Range<char**>(sortedRows_.data(), sortedRows_.size()));
+  } else {
+    // Finish spill, and we shouldn't get any rows from non-spilled partition as
+    // there is only one hash partition for a sort.
+    Spiller::SpillRows nonSpilledRows = spiller_->finishSpill();
+    VELOX_CHECK(nonSpilledRows.empty());
+
+    VELOX_CHECK_NULL(spillMerge_);
+    spillMerge_ = spiller_->startMerge(0);
+  }
+}
+
+RowVectorPtr SortBuffer::getOutput(vector_size_t maxOutputRows) {
+  VELOX_CHECK(noMoreInput_);
+  VELOX_CHECK_GT(maxOutputRows, 0);
+  if (numOutputRows_ == numInputRows_) {
+    return nullptr;
+  }
+
+  prepareOutput(maxOutputRows);
+  if (spiller_ != nullptr) {
+    getOutputWithSpill();
+  } else {
+    getOutputWithoutSpill();
+  }
+  return output_;
+}
+
+void SortBuffer::spill(int64_t targetRows, int64_t targetBytes) {
+  VELOX_CHECK(canSpill());
+  VELOX_CHECK(!noMoreInput_);
+  VELOX_CHECK_GE(targetRows, 0);
+  VELOX_CHECK_GE(targetBytes, 0);
+
+  if (numSpillRuns_) {
+    ++*numSpillRuns_;
+  }
+  if (spiller_ == nullptr) {
+    spiller_ = std::make_unique<Spiller>(
+        Spiller::Type::kOrderBy,
+        data_.get(),
+        [&](folly::Range<char**> rows) { data_->eraseRows(rows); },
+        spillerStoreType_,
+        data_->keyTypes().size(),
+        sortCompareFlags_,
+        spillConfig_->filePath,
+        spillConfig_->maxFileSize,
+        spillConfig_->minSpillRunSize,
+        spillConfig_->compressionKind,
+        Spiller::pool(),
+        spillConfig_->executor,
+        spillConfig_->extraFilePaths);
+    VELOX_CHECK_EQ(spiller_->state().maxPartitions(), 1);
+  }
+  spiller_->spill(targetRows, targetBytes);
+  if (data_->numRows() == 0) {
+    // Physically frees the memory of the spilled rows.
+    data_->clear();
+  }
+}
+
+std::optional<SpillStats> SortBuffer::spilledStats() const {
+  if (spiller_ == nullptr) {
+    return std::nullopt;
+  }
+  auto stats = spiller_->stats();
+  VELOX_CHECK_LE(stats.spilledPartitions, 1);
+  return stats;
+}
+
+void SortBuffer::ensureInputFits(const VectorPtr& input) {
+  // Check if spilling is enabled or not.
+  if (!canSpill()) {
+    return;
+  }
+
+  const int64_t numRows = data_->numRows();
+  if (numRows == 0) {
+    // 'data_' is empty. Nothing to spill.
+    return;
+  }
+  auto [freeRows, outOfLineFreeBytes] = data_->freeSpace();
+  const auto outOfLineBytes =
+      data_->stringAllocator().retainedSize() - outOfLineFreeBytes;
+  const int64_t outOfLineBytesPerRow = outOfLineBytes / numRows;
+  const int64_t flatInputBytes = input->estimateFlatSize();
+
+  // Test-only spill path.
+  if (numRows > 0 && spillConfig_->testSpillPct &&
+      (folly::hasher<uint64_t>()(++spillTestCounter_)) % 100 <=
+          spillConfig_->testSpillPct) {
+    const int64_t rowsToSpill = std::max<int64_t>(1, numRows / 10);
+    spill(
+        numRows - rowsToSpill,
+        outOfLineBytes - (rowsToSpill * outOfLineBytesPerRow));
+    return;
+  }
+
+  const auto currentUsage = pool_->currentBytes();
+  if (spillMemoryThreshold_ != 0 && currentUsage > spillMemoryThreshold_) {
+    const int64_t bytesToSpill =
+        currentUsage * spillConfig_->spillableReservationGrowthPct / 100;
+    auto rowsToSpill = std::max<int64_t>(
+        1, bytesToSpill / (data_->fixedRowSize() + outOfLineBytesPerRow));
+    spill(
+        std::max<int64_t>(0, numRows - rowsToSpill),
+        std::max<int64_t>(
+            0, outOfLineBytes - (rowsToSpill * outOfLineBytesPerRow)));
+    return;
+  }
+
+  if (freeRows > input->size() &&
+      (outOfLineBytes == 0 || outOfLineFreeBytes >= flatInputBytes)) {
+    // Enough free rows for input rows and enough variable length free
+    // space for the flat size of the whole vector. If outOfLineBytes
+    // is 0 there is no need for variable length space.
+    return;
+  }
+
+  // If there is variable length data we take the flat size of the input as a
+  // cap on the new variable length data needed.
+  const int64_t incrementBytes =
+      data_->sizeIncrement(input->size(), outOfLineBytes ? flatInputBytes : 0);
+
+  // There must be at least 2x the increment in reservation.
+  if (pool_->availableReservation() > 2 * incrementBytes) {
+    return;
+  }
+
+  // Check if can increase reservation. The increment is the larger of twice the
+  // maximum increment from this input and 'spillableReservationGrowthPct_' of
+  // the current reservation.
+  const auto targetIncrementBytes = std::max<int64_t>(
+      incrementBytes * 2,
+      currentUsage * spillConfig_->spillableReservationGrowthPct / 100);
+  if (pool_->maybeReserve(targetIncrementBytes)) {
+    return;
+  }
+
+  // NOTE: disk spilling use the system disk spilling memory pool instead of
+  // the operator memory pool.
+  const int64_t rowsToSpill = std::max<int64_t>(
+      1, targetIncrementBytes / (data_->fixedRowSize() + outOfLineBytesPerRow));
+  spill(
+      std::max<int64_t>(0, numRows - rowsToSpill),
+      std::max<int64_t>(
+          0, outOfLineBytes - (rowsToSpill * outOfLineBytesPerRow)));
+}
+
+void SortBuffer::prepareOutput(vector_size_t maxOutputRows) {
+  VELOX_CHECK_GT(numInputRows_, numOutputRows_);
+
+  const vector_size_t batchSize =
+      std::min<vector_size_t>(numInputRows_ - numOutputRows_, maxOutputRows);
+  if (output_ != nullptr) {
+    VectorPtr output = std::move(output_);
+    BaseVector::prepareForReuse(output, batchSize);
+    output_ = std::static_pointer_cast<RowVector>(output);
+  } else {
+    output_ = std::static_pointer_cast<RowVector>(
+        BaseVector::create(inputType_, batchSize, pool_));
+  }
+
+  for (auto& child : output_->children()) {
+    child->resize(batchSize);
+  }
+
+  if (spiller_ != nullptr) {
+    spillSources_.resize(maxOutputRows);
+    spillSourceRows_.resize(maxOutputRows);
+  }
+}
+
+void SortBuffer::getOutputWithoutSpill() {
+  VELOX_CHECK_GT(output_->size(), 0);
+  VELOX_CHECK_LE(output_->size() + numOutputRows_, numInputRows_);
+  VELOX_DCHECK_EQ(numInputRows_, sortedRows_.size());
+
+  for (const auto& columnProjection : columnMap_) {
+    data_->extractColumn(
+        sortedRows_.data() + numOutputRows_,
+        output_->size(),
+        columnProjection.inputChannel,
+        output_->childAt(columnProjection.outputChannel));
+  }
+  numOutputRows_ += output_->size();
+}
+
+void SortBuffer::getOutputWithSpill() {
+  VELOX_CHECK_NOT_NULL(spillMerge_);
+  VELOX_DCHECK_EQ(sortedRows_.size(), 0);
+  VELOX_DCHECK_GE(spillSources_.size(), output_->size());
+
+  int32_t outputRow = 0;
+  int32_t outputSize = 0;
+  bool isEndOfBatch = false;
+  while (outputRow + outputSize < output_->size()) {
+    SpillMergeStream* stream = spillMerge_->next();
+    VELOX_CHECK_NOT_NULL(stream);
+
+    spillSources_[outputSize] = &stream->current();
+    spillSourceRows_[outputSize] = stream->currentIndex(&isEndOfBatch);
+    ++outputSize;
+    if (FOLLY_UNLIKELY(isEndOfBatch)) {
+      // The stream is at end of input batch. Need to copy out the rows before
+      // fetching next batch in 'pop'.
+      gatherCopy(
+          output_.get(),
+          outputRow,
+          outputSize,
+          spillSources_,
+          spillSourceRows_,
+          columnMap_);
+      outputRow += outputSize;
+      outputSize = 0;
+    }
+
+    // Advance the stream.
+    stream->pop();
+  }
+  VELOX_CHECK_EQ(outputRow + outputSize, output_->size());
+
+  if (FOLLY_LIKELY(outputSize != 0)) {
+    gatherCopy(
+        output_.get(),
+        outputRow,
+        outputSize,
+        spillSources_,
+        spillSourceRows_,
+        columnMap_);
+  }
+
+  numOutputRows_ += output_->size();
+}
+
+} // namespace facebook::velox::exec
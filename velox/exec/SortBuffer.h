@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+#pragma once
+
+#include "velox/exec/Operator.h"
+#include "velox/exec/RowContainer.h"
+#include "velox/exec/Spiller.h"
+
+namespace facebook::velox::exec {
+
+/// Accumulates input rows in a RowContainer and returns them sorted on a set
+/// of key columns once all input is in. If a spill config is given, sorted
+/// runs are spilled to disk when memory runs short and merged on output.
+/// Used by the OrderBy operator and by writers that sort the rows of a file.
+class SortBuffer {
+ public:
+  /// 'sortColumnIndices' are the channels of the keys in 'inputType' and
+  /// 'sortCompareFlags' their sort orders. 'nonReclaimableSection' is set
+  /// while rows are being stored, if not null. 'numSpillRuns' is incremented
+  /// on every spill, if not null. 'spillMemoryThreshold' is the memory usage
+  /// above which the buffer spills, if not 0.
+  SortBuffer(
+      const RowTypePtr& inputType,
+      const std::vector<column_index_t>& sortColumnIndices,
+      const std::vector<CompareFlags>& sortCompareFlags,
+      memory::MemoryPool* pool,
+      tsan_atomic<bool>* nonReclaimableSection = nullptr,
+      uint32_t* numSpillRuns = nullptr,
+      const Spiller::Config* spillConfig = nullptr,
+      uint64_t spillMemoryThreshold = 0);
+
+  void addInput(const VectorPtr& input);
+
+  /// Sorts the rows. No input can be added after this.
+  void noMoreInput();
+
+  /// Returns up to 'maxOutputRows' of the next sorted rows, or nullptr if all
+  /// rows have been returned. The result may be reused by the next call if not
+  /// referenced elsewhere.
+  RowVectorPtr getOutput(vector_size_t maxOutputRows);
+
+  /// Spills rows until under 'targetRows' rows and 'targetBytes' of out of
+  /// line data are left. If 'targetRows' is 0, spills everything and frees the
+  /// memory of the row container. Can only be called before noMoreInput().
+  void spill(int64_t targetRows, int64_t targetBytes);
+
+  bool canSpill() const {
+    return spillConfig_ != nullptr;
+  }
+
+  /// Returns the spill stats, or std::nullopt if nothing was spilled.
+  std::optional<SpillStats> spilledStats() const;
+
+  /// Returns the memory a row container would grow by for adding 'numRows'
+  /// rows with 'flatBytes' of variable length data.
+  int64_t sizeIncrement(vector_size_t numRows, int64_t flatBytes) const {
+    return data_->sizeIncrement(numRows, flatBytes);
+  }
+
+  size_t numInputRows() const {
+    return numInputRows_;
+  }
+
+ private:
+  // Checks if 'input' fits in the existing memory and increases the
+  // reservation if not. If the reservation cannot be increased, spills enough
+  // to make 'input' fit.
+  void ensureInputFits(const VectorPtr& input);
+
+  void prepareOutput(vector_size_t maxOutputRows);
+
+  void getOutputWithoutSpill();
+
+  void getOutputWithSpill();
+
+  const RowTypePtr inputType_;
+  memory::MemoryPool* const pool_;
+  tsan_atomic<bool>* const nonReclaimableSection_;
+  uint32_t* const numSpillRuns_;
+  const Spiller::Config* const spillConfig_;
+  const uint64_t spillMemoryThreshold_;
+
+  // The map from a column channel in 'inputType_' to the one stored in
+  // 'data_'. The sort key columns are stored first in 'data_'.
+  std::vector<IdentityProjection> columnMap_;
+
+  std::vector<CompareFlags> sortCompareFlags_;
+
+  std::unique_ptr<RowContainer> data_;
+
+  // The row type of 'data_', used for spilling.
+  RowTypePtr spillerStoreType_;
+
+  std::unique_ptr<Spiller> spiller_;
+
+  // Counts inputs and triggers spilling if folly hash of this % 100 <=
+  // 'testSpillPct' of the spill config.
+  uint64_t spillTestCounter_{0};
+
+  // Reads back the spilled runs in sorted order.
+  std::unique_ptr<TreeOfLosers<SpillMergeStream>> spillMerge_;
+
+  // The source rows to copy to 'output_' in order when merging spilled runs.
+  std::vector<const RowVector*> spillSources_;
+  std::vector<vector_size_t> spillSourceRows_;
+
+  // The sorted rows of 'data_' when nothing was spilled.
+  std::vector<char*> sortedRows_;
+
+  // Possibly reusable output vector.
+  RowVectorPtr output_;
+
+  size_t numInputRows_{0};
+  size_t numOutputRows_{0};
+  bool noMoreInput_{false};
+};
+
+} // namespace facebook::velox::exec
@@ -113,11 +113,59 @@ Accumulator SortedAggregations::accumulator() const {
       [this](folly::Range<char**> groups) {
         for (auto* group : groups) {
           auto* accumulator = reinterpret_cast<RowPointers*>(group + offset_);
+          if (accumulator->firstBlock == nullptr) {
+            continue;
+          }
+          // Free the input rows too, so that spilling a group releases its
+          // rows.
+          auto rows = accumulator->read(*allocator_);
+          inputData_->eraseRows(folly::Range<char**>(rows.data(), rows.size()));
           accumulator->free(*allocator_);
+          accumulator->size = 0;
         }
+      },
+      [this](folly::Range<char**> groups, VectorPtr& result) {
+        extractForSpill(groups, result);
       }};
 }
 
+TypePtr SortedAggregations::spillType() const {
+  return ARRAY(ROW(std::vector<TypePtr>(inputData_->keyTypes())));
+}
+
+void SortedAggregations::extractForSpill(
+    folly::Range<char**> groups,
+    VectorPtr& result) const {
+  if (result == nullptr) {
+    result = BaseVector::create(spillType(), groups.size(), inputData_->pool());
+  } else {
+    result->resize(groups.size());
+  }
+  auto* arrayVector = result->asUnchecked<ArrayVector>();
+  arrayVector->clearNulls(0, groups.size());
+  auto* rawOffsets = arrayVector->mutableOffsets(groups.size())
+                         ->asMutable<vector_size_t>();
+  auto* rawSizes =
+      arrayVector->mutableSizes(groups.size())->asMutable<vector_size_t>();
+
+  std::vector<char*> allRows;
+  for (auto i = 0; i < groups.size(); ++i) {
+    auto groupRows =
+        reinterpret_cast<RowPointers*>(groups[i] + offset_)->read(*allocator_);
+    rawOffsets[i] = allRows.size();
+    rawSizes[i] = groupRows.size();
+    allRows.insert(allRows.end(), groupRows.begin(), groupRows.end());
+  }
+
+  auto& elements = arrayVector->elements();
+  elements->resize(allRows.size());
+  auto* rowElements = elements->asUnchecked<RowVector>();
+  for (auto i = 0; i < inputs_.size(); ++i) {
+    inputData_->extractColumn(
+        allRows.data(), allRows.size(), i, rowElements->childAt(i));
+  }
+}
+
 void SortedAggregations::initializeNewGroups(
     char** groups,
     folly::Range<const vector_size_t*> indices) {
@@ -174,6 +222,36 @@ void SortedAggregations::addSingleGroupInput(
   }
 }
 
+void SortedAggregations::addSingleGroupSpillInput(
+    char* group,
+    const VectorPtr& input,
+    vector_size_t index) {
+  decodedSpillInput_.decode(*input);
+  auto* arrayVector = decodedSpillInput_.base()->asUnchecked<ArrayVector>();
+  const auto arrayIndex = decodedSpillInput_.index(index);
+  const auto offset = arrayVector->offsetAt(arrayIndex);
+  const auto size = arrayVector->sizeAt(arrayIndex);
+  if (size == 0) {
+    return;
+  }
+
+  auto* elements = arrayVector->elements()->asUnchecked<RowVector>();
+  decodedSpillElements_.resize(inputs_.size());
+  for (auto i = 0; i < inputs_.size(); ++i) {
+    decodedSpillElements_[i].decode(*elements->childAt(i));
+  }
+
+  for (auto row = offset; row < offset + size; ++row) {
+    char* newRow = inputData_->newRow();
+
+    for (auto i = 0; i < inputs_.size(); ++i) {
+      inputData_->store(decodedSpillElements_[i], row, newRow, i);
+    }
+
+    addNewRow(group, newRow);
+  }
+}
+
 bool SortedAggregations::compareRowsWithKeys(
     const char* lhs,
     const char* rhs,
@@ -38,6 +38,10 @@ class SortedAggregations {
   /// Returns metadata about the accumulator used to store lists of input rows.
   Accumulator accumulator() const;
 
+  /// Returns the type of the accumulator when spilled: an array of the input
+  /// rows of each group, with the inputs and sorting keys of all aggregates.
+  TypePtr spillType() const;
+
   /// Aggregate-like APIs to aggregate input rows per group.
   void setAllocator(HashStringAllocator* allocator) {
     allocator_ = allocator;
@@ -62,6 +66,13 @@ class SortedAggregations {
 
   void addSingleGroupInput(char* group, const RowVectorPtr& input);
 
+  /// Adds the input rows spilled for one group in row 'index' of 'input' to
+  /// 'group'. 'input' is of spillType().
+  void addSingleGroupSpillInput(
+      char* group,
+      const VectorPtr& input,
+      vector_size_t index);
+
   void noMoreInput();
 
   /// Sorts input row for the specified groups, computes aggregations and stores
@@ -71,6 +82,9 @@ class SortedAggregations {
  private:
   void addNewRow(char* group, char* newRow);
 
+  // Copies the input rows of 'groups' into 'result' of spillType().
+  void extractForSpill(folly::Range<char**> groups, VectorPtr& result) const;
+
   bool compareRowsWithKeys(
       const char* lhs,
       const char* rhs,
@@ -95,6 +109,11 @@ class SortedAggregations {
 
   std::vector<DecodedVector> decodedInputs_;
 
+  // Decoded array of spilled input rows and its elements, reused across
+  // addSingleGroupSpillInput() calls.
+  DecodedVector decodedSpillInput_;
+  std::vector<DecodedVector> decodedSpillElements_;
+
   HashStringAllocator* allocator_;
   int32_t offset_;
   int32_t nullByte_;
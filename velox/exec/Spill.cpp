@@ -15,12 +15,38 @@
  */
 
 #include "velox/exec/Spill.h"
+#include <fcntl.h>
+#include <folly/String.h>
+#include <sys/mman.h>
+#include <unistd.h>
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/process/TraceTimeline.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/serializers/PrestoSerializer.h"
 
+DEFINE_bool(
+    velox_spill_mmap_read,
+    false,
+    "If true, spill files on the local file system are read back through a "
+    "memory mapping instead of a read buffer allocated from the operator's "
+    "memory pool");
+
 namespace facebook::velox::exec {
 namespace {
+constexpr std::string_view kFileScheme("file:");
+
+// Returns the path of 'path' on the local file system or std::nullopt if
+// 'path' is not on the local file system.
+std::optional<std::string> localPath(const std::string& path) {
+  if (path.find('/') == 0) {
+    return path;
+  }
+  if (path.find(kFileScheme) == 0) {
+    return path.substr(kFileScheme.size());
+  }
+  return std::nullopt;
+}
+
 // Spilling currently uses the default PrestoSerializer which by default
 // serializes timestamp with millisecond precision to maintain compatibility
 // with presto. Since velox's native timestamp implementation supports
@@ -51,6 +77,91 @@ void SpillInput::next(bool /*throwIfPastEnd*/) {
   offset_ += readBytes;
 }
 
+MappedSpillInput::MappedSpillInput(const std::string& path, uint64_t size)
+    : size_(size) {
+  VELOX_CHECK_GT(size_, 0);
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  VELOX_CHECK_GE(
+      fd, 0, "Cannot open spill file {}: {}", path, folly::errnoStr(errno));
+  void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  const auto mapErrno = errno;
+  ::close(fd);
+  VELOX_CHECK(
+      data != MAP_FAILED,
+      "Cannot map spill file {}: {}",
+      path,
+      folly::errnoStr(mapErrno));
+  data_ = static_cast<uint8_t*>(data);
+  ::madvise(data_, size_, MADV_SEQUENTIAL);
+
+  // The size of a ByteRange is 32 bits.
+  constexpr uint64_t kMaxRangeSize = 1 << 30;
+  std::vector<ByteRange> ranges;
+  for (uint64_t offset = 0; offset < size_; offset += kMaxRangeSize) {
+    ranges.push_back(ByteRange{
+        data_ + offset,
+        static_cast<int32_t>(std::min(kMaxRangeSize, size_ - offset)),
+        0});
+  }
+  resetInput(std::move(ranges));
+}
+
+MappedSpillInput::~MappedSpillInput() {
+  ::munmap(data_, size_);
+}
+
+void MappedSpillInput::releaseReadPages() {
+  static const uint64_t kPageSize = ::sysconf(_SC_PAGESIZE);
+  const uint64_t readOffset = size_ - remainingSize();
+  const auto end = readOffset - readOffset % kPageSize;
+  if (end > releasedBytes_) {
+    ::madvise(data_ + releasedBytes_, end - releasedBytes_, MADV_DONTNEED);
+    releasedBytes_ = end;
+  }
+}
+
+size_t SpillPathSelector::select() {
+  std::lock_guard<std::mutex> l(mutex_);
+  // Paths that have not been measured yet go first, the ones with the fewest
+  // pending bytes first. Then the paths that are expected to finish their
+  // pending writes and a write of the next file first.
+  std::optional<size_t> best;
+  std::pair<bool, double> bestCost;
+  for (auto i = 0; i < paths_.size(); ++i) {
+    const auto index = (nextIndex_ + i) % paths_.size();
+    const auto& path = paths_[index];
+    const bool measured = path.writtenBytes > 0 && path.writeTimeUs > 0;
+    const std::pair<bool, double> cost{
+        measured,
+        measured ? (path.pendingBytes + 1.0) * path.writeTimeUs /
+                path.writtenBytes
+                 : path.pendingBytes};
+    if (!best.has_value() || cost < bestCost) {
+      best = index;
+      bestCost = cost;
+    }
+  }
+  nextIndex_ = (best.value() + 1) % paths_.size();
+  return best.value();
+}
+
+void SpillPathSelector::startWrite(size_t index, uint64_t bytes) {
+  std::lock_guard<std::mutex> l(mutex_);
+  paths_.at(index).pendingBytes += bytes;
+}
+
+void SpillPathSelector::finishWrite(
+    size_t index,
+    uint64_t bytes,
+    uint64_t timeUs) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto& path = paths_.at(index);
+  VELOX_CHECK_GE(path.pendingBytes, bytes);
+  path.pendingBytes -= bytes;
+  path.writtenBytes += bytes;
+  path.writeTimeUs += timeUs;
+}
+
 void SpillMergeStream::pop() {
   if (++index_ >= size_) {
     setNextBatch();
@@ -112,6 +223,35 @@ SpillFile::SpillFile(
       sortCompareFlags_.empty() || sortCompareFlags_.size() == numSortingKeys_);
 }
 
+SpillFile::SpillFile(
+    RowTypePtr type,
+    int32_t numSortingKeys,
+    const std::vector<CompareFlags>& sortCompareFlags,
+    std::string path,
+    uint64_t fileSize,
+    common::CompressionKind compressionKind,
+    memory::MemoryPool* pool)
+    : type_(std::move(type)),
+      numSortingKeys_(numSortingKeys),
+      sortCompareFlags_(sortCompareFlags),
+      ordinal_(ordinalCounter_++),
+      path_(std::move(path)),
+      compressionKind_(compressionKind),
+      pool_(pool),
+      fileSize_(fileSize) {}
+
+std::unique_ptr<SpillFile> SpillFile::copyForRead() const {
+  VELOX_CHECK(!output_);
+  return std::unique_ptr<SpillFile>(new SpillFile(
+      type_,
+      numSortingKeys_,
+      sortCompareFlags_,
+      path_,
+      fileSize_,
+      compressionKind_,
+      pool_));
+}
+
 WriteFile& SpillFile::output() {
   if (!output_) {
     auto fs = filesystems::getFileSystem(path_, nullptr);
@@ -125,6 +265,13 @@ void SpillFile::startRead() {
       (1 << 20) - AlignedBuffer::kPaddedSize; // 1MB - padding.
   VELOX_CHECK(!output_);
   VELOX_CHECK(!input_);
+  VELOX_CHECK(!mappedInput_);
+  if (FLAGS_velox_spill_mmap_read && fileSize_ > 0) {
+    if (auto path = localPath(path_)) {
+      mappedInput_ = std::make_unique<MappedSpillInput>(*path, fileSize_);
+      return;
+    }
+  }
   auto fs = filesystems::getFileSystem(path_, nullptr);
   auto file = fs->openFileForRead(path_);
   auto buffer = AlignedBuffer::allocate<char>(
@@ -133,11 +280,20 @@ void SpillFile::startRead() {
 }
 
 bool SpillFile::nextBatch(RowVectorPtr& rowVector) {
+  serializer::presto::PrestoVectorSerde::PrestoOptions options = {
+      kDefaultUseLosslessTimestamp, compressionKind_};
+  if (mappedInput_) {
+    if (mappedInput_->atEnd()) {
+      return false;
+    }
+    VectorStreamGroup::read(
+        mappedInput_.get(), pool_, type_, &rowVector, &options);
+    mappedInput_->releaseReadPages();
+    return true;
+  }
   if (input_->atEnd()) {
     return false;
   }
-  serializer::presto::PrestoVectorSerde::PrestoOptions options = {
-      kDefaultUseLosslessTimestamp, compressionKind_};
   VectorStreamGroup::read(input_.get(), pool_, type_, &rowVector, &options);
   return true;
 }
@@ -150,19 +306,40 @@ SpillFileList::SpillFileList(
     uint64_t targetFileSize,
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
-    folly::Synchronized<SpillStats>* stats)
+    folly::Synchronized<SpillStats>* stats,
+    folly::Executor* executor,
+    const std::vector<std::string>& extraPaths,
+    SpillPathSelector* pathSelector)
     : type_(type),
       numSortingKeys_(numSortingKeys),
       sortCompareFlags_(sortCompareFlags),
-      path_(path),
+      paths_([&]() {
+        std::vector<std::string> paths{path};
+        paths.insert(paths.end(), extraPaths.begin(), extraPaths.end());
+        return paths;
+      }()),
       targetFileSize_(targetFileSize),
       compressionKind_(compressionKind),
       pool_(pool),
-      stats_(stats) {
+      stats_(stats),
+      executor_(executor),
+      pathSelector_(pathSelector) {
   // NOTE: if the associated spilling operator has specified the sort
   // comparison flags, then it must match the number of sorting keys.
   VELOX_CHECK(
       sortCompareFlags_.empty() || sortCompareFlags_.size() == numSortingKeys_);
+  VELOX_CHECK(
+      extraPaths.empty() || pathSelector_ != nullptr,
+      "Spilling to multiple paths requires a path selector");
+}
+
+SpillFileList::~SpillFileList() {
+  // The pending write refers to 'this' and the last file.
+  try {
+    waitForPendingWrite();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << "Failed to write spill file: " << e.what();
+  }
 }
 
 WriteFile& SpillFileList::currentOutput() {
@@ -172,11 +349,14 @@ WriteFile& SpillFileList::currentOutput() {
       files_.back()->finishWrite();
       updateSpilledFiles(files_.back()->size());
     }
+    if (pathSelector_ != nullptr) {
+      pathIndex_ = pathSelector_->select();
+    }
     files_.push_back(std::make_unique<SpillFile>(
         type_,
         numSortingKeys_,
         sortCompareFlags_,
-        fmt::format("{}-{}", path_, files_.size()),
+        fmt::format("{}-{}", paths_[pathIndex_], files_.size()),
         compressionKind_,
         pool_));
   }
@@ -184,33 +364,77 @@ WriteFile& SpillFileList::currentOutput() {
 }
 
 uint64_t SpillFileList::flush() {
-  uint64_t writtenBytes = 0;
-  if (batch_) {
-    IOBufOutputStream out(
-        *pool_, nullptr, std::max<int64_t>(64 * 1024, batch_->size()));
-    uint64_t flushTimeUs{0};
-    {
-      MicrosecondTimer timer(&flushTimeUs);
-      batch_->flush(&out);
-    }
+  if (!batch_) {
+    return 0;
+  }
+  IOBufOutputStream out(
+      *pool_, nullptr, std::max<int64_t>(64 * 1024, batch_->size()));
+  uint64_t flushTimeUs{0};
+  {
+    MicrosecondTimer timer(&flushTimeUs);
+    batch_->flush(&out);
+  }
+  batch_.reset();
+  std::shared_ptr<folly::IOBuf> iobuf = out.getIOBuf();
+  const uint64_t writtenBytes = iobuf->computeChainDataLength();
+
+  // The previous batch is written while this one is serialized. Wait for it
+  // before appending to the file, which may also start a new file.
+  waitForPendingWrite();
+  auto& file = currentOutput();
+  const auto pathIndex = pathIndex_;
+  if (pathSelector_ != nullptr) {
+    pathSelector_->startWrite(pathIndex, writtenBytes);
+  }
+  if (executor_ == nullptr) {
+    writeToFile(file, pathIndex, *iobuf, flushTimeUs);
+    return writtenBytes;
+  }
+  pendingWrite_ = std::make_shared<AsyncSource<uint64_t>>(
+      [this, &file, pathIndex, iobuf, flushTimeUs, writtenBytes]() {
+        writeToFile(file, pathIndex, *iobuf, flushTimeUs);
+        return std::make_unique<uint64_t>(writtenBytes);
+      });
+  executor_->add([write = pendingWrite_,
+                  timeline = process::TraceTimeline::current()]() {
+    process::ScopedTraceTimeline scopedTimeline(timeline);
+    write->prepare();
+  });
+  return writtenBytes;
+}
 
-    batch_.reset();
-    auto iobuf = out.getIOBuf();
-    auto& file = currentOutput();
-    uint64_t writeTimeUs{0};
-    uint32_t numDiskWrites{0};
-    {
-      MicrosecondTimer timer(&writeTimeUs);
-      for (auto& range : *iobuf) {
-        ++numDiskWrites;
-        file.append(std::string_view(
-            reinterpret_cast<const char*>(range.data()), range.size()));
-        writtenBytes += range.size();
-      }
+void SpillFileList::waitForPendingWrite() {
+  if (pendingWrite_ == nullptr) {
+    return;
+  }
+  auto write = std::move(pendingWrite_);
+  // Runs the write here if the executor has not started it yet.
+  write->move();
+}
+
+void SpillFileList::writeToFile(
+    WriteFile& file,
+    size_t pathIndex,
+    const folly::IOBuf& data,
+    uint64_t flushTimeUs) {
+  uint64_t writtenBytes{0};
+  uint64_t writeTimeUs{0};
+  uint32_t numDiskWrites{0};
+  {
+    process::TraceEvent traceEvent(
+        "spill", "Spill write", data.computeChainDataLength());
+    MicrosecondTimer timer(&writeTimeUs);
+    for (auto& range : data) {
+      ++numDiskWrites;
+      file.append(std::string_view(
+          reinterpret_cast<const char*>(range.data()), range.size()));
+      writtenBytes += range.size();
     }
-    updateWriteStats(numDiskWrites, writtenBytes, flushTimeUs, writeTimeUs);
   }
-  return writtenBytes;
+  updateWriteStats(numDiskWrites, writtenBytes, flushTimeUs, writeTimeUs);
+  if (pathSelector_ != nullptr) {
+    pathSelector_->finishWrite(pathIndex, writtenBytes, writeTimeUs);
+  }
 }
 
 uint64_t SpillFileList::write(
@@ -266,6 +490,7 @@ void SpillFileList::updateSpilledFiles(uint64_t fileSize) {
 
 void SpillFileList::finishFile() {
   flush();
+  waitForPendingWrite();
   if (files_.empty()) {
     return;
   }
@@ -291,7 +516,9 @@ SpillState::SpillState(
     uint64_t targetFileSize,
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
-    folly::Synchronized<SpillStats>* stats)
+    folly::Synchronized<SpillStats>* stats,
+    folly::Executor* executor,
+    const std::vector<std::string>& extraPaths)
     : path_(path),
       maxPartitions_(maxPartitions),
       numSortingKeys_(numSortingKeys),
@@ -300,6 +527,12 @@ SpillState::SpillState(
       compressionKind_(compressionKind),
       pool_(pool),
       stats_(stats),
+      executor_(executor),
+      extraPaths_(extraPaths),
+      pathSelector_(
+          extraPaths_.empty()
+              ? nullptr
+              : std::make_unique<SpillPathSelector>(extraPaths_.size() + 1)),
       files_(maxPartitions_) {}
 
 void SpillState::setPartitionSpilled(int32_t partition) {
@@ -318,6 +551,11 @@ uint64_t SpillState::appendToPartition(
       isPartitionSpilled(partition), "Partition {} is not spilled", partition);
   // Ensure that partition exist before writing.
   if (!files_.at(partition)) {
+    std::vector<std::string> extraPaths;
+    extraPaths.reserve(extraPaths_.size());
+    for (const auto& extraPath : extraPaths_) {
+      extraPaths.push_back(fmt::format("{}-spill-{}", extraPath, partition));
+    }
     files_[partition] = std::make_unique<SpillFileList>(
         std::static_pointer_cast<const RowType>(rows->type()),
         numSortingKeys_,
@@ -326,7 +564,10 @@ uint64_t SpillState::appendToPartition(
         targetFileSize_,
         compressionKind_,
         pool_,
-        stats_);
+        stats_,
+        executor_,
+        extraPaths,
+        pathSelector_.get());
   }
 
   IndexRange range{0, rows->size()};
@@ -401,6 +642,37 @@ std::vector<std::unique_ptr<SpillPartition>> SpillPartition::split(
   return shards;
 }
 
+uint64_t SpillPartition::size() const {
+  uint64_t size = 0;
+  for (const auto& file : files_) {
+    size += file->size();
+  }
+  return size;
+}
+
+std::vector<std::unique_ptr<SpillPartition>> SpillPartition::splitBlocks(
+    uint64_t maxBlockSize) {
+  std::vector<std::unique_ptr<SpillPartition>> blocks;
+  SpillFiles blockFiles;
+  uint64_t blockSize = 0;
+  for (auto& file : files_) {
+    if (!blockFiles.empty() && blockSize + file->size() > maxBlockSize) {
+      blocks.push_back(
+          std::make_unique<SpillPartition>(id_, std::move(blockFiles)));
+      blockFiles.clear();
+      blockSize = 0;
+    }
+    blockSize += file->size();
+    blockFiles.push_back(std::move(file));
+  }
+  if (!blockFiles.empty()) {
+    blocks.push_back(
+        std::make_unique<SpillPartition>(id_, std::move(blockFiles)));
+  }
+  files_.clear();
+  return blocks;
+}
+
 std::unique_ptr<UnorderedStreamReader<BatchStream>>
 SpillPartition::createReader() {
   std::vector<std::unique_ptr<BatchStream>> streams;
@@ -413,6 +685,17 @@ SpillPartition::createReader() {
       std::move(streams));
 }
 
+std::unique_ptr<UnorderedStreamReader<BatchStream>>
+SpillPartition::createSharedReader() const {
+  std::vector<std::unique_ptr<BatchStream>> streams;
+  streams.reserve(files_.size());
+  for (const auto& file : files_) {
+    streams.push_back(FileSpillBatchStream::create(file->copyForRead()));
+  }
+  return std::make_unique<UnorderedStreamReader<BatchStream>>(
+      std::move(streams));
+}
+
 SpillStats::SpillStats(
     uint64_t _spillRuns,
     uint64_t _spilledBytes,
@@ -16,8 +16,11 @@
 
 #pragma once
 
+#include <folly/Executor.h>
 #include <folly/container/F14Set.h>
+#include <gflags/gflags.h>
 
+#include "velox/common/base/AsyncSource.h"
 #include "velox/common/compression/Compression.h"
 #include "velox/common/file/File.h"
 #include "velox/exec/TreeOfLosers.h"
@@ -26,6 +29,8 @@
 #include "velox/vector/DecodedVector.h"
 #include "velox/vector/VectorStream.h"
 
+DECLARE_bool(velox_spill_mmap_read);
+
 namespace facebook::velox::exec {
 
 // Input stream backed by spill file.
@@ -54,6 +59,29 @@ class SpillInput : public ByteStream {
   uint64_t offset_ = 0;
 };
 
+/// Input stream over a spill file on the local file system, which is mapped
+/// into memory. The spilled pages are deserialized directly from the mapped
+/// file, without a read buffer and without copying them into it. The pages
+/// that have been read are dropped from memory by releaseReadPages().
+class MappedSpillInput : public ByteStream {
+ public:
+  /// Maps the local file 'path' of 'size' bytes.
+  MappedSpillInput(const std::string& path, uint64_t size);
+
+  ~MappedSpillInput() override;
+
+  /// Drops the mapped pages before the read position from memory. They are
+  /// clean pages of a private mapping, so they are read again from the file if
+  /// accessed later.
+  void releaseReadPages();
+
+ private:
+  uint8_t* data_{nullptr};
+  const uint64_t size_;
+  // Bytes from the beginning of the file that have been released.
+  uint64_t releasedBytes_{0};
+};
+
 /// Represents a spill file that is first in write mode and then
 /// turns into a source of spilled RowVectors. Owns a file system file that
 /// contains the spilled data and is live for the duration of 'this'.
@@ -122,7 +150,22 @@ class SpillFile {
     return path_;
   }
 
+  /// Returns a new spill file which reads the same backing file as 'this' from
+  /// the start. The caller must call finishWrite() on 'this' before this. This
+  /// allows to read a spill file multiple times or by multiple readers
+  /// concurrently.
+  std::unique_ptr<SpillFile> copyForRead() const;
+
  private:
+  SpillFile(
+      RowTypePtr type,
+      int32_t numSortingKeys,
+      const std::vector<CompareFlags>& sortCompareFlags,
+      std::string path,
+      uint64_t fileSize,
+      common::CompressionKind compressionKind,
+      memory::MemoryPool* pool);
+
   static std::atomic<int32_t> ordinalCounter_;
 
   // Type of 'rowVector_'. Needed for setting up writing.
@@ -139,6 +182,9 @@ class SpillFile {
   uint64_t fileSize_ = 0;
   std::unique_ptr<WriteFile> output_;
   std::unique_ptr<SpillInput> input_;
+  // Set instead of 'input_' if the file is read through a memory mapping.
+  // See FLAGS_velox_spill_mmap_read.
+  std::unique_ptr<MappedSpillInput> mappedInput_;
 };
 
 /// Provides the fine-grained spill execution stats.
@@ -209,6 +255,38 @@ FOLLY_ALWAYS_INLINE std::ostream& operator<<(
 
 using SpillFiles = std::vector<std::unique_ptr<SpillFile>>;
 
+/// Chooses the path of each new spill file among the paths of a spiller in
+/// different directories, e.g. on different disks. Tracks the bytes being
+/// written to and the measured write throughput of each path, and picks the
+/// path expected to finish its pending writes first. Paths that have not been
+/// written to yet are picked first. Thread safe.
+class SpillPathSelector {
+ public:
+  explicit SpillPathSelector(size_t numPaths) : paths_(numPaths) {}
+
+  /// Returns the index of the path to write the next spill file to.
+  size_t select();
+
+  /// Records the start of a write of 'bytes' to the path at 'index'.
+  void startWrite(size_t index, uint64_t bytes);
+
+  /// Records the end of a write started by startWrite(), which took 'timeUs'.
+  void finishWrite(size_t index, uint64_t bytes, uint64_t timeUs);
+
+ private:
+  struct PathStats {
+    uint64_t pendingBytes{0};
+    uint64_t writtenBytes{0};
+    uint64_t writeTimeUs{0};
+  };
+
+  std::mutex mutex_;
+  std::vector<PathStats> paths_;
+  // The path to start looking from, which rotates so that paths with the same
+  // expected time are picked in turn.
+  size_t nextIndex_{0};
+};
+
 /// Sequence of files for one partition of the spilled data. If data is
 /// sorted, each file is sorted. The globally sorted order is produced
 /// by merging the constituent files.
@@ -222,6 +300,12 @@ class SpillFileList {
   ///
   /// When writing sorted spill runs, the caller is responsible for buffering
   /// and sorting the data. write is called multiple times, followed by flush().
+  ///
+  /// If 'extraPaths' is not empty, the files are striped over 'path' and
+  /// 'extraPaths' as chosen by 'pathSelector', which is shared by the file
+  /// lists of the same spiller and is indexed like 'path' followed by
+  /// 'extraPaths'. If 'executor' is set, the serialized data is written to the
+  /// file on 'executor' while the next batch of data is serialized.
   SpillFileList(
       const RowTypePtr& type,
       int32_t numSortingKeys,
@@ -230,7 +314,12 @@ class SpillFileList {
       uint64_t targetFileSize,
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
-      folly::Synchronized<SpillStats>* stats);
+      folly::Synchronized<SpillStats>* stats,
+      folly::Executor* executor = nullptr,
+      const std::vector<std::string>& extraPaths = {},
+      SpillPathSelector* pathSelector = nullptr);
+
+  ~SpillFileList();
 
   /// Adds 'rows' for the positions in 'indices' into 'this'. The indices
   /// must produce a view where the rows are sorted if sorting is desired.
@@ -258,9 +347,21 @@ class SpillFileList {
   WriteFile& currentOutput();
 
   // Writes data from 'batch_' to the current output file. Returns the actual
-  // written size.
+  // written size. The write is done on 'executor_' if set and may still be in
+  // progress on return.
   uint64_t flush();
 
+  // Waits for the write started by the last flush() to finish, if any.
+  // Rethrows its error.
+  void waitForPendingWrite();
+
+  // Appends 'data' to 'file' and updates the write stats.
+  void writeToFile(
+      WriteFile& file,
+      size_t pathIndex,
+      const folly::IOBuf& data,
+      uint64_t flushTimeUs);
+
   // Invoked to update the number of spilled rows.
   void updateAppendStats(uint64_t numRows, uint64_t serializationTimeUs);
   // Invoked to increment the number of spilled files and the file size.
@@ -275,13 +376,20 @@ class SpillFileList {
   const RowTypePtr type_;
   const int32_t numSortingKeys_;
   const std::vector<CompareFlags> sortCompareFlags_;
-  const std::string path_;
+  // The path prefixes of the files, see 'pathSelector_'.
+  const std::vector<std::string> paths_;
   const uint64_t targetFileSize_;
   const common::CompressionKind compressionKind_;
   memory::MemoryPool* const pool_;
   folly::Synchronized<SpillStats>* const stats_;
+  folly::Executor* const executor_;
+  SpillPathSelector* const pathSelector_;
   std::unique_ptr<VectorStreamGroup> batch_;
   SpillFiles files_;
+  // The index in 'paths_' of the last file in 'files_'.
+  size_t pathIndex_{0};
+  // The write of the last flushed batch if done on 'executor_'.
+  std::shared_ptr<AsyncSource<uint64_t>> pendingWrite_;
 };
 
 // A source of sorted spilled RowVectors coming either from a file or memory.
@@ -349,7 +457,7 @@ class SpillMergeStream : public MergeStream {
     ensureRows();
     decoded_.resize(index + 1);
     for (auto i = oldSize; i <= index; ++i) {
-      decoded_[index].decode(*rowVector_->childAt(index), rows_);
+      decoded_[i].decode(*rowVector_->childAt(i), rows_);
     }
   }
 
@@ -538,16 +646,33 @@ class SpillPartition {
     return files_.size();
   }
 
+  /// Returns the total size of the spill files in bytes.
+  uint64_t size() const;
+
   /// Invoked to split this spill partition into 'numShards' to process in
   /// parallel.
   ///
   /// NOTE: the split spill partition shards will have the same id as this.
   std::vector<std::unique_ptr<SpillPartition>> split(int numShards);
 
+  /// Invoked to split this spill partition into blocks of consecutive spill
+  /// files of at most 'maxBlockSize' bytes each, except for the files larger
+  /// than that which make a block of their own.
+  ///
+  /// NOTE: the blocks will have the same id as this.
+  std::vector<std::unique_ptr<SpillPartition>> splitBlocks(
+      uint64_t maxBlockSize);
+
   /// Invoked to create an unordered stream reader from this spill partition.
   /// The created reader will take the ownership of the spill files.
   std::unique_ptr<UnorderedStreamReader<BatchStream>> createReader();
 
+  /// Invoked to create an unordered stream reader from this spill partition
+  /// which doesn't take the ownership of the spill files. This allows to read
+  /// the spill partition multiple times or by multiple readers concurrently.
+  std::unique_ptr<UnorderedStreamReader<BatchStream>> createSharedReader()
+      const;
+
  private:
   SpillPartitionId id_;
   SpillFiles files_;
@@ -566,7 +691,9 @@ class SpillState {
   /// 'numSortingKeys' is the number of leading columns on which the data is
   /// sorted, 0 if only hash partitioning is used. 'targetFileSize' is the
   /// target size of a single file.  'pool' owns the memory for state and
-  /// results.
+  /// results. If 'executor' is set, the file writes are done on it, see
+  /// SpillFileList. 'extraPaths' are path prefixes in other directories than
+  /// 'path', e.g. on other disks, over which the files are striped.
   SpillState(
       const std::string& path,
       int32_t maxPartitions,
@@ -575,7 +702,9 @@ class SpillState {
       uint64_t targetFileSize,
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
-      folly::Synchronized<SpillStats>* stats);
+      folly::Synchronized<SpillStats>* stats,
+      folly::Executor* executor = nullptr,
+      const std::vector<std::string>& extraPaths = {});
 
   /// Indicates if a given 'partition' has been spilled or not.
   bool isPartitionSpilled(int32_t partition) const {
@@ -658,6 +787,11 @@ class SpillState {
   const common::CompressionKind compressionKind_;
   memory::MemoryPool* const pool_;
   folly::Synchronized<SpillStats>* const stats_;
+  folly::Executor* const executor_;
+  const std::vector<std::string> extraPaths_;
+  // Set if there are 'extraPaths_'. Shared by the file lists of all
+  // partitions.
+  std::unique_ptr<SpillPathSelector> pathSelector_;
 
   // A set of spilled partition numbers.
   SpillPartitionNumSet spilledPartitionSet_;
@@ -19,6 +19,7 @@
 #include "velox/common/base/AsyncSource.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/Aggregate.h"
+#include "velox/exec/PrefixSort.h"
 
 using facebook::velox::common::testutil::TestValue;
 
@@ -39,7 +40,8 @@ Spiller::Spiller(
     uint64_t minSpillRunSize,
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
-    folly::Executor* executor)
+    folly::Executor* executor,
+    const std::vector<std::string>& extraPaths)
     : Spiller(
           type,
           container,
@@ -53,8 +55,12 @@ Spiller::Spiller(
           minSpillRunSize,
           compressionKind,
           pool,
-          executor) {
-  VELOX_CHECK_EQ(type_, Type::kOrderBy);
+          executor,
+          extraPaths) {
+  VELOX_CHECK(
+      type_ == Type::kOrderBy || type_ == Type::kWindow,
+      "Unexpected spiller type: {}",
+      typeName(type_));
 }
 
 Spiller::Spiller(
@@ -66,7 +72,8 @@ Spiller::Spiller(
     uint64_t minSpillRunSize,
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
-    folly::Executor* executor)
+    folly::Executor* executor,
+    const std::vector<std::string>& extraPaths)
     : Spiller(
           type,
           nullptr,
@@ -80,7 +87,8 @@ Spiller::Spiller(
           minSpillRunSize,
           compressionKind,
           pool,
-          executor) {
+          executor,
+          extraPaths) {
   VELOX_CHECK_EQ(type_, Type::kHashJoinProbe);
 }
 
@@ -97,7 +105,8 @@ Spiller::Spiller(
     uint64_t minSpillRunSize,
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
-    folly::Executor* executor)
+    folly::Executor* executor,
+    const std::vector<std::string>& extraPaths)
     : type_(type),
       container_(container),
       executor_(executor),
@@ -114,13 +123,15 @@ Spiller::Spiller(
           targetFileSize,
           compressionKind,
           pool_,
-          &stats_) {
+          &stats_,
+          executor_,
+          extraPaths) {
   TestValue::adjust(
       "facebook::velox::exec::Spiller", const_cast<HashBitRange*>(&bits_));
 
   VELOX_CHECK_EQ(container_ == nullptr, type_ == Type::kHashJoinProbe);
-  // kOrderBy spiller type must only have one partition.
-  VELOX_CHECK((type_ != Type::kOrderBy) || (state_.maxPartitions() == 1));
+  // kOrderBy and kWindow spiller types must only have one partition.
+  VELOX_CHECK(!isSinglePartition() || (state_.maxPartitions() == 1));
   spillRuns_.reserve(state_.maxPartitions());
   for (int i = 0; i < state_.maxPartitions(); ++i) {
     spillRuns_.emplace_back(*pool_);
@@ -144,8 +155,7 @@ void Spiller::extractSpill(folly::Range<char**> rows, RowVectorPtr& resultPtr) {
 
   auto numKeys = types.size();
   for (auto i = 0; i < accumulators.size(); ++i) {
-    accumulators[i].aggregateForSpill()->extractAccumulators(
-        rows.data(), rows.size(), &result->childAt(i + numKeys));
+    accumulators[i].extractForSpill(rows, result->childAt(i + numKeys));
   }
 }
 
@@ -253,13 +263,10 @@ void Spiller::ensureSorted(SpillRun& run) {
   uint64_t sortTimeUs{0};
   if (!run.sorted && needSort()) {
     MicrosecondTimer timer(&sortTimeUs);
-    std::sort(
-        run.rows.begin(),
-        run.rows.end(),
-        [&](const char* left, const char* right) {
-          return container_->compareRows(
-                     left, right, state_.sortCompareFlags()) < 0;
-        });
+    PrefixSort::sort(
+        *container_,
+        state_.sortCompareFlags(),
+        folly::Range<char**>(run.rows.data(), run.rows.size()));
     run.sorted = true;
   }
   if (sortTimeUs != 0) {
@@ -363,6 +370,10 @@ void Spiller::updateSpillSortTime(uint64_t timeUs) {
   updateGlobalSpillSortTime(timeUs);
 }
 
+bool Spiller::isSinglePartition() const {
+  return type_ == Type::kOrderBy || type_ == Type::kWindow;
+}
+
 bool Spiller::needSort() const {
   return type_ != Type::kHashJoinProbe && type_ != Type::kHashJoinBuild;
 }
@@ -579,7 +590,7 @@ void Spiller::fillSpillRuns(SpillRows* rowsFromNonSpillingPartitions) {
       for (auto i = 0; i < numRows; ++i) {
         // TODO: consider to cache the hash bits in row container so we only
         // need to calculate them once.
-        const auto partition = (type_ == Type::kOrderBy)
+        const auto partition = isSinglePartition()
             ? 0
             : bits_.partition(hashes[i], state_.maxPartitions());
         VELOX_DCHECK_GE(partition, 0);
@@ -659,6 +670,8 @@ std::string Spiller::typeName(Type type) {
       return "HASH_JOIN_PROBE";
     case Type::kAggregate:
       return "AGGREGATE";
+    case Type::kWindow:
+      return "WINDOW";
     default:
       VELOX_UNREACHABLE("Unknown type: {}", static_cast<int>(type));
   }
@@ -34,8 +34,10 @@ class Spiller {
     kHashJoinProbe = 2,
     // Used for order by.
     kOrderBy = 3,
+    // Used for window.
+    kWindow = 4,
   };
-  static constexpr int kNumTypes = 4;
+  static constexpr int kNumTypes = 5;
   static std::string typeName(Type);
 
   // Specifies the config for spilling.
@@ -51,7 +53,8 @@ class Spiller {
         uint8_t _aggregationPartitionBits,
         int32_t _maxSpillLevel,
         int32_t _testSpillPct,
-        const std::string& _compressionKind)
+        const std::string& _compressionKind,
+        std::vector<std::string> _extraFilePaths = {})
         : filePath(_filePath),
           maxFileSize(
               _maxFileSize == 0 ? std::numeric_limits<int64_t>::max()
@@ -64,7 +67,8 @@ class Spiller {
           aggregationPartitionBits(_aggregationPartitionBits),
           maxSpillLevel(_maxSpillLevel),
           testSpillPct(_testSpillPct),
-          compressionKind(common::stringToCompressionKind(_compressionKind)) {}
+          compressionKind(common::stringToCompressionKind(_compressionKind)),
+          extraFilePaths(std::move(_extraFilePaths)) {}
 
     /// Returns the hash join spilling level with given 'startBitOffset'.
     ///
@@ -123,12 +127,17 @@ class Spiller {
 
     // CompressionKind when spilling, CompressionKind_NONE means no compression.
     common::CompressionKind compressionKind;
+
+    // Filesystem paths in other directories than 'filePath', e.g. on other
+    // disks, over which the spill files are striped together with 'filePath'.
+    std::vector<std::string> extraFilePaths;
   };
 
   using SpillRows = std::vector<char*, memory::StlAllocator<char*>>;
 
   // The constructor without specifying hash bits which will only use one
-  // partition by default. It is only used by kOrderBy spiller type as for now.
+  // partition by default. It is only used by kOrderBy and kWindow spiller
+  // types as for now.
   Spiller(
       Type type,
       RowContainer* container,
@@ -141,7 +150,8 @@ class Spiller {
       uint64_t minSpillRunSize,
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
-      folly::Executor* executor);
+      folly::Executor* executor,
+      const std::vector<std::string>& extraPaths = {});
 
   Spiller(
       Type type,
@@ -152,7 +162,8 @@ class Spiller {
       uint64_t minSpillRunSize,
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
-      folly::Executor* executor);
+      folly::Executor* executor,
+      const std::vector<std::string>& extraPaths = {});
 
   Spiller(
       Type type,
@@ -167,7 +178,8 @@ class Spiller {
       uint64_t minSpillRunSize,
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
-      folly::Executor* executor);
+      folly::Executor* executor,
+      const std::vector<std::string>& extraPaths = {});
 
   /// Spills rows from 'this' until there are under 'targetRows' rows
   /// and 'targetBytes' of allocated variable length space in use. spill()
@@ -378,6 +390,11 @@ class Spiller {
   // non hash join types of spilling.
   bool needSort() const;
 
+  // Indicates if the spiller only has one partition. The kOrderBy and kWindow
+  // spillers need a total order on the spilled data so they can't be hash
+  // partitioned.
+  bool isSinglePartition() const;
+
   void updateSpillFillTime(uint64_t timeUs);
 
   void updateSpillSortTime(uint64_t timeUs);
@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #include "velox/exec/StreamingAggregation.h"
+#include <xsimd/xsimd.hpp>
+#include "velox/common/base/SimdUtil.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/RowContainer.h"
 
@@ -149,6 +151,137 @@ bool equalKeys(
 
   return true;
 }
+
+// Average number of rows per group from which the aggregates are updated one
+// group at a time with addSingleGroupRawInput() and
+// addSingleGroupIntermediateResults(). Shorter runs are updated together.
+constexpr vector_size_t kMinAverageRunLength = 16;
+
+// Sets the bit in 'changes' of each row in [1, size) whose value in 'values'
+// differs from the value of the previous row.
+template <typename T>
+void markValueChanges(const T* values, vector_size_t size, uint64_t* changes) {
+  vector_size_t row = 1;
+  if constexpr (std::is_integral_v<T> && sizeof(T) <= 8) {
+    using Batch = xsimd::batch<T>;
+    for (; row + Batch::size <= size; row += Batch::size) {
+      uint64_t mask = simd::toBitMask(
+          Batch::load_unaligned(values + row) !=
+          Batch::load_unaligned(values + row - 1));
+      while (mask) {
+        bits::setBit(changes, row + __builtin_ctzll(mask));
+        mask &= mask - 1;
+      }
+    }
+  }
+  for (; row < size; ++row) {
+    if (values[row] != values[row - 1]) {
+      bits::setBit(changes, row);
+    }
+  }
+}
+
+// Same as markValueChanges() for the dictionary of 'values' given by
+// 'indices'. Rows with the same index are equal without reading the values.
+template <typename T>
+void markDictionaryChanges(
+    const T* values,
+    const vector_size_t* indices,
+    vector_size_t size,
+    uint64_t* changes) {
+  using Batch = xsimd::batch<vector_size_t>;
+  vector_size_t row = 1;
+  for (; row + Batch::size <= size; row += Batch::size) {
+    uint64_t mask = simd::toBitMask(
+        Batch::load_unaligned(indices + row) !=
+        Batch::load_unaligned(indices + row - 1));
+    while (mask) {
+      const auto changed = row + __builtin_ctzll(mask);
+      if (values[indices[changed]] != values[indices[changed - 1]]) {
+        bits::setBit(changes, changed);
+      }
+      mask &= mask - 1;
+    }
+  }
+  for (; row < size; ++row) {
+    if (indices[row] != indices[row - 1] &&
+        values[indices[row]] != values[indices[row - 1]]) {
+      bits::setBit(changes, row);
+    }
+  }
+}
+
+template <typename T>
+void markFixedWidthChanges(
+    DecodedVector& decoded,
+    vector_size_t size,
+    uint64_t* changes) {
+  const auto* values = decoded.data<T>();
+  if (decoded.isIdentityMapping()) {
+    markValueChanges(values, size, changes);
+  } else {
+    markDictionaryChanges(values, decoded.indices(), size, changes);
+  }
+}
+
+// Sets the bit in 'changes' of each row in [1, size) whose key in 'decoded'
+// differs from the key of the previous row. Null keys are equal to each other
+// and differ from all non-null keys.
+void markKeyChanges(
+    DecodedVector& decoded,
+    vector_size_t size,
+    uint64_t* changes) {
+  if (decoded.isConstantMapping()) {
+    return;
+  }
+  const auto* base = decoded.base();
+  switch (base->isFlatEncoding() ? base->typeKind() : TypeKind::UNKNOWN) {
+    case TypeKind::TINYINT:
+      markFixedWidthChanges<int8_t>(decoded, size, changes);
+      break;
+    case TypeKind::SMALLINT:
+      markFixedWidthChanges<int16_t>(decoded, size, changes);
+      break;
+    case TypeKind::INTEGER:
+      markFixedWidthChanges<int32_t>(decoded, size, changes);
+      break;
+    case TypeKind::BIGINT:
+      markFixedWidthChanges<int64_t>(decoded, size, changes);
+      break;
+    case TypeKind::HUGEINT:
+      markFixedWidthChanges<int128_t>(decoded, size, changes);
+      break;
+    case TypeKind::TIMESTAMP:
+      markFixedWidthChanges<Timestamp>(decoded, size, changes);
+      break;
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      markFixedWidthChanges<StringView>(decoded, size, changes);
+      break;
+    default:
+      // Floating point values, booleans and complex types.
+      for (auto row = 1; row < size; ++row) {
+        if (!base->equalValueAt(
+                base, decoded.index(row), decoded.index(row - 1))) {
+          bits::setBit(changes, row);
+        }
+      }
+      break;
+  }
+
+  // The values of null rows are undefined. Fixes up the rows next to nulls.
+  const auto* nulls = decoded.nulls();
+  if (nulls == nullptr) {
+    return;
+  }
+  for (auto row = 1; row < size; ++row) {
+    const bool isNull = bits::isBitNull(nulls, row);
+    const bool previousIsNull = bits::isBitNull(nulls, row - 1);
+    if (isNull || previousIsNull) {
+      bits::setBit(changes, row, isNull != previousIsNull);
+    }
+  }
+}
 } // namespace
 
 char* StreamingAggregation::startNewGroup(vector_size_t index) {
@@ -195,41 +328,42 @@ RowVectorPtr StreamingAggregation::createOutput(size_t numGroups) {
 }
 
 void StreamingAggregation::assignGroups() {
-  auto numInput = input_->size();
-
+  const auto numInput = input_->size();
   inputGroups_.resize(numInput);
-
-  // Look for the end of the last group.
-  vector_size_t index = 0;
-  if (prevInput_) {
-    auto prevIndex = prevInput_->size() - 1;
-    auto* prevGroup = groups_[numGroups_ - 1];
-    for (; index < numInput; ++index) {
-      if (equalKeys(groupingKeys_, prevInput_, prevIndex, input_, index)) {
-        inputGroups_[index] = prevGroup;
-      } else {
-        break;
-      }
-    }
+  runBegins_.clear();
+  if (numInput == 0) {
+    return;
   }
 
-  if (index < numInput) {
-    for (auto i = 0; i < groupingKeys_.size(); ++i) {
-      decodedKeys_[i].decode(*input_->childAt(groupingKeys_[i]), inputRows_);
-    }
+  for (auto i = 0; i < groupingKeys_.size(); ++i) {
+    decodedKeys_[i].decode(*input_->childAt(groupingKeys_[i]), inputRows_);
+  }
 
-    auto* newGroup = startNewGroup(index);
-    inputGroups_[index] = newGroup;
+  // Marks the rows that start a new group, comparing each row to the previous
+  // one a batch of rows at a time.
+  groupStarts_.assign(bits::nwords(numInput), 0);
+  for (auto& decoded : decodedKeys_) {
+    markKeyChanges(decoded, numInput, groupStarts_.data());
+  }
 
-    for (auto i = index + 1; i < numInput; ++i) {
-      if (equalKeys(groupingKeys_, input_, index, input_, i)) {
-        inputGroups_[i] = inputGroups_[index];
-      } else {
-        newGroup = startNewGroup(i);
-        inputGroups_[i] = newGroup;
-        index = i;
-      }
-    }
+  // The first row continues the last group of the previous input if the keys
+  // are equal.
+  const bool continuesLastGroup = prevInput_ != nullptr &&
+      equalKeys(groupingKeys_, prevInput_, prevInput_->size() - 1, input_, 0);
+
+  runBegins_.push_back(0);
+  bits::forEachSetBit(
+      groupStarts_.data(), 1, numInput, [&](vector_size_t row) {
+        runBegins_.push_back(row);
+      });
+
+  for (auto run = 0; run < runBegins_.size(); ++run) {
+    const auto begin = runBegins_[run];
+    const auto end =
+        run + 1 < runBegins_.size() ? runBegins_[run + 1] : numInput;
+    auto* group = run == 0 && continuesLastGroup ? groups_[numGroups_ - 1]
+                                                 : startNewGroup(begin);
+    std::fill(inputGroups_.begin() + begin, inputGroups_.begin() + end, group);
   }
 }
 
@@ -242,6 +376,14 @@ const SelectivityVector& StreamingAggregation::getSelectivityVector(
 }
 
 void StreamingAggregation::evaluateAggregates() {
+  // Long runs of rows of the same group are typical of sorted input. These are
+  // added one group at a time, which saves the per row group lookups.
+  const auto numInput = input_->size();
+  const bool byRun = runBegins_.size() * kMinAverageRunLength <= numInput;
+  if (byRun) {
+    runRows_.resizeFill(numInput, false);
+  }
+
   for (auto i = 0; i < aggregates_.size(); ++i) {
     auto& aggregate = aggregates_[i];
 
@@ -256,10 +398,39 @@ void StreamingAggregation::evaluateAggregates() {
 
     const auto& rows = getSelectivityVector(i);
 
-    if (isRawInput(step_)) {
-      aggregate->addRawInput(inputGroups_.data(), rows, args, false);
-    } else {
-      aggregate->addIntermediateResults(inputGroups_.data(), rows, args, false);
+    if (!byRun) {
+      if (isRawInput(step_)) {
+        aggregate->addRawInput(inputGroups_.data(), rows, args, false);
+      } else {
+        aggregate->addIntermediateResults(
+            inputGroups_.data(), rows, args, false);
+      }
+      continue;
+    }
+
+    for (auto run = 0; run < runBegins_.size(); ++run) {
+      const auto begin = runBegins_[run];
+      const auto end =
+          run + 1 < runBegins_.size() ? runBegins_[run + 1] : numInput;
+      runRows_.setValidRange(begin, end, true);
+      if (!rows.isAllSelected()) {
+        bits::andBits(
+            runRows_.asMutableRange().bits(),
+            rows.asRange().bits(),
+            begin,
+            end);
+      }
+      runRows_.updateBounds();
+      if (runRows_.hasSelections()) {
+        auto* group = inputGroups_[begin];
+        if (isRawInput(step_)) {
+          aggregate->addSingleGroupRawInput(group, runRows_, args, false);
+        } else {
+          aggregate->addSingleGroupIntermediateResults(
+              group, runRows_, args, false);
+        }
+      }
+      runRows_.setValidRange(begin, end, false);
     }
   }
 }
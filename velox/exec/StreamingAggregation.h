@@ -62,7 +62,8 @@ class StreamingAggregation : public Operator {
   RowVectorPtr createOutput(size_t numGroups);
 
   // Assign input rows to groups based on values of the grouping keys. Store the
-  // assignments in inputGroups_.
+  // assignments in inputGroups_ and the runs of rows of the same group in
+  // runBegins_.
   void assignGroups();
 
   // Add input data to accumulators.
@@ -99,6 +100,15 @@ class StreamingAggregation : public Operator {
   // Pointers to groups for all input rows.
   std::vector<char*> inputGroups_;
 
+  // Bits of the input rows that start a new group.
+  std::vector<uint64_t> groupStarts_;
+
+  // The first row of each run of input rows of the same group.
+  std::vector<vector_size_t> runBegins_;
+
+  // The rows of one run of 'inputRows_' for adding to a single group.
+  SelectivityVector runRows_;
+
   // A subset of input rows to evaluate the aggregate function on. Rows
   // where aggregation mask is false are excluded.
   SelectivityVector inputRows_;
@@ -18,7 +18,11 @@
 #include "velox/exec/Task.h"
 #include "velox/expression/Expr.h"
 
-DEFINE_int32(split_preload_per_driver, 2, "Prefetch split metadata");
+DEFINE_int32(
+    split_preload_per_driver,
+    2,
+    "Maximum number of splits per driver to prefetch metadata for. The "
+    "number is lowered to what hides the split open latency");
 
 namespace facebook::velox::exec {
 
@@ -45,7 +49,8 @@ TableScan::TableScan(
           tableHandle_->connectorId())),
       readBatchSize_(driverCtx_->task->queryCtx()
                          ->queryConfig()
-                         .preferredOutputBatchRows()) {
+                         .preferredOutputBatchRows()),
+      splitOpenTime_(std::make_shared<SplitOpenTime>()) {
   connector_ = connector::getConnector(tableHandle_->connectorId());
 }
 
@@ -55,6 +60,18 @@ RowVectorPtr TableScan::getOutput() {
   }
 
   for (;;) {
+    if (rowLimit_.has_value() && numOutputRows_ >= rowLimit_.value()) {
+      // The consumer needs no more rows. The rest of the current split is
+      // not read and no more splits are taken.
+      if (!needNewSplit_) {
+        driverCtx_->task->splitFinished();
+        needNewSplit_ = true;
+      }
+      noMoreSplits_ = true;
+      addConnectorStats();
+      return nullptr;
+    }
+
     if (needNewSplit_) {
       exec::Split split;
       blockingReason_ = driverCtx_->task->getSplitOrFuture(
@@ -70,24 +87,7 @@ RowVectorPtr TableScan::getOutput() {
 
       if (!split.hasConnectorSplit()) {
         noMoreSplits_ = true;
-        if (dataSource_) {
-          auto connectorStats = dataSource_->runtimeStats();
-          auto lockedStats = stats_.wlock();
-          for (const auto& [name, counter] : connectorStats) {
-            if (name == "ioWaitNanos") {
-              ioWaitNanos_ += counter.value - lastIoWaitNanos_;
-              lastIoWaitNanos_ = counter.value;
-            }
-            if (UNLIKELY(lockedStats->runtimeStats.count(name) == 0)) {
-              lockedStats->runtimeStats.insert(
-                  std::make_pair(name, RuntimeMetric(counter.unit)));
-            } else {
-              VELOX_CHECK_EQ(
-                  lockedStats->runtimeStats.at(name).unit, counter.unit);
-            }
-            lockedStats->runtimeStats.at(name).addValue(counter.value);
-          }
-        }
+        addConnectorStats();
         return nullptr;
       }
 
@@ -111,6 +111,9 @@ RowVectorPtr TableScan::getOutput() {
           dataSource_->addDynamicFilter(entry.first, entry.second);
         }
         pendingDynamicFilters_.clear();
+        if (rowLimit_.has_value()) {
+          dataSource_->setRowLimit(rowLimit_.value());
+        }
       }
 
       debugString_ = fmt::format(
@@ -137,9 +140,12 @@ RowVectorPtr TableScan::getOutput() {
         }
         dataSource_->setFromDataSource(std::move(preparedDataSource));
       } else {
+        const auto addSplitStartMicros = getCurrentTimeMicro();
         dataSource_->addSplit(connectorSplit);
+        splitOpenTime_->add(getCurrentTimeMicro() - addSplitStartMicros);
       }
       ++stats_.wlock()->numSplits;
+      splitStartMicros_ = getCurrentTimeMicro();
 
       auto estimatedRowSize = dataSource_->estimatedRowSize();
       readBatchSize_ =
@@ -182,6 +188,7 @@ RowVectorPtr TableScan::getOutput() {
       if (data) {
         if (data->size() > 0) {
           lockedStats->addInputVector(data->estimateFlatSize(), data->size());
+          numOutputRows_ += data->size();
           return data;
         }
         continue;
@@ -202,11 +209,34 @@ RowVectorPtr TableScan::getOutput() {
       }
     }
 
+    totalSplitMicros_ += getCurrentTimeMicro() - splitStartMicros_;
+    ++numFinishedSplits_;
     driverCtx_->task->splitFinished();
     needNewSplit_ = true;
   }
 }
 
+void TableScan::addConnectorStats() {
+  if (!dataSource_) {
+    return;
+  }
+  auto connectorStats = dataSource_->runtimeStats();
+  auto lockedStats = stats_.wlock();
+  for (const auto& [name, counter] : connectorStats) {
+    if (name == "ioWaitNanos") {
+      ioWaitNanos_ += counter.value - lastIoWaitNanos_;
+      lastIoWaitNanos_ = counter.value;
+    }
+    if (UNLIKELY(lockedStats->runtimeStats.count(name) == 0)) {
+      lockedStats->runtimeStats.insert(
+          std::make_pair(name, RuntimeMetric(counter.unit)));
+    } else {
+      VELOX_CHECK_EQ(lockedStats->runtimeStats.at(name).unit, counter.unit);
+    }
+    lockedStats->runtimeStats.at(name).addValue(counter.value);
+  }
+}
+
 void TableScan::preload(std::shared_ptr<connector::ConnectorSplit> split) {
   // The AsyncSource returns a unique_ptr to the shared_ptr of the
   // DataSource. The callback may outlive the Task, hence it captures
@@ -221,6 +251,7 @@ void TableScan::preload(std::shared_ptr<connector::ConnectorSplit> split) {
        ctx = operatorCtx_->createConnectorQueryCtx(
            split->connectorId, planNodeId(), connectorPool_),
        task = operatorCtx_->task(),
+       openTime = splitOpenTime_,
        split]() -> std::unique_ptr<connector::DataSource> {
         if (task->isCancelled()) {
           return nullptr;
@@ -233,11 +264,13 @@ void TableScan::preload(std::shared_ptr<connector::ConnectorSplit> split) {
              },
              &debugString});
 
+        const auto startMicros = getCurrentTimeMicro();
         auto ptr = connector->createDataSource(type, table, columns, ctx.get());
         if (task->isCancelled()) {
           return nullptr;
         }
         ptr->addSplit(split);
+        openTime->add(getCurrentTimeMicro() - startMicros);
         return ptr;
       });
 }
@@ -245,12 +278,12 @@ void TableScan::preload(std::shared_ptr<connector::ConnectorSplit> split) {
 void TableScan::checkPreload() {
   auto executor = connector_->executor();
   if (FLAGS_split_preload_per_driver == 0 || !executor ||
-      !connector_->supportsSplitPreload()) {
+      !connector_->supportsSplitPreload() || rowLimit_.has_value()) {
     return;
   }
   if (dataSource_->allPrefetchIssued()) {
     maxPreloadedSplits_ = driverCtx_->task->numDrivers(driverCtx_->driver) *
-        FLAGS_split_preload_per_driver;
+        splitPreloadPerDriver();
     if (!splitPreloader_) {
       splitPreloader_ =
           [executor, this](std::shared_ptr<connector::ConnectorSplit> split) {
@@ -265,6 +298,33 @@ void TableScan::checkPreload() {
   }
 }
 
+int32_t TableScan::splitPreloadPerDriver() const {
+  const auto numOpened = splitOpenTime_->count.load();
+  if (numFinishedSplits_ == 0 || numOpened == 0) {
+    return FLAGS_split_preload_per_driver;
+  }
+  return preloadDepth(
+      splitOpenTime_->totalMicros.load() / numOpened,
+      totalSplitMicros_ / numFinishedSplits_,
+      FLAGS_split_preload_per_driver);
+}
+
+// static
+int32_t TableScan::preloadDepth(
+    uint64_t openMicros,
+    uint64_t splitMicros,
+    int32_t maxDepth) {
+  if (maxDepth <= 1) {
+    return maxDepth;
+  }
+  // While a driver processes a split, the next 'depth' splits of the driver
+  // are opening. They are ready in time if 'depth' splits take as long as an
+  // open.
+  splitMicros = std::max<uint64_t>(splitMicros, 1);
+  const auto depth = (openMicros + splitMicros - 1) / splitMicros;
+  return std::clamp<uint64_t>(depth, 1, maxDepth);
+}
+
 bool TableScan::isFinished() {
   return noMoreSplits_;
 }
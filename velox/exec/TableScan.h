@@ -49,6 +49,14 @@ class TableScan : public SourceOperator {
       column_index_t outputChannel,
       const std::shared_ptr<common::Filter>& filter) override;
 
+  /// Sets the number of rows after which the consumer needs no more rows,
+  /// e.g. the count plus offset of a Limit right above the scan. Passed to
+  /// the DataSource as a hint. Splits are not preloaded and the scan
+  /// finishes once it has returned 'limit' rows.
+  void setRowLimit(uint64_t limit) {
+    rowLimit_ = limit;
+  }
+
   /// Returns process-wide cumulative IO wait time for all table
   /// scan. This is the blocked time. If running entirely from memory
   /// this would be 0.
@@ -56,6 +64,12 @@ class TableScan : public SourceOperator {
     return ioWaitNanos_;
   }
 
+  /// Returns the number of splits to preload per driver so that a split is
+  /// open by the time the driver needs it, given the average time to open a
+  /// split and to process one. Between 1 and 'maxDepth'.
+  static int32_t
+  preloadDepth(uint64_t openMicros, uint64_t splitMicros, int32_t maxDepth);
+
  private:
   // Sets 'maxPreloadSplits' and 'splitPreloader' if prefetching
   // splits is appropriate. The preloader will be applied to the
@@ -63,6 +77,15 @@ class TableScan : public SourceOperator {
   // when getting splits.
   void checkPreload();
 
+  // Returns the number of splits to preload per driver, up to
+  // FLAGS_split_preload_per_driver, from the observed split open and
+  // processing times.
+  int32_t splitPreloadPerDriver() const;
+
+  // Adds the runtime stats of 'dataSource_' to the stats of 'this'. Called
+  // once when the scan finishes.
+  void addConnectorStats();
+
   // Sets 'split->dataSource' to be a Asyncsource that makes a
   // DataSource to read 'split'. This source will be prepared in the
   // background on the executor of the connector. If the DataSource is
@@ -107,6 +130,29 @@ class TableScan : public SourceOperator {
 
   int32_t readBatchSize_;
 
+  // See setRowLimit().
+  std::optional<uint64_t> rowLimit_;
+  uint64_t numOutputRows_{0};
+
+  // Time to make a DataSource for a split and add the split to it. Updated
+  // by preloads on the executor of the connector.
+  struct SplitOpenTime {
+    std::atomic<uint64_t> totalMicros{0};
+    std::atomic<uint64_t> count{0};
+
+    void add(uint64_t micros) {
+      totalMicros += micros;
+      ++count;
+    }
+  };
+  const std::shared_ptr<SplitOpenTime> splitOpenTime_;
+
+  // Wall time from adding a split to finishing it, summed over the finished
+  // splits of 'this'.
+  uint64_t splitStartMicros_{0};
+  uint64_t totalSplitMicros_{0};
+  uint64_t numFinishedSplits_{0};
+
   // String shown in ExceptionContext inside DataSource and LazyVector loading.
   std::string debugString_;
 
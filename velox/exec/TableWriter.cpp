@@ -40,7 +40,10 @@ TableWriter::TableWriter(
           tableWriteNode->insertTableHandle()->connectorId())),
       insertTableHandle_(
           tableWriteNode->insertTableHandle()->connectorInsertTableHandle()),
-      commitStrategy_(tableWriteNode->commitStrategy()) {
+      commitStrategy_(tableWriteNode->commitStrategy()),
+      writerSpillEnabled_(
+          driverCtx->queryConfig().spillEnabled() &&
+          driverCtx->queryConfig().writerSpillEnabled()) {
   if (tableWriteNode->outputType()->size() == 1) {
     VELOX_USER_CHECK_NULL(tableWriteNode->aggregationNode());
   } else {
@@ -101,7 +104,12 @@ void TableWriter::addInput(RowVectorPtr input) {
   if (!dataSink_) {
     createDataSink();
   }
-  dataSink_->appendData(mappedInput);
+  {
+    // The file writers can't be flushed by the memory arbitrator while they
+    // are writing.
+    NonReclaimableSection guard(this);
+    dataSink_->appendData(mappedInput);
+  }
   numWrittenRows_ += input->size();
   updateWrittenBytes();
 
@@ -202,6 +210,30 @@ std::string TableWriter::createTableCommitContext(bool lastOutput) {
   // clang-format on
 }
 
+bool TableWriter::canReclaim() const {
+  return writerSpillEnabled_ && dataSink_ != nullptr && dataSink_->canReclaim();
+}
+
+bool TableWriter::reclaimableBytes(uint64_t& reclaimableBytes) const {
+  reclaimableBytes = 0;
+  if (!canReclaim() || closed_) {
+    return false;
+  }
+  reclaimableBytes = connectorPool_->currentBytes();
+  return true;
+}
+
+void TableWriter::reclaim(uint64_t targetBytes) {
+  VELOX_CHECK(canReclaim());
+  if (closed_ || nonReclaimableSection_) {
+    LOG(WARNING) << "Can't reclaim from table writer, closed_[" << closed_
+                 << "], nonReclaimableSection_[" << nonReclaimableSection_
+                 << "], " << toString();
+    return;
+  }
+  dataSink_->reclaim(targetBytes);
+}
+
 void TableWriter::updateWrittenBytes() {
   const auto writtenBytes = dataSink_->getCompletedBytes();
   auto lockedStats = stats_.wlock();
@@ -138,6 +138,16 @@ class TableWriter : public Operator {
     return finished_;
   }
 
+  /// The file writers of the data sink hold most of the memory of a table
+  /// writer. They are reclaimable before close() if the query enables writer
+  /// spilling and the data sink supports flushing them early.
+  bool canReclaim() const override;
+
+  /// Reports the memory of the data sink as reclaimable.
+  bool reclaimableBytes(uint64_t& reclaimableBytes) const override;
+
+  void reclaim(uint64_t targetBytes) override;
+
  private:
   void createDataSink();
 
@@ -157,6 +167,7 @@ class TableWriter : public Operator {
   std::unique_ptr<connector::DataSink> dataSink_;
   std::vector<column_index_t> inputMapping_;
   std::shared_ptr<const RowType> mappedType_;
+  const bool writerSpillEnabled_;
 
   bool finished_{false};
   bool closed_{false};
@@ -257,6 +257,11 @@ Task::Task(
       planFragment_(std::move(planFragment)),
       destination_(destination),
       queryCtx_(std::move(queryCtx)),
+      traceTimeline_(
+          queryCtx_->queryConfig().taskTraceTimelineCapacity() > 0
+              ? std::make_shared<process::TraceTimeline>(
+                    queryCtx_->queryConfig().taskTraceTimelineCapacity())
+              : nullptr),
       consumerSupplier_(std::move(consumerSupplier)),
       onError_(onError),
       splitsStates_(buildSplitStates(planFragment_.planNode)),
@@ -307,12 +312,20 @@ bool Task::allNodesReceivedNoMoreSplitsMessageLocked() const {
 }
 
 void Task::removeSpillDirectoryIfExists() {
-  if (!spillDirectory_.empty()) {
+  if (spillDirectory_.empty()) {
+    return;
+  }
+  std::vector<std::string> directories{spillDirectory_};
+  directories.insert(
+      directories.end(),
+      extraSpillDirectories_.begin(),
+      extraSpillDirectories_.end());
+  for (const auto& directory : directories) {
     try {
-      auto fs = filesystems::getFileSystem(spillDirectory_, nullptr);
-      fs->rmdir(spillDirectory_);
+      auto fs = filesystems::getFileSystem(directory, nullptr);
+      fs->rmdir(directory);
     } catch (const std::exception& e) {
-      LOG(ERROR) << "Failed to remove spill directory '" << spillDirectory_
+      LOG(ERROR) << "Failed to remove spill directory '" << directory
                  << "' for Task " << taskId() << ": " << e.what();
     }
   }
@@ -557,6 +570,7 @@ void Task::start(
       std::unique_lock<std::mutex> l(self->mutex_);
       VELOX_CHECK(self->drivers_.empty());
       self->concurrentSplitGroups_ = concurrentSplitGroups;
+      self->targetSplitGroups_ = concurrentSplitGroups;
       self->taskStats_.executionStartTimeMs = getCurrentTimeMs();
 
 #if CODEGEN_ENABLED == 1
@@ -569,6 +583,7 @@ void Task::start(
         auto lazyLoading = config.codegenLazyLoading();
         codegen.initializeFromFile(
             config.codegenConfigurationFilePath(), lazyLoading);
+        codegen.setAsyncCompilation(config.codegenAsyncCompilation());
         if (auto newPlanNode =
                 codegen.compile(*(self->planFragment_.planNode))) {
           self->planFragment_.planNode = newPlanNode;
@@ -884,6 +899,8 @@ void Task::createDriversLocked(
   noMoreLocalExchangeProducers(splitGroupId);
   if (groupedExecutionDrivers) {
     ++numRunningSplitGroups_;
+    maxRunningSplitGroups_ =
+        std::max(maxRunningSplitGroups_, numRunningSplitGroups_);
   }
 
   // Initialize operator stats using the 1st driver of each operator.
@@ -949,6 +966,7 @@ void Task::removeDriver(std::shared_ptr<Task> self, Driver* driver) {
       if (splitGroupState.numRunningDrivers == 0) {
         if (splitGroupId != kUngroupedGroupId) {
           --self->numRunningSplitGroups_;
+          self->adjustSplitGroupConcurrencyLocked();
           self->taskStats_.completedSplitGroups.emplace(splitGroupId);
           stateChangeNotifier.activate(std::move(self->stateChangePromises_));
           splitGroupState.clear();
@@ -979,6 +997,27 @@ void Task::removeDriver(std::shared_ptr<Task> self, Driver* driver) {
   }
 }
 
+void Task::adjustSplitGroupConcurrencyLocked() {
+  if (targetSplitGroups_ >= concurrentSplitGroups_ ||
+      maxRunningSplitGroups_ == 0) {
+    return;
+  }
+  const auto splitGroupBytes = pool_->peakBytes() / maxRunningSplitGroups_;
+  const auto* root = pool_->root();
+  if (root->maxCapacity() - root->currentBytes() > splitGroupBytes) {
+    ++targetSplitGroups_;
+  }
+}
+
+void Task::reduceSplitGroupConcurrency() {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (numDriversPerSplitGroup_ == 0) {
+    return;
+  }
+  targetSplitGroups_ = std::max<uint32_t>(
+      1, std::min(targetSplitGroups_, numRunningSplitGroups_) / 2);
+}
+
 void Task::ensureSplitGroupsAreBeingProcessedLocked(
     std::shared_ptr<Task>& self) {
   // Only try creating more drivers if we are running.
@@ -986,7 +1025,7 @@ void Task::ensureSplitGroupsAreBeingProcessedLocked(
     return;
   }
 
-  while (numRunningSplitGroups_ < concurrentSplitGroups_ and
+  while (numRunningSplitGroups_ < targetSplitGroups_ and
          not queuedSplitGroups_.empty()) {
     const uint32_t splitGroupId = queuedSplitGroups_.front();
     queuedSplitGroups_.pop();
@@ -1943,6 +1982,7 @@ std::string Task::toJsonString() const {
   obj["groupedPartitionedOutput"] = groupedPartitionedOutput_;
   obj["concurrentSplitGroups"] = concurrentSplitGroups_;
   obj["numRunningSplitGroups"] = numRunningSplitGroups_;
+  obj["targetSplitGroups"] = targetSplitGroups_;
   obj["numDriversUngrouped"] = numDriversUngrouped_;
   obj["partitionedOutputConsumed"] = partitionedOutputConsumed_;
   obj["noMoreOutputBuffers"] = noMoreOutputBuffers_;
@@ -2242,6 +2282,11 @@ StopReason Task::enterSuspended(ThreadState& state) {
   return StopReason::kNone;
 }
 
+void Task::addMemoryArbitrationTime(uint64_t timeUs) {
+  std::lock_guard<std::mutex> l(mutex_);
+  taskStats_.memoryArbitrationTimeUs += timeUs;
+}
+
 StopReason Task::leaveSuspended(ThreadState& state) {
   VELOX_CHECK(!state.hasBlockingFuture);
   VELOX_CHECK(state.isOnThread());
@@ -2416,6 +2461,7 @@ uint64_t Task::MemoryReclaimer::reclaim(
   if (task->isCancelled()) {
     return 0;
   }
+  task->reduceSplitGroupConcurrency();
   return memory::MemoryReclaimer::reclaim(pool, targetBytes);
 }
 
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #pragma once
+#include "velox/common/process/TraceTimeline.h"
 #include "velox/core/PlanFragment.h"
 #include "velox/core/QueryCtx.h"
 #include "velox/exec/Driver.h"
@@ -72,6 +73,12 @@ class Task : public std::enable_shared_from_this<Task> {
     spillDirectory_ = spillDirectory;
   }
 
+  /// Specify directories in addition to the spill directory, e.g. on other
+  /// disks, over which the spill files are striped.
+  void setExtraSpillDirectories(std::vector<std::string> directories) {
+    extraSpillDirectories_ = std::move(directories);
+  }
+
   std::string toString() const;
 
   std::string toJsonString() const;
@@ -99,6 +106,19 @@ class Task : public std::enable_shared_from_this<Task> {
     return queryCtx_;
   }
 
+  /// Returns the trace timeline of the task or nullptr if the
+  /// 'task_trace_timeline_capacity' query config is 0. Drivers of the task
+  /// record into it.
+  const std::shared_ptr<process::TraceTimeline>& traceTimeline() const {
+    return traceTimeline_;
+  }
+
+  /// Returns the trace timeline in the Chrome trace event format or an empty
+  /// string if the task has no timeline.
+  std::string traceTimelineJson() const {
+    return traceTimeline_ ? traceTimeline_->toChromeTraceJson(taskId_) : "";
+  }
+
   /// Returns MemoryPool used to allocate memory during execution. This instance
   /// is a child of the MemoryPool passed in the constructor.
   memory::MemoryPool* pool() const {
@@ -257,6 +277,17 @@ class Task : public std::enable_shared_from_this<Task> {
   /// Returns time (ms) since the task execution ended or zero, if not finished.
   uint64_t timeSinceEndMs() const;
 
+  /// Adds 'cpuNanos' of CPU time spent by a Driver of this task on a thread.
+  void addDriverCpuNanos(uint64_t cpuNanos) {
+    driverCpuNanos_ += cpuNanos;
+  }
+
+  /// Returns the total CPU time spent by the Drivers of this task on
+  /// threads. Used to lower the executor priority of long running tasks.
+  uint64_t driverCpuNanos() const {
+    return driverCpuNanos_;
+  }
+
   /// Returns the total number of drivers in the output pipeline, e.g. the
   /// pipeline that produces the results.
   uint32_t numOutputDrivers() const {
@@ -500,6 +531,10 @@ class Task : public std::enable_shared_from_this<Task> {
 
   StopReason leaveSuspended(ThreadState& state);
 
+  /// Adds 'timeUs' to the time the drivers of this task spent in memory
+  /// arbitration, including the wait for other arbitrations to finish.
+  void addMemoryArbitrationTime(uint64_t timeUs);
+
   /// Returns a stop reason without synchronization. If the stop reason
   /// is yield, then atomically decrements the count of threads that
   /// are to yield.
@@ -571,6 +606,10 @@ class Task : public std::enable_shared_from_this<Task> {
     return spillDirectory_;
   }
 
+  const std::vector<std::string>& extraSpillDirectories() const {
+    return extraSpillDirectories_;
+  }
+
   /// True if produces output via PartitionedOutputBufferManager.
   bool hasPartitionedOutput() const {
     return numDriversInPartitionedOutput_ > 0;
@@ -733,6 +772,16 @@ class Task : public std::enable_shared_from_this<Task> {
   /// processed. If yes, creates split group state and Drivers and runs them.
   void ensureSplitGroupsAreBeingProcessedLocked(std::shared_ptr<Task>& self);
 
+  /// Called when a split group finishes. Raises 'targetSplitGroups_' by one if
+  /// it is below 'concurrentSplitGroups_' and the query memory has room for
+  /// another split group of the size observed so far.
+  void adjustSplitGroupConcurrencyLocked();
+
+  /// Called when memory is reclaimed from this task. Halves the number of
+  /// split groups to run at the same time so that grouped execution does not
+  /// keep triggering memory arbitration.
+  void reduceSplitGroupConcurrency();
+
   void driverClosedLocked();
 
   /// Returns true if Task is in kRunning state, but all output drivers finished
@@ -855,6 +904,7 @@ class Task : public std::enable_shared_from_this<Task> {
   core::PlanFragment planFragment_;
   const int destination_;
   const std::shared_ptr<core::QueryCtx> queryCtx_;
+  const std::shared_ptr<process::TraceTimeline> traceTimeline_;
 
   // Root MemoryPool for this Task. All member variables that hold references
   // to pool_ must be defined after pool_, childPools_.
@@ -946,6 +996,15 @@ class Task : public std::enable_shared_from_this<Task> {
   /// How many splits groups we are processing at the moment. Used to control
   /// split group concurrency. Ungrouped Split Group is not included here.
   uint32_t numRunningSplitGroups_{0};
+  /// The number of split groups to run at the same time, between 1 and
+  /// 'concurrentSplitGroups_'. Starts at 'concurrentSplitGroups_', is lowered
+  /// when memory is reclaimed from the task and raised again as split groups
+  /// finish with enough free memory.
+  uint32_t targetSplitGroups_{1};
+  /// The most split groups that have run at the same time. Together with the
+  /// peak memory of the task, gives an estimate of the memory a split group
+  /// uses.
+  uint32_t maxRunningSplitGroups_{0};
   /// Split groups for which we have received at least one split - meaning our
   /// task is to process these. This set only grows. Used to deduplicate split
   /// groups for different nodes and to determine how many split groups we to
@@ -993,6 +1052,7 @@ class Task : public std::enable_shared_from_this<Task> {
   std::atomic<bool> pauseRequested_{false};
   std::atomic<bool> terminateRequested_{false};
   std::atomic<int32_t> toYield_ = 0;
+  std::atomic<uint64_t> driverCpuNanos_{0};
   int32_t numThreads_ = 0;
   // Microsecond real time when 'this' last went from no threads to
   // one thread running. Used to decide if continuous run should be
@@ -1005,6 +1065,9 @@ class Task : public std::enable_shared_from_this<Task> {
 
   // Base spill directory for this task.
   std::string spillDirectory_;
+
+  // Spill directories for this task in addition to 'spillDirectory_'.
+  std::vector<std::string> extraSpillDirectories_;
 };
 
 /// Listener invoked on task completion.
@@ -91,6 +91,10 @@ struct TaskStats {
   double outputBufferUtilization{0};
   /// Indicates if output buffer is over-utilized and thus blocks the producers.
   bool outputBufferOverutilized{false};
+
+  /// Time the drivers spent in memory arbitration for growing the memory of
+  /// the task, including the wait for other arbitrations to finish.
+  uint64_t memoryArbitrationTimeUs{0};
 };
 
 } // namespace facebook::velox::exec
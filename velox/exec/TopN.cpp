@@ -15,9 +15,23 @@
  */
 #include "velox/exec/TopN.h"
 #include "velox/exec/ContainerRowSerde.h"
+#include "velox/exec/OperatorUtils.h"
 #include "velox/vector/FlatVector.h"
 
 namespace facebook::velox::exec {
+namespace {
+std::unique_ptr<RowContainer> makeRowContainer(
+    const RowTypePtr& internalStoreType,
+    size_t numKeys,
+    memory::MemoryPool* pool) {
+  const auto& types = internalStoreType->children();
+  return std::make_unique<RowContainer>(
+      std::vector<TypePtr>(types.begin(), types.begin() + numKeys),
+      std::vector<TypePtr>(types.begin() + numKeys, types.end()),
+      pool);
+}
+} // namespace
+
 TopN::TopN(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -27,21 +41,45 @@ TopN::TopN(
           topNNode->outputType(),
           operatorId,
           topNNode->id(),
-          "TopN"),
+          "TopN",
+          topNNode->canSpill(driverCtx->queryConfig())
+              ? driverCtx->makeSpillConfig(operatorId)
+              : std::nullopt),
       count_(topNNode->count()),
-      data_(std::make_unique<RowContainer>(outputType_->children(), pool())),
+      columnMap_(keyColumnsFirst(outputType_, topNNode->sortingKeys())),
+      internalStoreType_(projectRowType(outputType_, columnMap_)),
+      data_(makeRowContainer(
+          internalStoreType_,
+          topNNode->sortingKeys().size(),
+          pool())),
       comparator_(
-          outputType_,
+          internalStoreType_,
           topNNode->sortingKeys(),
           topNNode->sortingOrders(),
           data_.get()),
       topRows_(comparator_),
-      decodedVectors_(outputType_->children().size()) {}
+      decodedVectors_(outputType_->children().size()) {
+  keyCompareFlags_.reserve(topNNode->sortingOrders().size());
+  for (const auto& sortOrder : topNNode->sortingOrders()) {
+    keyCompareFlags_.push_back(
+        {sortOrder.isNullsFirst(),
+         sortOrder.isAscending(),
+         false,
+         CompareFlags::NullHandlingMode::NoStop});
+  }
+}
 
 void TopN::addInput(RowVectorPtr input) {
+  ensureInputFits(input);
+
+  // Prevents the memory arbitrator to reclaim memory from this operator during
+  // the execution below.
+  NonReclaimableSection guard(this);
+
   // TODO Decode keys first, then decode the rest only for passing positions
-  for (auto col = 0; col < input->childrenSize(); ++col) {
-    decodedVectors_[col].decode(*input->childAt(col));
+  for (const auto& projection : columnMap_) {
+    decodedVectors_[projection.inputChannel].decode(
+        *input->childAt(projection.outputChannel));
   }
 
   for (auto row = 0; row < input->size(); ++row) {
@@ -59,7 +97,7 @@ void TopN::addInput(RowVectorPtr input) {
       newRow = data_->initializeRow(topRow, true /* reuse */);
     }
 
-    for (auto col = 0; col < input->childrenSize(); ++col) {
+    for (auto col = 0; col < decodedVectors_.size(); ++col) {
       data_->store(decodedVectors_[col], row, newRow, col);
     }
 
@@ -67,11 +105,89 @@ void TopN::addInput(RowVectorPtr input) {
   }
 }
 
+void TopN::ensureInputFits(const RowVectorPtr& input) {
+  // Check if spilling is enabled or not.
+  if (!spillConfig_.has_value()) {
+    return;
+  }
+
+  // Once 'count_' rows are collected, the input rows only replace existing
+  // rows and need no new fixed size space.
+  const vector_size_t numNewRows = std::min<int64_t>(
+      input->size(), std::max<int64_t>(0, count_ - data_->numRows()));
+  // NOTE: the top rows are spilled together as a sorted run as the heap
+  // order doesn't allow to spill a part of them.
+  if (shouldSpillToFitInput(
+          *data_,
+          numNewRows,
+          input->estimateFlatSize(),
+          0,
+          spillConfig_.value(),
+          spillTestCounter_,
+          pool())) {
+    spill();
+  }
+}
+
+void TopN::reclaim(uint64_t /*targetBytes*/) {
+  VELOX_CHECK(canReclaim());
+
+  // NOTE: a topN operator is reclaimable if it hasn't started output
+  // processing and is not under non-reclaimable execution section.
+  if (noMoreInput_ || nonReclaimableSection_) {
+    LOG(WARNING) << "Can't reclaim from topN operator, noMoreInput_["
+                 << noMoreInput_ << "], nonReclaimableSection_["
+                 << nonReclaimableSection_ << "], " << toString();
+    return;
+  }
+
+  spill();
+  // Release the minimum reserved memory.
+  pool()->release();
+}
+
+void TopN::spill() {
+  if (topRows_.empty()) {
+    return;
+  }
+
+  ++numSpillRuns_;
+  if (spiller_ == nullptr) {
+    const auto& spillConfig = spillConfig_.value();
+    spiller_ = std::make_unique<Spiller>(
+        Spiller::Type::kOrderBy,
+        data_.get(),
+        [&](folly::Range<char**> rows) { data_->eraseRows(rows); },
+        internalStoreType_,
+        data_->keyTypes().size(),
+        keyCompareFlags_,
+        spillConfig.filePath,
+        spillConfig.maxFileSize,
+        spillConfig.minSpillRunSize,
+        spillConfig.compressionKind,
+        Spiller::pool(),
+        spillConfig.executor,
+        spillConfig.extraFilePaths);
+    VELOX_CHECK_EQ(spiller_->state().maxPartitions(), 1);
+  }
+  spiller_->spill(0, 0);
+  VELOX_CHECK_EQ(data_->numRows(), 0);
+  data_->clear();
+  topRows_ = decltype(topRows_)(comparator_);
+}
+
 RowVectorPtr TopN::getOutput() {
   if (finished_ || !noMoreInput_) {
     return nullptr;
   }
 
+  if (spillMerge_ != nullptr) {
+    return getOutputWithSpill();
+  }
+  return getOutputWithoutSpill();
+}
+
+RowVectorPtr TopN::getOutputWithoutSpill() {
   const auto numRowsToReturn = std::min<vector_size_t>(
       outputBatchSize_, rows_.size() - numRowsReturned_);
   VELOX_CHECK_GT(numRowsToReturn, 0);
@@ -79,20 +195,99 @@ RowVectorPtr TopN::getOutput() {
   auto result = BaseVector::create<RowVector>(
       outputType_, numRowsToReturn, operatorCtx_->pool());
 
-  for (auto i = 0; i < outputType_->size(); ++i) {
+  for (const auto& projection : columnMap_) {
     data_->extractColumn(
         rows_.data() + numRowsReturned_,
         numRowsToReturn,
-        i,
-        result->childAt(i));
+        projection.inputChannel,
+        result->childAt(projection.outputChannel));
   }
   numRowsReturned_ += numRowsToReturn;
   finished_ = (numRowsReturned_ == rows_.size());
   return result;
 }
 
+RowVectorPtr TopN::getOutputWithSpill() {
+  const auto maxOutputRows =
+      std::min<vector_size_t>(outputBatchSize_, count_ - numRowsReturned_);
+  VELOX_CHECK_GT(maxOutputRows, 0);
+
+  auto result = BaseVector::create<RowVector>(
+      outputType_, maxOutputRows, operatorCtx_->pool());
+
+  // The merged sorted runs may have more rows than 'count_' in total. Only
+  // the first 'count_' rows are returned.
+  int32_t outputRow = 0;
+  int32_t outputSize = 0;
+  bool isEndOfBatch = false;
+  while (outputRow + outputSize < maxOutputRows) {
+    SpillMergeStream* stream = spillMerge_->next();
+    if (stream == nullptr) {
+      break;
+    }
+
+    spillSources_[outputSize] = &stream->current();
+    spillSourceRows_[outputSize] = stream->currentIndex(&isEndOfBatch);
+    ++outputSize;
+    if (FOLLY_UNLIKELY(isEndOfBatch)) {
+      // The stream is at end of input batch. Need to copy out the rows before
+      // fetching next batch in 'pop'.
+      gatherCopy(
+          result.get(),
+          outputRow,
+          outputSize,
+          spillSources_,
+          spillSourceRows_,
+          columnMap_);
+      outputRow += outputSize;
+      outputSize = 0;
+    }
+
+    // Advance the stream.
+    stream->pop();
+  }
+
+  if (FOLLY_LIKELY(outputSize != 0)) {
+    gatherCopy(
+        result.get(),
+        outputRow,
+        outputSize,
+        spillSources_,
+        spillSourceRows_,
+        columnMap_);
+    outputRow += outputSize;
+  }
+
+  numRowsReturned_ += outputRow;
+  finished_ = (numRowsReturned_ == count_) || (outputRow < maxOutputRows);
+  if (finished_) {
+    spillMerge_.reset();
+  }
+  if (outputRow == 0) {
+    return nullptr;
+  }
+  result->resize(outputRow);
+  return result;
+}
+
 void TopN::noMoreInput() {
   Operator::noMoreInput();
+
+  if (spiller_ != nullptr) {
+    outputBatchSize_ = outputBatchRows(data_->estimateRowSize());
+    // Spill the remaining top rows so that the output is produced by merging
+    // the sorted runs.
+    spill();
+    Spiller::SpillRows nonSpilledRows = spiller_->finishSpill();
+    VELOX_CHECK(nonSpilledRows.empty());
+    Operator::recordSpillStats(spiller_->stats());
+
+    spillMerge_ = spiller_->startMerge(0);
+    spillSources_.resize(outputBatchSize_);
+    spillSourceRows_.resize(outputBatchSize_);
+    return;
+  }
+
   if (topRows_.empty()) {
     finished_ = true;
     return;
@@ -109,4 +304,12 @@ void TopN::noMoreInput() {
 bool TopN::isFinished() {
   return finished_;
 }
+
+void TopN::abort() {
+  Operator::abort();
+
+  spillMerge_.reset();
+  spiller_.reset();
+  data_.reset();
+}
 } // namespace facebook::velox::exec
@@ -17,6 +17,7 @@
 
 #include "velox/exec/Operator.h"
 #include "velox/exec/RowContainer.h"
+#include "velox/exec/Spiller.h"
 
 namespace facebook::velox::exec {
 
@@ -43,12 +44,42 @@ class TopN : public Operator {
 
   bool isFinished() override;
 
+  void reclaim(uint64_t targetBytes) override;
+
+  void abort() override;
+
  private:
+  // Checks if input will fit in the existing memory and increases
+  // reservation if not. If reservation cannot be increased, spills the top
+  // rows collected so far.
+  void ensureInputFits(const RowVectorPtr& input);
+
+  // Spills the top rows collected so far as a sorted run and resets
+  // 'topRows_'. The top 'count_' rows of the whole input are among the top
+  // 'count_' rows of the spilled runs and the rows collected after them, so
+  // no rows outside of 'topRows_' need to be kept. This is called by
+  // ensureInputFits or by external memory management. In the latter case, the
+  // Driver of this will be in a paused state and off thread.
+  void spill();
+
+  RowVectorPtr getOutputWithoutSpill();
+  RowVectorPtr getOutputWithSpill();
+
   const int32_t count_;
 
   bool finished_ = false;
   uint32_t numRowsReturned_ = 0;
 
+  // The map from column channel in the output to the corresponding one stored
+  // in 'data_'. The sorting key columns are stored first.
+  std::vector<IdentityProjection> columnMap_;
+
+  // The row type used to store input data in row container and for spilling
+  // internally.
+  RowTypePtr internalStoreType_;
+
+  std::vector<CompareFlags> keyCompareFlags_;
+
   // As the inputs are added to TopN operator, we use topRows_ (a priority
   // queue) to keep track of the pointers to rows stored in the
   // RowContainer (data_). We only update the RowContainer if a row is a
@@ -58,12 +89,31 @@ class TopN : public Operator {
   // Once all inputs are available, we copy the final set of rows to the
   // vector (rows_) in correct order. We use this vector along with the
   // RowContainer to generate the TopN's output.
+  //
+  // If spilling is triggered, the rows in topRows_ are spilled as a sorted run
+  // and topRows_ starts over. The output is then produced by merging the
+  // sorted runs.
   std::unique_ptr<RowContainer> data_;
   RowComparator comparator_;
   std::priority_queue<char*, std::vector<char*>, RowComparator> topRows_;
   std::vector<char*> rows_;
 
+  // Decoded input columns in the order they are stored in 'data_'.
   std::vector<DecodedVector> decodedVectors_;
   vector_size_t outputBatchSize_;
+
+  std::unique_ptr<Spiller> spiller_;
+
+  // Counts input batches and triggers spilling if folly hash of this % 100 <=
+  // 'testSpillPct_';.
+  uint64_t spillTestCounter_{0};
+
+  // Set to read back the spilled sorted runs if disk spilling has been
+  // triggered.
+  std::unique_ptr<TreeOfLosers<SpillMergeStream>> spillMerge_;
+
+  // Record the source rows to copy to the output in order.
+  std::vector<const RowVector*> spillSources_;
+  std::vector<vector_size_t> spillSourceRows_;
 };
 } // namespace facebook::velox::exec
@@ -14,8 +14,28 @@
  * limitations under the License.
  */
 #include "velox/exec/TopNRowNumber.h"
+#include "velox/exec/OperatorUtils.h"
 
 namespace facebook::velox::exec {
+namespace {
+std::vector<core::FieldAccessTypedExprPtr> partitionAndSortingKeys(
+    const core::TopNRowNumberNode& node) {
+  auto keys = node.partitionKeys();
+  keys.insert(keys.end(), node.sortingKeys().begin(), node.sortingKeys().end());
+  return keys;
+}
+
+std::unique_ptr<RowContainer> makeRowContainer(
+    const RowTypePtr& internalStoreType,
+    size_t numKeys,
+    memory::MemoryPool* pool) {
+  const auto& types = internalStoreType->children();
+  return std::make_unique<RowContainer>(
+      std::vector<TypePtr>(types.begin(), types.begin() + numKeys),
+      std::vector<TypePtr>(types.begin() + numKeys, types.end()),
+      pool);
+}
+} // namespace
 
 TopNRowNumber::TopNRowNumber(
     int32_t operatorId,
@@ -26,13 +46,22 @@ TopNRowNumber::TopNRowNumber(
           node->outputType(),
           operatorId,
           node->id(),
-          "TopNRowNumber"),
+          "TopNRowNumber",
+          node->canSpill(driverCtx->queryConfig())
+              ? driverCtx->makeSpillConfig(operatorId)
+              : std::nullopt),
       limit_{node->limit()},
       generateRowNumber_{node->generateRowNumber()},
       inputType_{node->sources()[0]->outputType()},
-      data_(std::make_unique<RowContainer>(inputType_->children(), pool())),
+      columnMap_{keyColumnsFirst(inputType_, partitionAndSortingKeys(*node))},
+      internalStoreType_{projectRowType(inputType_, columnMap_)},
+      numPartitionKeys_{node->partitionKeys().size()},
+      data_(makeRowContainer(
+          internalStoreType_,
+          numPartitionKeys_ + node->sortingKeys().size(),
+          pool())),
       comparator_(
-          inputType_,
+          internalStoreType_,
           node->sortingKeys(),
           node->sortingOrders(),
           data_.get()),
@@ -40,6 +69,19 @@ TopNRowNumber::TopNRowNumber(
   const auto& keys = node->partitionKeys();
   const auto numKeys = keys.size();
 
+  spillCompareFlags_.reserve(numKeys + node->sortingKeys().size());
+  for (auto i = 0; i < numKeys; ++i) {
+    spillCompareFlags_.push_back(
+        {true, true, false, CompareFlags::NullHandlingMode::NoStop});
+  }
+  for (const auto& sortOrder : node->sortingOrders()) {
+    spillCompareFlags_.push_back(
+        {sortOrder.isNullsFirst(),
+         sortOrder.isAscending(),
+         false,
+         CompareFlags::NullHandlingMode::NoStop});
+  }
+
   if (numKeys > 0) {
     Accumulator accumulator{true, sizeof(TopRows), false, 1, [](auto) {}};
 
@@ -71,10 +113,17 @@ TopNRowNumber::TopNRowNumber(
 }
 
 void TopNRowNumber::addInput(RowVectorPtr input) {
+  ensureInputFits(input);
+
+  // Prevents the memory arbitrator to reclaim memory from this operator during
+  // the execution below.
+  NonReclaimableSection guard(this);
+
   const auto numInput = input->size();
 
-  for (auto i = 0; i < inputType_->size(); ++i) {
-    decodedVectors_[i].decode(*input->childAt(i));
+  for (const auto& projection : columnMap_) {
+    decodedVectors_[projection.inputChannel].decode(
+        *input->childAt(projection.outputChannel));
   }
 
   if (table_) {
@@ -130,13 +179,85 @@ void TopNRowNumber::processInputRow(
     newRow = data_->initializeRow(topRow, true /* reuse */);
   }
 
-  for (auto col = 0; col < input->childrenSize(); ++col) {
+  for (auto col = 0; col < decodedVectors_.size(); ++col) {
     data_->store(decodedVectors_[col], index, newRow, col);
   }
 
   topRows.push(newRow);
 }
 
+void TopNRowNumber::ensureInputFits(const RowVectorPtr& input) {
+  // Check if spilling is enabled or not.
+  if (!spillConfig_.has_value()) {
+    return;
+  }
+
+  if (shouldSpillToFitInput(
+          *data_,
+          input->size(),
+          input->estimateFlatSize(),
+          table_ ? table_->hashTableSizeIncrease(input->size()) : 0,
+          spillConfig_.value(),
+          spillTestCounter_,
+          pool())) {
+    spill();
+  }
+}
+
+void TopNRowNumber::reclaim(uint64_t /*targetBytes*/) {
+  VELOX_CHECK(canReclaim());
+
+  // NOTE: a topN row number operator is reclaimable if it hasn't started
+  // output processing and is not under non-reclaimable execution section.
+  if (noMoreInput_ || nonReclaimableSection_) {
+    LOG(WARNING) << "Can't reclaim from topN row number operator, noMoreInput_["
+                 << noMoreInput_ << "], nonReclaimableSection_["
+                 << nonReclaimableSection_ << "], " << toString();
+    return;
+  }
+
+  spill();
+  // Release the minimum reserved memory.
+  pool()->release();
+}
+
+void TopNRowNumber::spill() {
+  if (data_->numRows() == 0) {
+    return;
+  }
+
+  ++numSpillRuns_;
+  if (spiller_ == nullptr) {
+    const auto& spillConfig = spillConfig_.value();
+    spiller_ = std::make_unique<Spiller>(
+        Spiller::Type::kOrderBy,
+        data_.get(),
+        [&](folly::Range<char**> rows) { data_->eraseRows(rows); },
+        internalStoreType_,
+        data_->keyTypes().size(),
+        spillCompareFlags_,
+        spillConfig.filePath,
+        spillConfig.maxFileSize,
+        spillConfig.minSpillRunSize,
+        spillConfig.compressionKind,
+        Spiller::pool(),
+        spillConfig.executor,
+        spillConfig.extraFilePaths);
+    VELOX_CHECK_EQ(spiller_->state().maxPartitions(), 1);
+  }
+  spiller_->spill(0, 0);
+  VELOX_CHECK_EQ(data_->numRows(), 0);
+  data_->clear();
+
+  // All the partitions start over.
+  if (table_) {
+    destroyPartitions();
+    table_->clear();
+  } else {
+    singlePartition_ = std::make_unique<TopRows>(allocator_.get(), comparator_);
+  }
+}
+
 void TopNRowNumber::noMoreInput() {
   Operator::noMoreInput();
 
@@ -146,6 +267,22 @@ void TopNRowNumber::noMoreInput() {
   }
 
   outputBatchSize_ = outputBatchRows(rowSize);
+
+  if (spiller_ != nullptr) {
+    // Spill the remaining top rows so that the output is produced by merging
+    // the sorted runs. 'data_' is then only used to hold the first row of the
+    // current partition.
+    spill();
+    Spiller::SpillRows nonSpilledRows = spiller_->finishSpill();
+    VELOX_CHECK(nonSpilledRows.empty());
+    Operator::recordSpillStats(spiller_->stats());
+
+    spillMerge_ = spiller_->startMerge(0);
+    spillSources_.resize(outputBatchSize_);
+    spillSourceRows_.resize(outputBatchSize_);
+    return;
+  }
+
   outputRows_.resize(outputBatchSize_);
 }
 
@@ -214,6 +351,10 @@ RowVectorPtr TopNRowNumber::getOutput() {
     return nullptr;
   }
 
+  if (spillMerge_ != nullptr) {
+    return getOutputFromSpill();
+  }
+
   // Loop over partitions and emit sorted rows along with row numbers.
   auto output =
       BaseVector::create<RowVector>(outputType_, outputBatchSize_, pool());
@@ -267,10 +408,122 @@ RowVectorPtr TopNRowNumber::getOutput() {
   }
   output->resize(offset);
 
-  for (int i = 0; i < inputType_->size(); ++i) {
-    data_->extractColumn(outputRows_.data(), offset, i, output->childAt(i));
+  for (const auto& projection : columnMap_) {
+    data_->extractColumn(
+        outputRows_.data(),
+        offset,
+        projection.inputChannel,
+        output->childAt(projection.outputChannel));
+  }
+
+  return output;
+}
+
+bool TopNRowNumber::isNewSpillPartition(
+    SpillMergeStream& stream,
+    vector_size_t index) {
+  if (spillPartitionRow_ == nullptr) {
+    return true;
+  }
+  for (auto i = 0; i < numPartitionKeys_; ++i) {
+    if (data_->compare(
+            spillPartitionRow_,
+            data_->columnAt(i),
+            stream.decoded(i),
+            index,
+            spillCompareFlags_[i])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+RowVectorPtr TopNRowNumber::getOutputFromSpill() {
+  auto output =
+      BaseVector::create<RowVector>(outputType_, outputBatchSize_, pool());
+  FlatVector<int64_t>* rowNumbers = nullptr;
+  if (generateRowNumber_) {
+    rowNumbers = output->children().back()->as<FlatVector<int64_t>>();
+    rowNumbers->resize(outputBatchSize_);
+  }
+
+  // The merged sorted runs may have more than 'limit_' rows for a partition
+  // as each run has up to 'limit_' rows of it. Only the first 'limit_' rows
+  // are returned.
+  int32_t outputRow = 0;
+  int32_t outputSize = 0;
+  bool isEndOfBatch = false;
+  while (outputRow + outputSize < outputBatchSize_) {
+    SpillMergeStream* stream = spillMerge_->next();
+    if (stream == nullptr) {
+      break;
+    }
+
+    const auto index = stream->currentIndex(&isEndOfBatch);
+    if (isNewSpillPartition(*stream, index)) {
+      // Keep a copy of the first row of the partition as the stream may
+      // move to its next batch before the end of the partition.
+      spillPartitionRow_ = spillPartitionRow_ == nullptr
+          ? data_->newRow()
+          : data_->initializeRow(spillPartitionRow_, true /* reuse */);
+      for (auto i = 0; i < internalStoreType_->size(); ++i) {
+        data_->store(stream->decoded(i), index, spillPartitionRow_, i);
+      }
+      numSpillPartitionRows_ = 0;
+    }
+
+    if (numSpillPartitionRows_ < limit_) {
+      ++numSpillPartitionRows_;
+      spillSources_[outputSize] = &stream->current();
+      spillSourceRows_[outputSize] = index;
+      if (rowNumbers) {
+        rowNumbers->set(outputRow + outputSize, numSpillPartitionRows_);
+      }
+      ++outputSize;
+    }
+
+    if (FOLLY_UNLIKELY(isEndOfBatch)) {
+      // The stream is at end of input batch. Need to copy out the rows before
+      // fetching next batch in 'pop'.
+      gatherCopy(
+          output.get(),
+          outputRow,
+          outputSize,
+          spillSources_,
+          spillSourceRows_,
+          columnMap_);
+      outputRow += outputSize;
+      outputSize = 0;
+    }
+
+    // Advance the stream.
+    stream->pop();
+  }
+
+  if (outputSize != 0) {
+    gatherCopy(
+        output.get(),
+        outputRow,
+        outputSize,
+        spillSources_,
+        spillSourceRows_,
+        columnMap_);
+    outputRow += outputSize;
   }
 
+  if (outputRow < outputBatchSize_) {
+    // No more spilled rows.
+    finished_ = true;
+    spillMerge_.reset();
+    if (outputRow == 0) {
+      return nullptr;
+    }
+  }
+
+  if (rowNumbers) {
+    rowNumbers->resize(outputRow);
+  }
+  output->resize(outputRow);
   return output;
 }
 
@@ -280,19 +533,25 @@ bool TopNRowNumber::isFinished() {
 
 void TopNRowNumber::close() {
   if (table_) {
-    partitionIt_.reset();
-    partitions_.resize(1000);
-    while (auto numPartitions = table_->listAllRows(
-               &partitionIt_,
-               partitions_.size(),
-               RowContainer::kUnlimited,
-               partitions_.data())) {
-      for (auto i = 0; i < numPartitions; ++i) {
-        std::destroy_at(
-            reinterpret_cast<TopRows*>(partitions_[i] + partitionOffset_));
-      }
+    destroyPartitions();
+  }
+}
+
+void TopNRowNumber::destroyPartitions() {
+  partitionIt_.reset();
+  partitions_.resize(1000);
+  while (auto numPartitions = table_->listAllRows(
+             &partitionIt_,
+             partitions_.size(),
+             RowContainer::kUnlimited,
+             partitions_.data())) {
+    for (auto i = 0; i < numPartitions; ++i) {
+      std::destroy_at(
+          reinterpret_cast<TopRows*>(partitions_[i] + partitionOffset_));
     }
   }
+  partitionIt_.reset();
+  partitions_.resize(kPartitionBatchSize);
 }
 
 } // namespace facebook::velox::exec
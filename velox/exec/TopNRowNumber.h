@@ -17,6 +17,7 @@
 
 #include "velox/exec/HashTable.h"
 #include "velox/exec/Operator.h"
+#include "velox/exec/Spiller.h"
 
 namespace facebook::velox::exec {
 
@@ -34,6 +35,11 @@ namespace facebook::velox::exec {
 ///
 /// This is an optimized version of a Window operator with a single row_number
 /// window function followed by a row_number <= N filter.
+///
+/// If spilling is triggered, the top rows of all partitions collected so far
+/// are spilled as a run sorted by partitioning and sorting keys and the
+/// partitions start over. The output is then produced by merging the sorted
+/// runs and returning up to 'limit' rows of each partition.
 class TopNRowNumber : public Operator {
  public:
   TopNRowNumber(
@@ -59,6 +65,8 @@ class TopNRowNumber : public Operator {
 
   void close() override;
 
+  void reclaim(uint64_t targetBytes) override;
+
  private:
   /// A priority queue to keep track of top 'limit' rows for a given partition.
   struct TopRows {
@@ -83,6 +91,27 @@ class TopNRowNumber : public Operator {
     return *reinterpret_cast<TopRows*>(group + partitionOffset_);
   }
 
+  // Destroys the TopRows structs of all the partitions in 'table_'.
+  void destroyPartitions();
+
+  // Checks if input will fit in the existing memory and increases
+  // reservation if not. If reservation cannot be increased, spills the top
+  // rows collected so far.
+  void ensureInputFits(const RowVectorPtr& input);
+
+  // Spills the top rows of all partitions as a single sorted run and clears
+  // the partitions. This is called by ensureInputFits or by external memory
+  // management. In the latter case, the Driver of this will be in a paused
+  // state and off thread.
+  void spill();
+
+  // Produces the next output batch from the merged spilled runs.
+  RowVectorPtr getOutputFromSpill();
+
+  // Returns true if the 'index'th row of 'stream' starts a new partition,
+  // e.g. its partitioning keys differ from those of 'spillPartitionRow_'.
+  bool isNewSpillPartition(SpillMergeStream& stream, vector_size_t index);
+
   /// Adds input row to a partition or discards the row.
   void processInputRow(
       const RowVectorPtr& input,
@@ -121,11 +150,25 @@ class TopNRowNumber : public Operator {
   std::unique_ptr<HashStringAllocator> allocator_;
   std::unique_ptr<TopRows> singlePartition_;
 
+  /// The map from column channel in the input to the corresponding one stored
+  /// in 'data_'. The partitioning and sorting key columns are stored first.
+  const std::vector<IdentityProjection> columnMap_;
+
+  /// The row type used to store input data in row container and for
+  /// spilling internally.
+  const RowTypePtr internalStoreType_;
+
+  const size_t numPartitionKeys_;
+
+  /// Compare flags of the partitioning and sorting keys for spilling.
+  std::vector<CompareFlags> spillCompareFlags_;
+
   /// Stores row data. For each partition, only up to 'limit' rows are stored.
   std::unique_ptr<RowContainer> data_;
 
   RowComparator comparator_;
 
+  /// Decoded input columns in the order they are stored in 'data_'.
   std::vector<DecodedVector> decodedVectors_;
 
   bool finished_{false};
@@ -143,5 +186,26 @@ class TopNRowNumber : public Operator {
   size_t numPartitions_{0};
   std::optional<int32_t> currentPartition_;
   vector_size_t remainingRowsInPartition_{0};
+
+  std::unique_ptr<Spiller> spiller_;
+
+  /// Counts input batches and triggers spilling if folly hash of this % 100 <=
+  /// 'testSpillPct'.
+  uint64_t spillTestCounter_{0};
+
+  /// Set to read back the spilled sorted runs if disk spilling has been
+  /// triggered.
+  std::unique_ptr<TreeOfLosers<SpillMergeStream>> spillMerge_;
+
+  /// Record the source rows to copy to the output in order.
+  std::vector<const RowVector*> spillSources_;
+  std::vector<vector_size_t> spillSourceRows_;
+
+  /// A copy of the first row of the partition being read from the merged
+  /// spilled runs, stored in 'data_'. Used to detect partition boundaries.
+  char* spillPartitionRow_{nullptr};
+
+  /// Number of rows of the current spilled partition added to the output.
+  vector_size_t numSpillPartitionRows_{0};
 };
 } // namespace facebook::velox::exec
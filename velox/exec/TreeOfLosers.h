@@ -357,4 +357,106 @@ class MergeArray {
   std::vector<std::unique_ptr<Stream>> streams_;
 };
 
+// Merging structure for streams whose first values are ordered by a single
+// uint64_t key, e.g. a fixed width key or a normalized key prefix that fully
+// orders the values. Implements the same interface as TreeOfLosers. The keys
+// of the first values of all streams are kept in a contiguous array that is
+// scanned with SIMD compares to find the lowest key, so that a step over many
+// streams costs a few vector instructions instead of a virtual comparison per
+// level of a tree. In addition to the Stream methods used by TreeOfLosers,
+// Stream must have a 'uint64_t key() const' method that returns the key of its
+// first value. key() is only called after hasData() returned true.
+template <typename Stream>
+class KeyMergeArray {
+ public:
+  using Batch = xsimd::batch<uint64_t>;
+
+  explicit KeyMergeArray(std::vector<std::unique_ptr<Stream>> streams)
+      : streams_(std::move(streams)) {
+    static_assert(std::is_base_of_v<MergeStream, Stream>);
+    VELOX_CHECK_GE(streams_.size(), 1);
+    // The tail of the last batch is padded with empty keys.
+    keys_.resize(bits::roundUp(streams_.size(), Batch::size), kEmptyKey);
+    for (auto i = 0; i < streams_.size(); ++i) {
+      updateKey(i);
+    }
+  }
+
+  // Returns the stream with the lowest first element. The caller is
+  // expected to pop off the first element of the stream before
+  // calling this again. Returns nullptr when all streams are at end.
+  Stream* next() {
+    if (lastIndex_ != kNoStream) {
+      updateKey(lastIndex_);
+    }
+    uint64_t minKey;
+    lastIndex_ = findMin(minKey);
+    return lastIndex_ == kNoStream ? nullptr : streams_[lastIndex_].get();
+  }
+
+  // Returns the stream with the lowest first element and the lowest key of
+  // the first elements of the other streams. The caller may pop off all
+  // consecutive elements of the stream with a key that is not greater than
+  // the returned key before calling this again. Returns {nullptr, 0} when all
+  // streams are at end.
+  std::pair<Stream*, uint64_t> nextRun() {
+    auto* stream = next();
+    if (stream == nullptr) {
+      return {nullptr, 0};
+    }
+    auto key = keys_[lastIndex_];
+    keys_[lastIndex_] = kEmptyKey;
+    uint64_t bound;
+    findMin(bound);
+    keys_[lastIndex_] = key;
+    return {stream, bound};
+  }
+
+ private:
+  static constexpr uint64_t kEmptyKey = std::numeric_limits<uint64_t>::max();
+  static constexpr int32_t kNoStream = -1;
+
+  void updateKey(int32_t index) {
+    keys_[index] = streams_[index]->hasData() ? streams_[index]->key()
+                                              : kEmptyKey;
+  }
+
+  // Returns the index of the first stream with the lowest key and sets
+  // 'minKey' to the key. Returns kNoStream and sets 'minKey' to kEmptyKey if
+  // all streams are at end.
+  int32_t findMin(uint64_t& minKey) const {
+    auto minBatch = Batch::load_unaligned(keys_.data());
+    for (auto i = Batch::size; i < keys_.size(); i += Batch::size) {
+      auto batch = Batch::load_unaligned(keys_.data() + i);
+      minBatch = xsimd::select(batch < minBatch, batch, minBatch);
+    }
+    alignas(sizeof(Batch)) uint64_t lanes[Batch::size];
+    minBatch.store_aligned(lanes);
+    minKey = *std::min_element(lanes, lanes + Batch::size);
+    if (UNLIKELY(minKey == kEmptyKey)) {
+      // Either all streams are at end or the lowest key is the largest
+      // value of uint64_t, which is also the key of an empty stream.
+      for (auto i = 0; i < streams_.size(); ++i) {
+        if (streams_[i]->hasData()) {
+          return i;
+        }
+      }
+      return kNoStream;
+    }
+    const auto target = Batch::broadcast(minKey);
+    for (auto i = 0;; i += Batch::size) {
+      auto mask =
+          simd::toBitMask(Batch::load_unaligned(keys_.data() + i) == target);
+      if (mask) {
+        return i + __builtin_ctz(mask);
+      }
+    }
+  }
+
+  std::vector<std::unique_ptr<Stream>> streams_;
+  // Key of the first element of each stream, kEmptyKey for streams at end.
+  std::vector<uint64_t> keys_;
+  int32_t lastIndex_{kNoStream};
+};
+
 } // namespace facebook::velox
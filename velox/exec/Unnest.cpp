@@ -58,51 +58,44 @@ Unnest::Unnest(
 
 void Unnest::addInput(RowVectorPtr input) {
   input_ = std::move(input);
-}
-
-RowVectorPtr Unnest::getOutput() {
-  if (!input_) {
-    return nullptr;
-  }
+  nextInputRow_ = 0;
+  nextElement_ = 0;
 
   auto size = input_->size();
   inputRows_.resize(size);
 
   // The max number of elements at each row across all unnested columns.
-  auto maxSizes = AlignedBuffer::allocate<int64_t>(size, pool(), 0);
-  auto rawMaxSizes = maxSizes->asMutable<int64_t>();
+  maxSizes_ = AlignedBuffer::allocate<int64_t>(size, pool(), 0);
+  auto* rawMaxSizes = maxSizes_->asMutable<int64_t>();
+  rawMaxSizes_ = rawMaxSizes;
 
-  std::vector<const vector_size_t*> rawSizes;
-  std::vector<const vector_size_t*> rawOffsets;
-  std::vector<const vector_size_t*> rawIndices;
-
-  rawSizes.resize(unnestChannels_.size());
-  rawOffsets.resize(unnestChannels_.size());
-  rawIndices.resize(unnestChannels_.size());
+  rawSizes_.resize(unnestChannels_.size());
+  rawOffsets_.resize(unnestChannels_.size());
+  rawIndices_.resize(unnestChannels_.size());
 
   for (auto channel = 0; channel < unnestChannels_.size(); ++channel) {
     const auto& unnestVector = input_->childAt(unnestChannels_[channel]);
     unnestDecoded_[channel].decode(*unnestVector, inputRows_);
 
     auto& currentDecoded = unnestDecoded_[channel];
-    rawIndices[channel] = currentDecoded.indices();
+    rawIndices_[channel] = currentDecoded.indices();
 
     const ArrayVector* unnestBaseArray;
     const MapVector* unnestBaseMap;
     if (unnestVector->typeKind() == TypeKind::ARRAY) {
       unnestBaseArray = currentDecoded.base()->as<ArrayVector>();
-      rawSizes[channel] = unnestBaseArray->rawSizes();
-      rawOffsets[channel] = unnestBaseArray->rawOffsets();
+      rawSizes_[channel] = unnestBaseArray->rawSizes();
+      rawOffsets_[channel] = unnestBaseArray->rawOffsets();
     } else {
       VELOX_CHECK(unnestVector->typeKind() == TypeKind::MAP);
       unnestBaseMap = currentDecoded.base()->as<MapVector>();
-      rawSizes[channel] = unnestBaseMap->rawSizes();
-      rawOffsets[channel] = unnestBaseMap->rawOffsets();
+      rawSizes_[channel] = unnestBaseMap->rawSizes();
+      rawOffsets_[channel] = unnestBaseMap->rawOffsets();
     }
 
     // Count max number of elements per row.
-    auto currentSizes = rawSizes[channel];
-    auto currentIndices = rawIndices[channel];
+    auto currentSizes = rawSizes_[channel];
+    auto currentIndices = rawIndices_[channel];
     for (auto row = 0; row < size; ++row) {
       if (!currentDecoded.isNullAt(row)) {
         auto unnestSize = currentSizes[currentIndices[row]];
@@ -112,15 +105,41 @@ RowVectorPtr Unnest::getOutput() {
       }
     }
   }
+}
 
-  // Calculate the number of rows in the unnest result.
-  int numElements = 0;
-  for (auto row = 0; row < size; ++row) {
-    numElements += rawMaxSizes[row];
+vector_size_t Unnest::outputRange(
+    vector_size_t maxOutputRows,
+    int32_t& lastRow,
+    int64_t& lastRowEnd) const {
+  vector_size_t numElements = 0;
+  lastRow = nextInputRow_;
+  lastRowEnd = nextElement_;
+  for (auto row = nextInputRow_; row < input_->size(); ++row) {
+    const auto start = row == nextInputRow_ ? nextElement_ : 0;
+    const auto count = std::min<int64_t>(
+        rawMaxSizes_[row] - start, maxOutputRows - numElements);
+    numElements += count;
+    lastRow = row;
+    lastRowEnd = start + count;
+    if (numElements == maxOutputRows) {
+      break;
+    }
   }
+  return numElements;
+}
 
+RowVectorPtr Unnest::getOutput() {
+  if (!input_) {
+    return nullptr;
+  }
+
+  const auto firstRow = nextInputRow_;
+  int32_t lastRow;
+  int64_t lastRowEnd;
+  const auto numElements =
+      outputRange(adaptiveOutputBatchRows(), lastRow, lastRowEnd);
   if (numElements == 0) {
-    // All arrays/maps are null or empty.
+    // The remaining arrays/maps are null or empty.
     input_ = nullptr;
     return nullptr;
   }
@@ -130,8 +149,9 @@ RowVectorPtr Unnest::getOutput() {
   auto repeatedIndices = allocateIndices(numElements, pool());
   auto* rawRepeatedIndices = repeatedIndices->asMutable<vector_size_t>();
   vector_size_t index = 0;
-  for (auto row = 0; row < size; ++row) {
-    for (auto i = 0; i < rawMaxSizes[row]; i++) {
+  for (auto row = firstRow; row <= lastRow; ++row) {
+    const auto [start, end] = elementRange(row, lastRow, lastRowEnd);
+    for (auto i = start; i < end; i++) {
       rawRepeatedIndices[index++] = row;
     }
   }
@@ -147,9 +167,9 @@ RowVectorPtr Unnest::getOutput() {
   vector_size_t outputsIndex = identityProjections_.size();
   for (auto channel = 0; channel < unnestChannels_.size(); ++channel) {
     auto& currentDecoded = unnestDecoded_[channel];
-    auto currentSizes = rawSizes[channel];
-    auto currentOffsets = rawOffsets[channel];
-    auto currentIndices = rawIndices[channel];
+    auto currentSizes = rawSizes_[channel];
+    auto currentOffsets = rawOffsets_[channel];
+    auto currentIndices = rawIndices_[channel];
 
     BufferPtr elementIndices = allocateIndices(numElements, pool());
     auto* rawElementIndices = elementIndices->asMutable<vector_size_t>();
@@ -158,59 +178,65 @@ RowVectorPtr Unnest::getOutput() {
         AlignedBuffer::allocate<bool>(numElements, pool(), bits::kNotNull);
     auto rawNulls = nulls->asMutable<uint64_t>();
 
-    // Make dictionary index for elements column since they may be out of order.
+    // Make dictionary index for elements column since they may be out of
+    // order. If the elements of the range are consecutive and have no nulls
+    // added the output is a slice of the elements vector, starting at
+    // 'firstElement'.
     index = 0;
-    bool identityMapping = true;
-    for (auto row = 0; row < size; ++row) {
-      auto maxSize = rawMaxSizes[row];
+    bool contiguous = true;
+    vector_size_t firstElement = 0;
+    for (auto row = firstRow; row <= lastRow; ++row) {
+      const auto [start, end] = elementRange(row, lastRow, lastRowEnd);
 
       if (!currentDecoded.isNullAt(row)) {
         auto offset = currentOffsets[currentIndices[row]];
         auto unnestSize = currentSizes[currentIndices[row]];
-
-        if (index != offset || unnestSize < maxSize) {
-          identityMapping = false;
+        if (end > start) {
+          if (index == 0) {
+            firstElement = offset + start;
+          }
+          if (firstElement + index != offset + start || unnestSize < end) {
+            contiguous = false;
+          }
         }
 
-        for (auto i = 0; i < unnestSize; i++) {
+        for (auto i = start; i < std::min<int64_t>(unnestSize, end); i++) {
           rawElementIndices[index++] = offset + i;
         }
 
-        for (auto i = unnestSize; i < maxSize; ++i) {
+        for (auto i = std::max<int64_t>(unnestSize, start); i < end; ++i) {
           bits::setNull(rawNulls, index++, true);
         }
-      } else if (maxSize > 0) {
-        identityMapping = false;
+      } else if (end > start) {
+        contiguous = false;
 
-        for (auto i = 0; i < maxSize; ++i) {
+        for (auto i = start; i < end; ++i) {
           bits::setNull(rawNulls, index++, true);
         }
       }
     }
 
+    auto unnestColumn = [&](const VectorPtr& elements) {
+      if (!contiguous) {
+        return wrapChild(numElements, elementIndices, elements, nulls);
+      }
+      if (firstElement == 0 && elements->size() == numElements) {
+        return elements;
+      }
+      return elements->slice(firstElement, numElements);
+    };
+
     if (currentDecoded.base()->typeKind() == TypeKind::ARRAY) {
       // Construct unnest column using Array elements wrapped using above
       // created dictionary.
       auto unnestBaseArray = currentDecoded.base()->as<ArrayVector>();
-      outputs[outputsIndex++] = identityMapping
-          ? unnestBaseArray->elements()
-          : wrapChild(
-                numElements,
-                elementIndices,
-                unnestBaseArray->elements(),
-                nulls);
+      outputs[outputsIndex++] = unnestColumn(unnestBaseArray->elements());
     } else {
       // Construct two unnest columns for Map keys and values vectors wrapped
       // using above created dictionary.
       auto unnestBaseMap = currentDecoded.base()->as<MapVector>();
-      outputs[outputsIndex++] = identityMapping
-          ? unnestBaseMap->mapKeys()
-          : wrapChild(
-                numElements, elementIndices, unnestBaseMap->mapKeys(), nulls);
-      outputs[outputsIndex++] = identityMapping
-          ? unnestBaseMap->mapValues()
-          : wrapChild(
-                numElements, elementIndices, unnestBaseMap->mapValues(), nulls);
+      outputs[outputsIndex++] = unnestColumn(unnestBaseMap->mapKeys());
+      outputs[outputsIndex++] = unnestColumn(unnestBaseMap->mapValues());
     }
   }
 
@@ -221,17 +247,26 @@ RowVectorPtr Unnest::getOutput() {
     // Set the ordinality at each result row to be the index of the element in
     // the original array (or map) plus one.
     auto rawOrdinality = ordinalityVector->mutableRawValues();
-    for (auto row = 0; row < size; ++row) {
-      auto maxSize = rawMaxSizes[row];
-      std::iota(rawOrdinality, rawOrdinality + maxSize, 1);
-      rawOrdinality += maxSize;
+    for (auto row = firstRow; row <= lastRow; ++row) {
+      const auto [start, end] = elementRange(row, lastRow, lastRowEnd);
+      std::iota(rawOrdinality, rawOrdinality + end - start, start + 1);
+      rawOrdinality += end - start;
     }
 
     // Ordinality column is always at the end.
     outputs.back() = std::move(ordinalityVector);
   }
 
-  input_ = nullptr;
+  // Continues after the range or with the next input.
+  if (lastRowEnd < rawMaxSizes_[lastRow]) {
+    nextInputRow_ = lastRow;
+    nextElement_ = lastRowEnd;
+  } else if (lastRow + 1 < input_->size()) {
+    nextInputRow_ = lastRow + 1;
+    nextElement_ = 0;
+  } else {
+    input_ = nullptr;
+  }
   return std::make_shared<RowVector>(
       pool(), outputType_, BufferPtr(nullptr), numElements, std::move(outputs));
 }
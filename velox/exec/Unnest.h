@@ -29,21 +29,57 @@ class Unnest : public Operator {
   }
 
   bool needsInput() const override {
-    return true;
+    return input_ == nullptr;
   }
 
   void addInput(RowVectorPtr input) override;
 
+  /// Returns the unnested rows of the next range of rows of 'input_', with at
+  /// most outputBatchRows() rows. A row with more elements than that spans
+  /// several outputs.
   RowVectorPtr getOutput() override;
 
   bool isFinished() override;
 
  private:
+  // Returns the number of output rows for the range of input rows starting
+  // at element 'nextElement_' of row 'nextInputRow_', up to 'maxOutputRows'.
+  // Sets 'lastRow' and 'lastRowEnd' to the last row in the range and the end
+  // of its elements in the output.
+  vector_size_t outputRange(
+      vector_size_t maxOutputRows,
+      int32_t& lastRow,
+      int64_t& lastRowEnd) const;
+
+  // Returns the first element of 'row' and the element after its last one in
+  // the output for the range ending at 'lastRow' and 'lastRowEnd'.
+  std::pair<int64_t, int64_t>
+  elementRange(int32_t row, int32_t lastRow, int64_t lastRowEnd) const {
+    return {
+        row == nextInputRow_ ? nextElement_ : 0,
+        row == lastRow ? lastRowEnd : rawMaxSizes_[row]};
+  }
+
   std::vector<column_index_t> unnestChannels_;
 
   SelectivityVector inputRows_;
   std::vector<DecodedVector> unnestDecoded_;
 
   const bool withOrdinality_;
+
+  // The max number of elements at each row of 'input_' across all unnested
+  // columns.
+  BufferPtr maxSizes_;
+  const int64_t* rawMaxSizes_{nullptr};
+
+  // Sizes, offsets and indices into these of the unnested columns of 'input_'.
+  std::vector<const vector_size_t*> rawSizes_;
+  std::vector<const vector_size_t*> rawOffsets_;
+  std::vector<const vector_size_t*> rawIndices_;
+
+  // The row of 'input_' and the element of that row the next output starts
+  // at.
+  int32_t nextInputRow_{0};
+  int64_t nextElement_{0};
 };
 } // namespace facebook::velox::exec
@@ -16,6 +16,7 @@
 
 #include "velox/exec/VectorHasher.h"
 #include "velox/common/base/BitUtil.h"
+#include "velox/common/base/HashKernels.h"
 #include "velox/common/base/Portability.h"
 #include "velox/common/base/SimdUtil.h"
 #include "velox/common/memory/HashStringAllocator.h"
@@ -64,6 +65,38 @@ uint64_t hashOne(DecodedVector& decoded, vector_size_t index) {
 }
 } // namespace
 
+template <typename T>
+void VectorHasher::hashFlat(
+    const SelectivityVector& rows,
+    bool mix,
+    uint64_t* result) {
+  const auto* selected = rows.isAllSelected() ? nullptr : rows.asRange().bits();
+  auto hashValue = [](T value) { return folly::hasher<T>()(value); };
+  if (mix) {
+    hashing::hashFlat(
+        decoded_.data<T>(),
+        decoded_.nulls(),
+        selected,
+        rows.begin(),
+        rows.end(),
+        result,
+        [&](T value, uint64_t hash) {
+          return bits::hashMix(hash, hashValue(value));
+        },
+        [](uint64_t hash) { return bits::hashMix(hash, kNullHash); });
+  } else {
+    hashing::hashFlat(
+        decoded_.data<T>(),
+        decoded_.nulls(),
+        selected,
+        rows.begin(),
+        rows.end(),
+        result,
+        [&](T value, uint64_t /*hash*/) { return hashValue(value); },
+        [](uint64_t /*hash*/) { return kNullHash; });
+  }
+}
+
 template <TypeKind Kind>
 void VectorHasher::hashValues(
     const SelectivityVector& rows,
@@ -78,6 +111,13 @@ void VectorHasher::hashValues(
       result[row] = mix ? bits::hashMix(result[row], hash) : hash;
     });
   } else if (decoded_.isIdentityMapping()) {
+    // Flat booleans are bits and complex types are hashed by the base vector.
+    if constexpr (
+        std::is_same_v<T, StringView> || std::is_same_v<T, Timestamp> ||
+        (std::is_arithmetic_v<T> && !std::is_same_v<T, bool>)) {
+      hashFlat<T>(rows, mix, result);
+      return;
+    }
     rows.applyToSelected([&](vector_size_t row) {
       if (decoded_.isNullAt(row)) {
         result[row] = mix ? bits::hashMix(result[row], kNullHash) : kNullHash;
@@ -87,8 +127,10 @@ void VectorHasher::hashValues(
       result[row] = mix ? bits::hashMix(result[row], hash) : hash;
     });
   } else {
-    cachedHashes_.resize(decoded_.base()->size());
-    std::fill(cachedHashes_.begin(), cachedHashes_.end(), kNullHash);
+    if (!reuseCachedHashes(CacheKind::kHashes)) {
+      cachedHashes_.resize(decoded_.base()->size());
+      std::fill(cachedHashes_.begin(), cachedHashes_.end(), kNullHash);
+    }
     rows.applyToSelected([&](vector_size_t row) {
       if (decoded_.isNullAt(row)) {
         result[row] = mix ? bits::hashMix(result[row], kNullHash) : kNullHash;
@@ -240,8 +282,10 @@ template <typename T, bool mayHaveNulls>
 bool VectorHasher::makeValueIdsDecoded(
     const SelectivityVector& rows,
     uint64_t* result) {
-  cachedHashes_.resize(decoded_.base()->size());
-  std::fill(cachedHashes_.begin(), cachedHashes_.end(), 0);
+  if (!reuseCachedHashes(CacheKind::kValueIds)) {
+    cachedHashes_.resize(decoded_.base()->size());
+    std::fill(cachedHashes_.begin(), cachedHashes_.end(), 0);
+  }
 
   auto indices = decoded_.indices();
   auto values = decoded_.data<T>();
@@ -317,10 +361,44 @@ bool VectorHasher::makeValueIdsDecoded<bool, false>(
   return true;
 }
 
+void VectorHasher::setCachedBase(const BaseVector& vector) {
+  const VectorPtr* base = nullptr;
+  for (auto* wrapper = &vector;
+       wrapper->encoding() == VectorEncoding::Simple::DICTIONARY;
+       wrapper = base->get()) {
+    base = &wrapper->valueVector();
+  }
+  if (!base || base->get() != decoded_.base() || !(*base)->isFlatEncoding()) {
+    cachedBase_.reset();
+    cacheKind_ = CacheKind::kNone;
+    return;
+  }
+  if (cachedBase_ != *base) {
+    cachedBase_ = *base;
+    cacheKind_ = CacheKind::kNone;
+  }
+}
+
+bool VectorHasher::reuseCachedHashes(CacheKind kind) {
+  if (cachedBase_ && cacheKind_ == kind &&
+      cachedHashes_.size() == cachedBase_->size()) {
+    return true;
+  }
+  cacheKind_ = cachedBase_ ? kind : CacheKind::kNone;
+  return false;
+}
+
 bool VectorHasher::computeValueIds(
     const SelectivityVector& rows,
     raw_vector<uint64_t>& result) {
-  return VALUE_ID_TYPE_DISPATCH(makeValueIds, typeKind_, rows, result.data());
+  const bool success =
+      VALUE_ID_TYPE_DISPATCH(makeValueIds, typeKind_, rows, result.data());
+  if (!success) {
+    // The mapping changes before the next successful call, e.g. the range
+    // grows to cover the new values.
+    clearCachedValueIds();
+  }
+  return success;
 }
 
 bool VectorHasher::computeValueIdsForRows(
@@ -745,6 +823,7 @@ void VectorHasher::cardinality(
 }
 
 uint64_t VectorHasher::enableValueIds(uint64_t multiplier, int32_t reservePct) {
+  clearCachedValueIds();
   VELOX_CHECK_NE(
       typeKind_,
       TypeKind::BOOLEAN,
@@ -762,6 +841,7 @@ uint64_t VectorHasher::enableValueIds(uint64_t multiplier, int32_t reservePct) {
 uint64_t VectorHasher::enableValueRange(
     uint64_t multiplier,
     int32_t reservePct) {
+  clearCachedValueIds();
   multiplier_ = multiplier;
   VELOX_CHECK_LE(0, reservePct);
   VELOX_CHECK(hasRange_);
@@ -781,6 +861,7 @@ uint64_t VectorHasher::enableValueRange(
 }
 
 void VectorHasher::copyStatsFrom(const VectorHasher& other) {
+  clearCachedValueIds();
   hasRange_ = other.hasRange_;
   rangeOverflow_ = other.rangeOverflow_;
   distinctOverflow_ = other.distinctOverflow_;
@@ -791,6 +872,7 @@ void VectorHasher::copyStatsFrom(const VectorHasher& other) {
 }
 
 void VectorHasher::merge(const VectorHasher& other) {
+  clearCachedValueIds();
   if (typeKind_ == TypeKind::BOOLEAN) {
     return;
   }
@@ -171,6 +171,7 @@ class VectorHasher {
         type_->toString(),
         vector.type()->toString());
     decoded_.decode(vector, rows);
+    setCachedBase(vector);
   }
 
   DecodedVector& decodedVector() {
@@ -248,6 +249,7 @@ class VectorHasher {
   void resetStats() {
     uniqueValues_.clear();
     uniqueValuesStorage_.clear();
+    clearCachedValueIds();
   }
 
   // Sets 'this' to range mode and adds 'reservePct' values to the
@@ -528,13 +530,48 @@ class VectorHasher {
   template <TypeKind Kind>
   void hashValues(const SelectivityVector& rows, bool mix, uint64_t* result);
 
+  // Hashes the flat values of 'decoded_' of type T with the loops of
+  // hashing::hashFlat().
+  template <typename T>
+  void hashFlat(const SelectivityVector& rows, bool mix, uint64_t* result);
+
+  // What 'cachedHashes_' holds for the entries of 'cachedBase_'.
+  enum class CacheKind { kNone, kHashes, kValueIds };
+
+  // Sets 'cachedBase_' to the values of 'vector' if 'vector' is a dictionary
+  // over a flat vector. Keeps 'cachedHashes_' if the values are the same as
+  // for the previous input.
+  void setCachedBase(const BaseVector& vector);
+
+  // Returns true if 'cachedHashes_' has 'kind' for the entries of the base of
+  // 'decoded_' from a previous input. Otherwise the caller must reset
+  // 'cachedHashes_' and the entries it fills are kept for the next input
+  // with the same base.
+  bool reuseCachedHashes(CacheKind kind);
+
+  // Called when the value ids of previously seen values may change.
+  void clearCachedValueIds() {
+    if (cacheKind_ == CacheKind::kValueIds) {
+      cacheKind_ = CacheKind::kNone;
+    }
+  }
+
   const column_index_t channel_;
   const TypePtr type_;
   const TypeKind typeKind_;
 
   DecodedVector decoded_;
+  // Hashes or value ids by index into the base of a dictionary encoded input.
   raw_vector<uint64_t> cachedHashes_;
 
+  // The base of the last dictionary encoded input. Consecutive inputs often
+  // share the base, e.g. the batches a table scan reads from the same string
+  // dictionary, so that each distinct value is hashed or mapped to an id once
+  // for all of them instead of once per input. Holding a reference prevents
+  // the base from being reused or changed in place.
+  VectorPtr cachedBase_;
+  CacheKind cacheKind_{CacheKind::kNone};
+
   // Single precomputed hash for constant partition keys.
   uint64_t precomputedHash_{0};
 
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/Window.h"
+#include "velox/common/base/AsyncSource.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
 
@@ -51,11 +52,12 @@ Window::Window(
           windowNode->outputType(),
           operatorId,
           windowNode->id(),
-          "Window"),
+          "Window",
+          windowNode->canSpill(driverCtx->queryConfig())
+              ? driverCtx->makeSpillConfig(operatorId)
+              : std::nullopt),
       numInputColumns_(windowNode->sources()[0]->outputType()->size()),
-      data_(std::make_unique<RowContainer>(
-          windowNode->sources()[0]->outputType()->children(),
-          pool())),
+      inputsSorted_(windowNode->inputsSorted()),
       decodedInputVectors_(numInputColumns_),
       stringAllocator_(pool()) {
   auto inputType = windowNode->sources()[0]->outputType();
@@ -71,9 +73,52 @@ Window::Window(
   allKeyInfo_.insert(
       allKeyInfo_.cend(), sortKeyInfo_.begin(), sortKeyInfo_.end());
 
+  // Store the distinct partition and sort key columns first in the row
+  // container followed by the rest of the input columns. This enables the
+  // spiller to sort the spilled rows by (partition keys + order by keys). A key
+  // column repeated in the keys doesn't change the order so it is only stored
+  // once.
+  std::vector<TypePtr> keyTypes;
+  std::vector<TypePtr> dependentTypes;
+  std::vector<TypePtr> types;
+  std::vector<std::string> names;
+  inputChannelToColumn_.resize(numInputColumns_, kConstantChannel);
+  for (const auto& [channel, sortOrder] : allKeyInfo_) {
+    if (inputChannelToColumn_[channel] != kConstantChannel) {
+      continue;
+    }
+    inputChannelToColumn_[channel] = keyTypes.size();
+    keyTypes.push_back(inputType->childAt(channel));
+    types.push_back(keyTypes.back());
+    names.push_back(inputType->nameOf(channel));
+    spillCompareFlags_.push_back(
+        {sortOrder.isNullsFirst(),
+         sortOrder.isAscending(),
+         false,
+         CompareFlags::NullHandlingMode::NoStop});
+  }
+  for (column_index_t channel = 0; channel < numInputColumns_; ++channel) {
+    if (inputChannelToColumn_[channel] != kConstantChannel) {
+      continue;
+    }
+    inputChannelToColumn_[channel] = types.size();
+    dependentTypes.push_back(inputType->childAt(channel));
+    types.push_back(dependentTypes.back());
+    names.push_back(inputType->nameOf(channel));
+  }
+  data_ = std::make_unique<RowContainer>(keyTypes, dependentTypes, pool());
+  spillRowType_ = ROW(std::move(names), std::move(types));
+
+  // Translate the key channels into the column indices in the row container.
+  for (auto* keyInfo : {&partitionKeyInfo_, &sortKeyInfo_, &allKeyInfo_}) {
+    for (auto& key : *keyInfo) {
+      key.first = inputChannelToColumn_[key.first];
+    }
+  }
+
   std::vector<exec::RowColumn> inputColumns;
   for (int i = 0; i < inputType->children().size(); i++) {
-    inputColumns.push_back(data_->columnAt(i));
+    inputColumns.push_back(data_->columnAt(inputChannelToColumn_[i]));
   }
   // The WindowPartition is structured over all the input columns data.
   // Individual functions access its input argument column values from it.
@@ -140,6 +185,13 @@ void Window::createWindowFunctions(
     const std::shared_ptr<const core::WindowNode>& windowNode,
     const RowTypePtr& inputType,
     const core::QueryConfig& config) {
+  // The functions evaluated in parallel each get their own allocator as
+  // HashStringAllocator is not thread safe.
+  if (config.windowParallelFunctionsMinRows() > 0 &&
+      windowNode->windowFunctions().size() > 1) {
+    parallelFunctionsMinRows_ = config.windowParallelFunctionsMinRows();
+    functionsExecutor_ = operatorCtx_->task()->queryCtx()->executor();
+  }
   for (const auto& windowNodeFunction : windowNode->windowFunctions()) {
     std::vector<WindowFunctionArg> functionArgs;
     functionArgs.reserve(windowNodeFunction.functionCall->inputs().size());
@@ -161,7 +213,7 @@ void Window::createWindowFunctions(
         windowNodeFunction.functionCall->type(),
         windowNodeFunction.ignoreNulls,
         operatorCtx_->pool(),
-        &stringAllocator_,
+        functionStringAllocator(),
         config));
 
     windowFrames_.push_back(
@@ -169,20 +221,228 @@ void Window::createWindowFunctions(
   }
 }
 
+HashStringAllocator* Window::functionStringAllocator() {
+  if (functionsExecutor_ == nullptr) {
+    return &stringAllocator_;
+  }
+  functionStringAllocators_.push_back(
+      std::make_unique<HashStringAllocator>(pool()));
+  return functionStringAllocators_.back().get();
+}
+
 void Window::addInput(RowVectorPtr input) {
+  ensureInputFits(input);
+
+  // Prevents the memory arbitrator to reclaim memory from this operator during
+  // the execution below.
+  NonReclaimableSection guard(this);
+
   for (auto col = 0; col < input->childrenSize(); ++col) {
     decodedInputVectors_[col].decode(*input->childAt(col));
   }
 
   // Add all the rows into the RowContainer.
+  const vector_size_t firstNewRow = sortedRows_.size();
   for (auto row = 0; row < input->size(); ++row) {
     char* newRow = data_->newRow();
 
     for (auto col = 0; col < input->childrenSize(); ++col) {
-      data_->store(decodedInputVectors_[col], row, newRow, col);
+      data_->store(
+          decodedInputVectors_[col], row, newRow, inputChannelToColumn_[col]);
+    }
+    if (inputsSorted_) {
+      sortedRows_.push_back(newRow);
     }
   }
   numRows_ += input->size();
+
+  if (inputsSorted_ && input->size() > 0) {
+    if (peerStartBuffer_ == nullptr) {
+      createPeerAndFrameBuffers();
+    }
+    updatePartitionStartRows(firstNewRow);
+  }
+}
+
+void Window::updatePartitionStartRows(vector_size_t startRow) {
+  VELOX_DCHECK(inputsSorted_);
+  if (startRow == 0) {
+    partitionStartRows_.push_back(0);
+    ++startRow;
+  }
+  // NOTE: the input might be sorted with different null orders than the
+  // partition keys so a partition starts at any change of the key values.
+  for (auto i = startRow; i < sortedRows_.size(); ++i) {
+    for (const auto& key : partitionKeyInfo_) {
+      if (data_->compare(sortedRows_[i - 1], sortedRows_[i], key.first) !=
+          0) {
+        partitionStartRows_.push_back(i);
+        break;
+      }
+    }
+  }
+}
+
+void Window::removeProcessedRows() {
+  VELOX_DCHECK(inputsSorted_);
+  VELOX_CHECK_EQ(numProcessedRows_, partitionStartRows_.back());
+  VELOX_CHECK_EQ(currentPartition_, partitionStartRows_.size() - 1);
+
+  data_->eraseRows(folly::Range(sortedRows_.data(), numProcessedRows_));
+  sortedRows_.erase(
+      sortedRows_.begin(), sortedRows_.begin() + numProcessedRows_);
+  numRows_ -= numProcessedRows_;
+  numProcessedRows_ = 0;
+  currentPartition_ = 0;
+  partitionStartRows_.clear();
+  if (!sortedRows_.empty()) {
+    // The rows of the open partition.
+    partitionStartRows_.push_back(0);
+  }
+}
+
+void Window::ensureInputFits(const RowVectorPtr& input) {
+  // Check if spilling is enabled or not.
+  if (!spillConfig_.has_value()) {
+    return;
+  }
+  int64_t spillBytes{0};
+  if (!shouldSpillToFitInput(
+          *data_,
+          input->size(),
+          input->estimateFlatSize(),
+          0,
+          spillConfig_.value(),
+          spillTestCounter_,
+          pool(),
+          &spillBytes)) {
+    return;
+  }
+
+  // Spills enough of the rows to free 'spillBytes'.
+  const int64_t numRows = data_->numRows();
+  auto [freeRows, outOfLineFreeBytes] = data_->freeSpace();
+  const int64_t outOfLineBytes =
+      data_->stringAllocator().retainedSize() - outOfLineFreeBytes;
+  const int64_t outOfLineBytesPerRow = outOfLineBytes / numRows;
+  const int64_t rowsToSpill = std::max<int64_t>(
+      1, spillBytes / (data_->fixedRowSize() + outOfLineBytesPerRow));
+  spill(
+      std::max<int64_t>(0, numRows - rowsToSpill),
+      std::max<int64_t>(
+          0, outOfLineBytes - (rowsToSpill * outOfLineBytesPerRow)));
+}
+
+void Window::reclaim(uint64_t targetBytes) {
+  VELOX_CHECK(canReclaim());
+
+  // NOTE: a window operator is reclaimable if it hasn't started output
+  // processing and is not under non-reclaimable execution section.
+  if (noMoreInput_ || nonReclaimableSection_) {
+    LOG(WARNING) << "Can't reclaim from window operator, noMoreInput_["
+                 << noMoreInput_ << "], nonReclaimableSection_["
+                 << nonReclaimableSection_ << "], " << toString();
+    return;
+  }
+
+  spill(0, targetBytes);
+  VELOX_CHECK_EQ(data_->numRows(), 0);
+  data_->clear();
+  // Release the minimum reserved memory.
+  pool()->release();
+}
+
+void Window::spill(int64_t targetRows, int64_t targetBytes) {
+  VELOX_CHECK_GE(targetRows, 0);
+  VELOX_CHECK_GE(targetBytes, 0);
+
+  ++numSpillRuns_;
+  if (spiller_ == nullptr) {
+    const auto& spillConfig = spillConfig_.value();
+    spiller_ = std::make_unique<Spiller>(
+        Spiller::Type::kWindow,
+        data_.get(),
+        [&](folly::Range<char**> rows) { data_->eraseRows(rows); },
+        spillRowType_,
+        data_->keyTypes().size(),
+        spillCompareFlags_,
+        spillConfig.filePath,
+        spillConfig.maxFileSize,
+        spillConfig.minSpillRunSize,
+        spillConfig.compressionKind,
+        Spiller::pool(),
+        spillConfig.executor,
+        spillConfig.extraFilePaths);
+    VELOX_CHECK_EQ(spiller_->state().maxPartitions(), 1);
+  }
+  spiller_->spill(targetRows, targetBytes);
+}
+
+void Window::finishSpill() {
+  VELOX_CHECK_NOT_NULL(spiller_);
+  VELOX_CHECK_NULL(spillMerge_);
+
+  // Spill the remaining in-memory rows so that 'data_' can be reused to load
+  // one partition at a time from the merged spilled runs.
+  spiller_->spill(0, 0);
+  Spiller::SpillRows nonSpilledRows = spiller_->finishSpill();
+  VELOX_CHECK(nonSpilledRows.empty());
+  VELOX_CHECK_EQ(data_->numRows(), 0);
+  Operator::recordSpillStats(spiller_->stats());
+
+  spillMerge_ = spiller_->startMerge(0);
+  nextSpillStream_ = spillMerge_->next();
+}
+
+bool Window::isNewPartition(
+    const char* row,
+    SpillMergeStream& stream,
+    vector_size_t index) {
+  for (const auto& key : partitionKeyInfo_) {
+    if (data_->compare(
+            row,
+            data_->columnAt(key.first),
+            stream.decoded(key.first),
+            index,
+            spillCompareFlags_[key.first])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void Window::loadNextSpilledPartition() {
+  VELOX_CHECK_NOT_NULL(nextSpillStream_);
+  data_->clear();
+
+  const char* firstRow = nullptr;
+  while (nextSpillStream_ != nullptr) {
+    const auto index = nextSpillStream_->currentIndex();
+    if (firstRow != nullptr &&
+        isNewPartition(firstRow, *nextSpillStream_, index)) {
+      break;
+    }
+    char* newRow = data_->newRow();
+    for (auto col = 0; col < numInputColumns_; ++col) {
+      data_->store(nextSpillStream_->decoded(col), index, newRow, col);
+    }
+    if (firstRow == nullptr) {
+      firstRow = newRow;
+    }
+    nextSpillStream_->pop();
+    nextSpillStream_ = spillMerge_->next();
+  }
+
+  // The rows of a partition loaded from the spilled data are already sorted.
+  numRows_ = data_->numRows();
+  sortedRows_.resize(numRows_);
+  RowContainerIterator iter;
+  data_->listRows(&iter, numRows_, sortedRows_.data());
+  partitionStartRows_.clear();
+  partitionStartRows_.push_back(0);
+  partitionStartRows_.push_back(numRows_);
+  currentPartition_ = 0;
+  numProcessedRows_ = 0;
 }
 
 inline bool Window::compareRowsWithKeys(
@@ -204,6 +464,37 @@ inline bool Window::compareRowsWithKeys(
   return false;
 }
 
+vector_size_t Window::findPeerGroupEnd(
+    vector_size_t peerStart,
+    vector_size_t end) {
+  // The rows are sorted, so the rows after the peer group of 'peerStart' all
+  // compare greater than it. Gallops over the peer group and then binary
+  // searches its end, which takes O(log(group size)) comparisons instead of
+  // one per row. A single row group takes one comparison.
+  auto isPeer = [&](vector_size_t row) {
+    return !compareRowsWithKeys(
+        sortedRows_[peerStart], sortedRows_[row], sortKeyInfo_);
+  };
+  // 'low' is a peer, 'high' is either 'end' or not a peer.
+  vector_size_t low = peerStart;
+  vector_size_t high = peerStart + 1;
+  int64_t step = 1;
+  while (high < end && isPeer(high)) {
+    low = high;
+    step *= 2;
+    high = std::min<int64_t>(peerStart + step, end);
+  }
+  while (high - low > 1) {
+    const auto middle = low + (high - low) / 2;
+    if (isPeer(middle)) {
+      low = middle;
+    } else {
+      high = middle;
+    }
+  }
+  return high;
+}
+
 void Window::createPeerAndFrameBuffers() {
   // TODO: This computation needs to be revised. It only takes into account
   // the input columns size. We need to also account for the output columns.
@@ -290,8 +581,21 @@ void Window::noMoreInput() {
   // However, some preparation is needed. The rows should be
   // separated into partitions and sort by ORDER BY keys within
   // the partition. This will order the rows for getOutput().
-  sortPartitions();
+  if (inputsSorted_) {
+    // The rows are already sorted and partitioned. Close the last open
+    // partition.
+    partitionStartRows_.push_back(sortedRows_.size());
+    return;
+  }
   createPeerAndFrameBuffers();
+  if (spiller_ != nullptr) {
+    // The spilled rows are sorted by the spiller and loaded back one partition
+    // at a time.
+    finishSpill();
+    loadNextSpilledPartition();
+  } else {
+    sortPartitions();
+  }
 }
 
 void Window::callResetPartition(vector_size_t partitionNumber) {
@@ -471,6 +775,52 @@ void computeValidFrames(
 
 }; // namespace
 
+void Window::parallelApply(
+    const std::vector<VectorPtr>& result,
+    vector_size_t resultOffset) {
+  // The functions only read the partition and the shared peer buffers and
+  // write their own frame buffers, result vectors and allocators, so they
+  // are independent of each other.
+  std::vector<std::shared_ptr<AsyncSource<bool>>> applySteps;
+  auto sync = folly::makeGuard([&]() {
+    // This is executed on returning path, possibly in unwinding, so must not
+    // throw. The steps reference the functions and the result vectors.
+    for (auto& step : applySteps) {
+      try {
+        step->move();
+      } catch (const std::exception& e) {
+        LOG(ERROR) << "Error in parallel window function: " << e.what();
+      }
+    }
+  });
+  for (auto w = 0; w < windowFunctions_.size(); ++w) {
+    applySteps.push_back(std::make_shared<AsyncSource<bool>>(
+        [this, w, &result, resultOffset]() {
+          windowFunctions_[w]->apply(
+              peerStartBuffer_,
+              peerEndBuffer_,
+              frameStartBuffers_[w],
+              frameEndBuffers_[w],
+              validFrames_[w],
+              resultOffset,
+              result[w]);
+          return std::make_unique<bool>(true);
+        }));
+    functionsExecutor_->add([step = applySteps.back()]() { step->prepare(); });
+  }
+  std::exception_ptr error;
+  for (auto& step : applySteps) {
+    try {
+      step->move();
+    } catch (const std::exception&) {
+      error = std::current_exception();
+    }
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
 void Window::callApplyForPartitionRows(
     vector_size_t startRow,
     vector_size_t endRow,
@@ -504,38 +854,32 @@ void Window::callApplyForPartitionRows(
     rawFrameEnds.push_back(rawFrameEnd);
   }
 
-  auto peerCompare = [&](const char* lhs, const char* rhs) -> bool {
-    return compareRowsWithKeys(lhs, rhs, sortKeyInfo_);
-  };
   auto firstPartitionRow = partitionStartRows_[currentPartition_];
   auto lastPartitionRow = partitionStartRows_[currentPartition_ + 1] - 1;
-  for (auto i = startRow, j = 0; i < endRow; i++, j++) {
+  for (auto i = startRow, j = 0; i < endRow;) {
     // When traversing input partition rows, the peers are the rows
     // with the same values for the ORDER BY clause. These rows
     // are equal in some ways and affect the results of ranking functions.
-    // This logic exploits the fact that all rows between the peerStartRow_
-    // and peerEndRow_ have the same values for peerStartRow_ and peerEndRow_.
-    // So we can compute them just once and reuse across the rows in that peer
-    // interval. Note: peerStartRow_ and peerEndRow_ can be maintained across
-    // getOutput calls.
+    // All rows between the peerStartRow_ and peerEndRow_ have the same
+    // values for peerStartRow_ and peerEndRow_, so the peer buffers are
+    // filled a peer group at a time. Note: peerStartRow_ and peerEndRow_ can
+    // be maintained across getOutput calls.
 
     // Compute peerStart and peerEnd rows for the first row of the partition or
     // when past the previous peerGroup.
     if (i == firstPartitionRow || i >= peerEndRow_) {
       peerStartRow_ = i;
-      peerEndRow_ = i;
-      while (peerEndRow_ <= lastPartitionRow) {
-        if (peerCompare(sortedRows_[peerStartRow_], sortedRows_[peerEndRow_])) {
-          break;
-        }
-        peerEndRow_++;
-      }
+      peerEndRow_ = findPeerGroupEnd(i, lastPartitionRow + 1);
     }
 
     // Peer buffer values should be offsets from the start of the partition
     // as WindowFunction only sees one partition at a time.
-    rawPeerStarts[j] = peerStartRow_ - firstPartitionRow;
-    rawPeerEnds[j] = peerEndRow_ - 1 - firstPartitionRow;
+    const auto numPeers = std::min(peerEndRow_, endRow) - i;
+    std::fill_n(rawPeerStarts + j, numPeers, peerStartRow_ - firstPartitionRow);
+    std::fill_n(
+        rawPeerEnds + j, numPeers, peerEndRow_ - 1 - firstPartitionRow);
+    i += numPeers;
+    j += numPeers;
   }
 
   for (auto i = 0; i < numFuncs; i++) {
@@ -576,15 +920,20 @@ void Window::callApplyForPartitionRows(
   }
 
   // Invoke the apply method for the WindowFunctions.
-  for (auto w = 0; w < numFuncs; w++) {
-    windowFunctions_[w]->apply(
-        peerStartBuffer_,
-        peerEndBuffer_,
-        frameStartBuffers_[w],
-        frameEndBuffers_[w],
-        validFrames_[w],
-        resultOffset,
-        result[w]);
+  if (functionsExecutor_ != nullptr &&
+      lastPartitionRow + 1 - firstPartitionRow >= parallelFunctionsMinRows_) {
+    parallelApply(result, resultOffset);
+  } else {
+    for (auto w = 0; w < numFuncs; w++) {
+      windowFunctions_[w]->apply(
+          peerStartBuffer_,
+          peerEndBuffer_,
+          frameStartBuffers_[w],
+          frameEndBuffers_[w],
+          validFrames_[w],
+          resultOffset,
+          result[w]);
+    }
   }
 
   numProcessedRows_ += numRows;
@@ -631,11 +980,21 @@ void Window::callApplyLoop(
 }
 
 RowVectorPtr Window::getOutput() {
-  if (finished_ || !noMoreInput_) {
+  if (finished_ || (!noMoreInput_ && !inputsSorted_)) {
     return nullptr;
   }
 
-  auto numRowsLeft = numRows_ - numProcessedRows_;
+  if (spillMerge_ != nullptr && numProcessedRows_ == numRows_) {
+    loadNextSpilledPartition();
+  }
+
+  // Only the rows of the complete partitions can be output.
+  const vector_size_t numRowsLeft = partitionStartRows_.empty()
+      ? 0
+      : partitionStartRows_.back() - numProcessedRows_;
+  if (numRowsLeft == 0) {
+    return nullptr;
+  }
   auto numOutputRows = std::min(numRowsPerOutput_, numRowsLeft);
   auto result = std::dynamic_pointer_cast<RowVector>(
       BaseVector::create(outputType_, numOutputRows, operatorCtx_->pool()));
@@ -645,7 +1004,7 @@ RowVectorPtr Window::getOutput() {
     data_->extractColumn(
         sortedRows_.data() + numProcessedRows_,
         numOutputRows,
-        i,
+        inputChannelToColumn_[i],
         result->childAt(i));
   }
 
@@ -665,7 +1024,12 @@ RowVectorPtr Window::getOutput() {
     result->childAt(j) = windowOutputs[j - numInputColumns_];
   }
 
-  finished_ = (numProcessedRows_ == sortedRows_.size());
+  finished_ = noMoreInput_ && (numProcessedRows_ == sortedRows_.size()) &&
+      (nextSpillStream_ == nullptr);
+  if (inputsSorted_ && !finished_ &&
+      numProcessedRows_ == partitionStartRows_.back()) {
+    removeProcessedRows();
+  }
   return result;
 }
 
@@ -17,6 +17,7 @@
 
 #include "velox/exec/Operator.h"
 #include "velox/exec/RowContainer.h"
+#include "velox/exec/Spiller.h"
 #include "velox/exec/WindowFunction.h"
 #include "velox/exec/WindowPartition.h"
 
@@ -32,6 +33,19 @@ namespace facebook::velox::exec {
 /// It is also sorted in the order required for the WindowFunction
 /// to process it.
 ///
+/// If spilling is enabled, the input rows are spilled as sorted runs by
+/// (partition_by keys + order_by keys) when the operator runs out of memory.
+/// After all the input has been received, the spilled runs are merged and
+/// the rows are loaded back one partition at a time. So the memory usage is
+/// bounded by the size of the largest partition instead of the whole input.
+///
+/// If the input is already sorted by (partition_by keys + order_by keys), the
+/// sort is skipped and the operator works in streaming mode: the output of a
+/// partition is produced as soon as the first row of the next partition is
+/// received. So the memory usage is bounded by the size of the largest
+/// partition and the first output rows are produced before seeing all the
+/// input.
+///
 /// We will revise this algorithm in the future using a HashTable based
 /// approach pending some profiling results.
 class Window : public Operator {
@@ -46,7 +60,11 @@ class Window : public Operator {
   RowVectorPtr getOutput() override;
 
   bool needsInput() const override {
-    return !noMoreInput_;
+    // In streaming mode, the output of the complete partitions is produced
+    // before accepting more input.
+    return !noMoreInput_ &&
+        (!inputsSorted_ || partitionStartRows_.empty() ||
+         numProcessedRows_ == partitionStartRows_.back());
   }
 
   void noMoreInput() override;
@@ -59,6 +77,8 @@ class Window : public Operator {
     return finished_;
   }
 
+  void reclaim(uint64_t targetBytes) override;
+
  private:
   // Used for k preceding/following frames. Index is the column index if k is a
   // column. value is used to read column values from the column index when k
@@ -87,10 +107,56 @@ class Window : public Operator {
       const RowTypePtr& inputType,
       const core::QueryConfig& config);
 
+  // Checks if input will fit in the existing memory and increases
+  // reservation if not. If reservation cannot be increased, spills enough to
+  // make 'input' fit.
+  void ensureInputFits(const RowVectorPtr& input);
+
+  // Spills content until under 'targetRows' and under 'targetBytes' of out of
+  // line data are left. If 'targetRows' is 0, spills everything and physically
+  // frees the data in the 'data_'.
+  void spill(int64_t targetRows, int64_t targetBytes);
+
+  // Invoked after receiving all the input data if spilling has been triggered.
+  // Spills the remaining in-memory rows, and sets up the sort merge read of
+  // the spilled data.
+  void finishSpill();
+
+  // Clears 'data_' and loads the rows of the next partition from the sort
+  // merge read of the spilled data into it. The loaded rows are already in
+  // the order of (partition keys + order by keys).
+  void loadNextSpilledPartition();
+
+  // Returns true if the row at 'index' of 'stream' doesn't belong to the same
+  // partition as 'row' in 'data_'.
+  bool isNewPartition(
+      const char* row,
+      SpillMergeStream& stream,
+      vector_size_t index);
+
+  // Invoked in streaming mode to find the partition boundaries from the rows
+  // of 'sortedRows_' starting at 'startRow'.
+  void updatePartitionStartRows(vector_size_t startRow);
+
+  // Invoked in streaming mode after the output of all the complete partitions
+  // has been produced. Frees the processed rows from 'data_' and resets the
+  // row indices to start from the open partition.
+  void removeProcessedRows();
+
   // Helper function to create the buffers for peer and frame
   // row indices to send in window function apply invocations.
   void createPeerAndFrameBuffers();
 
+  // Returns the allocator for the next window function created. The
+  // functions share 'stringAllocator_' unless they are evaluated in parallel.
+  HashStringAllocator* functionStringAllocator();
+
+  // Calls WindowFunction::apply of each function on 'functionsExecutor_' and
+  // waits for all of them. The peer and frame buffers are already set.
+  void parallelApply(
+      const std::vector<VectorPtr>& result,
+      vector_size_t resultOffset);
+
   // Function to compute the partitionStartRows_ structure.
   // partitionStartRows_ is vector of the starting rows index
   // of each partition in the data. This is an auxiliary
@@ -129,6 +195,10 @@ class Window : public Operator {
       const char* rhs,
       const std::vector<std::pair<column_index_t, core::SortOrder>>& keys);
 
+  // Returns the first row in 'sortedRows_' after 'peerStart' and up to 'end'
+  // that is not a peer of 'peerStart', or 'end' if there is none.
+  vector_size_t findPeerGroupEnd(vector_size_t peerStart, vector_size_t end);
+
   // Function to compute window function values for the current output
   // buffer. The buffer has numOutputRows number of rows. windowOutputs
   // has the vectors for window function columns.
@@ -162,9 +232,26 @@ class Window : public Operator {
   bool finished_ = false;
   const vector_size_t numInputColumns_;
 
+  // True if the input is sorted by (partition keys + order by keys) and the
+  // operator runs in streaming mode.
+  const bool inputsSorted_;
+
+  // The map from the input column channel to the corresponding column stored
+  // in 'data_'. The partition and sort key columns are stored first in 'data_'
+  // which allows to sort the spilled rows by these keys.
+  std::vector<column_index_t> inputChannelToColumn_;
+
+  // The row type used to store input data in 'data_' and for spilling.
+  RowTypePtr spillRowType_;
+
+  // The compare flags of the key columns in 'data_' used to sort spilled rows.
+  std::vector<CompareFlags> spillCompareFlags_;
+
   // The Window operator needs to see all the input rows before starting
   // any function computation. As the Window operators gets input rows
-  // we store the rows in the RowContainer (data_).
+  // we store the rows in the RowContainer (data_). If spilling has been
+  // triggered, 'data_' holds one partition loaded from the spilled data at a
+  // time during the output processing.
   std::unique_ptr<RowContainer> data_;
 
   // The decodedInputVectors_ are reused across addInput() calls to decode
@@ -175,8 +262,16 @@ class Window : public Operator {
   // buffers.
   HashStringAllocator stringAllocator_;
 
-  // The below 3 vectors represent the ChannelIndex of the partition keys,
-  // the order by keys and the concatenation of the 2. These keyInfo are
+  // Set if the window functions of the partitions of at least
+  // 'parallelFunctionsMinRows_' rows are evaluated in parallel, one function
+  // per thread. Each function then has its own allocator in
+  // 'functionStringAllocators_'.
+  folly::Executor* functionsExecutor_{nullptr};
+  vector_size_t parallelFunctionsMinRows_{0};
+  std::vector<std::unique_ptr<HashStringAllocator>> functionStringAllocators_;
+
+  // The below 3 vectors represent the column index in 'data_' of the partition
+  // keys, the order by keys and the concatenation of the 2. These keyInfo are
   // used for sorting by those key combinations during the processing.
   // partitionKeyInfo_ is used to separate partitions in the rows.
   // sortKeyInfo_ is used to identify peer rows in a partition.
@@ -196,7 +291,8 @@ class Window : public Operator {
   // It represents the frame spec for the function computation.
   std::vector<WindowFrame> windowFrames_;
 
-  // Number of input rows.
+  // Number of input rows. If spilling has been triggered, it is the number of
+  // rows of the partition currently loaded in 'data_'.
   vector_size_t numRows_ = 0;
 
   // Vector of pointers to each input row in the data_ RowContainer.
@@ -215,7 +311,10 @@ class Window : public Operator {
   // This is a vector that gives the index of the start row
   // (in sortedRows_) of each partition in the RowContainer data_.
   // This auxiliary structure helps demarcate partitions in
-  // getOutput calls.
+  // getOutput calls. The last element is the end of the last partition
+  // except in streaming mode before all the input has been received. In that
+  // case, the last element is the start of the open partition that might
+  // continue in the next input so the rows before it can be output.
   std::vector<vector_size_t> partitionStartRows_;
 
   // The following 4 Buffers are used to pass peer and frame start and
@@ -264,6 +363,19 @@ class Window : public Operator {
 
   // Tracks how far along the partition rows have been output.
   vector_size_t partitionOffset_ = 0;
+
+  std::unique_ptr<Spiller> spiller_;
+
+  // Counts input batches and triggers spilling if folly hash of this % 100 <=
+  // 'testSpillPct_'.
+  uint64_t spillTestCounter_{0};
+
+  // Set to read back spilled data if disk spilling has been triggered.
+  std::unique_ptr<TreeOfLosers<SpillMergeStream>> spillMerge_;
+
+  // The stream from 'spillMerge_' which has the next row to load. It is null
+  // if all the spilled rows have been loaded.
+  SpillMergeStream* nextSpillStream_{nullptr};
 };
 
 } // namespace facebook::velox::exec
@@ -19,8 +19,9 @@
 #include "velox/vector/BaseVector.h"
 
 /// Simple WindowPartition that builds over the RowContainer used for storing
-/// the input rows in the Window Operator. This works completely in-memory.
-/// TODO: This implementation will be revised for Spill to disk semantics.
+/// the input rows in the Window Operator. This works completely in-memory. If
+/// the Window Operator has spilled, its RowContainer only holds the rows of
+/// the current partition loaded back from the spilled data.
 
 namespace facebook::velox::exec {
 class WindowPartition {
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/WorkStealingExecutor.h"
+
+#include <glog/logging.h>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/common/process/ProcessBase.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+// The executor and queue index of the worker running on this thread, if any.
+thread_local const WorkStealingExecutor* currentExecutor{nullptr};
+thread_local int32_t currentWorker{-1};
+} // namespace
+
+WorkStealingExecutor::WorkStealingExecutor(
+    int32_t numThreads,
+    uint8_t numPriorities,
+    int32_t numaNode)
+    : numPriorities_(numPriorities), numaNode_(numaNode) {
+  VELOX_CHECK_GT(numThreads, 0);
+  VELOX_CHECK_GT(numPriorities, 0);
+  queues_.reserve(numThreads);
+  for (auto i = 0; i < numThreads; ++i) {
+    queues_.push_back(std::make_unique<Queue>());
+    queues_.back()->levels.resize(numPriorities_);
+  }
+  threads_.reserve(numThreads);
+  for (auto i = 0; i < numThreads; ++i) {
+    threads_.emplace_back([this, i]() { workerLoop(i); });
+  }
+}
+
+WorkStealingExecutor::~WorkStealingExecutor() {
+  {
+    std::lock_guard<std::mutex> l(idleMutex_);
+    stop_ = true;
+  }
+  idleCv_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+void WorkStealingExecutor::add(folly::Func func) {
+  addWithPriority(std::move(func), MID_PRI);
+}
+
+void WorkStealingExecutor::addWithPriority(folly::Func func, int8_t priority) {
+  const auto index = currentExecutor == this
+      ? currentWorker
+      : nextQueue_.fetch_add(1) % queues_.size();
+  auto& queue = *queues_[index];
+  {
+    std::lock_guard<std::mutex> l(queue.mutex);
+    queue.levels[levelOf(priority)].push_back(std::move(func));
+    ++queue.size;
+  }
+  ++numPending_;
+  // A worker increments 'numIdle_' before it checks 'numPending_' and waits.
+  // Either it sees the function added above or it is seen as idle here.
+  if (numIdle_ > 0) {
+    {
+      std::lock_guard<std::mutex> l(idleMutex_);
+    }
+    idleCv_.notify_one();
+  }
+}
+
+int32_t WorkStealingExecutor::levelOf(int8_t priority) const {
+  if (priority >= MID_PRI) {
+    return 0;
+  }
+  return std::min<int32_t>(MID_PRI - priority, numPriorities_ - 1);
+}
+
+bool WorkStealingExecutor::tryTake(
+    Queue& queue,
+    bool lowFirst,
+    folly::Func& func) {
+  if (queue.size == 0) {
+    return false;
+  }
+  std::lock_guard<std::mutex> l(queue.mutex);
+  for (auto i = 0; i < numPriorities_; ++i) {
+    auto& level = queue.levels[lowFirst ? numPriorities_ - 1 - i : i];
+    if (!level.empty()) {
+      func = std::move(level.front());
+      level.pop_front();
+      --queue.size;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool WorkStealingExecutor::next(
+    int32_t index,
+    bool lowFirst,
+    folly::Func& func) {
+  if (tryTake(*queues_[index], lowFirst, func)) {
+    return true;
+  }
+  const auto numQueues = queues_.size();
+  for (auto i = 1; i < numQueues; ++i) {
+    if (tryTake(*queues_[(index + i) % numQueues], lowFirst, func)) {
+      ++numSteals_;
+      return true;
+    }
+  }
+  return false;
+}
+
+void WorkStealingExecutor::workerLoop(int32_t index) {
+  currentExecutor = this;
+  currentWorker = index;
+  if (numaNode_ >= 0 && !process::setThreadNumaNode(numaNode_)) {
+    LOG(WARNING) << "Could not pin executor thread to NUMA node " << numaNode_;
+  }
+  uint64_t numPicks = 0;
+  folly::Func func;
+  for (;;) {
+    if (next(index, ++numPicks % kLowPriorityInterval == 0, func)) {
+      --numPending_;
+      try {
+        func();
+      } catch (const std::exception& e) {
+        LOG(ERROR) << "WorkStealingExecutor: func threw unhandled "
+                   << typeid(e).name() << " exception: " << e.what();
+      } catch (...) {
+        LOG(ERROR) << "WorkStealingExecutor: func threw unhandled non-exception "
+                      "object";
+      }
+      func = nullptr;
+      continue;
+    }
+
+    std::unique_lock<std::mutex> l(idleMutex_);
+    ++numIdle_;
+    idleCv_.wait(l, [&]() { return stop_ || numPending_ > 0; });
+    --numIdle_;
+    if (numPending_ <= 0) {
+      // 'stop_' is set and all the queued functions have run.
+      return;
+    }
+  }
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include <folly/Executor.h>
+
+namespace facebook::velox::exec {
+
+/// A folly::Executor with a run queue per worker thread. A function added
+/// from a worker thread goes to the queue of that worker and functions added
+/// from other threads are spread round-robin over the queues. A worker runs
+/// functions from its own queue and steals from the other queues when its own
+/// is empty. Drivers that yield and re-enqueue themselves thus do not contend
+/// on a single queue lock and idle workers pick up work queued elsewhere.
+///
+/// Each queue has one FIFO per priority level. Priorities at or above
+/// folly::Executor::MID_PRI go to the first level and each step below MID_PRI
+/// goes one level lower. Workers run from the highest non-empty level, except
+/// that one in 'kLowPriorityInterval' picks starts from the lowest level so
+/// that low priority work keeps making progress on a busy executor.
+/// Driver::enqueue() lowers the priority of the Drivers of a Task as its
+/// on-thread CPU time grows, so short queries are not stuck behind long
+/// running ones.
+///
+/// If 'numaNode' is not negative, the worker threads run only on the CPUs of
+/// that NUMA node. A server on a multi-socket machine can then keep one
+/// executor per node so that the Drivers of a query and the memory they
+/// allocate from a NUMA aware MmapAllocator stay on the same node.
+class WorkStealingExecutor : public folly::Executor {
+ public:
+  static constexpr uint8_t kDefaultNumPriorities = 5;
+
+  /// One in this many picks by a worker starts from the lowest priority level.
+  static constexpr uint64_t kLowPriorityInterval = 16;
+
+  explicit WorkStealingExecutor(
+      int32_t numThreads,
+      uint8_t numPriorities = kDefaultNumPriorities,
+      int32_t numaNode = -1);
+
+  /// Runs the functions still queued and joins the worker threads.
+  ~WorkStealingExecutor() override;
+
+  void add(folly::Func func) override;
+
+  void addWithPriority(folly::Func func, int8_t priority) override;
+
+  uint8_t getNumPriorities() const override {
+    return numPriorities_;
+  }
+
+  int32_t numThreads() const {
+    return threads_.size();
+  }
+
+  /// Returns the NUMA node the worker threads are pinned to or -1.
+  int32_t numaNode() const {
+    return numaNode_;
+  }
+
+  /// Returns the number of functions a worker took from the queue of another
+  /// worker.
+  uint64_t numSteals() const {
+    return numSteals_;
+  }
+
+ private:
+  struct Queue {
+    std::mutex mutex;
+    // One FIFO per priority level, highest priority first.
+    std::vector<std::deque<folly::Func>> levels;
+    // Number of functions in 'levels'. Read without 'mutex' to skip empty
+    // queues when stealing.
+    std::atomic<int32_t> size{0};
+  };
+
+  // Returns the level in a Queue for 'priority'.
+  int32_t levelOf(int8_t priority) const;
+
+  // Moves the next function of 'queue' into 'func'. Takes from the lowest
+  // non-empty level if 'lowFirst' is true, otherwise from the highest.
+  // Returns false if 'queue' is empty.
+  bool tryTake(Queue& queue, bool lowFirst, folly::Func& func);
+
+  // Moves the next function for the worker 'index' into 'func'. Looks at the
+  // queue of the worker first and then at the queues of the other workers.
+  bool next(int32_t index, bool lowFirst, folly::Func& func);
+
+  void workerLoop(int32_t index);
+
+  const uint8_t numPriorities_;
+
+  const int32_t numaNode_;
+
+  std::vector<std::unique_ptr<Queue>> queues_;
+
+  std::vector<std::thread> threads_;
+
+  // Queue for the next function added from outside the worker threads.
+  std::atomic<uint32_t> nextQueue_{0};
+
+  // Number of functions in all the queues.
+  std::atomic<int64_t> numPending_{0};
+
+  std::atomic<uint64_t> numSteals_{0};
+
+  // Number of workers waiting on 'idleCv_'. A function added while this is 0
+  // doesn't need to take 'idleMutex_' to wake up a worker.
+  std::atomic<int32_t> numIdle_{0};
+
+  std::mutex idleMutex_;
+  std::condition_variable idleCv_;
+
+  // Set by the destructor under 'idleMutex_'.
+  bool stop_{false};
+};
+
+} // namespace facebook::velox::exec
@@ -31,6 +31,11 @@
 
 DEFINE_int32(width, 16, "Number of parties in shuffle");
 DEFINE_int32(task_width, 4, "Number of threads in each task in shuffle");
+DEFINE_int32(
+    scatter_width,
+    64,
+    "Number of parties in shuffle for comparing serialization with and "
+    "without scatter");
 
 DEFINE_int32(num_local_tasks, 8, "Number of concurrent local shuffles");
 DEFINE_int32(num_local_repeat, 8, "Number of repeats of local exchange query");
@@ -78,14 +83,51 @@ class ExchangeBenchmark : public VectorTestBase {
     return vectors;
   }
 
+  // Makes batches of a BIGINT 'c0' to partition on, 'numColumns' VARCHAR
+  // columns that are dictionaries over 'cardinality' strings and a constant
+  // VARCHAR column. The batches share the dictionary base values.
+  std::vector<RowVectorPtr> makeDictionaryRows(
+      int32_t numVectors,
+      int32_t rowsPerVector,
+      int32_t numColumns,
+      int32_t cardinality) {
+    auto base = makeFlatVector<std::string>(cardinality, [](auto row) {
+      return fmt::format("dictionary string value {}", row);
+    });
+    std::vector<RowVectorPtr> vectors;
+    for (int32_t i = 0; i < numVectors; ++i) {
+      std::vector<VectorPtr> columns = {makeFlatVector<int64_t>(
+          rowsPerVector, [&](auto row) { return i * rowsPerVector + row; })};
+      for (auto column = 0; column < numColumns; ++column) {
+        columns.push_back(wrapInDictionary(
+            makeIndices(
+                rowsPerVector,
+                [&](auto row) { return (row * (column + 7)) % cardinality; }),
+            rowsPerVector,
+            base));
+      }
+      columns.push_back(BaseVector::createConstant(
+          VARCHAR(), "constant string value", rowsPerVector, pool()));
+      vectors.push_back(makeRowVector(columns));
+    }
+    return vectors;
+  }
+
   void run(
       std::vector<RowVectorPtr>& vectors,
       int32_t width,
       int32_t taskWidth,
-      Counters& counters) {
+      Counters& counters,
+      bool scatter = false,
+      bool preserveEncodings = false) {
     assert(!vectors.empty());
     configSettings_[core::QueryConfig::kMaxPartitionedOutputBufferSize] =
         fmt::format("{}", FLAGS_exchange_buffer_mb << 20);
+    configSettings_
+        [core::QueryConfig::kPartitionedOutputScatterMinDestinations] =
+            scatter ? "1" : "0";
+    configSettings_[core::QueryConfig::kPartitionedOutputPreserveEncodings] =
+        preserveEncodings ? "true" : "false";
     std::vector<std::shared_ptr<Task>> tasks;
     std::vector<std::string> leafTaskIds;
     auto leafPlan = exec::test::PlanBuilder()
@@ -300,12 +342,19 @@ std::vector<RowVectorPtr> flat10k;
 std::vector<RowVectorPtr> deep10k;
 std::vector<RowVectorPtr> flat50;
 std::vector<RowVectorPtr> deep50;
+std::vector<RowVectorPtr> dictionary10k;
 
 Counters flat10kCounters;
 Counters deep10kCounters;
 Counters flat50Counters;
 Counters deep50Counters;
+Counters flat10kNoScatterCounters;
+Counters flat10kScatterCounters;
+Counters deep10kNoScatterCounters;
+Counters deep10kScatterCounters;
 Counters localFlat10kCounters;
+Counters dictionary10kFlatCounters;
+Counters dictionary10kEncodedCounters;
 
 BENCHMARK(exchangeFlat10k) {
   bm.run(flat10k, FLAGS_width, FLAGS_task_width, flat10kCounters);
@@ -323,6 +372,49 @@ BENCHMARK_RELATIVE(exchangeDeep50) {
   bm.run(deep50, FLAGS_width, FLAGS_task_width, deep50Counters);
 }
 
+BENCHMARK(exchangeFlat10kNoScatter) {
+  bm.run(
+      flat10k, FLAGS_scatter_width, FLAGS_task_width, flat10kNoScatterCounters);
+}
+
+BENCHMARK_RELATIVE(exchangeFlat10kScatter) {
+  bm.run(
+      flat10k,
+      FLAGS_scatter_width,
+      FLAGS_task_width,
+      flat10kScatterCounters,
+      true);
+}
+
+BENCHMARK(exchangeDeep10kNoScatter) {
+  bm.run(
+      deep10k, FLAGS_scatter_width, FLAGS_task_width, deep10kNoScatterCounters);
+}
+
+BENCHMARK_RELATIVE(exchangeDeep10kScatter) {
+  bm.run(
+      deep10k,
+      FLAGS_scatter_width,
+      FLAGS_task_width,
+      deep10kScatterCounters,
+      true);
+}
+
+BENCHMARK(exchangeDictionary10kFlat) {
+  bm.run(
+      dictionary10k, FLAGS_width, FLAGS_task_width, dictionary10kFlatCounters);
+}
+
+BENCHMARK_RELATIVE(exchangeDictionary10kEncoded) {
+  bm.run(
+      dictionary10k,
+      FLAGS_width,
+      FLAGS_task_width,
+      dictionary10kEncodedCounters,
+      false,
+      true);
+}
+
 BENCHMARK(localFlat10k) {
   bm.runLocal(
       flat10k, FLAGS_width, FLAGS_num_local_tasks, localFlat10kCounters);
@@ -379,12 +471,28 @@ int main(int argc, char** argv) {
   deep10k = bm.makeRows(deepType, 10, 10000);
   flat50 = bm.makeRows(flatType, 2000, 50);
   deep50 = bm.makeRows(deepType, 2000, 50);
+  dictionary10k = bm.makeDictionaryRows(10, 10000, 8, 100);
 
   folly::runBenchmarks();
   std::cout << "flat10k: " << flat10kCounters.toString() << std::endl
             << "flat50: " << flat50Counters.toString() << std::endl
             << "deep10k: " << deep10kCounters.toString() << std::endl
-            << "deep50: " << deep50Counters.toString() << std::endl;
+            << "deep50: " << deep50Counters.toString() << std::endl
+            << "flat10k no scatter: " << flat10kNoScatterCounters.toString()
+            << std::endl
+            << "flat10k scatter: " << flat10kScatterCounters.toString()
+            << std::endl
+            << "deep10k no scatter: " << deep10kNoScatterCounters.toString()
+            << std::endl
+            << "deep10k scatter: " << deep10kScatterCounters.toString()
+            << std::endl
+            << "dictionary10k flat: " << dictionary10kFlatCounters.toString()
+            << ", " << (dictionary10kFlatCounters.bytes >> 20) << " MB"
+            << std::endl
+            << "dictionary10k encoded: "
+            << dictionary10kEncodedCounters.toString() << ", "
+            << (dictionary10kEncodedCounters.bytes >> 20) << " MB"
+            << std::endl;
   return 0;
   return 0;
 }
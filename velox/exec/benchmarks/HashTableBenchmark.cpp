@@ -33,6 +33,20 @@ DEFINE_int32(custom_hit_rate, 0, "Percentage of hits in custom test");
 DEFINE_int32(custom_key_spacing, 1, "Spacing between key values");
 
 DEFINE_int32(custom_num_ways, 10, "Number of build threads");
+DEFINE_int32(
+    probe_group_size,
+    16,
+    "Number of rows probed together in kHash and kNormalizedKey modes");
+DEFINE_int64(
+    allocator_capacity_gb,
+    10,
+    "Capacity of the memory allocator in GB. Raise for tables of 1B "
+    "entries with --custom_size");
+DEFINE_bool(
+    use_madv_free,
+    false,
+    "Release freed allocator memory with MADV_FREE. Run with and without "
+    "--velox_memory_use_hugepages to see the effect of TLB misses on probes");
 
 using namespace facebook::velox;
 using namespace facebook::velox::exec;
@@ -190,6 +204,7 @@ class HashTableBenchmark : public VectorTestBase {
       startOffset += params_.size;
     }
     topTable_->prepareJoinTable(std::move(otherTables), executor_.get());
+    topTable_->setProbeGroupSize(FLAGS_probe_group_size);
     LOG(INFO) << "Made table " << topTable_->toString();
 
     if (topTable_->hashMode() == BaseHashTable::HashMode::kNormalizedKey) {
@@ -613,9 +628,10 @@ void combineResults(
 int main(int argc, char** argv) {
   folly::init(&argc, &argv);
   memory::MmapAllocator::Options options;
-  options.capacity = 10UL << 30;
+  options.capacity = FLAGS_allocator_capacity_gb << 30;
   options.useMmapArena = true;
   options.mmapArenaCapacityRatio = 1;
+  options.useMadvFree = FLAGS_use_madv_free;
 
   auto allocator = std::make_shared<memory::MmapAllocator>(options);
   memory::MemoryAllocator::setDefaultInstance(allocator.get());
@@ -632,6 +648,9 @@ int main(int argc, char** argv) {
       HashTableBenchmarkParams("Hit4M", 4000000, 100),
       HashTableBenchmarkParams("Miss4M", 4000000, 5),
 
+      HashTableBenchmarkParams("Hit10M", 10000000, 100),
+      HashTableBenchmarkParams("Miss10M", 10000000, 5),
+
       HashTableBenchmarkParams("Hit32M", 32000000, 100),
       HashTableBenchmarkParams("Miss32M", 32000000, 5),
 
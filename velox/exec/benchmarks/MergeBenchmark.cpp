@@ -37,6 +37,14 @@ BENCHMARK_RELATIVE(narrowArray) {
   MergeTestBase::test<MergeArray<TestingStream>>(narrow, false);
 }
 
+BENCHMARK_RELATIVE(narrowKeyArray) {
+  MergeTestBase::test<KeyMergeArray<TestingStream>>(narrow, false);
+}
+
+BENCHMARK_RELATIVE(narrowKeyArrayRuns) {
+  MergeTestBase::testRuns(narrow, false);
+}
+
 BENCHMARK(mediumTree) {
   MergeTestBase::test<TreeOfLosers<TestingStream>>(medium, false);
 }
@@ -45,6 +53,14 @@ BENCHMARK_RELATIVE(mediumArray) {
   MergeTestBase::test<MergeArray<TestingStream>>(medium, false);
 }
 
+BENCHMARK_RELATIVE(mediumKeyArray) {
+  MergeTestBase::test<KeyMergeArray<TestingStream>>(medium, false);
+}
+
+BENCHMARK_RELATIVE(mediumKeyArrayRuns) {
+  MergeTestBase::testRuns(medium, false);
+}
+
 BENCHMARK(wideTree) {
   MergeTestBase::test<TreeOfLosers<TestingStream>>(wide, false);
 }
@@ -53,6 +69,14 @@ BENCHMARK_RELATIVE(wideArray) {
   MergeTestBase::test<MergeArray<TestingStream>>(wide, false);
 }
 
+BENCHMARK_RELATIVE(wideKeyArray) {
+  MergeTestBase::test<KeyMergeArray<TestingStream>>(wide, false);
+}
+
+BENCHMARK_RELATIVE(wideKeyArrayRuns) {
+  MergeTestBase::testRuns(wide, false);
+}
+
 int main(int argc, char* argv[]) {
   folly::init(&argc, &argv);
   gflags::ParseCommandLineFlags(&argc, &argv, true);
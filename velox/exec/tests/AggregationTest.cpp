@@ -661,6 +661,53 @@ TEST_F(AggregationTest, hashmodes) {
       " GROUP BY c0, c1, c2, c3, c4, c5");
 }
 
+TEST_F(AggregationTest, arrayModeAddBySlot) {
+  // Few distinct keys put the hash table in array mode, where integer sum,
+  // min and max are added by slot. Sum of doubles uses the regular path.
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 5; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int32_t>(
+            1'000, [&](auto row) { return (row + i) % 24; }, nullEvery(101)),
+        makeFlatVector<int32_t>(
+            1'000,
+            [](auto row) { return row * 7 % 1'000 - 500; },
+            nullEvery(7)),
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row * 31; }),
+        makeFlatVector<double>(1'000, [](auto row) { return row * 0.5; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .singleAggregation(
+                      {"c0"},
+                      {"sum(c1)",
+                       "min(c1)",
+                       "max(c1)",
+                       "sum(c2)",
+                       "min(c2)",
+                       "max(c2)",
+                       "sum(c3)"})
+                  .planNode();
+  assertQuery(
+      plan,
+      "SELECT c0, sum(c1), min(c1), max(c1), sum(c2), min(c2), max(c2), "
+      "sum(c3) FROM tmp GROUP BY c0");
+
+  // Same with a mask, so that only some of the rows are added.
+  plan = PlanBuilder()
+             .values(vectors)
+             .project({"c0", "c1", "c2", "c1 % 3 = 0 AS m"})
+             .singleAggregation({"c0"}, {"sum(c1)", "max(c2)"}, {"m", "m"})
+             .planNode();
+  assertQuery(
+      plan,
+      "SELECT c0, sum(c1) FILTER (WHERE c1 % 3 = 0), "
+      "max(c2) FILTER (WHERE c1 % 3 = 0) FROM tmp GROUP BY c0");
+}
+
 TEST_F(AggregationTest, rangeToDistinct) {
   rng_.seed(1);
   auto rowType =
@@ -794,6 +841,46 @@ TEST_F(AggregationTest, partialAggregationMemoryLimit) {
           .customStats.count("flushRowCount"));
 }
 
+TEST_F(AggregationTest, partialAggregationSpill) {
+  constexpr int32_t kNumKeys = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int32_t>(1'000, [](auto row) { return row % kNumKeys; }),
+        makeFlatVector<int64_t>(1'000, [i](auto row) { return i + row; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  // Set an artificially low limit on the amount of data to accumulate in
+  // the partial aggregation so that it spills after every batch of input.
+  core::PlanNodeId aggNodeId;
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  auto task =
+      AssertQueryBuilder(duckDbQueryRunner_)
+          .spillDirectory(tempDirectory->path)
+          .config(QueryConfig::kSpillEnabled, "true")
+          .config(QueryConfig::kAggregationSpillEnabled, "true")
+          .config(QueryConfig::kPartialAggregationSpillEnabled, "true")
+          .config(QueryConfig::kMaxPartialAggregationMemory, "1")
+          .plan(PlanBuilder()
+                    .values(vectors)
+                    .partialAggregation({"c0"}, {"sum(c1)", "count(1)"})
+                    .capturePlanNodeId(aggNodeId)
+                    .finalAggregation()
+                    .planNode())
+          .assertResults("SELECT c0, sum(c1), count(1) FROM tmp GROUP BY 1");
+
+  // The spilled groups are merged, so that the partial aggregation produces
+  // each key once.
+  const auto stats = toPlanStats(task->taskStats()).at(aggNodeId);
+  ASSERT_GT(stats.spilledRows, 0);
+  ASSERT_GT(stats.customStats.at("partialAggregationSpills").sum, 0);
+  ASSERT_EQ(stats.customStats.count("flushRowCount"), 0);
+  ASSERT_EQ(stats.outputRows, kNumKeys);
+  OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+}
+
 TEST_F(AggregationTest, partialDistinctWithAbandon) {
   auto vectors = {
       // 1st batch will produce 100 distinct groups from 10 rows.
@@ -840,6 +927,50 @@ TEST_F(AggregationTest, partialDistinctWithAbandon) {
              .assertResults("SELECT distinct c0, sum(c0) FROM tmp group by c0");
 }
 
+TEST_F(AggregationTest, partialAggregationSampling) {
+  auto makeInput = [&](std::function<int64_t(vector_size_t)> keyAt) {
+    std::vector<RowVectorPtr> vectors;
+    for (auto i = 0; i < 10; ++i) {
+      vectors.push_back(makeRowVector({makeFlatVector<int64_t>(
+          1'000, [&](auto row) { return keyAt(i * 1'000 + row); })}));
+    }
+    return vectors;
+  };
+
+  struct {
+    std::function<int64_t(vector_size_t)> keyAt;
+    bool abandoned;
+    bool smallTable;
+  } testSettings[] = {
+      {[](auto row) { return row; }, true, false},
+      {[](auto row) { return row / 2; }, false, true},
+      {[](auto row) { return row % 10; }, false, false}};
+
+  for (const auto& testData : testSettings) {
+    auto vectors = makeInput(testData.keyAt);
+    createDuckDbTable(vectors);
+    core::PlanNodeId partialNodeId;
+    auto task =
+        AssertQueryBuilder(duckDbQueryRunner_)
+            .config(QueryConfig::kAbandonPartialAggregationSampleRows, "2000")
+            .config("max_drivers_per_task", "1")
+            .plan(PlanBuilder()
+                      .values(vectors)
+                      .partialAggregation({"c0"}, {"count(1)"})
+                      .capturePlanNodeId(partialNodeId)
+                      .finalAggregation()
+                      .planNode())
+            .assertResults("SELECT c0, count(1) FROM tmp GROUP BY c0");
+    const auto planStats = toPlanStats(task->taskStats());
+    const auto& stats = planStats.at(partialNodeId).customStats;
+    ASSERT_EQ(stats.count("partialAggregationSampledUniquePct"), 1);
+    ASSERT_EQ(
+        stats.count("abandonedPartialAggregation") > 0, testData.abandoned);
+    ASSERT_EQ(
+        stats.count("smallTablePartialAggregation") > 0, testData.smallTable);
+  }
+}
+
 TEST_F(AggregationTest, largeValueRangeArray) {
   // We have keys that map to integer range. The keys are
   // a little under max array hash table size apart. This wastes 16MB of
@@ -1475,6 +1606,56 @@ TEST_F(AggregationTest, groupingSets) {
       "SELECT k1, k2, count(1), sum(a), max(b) FROM tmp GROUP BY ROLLUP (k1, k2)");
 }
 
+TEST_F(AggregationTest, groupingSetsAggregation) {
+  vector_size_t size = 1'000;
+  auto data = makeRowVector(
+      {"k1", "k2", "a", "b"},
+      {
+          makeFlatVector<int64_t>(
+              size, [](auto row) { return row % 11; }, nullEvery(13)),
+          makeFlatVector<int64_t>(size, [](auto row) { return row % 17; }),
+          makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          makeFlatVector<StringView>(
+              size,
+              [](auto row) {
+                auto str = std::string(row % 12, 'x');
+                return StringView(str);
+              }),
+      });
+
+  createDuckDbTable({data});
+
+  // Cube. The null keys of the input are grouped apart from the null keys of
+  // the coarser grouping sets.
+  auto plan = PlanBuilder()
+                  .values({data})
+                  .groupingSetsAggregation(
+                      {{"k1", "k2"}, {"k1"}, {"k2"}, {}},
+                      {"count(1) as count_1",
+                       "sum(a) as sum_a",
+                       "max(b) as max_b",
+                       "avg(a) as avg_a"})
+                  .project({"k1", "k2", "count_1", "sum_a", "max_b", "avg_a"})
+                  .planNode();
+
+  assertQuery(
+      plan,
+      "SELECT k1, k2, count(1), sum(a), max(b), avg(a) FROM tmp GROUP BY CUBE (k1, k2)");
+
+  // Rollup.
+  plan = PlanBuilder()
+             .values({data})
+             .groupingSetsAggregation(
+                 {{"k1", "k2"}, {"k1"}, {}},
+                 {"count(1) as count_1", "sum(a) as sum_a"})
+             .project({"k1", "k2", "count_1", "sum_a"})
+             .planNode();
+
+  assertQuery(
+      plan,
+      "SELECT k1, k2, count(1), sum(a) FROM tmp GROUP BY ROLLUP (k1, k2)");
+}
+
 TEST_F(AggregationTest, groupingSetsOutput) {
   vector_size_t size = 1'000;
   auto data = makeRowVector(
@@ -1622,6 +1803,42 @@ TEST_F(AggregationTest, distinctWithSpilling) {
   OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
 }
 
+TEST_F(AggregationTest, distinctAndSortedAggregationsWithSpilling) {
+  std::vector<RowVectorPtr> vectors;
+  int64_t rowNumber = 0;
+  for (int32_t i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(100, [](auto row) { return row % 17; }),
+        makeFlatVector<int32_t>(
+            100, [](auto row) { return row % 7; }, nullEvery(11)),
+        makeFlatVector<int64_t>(100, [&](auto /*row*/) { return rowNumber++; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  core::PlanNodeId aggrNodeId;
+  auto task =
+      AssertQueryBuilder(duckDbQueryRunner_)
+          .spillDirectory(spillDirectory->path)
+          .config(QueryConfig::kSpillEnabled, "true")
+          .config(QueryConfig::kAggregationSpillEnabled, "true")
+          .config(QueryConfig::kTestingSpillPct, "100")
+          .plan(PlanBuilder()
+                    .values(vectors)
+                    .singleAggregation(
+                        {"c0"},
+                        {"count(distinct c1)",
+                         "sum(c2)",
+                         "array_agg(c1 ORDER BY c2 DESC)"})
+                    .capturePlanNodeId(aggrNodeId)
+                    .planNode())
+          .assertResults(
+              "SELECT c0, count(distinct c1), sum(c2), "
+              "array_agg(c1 ORDER BY c2 DESC) FROM tmp GROUP BY c0");
+  ASSERT_GT(toPlanStats(task->taskStats()).at(aggrNodeId).spilledBytes, 0);
+  OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+}
+
 TEST_F(AggregationTest, preGroupedAggregationWithSpilling) {
   std::vector<RowVectorPtr> vectors;
   int64_t val = 0;
@@ -1660,6 +1877,73 @@ TEST_F(AggregationTest, preGroupedAggregationWithSpilling) {
   OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
 }
 
+TEST_F(AggregationTest, parallelPartitionedGroupBy) {
+  auto vectors = makeVectors(rowType_, 1'000, 10);
+  createDuckDbTable(vectors);
+  auto groupBy = PlanBuilder()
+                     .values(vectors)
+                     .partialAggregation(
+                         {"c0", "c6"}, {"sum(c1)", "max(c6)", "count(1)"})
+                     .finalAggregation()
+                     .planNode();
+  auto distinct = PlanBuilder()
+                      .values(vectors)
+                      .singleAggregation({"c0", "c2"}, {})
+                      .planNode();
+  for (const auto* numPartitions : {"1", "4", "7"}) {
+    SCOPED_TRACE(fmt::format("numPartitions: {}", numPartitions));
+    AssertQueryBuilder(groupBy, duckDbQueryRunner_)
+        .config(QueryConfig::kAggregationNumParallelPartitions, numPartitions)
+        .config(QueryConfig::kPreferredOutputBatchRows, "100")
+        .assertResults(
+            "SELECT c0, c6, sum(c1), max(c6), count(1) FROM tmp GROUP BY 1, 2");
+    AssertQueryBuilder(distinct, duckDbQueryRunner_)
+        .config(QueryConfig::kAggregationNumParallelPartitions, numPartitions)
+        .assertResults("SELECT DISTINCT c0, c2 FROM tmp");
+  }
+}
+
+TEST_F(AggregationTest, intraTaskMerge) {
+  constexpr int32_t kNumDrivers = 4;
+  auto vectors = makeVectors(rowType_, 1'000, 10);
+  // Each driver reads all of 'vectors'.
+  std::vector<RowVectorPtr> allVectors;
+  for (auto i = 0; i < kNumDrivers; ++i) {
+    allVectors.insert(allVectors.end(), vectors.begin(), vectors.end());
+  }
+  createDuckDbTable(allVectors);
+
+  auto groupBy = PlanBuilder()
+                     .values(vectors, true)
+                     .singleAggregation(
+                         {"c0", "c6"},
+                         {"sum(c1)", "max(c6)", "count(1)", "avg(c2)"})
+                     .planNode();
+  auto global = PlanBuilder()
+                    .values(vectors, true)
+                    .singleAggregation({}, {"sum(c1)", "count(c2)"})
+                    .planNode();
+  auto distinct = PlanBuilder()
+                      .values(vectors, true)
+                      .singleAggregation({"c0", "c2"}, {})
+                      .planNode();
+  for (const auto* numPartitions : {"0", "4"}) {
+    SCOPED_TRACE(fmt::format("numPartitions: {}", numPartitions));
+    auto builder = [&](const core::PlanNodePtr& plan) {
+      return AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .maxDrivers(kNumDrivers)
+          .config(QueryConfig::kAggregationIntraTaskMerge, "true")
+          .config(QueryConfig::kAggregationNumParallelPartitions, numPartitions)
+          .config(QueryConfig::kPreferredOutputBatchRows, "100");
+    };
+    builder(groupBy).assertResults(
+        "SELECT c0, c6, sum(c1), max(c6), count(1), avg(c2) FROM tmp "
+        "GROUP BY 1, 2");
+    builder(global).assertResults("SELECT sum(c1), count(c2) FROM tmp");
+    builder(distinct).assertResults("SELECT DISTINCT c0, c2 FROM tmp");
+  }
+}
+
 TEST_F(AggregationTest, adaptiveOutputBatchRows) {
   int32_t defaultOutputBatchRows = 10;
   vector_size_t size = defaultOutputBatchRows * 5;
@@ -1708,6 +1992,37 @@ TEST_F(AggregationTest, adaptiveOutputBatchRows) {
   }
 }
 
+TEST_F(AggregationTest, compactVariableLengthData) {
+  auto vectors = makeVectors(rowType_, 1'000, 10);
+  createDuckDbTable(vectors);
+
+  // Few groups whose max and min strings keep changing and growing arrays
+  // leave free blocks between the live ones.
+  core::PlanNodeId aggregationId;
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .project({"c0 % 10 AS k", "c1", "c6"})
+                  .singleAggregation(
+                      {"k"}, {"max(c6)", "min(c6)", "array_agg(c1)"})
+                  .capturePlanNodeId(aggregationId)
+                  .project({"k", "a0", "a1", "cardinality(a2)"})
+                  .planNode();
+  const auto sql =
+      "SELECT c0 % 10, max(c6), min(c6), count(*) FROM tmp GROUP BY 1";
+
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .config(QueryConfig::kAggregationCompactionFreePct, "1")
+                  .config(QueryConfig::kAggregationCompactionMinBytes, "1")
+                  .assertResults(sql);
+  auto stats = toPlanStats(task->taskStats()).at(aggregationId).customStats;
+  EXPECT_LT(0, stats.at("stringAllocator.numCompactions").sum);
+
+  task = AssertQueryBuilder(plan, duckDbQueryRunner_).assertResults(sql);
+  stats = toPlanStats(task->taskStats()).at(aggregationId).customStats;
+  EXPECT_EQ(0, stats.count("stringAllocator.numCompactions"));
+  EXPECT_EQ(1, stats.count("stringAllocator.freePct"));
+}
+
 DEBUG_ONLY_TEST_F(AggregationTest, reclaimDuringInputProcessing) {
   constexpr int64_t kMaxBytes = 1LL << 30; // 1GB
   auto rowType = ROW({"c0", "c1", "c2"}, {INTEGER(), INTEGER(), VARCHAR()});
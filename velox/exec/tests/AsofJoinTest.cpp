@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+namespace {
+
+class AsofJoinTest : public OperatorTestBase {
+ protected:
+  // Returns batches of 'sizes' rows of (key, ts, payload) sorted on (key,
+  // ts). The rows with 'keyAt' and 'tsAt' of the row number are in order
+  // and 'nullEvery' rows have a null ts.
+  std::vector<RowVectorPtr> makeBatches(
+      const std::vector<vector_size_t>& sizes,
+      const std::string& prefix,
+      std::function<int32_t(vector_size_t)> keyAt,
+      std::function<int64_t(vector_size_t)> tsAt,
+      vector_size_t nullEvery) {
+    std::vector<RowVectorPtr> batches;
+    vector_size_t start = 0;
+    for (auto size : sizes) {
+      batches.push_back(makeRowVector(
+          {prefix + "k", prefix + "ts", prefix + "p"},
+          {makeFlatVector<int32_t>(
+               size, [&](auto row) { return keyAt(start + row); }),
+           makeFlatVector<int64_t>(
+               size,
+               [&](auto row) { return tsAt(start + row); },
+               [&](auto row) { return (start + row) % nullEvery == 0; }),
+           makeFlatVector<int64_t>(
+               size, [&](auto row) { return start + row; })}));
+      start += size;
+    }
+    return batches;
+  }
+
+  // Joins 't' with 'u' using 'comparison' and compares with DuckDB. The
+  // match of each left row is the closest right row, found with 'closest'
+  // ('max' or 'min') over the right rows satisfying the comparison.
+  void testJoin(const std::string& comparison, const std::string& closest) {
+    const std::vector<std::string> outputLayout = {"k", "ts", "p", "u_p"};
+    for (auto joinType : {core::JoinType::kInner, core::JoinType::kLeft}) {
+      SCOPED_TRACE(fmt::format(
+          "{} {}", comparison, core::joinTypeName(joinType)));
+      auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+      auto plan = PlanBuilder(planNodeIdGenerator)
+                      .values(left_)
+                      .asofJoin(
+                          {"k", "ts"},
+                          {"u_k", "u_ts"},
+                          PlanBuilder(planNodeIdGenerator)
+                              .values(right_)
+                              .planNode(),
+                          comparison,
+                          outputLayout,
+                          joinType)
+                      .planNode();
+      const auto sql = fmt::format(
+          "WITH m AS (SELECT k, ts, p, (SELECT {}(u_ts) FROM u "
+          "WHERE u_k = k AND ts {} u_ts) AS match_ts FROM t) "
+          "SELECT k, ts, p, u_p FROM m {} JOIN u "
+          "ON k = u_k AND match_ts = u_ts",
+          closest,
+          comparison,
+          joinType == core::JoinType::kInner ? "INNER" : "LEFT");
+      // Uses a small output batch size to stop in the middle of left side
+      // batches.
+      for (auto batchRows : {"7", "1024"}) {
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .config(core::QueryConfig::kPreferredOutputBatchRows, batchRows)
+            .config(core::QueryConfig::kMaxOutputBatchRows, batchRows)
+            .assertResults(sql);
+      }
+    }
+  }
+
+  void SetUp() override {
+    OperatorTestBase::SetUp();
+    // Left keys go from 0 to 9 and right keys from 2 to 13. The right rows
+    // have distinct ts per key.
+    left_ = makeBatches(
+        {300, 1, 1'000, 699},
+        "",
+        [](auto row) { return row / 200; },
+        [](auto row) { return (row % 200) * 3; },
+        17);
+    right_ = makeBatches(
+        {50, 700, 1, 449},
+        "u_",
+        [](auto row) { return 2 + row / 100; },
+        [](auto row) { return (row % 100) * 5 + 1; },
+        23);
+    createDuckDbTable("t", left_);
+    createDuckDbTable("u", right_);
+  }
+
+  std::vector<RowVectorPtr> left_;
+  std::vector<RowVectorPtr> right_;
+};
+
+TEST_F(AsofJoinTest, greaterThanOrEqual) {
+  testJoin(">=", "max");
+}
+
+TEST_F(AsofJoinTest, greaterThan) {
+  testJoin(">", "max");
+}
+
+TEST_F(AsofJoinTest, lessThanOrEqual) {
+  testJoin("<=", "min");
+}
+
+TEST_F(AsofJoinTest, lessThan) {
+  testJoin("<", "min");
+}
+
+TEST_F(AsofJoinTest, emptyRight) {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .values(left_)
+                  .asofJoin(
+                      {"k", "ts"},
+                      {"u_k", "u_ts"},
+                      PlanBuilder(planNodeIdGenerator)
+                          .values(right_)
+                          .filter("u_k < 0")
+                          .planNode(),
+                      ">=",
+                      {"k", "ts", "p", "u_p"},
+                      core::JoinType::kLeft)
+                  .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .assertResults("SELECT k, ts, p, null FROM t");
+}
+
+TEST_F(AsofJoinTest, invalidPlan) {
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto right = PlanBuilder(planNodeIdGenerator).values(right_).planNode();
+  VELOX_ASSERT_THROW(
+      PlanBuilder(planNodeIdGenerator)
+          .values(left_)
+          .asofJoin({"k", "ts"}, {"u_k", "u_ts"}, right, "=", {"k", "u_p"}),
+      "Invalid ASOF join comparison: =");
+  VELOX_ASSERT_THROW(
+      PlanBuilder(planNodeIdGenerator)
+          .values(left_)
+          .asofJoin(
+              {"k", "ts"},
+              {"u_k", "u_ts"},
+              right,
+              ">=",
+              {"k", "u_p"},
+              core::JoinType::kFull),
+      "ASOF join supports only inner and left joins, not FULL");
+}
+
+} // namespace
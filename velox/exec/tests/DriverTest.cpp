@@ -15,6 +15,7 @@
  */
 #include <folly/Unit.h>
 #include <folly/init/Init.h>
+#include <folly/json.h>
 #include <velox/exec/Driver.h>
 #include "folly/experimental/EventCount.h"
 #include "velox/common/base/tests/GTestUtils.h"
@@ -605,6 +606,96 @@ TEST_F(DriverTest, yield) {
   }
 }
 
+TEST_F(DriverTest, timeSlice) {
+  auto data = makeRowVector({makeFlatVector<int64_t>(
+      1'000, [](auto row) { return row; })});
+  auto plan = PlanBuilder()
+                  .values({data}, false, 2'000)
+                  .project({"c0 % 7 + c0 % 11 + c0 % 13 AS c1"})
+                  .singleAggregation({}, {"count(1)", "sum(c1)"})
+                  .planNode();
+
+  int64_t sum = 0;
+  for (auto i = 0; i < 1'000; ++i) {
+    sum += i % 7 + i % 11 + i % 13;
+  }
+
+  // The Driver yields back to the executor each millisecond on thread and
+  // continues from where it stopped.
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config(core::QueryConfig::kDriverTimeSliceMs, "1")
+          .assertResults(fmt::format("SELECT 2000000, {}", sum * 2'000));
+
+  int64_t numYields = 0;
+  for (const auto& pipeline : task->taskStats().pipelineStats) {
+    for (const auto& op : pipeline.operatorStats) {
+      auto it = op.runtimeStats.find("timeSliceYields");
+      if (it != op.runtimeStats.end()) {
+        numYields += it->second.sum;
+      }
+    }
+  }
+  ASSERT_GT(numYields, 0);
+  ASSERT_GT(task->driverCpuNanos(), 0);
+}
+
+TEST_F(DriverTest, hardwareCounters) {
+  auto data = makeRowVector({makeFlatVector<int64_t>(
+      1'000, [](auto row) { return row; })});
+  createDuckDbTable({data});
+  auto plan = PlanBuilder()
+                  .values({data}, false, 100)
+                  .project({"c0 % 7 + c0 % 11 AS c1"})
+                  .singleAggregation({}, {"sum(c1)"})
+                  .planNode();
+  auto projectCounters = [](const std::shared_ptr<Task>& task) {
+    return task->taskStats().pipelineStats[0].operatorStats[1].hardwareCounters;
+  };
+
+  // Off by default.
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .assertResults("SELECT sum(c0 % 7 + c0 % 11) * 100 FROM tmp");
+  EXPECT_TRUE(projectCounters(task).empty());
+
+  task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+             .config(core::QueryConfig::kOperatorTrackHardwareCounters, "true")
+             .assertResults("SELECT sum(c0 % 7 + c0 % 11) * 100 FROM tmp");
+  if (process::threadHardwareCounters().empty()) {
+    // No hardware counters in this environment.
+    return;
+  }
+  EXPECT_GT(projectCounters(task).cycles, 0);
+  EXPECT_GT(projectCounters(task).instructions, 0);
+}
+
+TEST_F(DriverTest, traceTimeline) {
+  auto data = makeRowVector({makeFlatVector<int64_t>(
+      1'000, [](auto row) { return row; })});
+  createDuckDbTable({data});
+  auto plan = PlanBuilder()
+                  .values({data}, false, 10)
+                  .singleAggregation({}, {"sum(c0)"})
+                  .planNode();
+
+  // Off by default.
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .assertResults("SELECT sum(c0) * 10 FROM tmp");
+  EXPECT_EQ(task->traceTimeline(), nullptr);
+  EXPECT_EQ(task->traceTimelineJson(), "");
+
+  task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+             .config(core::QueryConfig::kTaskTraceTimelineCapacity, "100")
+             .assertResults("SELECT sum(c0) * 10 FROM tmp");
+  ASSERT_NE(task->traceTimeline(), nullptr);
+  auto events = task->traceTimeline()->events();
+  ASSERT_FALSE(events.empty());
+  EXPECT_STREQ(events[0].category, "driver");
+  EXPECT_EQ(events[0].name.find("Driver 0.0"), 0);
+  auto trace = folly::parseJson(task->traceTimelineJson());
+  EXPECT_EQ(trace["traceEvents"].size(), events.size() + 1);
+}
+
 // A testing Operator that periodically does one of the following:
 //
 // 1. Blocks and registers a resume that continues the Driver after a timed
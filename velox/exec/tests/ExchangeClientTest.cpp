@@ -16,6 +16,7 @@
 #include <gtest/gtest.h>
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/exec/Exchange.h"
+#include "velox/exec/InProcessExchangeSource.h"
 #include "velox/exec/PartitionedOutputBufferManager.h"
 #include "velox/exec/Task.h"
 #include "velox/exec/tests/utils/LocalExchangeSource.h"
@@ -144,6 +145,10 @@ TEST_F(ExchangeClientTest, stats) {
   EXPECT_EQ(totalBytes, stats.at("peakBytes").sum);
   EXPECT_EQ(data.size(), stats.at("numReceivedPages").sum);
   EXPECT_EQ(totalBytes / data.size(), stats.at("averageReceivedPageBytes").sum);
+  EXPECT_LE(
+      stats.at("maxPageWaitWallNanos").sum, stats.at("pageWaitWallNanos").sum);
+  // One value for the one source.
+  EXPECT_EQ(1, stats.at("sourceRequestWaitWallNanos").count);
 
   task->requestCancel();
   bufferManager_->removeTask(taskId);
@@ -197,5 +202,61 @@ TEST_F(ExchangeClientTest, flowControl) {
   }
 }
 
+TEST_F(ExchangeClientTest, inProcessSource) {
+  exec::ExchangeSource::factories().clear();
+  exec::ExchangeSource::registerFactory(createInProcessExchangeSource);
+
+  auto data = {
+      makeRowVector({makeFlatVector<int32_t>({1, 2, 3})}),
+      makeRowVector({makeFlatVector<int32_t>({4, 5})}),
+  };
+  auto plan = test::PlanBuilder()
+                  .values(data)
+                  .partitionedOutput({"c0"}, 100)
+                  .planNode();
+
+  // The task id has no URL scheme. The in-process source is picked because
+  // the task has output buffers in the buffer manager.
+  const std::string taskId = "in.process.t1";
+  {
+    ExchangeClient client(
+        "t", 17, pool(), ExchangeClient::kDefaultMaxQueuedBytes);
+    VELOX_ASSERT_THROW(
+        client.addRemoteTaskId(taskId),
+        "No ExchangeSource factory matches in.process.t1");
+  }
+
+  auto task = makeTask(taskId, plan, 17);
+  bufferManager_->initializeTask(
+      task, core::PartitionedOutputNode::Kind::kPartitioned, 100, 1);
+  ExchangeClient client(
+      "t", 17, pool(), ExchangeClient::kDefaultMaxQueuedBytes);
+  client.addRemoteTaskId(taskId);
+  client.noMoreRemoteTasks();
+
+  for (auto vector : data) {
+    enqueue(taskId, 17, vector);
+  }
+  fetchPages(client, data.size());
+
+  bufferManager_->noMoreData(taskId);
+  bool atEnd = false;
+  ContinueFuture future = ContinueFuture::makeEmpty();
+  auto page = client.next(&atEnd, &future);
+  if (page == nullptr && !atEnd) {
+    future.wait();
+    page = client.next(&atEnd, &future);
+  }
+  ASSERT_EQ(page, nullptr);
+  ASSERT_TRUE(atEnd);
+
+  auto stats = client.stats();
+  EXPECT_EQ(data.size(), stats.at("numReceivedPages").sum);
+  EXPECT_EQ(data.size(), stats.at("inProcessExchangeSource.numPages").sum);
+
+  task->requestCancel();
+  bufferManager_->removeTask(taskId);
+}
+
 } // namespace
 } // namespace facebook::velox::exec
@@ -15,6 +15,7 @@
  */
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 
@@ -322,3 +323,30 @@ TEST_F(FilterProjectTest, projectAndIdentityOverLazy) {
                   .planNode();
   assertQuery(plan, "SELECT c0 < 10 AND c1 < 10, c1 FROM tmp");
 }
+
+TEST_F(FilterProjectTest, compactResults) {
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    auto vector = std::dynamic_pointer_cast<RowVector>(
+        BatchMaker::createBatch(rowType_, 100, *pool_));
+    vectors.push_back(vector);
+  }
+  createDuckDbTable(vectors);
+
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .filter("c1 % 10  > 3")
+                  .project({"c0", "c0 + c1", "c1 % 3 = 0", "c3 * 2.0"})
+                  .planNode();
+
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .config(core::QueryConfig::kFilterProjectCompactResults, "true")
+          .assertResults(
+              "SELECT c0, c0 + c1, c1 % 3 = 0, c3 * 2.0 FROM tmp "
+              "WHERE c1 % 10 > 3");
+  const auto& runtimeStats =
+      task->taskStats().pipelineStats[0].operatorStats[1].runtimeStats;
+  ASSERT_EQ(runtimeStats.count("numCompactedResults"), 1);
+  ASSERT_GT(runtimeStats.at("numCompactedResults").sum, 0);
+}
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <folly/json.h>
 #include <velox/type/Timestamp.h>
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
@@ -172,6 +173,63 @@ TEST_F(GroupedExecutionTest, groupedExecutionErrors) {
           localPartitionNodeId));
 }
 
+TEST_F(GroupedExecutionTest, adaptiveSplitGroupConcurrency) {
+  auto vectors = makeVectors(10, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->path, vectors);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId tableScanNodeId;
+  auto planFragment =
+      PlanBuilder(planNodeIdGenerator)
+          .tableScan(rowType_)
+          .capturePlanNodeId(tableScanNodeId)
+          .localPartitionRoundRobinRow()
+          .partitionedOutput({}, 1, {"c0", "c1", "c2", "c3", "c4", "c5"})
+          .planFragment();
+  planFragment.executionStrategy = core::ExecutionStrategy::kGrouped;
+  planFragment.groupedExecutionLeafNodeIds.emplace(tableScanNodeId);
+  planFragment.numSplitGroups = 10;
+  auto queryCtx = std::make_shared<core::QueryCtx>(executor_.get());
+  queryCtx->testingOverrideMemoryPool(
+      memory::defaultMemoryManager().addRootPool(
+          queryCtx->queryId(), 1L << 30, memory::MemoryReclaimer::create()));
+  auto task =
+      exec::Task::create("0", std::move(planFragment), 0, std::move(queryCtx));
+  auto targetSplitGroups = [&]() {
+    return folly::parseJson(task->toJsonString())["targetSplitGroups"]
+        .asInt();
+  };
+
+  // 3 drivers max and 2 concurrent split groups.
+  task->start(task, 3, 2);
+  for (auto group : {1, 5, 8}) {
+    task->addSplit("0", makeHiveSplitWithGroup(filePath->path, group));
+  }
+  // 2 split groups with 2 pipelines of 3 drivers each.
+  EXPECT_EQ(12, task->numRunningDrivers());
+  EXPECT_EQ(2, targetSplitGroups());
+
+  // Reclaiming memory from the task halves the split group concurrency.
+  task->pool()->reclaimer()->reclaim(task->pool(), 0);
+  EXPECT_EQ(1, targetSplitGroups());
+
+  // There is plenty of free memory when a split group finishes, so the
+  // concurrency goes back up and two split groups run again.
+  task->noMoreSplitsForGroup("0", 1);
+  waitForFinishedDrivers(task, 6);
+  EXPECT_EQ(2, targetSplitGroups());
+  EXPECT_EQ(12, task->numRunningDrivers());
+
+  task->noMoreSplitsForGroup("0", 5);
+  task->noMoreSplitsForGroup("0", 8);
+  waitForFinishedDrivers(task, 18);
+  task->noMoreSplits("0");
+  exec::PartitionedOutputBufferManager::getInstance().lock()->deleteResults(
+      task->taskId(), 0);
+  EXPECT_EQ(exec::TaskState::kFinished, task->state());
+}
+
 // Here we test various aspects of grouped/bucketed execution involving
 // output buffer and 3 pipelines.
 TEST_F(GroupedExecutionTest, groupedExecutionWithOutputBuffer) {
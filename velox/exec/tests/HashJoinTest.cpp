@@ -4699,6 +4699,111 @@ TEST_F(HashJoinTest, spillFileSize) {
   }
 }
 
+TEST_F(HashJoinTest, spillWithSkewedKey) {
+  // Half of the build rows and a third of the probe rows have the same key.
+  std::vector<RowVectorPtr> buildVectors;
+  std::vector<RowVectorPtr> probeVectors;
+  for (auto i = 0; i < 5; ++i) {
+    buildVectors.push_back(makeRowVector(
+        {"u_k0", "u_data"},
+        {makeFlatVector<int64_t>(
+             100, [i](auto row) { return row % 2 == 0 ? 7 : i * 100 + row; }),
+         makeFlatVector<int64_t>(100, [](auto row) { return row; })}));
+    probeVectors.push_back(makeRowVector(
+        {"t_k0", "t_data"},
+        {makeFlatVector<int64_t>(
+             100, [i](auto row) { return row % 3 == 0 ? 7 : i * 100 + row; }),
+         makeFlatVector<int64_t>(100, [](auto row) { return row; })}));
+  }
+
+  HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+      .numDrivers(numDrivers_)
+      .probeKeys({"t_k0"})
+      .probeVectors(std::move(probeVectors))
+      .buildKeys({"u_k0"})
+      .buildVectors(std::move(buildVectors))
+      .referenceQuery(
+          "SELECT t_k0, t_data, u_k0, u_data FROM t, u WHERE t.t_k0 = u.u_k0")
+      .config(core::QueryConfig::kJoinSpillSkewedKeyFraction, "0.2")
+      .checkSpillStats(false)
+      .maxSpillLevel(0)
+      .verifier([&](const std::shared_ptr<Task>& task, bool hasSpill) {
+        if (!hasSpill) {
+          return;
+        }
+        // The partition with the skewed key is kept in memory on the first
+        // spill runs as spilling the other partitions meets the target.
+        int64_t numSkewedInMemory = 0;
+        for (auto& pipeline : task->taskStats().pipelineStats) {
+          for (auto op : pipeline.operatorStats) {
+            if (op.operatorType == "HashBuild") {
+              numSkewedInMemory +=
+                  op.runtimeStats["skewedPartitionsInMemory"].sum;
+            }
+          }
+        }
+        ASSERT_GT(numSkewedInMemory, 0);
+      })
+      .run();
+}
+
+TEST_F(HashJoinTest, spillBlockJoin) {
+  // Half of the build rows have the same key. The spill partitions can not be
+  // split further with a max spill level of 0, so they are restored one spill
+  // file at a time and each file is probed with all the probe rows.
+  std::vector<RowVectorPtr> buildVectors;
+  std::vector<RowVectorPtr> probeVectors;
+  for (auto i = 0; i < 5; ++i) {
+    buildVectors.push_back(makeRowVector(
+        {"u_k0", "u_data"},
+        {makeFlatVector<int64_t>(
+             100, [i](auto row) { return row % 2 == 0 ? 7 : i * 100 + row; }),
+         makeFlatVector<int64_t>(100, [](auto row) { return row; })}));
+    probeVectors.push_back(makeRowVector(
+        {"t_k0", "t_data"},
+        {makeFlatVector<int64_t>(
+             100, [i](auto row) { return row % 3 == 0 ? 7 : i * 200 + row; }),
+         makeFlatVector<int64_t>(100, [](auto row) { return row; })}));
+  }
+
+  for (const auto joinType : {core::JoinType::kInner, core::JoinType::kRight}) {
+    SCOPED_TRACE(core::joinTypeName(joinType));
+    auto testProbeVectors = probeVectors;
+    auto testBuildVectors = buildVectors;
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .numDrivers(numDrivers_)
+        .probeKeys({"t_k0"})
+        .probeVectors(std::move(testProbeVectors))
+        .buildKeys({"u_k0"})
+        .buildVectors(std::move(testBuildVectors))
+        .joinType(joinType)
+        .joinOutputLayout({"t_k0", "t_data", "u_k0", "u_data"})
+        .referenceQuery(fmt::format(
+            "SELECT t_k0, t_data, u_k0, u_data FROM t {} JOIN u ON t_k0 = u_k0",
+            joinType == core::JoinType::kInner ? "INNER" : "RIGHT"))
+        .config(core::QueryConfig::kMaxSpillFileSize, "1")
+        .config(core::QueryConfig::kJoinSpillFallbackBlockSize, "1")
+        .checkSpillStats(false)
+        .maxSpillLevel(0)
+        .verifier([&](const std::shared_ptr<Task>& task, bool hasSpill) {
+          if (!hasSpill) {
+            return;
+          }
+          int64_t numUnsplittableInputs = 0;
+          for (auto& pipeline : task->taskStats().pipelineStats) {
+            for (auto op : pipeline.operatorStats) {
+              if (op.operatorType == "HashBuild") {
+                numUnsplittableInputs +=
+                    op.runtimeStats["unsplittableSpillInputs"].sum;
+              }
+            }
+          }
+          ASSERT_GT(numUnsplittableInputs, 0);
+        })
+        .run();
+  }
+}
+
 // The test is to verify if the hash build reservation has been released on
 // task error.
 DEBUG_ONLY_TEST_F(HashJoinTest, buildReservationReleaseCheck) {
@@ -4800,6 +4905,103 @@ TEST_F(HashJoinTest, dynamicFilterOnPartitionKey) {
       .run();
 }
 
+TEST_F(HashJoinTest, bloomFilterDynamicFilters) {
+  const int32_t numSplits = 10;
+  const int32_t numRowsProbe = 1'000;
+  const int32_t numRowsBuild = 500;
+
+  std::vector<std::string> keys;
+  keys.reserve(numSplits * numRowsProbe);
+  for (int32_t i = 0; i < numSplits * numRowsProbe; ++i) {
+    keys.push_back(fmt::format("key-{}", i));
+  }
+
+  std::vector<RowVectorPtr> probeVectors;
+  std::vector<std::shared_ptr<TempFilePath>> tempFiles;
+  for (int32_t i = 0; i < numSplits; ++i) {
+    auto rowVector = makeRowVector({
+        makeFlatVector<StringView>(
+            numRowsProbe,
+            [&](auto row) { return StringView(keys[i * numRowsProbe + row]); }),
+        makeFlatVector<int64_t>(numRowsProbe, [](auto row) { return row; }),
+    });
+    probeVectors.push_back(rowVector);
+    tempFiles.push_back(TempFilePath::create());
+    writeToFile(tempFiles.back()->path, rowVector);
+  }
+
+  // 500 string keys which can't be pushed down as a range or a list of values.
+  std::vector<RowVectorPtr> buildVectors = {makeRowVector(
+      {"u_c0", "u_c1"},
+      {
+          makeFlatVector<StringView>(
+              numRowsBuild,
+              [&](auto row) { return StringView(keys[row * 20]); }),
+          makeFlatVector<int64_t>(numRowsBuild, [](auto row) { return row; }),
+      })};
+
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  auto probeType = ROW({"c0", "c1"}, {VARCHAR(), BIGINT()});
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  core::PlanNodeId probeScanId;
+  auto op = PlanBuilder(planNodeIdGenerator, pool_.get())
+                .tableScan(probeType)
+                .capturePlanNodeId(probeScanId)
+                .hashJoin(
+                    {"c0"},
+                    {"u_c0"},
+                    PlanBuilder(planNodeIdGenerator, pool_.get())
+                        .values(buildVectors)
+                        .planNode(),
+                    "",
+                    {"c0", "c1", "u_c1"},
+                    core::JoinType::kInner)
+                .planNode();
+
+  std::vector<exec::Split> probeSplits;
+  for (auto& file : tempFiles) {
+    probeSplits.push_back(exec::Split(makeHiveConnectorSplit(file->path)));
+  }
+  SplitInput splits;
+  splits.emplace(probeScanId, probeSplits);
+
+  HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+      .planNode(op)
+      .inputSplits(splits)
+      .referenceQuery("SELECT t.c0, t.c1, u.u_c1 FROM t, u WHERE t.c0 = u.u_c0")
+      .verifier([&](const std::shared_ptr<Task>& task, bool hasSpill) {
+        SCOPED_TRACE(fmt::format("hasSpill:{}", hasSpill));
+        if (hasSpill) {
+          // Dynamic filtering should be disabled with spilling triggered.
+          ASSERT_EQ(0, getFiltersProduced(task, 1).sum);
+          ASSERT_EQ(0, getFiltersAccepted(task, 0).sum);
+          ASSERT_EQ(getInputPositions(task, 1), numRowsProbe * numSplits);
+        } else {
+          ASSERT_EQ(1, getFiltersProduced(task, 1).sum);
+          ASSERT_EQ(1, getFiltersAccepted(task, 0).sum);
+          // The bloom filter may pass false positives so the join can't be
+          // replaced with the filter.
+          ASSERT_EQ(0, getReplacedWithFilterRows(task, 1).sum);
+          ASSERT_LT(getInputPositions(task, 1), numRowsProbe * numSplits / 2);
+        }
+      })
+      .run();
+
+  // No bloom filter is built if it exceeds the max size.
+  HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+      .planNode(op)
+      .inputSplits(splits)
+      .config(core::QueryConfig::kHashJoinBloomFilterMaxSize, "16")
+      .referenceQuery("SELECT t.c0, t.c1, u.u_c1 FROM t, u WHERE t.c0 = u.u_c0")
+      .verifier([&](const std::shared_ptr<Task>& task, bool /*unused*/) {
+        ASSERT_EQ(0, getFiltersProduced(task, 1).sum);
+        ASSERT_EQ(getInputPositions(task, 1), numRowsProbe * numSplits);
+      })
+      .run();
+}
+
 DEBUG_ONLY_TEST_F(HashJoinTest, reclaimDuringInputProcessing) {
   constexpr int64_t kMaxBytes = 1LL << 30; // 1GB
   VectorFuzzer fuzzer({.vectorSize = 1000}, pool());
@@ -5766,4 +5968,63 @@ DEBUG_ONLY_TEST_F(HashJoinTest, hashProbeAbortDuringInputProcessing) {
     waitForAllTasksToBeDeleted();
   }
 }
+TEST_F(HashJoinTest, lazyBuildColumns) {
+  // The build side columns of the probe output are loaded only for the rows
+  // that pass the filter after the join. Unmatched rows of the left join have
+  // nulls.
+  auto probeVectors = makeBatches(5, [&](int32_t /*unused*/) {
+    return makeRowVector(
+        {"t0", "t1"},
+        {
+            makeFlatVector<int32_t>(1'000, [](auto row) { return row % 120; }),
+            makeFlatVector<int64_t>(1'000, folly::identity),
+        });
+  });
+  auto buildVectors = makeBatches(2, [&](int32_t batch) {
+    return makeRowVector(
+        {"u0", "u1", "u2"},
+        {
+            makeFlatVector<int32_t>(
+                50, [&](auto row) { return batch * 50 + row; }),
+            makeFlatVector<std::string>(
+                50,
+                [](auto row) {
+                  return fmt::format("{} is not an inline string", row);
+                },
+                nullEvery(7)),
+            makeArrayVector<int64_t>(
+                50,
+                [](auto row) { return row % 4; },
+                [](auto row) { return row; }),
+        });
+  });
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  for (auto joinType : {core::JoinType::kInner, core::JoinType::kLeft}) {
+    SCOPED_TRACE(core::joinTypeName(joinType));
+    auto plan =
+        PlanBuilder(planNodeIdGenerator)
+            .values(probeVectors)
+            .hashJoin(
+                {"t0"},
+                {"u0"},
+                PlanBuilder(planNodeIdGenerator)
+                    .values(buildVectors)
+                    .planNode(),
+                "",
+                {"t1", "u1", "u2"},
+                joinType)
+            .filter("t1 % 17 = 0")
+            .planNode();
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .planNode(std::move(plan))
+        .checkSpillStats(false)
+        .referenceQuery(fmt::format(
+            "SELECT t1, u1, u2 FROM t {} JOIN u ON t0 = u0 WHERE t1 % 17 = 0",
+            joinType == core::JoinType::kLeft ? "LEFT" : "INNER"))
+        .run();
+  }
+}
 } // namespace
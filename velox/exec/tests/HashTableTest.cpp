@@ -560,6 +560,33 @@ TEST_P(HashTableTest, mixed6Sparse) {
   testCycle(BaseHashTable::HashMode::kHash, 100000, 9, type, 6);
 }
 
+TEST_P(HashTableTest, probeGroupSizeNormalized) {
+  auto type = ROW({"k1", "k2"}, {BIGINT(), BIGINT()});
+  keySpacing_ = 1000;
+  insertPct_ = 50;
+  testCycle(BaseHashTable::HashMode::kNormalizedKey, 10000, 2, type, 2);
+  for (auto size : {1, 3, 17, HashTable<true>::kMaxProbeGroupSize}) {
+    topTable_->setProbeGroupSize(size);
+    testProbe();
+  }
+  VELOX_ASSERT_THROW(topTable_->setProbeGroupSize(0), "");
+  VELOX_ASSERT_THROW(
+      topTable_->setProbeGroupSize(HashTable<true>::kMaxProbeGroupSize + 1),
+      "");
+}
+
+TEST_P(HashTableTest, probeGroupSizeHash) {
+  auto type =
+      ROW({"key"}, {ROW({"k1", "k2", "k3"}, {BIGINT(), VARCHAR(), BIGINT()})});
+  keySpacing_ = 1000;
+  insertPct_ = 50;
+  testCycle(BaseHashTable::HashMode::kHash, 100000, 2, type, 1);
+  for (auto size : {1, 3, 17, HashTable<true>::kMaxProbeGroupSize}) {
+    topTable_->setProbeGroupSize(size);
+    testProbe();
+  }
+}
+
 // It should be safe to call clear() before we insert any data into HashTable
 TEST_P(HashTableTest, clear) {
   std::vector<std::unique_ptr<VectorHasher>> keyHashers;
@@ -773,6 +800,186 @@ TEST_P(HashTableTest, checkSizeValidation) {
   ASSERT_EQ(table->capacity(), 512 << 10);
 }
 
+TEST_P(HashTableTest, packedKeys) {
+  constexpr int32_t kSize = 10'000;
+  auto type = ROW({"k1", "k2"}, {BIGINT(), BIGINT()});
+  auto table = createHashTableForAggregation(type, 2);
+  auto lookup = std::make_unique<HashLookup>(table->hashers());
+  table->testingSetHashMode(BaseHashTable::HashMode::kHash, kSize);
+
+  // The second key differs in the high bits only, so that the keys of
+  // different groups agree in one of the two words.
+  auto makeKeys = [&](std::function<bool(vector_size_t)> isNullAt) {
+    return vectorMaker_->rowVector({
+        vectorMaker_->flatVector<int64_t>(
+            kSize, [](auto row) { return row % 1'000; }, isNullAt),
+        vectorMaker_->flatVector<int64_t>(
+            kSize, [](auto row) { return (row / 1'000) << 40; }),
+    });
+  };
+  auto keys = makeKeys(nullptr);
+  insertGroups(*keys, *lookup, *table);
+  ASSERT_EQ(table->hashMode(), BaseHashTable::HashMode::kHash);
+  ASSERT_EQ(table->numDistinct(), kSize);
+  std::vector<char*> groups(
+      lookup->hits.begin(), lookup->hits.begin() + kSize);
+
+  insertGroups(*keys, *lookup, *table);
+  ASSERT_EQ(table->numDistinct(), kSize);
+  for (auto row = 0; row < kSize; ++row) {
+    ASSERT_EQ(groups[row], lookup->hits[row]);
+  }
+
+  // A batch with null keys takes the per-key compare. Each null in 'k1'
+  // makes a new group per distinct 'k2'.
+  auto keysWithNulls = makeKeys([](auto row) { return row % 7 == 0; });
+  insertGroups(*keysWithNulls, *lookup, *table);
+  ASSERT_EQ(table->numDistinct(), kSize + 10);
+  for (auto row = 0; row < kSize; ++row) {
+    if (row % 7 != 0) {
+      ASSERT_EQ(groups[row], lookup->hits[row]);
+    }
+  }
+
+  // The groups with null keys are not hit by keys without nulls.
+  insertGroups(*keys, *lookup, *table);
+  ASSERT_EQ(table->numDistinct(), kSize + 10);
+  for (auto row = 0; row < kSize; ++row) {
+    ASSERT_EQ(groups[row], lookup->hits[row]);
+  }
+}
+
+TEST_P(HashTableTest, incrementalRehash) {
+  constexpr int32_t kBatchSize = 1'000;
+  constexpr int32_t kNumBatches = 40;
+  constexpr int32_t kNumReprobed = 50;
+  auto type = ROW({"k1", "k2"}, {BIGINT(), BIGINT()});
+  std::vector<std::unique_ptr<VectorHasher>> keyHashers;
+  for (auto channel = 0; channel < 2; ++channel) {
+    keyHashers.emplace_back(
+        std::make_unique<VectorHasher>(type->childAt(channel), channel));
+  }
+  auto table = HashTable<false>::createForAggregation(
+      std::move(keyHashers), std::vector<Accumulator>{}, pool_.get(), 4'096);
+  table->testingSetHashMode(BaseHashTable::HashMode::kHash, 0);
+  auto lookup = std::make_unique<HashLookup>(table->hashers());
+
+  auto makeKeys = [&](int32_t start, int32_t size) {
+    return vectorMaker_->rowVector({
+        vectorMaker_->flatVector<int64_t>(
+            size, [&](auto row) { return start + row; }),
+        vectorMaker_->flatVector<int64_t>(
+            size, [&](auto row) { return (start + row) * 7; }),
+    });
+  };
+  // Probes keys from 'start' and checks that they hit 'groups'.
+  std::vector<char*> groups;
+  auto reprobe = [&](int32_t start, int32_t size) {
+    insertGroups(*makeKeys(start, size), *lookup, *table);
+    ASSERT_TRUE(lookup->newGroups.empty());
+    for (auto row = 0; row < size; ++row) {
+      ASSERT_EQ(groups[start + row], lookup->hits[row]);
+    }
+  };
+
+  bool rehashSeen = false;
+  for (auto batch = 0; batch < kNumBatches; ++batch) {
+    insertGroups(*makeKeys(batch * kBatchSize, kBatchSize), *lookup, *table);
+    ASSERT_EQ(lookup->newGroups.size(), kBatchSize);
+    groups.insert(
+        groups.end(), lookup->hits.begin(), lookup->hits.begin() + kBatchSize);
+    rehashSeen |= table->testingRehashInProgress();
+    table->checkConsistency();
+    // Probes a few keys of an earlier batch while entries are being moved.
+    reprobe((batch / 2) * kBatchSize, kNumReprobed);
+    table->checkConsistency();
+  }
+  ASSERT_TRUE(rehashSeen);
+  ASSERT_EQ(table->numDistinct(), kBatchSize * kNumBatches);
+  for (auto batch = 0; batch < kNumBatches; ++batch) {
+    reprobe(batch * kBatchSize, kBatchSize);
+  }
+
+  // Erase moves the remaining entries to the new table.
+  insertGroups(
+      *makeKeys(kNumBatches * kBatchSize, kBatchSize), *lookup, *table);
+  groups.insert(
+      groups.end(), lookup->hits.begin(), lookup->hits.begin() + kBatchSize);
+  table->erase(folly::Range<char**>(groups.data(), kBatchSize));
+  ASSERT_FALSE(table->testingRehashInProgress());
+  table->checkConsistency();
+  ASSERT_EQ(table->numDistinct(), kBatchSize * kNumBatches);
+  reprobe(kBatchSize, kBatchSize * (kNumBatches - 1));
+}
+
+TEST_P(HashTableTest, compactRows) {
+  constexpr int32_t kBatchSize = 1'000;
+  constexpr int32_t kNumBatches = 20;
+  auto type = ROW({"k1", "k2"}, {BIGINT(), BIGINT()});
+  std::vector<std::unique_ptr<VectorHasher>> keyHashers;
+  for (auto channel = 0; channel < 2; ++channel) {
+    keyHashers.emplace_back(
+        std::make_unique<VectorHasher>(type->childAt(channel), channel));
+  }
+  auto table = HashTable<false>::createForAggregation(
+      std::move(keyHashers), std::vector<Accumulator>{}, pool_.get());
+  auto lookup = std::make_unique<HashLookup>(table->hashers());
+  auto makeKeys = [&](int32_t start, int32_t size) {
+    return vectorMaker_->rowVector({
+        vectorMaker_->flatVector<int64_t>(
+            size, [&](auto row) { return start + row; }),
+        vectorMaker_->flatVector<int64_t>(
+            size, [&](auto row) { return (start + row) * 7; }),
+    });
+  };
+
+  std::vector<char*> groups;
+  for (auto batch = 0; batch < kNumBatches; ++batch) {
+    insertGroups(*makeKeys(batch * kBatchSize, kBatchSize), *lookup, *table);
+    groups.insert(
+        groups.end(), lookup->hits.begin(), lookup->hits.begin() + kBatchSize);
+  }
+  // Erases all but every 4th batch.
+  std::vector<char*> erased;
+  for (auto i = 0; i < groups.size(); ++i) {
+    if ((i / kBatchSize) % 4 != 0) {
+      erased.push_back(groups[i]);
+    }
+  }
+  table->erase(folly::Range<char**>(erased.data(), erased.size()));
+  const auto numDistinct = table->numDistinct();
+  const auto bytesBefore = table->allocatedBytes();
+
+  ASSERT_TRUE(table->compactRows());
+  EXPECT_EQ(table->rows()->numFreeRows(), 0);
+  EXPECT_EQ(table->numDistinct(), numDistinct);
+  EXPECT_LT(table->allocatedBytes(), bytesBefore);
+  table->checkConsistency();
+  table->rows()->checkConsistency();
+
+  // The remaining keys are found in the moved rows and the erased keys are
+  // new.
+  for (auto batch = 0; batch < kNumBatches; ++batch) {
+    auto keys = makeKeys(batch * kBatchSize, kBatchSize);
+    insertGroups(*keys, *lookup, *table);
+    if (batch % 4 != 0) {
+      ASSERT_EQ(lookup->newGroups.size(), kBatchSize);
+      continue;
+    }
+    ASSERT_TRUE(lookup->newGroups.empty());
+    for (auto column = 0; column < 2; ++column) {
+      auto result = BaseVector::create(BIGINT(), kBatchSize, pool_.get());
+      table->rows()->extractColumn(
+          lookup->hits.data(), kBatchSize, column, result);
+      const auto& expected = keys->childAt(column);
+      for (auto row = 0; row < kBatchSize; ++row) {
+        ASSERT_TRUE(expected->equalValueAt(result.get(), row, row));
+      }
+    }
+  }
+  table->checkConsistency();
+}
+
 TEST_P(HashTableTest, listNullKeyRows) {
   VectorPtr keys = vectorMaker_->flatVector<int64_t>(500, folly::identity);
   testListNullKeyRows(keys, BaseHashTable::HashMode::kArray);
@@ -283,6 +283,65 @@ TEST_F(LocalPartitionTest, maxBufferSizePartition) {
   verifyExchangeSourceOperatorStats(task, 2100, 42);
 }
 
+TEST_F(LocalPartitionTest, copyPartitions) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 21; i++) {
+    vectors.emplace_back(makeRowVector({
+        makeFlatVector<int32_t>(100, [i](auto row) { return i * 100 + row; }),
+        makeFlatVector<StringView>(
+            100,
+            [](auto row) {
+              return StringView::makeInline(fmt::format("s{}", row % 17));
+            },
+            nullEvery(7)),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto valuesNode = [&](int start, int end) {
+    return PlanBuilder(planNodeIdGenerator)
+        .values(std::vector<RowVectorPtr>(
+            vectors.begin() + start, vectors.begin() + end))
+        .planNode();
+  };
+
+  core::PlanNodeId exchangeId;
+  auto plan = PlanBuilder(planNodeIdGenerator)
+                  .localPartition(
+                      {"c0"},
+                      {
+                          valuesNode(0, 7),
+                          valuesNode(7, 14),
+                          valuesNode(14, 21),
+                      })
+                  .capturePlanNodeId(exchangeId)
+                  .partialAggregation({"c1"}, {"count(1)", "sum(c0)"})
+                  .planNode();
+
+  auto numExchangeVectors = [&](bool copyPartitions) {
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .maxDrivers(4)
+            .config(
+                core::QueryConfig::kLocalExchangeCopyPartitions,
+                copyPartitions ? "true" : "false")
+            .config(core::QueryConfig::kPreferredOutputBatchRows, "300")
+            .assertResults(
+                "SELECT c1, count(1), sum(c0) FROM tmp GROUP BY 1");
+    const auto stats =
+        toPlanStats(task->taskStats()).at(exchangeId).operatorStats;
+    EXPECT_EQ(stats.at("LocalExchange")->inputRows, 2100);
+    return stats.at("LocalExchange")->inputVectors;
+  };
+
+  // Each of the 21 inputs gets a dictionary per partition.
+  ASSERT_EQ(numExchangeVectors(false), 21 * 4);
+  // Each of the 3 producers enqueues about 700 / 4 rows per partition at
+  // the end.
+  ASSERT_EQ(numExchangeVectors(true), 3 * 4);
+}
+
 TEST_F(LocalPartitionTest, blockingOnLocalExchangeQueue) {
   auto localExchangeBufferSize = "1024";
   auto baseVector = vectorMaker_.flatVector<int64_t>(
@@ -433,6 +492,43 @@ TEST_F(LocalPartitionTest, earlyCompletion) {
   assertTaskReferenceCount(task, 1);
 }
 
+TEST_F(LocalPartitionTest, earlyCompletionStopsProducers) {
+  std::vector<RowVectorPtr> data = {
+      makeRowVector({makeFlatSequence(3, 100)}),
+  };
+
+  // The limit is not in the output pipeline, so the task does not finish
+  // when it is reached. The producers of the inner local exchange must stop
+  // on their own, before producing all of 10M rows.
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto plan =
+      PlanBuilder(planNodeIdGenerator)
+          .localPartition(
+              {},
+              {PlanBuilder(planNodeIdGenerator)
+                   .localPartition(
+                       {},
+                       {PlanBuilder(planNodeIdGenerator)
+                            .values(data, false, 100'000)
+                            .planNode()})
+                   .limit(0, 2, true)
+                   .planNode()})
+          .planNode();
+
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .config(core::QueryConfig::kMaxLocalExchangeBufferSize, "100")
+                  .assertResults("VALUES (3), (4)");
+
+  for (const auto& pipeline : task->taskStats().pipelineStats) {
+    const auto& producerStats = pipeline.operatorStats.back();
+    if (pipeline.operatorStats.front().operatorType == "Values") {
+      ASSERT_EQ(producerStats.operatorType, "LocalPartition");
+      ASSERT_LT(producerStats.inputPositions, 100'000);
+    }
+  }
+  assertTaskReferenceCount(task, 1);
+}
+
 TEST_F(LocalPartitionTest, earlyCancelation) {
   std::vector<RowVectorPtr> data = {
       makeRowVector({makeFlatSequence(3, 100)}),
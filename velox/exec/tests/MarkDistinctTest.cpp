@@ -17,6 +17,7 @@
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::test;
@@ -141,3 +142,49 @@ TEST_F(MarkDistinctTest, aggregation) {
       .assertResults(
           "SELECT c0, sum(distinct c1), sum(distinct c2) FROM tmp GROUP BY 1");
 }
+
+TEST_F(MarkDistinctTest, spill) {
+  const vector_size_t batchSize = 1'000;
+  std::vector<std::string> strings;
+  for (auto i = 0; i < 50; ++i) {
+    strings.push_back(fmt::format("{}-{}", std::string(20, 'a' + i % 26), i));
+  }
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            batchSize,
+            [&](auto row) { return (row * 7 + i) % 2'000; },
+            nullEvery(37)),
+        makeFlatVector<StringView>(
+            batchSize,
+            [&](auto row) {
+              return StringView(strings[(row + i) % strings.size()]);
+            }),
+        makeFlatVector<int64_t>(
+            batchSize, [&](auto row) { return batchSize * i + row; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  // The first row of each distinct key is marked as distinct, including after
+  // the key has been spilled.
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .markDistinct("c0_distinct", {"c0", "c1"})
+                  .planNode();
+  auto spillDirectory = TempDirectoryPath::create();
+  auto task =
+      AssertQueryBuilder(plan, duckDbQueryRunner_)
+          .spillDirectory(spillDirectory->path)
+          .config(core::QueryConfig::kSpillEnabled, "true")
+          .config(core::QueryConfig::kMarkDistinctSpillEnabled, "true")
+          .config(core::QueryConfig::kTestingSpillPct, "100")
+          .assertResults(
+              "SELECT *, row_number() over (partition by c0, c1 order by c2) = 1 FROM tmp");
+  auto stats = task->taskStats().pipelineStats[0].operatorStats[1];
+  ASSERT_GT(stats.spilledRows, 0);
+  ASSERT_GT(stats.spilledBytes, 0);
+  ASSERT_GT(stats.spilledPartitions, 0);
+  ASSERT_GT(stats.spilledFiles, 0);
+}
@@ -17,6 +17,7 @@
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::exec;
@@ -539,3 +540,77 @@ TEST_F(MergeJoinTest, nullKeys) {
   AssertQueryBuilder(plan, duckDbQueryRunner_)
       .assertResults("SELECT * FROM t LEFT JOIN u ON t.t0 = u.u0");
 }
+
+TEST_F(MergeJoinTest, spill) {
+  // A skewed key on the right side whose matching rows span several batches
+  // and are spilled. Two other keys match within a single batch.
+  std::vector<RowVectorPtr> left;
+  left.push_back(makeRowVector(
+      {"t0", "t1"},
+      {makeFlatVector<int64_t>({1, 5, 5, 5, 7, 9}),
+       makeFlatVector<int64_t>({0, 1, 2, 3, 4, 5})}));
+  left.push_back(makeRowVector(
+      {"t0", "t1"},
+      {makeFlatVector<int64_t>({9, 9, 11}),
+       makeFlatVector<int64_t>({6, 7, 8})}));
+
+  std::vector<RowVectorPtr> right;
+  right.push_back(makeRowVector(
+      {"u0", "u1"},
+      {makeFlatVector<int64_t>(
+           100, [](auto row) { return row < 10 ? row / 5 : 5; }),
+       makeFlatVector<int64_t>(100, [](auto row) { return row; })}));
+  for (auto i = 1; i < 5; ++i) {
+    right.push_back(makeRowVector(
+        {"u0", "u1"},
+        {makeFlatVector<int64_t>(
+             100, [i](auto row) { return i < 4 || row < 50 ? 5 : 9; }),
+         makeFlatVector<int64_t>(
+             100, [i](auto row) { return i * 100 + row; })}));
+  }
+
+  createDuckDbTable("t", left);
+  createDuckDbTable("u", right);
+
+  for (auto joinType : {core::JoinType::kInner, core::JoinType::kLeft}) {
+    SCOPED_TRACE(core::joinTypeName(joinType));
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    core::PlanNodeId joinNodeId;
+    auto plan =
+        PlanBuilder(planNodeIdGenerator)
+            .values(left)
+            .mergeJoin(
+                {"t0"},
+                {"u0"},
+                PlanBuilder(planNodeIdGenerator).values(right).planNode(),
+                "",
+                {"t0", "t1", "u1"},
+                joinType)
+            .capturePlanNodeId(joinNodeId)
+            .planNode();
+
+    for (auto batchSize : {7, 1024}) {
+      auto spillDirectory = exec::test::TempDirectoryPath::create();
+      auto task =
+          AssertQueryBuilder(plan, duckDbQueryRunner_)
+              .spillDirectory(spillDirectory->path)
+              .config(core::QueryConfig::kSpillEnabled, "true")
+              .config(core::QueryConfig::kMergeJoinSpillEnabled, "true")
+              .config(core::QueryConfig::kMergeJoinSpillMemoryThreshold, "1")
+              .config(
+                  core::QueryConfig::kPreferredOutputBatchRows,
+                  std::to_string(batchSize))
+              .assertResults(fmt::format(
+                  "SELECT t0, t1, u1 FROM t {} JOIN u ON t0 = u0",
+                  core::joinTypeName(joinType)));
+
+      auto planStats = toPlanStats(task->taskStats());
+      const auto& joinStats = planStats.at(joinNodeId);
+      // All 440 rows with key 5 spill. The 50 rows with key 9 are in the
+      // last batch and do not.
+      ASSERT_EQ(joinStats.spilledRows, 440);
+      ASSERT_GT(joinStats.spilledFiles, 0);
+      ASSERT_EQ(joinStats.customStats.at("maxRightMatchRows").max, 440);
+    }
+  }
+}
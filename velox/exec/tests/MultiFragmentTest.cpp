@@ -518,6 +518,40 @@ TEST_F(MultiFragmentTest, partitionedOutput) {
   }
 }
 
+TEST_F(MultiFragmentTest, scatterPartitionedOutput) {
+  setupSources(10, 1000);
+  configSettings_[core::QueryConfig::kPartitionedOutputScatterMinDestinations] =
+      "2";
+  // Small pages so that pages are flushed while later inputs are scattered.
+  configSettings_[core::QueryConfig::kMaxPartitionedOutputBufferSize] = "1024";
+
+  constexpr int32_t kFanout = 8;
+  auto leafTaskId = makeTaskId("leaf", 0);
+  auto leafPlan = PlanBuilder()
+                      .values(vectors_)
+                      .partitionedOutput({"c0"}, kFanout, {"c5", "c0", "c3"})
+                      .planNode();
+  auto leafTask = makeTask(leafTaskId, leafPlan, 0);
+  Task::start(leafTask, 4);
+
+  auto intermediatePlan = PlanBuilder()
+                              .exchange(leafPlan->outputType())
+                              .partitionedOutput({}, 1)
+                              .planNode();
+  std::vector<std::string> intermediateTaskIds;
+  for (auto i = 0; i < kFanout; ++i) {
+    intermediateTaskIds.push_back(makeTaskId("intermediate", i));
+    auto intermediateTask =
+        makeTask(intermediateTaskIds.back(), intermediatePlan, i);
+    Task::start(intermediateTask, 1);
+    addRemoteSplits(intermediateTask, {leafTaskId});
+  }
+
+  auto op = PlanBuilder().exchange(intermediatePlan->outputType()).planNode();
+  assertQuery(op, intermediateTaskIds, "SELECT c5, c0, c3 FROM tmp");
+  ASSERT_TRUE(waitForTaskCompletion(leafTask.get())) << leafTask->taskId();
+}
+
 TEST_F(MultiFragmentTest, broadcast) {
   auto data = makeRowVector(
       {makeFlatVector<int32_t>(1'000, [](auto row) { return row; })});
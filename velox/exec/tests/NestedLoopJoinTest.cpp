@@ -13,8 +13,11 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/exec/tests/utils/VectorTestUtil.h"
 #include "velox/vector/fuzzer/VectorFuzzer.h"
 
@@ -432,3 +435,63 @@ TEST_F(NestedLoopJoinTest, allTypes) {
       "SELECT t0, u0 FROM t {0} JOIN u ON t.t0 {1} u0 AND t1 {1} u1 AND t2 {1} u2 AND t3 {1} u3 AND t4 {1} u4 AND t5 {1} u5 AND t6 {1} u6");
   runTest(probeVectors, buildVectors);
 }
+
+TEST_F(NestedLoopJoinTest, spill) {
+  auto probeVectors = makeBatches(20, 5, probeType_, pool_.get());
+  auto buildVectors = makeBatches(18, 5, buildType_, pool_.get());
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  struct {
+    core::JoinType joinType;
+    // Size of the spilled build side data read back at a time.
+    std::string readBufferSize;
+
+    std::string debugString() const {
+      return fmt::format(
+          "joinType:{} readBufferSize:{}",
+          joinTypeName(joinType),
+          readBufferSize);
+    }
+  } testSettings[] = {
+      {core::JoinType::kInner, "1"},
+      {core::JoinType::kInner, "1000000"},
+      {core::JoinType::kLeft, "1"},
+      {core::JoinType::kLeft, "1000000"}};
+
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.debugString());
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    core::PlanNodeId joinNodeId;
+    auto plan =
+        PlanBuilder(planNodeIdGenerator)
+            .values(probeVectors)
+            .nestedLoopJoin(
+                PlanBuilder(planNodeIdGenerator)
+                    .values(buildVectors)
+                    .planNode(),
+                "t0 < u0",
+                {"t0", "u0"},
+                testData.joinType)
+            .capturePlanNodeId(joinNodeId)
+            .planNode();
+
+    auto spillDirectory = exec::test::TempDirectoryPath::create();
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .spillDirectory(spillDirectory->path)
+            .config(core::QueryConfig::kSpillEnabled, "true")
+            .config(core::QueryConfig::kNestedLoopJoinSpillEnabled, "true")
+            .config(core::QueryConfig::kTestingSpillPct, "100")
+            .config(
+                core::QueryConfig::kNestedLoopJoinSpillReadBufferSize,
+                testData.readBufferSize)
+            .assertResults(fmt::format(
+                "SELECT t0, u0 FROM t {} JOIN u ON t.t0 < u.u0",
+                joinTypeName(testData.joinType)));
+
+    auto planStats = toPlanStats(task->taskStats());
+    ASSERT_GT(planStats.at(joinNodeId).spilledBytes, 0);
+    ASSERT_GT(planStats.at(joinNodeId).spilledFiles, 0);
+  }
+}
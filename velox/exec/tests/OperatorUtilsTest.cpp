@@ -276,6 +276,19 @@ TEST_F(OperatorUtilsTest, addOperatorRuntimeStats) {
   ASSERT_EQ(stats[statsName].sum, 500);
   ASSERT_EQ(stats[statsName].max, 200);
   ASSERT_EQ(stats[statsName].min, 100);
+  ASSERT_FALSE(stats[statsName].histogram.has_value());
+
+  const std::string histogramName("histogramStats");
+  registerRuntimeHistogram(histogramName);
+  for (auto i = 1; i <= 100; ++i) {
+    addOperatorRuntimeStats(
+        histogramName,
+        RuntimeCounter(i * 1'000, RuntimeCounter::Unit::kNanos),
+        stats);
+  }
+  ASSERT_TRUE(stats[histogramName].histogram.has_value());
+  ASSERT_EQ(stats[histogramName].histogram->count(), 100);
+  ASSERT_NEAR(stats[histogramName].histogram->percentile(90), 90'000, 3'000);
 }
 
 TEST_F(OperatorUtilsTest, initializeRowNumberMapping) {
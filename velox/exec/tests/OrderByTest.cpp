@@ -306,6 +306,45 @@ TEST_F(OrderByTest, multipleKeys) {
       {0, 1});
 }
 
+TEST_F(OrderByTest, parallel) {
+  vector_size_t batchSize = 1000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 4; ++i) {
+    auto c0 = makeFlatVector<int64_t>(
+        batchSize,
+        [&](vector_size_t row) { return row % 97 + i; },
+        nullEvery(7));
+    auto c1 = makeFlatVector<StringView>(batchSize, [&](vector_size_t row) {
+      return StringView(fmt::format("{}", (row * 17 + i) % 101));
+    });
+    vectors.push_back(makeRowVector({c0, c1}));
+  }
+  createDuckDbTable(vectors);
+
+  // Each of the 4 drivers sorts a copy of the input and the LocalMerge merges
+  // the 4 sorted runs.
+  const std::string duckDbSql =
+      "SELECT * FROM (SELECT * FROM tmp UNION ALL SELECT * FROM tmp "
+      "UNION ALL SELECT * FROM tmp UNION ALL SELECT * FROM tmp) ";
+  for (const auto& orderBy :
+       {std::vector<std::string>{"c0 ASC NULLS LAST", "c1"},
+        std::vector<std::string>{"c0 DESC NULLS FIRST", "c1 DESC"}}) {
+    SCOPED_TRACE(folly::join(", ", orderBy));
+    core::PlanNodeId valuesId;
+    CursorParameters params;
+    params.planNode = PlanBuilder()
+                          .values(vectors, true)
+                          .capturePlanNodeId(valuesId)
+                          .parallelOrderBy(orderBy)
+                          .planNode();
+    params.maxDrivers = 4;
+    auto task = assertQueryOrdered(
+        params, duckDbSql + "ORDER BY " + folly::join(", ", orderBy), {0, 1});
+    auto planStats = toPlanStats(task->taskStats());
+    EXPECT_EQ(4, planStats.at(valuesId).numDrivers);
+  }
+}
+
 TEST_F(OrderByTest, multiBatchResult) {
   vector_size_t batchSize = 5000;
   std::vector<RowVectorPtr> vectors;
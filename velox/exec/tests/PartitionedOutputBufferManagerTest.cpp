@@ -17,9 +17,12 @@
 #include <gtest/gtest.h>
 #include "folly/experimental/EventCount.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/common/testutil/TestValue.h"
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/exec/Task.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/serializers/PrestoSerializer.h"
 
 using namespace facebook::velox;
@@ -37,6 +40,7 @@ class PartitionedOutputBufferManagerTest : public testing::Test {
   }
 
   void SetUp() override {
+    common::testutil::TestValue::enable();
     pool_ = facebook::velox::memory::addDefaultLeafMemoryPool();
     bufferManager_ = PartitionedOutputBufferManager::getInstance().lock();
     if (!isRegisteredVectorSerde()) {
@@ -55,7 +59,8 @@ class PartitionedOutputBufferManagerTest : public testing::Test {
       PartitionedOutputNode::Kind kind,
       int numDestinations,
       int numDrivers,
-      int maxPartitionedOutputBufferSize = 0) {
+      int maxPartitionedOutputBufferSize = 0,
+      const std::string& spillDirectory = "") {
     bufferManager_->removeTask(taskId);
 
     auto planFragment = exec::test::PlanBuilder()
@@ -67,11 +72,17 @@ class PartitionedOutputBufferManagerTest : public testing::Test {
       configSettings[core::QueryConfig::kMaxPartitionedOutputBufferSize] =
           std::to_string(maxPartitionedOutputBufferSize);
     }
+    if (!spillDirectory.empty()) {
+      configSettings[core::QueryConfig::kSpillEnabled] = "true";
+    }
     auto queryCtx = std::make_shared<core::QueryCtx>(
         executor_.get(), std::move(configSettings));
 
     auto task =
         Task::create(taskId, std::move(planFragment), 0, std::move(queryCtx));
+    if (!spillDirectory.empty()) {
+      task->setSpillDirectory(spillDirectory);
+    }
 
     bufferManager_->initializeTask(task, kind, numDestinations, numDrivers);
     return task;
@@ -510,11 +521,12 @@ TEST_F(PartitionedOutputBufferManagerTest, destinationBuffer) {
         buffer.toString(), "[ARBITRARY_BUFFER PAGES[9] NO MORE DATA[false]]");
     std::atomic<bool> notified{false};
     int64_t numBytes{0};
-    auto buffers = destinationBuffer.getData(
+    auto data = destinationBuffer.getData(
         1'000'000'000,
         0,
         [&](std::vector<std::unique_ptr<folly::IOBuf>> /*unused*/,
             int64_t /*unused*/) { notified = true; });
+    auto buffers = data.load();
     for (const auto& buffer : buffers) {
       numBytes += buffer->length();
     }
@@ -529,7 +541,7 @@ TEST_F(PartitionedOutputBufferManagerTest, destinationBuffer) {
     auto pages = destinationBuffer.acknowledge(1, false);
     ASSERT_EQ(pages.size(), 1);
 
-    buffers = destinationBuffer.getData(
+    data = destinationBuffer.getData(
         1'000'000,
         1,
         [&](std::vector<std::unique_ptr<folly::IOBuf>> buffers,
@@ -541,7 +553,7 @@ TEST_F(PartitionedOutputBufferManagerTest, destinationBuffer) {
           }
           notified = true;
         });
-    ASSERT_TRUE(buffers.empty());
+    ASSERT_TRUE(data.empty());
     ASSERT_FALSE(notified);
 
     destinationBuffer.maybeLoadData(&buffer);
@@ -993,6 +1005,197 @@ TEST_F(PartitionedOutputBufferManagerTest, outOfOrderAcks) {
   bufferManager_->removeTask(taskId);
 }
 
+TEST_F(PartitionedOutputBufferManagerTest, broadcastSharesPages) {
+  const std::string taskId = "t0";
+  const int64_t maxSize = 1'000'000;
+  auto task = initializeTask(
+      taskId, rowType_, PartitionedOutputNode::Kind::kBroadcast, 3, 1, maxSize);
+  bufferManager_->updateOutputBuffers(taskId, 3, true);
+  auto buffer = bufferManager_->getBufferIfExists(taskId);
+
+  auto page = makeSerializedPage(rowType_, 100);
+  const auto pageSize = page->size();
+  ContinueFuture future;
+  ASSERT_FALSE(bufferManager_->enqueue(taskId, 0, std::move(page), &future));
+  // Accounted once, not once per destination.
+  ASSERT_DOUBLE_EQ(buffer->getUtilization(), pageSize / (double)maxSize);
+
+  // All destinations get the same bytes without a copy.
+  std::vector<const uint8_t*> data;
+  for (int destination = 0; destination < 3; ++destination) {
+    ASSERT_TRUE(bufferManager_->getData(
+        taskId,
+        destination,
+        std::numeric_limits<uint64_t>::max(),
+        0,
+        [&](std::vector<std::unique_ptr<folly::IOBuf>> pages,
+            int64_t /*sequence*/) {
+          ASSERT_EQ(pages.size(), 1);
+          data.push_back(pages[0]->data());
+        }));
+  }
+  ASSERT_EQ(data.size(), 3);
+  ASSERT_EQ(data[0], data[1]);
+  ASSERT_EQ(data[0], data[2]);
+
+  // The memory is released by the last acknowledgement.
+  acknowledge(taskId, 0, 1);
+  acknowledge(taskId, 1, 1);
+  ASSERT_DOUBLE_EQ(buffer->getUtilization(), pageSize / (double)maxSize);
+  acknowledge(taskId, 2, 1);
+  ASSERT_EQ(buffer->getUtilization(), 0);
+
+  buffer.reset();
+  task->requestCancel();
+  bufferManager_->removeTask(taskId);
+}
+
+TEST_F(PartitionedOutputBufferManagerTest, spill) {
+  filesystems::registerLocalFileSystem();
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  const std::string taskId = "spill";
+  auto task = initializeTask(
+      taskId,
+      rowType_,
+      PartitionedOutputNode::Kind::kPartitioned,
+      2,
+      1,
+      1024,
+      spillDirectory->path);
+
+  auto toString = [](const folly::IOBuf& iobuf) {
+    auto copy = iobuf.cloneCoalesced();
+    return std::string(
+        reinterpret_cast<const char*>(copy->data()), copy->length());
+  };
+
+  // Each page is larger than the buffer, so the producer would block on each
+  // without spilling.
+  std::vector<std::string> expected;
+  for (int i = 0; i < 10; ++i) {
+    auto page = makeSerializedPage(rowType_, 1'000);
+    ASSERT_GT(page->size(), 1'024);
+    expected.push_back(toString(*page->getIOBuf()));
+    ContinueFuture future;
+    ASSERT_FALSE(
+        bufferManager_->enqueue(taskId, i % 2, std::move(page), &future));
+  }
+  auto buffer = bufferManager_->getBufferIfExists(taskId);
+  ASSERT_NE(buffer, nullptr);
+  ASSERT_GT(buffer->spilledBytes(), 0);
+  ASSERT_LE(buffer->getUtilization(), 1);
+  ASSERT_FALSE(buffer->isOverutilized());
+  noMoreData(taskId);
+
+  for (int destination = 0; destination < 2; ++destination) {
+    std::vector<std::unique_ptr<folly::IOBuf>> received;
+    ASSERT_TRUE(bufferManager_->getData(
+        taskId,
+        destination,
+        std::numeric_limits<uint64_t>::max(),
+        0,
+        [&](std::vector<std::unique_ptr<folly::IOBuf>> pages,
+            int64_t /*sequence*/) { received = std::move(pages); }));
+    ASSERT_EQ(received.size(), 6);
+    for (int i = 0; i < 5; ++i) {
+      ASSERT_EQ(toString(*received[i]), expected[destination + 2 * i]);
+    }
+    ASSERT_EQ(received.back(), nullptr);
+    deleteResults(taskId, destination);
+  }
+  buffer.reset();
+  task->requestCancel();
+  bufferManager_->removeTask(taskId);
+
+  // The spill files go away with the last of their pages.
+  auto fs = filesystems::getFileSystem(spillDirectory->path, nullptr);
+  ASSERT_TRUE(fs->list(spillDirectory->path).empty());
+}
+
+DEBUG_ONLY_TEST_F(PartitionedOutputBufferManagerTest, getDataDuringSpill) {
+  filesystems::registerLocalFileSystem();
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  const std::string taskId = "getDataDuringSpill";
+  auto task = initializeTask(
+      taskId,
+      rowType_,
+      PartitionedOutputNode::Kind::kPartitioned,
+      2,
+      1,
+      1024,
+      spillDirectory->path);
+
+  auto toString = [](const folly::IOBuf& iobuf) {
+    auto copy = iobuf.cloneCoalesced();
+    return std::string(
+        reinterpret_cast<const char*>(copy->data()), copy->length());
+  };
+
+  // Fetches from destination 0 while the third page, which goes to
+  // destination 0, is being written. The buffer is not locked, so the fetch
+  // does not wait for the write. It gets the first page read back from disk
+  // and the third from memory.
+  std::vector<std::string> expected;
+  int numSpills{0};
+  std::vector<std::unique_ptr<folly::IOBuf>> fetched;
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::exec::PartitionedOutputBuffer::spill",
+      std::function<void(PartitionedOutputBuffer*)>(
+          [&](PartitionedOutputBuffer* /*buffer*/) {
+            if (++numSpills != 3) {
+              return;
+            }
+            ASSERT_TRUE(bufferManager_->getData(
+                taskId,
+                0,
+                std::numeric_limits<uint64_t>::max(),
+                0,
+                [&](std::vector<std::unique_ptr<folly::IOBuf>> pages,
+                    int64_t /*sequence*/) { fetched = std::move(pages); }));
+          }));
+
+  for (int i = 0; i < 4; ++i) {
+    auto page = makeSerializedPage(rowType_, 1'000);
+    ASSERT_GT(page->size(), 1'024);
+    expected.push_back(toString(*page->getIOBuf()));
+    ContinueFuture future;
+    ASSERT_FALSE(
+        bufferManager_->enqueue(taskId, i % 2, std::move(page), &future));
+  }
+  ASSERT_EQ(numSpills, 4);
+  ASSERT_EQ(fetched.size(), 2);
+  ASSERT_EQ(toString(*fetched[0]), expected[0]);
+  ASSERT_EQ(toString(*fetched[1]), expected[2]);
+
+  auto buffer = bufferManager_->getBufferIfExists(taskId);
+  ASSERT_NE(buffer, nullptr);
+  ASSERT_LE(buffer->getUtilization(), 1);
+  noMoreData(taskId);
+
+  for (int destination = 0; destination < 2; ++destination) {
+    std::vector<std::unique_ptr<folly::IOBuf>> received;
+    ASSERT_TRUE(bufferManager_->getData(
+        taskId,
+        destination,
+        std::numeric_limits<uint64_t>::max(),
+        0,
+        [&](std::vector<std::unique_ptr<folly::IOBuf>> pages,
+            int64_t /*sequence*/) { received = std::move(pages); }));
+    ASSERT_EQ(received.size(), 3);
+    for (int i = 0; i < 2; ++i) {
+      ASSERT_EQ(toString(*received[i]), expected[destination + 2 * i]);
+    }
+    ASSERT_EQ(received.back(), nullptr);
+    deleteResults(taskId, destination);
+  }
+  buffer.reset();
+  task->requestCancel();
+  bufferManager_->removeTask(taskId);
+
+  auto fs = filesystems::getFileSystem(spillDirectory->path, nullptr);
+  ASSERT_TRUE(fs->list(spillDirectory->path).empty());
+}
+
 TEST_F(PartitionedOutputBufferManagerTest, errorInQueue) {
   auto queue = std::make_shared<ExchangeQueue>();
   queue->setError("Forced failure");
@@ -410,6 +410,23 @@ TEST_F(PlanNodeSerdeTest, window) {
              .planNode();
 
   testSerde(plan);
+
+  plan = PlanBuilder()
+             .values({data_})
+             .orderBy({"c1", "c2"}, false)
+             .streamingWindow({"sum(c0) over (partition by c1 order by c2)"})
+             .planNode();
+
+  testSerde(plan);
+
+  // Plans serialized before 'inputsSorted' was added deserialize as not
+  // sorted.
+  auto serialized = plan->serialize();
+  serialized.erase("inputsSorted");
+  auto copy =
+      velox::ISerializable::deserialize<core::PlanNode>(serialized, pool());
+  ASSERT_FALSE(
+      std::dynamic_pointer_cast<const core::WindowNode>(copy)->inputsSorted());
 }
 
 TEST_F(PlanNodeSerdeTest, rowNumber) {
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/PrefixSort.h"
+#include "velox/exec/tests/utils/RowContainerTestBase.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+class PrefixSortTest : public exec::test::RowContainerTestBase {
+ protected:
+  // Stores 'data' in a RowContainer with the first 'numKeys' columns as keys
+  // and checks that PrefixSort orders the rows like compareRows for all
+  // combinations of ascending and nulls first.
+  void testSort(const RowVectorPtr& data, int32_t numKeys, bool nullableKeys) {
+    std::vector<TypePtr> keyTypes;
+    std::vector<TypePtr> dependentTypes;
+    for (auto i = 0; i < data->childrenSize(); ++i) {
+      (i < numKeys ? keyTypes : dependentTypes)
+          .push_back(data->childAt(i)->type());
+    }
+    auto container = makeRowContainer(keyTypes, dependentTypes, !nullableKeys);
+
+    const auto numRows = data->size();
+    SelectivityVector allRows(numRows);
+    std::vector<char*> rows(numRows);
+    for (auto i = 0; i < numRows; ++i) {
+      rows[i] = container->newRow();
+    }
+    for (auto column = 0; column < data->childrenSize(); ++column) {
+      DecodedVector decoded(*data->childAt(column), allRows);
+      for (auto i = 0; i < numRows; ++i) {
+        container->store(decoded, i, rows[i], column);
+      }
+    }
+
+    for (auto ascending : {true, false}) {
+      for (auto nullsFirst : {true, false}) {
+        SCOPED_TRACE(fmt::format(
+            "ascending: {}, nullsFirst: {}", ascending, nullsFirst));
+        std::vector<CompareFlags> flags(
+            numKeys, CompareFlags{nullsFirst, ascending});
+        // Alternate the order of the keys after the first.
+        for (auto i = 1; i < numKeys; i += 2) {
+          flags[i].ascending = !ascending;
+        }
+
+        auto expected = rows;
+        std::sort(
+            expected.begin(),
+            expected.end(),
+            [&](const char* left, const char* right) {
+              return container->compareRows(left, right, flags) < 0;
+            });
+        auto actual = rows;
+        PrefixSort::sort(
+            *container,
+            flags,
+            folly::Range<char**>(actual.data(), actual.size()));
+        for (auto i = 0; i < numRows; ++i) {
+          ASSERT_EQ(0, container->compareRows(expected[i], actual[i], flags))
+              << "at " << i;
+        }
+      }
+    }
+  }
+
+  // Makes keys with ties, -0.0, NaN and strings longer than the prefix. If
+  // 'withNulls' is false, the data can be stored as non-nullable keys.
+  RowVectorPtr makeData(vector_size_t size, bool withNulls) {
+    const auto nan = std::numeric_limits<double>::quiet_NaN();
+    const std::vector<double> doubles = {
+        nan, -0.0, 0.0, 1.5, -1.5, std::numeric_limits<double>::lowest()};
+    static const std::vector<std::string> strings = {
+        "",
+        "a",
+        "ab",
+        "abcdefghijklmnopqrstuvwxyz",
+        "abcdefghijklmnopqrstuvwxyZ",
+        "\xff\x01",
+        "b"};
+    auto nulls = [&](int n) {
+      return withNulls ? nullEvery(n) : nullptr;
+    };
+    return makeRowVector({
+        makeFlatVector<int32_t>(
+            size, [](auto row) { return row % 7 - 3; }, nulls(11)),
+        makeFlatVector<double>(
+            size,
+            [&](auto row) { return doubles[row % doubles.size()]; },
+            nulls(13)),
+        makeFlatVector<StringView>(
+            size,
+            [&](auto row) {
+              return StringView(strings[(row / 3) % strings.size()]);
+            },
+            nulls(5)),
+        makeFlatVector<int64_t>(
+            size,
+            [](auto row) { return (row % 3 == 0 ? -1 : 1) * row; },
+            nulls(17)),
+        makeFlatVector<bool>(size, [](auto row) { return row % 2 == 0; }),
+        makeFlatVector<int16_t>(size, [](auto row) { return row % 5; }),
+    });
+  }
+};
+
+TEST_F(PrefixSortTest, fixedWidthKeys) {
+  for (auto nullableKeys : {true, false}) {
+    auto data = makeData(1'000, nullableKeys);
+    auto fixedWidth = makeRowVector({
+        data->childAt(0),
+        data->childAt(4),
+        data->childAt(5),
+        data->childAt(1),
+        data->childAt(3),
+    });
+    // Keys fully encoded in the prefix.
+    testSort(fixedWidth, 3, nullableKeys);
+    // Keys that do not fit in the prefix are compared on ties.
+    testSort(fixedWidth, 5, nullableKeys);
+  }
+}
+
+TEST_F(PrefixSortTest, stringKeys) {
+  for (auto nullableKeys : {true, false}) {
+    auto data = makeData(1'000, nullableKeys);
+    // A string after fixed width keys is truncated to the rest of the prefix.
+    testSort(data, 3, nullableKeys);
+    testSort(data, 4, nullableKeys);
+
+    auto stringFirst = makeRowVector({
+        data->childAt(2),
+        data->childAt(0),
+        data->childAt(1),
+    });
+    testSort(stringFirst, 1, nullableKeys);
+    testSort(stringFirst, 3, nullableKeys);
+  }
+}
+
+TEST_F(PrefixSortTest, noPrefix) {
+  auto data = makeData(1'000, true);
+  // Timestamp keys have no prefix encoding and are sorted with the full key
+  // comparison.
+  auto timestampFirst = makeRowVector({
+      makeFlatVector<Timestamp>(
+          1'000,
+          [](auto row) { return Timestamp(row % 10, row % 3); },
+          nullEvery(7)),
+      data->childAt(0),
+  });
+  testSort(timestampFirst, 2, true);
+}
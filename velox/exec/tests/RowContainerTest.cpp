@@ -1227,3 +1227,192 @@ TEST_F(RowContainerTest, mixedFree) {
   data1->checkConsistency();
   data2->checkConsistency();
 }
+
+TEST_F(RowContainerTest, columnarDependents) {
+  constexpr int32_t kNumRows = 3 * RowContainer::kColumnarBlockRows + 100;
+  std::vector<TypePtr> dependentTypes{
+      BIGINT(), VARCHAR(), DOUBLE(), BOOLEAN(), TIMESTAMP()};
+  auto makeContainer = [&](bool columnarDependents) {
+    return std::make_unique<RowContainer>(
+        std::vector<TypePtr>{BIGINT()}, // keyTypes
+        false, // nullableKeys
+        std::vector<Accumulator>{},
+        dependentTypes,
+        true, // hasNext
+        true, // isJoinBuild
+        false, // hasProbedFlag
+        false, // hasNormalizedKey
+        pool_.get(),
+        nullptr, // stringAllocator
+        columnarDependents);
+  };
+  auto data = makeContainer(true);
+  EXPECT_FALSE(data->isColumnar(0));
+  EXPECT_TRUE(data->isColumnar(1));
+  EXPECT_FALSE(data->isColumnar(2));
+  EXPECT_TRUE(data->isColumnar(3));
+  EXPECT_TRUE(data->isColumnar(4));
+  EXPECT_TRUE(data->isColumnar(5));
+  EXPECT_LT(data->fixedRowSize(), makeContainer(false)->fixedRowSize());
+
+  auto input = makeRowVector({
+      makeFlatVector<int64_t>(kNumRows, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(
+          kNumRows, [](auto row) { return row * 3; }, nullEvery(7)),
+      makeFlatVector<std::string>(
+          kNumRows,
+          [](auto row) { return std::string(row % 30, 'x'); },
+          nullEvery(11)),
+      makeFlatVector<double>(
+          kNumRows, [](auto row) { return row / 3.0; }, nullEvery(5)),
+      makeFlatVector<bool>(
+          kNumRows, [](auto row) { return row % 3 == 0; }, nullEvery(13)),
+      makeFlatVector<Timestamp>(
+          kNumRows,
+          [](auto row) { return Timestamp(row, row * 1000); },
+          nullEvery(17)),
+  });
+  std::vector<DecodedVector> decoded;
+  for (auto& child : input->children()) {
+    decoded.emplace_back(*child);
+  }
+  std::vector<char*> rows(kNumRows);
+  for (auto i = 0; i < kNumRows; ++i) {
+    rows[i] = data->newRow();
+    for (auto column = 0; column < decoded.size(); ++column) {
+      data->store(decoded[column], i, rows[i], column);
+    }
+  }
+
+  auto checkColumns = [&]() {
+    for (auto column = 0; column < input->childrenSize(); ++column) {
+      const auto& expected = input->childAt(column);
+      auto result = BaseVector::create(expected->type(), 0, pool());
+      data->extractColumn(rows.data(), kNumRows, column, result);
+      assertEqualVectors(expected, result);
+    }
+  };
+  checkColumns();
+
+  // Extracts in reverse order with row numbers, a negative row number and a
+  // result offset.
+  std::vector<vector_size_t> rowNumbers(kNumRows);
+  for (auto i = 0; i < kNumRows; ++i) {
+    rowNumbers[i] = kNumRows - i - 1;
+  }
+  rowNumbers[10] = -1;
+  auto result = BaseVector::create(BIGINT(), 0, pool());
+  data->extractColumn(
+      rows.data(),
+      folly::Range<const vector_size_t*>(rowNumbers.data(), kNumRows),
+      1,
+      5,
+      result);
+  ASSERT_EQ(result->size(), kNumRows + 5);
+  for (auto i = 0; i < kNumRows; ++i) {
+    if (rowNumbers[i] < 0) {
+      EXPECT_TRUE(result->isNullAt(i + 5));
+      continue;
+    }
+    EXPECT_TRUE(input->childAt(1)->equalValueAt(
+        result.get(), rowNumbers[i], i + 5));
+  }
+
+  // Erased rows keep their position in the columnar values when reused.
+  std::vector<char*> erased;
+  std::vector<vector_size_t> erasedIndices;
+  for (auto i = 0; i < kNumRows; i += 3) {
+    erased.push_back(rows[i]);
+    erasedIndices.push_back(i);
+  }
+  data->eraseRows(folly::Range<char**>(erased.data(), erased.size()));
+  data->checkConsistency();
+  for (auto i : erasedIndices) {
+    rows[i] = data->newRow();
+    for (auto column = 0; column < decoded.size(); ++column) {
+      data->store(decoded[column], i, rows[i], column);
+    }
+  }
+  checkColumns();
+
+  data->clear();
+  EXPECT_EQ(data->numRows(), 0);
+}
+
+TEST_F(RowContainerTest, internStringKeys) {
+  constexpr int32_t kNumRows = 1'000;
+  constexpr int32_t kNumDistinct = 10;
+  auto stringAllocator = std::make_shared<HashStringAllocator>(pool_.get());
+  auto data = std::make_unique<RowContainer>(
+      std::vector<TypePtr>{VARCHAR(), BIGINT()}, // keyTypes
+      true, // nullableKeys
+      std::vector<Accumulator>{},
+      std::vector<TypePtr>{VARCHAR()}, // dependentTypes
+      true, // hasNext
+      true, // isJoinBuild
+      false, // hasProbedFlag
+      false, // hasNormalizedKey
+      pool_.get(),
+      stringAllocator);
+  data->internStringKeys();
+  EXPECT_TRUE(data->internsStringKeys());
+
+  // Long values that repeat, short inline values and nulls.
+  auto input = makeRowVector({
+      makeFlatVector<std::string>(
+          kNumRows,
+          [](auto row) {
+            return row % 3 == 0
+                ? "short"
+                : fmt::format("a long key value {}", row % kNumDistinct);
+          },
+          nullEvery(17)),
+      makeFlatVector<int64_t>(kNumRows, [](auto row) { return row; }),
+      makeFlatVector<std::string>(
+          kNumRows,
+          [](auto row) { return fmt::format("dependent value {}", row); }),
+  });
+  std::vector<DecodedVector> decoded;
+  for (auto& child : input->children()) {
+    decoded.emplace_back(*child);
+  }
+  std::vector<char*> rows(kNumRows);
+  for (auto i = 0; i < kNumRows; ++i) {
+    rows[i] = data->newRow();
+    for (auto column = 0; column < decoded.size(); ++column) {
+      data->store(decoded[column], i, rows[i], column);
+    }
+  }
+  EXPECT_EQ(kNumDistinct, data->numInternedStrings());
+
+  // Equal long keys refer to the same copy.
+  auto keyAt = [&](int32_t row) {
+    return reinterpret_cast<const StringView*>(
+        rows[row] + data->columnAt(0).offset());
+  };
+  EXPECT_EQ(keyAt(1)->data(), keyAt(1 + kNumDistinct)->data());
+  EXPECT_EQ(
+      0,
+      data->compare(rows[1], rows[1 + kNumDistinct], 0, CompareFlags{}));
+  EXPECT_NE(0, data->compare(rows[1], rows[2], 0, CompareFlags{}));
+
+  for (auto column = 0; column < input->childrenSize(); ++column) {
+    auto result = BaseVector::create(input->childAt(column)->type(), 0, pool());
+    data->extractColumn(rows.data(), kNumRows, column, result);
+    assertEqualVectors(input->childAt(column), result);
+  }
+
+  // Erasing rows keeps the interned copies.
+  std::vector<char*> erased;
+  for (auto i = 0; i < kNumRows; i += 2) {
+    erased.push_back(rows[i]);
+  }
+  data->eraseRows(folly::Range<char**>(erased.data(), erased.size()));
+  data->checkConsistency();
+  EXPECT_EQ(kNumDistinct, data->numInternedStrings());
+
+  // clear() frees the interned copies also when the allocator is shared.
+  data->clear();
+  EXPECT_EQ(0, data->numInternedStrings());
+  stringAllocator->checkEmpty();
+}
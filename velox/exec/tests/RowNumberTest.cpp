@@ -13,8 +13,10 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 
 namespace facebook::velox::exec::test {
 
@@ -166,4 +168,44 @@ TEST_F(RowNumberTest, largeInput) {
   testLimit(5'000);
 }
 
+TEST_F(RowNumberTest, spill) {
+  const vector_size_t batchSize = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            batchSize,
+            [&](auto row) { return (row * 13 + i) % 1'500; },
+            nullEvery(31)),
+        makeFlatVector<int64_t>(
+            batchSize, [&](auto row) { return batchSize * i + row; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  for (const std::optional<int32_t> limit :
+       {std::optional<int32_t>(), std::optional<int32_t>(3)}) {
+    SCOPED_TRACE(fmt::format("limit: {}", limit.value_or(-1)));
+    auto plan =
+        PlanBuilder().values(vectors).rowNumber({"c0"}, limit).planNode();
+    auto spillDirectory = TempDirectoryPath::create();
+    const std::string sql =
+        "SELECT * FROM (SELECT *, row_number() over (partition by c0 order by c1) as rn FROM tmp)";
+    auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                    .spillDirectory(spillDirectory->path)
+                    .config(core::QueryConfig::kSpillEnabled, "true")
+                    .config(core::QueryConfig::kRowNumberSpillEnabled, "true")
+                    .config(core::QueryConfig::kTestingSpillPct, "100")
+                    .assertResults(
+                        limit.has_value()
+                            ? fmt::format("{} WHERE rn <= {}", sql, *limit)
+                            : sql);
+    auto stats = task->taskStats().pipelineStats[0].operatorStats[1];
+    ASSERT_GT(stats.spilledRows, 0);
+    ASSERT_GT(stats.spilledBytes, 0);
+    ASSERT_GT(stats.spilledPartitions, 0);
+    ASSERT_GT(stats.spilledFiles, 0);
+  }
+}
+
 } // namespace facebook::velox::exec::test
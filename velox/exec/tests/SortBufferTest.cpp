@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/SortBuffer.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+class SortBufferTest : public testing::Test,
+                       public velox::test::VectorTestBase {
+ protected:
+  // Adds 'inputs' to a SortBuffer sorting on 'sortColumnIndices' and checks
+  // that the output has all the input rows in the order of 'sortCompareFlags'.
+  void testSort(
+      const std::vector<RowVectorPtr>& inputs,
+      const std::vector<column_index_t>& sortColumnIndices,
+      const std::vector<CompareFlags>& sortCompareFlags,
+      vector_size_t maxOutputRows) {
+    auto sortBuffer = std::make_unique<SortBuffer>(
+        asRowType(inputs[0]->type()),
+        sortColumnIndices,
+        sortCompareFlags,
+        pool());
+    vector_size_t numInputRows = 0;
+    for (const auto& input : inputs) {
+      sortBuffer->addInput(input);
+      numInputRows += input->size();
+    }
+    sortBuffer->noMoreInput();
+    ASSERT_EQ(sortBuffer->numInputRows(), numInputRows);
+    ASSERT_FALSE(sortBuffer->spilledStats().has_value());
+
+    // Column 0 of the input has the distinct values 0 to 'numInputRows' - 1.
+    std::vector<bool> seen(numInputRows, false);
+    RowVectorPtr previous;
+    vector_size_t previousRow = 0;
+    vector_size_t numOutputRows = 0;
+    while (auto output = sortBuffer->getOutput(maxOutputRows)) {
+      ASSERT_LE(output->size(), maxOutputRows);
+      // 'output' may be reused by the next call.
+      output = std::dynamic_pointer_cast<RowVector>(
+          BaseVector::copy(*output, pool()));
+      for (auto row = 0; row < output->size(); ++row) {
+        const auto id =
+            output->childAt(0)->asFlatVector<int64_t>()->valueAt(row);
+        ASSERT_FALSE(seen[id]);
+        seen[id] = true;
+        if (previous != nullptr) {
+          ASSERT_LE(
+              compareKeys(
+                  *previous,
+                  previousRow,
+                  *output,
+                  row,
+                  sortColumnIndices,
+                  sortCompareFlags),
+              0);
+        }
+        previous = output;
+        previousRow = row;
+      }
+      numOutputRows += output->size();
+    }
+    ASSERT_EQ(numOutputRows, numInputRows);
+    ASSERT_EQ(sortBuffer->getOutput(maxOutputRows), nullptr);
+  }
+
+  static int32_t compareKeys(
+      const RowVector& left,
+      vector_size_t leftRow,
+      const RowVector& right,
+      vector_size_t rightRow,
+      const std::vector<column_index_t>& sortColumnIndices,
+      const std::vector<CompareFlags>& sortCompareFlags) {
+    for (auto i = 0; i < sortColumnIndices.size(); ++i) {
+      const auto channel = sortColumnIndices[i];
+      const auto result = left.childAt(channel)->compare(
+          right.childAt(channel).get(),
+          leftRow,
+          rightRow,
+          sortCompareFlags[i]);
+      if (result.value() != 0) {
+        return result.value();
+      }
+    }
+    return 0;
+  }
+
+  std::vector<RowVectorPtr> makeInputs(int32_t numBatches, int32_t batchSize) {
+    std::vector<RowVectorPtr> inputs;
+    for (auto i = 0; i < numBatches; ++i) {
+      const auto offset = i * batchSize;
+      inputs.push_back(makeRowVector({
+          makeFlatVector<int64_t>(
+              batchSize, [&](auto row) { return offset + row; }),
+          makeFlatVector<int32_t>(
+              batchSize,
+              [&](auto row) { return (offset + row) % 17; },
+              nullEvery(7)),
+          makeFlatVector<StringView>(
+              batchSize,
+              [&](auto row) {
+                return StringView::makeInline(
+                    fmt::format("{}", (offset + row) % 101));
+              }),
+      }));
+    }
+    return inputs;
+  }
+};
+
+TEST_F(SortBufferTest, sort) {
+  const auto inputs = makeInputs(5, 333);
+  for (auto ascending : {true, false}) {
+    for (auto nullsFirst : {true, false}) {
+      SCOPED_TRACE(fmt::format(
+          "ascending: {}, nullsFirst: {}", ascending, nullsFirst));
+      const CompareFlags flags{
+          nullsFirst,
+          ascending,
+          false,
+          CompareFlags::NullHandlingMode::NoStop};
+      const CompareFlags reverseFlags{
+          !nullsFirst,
+          !ascending,
+          false,
+          CompareFlags::NullHandlingMode::NoStop};
+      testSort(inputs, {1}, {flags}, 100);
+      testSort(inputs, {2, 1}, {flags, reverseFlags}, 1);
+      testSort(inputs, {1, 2, 0}, {flags, flags, reverseFlags}, 10'000);
+    }
+  }
+}
+
+TEST_F(SortBufferTest, noInput) {
+  auto sortBuffer = std::make_unique<SortBuffer>(
+      ROW({"c0"}, {BIGINT()}),
+      std::vector<column_index_t>{0},
+      std::vector<CompareFlags>{{}},
+      pool());
+  sortBuffer->noMoreInput();
+  ASSERT_EQ(sortBuffer->numInputRows(), 0);
+  ASSERT_EQ(sortBuffer->getOutput(100), nullptr);
+}
@@ -14,9 +14,11 @@
  * limitations under the License.
  */
 #include "velox/exec/Spill.h"
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gtest/gtest.h>
 #include <algorithm>
 #include <memory>
+#include <numeric>
 #include "velox/common/base/RuntimeMetrics.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/FileSystems.h"
@@ -155,7 +157,9 @@ class SpillTest : public ::testing::TestWithParam<common::CompressionKind>,
         targetFileSize,
         compressionKind_,
         pool(),
-        &stats_);
+        &stats_,
+        executor_.get(),
+        extraSpillPaths_);
     ASSERT_EQ(targetFileSize, state_->targetFileSize());
     ASSERT_EQ(numPartitions, state_->maxPartitions());
     ASSERT_EQ(stats_.rlock()->spilledPartitions, 0);
@@ -385,6 +389,10 @@ class SpillTest : public ::testing::TestWithParam<common::CompressionKind>,
   std::vector<std::vector<RowVectorPtr>> batchesByPartition_;
   std::string spillPath_;
   folly::Synchronized<SpillStats> stats_;
+  // If set, the spill files are written on 'executor_' and striped over
+  // 'spillPath_' and 'extraSpillPaths_'.
+  std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
+  std::vector<std::string> extraSpillPaths_;
   std::unique_ptr<SpillState> state_;
   std::unordered_map<std::string, RuntimeMetric> runtimeStats_;
   std::unique_ptr<TestRuntimeStatWriter> statWriter_;
@@ -471,6 +479,53 @@ TEST_P(SpillTest, spillStateWithSmallTargetFileSize) {
   spillStateTest(1, 2, 10, 10, {}, 10 * 2);
 }
 
+TEST_P(SpillTest, mappedRead) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_velox_spill_mmap_read = true;
+
+  spillStateTest(kGB, 2, 10, 1, {CompareFlags{true, true}}, 10);
+  spillStateTest(kGB, 2, 10, 10, {}, 10);
+  spillStateTest(1, 2, 10, 1, {CompareFlags{false, true}}, 10 * 2);
+  spillStateTest(1, 2, 10, 10, {}, 10 * 2);
+}
+
+TEST_P(SpillTest, stripedAsyncWrite) {
+  executor_ = std::make_unique<folly::CPUThreadPoolExecutor>(4);
+  std::vector<std::shared_ptr<TempDirectoryPath>> extraDirs;
+  for (auto i = 0; i < 2; ++i) {
+    extraDirs.push_back(TempDirectoryPath::create());
+    extraSpillPaths_.push_back(extraDirs.back()->path + "/test");
+  }
+
+  // Each batch goes to a new file, which is written to the directory with the
+  // fewest bytes pending or otherwise the highest measured throughput.
+  setupSpillState(1, 2, 10);
+  std::vector<std::string> dirs{tempDir_->path};
+  for (const auto& dir : extraDirs) {
+    dirs.push_back(dir->path);
+  }
+  std::vector<int32_t> numFilesPerDir(dirs.size());
+  for (const auto& path : state_->testingSpilledFilePaths()) {
+    for (auto i = 0; i < dirs.size(); ++i) {
+      if (path.find(dirs[i]) == 0) {
+        ++numFilesPerDir[i];
+      }
+    }
+  }
+  EXPECT_EQ(
+      std::accumulate(numFilesPerDir.begin(), numFilesPerDir.end(), 0),
+      2 * 10);
+  // The first files go to each directory once before any is measured.
+  for (auto numFiles : numFilesPerDir) {
+    EXPECT_GT(numFiles, 0);
+  }
+
+  spillStateTest(kGB, 2, 10, 1, {CompareFlags{true, true}}, 10);
+  spillStateTest(1, 2, 10, 10, {}, 10 * 2);
+  state_.reset();
+  executor_.reset();
+}
+
 TEST_P(SpillTest, spillPartitionId) {
   SpillPartitionId partitionId1_2(1, 2);
   ASSERT_EQ(partitionId1_2.partitionBitOffset(), 1);
@@ -661,6 +716,42 @@ TEST_P(SpillTest, spillPartitionSpilt) {
   }
 }
 
+TEST_P(SpillTest, spillPartitionSplitBlocks) {
+  const int numBatches = 10;
+  const int numRowsPerBatch = 100;
+  const SpillPartitionId id(0, 0);
+  // Blocks of about 3 files, and a block per file if the files are larger than
+  // the block size.
+  for (const bool smallBlocks : {false, true}) {
+    SCOPED_TRACE(fmt::format("smallBlocks: {}", smallBlocks));
+    // Each batch goes to a new file.
+    setupSpillState(1, 1, numBatches, numRowsPerBatch);
+    SpillPartition spillPartition(id, state_->files(0));
+    ASSERT_EQ(spillPartition.numFiles(), numBatches);
+    const auto size = spillPartition.size();
+    ASSERT_EQ(size, stats_.rlock()->spilledBytes);
+
+    const uint64_t maxBlockSize = smallBlocks ? 1 : size * 3 / numBatches;
+    const auto blocks = spillPartition.splitBlocks(maxBlockSize);
+    ASSERT_EQ(spillPartition.numFiles(), 0);
+    int numFiles = 0;
+    uint64_t blocksSize = 0;
+    for (const auto& block : blocks) {
+      ASSERT_EQ(id, block->id());
+      ASSERT_TRUE(block->numFiles() == 1 || block->size() <= maxBlockSize);
+      numFiles += block->numFiles();
+      blocksSize += block->size();
+    }
+    ASSERT_EQ(numFiles, numBatches);
+    ASSERT_EQ(blocksSize, size);
+    if (smallBlocks) {
+      ASSERT_EQ(blocks.size(), numBatches);
+    } else {
+      ASSERT_LT(blocks.size(), numBatches);
+    }
+  }
+}
+
 TEST_P(SpillTest, nonExistSpillFileOnDeletion) {
   const int32_t numRowsPerBatch = 100;
   std::vector<RowVectorPtr> batches;
@@ -681,6 +772,30 @@ INSTANTIATE_TEST_SUITE_P(
         common::CompressionKind::CompressionKind_LZ4,
         common::CompressionKind::CompressionKind_GZIP));
 
+TEST(SpillTest, spillPathSelector) {
+  SpillPathSelector selector(2);
+  // Unmeasured paths are picked in turn.
+  ASSERT_EQ(selector.select(), 0);
+  ASSERT_EQ(selector.select(), 1);
+  // Then the one with fewer pending bytes.
+  selector.startWrite(0, 100);
+  ASSERT_EQ(selector.select(), 1);
+  ASSERT_EQ(selector.select(), 1);
+  // Unmeasured paths go before measured ones.
+  selector.finishWrite(0, 100, 10);
+  ASSERT_EQ(selector.select(), 1);
+  // Measured paths are picked by the expected time to finish their pending
+  // writes.
+  selector.startWrite(1, 100);
+  selector.finishWrite(1, 100, 1'000);
+  ASSERT_EQ(selector.select(), 0);
+  ASSERT_EQ(selector.select(), 0);
+  selector.startWrite(0, 100'000);
+  ASSERT_EQ(selector.select(), 1);
+  selector.finishWrite(0, 100'000, 10'000);
+  ASSERT_EQ(selector.select(), 0);
+}
+
 TEST(SpillTest, spillStats) {
   SpillStats stats1;
   stats1.spillRuns = 100;
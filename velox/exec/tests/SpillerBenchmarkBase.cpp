@@ -15,6 +15,7 @@
  */
 
 #include "velox/exec/tests/SpillerBenchmarkBase.h"
+#include <folly/String.h>
 
 DEFINE_string(
     spiller_benchmark_path,
@@ -44,6 +45,11 @@ DEFINE_uint32(
     spiller_benchmark_spill_executor_size,
     std::thread::hardware_concurrency(),
     "The spiller executor size in number of threads");
+DEFINE_string(
+    spiller_benchmark_extra_paths,
+    "",
+    "Comma separated file directory paths, e.g. on other disks, over which "
+    "the spill files are striped together with spiller_benchmark_path");
 
 using namespace facebook::velox;
 using namespace facebook::velox::common;
@@ -88,6 +94,14 @@ void JoinSpillInputTest::setUp() {
   }
   fs_ = filesystems::getFileSystem(spillDir_, {});
   fs_->mkdir(spillDir_);
+  std::vector<std::string> extraPaths;
+  if (!FLAGS_spiller_benchmark_extra_paths.empty()) {
+    folly::split(',', FLAGS_spiller_benchmark_extra_paths, extraSpillDirs_);
+  }
+  for (const auto& dir : extraSpillDirs_) {
+    fs_->mkdir(dir);
+    extraPaths.push_back(fmt::format("{}/{}", dir, "JoinSpillInputTest"));
+  }
 
   spiller_ = std::make_unique<Spiller>(
       exec::Spiller::Type::kHashJoinProbe,
@@ -98,7 +112,8 @@ void JoinSpillInputTest::setUp() {
       FLAGS_spiller_benchmark_min_spill_run_size,
       stringToCompressionKind(FLAGS_spiller_benchmark_compression_kind),
       Spiller::pool(),
-      executor_.get());
+      executor_.get(),
+      extraPaths);
   spiller_->setPartitionsSpilled({0});
 }
 
@@ -122,16 +137,24 @@ void JoinSpillInputTest::printStats() {
   SpillPartitionSet partitionSet;
   spiller_->finishSpill(partitionSet);
   VELOX_CHECK_EQ(partitionSet.size(), 1);
-  const auto files = fs_->list(spillDir_);
-  for (const auto& file : files) {
-    auto rfile = fs_->openFileForRead(file);
-    LOG(INFO) << "spilled file " << file << " size "
-              << succinctBytes(rfile->size());
+  std::vector<std::string> dirs{spillDir_};
+  dirs.insert(dirs.end(), extraSpillDirs_.begin(), extraSpillDirs_.end());
+  for (const auto& dir : dirs) {
+    const auto files = fs_->list(dir);
+    for (const auto& file : files) {
+      auto rfile = fs_->openFileForRead(file);
+      LOG(INFO) << "spilled file " << file << " size "
+                << succinctBytes(rfile->size());
+    }
   }
 }
 
 void JoinSpillInputTest::cleanup() {
   LOG(INFO) << "Remove spill dir: " << spillDir_;
   fs_->rmdir(spillDir_);
+  for (const auto& dir : extraSpillDirs_) {
+    LOG(INFO) << "Remove spill dir: " << dir;
+    fs_->rmdir(dir);
+  }
 }
 } // namespace facebook::velox::exec::test
@@ -39,6 +39,7 @@ DECLARE_uint32(spiller_benchmark_num_input_vectors);
 DECLARE_uint32(spiller_benchmark_input_vector_size);
 DECLARE_string(spiller_benchmark_compression_kind);
 DECLARE_uint32(spiller_benchmark_spill_executor_size);
+DECLARE_string(spiller_benchmark_extra_paths);
 
 using namespace facebook::velox;
 using namespace facebook::velox::common;
@@ -74,6 +75,7 @@ class JoinSpillInputTest {
   std::unique_ptr<folly::IOThreadPoolExecutor> executor_;
   std::shared_ptr<exec::test::TempDirectoryPath> tempDir_;
   std::string spillDir_;
+  std::vector<std::string> extraSpillDirs_;
   std::shared_ptr<filesystems::FileSystem> fs_;
   std::unique_ptr<Spiller> spiller_;
   // Stats.
@@ -116,7 +116,12 @@ class SpillerTest : public exec::test::RowContainerTestBase {
         type_(param.type),
         executorPoolSize_(param.poolSize),
         compressionKind_(param.compressionKind),
-        hashBits_(0, type_ == Spiller::Type::kOrderBy ? 0 : 2),
+        hashBits_(
+            0,
+            (type_ == Spiller::Type::kOrderBy ||
+             type_ == Spiller::Type::kWindow)
+                ? 0
+                : 2),
         numPartitions_(hashBits_.numPartitions()),
         statWriter_(std::make_unique<TestRuntimeStatWriter>(stats_)) {
     setThreadLocalRunTimeStatWriter(statWriter_.get());
@@ -465,9 +470,10 @@ class SpillerTest : public exec::test::RowContainerTestBase {
           compressionKind_,
           pool_.get(),
           executor());
-    } else if (type_ == Spiller::Type::kOrderBy) {
-      // We spill 'data' in one partition in type of kOrderBy, otherwise in 4
-      // partitions.
+    } else if (
+        type_ == Spiller::Type::kOrderBy || type_ == Spiller::Type::kWindow) {
+      // We spill 'data' in one partition in type of kOrderBy and kWindow,
+      // otherwise in 4 partitions.
       spiller_ = std::make_unique<Spiller>(
           type_,
           rowContainer_.get(),
@@ -497,7 +503,7 @@ class SpillerTest : public exec::test::RowContainerTestBase {
           pool_.get(),
           executor());
     }
-    if (type_ == Spiller::Type::kOrderBy) {
+    if (type_ == Spiller::Type::kOrderBy || type_ == Spiller::Type::kWindow) {
       ASSERT_EQ(spiller_->state().maxPartitions(), 1);
     } else {
       ASSERT_EQ(spiller_->state().maxPartitions(), numPartitions_);
@@ -1031,7 +1037,8 @@ class NoHashJoinNoOrderBy : public SpillerTest,
         .typesToExclude =
             {Spiller::Type::kHashJoinProbe,
              Spiller::Type::kHashJoinBuild,
-             Spiller::Type::kOrderBy}}
+             Spiller::Type::kOrderBy,
+             Spiller::Type::kWindow}}
         .getTestParams();
   }
 };
@@ -1080,8 +1087,8 @@ TEST_P(NoHashJoin, error) {
 }
 
 TEST_P(NoHashJoinNoOrderBy, spillWithEmptyPartitions) {
-  // kOrderBy type which has only one partition which is not relevant for this
-  // test.
+  // kOrderBy and kWindow types which have only one partition are not relevant
+  // for this test.
   rowType_ = ROW({{"long_val", BIGINT()}, {"string_val", VARCHAR()}});
   struct {
     std::vector<int> rowsPerPartition;
@@ -1165,7 +1172,8 @@ TEST_P(NoHashJoinNoOrderBy, spillWithEmptyPartitions) {
 }
 
 TEST_P(NoHashJoinNoOrderBy, spillWithNonSpillingPartitions) {
-  // kOrderBy type which has only one partition, is irrelevant for this test.
+  // kOrderBy and kWindow types which have only one partition, are irrelevant
+  // for this test.
   rowType_ = ROW({{"long_val", BIGINT()}, {"string_val", VARCHAR()}});
   struct {
     std::vector<int> rowsPerPartition;
@@ -1285,7 +1293,8 @@ TEST_P(NoHashJoin, spillPartition) {
 }
 
 TEST_P(AllTypes, nonSortedSpillFunctions) {
-  if (type_ == Spiller::Type::kOrderBy || type_ == Spiller::Type::kAggregate) {
+  if (type_ == Spiller::Type::kOrderBy || type_ == Spiller::Type::kAggregate ||
+      type_ == Spiller::Type::kWindow) {
     setupSpillData(rowType_, numKeys_, 1'000, 1, nullptr, {});
     sortSpillData();
     setupSpiller(100'000, 0, false);
@@ -1367,7 +1376,8 @@ class HashJoinBuildOnly : public SpillerTest,
         .typesToExclude =
             {Spiller::Type::kAggregate,
              Spiller::Type::kHashJoinProbe,
-             Spiller::Type::kOrderBy}}
+             Spiller::Type::kOrderBy,
+             Spiller::Type::kWindow}}
         .getTestParams();
   }
 };
@@ -262,6 +262,46 @@ TEST_F(StreamingAggregationTest, uniqueKeys) {
   testAggregation(keys, 100);
 }
 
+TEST_F(StreamingAggregationTest, longRunsAndEncodings) {
+  auto size = 1'024;
+
+  // Runs of 100 rows that span batches, starting with a run of nulls.
+  std::vector<VectorPtr> keys = {
+      makeFlatVector<int64_t>(
+          size,
+          [](auto row) { return row / 100; },
+          [](auto row) { return row < 150; }),
+      makeFlatVector<int64_t>(
+          size, [size](auto row) { return (size + row) / 100; }),
+      makeFlatVector<int64_t>(
+          size, [size](auto row) { return (2 * size + row) / 100; }),
+  };
+  testAggregation(keys);
+  testAggregation(keys, 7);
+
+  // Dictionary encoded strings. Different indices may refer to equal values.
+  auto makeKeys = [&](const std::vector<std::string>& values) {
+    const auto numValues = values.size();
+    return wrapInDictionary(
+        makeIndices(size, [&](auto row) { return row * numValues / size; }),
+        size,
+        makeFlatVector<std::string>(values));
+  };
+  std::vector<VectorPtr> stringKeys = {
+      makeKeys({"a long string key", "a long string key", "b", "c", "c"}),
+      makeKeys({"c", "d", "d", "a string key in the last batch"}),
+  };
+  testAggregation(stringKeys);
+
+  // Floating point keys take the generic comparison.
+  std::vector<VectorPtr> doubleKeys = {
+      makeFlatVector<double>(size, [](auto row) { return row / 50; }),
+      makeFlatVector<double>(
+          size, [size](auto row) { return (size + row) / 50; }),
+  };
+  testAggregation(doubleKeys, 10);
+}
+
 TEST_F(StreamingAggregationTest, partialStreaming) {
   auto size = 1'024;
 
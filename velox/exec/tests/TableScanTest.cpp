@@ -290,6 +290,232 @@ TEST_F(TableScanTest, partitionKeyAlias) {
   assertQuery(op, split, "SELECT c0, '2021-12-02' FROM tmp");
 }
 
+TEST_F(TableScanTest, positionalDeletes) {
+  constexpr int32_t kBatchSize = 5'000;
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 4; ++i) {
+    vectors.push_back(makeRowVector({makeFlatVector<int64_t>(
+        kBatchSize, [&](auto row) { return i * kBatchSize + row; })}));
+  }
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->path, vectors);
+  createDuckDbTable(vectors);
+
+  // Two delete files with overlapping positions. The second has positions
+  // past the end of the data file.
+  auto firstDeletes = TempFilePath::create();
+  writeToFile(
+      firstDeletes->path,
+      makeRowVector(
+          {"pos"},
+          {makeFlatVector<int64_t>(
+              4 * kBatchSize / 7, [](auto row) { return row * 7; })}));
+  auto secondDeletes = TempFilePath::create();
+  writeToFile(
+      secondDeletes->path,
+      makeRowVector(
+          {"pos"},
+          {makeFlatVector<int64_t>(
+              1'000, [](auto row) { return 9'500 + row * 20; })}));
+
+  auto split = HiveConnectorSplitBuilder(filePath->path)
+                   .deleteFile(firstDeletes->path)
+                   .deleteFile(secondDeletes->path)
+                   .build();
+  const std::string deletedRows =
+      "(c0 % 7 = 0 OR (c0 >= 9500 AND c0 % 20 = 0))";
+
+  auto rowType = ROW({"c0"}, {BIGINT()});
+  auto op = PlanBuilder().tableScan(rowType).planNode();
+  assertQuery(op, split, "SELECT c0 FROM tmp WHERE NOT " + deletedRows);
+
+  // Deleted rows combined with a filter that skips row groups.
+  op = PlanBuilder().tableScan(rowType, {"c0 >= 12000"}).planNode();
+  assertQuery(
+      op,
+      split,
+      "SELECT c0 FROM tmp WHERE c0 >= 12000 AND NOT " + deletedRows);
+
+  op = PlanBuilder().tableScan(rowType, {}, "c0 % 3 = 1").planNode();
+  assertQuery(
+      op, split, "SELECT c0 FROM tmp WHERE c0 % 3 = 1 AND NOT " + deletedRows);
+}
+
+TEST_F(TableScanTest, statsAggregates) {
+  auto rowType = ROW({"c0", "c1", "c2"}, {BIGINT(), INTEGER(), VARCHAR()});
+  std::vector<std::shared_ptr<TempFilePath>> filePaths;
+  std::vector<RowVectorPtr> allVectors;
+  for (auto i = 0; i < 3; ++i) {
+    auto vectors = makeVectors(2, 1'000, rowType);
+    filePaths.push_back(TempFilePath::create());
+    writeToFile(filePaths.back()->path, vectors);
+    allVectors.insert(allVectors.end(), vectors.begin(), vectors.end());
+  }
+  createDuckDbTable(allVectors);
+
+  auto makeStatsTableHandle = [&](HiveStatsAggregates aggregates) {
+    return std::make_shared<HiveTableHandle>(
+        kHiveConnectorId,
+        "hive_table",
+        true,
+        SubfieldFilters{},
+        nullptr,
+        rowType,
+        std::move(aggregates));
+  };
+  auto getStatsAggregatedSplits = [](const std::shared_ptr<Task>& task,
+                                     const core::PlanNodeId& scanId) {
+    return toPlanStats(task->taskStats())
+        .at(scanId)
+        .customStats.at("statsAggregatedSplits")
+        .sum;
+  };
+
+  // count, min and max of integers are answered from the file statistics.
+  HiveStatsAggregates aggregates = {
+      {"n", {HiveStatsAggregate::Kind::kCount, ""}},
+      {"n1", {HiveStatsAggregate::Kind::kCount, "c1"}},
+      {"min0", {HiveStatsAggregate::Kind::kMin, "c0"}},
+      {"max1", {HiveStatsAggregate::Kind::kMax, "c1"}}};
+  core::PlanNodeId scanId;
+  auto plan =
+      PlanBuilder()
+          .tableScan(
+              ROW({"n", "n1", "min0", "max1"},
+                  {BIGINT(), BIGINT(), BIGINT(), INTEGER()}),
+              makeStatsTableHandle(aggregates),
+              {})
+          .capturePlanNodeId(scanId)
+          .singleAggregation(
+              {}, {"sum(n)", "sum(n1)", "min(min0)", "max(max1)"})
+          .planNode();
+  const std::string sql =
+      "SELECT count(*), count(c1), min(c0), max(c1) FROM tmp";
+  auto task = assertQuery(plan, filePaths, sql);
+  EXPECT_EQ(getStatsAggregatedSplits(task, scanId), 3);
+
+  // Splits of parts of the files are aggregated from the rows read.
+  std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+  for (const auto& filePath : filePaths) {
+    for (auto& split : makeHiveConnectorSplits(
+             filePath->path, 3, dwio::common::FileFormat::DWRF)) {
+      splits.push_back(split);
+    }
+  }
+  task = OperatorTestBase::assertQuery(plan, splits, sql);
+  EXPECT_EQ(getStatsAggregatedSplits(task, scanId), 0);
+
+  // There are no statistics for min and max of strings.
+  aggregates["min2"] = {HiveStatsAggregate::Kind::kMin, "c2"};
+  aggregates["max2"] = {HiveStatsAggregate::Kind::kMax, "c2"};
+  plan = PlanBuilder()
+             .tableScan(
+                 ROW({"n", "min2", "max2", "min0"},
+                     {BIGINT(), VARCHAR(), VARCHAR(), BIGINT()}),
+                 makeStatsTableHandle(aggregates),
+                 {})
+             .capturePlanNodeId(scanId)
+             .singleAggregation(
+                 {}, {"sum(n)", "min(min2)", "max(max2)", "min(min0)"})
+             .planNode();
+  task = assertQuery(
+      plan, filePaths, "SELECT count(*), min(c2), max(c2), min(c0) FROM tmp");
+  EXPECT_EQ(getStatsAggregatedSplits(task, scanId), 0);
+
+  // Aggregation grouped on a partition key.
+  splits.clear();
+  std::vector<RowVectorPtr> partitionedVectors;
+  for (auto i = 0; i < filePaths.size(); ++i) {
+    const std::string ds = i == 2 ? "b" : "a";
+    splits.push_back(HiveConnectorSplitBuilder(filePaths[i]->path)
+                         .partitionKey("ds", ds)
+                         .build());
+    for (auto j = 0; j < 2; ++j) {
+      const auto& vector = allVectors[2 * i + j];
+      partitionedVectors.push_back(makeRowVector(
+          {"c0", "ds"},
+          {vector->childAt(0),
+           makeConstant(variant(ds), vector->size())}));
+    }
+  }
+  createDuckDbTable(partitionedVectors);
+  plan = PlanBuilder()
+             .tableScan(
+                 ROW({"ds", "n", "max0"}, {VARCHAR(), BIGINT(), BIGINT()}),
+                 makeStatsTableHandle(
+                     {{"n", {HiveStatsAggregate::Kind::kCount, ""}},
+                      {"max0", {HiveStatsAggregate::Kind::kMax, "c0"}}}),
+                 {{"ds", partitionKey("ds", VARCHAR())}})
+             .capturePlanNodeId(scanId)
+             .singleAggregation({"ds"}, {"sum(n)", "max(max0)"})
+             .planNode();
+  task = OperatorTestBase::assertQuery(
+      plan, splits, "SELECT ds, count(*), max(c0) FROM tmp GROUP BY ds");
+  EXPECT_EQ(getStatsAggregatedSplits(task, scanId), 3);
+
+  plan = PlanBuilder()
+             .tableScan(
+                 ROW({"n"}, {BIGINT()}),
+                 std::make_shared<HiveTableHandle>(
+                     kHiveConnectorId,
+                     "hive_table",
+                     true,
+                     SubfieldFilters{},
+                     parseExpr("c0 % 2 = 0", rowType),
+                     rowType,
+                     HiveStatsAggregates{
+                         {"n", {HiveStatsAggregate::Kind::kCount, ""}}}),
+                 {})
+             .planNode();
+  VELOX_ASSERT_THROW(
+      AssertQueryBuilder(plan)
+          .split(makeHiveConnectorSplit(filePaths[0]->path))
+          .copyResults(pool()),
+      "Aggregates from file statistics do not allow a remaining filter");
+}
+
+TEST_F(TableScanTest, limit) {
+  auto rowType = ROW({"c0"}, {BIGINT()});
+  auto filePaths = makeFilePaths(5);
+  for (auto i = 0; i < filePaths.size(); ++i) {
+    writeToFile(
+        filePaths[i]->path,
+        makeRowVector({makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return i * 1'000 + row; })}));
+  }
+
+  // The scan stops after the rows needed by the limit and does not take the
+  // remaining splits.
+  auto plan = PlanBuilder()
+                  .tableScan(rowType)
+                  .limit(0, 1'500, false)
+                  .planNode();
+  auto task = AssertQueryBuilder(plan)
+                  .splits(makeHiveConnectorSplits(filePaths))
+                  .assertTypeAndNumRows(rowType, 1'500);
+  EXPECT_EQ(2, getTableScanStats(task).numSplits);
+  EXPECT_LE(getTableScanStats(task).rawInputRows, 2'000);
+
+  plan = PlanBuilder()
+             .tableScan(rowType)
+             .limit(2'000, 300, false)
+             .planNode();
+  task = AssertQueryBuilder(plan)
+             .splits(makeHiveConnectorSplits(filePaths))
+             .assertTypeAndNumRows(rowType, 300);
+  EXPECT_EQ(3, getTableScanStats(task).numSplits);
+
+  // A limit larger than the data.
+  plan = PlanBuilder()
+             .tableScan(rowType)
+             .limit(0, 10'000, false)
+             .planNode();
+  task = AssertQueryBuilder(plan)
+             .splits(makeHiveConnectorSplits(filePaths))
+             .assertTypeAndNumRows(rowType, 5'000);
+  EXPECT_EQ(5, getTableScanStats(task).numSplits);
+}
+
 TEST_F(TableScanTest, columnPruning) {
   auto vectors = makeVectors(10, 1'000);
   auto filePath = TempFilePath::create();
@@ -517,6 +743,60 @@ TEST_F(TableScanTest, subfieldPruningMapType) {
   }
 }
 
+TEST_F(TableScanTest, flatMapAsStruct) {
+  constexpr vector_size_t kSize = 100;
+  using Entries = std::vector<std::pair<StringView, std::optional<double>>>;
+  std::vector<std::optional<Entries>> maps;
+  for (auto i = 0; i < kSize; ++i) {
+    if (i % 7 == 0) {
+      maps.push_back(std::nullopt);
+      continue;
+    }
+    Entries entries{{"a", i}, {"c", i * 3}};
+    if (i % 3 != 0) {
+      entries.push_back({"b", i * 2});
+    }
+    maps.push_back(std::move(entries));
+  }
+  auto vector = makeRowVector(
+      {"c0", "c1"},
+      {makeFlatVector<int64_t>(kSize, [](auto row) { return row; }),
+       makeNullableMapVector(maps)});
+  auto filePath = TempFilePath::create();
+  auto config = std::make_shared<dwrf::Config>();
+  config->set(dwrf::Config::MAP_FLAT_COLS, {1});
+  writeToFile(filePath->path, {vector}, config);
+
+  // Reads the values of keys 'b' and 'a' and of the missing key 'z' as the
+  // fields of a struct.
+  auto structType = ROW({"b", "a", "z"}, {DOUBLE(), DOUBLE(), DOUBLE()});
+  auto outputType = ROW({"c0", "c1"}, {BIGINT(), structType});
+  std::unordered_map<std::string, std::shared_ptr<connector::ColumnHandle>>
+      assignments = {
+          {"c0", regularColumn("c0", BIGINT())},
+          {"c1", regularColumn("c1", structType)}};
+  auto tableHandle = makeTableHandle(
+      {}, nullptr, "hive_table", asRowType(vector->type()));
+  auto plan = PlanBuilder()
+                  .tableScan(outputType, tableHandle, assignments)
+                  .planNode();
+  auto result = AssertQueryBuilder(plan)
+                    .split(makeHiveConnectorSplit(filePath->path))
+                    .copyResults(pool());
+
+  auto expected = makeRowVector(
+      {"c0", "c1"},
+      {makeFlatVector<int64_t>(kSize, [](auto row) { return row; }),
+       makeRowVector(
+           {"b", "a", "z"},
+           {makeFlatVector<double>(
+                kSize, [](auto row) { return row * 2; }, nullEvery(3)),
+            makeFlatVector<double>(kSize, [](auto row) { return row; }),
+            makeNullConstant(TypeKind::DOUBLE, kSize)},
+           nullEvery(7))});
+  assertEqualVectors(expected, result);
+}
+
 TEST_F(TableScanTest, subfieldPruningArrayType) {
   auto elementType = ROW({"a", "b"}, {BIGINT(), DOUBLE()});
   auto arrayType = ARRAY(elementType);
@@ -887,6 +1167,19 @@ TEST_F(TableScanTest, multipleSplits) {
   }
 }
 
+TEST_F(TableScanTest, preloadDepth) {
+  // Opening takes longer than processing: preload enough splits to cover the
+  // open latency.
+  EXPECT_EQ(TableScan::preloadDepth(100'000, 10'000, 20), 10);
+  EXPECT_EQ(TableScan::preloadDepth(100'001, 10'000, 20), 11);
+  EXPECT_EQ(TableScan::preloadDepth(100'000, 1'000, 20), 20);
+  // Opening is faster than processing: one split ahead is enough.
+  EXPECT_EQ(TableScan::preloadDepth(1'000, 10'000, 20), 1);
+  EXPECT_EQ(TableScan::preloadDepth(0, 10'000, 20), 1);
+  EXPECT_EQ(TableScan::preloadDepth(1'000, 0, 20), 20);
+  EXPECT_EQ(TableScan::preloadDepth(100'000, 10'000, 0), 0);
+}
+
 TEST_F(TableScanTest, waitForSplit) {
   auto filePaths = makeFilePaths(10);
   auto vectors = makeVectors(10, 1'000);
@@ -1118,6 +1411,62 @@ TEST_F(TableScanTest, statsBasedSkippingDouble) {
   EXPECT_EQ(3, getSkippedStridesStat(task));
 }
 
+TEST_F(TableScanTest, splitSkippingBeforeOpen) {
+  auto filePaths = makeFilePaths(1);
+  auto rowVector = makeRowVector(
+      {makeFlatVector<int64_t>(1'000, [](auto row) { return row; })});
+  writeToFile(filePaths[0]->path, rowVector);
+  createDuckDbTable({rowVector});
+  auto rowType = ROW({"c0"}, {BIGINT()});
+  auto skippedBeforeOpen = [&](const std::shared_ptr<Task>& task) {
+    return getTableScanRuntimeStats(task)["skippedSplitsBeforeOpen"].sum;
+  };
+
+  // The first scan reads the footer and keeps the statistics of c0. Later
+  // scans of the file skip it without reading the footer.
+  auto task = assertQuery(
+      PlanBuilder().tableScan(rowType, {"c0 <= -1"}).planNode(),
+      filePaths,
+      "SELECT c0 FROM tmp WHERE c0 <= -1");
+  EXPECT_EQ(1, getSkippedSplitsStat(task));
+  EXPECT_EQ(0, skippedBeforeOpen(task));
+
+  task = assertQuery(
+      PlanBuilder().tableScan(rowType, {"c0 >= 5000"}).planNode(),
+      filePaths,
+      "SELECT c0 FROM tmp WHERE c0 >= 5000");
+  EXPECT_EQ(1, getSkippedSplitsStat(task));
+  EXPECT_EQ(1, skippedBeforeOpen(task));
+
+  task = assertQuery(
+      PlanBuilder().tableScan(rowType, {"c0 >= 500"}).planNode(),
+      filePaths,
+      "SELECT c0 FROM tmp WHERE c0 >= 500");
+  EXPECT_EQ(0, getSkippedSplitsStat(task));
+
+  // Splits whose partition keys do not pass the filters are skipped before
+  // opening their files.
+  ColumnHandleMap assignments = {
+      {"c0", regularColumn("c0", BIGINT())},
+      {"ds", partitionKey("ds", VARCHAR())}};
+  std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+  for (const auto* ds : {"2021-12-01", "2021-12-02", "2021-12-03"}) {
+    splits.push_back(HiveConnectorSplitBuilder(filePaths[0]->path)
+                         .partitionKey("ds", ds)
+                         .build());
+  }
+  auto op = PlanBuilder()
+                .tableScan(
+                    ROW({"c0", "ds"}, {BIGINT(), VARCHAR()}),
+                    makeTableHandle(
+                        singleSubfieldFilter("ds", equal("2021-12-02"))),
+                    assignments)
+                .planNode();
+  task = assertQuery(op, splits, "SELECT c0, '2021-12-02' FROM tmp");
+  EXPECT_EQ(2, getSkippedSplitsStat(task));
+  EXPECT_EQ(2, skippedBeforeOpen(task));
+}
+
 TEST_F(TableScanTest, statsBasedSkippingFloat) {
   auto filePaths = makeFilePaths(1);
   auto size = 31'234;
@@ -2098,6 +2447,41 @@ TEST_F(TableScanTest, remainingFilter) {
       "SELECT * FROM tmp WHERE not (c0 > 0 or c1 > c0)");
 }
 
+TEST_F(TableScanTest, filterStats) {
+  auto rowType = ROW({{"c0", BIGINT()}, {"c1", BIGINT()}, {"c2", BIGINT()}});
+  auto vectors = makeVectors(10, 1'000, rowType);
+  auto filePaths = makeFilePaths(vectors.size());
+  for (auto i = 0; i < vectors.size(); ++i) {
+    writeToFile(filePaths[i]->path, vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  auto plan = PlanBuilder()
+                  .tableScan(rowType, {"c0 > 0", "c1 < 0"}, "c0 > c2")
+                  .planNode();
+  auto task = assertQuery(
+      plan,
+      filePaths,
+      "SELECT * FROM tmp WHERE c0 > 0 AND c1 < 0 AND c0 > c2");
+  auto stats = getTableScanRuntimeStats(task);
+  std::vector<int64_t> ranks;
+  for (const auto& prefix : {"filter.c0", "filter.c1", "remainingFilter"}) {
+    SCOPED_TRACE(prefix);
+    const auto name = std::string(prefix);
+    ASSERT_EQ(stats.count(name + ".rank"), 1);
+    ranks.push_back(stats.at(name + ".rank").max);
+    EXPECT_GT(stats.at(name + ".rowsIn").sum, 0);
+    EXPECT_LE(
+        stats.at(name + ".rowsOut").sum, stats.at(name + ".rowsIn").sum);
+    EXPECT_GE(stats.at(name + ".clocksPerDroppedRow").sum, 0);
+  }
+  // The pushed down filters come first in some order, then the remaining
+  // filter.
+  EXPECT_EQ(ranks[0] + ranks[1], 1);
+  EXPECT_EQ(ranks[2], 2);
+  EXPECT_EQ(stats.count("filter.c2.rank"), 0);
+}
+
 TEST_F(TableScanTest, remainingFilterSkippedStrides) {
   auto rowType = ROW({{"c0", BIGINT()}, {"c1", BIGINT()}});
   std::vector<RowVectorPtr> vectors(3);
@@ -2296,6 +2680,53 @@ TEST_F(TableScanTest, aggregationPushdown) {
       {filePath},
       "SELECT c5, min(c0 + 1), max(c1 + 2), sum(c2 + 3) FROM tmp GROUP BY 1");
   EXPECT_EQ(0, loadedToValueHook(task));
+
+  op = PlanBuilder()
+           .tableScan(rowType_)
+           .singleAggregation(
+               {"c5"}, {"count(c0)", "avg(c1)", "avg(c4)", "count(c6)"})
+           .planNode();
+  task = assertQuery(
+      op,
+      {filePath},
+      "SELECT c5, count(c0), avg(c1), avg(c4), count(c6) FROM tmp GROUP BY 1");
+  EXPECT_EQ(4 * 10'000, loadedToValueHook(task, 1));
+
+  // Global aggregations are pushed down too.
+  op = PlanBuilder()
+           .tableScan(rowType_)
+           .singleAggregation(
+               {},
+               {"count(c0)",
+                "avg(c1)",
+                "sum(c2)",
+                "max(c4)",
+                "bitwise_or_agg(c6)"})
+           .planNode();
+  task = assertQuery(
+      op,
+      {filePath},
+      "SELECT count(c0), avg(c1), sum(c2), max(c4), bit_or(c6) FROM tmp");
+  EXPECT_EQ(5 * 10'000, loadedToValueHook(task, 1));
+
+  // approx_distinct gives the same results as without pushdown.
+  for (const auto& keys : std::vector<std::vector<std::string>>{{"c5"}, {}}) {
+    const std::vector<std::string> aggregates = {
+        "approx_distinct(c0)", "approx_distinct(c3)"};
+    auto expected = AssertQueryBuilder(PlanBuilder()
+                                           .values(vectors)
+                                           .singleAggregation(keys, aggregates)
+                                           .planNode())
+                        .copyResults(pool());
+    op = PlanBuilder()
+             .tableScan(rowType_)
+             .singleAggregation(keys, aggregates)
+             .planNode();
+    task = AssertQueryBuilder(op)
+               .split(makeHiveConnectorSplit(filePath->path))
+               .assertResults(expected);
+    EXPECT_EQ(2 * 10'000, loadedToValueHook(task, 1));
+  }
 }
 
 TEST_F(TableScanTest, bitwiseAggregationPushdown) {
@@ -16,6 +16,7 @@
 #include "folly/dynamic.h"
 #include "velox/common/base/Fs.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/testutil/TestValue.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/HivePartitionFunction.h"
 #include "velox/dwio/common/WriterFactory.h"
@@ -27,6 +28,7 @@
 #include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
 #include "velox/vector/fuzzer/VectorFuzzer.h"
 
+#include <folly/synchronization/EventCount.h>
 #include <re2/re2.h>
 
 using namespace facebook::velox;
@@ -37,6 +39,7 @@ using namespace facebook::velox::exec::test;
 using namespace facebook::velox::connector;
 using namespace facebook::velox::connector::hive;
 using namespace facebook::velox::dwio::common;
+using namespace facebook::velox::common::testutil;
 
 enum class TestMode {
   kUnpartitioned,
@@ -1866,6 +1869,85 @@ TEST_P(UnpartitionedTableWriterTest, differentCompression) {
   }
 }
 
+DEBUG_ONLY_TEST_P(UnpartitionedTableWriterTest, reclaimDuringInputProcessing) {
+  const int32_t numBatches = 10;
+  auto input = makeVectors(numBatches, 1'000);
+
+  for (const auto spillEnabled : {false, true}) {
+    SCOPED_TRACE(fmt::format("spillEnabled: {}", spillEnabled));
+    auto outputDirectory = TempDirectoryPath::create();
+    auto plan = createInsertPlan(
+        PlanBuilder().values(input),
+        rowType_,
+        outputDirectory->path,
+        {},
+        nullptr,
+        CompressionKind_NONE,
+        1,
+        connector::hive::LocationHandle::TableType::kNew);
+
+    folly::EventCount driverWait;
+    auto driverWaitKey = driverWait.prepareWait();
+    folly::EventCount testWait;
+    auto testWaitKey = testWait.prepareWait();
+
+    std::atomic<int> numInputs{0};
+    Operator* op{nullptr};
+    SCOPED_TESTVALUE_SET(
+        "facebook::velox::exec::Driver::runInternal::addInput",
+        std::function<void(Operator*)>(([&](Operator* testOp) {
+          if (testOp->operatorType() != "TableWrite") {
+            return;
+          }
+          // Pauses before the second input so that the file writer holds the
+          // first one.
+          if (++numInputs != 2) {
+            return;
+          }
+          op = testOp;
+          testWait.notify();
+          driverWait.wait(driverWaitKey);
+        })));
+
+    std::thread taskThread([&]() {
+      auto result = AssertQueryBuilder(plan)
+                        .config(QueryConfig::kTaskWriterCount, "1")
+                        .config(
+                            QueryConfig::kSpillEnabled,
+                            spillEnabled ? "true" : "false")
+                        .config(QueryConfig::kWriterSpillEnabled, "true")
+                        .copyResults(pool());
+      assertEqualResults(
+          {makeRowVector({makeConstant<int64_t>(numBatches * 1'000, 1)})},
+          {result});
+    });
+
+    testWait.wait(testWaitKey);
+    ASSERT_TRUE(op != nullptr);
+    auto task = op->testingOperatorCtx()->task();
+    auto taskPauseWait = task->requestPause();
+    driverWait.notify();
+    taskPauseWait.wait();
+
+    ASSERT_EQ(op->canReclaim(), spillEnabled);
+    uint64_t reclaimableBytes{0};
+    ASSERT_EQ(op->reclaimableBytes(reclaimableBytes), spillEnabled);
+    if (spillEnabled) {
+      ASSERT_GT(reclaimableBytes, 0);
+      op->reclaim(0);
+      uint64_t reclaimableBytesAfterReclaim{0};
+      ASSERT_TRUE(op->reclaimableBytes(reclaimableBytesAfterReclaim));
+      ASSERT_LE(reclaimableBytesAfterReclaim, reclaimableBytes);
+    } else {
+      ASSERT_EQ(reclaimableBytes, 0);
+      VELOX_ASSERT_THROW(op->reclaim(0), "");
+    }
+
+    Task::resume(task);
+    taskThread.join();
+  }
+}
+
 TEST_P(UnpartitionedTableWriterTest, createAndInsertIntoUnpartitionedTable) {
   // When table type is NEW, we always return UpdateMode::kNew. In this case
   // no exception is expected because we are trying to insert rows into a new
@@ -2063,6 +2145,41 @@ TEST_P(BucketedTableOnlyWriteTest, mismatchedBucketTypes) {
           bucketProperty_->bucketedTypes()[0]));
 }
 
+TEST_P(BucketedTableOnlyWriteTest, unpartitionedBucketedTable) {
+  SCOPED_TRACE(testParam_.toString());
+  auto input = makeVectors(2, 500);
+  createDuckDbTable(input);
+  auto outputDirectory = TempDirectoryPath::create();
+  // A single table writer without a local exchange on the bucket columns: the
+  // data sink routes the rows to the file of their bucket.
+  const auto plan = createInsertPlan(
+      PlanBuilder().values(input),
+      rowType_,
+      outputDirectory->path,
+      {},
+      bucketProperty_,
+      compressionKind_,
+      1,
+      connector::hive::LocationHandle::TableType::kNew,
+      commitStrategy_);
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .maxDrivers(1)
+      .assertResults("SELECT count(*) FROM tmp");
+
+  assertQuery(
+      PlanBuilder().tableScan(rowType_).planNode(),
+      makeHiveConnectorSplits(outputDirectory),
+      "SELECT * FROM tmp");
+
+  const auto filePaths = getRecursiveFiles(outputDirectory->path);
+  ASSERT_EQ(filePaths.size(), bucketProperty_->bucketCount());
+  for (const auto& filePath : filePaths) {
+    ASSERT_EQ(
+        std::filesystem::path(filePath).parent_path(), outputDirectory->path);
+    verifyBucketedFileData(filePath);
+  }
+}
+
 TEST_P(AllTableWriterTest, tableWriteOutputCheck) {
   SCOPED_TRACE(testParam_.toString());
   if (!testParam_.multiDrivers() ||
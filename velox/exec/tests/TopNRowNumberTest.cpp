@@ -16,6 +16,7 @@
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 
 using namespace facebook::velox::exec::test;
 
@@ -166,5 +167,59 @@ TEST_F(TopNRowNumberTest, manyPartitions) {
   testLimit(100);
 }
 
+TEST_F(TopNRowNumberTest, spill) {
+  const vector_size_t size = 1'000;
+  std::vector<std::string> strings;
+  for (auto i = 0; i < 26; ++i) {
+    strings.push_back(std::string(20, 'a' + i));
+  }
+  std::vector<RowVectorPtr> data;
+  for (auto i = 0; i < 10; ++i) {
+    data.push_back(makeRowVector({
+        // Partitioning key.
+        makeFlatVector<int64_t>(
+            size, [](auto row) { return row % 97; }, nullEvery(7)),
+        // Sorting key.
+        makeFlatVector<int64_t>(size, [i](auto row) { return i * size + row; }),
+        // Data.
+        makeFlatVector<StringView>(
+            size,
+            [&](auto row) { return StringView(strings[row % strings.size()]); },
+            nullEvery(11)),
+    }));
+  }
+
+  createDuckDbTable(data);
+
+  for (const auto& partitionKeys :
+       {std::vector<std::string>{"c0"}, std::vector<std::string>{}}) {
+    for (const auto limit : {1, 5, 200}) {
+      SCOPED_TRACE(fmt::format(
+          "partitionKeys: {}, limit: {}",
+          folly::join(",", partitionKeys),
+          limit));
+      auto plan = PlanBuilder()
+                      .values(data)
+                      .topNRowNumber(partitionKeys, {"c1 DESC"}, limit, true)
+                      .planNode();
+      auto spillDirectory = TempDirectoryPath::create();
+      auto task =
+          AssertQueryBuilder(plan, duckDbQueryRunner_)
+              .spillDirectory(spillDirectory->path)
+              .config(core::QueryConfig::kSpillEnabled, "true")
+              .config(core::QueryConfig::kTopNRowNumberSpillEnabled, "true")
+              .config(core::QueryConfig::kTestingSpillPct, "100")
+              .assertResults(fmt::format(
+                  "SELECT * FROM (SELECT *, row_number() over ({} order by c1 desc) as rn FROM tmp) "
+                  " WHERE rn <= {}",
+                  partitionKeys.empty() ? "" : "partition by c0",
+                  limit));
+      auto stats = task->taskStats().pipelineStats[0].operatorStats[1];
+      ASSERT_GT(stats.spilledRows, 0);
+      ASSERT_EQ(stats.spilledPartitions, 1);
+    }
+  }
+}
+
 } // namespace
 } // namespace facebook::velox::exec
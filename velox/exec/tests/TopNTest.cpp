@@ -13,8 +13,10 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::exec::test;
@@ -261,3 +263,48 @@ TEST_F(TopNTest, lowCardinality) {
 
   testTwoKeys(vectors, "c0", "c1", 200);
 }
+
+TEST_F(TopNTest, spill) {
+  const vector_size_t batchSize = 1'000;
+  std::vector<std::string> strings;
+  for (auto i = 0; i < 26; ++i) {
+    strings.push_back(std::string(20, 'a' + i));
+  }
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    auto c0 = makeFlatVector<int64_t>(
+        batchSize, [&](vector_size_t row) { return (row * 7 + i) % 1'009; });
+    auto c1 = makeFlatVector<int64_t>(
+        batchSize,
+        [&](vector_size_t row) { return batchSize * i + row; },
+        nullEvery(17));
+    auto c2 = makeFlatVector<StringView>(batchSize, [&](vector_size_t row) {
+      return StringView(strings[(row + i) % strings.size()]);
+    });
+    vectors.push_back(makeRowVector({c0, c1, c2}));
+  }
+  createDuckDbTable(vectors);
+
+  for (const auto limit : {10, 1'500, 20'000}) {
+    SCOPED_TRACE(fmt::format("limit: {}", limit));
+    auto plan = PlanBuilder()
+                    .values(vectors)
+                    .topN({"c0 DESC", "c1 NULLS FIRST"}, limit, false)
+                    .planNode();
+    auto spillDirectory = TempDirectoryPath::create();
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .spillDirectory(spillDirectory->path)
+            .config(core::QueryConfig::kSpillEnabled, "true")
+            .config(core::QueryConfig::kTopNSpillEnabled, "true")
+            .config(core::QueryConfig::kTestingSpillPct, "100")
+            .assertResults(fmt::format(
+                "SELECT * FROM tmp ORDER BY c0 DESC, c1 NULLS FIRST LIMIT {}",
+                limit));
+    auto stats = task->taskStats().pipelineStats[0].operatorStats[1];
+    ASSERT_GT(stats.spilledRows, 0);
+    ASSERT_GT(stats.spilledBytes, 0);
+    ASSERT_EQ(stats.spilledPartitions, 1);
+    ASSERT_GT(stats.spilledFiles, 0);
+  }
+}
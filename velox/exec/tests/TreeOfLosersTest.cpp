@@ -28,6 +28,8 @@ class TreeOfLosersTest : public testing::Test, public MergeTestBase {
     TestData testData = makeTestData(numValues, numStreams);
     test<TreeOfLosers<TestingStream>>(testData, true);
     test<MergeArray<TestingStream>>(testData, true);
+    test<KeyMergeArray<TestingStream>>(testData, true);
+    testRuns(testData, true);
   }
 };
 
@@ -241,3 +243,36 @@ TEST_F(TreeOfLosersTest, randomWithDuplicates) {
     }
   }
 }
+
+TEST_F(TreeOfLosersTest, keyMergeRuns) {
+  const int kNumsPerStream = 40;
+  const int kNumStreams = 70;
+  std::vector<std::unique_ptr<TestingStream>> mergeStreams;
+  for (int i = 0; i < kNumStreams; ++i) {
+    // Each stream has a range of values that sorts after the ones before it.
+    std::vector<uint32_t> streamNumbers;
+    for (int j = 0; j < kNumsPerStream; ++j) {
+      streamNumbers.push_back(i * kNumsPerStream + j);
+    }
+    std::reverse(streamNumbers.begin(), streamNumbers.end());
+    mergeStreams.push_back(
+        std::make_unique<TestingStream>(std::move(streamNumbers)));
+  }
+  KeyMergeArray<TestingStream> merge(std::move(mergeStreams));
+  uint32_t expected = 0;
+  int numRuns = 0;
+  for (;;) {
+    auto [stream, bound] = merge.nextRun();
+    if (stream == nullptr) {
+      break;
+    }
+    ++numRuns;
+    do {
+      ASSERT_EQ(stream->current()->value(), expected++);
+      stream->pop();
+    } while (stream->hasData() && stream->key() <= bound);
+  }
+  EXPECT_EQ(kNumStreams * kNumsPerStream, expected);
+  // The streams do not overlap, so each stream is read in one run.
+  EXPECT_EQ(kNumStreams, numRuns);
+}
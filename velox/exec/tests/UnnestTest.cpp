@@ -13,10 +13,13 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 
 using namespace facebook::velox;
+using namespace facebook::velox::exec;
 using namespace facebook::velox::exec::test;
 
 class UnnestTest : public OperatorTestBase {};
@@ -403,3 +406,105 @@ TEST_F(UnnestTest, allEmptyOrNullMaps) {
            .planNode();
   assertQueryReturnsEmptyResult(op);
 }
+
+TEST_F(UnnestTest, batchSize) {
+  // Row 10 has more elements than fit in one output.
+  auto vector = makeRowVector({
+      makeFlatVector<int64_t>(100, [](auto row) { return row; }),
+      makeArrayVector<int32_t>(
+          100,
+          [](auto row) { return row == 10 ? 50 : row % 5; },
+          [](auto row, auto index) { return row * 100 + index; },
+          nullEvery(7)),
+      makeArrayVector<int32_t>(
+          100,
+          [](auto row) { return row % 3; },
+          [](auto row, auto index) { return row + index; }),
+  });
+
+  core::PlanNodeId unnestId;
+  auto op = PlanBuilder()
+                .values({vector})
+                .unnest({"c0"}, {"c1", "c2"}, "ordinal")
+                .capturePlanNodeId(unnestId)
+                .planNode();
+  auto expected = AssertQueryBuilder(op).copyResults(pool());
+  ASSERT_GT(expected->size(), 200);
+
+  auto task = AssertQueryBuilder(op)
+                  .config(core::QueryConfig::kPreferredOutputBatchRows, "16")
+                  .assertResults(expected);
+  auto stats = toPlanStats(task->taskStats());
+  EXPECT_EQ(
+      stats.at(unnestId).outputVectors, bits::divRoundUp(expected->size(), 16));
+}
+
+TEST_F(UnnestTest, adaptiveBatchSize) {
+  // 10K output rows of over 100 bytes each.
+  std::vector<std::string> strings;
+  for (auto i = 0; i < 26; ++i) {
+    strings.push_back(std::string(100, 'a' + i));
+  }
+  auto vector = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+      makeArrayVector<StringView>(
+          1'000,
+          [](auto /*row*/) { return 10; },
+          [](auto row, auto index) {
+            return StringView(strings[(row + index) % strings.size()]);
+          }),
+  });
+
+  core::PlanNodeId unnestId;
+  auto op = PlanBuilder()
+                .values({vector})
+                .unnest({"c0"}, {"c1"})
+                .capturePlanNodeId(unnestId)
+                .planNode();
+  auto expected = AssertQueryBuilder(op).copyResults(pool());
+  ASSERT_EQ(expected->size(), 10'000);
+
+  auto outputVectors = [&](bool adaptive) {
+    auto task =
+        AssertQueryBuilder(op)
+            .config(core::QueryConfig::kPreferredOutputBatchRows, "1000")
+            .config(core::QueryConfig::kPreferredOutputBatchBytes, "10000")
+            .config(
+                core::QueryConfig::kAdaptiveOutputBatchSizing,
+                adaptive ? "true" : "false")
+            .assertResults(expected);
+    return toPlanStats(task->taskStats()).at(unnestId).outputVectors;
+  };
+
+  ASSERT_EQ(outputVectors(false), 10);
+  // The first batch has 1000 rows. The rest are sized to about 10KB from the
+  // measured row size.
+  ASSERT_GT(outputVectors(true), 30);
+}
+
+TEST_F(UnnestTest, zeroCopyElements) {
+  auto array = makeArrayVector<int32_t>(
+      10,
+      [](auto /* row */) { return 3; },
+      [](auto row, auto index) { return row * 3 + index; });
+
+  // Each output is a flat slice of the elements of the arrays.
+  CursorParameters params;
+  params.planNode = PlanBuilder()
+                        .values({makeRowVector({array})})
+                        .unnest({}, {"c0"})
+                        .planNode();
+  params.queryCtx = std::make_shared<core::QueryCtx>(executor_.get());
+  params.queryCtx->testingOverrideConfigUnsafe(
+      {{core::QueryConfig::kPreferredOutputBatchRows, "4"}});
+  auto [cursor, results] = readCursor(params, [](Task*) {});
+  ASSERT_EQ(results.size(), 8);
+  for (auto i = 0; i < results.size(); ++i) {
+    auto& elements = results[i]->childAt(0);
+    ASSERT_EQ(elements->encoding(), VectorEncoding::Simple::FLAT);
+    assertEqualVectors(
+        makeFlatVector<int32_t>(
+            elements->size(), [&](auto row) { return i * 4 + row; }),
+        elements);
+  }
+}
@@ -303,6 +303,57 @@ TEST_F(VectorHasherTest, dictionary) {
   }
 }
 
+// Checks that the hashes and value ids of dictionary entries are kept across
+// inputs that share the dictionary and are recomputed when the mapping of
+// values to ids changes.
+TEST_F(VectorHasherTest, dictionarySharedAcrossInputs) {
+  auto hasher = exec::VectorHasher::create(BIGINT(), 0);
+  auto base = vectorMaker_->flatVector<int64_t>({10, 11, 12, 13, 14});
+  auto first = makeDictionary(100, base);
+  auto second = BaseVector::wrapInDictionary(
+      BufferPtr(nullptr),
+      makeIndices(100, [](vector_size_t row) { return (row * 3) % 5; }),
+      100,
+      base);
+  auto secondFlat = vectorMaker_->flatVector<int64_t>(
+      100, [](vector_size_t row) { return 10 + (row * 3) % 5; });
+
+  raw_vector<uint64_t> hashes(100);
+  hasher->decode(*first, allRows_);
+  hasher->hash(allRows_, false, hashes);
+  hasher->decode(*second, allRows_);
+  hasher->hash(allRows_, false, hashes);
+  for (auto i = 0; i < 100; ++i) {
+    EXPECT_EQ(hashes[i], folly::hasher<int64_t>()(10 + (i * 3) % 5))
+        << "at " << i;
+  }
+
+  raw_vector<uint64_t> ids(100);
+  raw_vector<uint64_t> expectedIds(100);
+  hasher->decode(*first, allRows_);
+  ASSERT_FALSE(hasher->computeValueIds(allRows_, ids));
+  hasher->enableValueRange(1, 0);
+  hasher->decode(*first, allRows_);
+  ASSERT_TRUE(hasher->computeValueIds(allRows_, ids));
+  hasher->decode(*second, allRows_);
+  ASSERT_TRUE(hasher->computeValueIds(allRows_, ids));
+  hasher->decode(*secondFlat, allRows_);
+  ASSERT_TRUE(hasher->computeValueIds(allRows_, expectedIds));
+  for (auto i = 0; i < 100; ++i) {
+    EXPECT_EQ(ids[i], expectedIds[i]) << "at " << i;
+  }
+
+  // Distinct value ids differ from the range ids cached for 'base'.
+  hasher->enableValueIds(1, 0);
+  hasher->decode(*second, allRows_);
+  ASSERT_TRUE(hasher->computeValueIds(allRows_, ids));
+  hasher->decode(*secondFlat, allRows_);
+  ASSERT_TRUE(hasher->computeValueIds(allRows_, expectedIds));
+  for (auto i = 0; i < 100; ++i) {
+    EXPECT_EQ(ids[i], expectedIds[i]) << "at " << i;
+  }
+}
+
 // Tests how strings are mapped to uint64_t (if they fit) and to
 // consecutive ids of distinct values for the general case.
 TEST_F(VectorHasherTest, stringIds) {
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/WorkStealingExecutor.h"
+
+#include <folly/synchronization/Baton.h>
+#include <gtest/gtest.h>
+
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+class WorkStealingExecutorTest : public OperatorTestBase {};
+
+TEST_F(WorkStealingExecutorTest, allFunctionsRun) {
+  std::atomic<int32_t> numRuns{0};
+  {
+    WorkStealingExecutor executor(4);
+    ASSERT_EQ(executor.numThreads(), 4);
+    for (auto i = 0; i < 1'000; ++i) {
+      executor.add([&]() {
+        ++numRuns;
+        // Functions added from a worker go to the queue of the worker.
+        executor.add([&]() { ++numRuns; });
+      });
+    }
+    // The destructor runs the functions that are still queued.
+  }
+  ASSERT_EQ(numRuns, 2'000);
+}
+
+TEST_F(WorkStealingExecutorTest, priority) {
+  WorkStealingExecutor executor(1, 3);
+  ASSERT_EQ(executor.getNumPriorities(), 3);
+
+  folly::Baton<> started;
+  folly::Baton<> release;
+  executor.add([&]() {
+    started.post();
+    release.wait();
+  });
+  started.wait();
+
+  // The single worker is busy. Queue functions of all priorities and check
+  // that they run from the highest priority down, in FIFO order within a
+  // priority. Priorities below the lowest level share the lowest level.
+  std::vector<int32_t> order;
+  std::mutex mutex;
+  auto addNumbered = [&](int32_t number, int8_t priority) {
+    executor.addWithPriority(
+        [&, number]() {
+          std::lock_guard<std::mutex> l(mutex);
+          order.push_back(number);
+        },
+        priority);
+  };
+  addNumbered(5, folly::Executor::MID_PRI - 2);
+  addNumbered(3, folly::Executor::MID_PRI - 1);
+  addNumbered(1, folly::Executor::MID_PRI);
+  addNumbered(6, folly::Executor::LO_PRI);
+  addNumbered(2, folly::Executor::HI_PRI);
+  addNumbered(4, folly::Executor::MID_PRI - 1);
+
+  folly::Baton<> done;
+  executor.addWithPriority([&]() { done.post(); }, folly::Executor::LO_PRI);
+  release.post();
+  done.wait();
+  ASSERT_EQ(order, std::vector<int32_t>({1, 2, 3, 4, 5, 6}));
+}
+
+TEST_F(WorkStealingExecutorTest, steal) {
+  constexpr int32_t kNumFunctions = 10;
+  WorkStealingExecutor executor(2);
+  std::atomic<int32_t> numRuns{0};
+  folly::Baton<> allRun;
+  folly::Baton<> done;
+  executor.add([&]() {
+    // These go to the queue of this worker, which stays busy until the other
+    // worker has stolen and run all of them.
+    for (auto i = 0; i < kNumFunctions; ++i) {
+      executor.add([&]() {
+        if (++numRuns == kNumFunctions) {
+          allRun.post();
+        }
+      });
+    }
+    allRun.wait();
+    done.post();
+  });
+  done.wait();
+  ASSERT_EQ(numRuns, kNumFunctions);
+  ASSERT_GE(executor.numSteals(), kNumFunctions);
+}
+
+TEST_F(WorkStealingExecutorTest, query) {
+  // Drivers enqueue themselves with priorities if the executor has more than
+  // one.
+  auto data = makeRowVector({makeFlatVector<int64_t>(
+      1'000, [](auto row) { return row % 17; })});
+  createDuckDbTable({data});
+
+  WorkStealingExecutor executor(4);
+  auto queryCtx = std::make_shared<core::QueryCtx>(&executor);
+  auto plan = PlanBuilder()
+                  .values({data}, true)
+                  .filter("c0 % 2 = 0")
+                  .partialAggregation({"c0"}, {"count(1)"})
+                  .localPartition({"c0"})
+                  .finalAggregation()
+                  .planNode();
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .queryCtx(queryCtx)
+                  .maxDrivers(4)
+                  .assertResults(
+                      "SELECT c0, count(1) FROM tmp WHERE c0 % 2 = 0 GROUP BY 1");
+  ASSERT_GT(task->driverCpuNanos(), 0);
+}
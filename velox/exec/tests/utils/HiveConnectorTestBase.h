@@ -218,6 +218,14 @@ class HiveConnectorSplitBuilder {
     return *this;
   }
 
+  HiveConnectorSplitBuilder& deleteFile(
+      const std::string& filePath,
+      dwio::common::FileFormat format = dwio::common::FileFormat::DWRF) {
+    deleteFiles_.push_back(
+        {filePath.find("/") == 0 ? "file:" + filePath : filePath, format});
+    return *this;
+  }
+
   std::shared_ptr<connector::hive::HiveConnectorSplit> build() const {
     return std::make_shared<connector::hive::HiveConnectorSplit>(
         kHiveConnectorId,
@@ -226,7 +234,10 @@ class HiveConnectorSplitBuilder {
         start_,
         length_,
         partitionKeys_,
-        tableBucketNumber_);
+        tableBucketNumber_,
+        std::unordered_map<std::string, std::string>{},
+        nullptr,
+        deleteFiles_);
   }
 
  private:
@@ -236,6 +247,7 @@ class HiveConnectorSplitBuilder {
   uint64_t length_{std::numeric_limits<uint64_t>::max()};
   std::unordered_map<std::string, std::optional<std::string>> partitionKeys_;
   std::optional<int32_t> tableBucketNumber_;
+  std::vector<connector::hive::HiveDeleteFile> deleteFiles_;
 };
 
 } // namespace facebook::velox::exec::test
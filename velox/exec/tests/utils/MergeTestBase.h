@@ -79,6 +79,11 @@ class TestingStream final : public MergeStream {
     currentValid_ = false;
   }
 
+  // Key of the first value for KeyMergeArray.
+  uint64_t key() const {
+    return current_.value();
+  }
+
   bool operator<(const MergeStream& other) const final {
     return current_.value() <
         static_cast<const TestingStream&>(other).current_.value();
@@ -175,6 +180,36 @@ class MergeTestBase {
     }
   }
 
+  // Reads the data in 'testData.runs' with KeyMergeArray::nextRun(), taking
+  // all values up to the returned bound from each returned stream. Checks the
+  // results like test().
+  static void testRuns(const TestData& testData, bool check) {
+    std::vector<std::unique_ptr<TestingStream>> sources;
+    for (auto& source : testData.sources) {
+      sources.push_back(std::make_unique<TestingStream>(*source));
+    }
+    KeyMergeArray<TestingStream> merge(std::move(sources));
+    auto expected = testData.data.begin();
+    for (;;) {
+      auto [source, bound] = merge.nextRun();
+      if (source == nullptr) {
+        break;
+      }
+      do {
+        if (check) {
+          ASSERT_TRUE(expected != testData.data.end())
+              << "Too many values in merged stream";
+          ASSERT_EQ(source->current()->value(), *expected++);
+        }
+        source->pop();
+      } while (source->hasData() && source->key() <= bound);
+    }
+    if (check) {
+      ASSERT_TRUE(expected == testData.data.end())
+          << "Premature end in merged stream";
+    }
+  }
+
  protected:
   folly::Random::DefaultGenerator rng_;
 };
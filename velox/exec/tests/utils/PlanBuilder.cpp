@@ -696,6 +696,68 @@ PlanBuilder& PlanBuilder::groupId(
   return *this;
 }
 
+PlanBuilder& PlanBuilder::groupingSetsAggregation(
+    const std::vector<std::vector<std::string>>& groupingSets,
+    const std::vector<std::string>& aggregates,
+    std::string groupIdName) {
+  // The finest grouping set has all keys in the order groupId() outputs them.
+  std::vector<std::string> groupingKeys;
+  for (const auto& groupingSet : groupingSets) {
+    for (const auto& key : groupingSet) {
+      if (std::find(groupingKeys.begin(), groupingKeys.end(), key) ==
+          groupingKeys.end()) {
+        groupingKeys.push_back(key);
+      }
+    }
+  }
+  partialAggregation(groupingKeys, aggregates);
+  auto partialAggNode =
+      std::dynamic_pointer_cast<const core::AggregationNode>(planNode_);
+  VELOX_CHECK_NOT_NULL(partialAggNode);
+  const auto& aggregateNames = partialAggNode->aggregateNames();
+  groupId(groupingSets, aggregateNames, groupIdName);
+
+  const auto numGroupingKeys = groupingKeys.size();
+  std::vector<core::FieldAccessTypedExprPtr> finalKeys;
+  for (auto i = 0; i < numGroupingKeys; ++i) {
+    finalKeys.push_back(field(i));
+  }
+  finalKeys.push_back(field(groupIdName));
+
+  std::vector<core::AggregationNode::Aggregate> finalAggregates;
+  for (auto i = 0; i < aggregateNames.size(); ++i) {
+    // Resolves the final result type from the raw input types of the partial
+    // aggregation.
+    const auto& call = partialAggNode->aggregates()[i].call;
+    std::vector<TypePtr> rawInputTypes;
+    for (const auto& rawInput : call->inputs()) {
+      rawInputTypes.push_back(rawInput->type());
+    }
+    auto type = resolveAggregateType(
+        call->name(),
+        core::AggregationNode::Step::kFinal,
+        rawInputTypes,
+        false);
+    core::AggregationNode::Aggregate aggregate;
+    aggregate.call = std::make_shared<core::CallTypedExpr>(
+        type,
+        std::vector<core::TypedExprPtr>{field(numGroupingKeys + i)},
+        call->name());
+    finalAggregates.push_back(std::move(aggregate));
+  }
+
+  planNode_ = std::make_shared<core::AggregationNode>(
+      nextPlanNodeId(),
+      core::AggregationNode::Step::kFinal,
+      finalKeys,
+      std::vector<core::FieldAccessTypedExprPtr>{},
+      aggregateNames,
+      finalAggregates,
+      false, // ignoreNullKeys
+      planNode_);
+  return *this;
+}
+
 PlanBuilder& PlanBuilder::localMerge(
     const std::vector<std::string>& keys,
     std::vector<core::PlanNodePtr> sources) {
@@ -725,6 +787,21 @@ PlanBuilder& PlanBuilder::orderBy(
   return *this;
 }
 
+PlanBuilder& PlanBuilder::parallelOrderBy(
+    const std::vector<std::string>& keys) {
+  orderBy(keys, true);
+
+  auto [sortingKeys, sortingOrders] =
+      parseOrderByClauses(keys, planNode_->outputType(), pool_);
+  planNode_ = std::make_shared<core::LocalMergeNode>(
+      nextPlanNodeId(),
+      sortingKeys,
+      sortingOrders,
+      std::vector<core::PlanNodePtr>{planNode_});
+
+  return *this;
+}
+
 PlanBuilder& PlanBuilder::topN(
     const std::vector<std::string>& keys,
     int32_t count,
@@ -1084,6 +1161,31 @@ PlanBuilder& PlanBuilder::nestedLoopJoin(
   return nestedLoopJoin(right, "", outputLayout, joinType);
 }
 
+PlanBuilder& PlanBuilder::asofJoin(
+    const std::vector<std::string>& leftKeys,
+    const std::vector<std::string>& rightKeys,
+    const core::PlanNodePtr& right,
+    const std::string& comparison,
+    const std::vector<std::string>& outputLayout,
+    core::JoinType joinType) {
+  VELOX_CHECK_EQ(leftKeys.size(), rightKeys.size());
+
+  auto leftType = planNode_->outputType();
+  auto rightType = right->outputType();
+  auto outputType = extract(concat(leftType, rightType), outputLayout);
+
+  planNode_ = std::make_shared<core::AsofJoinNode>(
+      nextPlanNodeId(),
+      joinType,
+      fields(leftType, leftKeys),
+      fields(rightType, rightKeys),
+      core::AsofJoinNode::comparisonFromName(comparison),
+      std::move(planNode_),
+      right,
+      outputType);
+  return *this;
+}
+
 PlanBuilder& PlanBuilder::nestedLoopJoin(
     const core::PlanNodePtr& right,
     const std::string& joinCondition,
@@ -1349,6 +1451,17 @@ bool equalSortOrderList(
 
 PlanBuilder& PlanBuilder::window(
     const std::vector<std::string>& windowFunctions) {
+  return window(windowFunctions, false);
+}
+
+PlanBuilder& PlanBuilder::streamingWindow(
+    const std::vector<std::string>& windowFunctions) {
+  return window(windowFunctions, true);
+}
+
+PlanBuilder& PlanBuilder::window(
+    const std::vector<std::string>& windowFunctions,
+    bool inputsSorted) {
   VELOX_CHECK_GT(
       windowFunctions.size(),
       0,
@@ -1429,6 +1542,7 @@ PlanBuilder& PlanBuilder::window(
       sortingOrders,
       windowNames,
       windowNodeFunctions,
+      inputsSorted,
       planNode_);
   return *this;
 }
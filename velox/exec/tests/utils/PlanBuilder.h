@@ -464,6 +464,21 @@ class PlanBuilder {
       const std::vector<std::string>& aggregationInputs,
       std::string groupIdName = "group_id");
 
+  /// Computes 'aggregates' for each of 'groupingSets' by aggregating the
+  /// input once on the union of the grouping sets and re-aggregating the
+  /// intermediate results for each set. Adds a partial aggregation on all
+  /// grouping keys, a GroupIdNode that replicates the partial results once
+  /// per grouping set and a final aggregation on the grouping keys and
+  /// 'groupIdName'. The output is as of groupId() followed by a single
+  /// aggregation on the grouping keys and 'groupIdName', but the input rows
+  /// are not replicated. For example, a cube on 4 keys aggregates the input
+  /// once instead of 16 times. 'aggregates' are as in partialAggregation().
+  /// Masks and distinct aggregates are not supported.
+  PlanBuilder& groupingSetsAggregation(
+      const std::vector<std::vector<std::string>>& groupingSets,
+      const std::vector<std::string>& aggregates,
+      std::string groupIdName = "group_id");
+
   /// Add a LocalMergeNode using specified ORDER BY clauses.
   ///
   /// For example,
@@ -486,6 +501,19 @@ class PlanBuilder {
   /// ASC NULLS LAST and column "b" will use DESC NULLS LAST.
   PlanBuilder& orderBy(const std::vector<std::string>& keys, bool isPartial);
 
+  /// Adds a partial OrderByNode followed by a LocalMergeNode using specified
+  /// ORDER BY clauses. The OrderBy and its source run in a separate pipeline
+  /// with multiple drivers, each sorting its share of the input. The
+  /// LocalMerge produces a single sorted stream from the sorted outputs of
+  /// the drivers.
+  ///
+  /// For example,
+  ///
+  ///     .parallelOrderBy({"a", "b DESC", "c ASC NULLS FIRST"})
+  ///
+  /// Uses the same default sort order as orderBy().
+  PlanBuilder& parallelOrderBy(const std::vector<std::string>& keys);
+
   /// Add a TopNNode using specified N and ORDER BY clauses.
   ///
   /// For example,
@@ -645,6 +673,23 @@ class PlanBuilder {
       const std::vector<std::string>& outputLayout,
       core::JoinType joinType = core::JoinType::kInner);
 
+  /// Add an AsofJoinNode joining each row of the input with at most one row of
+  /// 'right': the row with equal 'leftKeys' and 'rightKeys' except for the last
+  /// ones, whose last key is the closest to the last left key among the rows
+  /// for which 'leftKey <comparison> rightKey'. The caller is responsible to
+  /// ensure that the inputs are sorted in ascending order on the keys.
+  ///
+  /// @param comparison The comparison of the last keys: '>=', '>', '<=' or
+  /// '<'.
+  /// @param joinType Type of the join: inner or left.
+  PlanBuilder& asofJoin(
+      const std::vector<std::string>& leftKeys,
+      const std::vector<std::string>& rightKeys,
+      const core::PlanNodePtr& right,
+      const std::string& comparison,
+      const std::vector<std::string>& outputLayout,
+      core::JoinType joinType = core::JoinType::kInner);
+
   /// Add a NestedLoopJoinNode to join two inputs using filter as join
   /// condition to perform equal/non-equal join. Only supports inner/outer
   /// joins.
@@ -720,6 +765,12 @@ class PlanBuilder {
   ///  rows between a + 10 preceding and 10 following)"
   PlanBuilder& window(const std::vector<std::string>& windowFunctions);
 
+  /// Same as above, but the input is expected to be already sorted by
+  /// (partition keys + sorting keys), e.g. the output of an OrderBy or Merge.
+  /// The window operator then produces the output of each partition as soon
+  /// as the partition is complete.
+  PlanBuilder& streamingWindow(const std::vector<std::string>& windowFunctions);
+
   /// Add a RowNumberNode to compute single row_number window function with an
   /// optional limit and no sorting.
   PlanBuilder& rowNumber(
@@ -834,6 +885,10 @@ class PlanBuilder {
     std::vector<std::string> names;
   };
 
+  PlanBuilder& window(
+      const std::vector<std::string>& windowFunctions,
+      bool inputsSorted);
+
   AggregatesAndNames createAggregateExpressionsAndNames(
       const std::vector<std::string>& aggregates,
       const std::vector<std::string>& masks,
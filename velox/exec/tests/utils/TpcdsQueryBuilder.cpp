@@ -0,0 +1,642 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/tests/utils/TpcdsQueryBuilder.h"
+
+#include "velox/common/base/Fs.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/dwio/common/ReaderFactory.h"
+
+#include <fstream>
+
+namespace facebook::velox::exec::test {
+
+namespace {
+std::vector<std::string> mergeColumnNames(
+    std::vector<std::string> first,
+    const std::vector<std::string>& second) {
+  first.insert(first.end(), second.begin(), second.end());
+  return first;
+}
+
+// Returns a filter on 'column' between 'lowerBound' and 'upperBound'. DWRF
+// does not support the Date type and keeps dates as Varchar.
+std::string dateBetween(
+    const std::string& column,
+    const RowTypePtr& rowType,
+    const std::string& lowerBound,
+    const std::string& upperBound) {
+  const auto suffix = rowType->findChild(column)->isVarchar() ? "" : "::DATE";
+  return fmt::format(
+      "{} between {}{} and {}{}",
+      column,
+      lowerBound,
+      suffix,
+      upperBound,
+      suffix);
+}
+} // namespace
+
+void TpcdsQueryBuilder::readFileSchema(
+    const std::string& tableName,
+    const std::string& filePath,
+    const std::vector<std::string>& columns) {
+  dwio::common::ReaderOptions readerOptions{pool_.get()};
+  readerOptions.setFileFormat(format_);
+  std::shared_ptr<ReadFile> readFile =
+      filesystems::getFileSystem(filePath, nullptr)->openFileForRead(filePath);
+  auto input = std::make_unique<dwio::common::BufferedInput>(
+      readFile, readerOptions.getMemoryPool());
+  auto reader = dwio::common::getReaderFactory(readerOptions.getFileFormat())
+                    ->createReader(std::move(input), readerOptions);
+  const auto& fileType = reader->rowType();
+  // There can be extra columns in the file towards the end.
+  VELOX_CHECK_GE(fileType->size(), columns.size());
+  auto& metadata = tableMetadata_[tableName];
+  for (auto i = 0; i < columns.size(); ++i) {
+    metadata.fileColumnNames[columns[i]] = fileType->nameOf(i);
+  }
+  auto names = columns;
+  auto types = fileType->children();
+  types.resize(columns.size());
+  metadata.type = ROW(std::move(names), std::move(types));
+}
+
+void TpcdsQueryBuilder::initialize(const std::string& dataPath) {
+  for (const auto& [tableName, columns] : kTables_) {
+    const fs::path tablePath{dataPath + "/" + tableName};
+    std::error_code error;
+    bool anyFound = false;
+    for (auto const& dirEntry : fs::directory_iterator{
+             tablePath, std::filesystem::directory_options(), error}) {
+      if (!dirEntry.is_regular_file()) {
+        continue;
+      }
+      // Ignore hidden files.
+      if (dirEntry.path().filename().c_str()[0] == '.') {
+        continue;
+      }
+      if (tableMetadata_[tableName].dataFiles.empty()) {
+        anyFound = true;
+        readFileSchema(tableName, dirEntry.path().string(), columns);
+      }
+      tableMetadata_[tableName].dataFiles.push_back(dirEntry.path());
+    }
+    if (!anyFound && error) {
+      std::ifstream file(tablePath);
+      std::string line;
+      while (std::getline(file, line)) {
+        if (tableMetadata_[tableName].dataFiles.empty()) {
+          readFileSchema(tableName, line, columns);
+        }
+        tableMetadata_[tableName].dataFiles.push_back(line);
+      }
+    }
+  }
+}
+
+const std::vector<int32_t>& TpcdsQueryBuilder::getQueryIds() {
+  static const std::vector<int32_t> kQueryIds = {3, 7, 42, 55, 67, 98};
+  return kQueryIds;
+}
+
+const std::vector<std::string>& TpcdsQueryBuilder::getTableNames() {
+  return kTableNames_;
+}
+
+TpchPlan TpcdsQueryBuilder::getQueryPlan(int queryId) const {
+  switch (queryId) {
+    case 3:
+      return getQ3Plan();
+    case 7:
+      return getQ7Plan();
+    case 42:
+      return getQ42Plan();
+    case 55:
+      return getQ55Plan();
+    case 67:
+      return getQ67Plan();
+    case 98:
+      return getQ98Plan();
+    default:
+      VELOX_NYI("TPC-DS query {} is not supported yet", queryId);
+  }
+}
+
+PlanBuilder TpcdsQueryBuilder::scan(
+    const std::shared_ptr<core::PlanNodeIdGenerator>& planNodeIdGenerator,
+    const std::string& tableName,
+    const std::vector<std::string>& columns,
+    TpchPlan& plan,
+    const std::vector<std::string>& subfieldFilters,
+    const std::string& remainingFilter) const {
+  const auto& metadata = tableMetadata_.at(tableName);
+  core::PlanNodeId scanId;
+  PlanBuilder builder(planNodeIdGenerator, pool_.get());
+  builder
+      .tableScan(
+          tableName,
+          getRowType(tableName, columns),
+          metadata.fileColumnNames,
+          subfieldFilters,
+          remainingFilter)
+      .capturePlanNodeId(scanId);
+  plan.dataFiles[scanId] = metadata.dataFiles;
+  return builder;
+}
+
+TpchPlan TpcdsQueryBuilder::getStoreSalesByItemPlan(
+    const std::vector<std::string>& dateFilters,
+    const std::vector<std::string>& itemColumns,
+    const std::string& itemFilter,
+    const std::vector<std::string>& groupingKeys,
+    const std::vector<std::string>& orderBy) const {
+  TpchPlan context;
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto dates = scan(
+                   planNodeIdGenerator,
+                   kDateDim,
+                   {"d_date_sk", "d_year", "d_moy"},
+                   context,
+                   dateFilters)
+                   .planNode();
+  auto items =
+      scan(planNodeIdGenerator, kItem, itemColumns, context, {itemFilter})
+          .planNode();
+
+  // The grouping keys come from item except for d_year.
+  std::vector<std::string> itemJoinOutput = {
+      "ss_sold_date_sk", "ss_ext_sales_price"};
+  for (const auto& key : groupingKeys) {
+    if (key != "d_year") {
+      itemJoinOutput.push_back(key);
+    }
+  }
+
+  context.plan =
+      scan(
+          planNodeIdGenerator,
+          kStoreSales,
+          {"ss_sold_date_sk", "ss_item_sk", "ss_ext_sales_price"},
+          context)
+          .hashJoin({"ss_item_sk"}, {"i_item_sk"}, items, "", itemJoinOutput)
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              mergeColumnNames(groupingKeys, {"ss_ext_sales_price"}))
+          .project(mergeColumnNames(
+              groupingKeys, {"cast(ss_ext_sales_price as double) AS price"}))
+          .partialAggregation(groupingKeys, {"sum(price) AS sum_agg"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .orderBy(orderBy, false)
+          .limit(0, 100, false)
+          .planNode();
+  context.dataFileFormat = format_;
+  return context;
+}
+
+TpchPlan TpcdsQueryBuilder::getQ3Plan() const {
+  return getStoreSalesByItemPlan(
+      {"d_moy = 11"},
+      {"i_item_sk", "i_brand_id", "i_brand", "i_manufact_id"},
+      "i_manufact_id = 128",
+      {"d_year", "i_brand_id", "i_brand"},
+      {"d_year", "sum_agg DESC", "i_brand_id"});
+}
+
+TpchPlan TpcdsQueryBuilder::getQ42Plan() const {
+  return getStoreSalesByItemPlan(
+      {"d_moy = 11", "d_year = 2000"},
+      {"i_item_sk", "i_category_id", "i_category", "i_manager_id"},
+      "i_manager_id = 1",
+      {"d_year", "i_category_id", "i_category"},
+      {"sum_agg DESC", "d_year", "i_category_id", "i_category"});
+}
+
+TpchPlan TpcdsQueryBuilder::getQ55Plan() const {
+  return getStoreSalesByItemPlan(
+      {"d_moy = 11", "d_year = 1999"},
+      {"i_item_sk", "i_brand_id", "i_brand", "i_manager_id"},
+      "i_manager_id = 28",
+      {"i_brand_id", "i_brand"},
+      {"sum_agg DESC", "i_brand_id"});
+}
+
+TpchPlan TpcdsQueryBuilder::getQ7Plan() const {
+  TpchPlan context;
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto demographics = scan(
+                          planNodeIdGenerator,
+                          kCustomerDemographics,
+                          {"cd_demo_sk",
+                           "cd_gender",
+                           "cd_marital_status",
+                           "cd_education_status"},
+                          context,
+                          {"cd_gender = 'M'",
+                           "cd_marital_status = 'S'",
+                           "cd_education_status = 'College'"})
+                          .planNode();
+  auto dates = scan(
+                   planNodeIdGenerator,
+                   kDateDim,
+                   {"d_date_sk", "d_year"},
+                   context,
+                   {"d_year = 2000"})
+                   .planNode();
+  auto promotions = scan(
+                        planNodeIdGenerator,
+                        kPromotion,
+                        {"p_promo_sk", "p_channel_email", "p_channel_event"},
+                        context,
+                        {},
+                        "p_channel_email = 'N' OR p_channel_event = 'N'")
+                        .planNode();
+  auto items = scan(
+                   planNodeIdGenerator,
+                   kItem,
+                   {"i_item_sk", "i_item_id"},
+                   context)
+                   .planNode();
+
+  const std::vector<std::string> measures = {
+      "ss_quantity", "ss_list_price", "ss_coupon_amt", "ss_sales_price"};
+  context.plan =
+      scan(
+          planNodeIdGenerator,
+          kStoreSales,
+          mergeColumnNames(
+              {"ss_sold_date_sk", "ss_item_sk", "ss_cdemo_sk", "ss_promo_sk"},
+              measures),
+          context)
+          .hashJoin(
+              {"ss_cdemo_sk"},
+              {"cd_demo_sk"},
+              demographics,
+              "",
+              mergeColumnNames(
+                  {"ss_sold_date_sk", "ss_item_sk", "ss_promo_sk"}, measures))
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              mergeColumnNames({"ss_item_sk", "ss_promo_sk"}, measures))
+          .hashJoin(
+              {"ss_promo_sk"},
+              {"p_promo_sk"},
+              promotions,
+              "",
+              mergeColumnNames({"ss_item_sk"}, measures))
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              items,
+              "",
+              mergeColumnNames({"i_item_id"}, measures))
+          .project(
+              {"i_item_id",
+               "ss_quantity",
+               "cast(ss_list_price as double) AS list_price",
+               "cast(ss_coupon_amt as double) AS coupon_amt",
+               "cast(ss_sales_price as double) AS sales_price"})
+          .partialAggregation(
+              {"i_item_id"},
+              {"avg(ss_quantity) AS agg1",
+               "avg(list_price) AS agg2",
+               "avg(coupon_amt) AS agg3",
+               "avg(sales_price) AS agg4"})
+          .localPartition(std::vector<std::string>{})
+          .finalAggregation()
+          .orderBy({"i_item_id"}, false)
+          .limit(0, 100, false)
+          .planNode();
+  context.dataFileFormat = format_;
+  return context;
+}
+
+TpchPlan TpcdsQueryBuilder::getQ67Plan() const {
+  TpchPlan context;
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto dates = scan(
+                   planNodeIdGenerator,
+                   kDateDim,
+                   {"d_date_sk", "d_month_seq", "d_year", "d_qoy", "d_moy"},
+                   context,
+                   {"d_month_seq between 1200 and 1211"})
+                   .planNode();
+  auto stores = scan(
+                    planNodeIdGenerator,
+                    kStore,
+                    {"s_store_sk", "s_store_id"},
+                    context)
+                    .planNode();
+  auto items =
+      scan(
+          planNodeIdGenerator,
+          kItem,
+          {"i_item_sk", "i_category", "i_class", "i_brand", "i_product_name"},
+          context)
+          .planNode();
+
+  const std::vector<std::string> keys = {
+      "i_category",
+      "i_class",
+      "i_brand",
+      "i_product_name",
+      "d_year",
+      "d_qoy",
+      "d_moy",
+      "s_store_id"};
+  // GROUP BY ROLLUP(keys) is an aggregation over the grouping sets made of
+  // each prefix of 'keys'.
+  std::vector<std::vector<std::string>> rollup;
+  for (auto i = keys.size(); i > 0; --i) {
+    rollup.emplace_back(keys.begin(), keys.begin() + i);
+  }
+  rollup.emplace_back();
+
+  const std::vector<std::string> measures = {"ss_quantity", "ss_sales_price"};
+  context.plan =
+      scan(
+          planNodeIdGenerator,
+          kStoreSales,
+          mergeColumnNames(
+              {"ss_sold_date_sk", "ss_item_sk", "ss_store_sk"}, measures),
+          context)
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              mergeColumnNames(
+                  {"ss_item_sk", "ss_store_sk", "d_year", "d_qoy", "d_moy"},
+                  measures))
+          .hashJoin(
+              {"ss_store_sk"},
+              {"s_store_sk"},
+              stores,
+              "",
+              mergeColumnNames(
+                  {"ss_item_sk", "d_year", "d_qoy", "d_moy", "s_store_id"},
+                  measures))
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              items,
+              "",
+              mergeColumnNames(keys, measures))
+          .project(mergeColumnNames(
+              keys,
+              {"coalesce(cast(ss_sales_price as double) * "
+               "cast(ss_quantity as double), 0.0) AS sales"}))
+          .groupId(rollup, {"sales"})
+          .partialAggregation(
+              mergeColumnNames(keys, {"group_id"}), {"sum(sales) AS sumsales"})
+          .localPartition({"i_category"})
+          .finalAggregation()
+          .window(
+              {"rank() over (partition by i_category order by sumsales desc) "
+               "AS rk"})
+          .filter("rk <= 100")
+          .localPartition(std::vector<std::string>{})
+          .topN(mergeColumnNames(keys, {"sumsales", "rk"}), 100, false)
+          .project(mergeColumnNames(keys, {"sumsales", "rk"}))
+          .planNode();
+  context.dataFileFormat = format_;
+  return context;
+}
+
+TpchPlan TpcdsQueryBuilder::getQ98Plan() const {
+  TpchPlan context;
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  const std::vector<std::string> dateColumns = {"d_date_sk", "d_date"};
+  auto dates = scan(
+                   planNodeIdGenerator,
+                   kDateDim,
+                   dateColumns,
+                   context,
+                   {dateBetween(
+                       "d_date",
+                       getRowType(kDateDim, dateColumns),
+                       "'1999-02-22'",
+                       "'1999-03-24'")})
+                   .planNode();
+  auto items = scan(
+                   planNodeIdGenerator,
+                   kItem,
+                   {"i_item_sk",
+                    "i_item_id",
+                    "i_item_desc",
+                    "i_current_price",
+                    "i_class",
+                    "i_category"},
+                   context,
+                   {"i_category IN ('Sports', 'Books', 'Home')"})
+                   .planNode();
+
+  const std::vector<std::string> keys = {
+      "i_item_id", "i_item_desc", "i_category", "i_class", "i_current_price"};
+  context.plan =
+      scan(
+          planNodeIdGenerator,
+          kStoreSales,
+          {"ss_sold_date_sk", "ss_item_sk", "ss_ext_sales_price"},
+          context)
+          .hashJoin(
+              {"ss_item_sk"},
+              {"i_item_sk"},
+              items,
+              "",
+              mergeColumnNames({"ss_sold_date_sk", "ss_ext_sales_price"}, keys))
+          .hashJoin(
+              {"ss_sold_date_sk"},
+              {"d_date_sk"},
+              dates,
+              "",
+              mergeColumnNames(keys, {"ss_ext_sales_price"}))
+          .project(mergeColumnNames(
+              keys, {"cast(ss_ext_sales_price as double) AS price"}))
+          .partialAggregation(keys, {"sum(price) AS itemrevenue"})
+          // Partitioning on i_class serves both the final aggregation and the
+          // window.
+          .localPartition({"i_class"})
+          .finalAggregation()
+          .window({"sum(itemrevenue) over (partition by i_class) AS total"})
+          .project(mergeColumnNames(
+              keys,
+              {"itemrevenue", "itemrevenue * 100.0 / total AS revenueratio"}))
+          .parallelOrderBy(
+              {"i_category",
+               "i_class",
+               "i_item_id",
+               "i_item_desc",
+               "revenueratio"})
+          .planNode();
+  context.dataFileFormat = format_;
+  return context;
+}
+
+const std::vector<std::string> TpcdsQueryBuilder::kTableNames_ = {
+    kStoreSales,
+    kDateDim,
+    kItem,
+    kStore,
+    kCustomerDemographics,
+    kPromotion};
+
+const std::unordered_map<std::string, std::vector<std::string>>
+    TpcdsQueryBuilder::kTables_ = {
+        {kStoreSales,
+         {"ss_sold_date_sk",
+          "ss_sold_time_sk",
+          "ss_item_sk",
+          "ss_customer_sk",
+          "ss_cdemo_sk",
+          "ss_hdemo_sk",
+          "ss_addr_sk",
+          "ss_store_sk",
+          "ss_promo_sk",
+          "ss_ticket_number",
+          "ss_quantity",
+          "ss_wholesale_cost",
+          "ss_list_price",
+          "ss_sales_price",
+          "ss_ext_discount_amt",
+          "ss_ext_sales_price",
+          "ss_ext_wholesale_cost",
+          "ss_ext_list_price",
+          "ss_ext_tax",
+          "ss_coupon_amt",
+          "ss_net_paid",
+          "ss_net_paid_inc_tax",
+          "ss_net_profit"}},
+        {kDateDim,
+         {"d_date_sk",
+          "d_date_id",
+          "d_date",
+          "d_month_seq",
+          "d_week_seq",
+          "d_quarter_seq",
+          "d_year",
+          "d_dow",
+          "d_moy",
+          "d_dom",
+          "d_qoy",
+          "d_fy_year",
+          "d_fy_quarter_seq",
+          "d_fy_week_seq",
+          "d_day_name",
+          "d_quarter_name",
+          "d_holiday",
+          "d_weekend",
+          "d_following_holiday",
+          "d_first_dom",
+          "d_last_dom",
+          "d_same_day_ly",
+          "d_same_day_lq",
+          "d_current_day",
+          "d_current_week",
+          "d_current_month",
+          "d_current_quarter",
+          "d_current_year"}},
+        {kItem,
+         {"i_item_sk",
+          "i_item_id",
+          "i_rec_start_date",
+          "i_rec_end_date",
+          "i_item_desc",
+          "i_current_price",
+          "i_wholesale_cost",
+          "i_brand_id",
+          "i_brand",
+          "i_class_id",
+          "i_class",
+          "i_category_id",
+          "i_category",
+          "i_manufact_id",
+          "i_manufact",
+          "i_size",
+          "i_formulation",
+          "i_color",
+          "i_units",
+          "i_container",
+          "i_manager_id",
+          "i_product_name"}},
+        {kStore,
+         {"s_store_sk",
+          "s_store_id",
+          "s_rec_start_date",
+          "s_rec_end_date",
+          "s_closed_date_sk",
+          "s_store_name",
+          "s_number_employees",
+          "s_floor_space",
+          "s_hours",
+          "s_manager",
+          "s_market_id",
+          "s_geography_class",
+          "s_market_desc",
+          "s_market_manager",
+          "s_division_id",
+          "s_division_name",
+          "s_company_id",
+          "s_company_name",
+          "s_street_number",
+          "s_street_name",
+          "s_street_type",
+          "s_suite_number",
+          "s_city",
+          "s_county",
+          "s_state",
+          "s_zip",
+          "s_country",
+          "s_gmt_offset",
+          "s_tax_precentage"}},
+        {kCustomerDemographics,
+         {"cd_demo_sk",
+          "cd_gender",
+          "cd_marital_status",
+          "cd_education_status",
+          "cd_purchase_estimate",
+          "cd_credit_rating",
+          "cd_dep_count",
+          "cd_dep_employed_count",
+          "cd_dep_college_count"}},
+        {kPromotion,
+         {"p_promo_sk",
+          "p_promo_id",
+          "p_start_date_sk",
+          "p_end_date_sk",
+          "p_item_sk",
+          "p_cost",
+          "p_response_target",
+          "p_promo_name",
+          "p_channel_dmail",
+          "p_channel_email",
+          "p_channel_catalog",
+          "p_channel_tv",
+          "p_channel_radio",
+          "p_channel_press",
+          "p_channel_event",
+          "p_channel_demo",
+          "p_channel_details",
+          "p_purpose",
+          "p_discount_active"}}};
+
+} // namespace facebook::velox::exec::test
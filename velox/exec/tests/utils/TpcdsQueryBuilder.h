@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/tests/utils/TpchQueryBuilder.h"
+
+namespace facebook::velox::exec::test {
+
+/// Builds TPC-DS queries using TPC-DS data files located in the specified
+/// directory. The data layout and the mapping of file column names to the
+/// standard names are the same as for TpchQueryBuilder: a sub-directory or a
+/// file listing the data files per table, with the columns in the order of the
+/// TPC-DS specification.
+///
+/// Covers a subset of the queries chosen for the operators they exercise:
+///  3, 42, 55: star joins of store_sales with date_dim and item and a
+///  grouped aggregation.
+///  7: five way join with selective dimension filters.
+///  67: rollup over 8 keys followed by rank() per category.
+///  98: aggregation followed by a window sum per class.
+///
+/// Decimal columns are converted to double before arithmetic, so the data
+/// can be generated with either decimal or double prices.
+class TpcdsQueryBuilder {
+ public:
+  explicit TpcdsQueryBuilder(dwio::common::FileFormat format)
+      : format_(format) {}
+
+  /// Reads a data file of each table, initializes row types, and determines
+  /// data paths for each table.
+  /// @param dataPath path to the data files
+  void initialize(const std::string& dataPath);
+
+  /// Returns the query plan for a given TPC-DS query number.
+  /// @param queryId TPC-DS query number
+  TpchPlan getQueryPlan(int queryId) const;
+
+  /// Returns the numbers of the supported queries.
+  static const std::vector<int32_t>& getQueryIds();
+
+  /// Returns the TPC-DS table names used by the supported queries.
+  static const std::vector<std::string>& getTableNames();
+
+ private:
+  void readFileSchema(
+      const std::string& tableName,
+      const std::string& filePath,
+      const std::vector<std::string>& columns);
+
+  // Returns a PlanBuilder scanning 'columns' of 'tableName' with
+  // 'subfieldFilters' and 'remainingFilter' and adds the data files of
+  // 'tableName' to 'plan'.
+  PlanBuilder scan(
+      const std::shared_ptr<core::PlanNodeIdGenerator>& planNodeIdGenerator,
+      const std::string& tableName,
+      const std::vector<std::string>& columns,
+      TpchPlan& plan,
+      const std::vector<std::string>& subfieldFilters = {},
+      const std::string& remainingFilter = "") const;
+
+  // Queries 3, 42 and 55: store_sales joined with date_dim and item,
+  // aggregated by 'groupingKeys' from these and ordered by 'orderBy'.
+  TpchPlan getStoreSalesByItemPlan(
+      const std::vector<std::string>& dateFilters,
+      const std::vector<std::string>& itemColumns,
+      const std::string& itemFilter,
+      const std::vector<std::string>& groupingKeys,
+      const std::vector<std::string>& orderBy) const;
+
+  TpchPlan getQ3Plan() const;
+  TpchPlan getQ7Plan() const;
+  TpchPlan getQ42Plan() const;
+  TpchPlan getQ55Plan() const;
+  TpchPlan getQ67Plan() const;
+  TpchPlan getQ98Plan() const;
+
+  RowTypePtr getRowType(
+      const std::string& tableName,
+      const std::vector<std::string>& columnNames) const {
+    auto columnSelector = std::make_shared<dwio::common::ColumnSelector>(
+        tableMetadata_.at(tableName).type, columnNames);
+    return columnSelector->buildSelectedReordered();
+  }
+
+  std::unordered_map<std::string, TpchTableMetadata> tableMetadata_;
+  const dwio::common::FileFormat format_;
+  static const std::unordered_map<std::string, std::vector<std::string>>
+      kTables_;
+  static const std::vector<std::string> kTableNames_;
+
+  static constexpr const char* kStoreSales = "store_sales";
+  static constexpr const char* kDateDim = "date_dim";
+  static constexpr const char* kItem = "item";
+  static constexpr const char* kStore = "store";
+  static constexpr const char* kCustomerDemographics = "customer_demographics";
+  static constexpr const char* kPromotion = "promotion";
+  std::shared_ptr<memory::MemoryPool> pool_ =
+      memory::addDefaultLeafMemoryPool();
+};
+
+} // namespace facebook::velox::exec::test
@@ -17,6 +17,7 @@
 #include "velox/experimental/codegen/Codegen.h"
 #include <glog/logging.h>
 #include <memory>
+#include "velox/common/base/Exceptions.h"
 #include "velox/core/PlanNode.h"
 #include "velox/experimental/codegen/CodegenCompiledExpressionTransform.h"
 #include "velox/experimental/codegen/CodegenExceptions.h"
@@ -73,6 +74,13 @@ std::shared_ptr<const core::PlanNode> Codegen::compile(
   return transformedPlanNode;
 }
 
+void Codegen::setAsyncCompilation(bool asyncCompilation) {
+  VELOX_CHECK_NOT_NULL(transform_, "Codegen is not initialized");
+  auto flags = transform_->transformFlags();
+  flags.asyncCompilation = asyncCompilation;
+  transform_->setTransformFlags(flags);
+}
+
 bool Codegen::initializeCodeManager(
     const proto::CompilerOptionsProto& compilerOptionsProto) {
   LOG(INFO) << "Codegen: initializing CodeManager";
@@ -48,6 +48,11 @@ class Codegen {
 
   std::shared_ptr<const core::PlanNode> compile(const core::PlanNode& planNode);
 
+  /// If true, compile() returns the plan with the interpreted expressions
+  /// until the generated code, compiled in the background, is ready. Must be
+  /// called after initialize().
+  void setAsyncCompilation(bool asyncCompilation);
+
  private:
   std::shared_ptr<ICodegenLogger> codegenLogger_;
 
@@ -24,6 +24,7 @@
 #include "velox/experimental/codegen/CompiledExpressionAnalysis.h"
 #include "velox/experimental/codegen/code_generator/ExprCodeGenerator.h"
 #include "velox/experimental/codegen/compiler_utils/CodeManager.h"
+#include "velox/experimental/codegen/compiler_utils/CompiledObjectCache.h"
 #include "velox/experimental/codegen/compiler_utils/ICompiledCall.h"
 #include "velox/experimental/codegen/transform/PlanNodeTransform.h"
 #include "velox/experimental/codegen/transform/utils/ranges_utils.h"
@@ -44,11 +45,13 @@ class CompiledExpressionTransformVisitor {
       const CompilerOptions& options,
       DefaultScopedTimer::EventSequence& eventSequence,
       bool compileFilter = true,
-      bool mergeFilter = true)
+      bool mergeFilter = true,
+      bool asyncCompilation = false)
       : codeManager_(options, eventSequence),
         compiledExprAnalysisResult_(compiledExprAnalysisResult),
         compileFilter_(compileFilter),
-        mergeFilter_(mergeFilter) {}
+        mergeFilter_(mergeFilter),
+        asyncCompilation_(asyncCompilation) {}
 
   template <typename Children>
   std::shared_ptr<core::PlanNode> visit(
@@ -112,6 +115,38 @@ class CompiledExpressionTransformVisitor {
   bool compileFilter_;
   bool mergeFilter_;
 
+  // Compile in the background and keep the interpreted expressions until the
+  // library is ready.
+  bool asyncCompilation_;
+
+  /// Returns the library built from 'fileString', shared by all the plans
+  /// with the same generated code. Returns std::nullopt while it is compiled
+  /// in the background or if the compilation failed, in which case the caller
+  /// keeps the interpreted expressions.
+  std::optional<std::filesystem::path> compileAndLink(
+      const std::string& fileString) {
+    compiler_utils::CompiledObjectCache::CompileFunction compile;
+    if (asyncCompilation_) {
+      // The compilation may outlive 'this', so it gets its own compiler.
+      compile = [options = codeManager_.compiler().compilerOptions(),
+                 fileString]() {
+        DefaultScopedTimer::EventSequence eventSequence;
+        compiler_utils::Compiler compiler(options, eventSequence);
+        auto compiledObject = compiler.compileString({}, fileString);
+        return compiler.link({}, {compiledObject});
+      };
+    } else {
+      // Runs in the calling thread before get() returns.
+      compile = [this, &fileString]() {
+        auto compiledObject =
+            codeManager_.compiler().compileString({}, fileString);
+        return codeManager_.compiler().link({}, {compiledObject});
+      };
+    }
+    return compiler_utils::CompiledObjectCache::instance().get(
+        fileString, std::move(compile), asyncCompilation_);
+  }
+
   std::optional<std::reference_wrapper<const GeneratedExpressionStruct>>
   getGeneratedCode(const std::shared_ptr<const ITypedExpr>& expression) {
     auto it = compiledExprAnalysisResult_.generatedCode_.find(expression);
@@ -489,14 +524,20 @@ class CompiledExpressionTransformVisitor {
             fmt::arg(
                 "isDefaultNullStrict",
                 isDefaultNullStrict(filter.id()) ? "true" : "false")));
-    auto compiledObject = codeManager_.compiler().compileString({}, fileString);
-    auto dynamicObject = codeManager_.compiler().link({}, {compiledObject});
+    auto dynamicObject = compileAndLink(fileString);
+    if (!dynamicObject) {
+      return utils::adapter::FilterCopy::copyWith(
+          filter,
+          std::placeholders::_1,
+          std::placeholders::_1,
+          *ranges::begin(children));
+    }
 
     // Extract the row input expression from the current filter
     const auto inputType = filter.sources()[0]->outputType();
 
     std::shared_ptr<const ITypedExpr> newFilter = buildCompiledCallExpr(
-        dynamicObject, concatOutputType, concatInputType, inputType)[0];
+        *dynamicObject, concatOutputType, concatInputType, inputType)[0];
 
     // Build new filter node with newly generated expressions
     return utils::adapter::FilterCopy::copyWith(
@@ -588,8 +629,15 @@ class CompiledExpressionTransformVisitor {
                 "isDefaultNullStrict",
                 isDefaultNullStrict ? "true" : "false")));
 
-    auto compiledObject = codeManager_.compiler().compileString({}, fileString);
-    auto dynamicObject = codeManager_.compiler().link({}, {compiledObject});
+    auto dynamicObject = compileAndLink(fileString);
+    if (!dynamicObject) {
+      return utils::adapter::ProjectCopy::copyWith(
+          projection,
+          std::placeholders::_1,
+          std::placeholders::_1,
+          std::placeholders::_1,
+          *ranges::begin(children));
+    }
     std::vector<std::shared_ptr<const ITypedExpr>> newProjections;
 
     // Extract the row input expression from the current projection
@@ -597,7 +645,7 @@ class CompiledExpressionTransformVisitor {
 
     std::vector<std::shared_ptr<const ITypedExpr>> newExpressions =
         buildCompiledCallExpr(
-            dynamicObject, concatOutputType, concatInputType, inputType);
+            *dynamicObject, concatOutputType, concatInputType, inputType);
 
     // oldToNewExpressionColumnMap[Index] in the new projection list maps to
     // projection.projections()[Index] in the old;
@@ -647,6 +695,10 @@ union TransformFlags {
     // invalid if enableDefaultNullOpt not set
     bool enableFilterDefaultNull : 1;
 
+    // compile in the background, running the interpreted expressions until
+    // the compiled ones are ready
+    bool asyncCompilation : 1;
+
     // up for more flags in the future
   };
 
@@ -656,7 +708,7 @@ union TransformFlags {
 
 class CodegenCompiledExpressionTransform final : PlanNodeTransform {
  public:
-  constexpr static TransformFlags defaultFlags = {{1, 1, 1, 1}};
+  constexpr static TransformFlags defaultFlags = {{1, 1, 1, 1, 0}};
   CodegenCompiledExpressionTransform(
       const CompilerOptions& options,
       const UDFManager& udfManager,
@@ -688,7 +740,8 @@ class CodegenCompiledExpressionTransform final : PlanNodeTransform {
         compilerOptions_,
         eventSequence_,
         flags_.compileFilter,
-        flags_.mergeFilter);
+        flags_.mergeFilter,
+        flags_.asyncCompilation);
 
     auto nodeTransformer = [&visitor](
                                auto& node, const auto& transformedChildren) {
@@ -704,6 +757,10 @@ class CodegenCompiledExpressionTransform final : PlanNodeTransform {
     flags_ = flags;
   }
 
+  const TransformFlags& transformFlags() const {
+    return flags_;
+  }
+
  private:
   CompilerOptions compilerOptions_;
   const UDFManager& udfManager_;
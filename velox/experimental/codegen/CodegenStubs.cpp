@@ -40,6 +40,11 @@ __attribute__((weak)) std::shared_ptr<const core::PlanNode> Codegen::compile(
   throw CodegenStubsException("Codegen::compile()");
 }
 
+__attribute__((weak)) void Codegen::setAsyncCompilation(
+    [[maybe_unused]] bool asyncCompilation) {
+  throw CodegenStubsException("Codegen::setAsyncCompilation()");
+}
+
 bool Codegen::initializeCodeManager(
     [[maybe_unused]] const proto::CompilerOptionsProto& compilerOptionsProto) {
   throw CodegenStubsException("Codegen::initializeCodeManager()");
@@ -386,6 +386,18 @@ class CodegenBenchmark : public CodegenTestCore {
     auto compileTimeLambda =
         [ this, benchmarkIndex, numberIteration ]() -> auto {
       auto& info = benchmarkInfos[benchmarkIndex];
+      folly::BenchmarkSuspender suspender;
+      compiler_utils::CompiledObjectCache::instance().clear();
+      suspender.dismiss();
+      codegenTransformation_->transform(*info.refPlanNodes);
+      return numberIteration;
+    };
+
+    // Compiled time run when the compiled code is cached, e.g. for the tasks
+    // after the first running the same expressions.
+    auto cachedCompileTimeLambda =
+        [ this, benchmarkIndex, numberIteration ]() -> auto {
+      auto& info = benchmarkInfos[benchmarkIndex];
       codegenTransformation_->transform(*info.refPlanNodes);
       return numberIteration;
     };
@@ -394,7 +406,8 @@ class CodegenBenchmark : public CodegenTestCore {
         std::move(referenceLambda),
         std::move(compiledLambda),
         std::move(generatedFunctionLambda),
-        std::move(compileTimeLambda));
+        std::move(compileTimeLambda),
+        std::move(cachedCompileTimeLambda));
   }
 
   /// Register a set of benchmarks to be ran with runBenchmark later.
@@ -432,12 +445,20 @@ class CodegenBenchmark : public CodegenTestCore {
     auto compileTimeName = fmt::format(
         "%{}_{}x{}_compileTime", benchmarkName, numberBatches, rowPerBatch);
 
+    // the % is used to enable relative benchmarks.
+    auto cachedCompileTimeName = fmt::format(
+        "%{}_{}x{}_cachedCompileTime",
+        benchmarkName,
+        numberBatches,
+        rowPerBatch);
+
     for (const auto& flags : flagsVec) {
       auto
           [referenceLambda,
            compiledLambda,
            vectorFunctionLambda,
-           compileTimeLambda] =
+           compileTimeLambda,
+           cachedCompileTimeLambda] =
               createBenchmarkLambda(
                   benchmarkName,
                   filterExpr,
@@ -464,6 +485,8 @@ class CodegenBenchmark : public CodegenTestCore {
       folly::addBenchmark(__FILE__, compiledName, compiledLambda);
       folly::addBenchmark(__FILE__, vectorFunctionName, vectorFunctionLambda);
       folly::addBenchmark(__FILE__, compileTimeName, compileTimeLambda);
+      folly::addBenchmark(
+          __FILE__, cachedCompileTimeName, cachedCompileTimeLambda);
     }
   }
 
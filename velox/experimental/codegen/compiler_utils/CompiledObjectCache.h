@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "glog/logging.h"
+
+namespace facebook::velox::codegen::compiler_utils {
+
+/// Process wide cache of the dynamic libraries compiled from generated
+/// expression code, keyed by the generated source. The source holds the
+/// whole expression signature, i.e. the expressions, their input and output
+/// types and the null handling, so that the plans of all tasks running the
+/// same expressions share one compilation.
+///
+/// A library that is not cached yet is compiled either in the calling thread
+/// or, if 'async' is set, in the background, while the callers keep using the
+/// interpreted expressions until it is ready. A failed compilation is cached
+/// too, so that it is not retried for every task.
+class CompiledObjectCache {
+ public:
+  using CompileFunction = std::function<std::filesystem::path()>;
+
+  static CompiledObjectCache& instance() {
+    static CompiledObjectCache cache;
+    return cache;
+  }
+
+  /// Returns the library compiled from 'source' by 'compile'. Compiles it if
+  /// it is not cached. If 'async' is set, the compilation runs in the
+  /// background and std::nullopt is returned until it is done. Returns
+  /// std::nullopt if the compilation failed.
+  std::optional<std::filesystem::path>
+  get(const std::string& source, CompileFunction compile, bool async) {
+    std::shared_future<std::filesystem::path> library;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      auto it = libraries_.find(source);
+      if (it != libraries_.end()) {
+        library = it->second;
+        ++numHits_;
+      } else {
+        ++numMisses_;
+        library = std::async(
+                      async ? std::launch::async : std::launch::deferred,
+                      std::move(compile))
+                      .share();
+        libraries_.emplace(source, library);
+      }
+    }
+    // A deferred compilation runs in the first get() that waits for it.
+    if (async &&
+        library.wait_for(std::chrono::seconds(0)) ==
+            std::future_status::timeout) {
+      return std::nullopt;
+    }
+    try {
+      return library.get();
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Codegen: compilation failed, using interpreted "
+                   << "expressions: " << e.what();
+      return std::nullopt;
+    }
+  }
+
+  /// Waits for the background compilations to finish. Used by tests and
+  /// benchmarks.
+  void waitForCompilations() {
+    std::vector<std::shared_future<std::filesystem::path>> libraries;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      for (const auto& [source, library] : libraries_) {
+        libraries.push_back(library);
+      }
+    }
+    for (const auto& library : libraries) {
+      library.wait();
+    }
+  }
+
+  /// Drops all entries after waiting for the running compilations.
+  void clear() {
+    waitForCompilations();
+    std::lock_guard<std::mutex> l(mutex_);
+    libraries_.clear();
+  }
+
+  size_t size() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return libraries_.size();
+  }
+
+  uint64_t numHits() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return numHits_;
+  }
+
+  uint64_t numMisses() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return numMisses_;
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, std::shared_future<std::filesystem::path>>
+      libraries_;
+  uint64_t numHits_{0};
+  uint64_t numMisses_{0};
+};
+
+} // namespace facebook::velox::codegen::compiler_utils
@@ -20,6 +20,7 @@
 #include <iostream>
 #include <regex>
 #include "boost/filesystem.hpp"
+#include "velox/experimental/codegen/compiler_utils/CompiledObjectCache.h"
 #include "velox/experimental/codegen/compiler_utils/Compiler.h"
 #include "velox/experimental/codegen/compiler_utils/tests/definitions.h"
 #include "velox/experimental/codegen/external_process/Filesystem.h"
@@ -290,4 +291,53 @@ TEST(Compiler, CompileAndLink) {
   ASSERT_EQ(dlerror(), nullptr);
   ASSERT_EQ(f(), 24);
 };
+TEST(CompiledObjectCache, getAndCompile) {
+  CompiledObjectCache cache;
+  int numCompiles = 0;
+  auto compile = [&numCompiles](const std::string& library) {
+    return [&numCompiles, library]() {
+      ++numCompiles;
+      return std::filesystem::path(library);
+    };
+  };
+
+  // Synchronous compilation, compiled once per source.
+  ASSERT_EQ(cache.get("a", compile("liba.so"), false), "liba.so");
+  ASSERT_EQ(cache.get("a", compile("other.so"), false), "liba.so");
+  ASSERT_EQ(cache.get("b", compile("libb.so"), false), "libb.so");
+  ASSERT_EQ(numCompiles, 2);
+  ASSERT_EQ(cache.size(), 2);
+  ASSERT_EQ(cache.numHits(), 1);
+  ASSERT_EQ(cache.numMisses(), 2);
+
+  // Asynchronous compilation returns nothing until the library is ready.
+  std::promise<void> started;
+  std::promise<void> release;
+  auto blocked = [&started, &release]() {
+    started.set_value();
+    release.get_future().wait();
+    return std::filesystem::path("libc.so");
+  };
+  ASSERT_FALSE(cache.get("c", blocked, true).has_value());
+  started.get_future().wait();
+  ASSERT_FALSE(cache.get("c", compile("other.so"), true).has_value());
+  release.set_value();
+  cache.waitForCompilations();
+  ASSERT_EQ(cache.get("c", compile("other.so"), true), "libc.so");
+  ASSERT_EQ(numCompiles, 2);
+
+  // A failed compilation is cached and not retried.
+  auto failing = []() -> std::filesystem::path {
+    throw std::runtime_error("compilation failed");
+  };
+  ASSERT_FALSE(cache.get("d", failing, false).has_value());
+  ASSERT_FALSE(cache.get("d", compile("libd.so"), false).has_value());
+  ASSERT_EQ(numCompiles, 2);
+
+  cache.clear();
+  ASSERT_EQ(cache.size(), 0);
+  ASSERT_EQ(cache.get("a", compile("liba.so"), false), "liba.so");
+  ASSERT_EQ(numCompiles, 3);
+}
+
 } // namespace facebook::velox::codegen::compiler_utils::test
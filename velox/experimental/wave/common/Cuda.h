@@ -98,6 +98,10 @@ class Event {
   /// must enable timing.
   float elapsedTime(const Event& start) const;
 
+  bool isRecorded() const {
+    return recorded_;
+  }
+
  private:
   std::unique_ptr<EventImpl> event_;
   const bool hasTiming_;
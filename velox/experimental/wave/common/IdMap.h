@@ -37,10 +37,29 @@ class IdMap {
 
   __device__ int32_t makeId(T value);
 
+  /// Returns the id of 'value' or 0 if 'value' is not in 'this'. Must not run
+  /// concurrently with makeId().
+  __device__ int32_t id(T value) const;
+
   __device__ int cardinality() const {
     return lastId_;
   }
 
+  /// Calls 'func' with each value in 'this' and its id. Runs on host after the
+  /// kernels updating 'this' have completed. 'this' and its buffers must be
+  /// host accessible.
+  template <typename F>
+  void forEach(F func) const {
+    if (emptyId_ > 0) {
+      func(kEmptyMarker, emptyId_);
+    }
+    for (auto i = 0; i < capacity_; ++i) {
+      if (ids_[i] > 0) {
+        func(values_[i], ids_[i]);
+      }
+    }
+  }
+
  private:
   __device__ static T casValue(T* address, T compare, T val) {
     if constexpr (std::is_same_v<T, StringView>) {
@@ -131,4 +150,20 @@ __device__ int32_t IdMap<T, H>::makeId(T value) {
   }
 }
 
+template <typename T, typename H>
+__device__ int32_t IdMap<T, H>::id(T value) const {
+  if (value == kEmptyMarker) {
+    return emptyId_ > 0 ? emptyId_ : 0;
+  }
+  auto mask = capacity_ - 1;
+  for (auto i = H()(value) & mask;; i = (i + 1) & mask) {
+    if (values_[i] == value) {
+      return ids_[i];
+    }
+    if (values_[i] == kEmptyMarker) {
+      return 0;
+    }
+  }
+}
+
 } // namespace facebook::velox::wave
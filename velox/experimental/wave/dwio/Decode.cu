@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/common/CudaUtil.cuh"
+#include "velox/experimental/wave/common/Exception.h"
+#include "velox/experimental/wave/dwio/Decode.h"
+
+namespace facebook::velox::wave {
+
+namespace {
+constexpr int32_t kThreads = 256;
+
+int32_t numBlocks(int32_t numValues) {
+  return roundUp(numValues, kThreads) / kThreads;
+}
+
+// Returns the 'index'th 'bitWidth' bit value from 'packed'.
+__device__ inline uint32_t
+unpack(const uint8_t* packed, int32_t index, int32_t bitWidth) {
+  const uint64_t bitOffset = static_cast<uint64_t>(index) * bitWidth;
+  const auto* bytes = packed + (bitOffset >> 3);
+  const auto shift = bitOffset & 7;
+  uint64_t word = 0;
+  for (auto i = 0; i < (shift + bitWidth + 7) / 8; ++i) {
+    word |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+  }
+  return (word >> shift) & ((1ULL << bitWidth) - 1);
+}
+
+__global__ void decodeRunsKernel(
+    const DecodeRun* runs,
+    int32_t bitWidth,
+    int32_t* indices) {
+  const auto& run = runs[blockIdx.x];
+  auto* result = indices + run.begin;
+  for (auto i = threadIdx.x; i < run.numValues; i += blockDim.x) {
+    result[i] = run.packed ? unpack(run.packed, i, bitWidth) : run.value;
+  }
+}
+
+__global__ void dictionaryLookupKernel(
+    const int32_t* indices,
+    int32_t numValues,
+    const int64_t* dictionary,
+    int64_t* values) {
+  auto i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i < numValues) {
+    values[i] = dictionary[indices[i]];
+  }
+}
+
+__global__ void bigintRangeKernel(
+    const int64_t* values,
+    int32_t numValues,
+    int64_t lower,
+    int64_t upper,
+    uint8_t* flags) {
+  auto i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i < numValues) {
+    flags[i] = values[i] >= lower && values[i] <= upper;
+  }
+}
+
+int32_t readVarint(const uint8_t*& data, const uint8_t* end) {
+  uint32_t result = 0;
+  for (auto shift = 0; data < end; shift += 7) {
+    auto byte = *data++;
+    result |= static_cast<uint32_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      return result;
+    }
+  }
+  waveError("Truncated run header in RLE/bit-packed data");
+  return 0;
+}
+} // namespace
+
+std::vector<DecodeRun> parseHybridRuns(
+    const uint8_t* data,
+    int32_t size,
+    int32_t bitWidth,
+    int32_t numValues,
+    const uint8_t* deviceData) {
+  std::vector<DecodeRun> runs;
+  const auto* position = data;
+  const auto* end = data + size;
+  int32_t numDecoded = 0;
+  while (numDecoded < numValues) {
+    const auto header = readVarint(position, end);
+    DecodeRun run;
+    run.begin = numDecoded;
+    if (header & 1) {
+      // 'header >> 1' groups of 8 bit-packed values. The last group may be
+      // padded past 'numValues'.
+      const int32_t numGroups = header >> 1;
+      run.numValues = std::min(numGroups * 8, numValues - numDecoded);
+      run.packed = deviceData + (position - data);
+      run.value = 0;
+      position += numGroups * bitWidth;
+    } else {
+      run.numValues = std::min<int32_t>(header >> 1, numValues - numDecoded);
+      run.packed = nullptr;
+      run.value = 0;
+      for (auto i = 0; i < (bitWidth + 7) / 8; ++i) {
+        run.value |= static_cast<uint32_t>(position[i]) << (8 * i);
+      }
+      position += (bitWidth + 7) / 8;
+    }
+    if (position > end) {
+      waveError("Truncated run in RLE/bit-packed data");
+    }
+    numDecoded += run.numValues;
+    runs.push_back(run);
+  }
+  return runs;
+}
+
+void DecodeStream::decodeRuns(
+    const DecodeRun* runs,
+    int32_t numRuns,
+    int32_t bitWidth,
+    int32_t* indices) {
+  if (numRuns == 0) {
+    return;
+  }
+  decodeRunsKernel<<<numRuns, kThreads, 0, stream_->stream>>>(
+      runs, bitWidth, indices);
+  CUDA_CHECK(cudaGetLastError());
+}
+
+void DecodeStream::dictionaryLookup(
+    const int32_t* indices,
+    int32_t numValues,
+    const int64_t* dictionary,
+    int64_t* values) {
+  if (numValues == 0) {
+    return;
+  }
+  const auto blocks = numBlocks(numValues);
+  dictionaryLookupKernel<<<blocks, kThreads, 0, stream_->stream>>>(
+      indices, numValues, dictionary, values);
+  CUDA_CHECK(cudaGetLastError());
+}
+
+void DecodeStream::bigintRange(
+    const int64_t* values,
+    int32_t numValues,
+    int64_t lower,
+    int64_t upper,
+    uint8_t* flags) {
+  if (numValues == 0) {
+    return;
+  }
+  const auto blocks = numBlocks(numValues);
+  bigintRangeKernel<<<blocks, kThreads, 0, stream_->stream>>>(
+      values, numValues, lower, upper, flags);
+  CUDA_CHECK(cudaGetLastError());
+}
+
+} // namespace facebook::velox::wave
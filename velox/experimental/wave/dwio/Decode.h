@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "velox/experimental/wave/common/Cuda.h"
+
+/// Device side decoding of encoded column data for Wave table scans. The
+/// encoded data is copied to device as is and is expanded there, so that
+/// only the encoded bytes cross the bus.
+namespace facebook::velox::wave {
+
+/// A run of the RLE/bit-packed hybrid encoding of Parquet dictionary indices
+/// and levels.
+struct DecodeRun {
+  // Position of the first value of the run in the output.
+  int32_t begin;
+
+  int32_t numValues;
+
+  // Device side bit-packed values, least significant bit first. nullptr for a
+  // run of 'value'.
+  const uint8_t* packed;
+
+  // The value repeated 'numValues' times if 'packed' is nullptr.
+  uint32_t value;
+};
+
+/// Parses the run headers of the first 'numValues' values of 'size' bytes of
+/// RLE/bit-packed hybrid 'data' of 'bitWidth' bit values. The headers are
+/// parsed on host. The 'packed' of the runs point to the corresponding
+/// positions of 'deviceData', which is a device side copy of 'data'.
+std::vector<DecodeRun> parseHybridRuns(
+    const uint8_t* data,
+    int32_t size,
+    int32_t bitWidth,
+    int32_t numValues,
+    const uint8_t* deviceData);
+
+class DecodeStream : public Stream {
+ public:
+  /// Expands the 'numRuns' 'runs' of 'bitWidth' bit values into 'indices'.
+  /// Each run is expanded by one thread block. 'runs' must be device
+  /// accessible.
+  void decodeRuns(
+      const DecodeRun* runs,
+      int32_t numRuns,
+      int32_t bitWidth,
+      int32_t* indices);
+
+  /// Sets 'values[i]' to 'dictionary[indices[i]]' for the first 'numValues'
+  /// values.
+  void dictionaryLookup(
+      const int32_t* indices,
+      int32_t numValues,
+      const int64_t* dictionary,
+      int64_t* values);
+
+  /// Sets 'flags[i]' to 1 if 'lower' <= 'values[i]' <= 'upper' and to 0
+  /// otherwise. The device side counterpart of common::BigintRange without
+  /// nulls.
+  void bigintRange(
+      const int64_t* values,
+      int32_t numValues,
+      int64_t lower,
+      int64_t upper,
+      uint8_t* flags);
+};
+
+} // namespace facebook::velox::wave
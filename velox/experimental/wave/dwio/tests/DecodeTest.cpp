@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "velox/experimental/wave/common/GpuArena.h"
+#include "velox/experimental/wave/dwio/Decode.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::wave;
+
+class DecodeTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    device_ = getDevice();
+    setDevice(device_);
+    allocator_ = getAllocator(device_);
+    arena_ = std::make_unique<GpuArena>(1 << 28, allocator_);
+  }
+
+  static void appendVarint(uint32_t value, std::vector<uint8_t>& data) {
+    while (value >= 0x80) {
+      data.push_back((value & 0x7f) | 0x80);
+      value >>= 7;
+    }
+    data.push_back(value);
+  }
+
+  // Appends a run of 'count' times 'value' to hybrid encoded 'data'.
+  static void appendRle(
+      uint32_t value,
+      int32_t count,
+      int32_t bitWidth,
+      std::vector<uint8_t>& data) {
+    appendVarint(count << 1, data);
+    for (auto i = 0; i < (bitWidth + 7) / 8; ++i) {
+      data.push_back(value >> (8 * i));
+    }
+  }
+
+  // Appends bit-packed 'values' to hybrid encoded 'data', padded to a
+  // multiple of 8 values.
+  static void appendBitPacked(
+      const std::vector<uint32_t>& values,
+      int32_t bitWidth,
+      std::vector<uint8_t>& data) {
+    const int32_t numGroups = (values.size() + 7) / 8;
+    appendVarint((numGroups << 1) | 1, data);
+    std::vector<uint8_t> packed(numGroups * bitWidth);
+    for (auto i = 0; i < values.size(); ++i) {
+      for (auto bit = 0; bit < bitWidth; ++bit) {
+        if (values[i] & (1U << bit)) {
+          const auto offset = i * bitWidth + bit;
+          packed[offset / 8] |= 1 << (offset % 8);
+        }
+      }
+    }
+    data.insert(data.end(), packed.begin(), packed.end());
+  }
+
+  Device* device_;
+  GpuAllocator* allocator_;
+  std::unique_ptr<GpuArena> arena_;
+};
+
+TEST_F(DecodeTest, dictionary) {
+  constexpr int32_t kBitWidth = 5;
+  std::vector<uint8_t> data;
+  std::vector<int32_t> expected;
+  appendRle(3, 1'000, kBitWidth, data);
+  expected.insert(expected.end(), 1'000, 3);
+  std::vector<uint32_t> packed;
+  for (auto i = 0; i < 301; ++i) {
+    packed.push_back((i * 7) % 32);
+    expected.push_back(packed.back());
+  }
+  appendBitPacked(packed, kBitWidth, data);
+  appendRle(31, 20, kBitWidth, data);
+  expected.insert(expected.end(), 20, 31);
+  // The padding of the bit-packed run is not part of the values.
+  const int32_t numValues = expected.size();
+
+  auto deviceData = arena_->allocate<uint8_t>(data.size());
+  memcpy(deviceData->as<uint8_t>(), data.data(), data.size());
+  auto runs = parseHybridRuns(
+      data.data(),
+      data.size(),
+      kBitWidth,
+      numValues,
+      deviceData->as<uint8_t>());
+  ASSERT_EQ(3, runs.size());
+  ASSERT_EQ(301, runs[1].numValues);
+  auto deviceRuns = arena_->allocate<DecodeRun>(runs.size());
+  memcpy(
+      deviceRuns->as<DecodeRun>(),
+      runs.data(),
+      runs.size() * sizeof(DecodeRun));
+
+  auto indices = arena_->allocate<int32_t>(numValues);
+  auto dictionary = arena_->allocate<int64_t>(32);
+  for (auto i = 0; i < 32; ++i) {
+    dictionary->as<int64_t>()[i] = i * 1'000'000'000L;
+  }
+  auto values = arena_->allocate<int64_t>(numValues);
+  auto flags = arena_->allocate<uint8_t>(numValues);
+
+  DecodeStream stream;
+  stream.decodeRuns(
+      deviceRuns->as<DecodeRun>(),
+      runs.size(),
+      kBitWidth,
+      indices->as<int32_t>());
+  stream.dictionaryLookup(
+      indices->as<int32_t>(),
+      numValues,
+      dictionary->as<int64_t>(),
+      values->as<int64_t>());
+  stream.bigintRange(
+      values->as<int64_t>(),
+      numValues,
+      5'000'000'000L,
+      20'000'000'000L,
+      flags->as<uint8_t>());
+  stream.wait();
+
+  for (auto i = 0; i < numValues; ++i) {
+    ASSERT_EQ(expected[i], indices->as<int32_t>()[i]) << i;
+    const int64_t value = expected[i] * 1'000'000'000L;
+    ASSERT_EQ(value, values->as<int64_t>()[i]) << i;
+    ASSERT_EQ(
+        value >= 5'000'000'000L && value <= 20'000'000'000L,
+        flags->as<uint8_t>()[i])
+        << i;
+  }
+}
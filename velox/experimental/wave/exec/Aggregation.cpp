@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/exec/Aggregation.h"
+#include "velox/exec/Aggregate.h"
+#include "velox/experimental/wave/exec/ToWave.h"
+#include "velox/experimental/wave/exec/Vectors.h"
+#include "velox/experimental/wave/exec/WaveDriver.h"
+
+DEFINE_int32(
+    velox_wave_aggregation_capacity,
+    1 << 20,
+    "Slots in the group id table of a Wave aggregation. A power of 2");
+
+namespace facebook::velox::wave {
+
+namespace {
+bool isBigint(const Type& type) {
+  return type.kind() == TypeKind::BIGINT && !type.isShortDecimal();
+}
+
+std::optional<AggregateOp> aggregateOp(
+    core::AggregationNode::Step step,
+    const std::string& name) {
+  if (name == "count") {
+    return exec::isRawInput(step) ? AggregateOp::kCount : AggregateOp::kSum;
+  }
+  if (name == "sum") {
+    return AggregateOp::kSum;
+  }
+  if (name == "min") {
+    return AggregateOp::kMin;
+  }
+  if (name == "max") {
+    return AggregateOp::kMax;
+  }
+  return std::nullopt;
+}
+
+int64_t initialValue(AggregateOp op) {
+  switch (op) {
+    case AggregateOp::kMin:
+      return std::numeric_limits<int64_t>::max();
+    case AggregateOp::kMax:
+      return std::numeric_limits<int64_t>::min();
+    default:
+      return 0;
+  }
+}
+
+// Group numbers 1 to capacity + 1 for the ids of non-null keys and 0 for null
+// keys.
+int32_t numGroupSlots() {
+  return FLAGS_velox_wave_aggregation_capacity + 2;
+}
+} // namespace
+
+Aggregation::Aggregation(
+    CompileState& state,
+    const core::AggregationNode& node)
+    : WaveOperator(state, node.outputType()),
+      ignoreNullKeys_(node.ignoreNullKeys()) {
+  const auto& inputType = node.sources()[0]->outputType();
+  if (!node.groupingKeys().empty()) {
+    keyChannel_ = inputType->getChildIdx(node.groupingKeys()[0]->name());
+  }
+  for (const auto& aggregate : node.aggregates()) {
+    ops_.push_back(aggregateOp(node.step(), aggregate.call->name()).value());
+    isCount_.push_back(aggregate.call->name() == "count");
+    const auto& inputs = aggregate.call->inputs();
+    if (inputs.empty()) {
+      inputChannels_.push_back(std::nullopt);
+    } else {
+      auto field =
+          std::dynamic_pointer_cast<const core::FieldAccessTypedExpr>(
+              inputs[0]);
+      inputChannels_.push_back(inputType->getChildIdx(field->name()));
+    }
+  }
+}
+
+// static
+bool Aggregation::isSupported(const core::AggregationNode& node) {
+  if (node.groupingKeys().size() > 1 || !node.preGroupedKeys().empty()) {
+    return false;
+  }
+  for (const auto& key : node.groupingKeys()) {
+    if (!isBigint(*key->type())) {
+      return false;
+    }
+  }
+  for (const auto& aggregate : node.aggregates()) {
+    if (aggregate.mask || aggregate.distinct ||
+        !aggregate.sortingKeys.empty()) {
+      return false;
+    }
+    const auto& call = aggregate.call;
+    if (!aggregateOp(node.step(), call->name()).has_value() ||
+        !isBigint(*call->type())) {
+      return false;
+    }
+    const auto& inputs = call->inputs();
+    if (inputs.empty()) {
+      // count(*).
+      if (call->name() != "count") {
+        return false;
+      }
+      continue;
+    }
+    if (inputs.size() > 1 ||
+        !std::dynamic_pointer_cast<const core::FieldAccessTypedExpr>(
+            inputs[0]) ||
+        !isBigint(*inputs[0]->type())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void Aggregation::initGroups() {
+  const int32_t capacity = FLAGS_velox_wave_aggregation_capacity;
+  VELOX_CHECK(
+      bits::isPowerOfTwo(capacity),
+      "Wave aggregation capacity must be a power of 2: {}",
+      capacity);
+  const int64_t numAggregates = ops_.size();
+  const int64_t numSlots = numGroupSlots();
+  const auto opsOffset = bits::roundUp(int64IdMapBytes(capacity), 8);
+  const auto accumulatorsOffset =
+      bits::roundUp(opsOffset + numAggregates * sizeof(AggregateOp), 8);
+  const auto nonNullOffset =
+      accumulatorsOffset + numAggregates * sizeof(int64_t*);
+  const auto accumulatorDataOffset =
+      nonNullOffset + numAggregates * sizeof(uint8_t*);
+  const auto nonNullDataOffset =
+      accumulatorDataOffset + numAggregates * numSlots * sizeof(int64_t);
+  const auto nullKeySeenOffset =
+      nonNullDataOffset + numAggregates * numSlots * sizeof(uint8_t);
+  groups_ = driver_->arena().allocateBytes(nullKeySeenOffset + 1);
+
+  auto* data = groups_->as<char>();
+  idMap_ = initInt64IdMap(data, capacity);
+  deviceOps_ = reinterpret_cast<AggregateOp*>(data + opsOffset);
+  accumulators_ = reinterpret_cast<int64_t**>(data + accumulatorsOffset);
+  nonNull_ = reinterpret_cast<uint8_t**>(data + nonNullOffset);
+  auto* accumulatorData =
+      reinterpret_cast<int64_t*>(data + accumulatorDataOffset);
+  auto* nonNullData = reinterpret_cast<uint8_t*>(data + nonNullDataOffset);
+  for (auto i = 0; i < numAggregates; ++i) {
+    deviceOps_[i] = ops_[i];
+    accumulators_[i] = accumulatorData + i * numSlots;
+    std::fill(
+        accumulators_[i], accumulators_[i] + numSlots, initialValue(ops_[i]));
+    nonNull_[i] = nonNullData + i * numSlots;
+  }
+  memset(nonNullData, 0, numAggregates * numSlots + 1);
+  nullKeySeen_ = reinterpret_cast<uint8_t*>(data + nullKeySeenOffset);
+}
+
+void Aggregation::enqueue(WaveVectorPtr input) {
+  if (!groups_) {
+    initGroups();
+  }
+  if (!stream_) {
+    stream_ = std::make_unique<WaveKernelStream>();
+  }
+  auto& arena = driver_->arena();
+  const auto numColumns = input->type()->size();
+  const auto numRows = numColumns ? input->childAt(0).size() : input->size();
+
+  // The operands of the input columns and the input operand of each
+  // aggregate.
+  auto memory = arena.allocateBytes(
+      numColumns * sizeof(Operand) + ops_.size() * sizeof(Operand*));
+  auto* columns = memory->as<Operand>();
+  for (auto i = 0; i < numColumns; ++i) {
+    input->childAt(i).toOperand(&columns[i]);
+  }
+  auto* inputs = reinterpret_cast<Operand**>(columns + numColumns);
+  for (auto i = 0; i < ops_.size(); ++i) {
+    inputs[i] = inputChannels_[i].has_value()
+        ? &columns[inputChannels_[i].value()]
+        : nullptr;
+  }
+
+  Instruction instruction;
+  instruction.opCode = OpCode::kAggregate;
+  auto& aggregate = instruction._.aggregate;
+  aggregate.key =
+      keyChannel_.has_value() ? &columns[keyChannel_.value()] : nullptr;
+  aggregate.groups = idMap_;
+  aggregate.numAggregates = ops_.size();
+  aggregate.ops = deviceOps_;
+  aggregate.inputs = inputs;
+  aggregate.accumulators = accumulators_;
+  aggregate.nonNull = nonNull_;
+  aggregate.nullKeySeen = nullKeySeen_;
+
+  WaveBufferPtr program;
+  pendingStatus_.push_back(
+      launchInstruction(*stream_, instruction, numRows, arena, program));
+  pendingMemory_.push_back(std::move(memory));
+  pendingMemory_.push_back(std::move(program));
+  pendingInputs_.push_back(std::move(input));
+}
+
+void Aggregation::flush() {
+  if (!stream_) {
+    return;
+  }
+  stream_->wait();
+  for (auto& status : pendingStatus_) {
+    checkBlockStatus(status);
+  }
+  pendingStatus_.clear();
+  pendingMemory_.clear();
+  pendingInputs_.clear();
+}
+
+void Aggregation::noMoreInput() {
+  flush();
+  if (!groups_) {
+    initGroups();
+  }
+  noMoreInput_ = true;
+  if (!keyChannel_.has_value()) {
+    numOutputRows_ = 1;
+    return;
+  }
+  numOutputRows_ = 0;
+  forEachInt64Id(idMap_, [&](int64_t /*key*/, int32_t /*id*/) {
+    ++numOutputRows_;
+  });
+  if (*nullKeySeen_ && !ignoreNullKeys_) {
+    ++numOutputRows_;
+  }
+}
+
+int32_t Aggregation::canAdvance() {
+  if (!noMoreInput_ || finished_) {
+    return 0;
+  }
+  return numOutputRows_;
+}
+
+std::vector<VectorPtr> Aggregation::makeGroups(memory::MemoryPool* pool) {
+  // The group number of each output row.
+  std::vector<int32_t> groups;
+  groups.reserve(numOutputRows_);
+  std::vector<VectorPtr> result;
+  if (keyChannel_.has_value()) {
+    auto keys = BaseVector::create<FlatVector<int64_t>>(
+        outputType_->childAt(0), numOutputRows_, pool);
+    forEachInt64Id(idMap_, [&](int64_t key, int32_t id) {
+      keys->set(groups.size(), key);
+      groups.push_back(id);
+    });
+    if (groups.size() < numOutputRows_) {
+      keys->setNull(groups.size(), true);
+      groups.push_back(0);
+    }
+    result.push_back(std::move(keys));
+  } else {
+    groups.push_back(0);
+  }
+  for (auto i = 0; i < ops_.size(); ++i) {
+    auto values = BaseVector::create<FlatVector<int64_t>>(
+        outputType_->childAt(result.size()), numOutputRows_, pool);
+    for (auto row = 0; row < groups.size(); ++row) {
+      // count is 0 for a group without input, the others are null.
+      if (!isCount_[i] && !nonNull_[i][groups[row]]) {
+        values->setNull(row, true);
+      } else {
+        values->set(row, accumulators_[i][groups[row]]);
+      }
+    }
+    result.push_back(std::move(values));
+  }
+  return result;
+}
+
+void Aggregation::schedule(WaveStream& stream, int32_t /*maxRows*/) {
+  // The groups are read on host from unified memory after all input has
+  // arrived and are transferred like the batches of a Values.
+  auto groups = makeGroups(driver_->pool());
+  std::vector<const BaseVector*> sources;
+  for (auto& vector : groups) {
+    sources.push_back(vector.get());
+  }
+  vectorsToDevice(
+      folly::Range(sources.data(), sources.size()), outputIds_, stream);
+  finished_ = true;
+}
+
+std::string Aggregation::toString() const {
+  return keyChannel_.has_value() ? "Aggregation" : "GlobalAggregation";
+}
+
+} // namespace facebook::velox::wave
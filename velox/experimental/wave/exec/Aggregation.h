@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/core/PlanNode.h"
+#include "velox/experimental/wave/exec/WaveOperator.h"
+
+namespace facebook::velox::wave {
+
+/// Hash aggregation on device. The input batches update a device side hash
+/// table of group ids and an array of accumulators per aggregate. The groups
+/// are produced after the last input batch.
+class Aggregation : public WaveOperator {
+ public:
+  Aggregation(CompileState& state, const core::AggregationNode& node);
+
+  /// True if 'node' has at most one BIGINT grouping key and only count, sum,
+  /// min and max over BIGINT columns, without masks, sorting or distinct.
+  static bool isSupported(const core::AggregationNode& node);
+
+  bool isStreaming() const override {
+    return false;
+  }
+
+  void enqueue(WaveVectorPtr input) override;
+
+  void flush() override;
+
+  void noMoreInput() override;
+
+  int32_t canAdvance() override;
+
+  void schedule(WaveStream& stream, int32_t maxRows = 0) override;
+
+  vector_size_t outputSize() const override {
+    return numOutputRows_;
+  }
+
+  std::string toString() const override;
+
+ private:
+  // Allocates and initializes the group ids and accumulators.
+  void initGroups();
+
+  // Makes host side vectors of the keys and accumulators of the groups.
+  std::vector<VectorPtr> makeGroups(memory::MemoryPool* pool);
+
+  // Channel of the grouping key in the input. std::nullopt for a global
+  // aggregation.
+  std::optional<column_index_t> keyChannel_;
+
+  const bool ignoreNullKeys_;
+
+  std::vector<AggregateOp> ops_;
+
+  // True for the aggregates that are count. These produce 0 instead of null
+  // for groups without input.
+  std::vector<bool> isCount_;
+
+  // Input channel of each aggregate. std::nullopt for count(*).
+  std::vector<std::optional<column_index_t>> inputChannels_;
+
+  // The group ids and accumulators in unified memory. Allocated on first
+  // input.
+  WaveBufferPtr groups_;
+  Int64IdMap* idMap_{nullptr};
+  // Device side arrays for IAggregate, one element per aggregate.
+  AggregateOp* deviceOps_{nullptr};
+  Operand** deviceInputs_{nullptr};
+  int64_t** accumulators_{nullptr};
+  uint8_t** nonNull_{nullptr};
+  uint8_t* nullKeySeen_{nullptr};
+
+  std::unique_ptr<WaveKernelStream> stream_;
+
+  // Inputs, operands and programs of the kernels pending on 'stream_'.
+  std::vector<WaveVectorPtr> pendingInputs_;
+  std::vector<WaveBufferPtr> pendingMemory_;
+  std::vector<folly::Range<BlockStatus*>> pendingStatus_;
+
+  bool noMoreInput_{false};
+  bool finished_{false};
+  vector_size_t numOutputRows_{0};
+};
+
+} // namespace facebook::velox::wave
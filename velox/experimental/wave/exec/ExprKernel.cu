@@ -18,6 +18,7 @@
 
 #include "velox/experimental/wave/common/Block.cuh"
 #include "velox/experimental/wave/common/CudaUtil.cuh"
+#include "velox/experimental/wave/common/IdMap.h"
 #include "velox/experimental/wave/exec/WaveCore.cuh"
 
 namespace facebook::velox::wave {
@@ -69,6 +70,96 @@ __device__ void filterKernel(
 
 __device__ void wrapKernel(IWrap& wrap, int32_t blockBase, int32_t& numRows) {}
 
+__device__ void aggregateKernel(
+    const IAggregate& aggregate,
+    int32_t blockBase,
+    char* shared,
+    BlockStatus* status) {
+  if (threadIdx.x >= status->numRows) {
+    return;
+  }
+  int32_t group = 0;
+  if (aggregate.key && !isNotNull(aggregate.key, blockBase)) {
+    *aggregate.nullKeySeen = 1;
+  } else if (aggregate.key) {
+    auto key = value<int64_t>(aggregate.key, blockBase, shared);
+    group = aggregate.groups->makeId(key);
+    if (group < 0) {
+      status->errors[threadIdx.x] = ErrorCode::kInsuffcientMemory;
+      return;
+    }
+  }
+  for (auto i = 0; i < aggregate.numAggregates; ++i) {
+    auto* input = aggregate.inputs[i];
+    if (input && !isNotNull(input, blockBase)) {
+      continue;
+    }
+    auto* accumulator = aggregate.accumulators[i] + group;
+    if (aggregate.ops[i] == AggregateOp::kCount) {
+      atomicAdd(reinterpret_cast<unsigned long long*>(accumulator), 1ULL);
+      continue;
+    }
+    auto data = value<int64_t>(input, blockBase, shared);
+    switch (aggregate.ops[i]) {
+      case AggregateOp::kSum:
+        atomicAdd(
+            reinterpret_cast<unsigned long long*>(accumulator),
+            static_cast<unsigned long long>(data));
+        break;
+      case AggregateOp::kMin:
+        atomicMin(
+            reinterpret_cast<long long*>(accumulator),
+            static_cast<long long>(data));
+        break;
+      case AggregateOp::kMax:
+        atomicMax(
+            reinterpret_cast<long long*>(accumulator),
+            static_cast<long long>(data));
+        break;
+      default:
+        break;
+    }
+    aggregate.nonNull[i][group] = 1;
+  }
+}
+
+__device__ void hashBuildKernel(
+    const IHashBuild& build,
+    int32_t blockBase,
+    char* shared,
+    BlockStatus* status) {
+  if (threadIdx.x >= status->numRows || !isNotNull(build.key, blockBase)) {
+    return;
+  }
+  auto id = build.table->makeId(value<int64_t>(build.key, blockBase, shared));
+  if (id < 0) {
+    status->errors[threadIdx.x] = ErrorCode::kInsuffcientMemory;
+    return;
+  }
+  if (atomicCAS(&build.rows[id], -1, blockBase + threadIdx.x) != -1) {
+    status->errors[threadIdx.x] = ErrorCode::kDuplicateKey;
+  }
+}
+
+__device__ void hashProbeKernel(
+    const IHashProbe& probe,
+    int32_t blockBase,
+    char* shared,
+    BlockStatus* status) {
+  if (threadIdx.x >= status->numRows) {
+    return;
+  }
+  int32_t match = -1;
+  if (isNotNull(probe.key, blockBase)) {
+    auto id = probe.table->id(value<int64_t>(probe.key, blockBase, shared));
+    if (id > 0) {
+      match = probe.buildRows[id];
+    }
+  }
+  flatResult<uint8_t>(probe.flags, blockBase) = match >= 0;
+  probe.matches[blockBase + threadIdx.x] = match;
+}
+
 #define OP_MIX(op, t) \
   static_cast<OpCode>(static_cast<int32_t>(t) + 8 * static_cast<int32_t>(op))
 
@@ -103,6 +194,18 @@ __global__ void waveBaseKernel(
         wrapKernel(instruction->_.wrap, blockBase, status->numRows);
         break;
 
+      case OpCode::kAggregate:
+        aggregateKernel(instruction->_.aggregate, blockBase, shared, status);
+        break;
+
+      case OpCode::kHashBuild:
+        hashBuildKernel(instruction->_.hashBuild, blockBase, shared, status);
+        break;
+
+      case OpCode::kHashProbe:
+        hashProbeKernel(instruction->_.hashProbe, blockBase, shared, status);
+        break;
+
         BINARY_TYPES(OpCode::kPlus, +);
     }
   }
@@ -123,4 +226,31 @@ void WaveKernelStream::call(
       programs, baseIndices, status);
 }
 
+namespace {
+int64_t idMapValuesOffset() {
+  return (sizeof(Int64IdMap) + sizeof(int64_t) - 1) & ~(sizeof(int64_t) - 1);
+}
+} // namespace
+
+int64_t int64IdMapBytes(int32_t capacity) {
+  return idMapValuesOffset() + capacity * (sizeof(int64_t) + sizeof(int32_t));
+}
+
+Int64IdMap* initInt64IdMap(void* memory, int32_t capacity) {
+  auto* map = reinterpret_cast<Int64IdMap*>(memory);
+  auto* values = reinterpret_cast<int64_t*>(
+      reinterpret_cast<char*>(memory) + idMapValuesOffset());
+  auto* ids = reinterpret_cast<int32_t*>(values + capacity);
+  // The empty marker of a BIGINT key is 0.
+  memset(values, 0, capacity * (sizeof(int64_t) + sizeof(int32_t)));
+  map->init(capacity, values, ids);
+  return map;
+}
+
+void forEachInt64Id(
+    const Int64IdMap* map,
+    const std::function<void(int64_t key, int32_t id)>& func) {
+  map->forEach(func);
+}
+
 } // namespace facebook::velox::wave
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <cstdint>
+#include <functional>
 #include "velox/experimental/wave/common/Cuda.h"
 #include "velox/experimental/wave/vector/Operand.h"
 
@@ -28,6 +29,16 @@
 /// be allocated dynamically at kernel invocation.
 namespace facebook::velox::wave {
 
+template <typename Input, typename Output>
+struct Hasher;
+
+template <typename T, typename H>
+class IdMap;
+
+/// Device side hash table from a BIGINT key to an id. Defined in IdMap.h,
+/// which is for device side files only.
+using Int64IdMap = IdMap<int64_t, Hasher<int64_t, uint32_t>>;
+
 /// Mixed with opcode to switch between instantiations of instructions for
 /// different types.
 enum class ScalarType {
@@ -46,6 +57,9 @@ enum class OpCode {
   // First all OpCodes that have no operand type specialization.
   kFilter = 0,
   kWrap,
+  kAggregate,
+  kHashBuild,
+  kHashProbe,
 
   // From here, only OpCodes that have variants for scalar types.
   kPlus,
@@ -107,12 +121,76 @@ struct IWrap {
   int32_t mayShareIndices;
 };
 
+/// Accumulator update of an aggregate in IAggregate. A final count is a sum
+/// of partial counts.
+enum class AggregateOp : int32_t {
+  kCount,
+  kSum,
+  kMin,
+  kMax,
+};
+
+struct IAggregate {
+  // The BIGINT grouping key. nullptr for a global aggregation.
+  Operand* key;
+
+  // Maps non-null values of 'key' to group numbers starting at 1. Group 0 is
+  // the group of null keys and the only group of a global aggregation.
+  Int64IdMap* groups;
+
+  // Number of items in 'ops', 'inputs', 'accumulators' and 'nonNull'.
+  int32_t numAggregates;
+
+  AggregateOp* ops;
+
+  // The BIGINT input of each aggregate. nullptr for count(*).
+  Operand** inputs;
+
+  // The accumulator of each aggregate for each group number.
+  int64_t** accumulators;
+
+  // Set to 1 for the groups of an aggregate that have non-null input.
+  uint8_t** nonNull;
+
+  // Set to 1 if a row has a null 'key'.
+  uint8_t* nullKeySeen;
+};
+
+struct IHashBuild {
+  // The BIGINT build side key. Rows with null keys are not added.
+  Operand* key;
+
+  Int64IdMap* table;
+
+  // The build side row number for each id in 'table'. Must be initialized to
+  // -1. Duplicate keys set an error.
+  int32_t* rows;
+};
+
+struct IHashProbe {
+  // The BIGINT probe side key.
+  Operand* key;
+
+  // Table and row numbers filled in by IHashBuild.
+  Int64IdMap* table;
+  int32_t* buildRows;
+
+  // Set to 1 for rows with a match. Can be the flags of a following IFilter.
+  Operand* flags;
+
+  // The matching build side row number for each row, -1 if no match.
+  int32_t* matches;
+};
+
 struct Instruction {
   OpCode opCode;
   union {
     IBinary binary;
     IFilter filter;
     IWrap wrap;
+    IAggregate aggregate;
+    IHashBuild hashBuild;
+    IHashProbe hashProbe;
   } _;
 };
 
@@ -125,6 +203,9 @@ enum class ErrorCode : int32_t {
   kError,
 
   kInsuffcientMemory,
+
+  // A unique key was seen twice, e.g. a duplicate key in IHashBuild.
+  kDuplicateKey,
 };
 
 /// Contains a count of active lanes and a per lane error code.
@@ -158,4 +239,19 @@ class WaveKernelStream : public Stream {
       int32_t sharedSize);
 };
 
+/// Returns the bytes for an Int64IdMap with 'capacity' slots, including its
+/// values and ids.
+int64_t int64IdMapBytes(int32_t capacity);
+
+/// Initializes an empty Int64IdMap of 'capacity' slots at 'memory', which has
+/// int64IdMapBytes(capacity) bytes of unified memory. 'capacity' must be a
+/// power of two.
+Int64IdMap* initInt64IdMap(void* memory, int32_t capacity);
+
+/// Calls 'func' with each key in 'map' and its id. Call only after the kernels
+/// updating 'map' have completed.
+void forEachInt64Id(
+    const Int64IdMap* map,
+    const std::function<void(int64_t key, int32_t id)>& func);
+
 } // namespace facebook::velox::wave
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/exec/HashProbe.h"
+#include "velox/exec/Task.h"
+#include "velox/experimental/wave/exec/ToWave.h"
+#include "velox/experimental/wave/exec/Vectors.h"
+#include "velox/experimental/wave/exec/WaveDriver.h"
+
+namespace facebook::velox::wave {
+
+namespace {
+bool isBigint(const Type& type) {
+  return type.kind() == TypeKind::BIGINT && !type.isShortDecimal();
+}
+
+// The column of the build side key in the RowContainer of the hash table.
+// The other build side columns follow in the order of the build side type.
+constexpr column_index_t kKeyColumn = 0;
+} // namespace
+
+HashProbe::HashProbe(CompileState& state, const core::HashJoinNode& node)
+    : WaveOperator(state, node.outputType()),
+      joinBridge_(state.driver().driverCtx()->task->getHashJoinBridgeLocked(
+          state.driver().driverCtx()->splitGroupId,
+          node.id())) {
+  VELOX_CHECK_NOT_NULL(joinBridge_);
+  isFilter_ = true;
+
+  const auto& buildType = node.sources()[1]->outputType();
+  const auto& buildKey = node.rightKeys()[0]->name();
+  column_index_t tableColumn = kKeyColumn + 1;
+  for (auto i = 0; i < buildType->size(); ++i) {
+    const auto& name = buildType->nameOf(i);
+    const auto column = name == buildKey ? kKeyColumn : tableColumn++;
+    auto outputChannel = outputType_->getChildIdxIfExists(name);
+    if (outputChannel.has_value()) {
+      buildProjections_.emplace_back(column, outputChannel.value());
+    }
+  }
+
+  auto program = std::make_shared<Program>();
+  auto* key = state.findCurrentValue(
+      Value(state.toSubfield(node.leftKeys()[0]->name())));
+  program->add(std::make_unique<AbstractHashProbe>(
+      key, state.newOperand(BOOLEAN(), "matches")));
+  programs_.push_back(std::move(program));
+}
+
+// static
+bool HashProbe::isSupported(const core::HashJoinNode& node) {
+  if (!node.isInnerJoin() || node.filter() || node.leftKeys().size() != 1 ||
+      !isBigint(*node.leftKeys()[0]->type()) ||
+      !isBigint(*node.rightKeys()[0]->type())) {
+    return false;
+  }
+  for (const auto& type : node.outputType()->children()) {
+    if (!type->isFixedWidth()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+exec::BlockingReason HashProbe::isBlocked(ContinueFuture* future) {
+  if (table_) {
+    return exec::BlockingReason::kNotBlocked;
+  }
+  auto buildResult = joinBridge_->tableOrFuture(future);
+  if (!buildResult.has_value()) {
+    VELOX_CHECK(future->valid());
+    return exec::BlockingReason::kWaitForJoinBuild;
+  }
+  VELOX_CHECK(
+      buildResult->spillPartitionIds.empty(),
+      "Wave HashProbe does not support spilled build sides");
+  VELOX_CHECK(
+      !buildResult->table->hasDuplicateKeys(),
+      "Wave HashProbe requires unique build side keys");
+  buildTable(*buildResult->table);
+  return exec::BlockingReason::kNotBlocked;
+}
+
+void HashProbe::buildTable(exec::BaseHashTable& table) {
+  constexpr int32_t kBatch = 1024;
+  std::vector<char*> rows;
+  exec::BaseHashTable::RowsIterator iter;
+  for (;;) {
+    const auto numRows = rows.size();
+    rows.resize(numRows + kBatch);
+    const auto numListed = table.listAllRows(
+        &iter,
+        kBatch,
+        std::numeric_limits<uint64_t>::max(),
+        rows.data() + numRows);
+    rows.resize(numRows + numListed);
+    if (numListed == 0) {
+      break;
+    }
+  }
+
+  auto* pool = driver_->pool();
+  auto& arena = driver_->arena();
+  auto* container = table.rows();
+  const int32_t numRows = rows.size();
+  auto keys = BaseVector::create(BIGINT(), numRows, pool);
+  container->extractColumn(rows.data(), numRows, kKeyColumn, keys);
+  auto deviceKeys = vectorToDevice(keys.get(), arena);
+  for (const auto& [column, outputChannel] : buildProjections_) {
+    auto values =
+        BaseVector::create(outputType_->childAt(outputChannel), numRows, pool);
+    container->extractColumn(rows.data(), numRows, column, values);
+    buildColumns_.push_back(vectorToDevice(values.get(), arena));
+  }
+
+  // Keys fill at most half of the slots. The row numbers are indexed by id,
+  // which goes from 1 to capacity.
+  const int32_t capacity = std::max<int32_t>(
+      kBlockSize, bits::nextPowerOfTwo(2 * static_cast<int64_t>(numRows)));
+  const auto rowsOffset = bits::roundUp(int64IdMapBytes(capacity), 8);
+  const auto keyOffset =
+      bits::roundUp(rowsOffset + (capacity + 1) * sizeof(int32_t), 8);
+  table_ = arena.allocateBytes(keyOffset + sizeof(Operand));
+  auto* data = table_->as<char>();
+  idMap_ = initInt64IdMap(data, capacity);
+  buildRows_ = reinterpret_cast<int32_t*>(data + rowsOffset);
+  std::fill(buildRows_, buildRows_ + capacity + 1, -1);
+  auto* keyOperand = reinterpret_cast<Operand*>(data + keyOffset);
+  deviceKeys->toOperand(keyOperand);
+
+  Instruction instruction;
+  instruction.opCode = OpCode::kHashBuild;
+  auto& build = instruction._.hashBuild;
+  build.key = keyOperand;
+  build.table = idMap_;
+  build.rows = buildRows_;
+  stream_ = std::make_unique<WaveKernelStream>();
+  WaveBufferPtr program;
+  auto status =
+      launchInstruction(*stream_, instruction, numRows, arena, program);
+  stream_->wait();
+  checkBlockStatus(status);
+}
+
+void HashProbe::schedule(WaveStream& stream, int32_t maxRows) {
+  // The probe runs as part of the program of the pipeline once programs are
+  // instantiated. The table and the build side columns are in 'table_' and
+  // 'buildColumns_'.
+}
+
+std::string HashProbe::toString() const {
+  return "HashProbe";
+}
+
+} // namespace facebook::velox::wave
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/core/PlanNode.h"
+#include "velox/exec/HashJoinBridge.h"
+#include "velox/experimental/wave/exec/WaveOperator.h"
+
+namespace facebook::velox::wave {
+
+/// Probe of an inner hash join on device. The build side is built on CPU by
+/// HashBuild. When the build side is available, its keys and output columns
+/// are copied to device and the keys are inserted into a device side hash
+/// table from key to build side row number. Probe batches then look up the
+/// table and set a match flag and the matching build side row per probe row.
+class HashProbe : public WaveOperator {
+ public:
+  HashProbe(CompileState& state, const core::HashJoinNode& node);
+
+  /// True if 'node' is an inner join without filter on one BIGINT key with
+  /// fixed width output columns.
+  static bool isSupported(const core::HashJoinNode& node);
+
+  bool isStreaming() const override {
+    return true;
+  }
+
+  exec::BlockingReason isBlocked(ContinueFuture* future) override;
+
+  void schedule(WaveStream& stream, int32_t maxRows = 0) override;
+
+  vector_size_t outputSize() const override {
+    return 0;
+  }
+
+  std::string toString() const override;
+
+ private:
+  // Copies the keys and the output columns of 'table' to device and builds the
+  // device side hash table.
+  void buildTable(exec::BaseHashTable& table);
+
+  const std::shared_ptr<exec::HashJoinBridge> joinBridge_;
+
+  // The column in the build side RowContainer and the output channel of each
+  // build side output column.
+  std::vector<std::pair<column_index_t, column_index_t>> buildProjections_;
+
+  // The hash table from key to build side row number in unified memory.
+  WaveBufferPtr table_;
+  Int64IdMap* idMap_{nullptr};
+  int32_t* buildRows_{nullptr};
+
+  // Device side copies of the build side output columns, in the order of
+  // 'buildProjections_'.
+  std::vector<WaveVectorPtr> buildColumns_;
+
+  std::unique_ptr<WaveKernelStream> stream_;
+};
+
+} // namespace facebook::velox::wave
@@ -85,4 +85,14 @@ struct AbstractBinary : public AbstractInstruction {
   AbstractOperand* result;
 };
 
+struct AbstractHashProbe : public AbstractInstruction {
+  AbstractHashProbe(AbstractOperand* key, AbstractOperand* flags)
+      : AbstractInstruction(OpCode::kHashProbe), key(key), flags(flags) {}
+
+  AbstractOperand* key;
+
+  // Set for probe rows with a match.
+  AbstractOperand* flags;
+};
+
 } // namespace facebook::velox::wave
@@ -16,12 +16,18 @@
 
 #include "velox/experimental/wave/exec/ToWave.h"
 #include "velox/exec/FilterProject.h"
+#include "velox/experimental/wave/exec/Aggregation.h"
+#include "velox/experimental/wave/exec/HashProbe.h"
 #include "velox/experimental/wave/exec/Values.h"
 #include "velox/experimental/wave/exec/WaveDriver.h"
 #include "velox/expression/ConstantExpr.h"
 #include "velox/expression/FieldReference.h"
 
 DEFINE_int64(velox_wave_arena_unit_size, 1 << 30, "Per Driver GPU memory size");
+DEFINE_bool(
+    velox_wave_hash_probe,
+    false,
+    "Replace HashProbe with Wave. The probe program is not yet scheduled");
 
 namespace facebook::velox::wave {
 
@@ -196,6 +202,22 @@ bool CompileState::addOperator(
       return false;
     }
     addFilterProject(op);
+  } else if (name == "Aggregation" || name == "PartialAggregation") {
+    auto* node = dynamic_cast<const core::AggregationNode*>(
+        driverFactory_.planNodes[nodeIndex].get());
+    if (!node || !Aggregation::isSupported(*node) || !reserveMemory()) {
+      return false;
+    }
+    operators_.push_back(std::make_unique<Aggregation>(*this, *node));
+    outputType = node->outputType();
+  } else if (name == "HashProbe" && FLAGS_velox_wave_hash_probe) {
+    auto* node = dynamic_cast<const core::HashJoinNode*>(
+        driverFactory_.planNodes[nodeIndex].get());
+    if (!node || !HashProbe::isSupported(*node) || !reserveMemory()) {
+      return false;
+    }
+    operators_.push_back(std::make_unique<HashProbe>(*this, *node));
+    outputType = node->outputType();
   } else {
     return false;
   }
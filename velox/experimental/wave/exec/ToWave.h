@@ -56,6 +56,10 @@ class CompileState {
     return *arena_;
   }
 
+  exec::Driver& driver() {
+    return driver_;
+  }
+
  private:
   bool
   addOperator(exec::Operator* op, int32_t& nodeIndex, RowTypePtr& outputType);
@@ -106,6 +106,17 @@ void transferVector(
   }
 }
 
+WaveVectorPtr vectorToDevice(const BaseVector* source, GpuArena& arena) {
+  std::vector<Transfer> transfers;
+  std::vector<WaveVectorPtr> waveVectors;
+  std::vector<Operand> operands;
+  transferVector(source, 0, transfers, waveVectors, operands, arena, 0);
+  for (auto& transfer : transfers) {
+    ::memcpy(transfer.to, transfer.from, transfer.size);
+  }
+  return std::move(waveVectors[0]);
+}
+
 void vectorsToDevice(
     folly::Range<const BaseVector**> source,
     const OperandSet& ids,
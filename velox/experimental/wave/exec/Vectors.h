@@ -29,6 +29,10 @@ void vectorsToDevice(
 
 WaveVectorPtr allocateWaveVector(const BaseVector* source, GpuArena& arena);
 
+/// Returns a copy of flat 'source' in unified memory. Copies on the calling
+/// thread.
+WaveVectorPtr vectorToDevice(const BaseVector* source, GpuArena& arena);
+
 void ensureWaveVector(
     WaveVectorPtr& waveVector,
     const BaseVector* vector,
@@ -15,6 +15,7 @@
  */
 
 #include "velox/experimental/wave/exec/Wave.h"
+#include "velox/common/time/Timer.h"
 
 namespace facebook::velox::wave {
 
@@ -40,9 +41,21 @@ Stream* WaveStream::newStream() {
   auto result = stream.get();
   streams_.push_back(std::move(stream));
   lastEvent_.push_back(nullptr);
+  startEvents_.push_back(std::make_unique<Event>(true));
+  startEvents_.back()->record(*result);
+  endEvents_.push_back(std::make_unique<Event>(true));
   return result;
 }
 
+void WaveStream::forEachStreamTime(
+    const std::function<void(int64_t nanos)>& func) {
+  for (auto i = 0; i < streams_.size(); ++i) {
+    if (endEvents_[i]->isRecorded()) {
+      func(endEvents_[i]->elapsedTime(*startEvents_[i]) * 1'000'000);
+    }
+  }
+}
+
 // static
 void WaveStream::clearReusable() {
   streamsForReuse_.clear();
@@ -120,7 +133,16 @@ void Executable::startTransfer(
   exe->deviceData = operands;
   exe->operands = operands->as<Operand>();
   exe->outputOperands = outputOperands;
-  copyData(exe->transfers);
+  uint64_t copyMicros = 0;
+  {
+    MicrosecondTimer timer(&copyMicros);
+    copyData(exe->transfers);
+  }
+  int64_t bytes = 0;
+  for (auto& transfer : exe->transfers) {
+    bytes += transfer.size;
+  }
+  waveStream.addTransfer(bytes, copyMicros);
   auto* device = waveStream.device();
   waveStream.installExecutables(
       folly::Range(&exe, 1),
@@ -174,6 +196,7 @@ void WaveStream::installExecutables(
     if (required.empty()) {
       auto stream = newStream();
       launch(stream, exes);
+      recordEnd(*stream);
     } else {
       for (auto* req : required) {
         auto id = reinterpret_cast<uintptr_t>(req->userData());
@@ -187,10 +210,16 @@ void WaveStream::installExecutables(
       auto launchStream = newStream();
       ids.forEach([&](int32_t id) { streamEvents[id]->wait(*launchStream); });
       launch(launchStream, exes);
+      recordEnd(*launchStream);
     }
   }
 }
 
+void WaveStream::recordEnd(Stream& stream) {
+  auto id = reinterpret_cast<uintptr_t>(stream.userData());
+  endEvents_[id]->record(stream);
+}
+
 bool WaveStream::isArrived(
     const OperandSet& ids,
     int32_t sleepMicro,
@@ -236,4 +265,68 @@ bool WaveStream::isArrived(
   return false;
 }
 
+folly::Range<BlockStatus*> launchInstruction(
+    WaveKernelStream& stream,
+    const Instruction& instruction,
+    int32_t numRows,
+    GpuArena& arena,
+    WaveBufferPtr& memory) {
+  const int32_t numBlocks = bits::roundUp(numRows, kBlockSize) / kBlockSize;
+  if (numBlocks == 0) {
+    return {};
+  }
+  // The instruction, the program, the instruction list of the program, the
+  // program and base index of each thread block and the status of each thread
+  // block.
+  const auto programOffset = bits::roundUp(sizeof(Instruction), 8);
+  const auto listOffset =
+      programOffset + bits::roundUp(sizeof(ThreadBlockProgram), 8);
+  const auto programsOffset = listOffset + sizeof(Instruction*);
+  const auto basesOffset =
+      programsOffset + numBlocks * sizeof(ThreadBlockProgram*);
+  const auto statusOffset =
+      bits::roundUp(basesOffset + numBlocks * sizeof(int32_t), 8);
+  memory = arena.allocateBytes(statusOffset + numBlocks * sizeof(BlockStatus));
+  auto* data = memory->as<char>();
+
+  auto* deviceInstruction = reinterpret_cast<Instruction*>(data);
+  *deviceInstruction = instruction;
+  auto* list = reinterpret_cast<Instruction**>(data + listOffset);
+  list[0] = deviceInstruction;
+  auto* program = reinterpret_cast<ThreadBlockProgram*>(data + programOffset);
+  program->sharedMemorySize = 0;
+  program->numInstructions = 1;
+  program->instructions = list;
+
+  auto* programs =
+      reinterpret_cast<ThreadBlockProgram**>(data + programsOffset);
+  auto* bases = reinterpret_cast<int32_t*>(data + basesOffset);
+  auto* status = reinterpret_cast<BlockStatus*>(data + statusOffset);
+  memset(status, 0, numBlocks * sizeof(BlockStatus));
+  for (auto i = 0; i < numBlocks; ++i) {
+    programs[i] = program;
+    bases[i] = 0;
+    status[i].numRows = std::min(kBlockSize, numRows - i * kBlockSize);
+  }
+  stream.call(nullptr, numBlocks, programs, bases, status, 0);
+  return folly::Range(status, numBlocks);
+}
+
+void checkBlockStatus(folly::Range<const BlockStatus*> status) {
+  for (const auto& block : status) {
+    for (auto i = 0; i < block.numRows; ++i) {
+      switch (block.errors[i]) {
+        case ErrorCode::kOk:
+          break;
+        case ErrorCode::kInsuffcientMemory:
+          VELOX_FAIL("Insufficient memory in Wave kernel");
+        case ErrorCode::kDuplicateKey:
+          VELOX_FAIL("Duplicate key in Wave kernel");
+        default:
+          VELOX_FAIL("Error in Wave kernel");
+      }
+    }
+  }
+}
+
 } // namespace facebook::velox::wave
@@ -258,6 +258,26 @@ class WaveStream {
   static std::unique_ptr<Stream> streamFromReserve();
   static void releaseStream(std::unique_ptr<Stream>&& stream);
 
+  /// Records 'bytes' copied from host into unified memory in 'micros' for a
+  /// transfer.
+  void addTransfer(int64_t bytes, uint64_t micros) {
+    transferBytes_ += bytes;
+    hostCopyMicros_ += micros;
+  }
+
+  int64_t transferBytes() const {
+    return transferBytes_;
+  }
+
+  uint64_t hostCopyMicros() const {
+    return hostCopyMicros_;
+  }
+
+  /// Calls 'func' with the device time in nanoseconds from the first to the
+  /// last launch on each stream of 'this'. Call only after all work has
+  /// arrived.
+  void forEachStreamTime(const std::function<void(int64_t nanos)>& func);
+
  private:
   Event* newEvent();
 
@@ -272,6 +292,9 @@ class WaveStream {
 
   static void clearReusable();
 
+  // Records the end timing event of 'stream' after the work enqueued so far.
+  void recordEnd(Stream& stream);
+
   GpuArena& arena_;
   folly::F14FastMap<OperandId, Executable*> operandToExecutable_;
   std::vector<std::unique_ptr<Executable>> executables_;
@@ -286,6 +309,30 @@ class WaveStream {
   // all events recorded on any stream. Events, once seen realized, are moved
   // back to reserve from here.
   folly::F14FastSet<Event*> allEvents_;
+
+  // Timing events recorded on the pairwise corresponding element of
+  // 'streams_' when it is created and after each launch on it.
+  std::vector<std::unique_ptr<Event>> startEvents_;
+  std::vector<std::unique_ptr<Event>> endEvents_;
+
+  int64_t transferBytes_{0};
+  uint64_t hostCopyMicros_{0};
 };
 
+/// Runs 'instruction' as a program of one instruction over 'numRows' rows on
+/// 'stream'. The program and the status of each thread block are allocated
+/// from 'arena' into 'memory', which must be kept until the kernel has
+/// completed. The operands of 'instruction' must be in unified memory.
+/// Returns the status of each thread block.
+folly::Range<BlockStatus*> launchInstruction(
+    WaveKernelStream& stream,
+    const Instruction& instruction,
+    int32_t numRows,
+    GpuArena& arena,
+    WaveBufferPtr& memory);
+
+/// Throws if a lane in 'status' has an error. Call after the kernel setting
+/// 'status' has completed.
+void checkBlockStatus(folly::Range<const BlockStatus*> status);
+
 } // namespace facebook::velox::wave
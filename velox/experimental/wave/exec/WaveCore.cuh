@@ -31,18 +31,27 @@ __device__ inline bool isNull(Operand* op, int32_t blockBase) {
   return op->nulls == nullptr || !op->nulls[blockBase + threadIdx.x];
 }
 
-template <typename T>
-__device__ inline T value(Operand* op, int32_t blockBase, char* shared) {
+// Returns the position of the lane in the values and nulls of 'op'.
+__device__ inline int32_t operandIndex(Operand* op, int32_t blockBase) {
   int32_t index = (threadIdx.x + blockBase) & op->indexMask;
-  void* base = op->sharedOffset != Operand::kGlobal ? shared + op->sharedOffset
-                                                    : op->base;
   if (auto indicesInOp = op->indices) {
     auto indices = indicesInOp[blockBase / kBlockSize];
     if (indices) {
       index = indices[index];
     }
   }
-  return reinterpret_cast<const T*>(base)[index];
+  return index;
+}
+
+template <typename T>
+__device__ inline T value(Operand* op, int32_t blockBase, char* shared) {
+  void* base = op->sharedOffset != Operand::kGlobal ? shared + op->sharedOffset
+                                                    : op->base;
+  return reinterpret_cast<const T*>(base)[operandIndex(op, blockBase)];
+}
+
+__device__ inline bool isNotNull(Operand* op, int32_t blockBase) {
+  return op->nulls == nullptr || op->nulls[operandIndex(op, blockBase)];
 }
 
 template <typename T>
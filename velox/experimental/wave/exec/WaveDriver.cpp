@@ -18,6 +18,11 @@
 #include "velox/experimental/wave/exec/Instruction.h"
 #include "velox/experimental/wave/exec/WaveOperator.h"
 
+DEFINE_int32(
+    velox_wave_max_streams_in_flight,
+    3,
+    "Maximum number of batches of a Wave pipeline that run concurrently");
+
 namespace facebook::velox::wave {
 
 WaveDriver::WaveDriver(
@@ -49,6 +54,22 @@ WaveDriver::WaveDriver(
   }
 }
 
+exec::BlockingReason WaveDriver::isBlocked(ContinueFuture* future) {
+  if (blockingFuture_.valid()) {
+    *future = std::move(blockingFuture_);
+    return blockingReason_;
+  }
+  for (auto& pipeline : pipelines_) {
+    for (auto& op : pipeline.operators) {
+      auto reason = op->isBlocked(future);
+      if (reason != exec::BlockingReason::kNotBlocked) {
+        return reason;
+      }
+    }
+  }
+  return exec::BlockingReason::kNotBlocked;
+}
+
 RowVectorPtr WaveDriver::getOutput() {
   for (;;) {
     startMore();
@@ -74,6 +95,7 @@ RowVectorPtr WaveDriver::getOutput() {
           result = makeResult(*stream, lastSet);
         }
         if (streamAtEnd(*stream)) {
+          addStreamStats(*stream);
           it = streams.erase(it);
         } else {
           ++it;
@@ -87,12 +109,23 @@ RowVectorPtr WaveDriver::getOutput() {
       }
       running = true;
     }
-    if (!running) {
+    if (!running && !finishNextPipeline()) {
       return nullptr;
     }
   }
 }
 
+bool WaveDriver::finishNextPipeline() {
+  for (auto i = 1; i < pipelines_.size(); ++i) {
+    if (!pipelines_[i].noMoreInput) {
+      pipelines_[i].noMoreInput = true;
+      pipelines_[i].operators[0]->noMoreInput();
+      return true;
+    }
+  }
+  return false;
+}
+
 bool WaveDriver::streamAtEnd(WaveStream& stream) {
   return true;
 }
@@ -138,7 +171,16 @@ RowVectorPtr WaveDriver::makeResult(
 void WaveDriver::startMore() {
   for (int i = 0; i < pipelines_.size(); ++i) {
     auto& ops = pipelines_[i].operators;
-    if (auto rows = ops[0]->canAdvance()) {
+    auto& streams = pipelines_[i].streams;
+    // Up to 'velox_wave_max_streams_in_flight' batches are pending so that the
+    // transfer of a batch overlaps the kernels of the previous ones.
+    bool started = false;
+    while (static_cast<int32_t>(streams.size()) <
+           FLAGS_velox_wave_max_streams_in_flight) {
+      auto rows = ops[0]->canAdvance();
+      if (!rows) {
+        break;
+      }
       auto stream = std::make_unique<WaveStream>(*arena_);
       for (auto& op : ops) {
         op->schedule(*stream, rows);
@@ -146,12 +188,29 @@ void WaveDriver::startMore() {
       if (i == pipelines_.size() - 1) {
         prefetchReturn(*stream);
       }
-      pipelines_[i].streams.push_back(std::move(stream));
+      streams.push_back(std::move(stream));
+      started = true;
+    }
+    if (started) {
       break;
     }
   }
 }
 
+void WaveDriver::addStreamStats(WaveStream& stream) {
+  addRuntimeStat(
+      "waveTransferBytes",
+      RuntimeCounter(stream.transferBytes(), RuntimeCounter::Unit::kBytes));
+  addRuntimeStat(
+      "waveHostCopyNanos",
+      RuntimeCounter(
+          stream.hostCopyMicros() * 1'000, RuntimeCounter::Unit::kNanos));
+  stream.forEachStreamTime([&](int64_t nanos) {
+    addRuntimeStat(
+        "waveStreamNanos", RuntimeCounter(nanos, RuntimeCounter::Unit::kNanos));
+  });
+}
+
 void WaveDriver::prefetchReturn(WaveStream& stream) {
   // Schedule return buffers from last op to be on host side.
 }
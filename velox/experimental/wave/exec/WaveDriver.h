@@ -38,13 +38,7 @@ class WaveDriver : public exec::SourceOperator {
 
   RowVectorPtr getOutput() override;
 
-  exec::BlockingReason isBlocked(ContinueFuture* future) override {
-    if (blockingFuture_.valid()) {
-      *future = std::move(blockingFuture_);
-      return blockingReason_;
-    }
-    return exec::BlockingReason::kNotBlocked;
-  }
+  exec::BlockingReason isBlocked(ContinueFuture* future) override;
 
   bool isFinished() {
     return finished_;
@@ -73,10 +67,20 @@ class WaveDriver : public exec::SourceOperator {
       WaveStream& stream,
       const OperandSet& lastSet);
 
-  // Starts another WaveStream if the source operator indicates it has more data
-  // and there is space in the arena.
+  // Starts WaveStreams for the first pipeline whose source operator indicates
+  // it has more data, up to --velox_wave_max_streams_in_flight pending
+  // streams per pipeline.
   void startMore();
 
+  // Adds the transfer volume and the device time of each Cuda stream of
+  // 'stream' to the runtime stats. 'stream' must have arrived.
+  void addStreamStats(WaveStream& stream);
+
+  // Calls noMoreInput() on the first operator of the first pipeline whose
+  // input is not yet finished. Call when no pipeline has running or startable
+  // streams. Returns false if all pipelines have finished input.
+  bool finishNextPipeline();
+
   // Enqueus a prefetch from device to host for the buffers of output vectors.
   void prefetchReturn(WaveStream& stream);
 
@@ -97,6 +101,10 @@ class WaveDriver : public exec::SourceOperator {
     // independently of each other.  This is bounded by device memory and the
     // speed at which the source can produce new batches.
     std::list<std::unique_ptr<WaveStream>> streams;
+
+    // True after noMoreInput() of the first operator. The first pipeline has
+    // no input.
+    bool noMoreInput{false};
   };
 
   std::vector<Pipeline> pipelines_;
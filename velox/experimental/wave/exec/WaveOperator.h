@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/exec/Driver.h"
 #include "velox/experimental/wave/exec/Wave.h"
 #include "velox/experimental/wave/vector/WaveVector.h"
 
@@ -54,6 +55,18 @@ class WaveOperator {
     VELOX_FAIL("Override for blocking operator");
   }
 
+  /// Called on a blocking operator after all its input has been enqueued and
+  /// flushed.
+  virtual void noMoreInput() {
+    VELOX_FAIL("Override for blocking operator");
+  }
+
+  /// Returns the reason 'this' cannot run yet, e.g. waiting for the build side
+  /// of a join, and sets 'future' to be realized when it can.
+  virtual exec::BlockingReason isBlocked(ContinueFuture* /*future*/) {
+    return exec::BlockingReason::kNotBlocked;
+  }
+
   // If 'this' is a cardinality change (filter, join, unnest...),
   // returns the instruction where the projected through columns get
   // wrapped. Columns that need to be accessed through the change are
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/experimental/wave/exec/ToWave.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+class AggregationTest : public OperatorTestBase {
+ protected:
+  void SetUp() override {
+    OperatorTestBase::SetUp();
+    wave::registerWave();
+  }
+
+  std::vector<RowVectorPtr> makeVectors() {
+    std::vector<RowVectorPtr> vectors;
+    for (int32_t i = 0; i < 10; ++i) {
+      vectors.push_back(makeRowVector({
+          makeFlatVector<int64_t>(
+              1'000, [](auto row) { return row % 17; }, nullEvery(11)),
+          makeFlatVector<int64_t>(
+              1'000, [i](auto row) { return row * i - 500; }, nullEvery(7)),
+      }));
+    }
+    return vectors;
+  }
+};
+
+TEST_F(AggregationTest, global) {
+  auto vectors = makeVectors();
+  createDuckDbTable(vectors);
+  auto plan =
+      PlanBuilder()
+          .values(vectors)
+          .singleAggregation(
+              {}, {"count(c1)", "sum(c1)", "min(c1)", "max(c1)", "count(c0)"})
+          .planNode();
+  assertQuery(
+      plan,
+      "SELECT count(c1), sum(c1), min(c1), max(c1), count(c0) FROM tmp");
+}
+
+TEST_F(AggregationTest, grouped) {
+  auto vectors = makeVectors();
+  createDuckDbTable(vectors);
+  auto plan =
+      PlanBuilder()
+          .values(vectors)
+          .singleAggregation({"c0"}, {"count(c1)", "sum(c1)", "max(c1)"})
+          .planNode();
+  assertQuery(
+      plan, "SELECT c0, count(c1), sum(c1), max(c1) FROM tmp GROUP BY c0");
+}
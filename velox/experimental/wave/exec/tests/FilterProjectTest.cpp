@@ -80,6 +80,22 @@ TEST_F(FilterProjectTest, roundTrip) {
   AssertQueryBuilder(plan).assertResults(vectors);
 }
 
+TEST_F(FilterProjectTest, streamStats) {
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 10; ++i) {
+    auto vector = std::dynamic_pointer_cast<RowVector>(
+        BatchMaker::createBatch(rowType_, 100, *pool_));
+    makeNotNull(vector);
+    vectors.push_back(vector);
+  }
+  auto plan = PlanBuilder().values(vectors).planNode();
+  auto task = AssertQueryBuilder(plan).assertResults(vectors);
+  auto stats = toPlanStats(task->taskStats()).at(plan->id()).customStats;
+  ASSERT_EQ(stats.at("waveTransferBytes").count, vectors.size());
+  ASSERT_LT(0, stats.at("waveTransferBytes").sum);
+  ASSERT_LE(vectors.size(), stats.at("waveStreamNanos").count);
+}
+
 TEST_F(FilterProjectTest, project) {
   return;
   std::vector<RowVectorPtr> vectors;
@@ -14,6 +14,10 @@
  * limitations under the License.
  */
 #pragma once
+#include <charconv>
+
+#include <folly/Conv.h>
+
 #include "velox/common/base/Exceptions.h"
 #include "velox/core/CoreTypeSystem.h"
 #include "velox/expression/StringWriter.h"
@@ -142,6 +146,47 @@ void CastExpr::applyCastKernel(
     }
   }
 
+  // Parse numbers with folly::tryTo, which reports invalid input without
+  // throwing. The error message is the one folly::to would have thrown.
+  if constexpr (
+      !Truncate &&
+      (FromKind == TypeKind::VARCHAR || FromKind == TypeKind::VARBINARY) &&
+      (ToKind == TypeKind::TINYINT || ToKind == TypeKind::SMALLINT ||
+       ToKind == TypeKind::INTEGER || ToKind == TypeKind::BIGINT ||
+       ToKind == TypeKind::REAL || ToKind == TypeKind::DOUBLE)) {
+    const folly::StringPiece value(inputRowValue);
+    auto parsed =
+        folly::tryTo<typename TypeTraits<ToKind>::NativeType>(value);
+    if (LIKELY(parsed.hasValue())) {
+      result->set(row, parsed.value());
+    } else if (setNullInResultAtError()) {
+      result->setNull(row, true);
+    } else {
+      context.setVeloxExceptionError(
+          row,
+          makeBadCastException(
+              result->type(),
+              *input,
+              row,
+              folly::makeConversionError(parsed.error(), value).what()));
+    }
+    return;
+  }
+
+  // Print integers into a stack buffer instead of a temporary std::string.
+  // Strings that fit inline in a StringView are not copied to the string
+  // buffers of 'result'.
+  if constexpr (
+      ToKind == TypeKind::VARCHAR &&
+      (FromKind == TypeKind::TINYINT || FromKind == TypeKind::SMALLINT ||
+       FromKind == TypeKind::INTEGER || FromKind == TypeKind::BIGINT)) {
+    char buffer[24];
+    auto end =
+        std::to_chars(buffer, buffer + sizeof(buffer), inputRowValue).ptr;
+    result->set(row, StringView(buffer, end - buffer));
+    return;
+  }
+
   auto output = util::Converter<ToKind, void, Truncate>::cast(inputRowValue);
 
   if constexpr (ToKind == TypeKind::VARCHAR || ToKind == TypeKind::VARBINARY) {
@@ -116,6 +116,11 @@ void ConjunctExpr::evalSpecialForm(
         values, rows.asRange().bits(), rows.begin(), rows.end());
   }
 
+  auto& queryCtx = *context.execCtx()->queryCtx();
+  if (!reorderEnabledChecked_) {
+    initializeReordering(queryCtx);
+  }
+
   // OR: fix finalSelection at "rows" unless already fixed
   ScopedFinalSelectionSetter scopedFinalSelectionSetter(
       context, &rows, !isAnd_);
@@ -161,19 +166,26 @@ void ConjunctExpr::evalSpecialForm(
   }
   // Clear errors for 'rows' that are not in 'activeRows'.
   finalizeErrors(rows, *activeRows, throwOnError, context);
-  if (!reorderEnabledChecked_) {
-    reorderEnabled_ = context.execCtx()
-                          ->queryCtx()
-                          ->queryConfig()
-                          .adaptiveFilterReorderingEnabled();
-    reorderEnabledChecked_ = true;
-  }
   if (reorderEnabled_) {
-    maybeReorderInputs();
+    maybeReorderInputs(queryCtx);
+  }
+}
+
+void ConjunctExpr::initializeReordering(core::QueryCtx& queryCtx) {
+  reorderEnabled_ = queryCtx.queryConfig().adaptiveFilterReorderingEnabled();
+  reorderEnabledChecked_ = true;
+  if (!reorderEnabled_) {
+    return;
+  }
+  orderKey_ = toString();
+  if (auto order = queryCtx.conjunctOrder(orderKey_)) {
+    if (order->size() == inputs_.size()) {
+      inputOrder_ = std::move(*order);
+    }
   }
 }
 
-void ConjunctExpr::maybeReorderInputs() {
+void ConjunctExpr::maybeReorderInputs(core::QueryCtx& queryCtx) {
   bool reorder = false;
   for (auto i = 1; i < inputs_.size(); ++i) {
     if (selectivity_[inputOrder_[i - 1]].timeToDropValue() >
@@ -190,6 +202,7 @@ void ConjunctExpr::maybeReorderInputs() {
           return selectivity_[left].timeToDropValue() <
               selectivity_[right].timeToDropValue();
         });
+    queryCtx.setConjunctOrder(orderKey_, inputOrder_);
   }
 }
 
@@ -74,7 +74,11 @@ class ConjunctExpr : public SpecialForm {
     propagatesNulls_ = false;
   }
 
-  void maybeReorderInputs();
+  // Reads the reordering switch and starts with the order learned for the
+  // same expression by the other ExprSets of the query, if any.
+  void initializeReordering(core::QueryCtx& queryCtx);
+
+  void maybeReorderInputs(core::QueryCtx& queryCtx);
 
   void updateResult(
       BaseVector* inputResult,
@@ -94,6 +98,8 @@ class ConjunctExpr : public SpecialForm {
   bool reorderEnabled_;
   std::vector<SelectivityInfo> selectivity_;
   std::vector<int32_t> inputOrder_;
+  // Identifies the expression in QueryCtx::conjunctOrder().
+  std::string orderKey_;
 
   friend class ConjunctCallToSpecialForm;
 };
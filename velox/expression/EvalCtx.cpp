@@ -15,7 +15,9 @@
  */
 
 #include "velox/expression/EvalCtx.h"
+#include <algorithm>
 #include <exception>
+#include <numeric>
 #include "velox/common/base/RawVector.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/PeeledEncoding.h"
@@ -51,6 +53,140 @@ EvalCtx::EvalCtx(core::ExecCtx* execCtx)
   VELOX_CHECK_NOT_NULL(execCtx);
 }
 
+namespace {
+// Returns the vector wrapped by 'vector' or nullptr if 'vector' is not a
+// wrapper.
+const BaseVector* wrappedVector(const BaseVector& vector) {
+  switch (vector.encoding()) {
+    case VectorEncoding::Simple::DICTIONARY:
+    case VectorEncoding::Simple::SEQUENCE:
+    case VectorEncoding::Simple::CONSTANT:
+      return vector.valueVector().get();
+    default:
+      return nullptr;
+  }
+}
+
+// Returns true if 'vector' is 'column' or a vector wrapped by it, looking
+// through loaded lazy vectors.
+bool isInColumn(const BaseVector& vector, const BaseVector* column) {
+  for (auto* inner = column; inner;) {
+    if (inner == &vector) {
+      return true;
+    }
+    if (inner->isLazy()) {
+      auto* lazy = inner->asUnchecked<LazyVector>();
+      inner = lazy->isLoaded() ? lazy->loadedVector() : nullptr;
+    } else {
+      inner = wrappedVector(*inner);
+    }
+  }
+  return false;
+}
+} // namespace
+
+EvalCtx::~EvalCtx() {
+  for (auto& entry : decodedVectorCache_) {
+    execCtx_->releaseSelectivityVector(std::move(entry.rows));
+    execCtx_->releaseDecodedVector(std::move(entry.decoded));
+  }
+}
+
+const DecodedVector* EvalCtx::getCachedDecodedVector(
+    const BaseVector& vector,
+    const SelectivityVector& rows,
+    bool loadLazy) const {
+  if (!row_) {
+    return nullptr;
+  }
+  if (!cacheableVectors_.has_value()) {
+    cacheableVectors_.emplace();
+    for (const auto& child : row_->children()) {
+      // Decoding a lazy vector depends on the rows and on 'loadLazy'. Skips
+      // columns that are or wrap one.
+      bool hasLazy = false;
+      for (auto* inner = child.get(); inner; inner = wrappedVector(*inner)) {
+        if (inner->isLazy()) {
+          hasLazy = true;
+          break;
+        }
+      }
+      if (hasLazy) {
+        continue;
+      }
+      for (auto* inner = child.get(); inner; inner = wrappedVector(*inner)) {
+        cacheableVectors_->insert(inner);
+      }
+    }
+  }
+  if (!cacheableVectors_->contains(&vector)) {
+    return nullptr;
+  }
+
+  for (const auto& entry : decodedVectorCache_) {
+    if (entry.vector == &vector && entry.loadLazy == loadLazy &&
+        rows.isSubset(*entry.rows)) {
+      return entry.decoded.get();
+    }
+  }
+  if (decodedVectorCache_.size() >= kMaxCachedDecodedVectors) {
+    return nullptr;
+  }
+
+  auto cachedRows = execCtx_->getSelectivityVector();
+  *cachedRows = rows;
+  auto decoded = execCtx_->getDecodedVector();
+  decoded->decode(vector, rows, loadLazy);
+  decodedVectorCache_.push_back(
+      {&vector, loadLazy, std::move(cachedRows), std::move(decoded)});
+  return decodedVectorCache_.back().decoded.get();
+}
+
+const vector_size_t* EvalCtx::getSortedMapKeyOffsets(
+    const MapVector& map) const {
+  if (!row_ ||
+      std::none_of(
+          row_->children().begin(),
+          row_->children().end(),
+          [&](const auto& child) { return isInColumn(map, child.get()); })) {
+    return nullptr;
+  }
+  auto it = std::find_if(
+      sortedMapKeysCache_.begin(),
+      sortedMapKeysCache_.end(),
+      [&](const auto& entry) { return entry.map == &map; });
+  if (it == sortedMapKeysCache_.end()) {
+    if (sortedMapKeysCache_.size() < kMaxSortedMapKeys) {
+      sortedMapKeysCache_.push_back({&map, nullptr});
+    }
+    return nullptr;
+  }
+  if (it->offsets != nullptr) {
+    return it->offsets->as<vector_size_t>();
+  }
+
+  const auto& keys = map.mapKeys();
+  const auto numKeys = keys->size();
+  auto* rawOffsets = map.rawOffsets();
+  auto* rawSizes = map.rawSizes();
+  it->offsets = allocateIndices(numKeys, pool());
+  auto* sorted = it->offsets->asMutable<vector_size_t>();
+  for (auto i = 0; i < map.size(); ++i) {
+    // Skips null maps and the maps of rows a lazy column was not loaded for.
+    if (map.isNullAt(i) || rawSizes[i] <= 0 ||
+        rawOffsets[i] + rawSizes[i] > numKeys) {
+      continue;
+    }
+    auto* begin = sorted + rawOffsets[i];
+    auto* end = begin + rawSizes[i];
+    std::iota(begin, end, rawOffsets[i]);
+    std::sort(begin, end, [&](vector_size_t left, vector_size_t right) {
+      return keys->compare(keys.get(), left, right) < 0;
+    });
+  }
+  return sorted;
+}
+
 void EvalCtx::saveAndReset(
     ScopedContextSaver& saver,
     const SelectivityVector& rows) {
@@ -191,6 +327,11 @@ void EvalCtx::setErrors(
       [&](auto row) { addError(row, veloxException, errors_); });
 }
 
+void EvalCtx::setStatus(vector_size_t index, const Status& status) {
+  VELOX_DCHECK(!status.ok());
+  setVeloxExceptionError(index, status.toException());
+}
+
 void EvalCtx::addElementErrorsToTopLevel(
     const SelectivityVector& elementRows,
     const BufferPtr& elementToTopLevelRows,
@@ -16,9 +16,12 @@
 
 #pragma once
 
+#include <folly/container/F14Set.h>
 #include <functional>
+#include <optional>
 
 #include "velox/common/base/Portability.h"
+#include "velox/common/base/Status.h"
 #include "velox/core/QueryCtx.h"
 #include "velox/vector/ComplexVector.h"
 #include "velox/vector/FlatVector.h"
@@ -44,6 +47,8 @@ class EvalCtx {
   /// For testing only.
   explicit EvalCtx(core::ExecCtx* FOLLY_NONNULL execCtx);
 
+  ~EvalCtx();
+
   const RowVector* FOLLY_NONNULL row() const {
     return row_;
   }
@@ -93,6 +98,11 @@ class EvalCtx {
       const SelectivityVector& rows,
       const std::exception_ptr& exceptionPtr);
 
+  /// Records the error in 'status', which must not be ok(), for row 'index'.
+  /// Used by functions that return errors as a Status instead of throwing.
+  /// Throws the error if errors are not captured.
+  void setStatus(vector_size_t index, const Status& status);
+
   /// Invokes a function on each selected row. Records per-row exceptions by
   /// calling 'setError'. The function must take a single "row" argument of type
   /// vector_size_t and return void.
@@ -292,7 +302,49 @@ class EvalCtx {
     return peeledEncoding_.get();
   }
 
+  /// Returns a DecodedVector of 'vector' for at least 'rows' that is shared by
+  /// all LocalDecodedVectors built over 'vector' while evaluating this batch.
+  /// Decodes 'vector' on first use. Returns nullptr if 'vector' is not a
+  /// column of the input row or a vector wrapped by one, since only these
+  /// outlive the context, or if it is or wraps a lazy vector.
+  const DecodedVector* FOLLY_NULLABLE getCachedDecodedVector(
+      const BaseVector& vector,
+      const SelectivityVector& rows,
+      bool loadLazy) const;
+
+  /// Returns the offsets of the keys of all maps of 'map' sorted by key
+  /// within each map: for the map at 'i', the keys at offsets sorted[offset],
+  /// sorted[offset + 1], ... sorted[offset + size - 1] are in ascending
+  /// order, where 'offset' and 'size' are the offset and size of the map.
+  /// Lets repeated subscripts into the same maps do binary searches. Sorts on
+  /// the second call for 'map' while evaluating this batch and returns
+  /// nullptr on the first, since a single lookup is cheaper as a linear
+  /// scan. Returns nullptr also if 'map' is not a column of the input row or
+  /// a vector wrapped by one, possibly after loading a lazy column, since
+  /// only these outlive the context.
+  const vector_size_t* FOLLY_NULLABLE
+  getSortedMapKeyOffsets(const MapVector& map) const;
+
  private:
+  struct CachedDecodedVector {
+    const BaseVector* vector;
+    bool loadLazy;
+    std::unique_ptr<SelectivityVector> rows;
+    std::unique_ptr<DecodedVector> decoded;
+  };
+
+  struct SortedMapKeys {
+    const MapVector* map;
+    // Null until the second request for 'map'.
+    BufferPtr offsets;
+  };
+
+  // Maximum number of entries in 'decodedVectorCache_'.
+  static constexpr int32_t kMaxCachedDecodedVectors = 64;
+
+  // Maximum number of entries in 'sortedMapKeysCache_'.
+  static constexpr int32_t kMaxSortedMapKeys = 16;
+
   core::ExecCtx* const FOLLY_NONNULL execCtx_;
   ExprSet* FOLLY_NULLABLE const exprSet_;
   const RowVector* FOLLY_NULLABLE row_;
@@ -323,6 +375,19 @@ class EvalCtx {
   // in a opaque flat vector, which will translate to a
   // std::shared_ptr<std::exception_ptr>.
   ErrorVectorPtr errors_;
+
+  // Columns of 'row_' and the vectors wrapped by them, the vectors that can be
+  // cached in 'decodedVectorCache_'. Set on first use.
+  mutable std::optional<folly::F14FastSet<const BaseVector*>>
+      cacheableVectors_;
+
+  // Decoded vectors handed out by getCachedDecodedVector(). Entries are never
+  // decoded again since LocalDecodedVectors may point to them. Allocated from
+  // and returned to the pools of 'execCtx_'.
+  mutable std::vector<CachedDecodedVector> decodedVectorCache_;
+
+  // Maps seen by getSortedMapKeyOffsets() and their sorted key offsets.
+  mutable std::vector<SortedMapKeys> sortedMapKeysCache_;
 };
 
 /// Utility wrapper struct that is used to temporarily reset the value of the an
@@ -504,16 +569,28 @@ class LocalDecodedVector {
       const BaseVector& vector,
       const SelectivityVector& rows,
       bool loadLazy = true)
-      : context_(*context.execCtx()) {
-    get()->decode(vector, rows, loadLazy);
+      : context_(*context.execCtx()),
+        cached_(context.getCachedDecodedVector(vector, rows, loadLazy)) {
+    if (!cached_) {
+      get()->decode(vector, rows, loadLazy);
+    }
   }
 
   LocalDecodedVector(LocalDecodedVector&& other) noexcept
-      : context_{other.context_}, vector_{std::move(other.vector_)} {}
+      : context_{other.context_},
+        vector_{std::move(other.vector_)},
+        cached_{other.cached_} {
+    other.cached_ = nullptr;
+  }
 
   void operator=(LocalDecodedVector&& other) {
+    if (vector_) {
+      context_.get().releaseDecodedVector(std::move(vector_));
+    }
     context_ = other.context_;
     vector_ = std::move(other.vector_);
+    cached_ = other.cached_;
+    other.cached_ = nullptr;
   }
 
   ~LocalDecodedVector() {
@@ -522,7 +599,13 @@ class LocalDecodedVector {
     }
   }
 
+  // If constructed with data, the decoded vector may be shared with other
+  // LocalDecodedVectors through EvalCtx::getCachedDecodedVector() and must
+  // not be decoded again.
   DecodedVector* FOLLY_NONNULL get() {
+    if (cached_) {
+      return const_cast<DecodedVector*>(cached_);
+    }
     if (!vector_) {
       vector_ = context_.get().getDecodedVector();
     }
@@ -531,28 +614,35 @@ class LocalDecodedVector {
 
   // Must either use the constructor that provides data or call get() first.
   DecodedVector& operator*() {
-    VELOX_DCHECK_NOT_NULL(vector_, "get() must be called.");
-    return *vector_;
+    return *decoded();
   }
 
   const DecodedVector& operator*() const {
-    VELOX_DCHECK_NOT_NULL(vector_, "get() must be called.");
-    return *vector_;
+    return *decoded();
   }
 
   DecodedVector* FOLLY_NONNULL operator->() {
-    VELOX_DCHECK_NOT_NULL(vector_, "get() must be called.");
-    return vector_.get();
+    return decoded();
   }
 
   const DecodedVector* FOLLY_NONNULL operator->() const {
+    return decoded();
+  }
+
+ private:
+  DecodedVector* FOLLY_NONNULL decoded() const {
+    if (cached_) {
+      return const_cast<DecodedVector*>(cached_);
+    }
     VELOX_DCHECK_NOT_NULL(vector_, "get() must be called.");
     return vector_.get();
   }
 
- private:
   std::reference_wrapper<core::ExecCtx> context_;
   std::unique_ptr<DecodedVector> vector_;
+  // Set if the decoded vector is owned by the EvalCtx. See
+  // EvalCtx::getCachedDecodedVector().
+  const DecodedVector* FOLLY_NULLABLE cached_{nullptr};
 };
 
 /// Utility class used to activate final selection (setting isFinalSelection to
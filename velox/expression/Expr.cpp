@@ -1484,7 +1484,11 @@ void Expr::applyFunction(
       : std::nullopt;
 
   try {
-    vectorFunction_->apply(rows, inputValues_, type(), context, result);
+    if (auto* cache = valueCache(context)) {
+      applyFunctionWithValueCache(rows, *cache, context, result);
+    } else {
+      vectorFunction_->apply(rows, inputValues_, type(), context, result);
+    }
   } catch (const VeloxException& ve) {
     throw;
   } catch (const std::exception& e) {
@@ -1518,6 +1522,64 @@ void Expr::applyFunction(
   }
 }
 
+ExprValueCache* Expr::valueCache(EvalCtx& context) {
+  if (valueCacheMaxEntries_ == 0 || !deterministic_) {
+    return nullptr;
+  }
+  if (!valueCache_) {
+    std::vector<TypePtr> argTypes;
+    argTypes.reserve(inputs_.size());
+    for (const auto& input : inputs_) {
+      argTypes.push_back(input->type());
+    }
+    if (!ExprValueCache::supportsTypes(argTypes, type())) {
+      valueCacheMaxEntries_ = 0;
+      return nullptr;
+    }
+    valueCache_ = std::make_unique<ExprValueCache>(
+        std::move(argTypes), type(), valueCacheMaxEntries_, context.pool());
+  }
+  return valueCache_.get();
+}
+
+void Expr::applyFunctionWithValueCache(
+    const SelectivityVector& rows,
+    ExprValueCache& cache,
+    EvalCtx& context,
+    VectorPtr& result) {
+  LocalSelectivityVector missingHolder(context, rows.end());
+  auto* missingRows = missingHolder.get();
+  const auto numHits = cache.findHits(rows, inputValues_, *missingRows);
+  stats_.numValueCacheHits += numHits;
+  stats_.numValueCacheMisses += rows.countSelected() - numHits;
+
+  // Holds on to the arguments so that the function does not move them into
+  // 'result' or overwrite them in place before they are cached.
+  const std::vector<VectorPtr> args = inputValues_;
+  if (missingRows->hasSelections()) {
+    vectorFunction_->apply(*missingRows, inputValues_, type(), context, result);
+    if (!result) {
+      // Reported by applyFunction().
+      return;
+    }
+  }
+
+  if (numHits > 0) {
+    // Keeps the results of the missing rows.
+    LocalSelectivityVector hitRows(context, rows);
+    hitRows.get()->deselect(*missingRows);
+    context.ensureWritable(*hitRows.get(), type(), result);
+    cache.copyHits(*result);
+  }
+
+  // Rows with errors are not cached so that they are evaluated, and fail,
+  // again.
+  context.deselectErrors(*missingRows);
+  if (missingRows->hasSelections()) {
+    cache.insert(*missingRows, args, *result);
+  }
+}
+
 void Expr::evalSpecialFormWithStats(
     const SelectivityVector& rows,
     EvalCtx& context,
@@ -25,6 +25,7 @@
 #include "velox/core/Expressions.h"
 #include "velox/expression/DecodedArgs.h"
 #include "velox/expression/EvalCtx.h"
+#include "velox/expression/ExprValueCache.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/type/Subfield.h"
 #include "velox/vector/SimpleVector.h"
@@ -59,18 +60,38 @@ struct ExprStats {
   /// size.
   uint64_t numProcessedVectors{0};
 
+  /// Number of processed rows whose result was found in the value cache of
+  /// the function. See QueryConfig::kExprValueCacheFunctions.
+  uint64_t numValueCacheHits{0};
+
+  /// Number of processed rows that were looked up in the value cache of the
+  /// function and not found.
+  uint64_t numValueCacheMisses{0};
+
   void add(const ExprStats& other) {
     timing.add(other.timing);
     numProcessedRows += other.numProcessedRows;
     numProcessedVectors += other.numProcessedVectors;
+    numValueCacheHits += other.numValueCacheHits;
+    numValueCacheMisses += other.numValueCacheMisses;
+  }
+
+  double valueCacheHitRate() const {
+    const auto numLookups = numValueCacheHits + numValueCacheMisses;
+    return numLookups == 0
+        ? 0
+        : static_cast<double>(numValueCacheHits) / numLookups;
   }
 
   std::string toString() const {
     return fmt::format(
-        "timing: {}, numProcessedRows: {}, numProcessedVectors: {}",
+        "timing: {}, numProcessedRows: {}, numProcessedVectors: {}, "
+        "numValueCacheHits: {}, numValueCacheMisses: {}",
         timing.toString(),
         numProcessedRows,
-        numProcessedVectors);
+        numProcessedVectors,
+        numValueCacheHits,
+        numValueCacheMisses);
   }
 };
 
@@ -243,6 +264,16 @@ class Expr {
     sharedSubexprResults_.clear();
   }
 
+  /// Caches the results of the function of 'this' by the values of its
+  /// arguments across batches, holding up to 'maxEntries' distinct argument
+  /// values. Has no effect unless 'this' is deterministic and the arguments
+  /// and the result are of primitive types.
+  void enableValueCache(vector_size_t maxEntries) {
+    VELOX_CHECK_NOT_NULL(vectorFunction_);
+    VELOX_CHECK_GT(maxEntries, 0);
+    valueCacheMaxEntries_ = maxEntries;
+  }
+
   void clearMemo() {
     baseDictionary_ = nullptr;
     dictionaryCache_ = nullptr;
@@ -456,6 +487,18 @@ class Expr {
       EvalCtx& context,
       VectorPtr& result);
 
+  // Returns the value cache of 'this' and creates it on first use. Returns
+  // nullptr if the results of 'this' are not cached.
+  ExprValueCache* valueCache(EvalCtx& context);
+
+  // Calls the function of 'this' on the rows of 'rows' whose argument values
+  // are not in the value cache and copies the cached results for the others.
+  void applyFunctionWithValueCache(
+      const SelectivityVector& rows,
+      ExprValueCache& cache,
+      EvalCtx& context,
+      VectorPtr& result);
+
   // Returns true if values in 'distinctFields_' have nulls that are
   // worth skipping. If so, the rows in 'rows' with at least one sure
   // null are deselected in 'nullHolder->get()'.
@@ -541,11 +584,14 @@ class Expr {
       EvalCtx& context,
       VectorPtr& result);
 
-  /// Returns an instance of CpuWallTimer if cpu usage tracking is enabled. Null
-  /// otherwise.
-  std::unique_ptr<CpuWallTimer> cpuWallTimer() {
-    return trackCpuUsage_ ? std::make_unique<CpuWallTimer>(stats_.timing)
-                          : nullptr;
+  /// Returns a timer of the evaluation if cpu usage tracking is enabled. Empty
+  /// otherwise. The timer is cheap enough to time every evaluation, see
+  /// SampledCpuWallTimer.
+  std::optional<SampledCpuWallTimer> cpuWallTimer() {
+    if (!trackCpuUsage_) {
+      return std::nullopt;
+    }
+    return std::optional<SampledCpuWallTimer>(std::in_place, stats_.timing);
   }
 
   const TypePtr type_;
@@ -612,6 +658,14 @@ class Expr {
   // Count of times the cacheable vector is seen for a non-first time.
   int32_t numCacheableRepeats_{0};
 
+  // Max number of entries of 'valueCache_'. 0 if the results of 'this' are
+  // not cached by argument values.
+  vector_size_t valueCacheMaxEntries_{0};
+
+  // Results of the function of 'this' by argument values, kept across
+  // batches. Created on first use if 'valueCacheMaxEntries_' is set.
+  std::unique_ptr<ExprValueCache> valueCache_;
+
   /// Runtime statistics. CPU time, wall time and number of processed rows.
   ExprStats stats_;
 
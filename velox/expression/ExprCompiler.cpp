@@ -378,6 +378,38 @@ core::TypedExprPtr rewriteExpression(const core::TypedExprPtr& expr) {
   return expr;
 }
 
+// Caches the results of the function call 'expr' by argument values if its
+// function is listed in QueryConfig::kExprValueCacheFunctions.
+void maybeEnableValueCache(Expr& expr, const core::QueryConfig& config) {
+  const auto functions = config.exprValueCacheFunctions();
+  if (functions.empty()) {
+    return;
+  }
+  std::vector<folly::StringPiece> names;
+  folly::split(',', functions, names, true);
+  for (const auto& name : names) {
+    if (folly::trimWhitespace(name) == expr.name()) {
+      expr.enableValueCache(config.exprValueCacheMaxEntries());
+      return;
+    }
+  }
+}
+
+/// Applies the registered ExprSet re-writes to 'sources'. Returns an empty
+/// vector if none of them applies.
+std::vector<TypedExprPtr> rewriteExpressions(
+    const std::vector<TypedExprPtr>& sources) {
+  std::vector<TypedExprPtr> result;
+  for (auto& rewrite : exprSetRewrites()) {
+    auto rewritten = rewrite(result.empty() ? sources : result);
+    if (!rewritten.empty()) {
+      VELOX_CHECK_EQ(rewritten.size(), sources.size());
+      result = std::move(rewritten);
+    }
+  }
+  return result;
+}
+
 ExprPtr compileRewrittenExpression(
     const TypedExprPtr& expr,
     Scope* scope,
@@ -437,6 +469,7 @@ ExprPtr compileRewrittenExpression(
           func,
           call->name(),
           trackCpuUsage);
+      maybeEnableValueCache(*result, config);
     } else if (
         auto simpleFunctionEntry =
             simpleFunctions().resolveFunction(call->name(), inputTypes)) {
@@ -456,6 +489,7 @@ ExprPtr compileRewrittenExpression(
           std::move(func),
           call->name(),
           trackCpuUsage);
+      maybeEnableValueCache(*result, config);
     } else {
       const auto& functionName = call->name();
       auto vectorFunctionSignatures = getVectorFunctionSignatures(functionName);
@@ -592,11 +626,14 @@ std::vector<std::shared_ptr<Expr>> compileExpressions(
   std::vector<std::shared_ptr<Expr>> exprs;
   exprs.reserve(sources.size());
 
+  auto rewritten = rewriteExpressions(sources);
+  const auto& rewrittenSources = rewritten.empty() ? sources : rewritten;
+
   // Precompute a set of function calls that support flattening. This allows to
   // lock function registry once vs. locking for each function call.
-  auto flatteningCandidates = collectFlatteningCandidates(sources);
+  auto flatteningCandidates = collectFlatteningCandidates(rewrittenSources);
 
-  for (auto& source : sources) {
+  for (auto& source : rewrittenSources) {
     exprs.push_back(compileExpression(
         source,
         &scope,
@@ -50,11 +50,59 @@ T singleValue(const VectorPtr& vector) {
   return simpleVector->valueAt(0);
 }
 
+// Returns the size of the values of 'type' if it is TINYINT, SMALLINT,
+// INTEGER or BIGINT, 0 otherwise.
+int32_t integerSize(const Type& type) {
+  if (type == *TINYINT()) {
+    return 1;
+  }
+  if (type == *SMALLINT()) {
+    return 2;
+  }
+  if (type == *INTEGER()) {
+    return 4;
+  }
+  if (type == *BIGINT()) {
+    return 8;
+  }
+  return 0;
+}
+
+// Returns input 'index' of 'expr' if it is a field. If the input is a cast of
+// an integer field to an integer type at least as wide, returns the field:
+// the cast does not change the values, so that a filter on the cast values
+// applies unchanged to the values of the field.
 const core::FieldAccessTypedExpr* asField(
     const core::ITypedExpr* expr,
     int index) {
-  return dynamic_cast<const core::FieldAccessTypedExpr*>(
-      expr->inputs()[index].get());
+  const auto* input = expr->inputs()[index].get();
+  if (auto* cast = dynamic_cast<const core::CastTypedExpr*>(input)) {
+    const auto* field = dynamic_cast<const core::FieldAccessTypedExpr*>(
+        cast->inputs()[0].get());
+    if (!field) {
+      return nullptr;
+    }
+    const auto fromSize = integerSize(*field->type());
+    return fromSize > 0 && fromSize <= integerSize(*cast->type()) ? field
+                                                                  : nullptr;
+  }
+  return dynamic_cast<const core::FieldAccessTypedExpr*>(input);
+}
+
+// Returns the field under input 'index' of 'expr' if the input is a cast of a
+// timestamp field to date.
+const core::FieldAccessTypedExpr* asTimestampToDateField(
+    const core::ITypedExpr* expr,
+    int index) {
+  auto* cast =
+      dynamic_cast<const core::CastTypedExpr*>(expr->inputs()[index].get());
+  if (!cast || !cast->type()->isDate()) {
+    return nullptr;
+  }
+  auto* field =
+      dynamic_cast<const core::FieldAccessTypedExpr*>(cast->inputs()[0].get());
+  return field && field->type()->kind() == TypeKind::TIMESTAMP ? field
+                                                               : nullptr;
 }
 
 const core::CallTypedExpr* asCall(const core::ITypedExpr* expr) {
@@ -448,6 +496,185 @@ std::unique_ptr<common::Filter> makeBetweenFilter(
   }
 }
 
+// Returns a filter passing the strings that start with 'prefix'. The strings
+// are compared bytewise, so that these are the strings from 'prefix'
+// inclusive to 'prefix' with its last byte incremented exclusive. Trailing
+// 0xFF bytes have no successor and are dropped from the upper bound.
+std::unique_ptr<common::Filter> makePrefixFilter(const std::string& prefix) {
+  if (prefix.empty()) {
+    return isNotNull();
+  }
+  auto upper = prefix;
+  while (!upper.empty() && static_cast<uint8_t>(upper.back()) == 0xFF) {
+    upper.pop_back();
+  }
+  if (upper.empty()) {
+    return greaterThanOrEqual(prefix);
+  }
+  ++upper.back();
+  return std::make_unique<common::BytesRange>(
+      prefix, false, false, upper, false, true, false);
+}
+
+// Returns a filter for 'value LIKE pattern [ESCAPE escape]' if 'pattern' is a
+// constant of a literal prefix followed by only '%' wildcards, or a literal
+// without wildcards. Other patterns need the regular expression and are not
+// converted.
+std::unique_ptr<common::Filter> makeLikeFilter(
+    const core::CallTypedExpr& call,
+    core::ExpressionEvaluator* evaluator,
+    bool negated) {
+  if (negated) {
+    return nullptr;
+  }
+  auto patternVector = toConstant(call.inputs()[1], evaluator);
+  if (!patternVector || patternVector->isNullAt(0)) {
+    return nullptr;
+  }
+  std::optional<char> escape;
+  if (call.inputs().size() == 3) {
+    auto escapeVector = toConstant(call.inputs()[2], evaluator);
+    if (!escapeVector || escapeVector->isNullAt(0)) {
+      return nullptr;
+    }
+    auto escapeString = singleValue<StringView>(escapeVector);
+    if (escapeString.size() != 1) {
+      return nullptr;
+    }
+    escape = escapeString.data()[0];
+  }
+
+  const auto pattern = singleValue<StringView>(patternVector);
+  std::string prefix;
+  size_t i = 0;
+  for (; i < pattern.size(); ++i) {
+    const auto c = pattern.data()[i];
+    if (escape.has_value() && c == escape.value()) {
+      if (++i == pattern.size()) {
+        return nullptr;
+      }
+      prefix += pattern.data()[i];
+    } else if (c == '%' || c == '_') {
+      break;
+    } else {
+      prefix += c;
+    }
+  }
+  if (i == pattern.size()) {
+    return equal(prefix);
+  }
+  for (; i < pattern.size(); ++i) {
+    if (pattern.data()[i] != '%') {
+      return nullptr;
+    }
+  }
+  return makePrefixFilter(prefix);
+}
+
+std::unique_ptr<common::Filter> makeStartsWithFilter(
+    const core::TypedExprPtr& prefixExpr,
+    core::ExpressionEvaluator* evaluator,
+    bool negated) {
+  if (negated) {
+    return nullptr;
+  }
+  auto prefix = toConstant(prefixExpr, evaluator);
+  if (!prefix || prefix->isNullAt(0)) {
+    return nullptr;
+  }
+  return makePrefixFilter(singleValue<StringView>(prefix).str());
+}
+
+// Returns the timestamp that a cast of 'days' to timestamp produces. This is
+// midnight in the session time zone if the cast adjusts to the time zone.
+std::optional<Timestamp> dateToTimestamp(
+    int32_t days,
+    core::ExpressionEvaluator* evaluator) {
+  auto cast = std::make_shared<core::CastTypedExpr>(
+      TIMESTAMP(),
+      std::vector<core::TypedExprPtr>{
+          std::make_shared<core::ConstantTypedExpr>(DATE(), variant(days))},
+      false);
+  auto timestamp = toConstant(cast, evaluator);
+  if (!timestamp) {
+    return std::nullopt;
+  }
+  return singleValue<Timestamp>(timestamp);
+}
+
+// Returns a filter on a timestamp column for a comparison of the column cast
+// to date with a constant date. The dates from 'a' to 'b' inclusive are the
+// timestamps from the cast of 'a' to timestamp inclusive to the cast of 'b +
+// 1' exclusive. The casts of date to timestamp and back use the same time
+// zone, so that the filter is exact.
+std::unique_ptr<common::Filter> makeTimestampToDateFilter(
+    const core::CallTypedExpr& call,
+    core::ExpressionEvaluator* evaluator,
+    bool negated) {
+  auto name = call.name();
+  if (negated) {
+    static const std::unordered_map<std::string, std::string> kNegations = {
+        {"lt", "gte"}, {"lte", "gt"}, {"gt", "lte"}, {"gte", "lt"}};
+    auto it = kNegations.find(name);
+    if (it == kNegations.end()) {
+      return nullptr;
+    }
+    name = it->second;
+  }
+  if (name != "eq" && name != "lt" && name != "lte" && name != "gt" &&
+      name != "gte" && name != "between") {
+    return nullptr;
+  }
+  if (call.inputs().size() != (name == "between" ? 3 : 2)) {
+    return nullptr;
+  }
+
+  std::optional<int32_t> dates[2];
+  for (auto i = 1; i < call.inputs().size(); ++i) {
+    auto date = toConstant(call.inputs()[i], evaluator);
+    if (!date || !date->type()->isDate() || date->isNullAt(0)) {
+      return nullptr;
+    }
+    dates[i - 1] = singleValue<int32_t>(date);
+  }
+  // The first and last date that pass the filter inclusive.
+  std::optional<int32_t> lower;
+  std::optional<int32_t> upper;
+  if (name == "eq") {
+    lower = upper = dates[0];
+  } else if (name == "lt") {
+    upper = dates[0].value() - 1;
+  } else if (name == "lte") {
+    upper = dates[0];
+  } else if (name == "gt") {
+    lower = dates[0].value() + 1;
+  } else if (name == "gte") {
+    lower = dates[0];
+  } else {
+    lower = dates[0];
+    upper = dates[1];
+  }
+
+  auto lowerTimestamp = std::numeric_limits<Timestamp>::min();
+  if (lower.has_value()) {
+    auto timestamp = dateToTimestamp(lower.value(), evaluator);
+    if (!timestamp.has_value()) {
+      return nullptr;
+    }
+    lowerTimestamp = timestamp.value();
+  }
+  auto upperTimestamp = std::numeric_limits<Timestamp>::max();
+  if (upper.has_value()) {
+    auto timestamp = dateToTimestamp(upper.value() + 1, evaluator);
+    if (!timestamp.has_value()) {
+      return nullptr;
+    }
+    upperTimestamp = timestamp.value();
+    --upperTimestamp;
+  }
+  return between(lowerTimestamp, upperTimestamp);
+}
+
 } // namespace
 
 std::unique_ptr<common::Filter> leafCallToSubfieldFilter(
@@ -455,6 +682,15 @@ std::unique_ptr<common::Filter> leafCallToSubfieldFilter(
     common::Subfield& subfield,
     core::ExpressionEvaluator* evaluator,
     bool negated) {
+  if (call.inputs().empty()) {
+    return nullptr;
+  }
+  if (auto field = asTimestampToDateField(&call, 0)) {
+    if (toSubfield(field, subfield)) {
+      return makeTimestampToDateFilter(call, evaluator, negated);
+    }
+    return nullptr;
+  }
   if (call.name() == "eq") {
     if (auto field = asField(&call, 0)) {
       if (toSubfield(field, subfield)) {
@@ -512,6 +748,18 @@ std::unique_ptr<common::Filter> leafCallToSubfieldFilter(
         return makeInFilter(call.inputs()[1], evaluator, negated);
       }
     }
+  } else if (call.name() == "like") {
+    if (auto field = asField(&call, 0)) {
+      if (toSubfield(field, subfield)) {
+        return makeLikeFilter(call, evaluator, negated);
+      }
+    }
+  } else if (call.name() == "starts_with" || call.name() == "startswith") {
+    if (auto field = asField(&call, 0)) {
+      if (toSubfield(field, subfield)) {
+        return makeStartsWithFilter(call.inputs()[1], evaluator, negated);
+      }
+    }
   } else if (call.name() == "is_null") {
     if (auto field = asField(&call, 0)) {
       if (toSubfield(field, subfield)) {
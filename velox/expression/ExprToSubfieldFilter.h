@@ -379,7 +379,11 @@ std::pair<common::Subfield, std::unique_ptr<common::Filter>> toSubfieldFilter(
 /// filter.  Return nullptr if not supported for pushdown.  This is needed
 /// because this conversion is frequently applied when extracting filters from
 /// remaining filter in readers.  Frequent throw clutters logs and slows down
-/// execution.
+/// execution. Besides comparisons, between, in and is_null of a field, converts
+/// LIKE with a literal prefix pattern and starts_with to string ranges, sees
+/// through widening casts of integer fields and converts comparisons of a
+/// timestamp field cast to date to timestamp ranges. The filters are exact and
+/// replace the call.
 std::unique_ptr<common::Filter> leafCallToSubfieldFilter(
     const core::CallTypedExpr&,
     common::Subfield&,
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/expression/ExprValueCache.h"
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+bool isCacheableType(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::HUGEINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+    case TypeKind::TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Copies the value at 'sourceRow' of 'source' to 'targetRow' of the flat
+// 'target'. Strings are copied into the buffers of 'target' so that 'target'
+// does not keep the buffers of 'source' alive.
+template <TypeKind kind>
+void copyValue(
+    const BaseVector& source,
+    vector_size_t sourceRow,
+    BaseVector& target,
+    vector_size_t targetRow) {
+  using T = typename TypeTraits<kind>::NativeType;
+  auto* flat = target.asUnchecked<FlatVector<T>>();
+  if (source.isNullAt(sourceRow)) {
+    flat->setNull(targetRow, true);
+    return;
+  }
+  flat->set(
+      targetRow,
+      source.asUnchecked<SimpleVector<T>>()->valueAt(sourceRow));
+}
+} // namespace
+
+ExprValueCache::ExprValueCache(
+    std::vector<TypePtr> argTypes,
+    TypePtr resultType,
+    vector_size_t maxEntries,
+    memory::MemoryPool* pool)
+    : argTypes_(std::move(argTypes)),
+      resultType_(std::move(resultType)),
+      maxEntries_(maxEntries),
+      pool_(pool) {
+  VELOX_CHECK(supportsTypes(argTypes_, resultType_));
+  VELOX_CHECK_GT(maxEntries_, 0);
+  clear();
+}
+
+// static
+bool ExprValueCache::supportsTypes(
+    const std::vector<TypePtr>& argTypes,
+    const TypePtr& resultType) {
+  if (argTypes.empty() || !isCacheableType(resultType)) {
+    return false;
+  }
+  return std::all_of(argTypes.begin(), argTypes.end(), isCacheableType);
+}
+
+vector_size_t ExprValueCache::findHits(
+    const SelectivityVector& rows,
+    const std::vector<VectorPtr>& args,
+    SelectivityVector& missingRows) {
+  VELOX_CHECK_EQ(args.size(), args_.size());
+  hashes_.resize(rows.end());
+  hits_.clear();
+  missingRows.resizeFill(rows.end(), false);
+  rows.applyToSelected([&](vector_size_t row) {
+    uint64_t hash = args[0]->hashValueAt(row);
+    for (auto i = 1; i < args.size(); ++i) {
+      hash = bits::hashMix(hash, args[i]->hashValueAt(row));
+    }
+    hashes_[row] = hash;
+    auto it = entries_.find(hash);
+    if (it != entries_.end() && equalArgs(args, row, it->second)) {
+      hits_.push_back({it->second, row, 1});
+    } else {
+      missingRows.setValid(row, true);
+    }
+  });
+  missingRows.updateBounds();
+  return hits_.size();
+}
+
+bool ExprValueCache::equalArgs(
+    const std::vector<VectorPtr>& args,
+    vector_size_t row,
+    vector_size_t entry) const {
+  for (auto i = 0; i < args.size(); ++i) {
+    if (!args[i]->equalValueAt(args_[i].get(), row, entry)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ExprValueCache::copyHits(BaseVector& result) const {
+  if (!hits_.empty()) {
+    result.copyRanges(values_.get(), folly::Range(hits_.data(), hits_.size()));
+  }
+}
+
+void ExprValueCache::insert(
+    const SelectivityVector& rows,
+    const std::vector<VectorPtr>& args,
+    const BaseVector& result) {
+  rows.applyToSelected([&](vector_size_t row) {
+    if (size_ == maxEntries_) {
+      clear();
+    }
+    const auto hash = hashes_[row];
+    // Keeps the first of the values with the same hash, which also skips the
+    // repeats of a value within the batch.
+    if (!entries_.emplace(hash, size_).second) {
+      return;
+    }
+    ensureCapacity();
+    for (auto i = 0; i < args.size(); ++i) {
+      VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+          copyValue, argTypes_[i]->kind(), *args[i], row, *args_[i], size_);
+    }
+    VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+        copyValue, resultType_->kind(), result, row, *values_, size_);
+    ++size_;
+  });
+}
+
+void ExprValueCache::clear() {
+  args_.clear();
+  for (const auto& type : argTypes_) {
+    args_.push_back(BaseVector::create(type, 0, pool_));
+  }
+  values_ = BaseVector::create(resultType_, 0, pool_);
+  size_ = 0;
+  entries_.clear();
+}
+
+void ExprValueCache::ensureCapacity() {
+  if (size_ < values_->size()) {
+    return;
+  }
+  const auto capacity =
+      std::min<vector_size_t>(maxEntries_, std::max(16, 2 * size_));
+  for (auto& arg : args_) {
+    arg->resize(capacity);
+  }
+  values_->resize(capacity);
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include "velox/vector/BaseVector.h"
+#include "velox/vector/SelectivityVector.h"
+
+namespace facebook::velox::exec {
+
+/// Bounded cache of the results of a deterministic function by the values of
+/// its arguments. Lets an Expr skip calling an expensive function for argument
+/// values seen in earlier batches, e.g. a regular expression over a low
+/// cardinality string column that is not dictionary encoded. An entry is found
+/// by the hash of the argument values of a row and is verified by comparing
+/// the values. The arguments and the result must be of primitive types. The
+/// cache starts over when it holds 'maxEntries' entries.
+class ExprValueCache {
+ public:
+  ExprValueCache(
+      std::vector<TypePtr> argTypes,
+      TypePtr resultType,
+      vector_size_t maxEntries,
+      memory::MemoryPool* pool);
+
+  /// Returns true if a function of 'argTypes' returning 'resultType' can be
+  /// cached.
+  static bool supportsTypes(
+      const std::vector<TypePtr>& argTypes,
+      const TypePtr& resultType);
+
+  /// Looks up 'rows' of 'args' and sets 'missingRows' to the rows that are not
+  /// in the cache. Remembers the other rows for copyHits(). Returns the number
+  /// of hits.
+  vector_size_t findHits(
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args,
+      SelectivityVector& missingRows);
+
+  /// Copies the cached results of the hits of the last findHits() into
+  /// 'result', which must be writable for these rows.
+  void copyHits(BaseVector& result) const;
+
+  /// Adds the results in 'result' for 'rows' of 'args'. 'rows' must be a
+  /// subset of the missing rows of the last findHits() without errors.
+  void insert(
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args,
+      const BaseVector& result);
+
+  vector_size_t size() const {
+    return size_;
+  }
+
+ private:
+  bool equalArgs(
+      const std::vector<VectorPtr>& args,
+      vector_size_t row,
+      vector_size_t entry) const;
+
+  // Drops all entries and makes new vectors for 'args_' and 'values_' so that
+  // results that reference the strings in the old ones stay valid.
+  void clear();
+
+  // Makes room for at least one more entry in 'args_' and 'values_'.
+  void ensureCapacity();
+
+  const std::vector<TypePtr> argTypes_;
+  const TypePtr resultType_;
+  const vector_size_t maxEntries_;
+  memory::MemoryPool* const pool_;
+
+  // The argument values of the entries, one flat vector per argument.
+  std::vector<VectorPtr> args_;
+  // The result of each entry.
+  VectorPtr values_;
+  vector_size_t size_{0};
+
+  // Hash of the argument values to the entry.
+  folly::F14FastMap<uint64_t, vector_size_t> entries_;
+
+  // Hashes of the rows of the last findHits(), indexed by row.
+  std::vector<uint64_t> hashes_;
+  // Hits of the last findHits() as copies from 'values_' to the result.
+  std::vector<BaseVector::CopyRange> hits_;
+};
+
+} // namespace facebook::velox::exec
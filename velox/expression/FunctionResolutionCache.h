@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/type/Type.h"
+
+namespace facebook::velox::exec {
+
+/// Caches the result of resolving a call of a function with given argument
+/// types, i.e. of binding the types to each signature of the function with
+/// SignatureBinder. Queries of the same shape resolve the same calls over and
+/// over, while the result only depends on the registered functions. The owner
+/// clears the cache when the functions it resolves change. Thread-safe.
+template <typename T>
+class FunctionResolutionCache {
+ public:
+  /// The cache is cleared when it exceeds this many entries.
+  static constexpr size_t kMaxEntries = 10'000;
+
+  std::optional<T> find(
+      const std::string& name,
+      const std::vector<TypePtr>& argTypes) const {
+    return entries_.withRLock([&](const auto& entries) -> std::optional<T> {
+      auto it = entries.find(Key{name, argTypes});
+      if (it == entries.end()) {
+        return std::nullopt;
+      }
+      return it->second;
+    });
+  }
+
+  void insert(
+      const std::string& name,
+      const std::vector<TypePtr>& argTypes,
+      T value) {
+    entries_.withWLock([&](auto& entries) {
+      if (entries.size() >= kMaxEntries) {
+        entries.clear();
+      }
+      entries.emplace(Key{name, argTypes}, std::move(value));
+    });
+  }
+
+  void clear() {
+    entries_.wlock()->clear();
+  }
+
+  size_t size() const {
+    return entries_.rlock()->size();
+  }
+
+ private:
+  struct Key {
+    std::string name;
+    std::vector<TypePtr> argTypes;
+
+    bool operator==(const Key& other) const {
+      if (name != other.name || argTypes.size() != other.argTypes.size()) {
+        return false;
+      }
+      for (auto i = 0; i < argTypes.size(); ++i) {
+        if (*argTypes[i] != *other.argTypes[i]) {
+          return false;
+        }
+      }
+      return true;
+    }
+  };
+
+  struct KeyHasher {
+    size_t operator()(const Key& key) const {
+      auto hash = std::hash<std::string>()(key.name);
+      for (const auto& type : key.argTypes) {
+        hash = bits::hashMix(hash, type->hashKind());
+      }
+      return hash;
+    }
+  };
+
+  folly::Synchronized<folly::F14FastMap<Key, T, KeyHasher>> entries_;
+};
+
+} // namespace facebook::velox::exec
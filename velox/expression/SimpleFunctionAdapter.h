@@ -62,6 +62,24 @@ struct udf_reuse_strings_from_arg<
     util::detail::void_t<decltype(T::reuse_strings_from_arg)>>
     : std::integral_constant<int32_t, T::reuse_strings_from_arg> {};
 
+// A simple function can set 'has_call_batch' and implement
+//
+//   void callBatch(TOut* out, const TIn1* in1, ..., vector_size_t size);
+//
+// to compute the results of 'size' rows at once, e.g. with xsimd. It is called
+// instead of call() when all rows are selected and all the arguments are flat
+// and have no nulls. 'out' may be the same as one of the inputs. The return
+// and argument types must be fixed width and not boolean, the function must
+// have the default null behavior, not produce nulls and not throw.
+template <class T, class = void>
+struct udf_has_call_batch : std::false_type {};
+
+template <class T>
+struct udf_has_call_batch<
+    T,
+    util::detail::void_t<decltype(T::has_call_batch)>>
+    : std::integral_constant<bool, T::has_call_batch> {};
+
 template <typename FUNC>
 class SimpleFunctionAdapter : public VectorFunction {
   using T = typename FUNC::exec_return_type;
@@ -133,6 +151,48 @@ class SimpleFunctionAdapter : public VectorFunction {
     }() && ...);
   }
 
+  // Whether callBatch() can be used for this UDF and its argument types. See
+  // udf_has_call_batch.
+  constexpr bool static callBatchEligible() {
+    if constexpr (
+        udf_has_call_batch<typename FUNC::udf_struct_t>() &&
+        FUNC::is_default_null_behavior && !FUNC::can_produce_null_output &&
+        fastPathIteration &&
+        return_type_traits::typeKind != TypeKind::BOOLEAN) {
+      return callBatchEligibleImpl(std::make_index_sequence<FUNC::num_args>());
+    } else {
+      return false;
+    }
+  }
+
+  template <size_t... Is>
+  constexpr bool static callBatchEligibleImpl(std::index_sequence<Is...>) {
+    return ([&]() {
+      if constexpr (isVariadicType<arg_at<Is>>::value) {
+        return false;
+      } else {
+        return SimpleTypeTrait<arg_at<Is>>::isPrimitiveType &&
+            SimpleTypeTrait<arg_at<Is>>::isFixedWidth &&
+            SimpleTypeTrait<arg_at<Is>>::typeKind != TypeKind::BOOLEAN;
+      }
+    }() && ...);
+  }
+
+  // Returns true if callBatch() can be used for 'rows' of 'args'.
+  static bool canCallBatch(
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) {
+    if (!rows.isAllSelected()) {
+      return false;
+    }
+    for (const auto& arg : args) {
+      if (!arg->isFlatEncoding() || arg->mayHaveNulls()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   /// When true, a fast path for each possible combination of encodings will be
   /// used for reading arguments when all arguments are flat or constant
   /// primitivies.
@@ -155,8 +215,9 @@ class SimpleFunctionAdapter : public VectorFunction {
         const TypePtr& outputType,
         EvalCtx& _context,
         VectorPtr& _result,
-        bool isResultReused)
-        : rows{_rows}, context{_context} {
+        bool isResultReused,
+        FUNC& _fn)
+        : rows{_rows}, context{_context}, fn{_fn} {
       // If we're reusing the input, we've already checked that the vector
       // is unique, as is nulls.  We also know the size of the vector is
       // at least as large as the size of rows.
@@ -177,13 +238,25 @@ class SimpleFunctionAdapter : public VectorFunction {
 
     template <typename Callable>
     void applyToSelectedNoThrow(Callable func) {
-      context.template applyToSelectedNoThrow<Callable>(*rows, func);
+      if constexpr (FUNC::udf_has_call_return_status) {
+        // The function returned an error Status for the row instead of
+        // throwing. The result for the row is null.
+        context.applyToSelectedNoThrow(*rows, [&](auto row) INLINE_LAMBDA {
+          func(row);
+          if (UNLIKELY(fn.hasError())) {
+            context.setStatus(row, fn.takeStatus());
+          }
+        });
+      } else {
+        context.template applyToSelectedNoThrow<Callable>(*rows, func);
+      }
     }
 
     const SelectivityVector* rows;
     result_vector_t* result;
     VectorWriter<typename FUNC::return_type> resultWriter;
     EvalCtx& context;
+    FUNC& fn;
     bool allAscii{false};
     bool mayHaveNullsRecursive{false};
   };
@@ -300,7 +373,7 @@ class SimpleFunctionAdapter : public VectorFunction {
     }
 
     ApplyContext applyContext{
-        &rows, outputType, context, *reusableResult, isResultReused};
+        &rows, outputType, context, *reusableResult, isResultReused, *fn_};
 
     // If the function provides an initialize() method and it threw, we set that
     // exception in all active rows and we're done with it.
@@ -332,6 +405,17 @@ class SimpleFunctionAdapter : public VectorFunction {
       }
     }
 
+    if constexpr (callBatchEligible()) {
+      if (canCallBatch(rows, args)) {
+        callBatch(
+            applyContext, args, std::make_index_sequence<FUNC::num_args>());
+        if (isResultReused) {
+          result = std::move(*reusableResult);
+        }
+        return;
+      }
+    }
+
     std::vector<std::optional<LocalDecodedVector>> decoded;
     if (allPrimitiveArgsFlatConstant(args)) {
       if constexpr (
@@ -432,6 +516,22 @@ class SimpleFunctionAdapter : public VectorFunction {
   }
 
  private:
+  // Computes all rows at once with the callBatch() of the UDF. All 'args' are
+  // flat without nulls.
+  template <size_t... Is>
+  void callBatch(
+      ApplyContext& applyContext,
+      const std::vector<VectorPtr>& args,
+      std::index_sequence<Is...>) const {
+    (*fn_).callBatch(
+        applyContext.result->mutableRawValues(),
+        args[Is]
+            ->template asUnchecked<FlatVector<
+                typename VectorExec::template resolver<arg_at<Is>>::in_type>>()
+            ->rawValues()...,
+        applyContext.rows->end());
+  }
+
   // This is called only when we know that all args are flat or constant and are
   // eligible for the optimization and the optimization is enabled.
   template <int32_t POSITION, typename... TReader>
@@ -42,6 +42,7 @@ void SimpleFunctionRegistry::registerFunctionInternal(
     SignatureMap& signatureMap = map[sanitizedName];
     signatureMap[*metadata->signature()] =
         std::make_unique<const FunctionEntry>(metadata, factory);
+    resolutions_.clear();
   });
 }
 
@@ -79,6 +80,10 @@ SimpleFunctionRegistry::resolveFunction(
   const FunctionEntry* selectedCandidate = nullptr;
   TypePtr selectedCandidateType = nullptr;
   registeredFunctions_.withRLock([&](const auto& map) {
+    if (auto cached = resolutions_.find(name, argTypes)) {
+      std::tie(selectedCandidate, selectedCandidateType) = cached.value();
+      return;
+    }
     if (const auto* signatureMap = getSignatureMap(name, map)) {
       for (const auto& [candidateSignature, functionEntry] : *signatureMap) {
         SignatureBinder binder(candidateSignature, argTypes);
@@ -93,6 +98,8 @@ SimpleFunctionRegistry::resolveFunction(
         }
       }
     }
+    resolutions_.insert(
+        name, argTypes, {selectedCandidate, selectedCandidateType});
   });
 
   VELOX_DCHECK(!selectedCandidate || selectedCandidateType);
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "velox/core/SimpleFunctionMetadata.h"
+#include "velox/expression/FunctionResolutionCache.h"
 #include "velox/expression/SignatureBinder.h"
 #include "velox/expression/SimpleFunctionAdapter.h"
 #include "velox/type/Type.h"
@@ -85,7 +86,10 @@ class SimpleFunctionRegistry {
   }
 
   void clearRegistry() {
-    registeredFunctions_.withWLock([&](auto& map) { map.clear(); });
+    registeredFunctions_.withWLock([&](auto& map) {
+      map.clear();
+      resolutions_.clear();
+    });
   }
 
   std::vector<const FunctionSignature*> getFunctionSignatures(
@@ -131,6 +135,13 @@ class SimpleFunctionRegistry {
       const FunctionFactory& factory);
 
   folly::Synchronized<FunctionMap> registeredFunctions_;
+
+  // The function entry and return type by function name and argument types.
+  // The entry is nullptr if no signature matches. Is cleared with the write
+  // lock on 'registeredFunctions_' held whenever a function is registered, so
+  // the entries are valid while a read lock is held.
+  mutable FunctionResolutionCache<std::pair<const FunctionEntry*, TypePtr>>
+      resolutions_;
 };
 
 const SimpleFunctionRegistry& simpleFunctions();
@@ -17,6 +17,7 @@
 #include <unordered_map>
 #include "folly/Singleton.h"
 #include "folly/Synchronized.h"
+#include "folly/synchronization/CallOnce.h"
 #include "velox/expression/SignatureBinder.h"
 
 namespace facebook::velox::exec {
@@ -38,20 +39,41 @@ std::optional<std::vector<FunctionSignaturePtr>> getVectorFunctionSignatures(
       });
 }
 
-std::shared_ptr<const Type> resolveVectorFunction(
-    const std::string& functionName,
+namespace {
+// Returns the return type of the first signature of 'entry' that 'argTypes'
+// bind to, or nullptr if none does.
+TypePtr resolveVectorFunctionEntry(
+    const VectorFunctionEntry& entry,
+    const std::string& sanitizedName,
     const std::vector<TypePtr>& argTypes) {
-  if (auto vectorFunctionSignatures =
-          exec::getVectorFunctionSignatures(functionName)) {
-    for (const auto& signature : vectorFunctionSignatures.value()) {
-      exec::SignatureBinder binder(*signature, argTypes);
-      if (binder.tryBind()) {
-        return binder.tryResolveReturnType();
-      }
+  if (auto cached = entry.resolutions->find(sanitizedName, argTypes)) {
+    return cached.value();
+  }
+  TypePtr returnType;
+  for (const auto& signature : entry.signatures) {
+    exec::SignatureBinder binder(*signature, argTypes);
+    if (binder.tryBind()) {
+      returnType = binder.tryResolveReturnType();
+      break;
     }
   }
+  entry.resolutions->insert(sanitizedName, argTypes, returnType);
+  return returnType;
+}
+} // namespace
 
-  return nullptr;
+std::shared_ptr<const Type> resolveVectorFunction(
+    const std::string& functionName,
+    const std::vector<TypePtr>& argTypes) {
+  auto sanitizedName = sanitizeName(functionName);
+  return vectorFunctionFactories().withRLock(
+      [&](const auto& functionMap) -> TypePtr {
+        auto it = functionMap.find(sanitizedName);
+        if (it == functionMap.end()) {
+          return nullptr;
+        }
+        return resolveVectorFunctionEntry(it->second, sanitizedName, argTypes);
+      });
 }
 
 std::shared_ptr<VectorFunction> getVectorFunction(
@@ -80,10 +102,10 @@ std::shared_ptr<VectorFunction> getVectorFunction(
   return vectorFunctionFactories().withRLock(
       [&sanitizedName, &inputArgs, &config, &inputTypes](
           auto& functionMap) -> std::shared_ptr<VectorFunction> {
-        if (resolveVectorFunction(sanitizedName, inputTypes)) {
-          auto functionIterator = functionMap.find(sanitizedName);
-          return functionIterator->second.factory(
-              sanitizedName, inputArgs, config);
+        auto it = functionMap.find(sanitizedName);
+        if (it != functionMap.end() &&
+            resolveVectorFunctionEntry(it->second, sanitizedName, inputTypes)) {
+          return it->second.factory(sanitizedName, inputArgs, config);
         }
         return nullptr;
       });
@@ -133,6 +155,33 @@ bool registerVectorFunction(
       name, signatures, factory, metadata, overwrite);
 }
 
+bool registerLazyVectorFunction(
+    const std::string& name,
+    std::vector<FunctionSignaturePtr> signatures,
+    VectorFunctionMaker maker,
+    VectorFunctionMetadata metadata,
+    bool overwrite) {
+  struct LazyFunction {
+    folly::once_flag once;
+    VectorFunctionMaker maker;
+    std::shared_ptr<VectorFunction> function;
+  };
+  auto lazy = std::make_shared<LazyFunction>();
+  lazy->maker = std::move(maker);
+  auto factory = [lazy](
+                     const auto& /*name*/,
+                     const auto& /*vectorArg*/,
+                     const auto& /*config*/) {
+    folly::call_once(lazy->once, [&]() {
+      lazy->function = lazy->maker();
+      lazy->maker = nullptr;
+    });
+    return lazy->function;
+  };
+  return registerStatefulVectorFunction(
+      name, std::move(signatures), factory, metadata, overwrite);
+}
+
 std::vector<ExpressionRewrite>& expressionRewrites() {
   static std::vector<ExpressionRewrite> rewrites;
   return rewrites;
@@ -142,4 +191,13 @@ void registerExpressionRewrite(ExpressionRewrite rewrite) {
   expressionRewrites().emplace_back(rewrite);
 }
 
+std::vector<ExprSetRewrite>& exprSetRewrites() {
+  static std::vector<ExprSetRewrite> rewrites;
+  return rewrites;
+}
+
+void registerExprSetRewrite(ExprSetRewrite rewrite) {
+  exprSetRewrites().emplace_back(rewrite);
+}
+
 } // namespace facebook::velox::exec
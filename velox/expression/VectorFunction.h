@@ -19,6 +19,7 @@
 #include <vector>
 #include "velox/core/Expressions.h"
 #include "velox/expression/EvalCtx.h"
+#include "velox/expression/FunctionResolutionCache.h"
 #include "velox/expression/FunctionSignature.h"
 #include "velox/vector/SelectivityVector.h"
 #include "velox/vector/SimpleVector.h"
@@ -213,6 +214,19 @@ bool registerVectorFunction(
     VectorFunctionMetadata metadata = {},
     bool overwrite = true);
 
+using VectorFunctionMaker = std::function<std::unique_ptr<VectorFunction>()>;
+
+/// Same as registerVectorFunction() but makes the instance with 'maker' when
+/// the function is first used in an expression instead of at registration.
+/// Keeps registering many functions, most of which a process may never use,
+/// down to recording their signatures.
+bool registerLazyVectorFunction(
+    const std::string& name,
+    std::vector<FunctionSignaturePtr> signatures,
+    VectorFunctionMaker maker,
+    VectorFunctionMetadata metadata = {},
+    bool overwrite = true);
+
 // Represents arguments for stateful vector functions. Stores element type, and
 // the constant value (if supplied).
 struct VectorFunctionArg {
@@ -229,6 +243,10 @@ struct VectorFunctionEntry {
   std::vector<FunctionSignaturePtr> signatures;
   VectorFunctionFactory factory;
   VectorFunctionMetadata metadata;
+  // Return types by argument types, nullptr if no signature matches. Goes
+  // away with the entry when the function is re-registered.
+  std::shared_ptr<FunctionResolutionCache<TypePtr>> resolutions{
+      std::make_shared<FunctionResolutionCache<TypePtr>>()};
 };
 
 // TODO: Use folly::Singleton here
@@ -281,23 +299,52 @@ std::vector<ExpressionRewrite>& expressionRewrites();
 /// non-null result terminates the re-write for this particular expression.
 void registerExpressionRewrite(ExpressionRewrite rewrite);
 
+/// A re-writer that takes all the expressions of an ExprSet and returns
+/// equivalent expressions, or an empty vector if re-write is not possible.
+/// Unlike an ExpressionRewrite, it sees all the expressions together and can
+/// combine the work they share, e.g. replace similar calls on the same input
+/// with a common subexpression that is evaluated once.
+using ExprSetRewrite = std::function<std::vector<core::TypedExprPtr>(
+    const std::vector<core::TypedExprPtr>&)>;
+
+/// Returns a list of registered ExprSet re-writes.
+std::vector<ExprSetRewrite>& exprSetRewrites();
+
+/// Appends a 'rewrite' to 'exprSetRewrites'. Re-writes are applied before
+/// compiling an ExprSet in the order they were registered, each to the output
+/// of the previous one, and before the per-expression re-writes.
+void registerExprSetRewrite(ExprSetRewrite rewrite);
+
 } // namespace facebook::velox::exec
 
 // Private. Return the external function name given a UDF tag.
 #define _VELOX_REGISTER_FUNC_NAME(tag) registerVectorFunction_##tag
 
+// Private. Wraps the expression making a vectorized UDF into a maker that
+// defers evaluating it until first use.
+#define _VELOX_VECTOR_FUNCTION_MAKER(function)                      \
+  [=]() -> std::unique_ptr<facebook::velox::exec::VectorFunction> { \
+    return (function);                                              \
+  }
+
 // Declares a vectorized UDF function given a tag. Goes into the UDF .cpp file.
+// 'function' is evaluated when the function is first used.
 #define VELOX_DECLARE_VECTOR_FUNCTION(tag, signatures, function) \
   void _VELOX_REGISTER_FUNC_NAME(tag)(const std::string& name) { \
-    facebook::velox::exec::registerVectorFunction(               \
-        (name), (signatures), (function));                       \
+    facebook::velox::exec::registerLazyVectorFunction(           \
+        (name),                                                  \
+        (signatures),                                            \
+        _VELOX_VECTOR_FUNCTION_MAKER(function));                 \
   }
 
 #define VELOX_DECLARE_VECTOR_FUNCTION_WITH_METADATA(             \
     tag, signatures, metadata, function)                         \
   void _VELOX_REGISTER_FUNC_NAME(tag)(const std::string& name) { \
-    facebook::velox::exec::registerVectorFunction(               \
-        (name), (signatures), (function), (metadata));           \
+    facebook::velox::exec::registerLazyVectorFunction(           \
+        (name),                                                  \
+        (signatures),                                            \
+        _VELOX_VECTOR_FUNCTION_MAKER(function),                  \
+        (metadata));                                             \
   }
 
 // Declares a stateful vectorized UDF.
@@ -29,19 +29,30 @@ class CastBenchmark : public functions::test::FunctionBenchmarkBase {
 
   size_t doRun(const TypePtr& inputType, const TypePtr& outputType) {
     folly::BenchmarkSuspender suspender;
+    facebook::velox::VectorFuzzer fuzzer({}, pool());
+    // With encodings, evalMemo can get invoked which does a copy and adds a lot
+    // of overhead.
+    auto input = fuzzer.fuzzFlatNotNull(inputType);
+    suspender.dismiss();
+
+    return doRun(input, outputType);
+  }
+
+  // Casts 'input' to 'outputType'. Uses try_cast if 'nullOnFailure' is set.
+  size_t doRun(
+      const VectorPtr& input,
+      const TypePtr& outputType,
+      bool nullOnFailure = false) {
+    folly::BenchmarkSuspender suspender;
     std::string colName = "c0";
     std::vector<facebook::velox::core::TypedExprPtr> inputs{
         std::make_shared<facebook::velox::core::FieldAccessTypedExpr>(
-            inputType, colName)};
+            input->type(), colName)};
     std::vector<facebook::velox::core::TypedExprPtr> expr{
         std::make_shared<facebook::velox::core::CastTypedExpr>(
-            outputType, inputs, false)};
+            outputType, inputs, nullOnFailure)};
     exec::ExprSet exprSet(expr, &execCtx_);
 
-    facebook::velox::VectorFuzzer fuzzer({}, pool());
-    // With encodings, evalMemo can get invoked which does a copy and adds a lot
-    // of overhead.
-    auto input = fuzzer.fuzzFlatNotNull(inputType);
     auto rowVector = vectorMaker_.rowVector({colName}, {input});
     suspender.dismiss();
 
@@ -69,6 +80,52 @@ BENCHMARK_MULTI(scalar) {
   return benchmark.doRun(INTEGER(), BIGINT());
 }
 
+BENCHMARK_MULTI(bigintToVarchar) {
+  folly::BenchmarkSuspender suspender;
+  CastBenchmark benchmark;
+  suspender.dismiss();
+
+  return benchmark.doRun(BIGINT(), VARCHAR());
+}
+
+BENCHMARK_MULTI(varcharToBigint) {
+  folly::BenchmarkSuspender suspender;
+  CastBenchmark benchmark;
+  auto input = benchmark.maker().flatVector<std::string>(
+      10'000, [&](auto row) {
+        return fmt::format("{}", row * 7'919 - 1'000'000);
+      });
+  suspender.dismiss();
+
+  return benchmark.doRun(input, BIGINT());
+}
+
+BENCHMARK_MULTI(varcharToDouble) {
+  folly::BenchmarkSuspender suspender;
+  CastBenchmark benchmark;
+  auto input = benchmark.maker().flatVector<std::string>(
+      10'000, [&](auto row) {
+        return fmt::format("{}", row * 0.37 - 1'000);
+      });
+  suspender.dismiss();
+
+  return benchmark.doRun(input, DOUBLE());
+}
+
+// Every other string is not a number.
+BENCHMARK_MULTI(tryCastInvalidVarcharToBigint) {
+  folly::BenchmarkSuspender suspender;
+  CastBenchmark benchmark;
+  auto input = benchmark.maker().flatVector<std::string>(
+      10'000, [&](auto row) {
+        return row % 2 == 0 ? fmt::format("{}", row)
+                            : fmt::format("a{}", row);
+      });
+  suspender.dismiss();
+
+  return benchmark.doRun(input, BIGINT(), true);
+}
+
 BENCHMARK_MULTI(renameSmallStruct) {
   folly::BenchmarkSuspender suspender;
   CastBenchmark benchmark;
@@ -17,6 +17,9 @@
 #include <folly/Benchmark.h>
 #include <folly/init/Init.h>
 
+#include "velox/common/base/CheckedArithmetic.h"
+#include "velox/functions/Macros.h"
+#include "velox/functions/Registerer.h"
 #include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
 #include "velox/functions/prestosql/registration/RegistrationFunctions.h"
 
@@ -29,8 +32,9 @@
 // caught in these benchmarks.
 // 2) Benchmark the performance impact of throwing exceptions and catching them
 // using Try.
-// It divides two integers, using division by 0 to trigger an exception getting
-// thrown.
+// It divides two integers, using division by 0 to trigger an error. divide()
+// returns the error as a Status. throwing_divide() throws it, which shows the
+// cost of the exceptions.
 // These benchmarks show that meerly adding a Try expression does not
 // significantly impact performance, and the performance cost of handling
 // exceptions scales linearly with the number of rows that saw exceptions.
@@ -38,10 +42,20 @@
 using namespace facebook::velox;
 
 namespace {
+template <typename T>
+struct ThrowingDivideFunction {
+  FOLLY_ALWAYS_INLINE void
+  call(int32_t& result, const int32_t& a, const int32_t& b) {
+    result = checkedDivide(a, b);
+  }
+};
+
 class TryBenchmark : public functions::test::FunctionBenchmarkBase {
  public:
   TryBenchmark() : FunctionBenchmarkBase() {
     functions::prestosql::registerAllScalarFunctions();
+    registerFunction<ThrowingDivideFunction, int32_t, int32_t, int32_t>(
+        {"throwing_divide"});
   }
 
   RowVectorPtr makeData(vector_size_t numArgs) {
@@ -144,6 +158,24 @@ class TryBenchmark : public functions::test::FunctionBenchmarkBase {
     return doRun(exprSet, rowVector);
   }
 
+  // Divides by 0 in one of every 'errorEvery' rows.
+  size_t runDivisionWithErrors(
+      const std::string& function,
+      vector_size_t errorEvery) {
+    folly::BenchmarkSuspender suspender;
+    auto numerators = makeData(1)->childAt(0);
+    auto denominators = vectorMaker_.flatVector<int32_t>(
+        numerators->size(),
+        [&](auto row) { return row % errorEvery == 0 ? 0 : 1; });
+    auto rowVector = vectorMaker_.rowVector({numerators, denominators});
+
+    auto exprSet = compileExpression(
+        fmt::format("TRY({}(c0, c1))", function), rowVector->type());
+    suspender.dismiss();
+
+    return doRun(exprSet, rowVector);
+  }
+
   size_t doRun(exec::ExprSet& exprSet, const RowVectorPtr& rowVector) {
     int cnt = 0;
     for (auto i = 0; i < 100; i++) {
@@ -182,6 +214,16 @@ BENCHMARK_MULTI(divideAllExceptions) {
   TryBenchmark benchmark;
   return benchmark.runDivisionWithAllExceptions();
 }
+
+BENCHMARK_MULTI(divideFivePercentErrors) {
+  TryBenchmark benchmark;
+  return benchmark.runDivisionWithErrors("divide", 20);
+}
+
+BENCHMARK_MULTI(throwingDivideFivePercentErrors) {
+  TryBenchmark benchmark;
+  return benchmark.runDivisionWithErrors("throwing_divide", 20);
+}
 } // namespace
 
 int main(int argc, char** argv) {
@@ -967,6 +967,59 @@ TEST_F(CastExprTest, errorHandling) {
       "tinyint", {"1", "2", "3", "100", "-100.5"}, {1, 2, 3, 100, -100}, true);
 }
 
+TEST_F(CastExprTest, stringToNumber) {
+  testCast<std::string, int64_t>(
+      "bigint",
+      {"9223372036854775807", "-9223372036854775808", " 12", "+7", "0"},
+      {std::numeric_limits<int64_t>::max(),
+       std::numeric_limits<int64_t>::min(),
+       12,
+       7,
+       0});
+  testCast<std::string, int16_t>(
+      "smallint",
+      {"32768", "-32769", "1.5", "abc", "12", std::nullopt},
+      {std::nullopt,
+       std::nullopt,
+       std::nullopt,
+       std::nullopt,
+       12,
+       std::nullopt},
+      false,
+      true);
+  testCast<std::string, double>(
+      "double",
+      {"1.5", "-1e10", "x1.5", "1.5x", std::nullopt},
+      {1.5, -1e10, std::nullopt, std::nullopt, std::nullopt},
+      false,
+      true);
+
+  // Invalid input reports the same error as folly::to.
+  auto data = makeRowVector({makeFlatVector<StringView>({"12", "1a"})});
+  VELOX_ASSERT_THROW(
+      evaluate("cast(c0 as integer)", data),
+      "Failed to cast from VARCHAR to INTEGER: 1a. Non-whitespace character "
+      "found after end of conversion: \"a\"");
+  data = makeRowVector({makeFlatVector<StringView>({"2147483648"})});
+  VELOX_ASSERT_THROW(
+      evaluate("cast(c0 as integer)", data),
+      "Failed to cast from VARCHAR to INTEGER: 2147483648. Overflow");
+}
+
+TEST_F(CastExprTest, integerToString) {
+  testCast<int8_t, std::string>(
+      "varchar",
+      {-128, 0, 127, std::nullopt},
+      {"-128", "0", "127", std::nullopt});
+  testCast<int64_t, std::string>(
+      "varchar",
+      {std::numeric_limits<int64_t>::min(),
+       std::numeric_limits<int64_t>::max(),
+       -1,
+       std::nullopt},
+      {"-9223372036854775808", "9223372036854775807", "-1", std::nullopt});
+}
+
 constexpr vector_size_t kVectorSize = 1'000;
 
 TEST_F(CastExprTest, mapCast) {
@@ -19,6 +19,7 @@
 
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/expression/EvalCtx.h"
+#include "velox/expression/Expr.h"
 #include "velox/vector/tests/utils/VectorTestBase.h"
 
 using namespace facebook::velox;
@@ -221,3 +222,65 @@ TEST_F(EvalCtxTest, localSingleRow) {
     }
   }
 }
+
+TEST_F(EvalCtxTest, cachedDecodedVector) {
+  auto base = makeFlatVector<int64_t>(10, [](auto row) { return row; });
+  auto dictionary = wrapInDictionary(makeIndicesInReverse(10), base);
+  auto data = makeRowVector({dictionary, makeFlatVector<int32_t>({1, 2})});
+  auto queryCtx = std::make_shared<core::QueryCtx>();
+  core::ExecCtx execCtx(pool(), queryCtx.get());
+  ExprSet exprSet({}, &execCtx);
+  EvalCtx context(&execCtx, &exprSet, data.get());
+
+  SelectivityVector allRows(10);
+  SelectivityVector someRows(10, false);
+  someRows.setValid(3, true);
+  someRows.updateBounds();
+
+  LocalDecodedVector decoded(context, *dictionary, allRows);
+  ASSERT_EQ(decoded->valueAt<int64_t>(0), 9);
+
+  // The same column for the same rows or a subset of them reuses the decoded
+  // vector.
+  {
+    LocalDecodedVector same(context, *dictionary, allRows);
+    ASSERT_EQ(same.get(), decoded.get());
+    LocalDecodedVector subset(context, *dictionary, someRows);
+    ASSERT_EQ(subset.get(), decoded.get());
+    ASSERT_EQ(subset->valueAt<int64_t>(3), 6);
+  }
+
+  // So does a vector wrapped by a column.
+  {
+    LocalDecodedVector inner(context, *base, allRows);
+    LocalDecodedVector other(context, *base, allRows);
+    ASSERT_EQ(inner.get(), other.get());
+    ASSERT_NE(inner.get(), decoded.get());
+  }
+
+  // A superset of the rows is decoded again.
+  {
+    EvalCtx otherContext(&execCtx, &exprSet, data.get());
+    LocalDecodedVector first(otherContext, *dictionary, someRows);
+    LocalDecodedVector second(otherContext, *dictionary, allRows);
+    ASSERT_NE(first.get(), second.get());
+    ASSERT_EQ(second->valueAt<int64_t>(9), 0);
+  }
+
+  // Vectors that are not input columns are not shared.
+  {
+    auto notInput = wrapInDictionary(makeIndicesInReverse(10), base);
+    LocalDecodedVector first(context, *notInput, allRows);
+    LocalDecodedVector second(context, *notInput, allRows);
+    ASSERT_NE(first.get(), second.get());
+    ASSERT_EQ(second->valueAt<int64_t>(0), 9);
+  }
+
+  // A context without an input row does not share decoded vectors.
+  {
+    EvalCtx noInput(&execCtx);
+    LocalDecodedVector first(noInput, *dictionary, allRows);
+    LocalDecodedVector second(noInput, *dictionary, allRows);
+    ASSERT_NE(first.get(), second.get());
+  }
+}
@@ -449,3 +449,63 @@ TEST_F(ExprStatsTest, exceptionPreparingStatsForListener) {
   evaluate(*exprSet, makeRowVector({varbinaryData}));
   ASSERT_TRUE(exec::unregisterExprSetListener(listener));
 }
+
+TEST_F(ExprStatsTest, valueCache) {
+  queryCtx_->testingOverrideConfigUnsafe({
+      {core::QueryConfig::kExprValueCacheFunctions, "regexp_extract, upper"},
+      {core::QueryConfig::kExprValueCacheMaxEntries, "100"},
+  });
+
+  const vector_size_t size = 1'000;
+  // 10 distinct values, each batch in a different order and not dictionary
+  // encoded.
+  auto makeData = [&](int32_t batch) {
+    return makeRowVector({makeFlatVector<std::string>(size, [&](auto row) {
+      return fmt::format("value {}", (row + batch) % 10);
+    })});
+  };
+  auto rowType = asRowType(makeData(0)->type());
+  auto cachedExprSet =
+      compileExpressions({"regexp_extract(c0, '[0-9]+')"}, rowType);
+  auto uncachedExprSet = compileExpressions({"lower(c0)"}, rowType);
+
+  const int32_t numBatches = 3;
+  for (auto batch = 0; batch < numBatches; ++batch) {
+    auto data = makeData(batch);
+    auto result = evaluate(*cachedExprSet, data);
+    assertEqualVectors(
+        makeFlatVector<std::string>(
+            size,
+            [&](auto row) { return fmt::format("{}", (row + batch) % 10); }),
+        result);
+    evaluate(*uncachedExprSet, data);
+  }
+
+  // All rows of the first batch miss the cache, the rows of the other batches
+  // are all hits.
+  auto stats = cachedExprSet->stats();
+  ASSERT_EQ(size, stats.at("regexp_extract").numValueCacheMisses);
+  ASSERT_EQ(
+      (numBatches - 1) * size, stats.at("regexp_extract").numValueCacheHits);
+  ASSERT_NEAR(
+      2.0 / 3, stats.at("regexp_extract").valueCacheHitRate(), 0.0001);
+
+  stats = uncachedExprSet->stats();
+  ASSERT_EQ(0, stats.at("lower").numValueCacheHits);
+  ASSERT_EQ(0, stats.at("lower").numValueCacheMisses);
+
+  // More distinct values than the cache holds. The cache starts over every 100
+  // values, so only the last 100 values of the first batch are hits in the
+  // second batch.
+  auto data = makeRowVector({makeFlatVector<std::string>(
+      size, [](auto row) { return fmt::format("value {}", row); })});
+  auto exprSet = compileExpressions({"upper(c0)"}, rowType);
+  for (auto batch = 0; batch < 2; ++batch) {
+    assertEqualVectors(
+        makeFlatVector<std::string>(
+            size, [](auto row) { return fmt::format("VALUE {}", row); }),
+        evaluate(*exprSet, data));
+  }
+  ASSERT_EQ(100, exprSet->stats().at("upper").numValueCacheHits);
+  ASSERT_EQ(2 * size - 100, exprSet->stats().at("upper").numValueCacheMisses);
+}
@@ -452,6 +452,48 @@ TEST_F(ExprTest, reorder) {
   }
 }
 
+TEST_F(ExprTest, reorderAcrossExprSets) {
+  constexpr int32_t kTestSize = 20'000;
+
+  auto data = makeRowVector(
+      {makeFlatVector<int64_t>(kTestSize, [](auto row) { return row; })});
+  const std::string expression = "c0 % 409 < 300 and c0 % 103 < 30";
+  auto exprSet = compileExpression(expression, asRowType(data->type()));
+  auto condition =
+      std::dynamic_pointer_cast<exec::ConjunctExpr>(exprSet->expr(0));
+  ASSERT_TRUE(condition != nullptr);
+
+  // An order learned by another ExprSet of the query is used from the first
+  // batch on.
+  queryCtx_->setConjunctOrder(condition->toString(), {1, 0});
+  evaluate(exprSet.get(), data);
+
+  vector_size_t numPassedFirst = 0;
+  vector_size_t numPassedSecond = 0;
+  for (auto i = 0; i < kTestSize; ++i) {
+    numPassedFirst += i % 409 < 300;
+    numPassedSecond += i % 103 < 30;
+  }
+  bool secondEvaluatedFirst = false;
+  for (auto i = 0; i < condition->inputs().size(); ++i) {
+    const auto& selectivity = condition->selectivityAt(i);
+    if (selectivity.numIn() == kTestSize &&
+        selectivity.numOut() == numPassedSecond) {
+      secondEvaluatedFirst = true;
+    }
+  }
+  ASSERT_TRUE(secondEvaluatedFirst);
+
+  // Without adaptive reordering the order in the plan is kept.
+  queryCtx_->testingOverrideConfigUnsafe(
+      {{core::QueryConfig::kAdaptiveFilterReorderingEnabled, "false"}});
+  exprSet = compileExpression(expression, asRowType(data->type()));
+  condition = std::dynamic_pointer_cast<exec::ConjunctExpr>(exprSet->expr(0));
+  evaluate(exprSet.get(), data);
+  ASSERT_EQ(condition->selectivityAt(0).numIn(), kTestSize);
+  ASSERT_EQ(condition->selectivityAt(0).numOut(), numPassedFirst);
+}
+
 TEST_F(ExprTest, constant) {
   auto exprSet = compileExpression("1 + 2 + 3 + 4", ROW({}));
   auto constExpr = dynamic_cast<exec::ConstantExpr*>(exprSet->expr(0).get());
@@ -212,7 +212,102 @@ TEST_F(ExprToSubfieldFilterTest, like) {
   auto call = parseCallExpr("a like 'foo%'", ROW({{"a", VARCHAR()}}));
   Subfield subfield;
   auto filter = leafCallToSubfieldFilter(*call, subfield, evaluator());
-  ASSERT_FALSE(filter);
+  ASSERT_TRUE(filter);
+  validateSubfield(subfield, {"a"});
+  ASSERT_TRUE(filter->testBytes("foo", 3));
+  ASSERT_TRUE(filter->testBytes("foobar", 6));
+  ASSERT_FALSE(filter->testBytes("fo", 2));
+  ASSERT_FALSE(filter->testBytes("fop", 3));
+  ASSERT_FALSE(filter->testNull());
+
+  call = parseCallExpr("a like 'foo'", ROW({{"a", VARCHAR()}}));
+  filter = leafCallToSubfieldFilter(*call, subfield, evaluator());
+  ASSERT_TRUE(filter);
+  ASSERT_TRUE(filter->testBytes("foo", 3));
+  ASSERT_FALSE(filter->testBytes("foobar", 6));
+
+  call = parseCallExpr("a like 'f#%o%' escape '#'", ROW({{"a", VARCHAR()}}));
+  filter = leafCallToSubfieldFilter(*call, subfield, evaluator());
+  ASSERT_TRUE(filter);
+  ASSERT_TRUE(filter->testBytes("f%oo", 4));
+  ASSERT_FALSE(filter->testBytes("fxoo", 4));
+
+  // Patterns with wildcards other than a trailing '%' are not converted.
+  for (const auto* pattern : {"a like 'f_o%'", "a like '%foo'"}) {
+    call = parseCallExpr(pattern, ROW({{"a", VARCHAR()}}));
+    ASSERT_FALSE(leafCallToSubfieldFilter(*call, subfield, evaluator()));
+  }
+  call = parseCallExpr("a like 'foo%'", ROW({{"a", VARCHAR()}}));
+  ASSERT_FALSE(leafCallToSubfieldFilter(*call, subfield, evaluator(), true));
+}
+
+TEST_F(ExprToSubfieldFilterTest, startsWith) {
+  auto call = std::make_shared<core::CallTypedExpr>(
+      BOOLEAN(),
+      std::vector<core::TypedExprPtr>{
+          std::make_shared<core::FieldAccessTypedExpr>(VARCHAR(), "a"),
+          std::make_shared<core::ConstantTypedExpr>(
+              VARCHAR(), variant("ab\xff"))},
+      "starts_with");
+  Subfield subfield;
+  auto filter = leafCallToSubfieldFilter(*call, subfield, evaluator());
+  ASSERT_TRUE(filter);
+  validateSubfield(subfield, {"a"});
+  ASSERT_TRUE(filter->testBytes("ab\xff", 3));
+  ASSERT_TRUE(filter->testBytes("ab\xff\xff", 4));
+  ASSERT_FALSE(filter->testBytes("ab", 2));
+  ASSERT_FALSE(filter->testBytes("ac", 2));
+}
+
+TEST_F(ExprToSubfieldFilterTest, wideningCast) {
+  auto call = parseCallExpr("cast(a as bigint) = 5", ROW({{"a", INTEGER()}}));
+  Subfield subfield;
+  auto filter = leafCallToSubfieldFilter(*call, subfield, evaluator());
+  ASSERT_TRUE(filter);
+  validateSubfield(subfield, {"a"});
+  ASSERT_TRUE(filter->testInt64(5));
+  ASSERT_FALSE(filter->testInt64(6));
+
+  call = parseCallExpr("cast(a as bigint) in (1, 3)", ROW({{"a", SMALLINT()}}));
+  filter = leafCallToSubfieldFilter(*call, subfield, evaluator());
+  ASSERT_TRUE(filter);
+  ASSERT_TRUE(filter->testInt64(3));
+  ASSERT_FALSE(filter->testInt64(2));
+
+  // Narrowing casts change the values.
+  call = parseCallExpr("cast(a as smallint) = 5", ROW({{"a", BIGINT()}}));
+  ASSERT_FALSE(leafCallToSubfieldFilter(*call, subfield, evaluator()));
+}
+
+TEST_F(ExprToSubfieldFilterTest, timestampToDate) {
+  const auto rowType = ROW({{"a", TIMESTAMP()}});
+  // 2023-01-02 is day 19'359.
+  const Timestamp dayStart(19'359 * 86'400, 0);
+  const Timestamp dayEnd(19'360 * 86'400 - 1, 999'999'999);
+  const Timestamp nextDay(19'360 * 86'400, 0);
+
+  auto call =
+      parseCallExpr("cast(a as date) = cast('2023-01-02' as date)", rowType);
+  Subfield subfield;
+  auto filter = leafCallToSubfieldFilter(*call, subfield, evaluator());
+  ASSERT_TRUE(filter);
+  validateSubfield(subfield, {"a"});
+  ASSERT_FALSE(filter->testTimestamp(Timestamp(19'359 * 86'400 - 1, 0)));
+  ASSERT_TRUE(filter->testTimestamp(dayStart));
+  ASSERT_TRUE(filter->testTimestamp(dayEnd));
+  ASSERT_FALSE(filter->testTimestamp(nextDay));
+
+  call = parseCallExpr("cast(a as date) > cast('2023-01-02' as date)", rowType);
+  filter = leafCallToSubfieldFilter(*call, subfield, evaluator());
+  ASSERT_TRUE(filter);
+  ASSERT_FALSE(filter->testTimestamp(dayEnd));
+  ASSERT_TRUE(filter->testTimestamp(nextDay));
+
+  // not (cast(a as date) > d) is cast(a as date) <= d.
+  filter = leafCallToSubfieldFilter(*call, subfield, evaluator(), true);
+  ASSERT_TRUE(filter);
+  ASSERT_TRUE(filter->testTimestamp(dayEnd));
+  ASSERT_FALSE(filter->testTimestamp(nextDay));
 }
 
 TEST_F(ExprToSubfieldFilterTest, nonConstant) {
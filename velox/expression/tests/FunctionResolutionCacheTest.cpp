@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/expression/FunctionResolutionCache.h"
+#include <gtest/gtest.h>
+#include "velox/expression/VectorFunction.h"
+
+namespace facebook::velox::exec {
+namespace {
+
+TEST(FunctionResolutionCacheTest, basic) {
+  FunctionResolutionCache<TypePtr> cache;
+  ASSERT_FALSE(cache.find("f", {BIGINT()}).has_value());
+
+  cache.insert("f", {BIGINT()}, VARCHAR());
+  cache.insert("f", {INTEGER()}, nullptr);
+  ASSERT_EQ(*cache.find("f", {BIGINT()}).value(), *VARCHAR());
+  // A cached miss.
+  ASSERT_TRUE(cache.find("f", {INTEGER()}).has_value());
+  ASSERT_EQ(cache.find("f", {INTEGER()}).value(), nullptr);
+  ASSERT_FALSE(cache.find("g", {BIGINT()}).has_value());
+  ASSERT_FALSE(cache.find("f", {BIGINT(), BIGINT()}).has_value());
+
+  // Types are compared by value, including field names.
+  cache.insert("f", {ROW({"a"}, {BIGINT()})}, BIGINT());
+  ASSERT_TRUE(cache.find("f", {ROW({"a"}, {BIGINT()})}).has_value());
+  ASSERT_FALSE(cache.find("f", {ROW({"b"}, {BIGINT()})}).has_value());
+
+  cache.clear();
+  ASSERT_EQ(cache.size(), 0);
+}
+
+TEST(FunctionResolutionCacheTest, maxEntries) {
+  FunctionResolutionCache<int32_t> cache;
+  for (auto i = 0; i < FunctionResolutionCache<int32_t>::kMaxEntries; ++i) {
+    cache.insert(fmt::format("f{}", i), {}, i);
+  }
+  ASSERT_EQ(cache.size(), FunctionResolutionCache<int32_t>::kMaxEntries);
+  cache.insert("g", {}, 0);
+  ASSERT_EQ(cache.size(), 1);
+}
+
+class NoOpFunction : public VectorFunction {
+ public:
+  void apply(
+      const SelectivityVector& /*rows*/,
+      std::vector<VectorPtr>& /*args*/,
+      const TypePtr& /*outputType*/,
+      EvalCtx& /*context*/,
+      VectorPtr& /*result*/) const override {}
+};
+
+TEST(FunctionResolutionCacheTest, reregisterVectorFunction) {
+  auto registerWithReturnType = [](const std::string& returnType) {
+    registerVectorFunction(
+        "resolution_cache_test",
+        {FunctionSignatureBuilder()
+             .returnType(returnType)
+             .argumentType("integer")
+             .build()},
+        std::make_unique<NoOpFunction>(),
+        {},
+        true);
+  };
+
+  registerWithReturnType("bigint");
+  ASSERT_EQ(
+      *resolveVectorFunction("resolution_cache_test", {INTEGER()}), *BIGINT());
+  ASSERT_EQ(
+      resolveVectorFunction("resolution_cache_test", {DOUBLE()}), nullptr);
+
+  // The cached resolution goes away with the old registration.
+  registerWithReturnType("varchar");
+  ASSERT_EQ(
+      *resolveVectorFunction("resolution_cache_test", {INTEGER()}), *VARCHAR());
+}
+
+TEST(FunctionResolutionCacheTest, lazyVectorFunction) {
+  int32_t numMade = 0;
+  registerLazyVectorFunction(
+      "lazy_resolution_cache_test",
+      {FunctionSignatureBuilder()
+           .returnType("bigint")
+           .argumentType("integer")
+           .build()},
+      [&]() {
+        ++numMade;
+        return std::make_unique<NoOpFunction>();
+      });
+  // Resolving the signature does not make the function.
+  ASSERT_EQ(
+      *resolveVectorFunction("lazy_resolution_cache_test", {INTEGER()}),
+      *BIGINT());
+  ASSERT_EQ(numMade, 0);
+
+  core::QueryConfig config({});
+  auto first = getVectorFunction(
+      "lazy_resolution_cache_test", {INTEGER()}, {}, config);
+  auto second = getVectorFunction(
+      "lazy_resolution_cache_test", {INTEGER()}, {}, config);
+  ASSERT_NE(first, nullptr);
+  ASSERT_EQ(first, second);
+  ASSERT_EQ(numMade, 1);
+}
+
+} // namespace
+} // namespace facebook::velox::exec
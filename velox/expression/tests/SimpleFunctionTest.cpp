@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include <cmath>
 #include <cstdint>
 #include <optional>
 #include <string>
@@ -21,6 +22,7 @@
 #include "folly/lang/Hint.h"
 #include "glog/logging.h"
 #include "gtest/gtest.h"
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/expression/Expr.h"
 #include "velox/functions/Udf.h"
 #include "velox/functions/prestosql/registration/RegistrationFunctions.h"
@@ -1131,6 +1133,97 @@ TEST_F(SimpleFunctionTest, testAllNotNull) {
   assertEqualVectors(expected, result);
 }
 
+// Adds two numbers, counting the calls to callBatch().
+template <typename T>
+struct CallBatchFunction {
+  static constexpr bool has_call_batch = true;
+
+  static inline int32_t numBatchCalls = 0;
+
+  FOLLY_ALWAYS_INLINE void
+  call(int64_t& result, const int64_t& a, const int64_t& b) {
+    result = a + b;
+  }
+
+  FOLLY_ALWAYS_INLINE void callBatch(
+      int64_t* result,
+      const int64_t* a,
+      const int64_t* b,
+      vector_size_t size) {
+    ++numBatchCalls;
+    for (auto i = 0; i < size; ++i) {
+      result[i] = a[i] + b[i];
+    }
+  }
+};
+
+TEST_F(SimpleFunctionTest, callBatch) {
+  registerFunction<CallBatchFunction, int64_t, int64_t, int64_t>(
+      {"call_batch"});
+  auto& numBatchCalls = CallBatchFunction<exec::VectorExec>::numBatchCalls;
+  numBatchCalls = 0;
+
+  const vector_size_t size = 1'000;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(size, [](auto row) { return row * 3; }),
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return row; }, nullEvery(7)),
+  });
+
+  // All arguments are flat without nulls.
+  auto expected =
+      makeFlatVector<int64_t>(size, [](auto row) { return row * 4; });
+  assertEqualVectors(expected, evaluate("call_batch(c0, c1)", data));
+  ASSERT_EQ(numBatchCalls, 1);
+
+  // The result reuses the flat result of the inner call.
+  expected = makeFlatVector<int64_t>(size, [](auto row) { return row * 7; });
+  assertEqualVectors(
+      expected, evaluate("call_batch(call_batch(c0, c1), c1)", data));
+  ASSERT_EQ(numBatchCalls, 3);
+
+  // Arguments with nulls and constant arguments use call().
+  expected = makeFlatVector<int64_t>(
+      size, [](auto row) { return row * 2; }, nullEvery(7));
+  assertEqualVectors(expected, evaluate("call_batch(c0, c2)", data));
+  expected = makeFlatVector<int64_t>(size, [](auto row) { return row + 1; });
+  assertEqualVectors(expected, evaluate("call_batch(c0, 1)", data));
+  ASSERT_EQ(numBatchCalls, 3);
+}
+
+// Returns the square root of non-negative numbers and an error Status for
+// negative ones.
+template <typename T>
+struct StatusFunction {
+  FOLLY_ALWAYS_INLINE Status call(int64_t& result, const int64_t& a) {
+    if (a < 0) {
+      return Status::UserError(fmt::format("negative input: {}", a));
+    }
+    result = std::sqrt(a);
+    return Status::OK();
+  }
+};
+
+TEST_F(SimpleFunctionTest, statusError) {
+  registerFunction<StatusFunction, int64_t, int64_t>({"status_sqrt"});
+
+  auto data = makeRowVector({makeNullableFlatVector<int64_t>(
+      {4, -1, 9, std::nullopt, -4, 16})});
+  auto expected = makeNullableFlatVector<int64_t>(
+      {2, std::nullopt, 3, std::nullopt, std::nullopt, 4});
+  assertEqualVectors(expected, evaluate("try(status_sqrt(c0))", data));
+
+  VELOX_ASSERT_THROW(evaluate("status_sqrt(c0)", data), "negative input: -1");
+
+  try {
+    evaluate("status_sqrt(c0)", data);
+    FAIL() << "Expected an exception";
+  } catch (const VeloxUserError& e) {
+    ASSERT_EQ(e.errorCode(), error_code::kInvalidArgument.c_str());
+  }
+}
+
 // Test that SimpleFunctionRegistry does not crash in multithreaded environment.
 TEST_F(SimpleFunctionTest, simpleFunctionRegistryThreadSafe) {
   std::vector<std::thread> threads;
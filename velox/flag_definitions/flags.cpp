@@ -28,6 +28,21 @@ DEFINE_int32(
     32,
     "Number of shared leaf memory pools per process");
 
+DEFINE_int32(
+    velox_memory_pool_slab_cache_kb,
+    0,
+    "If non-zero, the capacity in KB of the cache of freed small buffers of "
+    "each leaf memory pool. 0 disables the cache");
+
+DEFINE_int32(
+    velox_memory_pool_reservation_slack_mb,
+    0,
+    "If non-zero, the max unused memory reservation in MB a leaf memory pool "
+    "keeps on top of its usage. The slack grows with the usage so that a "
+    "growing pool reserves from its parents in increasing quanta and small "
+    "allocations and frees are handled locally. 0 reserves the quantized "
+    "usage only");
+
 DEFINE_bool(
     velox_time_allocations,
     true,
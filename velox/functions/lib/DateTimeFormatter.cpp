@@ -180,37 +180,48 @@ static std::
 constexpr int monthsFullLength[] = {7, 8, 5, 5, 3, 4, 4, 6, 9, 7, 8, 8};
 
 /// Pads the content with desired padding characters. E.g. if we need to pad 999
-/// with three 0s in front, the result will be '000999'
-/// \param content the content that is going to be padded.
+/// with three 0s in front, the result will be '000999'. Writes the result to
+/// 'out' and advances 'out' past it.
+/// \param content the integer that is going to be padded.
 /// \param padding the padding that is going to be used to pad the content.
 /// \param totalDigits the total number of digits the padded result is desired
 /// to be. If totalDigits is already smaller than content length, the original
-/// content will be returned with no padding
-/// \param padFront if the padding is in front of the content or back of the
-/// content.
+/// content will be written with no padding. A minus sign precedes the padding.
 template <typename T>
-std::string padContent(
+void padContent(
     const T& content,
     char padding,
     size_t totalDigits,
-    bool padFront = true) {
-  std::string strContent = folly::to<std::string>(content);
-  auto contentLength = strContent.size();
-  if (contentLength == 0) {
-    return std::string(totalDigits, padding);
+    char*& out) {
+  bool isNegative = false;
+  uint64_t value = content;
+  if constexpr (std::is_signed_v<T>) {
+    isNegative = content < 0;
+    value = isNegative ? -static_cast<int64_t>(content) : content;
   }
-
-  bool isNegative = strContent[0] == '-';
-  auto digitLength = contentLength - (isNegative ? 1 : 0);
-  if (digitLength >= totalDigits) {
-    return strContent;
+  size_t numDigits = 1;
+  for (auto rest = value / 10; rest > 0; rest /= 10) {
+    ++numDigits;
   }
-  std::string paddingStr(totalDigits - digitLength, padding);
-  if (padFront) {
-    return strContent.insert((isNegative ? 1 : 0), paddingStr);
-  } else {
-    return strContent.append(paddingStr);
+  if (isNegative) {
+    *out++ = '-';
+  }
+  if (numDigits < totalDigits) {
+    std::memset(out, padding, totalDigits - numDigits);
+    out += totalDigits - numDigits;
   }
+  out += numDigits;
+  auto* digit = out;
+  do {
+    *--digit = '0' + value % 10;
+    value /= 10;
+  } while (value > 0);
+}
+
+// Copies 'value' to 'out' and advances 'out' past it.
+inline void append(std::string_view value, char*& out) {
+  std::memcpy(out, value.data(), value.size());
+  out += value.size();
 }
 
 size_t countOccurence(const std::string_view& base, const std::string& target) {
@@ -462,31 +473,22 @@ int64_t parseHalfDayOfDay(const char* cur, const char* end, Date& date) {
   }
 }
 
-std::string formatFractionOfSecond(
+// Writes the first 'minRepresentDigits' digits of the milliseconds in
+// 'subseconds', padded with zeros at the end, to 'out'.
+void formatFractionOfSecond(
     uint16_t subseconds,
-    size_t minRepresentDigits) {
-  char toAdd[minRepresentDigits > 3 ? minRepresentDigits + 1 : 4];
-
-  if (subseconds < 10) {
-    toAdd[0] = '0';
-    toAdd[1] = '0';
-    toAdd[2] = char(subseconds + '0');
-  } else if (subseconds < 100) {
-    toAdd[2] = char(subseconds % 10 + '0');
-    toAdd[1] = char((subseconds / 10) % 10 + '0');
-    toAdd[0] = '0';
-  } else {
-    toAdd[2] = char(subseconds % 10 + '0');
-    toAdd[1] = char((subseconds / 10) % 10 + '0');
-    toAdd[0] = char((subseconds / 100) % 10 + '0');
-  }
-
+    size_t minRepresentDigits,
+    char*& out) {
+  char digits[3];
+  digits[0] = char((subseconds / 100) % 10 + '0');
+  digits[1] = char((subseconds / 10) % 10 + '0');
+  digits[2] = char(subseconds % 10 + '0');
+
+  std::memcpy(out, digits, std::min<size_t>(minRepresentDigits, 3));
   if (minRepresentDigits > 3) {
-    memset(toAdd + 3, '0', minRepresentDigits - 3);
+    std::memset(out + 3, '0', minRepresentDigits - 3);
   }
-
-  toAdd[minRepresentDigits] = '\0';
-  return toAdd;
+  out += minRepresentDigits;
 }
 
 // According to DateTimeFormatSpecifier enum class
@@ -927,9 +929,81 @@ void parseFromPattern(
 
 } // namespace
 
+int32_t DateTimeFormatter::maxResultSize(
+    const date::time_zone* timezone) const {
+  // Years are at most 10 digits and a sign.
+  constexpr size_t kMaxYearSize = 11;
+  // "September" and "Wednesday".
+  constexpr size_t kMaxTextSize = 9;
+  size_t size = 0;
+  for (const auto& token : tokens_) {
+    if (token.type == DateTimeToken::Type::kLiteral) {
+      size += token.literal.size();
+      continue;
+    }
+    const auto minDigits = token.pattern.minRepresentDigits;
+    switch (token.pattern.specifier) {
+      case DateTimeFormatSpecifier::ERA:
+      case DateTimeFormatSpecifier::HALFDAY_OF_DAY:
+        size += 2;
+        break;
+      case DateTimeFormatSpecifier::CENTURY_OF_ERA:
+      case DateTimeFormatSpecifier::YEAR_OF_ERA:
+      case DateTimeFormatSpecifier::YEAR:
+        size += std::max(minDigits, kMaxYearSize);
+        break;
+      case DateTimeFormatSpecifier::DAY_OF_WEEK_0_BASED:
+      case DateTimeFormatSpecifier::DAY_OF_WEEK_1_BASED:
+        size += std::max<size_t>(minDigits, 1);
+        break;
+      case DateTimeFormatSpecifier::DAY_OF_WEEK_TEXT:
+      case DateTimeFormatSpecifier::MONTH_OF_YEAR_TEXT:
+        size += minDigits <= 3 ? 3 : kMaxTextSize;
+        break;
+      case DateTimeFormatSpecifier::DAY_OF_YEAR:
+        size += std::max<size_t>(minDigits, 3);
+        break;
+      case DateTimeFormatSpecifier::MONTH_OF_YEAR:
+      case DateTimeFormatSpecifier::DAY_OF_MONTH:
+      case DateTimeFormatSpecifier::HOUR_OF_HALFDAY:
+      case DateTimeFormatSpecifier::CLOCK_HOUR_OF_HALFDAY:
+      case DateTimeFormatSpecifier::HOUR_OF_DAY:
+      case DateTimeFormatSpecifier::CLOCK_HOUR_OF_DAY:
+      case DateTimeFormatSpecifier::MINUTE_OF_HOUR:
+      case DateTimeFormatSpecifier::SECOND_OF_MINUTE:
+        size += std::max<size_t>(minDigits, 2);
+        break;
+      case DateTimeFormatSpecifier::FRACTION_OF_SECOND:
+        size += minDigits;
+        break;
+      case DateTimeFormatSpecifier::TIMEZONE:
+        if (timezone != nullptr) {
+          size += timezone->name().size();
+        }
+        break;
+      default:
+        // Formatting fails for the other specifiers.
+        break;
+    }
+  }
+  return size;
+}
+
 std::string DateTimeFormatter::format(
     const Timestamp& timestamp,
     const date::time_zone* timezone) const {
+  std::string result(maxResultSize(timezone), '\0');
+  result.resize(format(timestamp, timezone, result.size(), result.data()));
+  const auto resultSize = out - result;
+  VELOX_DCHECK_LE(resultSize, maxResultSize);
+  return resultSize;
+}
+
+int32_t DateTimeFormatter::format(
+    const Timestamp& timestamp,
+    const date::time_zone* timezone,
+    const int32_t maxResultSize,
+    char* result) const {
   Timestamp t = timestamp;
   if (timezone != nullptr) {
     t.toTimezone(*timezone);
@@ -941,30 +1015,30 @@ std::string DateTimeFormatter::format(
   const date::year_month_day calDate(daysTimePoint);
   const date::weekday weekday(daysTimePoint);
 
-  std::string result;
+  char* out = result;
   for (auto& token : tokens_) {
     if (token.type == DateTimeToken::Type::kLiteral) {
-      result += token.literal;
+      append(token.literal, out);
     } else {
       switch (token.pattern.specifier) {
         case DateTimeFormatSpecifier::ERA:
-          result += static_cast<signed>(calDate.year()) > 0 ? "AD" : "BC";
+          append(static_cast<signed>(calDate.year()) > 0 ? "AD" : "BC", out);
           break;
 
         case DateTimeFormatSpecifier::CENTURY_OF_ERA: {
           auto year = static_cast<signed>(calDate.year());
           year = (year < 0 ? -year : year);
           auto century = year / 100;
-          result += padContent(century, '0', token.pattern.minRepresentDigits);
+          padContent(century, '0', token.pattern.minRepresentDigits, out);
         } break;
 
         case DateTimeFormatSpecifier::YEAR_OF_ERA: {
           auto year = static_cast<signed>(calDate.year());
           if (token.pattern.minRepresentDigits == 2) {
-            result += padContent(std::abs(year) % 100, '0', 2);
+            padContent(std::abs(year) % 100, '0', 2, out);
           } else {
             year = year <= 0 ? std::abs(year - 1) : year;
-            result += padContent(year, '0', token.pattern.minRepresentDigits);
+            padContent(year, '0', token.pattern.minRepresentDigits, out);
           }
         } break;
 
@@ -976,16 +1050,15 @@ std::string DateTimeFormatter::format(
                   DateTimeFormatSpecifier::DAY_OF_WEEK_1_BASED) {
             weekdayNum = 7;
           }
-          result +=
-              padContent(weekdayNum, '0', token.pattern.minRepresentDigits);
+          padContent(weekdayNum, '0', token.pattern.minRepresentDigits, out);
         } break;
 
         case DateTimeFormatSpecifier::DAY_OF_WEEK_TEXT: {
           auto weekdayNum = weekday.c_encoding();
           if (token.pattern.minRepresentDigits <= 3) {
-            result += weekdaysShort[weekdayNum];
+            append(weekdaysShort[weekdayNum], out);
           } else {
-            result += weekdaysFull[weekdayNum];
+            append(weekdaysFull[weekdayNum], out);
           }
         } break;
 
@@ -994,13 +1067,14 @@ std::string DateTimeFormatter::format(
           if (token.pattern.minRepresentDigits == 2) {
             year = std::abs(year);
             auto twoDigitYear = year % 100;
-            result +=
-                padContent(twoDigitYear, '0', token.pattern.minRepresentDigits);
+            padContent(
+                twoDigitYear, '0', token.pattern.minRepresentDigits, out);
           } else {
-            result += padContent(
+            padContent(
                 static_cast<signed>(calDate.year()),
                 '0',
-                token.pattern.minRepresentDigits);
+                token.pattern.minRepresentDigits,
+                out);
           }
         } break;
 
@@ -1011,33 +1085,37 @@ std::string DateTimeFormatter::format(
               (date::sys_days{calDate} - date::sys_days{firstDayOfTheYear})
                   .count();
           delta += 1;
-          result += padContent(delta, '0', token.pattern.minRepresentDigits);
+          padContent(delta, '0', token.pattern.minRepresentDigits, out);
         } break;
 
         case DateTimeFormatSpecifier::MONTH_OF_YEAR:
-          result += padContent(
+          padContent(
               static_cast<unsigned>(calDate.month()),
               '0',
-              token.pattern.minRepresentDigits);
+              token.pattern.minRepresentDigits,
+              out);
           break;
 
         case DateTimeFormatSpecifier::MONTH_OF_YEAR_TEXT:
           if (token.pattern.minRepresentDigits <= 3) {
-            result += monthsShort[static_cast<unsigned>(calDate.month()) - 1];
+            append(
+                monthsShort[static_cast<unsigned>(calDate.month()) - 1], out);
           } else {
-            result += monthsFull[static_cast<unsigned>(calDate.month()) - 1];
+            append(
+                monthsFull[static_cast<unsigned>(calDate.month()) - 1], out);
           }
           break;
 
         case DateTimeFormatSpecifier::DAY_OF_MONTH:
-          result += padContent(
+          padContent(
               static_cast<unsigned>(calDate.day()),
               '0',
-              token.pattern.minRepresentDigits);
+              token.pattern.minRepresentDigits,
+              out);
           break;
 
         case DateTimeFormatSpecifier::HALFDAY_OF_DAY:
-          result += durationInTheDay.hours().count() < 12 ? "AM" : "PM";
+          append(durationInTheDay.hours().count() < 12 ? "AM" : "PM", out);
           break;
 
         case DateTimeFormatSpecifier::HOUR_OF_HALFDAY:
@@ -1057,27 +1135,30 @@ std::string DateTimeFormatter::format(
               DateTimeFormatSpecifier::CLOCK_HOUR_OF_DAY) {
             hourNum = (hourNum + 23) % 24 + 1;
           }
-          result += padContent(hourNum, '0', token.pattern.minRepresentDigits);
+          padContent(hourNum, '0', token.pattern.minRepresentDigits, out);
         } break;
 
         case DateTimeFormatSpecifier::MINUTE_OF_HOUR:
-          result += padContent(
+          padContent(
               durationInTheDay.minutes().count() % 60,
               '0',
-              token.pattern.minRepresentDigits);
+              token.pattern.minRepresentDigits,
+              out);
           break;
 
         case DateTimeFormatSpecifier::SECOND_OF_MINUTE:
-          result += padContent(
+          padContent(
               durationInTheDay.seconds().count() % 60,
               '0',
-              token.pattern.minRepresentDigits);
+              token.pattern.minRepresentDigits,
+              out);
           break;
 
         case DateTimeFormatSpecifier::FRACTION_OF_SECOND: {
-          result += formatFractionOfSecond(
+          formatFractionOfSecond(
               durationInTheDay.subseconds().count(),
-              token.pattern.minRepresentDigits);
+              token.pattern.minRepresentDigits,
+              out);
           break;
         }
 
@@ -1090,7 +1171,7 @@ std::string DateTimeFormatter::format(
           if (timezone == nullptr) {
             VELOX_USER_FAIL("Timezone unknown")
           }
-          result += timezone->name();
+          append(timezone->name(), out);
           break;
 
         case DateTimeFormatSpecifier::TIMEZONE_OFFSET_ID:
@@ -1105,7 +1186,9 @@ std::string DateTimeFormatter::format(
       }
     }
   }
-  return result;
+  const auto resultSize = out - result;
+  VELOX_DCHECK_LE(resultSize, maxResultSize);
+  return resultSize;
 }
 
 DateTimeResult DateTimeFormatter::parse(const std::string_view& input) const {
@@ -179,6 +179,19 @@ class DateTimeFormatter {
       const Timestamp& timestamp,
       const date::time_zone* timezone) const;
 
+  /// Returns an upper bound of the size of a result of format() with
+  /// 'timezone'. Callers with a constant format compute this once.
+  int32_t maxResultSize(const date::time_zone* timezone) const;
+
+  /// Formats 'timestamp' into 'result', which must have space for
+  /// 'maxResultSize' characters, as returned by maxResultSize(). Returns the
+  /// size of the result. Does not allocate.
+  int32_t format(
+      const Timestamp& timestamp,
+      const date::time_zone* timezone,
+      const int32_t maxResultSize,
+      char* result) const;
+
  private:
   std::unique_ptr<char[]> literalBuf_;
   size_t bufSize_;
@@ -309,6 +309,53 @@ void KllSketch<T, A, C>::doInsert(T value) {
   isLevelZeroSorted_ = false;
 }
 
+template <typename T, typename A, typename C>
+void KllSketch<T, A, C>::insert(const T* values, size_t size) {
+  if (size == 0) {
+    return;
+  }
+  auto minValue = n_ == 0 ? values[0] : minValue_;
+  auto maxValue = n_ == 0 ? values[0] : maxValue_;
+  for (size_t i = 0; i < size; ++i) {
+    minValue = std::min(minValue, values[i], C());
+    maxValue = std::max(maxValue, values[i], C());
+  }
+  minValue_ = minValue;
+  maxValue_ = maxValue;
+  doInsert(values, size);
+}
+
+template <typename T, typename A, typename C>
+void KllSketch<T, A, C>::doInsert(const T* values, size_t size) {
+  VELOX_DCHECK_GT(k_, 0);
+  VELOX_DCHECK_GE(levels_.size(), 2);
+  size_t i = 0;
+  if (numLevels() == 1 && items_.size() < k_) {
+    const auto numToAppend = std::min<size_t>(size, k_ - items_.size());
+    items_.insert(items_.end(), values, values + numToAppend);
+    levels_[1] += numToAppend;
+    i = numToAppend;
+  }
+  while (i < size) {
+    if (levels_[0] == 0) {
+      // Level zero is full, compact and insert one value.
+      items_[insertPosition()] = values[i++];
+      continue;
+    }
+    // Fill the free slots below level zero from the top down, as insert()
+    // does.
+    const auto numToCopy = std::min<size_t>(size - i, levels_[0]);
+    auto* target = items_.data() + levels_[0];
+    for (size_t j = 0; j < numToCopy; ++j) {
+      *--target = values[i + j];
+    }
+    levels_[0] -= numToCopy;
+    i += numToCopy;
+  }
+  n_ += size;
+  isLevelZeroSorted_ = false;
+}
+
 template <typename T, typename A, typename C>
 uint32_t KllSketch<T, A, C>::insertPosition() {
   if (levels_[0] == 0) {
@@ -588,9 +635,7 @@ void KllSketch<T, A, C>::mergeViews(const folly::Range<const View*>& others) {
     if (other.n == 0) {
       continue;
     }
-    for (uint32_t j = other.levels[0]; j < other.levels[1]; ++j) {
-      doInsert(other.items[j]);
-    }
+    doInsert(other.items.data() + other.levels[0], other.safeLevelSize(0));
   }
   // Merge higher levels.
   auto tmpNumItems = getNumRetained();
@@ -60,6 +60,11 @@ struct KllSketch {
   /// Add one new value to the sketch.
   void insert(T value);
 
+  /// Add 'size' new values to the sketch.  Gives the same sketch as calling
+  /// insert() on each value in order, but copies the values into level zero
+  /// in bulk and compacts only when level zero is full.
+  void insert(const T* FOLLY_NONNULL values, size_t size);
+
   /// Call this before serialization can optimize the space used.
   void compact();
 
@@ -169,6 +174,7 @@ struct KllSketch {
  private:
   KllSketch(const Allocator&, uint32_t seed);
   void doInsert(T);
+  void doInsert(const T* FOLLY_NONNULL, size_t);
   uint32_t insertPosition();
   int findLevelToCompact() const;
   void addEmptyTopLevelToCompletelyFullSketch();
@@ -16,9 +16,11 @@
 #include "velox/functions/lib/Re2Functions.h"
 
 #include <re2/re2.h>
+#include <cctype>
 #include <optional>
 #include <string>
 
+#include "velox/common/base/SimdUtil.h"
 #include "velox/expression/VectorWriters.h"
 
 namespace facebook::velox::functions {
@@ -89,6 +91,88 @@ bool re2PartialMatch(StringView str, const RE2& re) {
   return RE2::PartialMatch(toStringPiece(str), re);
 }
 
+// Returns the position of the first occurrence of 'needle' in 'haystack' or
+// std::string_view::npos. Compares the first and the last byte of 'needle'
+// with a batch of positions at a time and compares the rest of 'needle' only
+// at the positions where both are equal.
+size_t simdFind(std::string_view haystack, std::string_view needle) {
+  const auto size = needle.size();
+  if (size <= 1 || haystack.size() < size) {
+    return haystack.find(needle);
+  }
+  using Batch = xsimd::batch<uint8_t>;
+  const auto first = Batch::broadcast(needle[0]);
+  const auto last = Batch::broadcast(needle[size - 1]);
+  const auto* data = reinterpret_cast<const uint8_t*>(haystack.data());
+  size_t i = 0;
+  for (; i + size - 1 + Batch::size <= haystack.size(); i += Batch::size) {
+    uint64_t candidates = simd::toBitMask(
+        (Batch::load_unaligned(data + i) == first) &
+        (Batch::load_unaligned(data + i + size - 1) == last));
+    while (candidates) {
+      const auto offset = __builtin_ctzll(candidates);
+      if (memcmp(
+              haystack.data() + i + offset + 1,
+              needle.data() + 1,
+              size - 2) == 0) {
+        return i + offset;
+      }
+      candidates &= candidates - 1;
+    }
+  }
+  const auto tail = haystack.substr(i).find(needle);
+  return tail == std::string_view::npos ? tail : i + tail;
+}
+
+// Checks the input strings of a constant pattern for the literals found by
+// analyzeRegexLiterals() before running RE2.
+class LiteralPrefilter {
+ public:
+  explicit LiteralPrefilter(std::string_view pattern)
+      : literals_(analyzeRegexLiterals(pattern)) {}
+
+  // True if the pattern is an alternation of literals and matches() can be
+  // used instead of RE2.
+  bool literalsOnly() const {
+    return literals_.literalsOnly;
+  }
+
+  // Returns false if 'str' cannot contain a match of the pattern.
+  bool mayMatch(StringView str) const {
+    if (literals_.literals.empty()) {
+      return true;
+    }
+    return containsLiteral(str);
+  }
+
+  // Returns whether 'str' matches the pattern. Requires literalsOnly().
+  bool matches(StringView str, bool fullMatch) const {
+    VELOX_DCHECK(literals_.literalsOnly);
+    if (fullMatch) {
+      for (const auto& literal : literals_.literals) {
+        if (std::string_view(str) == literal) {
+          return true;
+        }
+      }
+      return false;
+    }
+    return containsLiteral(str);
+  }
+
+ private:
+  bool containsLiteral(StringView str) const {
+    const std::string_view haystack(str.data(), str.size());
+    for (const auto& literal : literals_.literals) {
+      if (simdFind(haystack, literal) != std::string_view::npos) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  const RegexLiterals literals_;
+};
+
 bool re2Extract(
     FlatVector<StringView>& result,
     int row,
@@ -96,10 +180,12 @@ bool re2Extract(
     const exec::LocalDecodedVector& strs,
     std::vector<re2::StringPiece>& groups,
     int32_t groupId,
-    bool emptyNoMatch) {
+    bool emptyNoMatch,
+    const LiteralPrefilter* prefilter = nullptr) {
   const StringView str = strs->valueAt<StringView>(row);
   DCHECK_GT(groups.size(), groupId);
-  if (!re.Match(
+  if ((prefilter && !prefilter->mayMatch(str)) ||
+      !re.Match(
           toStringPiece(str),
           0,
           str.size(),
@@ -180,7 +266,8 @@ template <bool (*Fn)(StringView, const RE2&)>
 class Re2MatchConstantPattern final : public VectorFunction {
  public:
   explicit Re2MatchConstantPattern(StringView pattern)
-      : re_(toStringPiece(pattern), RE2::Quiet) {}
+      : re_(toStringPiece(pattern), RE2::Quiet),
+        prefilter_(std::string_view(pattern.data(), pattern.size())) {}
 
   void apply(
       const SelectivityVector& rows,
@@ -198,13 +285,25 @@ class Re2MatchConstantPattern final : public VectorFunction {
       return;
     }
 
+    if (prefilter_.literalsOnly()) {
+      context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
+        result.set(
+            i,
+            prefilter_.matches(
+                toSearch->valueAt<StringView>(i), Fn == re2FullMatch));
+      });
+      return;
+    }
+
     context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
-      result.set(i, Fn(toSearch->valueAt<StringView>(i), re_));
+      const auto str = toSearch->valueAt<StringView>(i);
+      result.set(i, prefilter_.mayMatch(str) && Fn(str, re_));
     });
   }
 
  private:
   RE2 re_;
+  const LiteralPrefilter prefilter_;
 };
 
 template <bool (*Fn)(StringView, const RE2&)>
@@ -246,7 +345,9 @@ class Re2SearchAndExtractConstantPattern final : public VectorFunction {
   explicit Re2SearchAndExtractConstantPattern(
       StringView pattern,
       bool emptyNoMatch)
-      : re_(toStringPiece(pattern), RE2::Quiet), emptyNoMatch_(emptyNoMatch) {}
+      : re_(toStringPiece(pattern), RE2::Quiet),
+        emptyNoMatch_(emptyNoMatch),
+        prefilter_(std::string_view(pattern.data(), pattern.size())) {}
 
   void apply(
       const SelectivityVector& rows,
@@ -274,8 +375,8 @@ class Re2SearchAndExtractConstantPattern final : public VectorFunction {
     if (args.size() == 2) {
       groups.resize(1);
       context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
-        mustRefSourceStrings |=
-            re2Extract(result, i, re_, toSearch, groups, 0, emptyNoMatch_);
+        mustRefSourceStrings |= re2Extract(
+            result, i, re_, toSearch, groups, 0, emptyNoMatch_, &prefilter_);
       });
       if (mustRefSourceStrings) {
         result.acquireSharedStringBuffers(toSearch->base());
@@ -294,7 +395,14 @@ class Re2SearchAndExtractConstantPattern final : public VectorFunction {
       groups.resize(*groupId + 1);
       context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
         mustRefSourceStrings |= re2Extract(
-            result, i, re_, toSearch, groups, *groupId, emptyNoMatch_);
+            result,
+            i,
+            re_,
+            toSearch,
+            groups,
+            *groupId,
+            emptyNoMatch_,
+            &prefilter_);
       });
       if (mustRefSourceStrings) {
         result.acquireSharedStringBuffers(toSearch->base());
@@ -310,8 +418,8 @@ class Re2SearchAndExtractConstantPattern final : public VectorFunction {
     context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
       T group = groupIds->valueAt<T>(i);
       checkForBadGroupId(group, re_);
-      mustRefSourceStrings |=
-          re2Extract(result, i, re_, toSearch, groups, group, emptyNoMatch_);
+      mustRefSourceStrings |= re2Extract(
+          result, i, re_, toSearch, groups, group, emptyNoMatch_, &prefilter_);
     });
     if (mustRefSourceStrings) {
       result.acquireSharedStringBuffers(toSearch->base());
@@ -321,6 +429,7 @@ class Re2SearchAndExtractConstantPattern final : public VectorFunction {
  private:
   RE2 re_;
   const bool emptyNoMatch_;
+  const LiteralPrefilter prefilter_;
 }; // namespace
 
 // The factory function we provide returns a unique instance for each call, so
@@ -475,9 +584,9 @@ class LikeWithRe2 final : public VectorFunction {
   LikeWithRe2(StringView pattern, std::optional<char> escapeChar) {
     RE2::Options opt{RE2::Quiet};
     opt.set_dot_nl(true);
-    re_.emplace(
-        toStringPiece(likePatternToRe2(pattern, escapeChar, validPattern_)),
-        opt);
+    const auto regex = likePatternToRe2(pattern, escapeChar, validPattern_);
+    re_.emplace(toStringPiece(regex), opt);
+    prefilter_.emplace(regex);
   }
 
   void apply(
@@ -510,13 +619,17 @@ class LikeWithRe2 final : public VectorFunction {
     if (toSearch->isIdentityMapping()) {
       auto rawStrings = toSearch->data<StringView>();
       context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
-        result.set(i, re2FullMatch(rawStrings[i], *re_));
+        result.set(
+            i,
+            prefilter_->mayMatch(rawStrings[i]) &&
+                re2FullMatch(rawStrings[i], *re_));
       });
       return;
     }
 
     if (toSearch->isConstantMapping()) {
-      bool match = re2FullMatch(toSearch->valueAt<StringView>(0), *re_);
+      const auto str = toSearch->valueAt<StringView>(0);
+      bool match = prefilter_->mayMatch(str) && re2FullMatch(str, *re_);
       context.applyToSelectedNoThrow(
           rows, [&](vector_size_t i) { result.set(i, match); });
       return;
@@ -530,6 +643,7 @@ class LikeWithRe2 final : public VectorFunction {
 
  private:
   std::optional<RE2> re_;
+  std::optional<LiteralPrefilter> prefilter_;
   bool validPattern_;
 };
 
@@ -908,6 +1022,193 @@ std::pair<PatternKind, vector_size_t> determinePatternKind(StringView pattern) {
   return {PatternKind::kSuffix, patternLength - fixedPatternStart};
 }
 
+namespace {
+// Removes the last UTF-8 character from 'literal'.
+void popCharacter(std::string& literal) {
+  while (!literal.empty() && (literal.back() & 0xC0) == 0x80) {
+    literal.pop_back();
+  }
+  if (!literal.empty()) {
+    literal.pop_back();
+  }
+}
+
+// Returns the position after the character class that starts at 'start' or
+// std::string_view::npos if the class does not end.
+size_t skipCharacterClass(std::string_view pattern, size_t start) {
+  auto i = start + 1;
+  if (i < pattern.size() && pattern[i] == '^') {
+    ++i;
+  }
+  // A ']' right after the opening bracket is a literal.
+  if (i < pattern.size() && pattern[i] == ']') {
+    ++i;
+  }
+  while (i < pattern.size()) {
+    if (pattern[i] == '\\') {
+      i += 2;
+    } else if (pattern.substr(i, 2) == "[:") {
+      const auto end = pattern.find(":]", i + 2);
+      if (end == std::string_view::npos) {
+        return end;
+      }
+      i = end + 2;
+    } else if (pattern[i] == ']') {
+      return i + 1;
+    } else {
+      ++i;
+    }
+  }
+  return std::string_view::npos;
+}
+
+// Returns the position after the group that starts at 'start' or
+// std::string_view::npos if the group does not end.
+size_t skipGroup(std::string_view pattern, size_t start) {
+  int32_t depth = 0;
+  auto i = start;
+  while (i < pattern.size()) {
+    switch (pattern[i]) {
+      case '\\':
+        i += 2;
+        break;
+      case '[':
+        i = skipCharacterClass(pattern, i);
+        break;
+      case '(':
+        ++depth;
+        ++i;
+        break;
+      case ')':
+        ++i;
+        if (--depth == 0) {
+          return i;
+        }
+        break;
+      default:
+        ++i;
+    }
+  }
+  return std::string_view::npos;
+}
+} // namespace
+
+RegexLiterals analyzeRegexLiterals(std::string_view pattern) {
+  // The longest literal of each top level alternative.
+  std::vector<std::string> literals;
+  bool literalsOnly = true;
+
+  // The literal being parsed, the longest one of the current alternative and
+  // whether the alternative is a literal.
+  std::string current;
+  std::string longest;
+  bool isLiteral = true;
+  auto endLiteral = [&]() {
+    if (current.size() > longest.size()) {
+      longest = current;
+    }
+    current.clear();
+  };
+  auto endAlternative = [&]() {
+    endLiteral();
+    literals.push_back(std::move(longest));
+    longest.clear();
+    literalsOnly &= isLiteral;
+    isLiteral = true;
+  };
+
+  size_t i = 0;
+  while (i < pattern.size()) {
+    const char c = pattern[i];
+    switch (c) {
+      case '\\':
+        if (i + 1 == pattern.size()) {
+          return {};
+        }
+        // Escaped punctuation is a literal. Escaped letters and digits are
+        // character classes, assertions, or code points, e.g. \d, \b, \x41.
+        if (std::isalnum(static_cast<unsigned char>(pattern[i + 1]))) {
+          endLiteral();
+          isLiteral = false;
+        } else {
+          current.push_back(pattern[i + 1]);
+        }
+        i += 2;
+        break;
+      case '[':
+        i = skipCharacterClass(pattern, i);
+        endLiteral();
+        isLiteral = false;
+        break;
+      case '(':
+        // Flags like (?i) change the meaning of the rest of the pattern.
+        if (pattern.substr(i, 2) == "(?" && pattern.substr(i, 3) != "(?:" &&
+            pattern.substr(i, 4) != "(?P<") {
+          return {};
+        }
+        i = skipGroup(pattern, i);
+        endLiteral();
+        isLiteral = false;
+        break;
+      case ')':
+        return {};
+      case '*':
+      case '?':
+        // The last character is optional.
+        popCharacter(current);
+        endLiteral();
+        isLiteral = false;
+        ++i;
+        break;
+      case '{':
+        // A repetition that may be zero. A '{' that does not start a
+        // repetition is a literal but is skipped all the same.
+        popCharacter(current);
+        endLiteral();
+        isLiteral = false;
+        i = pattern.find('}', i);
+        if (i != std::string_view::npos) {
+          ++i;
+        }
+        break;
+      case '+':
+        // The last character is required but may repeat.
+        endLiteral();
+        isLiteral = false;
+        ++i;
+        break;
+      case '.':
+      case '^':
+      case '$':
+        endLiteral();
+        isLiteral = false;
+        ++i;
+        break;
+      case '|':
+        endAlternative();
+        ++i;
+        break;
+      default:
+        current.push_back(c);
+        ++i;
+    }
+    if (i == std::string_view::npos) {
+      return {};
+    }
+  }
+  endAlternative();
+
+  if (literalsOnly) {
+    return {std::move(literals), true};
+  }
+  for (const auto& literal : literals) {
+    if (literal.empty()) {
+      return {};
+    }
+  }
+  return {std::move(literals), false};
+}
+
 std::shared_ptr<exec::VectorFunction> makeLike(
     const std::string& name,
     const std::vector<exec::VectorFunctionArg>& inputArgs,
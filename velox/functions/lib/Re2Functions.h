@@ -16,6 +16,8 @@
 #pragma once
 
 #include <memory>
+#include <string>
+#include <string_view>
 #include <vector>
 
 #include <re2/re2.h>
@@ -104,6 +106,26 @@ std::vector<std::shared_ptr<exec::FunctionSignature>> re2ExtractSignatures();
 /// {kGenericPattern, 0} for generic patterns).
 std::pair<PatternKind, vector_size_t> determinePatternKind(StringView pattern);
 
+/// Literal strings found in a regular expression by analyzeRegexLiterals().
+struct RegexLiterals {
+  /// Every string that contains a match of the pattern contains at least one
+  /// of 'literals'. Empty if no such literals were found, e.g. for '\d+'.
+  std::vector<std::string> literals;
+
+  /// True if the pattern is an alternation of literals, e.g. 'foo' or
+  /// 'foo|bar\.baz'. A string then contains a match if and only if it
+  /// contains one of 'literals', and fully matches if and only if it is equal
+  /// to one of them.
+  bool literalsOnly{false};
+};
+
+/// Analyzes an RE2 'pattern' for the literals that a string must contain to
+/// match it, so that strings can be matched or rejected without running RE2.
+/// Takes the longest literal of each top level alternative, e.g. 'foo' for
+/// 'fo+[0-9]foo' and {'abc', 'de'} for 'abc\d|x?de'. Returns no literals if
+/// any alternative has none or if the pattern sets flags like (?i).
+RegexLiterals analyzeRegexLiterals(std::string_view pattern);
+
 std::shared_ptr<exec::VectorFunction> makeLike(
     const std::string& name,
     const std::vector<exec::VectorFunctionArg>& inputArgs,
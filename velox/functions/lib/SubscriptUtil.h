@@ -91,6 +91,10 @@ class SubscriptImpl : public exec::Subscript {
   }
 
  private:
+  // Minimum average number of keys per map for binary searching maps whose
+  // keys are not sorted.
+  static constexpr vector_size_t kMinMapSizeForSortedKeys = 16;
+
   VectorPtr applyArray(
       const SelectivityVector& rows,
       std::vector<VectorPtr>& args,
@@ -333,6 +337,27 @@ class SubscriptImpl : public exec::Subscript {
     auto rawSizes = baseMap->rawSizes();
     auto rawOffsets = baseMap->rawOffsets();
 
+    // Large maps are binary searched if their keys are sorted or if the same
+    // maps are subscripted more than once in the batch, in which case the
+    // context sorts the key offsets once for all subscripts. Floating point
+    // keys are scanned since NaN does not order with operator<.
+    bool binarySearch = false;
+    const vector_size_t* sortedOffsets = nullptr;
+    if constexpr (!std::is_floating_point_v<TKey>) {
+      if (baseMap->hasSortedKeys()) {
+        binarySearch = true;
+      } else if (
+          baseMap->size() > 0 &&
+          mapKeys->size() / baseMap->size() >= kMinMapSizeForSortedKeys) {
+        sortedOffsets = context.getSortedMapKeyOffsets(*baseMap);
+        binarySearch = sortedOffsets != nullptr;
+      }
+    }
+    auto keyAt = [&](vector_size_t offset) {
+      return decodedMapKeys->valueAt<TKey>(
+          sortedOffsets ? sortedOffsets[offset] : offset);
+    };
+
     // Lambda that does the search for a key, for each row.
     auto processRow = [&](vector_size_t row, TKey searchKey) {
       size_t mapIndex = mapIndices[row];
@@ -340,16 +365,32 @@ class SubscriptImpl : public exec::Subscript {
       size_t offsetEnd = offsetStart + rawSizes[mapIndex];
       bool found = false;
 
-      // Sequentially check each key on this map for a match. We use a
-      // sequential scan over the keys because it's easier to express (and
-      // likely has good memory locality), but if we find that this is slow
-      // for large maps we could try to canonicalize the whole vector and binary
-      // search `searchKey`.
-      for (size_t offset = offsetStart; offset < offsetEnd; ++offset) {
-        if (decodedMapKeys->valueAt<TKey>(offset) == searchKey) {
-          rawIndices[row] = offset;
-          found = true;
-          break;
+      if (binarySearch) {
+        if constexpr (!std::is_floating_point_v<TKey>) {
+          auto low = offsetStart;
+          auto high = offsetEnd;
+          while (low < high) {
+            const auto middle = low + (high - low) / 2;
+            if (keyAt(middle) < searchKey) {
+              low = middle + 1;
+            } else {
+              high = middle;
+            }
+          }
+          if (low < offsetEnd && keyAt(low) == searchKey) {
+            rawIndices[row] = sortedOffsets ? sortedOffsets[low] : low;
+            found = true;
+          }
+        }
+      } else {
+        // Sequentially check each key on this map for a match. Small maps are
+        // scanned since that has good memory locality and needs no setup.
+        for (size_t offset = offsetStart; offset < offsetEnd; ++offset) {
+          if (decodedMapKeys->valueAt<TKey>(offset) == searchKey) {
+            rawIndices[row] = offset;
+            found = true;
+            break;
+          }
         }
       }
 
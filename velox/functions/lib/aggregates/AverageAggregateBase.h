@@ -16,6 +16,7 @@
 #pragma once
 
 #include "velox/exec/Aggregate.h"
+#include "velox/exec/AggregationHook.h"
 #include "velox/functions/lib/aggregates/DecimalAggregate.h"
 #include "velox/type/DecimalUtil.h"
 #include "velox/vector/ComplexVector.h"
@@ -142,7 +143,13 @@ class AverageAggregateBase : public exec::Aggregate {
       char** groups,
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
-      bool /*mayPushdown*/) override {
+      bool mayPushdown) override {
+    if (canPushdown(args[0], mayPushdown)) {
+      auto update = hookUpdate();
+      pushdown<velox::aggregate::GroupCallableHook<TInput, decltype(update)>>(
+          groups, rows, args[0], update);
+      return;
+    }
     decodedRaw_.decode(*args[0], rows);
     if (decodedRaw_.isConstantMapping()) {
       if (!decodedRaw_.isNullAt(0)) {
@@ -176,7 +183,14 @@ class AverageAggregateBase : public exec::Aggregate {
       char* group,
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
-      bool /*mayPushdown*/) override {
+      bool mayPushdown) override {
+    if (canPushdown(args[0], mayPushdown)) {
+      auto update = hookUpdate();
+      pushdownSingleGroup<
+          velox::aggregate::GroupCallableHook<TInput, decltype(update)>>(
+          group, rows, args[0], update);
+      return;
+    }
     decodedRaw_.decode(*args[0], rows);
 
     if (decodedRaw_.isConstantMapping()) {
@@ -263,6 +277,19 @@ class AverageAggregateBase : public exec::Aggregate {
     return exec::Aggregate::value<SumCount<TAccumulator>>(group);
   }
 
+  static bool canPushdown(const VectorPtr& arg, bool mayPushdown) {
+    return mayPushdown && arg->isLazy() &&
+        velox::aggregate::AggregationHook::supportsPushdown(*arg->type());
+  }
+
+  // Returns the update of the value hook of pushdown(), which adds a value to
+  // the sum and count of a group. The hook clears the null flag.
+  auto hookUpdate() {
+    return [this](char* group, TInput value) {
+      updateNonNullValue<false>(group, TAccumulator(value));
+    };
+  }
+
   template <bool checkNullFields>
   void addIntermediateResultsImpl(
       char** groups,
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <xsimd/xsimd.hpp>
+
 #include "velox/common/base/IOUtils.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/type/HugeInt.h"
@@ -68,6 +70,115 @@ struct LongDecimalWithOverflowState {
   int64_t overflow{0};
 };
 
+namespace detail {
+// Adds 'top' * 2^128 + 'low' to 'accumulator'.
+inline void addWideSum(
+    LongDecimalWithOverflowState& accumulator,
+    int64_t top,
+    __uint128_t low) {
+  const bool lowHasSign = (low >> 127) != 0;
+  if ((top == 0 && !lowHasSign) || (top == -1 && lowHasSign)) {
+    // The sum fits in 128 bits.
+    accumulator.overflow += DecimalUtil::addWithOverflow(
+        accumulator.sum, accumulator.sum, static_cast<int128_t>(low));
+    return;
+  }
+  const bool negative = top < 0;
+  if (negative) {
+    low = ~low + 1;
+    top = ~top + (low == 0 ? 1 : 0);
+  }
+  // The magnitude is a multiple of 2^127 plus a remainder that is added as a
+  // value of the same sign.
+  const int64_t multiples = top * 2 + static_cast<int64_t>(low >> 127);
+  const auto remainder =
+      static_cast<int128_t>(low & ~DecimalUtil::kOverflowMultiplier);
+  accumulator.overflow += negative ? -multiples : multiples;
+  accumulator.overflow += DecimalUtil::addWithOverflow(
+      accumulator.sum, accumulator.sum, negative ? -remainder : remainder);
+}
+} // namespace detail
+
+/// Adds the 'values' of 'rows' to the sum and overflow of 'accumulator'
+/// without checking for overflow per value. Splits the 64-bit words of the
+/// values into 32-bit halves that are summed in 64-bit SIMD lanes, which do
+/// not overflow for the at most 2^31 rows of a vector. The sum is carried into
+/// 'accumulator' once at the end. Does not update the count.
+template <typename T>
+void addDecimalValues(
+    const T* values,
+    const SelectivityVector& rows,
+    LongDecimalWithOverflowState& accumulator) {
+  static_assert(std::is_same_v<T, int64_t> || std::is_same_v<T, int128_t>);
+  constexpr int32_t kWordsPerValue = sizeof(T) / sizeof(uint64_t);
+  // Sums of the low and high halves and of the sign bits of the words at each
+  // position of a value. The sign bit counts only in the last word.
+  uint64_t low[kWordsPerValue] = {};
+  uint64_t high[kWordsPerValue] = {};
+  uint64_t signs[kWordsPerValue] = {};
+  auto addWord = [&](uint64_t word, int32_t position) {
+    low[position] += word & 0xffffffff;
+    high[position] += word >> 32;
+    signs[position] += word >> 63;
+  };
+
+  if (rows.isAllSelected()) {
+    const auto begin = rows.begin();
+    const auto* words = reinterpret_cast<const uint64_t*>(values + begin);
+    const int64_t numWords =
+        static_cast<int64_t>(rows.end() - begin) * kWordsPerValue;
+    using Batch = xsimd::batch<uint64_t>;
+    static_assert(Batch::size % kWordsPerValue == 0);
+    const Batch lowMask(0xffffffff);
+    Batch lowSums(0);
+    Batch highSums(0);
+    Batch signSums(0);
+    int64_t i = 0;
+    for (; i + Batch::size <= numWords; i += Batch::size) {
+      const auto word = Batch::load_unaligned(words + i);
+      lowSums += word & lowMask;
+      highSums += word >> 32;
+      signSums += word >> 63;
+    }
+    uint64_t lanes[3][Batch::size];
+    lowSums.store_unaligned(lanes[0]);
+    highSums.store_unaligned(lanes[1]);
+    signSums.store_unaligned(lanes[2]);
+    for (auto lane = 0; lane < Batch::size; ++lane) {
+      const auto position = lane % kWordsPerValue;
+      low[position] += lanes[0][lane];
+      high[position] += lanes[1][lane];
+      signs[position] += lanes[2][lane];
+    }
+    for (; i < numWords; ++i) {
+      addWord(words[i], i % kWordsPerValue);
+    }
+  } else {
+    rows.applyToSelected([&](vector_size_t row) {
+      const auto* words = reinterpret_cast<const uint64_t*>(values + row);
+      for (auto position = 0; position < kWordsPerValue; ++position) {
+        addWord(words[position], position);
+      }
+    });
+  }
+
+  // The sum is 'top' * 2^128 + 'sum'. A value is its words as unsigned
+  // numbers minus 2^(64 * kWordsPerValue) if the sign bit is set.
+  const __uint128_t first = low[0] + (static_cast<__uint128_t>(high[0]) << 32);
+  if constexpr (kWordsPerValue == 1) {
+    const auto borrow = static_cast<__uint128_t>(signs[0]) << 64;
+    const __uint128_t sum = first - borrow;
+    detail::addWideSum(accumulator, borrow > first ? -1 : 0, sum);
+  } else {
+    const __uint128_t second =
+        low[1] + (static_cast<__uint128_t>(high[1]) << 32);
+    const __uint128_t sum = first + (second << 64);
+    const int64_t top = static_cast<int64_t>(second >> 64) +
+        (sum < first ? 1 : 0) - static_cast<int64_t>(signs[1]);
+    detail::addWideSum(accumulator, top, sum);
+  }
+}
+
 template <typename TResultType, typename TInputType = TResultType>
 class DecimalAggregate : public exec::Aggregate {
  public:
@@ -140,6 +251,22 @@ class DecimalAggregate : public exec::Aggregate {
           updateNonNullValue(group, TResultType(value));
         });
       }
+    } else if (decodedRaw_.isIdentityMapping()) {
+      const SelectivityVector* nonNullRows = &rows;
+      if (decodedRaw_.mayHaveNulls()) {
+        nonNullRows_ = rows;
+        nonNullRows_.deselectNulls(
+            decodedRaw_.nulls(), rows.begin(), rows.end());
+        nonNullRows = &nonNullRows_;
+      }
+      if (!nonNullRows->hasSelections()) {
+        return;
+      }
+      clearNull(group);
+      auto* accumulator = decimalAccumulator(group);
+      addDecimalValues(
+          decodedRaw_.data<TInputType>(), *nonNullRows, *accumulator);
+      accumulator->count += nonNullRows->countSelected();
     } else if (decodedRaw_.mayHaveNulls()) {
       rows.applyToSelected([&](vector_size_t i) {
         if (!decodedRaw_.isNullAt(i)) {
@@ -147,19 +274,6 @@ class DecimalAggregate : public exec::Aggregate {
               group, TResultType(decodedRaw_.valueAt<TInputType>(i)));
         }
       });
-    } else if (!exec::Aggregate::numNulls_ && decodedRaw_.isIdentityMapping()) {
-      const TInputType* data = decodedRaw_.data<TInputType>();
-      LongDecimalWithOverflowState accumulator;
-      rows.applyToSelected([&](vector_size_t i) {
-        accumulator.overflow += DecimalUtil::addWithOverflow(
-            accumulator.sum, data[i], accumulator.sum);
-      });
-      accumulator.count = rows.countSelected();
-      char rawData[LongDecimalWithOverflowState::serializedSize()];
-      StringView serialized(
-          rawData, LongDecimalWithOverflowState::serializedSize());
-      accumulator.serialize(serialized);
-      mergeAccumulators<false>(group, serialized);
     } else {
       LongDecimalWithOverflowState accumulator;
       rows.applyToSelected([&](vector_size_t i) {
@@ -336,6 +450,9 @@ class DecimalAggregate : public exec::Aggregate {
 
   DecodedVector decodedRaw_;
   DecodedVector decodedPartial_;
+
+  // The non-null rows of flat raw input of a single group.
+  SelectivityVector nonNullRows_;
 };
 
 } // namespace facebook::velox::functions::aggregate
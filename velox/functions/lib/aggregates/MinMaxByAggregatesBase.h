@@ -15,6 +15,10 @@
  */
 #pragma once
 
+#include <algorithm>
+
+#include <folly/container/F14Map.h>
+
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/ContainerRowSerde.h"
 #include "velox/functions/lib/aggregates/SingleValueAccumulator.h"
@@ -324,6 +328,17 @@ class MinMaxByAggregateBase : public exec::Aggregate {
         decodedComparison_.isNullAt(0)) {
       return;
     }
+    if constexpr (kDeferValueStores) {
+      winners_.clear();
+      rows.applyToSelected([&](vector_size_t i) {
+        if (!decodedComparison_.isNullAt(i) &&
+            updateComparison(groups[i], decodedComparison_, i, mayUpdate)) {
+          winners_[groups[i]] = i;
+        }
+      });
+      storeWinningValues();
+      return;
+    }
     if (decodedValue_.mayHaveNulls() || decodedComparison_.mayHaveNulls()) {
       rows.applyToSelected([&](vector_size_t i) {
         if (decodedComparison_.isNullAt(i)) {
@@ -362,6 +377,21 @@ class MinMaxByAggregateBase : public exec::Aggregate {
         decodedIntermediateResult_.isNullAt(0)) {
       return;
     }
+    if constexpr (kDeferValueStores) {
+      winners_.clear();
+      rows.applyToSelected([&](vector_size_t i) {
+        if (decodedIntermediateResult_.isNullAt(i)) {
+          return;
+        }
+        const auto decodedIndex = decodedIntermediateResult_.index(i);
+        if (updateComparison(
+                groups[i], decodedComparison_, decodedIndex, mayUpdate)) {
+          winners_[groups[i]] = decodedIndex;
+        }
+      });
+      storeWinningValues();
+      return;
+    }
     if (decodedIntermediateResult_.mayHaveNulls()) {
       rows.applyToSelected([&](vector_size_t i) {
         if (decodedIntermediateResult_.isNullAt(i)) {
@@ -413,6 +443,22 @@ class MinMaxByAggregateBase : public exec::Aggregate {
           0,
           decodedValue_.isNullAt(0),
           mayUpdate);
+    } else if constexpr (isNumeric<U>()) {
+      const auto winner = findWinner(
+          rows,
+          true,
+          [](vector_size_t i) { return i; },
+          [&](vector_size_t i) { return decodedComparison_.isNullAt(i); },
+          mayUpdate);
+      if (winner >= 0) {
+        updateValues(
+            group,
+            decodedValue_,
+            decodedComparison_,
+            winner,
+            decodedValue_.isNullAt(winner),
+            mayUpdate);
+      }
     } else if (
         decodedValue_.mayHaveNulls() || decodedComparison_.mayHaveNulls()) {
       rows.applyToSelected([&](vector_size_t i) {
@@ -464,6 +510,24 @@ class MinMaxByAggregateBase : public exec::Aggregate {
           decodedIndex,
           decodedValue_.isNullAt(decodedIndex),
           mayUpdate);
+    } else if constexpr (isNumeric<U>()) {
+      const auto winner = findWinner(
+          rows,
+          false,
+          [&](vector_size_t i) { return decodedIntermediateResult_.index(i); },
+          [&](vector_size_t i) {
+            return decodedIntermediateResult_.isNullAt(i);
+          },
+          mayUpdate);
+      if (winner >= 0) {
+        updateValues(
+            group,
+            decodedValue_,
+            decodedComparison_,
+            winner,
+            decodedValue_.isNullAt(winner),
+            mayUpdate);
+      }
     } else if (decodedIntermediateResult_.mayHaveNulls()) {
       rows.applyToSelected([&](vector_size_t i) {
         if (decodedIntermediateResult_.isNullAt(i)) {
@@ -501,18 +565,117 @@ class MinMaxByAggregateBase : public exec::Aggregate {
       vector_size_t index,
       bool isValueNull,
       MayUpdate mayUpdate) {
+    if (updateComparison(group, decodedComparisons, index, mayUpdate)) {
+      storeValue(group, decodedValues, index, isValueNull);
+    }
+  }
+
+  // Stores the comparison value at 'index' in 'group' if it is the new
+  // minimum or maximum and returns true if so. The caller then stores the
+  // value.
+  template <typename MayUpdate>
+  inline bool updateComparison(
+      char* group,
+      const DecodedVector& decodedComparisons,
+      vector_size_t index,
+      MayUpdate mayUpdate) {
     auto isFirstValue = isNull(group);
     clearNull(group);
     if (mayUpdate(
             comparisonValue(group), decodedComparisons, index, isFirstValue)) {
-      valueIsNull(group) = isValueNull;
-      if (LIKELY(!isValueNull)) {
-        store<T, ValueAccumulatorType>(
-            value(group), decodedValues, index, allocator_);
-      }
       store<U, ComparisonAccumulatorType>(
           comparisonValue(group), decodedComparisons, index, allocator_);
+      return true;
+    }
+    return false;
+  }
+
+  inline void storeValue(
+      char* group,
+      const DecodedVector& decodedValues,
+      vector_size_t index,
+      bool isValueNull) {
+    valueIsNull(group) = isValueNull;
+    if (LIKELY(!isValueNull)) {
+      store<T, ValueAccumulatorType>(
+          value(group), decodedValues, index, allocator_);
+    }
+  }
+
+  // Copies the value of the last winning row of each group in 'winners_'
+  // into the group.
+  void storeWinningValues() {
+    for (const auto& [group, index] : winners_) {
+      storeValue(group, decodedValue_, index, decodedValue_.isNullAt(index));
+    }
+  }
+
+  // Returns the index in 'decodedComparison_' of the row that would be the
+  // last to replace the minimum or maximum if 'rows' were added one by one to
+  // an empty accumulator, or -1 if all rows are null. Updating an accumulator
+  // with just this row then gives the same result as updating it with all of
+  // 'rows', and copies the value only once. Ties are decided by 'mayUpdate',
+  // so that the winner is the first or the last of equal rows as the
+  // comparator requires. 'indexAt' maps a row to its index in
+  // 'decodedComparison_' and 'isNullAt' tells if a row is skipped. If
+  // 'identityRows' is set, the rows index 'decodedComparison_' directly.
+  template <typename IndexAt, typename IsNullAt, typename MayUpdate>
+  vector_size_t findWinner(
+      const SelectivityVector& rows,
+      bool identityRows,
+      IndexAt indexAt,
+      IsNullAt isNullAt,
+      MayUpdate mayUpdate) {
+    if constexpr (std::is_integral_v<U> && !std::is_same_v<U, bool>) {
+      if (identityRows && rows.isAllSelected() &&
+          decodedComparison_.isIdentityMapping() &&
+          !decodedComparison_.mayHaveNulls()) {
+        return findFlatWinner(rows.end(), mayUpdate);
+      }
     }
+    U best{};
+    vector_size_t winner = -1;
+    rows.applyToSelected([&](vector_size_t i) {
+      if (isNullAt(i)) {
+        return;
+      }
+      const auto index = indexAt(i);
+      if (mayUpdate(&best, decodedComparison_, index, winner < 0)) {
+        best = decodedComparison_.valueAt<U>(index);
+        winner = index;
+      }
+    });
+    return winner;
+  }
+
+  // findWinner() for the first 'size' rows of a flat 'decodedComparison_'
+  // without nulls. Finds the minimum or maximum in a loop that the compiler
+  // vectorizes and then picks the first or the last row with it.
+  template <typename MayUpdate>
+  vector_size_t findFlatWinner(vector_size_t size, MayUpdate mayUpdate) {
+    if (size == 0) {
+      return -1;
+    }
+    const auto* values = decodedComparison_.data<U>();
+    U extreme = values[0];
+    for (auto i = 1; i < size; ++i) {
+      if constexpr (isMaxFunc) {
+        extreme = std::max(extreme, values[i]);
+      } else {
+        extreme = std::min(extreme, values[i]);
+      }
+    }
+    const vector_size_t first = std::find(values, values + size, extreme) -
+        values;
+    vector_size_t last = size - 1;
+    while (values[last] != extreme) {
+      --last;
+    }
+    if (last != first &&
+        mayUpdate(&extreme, decodedComparison_, last, false)) {
+      return last;
+    }
+    return first;
   }
 
   inline ValueAccumulatorType* value(char* group) {
@@ -530,9 +693,18 @@ class MinMaxByAggregateBase : public exec::Aggregate {
         sizeof(ComparisonAccumulatorType));
   }
 
+  // Values are copied once per group and batch when copying them is more
+  // expensive than comparing, i.e. for strings and complex types compared by
+  // a fixed width type.
+  static constexpr bool kDeferValueStores = !isNumeric<T>() && isNumeric<U>();
+
   DecodedVector decodedValue_;
   DecodedVector decodedComparison_;
   DecodedVector decodedIntermediateResult_;
+
+  // The index of the last row that became the minimum or maximum of each
+  // group in the batch being added. Used if 'kDeferValueStores'.
+  folly::F14FastMap<char*, vector_size_t> winners_;
 };
 
 template <
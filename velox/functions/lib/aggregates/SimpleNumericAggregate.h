@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <folly/ScopeGuard.h>
+
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/AggregationHook.h"
 #include "velox/vector/DecodedVector.h"
@@ -157,8 +159,15 @@ class SimpleNumericAggregate : public exec::Aggregate {
       const VectorPtr& arg,
       UpdateSingle updateSingleValue,
       UpdateDuplicate updateDuplicateValues,
-      bool /*mayPushdown*/,
+      bool mayPushdown,
       TData initialValue) {
+    if (mayPushdown && arg->isLazy() &&
+        velox::aggregate::AggregationHook::supportsPushdown(*arg->type())) {
+      exec::Aggregate::template pushdownSingleGroup<
+          velox::aggregate::SimpleCallableHook<TValue, TData, UpdateSingle>>(
+          group, rows, arg, updateSingleValue);
+      return;
+    }
     DecodedVector decoded(*arg, rows);
 
     // Do row by row if not all rows are selected.
@@ -192,37 +201,61 @@ class SimpleNumericAggregate : public exec::Aggregate {
     }
   }
 
-  template <typename THook>
-  void
-  pushdown(char** groups, const SelectivityVector& rows, const VectorPtr& arg) {
-    DecodedVector decoded(*arg, rows, false);
-    const vector_size_t* indices = decoded.indices();
-    THook hook(
-        exec::Aggregate::offset_,
-        exec::Aggregate::nullByte_,
-        exec::Aggregate::nullMask_,
-        groups,
-        &this->exec::Aggregate::numNulls_);
-    // The decoded vector does not really keep the info from the 'rows', except
-    // for the 'upper bound' of it. In case not all rows are selected we need to
-    // generate proper indices, which we 'indirect' through the ones we got from
-    // the decoded vector.
-    vector_size_t numIndices{arg->size()};
-    if (not rows.isAllSelected()) {
-      const auto numSelected = rows.countSelected();
-      if (numSelected != arg->size()) {
-        pushdownCustomIndices_.resize(numSelected);
-        vector_size_t tgtIndex{0};
-        rows.template applyToSelected([&](vector_size_t i) {
-          pushdownCustomIndices_[tgtIndex++] = indices[i];
-        });
-        indices = pushdownCustomIndices_.data();
-        numIndices = numSelected;
+  // Implements Aggregate::addRawInputBySlot() for an 'updateSingleValue' that
+  // is associative and commutative and for which the initial value of the
+  // groups is the identity, e.g. min, max and sum of integers. The values of
+  // the rows of a slot are combined in 'slotValues_' and each group is then
+  // updated once with the combined value.
+  template <typename TData, typename TValue, typename UpdateSingleValue>
+  void updateSlots(
+      char** groups,
+      const uint64_t* slots,
+      uint64_t numSlots,
+      const SelectivityVector& rows,
+      const VectorPtr& arg,
+      UpdateSingleValue updateSingleValue) {
+    static_assert(sizeof(TData) <= sizeof(int64_t));
+    DecodedVector decoded(*arg, rows);
+    if (slotGroups_.size() < numSlots) {
+      slotGroups_.resize(numSlots, nullptr);
+      slotValues_.resize(numSlots);
+    }
+    auto* values = reinterpret_cast<TData*>(slotValues_.data());
+    // Leaves no slot in use if an update throws, e.g. on overflow.
+    auto guard = folly::makeGuard([&]() {
+      for (auto slot : usedSlots_) {
+        slotGroups_[slot] = nullptr;
       }
+      usedSlots_.clear();
+    });
+
+    auto addValue = [&](vector_size_t row, TData value) {
+      const auto slot = slots[row];
+      if (slotGroups_[slot] == nullptr) {
+        slotGroups_[slot] = groups[row];
+        values[slot] = value;
+        usedSlots_.push_back(slot);
+      } else {
+        updateSingleValue(values[slot], value);
+      }
+    };
+    if (decoded.isIdentityMapping() && !decoded.mayHaveNulls() &&
+        !std::is_same_v<TValue, bool>) {
+      auto data = decoded.data<TValue>();
+      rows.applyToSelected(
+          [&](vector_size_t i) { addValue(i, TData(data[i])); });
+    } else {
+      rows.applyToSelected([&](vector_size_t i) {
+        if (!decoded.isNullAt(i)) {
+          addValue(i, TData(decoded.valueAt<TValue>(i)));
+        }
+      });
     }
 
-    decoded.base()->as<const LazyVector>()->load(
-        RowSet(indices, numIndices), &hook);
+    for (auto slot : usedSlots_) {
+      updateNonNullValue<true, TData>(
+          slotGroups_[slot], values[slot], updateSingleValue);
+    }
   }
 
  private:
@@ -239,6 +272,12 @@ class SimpleNumericAggregate : public exec::Aggregate {
     }
     updateValue(*exec::Aggregate::value<TDataType>(group), value);
   }
+
+  // Group and combined value by slot for updateSlots(). Unused slots have a
+  // nullptr group.
+  std::vector<char*> slotGroups_;
+  std::vector<int64_t> slotValues_;
+  std::vector<uint64_t> usedSlots_;
 };
 
 } // namespace facebook::velox::functions::aggregate
@@ -56,6 +56,45 @@ BENCHMARK_NAMED_PARAM_MULTI(regexSearch, bs1k, 1 << 10, "re2_search");
 BENCHMARK_NAMED_PARAM_MULTI(regexSearch, bs10k, 10 << 10, "re2_search");
 BENCHMARK_NAMED_PARAM_MULTI(regexSearch, bs100k, 100 << 10, "re2_search");
 
+// Searches random strings for 'pattern'. The patterns with literals are
+// matched or prefiltered without RE2. A pattern in a non-capturing group,
+// e.g. '(?:hello)', has no literals for the analysis and runs RE2 on every
+// row.
+int regexSearchPattern(int n, const char* pattern) {
+  folly::BenchmarkSuspender kSuspender;
+  FunctionBenchmarkBase benchmarkBase;
+
+  VectorFuzzer::Options opts;
+  opts.vectorSize = 10 << 10;
+  opts.stringLength = 100;
+  auto vector = VectorFuzzer(opts, benchmarkBase.pool()).fuzzFlat(VARCHAR());
+  const auto data = benchmarkBase.maker().rowVector({vector});
+
+  exec::ExprSet expr = benchmarkBase.compileExpression(
+      fmt::format("re2_search(c0, '{}')", pattern), data->type());
+  kSuspender.dismiss();
+  for (int i = 0; i != n; ++i) {
+    benchmarkBase.evaluate(expr, data);
+  }
+  return n * opts.vectorSize;
+}
+
+BENCHMARK_NAMED_PARAM_MULTI(regexSearchPattern, literal, "hello");
+BENCHMARK_NAMED_PARAM_MULTI(regexSearchPattern, literalRe2, "(?:hello)");
+BENCHMARK_NAMED_PARAM_MULTI(
+    regexSearchPattern,
+    alternation,
+    "hello|world|velox");
+BENCHMARK_NAMED_PARAM_MULTI(
+    regexSearchPattern,
+    alternationRe2,
+    "(?:hello|world|velox)");
+BENCHMARK_NAMED_PARAM_MULTI(regexSearchPattern, prefilter, "hel+o[0-9]+");
+BENCHMARK_NAMED_PARAM_MULTI(
+    regexSearchPattern,
+    prefilterRe2,
+    "(?:hel+o[0-9]+)");
+
 int regexExtract(int n, int blockSize) {
   folly::BenchmarkSuspender kSuspender;
   FunctionBenchmarkBase benchmarkBase;
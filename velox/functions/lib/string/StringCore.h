@@ -20,6 +20,7 @@
 #include <string_view>
 #include "folly/CPortability.h"
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/external/utf8proc/utf8procImpl.h"
 
 #if (ENABLE_VECTORIZATION > 0) && !defined(_DEBUG) && !defined(DEBUG)
@@ -44,16 +45,32 @@
 namespace facebook::velox::functions {
 namespace stringCore {
 
+/// Returns the number of bytes before the first byte of 'str' that is not
+/// ascii, or 'length' if all bytes are ascii. Checks a SIMD batch of bytes at
+/// a time.
+FOLLY_ALWAYS_INLINE size_t asciiPrefixLength(const char* str, size_t length) {
+  using Batch = xsimd::batch<int8_t>;
+  const auto* bytes = reinterpret_cast<const int8_t*>(str);
+  size_t i = 0;
+  for (; i + Batch::size <= length; i += Batch::size) {
+    // Bytes that are not ascii have the high bit set and are negative.
+    const auto nonAscii =
+        simd::toBitMask(Batch::load_unaligned(bytes + i) < Batch(0));
+    if (nonAscii != 0) {
+      return i + __builtin_ctz(nonAscii);
+    }
+  }
+  while (i < length && bytes[i] >= 0) {
+    ++i;
+  }
+  return i;
+}
+
 /// Check if a given string is ascii
 static bool isAscii(const char* str, size_t length);
 
 FOLLY_ALWAYS_INLINE bool isAscii(const char* str, size_t length) {
-  for (auto i = 0; i < length; i++) {
-    if (str[i] & 0x80) {
-      return false;
-    }
-  }
-  return true;
+  return asciiPrefixLength(str, length) == length;
 }
 
 /// Perform reverse for ascii string input
@@ -222,10 +239,18 @@ lengthUnicode(const char* inputBuffer, size_t bufferLength) {
   auto currentChar = inputBuffer;
   int64_t size = 0;
   while (currentChar < buffEndAddress) {
-    auto chrOffset = utf8proc_char_length(currentChar);
-    // Skip bad byte if we get utf length < 0.
-    currentChar += UNLIKELY(chrOffset < 0) ? 1 : chrOffset;
-    size++;
+    // Counts a run of ascii characters a SIMD batch at a time.
+    const auto numAscii =
+        asciiPrefixLength(currentChar, buffEndAddress - currentChar);
+    currentChar += numAscii;
+    size += numAscii;
+    // Then the characters up to the next ascii byte one at a time.
+    while (currentChar < buffEndAddress && (*currentChar & 0x80)) {
+      auto chrOffset = utf8proc_char_length(currentChar);
+      // Skip bad byte if we get utf length < 0.
+      currentChar += UNLIKELY(chrOffset < 0) ? 1 : chrOffset;
+      size++;
+    }
   }
   return size;
 }
@@ -197,6 +197,25 @@ TEST_F(StringImplTest, badUnicodeLength) {
   ASSERT_EQ(2, len);
 }
 
+TEST_F(StringImplTest, longMixedStrings) {
+  // Ascii runs of all lengths across SIMD batches, between multi-byte and
+  // bad characters.
+  for (auto numAscii = 0; numAscii < 100; ++numAscii) {
+    const std::string ascii(numAscii, 'a');
+    ASSERT_TRUE(isAscii(ascii.data(), ascii.size()));
+    ASSERT_EQ(numAscii, asciiPrefixLength(ascii.data(), ascii.size()));
+
+    const auto mixed = ascii + "\u04FF" + ascii + "\U0001D437\xFF" + ascii;
+    ASSERT_FALSE(isAscii(mixed.data(), mixed.size()));
+    ASSERT_EQ(numAscii, asciiPrefixLength(mixed.data(), mixed.size()));
+    ASSERT_EQ(3 * numAscii + 3, length</*isAscii*/ false>(mixed));
+  }
+
+  // A truncated character at the end counts as one.
+  const auto truncated = std::string(40, 'a') + "\xE2\x82";
+  ASSERT_EQ(41, length</*isAscii*/ false>(truncated));
+}
+
 TEST_F(StringImplTest, codePointToString) {
   auto testValidInput = [](const int64_t codePoint,
                            const std::string& expectedString) {
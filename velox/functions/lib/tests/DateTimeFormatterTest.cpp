@@ -1355,6 +1355,31 @@ TEST_F(JodaDateTimeFormatterTest, parseConsecutiveSpecifiers) {
   EXPECT_THROW(parseJoda("12312", "yyH"), VeloxUserError);
 }
 
+TEST_F(JodaDateTimeFormatterTest, formatIntoBuffer) {
+  auto* timezone = date::locate_zone("America/Los_Angeles");
+  auto formatter = buildJodaDateTimeFormatter(
+      "EEEE, MMMM dd yyyy HH:mm:ss.SSSSSS a G zzzz 'literal'");
+  const auto maxResultSize = formatter->maxResultSize(timezone);
+  std::string buffer(maxResultSize, '\0');
+  for (const auto* timestamp :
+       {"1970-01-01", "2022-09-14 23:59:59.123", "-1-12-31 01:02:03.004"}) {
+    auto expected =
+        formatter->format(util::fromTimestampString(timestamp), timezone);
+    auto size = formatter->format(
+        util::fromTimestampString(timestamp),
+        timezone,
+        maxResultSize,
+        buffer.data());
+    EXPECT_LE(size, maxResultSize);
+    EXPECT_EQ(expected, std::string_view(buffer.data(), size));
+  }
+  EXPECT_EQ(
+      "Wednesday, September 14 2022 16:59:59.123000 PM AD "
+      "America/Los_Angeles literal",
+      formatter->format(
+          util::fromTimestampString("2022-09-14 23:59:59.123"), timezone));
+}
+
 class MysqlDateTimeTest : public DateTimeFormatterTest {};
 
 TEST_F(MysqlDateTimeTest, validBuild) {
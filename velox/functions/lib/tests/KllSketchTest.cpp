@@ -122,6 +122,40 @@ TEST(KllSketchTest, randomInput) {
   }
 }
 
+TEST(KllSketchTest, insertBatch) {
+  constexpr int N = 1e5;
+  std::vector<double> values(N);
+  std::default_random_engine gen(0);
+  std::uniform_real_distribution<> dist;
+  for (auto& value : values) {
+    value = dist(gen);
+  }
+  KllSketch<double> expected(kDefaultK, {}, 0);
+  for (auto value : values) {
+    expected.insert(value);
+  }
+  // Batches of varying sizes give the same sketch as single inserts.
+  KllSketch<double> kll(kDefaultK, {}, 0);
+  for (int i = 0, batchSize = 1; i < N; batchSize = batchSize * 3 % 1'000) {
+    auto size = std::min(batchSize, N - i);
+    kll.insert(values.data() + i, size);
+    i += size;
+  }
+  EXPECT_EQ(kll.totalCount(), N);
+  auto expectedView = expected.toView();
+  auto view = kll.toView();
+  EXPECT_EQ(view.minValue, expectedView.minValue);
+  EXPECT_EQ(view.maxValue, expectedView.maxValue);
+  EXPECT_EQ(
+      std::vector<double>(view.items.begin(), view.items.end()),
+      std::vector<double>(
+          expectedView.items.begin(), expectedView.items.end()));
+  EXPECT_EQ(
+      std::vector<uint32_t>(view.levels.begin(), view.levels.end()),
+      std::vector<uint32_t>(
+          expectedView.levels.begin(), expectedView.levels.end()));
+}
+
 TEST(KllSketchTest, merge) {
   constexpr int N = 1e4;
   constexpr int M = 1001;
@@ -442,6 +442,78 @@ TEST_F(Re2FunctionsTest, likeDeterminePatternKind) {
   testPattern("foo%bar", PatternKind::kGeneric, 0);
 }
 
+TEST_F(Re2FunctionsTest, analyzeRegexLiterals) {
+  auto test = [](std::string_view pattern,
+                 std::vector<std::string> literals,
+                 bool literalsOnly) {
+    SCOPED_TRACE(pattern);
+    auto result = analyzeRegexLiterals(pattern);
+    EXPECT_EQ(result.literals, literals);
+    EXPECT_EQ(result.literalsOnly, literalsOnly);
+  };
+
+  test("foo", {"foo"}, true);
+  test("foo|bar\\.baz|", {"foo", "bar.baz", ""}, true);
+  test("", {""}, true);
+  test("fo+[0-9]foo", {"foo"}, false);
+  test("abc\\d|x?de", {"abc", "de"}, false);
+  test("ab*c", {"a"}, false);
+  test("a{2,}bc", {"bc"}, false);
+  test("^.*hello.*$", {"hello"}, false);
+  test("(foo|bar)baz", {"baz"}, false);
+  test("[[:alpha:]]]x", {"]x"}, false);
+  test("\u00e9t\u00e9?", {"\u00e9t"}, false);
+
+  // No literal that must occur.
+  test("\\d+", {}, false);
+  test("foo|\\d", {}, false);
+  test("(?i)foo", {}, false);
+  test("[abc]", {}, false);
+}
+
+TEST_F(Re2FunctionsTest, literalPatterns) {
+  // Long strings to cover the batches and the tail of the substring search.
+  const std::string padding(40, 'x');
+  const std::vector<std::string> strings = {
+      "foo",
+      padding + "foo",
+      padding + "fxo" + padding,
+      "fo" + padding + "o",
+      padding + "bar.baz" + padding,
+      padding + "barxbaz",
+      "",
+  };
+  const std::vector<std::string> patterns = {
+      "foo", "foo|bar\\.baz", "xfoo", "xo+|baz", "^x+foo$", "x.foo"};
+  auto data = makeRowVector({makeFlatVector<std::string>(strings)});
+  for (const auto& pattern : patterns) {
+    SCOPED_TRACE(pattern);
+    RE2 re(pattern);
+    std::vector<bool> expectedSearch;
+    std::vector<bool> expectedMatch;
+    std::vector<std::optional<std::string>> expectedExtract;
+    for (const auto& str : strings) {
+      expectedSearch.push_back(RE2::PartialMatch(str, re));
+      expectedMatch.push_back(RE2::FullMatch(str, re));
+      re2::StringPiece match;
+      if (re.Match(str, 0, str.size(), RE2::UNANCHORED, &match, 1)) {
+        expectedExtract.push_back(std::string(match.data(), match.size()));
+      } else {
+        expectedExtract.push_back(std::nullopt);
+      }
+    }
+    assertEqualVectors(
+        makeFlatVector<bool>(expectedSearch),
+        evaluate(fmt::format("re2_search(c0, '{}')", pattern), data));
+    assertEqualVectors(
+        makeFlatVector<bool>(expectedMatch),
+        evaluate(fmt::format("re2_match(c0, '{}')", pattern), data));
+    assertEqualVectors(
+        makeNullableFlatVector<std::string>(expectedExtract),
+        evaluate(fmt::format("re2_extract(c0, '{}')", pattern), data));
+  }
+}
+
 TEST_F(Re2FunctionsTest, likePatternWildcard) {
   auto like = [&](std::string str, std::string pattern) {
     auto likeResult = evaluateOnce<bool>(
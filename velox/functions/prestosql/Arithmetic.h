@@ -42,29 +42,62 @@ namespace {
 
 template <typename T>
 struct PlusFunction {
+  static constexpr bool has_call_batch = true;
+
   template <typename TInput>
   FOLLY_ALWAYS_INLINE void
   call(TInput& result, const TInput& a, const TInput& b) {
     result = plus(a, b);
   }
+
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE void callBatch(
+      TInput* result,
+      const TInput* a,
+      const TInput* b,
+      int32_t size) {
+    binaryBatch(result, a, b, size, [](auto x, auto y) { return x + y; });
+  }
 };
 
 template <typename T>
 struct MinusFunction {
+  static constexpr bool has_call_batch = true;
+
   template <typename TInput>
   FOLLY_ALWAYS_INLINE void
   call(TInput& result, const TInput& a, const TInput& b) {
     result = minus(a, b);
   }
+
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE void callBatch(
+      TInput* result,
+      const TInput* a,
+      const TInput* b,
+      int32_t size) {
+    binaryBatch(result, a, b, size, [](auto x, auto y) { return x - y; });
+  }
 };
 
 template <typename T>
 struct MultiplyFunction {
+  static constexpr bool has_call_batch = true;
+
   template <typename TInput>
   FOLLY_ALWAYS_INLINE void
   call(TInput& result, const TInput& a, const TInput& b) {
     result = multiply(a, b);
   }
+
+  template <typename TInput>
+  FOLLY_ALWAYS_INLINE void callBatch(
+      TInput* result,
+      const TInput* a,
+      const TInput* b,
+      int32_t size) {
+    binaryBatch(result, a, b, size, [](auto x, auto y) { return x * y; });
+  }
 };
 
 template <typename T>
@@ -19,6 +19,7 @@
 #include <cmath>
 #include <type_traits>
 #include "folly/CPortability.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/type/DoubleUtil.h"
 
 namespace facebook::velox::functions {
@@ -86,6 +87,25 @@ T multiply(const T a, const T b)
   return a * b;
 }
 
+// Sets 'result[i]' to 'op(a[i], b[i])' for the first 'size' values, a SIMD
+// batch at a time. 'op' is applied to xsimd batches and to single values for
+// the tail. 'result' may be the same as 'a' or 'b'. Used by the callBatch() of
+// the floating point functions.
+template <typename T, typename TOp>
+FOLLY_ALWAYS_INLINE void
+binaryBatch(T* result, const T* a, const T* b, int32_t size, TOp op) {
+  using Batch = xsimd::batch<T>;
+  constexpr int32_t kBatchSize = Batch::size;
+  int32_t i = 0;
+  for (; i + kBatchSize <= size; i += kBatchSize) {
+    op(Batch::load_unaligned(a + i), Batch::load_unaligned(b + i))
+        .store_unaligned(result + i);
+  }
+  for (; i < size; ++i) {
+    result[i] = op(a[i], b[i]);
+  }
+}
+
 // This is used by Velox for floating points divide.
 template <typename T>
 T divide(const T& a, const T& b)
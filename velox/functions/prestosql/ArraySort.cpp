@@ -15,6 +15,8 @@
  */
 
 #include <folly/container/F14Set.h>
+#include <array>
+#include <numeric>
 
 #include "velox/expression/EvalCtx.h"
 #include "velox/expression/Expr.h"
@@ -26,6 +28,109 @@
 namespace facebook::velox::functions {
 namespace {
 
+// Arrays of scalars with at least this many non-null elements are radix
+// sorted instead of sorted with std::sort.
+constexpr vector_size_t kMinRadixSortSize = 256;
+
+// Returns true for the types whose values order like their toRadixKey().
+template <typename T>
+constexpr bool hasRadixKey() {
+  return std::is_floating_point_v<T> ||
+      (std::is_integral_v<T> && !std::is_same_v<T, bool> &&
+       !std::is_same_v<T, int128_t>);
+}
+
+// Returns an unsigned integer of the width of 'value' that orders like
+// 'value'. NaN orders after all other values, as in SimpleVector::compare().
+template <typename T>
+auto toRadixKey(T value) {
+  if constexpr (std::is_floating_point_v<T>) {
+    using U = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+    constexpr U kSignBit = U(1) << (sizeof(U) * 8 - 1);
+    if (std::isnan(value)) {
+      value = std::numeric_limits<T>::quiet_NaN();
+    }
+    U bits;
+    memcpy(&bits, &value, sizeof(T));
+    return (bits & kSignBit) ? static_cast<U>(~bits) : bits | kSignBit;
+  } else {
+    using U = std::make_unsigned_t<T>;
+    return static_cast<U>(
+        static_cast<U>(value) ^ (U(1) << (sizeof(U) * 8 - 1)));
+  }
+}
+
+// Sorts 'values' ascending with a least significant digit radix sort on
+// bytes of their toRadixKey(). 'scratch' is a buffer reused across calls.
+// Skips the bytes that are the same in all values.
+template <typename T>
+void radixSort(T* values, vector_size_t size, std::vector<T>& scratch) {
+  constexpr int32_t kKeyBits = sizeof(decltype(toRadixKey(T{}))) * 8;
+  scratch.resize(size);
+  T* from = values;
+  T* to = scratch.data();
+  for (auto shift = 0; shift < kKeyBits; shift += 8) {
+    std::array<vector_size_t, 256> counts{};
+    for (auto i = 0; i < size; ++i) {
+      ++counts[(toRadixKey(from[i]) >> shift) & 0xff];
+    }
+    if (std::find(counts.begin(), counts.end(), size) != counts.end()) {
+      continue;
+    }
+    vector_size_t start = 0;
+    for (auto& count : counts) {
+      std::swap(start, count);
+      start += count;
+    }
+    for (auto i = 0; i < size; ++i) {
+      to[counts[(toRadixKey(from[i]) >> shift) & 0xff]++] = from[i];
+    }
+    std::swap(from, to);
+  }
+  if (from != values) {
+    memcpy(values, from, size * sizeof(T));
+  }
+}
+
+// Sorts the indices of the elements of each array by the values of the flat
+// 'elements'. Compares values inline instead of calling BaseVector::compare().
+template <typename T>
+void sortIndicesByValue(
+    const SelectivityVector& rows,
+    const ArrayVector& inputArray,
+    const DecodedVector& decodedElements,
+    const FlatVector<T>& elements,
+    bool ascending,
+    vector_size_t* rawIndices) {
+  const auto* rawValues = elements.rawValues();
+  const auto* decodedIndices = decodedElements.indices();
+  auto keyAt = [&](vector_size_t index) {
+    return toRadixKey(rawValues[decodedIndices[index]]);
+  };
+  rows.applyToSelected([&](vector_size_t row) {
+    const auto size = inputArray.sizeAt(row);
+    const auto offset = inputArray.offsetAt(row);
+    auto* begin = rawIndices + offset;
+    std::iota(begin, begin + size, offset);
+    // Nulls go last.
+    auto* nonNullEnd = begin + size;
+    if (decodedElements.mayHaveNulls()) {
+      nonNullEnd = std::stable_partition(begin, nonNullEnd, [&](auto index) {
+        return !decodedElements.isNullAt(index);
+      });
+    }
+    if (ascending) {
+      std::sort(begin, nonNullEnd, [&](auto left, auto right) {
+        return keyAt(left) < keyAt(right);
+      });
+    } else {
+      std::sort(begin, nonNullEnd, [&](auto left, auto right) {
+        return keyAt(left) > keyAt(right);
+      });
+    }
+  });
+}
+
 BufferPtr sortElements(
     const SelectivityVector& rows,
     const ArrayVector& inputArray,
@@ -42,6 +147,35 @@ BufferPtr sortElements(
   BufferPtr indices = allocateIndices(inputElements.size(), context.pool());
   vector_size_t* rawIndices = indices->asMutable<vector_size_t>();
 
+  if (baseElementsVector->isFlatEncoding()) {
+    auto sortTyped = [&](auto* elements) {
+      sortIndicesByValue(
+          rows, inputArray, *decodedElements, *elements, ascending, rawIndices);
+    };
+    switch (baseElementsVector->typeKind()) {
+      case TypeKind::TINYINT:
+        sortTyped(baseElementsVector->asUnchecked<FlatVector<int8_t>>());
+        return indices;
+      case TypeKind::SMALLINT:
+        sortTyped(baseElementsVector->asUnchecked<FlatVector<int16_t>>());
+        return indices;
+      case TypeKind::INTEGER:
+        sortTyped(baseElementsVector->asUnchecked<FlatVector<int32_t>>());
+        return indices;
+      case TypeKind::BIGINT:
+        sortTyped(baseElementsVector->asUnchecked<FlatVector<int64_t>>());
+        return indices;
+      case TypeKind::REAL:
+        sortTyped(baseElementsVector->asUnchecked<FlatVector<float>>());
+        return indices;
+      case TypeKind::DOUBLE:
+        sortTyped(baseElementsVector->asUnchecked<FlatVector<double>>());
+        return indices;
+      default:
+        break;
+    }
+  }
+
   const CompareFlags flags{.nullsFirst = false, .ascending = ascending};
   auto decodedIndices = decodedElements->indices();
 
@@ -127,6 +261,7 @@ void applyScalarType(
       inputElements.get(), inputElementRows, /*toSourceRow=*/nullptr);
 
   auto flatResults = resultElements->asFlatVector<T>();
+  std::vector<T> scratch;
 
   auto processRow = [&](vector_size_t row) {
     const auto size = inputArray->sizeAt(row);
@@ -160,6 +295,15 @@ void applyScalarType(
       }
     } else {
       T* resultRawValues = flatResults->mutableRawValues();
+      if constexpr (hasRadixKey<T>()) {
+        if (endRow - startRow >= kMinRadixSortSize) {
+          radixSort(resultRawValues + startRow, endRow - startRow, scratch);
+          if (!ascending) {
+            std::reverse(resultRawValues + startRow, resultRawValues + endRow);
+          }
+          return;
+        }
+      }
       if (ascending) {
         std::sort(resultRawValues + startRow, resultRawValues + endRow);
       } else {
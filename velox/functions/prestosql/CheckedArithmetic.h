@@ -50,21 +50,23 @@ struct CheckedMultiplyFunction {
   }
 };
 
+// Division and modulus report division by zero as an error Status so that
+// rows with a zero divisor do not throw an exception each, e.g. under TRY.
 template <typename T>
 struct CheckedDivideFunction {
   template <typename TInput>
-  FOLLY_ALWAYS_INLINE void
+  FOLLY_ALWAYS_INLINE Status
   call(TInput& result, const TInput& a, const TInput& b) {
-    result = checkedDivide(a, b);
+    return tryCheckedDivide(a, b, result);
   }
 };
 
 template <typename T>
 struct CheckedModulusFunction {
   template <typename TInput>
-  FOLLY_ALWAYS_INLINE void
+  FOLLY_ALWAYS_INLINE Status
   call(TInput& result, const TInput& a, const TInput& b) {
-    result = checkedModulus(a, b);
+    return tryCheckedModulus(a, b, result);
   }
 };
 
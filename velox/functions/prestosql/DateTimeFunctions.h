@@ -85,13 +85,9 @@ struct TimestampWithTimezoneSupport {
   int64_t getGMTOffsetSec(
       const arg_type<TimestampWithTimezone>& timestampWithTimezone) {
     Timestamp inputTimeStamp = this->toTimestamp(timestampWithTimezone);
-    // Get the given timezone name
-    auto timezone =
-        util::getTimeZoneName(*timestampWithTimezone.template at<1>());
-    auto* timezonePtr = date::locate_zone(timezone);
     // Create a copy of inputTimeStamp and convert it to GMT
     auto gmtTimeStamp = inputTimeStamp;
-    gmtTimeStamp.toGMT(*timezonePtr);
+    gmtTimeStamp.toGMT(*timestampWithTimezone.template at<1>());
     // Get offset in seconds with GMT and convert to hour
     return (inputTimeStamp.getSeconds() - gmtTimeStamp.getSeconds());
   }
@@ -1054,11 +1050,13 @@ struct DateFormatFunction : public TimestampWithTimezoneSupport<T> {
   const date::time_zone* sessionTimeZone_ = nullptr;
   std::shared_ptr<DateTimeFormatter> mysqlDateTime_;
   bool isConstFormat_ = false;
+  int32_t maxResultSize_;
 
   FOLLY_ALWAYS_INLINE void setFormatter(const arg_type<Varchar>* formatString) {
     if (formatString != nullptr) {
       mysqlDateTime_ = buildMysqlDateTimeFormatter(
           std::string_view(formatString->data(), formatString->size()));
+      maxResultSize_ = mysqlDateTime_->maxResultSize(sessionTimeZone_);
       isConstFormat_ = true;
     }
   }
@@ -1085,14 +1083,13 @@ struct DateFormatFunction : public TimestampWithTimezoneSupport<T> {
     if (!isConstFormat_) {
       mysqlDateTime_ = buildMysqlDateTimeFormatter(
           std::string_view(formatString.data(), formatString.size()));
+      maxResultSize_ = mysqlDateTime_->maxResultSize(sessionTimeZone_);
     }
 
-    auto formattedResult = mysqlDateTime_->format(timestamp, sessionTimeZone_);
-    auto resultSize = formattedResult.size();
+    result.reserve(maxResultSize_);
+    const auto resultSize = mysqlDateTime_->format(
+        timestamp, sessionTimeZone_, maxResultSize_, result.data());
     result.resize(resultSize);
-    if (resultSize != 0) {
-      std::memcpy(result.data(), formattedResult.data(), resultSize);
-    }
     return true;
   }
 
@@ -1157,6 +1154,7 @@ struct FormatDateTimeFunction {
   const date::time_zone* sessionTimeZone_ = nullptr;
   std::shared_ptr<DateTimeFormatter> jodaDateTime_;
   bool isConstFormat_ = false;
+  int32_t maxResultSize_;
 
   FOLLY_ALWAYS_INLINE void initialize(
       const core::QueryConfig& config,
@@ -1166,6 +1164,7 @@ struct FormatDateTimeFunction {
     if (formatString != nullptr) {
       jodaDateTime_ = buildJodaDateTimeFormatter(
           std::string_view(formatString->data(), formatString->size()));
+      maxResultSize_ = jodaDateTime_->maxResultSize(sessionTimeZone_);
       isConstFormat_ = true;
     }
   }
@@ -1177,14 +1176,13 @@ struct FormatDateTimeFunction {
     if (!isConstFormat_) {
       jodaDateTime_ = buildJodaDateTimeFormatter(
           std::string_view(formatString.data(), formatString.size()));
+      maxResultSize_ = jodaDateTime_->maxResultSize(sessionTimeZone_);
     }
 
-    auto formattedResult = jodaDateTime_->format(timestamp, sessionTimeZone_);
-    auto resultSize = formattedResult.size();
+    result.reserve(maxResultSize_);
+    const auto resultSize = jodaDateTime_->format(
+        timestamp, sessionTimeZone_, maxResultSize_, result.data());
     result.resize(resultSize);
-    if (resultSize != 0) {
-      std::memcpy(result.data(), formattedResult.data(), resultSize);
-    }
     return true;
   }
 };
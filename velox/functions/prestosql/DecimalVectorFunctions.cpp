@@ -37,8 +37,11 @@ template <
     typename Operation /* Arithmetic operation */>
 class DecimalBaseFunction : public exec::VectorFunction {
  public:
-  DecimalBaseFunction(uint8_t aRescale, uint8_t bRescale)
-      : aRescale_(aRescale), bRescale_(bRescale) {}
+  /// 'mayOverflow' is false if the precisions of the arguments prove that the
+  /// result fits in the result precision, in which case flat and constant
+  /// arguments are processed without overflow checks.
+  DecimalBaseFunction(uint8_t aRescale, uint8_t bRescale, bool mayOverflow)
+      : aRescale_(aRescale), bRescale_(bRescale), mayOverflow_(mayOverflow) {}
 
   void apply(
       const SelectivityVector& rows,
@@ -47,6 +50,9 @@ class DecimalBaseFunction : public exec::VectorFunction {
       exec::EvalCtx& context,
       VectorPtr& result) const override {
     auto rawResults = prepareResults(rows, resultType, context, result);
+    if (!mayOverflow_ && applyNoOverflow(rows, args, rawResults)) {
+      return;
+    }
     if (args[0]->isConstantEncoding() && args[1]->isFlatEncoding()) {
       // Fast path for (const, flat).
       auto constant = args[0]->asUnchecked<SimpleVector<A>>()->valueAt(0);
@@ -92,6 +98,57 @@ class DecimalBaseFunction : public exec::VectorFunction {
   }
 
  private:
+  // Computes the result for flat and constant arguments without overflow
+  // checks. Nothing can throw, so the rows are not wrapped in try-catch and if
+  // all rows are selected, the loop has no gaps and can be vectorized by the
+  // compiler. Returns false if an argument is encoded otherwise.
+  bool applyNoOverflow(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      R* rawResults) const {
+    const bool aConstant = args[0]->isConstantEncoding();
+    const bool bConstant = args[1]->isConstantEncoding();
+    if ((!aConstant && !args[0]->isFlatEncoding()) ||
+        (!bConstant && !args[1]->isFlatEncoding()) ||
+        (aConstant && bConstant)) {
+      return false;
+    }
+    if (aConstant) {
+      auto constant = args[0]->asUnchecked<SimpleVector<A>>()->valueAt(0);
+      auto rawB = args[1]->asUnchecked<FlatVector<B>>()->rawValues();
+      applyToRows(rows, [&](auto row) {
+        Operation::template applyNoOverflow<R, A, B>(
+            rawResults[row], constant, rawB[row], aRescale_, bRescale_);
+      });
+    } else if (bConstant) {
+      auto rawA = args[0]->asUnchecked<FlatVector<A>>()->rawValues();
+      auto constant = args[1]->asUnchecked<SimpleVector<B>>()->valueAt(0);
+      applyToRows(rows, [&](auto row) {
+        Operation::template applyNoOverflow<R, A, B>(
+            rawResults[row], rawA[row], constant, aRescale_, bRescale_);
+      });
+    } else {
+      auto rawA = args[0]->asUnchecked<FlatVector<A>>()->rawValues();
+      auto rawB = args[1]->asUnchecked<FlatVector<B>>()->rawValues();
+      applyToRows(rows, [&](auto row) {
+        Operation::template applyNoOverflow<R, A, B>(
+            rawResults[row], rawA[row], rawB[row], aRescale_, bRescale_);
+      });
+    }
+    return true;
+  }
+
+  template <typename Func>
+  static void applyToRows(const SelectivityVector& rows, Func func) {
+    if (rows.isAllSelected()) {
+      for (auto row = rows.begin(); row < rows.end(); ++row) {
+        func(row);
+      }
+    } else {
+      rows.applyToSelected(func);
+    }
+  }
+
   R* prepareResults(
       const SelectivityVector& rows,
       const TypePtr& resultType,
@@ -104,6 +161,7 @@ class DecimalBaseFunction : public exec::VectorFunction {
 
   const uint8_t aRescale_;
   const uint8_t bRescale_;
+  const bool mayOverflow_;
 };
 
 template <
@@ -292,6 +350,17 @@ class Addition {
     DecimalUtil::valueInRange(r);
   }
 
+  template <typename R, typename A, typename B>
+  inline static void applyNoOverflow(
+      R& r,
+      const A& a,
+      const B& b,
+      uint8_t aRescale,
+      uint8_t bRescale) {
+    r = R(a) * R(DecimalUtil::kPowersOfTen[aRescale]) +
+        R(b) * R(DecimalUtil::kPowersOfTen[bRescale]);
+  }
+
   inline static uint8_t
   computeRescaleFactor(uint8_t fromScale, uint8_t toScale, uint8_t rScale = 0) {
     return std::max(0, toScale - fromScale);
@@ -303,12 +372,30 @@ class Addition {
       const uint8_t bPrecision,
       const uint8_t bScale) {
     return {
-        std::min(
-            38,
-            std::max(aPrecision - aScale, bPrecision - bScale) +
-                std::max(aScale, bScale) + 1),
+        std::min(38, uncappedPrecision(aPrecision, aScale, bPrecision, bScale)),
         std::max(aScale, bScale)};
   }
+
+  // The result type has one more integer digit than the wider argument, so
+  // the result can only overflow if its precision is capped at 38.
+  inline static bool mayOverflow(
+      const uint8_t aPrecision,
+      const uint8_t aScale,
+      const uint8_t bPrecision,
+      const uint8_t bScale) {
+    return uncappedPrecision(aPrecision, aScale, bPrecision, bScale) >
+        LongDecimalType::kMaxPrecision;
+  }
+
+ private:
+  inline static int32_t uncappedPrecision(
+      const uint8_t aPrecision,
+      const uint8_t aScale,
+      const uint8_t bPrecision,
+      const uint8_t bScale) {
+    return std::max(aPrecision - aScale, bPrecision - bScale) +
+        std::max(aScale, bScale) + 1;
+  }
 };
 
 class Subtraction {
@@ -334,6 +421,17 @@ class Subtraction {
     DecimalUtil::valueInRange(r);
   }
 
+  template <typename R, typename A, typename B>
+  inline static void applyNoOverflow(
+      R& r,
+      const A& a,
+      const B& b,
+      uint8_t aRescale,
+      uint8_t bRescale) {
+    r = R(a) * R(DecimalUtil::kPowersOfTen[aRescale]) -
+        R(b) * R(DecimalUtil::kPowersOfTen[bRescale]);
+  }
+
   inline static uint8_t
   computeRescaleFactor(uint8_t fromScale, uint8_t toScale, uint8_t rScale = 0) {
     return std::max(0, toScale - fromScale);
@@ -347,6 +445,14 @@ class Subtraction {
     return Addition::computeResultPrecisionScale(
         aPrecision, aScale, bPrecision, bScale);
   }
+
+  inline static bool mayOverflow(
+      const uint8_t aPrecision,
+      const uint8_t aScale,
+      const uint8_t bPrecision,
+      const uint8_t bScale) {
+    return Addition::mayOverflow(aPrecision, aScale, bPrecision, bScale);
+  }
 };
 
 class Multiply {
@@ -360,6 +466,17 @@ class Multiply {
     DecimalUtil::valueInRange(r);
   }
 
+  template <typename R, typename A, typename B>
+  inline static void applyNoOverflow(
+      R& r,
+      const A& a,
+      const B& b,
+      uint8_t aRescale,
+      uint8_t bRescale) {
+    // The rescale factors of multiplication are 0.
+    r = R(a) * R(b);
+  }
+
   inline static uint8_t
   computeRescaleFactor(uint8_t fromScale, uint8_t toScale, uint8_t rScale = 0) {
     return 0;
@@ -372,6 +489,16 @@ class Multiply {
       const uint8_t bScale) {
     return {std::min(38, aPrecision + bPrecision), aScale + bScale};
   }
+
+  // The product of numbers of 'aPrecision' and 'bPrecision' digits has at
+  // most 'aPrecision' + 'bPrecision' digits.
+  inline static bool mayOverflow(
+      const uint8_t aPrecision,
+      const uint8_t /*aScale*/,
+      const uint8_t bPrecision,
+      const uint8_t /*bScale*/) {
+    return aPrecision + bPrecision > LongDecimalType::kMaxPrecision;
+  }
 };
 
 class Divide {
@@ -383,6 +510,16 @@ class Divide {
     DecimalUtil::valueInRange(r);
   }
 
+  template <typename R, typename A, typename B>
+  inline static void applyNoOverflow(
+      R& r,
+      const A& a,
+      const B& b,
+      uint8_t aRescale,
+      uint8_t bRescale) {
+    apply<R, A, B>(r, a, b, aRescale, bRescale);
+  }
+
   inline static uint8_t
   computeRescaleFactor(uint8_t fromScale, uint8_t toScale, uint8_t rScale) {
     return rScale - fromScale + toScale;
@@ -397,6 +534,15 @@ class Divide {
         std::min(38, aPrecision + bScale + std::max(0, bScale - aScale)),
         std::max(aScale, bScale)};
   }
+
+  // Division by zero is an error for any precision.
+  inline static bool mayOverflow(
+      const uint8_t /*aPrecision*/,
+      const uint8_t /*aScale*/,
+      const uint8_t /*bPrecision*/,
+      const uint8_t /*bScale*/) {
+    return true;
+  }
 };
 
 class Round {
@@ -650,6 +796,8 @@ std::shared_ptr<exec::VectorFunction> createDecimalFunction(
       aPrecision, aScale, bPrecision, bScale);
   uint8_t aRescale = Operation::computeRescaleFactor(aScale, bScale, rScale);
   uint8_t bRescale = Operation::computeRescaleFactor(bScale, aScale, rScale);
+  const bool mayOverflow =
+      Operation::mayOverflow(aPrecision, aScale, bPrecision, bScale);
   if (aType->isShortDecimal()) {
     if (bType->isShortDecimal()) {
       if (rPrecision > ShortDecimalType::kMaxPrecision) {
@@ -658,14 +806,14 @@ std::shared_ptr<exec::VectorFunction> createDecimalFunction(
             int128_t /*result*/,
             int64_t,
             int64_t,
-            Operation>>(aRescale, bRescale);
+            Operation>>(aRescale, bRescale, mayOverflow);
       } else {
         // Arguments are short decimals and result is a short decimal.
         return std::make_shared<DecimalBaseFunction<
             int64_t /*result*/,
             int64_t,
             int64_t,
-            Operation>>(aRescale, bRescale);
+            Operation>>(aRescale, bRescale, mayOverflow);
       }
     } else {
       if (rPrecision > ShortDecimalType::kMaxPrecision) {
@@ -675,7 +823,7 @@ std::shared_ptr<exec::VectorFunction> createDecimalFunction(
             int128_t /*result*/,
             int64_t,
             int128_t,
-            Operation>>(aRescale, bRescale);
+            Operation>>(aRescale, bRescale, mayOverflow);
       } else {
         // In some cases such as division, the result type can still be a short
         // decimal even though RHS is a long decimal.
@@ -683,7 +831,7 @@ std::shared_ptr<exec::VectorFunction> createDecimalFunction(
             int64_t /*result*/,
             int64_t,
             int128_t,
-            Operation>>(aRescale, bRescale);
+            Operation>>(aRescale, bRescale, mayOverflow);
       }
     }
   } else {
@@ -693,14 +841,14 @@ std::shared_ptr<exec::VectorFunction> createDecimalFunction(
           int128_t /*result*/,
           int128_t,
           int64_t,
-          Operation>>(aRescale, bRescale);
+          Operation>>(aRescale, bRescale, mayOverflow);
     } else {
       // Arguments and result are all long decimals.
       return std::make_shared<DecimalBaseFunction<
           int128_t /*result*/,
           int128_t,
           int128_t,
-          Operation>>(aRescale, bRescale);
+          Operation>>(aRescale, bRescale, mayOverflow);
     }
   }
   VELOX_UNSUPPORTED();
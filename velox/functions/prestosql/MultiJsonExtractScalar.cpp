@@ -0,0 +1,308 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/functions/prestosql/MultiJsonExtractScalar.h"
+
+#include <folly/container/F14Map.h>
+
+#include "velox/expression/EvalCtx.h"
+#include "velox/functions/prestosql/SIMDJsonFunctions.h"
+
+namespace facebook::velox::functions {
+namespace {
+
+struct TypedExprHasher {
+  size_t operator()(const core::ITypedExpr* expr) const {
+    return expr->hash();
+  }
+};
+
+struct TypedExprComparer {
+  bool operator()(const core::ITypedExpr* lhs, const core::ITypedExpr* rhs)
+      const {
+    return *lhs == *rhs;
+  }
+};
+
+// Returns the value of 'expr' if it is a non-null VARCHAR constant.
+std::optional<std::string> constantString(const core::TypedExprPtr& expr) {
+  auto constant = dynamic_cast<const core::ConstantTypedExpr*>(expr.get());
+  if (constant == nullptr || constant->type()->kind() != TypeKind::VARCHAR) {
+    return std::nullopt;
+  }
+  if (constant->hasValueVector()) {
+    const auto& vector = constant->valueVector();
+    if (vector->isNullAt(0)) {
+      return std::nullopt;
+    }
+    return vector->as<SimpleVector<StringView>>()->valueAt(0).str();
+  }
+  if (constant->value().isNull()) {
+    return std::nullopt;
+  }
+  return constant->value().value<TypeKind::VARCHAR>();
+}
+
+// Returns true if the inputs of 'expr' are compiled in the same scope as
+// 'expr' and can be rewritten. This is not the case for the body of a lambda.
+bool canRewriteInputs(const core::ITypedExpr& expr) {
+  if (auto access = dynamic_cast<const core::FieldAccessTypedExpr*>(&expr)) {
+    return !access->inputs().empty();
+  }
+  return dynamic_cast<const core::CallTypedExpr*>(&expr) ||
+      dynamic_cast<const core::CastTypedExpr*>(&expr) ||
+      dynamic_cast<const core::ConcatTypedExpr*>(&expr);
+}
+
+// Returns a copy of 'expr' with 'inputs'. 'expr' must be one of the kinds
+// accepted by canRewriteInputs().
+core::TypedExprPtr withInputs(
+    const core::TypedExprPtr& expr,
+    std::vector<core::TypedExprPtr> inputs) {
+  if (auto call = dynamic_cast<const core::CallTypedExpr*>(expr.get())) {
+    return std::make_shared<core::CallTypedExpr>(
+        expr->type(), std::move(inputs), call->name());
+  }
+  if (auto cast = dynamic_cast<const core::CastTypedExpr*>(expr.get())) {
+    return std::make_shared<core::CastTypedExpr>(
+        expr->type(), inputs, cast->nullOnFailure());
+  }
+  if (dynamic_cast<const core::ConcatTypedExpr*>(expr.get())) {
+    return std::make_shared<core::ConcatTypedExpr>(
+        expr->type()->asRow().names(), inputs);
+  }
+  auto access = dynamic_cast<const core::FieldAccessTypedExpr*>(expr.get());
+  VELOX_CHECK_NOT_NULL(access);
+  return std::make_shared<core::FieldAccessTypedExpr>(
+      expr->type(), inputs[0], access->name());
+}
+
+class JsonExtractScalarRewriter {
+ public:
+  explicit JsonExtractScalarRewriter(const std::string& prefix)
+      : name_(prefix + "json_extract_scalar"),
+        multiName_(prefix + kMultiJsonExtractScalar) {}
+
+  // Records the paths of the json_extract_scalar calls in 'expr'. Returns
+  // true if some input has calls with more than one path.
+  bool collect(const core::TypedExprPtr& expr) {
+    bool found = false;
+    if (auto path = extractedPath(expr)) {
+      auto& group = groups_[expr->inputs()[0].get()];
+      if (group.indices.emplace(*path, group.paths.size()).second) {
+        group.paths.push_back(*path);
+      }
+      found = group.paths.size() > 1;
+    }
+    if (canRewriteInputs(*expr)) {
+      for (const auto& input : expr->inputs()) {
+        found |= collect(input);
+      }
+    }
+    return found;
+  }
+
+  core::TypedExprPtr rewrite(const core::TypedExprPtr& expr) {
+    if (auto path = extractedPath(expr)) {
+      auto it = groups_.find(expr->inputs()[0].get());
+      VELOX_CHECK(it != groups_.end());
+      auto& group = it->second;
+      if (group.paths.size() > 1) {
+        return std::make_shared<core::FieldAccessTypedExpr>(
+            VARCHAR(),
+            multiExtract(expr->inputs()[0], group),
+            fieldName(group.indices[*path]));
+      }
+    }
+    if (!canRewriteInputs(*expr)) {
+      return expr;
+    }
+    std::vector<core::TypedExprPtr> inputs;
+    inputs.reserve(expr->inputs().size());
+    for (const auto& input : expr->inputs()) {
+      inputs.push_back(rewrite(input));
+    }
+    return withInputs(expr, std::move(inputs));
+  }
+
+ private:
+  // The JSON paths extracted from one input, in the order of first use.
+  struct PathGroup {
+    std::vector<std::string> paths;
+    folly::F14FastMap<std::string, int32_t> indices;
+    // The call that extracts all 'paths'. Shared by all the rewritten calls
+    // so that it is compiled and evaluated once.
+    core::TypedExprPtr multiExtract;
+  };
+
+  static std::string fieldName(int32_t index) {
+    return fmt::format("p{}", index);
+  }
+
+  // Returns the path of 'expr' if it is a json_extract_scalar call with a
+  // valid constant path.
+  std::optional<std::string> extractedPath(const core::TypedExprPtr& expr) {
+    auto call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+    if (call == nullptr || call->name() != name_ ||
+        call->inputs().size() != 2) {
+      return std::nullopt;
+    }
+    auto path = constantString(call->inputs()[1]);
+    if (!path.has_value() || !SIMDJsonMultiExtractor::isValidPath(*path)) {
+      // Invalid paths fail for each row, leave them to json_extract_scalar.
+      return std::nullopt;
+    }
+    return path;
+  }
+
+  const core::TypedExprPtr& multiExtract(
+      const core::TypedExprPtr& json,
+      PathGroup& group) {
+    if (group.multiExtract == nullptr) {
+      std::vector<std::string> names;
+      std::vector<TypePtr> types(group.paths.size(), VARCHAR());
+      std::vector<core::TypedExprPtr> inputs;
+      inputs.push_back(rewrite(json));
+      for (auto i = 0; i < group.paths.size(); ++i) {
+        names.push_back(fieldName(i));
+        inputs.push_back(std::make_shared<core::ConstantTypedExpr>(
+            VARCHAR(), variant(group.paths[i])));
+      }
+      group.multiExtract = std::make_shared<core::CallTypedExpr>(
+          ROW(std::move(names), std::move(types)),
+          std::move(inputs),
+          multiName_);
+    }
+    return group.multiExtract;
+  }
+
+  const std::string name_;
+  const std::string multiName_;
+  // Keyed by the JSON input. Equal inputs share a group.
+  folly::F14NodeMap<
+      const core::ITypedExpr*,
+      PathGroup,
+      TypedExprHasher,
+      TypedExprComparer>
+      groups_;
+};
+
+class MultiJsonExtractScalarFunction : public exec::VectorFunction {
+ public:
+  explicit MultiJsonExtractScalarFunction(
+      const std::vector<std::string>& paths)
+      : extractor_(paths) {}
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& outputType,
+      exec::EvalCtx& context,
+      VectorPtr& result) const override {
+    exec::LocalDecodedVector json(context, *args[0], rows);
+
+    const auto numPaths = extractor_.numPaths();
+    std::vector<VectorPtr> fields(numPaths);
+    std::vector<FlatVector<StringView>*> flatFields(numPaths);
+    for (auto i = 0; i < numPaths; ++i) {
+      fields[i] = BaseVector::create(VARCHAR(), rows.end(), context.pool());
+      flatFields[i] = fields[i]->asFlatVector<StringView>();
+    }
+
+    std::vector<detail::JsonExtractScalarConsumer> consumers(numPaths);
+    std::vector<bool> succeeded;
+    rows.applyToSelected([&](auto row) {
+      for (auto& consumer : consumers) {
+        consumer.reset();
+      }
+      extractor_.extract(
+          json->valueAt<StringView>(row),
+          [&](size_t i, auto& v) { consumers[i](v); },
+          succeeded);
+      for (auto i = 0; i < numPaths; ++i) {
+        if (succeeded[i] && consumers[i].result.has_value()) {
+          flatFields[i]->set(row, StringView(*consumers[i].result));
+        } else {
+          flatFields[i]->setNull(row, true);
+        }
+      }
+    });
+
+    auto localResult = std::make_shared<RowVector>(
+        context.pool(), outputType, nullptr, rows.end(), std::move(fields));
+    context.moveOrCopyResult(localResult, rows, result);
+  }
+
+ private:
+  const SIMDJsonMultiExtractor extractor_;
+};
+
+} // namespace
+
+std::vector<core::TypedExprPtr> rewriteJsonExtractScalarCalls(
+    const std::string& prefix,
+    const std::vector<core::TypedExprPtr>& exprs) {
+  JsonExtractScalarRewriter rewriter(prefix);
+  bool found = false;
+  for (const auto& expr : exprs) {
+    found |= rewriter.collect(expr);
+  }
+  if (!found) {
+    return {};
+  }
+  std::vector<core::TypedExprPtr> rewritten;
+  rewritten.reserve(exprs.size());
+  for (const auto& expr : exprs) {
+    rewritten.push_back(rewriter.rewrite(expr));
+  }
+  return rewritten;
+}
+
+std::shared_ptr<exec::VectorFunction> makeMultiJsonExtractScalar(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& /*config*/) {
+  VELOX_CHECK_GE(inputArgs.size(), 2);
+  std::vector<std::string> paths;
+  for (auto i = 1; i < inputArgs.size(); ++i) {
+    const auto& path = inputArgs[i].constantValue;
+    VELOX_USER_CHECK(
+        path != nullptr && !path->isNullAt(0),
+        "JSON paths of {} must be constant and not null",
+        name);
+    paths.push_back(path->as<ConstantVector<StringView>>()->valueAt(0).str());
+  }
+  return std::make_shared<MultiJsonExtractScalarFunction>(paths);
+}
+
+std::vector<std::shared_ptr<exec::FunctionSignature>>
+multiJsonExtractScalarSignatures() {
+  // json, varchar... -> row(varchar...)
+  // varchar, varchar... -> row(varchar...)
+  // The result has one field per path. The signatures cannot express that,
+  // but the result type of the call is set by the rewrite.
+  std::vector<std::shared_ptr<exec::FunctionSignature>> signatures;
+  for (const auto& jsonType : {"json", "varchar"}) {
+    signatures.push_back(exec::FunctionSignatureBuilder()
+                             .returnType("row(varchar)")
+                             .argumentType(jsonType)
+                             .argumentType("varchar")
+                             .variableArity()
+                             .build());
+  }
+  return signatures;
+}
+
+} // namespace facebook::velox::functions
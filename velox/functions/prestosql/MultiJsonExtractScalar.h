@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/core/Expressions.h"
+#include "velox/expression/VectorFunction.h"
+
+namespace facebook::velox::functions {
+
+/// Name of the internal function that extracts several JSON paths at once,
+/// without the registration prefix.
+inline const std::string kMultiJsonExtractScalar =
+    "$internal$multi_json_extract_scalar";
+
+/// Finds json_extract_scalar(x, path) calls with constant paths on the same
+/// x in 'exprs' and replaces them with dereferences of one common
+/// subexpression that extracts all the paths, parsing each document in x
+/// once instead of once per path. For example, rewrites
+///     json_extract_scalar(x, '$.a'), json_extract_scalar(x, '$.b')
+/// into
+///     m.p0, m.p1
+/// where m is $internal$multi_json_extract_scalar(x, '$.a', '$.b') and returns
+/// row(p0 varchar, p1 varchar).
+///
+/// Returns the new expressions or an empty vector if no x has calls with more
+/// than one path.
+std::vector<core::TypedExprPtr> rewriteJsonExtractScalarCalls(
+    const std::string& prefix,
+    const std::vector<core::TypedExprPtr>& exprs);
+
+std::shared_ptr<exec::VectorFunction> makeMultiJsonExtractScalar(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& config);
+
+std::vector<std::shared_ptr<exec::FunctionSignature>>
+multiJsonExtractScalarSignatures();
+
+} // namespace facebook::velox::functions
@@ -22,7 +22,10 @@ namespace {
 /// Populates indices of the n-th elements of the arrays.
 /// Selects 'row' in 'arrayRows' if corresponding array has an n-th element.
 /// Sets elementIndices[row] to the index of the n-th element in the 'elements'
-/// vector.
+/// vector. Leaves the indices of the other rows as they are, which are either
+/// 0 or the indices of earlier elements. 'rows' may be the rows selected for
+/// the previous element, since these are the only ones that can have an n-th
+/// element.
 /// Returns true if at least one array has n-th element.
 bool toNthElementRows(
     const ArrayVectorPtr& arrayVector,
@@ -37,7 +40,6 @@ bool toNthElementRows(
   auto* rawElementIndices = elementIndices->asMutable<vector_size_t>();
 
   arrayRows.clearAll();
-  memset(rawElementIndices, 0, elementIndices->size());
 
   rows.applyToSelected([&](auto row) {
     if (!rawNulls || !bits::isBitNull(rawNulls, row)) {
@@ -104,6 +106,7 @@ class ReduceFunction : public exec::VectorFunction {
     BufferPtr elementIndices =
         allocateIndices(flatArray->size(), context.pool());
     SelectivityVector arrayRows(flatArray->size(), false);
+    SelectivityVector previousArrayRows;
 
     // Iteratively apply input function to array elements.
     // First, apply input function to first elements of all arrays.
@@ -114,6 +117,9 @@ class ReduceFunction : public exec::VectorFunction {
     while (auto entry = inputFuncIt.next()) {
       VectorPtr state = initialState;
 
+      // Each step goes over the arrays that had an element in the previous
+      // step, not over all rows.
+      const SelectivityVector* candidateRows = entry.rows;
       vector_size_t n = 0;
       while (true) {
         // 'state' might use the 'elementIndices', in that case we need to
@@ -127,7 +133,7 @@ class ReduceFunction : public exec::VectorFunction {
         // Set elementIndices[row] to the index of the n-th element in the
         // array's elements vector.
         if (!toNthElementRows(
-                flatArray, *entry.rows, n, arrayRows, elementIndices)) {
+                flatArray, *candidateRows, n, arrayRows, elementIndices)) {
           break; // Ran out of elements in all arrays.
         }
 
@@ -150,6 +156,8 @@ class ReduceFunction : public exec::VectorFunction {
             nullptr,
             &partialResult);
         state = partialResult;
+        previousArrayRows = arrayRows;
+        candidateRows = &previousArrayRows;
         n++;
       }
     }
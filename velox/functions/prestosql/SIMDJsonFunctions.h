@@ -153,6 +153,50 @@ struct SIMDJsonArrayLengthFunction {
   }
 };
 
+namespace detail {
+
+// Consumer for simdJsonExtract() that keeps the result of json_extract_scalar.
+// The result is null unless the path selects a single scalar.
+struct JsonExtractScalarConsumer {
+  template <typename TValue>
+  void operator()(TValue& v) {
+    if (populated) {
+      // We should just get a single value, if we see multiple, it's an error
+      // and we should return null.
+      result = std::nullopt;
+      return;
+    }
+
+    populated = true;
+
+    switch (v.type()) {
+      case simdjson::ondemand::json_type::boolean:
+        result = v.get_bool().value() ? "true" : "false";
+        break;
+      case simdjson::ondemand::json_type::string:
+        result = v.get_string().value();
+        break;
+      case simdjson::ondemand::json_type::object:
+      case simdjson::ondemand::json_type::array:
+      case simdjson::ondemand::json_type::null:
+        // Do nothing.
+        break;
+      default:
+        result = simdjson::to_json_string(v).value();
+    }
+  }
+
+  void reset() {
+    populated = false;
+    result.reset();
+  }
+
+  bool populated{false};
+  std::optional<std::string> result;
+};
+
+} // namespace detail
+
 // jsonExtractScalar(json, json_path) -> varchar
 // Like jsonExtract(), but returns the result value as a string (as opposed
 // to being encoded as JSON). The value referenced by json_path must be a scalar
@@ -165,42 +209,15 @@ struct SIMDJsonExtractScalarFunction {
       out_type<Varchar>& result,
       const arg_type<Json>& json,
       const arg_type<Varchar>& jsonPath) {
-    bool resultPopulated = false;
-    std::optional<std::string> resultStr;
-    auto consumer = [&resultStr, &resultPopulated](auto& v) {
-      if (resultPopulated) {
-        // We should just get a single value, if we see multiple, it's an error
-        // and we should return null.
-        resultStr = std::nullopt;
-        return;
-      }
-
-      resultPopulated = true;
-
-      switch (v.type()) {
-        case simdjson::ondemand::json_type::boolean:
-          resultStr = v.get_bool().value() ? "true" : "false";
-          break;
-        case simdjson::ondemand::json_type::string:
-          resultStr = v.get_string().value();
-          break;
-        case simdjson::ondemand::json_type::object:
-        case simdjson::ondemand::json_type::array:
-        case simdjson::ondemand::json_type::null:
-          // Do nothing.
-          break;
-        default:
-          resultStr = simdjson::to_json_string(v).value();
-      }
-    };
+    detail::JsonExtractScalarConsumer consumer;
 
     if (!simdJsonExtract(json, jsonPath, consumer)) {
       // If there's an error parsing the JSON, return null.
       return false;
     }
 
-    if (resultStr.has_value()) {
-      result.copy_from(*resultStr);
+    if (consumer.result.has_value()) {
+      result.copy_from(*consumer.result);
       return true;
     } else {
       return false;
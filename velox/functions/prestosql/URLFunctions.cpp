@@ -17,39 +17,126 @@
 #include "URLFunctions.h"
 #include "velox/type/Type.h"
 
+#include <algorithm>
+
 namespace facebook::velox::functions {
 
-bool matchAuthorityAndPath(
-    const boost::cmatch& urlMatch,
-    boost::cmatch& authAndPathMatch,
-    boost::cmatch& authorityMatch,
-    bool& hasAuthority) {
-  static const boost::regex kAuthorityAndPathRegex("//([^/]*)(/.*)?");
-  auto authorityAndPath = submatch(urlMatch, 2);
-  if (!boost::regex_match(
-          authorityAndPath.begin(),
-          authorityAndPath.end(),
-          authAndPathMatch,
-          kAuthorityAndPathRegex)) {
-    // Does not start with //, doesn't have authority.
-    hasAuthority = false;
+namespace {
+FOLLY_ALWAYS_INLINE bool isAsciiAlpha(char c) {
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+FOLLY_ALWAYS_INLINE bool isAsciiDigit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+FOLLY_ALWAYS_INLINE bool isSchemeChar(char c) {
+  return isAsciiAlpha(c) || isAsciiDigit(c) || c == '+' || c == '.' ||
+      c == '-';
+}
+
+// Matches the characters from 'begin' to 'end' against
+// (\[[^\]]*\]|[^\[:]*)(?::(\d*))?. Sets 'host' and 'port' and returns true on
+// a match.
+bool parseHostAndPort(
+    const char* begin,
+    const char* end,
+    StringView& host,
+    StringView& port) {
+  const char* hostEnd;
+  if (begin < end && *begin == '[') {
+    // IP-literal, e.g. '[' IPv6 ']'.
+    hostEnd = std::find(begin + 1, end, ']');
+    if (hostEnd == end) {
+      return false;
+    }
+    ++hostEnd;
+  } else {
+    // Dotted IPv4 or named host.
+    hostEnd = begin;
+    while (hostEnd < end && *hostEnd != '[' && *hostEnd != ':') {
+      ++hostEnd;
+    }
+  }
+  host = StringView(begin, hostEnd - begin);
+  port = StringView();
+  if (hostEnd == end) {
     return true;
   }
+  if (*hostEnd != ':') {
+    return false;
+  }
+  const char* portBegin = hostEnd + 1;
+  if (!std::all_of(portBegin, end, isAsciiDigit)) {
+    return false;
+  }
+  port = StringView(portBegin, end - portBegin);
+  return true;
+}
+
+// Sets the authority and path of 'components' from the part between the
+// scheme and the query or fragment.
+void parseAuthorityAndPath(
+    const char* begin,
+    const char* end,
+    UrlComponents& components) {
+  if (end - begin < 2 || begin[0] != '/' || begin[1] != '/') {
+    components.hasAuthority = false;
+    components.path = StringView(begin, end - begin);
+    return;
+  }
+  components.hasAuthority = true;
+  const char* authorityBegin = begin + 2;
+  const char* authorityEnd = std::find(authorityBegin, end, '/');
+  components.path = StringView(authorityEnd, end - authorityEnd);
+
+  // The user info is optional and ends at the first '@'. If the rest is not a
+  // host and port, the whole authority is tried as host and port.
+  const char* at = std::find(authorityBegin, authorityEnd, '@');
+  components.validAuthority =
+      (at != authorityEnd &&
+       parseHostAndPort(
+           at + 1, authorityEnd, components.host, components.port)) ||
+      parseHostAndPort(
+          authorityBegin, authorityEnd, components.host, components.port);
+}
+} // namespace
 
-  static const boost::regex kAuthorityRegex(
-      "(?:([^@:]*)(?::([^@]*))?@)?" // username, password.
-      "(\\[[^\\]]*\\]|[^\\[:]*)" // host (IP-literal (e.g. '['+IPv6+']',
-      // dotted-IPv4, or named host).
-      "(?::(\\d*))?"); // port.
+bool parseUrl(StringView url, UrlComponents& components) {
+  const char* data = url.data();
+  const char* end = data + url.size();
+  if (data == end || !isAsciiAlpha(*data)) {
+    return false;
+  }
+  const char* pos = data + 1;
+  while (pos < end && isSchemeChar(*pos)) {
+    ++pos;
+  }
+  if (pos == end || *pos != ':') {
+    return false;
+  }
+  components.scheme = StringView(data, pos - data);
 
-  const auto authority = authAndPathMatch[1];
-  if (!boost::regex_match(
-          authority.first, authority.second, authorityMatch, kAuthorityRegex)) {
-    return false; // Invalid URI Authority.
+  const char* authorityAndPathBegin = ++pos;
+  while (pos < end && *pos != '?' && *pos != '#') {
+    ++pos;
   }
+  const char* authorityAndPathEnd = pos;
 
-  hasAuthority = true;
+  components.query = StringView();
+  if (pos < end && *pos == '?') {
+    const char* queryBegin = ++pos;
+    pos = std::find(pos, end, '#');
+    components.query = StringView(queryBegin, pos - queryBegin);
+  }
+  components.fragment = StringView();
+  if (pos < end) {
+    ++pos;
+    components.fragment = StringView(pos, end - pos);
+  }
 
+  parseAuthorityAndPath(
+      authorityAndPathBegin, authorityAndPathEnd, components);
   return true;
 }
 
@@ -27,18 +27,6 @@ FOLLY_ALWAYS_INLINE StringView submatch(const boost::cmatch& match, int idx) {
   return StringView(sub.first, sub.length());
 }
 
-template <typename TInString>
-bool parse(const TInString& rawUrl, boost::cmatch& match) {
-  static const boost::regex kUriRegex(
-      "([a-zA-Z][a-zA-Z0-9+.-]*):" // scheme:
-      "([^?#]*)" // authority and path
-      "(?:\\?([^#]*))?" // ?query
-      "(?:#(.*))?"); // #fragment
-
-  return boost::regex_match(
-      rawUrl.data(), rawUrl.data() + rawUrl.size(), match, kUriRegex);
-}
-
 FOLLY_ALWAYS_INLINE unsigned char toHex(unsigned char c) {
   return c < 10 ? (c + '0') : (c + 'A' - 10);
 }
@@ -124,11 +112,31 @@ FOLLY_ALWAYS_INLINE void urlUnescape(
 
 } // namespace
 
-bool matchAuthorityAndPath(
-    const boost::cmatch& urlMatch,
-    boost::cmatch& authAndPathMatch,
-    boost::cmatch& authorityMatch,
-    bool& hasAuthority);
+/// The components of a URL of the form
+/// scheme:[//[userinfo@]host[:port]]path[?query][#fragment]. The components
+/// refer to the characters of the URL.
+struct UrlComponents {
+  StringView scheme;
+  StringView query;
+  StringView fragment;
+  /// True if the part after the scheme starts with '//'.
+  bool hasAuthority{false};
+  /// True if the authority is well formed. Only set if 'hasAuthority'.
+  bool validAuthority{false};
+  StringView host;
+  StringView port;
+  /// The path after the authority, or the whole part between the scheme and
+  /// the query or fragment if there is no authority.
+  StringView path;
+};
+
+/// Splits 'url' into its components in a single pass. Returns false if 'url'
+/// does not start with a scheme followed by ':'. Gives the same components as
+/// matching the URL with the regular expression
+/// ([a-zA-Z][a-zA-Z0-9+.-]*):([^?#]*)(?:\?([^#]*))?(?:#(.*))? and the part
+/// between the scheme and the query with //([^/]*)(/.*)? and the authority
+/// with (?:([^@:]*)(?::([^@]*))?@)?(\[[^\]]*\]|[^\[:]*)(?::(\d*))?.
+bool parseUrl(StringView url, UrlComponents& components);
 
 template <typename T>
 struct UrlExtractProtocolFunction {
@@ -143,11 +151,11 @@ struct UrlExtractProtocolFunction {
   FOLLY_ALWAYS_INLINE bool call(
       out_type<Varchar>& result,
       const arg_type<Varchar>& url) {
-    boost::cmatch match;
-    if (!parse(url, match)) {
+    UrlComponents components;
+    if (!parseUrl(url, components)) {
       result.setEmpty();
     } else {
-      result.setNoCopy(submatch(match, 1));
+      result.setNoCopy(components.scheme);
     }
     return true;
   }
@@ -166,11 +174,11 @@ struct UrlExtractFragmentFunction {
   FOLLY_ALWAYS_INLINE bool call(
       out_type<Varchar>& result,
       const arg_type<Varchar>& url) {
-    boost::cmatch match;
-    if (!parse(url, match)) {
+    UrlComponents components;
+    if (!parseUrl(url, components)) {
       result.setEmpty();
     } else {
-      result.setNoCopy(submatch(match, 4));
+      result.setNoCopy(components.fragment);
     }
     return true;
   }
@@ -189,19 +197,9 @@ struct UrlExtractHostFunction {
   FOLLY_ALWAYS_INLINE bool call(
       out_type<Varchar>& result,
       const arg_type<Varchar>& url) {
-    boost::cmatch match;
-    if (!parse(url, match)) {
-      result.setEmpty();
-      return true;
-    }
-    boost::cmatch authAndPathMatch;
-    boost::cmatch authorityMatch;
-    bool hasAuthority;
-
-    if (matchAuthorityAndPath(
-            match, authAndPathMatch, authorityMatch, hasAuthority) &&
-        hasAuthority) {
-      result.setNoCopy(submatch(authorityMatch, 3));
+    UrlComponents components;
+    if (parseUrl(url, components) && components.validAuthority) {
+      result.setNoCopy(components.host);
     } else {
       result.setEmpty();
     }
@@ -214,24 +212,13 @@ struct UrlExtractPortFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
 
   FOLLY_ALWAYS_INLINE bool call(int64_t& result, const arg_type<Varchar>& url) {
-    boost::cmatch match;
-    if (!parse(url, match)) {
-      return false;
-    }
-
-    boost::cmatch authAndPathMatch;
-    boost::cmatch authorityMatch;
-    bool hasAuthority;
-    if (matchAuthorityAndPath(
-            match, authAndPathMatch, authorityMatch, hasAuthority) &&
-        hasAuthority) {
-      auto port = submatch(authorityMatch, 4);
-      if (!port.empty()) {
-        try {
-          result = to<int64_t>(port);
-          return true;
-        } catch (folly::ConversionError const&) {
-        }
+    UrlComponents components;
+    if (parseUrl(url, components) && components.validAuthority &&
+        !components.port.empty()) {
+      try {
+        result = to<int64_t>(components.port);
+        return true;
+      } catch (folly::ConversionError const&) {
       }
     }
     return false;
@@ -251,23 +238,15 @@ struct UrlExtractPathFunction {
   FOLLY_ALWAYS_INLINE bool call(
       out_type<Varchar>& result,
       const arg_type<Varchar>& url) {
-    boost::cmatch match;
-    if (!parse(url, match)) {
+    UrlComponents components;
+    if (!parseUrl(url, components)) {
       result.setEmpty();
       return true;
     }
 
-    boost::cmatch authAndPathMatch;
-    boost::cmatch authorityMatch;
-    bool hasAuthority;
-
-    if (matchAuthorityAndPath(
-            match, authAndPathMatch, authorityMatch, hasAuthority)) {
-      if (hasAuthority) {
-        result.setNoCopy(submatch(authAndPathMatch, 2));
-      } else {
-        result.setNoCopy(submatch(match, 2));
-      }
+    // A URL with a malformed authority has no path.
+    if (!components.hasAuthority || components.validAuthority) {
+      result.setNoCopy(components.path);
     }
 
     return true;
@@ -287,14 +266,13 @@ struct UrlExtractQueryFunction {
   FOLLY_ALWAYS_INLINE bool call(
       out_type<Varchar>& result,
       const arg_type<Varchar>& url) {
-    boost::cmatch match;
-    if (!parse(url, match)) {
+    UrlComponents components;
+    if (!parseUrl(url, components)) {
       result.setEmpty();
       return true;
     }
 
-    auto query = submatch(match, 3);
-    result.setNoCopy(query);
+    result.setNoCopy(components.query);
     return true;
   }
 };
@@ -313,13 +291,13 @@ struct UrlExtractParameterFunction {
       out_type<Varchar>& result,
       const arg_type<Varchar>& url,
       const arg_type<Varchar>& param) {
-    boost::cmatch match;
-    if (!parse(url, match)) {
+    UrlComponents components;
+    if (!parseUrl(url, components)) {
       result.setEmpty();
       return false;
     }
 
-    auto query = submatch(match, 3);
+    const auto& query = components.query;
     if (!query.empty()) {
       // Parse query string.
       static const boost::regex kQueryParamRegex(
@@ -52,6 +52,10 @@ struct KllSketchAccumulator {
     sketch_.insert(value);
   }
 
+  void append(const T* values, size_t size) {
+    sketch_.insert(values, size);
+  }
+
   void append(T value, int64_t count) {
     constexpr size_t kMaxBufferSize = 4096;
     constexpr int64_t kMinCountToBuffer = 512;
@@ -327,21 +331,26 @@ class ApproxPercentileAggregate : public exec::Aggregate {
         accumulator->append(value, weight);
       });
     } else {
-      if (decodedValue_.mayHaveNulls()) {
-        rows.applyToSelected([&](auto row) {
-          if (decodedValue_.isNullAt(row)) {
-            return;
-          }
-
-          auto accumulator = initRawAccumulator(groups[row]);
-          accumulator->append(decodedValue_.valueAt<T>(row));
-        });
-      } else {
-        rows.applyToSelected([&](auto row) {
-          auto accumulator = initRawAccumulator(groups[row]);
-          accumulator->append(decodedValue_.valueAt<T>(row));
-        });
-      }
+      // Inserts the values of consecutive rows of the same group in one batch.
+      char* runGroup = nullptr;
+      auto flushRun = [&]() {
+        if (!values_.empty()) {
+          initRawAccumulator(runGroup)->append(values_.data(), values_.size());
+          values_.clear();
+        }
+      };
+      values_.clear();
+      rows.applyToSelected([&](auto row) {
+        if (decodedValue_.isNullAt(row)) {
+          return;
+        }
+        if (groups[row] != runGroup) {
+          flushRun();
+          runGroup = groups[row];
+        }
+        values_.push_back(decodedValue_.valueAt<T>(row));
+      });
+      flushRun();
     }
   }
 
@@ -374,20 +383,19 @@ class ApproxPercentileAggregate : public exec::Aggregate {
         checkWeight(weight);
         accumulator->append(value, weight);
       });
+    } else if (
+        decodedValue_.isIdentityMapping() && !decodedValue_.mayHaveNulls() &&
+        rows.isAllSelected()) {
+      // Flat input without nulls is inserted without copying.
+      accumulator->append(decodedValue_.data<T>(), rows.end());
     } else {
-      if (decodedValue_.mayHaveNulls()) {
-        rows.applyToSelected([&](auto row) {
-          if (decodedValue_.isNullAt(row)) {
-            return;
-          }
-
-          accumulator->append(decodedValue_.valueAt<T>(row));
-        });
-      } else {
-        rows.applyToSelected([&](auto row) {
-          accumulator->append(decodedValue_.valueAt<T>(row));
-        });
-      }
+      values_.clear();
+      rows.applyToSelected([&](auto row) {
+        if (!decodedValue_.isNullAt(row)) {
+          values_.push_back(decodedValue_.valueAt<T>(row));
+        }
+      });
+      accumulator->append(values_.data(), values_.size());
     }
   }
 
@@ -572,6 +580,13 @@ class ApproxPercentileAggregate : public exec::Aggregate {
   DecodedVector decodedAccuracy_;
   DecodedVector decodedDigest_;
 
+  // Values of raw input rows buffered for KllSketch::insert().
+  std::vector<T> values_;
+
+  // Sketches of intermediate input rows with their groups, buffered to merge
+  // all the sketches of a group at once.
+  std::vector<std::pair<char*, typename KllSketch<T>::View>> groupViews_;
+
  private:
   template <bool kSingleGroup, bool checkIntermediateInputs>
   void addIntermediateImpl(
@@ -637,6 +652,8 @@ class ApproxPercentileAggregate : public exec::Aggregate {
     std::vector<typename KllSketch<T>::View> views;
     if constexpr (kSingleGroup) {
       views.reserve(rows.end());
+    } else {
+      groupViews_.clear();
     }
     rows.applyToSelected([&](auto row) {
       if (decoded.isNullAt(row)) {
@@ -693,8 +710,7 @@ class ApproxPercentileAggregate : public exec::Aggregate {
       if constexpr (kSingleGroup) {
         views.push_back(v);
       } else {
-        auto tracker = trackRowSize(group[row]);
-        accumulator->append(v);
+        groupViews_.emplace_back(group[row], v);
       }
     });
     if constexpr (kSingleGroup) {
@@ -702,6 +718,23 @@ class ApproxPercentileAggregate : public exec::Aggregate {
         auto tracker = trackRowSize(group);
         accumulator->append(views);
       }
+    } else {
+      // Merging all the sketches of a group in one k-way merge compacts the
+      // group's sketch once instead of once per input sketch.
+      std::stable_sort(
+          groupViews_.begin(),
+          groupViews_.end(),
+          [](const auto& x, const auto& y) { return x.first < y.first; });
+      for (size_t i = 0; i < groupViews_.size();) {
+        auto* currentGroup = groupViews_[i].first;
+        views.clear();
+        for (; i < groupViews_.size() && groupViews_[i].first == currentGroup;
+             ++i) {
+          views.push_back(groupViews_[i].second);
+        }
+        auto tracker = trackRowSize(currentGroup);
+        value<KllSketchAccumulator<T>>(currentGroup)->append(views);
+      }
     }
   }
 };
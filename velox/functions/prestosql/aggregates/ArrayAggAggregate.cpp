@@ -16,6 +16,7 @@
 #include "velox/exec/ContainerRowSerde.h"
 #include "velox/expression/FunctionSignature.h"
 #include "velox/functions/prestosql/aggregates/AggregateNames.h"
+#include "velox/functions/prestosql/aggregates/CompactValueList.h"
 #include "velox/functions/prestosql/aggregates/ValueList.h"
 #include "velox/vector/ComplexVector.h"
 
@@ -26,13 +27,21 @@ struct ArrayAccumulator {
   ValueList elements;
 };
 
+// If 'compact' is set, the values of all groups are kept in one
+// CompactValueLists instead of a ValueList per group. This is used for partial
+// aggregations, which typically see many groups with few values each and
+// flush all groups at once.
 class ArrayAggAggregate : public exec::Aggregate {
  public:
-  explicit ArrayAggAggregate(TypePtr resultType, bool ignoreNulls)
-      : Aggregate(resultType), ignoreNulls_(ignoreNulls) {}
+  ArrayAggAggregate(TypePtr resultType, bool ignoreNulls, bool compact)
+      : Aggregate(resultType), ignoreNulls_(ignoreNulls), compact_(compact) {}
 
   int32_t accumulatorFixedWidthSize() const override {
-    return sizeof(ArrayAccumulator);
+    return compact_ ? sizeof(CompactValueList) : sizeof(ArrayAccumulator);
+  }
+
+  uint64_t sharedAllocatedBytes() const override {
+    return compactValues_ ? compactValues_->allocatedBytes() : 0;
   }
 
   bool isFixedSize() const override {
@@ -95,6 +104,16 @@ class ArrayAggAggregate : public exec::Aggregate {
   void initializeNewGroups(
       char** groups,
       folly::Range<const vector_size_t*> indices) override {
+    if (compact_) {
+      if (compactValues_ == nullptr) {
+        compactValues_ = std::make_unique<CompactValueLists>(
+            resultType()->childAt(0), allocator_->pool());
+      }
+      for (auto index : indices) {
+        new (groups[index] + offset_) CompactValueList();
+      }
+      return;
+    }
     for (auto index : indices) {
       new (groups[index] + offset_) ArrayAccumulator();
     }
@@ -110,6 +129,10 @@ class ArrayAggAggregate : public exec::Aggregate {
     elements->resize(countElements(groups, numGroups));
 
     uint64_t* rawNulls = getRawNulls(vector);
+    if (compact_) {
+      extractCompactValues(groups, numGroups, *vector, rawNulls);
+      return;
+    }
     vector_size_t offset = 0;
     for (int32_t i = 0; i < numGroups; ++i) {
       auto& values = value<ArrayAccumulator>(groups[i])->elements;
@@ -145,6 +168,11 @@ class ArrayAggAggregate : public exec::Aggregate {
         return;
       }
       auto group = groups[row];
+      if (compact_) {
+        compactValues_->append(
+            *value<CompactValueList>(group), decodedElements_, row);
+        return;
+      }
       auto tracker = trackRowSize(group);
       value<ArrayAccumulator>(group)->elements.appendValue(
           decodedElements_, row, allocator_);
@@ -160,6 +188,16 @@ class ArrayAggAggregate : public exec::Aggregate {
 
     auto arrayVector = decodedIntermediate_.base()->as<ArrayVector>();
     auto& elements = arrayVector->elements();
+    if (compact_) {
+      decodedElements_.decode(*elements);
+      rows.applyToSelected([&](vector_size_t row) {
+        if (!decodedIntermediate_.isNullAt(row)) {
+          appendCompactRange(
+              groups[row], *arrayVector, decodedIntermediate_.index(row));
+        }
+      });
+      return;
+    }
     rows.applyToSelected([&](vector_size_t row) {
       auto group = groups[row];
       auto decodedRow = decodedIntermediate_.index(row);
@@ -179,9 +217,19 @@ class ArrayAggAggregate : public exec::Aggregate {
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
       bool /* mayPushdown */) override {
-    auto& values = value<ArrayAccumulator>(group)->elements;
-
     decodedElements_.decode(*args[0], rows);
+    if (compact_) {
+      auto& list = *value<CompactValueList>(group);
+      rows.applyToSelected([&](vector_size_t row) {
+        if (ignoreNulls_ && decodedElements_.isNullAt(row)) {
+          return;
+        }
+        compactValues_->append(list, decodedElements_, row);
+      });
+      return;
+    }
+
+    auto& values = value<ArrayAccumulator>(group)->elements;
     auto tracker = trackRowSize(group);
     rows.applyToSelected([&](vector_size_t row) {
       if (ignoreNulls_ && decodedElements_.isNullAt(row)) {
@@ -199,6 +247,17 @@ class ArrayAggAggregate : public exec::Aggregate {
     decodedIntermediate_.decode(*args[0], rows);
     auto arrayVector = decodedIntermediate_.base()->as<ArrayVector>();
 
+    if (compact_) {
+      decodedElements_.decode(*arrayVector->elements());
+      rows.applyToSelected([&](vector_size_t row) {
+        if (!decodedIntermediate_.isNullAt(row)) {
+          appendCompactRange(
+              group, *arrayVector, decodedIntermediate_.index(row));
+        }
+      });
+      return;
+    }
+
     auto& values = value<ArrayAccumulator>(group)->elements;
     auto elements = arrayVector->elements();
     rows.applyToSelected([&](vector_size_t row) {
@@ -214,22 +273,82 @@ class ArrayAggAggregate : public exec::Aggregate {
   }
 
   void destroy(folly::Range<char**> groups) override {
+    if (compact_) {
+      for (auto group : groups) {
+        compactValues_->free(*value<CompactValueList>(group));
+      }
+      return;
+    }
     for (auto group : groups) {
       value<ArrayAccumulator>(group)->elements.free(allocator_);
     }
   }
 
+ protected:
+  void clearInternal() override {
+    Aggregate::clearInternal();
+    if (compactValues_) {
+      compactValues_->clear();
+    }
+  }
+
  private:
+  vector_size_t size(char* group) const {
+    return compact_ ? value<CompactValueList>(group)->size
+                    : value<ArrayAccumulator>(group)->elements.size();
+  }
+
   vector_size_t countElements(char** groups, int32_t numGroups) const {
     vector_size_t size = 0;
     for (int32_t i = 0; i < numGroups; ++i) {
-      size += value<ArrayAccumulator>(groups[i])->elements.size();
+      size += this->size(groups[i]);
     }
     return size;
   }
 
+  // Appends the elements of row 'index' of 'arrayVector' to the compact list
+  // of 'group'. The elements must be decoded in 'decodedElements_'.
+  void appendCompactRange(
+      char* group,
+      const ArrayVector& arrayVector,
+      vector_size_t index) {
+    auto& list = *value<CompactValueList>(group);
+    const auto offset = arrayVector.offsetAt(index);
+    const auto size = arrayVector.sizeAt(index);
+    for (auto i = offset; i < offset + size; ++i) {
+      compactValues_->append(list, decodedElements_, i);
+    }
+  }
+
+  // Extracts the compact lists of 'groups' into 'vector', copying the values
+  // of all groups at once.
+  void extractCompactValues(
+      char** groups,
+      int32_t numGroups,
+      ArrayVector& vector,
+      uint64_t* rawNulls) {
+    std::vector<const CompactValueList*> lists;
+    lists.reserve(numGroups);
+    vector_size_t offset = 0;
+    for (int32_t i = 0; i < numGroups; ++i) {
+      const auto* list = value<CompactValueList>(groups[i]);
+      if (list->size) {
+        clearNull(rawNulls, i);
+        vector.setOffsetAndSize(i, offset, list->size);
+        offset += list->size;
+        lists.push_back(list);
+      } else {
+        vector.setNull(i, true);
+      }
+    }
+    compactValues_->extract(lists, vector.elements());
+  }
+
   // A boolean representing whether to ignore nulls when aggregating inputs.
   const bool ignoreNulls_;
+  const bool compact_;
+  // The values of all groups if 'compact_' is set.
+  std::unique_ptr<CompactValueLists> compactValues_;
   // Reusable instance of DecodedVector for decoding input vectors.
   DecodedVector decodedElements_;
   DecodedVector decodedIntermediate_;
@@ -255,7 +374,9 @@ exec::AggregateRegistrationResult registerArray(const std::string& name) {
         VELOX_CHECK_EQ(
             argTypes.size(), 1, "{} takes at most one argument", name);
         return std::make_unique<ArrayAggAggregate>(
-            resultType, config.prestoArrayAggIgnoreNulls());
+            resultType,
+            config.prestoArrayAggIgnoreNulls(),
+            step == core::AggregationNode::Step::kPartial);
       },
       /*registerCompanionFunctions*/ true);
 }
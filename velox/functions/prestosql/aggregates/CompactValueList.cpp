@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/prestosql/aggregates/CompactValueList.h"
+
+namespace facebook::velox::aggregate {
+
+CompactValueLists::CompactValueLists(
+    const TypePtr& type,
+    memory::MemoryPool* pool)
+    : rows_(
+          {type},
+          true, // nullableKeys
+          std::vector<exec::Accumulator>{},
+          std::vector<TypePtr>{},
+          true, // hasNext
+          false, // isJoinBuild
+          false, // hasProbedFlag
+          false, // hasNormalizedKey
+          pool) {}
+
+void CompactValueLists::append(
+    CompactValueList& list,
+    const DecodedVector& decoded,
+    vector_size_t index) {
+  auto* row = rows_.newRow();
+  rows_.store(decoded, index, row, 0);
+  next(row) = nullptr;
+  if (list.last == nullptr) {
+    list.first = row;
+  } else {
+    next(list.last) = row;
+  }
+  list.last = row;
+  ++list.size;
+}
+
+void CompactValueLists::appendRows(
+    const CompactValueList& list,
+    std::vector<char*>& rows) const {
+  for (auto* row = list.first; row != nullptr; row = next(row)) {
+    rows.push_back(row);
+  }
+}
+
+void CompactValueLists::extract(
+    const std::vector<const CompactValueList*>& lists,
+    const VectorPtr& result) {
+  tempRows_.clear();
+  for (const auto* list : lists) {
+    appendRows(*list, tempRows_);
+  }
+  if (!tempRows_.empty()) {
+    rows_.extractColumn(tempRows_.data(), tempRows_.size(), 0, result);
+  }
+}
+
+void CompactValueLists::free(CompactValueList& list) {
+  if (list.size == 0) {
+    return;
+  }
+  tempRows_.clear();
+  appendRows(list, tempRows_);
+  rows_.eraseRows(folly::Range<char**>(tempRows_.data(), tempRows_.size()));
+  list = CompactValueList();
+  if (rows_.numRows() == 0) {
+    rows_.clear();
+  }
+}
+
+void CompactValueLists::clear() {
+  rows_.clear();
+}
+
+} // namespace facebook::velox::aggregate
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/exec/RowContainer.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::aggregate {
+
+// The list of values of one group in CompactValueLists.
+struct CompactValueList {
+  char* first{nullptr};
+  char* last{nullptr};
+  vector_size_t size{0};
+};
+
+// Lists of values, including nulls, of all groups of an aggregation, e.g.
+// array_agg, kept in one RowContainer with a single column. Each value is a
+// row pointing to the next value of the same group. A group takes 20 bytes
+// and a value its fixed width, a null flag and a pointer, whereas a ValueList
+// allocates separate value and null blocks for each group, which is several
+// times the payload for many groups of few values. The values of many groups
+// are extracted with one copy from the container.
+class CompactValueLists {
+ public:
+  CompactValueLists(const TypePtr& type, memory::MemoryPool* pool);
+
+  // Appends the value, or null, at 'index' in 'decoded' to 'list'.
+  void append(
+      CompactValueList& list,
+      const DecodedVector& decoded,
+      vector_size_t index);
+
+  // Copies the values of 'lists', one list after the other, into 'result'
+  // starting at 0. 'result' must hold the sum of the list sizes.
+  void extract(
+      const std::vector<const CompactValueList*>& lists,
+      const VectorPtr& result);
+
+  // Frees the values of 'list' and makes it empty.
+  void free(CompactValueList& list);
+
+  // Frees all values. The lists of all groups must be discarded.
+  void clear();
+
+  uint64_t allocatedBytes() const {
+    return rows_.allocatedBytes();
+  }
+
+ private:
+  char*& next(char* row) const {
+    return *reinterpret_cast<char**>(row + rows_.nextOffset());
+  }
+
+  // Appends the rows of 'list' to 'rows'.
+  void appendRows(const CompactValueList& list, std::vector<char*>& rows)
+      const;
+
+  exec::RowContainer rows_;
+
+  // Reusable list of rows to extract or free.
+  std::vector<char*> tempRows_;
+};
+
+} // namespace facebook::velox::aggregate
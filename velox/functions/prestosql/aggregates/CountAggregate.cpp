@@ -52,12 +52,17 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
       char** groups,
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
-      bool /*mayPushdown*/) override {
+      bool mayPushdown) override {
     if (args.empty()) {
       rows.applyToSelected([&](vector_size_t i) { addToGroup(groups[i], 1); });
       return;
     }
 
+    if (canPushdown(args[0], mayPushdown)) {
+      pushdown<CountHook>(groups, rows, args[0]);
+      return;
+    }
+
     DecodedVector decoded(*args[0], rows);
     if (decoded.isConstantMapping()) {
       if (!decoded.isNullAt(0)) {
@@ -91,12 +96,17 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
       char* group,
       const SelectivityVector& rows,
       const std::vector<VectorPtr>& args,
-      bool /*mayPushdown*/) override {
+      bool mayPushdown) override {
     if (args.empty()) {
       addToGroup(group, rows.countSelected());
       return;
     }
 
+    if (canPushdown(args[0], mayPushdown)) {
+      pushdownSingleGroup<CountHook>(group, rows, args[0]);
+      return;
+    }
+
     DecodedVector decoded(*args[0], rows);
     if (decoded.isConstantMapping()) {
       if (!decoded.isNullAt(0)) {
@@ -138,7 +148,45 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
     addToGroup(group, count);
   }
 
+  bool supportsRetract() const override {
+    return true;
+  }
+
+  void retractSingleGroupRawInput(
+      char* group,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) override {
+    if (args.empty()) {
+      addToGroup(group, -rows.countSelected());
+      return;
+    }
+
+    DecodedVector decoded(*args[0], rows);
+    if (decoded.isConstantMapping()) {
+      if (!decoded.isNullAt(0)) {
+        addToGroup(group, -rows.countSelected());
+      }
+    } else if (decoded.mayHaveNulls()) {
+      int64_t nonNullCount = 0;
+      rows.applyToSelected([&](vector_size_t i) {
+        if (!decoded.isNullAt(i)) {
+          ++nonNullCount;
+        }
+      });
+      addToGroup(group, -nonNullCount);
+    } else {
+      addToGroup(group, -rows.countSelected());
+    }
+  }
+
  private:
+  // Count does not look at the values, so strings can be counted by the
+  // readers too.
+  static bool canPushdown(const VectorPtr& arg, bool mayPushdown) {
+    return mayPushdown && arg->isLazy() &&
+        AggregationHook::supportsPushdown(*arg->type(), false);
+  }
+
   inline void addToGroup(char* group, int64_t count) {
     *value<int64_t>(group) += count;
   }
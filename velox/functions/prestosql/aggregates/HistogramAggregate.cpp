@@ -90,27 +90,25 @@ struct StringViewAccumulator {
       DecodedVector& decoded,
       vector_size_t index,
       HashStringAllocator* allocator) {
-    auto value = decoded.valueAt<StringView>(index);
-    base.values[store(value, allocator)]++;
+    addValueWithCount(decoded.valueAt<StringView>(index), 1, allocator);
   }
 
   void addValueWithCount(
       StringView value,
       int64_t count,
       HashStringAllocator* allocator) {
-    base.values[store(value, allocator)] += count;
-  }
-
-  StringView store(StringView value, HashStringAllocator* allocator) {
-    if (!value.isInline()) {
-      auto it = base.values.find(value);
-      if (it != base.values.end()) {
-        value = it->first;
-      } else {
-        value = strings.append(value, *allocator);
-      }
+    if (value.isInline()) {
+      base.values[value] += count;
+      return;
+    }
+    // Looks up a string that is not inline once if it is already there and
+    // copies it only if it is not.
+    auto it = base.values.find(value);
+    if (it != base.values.end()) {
+      it->second += count;
+    } else {
+      base.values.emplace(strings.append(value, *allocator), count);
     }
-    return value;
   }
 
   void extractValues(
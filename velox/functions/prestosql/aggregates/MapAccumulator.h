@@ -78,8 +78,9 @@ struct MapAccumulator {
     const auto mapSize = keys.size();
 
     // Align keys and values as the order of keys in 'keys' may not match the
-    // order of values in 'values'.
-    folly::F14FastMap<int32_t, int32_t> indices;
+    // order of values in 'values'. indices[i] is the position of the key of
+    // the i-th value.
+    std::vector<int32_t> indices(mapSize);
 
     auto flatKeys = mapKeys->asFlatVector<T>();
 
@@ -97,10 +98,10 @@ struct MapAccumulator {
       const VectorPtr& mapValues,
       vector_size_t offset,
       int32_t mapSize,
-      const folly::F14FastMap<int32_t, int32_t>& indices) {
+      const std::vector<int32_t>& indices) {
     ValueListReader valuesReader(values);
     for (auto index = 0; index < mapSize; ++index) {
-      valuesReader.next(*mapValues, offset + indices.at(index));
+      valuesReader.next(*mapValues, offset + indices[index]);
     }
   }
 
@@ -201,8 +202,7 @@ struct ComplexTypeMapAccumulator {
       vector_size_t offset) {
     const auto mapSize = base.keys.size();
 
-    folly::F14FastMap<int32_t, int32_t> indices;
-    indices.reserve(mapSize);
+    std::vector<int32_t> indices(mapSize);
 
     vector_size_t index = offset;
     for (const auto& value : base.keys) {
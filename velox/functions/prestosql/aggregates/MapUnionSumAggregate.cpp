@@ -60,16 +60,21 @@ struct Accumulator {
   }
 
   void addValue(K key, const SimpleVector<S>* mapValues, vector_size_t row) {
+    addToSum(sums[key], mapValues, row);
+  }
+
+  // Adds the value at 'row' to 'sum'. A null value adds nothing.
+  static void
+  addToSum(S& sum, const SimpleVector<S>* mapValues, vector_size_t row) {
     if (mapValues->isNullAt(row)) {
-      sums[key] += 0;
-    } else {
-      auto value = mapValues->valueAt(row);
+      return;
+    }
+    auto value = mapValues->valueAt(row);
 
-      if constexpr (std::is_same_v<S, double> || std::is_same_v<S, float>) {
-        sums[key] += value;
-      } else {
-        sums[key] = functions::checkedPlus<S>(sums[key], value);
-      }
+    if constexpr (std::is_same_v<S, double> || std::is_same_v<S, float>) {
+      sum += value;
+    } else {
+      sum = functions::checkedPlus<S>(sum, value);
     }
   }
 
@@ -119,10 +124,10 @@ struct StringViewAccumulator {
         if (!key.isInline()) {
           auto it = base.sums.find(key);
           if (it != base.sums.end()) {
-            key = it->first;
-          } else {
-            key = strings.append(key, *allocator);
+            base.addToSum(it->second, mapValues, offset + i);
+            continue;
           }
+          key = strings.append(key, *allocator);
         }
 
         base.addValue(key, mapValues, offset + i);
@@ -158,6 +158,26 @@ class MaxAggregate : public MinMaxAggregate<T> {
     addRawInput(groups, rows, args, mayPushdown);
   }
 
+  bool addRawInputBySlot(
+      char** groups,
+      const uint64_t* slots,
+      uint64_t numSlots,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) override {
+    // Floating point values are left out because of NaN, for which the result
+    // would depend on the order of the updates.
+    if constexpr (std::is_integral_v<T> && sizeof(T) <= sizeof(int64_t)) {
+      BaseAggregate::template updateSlots<T, T>(
+          groups, slots, numSlots, rows, args[0], [](T& result, T value) {
+            if (result < value) {
+              result = value;
+            }
+          });
+      return true;
+    }
+    return false;
+  }
+
   void addSingleGroupRawInput(
       char* group,
       const SelectivityVector& rows,
@@ -238,6 +258,26 @@ class MinAggregate : public MinMaxAggregate<T> {
     addRawInput(groups, rows, args, mayPushdown);
   }
 
+  bool addRawInputBySlot(
+      char** groups,
+      const uint64_t* slots,
+      uint64_t numSlots,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) override {
+    // Floating point values are left out because of NaN, for which the result
+    // would depend on the order of the updates.
+    if constexpr (std::is_integral_v<T> && sizeof(T) <= sizeof(int64_t)) {
+      BaseAggregate::template updateSlots<T, T>(
+          groups, slots, numSlots, rows, args[0], [](T& result, T value) {
+            if (result > value) {
+              result = value;
+            }
+          });
+      return true;
+    }
+    return false;
+  }
+
   void addSingleGroupRawInput(
       char* group,
       const SelectivityVector& rows,
@@ -18,6 +18,7 @@
 #define XXH_INLINE_ALL
 #include <xxhash.h>
 
+#include "velox/common/base/HashKernels.h"
 #include "velox/functions/lib/RowsTranslationUtil.h"
 #include "velox/functions/prestosql/types/TimestampWithTimeZoneType.h"
 
@@ -59,6 +60,20 @@ FOLLY_ALWAYS_INLINE void hashIntegral(
     const DecodedVector& vector,
     const SelectivityVector& rows,
     BufferPtr& hashes) {
+  if (vector.isIdentityMapping()) {
+    // Flat values are hashed in a loop over the raw buffers.
+    VELOX_CHECK_GE(hashes->size(), rows.end())
+    hashing::hashFlat(
+        vector.data<T>(),
+        vector.nulls(),
+        rows.isAllSelected() ? nullptr : rows.asRange().bits(),
+        rows.begin(),
+        rows.end(),
+        hashes->asMutable<int64_t>(),
+        [](T value, int64_t /*previous*/) { return hashInteger<T>(value); },
+        [](int64_t /*previous*/) { return 0; });
+    return;
+  }
   applyHashFunction(rows, vector, hashes, [&](auto row) {
     return hashInteger<T>(vector.valueAt<T>(row));
   });
@@ -85,6 +85,29 @@ class SumAggregate
     updateInternal<TAccumulator, TAccumulator>(groups, rows, args, mayPushdown);
   }
 
+  /// Sums of integers only, since the order of the additions of floating
+  /// point values changes the result.
+  bool addRawInputBySlot(
+      char** groups,
+      const uint64_t* slots,
+      uint64_t numSlots,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) override {
+    if constexpr (
+        std::is_integral_v<TAccumulator> &&
+        sizeof(TAccumulator) <= sizeof(int64_t)) {
+      BaseAggregate::template updateSlots<TAccumulator, TInput>(
+          groups,
+          slots,
+          numSlots,
+          rows,
+          args[0],
+          &updateSingleValue<TAccumulator>);
+      return true;
+    }
+    return false;
+  }
+
   void addSingleGroupRawInput(
       char* group,
       const SelectivityVector& rows,
@@ -115,6 +138,31 @@ class SumAggregate
         TAccumulator(0));
   }
 
+  /// Only sums of integers are retractable. Subtracting floating point values
+  /// back out of a sum does not restore the sum of the remaining values.
+  bool supportsRetract() const override {
+    return std::is_integral_v<TAccumulator>;
+  }
+
+  void retractSingleGroupRawInput(
+      char* group,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) override {
+    if constexpr (std::is_integral_v<TAccumulator>) {
+      DecodedVector decoded(*args[0], rows);
+      auto* accumulator =
+          BaseAggregate::Aggregate::template value<TAccumulator>(group);
+      rows.applyToSelected([&](vector_size_t i) {
+        if (!decoded.isNullAt(i)) {
+          *accumulator = functions::checkedMinus<TAccumulator>(
+              *accumulator, TAccumulator(decoded.valueAt<TInput>(i)));
+        }
+      });
+    } else {
+      BaseAggregate::retractSingleGroupRawInput(group, rows, args);
+    }
+  }
+
  protected:
   // TData is used to store the updated sum state. It can be either
   // TAccumulator or TResult, which in most cases are the same, but for
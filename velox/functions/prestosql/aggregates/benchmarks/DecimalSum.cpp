@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include <random>
+
+#include "velox/functions/lib/aggregates/DecimalAggregate.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::functions::aggregate;
+
+namespace {
+
+constexpr vector_size_t kNumValues = 10'000;
+
+// Compares adding a vector of decimals to a sum with an overflow check per
+// value, as done for multiple groups, and with addDecimalValues() as done for
+// a single group.
+template <typename T>
+class DecimalSumBenchmark {
+ public:
+  DecimalSumBenchmark() : rows_(kNumValues) {
+    std::mt19937_64 rng(1);
+    for (auto i = 0; i < kNumValues; ++i) {
+      if constexpr (std::is_same_v<T, int128_t>) {
+        values_.push_back(
+            HugeInt::build(rng(), rng()) % DecimalUtil::kLongDecimalMax);
+      } else {
+        values_.push_back(rng() % DecimalUtil::kShortDecimalMax);
+      }
+    }
+  }
+
+  int128_t sumByRow() {
+    LongDecimalWithOverflowState accumulator;
+    rows_.applyToSelected([&](vector_size_t row) {
+      accumulator.overflow += DecimalUtil::addWithOverflow(
+          accumulator.sum, accumulator.sum, values_[row]);
+    });
+    return accumulator.sum + accumulator.overflow;
+  }
+
+  int128_t sumByBatch() {
+    LongDecimalWithOverflowState accumulator;
+    addDecimalValues(values_.data(), rows_, accumulator);
+    return accumulator.sum + accumulator.overflow;
+  }
+
+ private:
+  std::vector<T> values_;
+  SelectivityVector rows_;
+};
+
+std::unique_ptr<DecimalSumBenchmark<int64_t>> shortBenchmark;
+std::unique_ptr<DecimalSumBenchmark<int128_t>> longBenchmark;
+
+BENCHMARK_MULTI(shortDecimalByRow) {
+  folly::doNotOptimizeAway(shortBenchmark->sumByRow());
+  return kNumValues;
+}
+
+BENCHMARK_RELATIVE_MULTI(shortDecimalByBatch) {
+  folly::doNotOptimizeAway(shortBenchmark->sumByBatch());
+  return kNumValues;
+}
+
+BENCHMARK_MULTI(longDecimalByRow) {
+  folly::doNotOptimizeAway(longBenchmark->sumByRow());
+  return kNumValues;
+}
+
+BENCHMARK_RELATIVE_MULTI(longDecimalByBatch) {
+  folly::doNotOptimizeAway(longBenchmark->sumByBatch());
+  return kNumValues;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+
+  shortBenchmark = std::make_unique<DecimalSumBenchmark<int64_t>>();
+  longBenchmark = std::make_unique<DecimalSumBenchmark<int128_t>>();
+  folly::runBenchmarks();
+  shortBenchmark.reset();
+  longBenchmark.reset();
+  return 0;
+}
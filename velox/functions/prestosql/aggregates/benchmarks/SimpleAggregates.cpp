@@ -265,6 +265,12 @@ AGG_BENCHMARKS(stddev, k_norm)
 AGG_BENCHMARKS(stddev, k_hash)
 BENCHMARK_DRAW_LINE();
 
+// Approx distinct aggregate.
+AGG_BENCHMARKS(approx_distinct, k_array)
+AGG_BENCHMARKS(approx_distinct, k_norm)
+AGG_BENCHMARKS(approx_distinct, k_hash)
+BENCHMARK_DRAW_LINE();
+
 } // namespace
 
 int main(int argc, char** argv) {
@@ -456,5 +456,32 @@ TEST_F(ArrayAggTest, mask) {
   testFunction("simple_array_agg");
 }
 
+// Partial array_agg keeps the values of all groups in one container. Flushes
+// the partial aggregation many times to check that the values are freed and
+// the container reused between flushes.
+TEST_F(ArrayAggTest, partialFlush) {
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < 10; ++i) {
+    batches.push_back(makeRowVector({
+        makeFlatVector<int32_t>(1'000, [](auto row) { return row % 300; }),
+        makeFlatVector<std::string>(
+            1'000,
+            [i](auto row) { return fmt::format("value {} {}", i, row); }),
+    }));
+  }
+  createDuckDbTable(batches);
+
+  auto plan = PlanBuilder()
+                  .values(batches)
+                  .partialAggregation({"c0"}, {"array_agg(c1)"})
+                  .finalAggregation()
+                  .project({"c0", "array_sort(a0)"})
+                  .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(core::QueryConfig::kMaxPartialAggregationMemory, "1000")
+      .assertResults(
+          "SELECT c0, array_sort(array_agg(c1)) FROM tmp GROUP BY c0");
+}
+
 } // namespace
 } // namespace facebook::velox::aggregate::test
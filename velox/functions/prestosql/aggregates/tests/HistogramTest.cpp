@@ -207,6 +207,35 @@ TEST_F(HistogramTest, groupByString) {
   testGlobalHistogramWithDuck(data);
 }
 
+TEST_F(HistogramTest, longStrings) {
+  // Strings longer than 12 bytes are not inlined in StringView, so that the
+  // accumulator copies them. Each string repeats in all the batches.
+  std::vector<std::string> strings;
+  for (auto i = 0; i < 20; ++i) {
+    strings.push_back(fmt::format("a string longer than 12 bytes: {}", i));
+  }
+  std::vector<RowVectorPtr> batches;
+  for (auto batch = 0; batch < 3; ++batch) {
+    batches.push_back(makeRowVector({
+        makeFlatVector<int16_t>(1'000, [](auto row) { return row % 17; }),
+        makeFlatVector<StringView>(
+            1'000,
+            [&](auto row) {
+              return StringView(strings[(row * 7 + batch) % strings.size()]);
+            },
+            nullEvery(13)),
+    }));
+  }
+  createDuckDbTable(batches);
+  testAggregations(
+      batches,
+      {"c0"},
+      {"histogram(c1)"},
+      "SELECT c0, histogram(c1) FROM tmp GROUP BY c0");
+  testAggregations(
+      batches, {}, {"histogram(c1)"}, "SELECT histogram(c1) FROM tmp");
+}
+
 TEST_F(HistogramTest, globalInteger) {
   vector_size_t num = 29;
   auto vector = makeFlatVector<int32_t>(
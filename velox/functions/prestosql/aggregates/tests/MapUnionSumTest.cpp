@@ -308,5 +308,66 @@ TEST_F(MapUnionSumTest, groupByVarcharKey) {
   testAggregations({data}, {"c0"}, {"map_union_sum(c1)"}, {expected});
 }
 
+TEST_F(MapUnionSumTest, longVarcharKeys) {
+  // Keys longer than 12 bytes are not inlined in StringView, so that the
+  // accumulator copies them. Each key repeats in many maps across batches.
+  std::vector<std::string> keyStrings;
+  for (auto i = 0; i < 10; ++i) {
+    keyStrings.push_back(fmt::format("a map key longer than 12 bytes: {}", i));
+  }
+  using Map = std::vector<std::pair<StringView, std::optional<int64_t>>>;
+  std::vector<RowVectorPtr> data;
+  std::map<int64_t, std::map<std::string, int64_t>> groupSums;
+  std::map<std::string, int64_t> globalSums;
+  int32_t row = 0;
+  for (auto batch = 0; batch < 3; ++batch) {
+    std::vector<int64_t> groups;
+    std::vector<std::optional<Map>> maps;
+    for (auto i = 0; i < 100; ++i, ++row) {
+      groups.push_back(row % 3);
+      if (row % 17 == 0) {
+        maps.push_back(std::nullopt);
+        continue;
+      }
+      Map map;
+      for (auto j = 0; j < row % 4; ++j) {
+        const auto& key = keyStrings[(row + j) % keyStrings.size()];
+        // A null value adds nothing but its key is in the result.
+        std::optional<int64_t> value;
+        if (row % 5 != j) {
+          value = row + j;
+        }
+        groupSums[row % 3][key] += value.value_or(0);
+        globalSums[key] += value.value_or(0);
+        map.emplace_back(StringView(key), value);
+      }
+      maps.push_back(map);
+    }
+    data.push_back(makeRowVector({
+        makeFlatVector<int64_t>(groups),
+        makeNullableMapVector<StringView, int64_t>(maps),
+    }));
+  }
+
+  auto toMap = [](const std::map<std::string, int64_t>& sums) {
+    Map map;
+    for (const auto& [key, sum] : sums) {
+      map.emplace_back(StringView(key), sum);
+    }
+    return map;
+  };
+  auto expected = makeRowVector({
+      makeFlatVector<int64_t>({0, 1, 2}),
+      makeMapVector<StringView, int64_t>(
+          {toMap(groupSums[0]), toMap(groupSums[1]), toMap(groupSums[2])}),
+  });
+  testAggregations(data, {"c0"}, {"map_union_sum(c1)"}, {expected});
+
+  expected = makeRowVector({
+      makeMapVector<StringView, int64_t>({toMap(globalSums)}),
+  });
+  testAggregations(data, {}, {"map_union_sum(c1)"}, {expected});
+}
+
 } // namespace
 } // namespace facebook::velox::aggregate::test
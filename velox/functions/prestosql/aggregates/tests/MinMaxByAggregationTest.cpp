@@ -1214,6 +1214,71 @@ TEST_F(MinMaxByComplexTypes, mapGroupBy) {
       {data}, {"c0"}, {"min_by(c1, c2)", "max_by(c1, c2)"}, {expected});
 }
 
+// Many rows per group and batch, so that the minimum and maximum change many
+// times within a batch. Covers comparisons with and without nulls.
+TEST_F(MinMaxByComplexTypes, manyRowsPerGroup) {
+  constexpr vector_size_t kSize = 1'000;
+  constexpr int32_t kNumGroups = 7;
+  auto by = [](vector_size_t row) { return (row * 37) % kSize; };
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>(kSize, [](auto row) { return row % kNumGroups; }),
+      makeFlatVector<std::string>(
+          kSize,
+          [](auto row) { return fmt::format("value {}", row); },
+          nullEvery(13)),
+      makeFlatVector<int64_t>(kSize, by, nullEvery(11)),
+      makeFlatVector<int64_t>(kSize, by),
+  });
+
+  auto expectedValue = [&](int32_t group, bool nullableBy, bool max) {
+    std::optional<vector_size_t> winner;
+    for (auto row = 0; row < kSize; ++row) {
+      if ((group >= 0 && row % kNumGroups != group) ||
+          (nullableBy && row % 11 == 0)) {
+        continue;
+      }
+      if (!winner.has_value() ||
+          (max ? by(row) > by(winner.value())
+               : by(row) < by(winner.value()))) {
+        winner = row;
+      }
+    }
+    std::optional<std::string> value;
+    if (winner.value() % 13 != 0) {
+      value = fmt::format("value {}", winner.value());
+    }
+    return value;
+  };
+
+  std::vector<int32_t> keys;
+  std::vector<std::vector<std::optional<std::string>>> values(4);
+  for (auto group = 0; group < kNumGroups; ++group) {
+    keys.push_back(group);
+    values[0].push_back(expectedValue(group, true, false));
+    values[1].push_back(expectedValue(group, true, true));
+    values[2].push_back(expectedValue(group, false, false));
+    values[3].push_back(expectedValue(group, false, true));
+  }
+  auto expected = makeRowVector({
+      makeFlatVector<int32_t>(keys),
+      makeNullableFlatVector<std::string>(values[0]),
+      makeNullableFlatVector<std::string>(values[1]),
+      makeNullableFlatVector<std::string>(values[2]),
+      makeNullableFlatVector<std::string>(values[3]),
+  });
+  const std::vector<std::string> aggregates = {
+      "min_by(c1, c2)", "max_by(c1, c2)", "min_by(c1, c3)", "max_by(c1, c3)"};
+  testAggregations({data}, {"c0"}, aggregates, {expected});
+
+  expected = makeRowVector({
+      makeNullableFlatVector<std::string>({expectedValue(-1, true, false)}),
+      makeNullableFlatVector<std::string>({expectedValue(-1, true, true)}),
+      makeNullableFlatVector<std::string>({expectedValue(-1, false, false)}),
+      makeNullableFlatVector<std::string>({expectedValue(-1, false, true)}),
+  });
+  testAggregations({data}, {}, aggregates, {expected});
+}
+
 class MinMaxByNTest : public AggregationTestBase {
  protected:
   void SetUp() override {
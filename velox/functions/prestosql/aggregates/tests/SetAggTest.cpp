@@ -31,6 +31,52 @@ class SetAggTest : public AggregationTestBase {
     AggregationTestBase::SetUp();
     allowInputShuffle();
   }
+
+  template <typename T>
+  void testManyIntegers() {
+    // Group 0 has 2 distinct values, group 1 has 7 and groups 2 and 3 have 97,
+    // so that some sets stay inline and others grow a hash table. Values
+    // include 0 and negative numbers. Group 3 has nulls.
+    constexpr vector_size_t kSize = 10'000;
+    auto valueAt = [](vector_size_t row) -> T {
+      switch (row % 4) {
+        case 0:
+          return row / 4 % 2;
+        case 1:
+          return row % 7 - 3;
+        default:
+          return row % 97 - 48;
+      }
+    };
+    auto isNullAt = [](vector_size_t row) {
+      return row % 4 == 3 && row % 11 == 0;
+    };
+
+    auto data = makeRowVector({
+        makeFlatVector<int32_t>(kSize, [](auto row) { return row % 4; }),
+        makeFlatVector<T>(kSize, valueAt, isNullAt),
+    });
+
+    std::vector<std::set<T>> groups(4);
+    for (auto i = 0; i < kSize; ++i) {
+      if (!isNullAt(i)) {
+        groups[i % 4].insert(valueAt(i));
+      }
+    }
+    std::vector<std::vector<std::optional<T>>> sets;
+    for (const auto& group : groups) {
+      sets.emplace_back(group.begin(), group.end());
+    }
+    sets.back().push_back(std::nullopt);
+
+    auto expected = makeRowVector({
+        makeFlatVector<int32_t>({0, 1, 2, 3}),
+        makeNullableArrayVector(sets),
+    });
+
+    testAggregations(
+        {data}, {"c0"}, {"set_agg(c1)"}, {"c0", "array_sort(a0)"}, {expected});
+  }
 };
 
 TEST_F(SetAggTest, global) {
@@ -157,6 +203,13 @@ TEST_F(SetAggTest, groupBy) {
       {expected});
 }
 
+TEST_F(SetAggTest, groupByManyIntegers) {
+  testManyIntegers<int8_t>();
+  testManyIntegers<int16_t>();
+  testManyIntegers<int32_t>();
+  testManyIntegers<int64_t>();
+}
+
 std::vector<std::optional<std::string>> generateStrings(
     const std::vector<std::optional<std::string>>& choices,
     vector_size_t size) {
@@ -14,10 +14,13 @@
  * limitations under the License.
  */
 
+#include <random>
+
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/exec/AggregationHook.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/functions/lib/aggregates/DecimalAggregate.h"
 #include "velox/functions/lib/aggregates/tests/AggregationTestBase.h"
 
 using facebook::velox::exec::test::PlanBuilder;
@@ -372,6 +375,74 @@ TEST_F(SumTest, sumDecimalOverflow) {
       "Value '-100000000000000000000000000000000000000' is not in the range of Decimal Type");
 }
 
+// Returns the sum of 'accumulator' as a multiple of 2^127 and a non-negative
+// remainder. Different orders of adding give different pairs of sum and
+// overflow for the same sum.
+std::pair<int64_t, int128_t> normalizedSum(
+    const functions::aggregate::LongDecimalWithOverflowState& accumulator) {
+  if (accumulator.sum >= 0) {
+    return {accumulator.overflow, accumulator.sum};
+  }
+  return {
+      accumulator.overflow - 1,
+      static_cast<int128_t>(
+          static_cast<__uint128_t>(accumulator.sum) +
+          DecimalUtil::kOverflowMultiplier)};
+}
+
+template <typename T>
+void testAddDecimalValues(const std::vector<T>& values) {
+  const auto size = values.size();
+  SelectivityVector rows(size);
+  for (auto step : {1, 3}) {
+    SCOPED_TRACE(fmt::format("step: {}", step));
+    if (step > 1) {
+      rows.clearAll();
+      for (auto i = 1; i < size; i += step) {
+        rows.setValid(i, true);
+      }
+      rows.updateBounds();
+    }
+    functions::aggregate::LongDecimalWithOverflowState expected;
+    rows.applyToSelected([&](auto row) {
+      expected.overflow += DecimalUtil::addWithOverflow(
+          expected.sum, expected.sum, values[row]);
+    });
+    functions::aggregate::LongDecimalWithOverflowState actual;
+    functions::aggregate::addDecimalValues(values.data(), rows, actual);
+    ASSERT_EQ(normalizedSum(expected), normalizedSum(actual));
+  }
+}
+
+TEST_F(SumTest, addDecimalValues) {
+  std::mt19937_64 rng(1);
+  std::vector<int128_t> longValues;
+  std::vector<int64_t> shortValues;
+  for (auto i = 0; i < 1'000; ++i) {
+    longValues.push_back(
+        HugeInt::build(rng(), rng()) % DecimalUtil::kLongDecimalMax);
+    const auto shortValue =
+        static_cast<int64_t>(rng() % DecimalUtil::kShortDecimalMax);
+    shortValues.push_back(i % 3 == 0 ? -shortValue : shortValue);
+  }
+  testAddDecimalValues(longValues);
+  testAddDecimalValues(shortValues);
+
+  // Sums that overflow in the middle or in the end.
+  testAddDecimalValues(
+      std::vector<int128_t>(100, DecimalUtil::kLongDecimalMax));
+  testAddDecimalValues(
+      std::vector<int128_t>(100, DecimalUtil::kLongDecimalMin));
+  testAddDecimalValues(std::vector<int128_t>{
+      DecimalUtil::kLongDecimalMax,
+      DecimalUtil::kLongDecimalMax,
+      DecimalUtil::kLongDecimalMin,
+      DecimalUtil::kLongDecimalMin,
+      -1});
+  testAddDecimalValues(
+      std::vector<int64_t>(1'000, std::numeric_limits<int64_t>::min()));
+}
+
 TEST_F(SumTest, sumWithMask) {
   auto rowType =
       ROW({"c0", "c1", "c2", "c3", "c4"},
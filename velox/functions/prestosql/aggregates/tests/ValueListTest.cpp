@@ -15,6 +15,7 @@
  */
 #include "velox/functions/prestosql/aggregates/ValueList.h"
 #include <gtest/gtest.h>
+#include "velox/functions/prestosql/aggregates/CompactValueList.h"
 #include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
 #include "velox/vector/tests/utils/VectorMaker.h"
 
@@ -134,3 +135,40 @@ TEST_F(ValueListTest, arrays) {
     }
   }
 }
+
+TEST_F(ValueListTest, compactLists) {
+  for (auto size : kTestSizes) {
+    auto data = makeFlatVector<std::string>(
+        size,
+        [](auto row) { return fmt::format("a long string value {}", row); },
+        test::VectorMaker::nullEvery(7));
+    DecodedVector decoded(*data);
+
+    // Interleave the values of 3 lists and extract them one list after the
+    // other.
+    aggregate::CompactValueLists lists(VARCHAR(), pool());
+    std::vector<aggregate::CompactValueList> groups(3);
+    for (auto i = 0; i < size; ++i) {
+      lists.append(groups[i % 3], decoded, i);
+    }
+    std::vector<vector_size_t> expectedRows;
+    for (auto group = 0; group < 3; ++group) {
+      for (auto i = group; i < size; i += 3) {
+        expectedRows.push_back(i);
+      }
+    }
+
+    auto result = BaseVector::create(VARCHAR(), size, pool());
+    lists.extract({&groups[0], &groups[1], &groups[2]}, result);
+    ASSERT_EQ(result->size(), size);
+    for (auto i = 0; i < size; ++i) {
+      ASSERT_TRUE(result->equalValueAt(data.get(), i, expectedRows[i]))
+          << "at " << i;
+    }
+
+    for (auto& group : groups) {
+      lists.free(group);
+      ASSERT_EQ(group.size, 0);
+    }
+  }
+}
@@ -30,6 +30,8 @@ int main(int argc, char** argv) {
   folly::init(&argc, &argv);
 
   functions::prestosql::registerArrayFunctions();
+  functions::prestosql::registerArithmeticFunctions();
+  functions::prestosql::registerGeneralFunctions();
   registerFunction<ArraySumFunction, int64_t, Array<int32_t>>(
       {"array_sum_alt"});
 
@@ -37,14 +39,20 @@ int main(int argc, char** argv) {
   auto inputType = ROW({"c0"}, {ARRAY(INTEGER())});
 
   auto createSet = [&](bool withNulls) {
-    benchmarkBuilder
-        .addBenchmarkSet(
-            fmt::format("array_sum_{}", withNulls ? "nulls" : "nullfree"),
-            inputType)
-        .withFuzzerOptions(
-            {.vectorSize = 1000, .nullRatio = withNulls ? 0.2 : 0})
-        .addExpression("vector", "array_sum(c0)")
-        .addExpression("simple", "array_sum_alt(c0)");
+    auto& set =
+        benchmarkBuilder
+            .addBenchmarkSet(
+                fmt::format("array_sum_{}", withNulls ? "nulls" : "nullfree"),
+                inputType)
+            .withFuzzerOptions(
+                {.vectorSize = 1000, .nullRatio = withNulls ? 0.2 : 0})
+            .addExpression("vector", "array_sum(c0)")
+            .addExpression("simple", "array_sum_alt(c0)");
+    if (!withNulls) {
+      // reduce returns null for arrays with null elements.
+      set.addExpression(
+          "reduce", "reduce(c0, 0, (s, x) -> s + cast(x as bigint), s -> s)");
+    }
   };
 
   createSet(true);
@@ -124,6 +124,20 @@ class DateTimeBenchmark : public functions::test::FunctionBenchmarkBase {
     doRun(exprSet, data);
   }
 
+  // Formats timestamps of recent years with 'function' and a constant format.
+  void runFormat(const std::string& function, const std::string& format) {
+    folly::BenchmarkSuspender suspender;
+    auto timestamps = vectorMaker_.flatVector<Timestamp>(10'000, [](auto row) {
+      return Timestamp(1'600'000'000 + row * 997, (row % 1'000) * 1'000'000);
+    });
+    auto data = vectorMaker_.rowVector({timestamps});
+    auto exprSet = compileExpression(
+        fmt::format("{}(c0, '{}')", function, format), data->type());
+    suspender.dismiss();
+
+    doRun(exprSet, data);
+  }
+
   void doRun(exec::ExprSet& exprSet, const RowVectorPtr& rowVector) {
     int cnt = 0;
     for (auto i = 0; i < 100; i++) {
@@ -197,6 +211,21 @@ BENCHMARK(second) {
   DateTimeBenchmark benchmark;
   benchmark.run("second");
 }
+
+BENCHMARK(formatDatetimeIso) {
+  DateTimeBenchmark benchmark;
+  benchmark.runFormat("format_datetime", "yyyy-MM-dd HH:mm:ss.SSS");
+}
+
+BENCHMARK(formatDatetimeText) {
+  DateTimeBenchmark benchmark;
+  benchmark.runFormat("format_datetime", "EEEE, MMMM dd yyyy hh:mm a");
+}
+
+BENCHMARK(dateFormatIso) {
+  DateTimeBenchmark benchmark;
+  benchmark.runFormat("date_format", "%Y-%m-%d %H:%i:%s");
+}
 } // namespace
 
 int main(int argc, char** argv) {
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+
+#include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+
+namespace facebook::velox::functions::test {
+namespace {
+
+// Benchmarks decimal arithmetic over flat columns. With precisions up to 18
+// digits for add and multiply the results cannot overflow and are computed
+// without overflow checks. DECIMAL(38, x) arguments always take the checked
+// path.
+class DecimalArithmeticBenchmark : public FunctionBenchmarkBase {
+ public:
+  DecimalArithmeticBenchmark() : FunctionBenchmarkBase() {
+    prestosql::registerArithmeticFunctions();
+    options_.parseDecimalAsDouble = false;
+  }
+
+  size_t run(
+      const std::string& expression,
+      const TypePtr& aType,
+      const TypePtr& bType) {
+    folly::BenchmarkSuspender suspender;
+    auto data = vectorMaker_.rowVector(
+        {makeData(aType, 1'234), makeData(bType, 567)});
+    auto exprSet = compileExpression(expression, data->type());
+    suspender.dismiss();
+
+    size_t count = 0;
+    for (auto i = 0; i < 100; ++i) {
+      count += evaluate(exprSet, data)->size();
+    }
+    return count;
+  }
+
+ private:
+  VectorPtr makeData(const TypePtr& type, int64_t seed) {
+    constexpr vector_size_t kSize = 10'000;
+    if (type->isShortDecimal()) {
+      return vectorMaker_.flatVector<int64_t>(
+          kSize,
+          [&](auto row) { return (row * seed) % 100'000 + 1; },
+          nullptr,
+          type);
+    }
+    return vectorMaker_.flatVector<int128_t>(
+        kSize,
+        [&](auto row) { return (row * seed) % 100'000 + 1; },
+        nullptr,
+        type);
+  }
+};
+
+BENCHMARK_MULTI(addShort) {
+  DecimalArithmeticBenchmark benchmark;
+  return benchmark.run("c0 + c1", DECIMAL(12, 2), DECIMAL(12, 2));
+}
+
+BENCHMARK_MULTI(addShortRescale) {
+  DecimalArithmeticBenchmark benchmark;
+  return benchmark.run("c0 + c1", DECIMAL(12, 2), DECIMAL(12, 4));
+}
+
+BENCHMARK_MULTI(addShortConstant) {
+  DecimalArithmeticBenchmark benchmark;
+  return benchmark.run("c0 + 1.00", DECIMAL(12, 2), DECIMAL(12, 2));
+}
+
+BENCHMARK_MULTI(subtractShort) {
+  DecimalArithmeticBenchmark benchmark;
+  return benchmark.run("c0 - c1", DECIMAL(12, 2), DECIMAL(12, 2));
+}
+
+BENCHMARK_MULTI(multiplyShort) {
+  DecimalArithmeticBenchmark benchmark;
+  return benchmark.run("c0 * c1", DECIMAL(9, 2), DECIMAL(9, 2));
+}
+
+BENCHMARK_MULTI(multiplyShortToLong) {
+  DecimalArithmeticBenchmark benchmark;
+  return benchmark.run("c0 * c1", DECIMAL(15, 2), DECIMAL(15, 2));
+}
+
+BENCHMARK_MULTI(divideShort) {
+  DecimalArithmeticBenchmark benchmark;
+  return benchmark.run("c0 / c1", DECIMAL(12, 2), DECIMAL(12, 2));
+}
+
+BENCHMARK_MULTI(addLong) {
+  DecimalArithmeticBenchmark benchmark;
+  return benchmark.run("c0 + c1", DECIMAL(24, 2), DECIMAL(24, 2));
+}
+
+BENCHMARK_MULTI(addLongChecked) {
+  DecimalArithmeticBenchmark benchmark;
+  return benchmark.run("c0 + c1", DECIMAL(38, 2), DECIMAL(38, 2));
+}
+
+BENCHMARK_MULTI(multiplyLongChecked) {
+  DecimalArithmeticBenchmark benchmark;
+  return benchmark.run("c0 * c1", DECIMAL(24, 2), DECIMAL(24, 2));
+}
+
+} // namespace
+} // namespace facebook::velox::functions::test
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -73,6 +73,30 @@ class InBenchmark : public functions::test::FunctionBenchmarkBase {
     doRun(exprSet, data);
   }
 
+  // Runs an IN list of 'numValues' strings of 'length' bytes over as many
+  // strings, half of which are in the list.
+  void runStrings(size_t numValues, size_t length) {
+    folly::BenchmarkSuspender suspender;
+    auto makeString = [&](auto i) {
+      auto value = std::to_string(i);
+      return std::string(length - value.size(), 'x') + value;
+    };
+    auto data = vectorMaker_.rowVector({vectorMaker_.flatVector<std::string>(
+        1'000, [&](auto row) { return makeString(row % (2 * numValues)); })});
+
+    std::ostringstream inList;
+    inList << "'" << makeString(0) << "'";
+    for (auto i = 1; i < numValues; ++i) {
+      inList << ", '" << makeString(i) << "'";
+    }
+
+    auto sql = fmt::format("c0 IN ({})", inList.str());
+    auto exprSet = compileExpression(sql, data->type());
+    suspender.dismiss();
+
+    doRun(exprSet, data);
+  }
+
   void doRun(ExprSet& exprSet, const RowVectorPtr& rowVector) {
     int cnt = 0;
     for (auto i = 0; i < 1000; i++) {
@@ -126,6 +150,26 @@ BENCHMARK_RELATIVE(in1K) {
   benchmark.run(1'000);
 }
 
+BENCHMARK(in10K) {
+  InBenchmark benchmark;
+  benchmark.run(10'000);
+}
+
+BENCHMARK(inShortStrings1K) {
+  InBenchmark benchmark;
+  benchmark.runStrings(1'000, 8);
+}
+
+BENCHMARK(inLongStrings1K) {
+  InBenchmark benchmark;
+  benchmark.runStrings(1'000, 40);
+}
+
+BENCHMARK(inLongStrings10K) {
+  InBenchmark benchmark;
+  benchmark.runStrings(10'000, 40);
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
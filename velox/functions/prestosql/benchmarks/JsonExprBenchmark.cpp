@@ -114,6 +114,38 @@ class JsonBenchmark : public velox::functions::test::FunctionBenchmarkBase {
     doRun(iter, exprSet, rowVector);
   }
 
+  // Evaluates fnName(c0, '$.key[i].k1') for 'numPaths' paths as separate
+  // expressions of one ExprSet, e.g. the projections of a query.
+  void runWithJsonExtractPaths(
+      int iter,
+      int vectorSize,
+      const std::string& fnName,
+      const std::string& json,
+      int numPaths) {
+    folly::BenchmarkSuspender suspender;
+    auto jsonVector = makeJsonData(json, vectorSize);
+    auto rowVector = vectorMaker_.rowVector({jsonVector});
+    std::vector<core::TypedExprPtr> exprs;
+    for (auto i = 0; i < numPaths; ++i) {
+      auto untyped = parse::parseExpr(
+          fmt::format("{}(c0, '$.key[{}].k1')", fnName, i), options_);
+      exprs.push_back(core::Expressions::inferTypes(
+          untyped, rowVector->type(), execCtx_.pool()));
+    }
+    exec::ExprSet exprSet(std::move(exprs), &execCtx_);
+    SelectivityVector rows(vectorSize);
+    suspender.dismiss();
+
+    uint32_t cnt = 0;
+    for (auto i = 0; i < iter; i++) {
+      exec::EvalCtx evalCtx(&execCtx_, &exprSet, rowVector.get());
+      std::vector<VectorPtr> results(numPaths);
+      exprSet.eval(rows, evalCtx, results);
+      cnt += results.back()->size();
+    }
+    folly::doNotOptimizeAway(cnt);
+  }
+
   void runWithJsonContains(
       int iter,
       int vectorSize,
@@ -211,6 +243,27 @@ void SIMDJsonExtractScalar(int iter, int vectorSize, int jsonSize) {
       iter, vectorSize, "simd_json_extract_scalar", json, "$.key[7].k1");
 }
 
+// Each json_extract_scalar call parses the documents again.
+void SIMDJsonExtractScalarPaths(int iter, int vectorSize, int jsonSize) {
+  folly::BenchmarkSuspender suspender;
+  JsonBenchmark benchmark;
+  auto json = benchmark.prepareData(jsonSize);
+  suspender.dismiss();
+  benchmark.runWithJsonExtractPaths(
+      iter, vectorSize, "simd_json_extract_scalar", json, 8);
+}
+
+// The json_extract_scalar calls on c0 are rewritten to parse each document
+// once for all the paths.
+void MultiJsonExtractScalarPaths(int iter, int vectorSize, int jsonSize) {
+  folly::BenchmarkSuspender suspender;
+  JsonBenchmark benchmark;
+  auto json = benchmark.prepareData(jsonSize);
+  suspender.dismiss();
+  benchmark.runWithJsonExtractPaths(
+      iter, vectorSize, "json_extract_scalar", json, 8);
+}
+
 void FollyJsonExtract(int iter, int vectorSize, int jsonSize) {
   folly::BenchmarkSuspender suspender;
   JsonBenchmark benchmark;
@@ -445,6 +498,43 @@ BENCHMARK_RELATIVE_NAMED_PARAM(
     10000);
 BENCHMARK_DRAW_LINE();
 
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(
+    SIMDJsonExtractScalarPaths,
+    100_iters_100bytes_size,
+    100,
+    100);
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    MultiJsonExtractScalarPaths,
+    100_iters_100bytes_size,
+    100,
+    100);
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM(
+    SIMDJsonExtractScalarPaths,
+    100_iters_1000bytes_size,
+    100,
+    1000);
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    MultiJsonExtractScalarPaths,
+    100_iters_1000bytes_size,
+    100,
+    1000);
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM(
+    SIMDJsonExtractScalarPaths,
+    100_iters_10000bytes_size,
+    100,
+    10000);
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    MultiJsonExtractScalarPaths,
+    100_iters_10000bytes_size,
+    100,
+    10000);
+BENCHMARK_DRAW_LINE();
+
 BENCHMARK_DRAW_LINE();
 BENCHMARK_NAMED_PARAM(FollyJsonSize, 100_iters_10bytes_size, 100, 10);
 BENCHMARK_RELATIVE_NAMED_PARAM(SIMDJsonSize, 100_iters_10bytes_size, 100, 10);
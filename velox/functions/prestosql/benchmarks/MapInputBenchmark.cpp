@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include <folly/Benchmark.h>
+#include <folly/String.h>
 #include <folly/init/Init.h>
 #include "velox/expression/EvalCtx.h"
 #include "velox/expression/VectorFunction.h"
@@ -249,6 +250,8 @@ class MapInputBenchmark : public functions::test::FunctionBenchmarkBase {
   MapInputBenchmark() : FunctionBenchmarkBase() {
     functions::prestosql::registerMapFunctions();
     functions::prestosql::registerArrayFunctions();
+    functions::prestosql::registerArithmeticFunctions();
+    functions::prestosql::registerGeneralFunctions();
 
     registerFunction<MapSumValuesAndKeysSimple, int64_t, Map<int64_t, int64_t>>(
         {"map_sum_simple"});
@@ -328,6 +331,38 @@ class MapInputBenchmark : public functions::test::FunctionBenchmarkBase {
     return vectorMaker_.rowVector({evaluate(expression, rowVector)});
   }
 
+  // Maps of 200 keys, named k0 to k199 in descending order so that the keys
+  // are not sorted.
+  RowVectorPtr makeLargeMapData() {
+    const vector_size_t size = 1'000;
+    constexpr int32_t kMapSize = 200;
+    auto mapVector = vectorMaker_.mapVector<StringView, double>(
+        size,
+        [](auto /* row */) { return kMapSize; },
+        [](auto idx) {
+          return StringView::makeInline(
+              fmt::format("k{}", kMapSize - 1 - idx % kMapSize));
+        },
+        [](auto idx) { return idx; });
+
+    return vectorMaker_.rowVector({mapVector});
+  }
+
+  // Sums 'numSubscripts' values of each map of makeLargeMapData().
+  void runSubscripts(int32_t numSubscripts) {
+    folly::BenchmarkSuspender suspender;
+    auto rowVector = makeLargeMapData();
+    std::vector<std::string> subscripts;
+    for (auto i = 0; i < numSubscripts; ++i) {
+      subscripts.push_back(fmt::format("c0['k{}']", i * 3));
+    }
+    auto exprSet = compileExpression(
+        folly::join(" + ", subscripts), rowVector->type());
+    suspender.dismiss();
+
+    doRun(exprSet, rowVector);
+  }
+
   void run(const std::string& functionName) {
     folly::BenchmarkSuspender suspender;
     auto rowVector = makeMapDataMap();
@@ -431,6 +466,16 @@ BENCHMARK_RELATIVE(nestedMapSumVectorFunctionMapView) {
   MapInputBenchmark benchmark;
   benchmark.runNested("nested_map_sum_vector_mapview");
 }
+
+BENCHMARK(largeMapOneSubscript) {
+  MapInputBenchmark benchmark;
+  benchmark.runSubscripts(1);
+}
+
+BENCHMARK(largeMapFiftySubscripts) {
+  MapInputBenchmark benchmark;
+  benchmark.runSubscripts(50);
+}
 } // namespace
 
 int main(int argc, char** argv) {
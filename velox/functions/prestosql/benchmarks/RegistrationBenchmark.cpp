@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include "velox/expression/SimpleFunctionRegistry.h"
+#include "velox/expression/VectorFunction.h"
+#include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+
+using namespace facebook::velox;
+
+// Measures the startup cost of registering the Presto scalar functions and
+// the time to compile and run a first expression after that.
+namespace {
+
+void clearFunctionRegistries() {
+  exec::vectorFunctionFactories().wlock()->clear();
+  exec::mutableSimpleFunctions().clearRegistry();
+}
+
+class RegistrationBenchmark : public functions::test::FunctionBenchmarkBase {
+ public:
+  void runFirstQuery() {
+    auto data = vectorMaker_.rowVector(
+        {vectorMaker_.flatVector<int64_t>({1, 2, 3}),
+         vectorMaker_.flatVector<std::string>({"a", "b", "c"})});
+    auto exprSet = compileExpression(
+        "concat(upper(c1), cast(c0 + 1 as varchar))", data->type());
+    folly::doNotOptimizeAway(evaluate(exprSet, data));
+  }
+};
+
+BENCHMARK(registerAllScalarFunctions) {
+  folly::BenchmarkSuspender suspender;
+  clearFunctionRegistries();
+  suspender.dismiss();
+
+  functions::prestosql::registerAllScalarFunctions();
+}
+
+BENCHMARK(timeToFirstQuery) {
+  folly::BenchmarkSuspender suspender;
+  clearFunctionRegistries();
+  RegistrationBenchmark benchmark;
+  suspender.dismiss();
+
+  functions::prestosql::registerAllScalarFunctions();
+  benchmark.runFirstQuery();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+
+  folly::runBenchmarks();
+  return 0;
+}
@@ -114,6 +114,27 @@ class StringAsciiUTFFunctionBenchmark
     doRun(exprSet, rowVector);
   }
 
+  // Runs 'expression' over strings of 100 characters in c0, which have a
+  // few non-ascii characters if 'utf' is true. The strings are not known
+  // to be ascii.
+  void runMostlyAscii(const std::string& expression, bool utf) {
+    folly::BenchmarkSuspender suspender;
+
+    auto vector = vectorMaker_.flatVector<std::string>(10'000, [&](auto row) {
+      std::string value(100, 'a' + row % 26);
+      if (utf) {
+        value.replace(row % 90, 2, "\u00E5");
+        value.replace(95, 3, "\u20AC");
+      }
+      return value;
+    });
+    auto rowVector = vectorMaker_.rowVector({vector});
+    auto exprSet = compileExpression(expression, rowVector->type());
+
+    suspender.dismiss();
+    doRun(exprSet, rowVector);
+  }
+
   void doRun(ExprSet& exprSet, const RowVectorPtr& rowVector) {
     uint32_t cnt = 0;
     for (auto i = 0; i < 100; i++) {
@@ -172,6 +193,26 @@ BENCHMARK_RELATIVE(aciiRPad) {
   StringAsciiUTFFunctionBenchmark benchmark;
   benchmark.runLPadRPad("rpad", false);
 }
+BENCHMARK(utfLength) {
+  StringAsciiUTFFunctionBenchmark benchmark;
+  benchmark.runMostlyAscii("length(c0)", true);
+}
+
+BENCHMARK_RELATIVE(asciiLength) {
+  StringAsciiUTFFunctionBenchmark benchmark;
+  benchmark.runMostlyAscii("length(c0)", false);
+}
+
+BENCHMARK(utfStrPos) {
+  StringAsciiUTFFunctionBenchmark benchmark;
+  benchmark.runMostlyAscii("strpos(c0, '\u20AC')", true);
+}
+
+BENCHMARK_RELATIVE(asciiStrPos) {
+  StringAsciiUTFFunctionBenchmark benchmark;
+  benchmark.runMostlyAscii("strpos(c0, 'b')", false);
+}
+
 } // namespace
 
 // Preliminary release run, before ascii optimization.
@@ -190,19 +190,7 @@ class UrlBenchmark : public functions::test::FunctionBenchmarkBase {
     folly::BenchmarkSuspender suspender;
 
     size_t size = 1000;
-    std::string url;
-    auto vectorUrls = vectorMaker_.flatVector<StringView>(
-        size,
-        [&](auto row) {
-          // construct some pseudo random url
-          url = fmt::format(
-              "http://somehost{}.com:8080/somepath{}/p.php?k1={}#Refi",
-              row,
-              row % 2,
-              row % 3);
-          return StringView(url);
-        },
-        nullptr);
+    auto vectorUrls = makeUrls(size);
     auto constVector =
         BaseVector::createConstant(VARCHAR(), "k1", size, pool());
     auto rowVector = isParameter
@@ -218,6 +206,33 @@ class UrlBenchmark : public functions::test::FunctionBenchmarkBase {
     doRun(exprSet, rowVector);
   }
 
+  // Evaluates 'fnNames' as separate expressions over the same column of URLs,
+  // as clickstream queries do.
+  void runMultipleUrlExtracts(const std::vector<std::string>& fnNames) {
+    folly::BenchmarkSuspender suspender;
+
+    auto rowVector = vectorMaker_.rowVector({makeUrls(1000)});
+    std::vector<core::TypedExprPtr> expressions;
+    for (const auto& fnName : fnNames) {
+      auto untyped = parse::parseExpr(fmt::format("{}(c0)", fnName), options_);
+      expressions.push_back(core::Expressions::inferTypes(
+          untyped, rowVector->type(), execCtx_.pool()));
+    }
+    ExprSet exprSet(std::move(expressions), &execCtx_);
+    SelectivityVector rows(rowVector->size());
+
+    suspender.dismiss();
+
+    uint32_t cnt = 0;
+    for (auto i = 0; i < 100; i++) {
+      EvalCtx evalCtx(&execCtx_, &exprSet, rowVector.get());
+      std::vector<VectorPtr> results(fnNames.size());
+      exprSet.eval(rows, evalCtx, results);
+      cnt += results[0]->size();
+    }
+    folly::doNotOptimizeAway(cnt);
+  }
+
   void doRun(ExprSet& exprSet, const RowVectorPtr& rowVector) {
     uint32_t cnt = 0;
     for (auto i = 0; i < 100; i++) {
@@ -225,6 +240,23 @@ class UrlBenchmark : public functions::test::FunctionBenchmarkBase {
     }
     folly::doNotOptimizeAway(cnt);
   }
+
+ private:
+  VectorPtr makeUrls(vector_size_t size) {
+    std::string url;
+    return vectorMaker_.flatVector<StringView>(
+        size,
+        [&](auto row) {
+          // construct some pseudo random url
+          url = fmt::format(
+              "http://somehost{}.com:8080/somepath{}/p.php?k1={}#Refi",
+              row,
+              row % 2,
+              row % 3);
+          return StringView(url);
+        },
+        nullptr);
+  }
 };
 
 BENCHMARK(folly_fragment) {
@@ -297,6 +329,17 @@ BENCHMARK_RELATIVE(velox_param) {
   benchmark.runUrlExtract("url_extract_parameter", true);
 }
 
+BENCHMARK(velox_multiple_extracts) {
+  UrlBenchmark benchmark;
+  benchmark.runMultipleUrlExtracts(
+      {"url_extract_protocol",
+       "url_extract_host",
+       "url_extract_port",
+       "url_extract_path",
+       "url_extract_query",
+       "url_extract_fragment"});
+}
+
 } // namespace
 
 int main(int argc, char** argv) {
@@ -48,6 +48,15 @@ simdjson::ondemand::document SIMDJsonExtractor::parse(
   return parser.iterate(json);
 }
 
+/* static */ std::unique_ptr<SIMDJsonExtractor> SIMDJsonExtractor::tryCreate(
+    folly::StringPiece path) {
+  std::unique_ptr<SIMDJsonExtractor> extractor(new SIMDJsonExtractor());
+  if (!extractor->tokenize(folly::trimWhitespace(path).str())) {
+    return nullptr;
+  }
+  return extractor;
+}
+
 bool SIMDJsonExtractor::tokenize(const std::string& path) {
   thread_local static JsonPathTokenizer tokenizer;
 
@@ -97,3 +106,19 @@ void extractArray(
   }
 }
 } // namespace facebook::velox::functions::detail
+
+namespace facebook::velox::functions {
+
+SIMDJsonMultiExtractor::SIMDJsonMultiExtractor(
+    const std::vector<std::string>& paths) {
+  extractors_.reserve(paths.size());
+  for (const auto& path : paths) {
+    auto extractor = detail::SIMDJsonExtractor::tryCreate(path);
+    if (extractor == nullptr) {
+      VELOX_USER_FAIL("Invalid JSON path: {}", path);
+    }
+    extractors_.push_back(std::move(extractor));
+  }
+}
+
+} // namespace facebook::velox::functions
@@ -16,7 +16,10 @@
 
 #pragma once
 
+#include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include "folly/Range.h"
 #include "folly/dynamic.h"
@@ -52,6 +55,10 @@ class SIMDJsonExtractor {
 
   simdjson::ondemand::document parse(const simdjson::padded_string& json);
 
+  // Returns an extractor for 'path' that is not shared with other callers, or
+  // nullptr if 'path' is not a valid JSON path.
+  static std::unique_ptr<SIMDJsonExtractor> tryCreate(folly::StringPiece path);
+
  private:
   // Use this method to get an instance of SIMDJsonExtractor given a JSON path.
   // Given the nature of the cache, it's important this is only used by
@@ -65,6 +72,8 @@ class SIMDJsonExtractor {
     }
   }
 
+  SIMDJsonExtractor() = default;
+
   bool tokenize(const std::string& path);
 
   // Max number of extractors cached in extractorCache.
@@ -184,6 +193,75 @@ bool simdJsonExtract(
   return true;
 }
 
+/// Extracts the elements at several JSON paths from each document, e.g. for
+/// json_extract_scalar(x, '$.a'), json_extract_scalar(x, '$.b') on the same x.
+/// Copies and parses each document once for all the paths: the ondemand
+/// parser indexes the whole document once and each path then only walks the
+/// part of that index it needs, starting again from the root.
+class SIMDJsonMultiExtractor {
+ public:
+  /// Throws VeloxUserError if any of 'paths' is not a valid JSON path.
+  explicit SIMDJsonMultiExtractor(const std::vector<std::string>& paths);
+
+  static bool isValidPath(folly::StringPiece path) {
+    return detail::SIMDJsonExtractor::tryCreate(path) != nullptr;
+  }
+
+  size_t numPaths() const {
+    return extractors_.size();
+  }
+
+  /// Calls consumer(i, element) for the element(s) at the i-th path, with the
+  /// same arguments as the consumer of simdJsonExtract(). Sets 'succeeded[i]'
+  /// to false if an error parsing the JSON prevented extracting the i-th path,
+  /// in which case simdJsonExtract() would return false.
+  template <typename TConsumer>
+  void extract(
+      const velox::StringView& json,
+      TConsumer&& consumer,
+      std::vector<bool>& succeeded) const;
+
+ private:
+  std::vector<std::unique_ptr<detail::SIMDJsonExtractor>> extractors_;
+};
+
+template <typename TConsumer>
+void SIMDJsonMultiExtractor::extract(
+    const velox::StringView& json,
+    TConsumer&& consumer,
+    std::vector<bool>& succeeded) const {
+  succeeded.assign(extractors_.size(), false);
+  simdjson::padded_string paddedJson(json.data(), json.size());
+  std::optional<simdjson::ondemand::document> jsonDoc;
+  for (size_t i = 0; i < extractors_.size(); ++i) {
+    auto& extractor = *extractors_[i];
+    try {
+      if (jsonDoc.has_value()) {
+        jsonDoc->rewind();
+      } else {
+        jsonDoc.emplace(extractor.parse(paddedJson));
+      }
+    } catch (const simdjson::simdjson_error&) {
+      // The document could not be indexed, all the paths fail.
+      return;
+    }
+    auto pathConsumer = [&](auto& v) { consumer(i, v); };
+    try {
+      if (extractor.isRootOnlyPath()) {
+        pathConsumer(*jsonDoc);
+      } else {
+        auto value = jsonDoc->get_value().value();
+        extractor.extract(value, pathConsumer);
+      }
+      succeeded[i] = true;
+    } catch (const simdjson::simdjson_error&) {
+      // rewind() does not clear the error of the document, parse it again for
+      // the next path.
+      jsonDoc.reset();
+    }
+  }
+}
+
 template <typename TConsumer>
 bool simdJsonExtract(
     const std::string& json,
@@ -16,6 +16,7 @@
 
 #include "velox/functions/Registerer.h"
 #include "velox/functions/prestosql/JsonFunctions.h"
+#include "velox/functions/prestosql/MultiJsonExtractScalar.h"
 #include "velox/functions/prestosql/SIMDJsonFunctions.h"
 
 namespace facebook::velox::functions {
@@ -32,6 +33,14 @@ void registerJsonFunctions(const std::string& prefix) {
   registerFunction<SIMDJsonExtractScalarFunction, Varchar, Varchar, Varchar>(
       {prefix + "json_extract_scalar"});
 
+  exec::registerStatefulVectorFunction(
+      prefix + kMultiJsonExtractScalar,
+      multiJsonExtractScalarSignatures(),
+      makeMultiJsonExtractScalar);
+  exec::registerExprSetRewrite([prefix](const auto& exprs) {
+    return rewriteJsonExtractScalarCalls(prefix, exprs);
+  });
+
   registerFunction<SIMDJsonExtractFunction, Json, Json, Varchar>(
       {prefix + "json_extract"});
   registerFunction<SIMDJsonExtractFunction, Json, Varchar, Varchar>(
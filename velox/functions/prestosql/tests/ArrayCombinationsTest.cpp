@@ -196,6 +196,38 @@ TEST_F(ArrayCombinationsTest, varcharArrays) {
   testExpr(expected, "combinations(C0, C1)", {arrayVector, comboLengthVector});
 }
 
+TEST_F(ArrayCombinationsTest, varcharArraysReferInput) {
+  auto arrayVector = makeArrayVector<std::string>(
+      {{"red shiny car ahead", "blue clear sky above", "yellow rose flowers"}});
+  auto data = makeRowVector({arrayVector, makeFlatVector<int32_t>({2})});
+  auto result = evaluate<ArrayVector>("combinations(c0, c1)", data);
+
+  // The result strings are not copied and share the buffers of the input.
+  auto* inputElements = arrayVector->elements()->asFlatVector<StringView>();
+  auto* resultElements = result->elements()
+                             ->as<ArrayVector>()
+                             ->elements()
+                             ->asFlatVector<StringView>();
+  ASSERT_EQ(1, inputElements->stringBuffers().size());
+  const auto& resultBuffers = resultElements->stringBuffers();
+  EXPECT_NE(
+      std::find(
+          resultBuffers.begin(),
+          resultBuffers.end(),
+          inputElements->stringBuffers()[0]),
+      resultBuffers.end());
+
+  // The result stays valid after the input is freed.
+  data.reset();
+  arrayVector.reset();
+  using S = StringView;
+  auto expected = makeNullableNestedArrayVector<S>(
+      {{{{{"red shiny car ahead", "blue clear sky above"}},
+         {{"red shiny car ahead", "yellow rose flowers"}},
+         {{"blue clear sky above", "yellow rose flowers"}}}}});
+  facebook::velox::test::assertEqualVectors(expected, result);
+}
+
 TEST_F(ArrayCombinationsTest, boolNullableArrays) {
   auto arrayVector = makeNullableArrayVector<bool>({
       {},
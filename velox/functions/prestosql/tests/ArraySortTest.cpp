@@ -583,6 +583,73 @@ TEST_F(ArraySortTest, lambda) {
       "(x, y) -> if(length(x) < length(y), 1, if(length(x) = length(y), 0, -1))");
 }
 
+TEST_F(ArraySortTest, largeArrays) {
+  // Arrays large enough to be radix sorted, with nulls, NaNs and negative
+  // values.
+  auto testLargeArrays = [&](auto typeTag) {
+    using T = decltype(typeTag);
+    std::vector<std::vector<std::optional<T>>> arrays;
+    std::vector<std::vector<std::optional<T>>> expectedAsc;
+    std::vector<std::vector<std::optional<T>>> expectedDesc;
+    for (auto i = 0; i < 3; ++i) {
+      std::vector<T> values;
+      for (auto j = 0; j < 1'000; ++j) {
+        values.push_back(static_cast<T>((j * 7'919 + i) % 1'001 - 500));
+      }
+      if constexpr (std::is_floating_point_v<T>) {
+        values[17] = std::numeric_limits<T>::quiet_NaN();
+        values[18] = std::numeric_limits<T>::infinity();
+        values[19] = -std::numeric_limits<T>::infinity();
+      }
+      auto& array = arrays.emplace_back();
+      std::vector<T> nonNulls;
+      for (auto j = 0; j < values.size(); ++j) {
+        if (j % 11 == 0) {
+          array.push_back(std::nullopt);
+        } else {
+          array.push_back(values[j]);
+          nonNulls.push_back(values[j]);
+        }
+      }
+      // NaN is the largest value.
+      std::sort(nonNulls.begin(), nonNulls.end(), [](T left, T right) {
+        if constexpr (std::is_floating_point_v<T>) {
+          if (std::isnan(left) || std::isnan(right)) {
+            return !std::isnan(left) && std::isnan(right);
+          }
+        }
+        return left < right;
+      });
+      auto& asc = expectedAsc.emplace_back(nonNulls.begin(), nonNulls.end());
+      asc.resize(array.size(), std::nullopt);
+      auto& desc =
+          expectedDesc.emplace_back(nonNulls.rbegin(), nonNulls.rend());
+      desc.resize(array.size(), std::nullopt);
+    }
+
+    auto data = makeRowVector({makeNullableArrayVector(arrays)});
+    assertEqualVectors(
+        makeNullableArrayVector(expectedAsc),
+        evaluate("array_sort(c0)", data));
+    assertEqualVectors(
+        makeNullableArrayVector(expectedDesc),
+        evaluate("array_sort_desc(c0)", data));
+    // Sorts by the values of a lambda.
+    assertEqualVectors(
+        makeNullableArrayVector(expectedAsc),
+        evaluate("array_sort(c0, x -> x)", data));
+    assertEqualVectors(
+        makeNullableArrayVector(expectedDesc),
+        evaluate("array_sort_desc(c0, x -> x)", data));
+  };
+
+  testLargeArrays(int8_t{});
+  testLargeArrays(int32_t{});
+  testLargeArrays(int64_t{});
+  testLargeArrays(float{});
+  testLargeArrays(double{});
+}
+
 VELOX_INSTANTIATE_TEST_SUITE_P(
     ArraySortTest,
     ArraySortTest,
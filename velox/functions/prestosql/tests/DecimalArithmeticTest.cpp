@@ -145,6 +145,64 @@ TEST_F(DecimalArithmeticTest, add) {
       "Decimal overflow: 1 + 99999999999999999999999999999999999999");
 }
 
+TEST_F(DecimalArithmeticTest, noOverflowFastPath) {
+  // The precisions of the arguments prove that the results fit, so the flat
+  // and constant arguments are computed without overflow checks.
+  constexpr vector_size_t kSize = 1'000;
+  auto a = makeFlatVector<int64_t>(
+      kSize, [](auto row) { return row * 37 - 5'000; }, nullptr, DECIMAL(8, 2));
+  auto b = makeFlatVector<int64_t>(
+      kSize, [](auto row) { return 7'000 - row * 11; }, nullptr, DECIMAL(9, 3));
+
+  testDecimalExpr<TypeKind::BIGINT>(
+      makeFlatVector<int64_t>(
+          kSize,
+          [](auto row) { return (row * 37 - 5'000) * 10 + 7'000 - row * 11; },
+          nullptr,
+          DECIMAL(10, 3)),
+      "c0 + c1",
+      {a, b});
+  testDecimalExpr<TypeKind::BIGINT>(
+      makeFlatVector<int64_t>(
+          kSize,
+          [](auto row) { return (row * 37 - 5'000) * 10 - (7'000 - row * 11); },
+          nullptr,
+          DECIMAL(10, 3)),
+      "c0 - c1",
+      {a, b});
+  testDecimalExpr<TypeKind::BIGINT>(
+      makeFlatVector<int64_t>(
+          kSize,
+          [](auto row) {
+            return int64_t(row * 37 - 5'000) * (7'000 - row * 11);
+          },
+          nullptr,
+          DECIMAL(17, 5)),
+      "c0 * c1",
+      {a, b});
+  testDecimalExpr<TypeKind::BIGINT>(
+      makeFlatVector<int64_t>(
+          kSize,
+          [](auto row) { return (row * 37 - 5'000) * 10 + 1'500; },
+          nullptr,
+          DECIMAL(10, 3)),
+      "c0 + 1.500",
+      {a});
+
+  // Only the selected rows are computed.
+  auto condition =
+      makeFlatVector<bool>(kSize, [](auto row) { return row % 3 == 0; });
+  auto result = evaluate<SimpleVector<int64_t>>(
+      "if(c2, c0 + c1, c0 - c1)", makeRowVector({b, b, condition}));
+  assertEqualVectors(
+      makeFlatVector<int64_t>(
+          kSize,
+          [](auto row) { return row % 3 == 0 ? 2 * (7'000 - row * 11) : 0; },
+          nullptr,
+          DECIMAL(10, 3)),
+      result);
+}
+
 TEST_F(DecimalArithmeticTest, subtract) {
   auto shortFlatA = makeFlatVector<int64_t>({1000, 2000}, DECIMAL(18, 3));
   // Subtract short and short, returning long.
@@ -700,6 +700,35 @@ TEST_F(ElementAtTest, stringAsKey) {
           "element_at(C0, C1)", makeRowVector({mapVector, searchVector})));
 }
 
+TEST_F(ElementAtTest, repeatedSubscriptsOfLargeMap) {
+  // 50 even keys per map in descending order, so not sorted.
+  constexpr vector_size_t kMapSize = 50;
+  auto keyAt = [](auto idx) { return (kMapSize - 1 - idx % kMapSize) * 2; };
+  auto mapVector = makeMapVector<int64_t, int64_t>(
+      100,
+      [](auto /* row */) { return kMapSize; },
+      keyAt,
+      [&](auto idx) { return keyAt(idx) * 10 + idx / kMapSize; });
+  auto searchVector =
+      makeFlatVector<int64_t>(100, [](auto row) { return row % kMapSize * 2; });
+  auto data = makeRowVector({mapVector, searchVector});
+
+  // The first subscript scans the maps, the next ones binary search them.
+  auto result = evaluate(
+      "element_at(c0, 6) + element_at(c0, 98) + coalesce(element_at(c0, 7), 0)",
+      data);
+  test::assertEqualVectors(
+      makeFlatVector<int64_t>(100, [](auto row) { return 1040 + 2 * row; }),
+      result);
+
+  result = evaluate(
+      "element_at(c0, c1) + coalesce(element_at(c0, c1 + 1), 0) + c0[0]", data);
+  test::assertEqualVectors(
+      makeFlatVector<int64_t>(
+          100, [](auto row) { return row % kMapSize * 20 + 2 * row; }),
+      result);
+}
+
 TEST_F(ElementAtTest, mapWithComplexTypeAsKey) {
   VectorPtr mapVector, keyVector, searchVector;
   const auto expected = makeNullableFlatVector<int64_t>({1, 3, std::nullopt});
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <folly/String.h>
 #include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
 
 using namespace facebook::velox;
@@ -772,3 +773,71 @@ TEST_F(InPredicateTest, floatDuplicateWithBigintValuesUsingHashTable) {
   auto result = evaluate<SimpleVector<bool>>(predicate, input);
   assertEqualVectors(expected, result);
 }
+
+TEST_F(InPredicateTest, largeListSomeRows) {
+  // Values spread out enough to make a hash table filter.
+  std::vector<int64_t> inValues;
+  for (auto i = 0; i < 1'000; ++i) {
+    inValues.push_back(i * 1'000'003);
+  }
+  auto inList = folly::join(", ", inValues);
+  auto isIn = [](int64_t value) {
+    return value % 1'000'003 == 0 && value / 1'000'003 < 1'000;
+  };
+
+  const vector_size_t size = 1'001;
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(
+          size, [](auto row) { return (row % 13) * 1'000'003 + row % 2; }),
+      makeFlatVector<int32_t>(size, [](auto row) { return row % 97; }),
+  });
+
+  auto expected = makeFlatVector<bool>(
+      size, [&](auto row) { return isIn((row % 13) * 1'000'003 + row % 2); });
+  assertEqualVectors(
+      expected,
+      evaluate<SimpleVector<bool>>(fmt::format("c0 IN ({})", inList), data));
+
+  // Rows that are not selected keep their previous result.
+  SelectivityVector rows(size, false);
+  for (auto row = 0; row < size; row += 3) {
+    rows.setValid(row, true);
+  }
+  rows.setValid(size - 1, true);
+  rows.updateBounds();
+  VectorPtr result =
+      makeFlatVector<bool>(size, [](auto /*row*/) { return true; });
+  evaluate<SimpleVector<bool>>(
+      fmt::format("c0 IN ({})", inList), data, rows, result);
+  expected = makeFlatVector<bool>(size, [&](auto row) {
+    return !rows.isValid(row) || isIn((row % 13) * 1'000'003 + row % 2);
+  });
+  assertEqualVectors(expected, result);
+
+  expected = makeFlatVector<bool>(
+      size, [](auto row) { return row % 97 < 40 && row % 97 % 2 == 0; });
+  std::vector<int32_t> evens;
+  for (auto i = 0; i < 40; i += 2) {
+    evens.push_back(i);
+  }
+  assertEqualVectors(
+      expected,
+      evaluate<SimpleVector<bool>>(
+          fmt::format("c1 IN ({})", folly::join(", ", evens)), data));
+}
+
+TEST_F(InPredicateTest, longStrings) {
+  std::vector<std::string> inValues;
+  for (auto i = 0; i < 100; ++i) {
+    inValues.push_back(fmt::format("'a string longer than inline {}'", i * 2));
+  }
+  auto data = makeRowVector({makeFlatVector<std::string>(300, [](auto row) {
+    return fmt::format("a string longer than inline {}", row);
+  })});
+  auto expected = makeFlatVector<bool>(
+      300, [](auto row) { return row < 200 && row % 2 == 0; });
+  assertEqualVectors(
+      expected,
+      evaluate<SimpleVector<bool>>(
+          fmt::format("c0 IN ({})", folly::join(", ", inValues)), data));
+}
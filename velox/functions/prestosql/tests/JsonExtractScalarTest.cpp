@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include "velox/functions/prestosql/MultiJsonExtractScalar.h"
 #include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
 #include "velox/functions/prestosql/types/JsonType.h"
 
@@ -206,6 +207,42 @@ TEST_F(JsonExtractScalarTest, wildcardSelect) {
       std::nullopt);
 }
 
+// Calls with different paths on the same input are evaluated together,
+// parsing each document once. Checks that this gives the same results as
+// evaluating the calls one by one.
+TEST_F(JsonExtractScalarTest, multiplePaths) {
+  auto data = makeRowVector({makeNullableFlatVector<StringView>(
+      {R"({"k1":"v1","k2":{"k3":3},"k4":[1,2]})"_sv,
+       R"({"k4":[true,false],"k2":{"k3":"x"},"k1":1.5})"_sv,
+       R"({"k1":null,"k2":[1],"k4":{"a":1}})"_sv,
+       R"({"k1":"v1","k2":)"_sv,
+       std::nullopt,
+       R"([1,2,3])"_sv,
+       R"("hello")"_sv},
+      JSON())});
+
+  const std::vector<std::string> paths = {
+      "$.k1", "$.k2.k3", "$.k4[1]", "$", "$.k1", "$.k4[*]"};
+  std::vector<std::string> expressions;
+  for (const auto& path : paths) {
+    expressions.push_back(fmt::format("json_extract_scalar(c0, '{}')", path));
+  }
+  auto exprSet = compileExpressions(expressions, asRowType(data->type()));
+  ASSERT_NE(
+      exprSet->toString().find(kMultiJsonExtractScalar), std::string::npos);
+
+  exec::EvalCtx context(&execCtx_, exprSet.get(), data.get());
+  SelectivityVector rows(data->size());
+  std::vector<VectorPtr> results(expressions.size());
+  exprSet->eval(rows, context, results);
+
+  for (auto i = 0; i < expressions.size(); ++i) {
+    SCOPED_TRACE(expressions[i]);
+    velox::test::assertEqualVectors(
+        evaluate(expressions[i], data), results[i]);
+  }
+}
+
 } // namespace
 
 } // namespace facebook::velox::functions::prestosql
@@ -153,6 +153,34 @@ TEST_F(ReduceTest, elementIndicesOverwrite) {
   assertEqualVectors(makeFlatVector<int64_t>({104, 106}), result);
 }
 
+TEST_F(ReduceTest, differentLengths) {
+  // A few long arrays among short, empty and null ones. Later steps only
+  // process the rows whose arrays are still long enough.
+  vector_size_t size = 1'000;
+  auto sizeAt = [](auto row) { return row % 10 == 0 ? row % 97 : row % 3; };
+  auto input = makeRowVector({makeArrayVector<int64_t>(
+      size,
+      sizeAt,
+      [](auto row, auto index) { return row * index; },
+      nullEvery(7))});
+
+  auto result = evaluate(
+      "reduce(c0, 1, (s, x) -> if(x % 2 = 0, s + x, s - 1), s -> s)", input);
+
+  auto expected = makeFlatVector<int64_t>(
+      size,
+      [&](auto row) {
+        int64_t state = 1;
+        for (auto i = 0; i < sizeAt(row); ++i) {
+          const int64_t x = row * i;
+          state = x % 2 == 0 ? state + x : state - 1;
+        }
+        return state;
+      },
+      nullEvery(7));
+  assertEqualVectors(expected, result);
+}
+
 TEST_F(ReduceTest, try) {
   auto input = makeRowVector({
       makeArrayVector<int64_t>({
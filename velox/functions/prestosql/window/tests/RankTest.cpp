@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/functions/lib/window/tests/WindowTestBase.h"
 #include "velox/functions/prestosql/window/WindowFunctionsRegistration.h"
 
@@ -103,5 +106,129 @@ VELOX_INSTANTIATE_TEST_SUITE_P(
     RankTest,
     testing::ValuesIn(getRankTestParams()));
 
+class RankExecutionTest : public WindowTestBase {
+ protected:
+  void SetUp() override {
+    WindowTestBase::SetUp();
+    window::prestosql::registerAllWindowFunctions();
+  }
+};
+
+// Tests all functions with the window operator spilling every input batch.
+// The spilled rows are read back one partition at a time.
+TEST_F(RankExecutionTest, spill) {
+  const vector_size_t kNumRows = 1'000;
+  std::vector<RowVectorPtr> input;
+  for (int i = 0; i < 5; ++i) {
+    input.push_back(makeRowVector({
+        makeFlatVector<int32_t>(kNumRows, [](auto row) { return row % 11; }),
+        makeFlatVector<int32_t>(
+            kNumRows, [](auto row) { return row % 7; }, nullEvery(13)),
+        makeFlatVector<int64_t>(
+            kNumRows, [i](auto row) { return i * kNumRows + row; }),
+    }));
+  }
+  createDuckDbTable(input);
+
+  for (const auto& function : kRankFunctions) {
+    auto queryInfo = buildWindowQuery(
+        input, function, "partition by c0 order by c1, c2", "");
+    SCOPED_TRACE(queryInfo.functionSql);
+    auto spillDirectory = TempDirectoryPath::create();
+    auto task = AssertQueryBuilder(queryInfo.planNode, duckDbQueryRunner_)
+                    .spillDirectory(spillDirectory->path)
+                    .config(core::QueryConfig::kSpillEnabled, "true")
+                    .config(core::QueryConfig::kWindowSpillEnabled, "true")
+                    .config(core::QueryConfig::kTestingSpillPct, "100")
+                    .assertResults(queryInfo.querySql);
+    auto stats = task->taskStats().pipelineStats[0].operatorStats[1];
+    ASSERT_GT(stats.spilledRows, 0);
+    ASSERT_GT(stats.spilledBytes, 0);
+    ASSERT_EQ(stats.spilledPartitions, 1);
+    ASSERT_GT(stats.spilledFiles, 0);
+  }
+}
+
+// Tests all functions with the window operator over sorted input which
+// produces the output one partition at a time.
+TEST_F(RankExecutionTest, inputsSorted) {
+  std::vector<RowVectorPtr> input = {
+      makeRandomInputVector(100),
+      makeRandomInputVector(100),
+      makeSinglePartitionVector(50)};
+  createDuckDbTable(input);
+
+  for (const auto& function : kRankFunctions) {
+    const auto functionSql = fmt::format(
+        "{} over (partition by c0 order by c1, c2, c3)", function);
+    SCOPED_TRACE(functionSql);
+    auto plan = PlanBuilder()
+                    .values(input)
+                    .orderBy({"c0", "c1", "c2", "c3"}, false)
+                    .streamingWindow({functionSql})
+                    .planNode();
+    assertQuery(
+        plan, fmt::format("SELECT c0, c1, c2, c3, {} FROM tmp", functionSql));
+  }
+}
+
+// Tests all functions evaluated in parallel over a skewed partition and
+// serially over the small ones.
+TEST_F(RankExecutionTest, parallelFunctions) {
+  const vector_size_t kNumRows = 1'000;
+  std::vector<RowVectorPtr> input;
+  for (int i = 0; i < 3; ++i) {
+    input.push_back(makeRowVector({
+        makeFlatVector<int32_t>(
+            kNumRows, [](auto row) { return row % 3 == 0 ? 0 : row % 11; }),
+        makeFlatVector<int32_t>(
+            kNumRows, [](auto row) { return row % 7; }, nullEvery(13)),
+        makeFlatVector<int64_t>(
+            kNumRows, [i](auto row) { return i * kNumRows + row; }),
+    }));
+  }
+  createDuckDbTable(input);
+
+  std::vector<std::string> functionSqls;
+  for (const auto& function : kRankFunctions) {
+    functionSqls.push_back(
+        fmt::format("{} over (partition by c0 order by c1, c2)", function));
+  }
+  auto plan = PlanBuilder().values(input).window(functionSqls).planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(core::QueryConfig::kWindowParallelFunctionsMinRows, "500")
+      .assertResults(fmt::format(
+          "SELECT c0, c1, c2, {} FROM tmp", folly::join(", ", functionSqls)));
+}
+
+// Tests all functions over peer groups of many rows which span several output
+// batches.
+TEST_F(RankExecutionTest, largePeerGroups) {
+  const vector_size_t kNumRows = 1'000;
+  auto input = makeRowVector({
+      makeFlatVector<int32_t>(kNumRows, [](auto row) { return row % 2; }),
+      makeFlatVector<int32_t>(
+          kNumRows, [](auto row) { return row / 300; }, nullEvery(97)),
+      makeFlatVector<int64_t>(kNumRows, [](auto row) { return row; }),
+  });
+  createDuckDbTable({input});
+
+  for (const auto& function : kRankFunctions) {
+    // The row numbers of peers are not deterministic.
+    if (function == "row_number()") {
+      continue;
+    }
+    const auto functionSql =
+        fmt::format("{} over (partition by c0 order by c1)", function);
+    SCOPED_TRACE(functionSql);
+    auto plan = PlanBuilder().values({input}).window({functionSql}).planNode();
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .config(core::QueryConfig::kPreferredOutputBatchRows, "64")
+        .config(core::QueryConfig::kMaxOutputBatchRows, "64")
+        .assertResults(
+            fmt::format("SELECT c0, c1, c2, {} FROM tmp", functionSql));
+  }
+}
+
 }; // namespace
 }; // namespace facebook::velox::window::test
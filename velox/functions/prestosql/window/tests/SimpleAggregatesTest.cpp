@@ -106,6 +106,20 @@ TEST_P(SimpleAggregatesTest, randomInput) {
   testWindowFunction({makeRandomInputVector(25)});
 }
 
+// Tests function with large frames. These are computed by retracting the rows
+// that leave a sliding frame or from a segment tree, depending on whether the
+// aggregate supports retraction.
+TEST_P(SimpleAggregatesTest, largeFrames) {
+  std::vector<RowVectorPtr> input = {
+      makeSinglePartitionVector(500), makeSinglePartitionVector(300)};
+  testWindowFunction(
+      input,
+      {"rows between 100 preceding and 100 following",
+       "rows between 100 preceding and current row",
+       "rows between 50 following and 150 following",
+       "rows between c2 preceding and 100 following"});
+}
+
 // Instantiate all the above tests for each combination of aggregate function
 // and over clause.
 VELOX_INSTANTIATE_TEST_SUITE_P(
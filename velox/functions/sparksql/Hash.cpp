@@ -18,6 +18,7 @@
 #include <folly/CPortability.h>
 
 #include "velox/common/base/BitUtil.h"
+#include "velox/common/base/HashKernels.h"
 #include "velox/expression/DecodedArgs.h"
 #include "velox/vector/FlatVector.h"
 
@@ -26,6 +27,27 @@ namespace {
 
 const int32_t kDefaultSeed = 42;
 
+// Hashes the values of the flat 'vector' into 'hashes', which hold the seeds,
+// without decoding. Null rows keep their seed.
+template <typename T, typename ReturnType, typename HashFn>
+void hashFlatValues(
+    const BaseVector& vector,
+    const SelectivityVector& rows,
+    ReturnType* hashes,
+    HashFn hashFn) {
+  hashing::hashFlat(
+      vector.asUnchecked<FlatVector<T>>()->rawValues(),
+      vector.rawNulls(),
+      rows.isAllSelected() ? nullptr : rows.asRange().bits(),
+      rows.begin(),
+      rows.end(),
+      hashes,
+      hashFn,
+      [](ReturnType seed) { return seed; });
+}
+
+class Murmur3Hash;
+
 // ReturnType can be either int32_t or int64_t
 // HashClass contains the function like hashInt32
 template <typename ReturnType, typename HashClass, typename SeedType>
@@ -41,11 +63,24 @@ void applyWithType(
 
   auto& result = *resultRef->as<FlatVector<ReturnType>>();
   rows.applyToSelected([&](int row) { result.set(row, hashSeed); });
+  auto* rawResult = result.mutableRawValues();
 
   exec::LocalSelectivityVector selectedMinusNulls(context);
 
   exec::DecodedArgs decodedArgs(rows, args, context);
   for (auto i = hashIdx; i < args.size(); i++) {
+    const auto kind = args[i]->type()->kind();
+    const bool isFlat = args[i]->isFlatEncoding();
+    if constexpr (std::is_same_v<HashClass, Murmur3Hash>) {
+      if (kind == TypeKind::INTEGER && isFlat && !args[i]->mayHaveNulls() &&
+          rows.isAllSelected()) {
+        HashClass::hashInt32Values(
+            args[i]->asUnchecked<FlatVector<int32_t>>()->rawValues(),
+            rows.end(),
+            reinterpret_cast<uint32_t*>(rawResult));
+        continue;
+      }
+    }
     auto decoded = decodedArgs.at(i);
     const SelectivityVector* selected = &rows;
     if (args[i]->mayHaveNulls()) {
@@ -54,17 +89,31 @@ void applyWithType(
           decoded->nulls(), rows.begin(), rows.end());
       selected = selectedMinusNulls.get();
     }
-    switch (args[i]->type()->kind()) {
+    switch (kind) {
 // Derived from InterpretedHashFunction.hash:
 // https://github.com/apache/spark/blob/382b66e/sql/catalyst/src/main/scala/org/apache/spark/sql/catalyst/expressions/hash.scala#L532
 #define CASE(typeEnum, hashFn, inputType)                                      \
   case TypeKind::typeEnum:                                                     \
+    if (isFlat) {                                                              \
+      hashFlatValues<inputType>(                                               \
+          *args[i], rows, rawResult, [&](inputType value, ReturnType seed) {   \
+            return hashFn(value, seed);                                        \
+          });                                                                  \
+      break;                                                                   \
+    }                                                                          \
     selected->applyToSelected([&](int row) {                                   \
       result.set(                                                              \
           row, hashFn(decoded->valueAt<inputType>(row), result.valueAt(row))); \
     });                                                                        \
     break;
-      CASE(BOOLEAN, hash.hashInt32, bool);
+      case TypeKind::BOOLEAN:
+        // Flat booleans are bits, hash them one by one.
+        selected->applyToSelected([&](int row) {
+          result.set(
+              row,
+              hash.hashInt32(decoded->valueAt<bool>(row), result.valueAt(row)));
+        });
+        break;
       CASE(TINYINT, hash.hashInt32, int8_t);
       CASE(SMALLINT, hash.hashInt32, int16_t);
       CASE(INTEGER, hash.hashInt32, int32_t);
@@ -83,35 +132,15 @@ void applyWithType(
   }
 }
 
-// Derived from src/main/java/org/apache/spark/unsafe/hash/Murmur3_x86_32.java.
-//
-// Spark's Murmur3 seems slightly different from the original from Austin
-// Appleby: in particular the fmix function's first line is different. The
-// original can be found here:
-// https://github.com/aappleby/smhasher/blob/master/src/MurmurHash3.cpp
-//
-// Signed integer types have been remapped to unsigned types (as in the
-// original) to avoid undefined signed integer overflow and sign extension.
-
+// Spark's Murmur3, see hashing::Murmur3_32.
 class Murmur3Hash final {
  public:
   uint32_t hashInt32(int32_t input, uint32_t seed) {
-    uint32_t k1 = mixK1(input);
-    uint32_t h1 = mixH1(seed, k1);
-    return fmix(h1, 4);
+    return hashing::Murmur3_32::hashInt32(input, seed);
   }
 
   uint32_t hashInt64(uint64_t input, uint32_t seed) {
-    uint32_t low = input;
-    uint32_t high = input >> 32;
-
-    uint32_t k1 = mixK1(low);
-    uint32_t h1 = mixH1(seed, k1);
-
-    k1 = mixK1(high);
-    h1 = mixH1(h1, k1);
-
-    return fmix(h1, 8);
+    return hashing::Murmur3_32::hashInt64(input, seed);
   }
 
   // Floating point numbers are hashed as if they are integers, with
@@ -129,16 +158,7 @@ class Murmur3Hash final {
   // Spark also has an hashUnsafeBytes2 function, but it was not used at the
   // time of implementation.
   uint32_t hashBytes(const StringView& input, uint32_t seed) {
-    const char* i = input.data();
-    const char* const end = input.data() + input.size();
-    uint32_t h1 = seed;
-    for (; i <= end - 4; i += 4) {
-      h1 = mixH1(h1, mixK1(*reinterpret_cast<const uint32_t*>(i)));
-    }
-    for (; i != end; ++i) {
-      h1 = mixH1(h1, mixK1(*i));
-    }
-    return fmix(h1, input.size());
+    return hashing::Murmur3_32::hashBytes(input.data(), input.size(), seed);
   }
 
   uint32_t hashLongDecimal(int128_t input, uint32_t seed) {
@@ -151,30 +171,11 @@ class Murmur3Hash final {
     return hashInt64(input.toMicros(), seed);
   }
 
- private:
-  uint32_t mixK1(uint32_t k1) {
-    k1 *= 0xcc9e2d51;
-    k1 = bits::rotateLeft(k1, 15);
-    k1 *= 0x1b873593;
-    return k1;
-  }
-
-  uint32_t mixH1(uint32_t h1, uint32_t k1) {
-    h1 ^= k1;
-    h1 = bits::rotateLeft(h1, 13);
-    h1 = h1 * 5 + 0xe6546b64;
-    return h1;
-  }
-
-  // Finalization mix - force all bits of a hash block to avalanche
-  uint32_t fmix(uint32_t h1, uint32_t length) {
-    h1 ^= length;
-    h1 ^= h1 >> 16;
-    h1 *= 0x85ebca6b;
-    h1 ^= h1 >> 13;
-    h1 *= 0xc2b2ae35;
-    h1 ^= h1 >> 16;
-    return h1;
+  // Hashes the INTEGER values of a flat vector without nulls several at a
+  // time.
+  static void
+  hashInt32Values(const int32_t* values, int32_t size, uint32_t* hashes) {
+    hashing::Murmur3_32::hashInt32Values(values, size, hashes);
   }
 };
 
@@ -201,26 +202,15 @@ class Murmur3HashFunction final : public exec::VectorFunction {
   const std::optional<int32_t> seed_;
 };
 
+// Spark's XXH64, see hashing::XxHash64.
 class XxHash64 final {
-  const uint64_t PRIME64_1 = 0x9E3779B185EBCA87L;
-  const uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4FL;
-  const uint64_t PRIME64_3 = 0x165667B19E3779F9L;
-  const uint64_t PRIME64_4 = 0x85EBCA77C2B2AE63L;
-  const uint64_t PRIME64_5 = 0x27D4EB2F165667C5L;
-
  public:
   int64_t hashInt32(const int32_t input, uint64_t seed) {
-    int64_t hash = seed + PRIME64_5 + 4L;
-    hash ^= static_cast<int64_t>((input & 0xFFFFFFFFL) * PRIME64_1);
-    hash = bits::rotateLeft64(hash, 23) * PRIME64_2 + PRIME64_3;
-    return fmix(hash);
+    return hashing::XxHash64::hashInt32(input, seed);
   }
 
   int64_t hashInt64(int64_t input, uint64_t seed) {
-    int64_t hash = seed + PRIME64_5 + 8L;
-    hash ^= bits::rotateLeft64(input * PRIME64_2, 31) * PRIME64_1;
-    hash = bits::rotateLeft64(hash, 27) * PRIME64_1 + PRIME64_4;
-    return fmix(hash);
+    return hashing::XxHash64::hashInt64(input, seed);
   }
 
   // Floating point numbers are hashed as if they are integers, with
@@ -236,25 +226,7 @@ class XxHash64 final {
   }
 
   uint64_t hashBytes(const StringView& input, uint64_t seed) {
-    const char* i = input.data();
-    const char* const end = input.data() + input.size();
-
-    uint64_t hash = hashBytesByWords(input, seed);
-    uint32_t length = input.size();
-    auto offset = i + (length & -8);
-    if (offset + 4L <= end) {
-      hash ^= (*reinterpret_cast<const uint64_t*>(offset) & 0xFFFFFFFFL) *
-          PRIME64_1;
-      hash = bits::rotateLeft64(hash, 23) * PRIME64_2 + PRIME64_3;
-      offset += 4L;
-    }
-
-    while (offset < end) {
-      hash ^= (*reinterpret_cast<const uint64_t*>(offset) & 0xFFL) * PRIME64_5;
-      hash = bits::rotateLeft64(hash, 11) * PRIME64_1;
-      offset++;
-    }
-    return fmix(hash);
+    return hashing::XxHash64::hashBytes(input.data(), input.size(), seed);
   }
 
   int64_t hashLongDecimal(int128_t input, uint32_t seed) {
@@ -266,83 +238,6 @@ class XxHash64 final {
   int64_t hashTimestamp(Timestamp input, uint32_t seed) {
     return hashInt64(input.toMicros(), seed);
   }
-
- private:
-  uint64_t fmix(uint64_t hash) {
-    hash ^= hash >> 33;
-    hash *= PRIME64_2;
-    hash ^= hash >> 29;
-    hash *= PRIME64_3;
-    hash ^= hash >> 32;
-    return hash;
-  }
-
-  uint64_t hashBytesByWords(const StringView& input, uint64_t seed) {
-    const char* i = input.data();
-    const char* const end = input.data() + input.size();
-    uint32_t length = input.size();
-    uint64_t hash;
-    if (length >= 32) {
-      uint64_t v1 = seed + PRIME64_1 + PRIME64_2;
-      uint64_t v2 = seed + PRIME64_2;
-      uint64_t v3 = seed;
-      uint64_t v4 = seed - PRIME64_1;
-      for (; i <= end - 32; i += 32) {
-        v1 = bits::rotateLeft64(
-                 v1 + (*reinterpret_cast<const uint64_t*>(i) * PRIME64_2), 31) *
-            PRIME64_1;
-        v2 = bits::rotateLeft64(
-                 v2 + (*reinterpret_cast<const uint64_t*>(i + 8) * PRIME64_2),
-                 31) *
-            PRIME64_1;
-        v3 = bits::rotateLeft64(
-                 v3 + (*reinterpret_cast<const uint64_t*>(i + 16) * PRIME64_2),
-                 31) *
-            PRIME64_1;
-        v4 = bits::rotateLeft64(
-                 v4 + (*reinterpret_cast<const uint64_t*>(i + 24) * PRIME64_2),
-                 31) *
-            PRIME64_1;
-      }
-      hash = bits::rotateLeft64(v1, 1) + bits::rotateLeft64(v2, 7) +
-          bits::rotateLeft64(v3, 12) + bits::rotateLeft64(v4, 18);
-      v1 *= PRIME64_2;
-      v1 = bits::rotateLeft64(v1, 31);
-      v1 *= PRIME64_1;
-      hash ^= v1;
-      hash = hash * PRIME64_1 + PRIME64_4;
-
-      v2 *= PRIME64_2;
-      v2 = bits::rotateLeft64(v2, 31);
-      v2 *= PRIME64_1;
-      hash ^= v2;
-      hash = hash * PRIME64_1 + PRIME64_4;
-
-      v3 *= PRIME64_2;
-      v3 = bits::rotateLeft64(v3, 31);
-      v3 *= PRIME64_1;
-      hash ^= v3;
-      hash = hash * PRIME64_1 + PRIME64_4;
-
-      v4 *= PRIME64_2;
-      v4 = bits::rotateLeft64(v4, 31);
-      v4 *= PRIME64_1;
-      hash ^= v4;
-      hash = hash * PRIME64_1 + PRIME64_4;
-    } else {
-      hash = seed + PRIME64_5;
-    }
-
-    hash += length;
-
-    for (; i <= end - 8; i += 8) {
-      hash ^= bits::rotateLeft64(
-                  *reinterpret_cast<const uint64_t*>(i) * PRIME64_2, 31) *
-          PRIME64_1;
-      hash = bits::rotateLeft64(hash, 27) * PRIME64_1 + PRIME64_4;
-    }
-    return hash;
-  }
 };
 
 class XxHash64Function final : public exec::VectorFunction {
@@ -479,6 +479,172 @@ int32_t CompactRow::serializeVariableWidth(vector_size_t index, char* buffer) {
 
 namespace {
 
+bool isString(TypeKind kind) {
+  return kind == TypeKind::VARCHAR || kind == TypeKind::VARBINARY;
+}
+
+// Copies the values at 'indices' of 'decoded' to 'valueOffsets' of the rows in
+// 'buffers'. Skips null values.
+template <typename T>
+void copyFixedWidthColumn(
+    const DecodedVector& decoded,
+    const std::vector<vector_size_t>& indices,
+    const int64_t* valueOffsets,
+    char* const* buffers) {
+  const auto numRows = indices.size();
+  const auto* values = decoded.data<T>();
+  if (decoded.isIdentityMapping() && !decoded.mayHaveNulls()) {
+    for (auto row = 0; row < numRows; ++row) {
+      memcpy(
+          buffers[row] + valueOffsets[row], values + indices[row], sizeof(T));
+    }
+    return;
+  }
+  for (auto row = 0; row < numRows; ++row) {
+    if (!decoded.isNullAt(indices[row])) {
+      memcpy(
+          buffers[row] + valueOffsets[row],
+          values + decoded.index(indices[row]),
+          sizeof(T));
+    }
+  }
+}
+} // namespace
+
+std::vector<vector_size_t> CompactRow::childIndices(
+    vector_size_t offset,
+    vector_size_t numRows) {
+  std::vector<vector_size_t> indices(numRows);
+  for (auto row = 0; row < numRows; ++row) {
+    indices[row] = decoded_.index(offset + row);
+  }
+  return indices;
+}
+
+void CompactRow::rowSizes(
+    vector_size_t offset,
+    vector_size_t numRows,
+    int32_t* sizes) {
+  int32_t fixedSize = rowNullBytes_;
+  for (auto i = 0; i < children_.size(); ++i) {
+    if (childIsFixedWidth_[i]) {
+      fixedSize += children_[i].valueBytes_;
+    }
+  }
+  std::fill(sizes, sizes + numRows, fixedSize);
+
+  std::vector<vector_size_t> indices;
+  for (auto i = 0; i < children_.size(); ++i) {
+    if (childIsFixedWidth_[i]) {
+      continue;
+    }
+    if (indices.empty()) {
+      indices = childIndices(offset, numRows);
+    }
+    children_[i].addVariableWidthRowSizes(indices, sizes);
+  }
+}
+
+void CompactRow::addVariableWidthRowSizes(
+    const std::vector<vector_size_t>& indices,
+    int32_t* sizes) {
+  const auto numRows = indices.size();
+  if (isString(typeKind_)) {
+    for (auto row = 0; row < numRows; ++row) {
+      if (!isNullAt(indices[row])) {
+        const auto value = decoded_.valueAt<StringView>(indices[row]);
+        sizes[row] += kSizeBytes + value.size();
+      }
+    }
+    return;
+  }
+  for (auto row = 0; row < numRows; ++row) {
+    if (!isNullAt(indices[row])) {
+      sizes[row] += variableWidthRowSize(indices[row]);
+    }
+  }
+}
+
+void CompactRow::serialize(
+    vector_size_t offset,
+    vector_size_t numRows,
+    char* const* buffers) {
+  const auto indices = childIndices(offset, numRows);
+  std::vector<int64_t> valueOffsets(numRows, rowNullBytes_);
+  for (auto i = 0; i < children_.size(); ++i) {
+    children_[i].serializeColumn(
+        i, childIsFixedWidth_[i], indices, buffers, valueOffsets.data());
+  }
+}
+
+void CompactRow::serializeColumn(
+    int32_t field,
+    bool fixedWidth,
+    const std::vector<vector_size_t>& indices,
+    char* const* buffers,
+    int64_t* valueOffsets) {
+  const auto numRows = indices.size();
+  if (decoded_.mayHaveNulls()) {
+    for (auto row = 0; row < numRows; ++row) {
+      if (isNullAt(indices[row])) {
+        bits::setBit(reinterpret_cast<uint8_t*>(buffers[row]), field, true);
+      }
+    }
+  }
+
+  if (fixedWidth) {
+    switch (typeKind_) {
+      case TypeKind::TINYINT:
+        copyFixedWidthColumn<int8_t>(decoded_, indices, valueOffsets, buffers);
+        break;
+      case TypeKind::SMALLINT:
+        copyFixedWidthColumn<int16_t>(
+            decoded_, indices, valueOffsets, buffers);
+        break;
+      case TypeKind::INTEGER:
+        FOLLY_FALLTHROUGH;
+      case TypeKind::REAL:
+        copyFixedWidthColumn<int32_t>(
+            decoded_, indices, valueOffsets, buffers);
+        break;
+      case TypeKind::BIGINT:
+        FOLLY_FALLTHROUGH;
+      case TypeKind::DOUBLE:
+        copyFixedWidthColumn<int64_t>(
+            decoded_, indices, valueOffsets, buffers);
+        break;
+      case TypeKind::HUGEINT:
+        copyFixedWidthColumn<int128_t>(
+            decoded_, indices, valueOffsets, buffers);
+        break;
+      case TypeKind::UNKNOWN:
+        // Always null and takes no space.
+        break;
+      default:
+        // Booleans are bit packed and timestamps are converted.
+        for (auto row = 0; row < numRows; ++row) {
+          if (!isNullAt(indices[row])) {
+            serializeFixedWidth(
+                indices[row], buffers[row] + valueOffsets[row]);
+          }
+        }
+    }
+    for (auto row = 0; row < numRows; ++row) {
+      valueOffsets[row] += valueBytes_;
+    }
+    return;
+  }
+
+  for (auto row = 0; row < numRows; ++row) {
+    if (!isNullAt(indices[row])) {
+      valueOffsets[row] += serializeVariableWidth(
+          indices[row], buffers[row] + valueOffsets[row]);
+    }
+  }
+}
+
+namespace {
+
 // Reads single fixed-width value from buffer into flatVector[index].
 template <typename T>
 void readFixedWidthValue(
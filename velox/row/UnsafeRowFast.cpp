@@ -31,6 +31,36 @@ int32_t alignBytes(int32_t numBytes) {
 bool isFixedWidth(const TypePtr& type) {
   return type->isFixedWidth() && !type->isLongDecimal();
 }
+
+bool isString(TypeKind kind) {
+  return kind == TypeKind::VARCHAR || kind == TypeKind::VARBINARY;
+}
+
+// Copies the values at 'indices' of 'decoded' to 'valueOffset' of the rows in
+// 'buffers'. Skips null values.
+template <typename T>
+void copyFixedWidthColumn(
+    const DecodedVector& decoded,
+    const std::vector<vector_size_t>& indices,
+    int32_t valueOffset,
+    char* const* buffers) {
+  const auto numRows = indices.size();
+  const auto* values = decoded.data<T>();
+  if (decoded.isIdentityMapping() && !decoded.mayHaveNulls()) {
+    for (auto row = 0; row < numRows; ++row) {
+      memcpy(buffers[row] + valueOffset, values + indices[row], sizeof(T));
+    }
+    return;
+  }
+  for (auto row = 0; row < numRows; ++row) {
+    if (!decoded.isNullAt(indices[row])) {
+      memcpy(
+          buffers[row] + valueOffset,
+          values + decoded.index(indices[row]),
+          sizeof(T));
+    }
+  }
+}
 } // namespace
 
 // static
@@ -408,4 +438,148 @@ int32_t UnsafeRowFast::serializeRow(vector_size_t index, char* buffer) {
 
   return variableWidthOffset;
 }
+
+std::vector<vector_size_t> UnsafeRowFast::childIndices(
+    vector_size_t offset,
+    vector_size_t numRows) {
+  std::vector<vector_size_t> indices(numRows);
+  for (auto row = 0; row < numRows; ++row) {
+    indices[row] = decoded_.index(offset + row);
+  }
+  return indices;
+}
+
+void UnsafeRowFast::rowSizes(
+    vector_size_t offset,
+    vector_size_t numRows,
+    int32_t* sizes) {
+  const int32_t fixedSize = rowNullBytes_ + children_.size() * kFieldWidth;
+  std::fill(sizes, sizes + numRows, fixedSize);
+
+  std::vector<vector_size_t> indices;
+  for (auto i = 0; i < children_.size(); ++i) {
+    if (childIsFixedWidth_[i]) {
+      continue;
+    }
+    if (indices.empty()) {
+      indices = childIndices(offset, numRows);
+    }
+    children_[i].addVariableWidthRowSizes(indices, sizes);
+  }
+}
+
+void UnsafeRowFast::addVariableWidthRowSizes(
+    const std::vector<vector_size_t>& indices,
+    int32_t* sizes) {
+  const auto numRows = indices.size();
+  if (isString(typeKind_)) {
+    for (auto row = 0; row < numRows; ++row) {
+      if (!isNullAt(indices[row])) {
+        const auto value = decoded_.valueAt<StringView>(indices[row]);
+        sizes[row] += alignBytes(value.size());
+      }
+    }
+    return;
+  }
+  for (auto row = 0; row < numRows; ++row) {
+    if (!isNullAt(indices[row])) {
+      sizes[row] += alignBytes(variableWidthRowSize(indices[row]));
+    }
+  }
+}
+
+void UnsafeRowFast::serialize(
+    vector_size_t offset,
+    vector_size_t numRows,
+    char* const* buffers) {
+  const auto indices = childIndices(offset, numRows);
+  std::vector<int64_t> variableWidthOffsets(
+      numRows, rowNullBytes_ + kFieldWidth * children_.size());
+
+  for (auto i = 0; i < children_.size(); ++i) {
+    const int32_t valueOffset = rowNullBytes_ + i * kFieldWidth;
+    if (childIsFixedWidth_[i]) {
+      children_[i].serializeFixedWidthColumn(i, valueOffset, indices, buffers);
+    } else {
+      children_[i].serializeVariableWidthColumn(
+          i, valueOffset, indices, buffers, variableWidthOffsets.data());
+    }
+  }
+}
+
+void UnsafeRowFast::serializeFixedWidthColumn(
+    int32_t field,
+    int32_t valueOffset,
+    const std::vector<vector_size_t>& indices,
+    char* const* buffers) {
+  VELOX_DCHECK(fixedWidthTypeKind_);
+  const auto numRows = indices.size();
+  if (decoded_.mayHaveNulls()) {
+    for (auto row = 0; row < numRows; ++row) {
+      if (isNullAt(indices[row])) {
+        bits::setBit(buffers[row], field, true);
+      }
+    }
+  }
+
+  switch (typeKind_) {
+    case TypeKind::TINYINT:
+      copyFixedWidthColumn<int8_t>(decoded_, indices, valueOffset, buffers);
+      return;
+    case TypeKind::SMALLINT:
+      copyFixedWidthColumn<int16_t>(decoded_, indices, valueOffset, buffers);
+      return;
+    case TypeKind::INTEGER:
+      FOLLY_FALLTHROUGH;
+    case TypeKind::REAL:
+      copyFixedWidthColumn<int32_t>(decoded_, indices, valueOffset, buffers);
+      return;
+    case TypeKind::BIGINT:
+      FOLLY_FALLTHROUGH;
+    case TypeKind::DOUBLE:
+      copyFixedWidthColumn<int64_t>(decoded_, indices, valueOffset, buffers);
+      return;
+    default:
+      // Booleans are bit packed, timestamps are converted and unknowns are
+      // always null.
+      for (auto row = 0; row < numRows; ++row) {
+        if (!isNullAt(indices[row])) {
+          serializeFixedWidth(indices[row], buffers[row] + valueOffset);
+        }
+      }
+  }
+}
+
+void UnsafeRowFast::serializeVariableWidthColumn(
+    int32_t field,
+    int32_t valueOffset,
+    const std::vector<vector_size_t>& indices,
+    char* const* buffers,
+    int64_t* variableWidthOffsets) {
+  const auto numRows = indices.size();
+  const bool isStringKind = isString(typeKind_);
+  for (auto row = 0; row < numRows; ++row) {
+    const auto index = indices[row];
+    auto* buffer = buffers[row];
+    if (isNullAt(index)) {
+      bits::setBit(buffer, field, true);
+      continue;
+    }
+
+    auto& variableWidthOffset = variableWidthOffsets[row];
+    int32_t size;
+    if (isStringKind) {
+      const auto value = decoded_.valueAt<StringView>(index);
+      memcpy(buffer + variableWidthOffset, value.data(), value.size());
+      size = value.size();
+    } else {
+      size = serializeVariableWidth(index, buffer + variableWidthOffset);
+    }
+    // Write size and offset.
+    uint64_t sizeAndOffset = variableWidthOffset << 32 | size;
+    *reinterpret_cast<uint64_t*>(buffer + valueOffset) = sizeAndOffset;
+
+    variableWidthOffset += alignBytes(size);
+  }
+}
 } // namespace facebook::velox::row
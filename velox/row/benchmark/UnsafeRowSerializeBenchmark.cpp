@@ -40,6 +40,16 @@ class SerializeBenchmark {
     VELOX_CHECK_EQ(serialized.size(), data->size());
   }
 
+  void serializeUnsafeBatch(const RowTypePtr& rowType) {
+    folly::BenchmarkSuspender suspender;
+    auto data = makeData(rowType);
+    suspender.dismiss();
+
+    UnsafeRowFast fast(data);
+    auto serialized = serializeBatch(fast, rowType, data->size());
+    VELOX_CHECK_EQ(serialized.size(), data->size());
+  }
+
   void deserializeUnsafe(const RowTypePtr& rowType) {
     folly::BenchmarkSuspender suspender;
     auto data = makeData(rowType);
@@ -65,6 +75,16 @@ class SerializeBenchmark {
     VELOX_CHECK_EQ(serialized.size(), data->size());
   }
 
+  void serializeCompactBatch(const RowTypePtr& rowType) {
+    folly::BenchmarkSuspender suspender;
+    auto data = makeData(rowType);
+    suspender.dismiss();
+
+    CompactRow compact(data);
+    auto serialized = serializeBatch(compact, rowType, data->size());
+    VELOX_CHECK_EQ(serialized.size(), data->size());
+  }
+
   void deserializeCompact(const RowTypePtr& rowType) {
     folly::BenchmarkSuspender suspender;
     auto data = makeData(rowType);
@@ -185,6 +205,38 @@ class SerializeBenchmark {
     return serialized;
   }
 
+  // Serializes all rows at once with rowSizes() and serialize() of
+  // UnsafeRowFast or CompactRow.
+  template <typename Row>
+  std::vector<std::string_view>
+  serializeBatch(Row& row, const RowTypePtr& rowType, vector_size_t numRows) {
+    std::vector<int32_t> rowSizes(numRows);
+    if (auto fixedRowSize = Row::fixedRowSize(rowType)) {
+      std::fill(rowSizes.begin(), rowSizes.end(), fixedRowSize.value());
+    } else {
+      row.rowSizes(0, numRows, rowSizes.data());
+    }
+    size_t totalSize = 0;
+    for (auto size : rowSizes) {
+      totalSize += size;
+    }
+
+    auto buffer = AlignedBuffer::allocate<char>(totalSize, pool(), 0);
+    auto rawBuffer = buffer->asMutable<char>();
+    std::vector<char*> rows(numRows);
+    std::vector<std::string_view> serialized;
+    serialized.reserve(numRows);
+    size_t offset = 0;
+    for (auto i = 0; i < numRows; ++i) {
+      rows[i] = rawBuffer + offset;
+      serialized.push_back(std::string_view(rows[i], rowSizes[i]));
+      offset += rowSizes[i];
+    }
+    row.serialize(0, numRows, rows.data());
+    buffers_.push_back(std::move(buffer));
+    return serialized;
+  }
+
   HashStringAllocator::Position serialize(
       const RowVectorPtr& data,
       HashStringAllocator& allocator) {
@@ -202,37 +254,49 @@ class SerializeBenchmark {
   }
 
   std::shared_ptr<memory::MemoryPool> pool_{memory::addDefaultLeafMemoryPool()};
+  // Keeps the results of serializeBatch() alive.
+  std::vector<BufferPtr> buffers_;
 };
 
-#define SERDE_BENCHMARKS(name, rowType)      \
-  BENCHMARK(unsafe_serialize_##name) {       \
-    SerializeBenchmark benchmark;            \
-    benchmark.serializeUnsafe(rowType);      \
-  }                                          \
-                                             \
-  BENCHMARK(compact_serialize_##name) {      \
-    SerializeBenchmark benchmark;            \
-    benchmark.serializeCompact(rowType);     \
-  }                                          \
-                                             \
-  BENCHMARK(container_serialize_##name) {    \
-    SerializeBenchmark benchmark;            \
-    benchmark.serializeContainer(rowType);   \
-  }                                          \
-                                             \
-  BENCHMARK(unsafe_deserialize_##name) {     \
-    SerializeBenchmark benchmark;            \
-    benchmark.deserializeUnsafe(rowType);    \
-  }                                          \
-                                             \
-  BENCHMARK(compact_deserialize_##name) {    \
-    SerializeBenchmark benchmark;            \
-    benchmark.deserializeCompact(rowType);   \
-  }                                          \
-                                             \
-  BENCHMARK(container_deserialize_##name) {  \
-    SerializeBenchmark benchmark;            \
-    benchmark.deserializeContainer(rowType); \
+#define SERDE_BENCHMARKS(name, rowType)       \
+  BENCHMARK(unsafe_serialize_##name) {        \
+    SerializeBenchmark benchmark;             \
+    benchmark.serializeUnsafe(rowType);       \
+  }                                           \
+                                              \
+  BENCHMARK(unsafe_batch_serialize_##name) {  \
+    SerializeBenchmark benchmark;             \
+    benchmark.serializeUnsafeBatch(rowType);  \
+  }                                           \
+                                              \
+  BENCHMARK(compact_serialize_##name) {       \
+    SerializeBenchmark benchmark;             \
+    benchmark.serializeCompact(rowType);      \
+  }                                           \
+                                              \
+  BENCHMARK(compact_batch_serialize_##name) { \
+    SerializeBenchmark benchmark;             \
+    benchmark.serializeCompactBatch(rowType); \
+  }                                           \
+                                              \
+  BENCHMARK(container_serialize_##name) {     \
+    SerializeBenchmark benchmark;             \
+    benchmark.serializeContainer(rowType);    \
+  }                                           \
+                                              \
+  BENCHMARK(unsafe_deserialize_##name) {      \
+    SerializeBenchmark benchmark;             \
+    benchmark.deserializeUnsafe(rowType);     \
+  }                                           \
+                                              \
+  BENCHMARK(compact_deserialize_##name) {     \
+    SerializeBenchmark benchmark;             \
+    benchmark.deserializeCompact(rowType);    \
+  }                                           \
+                                              \
+  BENCHMARK(container_deserialize_##name) {   \
+    SerializeBenchmark benchmark;             \
+    benchmark.deserializeContainer(rowType);  \
   }
 
 SERDE_BENCHMARKS(
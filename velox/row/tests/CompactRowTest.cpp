@@ -72,6 +72,20 @@ class CompactRowTest : public ::testing::Test, public VectorTestBase {
 
     VELOX_CHECK_EQ(offset, totalSize);
 
+    // Serializing all rows at once produces the same bytes.
+    std::vector<int32_t> rowSizes(numRows);
+    row.rowSizes(0, numRows, rowSizes.data());
+    BufferPtr batch = AlignedBuffer::allocate<char>(totalSize, pool(), 0);
+    std::vector<char*> rows(numRows);
+    offset = 0;
+    for (auto i = 0; i < numRows; ++i) {
+      ASSERT_EQ(rowSizes[i], serialized[i].size()) << i;
+      rows[i] = batch->asMutable<char>() + offset;
+      offset += rowSizes[i];
+    }
+    row.serialize(0, numRows, rows.data());
+    ASSERT_EQ(0, memcmp(rawBuffer, batch->as<char>(), totalSize));
+
     auto copy = CompactRow::deserialize(serialized, rowType, pool());
     assertEqualVectors(data, copy);
   }
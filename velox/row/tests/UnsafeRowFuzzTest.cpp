@@ -172,6 +172,20 @@ TEST_F(UnsafeRowFuzzTests, fast) {
 
       serialized.push_back(std::string_view(buffers_[i], rowSize));
     }
+
+    // Serializing all rows at once produces the same bytes.
+    std::vector<int32_t> rowSizes(data->size());
+    fast.rowSizes(0, data->size(), rowSizes.data());
+    std::vector<std::string> batch(data->size());
+    std::vector<char*> rows(data->size());
+    for (auto i = 0; i < data->size(); ++i) {
+      batch[i].resize(rowSizes[i]);
+      rows[i] = batch[i].data();
+    }
+    fast.serialize(0, data->size(), rows.data());
+    for (auto i = 0; i < data->size(); ++i) {
+      EXPECT_EQ(batch[i], serialized[i].value()) << i;
+    }
     return serialized;
   });
 }
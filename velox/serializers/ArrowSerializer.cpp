@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/serializers/ArrowSerializer.h"
+#include <folly/ScopeGuard.h>
+#include <deque>
+#include "velox/vector/arrow/Abi.h"
+#include "velox/vector/arrow/Bridge.h"
+
+namespace facebook::velox::serializer {
+
+namespace {
+// Buffers in the body of a page start at multiples of this many bytes.
+constexpr int64_t kBufferAlignment = 8;
+
+// Upper bound of the bytes of a field node and of the padding of its buffers
+// in a page: length, null count, number of buffers, 3 buffer sizes, number of
+// children and 3 paddings.
+constexpr int64_t kMaxFieldNodeOverhead =
+    8 + 8 + 4 + 3 * 8 + 4 + 3 * (kBufferAlignment - 1);
+
+template <typename T>
+void writeValue(OutputStream* out, T value) {
+  out->write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void checkSupported(const Type& type) {
+  VELOX_USER_CHECK(
+      type.kind() != TypeKind::TIMESTAMP && !type.isShortDecimal() &&
+          type.kind() != TypeKind::UNKNOWN,
+      "Arrow serde does not support {}",
+      type.toString());
+  for (auto i = 0; i < type.size(); ++i) {
+    checkSupported(*type.childAt(i));
+  }
+}
+
+int64_t numFieldNodes(const Type& type) {
+  // A map has a struct child of keys and values.
+  int64_t count = type.isMap() ? 2 : 1;
+  for (auto i = 0; i < type.size(); ++i) {
+    count += numFieldNodes(*type.childAt(i));
+  }
+  return count;
+}
+
+// Returns the type of the child 'i' of an Arrow array of 'type'.
+TypePtr childType(const TypePtr& type, int32_t i) {
+  if (type->isMap()) {
+    return ROW({"key", "value"}, {type->childAt(0), type->childAt(1)});
+  }
+  return type->childAt(i);
+}
+
+// Returns the size in bytes of buffer 'i' of 'array' of 'type'.
+int64_t bufferSize(const Type& type, const ArrowArray& array, int32_t i) {
+  if (array.buffers[i] == nullptr) {
+    return 0;
+  }
+  const auto length = array.length;
+  if (i == 0 || type.isBoolean()) {
+    return bits::nbytes(length);
+  }
+  switch (type.kind()) {
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      if (i == 2) {
+        return static_cast<const int32_t*>(array.buffers[1])[length];
+      }
+      [[fallthrough]];
+    case TypeKind::ARRAY:
+    case TypeKind::MAP:
+      return (length + 1) * sizeof(int32_t);
+    default:
+      return length * type.cppSizeInBytes();
+  }
+}
+
+void writeFieldNodes(
+    const TypePtr& type,
+    const ArrowArray& array,
+    OutputStream* out,
+    int64_t& bodySize) {
+  VELOX_CHECK_EQ(array.offset, 0);
+  VELOX_CHECK_NULL(array.dictionary);
+  writeValue<int64_t>(out, array.length);
+  // A null count of -1 means unknown and requires a validity buffer, which is
+  // empty and not sent if there are no rows.
+  writeValue<int64_t>(
+      out, bufferSize(*type, array, 0) == 0 ? 0 : array.null_count);
+  writeValue<int32_t>(out, array.n_buffers);
+  for (auto i = 0; i < array.n_buffers; ++i) {
+    const auto size = bufferSize(*type, array, i);
+    writeValue<int64_t>(out, size);
+    bodySize += bits::roundUp(size, kBufferAlignment);
+  }
+  writeValue<int32_t>(out, array.n_children);
+  for (auto i = 0; i < array.n_children; ++i) {
+    writeFieldNodes(childType(type, i), *array.children[i], out, bodySize);
+  }
+}
+
+void writeBuffers(
+    const TypePtr& type,
+    const ArrowArray& array,
+    OutputStream* out) {
+  static const char kPadding[kBufferAlignment] = {};
+  for (auto i = 0; i < array.n_buffers; ++i) {
+    const auto size = bufferSize(*type, array, i);
+    out->write(static_cast<const char*>(array.buffers[i]), size);
+    out->write(kPadding, bits::roundUp(size, kBufferAlignment) - size);
+  }
+  for (auto i = 0; i < array.n_children; ++i) {
+    writeBuffers(childType(type, i), *array.children[i], out);
+  }
+}
+
+class ArrowVectorSerializer : public VectorSerializer {
+ public:
+  ArrowVectorSerializer(RowTypePtr type, memory::MemoryPool* pool)
+      : type_(std::move(type)), pool_(pool) {}
+
+  void append(
+      const RowVectorPtr& vector,
+      const folly::Range<const IndexRange*>& ranges) override {
+    if (!rows_) {
+      rows_ = BaseVector::create<RowVector>(type_, 0, pool_);
+    }
+    // Copies the rows into flat vectors. The bridge then exports the flat
+    // vectors without copying, except for strings.
+    std::vector<BaseVector::CopyRange> copyRanges;
+    copyRanges.reserve(ranges.size());
+    auto numRows = rows_->size();
+    for (const auto& range : ranges) {
+      copyRanges.push_back({range.begin, numRows, range.size});
+      numRows += range.size;
+    }
+    vector->loadedVector();
+    rows_->resize(numRows);
+    rows_->copyRanges(vector.get(), copyRanges);
+  }
+
+  size_t maxSerializedSize() const override {
+    const auto overhead =
+        sizeof(int64_t) + numFieldNodes(*type_) * kMaxFieldNodeOverhead;
+    return overhead + (rows_ ? rows_->estimateFlatSize() : 0);
+  }
+
+  void flush(OutputStream* out) override {
+    if (!rows_) {
+      rows_ = BaseVector::create<RowVector>(type_, 0, pool_);
+    }
+    ArrowArray array;
+    exportToArrow(rows_, array, pool_);
+    SCOPE_EXIT {
+      array.release(&array);
+    };
+
+    // The field nodes go before the body but the body size is known only
+    // after going over the field nodes.
+    const auto offset = out->tellp();
+    writeValue<int64_t>(out, 0);
+    int64_t bodySize = 0;
+    writeFieldNodes(type_, array, out, bodySize);
+    const auto end = out->tellp();
+    out->seekp(offset);
+    writeValue<int64_t>(out, bodySize);
+    out->seekp(end);
+    writeBuffers(type_, array, out);
+  }
+
+ private:
+  const RowTypePtr type_;
+  memory::MemoryPool* const pool_;
+  RowVectorPtr rows_;
+};
+
+// Owns the body of a deserialized page and the ArrowArrays of its field
+// nodes, which point to the buffers in the body. Is the private data of the
+// top level ArrowArray.
+struct ImportedPage {
+  BufferPtr body;
+  std::deque<ArrowArray> children;
+  std::deque<std::vector<const void*>> buffers;
+  std::deque<std::vector<ArrowArray*>> childPointers;
+};
+
+void releaseChild(ArrowArray* array) {
+  array->release = nullptr;
+}
+
+void releasePage(ArrowArray* array) {
+  delete static_cast<ImportedPage*>(array->private_data);
+  array->private_data = nullptr;
+  array->release = nullptr;
+}
+
+// Reads the field node of 'array' and its children from 'source'. Points the
+// buffers of the field nodes to consecutive positions of 'page.body',
+// starting at 'bodyOffset'.
+void readFieldNodes(
+    ByteStream* source,
+    ImportedPage& page,
+    ArrowArray& array,
+    int64_t& bodyOffset) {
+  auto* body = page.body->asMutable<char>();
+  array.length = source->read<int64_t>();
+  array.null_count = source->read<int64_t>();
+  array.offset = 0;
+  array.n_buffers = source->read<int32_t>();
+  auto& buffers = page.buffers.emplace_back(array.n_buffers);
+  for (auto i = 0; i < array.n_buffers; ++i) {
+    const auto size = source->read<int64_t>();
+    // No validity buffer means no nulls. Other buffers are set even if
+    // empty.
+    buffers[i] = i == 0 && size == 0 ? nullptr : body + bodyOffset;
+    bodyOffset += bits::roundUp(size, kBufferAlignment);
+    VELOX_CHECK_LE(bodyOffset, page.body->size(), "Corrupt Arrow page");
+  }
+  array.buffers = buffers.data();
+  array.n_children = source->read<int32_t>();
+  auto& children = page.childPointers.emplace_back(array.n_children);
+  for (auto i = 0; i < array.n_children; ++i) {
+    auto& child = page.children.emplace_back();
+    child.private_data = nullptr;
+    child.release = releaseChild;
+    child.dictionary = nullptr;
+    children[i] = &child;
+    readFieldNodes(source, page, child, bodyOffset);
+  }
+  array.children = children.data();
+  array.dictionary = nullptr;
+}
+} // namespace
+
+void ArrowVectorSerde::estimateSerializedSize(
+    VectorPtr vector,
+    const folly::Range<const IndexRange*>& ranges,
+    vector_size_t** sizes) {
+  const auto bytesPerRow =
+      vector->size() == 0 ? 0 : vector->estimateFlatSize() / vector->size();
+  for (auto i = 0; i < ranges.size(); ++i) {
+    *sizes[i] += bytesPerRow * ranges[i].size;
+  }
+}
+
+std::unique_ptr<VectorSerializer> ArrowVectorSerde::createSerializer(
+    RowTypePtr type,
+    int32_t /* numRows */,
+    StreamArena* streamArena,
+    const Options* /* options */) {
+  checkSupported(*type);
+  return std::make_unique<ArrowVectorSerializer>(
+      std::move(type), streamArena->pool());
+}
+
+void ArrowVectorSerde::deserialize(
+    ByteStream* source,
+    velox::memory::MemoryPool* pool,
+    RowTypePtr type,
+    RowVectorPtr* result,
+    const Options* /* options */) {
+  const auto bodySize = source->read<int64_t>();
+  VELOX_CHECK_LE(bodySize, std::numeric_limits<int32_t>::max());
+
+  auto page = std::make_unique<ImportedPage>();
+  page->body = AlignedBuffer::allocate<char>(bodySize, pool);
+  ArrowArray array;
+  int64_t bodyOffset = 0;
+  readFieldNodes(source, *page, array, bodyOffset);
+  VELOX_CHECK_EQ(bodyOffset, bodySize, "Corrupt Arrow page");
+  source->readBytes(page->body->asMutable<uint8_t>(), bodySize);
+  array.private_data = page.release();
+  array.release = releasePage;
+
+  ArrowSchema schema;
+  exportToArrow(BaseVector::create(type, 0, pool), schema);
+  // The import takes ownership of 'schema' and 'array' if it succeeds.
+  SCOPE_EXIT {
+    if (array.release) {
+      array.release(&array);
+    }
+    if (schema.release) {
+      schema.release(&schema);
+    }
+  };
+  auto vector = importFromArrowAsOwner(schema, array, pool);
+  *result = std::dynamic_pointer_cast<RowVector>(vector);
+  VELOX_CHECK_NOT_NULL(*result);
+  VELOX_CHECK_EQ((*result)->childrenSize(), type->size());
+}
+
+// static
+void ArrowVectorSerde::registerVectorSerde() {
+  velox::registerVectorSerde(std::make_unique<ArrowVectorSerde>());
+}
+
+// static
+void ArrowVectorSerde::registerNamedVectorSerde() {
+  velox::registerNamedVectorSerde(kName, std::make_unique<ArrowVectorSerde>());
+}
+
+} // namespace facebook::velox::serializer
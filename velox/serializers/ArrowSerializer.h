@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/VectorStream.h"
+
+namespace facebook::velox::serializer {
+
+/// Serializes vectors in the Arrow columnar format, using the Arrow C data
+/// interface bridge in velox/vector/arrow/Bridge.h. A page is laid out like
+/// the body of an Arrow IPC record batch:
+///
+///   int64 body size in bytes
+///   the field nodes of the columns in pre-order, each with length, null
+///   count, the sizes of its buffers and its number of children
+///   body: the buffers of all field nodes in the same order, each padded to
+///   a multiple of 8 bytes
+///
+/// The columns are not encoded: dictionary, constant and lazy columns are
+/// serialized flat. The deserializer copies the body of a page into one
+/// buffer and wraps its buffers in vectors without copying them further,
+/// except for string offsets, which are converted to StringViews.
+///
+/// Supports the types supported by the bridge: booleans, integers, floating
+/// point numbers, dates, long decimals, strings, and arrays, maps and rows of
+/// these. Timestamps and short decimals are not supported.
+class ArrowVectorSerde : public VectorSerde {
+ public:
+  /// Name under which registerNamedVectorSerde() registers the serde.
+  static constexpr const char* kName = "arrow";
+
+  ArrowVectorSerde() = default;
+
+  /// Estimates the size of each row as the average flat size of the rows of
+  /// 'vector'.
+  void estimateSerializedSize(
+      VectorPtr vector,
+      const folly::Range<const IndexRange*>& ranges,
+      vector_size_t** sizes) override;
+
+  std::unique_ptr<VectorSerializer> createSerializer(
+      RowTypePtr type,
+      int32_t numRows,
+      StreamArena* streamArena,
+      const Options* options) override;
+
+  void deserialize(
+      ByteStream* source,
+      velox::memory::MemoryPool* pool,
+      RowTypePtr type,
+      RowVectorPtr* result,
+      const Options* options) override;
+
+  /// Registers the serde as the default serde.
+  static void registerVectorSerde();
+
+  /// Registers the serde as a named serde called kName.
+  static void registerNamedVectorSerde();
+};
+
+} // namespace facebook::velox::serializer
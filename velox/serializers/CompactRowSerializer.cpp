@@ -37,20 +37,29 @@ class CompactRowVectorSerializer : public VectorSerializer {
   void append(
       const RowVectorPtr& vector,
       const folly::Range<const IndexRange*>& ranges) override {
-    size_t totalSize = 0;
     row::CompactRow row(vector);
-    if (auto fixedRowSize =
-            row::CompactRow::fixedRowSize(asRowType(vector->type()))) {
-      for (const auto& range : ranges) {
-        totalSize += (fixedRowSize.value() + sizeof(TRowSize)) * range.size;
-      }
+    const auto fixedRowSize =
+        row::CompactRow::fixedRowSize(asRowType(vector->type()));
+    vector_size_t numRows = 0;
+    for (const auto& range : ranges) {
+      numRows += range.size;
+    }
 
-    } else {
-      for (const auto& range : ranges) {
-        for (auto i = range.begin; i < range.begin + range.size; ++i) {
-          totalSize += row.rowSize(i) + sizeof(TRowSize);
-        }
+    // Computes the sizes of all rows, one column at a time.
+    std::vector<int32_t> rowSizes(numRows);
+    auto* rawRowSizes = rowSizes.data();
+    for (const auto& range : ranges) {
+      if (fixedRowSize) {
+        std::fill(rawRowSizes, rawRowSizes + range.size, fixedRowSize.value());
+      } else {
+        row.rowSizes(range.begin, range.size, rawRowSizes);
       }
+      rawRowSizes += range.size;
+    }
+
+    size_t totalSize = 0;
+    for (auto size : rowSizes) {
+      totalSize += size + sizeof(TRowSize);
     }
 
     if (totalSize == 0) {
@@ -61,16 +70,21 @@ class CompactRowVectorSerializer : public VectorSerializer {
     auto rawBuffer = buffer->asMutable<char>();
     buffers_.push_back(std::move(buffer));
 
+    std::vector<char*> rows(numRows);
     size_t offset = 0;
-    for (auto& range : ranges) {
-      for (auto i = range.begin; i < range.begin + range.size; ++i) {
-        // Write row data.
-        TRowSize size = row.serialize(i, rawBuffer + offset + sizeof(TRowSize));
-
-        // Write raw size. Needs to be in big endian order.
-        *(TRowSize*)(rawBuffer + offset) = folly::Endian::big(size);
-        offset += sizeof(TRowSize) + size;
-      }
+    for (auto i = 0; i < numRows; ++i) {
+      // Write raw size. Needs to be in big endian order.
+      *(TRowSize*)(rawBuffer + offset) =
+          folly::Endian::big<TRowSize>(rowSizes[i]);
+      rows[i] = rawBuffer + offset + sizeof(TRowSize);
+      offset += sizeof(TRowSize) + rowSizes[i];
+    }
+
+    // Write row data.
+    auto* rawRows = rows.data();
+    for (const auto& range : ranges) {
+      row.serialize(range.begin, range.size, rawRows);
+      rawRows += range.size;
     }
   }
 
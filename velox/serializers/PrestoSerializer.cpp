@@ -16,6 +16,7 @@
 #include "velox/serializers/PrestoSerializer.h"
 #include "velox/common/base/Crc.h"
 #include "velox/common/memory/ByteStream.h"
+#include "velox/common/time/Timer.h"
 #include "velox/functions/prestosql/types/TimestampWithTimeZoneType.h"
 #include "velox/vector/BiasVector.h"
 #include "velox/vector/ComplexVector.h"
@@ -28,6 +29,7 @@ constexpr int8_t kCompressedBitMask = 1;
 constexpr int8_t kEncryptedBitMask = 2;
 constexpr int8_t kCheckSumBitMask = 4;
 constexpr folly::StringPiece kRLE{"RLE"};
+constexpr folly::StringPiece kDictionary{"DICTIONARY"};
 
 int64_t computeChecksum(
     PrestoOutputStreamListener* listener,
@@ -427,6 +429,25 @@ void readConstantVector(
   *result = BaseVector::wrapInConstant(size, 0, children[0]);
 }
 
+void readDictionaryVector(
+    ByteStream* source,
+    const TypePtr& type,
+    velox::memory::MemoryPool* pool,
+    VectorPtr* result,
+    bool useLosslessTimestamp) {
+  const auto size = source->read<int32_t>();
+  std::vector<TypePtr> childTypes = {type};
+  std::vector<VectorPtr> children(1);
+  readColumns(source, pool, childTypes, &children, useLosslessTimestamp);
+
+  auto indices = allocateIndices(size, pool);
+  source->readBytes(
+      indices->asMutable<uint8_t>(), size * sizeof(vector_size_t));
+  // Skip the dictionary instance id.
+  source->skip(3 * sizeof(int64_t));
+  *result = BaseVector::wrapInDictionary(nullptr, indices, size, children[0]);
+}
+
 void readArrayVector(
     ByteStream* source,
     std::shared_ptr<const Type> type,
@@ -698,8 +719,19 @@ void readColumns(
     if (encoding == kRLE) {
       readConstantVector(
           source, types[i], pool, &(*result)[i], useLosslessTimestamp);
+    } else if (encoding == kDictionary) {
+      readDictionaryVector(
+          source, types[i], pool, &(*result)[i], useLosslessTimestamp);
     } else {
       checkTypeEncoding(encoding, types[i]);
+      // A column of a previous page may have been read as a constant or a
+      // dictionary and cannot be reused for flat values.
+      auto& column = (*result)[i];
+      if (column &&
+          (column->isConstantEncoding() ||
+           column->encoding() == VectorEncoding::Simple::DICTIONARY)) {
+        column.reset();
+      }
       auto it = readers.find(types[i]->kind());
       VELOX_CHECK(
           it != readers.end(),
@@ -1599,6 +1631,178 @@ void estimateSerializedSizeInt(
   }
 }
 
+// Holds the rows of a top level column while they come from dictionaries
+// over the same base vector or from constants with the same value, so that
+// the column is serialized as a DICTIONARY or RLE block instead of one value
+// per row. The base values are serialized once. Used if
+// PrestoOptions::preserveEncodings is set.
+class EncodedColumn {
+ public:
+  EncodedColumn(
+      const TypePtr& type,
+      StreamArena* streamArena,
+      bool useLosslessTimestamp)
+      : type_(type),
+        streamArena_(streamArena),
+        useLosslessTimestamp_(useLosslessTimestamp) {}
+
+  // Adds the rows in 'ranges' of 'vector' to the encoded column. Returns false
+  // if they do not fit the encoding. The rows held so far are then appended
+  // to 'stream' and the caller appends the new rows to 'stream' too. The
+  // column stays flat until the end of the page.
+  bool append(
+      const VectorPtr& vector,
+      const folly::Range<const IndexRange*>& ranges,
+      VectorStream* stream) {
+    switch (kind_) {
+      case Kind::kNone:
+        if (start(vector, ranges)) {
+          return true;
+        }
+        kind_ = Kind::kFlat;
+        return false;
+      case Kind::kDictionary:
+        if (isDictionary(*vector) && vector->valueVector() == base_) {
+          addIndices(*vector, ranges);
+          return true;
+        }
+        break;
+      case Kind::kConstant:
+        if (vector->isConstantEncoding() &&
+            (vector == base_ || vector->equalValueAt(base_.get(), 0, 0))) {
+          numRows_ += rangesTotalSize(ranges);
+          return true;
+        }
+        break;
+      case Kind::kFlat:
+        return false;
+    }
+    flatten(stream);
+    return false;
+  }
+
+  // Appends the rows held so far to 'stream' and makes the column flat
+  // until the end of the page.
+  void flatten(VectorStream* stream) {
+    if (kind_ == Kind::kConstant) {
+      IndexRange range{0, numRows_};
+      serializeColumn(base_.get(), folly::Range(&range, 1), stream);
+    } else if (kind_ == Kind::kDictionary) {
+      std::vector<IndexRange> ranges;
+      for (auto index : indices_) {
+        if (!ranges.empty() &&
+            ranges.back().begin + ranges.back().size == index) {
+          ++ranges.back().size;
+        } else {
+          ranges.push_back({index, 1});
+        }
+      }
+      serializeColumn(base_.get(), ranges, stream);
+    }
+    kind_ = Kind::kFlat;
+    base_.reset();
+    values_.reset();
+    indices_.clear();
+  }
+
+  bool isEncoded() const {
+    return kind_ == Kind::kDictionary || kind_ == Kind::kConstant;
+  }
+
+  size_t serializedSize() {
+    CountingOutputStream out;
+    flush(&out);
+    return out.size();
+  }
+
+  // Writes the encoded column in wire format. Must be called only if
+  // isEncoded().
+  void flush(OutputStream* out) {
+    if (kind_ == Kind::kConstant) {
+      writeInt32(out, kRLE.size());
+      out->write(kRLE.data(), kRLE.size());
+      writeInt32(out, numRows_);
+      values_->flush(out);
+      return;
+    }
+    VELOX_CHECK(kind_ == Kind::kDictionary);
+    writeInt32(out, kDictionary.size());
+    out->write(kDictionary.data(), kDictionary.size());
+    writeInt32(out, indices_.size());
+    values_->flush(out);
+    out->write(
+        reinterpret_cast<const char*>(indices_.data()),
+        indices_.size() * sizeof(vector_size_t));
+    // Dictionary instance id. Presto uses it to tell if blocks share a
+    // dictionary. Not used by Velox.
+    for (auto i = 0; i < 3; ++i) {
+      writeInt64(out, 0);
+    }
+  }
+
+ private:
+  enum class Kind { kNone, kDictionary, kConstant, kFlat };
+
+  static bool isDictionary(const BaseVector& vector) {
+    return vector.encoding() == VectorEncoding::Simple::DICTIONARY &&
+        vector.rawNulls() == nullptr;
+  }
+
+  // Starts the column with the first rows of the page. Dictionaries are
+  // encoded if they have fewer base values than the rows that refer to them.
+  bool start(
+      const VectorPtr& vector,
+      const folly::Range<const IndexRange*>& ranges) {
+    if (vector->isConstantEncoding()) {
+      kind_ = Kind::kConstant;
+      base_ = vector;
+      numRows_ = rangesTotalSize(ranges);
+      values_ = std::make_unique<VectorStream>(
+          type_, streamArena_, 1, useLosslessTimestamp_);
+      IndexRange range{0, 1};
+      serializeColumn(base_.get(), folly::Range(&range, 1), values_.get());
+      return true;
+    }
+    if (isDictionary(*vector) &&
+        vector->valueVector()->size() < rangesTotalSize(ranges)) {
+      kind_ = Kind::kDictionary;
+      base_ = vector->valueVector();
+      values_ = std::make_unique<VectorStream>(
+          type_, streamArena_, base_->size(), useLosslessTimestamp_);
+      IndexRange range{0, base_->size()};
+      serializeColumn(base_.get(), folly::Range(&range, 1), values_.get());
+      addIndices(*vector, ranges);
+      return true;
+    }
+    return false;
+  }
+
+  void addIndices(
+      const BaseVector& vector,
+      const folly::Range<const IndexRange*>& ranges) {
+    const auto* indices = vector.wrapInfo()->as<vector_size_t>();
+    for (const auto& range : ranges) {
+      indices_.insert(
+          indices_.end(),
+          indices + range.begin,
+          indices + range.begin + range.size);
+    }
+  }
+
+  const TypePtr type_;
+  StreamArena* const streamArena_;
+  const bool useLosslessTimestamp_;
+  Kind kind_{Kind::kNone};
+  // The dictionary base vector or the constant vector.
+  VectorPtr base_;
+  // The serialized base values or constant value.
+  std::unique_ptr<VectorStream> values_;
+  // Indices into 'base_' if kDictionary.
+  std::vector<vector_size_t> indices_;
+  // Number of rows if kConstant.
+  vector_size_t numRows_{0};
+};
+
 class PrestoVectorSerializer : public VectorSerializer {
  public:
   PrestoVectorSerializer(
@@ -1606,9 +1810,17 @@ class PrestoVectorSerializer : public VectorSerializer {
       int32_t numRows,
       StreamArena* streamArena,
       bool useLosslessTimestamp,
-      common::CompressionKind compressionKind)
+      common::CompressionKind compressionKind,
+      bool preserveEncodings,
+      float minCompressionRatio,
+      PrestoVectorSerde::CompressionStats* compressionStats)
       : streamArena_(streamArena),
-        codec_(common::compressionKindToCodec(compressionKind)) {
+        codec_(common::compressionKindToCodec(compressionKind)),
+        minCompressionRatio_(minCompressionRatio),
+        compressionStats_(compressionStats) {
+    VELOX_CHECK(
+        minCompressionRatio_ == 0 || compressionStats_ != nullptr,
+        "Adaptive compression requires compression stats");
     auto types = rowType->children();
     auto numTypes = types.size();
     streams_.resize(numTypes);
@@ -1616,6 +1828,13 @@ class PrestoVectorSerializer : public VectorSerializer {
       streams_[i] = std::make_unique<VectorStream>(
           types[i], streamArena, numRows, useLosslessTimestamp);
     }
+    if (preserveEncodings) {
+      encodedColumns_.resize(numTypes);
+      for (int i = 0; i < numTypes; i++) {
+        encodedColumns_[i] = std::make_unique<EncodedColumn>(
+            types[i], streamArena, useLosslessTimestamp);
+      }
+    }
   }
 
   void append(
@@ -1625,6 +1844,12 @@ class PrestoVectorSerializer : public VectorSerializer {
     if (newRows > 0) {
       numRows_ += newRows;
       for (int32_t i = 0; i < vector->childrenSize(); ++i) {
+        if (!encodedColumns_.empty()) {
+          auto column = BaseVector::loadedVectorShared(vector->childAt(i));
+          if (encodedColumns_[i]->append(column, ranges, streams_[i].get())) {
+            continue;
+          }
+        }
         serializeColumn(vector->childAt(i).get(), ranges, streams_[i].get());
       }
     }
@@ -1632,8 +1857,12 @@ class PrestoVectorSerializer : public VectorSerializer {
 
   size_t maxSerializedSize() const override {
     size_t dataSize = 4; // streams_.size()
-    for (auto& stream : streams_) {
-      dataSize += stream->serializedSize();
+    for (auto i = 0; i < streams_.size(); ++i) {
+      if (isEncoded(i)) {
+        dataSize += encodedColumns_[i]->serializedSize();
+      } else {
+        dataSize += streams_[i]->serializedSize();
+      }
     }
 
     auto compressedSize = needCompression(*codec_)
@@ -1649,12 +1878,28 @@ class PrestoVectorSerializer : public VectorSerializer {
     flushInternal(numRows_, false /*rle*/, out);
   }
 
+  // Returns the stream of 'column' for appending rows directly. Moves the
+  // rows of an encoded column into the stream first.
+  VectorStream* streamAt(column_index_t column) {
+    if (!encodedColumns_.empty()) {
+      encodedColumns_[column]->flatten(streams_[column].get());
+    }
+    return streams_[column].get();
+  }
+
+  // Adds 'numRows' rows appended directly to the streams.
+  void addRows(int32_t numRows) {
+    numRows_ += numRows;
+  }
+
   void flushRle(const RowVectorPtr& vector, OutputStream* out) {
     VELOX_CHECK_EQ(0, numRows_);
     for (auto& child : vector->children()) {
       VELOX_CHECK(child->isConstantEncoding());
     }
 
+    // The page is RLE as a whole, so the columns are not encoded separately.
+    encodedColumns_.clear();
     std::vector<IndexRange> ranges{{0, 1}};
     append(vector, folly::Range(ranges.data(), ranges.size()));
 
@@ -1701,9 +1946,7 @@ class PrestoVectorSerializer : public VectorSerializer {
       writeInt32(out, numRows);
     }
 
-    for (auto& stream : streams_) {
-      stream->flush(out);
-    }
+    flushColumns(out);
 
     // Pause CRC computation
     if (listener) {
@@ -1730,20 +1973,6 @@ class PrestoVectorSerializer : public VectorSerializer {
       bool rle,
       OutputStream* output,
       PrestoOutputStreamListener* listener) {
-    const int32_t offset = output->tellp();
-    char codec = kCompressedBitMask;
-    if (listener) {
-      codec |= kCheckSumBitMask;
-    }
-
-    // Pause CRC computation
-    if (listener) {
-      listener->pause();
-    }
-
-    writeInt32(output, numRows);
-    output->write(&codec, 1);
-
     IOBufOutputStream out(
         *(streamArena_->pool()), nullptr, streamArena_->size());
     writeInt32(&out, streams_.size());
@@ -1755,16 +1984,50 @@ class PrestoVectorSerializer : public VectorSerializer {
       writeInt32(&out, numRows);
     }
 
-    for (auto& stream : streams_) {
-      stream->flush(&out);
-    }
+    flushColumns(&out);
     const int32_t uncompressedSize = out.tellp();
     VELOX_CHECK_LE(
         uncompressedSize,
         codec_->maxUncompressedLength(),
         "UncompressedSize exceeds limit");
-    auto compressed = codec_->compress(out.getIOBuf().get());
-    const int32_t compressedSize = compressed->length();
+    std::unique_ptr<folly::IOBuf> compressed;
+    uint64_t compressionTimeUs{0};
+    {
+      MicrosecondTimer timer(&compressionTimeUs);
+      compressed = codec_->compress(out.getIOBuf().get());
+    }
+    int32_t compressedSize = compressed->computeChainDataLength();
+    if (compressionStats_) {
+      compressionStats_->compressionInputBytes += uncompressedSize;
+      compressionStats_->compressedBytes += compressedSize;
+      compressionStats_->compressionTimeUs += compressionTimeUs;
+    }
+    char codec = kCompressedBitMask;
+    if (minCompressionRatio_ > 0) {
+      const bool compressible =
+          uncompressedSize >= compressedSize * minCompressionRatio_;
+      compressionStats_->recordPage(compressible);
+      if (!compressible) {
+        // The columns are already flushed to 'out', which becomes the payload
+        // of an uncompressed page.
+        compressed = out.getIOBuf();
+        compressedSize = uncompressedSize;
+        codec = 0;
+      }
+    }
+
+    const int32_t offset = output->tellp();
+    if (listener) {
+      codec |= kCheckSumBitMask;
+    }
+
+    // Pause CRC computation
+    if (listener) {
+      listener->pause();
+    }
+
+    writeInt32(output, numRows);
+    output->write(&codec, 1);
     writeInt32(output, uncompressedSize);
     writeInt32(output, compressedSize);
     const int32_t crcOffset = output->tellp();
@@ -1773,9 +2036,9 @@ class PrestoVectorSerializer : public VectorSerializer {
     if (listener) {
       listener->resume();
     }
-    output->write(
-        reinterpret_cast<const char*>(compressed->writableData()),
-        compressed->length());
+    for (const auto& range : *compressed) {
+      output->write(reinterpret_cast<const char*>(range.data()), range.size());
+    }
     // Pause CRC computation
     if (listener) {
       listener->pause();
@@ -1799,21 +2062,97 @@ class PrestoVectorSerializer : public VectorSerializer {
       listener->reset();
     }
 
-    if (!needCompression(*codec_)) {
+    if (!needCompression(*codec_) ||
+        (minCompressionRatio_ > 0 && compressionStats_->skipCompression())) {
       flushUncompressed(numRows, rle, out, listener);
     } else {
       flushCompressed(numRows, rle, out, listener);
     }
   }
 
+  bool isEncoded(column_index_t column) const {
+    return !encodedColumns_.empty() && encodedColumns_[column]->isEncoded();
+  }
+
+  void flushColumns(OutputStream* out) {
+    for (auto i = 0; i < streams_.size(); ++i) {
+      if (isEncoded(i)) {
+        encodedColumns_[i]->flush(out);
+      } else {
+        streams_[i]->flush(out);
+      }
+    }
+  }
+
   static const int32_t kSizeInBytesOffset{4 + 1};
   static const int32_t kHeaderSize{kSizeInBytesOffset + 4 + 4 + 8};
 
   StreamArena* const streamArena_;
   const std::unique_ptr<folly::io::Codec> codec_;
+  const float minCompressionRatio_;
+  PrestoVectorSerde::CompressionStats* const compressionStats_;
   int32_t numRows_{0};
   std::vector<std::unique_ptr<VectorStream>> streams_;
+  // Dictionary and constant columns kept encoded. Empty unless
+  // PrestoOptions::preserveEncodings is set.
+  std::vector<std::unique_ptr<EncodedColumn>> encodedColumns_;
 };
+
+// Appends each row 'i' of the flat 'vector' to 'streams[partitions[i]]'.
+template <TypeKind kind>
+void scatterFlatVector(
+    const BaseVector* vector,
+    folly::Range<const uint32_t*> partitions,
+    const std::vector<VectorStream*>& streams) {
+  using T = typename TypeTraits<kind>::NativeType;
+  const auto* rawValues = vector->asUnchecked<FlatVector<T>>()->rawValues();
+  if (!vector->mayHaveNulls()) {
+    for (auto row = 0; row < partitions.size(); ++row) {
+      auto* stream = streams[partitions[row]];
+      stream->appendNonNull();
+      stream->appendOne(rawValues[row]);
+    }
+    return;
+  }
+  const auto* rawNulls = vector->rawNulls();
+  for (auto row = 0; row < partitions.size(); ++row) {
+    auto* stream = streams[partitions[row]];
+    if (bits::isBitNull(rawNulls, row)) {
+      stream->appendNull();
+    } else {
+      stream->appendNonNull();
+      stream->appendOne(rawValues[row]);
+    }
+  }
+}
+
+// Scatters 'vector' to 'streams' if it is a flat vector of a type that is
+// serialized one value at a time. Returns false otherwise.
+bool scatterColumn(
+    const BaseVector* vector,
+    folly::Range<const uint32_t*> partitions,
+    const std::vector<VectorStream*>& streams) {
+  if (vector->encoding() != VectorEncoding::Simple::FLAT) {
+    return false;
+  }
+  switch (vector->typeKind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::HUGEINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::TIMESTAMP:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+          scatterFlatVector, vector->typeKind(), vector, partitions, streams);
+      return true;
+    default:
+      return false;
+  }
+}
 } // namespace
 
 void PrestoVectorSerde::estimateSerializedSize(
@@ -1834,7 +2173,56 @@ std::unique_ptr<VectorSerializer> PrestoVectorSerde::createSerializer(
       numRows,
       streamArena,
       prestoOptions.useLosslessTimestamp,
-      prestoOptions.compressionKind);
+      prestoOptions.compressionKind,
+      prestoOptions.preserveEncodings,
+      prestoOptions.minCompressionRatio,
+      prestoOptions.compressionStats);
+}
+
+void PrestoVectorSerde::appendScattered(
+    const RowVectorPtr& vector,
+    folly::Range<const uint32_t*> partitions,
+    folly::Range<VectorSerializer* const*> serializers) {
+  VELOX_CHECK_EQ(partitions.size(), vector->size());
+  const auto numSerializers = serializers.size();
+  // Ranges of consecutive rows for each serializer, for the columns that are
+  // not scattered.
+  std::vector<std::vector<IndexRange>> ranges(numSerializers);
+  for (vector_size_t row = 0; row < partitions.size(); ++row) {
+    auto& serializerRanges = ranges[partitions[row]];
+    if (!serializerRanges.empty() &&
+        serializerRanges.back().begin + serializerRanges.back().size == row) {
+      ++serializerRanges.back().size;
+    } else {
+      serializerRanges.push_back({row, 1});
+    }
+  }
+
+  std::vector<PrestoVectorSerializer*> prestoSerializers(numSerializers);
+  for (auto i = 0; i < numSerializers; ++i) {
+    prestoSerializers[i] = static_cast<PrestoVectorSerializer*>(serializers[i]);
+    prestoSerializers[i]->addRows(rangesTotalSize(
+        folly::Range(ranges[i].data(), ranges[i].size())));
+  }
+
+  std::vector<VectorStream*> streams(numSerializers);
+  for (auto column = 0; column < vector->childrenSize(); ++column) {
+    for (auto i = 0; i < numSerializers; ++i) {
+      streams[i] = prestoSerializers[i]->streamAt(column);
+    }
+    const auto* columnVector = vector->childAt(column)->loadedVector();
+    if (scatterColumn(columnVector, partitions, streams)) {
+      continue;
+    }
+    for (auto i = 0; i < numSerializers; ++i) {
+      if (!ranges[i].empty()) {
+        serializeColumn(
+            columnVector,
+            folly::Range(ranges[i].data(), ranges[i].size()),
+            streams[i]);
+      }
+    }
+  }
 }
 
 void PrestoVectorSerde::serializeConstants(
@@ -1879,23 +2267,33 @@ void PrestoVectorSerde::deserialize(
   VELOX_CHECK_EQ(
       checksum, actualCheckSum, "Received corrupted serialized page.");
 
-  VELOX_CHECK_EQ(
-      needCompression(*codec),
-      isCompressedBitSet(pageCodecMarker),
+  // Pages may be sent uncompressed whatever the codec, e.g. when they do not
+  // compress well enough, but compressed pages need the codec.
+  VELOX_CHECK(
+      !isCompressedBitSet(pageCodecMarker) || needCompression(*codec),
       "Compression kind {} should align with codec marker.",
       common::compressionKindToString(
           common::codecTypeToCompressionKind(codec->type())));
 
   auto children = &(*result)->children();
   auto childTypes = type->as<TypeKind::ROW>().children();
-  if (!needCompression(*codec)) {
+  if (!isCompressedBitSet(pageCodecMarker)) {
     auto numColumns = source->read<int32_t>();
     readColumns(source, pool, childTypes, children, useLosslessTimestamp);
   } else {
     auto compressBuf = folly::IOBuf::create(compressedSize);
     source->readBytes(compressBuf->writableData(), compressedSize);
     compressBuf->append(compressedSize);
-    auto uncompress = codec->uncompress(compressBuf.get(), uncompressedSize);
+    std::unique_ptr<folly::IOBuf> uncompress;
+    uint64_t decompressionTimeUs{0};
+    {
+      MicrosecondTimer timer(&decompressionTimeUs);
+      uncompress = codec->uncompress(compressBuf.get(), uncompressedSize);
+    }
+    if (prestoOptions.compressionStats) {
+      prestoOptions.compressionStats->decompressionTimeUs +=
+          decompressionTimeUs;
+    }
     ByteRange byteRange{
         uncompress->writableData(), (int32_t)uncompress->length(), 0};
     ByteStream uncompressedSource;
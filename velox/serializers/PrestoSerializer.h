@@ -21,6 +21,56 @@
 namespace facebook::velox::serializer::presto {
 class PrestoVectorSerde : public VectorSerde {
  public:
+  // Compression counters of a stream of pages, e.g. the pages of one
+  // PartitionedOutput or the pages read by one Exchange, and the state of
+  // adaptive compression. Updated by the serializers and deserializations
+  // given it in PrestoOptions. Not thread safe.
+  struct CompressionStats {
+    // After this many pages in a row that do not compress well enough,
+    // kNumSkippedPages pages are sent uncompressed without trying to
+    // compress them.
+    static constexpr int32_t kMaxIncompressiblePages = 4;
+    static constexpr int32_t kNumSkippedPages = 32;
+
+    // Returns true if the next page is to be sent uncompressed without trying
+    // to compress it.
+    bool skipCompression() {
+      if (numPagesToSkip == 0) {
+        return false;
+      }
+      --numPagesToSkip;
+      ++numSkippedPages;
+      return true;
+    }
+
+    // Records a page that was compressed, which is sent uncompressed if not
+    // 'compressible'.
+    void recordPage(bool compressible) {
+      if (compressible) {
+        numIncompressiblePages = 0;
+        return;
+      }
+      ++numUncompressedPages;
+      if (++numIncompressiblePages >= kMaxIncompressiblePages) {
+        numIncompressiblePages = 0;
+        numPagesToSkip = kNumSkippedPages;
+      }
+    }
+
+    // Bytes before and after compression of the pages that were compressed,
+    // including the ones then sent uncompressed.
+    int64_t compressionInputBytes{0};
+    int64_t compressedBytes{0};
+    uint64_t compressionTimeUs{0};
+    uint64_t decompressionTimeUs{0};
+    // Pages sent uncompressed because they did not compress well enough.
+    int64_t numUncompressedPages{0};
+    // Pages sent uncompressed without trying to compress them.
+    int64_t numSkippedPages{0};
+    int32_t numIncompressiblePages{0};
+    int32_t numPagesToSkip{0};
+  };
+
   // Input options that the serializer recognizes.
   struct PrestoOptions : VectorSerde::Options {
     PrestoOptions() = default;
@@ -38,6 +88,25 @@ class PrestoVectorSerde : public VectorSerde {
     bool useLosslessTimestamp{false};
     common::CompressionKind compressionKind{
         common::CompressionKind::CompressionKind_NONE};
+
+    // Serializes top level dictionary columns as DICTIONARY blocks of the
+    // base values and indices and constant columns as RLE blocks, as long as
+    // all rows of the column in a page come from the same dictionary base or
+    // constant value. Otherwise the column is serialized flat. Dictionaries
+    // with nulls added by the wrapper are serialized flat too. The
+    // deserializer returns these columns as dictionary and constant vectors.
+    // Is false by default.
+    bool preserveEncodings{false};
+
+    // If not 0, pages whose uncompressed size is less than this many times
+    // their compressed size are sent uncompressed and compression is skipped
+    // for a while after several such pages. See CompressionStats. Requires
+    // 'compressionStats'.
+    float minCompressionRatio{0};
+
+    // If set, the serializers and deserializations add their compression
+    // counters to it.
+    CompressionStats* compressionStats{nullptr};
   };
 
   void estimateSerializedSize(
@@ -51,6 +120,14 @@ class PrestoVectorSerde : public VectorSerde {
       StreamArena* streamArena,
       const Options* options) override;
 
+  /// Serializes one column at a time into all of 'serializers'. Flat columns
+  /// of scalar types other than boolean are scattered row by row in a single
+  /// pass. Other columns are appended to each serializer separately.
+  void appendScattered(
+      const RowVectorPtr& vector,
+      folly::Range<const uint32_t*> partitions,
+      folly::Range<VectorSerializer* const*> serializers) override;
+
   /// Serializes a RowVector with a constant children.
   void serializeConstants(
       const RowVectorPtr& vector,
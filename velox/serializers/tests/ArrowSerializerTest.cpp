@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/serializers/ArrowSerializer.h"
+#include <gtest/gtest.h>
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+namespace facebook::velox::serializer {
+namespace {
+
+class ArrowSerializerTest : public ::testing::Test,
+                            public test::VectorTestBase {
+ protected:
+  void SetUp() override {
+    serde_ = std::make_unique<ArrowVectorSerde>();
+  }
+
+  // Serializes 'ranges' of 'rowVector' as one page appended to 'output'.
+  void serialize(
+      const RowVectorPtr& rowVector,
+      const std::vector<IndexRange>& ranges,
+      std::ostream* output) {
+    auto arena = std::make_unique<StreamArena>(pool());
+    auto serializer = serde_->createSerializer(
+        asRowType(rowVector->type()), rowVector->size(), arena.get());
+    serializer->append(rowVector, folly::Range(ranges.data(), ranges.size()));
+    OStreamOutputStream out(output);
+    serializer->flush(&out);
+  }
+
+  void serialize(const RowVectorPtr& rowVector, std::ostream* output) {
+    serialize(rowVector, {IndexRange{0, rowVector->size()}}, output);
+  }
+
+  std::unique_ptr<ByteStream> toByteStream(const std::string& input) {
+    auto byteStream = std::make_unique<ByteStream>();
+    ByteRange byteRange{
+        reinterpret_cast<uint8_t*>(const_cast<char*>(input.data())),
+        (int32_t)input.length(),
+        0};
+    byteStream->resetInput({byteRange});
+    return byteStream;
+  }
+
+  RowVectorPtr deserialize(ByteStream* input, const RowTypePtr& rowType) {
+    RowVectorPtr result;
+    serde_->deserialize(input, pool(), rowType, &result);
+    return result;
+  }
+
+  void testRoundTrip(const RowVectorPtr& rowVector) {
+    std::ostringstream output;
+    serialize(rowVector, &output);
+    auto input = toByteStream(output.str());
+    auto result = deserialize(input.get(), asRowType(rowVector->type()));
+    EXPECT_TRUE(input->atEnd());
+    test::assertEqualVectors(rowVector, result);
+  }
+
+  std::unique_ptr<VectorSerde> serde_;
+};
+
+TEST_F(ArrowSerializerTest, fuzz) {
+  auto rowType = ROW({
+      BOOLEAN(),
+      TINYINT(),
+      SMALLINT(),
+      INTEGER(),
+      BIGINT(),
+      REAL(),
+      DOUBLE(),
+      VARCHAR(),
+      VARBINARY(),
+      DATE(),
+      DECIMAL(20, 3),
+      ROW({VARCHAR(), INTEGER()}),
+      ARRAY(INTEGER()),
+      MAP(VARCHAR(), INTEGER()),
+      MAP(VARCHAR(), ARRAY(VARCHAR())),
+  });
+
+  VectorFuzzer::Options opts;
+  opts.vectorSize = 100;
+  opts.nullRatio = 0.1;
+  opts.stringVariableLength = true;
+  opts.stringLength = 20;
+  opts.containerLength = 5;
+  VectorFuzzer fuzzer(opts, pool());
+
+  for (auto i = 0; i < 10; ++i) {
+    testRoundTrip(fuzzer.fuzzInputRow(rowType));
+  }
+}
+
+TEST_F(ArrowSerializerTest, encodings) {
+  auto data = makeRowVector({
+      BaseVector::createConstant(
+          VARCHAR(), "a constant longer than inline", 10, pool()),
+      wrapInDictionary(
+          makeIndicesInReverse(10),
+          makeArrayVector<int64_t>(
+              10,
+              [](auto row) { return row % 3; },
+              [](auto row) { return row; })),
+      makeFlatVector<int32_t>(10, [](auto row) { return row; }, nullEvery(3)),
+  });
+  testRoundTrip(data);
+}
+
+TEST_F(ArrowSerializerTest, ranges) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(100, [](auto row) { return row; }),
+      makeFlatVector<std::string>(
+          100, [](auto row) { return std::string(row % 20, 'x'); }),
+  });
+
+  std::ostringstream output;
+  std::vector<IndexRange> ranges = {{3, 10}, {50, 1}, {90, 10}};
+  serialize(data, ranges, &output);
+  // An empty page.
+  serialize(data, {}, &output);
+  serialize(data, &output);
+
+  auto input = toByteStream(output.str());
+  auto result = deserialize(input.get(), asRowType(data->type()));
+  auto expected = BaseVector::create<RowVector>(data->type(), 21, pool());
+  std::vector<BaseVector::CopyRange> copyRanges = {
+      {3, 0, 10}, {50, 10, 1}, {90, 11, 10}};
+  expected->copyRanges(data.get(), copyRanges);
+  test::assertEqualVectors(expected, result);
+
+  result = deserialize(input.get(), asRowType(data->type()));
+  EXPECT_EQ(result->size(), 0);
+
+  result = deserialize(input.get(), asRowType(data->type()));
+  test::assertEqualVectors(data, result);
+  EXPECT_TRUE(input->atEnd());
+}
+
+TEST_F(ArrowSerializerTest, unsupportedType) {
+  auto arena = std::make_unique<StreamArena>(pool());
+  VELOX_ASSERT_THROW(
+      serde_->createSerializer(ROW({"a"}, {TIMESTAMP()}), 10, arena.get()),
+      "Arrow serde does not support TIMESTAMP");
+}
+
+} // namespace
+} // namespace facebook::velox::serializer
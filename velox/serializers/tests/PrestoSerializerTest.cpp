@@ -65,6 +65,9 @@ class PrestoSerializerTest
     common::CompressionKind kind = GetParam();
     serializer::presto::PrestoVectorSerde::PrestoOptions paramOptions{
         useLosslessTimestamp, kind};
+    if (serdeOptions != nullptr) {
+      paramOptions.preserveEncodings = serdeOptions->preserveEncodings;
+    }
     return paramOptions;
   }
 
@@ -414,6 +417,174 @@ TEST_P(PrestoSerializerTest, lazy) {
   testRoundTrip(lazyVector);
 }
 
+TEST_P(PrestoSerializerTest, preserveEncodings) {
+  constexpr vector_size_t kSize = 1'000;
+  std::vector<std::string> strings;
+  for (auto i = 0; i < 10; ++i) {
+    strings.push_back(fmt::format("string value {}", i));
+  }
+  auto base = vectorMaker_->flatVector(strings);
+  auto makeIndices = [&](vector_size_t size, vector_size_t baseSize) {
+    auto indices = allocateIndices(size, pool_.get());
+    auto* rawIndices = indices->asMutable<vector_size_t>();
+    for (auto i = 0; i < size; ++i) {
+      rawIndices[i] = (i * 7) % baseSize;
+    }
+    return indices;
+  };
+  auto dictionary = BaseVector::wrapInDictionary(
+      nullptr, makeIndices(kSize, 10), kSize, base);
+  // Dictionaries with extra nulls or with more base values than rows are
+  // serialized flat.
+  BufferPtr nulls = AlignedBuffer::allocate<bool>(kSize, pool_.get(), false);
+  bits::setNull(nulls->asMutable<uint64_t>(), 3);
+  auto dictionaryWithNulls =
+      BaseVector::wrapInDictionary(nulls, makeIndices(kSize, 10), kSize, base);
+  auto largeBase = vectorMaker_->flatVector<int64_t>(
+      2 * kSize, [](auto row) { return row; });
+  auto sparseDictionary = BaseVector::wrapInDictionary(
+      nullptr, makeIndices(kSize, 2 * kSize), kSize, largeBase);
+  auto rowVector = vectorMaker_->rowVector({
+      dictionary,
+      BaseVector::createConstant(BIGINT(), 11, kSize, pool_.get()),
+      BaseVector::createNullConstant(VARCHAR(), kSize, pool_.get()),
+      dictionaryWithNulls,
+      sparseDictionary,
+      vectorMaker_->flatVector<int32_t>(kSize, [](auto row) { return row; }),
+  });
+  auto rowType = asRowType(rowVector->type());
+
+  serializer::presto::PrestoVectorSerde::PrestoOptions options;
+  options.preserveEncodings = true;
+  std::ostringstream encodedOut;
+  serialize(rowVector, &encodedOut, &options);
+  auto deserialized = deserialize(rowType, encodedOut.str(), &options);
+  assertEqualVectors(rowVector, deserialized);
+  EXPECT_EQ(
+      deserialized->childAt(0)->encoding(),
+      VectorEncoding::Simple::DICTIONARY);
+  EXPECT_EQ(deserialized->childAt(0)->valueVector()->size(), base->size());
+  EXPECT_TRUE(deserialized->childAt(1)->isConstantEncoding());
+  EXPECT_TRUE(deserialized->childAt(2)->isConstantEncoding());
+  for (auto i = 3; i < rowVector->childrenSize(); ++i) {
+    EXPECT_TRUE(deserialized->childAt(i)->isFlatEncoding());
+  }
+
+  std::ostringstream flatOut;
+  serialize(rowVector, &flatOut, nullptr);
+  EXPECT_LT(encodedOut.str().size(), flatOut.str().size());
+
+  // Appends several ranges of the same dictionary and constant, then a
+  // dictionary over another base, which makes the first column flat.
+  auto otherDictionary = BaseVector::wrapInDictionary(
+      nullptr, makeIndices(kSize, 5), kSize, base->slice(5, 5));
+  auto otherRowVector = vectorMaker_->rowVector({
+      otherDictionary,
+      BaseVector::createConstant(BIGINT(), 11, kSize, pool_.get()),
+  });
+  auto twoColumns = vectorMaker_->rowVector(
+      {rowVector->childAt(0), rowVector->childAt(1)});
+  auto arena = std::make_unique<StreamArena>(pool_.get());
+  auto paramOptions = getParamSerdeOptions(&options);
+  auto serializer = serde_->createSerializer(
+      asRowType(twoColumns->type()), 3 * kSize, arena.get(), &paramOptions);
+  std::vector<IndexRange> ranges = {{10, 90}, {500, 100}};
+  serializer->append(twoColumns, ranges);
+  serializer->append(otherRowVector);
+
+  std::ostringstream out;
+  facebook::velox::serializer::presto::PrestoOutputStreamListener listener;
+  OStreamOutputStream output(&out, &listener);
+  serializer->flush(&output);
+  deserialized =
+      deserialize(asRowType(twoColumns->type()), out.str(), &options);
+  EXPECT_TRUE(deserialized->childAt(0)->isFlatEncoding());
+  EXPECT_TRUE(deserialized->childAt(1)->isConstantEncoding());
+  ASSERT_EQ(deserialized->size(), 190 + kSize);
+  for (auto i = 0; i < deserialized->size(); ++i) {
+    const auto row = i < 90 ? 10 + i : (i < 190 ? 500 + i - 90 : i - 190);
+    const auto& expected = i < 190 ? twoColumns : otherRowVector;
+    ASSERT_TRUE(expected->equalValueAt(deserialized.get(), row, i))
+        << "at " << i;
+  }
+}
+
+TEST_P(PrestoSerializerTest, appendScattered) {
+  constexpr int32_t kNumPartitions = 5;
+  constexpr vector_size_t kSize = 1'000;
+  auto base = vectorMaker_->flatVector<int32_t>(
+      10, [](auto row) { return row * 3; });
+  auto rowVector = vectorMaker_->rowVector({
+      vectorMaker_->flatVector<int64_t>(
+          kSize, [](auto row) { return row; }, test::VectorMaker::nullEvery(7)),
+      vectorMaker_->flatVector<StringView>(
+          kSize,
+          [](auto row) {
+            return StringView::makeInline(fmt::format("s{}", row % 23));
+          },
+          test::VectorMaker::nullEvery(11)),
+      vectorMaker_->flatVector<double>(
+          kSize, [](auto row) { return row / 3.0; }),
+      // The columns below are appended per partition.
+      vectorMaker_->flatVector<bool>(kSize, [](auto row) { return row % 3; }),
+      BaseVector::wrapInDictionary(
+          nullptr,
+          test::makeIndices(
+              kSize, [](auto row) { return row % 10; }, pool_.get()),
+          kSize,
+          base),
+      vectorMaker_->arrayVector<int32_t>(
+          kSize,
+          [](auto row) { return row % 4; },
+          [](auto row) { return row; }),
+  });
+
+  std::vector<uint32_t> partitions(kSize);
+  std::vector<std::vector<IndexRange>> ranges(kNumPartitions);
+  for (auto row = 0; row < kSize; ++row) {
+    // Runs of 3 rows in the first half and single rows in the second half go
+    // to the same partition.
+    partitions[row] =
+        (row < kSize / 2 ? row / 3 : row) % kNumPartitions;
+    ranges[partitions[row]].push_back({row, 1});
+  }
+
+  auto rowType = asRowType(rowVector->type());
+  auto paramOptions = getParamSerdeOptions(nullptr);
+  std::vector<std::unique_ptr<StreamArena>> arenas;
+  std::vector<std::unique_ptr<VectorSerializer>> serializers;
+  std::vector<VectorSerializer*> rawSerializers;
+  for (auto i = 0; i < kNumPartitions; ++i) {
+    arenas.push_back(std::make_unique<StreamArena>(pool_.get()));
+    serializers.push_back(serde_->createSerializer(
+        rowType, kSize / kNumPartitions, arenas.back().get(), &paramOptions));
+    rawSerializers.push_back(serializers.back().get());
+  }
+  serde_->appendScattered(
+      rowVector,
+      folly::Range(partitions.data(), partitions.size()),
+      folly::Range(rawSerializers.data(), rawSerializers.size()));
+
+  for (auto i = 0; i < kNumPartitions; ++i) {
+    SCOPED_TRACE(fmt::format("partition {}", i));
+    std::ostringstream output;
+    facebook::velox::serializer::presto::PrestoOutputStreamListener listener;
+    OStreamOutputStream out(&output, &listener);
+    serializers[i]->flush(&out);
+    auto deserialized = deserialize(rowType, output.str(), nullptr);
+
+    std::vector<BaseVector::CopyRange> copyRanges;
+    for (auto& range : ranges[i]) {
+      copyRanges.push_back(
+          {range.begin, static_cast<vector_size_t>(copyRanges.size()), 1});
+    }
+    auto expected = BaseVector::create<RowVector>(
+        rowType, copyRanges.size(), pool_.get());
+    expected->copyRanges(rowVector.get(), copyRanges);
+    assertEqualVectors(expected, deserialized);
+  }
+}
+
 TEST_P(PrestoSerializerTest, ioBufRoundTrip) {
   VectorFuzzer::Options opts;
   opts.timestampPrecision =
@@ -433,6 +604,83 @@ TEST_P(PrestoSerializerTest, ioBufRoundTrip) {
   }
 }
 
+TEST_P(PrestoSerializerTest, adaptiveCompression) {
+  if (GetParam() == common::CompressionKind_NONE) {
+    return;
+  }
+  using CompressionStats =
+      serializer::presto::PrestoVectorSerde::CompressionStats;
+  CompressionStats stats;
+  serializer::presto::PrestoVectorSerde::PrestoOptions options;
+  options.compressionKind = GetParam();
+  options.minCompressionRatio = 1.2;
+  options.compressionStats = &stats;
+
+  // Serializes 'rowVector' as one page and returns true if the page is
+  // compressed after checking that it reads back as 'rowVector'.
+  auto serializePage = [&](const RowVectorPtr& rowVector) {
+    std::ostringstream output;
+    auto arena = std::make_unique<StreamArena>(pool_.get());
+    auto serializer = serde_->createSerializer(
+        asRowType(rowVector->type()), rowVector->size(), arena.get(), &options);
+    serializer->append(rowVector);
+    facebook::velox::serializer::presto::PrestoOutputStreamListener listener;
+    OStreamOutputStream out(&output, &listener);
+    serializer->flush(&out);
+
+    auto page = output.str();
+    auto byteStream = toByteStream(page);
+    RowVectorPtr result;
+    serde_->deserialize(
+        byteStream.get(),
+        pool_.get(),
+        asRowType(rowVector->type()),
+        &result,
+        &options);
+    assertEqualVectors(rowVector, result);
+    // The codec marker follows the number of rows.
+    return (page[sizeof(int32_t)] & 1) != 0;
+  };
+
+  folly::Random::DefaultGenerator rng(1);
+  auto incompressible =
+      vectorMaker_->rowVector({vectorMaker_->flatVector<int64_t>(
+          1'000, [&](auto /*row*/) { return folly::Random::rand64(rng); })});
+  auto compressible =
+      vectorMaker_->rowVector({vectorMaker_->flatVector<int64_t>(
+          1'000, [](auto row) { return row % 7; })});
+
+  EXPECT_TRUE(serializePage(compressible));
+  EXPECT_EQ(stats.numUncompressedPages, 0);
+
+  for (auto i = 0; i < CompressionStats::kMaxIncompressiblePages; ++i) {
+    EXPECT_FALSE(serializePage(incompressible));
+  }
+  EXPECT_EQ(
+      stats.numUncompressedPages, CompressionStats::kMaxIncompressiblePages);
+  EXPECT_EQ(stats.numSkippedPages, 0);
+
+  // Compression is skipped even for compressible pages for a while.
+  const auto compressionInputBytes = stats.compressionInputBytes;
+  for (auto i = 0; i < CompressionStats::kNumSkippedPages; ++i) {
+    EXPECT_FALSE(serializePage(compressible));
+  }
+  EXPECT_EQ(stats.numSkippedPages, CompressionStats::kNumSkippedPages);
+  EXPECT_EQ(stats.compressionInputBytes, compressionInputBytes);
+
+  EXPECT_TRUE(serializePage(compressible));
+  EXPECT_GT(stats.compressionInputBytes, compressionInputBytes);
+  EXPECT_GT(stats.compressionInputBytes, stats.compressedBytes);
+
+  // Pages that do not compress well but are not consecutive do not start
+  // skipping.
+  for (auto i = 0; i < 2 * CompressionStats::kMaxIncompressiblePages; ++i) {
+    EXPECT_EQ(
+        serializePage(i % 2 ? compressible : incompressible), i % 2 == 1);
+  }
+  EXPECT_EQ(stats.numSkippedPages, CompressionStats::kNumSkippedPages);
+}
+
 INSTANTIATE_TEST_SUITE_P(
     PrestoSerializerTest,
     PrestoSerializerTest,
@@ -116,24 +116,39 @@ void setLiteralValue(
   }
 }
 
+using LiteralList =
+    ::google::protobuf::RepeatedPtrField<::substrait::Expression::Literal>;
+
+// Makes a flat vector of the 'size' literals starting at 'offset'.
 template <TypeKind kind>
 VectorPtr constructFlatVector(
-    const ::substrait::Expression::Literal& listLiteral,
+    const LiteralList& literals,
+    int32_t offset,
     const vector_size_t size,
     const TypePtr& type,
     memory::MemoryPool* pool) {
   VELOX_CHECK(type->isPrimitiveType());
+  VELOX_CHECK_LE(offset + size, literals.size());
   auto vector = BaseVector::create(type, size, pool);
   using T = typename TypeTraits<kind>::NativeType;
   auto flatVector = vector->as<FlatVector<T>>();
 
-  vector_size_t index = 0;
-  for (auto child : listLiteral.list().values()) {
-    setLiteralValue(child, flatVector, index++);
+  for (vector_size_t index = 0; index < size; ++index) {
+    setLiteralValue(literals.Get(offset + index), flatVector, index);
   }
   return vector;
 }
 
+template <TypeKind kind>
+VectorPtr constructFlatVector(
+    const ::substrait::Expression::Literal& listLiteral,
+    const vector_size_t size,
+    const TypePtr& type,
+    memory::MemoryPool* pool) {
+  return constructFlatVector<kind>(
+      listLiteral.list().values(), 0, size, type, pool);
+}
+
 /// Whether null will be returned on cast failure.
 bool isNullOnFailure(
     ::substrait::Expression::Cast::FailureBehavior failureBehavior) {
@@ -255,6 +270,18 @@ SubstraitVeloxExprConverter::toVeloxExpr(
   }
 }
 
+VectorPtr SubstraitVeloxExprConverter::literalsToFlatVector(
+    const LiteralList& literals,
+    int32_t offset,
+    vector_size_t size,
+    const TypePtr& type) {
+  VELOX_USER_CHECK(
+      type->isPrimitiveType(),
+      "Values node with complex type values is not supported yet");
+  return VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+      constructFlatVector, type->kind(), literals, offset, size, type, pool_);
+}
+
 ArrayVectorPtr SubstraitVeloxExprConverter::literalsToArrayVector(
     const ::substrait::Expression::Literal& listLiteral) {
   auto childSize = listLiteral.list().values().size();
@@ -63,6 +63,16 @@ class SubstraitVeloxExprConverter {
       const ::substrait::Expression::IfThen& substraitIfThen,
       const RowTypePtr& inputType);
 
+  /// Convert 'size' literals starting at 'offset' into a flat vector of
+  /// 'type'. The values are set directly, without making a constant
+  /// expression and a variant for each. Only scalar types are supported.
+  VectorPtr literalsToFlatVector(
+      const ::google::protobuf::RepeatedPtrField<
+          ::substrait::Expression::Literal>& literals,
+      int32_t offset,
+      vector_size_t size,
+      const TypePtr& type);
+
  private:
   /// Convert list literal to ArrayVector.
   ArrayVectorPtr literalsToArrayVector(
@@ -16,7 +16,6 @@
 
 #include "velox/substrait/SubstraitToVeloxPlan.h"
 #include "velox/substrait/TypeUtils.h"
-#include "velox/substrait/VariantToVectorConverter.h"
 #include "velox/type/Type.h"
 
 namespace facebook::velox::substrait {
@@ -459,7 +458,7 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
 core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
     const ::substrait::ReadRel& readRel,
     const RowTypePtr& type) {
-  ::substrait::ReadRel_VirtualTable readVirtualTable = readRel.virtual_table();
+  const auto& readVirtualTable = readRel.virtual_table();
   int64_t numVectors = readVirtualTable.values_size();
   int64_t numColumns = type->size();
   int64_t valueFieldNums =
@@ -477,36 +476,14 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
 
   for (int64_t index = 0; index < numVectors; ++index) {
     std::vector<VectorPtr> children;
-    ::substrait::Expression_Literal_Struct rowValue =
-        readRel.virtual_table().values(index);
+    const auto& rowValue = readVirtualTable.values(index);
     auto fieldSize = rowValue.fields_size();
     VELOX_CHECK_EQ(fieldSize, batchSize * numColumns);
 
+    // The values of each column are consecutive in 'rowValue'.
     for (int64_t col = 0; col < numColumns; ++col) {
-      const TypePtr& outputChildType = type->childAt(col);
-      std::vector<variant> batchChild;
-      batchChild.reserve(batchSize);
-      for (int64_t batchId = 0; batchId < batchSize; batchId++) {
-        // each value in the batch
-        auto fieldIdx = col * batchSize + batchId;
-        ::substrait::Expression_Literal field = rowValue.fields(fieldIdx);
-
-        auto expr = exprConverter_->toVeloxExpr(field);
-        if (auto constantExpr =
-                std::dynamic_pointer_cast<const core::ConstantTypedExpr>(
-                    expr)) {
-          if (!constantExpr->hasValueVector()) {
-            batchChild.emplace_back(constantExpr->value());
-          } else {
-            VELOX_UNSUPPORTED(
-                "Values node with complex type values is not supported yet");
-          }
-        } else {
-          VELOX_FAIL("Expected constant expression");
-        }
-      }
-      children.emplace_back(
-          setVectorFromVariants(outputChildType, batchChild, pool_));
+      children.emplace_back(exprConverter_->literalsToFlatVector(
+          rowValue.fields(), col * batchSize, batchSize, type->childAt(col)));
     }
 
     vectors.emplace_back(
@@ -580,6 +557,31 @@ core::PlanNodePtr SubstraitVeloxPlanConverter::toVeloxPlan(
   VELOX_FAIL("RelRoot or Rel is expected in Plan.");
 }
 
+std::shared_ptr<const SubstraitPlanCache::Entry>
+SubstraitPlanCache::toVeloxPlan(const ::substrait::Plan& substraitPlan) {
+  auto key = substraitPlan.SerializeAsString();
+  {
+    auto entries = entries_.rlock();
+    auto it = entries->find(key);
+    if (it != entries->end()) {
+      return it->second;
+    }
+  }
+
+  // Convert outside of the lock. Tasks that miss at the same time convert
+  // the plan each and the first one to finish is kept.
+  SubstraitVeloxPlanConverter converter(pool_);
+  auto entry = std::make_shared<Entry>();
+  entry->planNode = converter.toVeloxPlan(substraitPlan);
+  entry->splitInfos = converter.splitInfos();
+
+  auto entries = entries_.wlock();
+  if (entries->size() >= maxEntries_) {
+    entries->clear();
+  }
+  return entries->emplace(std::move(key), std::move(entry)).first->second;
+}
+
 std::string SubstraitVeloxPlanConverter::nextPlanNodeId() {
   auto id = fmt::format("{}", planNodeId_);
   planNodeId_++;
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <folly/Synchronized.h>
+
 #include "velox/connectors/hive/HiveConnector.h"
 #include "velox/core/PlanNode.h"
 #include "velox/substrait/SubstraitToVeloxExpr.h"
@@ -182,4 +184,46 @@ class SubstraitVeloxPlanConverter {
   }
 };
 
+/// Converts Substrait plans into Velox plans once per distinct plan. The tasks
+/// of a stage all get the same Substrait plan. With a cache scoped to the
+/// stage, the first task converts it and the others share the resulting plan
+/// nodes, which are immutable. The vectors of Values nodes are allocated from
+/// 'pool', which must outlive the cache and the plans it returns. Is keyed on
+/// the serialized plan. Thread-safe.
+class SubstraitPlanCache {
+ public:
+  struct Entry {
+    core::PlanNodePtr planNode;
+    std::unordered_map<
+        core::PlanNodeId,
+        std::shared_ptr<SubstraitVeloxPlanConverter::SplitInfo>>
+        splitInfos;
+  };
+
+  /// The cache is cleared when it has 'maxEntries' plans and another one is
+  /// added.
+  explicit SubstraitPlanCache(
+      memory::MemoryPool* pool,
+      size_t maxEntries = kDefaultMaxEntries)
+      : pool_(pool), maxEntries_(maxEntries) {}
+
+  /// Returns the Velox plan and split infos for 'substraitPlan', converting
+  /// it if it is not in the cache.
+  std::shared_ptr<const Entry> toVeloxPlan(
+      const ::substrait::Plan& substraitPlan);
+
+  size_t size() const {
+    return entries_.rlock()->size();
+  }
+
+  static constexpr size_t kDefaultMaxEntries = 100;
+
+ private:
+  memory::MemoryPool* const pool_;
+  const size_t maxEntries_;
+  folly::Synchronized<
+      std::unordered_map<std::string, std::shared_ptr<const Entry>>>
+      entries_;
+};
+
 } // namespace facebook::velox::substrait
@@ -60,3 +60,28 @@ TEST_F(Substrait2VeloxValuesNodeConversionTest, valuesNode) {
   createDuckDbTable({expectedData});
   assertQuery(veloxPlan, "SELECT * FROM tmp");
 }
+
+TEST_F(Substrait2VeloxValuesNodeConversionTest, planCache) {
+  auto planPath = getDataFilePath(
+      "velox/substrait/tests", "data/substrait_virtualTable.json");
+
+  ::substrait::Plan substraitPlan;
+  JsonToProtoConverter::readFromFile(planPath, substraitPlan);
+
+  SubstraitPlanCache cache(pool_.get(), 1);
+  auto first = cache.toVeloxPlan(substraitPlan);
+  ASSERT_EQ(cache.size(), 1);
+  // The same plan converts once.
+  ASSERT_EQ(cache.toVeloxPlan(substraitPlan), first);
+  ASSERT_EQ(
+      first->planNode->toString(true, true),
+      planConverter_->toVeloxPlan(substraitPlan)->toString(true, true));
+
+  // A different plan replaces the first one in a cache of one entry.
+  auto otherPlan = substraitPlan;
+  otherPlan.mutable_relations(0)->mutable_root()->add_names("extra");
+  auto other = cache.toVeloxPlan(otherPlan);
+  ASSERT_NE(other, first);
+  ASSERT_EQ(cache.size(), 1);
+  ASSERT_NE(cache.toVeloxPlan(substraitPlan), first);
+}
@@ -37,6 +37,19 @@ class DBGenBackend {
     DBGenContext dbgenCtx;
     load_dists(
         10 * 1024 * 1024, &dbgenCtx); // 10 MB buffer size for text generation.
+
+    // mk_cust(), mk_order(), mk_part() and mk_supp() lazily initialize
+    // function level statics on their first call. Make these calls here, under
+    // the singleton's initialization, so that splits can then be generated
+    // concurrently from different threads.
+    customer_t customer;
+    mk_cust(1, &customer, &dbgenCtx);
+    auto order = std::make_unique<order_t>();
+    mk_order(1, order.get(), &dbgenCtx, /*update-num=*/0);
+    auto part = std::make_unique<part_t>();
+    mk_part(1, part.get(), &dbgenCtx);
+    supplier_t supplier;
+    mk_supp(1, &supplier, &dbgenCtx);
   }
   ~DBGenBackend() {
     cleanup_dists();
@@ -19,6 +19,7 @@
 #include "velox/external/duckdb/tpch/dbgen/include/dbgen/dss.h"
 #include "velox/external/duckdb/tpch/dbgen/include/dbgen/dsstypes.h"
 #include "velox/tpch/gen/DBGenIterator.h"
+#include "velox/type/TimestampConversion.h"
 #include "velox/vector/FlatVector.h"
 
 namespace facebook::velox::tpch {
@@ -82,7 +83,29 @@ double decimalToDouble(int64_t value) {
   return (double)value * 0.01;
 }
 
+// Dbgen formats all dates as YYYY-MM-DD. Reads the digits at their fixed
+// positions instead of going through the generic date parser, which takes a
+// large share of the time of generating orders and lineitem.
 int32_t toDate(std::string_view stringDate) {
+  auto digits = [&](int32_t begin, int32_t end, int32_t& value) {
+    value = 0;
+    for (auto i = begin; i < end; ++i) {
+      const auto digit = stringDate[i] - '0';
+      if (digit < 0 || digit > 9) {
+        return false;
+      }
+      value = value * 10 + digit;
+    }
+    return true;
+  };
+  int32_t year;
+  int32_t month;
+  int32_t day;
+  if (stringDate.size() == 10 && stringDate[4] == '-' &&
+      stringDate[7] == '-' && digits(0, 4, year) && digits(5, 7, month) &&
+      digits(8, 10, day)) {
+    return util::daysSinceEpochFromDate(year, month, day);
+  }
   return DATE()->toDays(stringDate);
 }
 
@@ -15,6 +15,7 @@
  */
 
 #include <folly/init/Init.h>
+#include <thread>
 #include "gtest/gtest.h"
 
 #include "velox/tpch/gen/TpchGen.h"
@@ -410,6 +411,34 @@ TEST_F(TpchGenTestLineItemTest, reproducible) {
   }
 }
 
+// Ensure that batches generated concurrently from different threads are the
+// same as the ones generated serially.
+TEST_F(TpchGenTestLineItemTest, parallel) {
+  constexpr int32_t kNumBatches = 8;
+  constexpr size_t kOrdersPerBatch = 1000;
+  std::vector<RowVectorPtr> parallelBatches(kNumBatches);
+  std::vector<std::thread> threads;
+  threads.reserve(kNumBatches);
+  for (auto i = 0; i < kNumBatches; ++i) {
+    threads.emplace_back([&, i]() {
+      parallelBatches[i] =
+          genTpchLineItem(pool_.get(), kOrdersPerBatch, i * kOrdersPerBatch);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (auto i = 0; i < kNumBatches; ++i) {
+    auto expected =
+        genTpchLineItem(pool_.get(), kOrdersPerBatch, i * kOrdersPerBatch);
+    ASSERT_EQ(expected->size(), parallelBatches[i]->size());
+    for (size_t j = 0; j < expected->size(); ++j) {
+      ASSERT_TRUE(expected->equalValueAt(parallelBatches[i].get(), j, j));
+    }
+  }
+}
+
 // Supplier.
 class TpchGenTestSupplierTest : public testing::Test {
  protected:
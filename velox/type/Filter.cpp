@@ -20,7 +20,10 @@
 #include <set>
 #include <string>
 
+#include <folly/hash/Hash.h>
+
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/encode/Base64.h"
 #include "velox/type/Filter.h"
 
 namespace facebook::velox::common {
@@ -94,6 +97,9 @@ std::string Filter::toString() const {
     case FilterKind::kHugeintValuesUsingHashTable:
       strKind = "HugeintValuesUsingHashTable";
       break;
+    case FilterKind::kBloomFilterValues:
+      strKind = "BloomFilterValues";
+      break;
   };
 
   return fmt::format(
@@ -131,6 +137,7 @@ std::unordered_map<FilterKind, std::string> filterKindNames() {
       {FilterKind::kTimestampRange, "kTimestampRange"},
       {FilterKind::kHugeintValuesUsingHashTable,
        "kHugeintValuesUsingHashTable"},
+      {FilterKind::kBloomFilterValues, "kBloomFilterValues"},
   };
 }
 
@@ -199,6 +206,7 @@ void Filter::registerSerDe() {
   registry.Register("NegatedBytesValues", NegatedBytesValues::create);
   registry.Register("MultiRange", MultiRange::create);
   registry.Register("TimestampRange", TimestampRange::create);
+  registry.Register("BloomFilterValues", BloomFilterValues::create);
 }
 
 folly::dynamic Filter::serializeBase(std::string_view name) const {
@@ -2635,4 +2643,132 @@ std::unique_ptr<Filter> NegatedBytesValues::mergeWith(
       VELOX_UNREACHABLE();
   }
 }
+
+namespace {
+std::string serializeBloomFilter(const BloomFilter<>& bloomFilter) {
+  std::string serialized(bloomFilter.serializedSize(), '\0');
+  bloomFilter.serialize(serialized.data());
+  return encoding::Base64::encode(serialized.data(), serialized.size());
+}
+} // namespace
+
+uint64_t BloomFilterValues::hashInt64(int64_t value) {
+  return folly::hash::twang_mix64(value);
+}
+
+uint64_t BloomFilterValues::hashBytes(const char* value, int32_t length) {
+  return folly::hasher<std::string_view>()(std::string_view(value, length));
+}
+
+folly::dynamic BloomFilterValues::serialize() const {
+  auto obj = Filter::serializeBase("BloomFilterValues");
+  folly::dynamic bloomFilters = folly::dynamic::array;
+  for (const auto& bloomFilter : bloomFilters_) {
+    bloomFilters.push_back(serializeBloomFilter(*bloomFilter));
+  }
+  obj["bloomFilters"] = bloomFilters;
+  if (other_ != nullptr) {
+    obj["other"] = other_->serialize();
+  }
+  return obj;
+}
+
+FilterPtr BloomFilterValues::create(const folly::dynamic& obj) {
+  auto nullAllowed = deserializeNullAllowed(obj);
+  std::vector<std::shared_ptr<const BloomFilter<>>> bloomFilters;
+  for (const auto& encoded : obj["bloomFilters"]) {
+    auto serialized = encoding::Base64::decode(encoded.asString());
+    auto bloomFilter = std::make_shared<BloomFilter<>>();
+    bloomFilter->merge(serialized.data());
+    bloomFilters.push_back(std::move(bloomFilter));
+  }
+  std::shared_ptr<const Filter> other;
+  if (obj.count("other") > 0) {
+    other = ISerializable::deserialize<Filter>(obj["other"]);
+  }
+  return std::make_unique<BloomFilterValues>(
+      std::move(bloomFilters), std::move(other), nullAllowed);
+}
+
+bool BloomFilterValues::testingEquals(const Filter& other) const {
+  auto otherBloomFilterValues = dynamic_cast<const BloomFilterValues*>(&other);
+  if (otherBloomFilterValues == nullptr || !Filter::testingBaseEquals(other) ||
+      bloomFilters_.size() != otherBloomFilterValues->bloomFilters_.size() ||
+      (other_ == nullptr) != (otherBloomFilterValues->other_ == nullptr)) {
+    return false;
+  }
+  for (auto i = 0; i < bloomFilters_.size(); ++i) {
+    if (serializeBloomFilter(*bloomFilters_[i]) !=
+        serializeBloomFilter(*otherBloomFilterValues->bloomFilters_[i])) {
+      return false;
+    }
+  }
+  return other_ == nullptr ||
+      other_->testingEquals(*otherBloomFilterValues->other_);
+}
+
+bool BloomFilterValues::testInt64Range(int64_t min, int64_t max, bool hasNull)
+    const {
+  if (hasNull && nullAllowed_) {
+    return true;
+  }
+  if (min == max) {
+    return testInt64(min);
+  }
+  return other_ == nullptr || other_->testInt64Range(min, max, false);
+}
+
+bool BloomFilterValues::testBytesRange(
+    std::optional<std::string_view> min,
+    std::optional<std::string_view> max,
+    bool hasNull) const {
+  if (hasNull && nullAllowed_) {
+    return true;
+  }
+  if (min.has_value() && max.has_value() && min.value() == max.value()) {
+    return testBytes(min->data(), min->size());
+  }
+  return other_ == nullptr || other_->testBytesRange(min, max, false);
+}
+
+std::unique_ptr<Filter> BloomFilterValues::mergeWith(
+    const Filter* other) const {
+  switch (other->kind()) {
+    case FilterKind::kAlwaysTrue:
+    case FilterKind::kAlwaysFalse:
+    case FilterKind::kIsNull:
+      return other->mergeWith(this);
+    case FilterKind::kIsNotNull:
+      return this->clone(/*nullAllowed=*/false);
+    case FilterKind::kBloomFilterValues: {
+      auto otherBloomFilterValues =
+          static_cast<const BloomFilterValues*>(other);
+      auto bloomFilters = bloomFilters_;
+      bloomFilters.insert(
+          bloomFilters.end(),
+          otherBloomFilterValues->bloomFilters_.begin(),
+          otherBloomFilterValues->bloomFilters_.end());
+      std::shared_ptr<const Filter> mergedOther = other_;
+      if (otherBloomFilterValues->other_ != nullptr) {
+        mergedOther = other_ == nullptr
+            ? otherBloomFilterValues->other_
+            : std::shared_ptr<const Filter>(
+                  other_->mergeWith(otherBloomFilterValues->other_.get()));
+      }
+      return std::make_unique<BloomFilterValues>(
+          std::move(bloomFilters),
+          std::move(mergedOther),
+          nullAllowed_ && other->testNull());
+    }
+    default: {
+      std::shared_ptr<const Filter> mergedOther = other_ == nullptr
+          ? std::shared_ptr<const Filter>(other->clone())
+          : std::shared_ptr<const Filter>(other_->mergeWith(other));
+      return std::make_unique<BloomFilterValues>(
+          bloomFilters_,
+          std::move(mergedOther),
+          nullAllowed_ && other->testNull());
+    }
+  }
+}
 } // namespace facebook::velox::common
@@ -25,6 +25,7 @@
 #include <folly/Range.h>
 #include <folly/container/F14Set.h>
 
+#include "velox/common/base/BloomFilter.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
 #include "velox/common/serialization/Serializable.h"
@@ -56,6 +57,7 @@ enum class FilterKind {
   kHugeintRange,
   kTimestampRange,
   kHugeintValuesUsingHashTable,
+  kBloomFilterValues,
 };
 
 class Filter;
@@ -1849,8 +1851,9 @@ class BytesValues final : public Filter {
   }
 
   bool testBytes(const char* value, int32_t length) const final {
+    // Looks up a string_view to not copy 'value' into a std::string.
     return lengths_.contains(length) &&
-        values_.contains(std::string(value, length));
+        values_.contains(std::string_view(value, length));
   }
 
   bool testBytesRange(
@@ -1974,6 +1977,103 @@ class NegatedBytesValues final : public Filter {
   std::unique_ptr<BytesValues> nonNegated_;
 };
 
+/// Filter on integral or string values that passes the values whose hashes
+/// are set in one or more bloom filters. Produced by hash joins for the join
+/// keys which have too many distinct values to be pushed down as an IN-list.
+/// Values which are not in the set pass at the false positive rate of the
+/// bloom filters. The filter may carry another filter on the same column that
+/// it has been merged with, which is ANDed with the bloom filters.
+class BloomFilterValues final : public Filter {
+ public:
+  /// @param bloomFilter The hashes of the values that pass the filter. The
+  /// values are hashed with hashInt64() or hashBytes().
+  /// @param nullAllowed Null values are passing the filter if true.
+  BloomFilterValues(
+      std::shared_ptr<const BloomFilter<>> bloomFilter,
+      bool nullAllowed)
+      : Filter(true, nullAllowed, FilterKind::kBloomFilterValues),
+        bloomFilters_({std::move(bloomFilter)}) {}
+
+  BloomFilterValues(
+      std::vector<std::shared_ptr<const BloomFilter<>>> bloomFilters,
+      std::shared_ptr<const Filter> other,
+      bool nullAllowed)
+      : Filter(true, nullAllowed, FilterKind::kBloomFilterValues),
+        bloomFilters_(std::move(bloomFilters)),
+        other_(std::move(other)) {
+    VELOX_CHECK(!bloomFilters_.empty());
+  }
+
+  BloomFilterValues(const BloomFilterValues& other, bool nullAllowed)
+      : Filter(true, nullAllowed, FilterKind::kBloomFilterValues),
+        bloomFilters_(other.bloomFilters_),
+        other_(other.other_) {}
+
+  /// Returns the hash to insert into or look up in the bloom filter for an
+  /// integral value.
+  static uint64_t hashInt64(int64_t value);
+
+  /// Returns the hash to insert into or look up in the bloom filter for a
+  /// string value.
+  static uint64_t hashBytes(const char* value, int32_t length);
+
+  folly::dynamic serialize() const override;
+
+  static FilterPtr create(const folly::dynamic& obj);
+
+  std::unique_ptr<Filter> clone(
+      std::optional<bool> nullAllowed = std::nullopt) const final {
+    if (nullAllowed) {
+      return std::make_unique<BloomFilterValues>(*this, nullAllowed.value());
+    } else {
+      return std::make_unique<BloomFilterValues>(*this);
+    }
+  }
+
+  bool testInt64(int64_t value) const final {
+    return mayContain(hashInt64(value)) &&
+        (other_ == nullptr || other_->testInt64(value));
+  }
+
+  bool testBytes(const char* value, int32_t length) const final {
+    return mayContain(hashBytes(value, length)) &&
+        (other_ == nullptr || other_->testBytes(value, length));
+  }
+
+  bool testInt64Range(int64_t min, int64_t max, bool hasNull) const final;
+
+  bool testBytesRange(
+      std::optional<std::string_view> min,
+      std::optional<std::string_view> max,
+      bool hasNull) const final;
+
+  std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
+
+  std::string toString() const final {
+    return fmt::format(
+        "BloomFilterValues: {} bloom filter(s){} {}",
+        bloomFilters_.size(),
+        other_ != nullptr ? " and " + other_->toString() : "",
+        nullAllowed_ ? "with nulls" : "no nulls");
+  }
+
+  bool testingEquals(const Filter& other) const final;
+
+ private:
+  bool mayContain(uint64_t hash) const {
+    for (const auto& bloomFilter : bloomFilters_) {
+      if (!bloomFilter->mayContain(hash)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // The bloom filters are immutable and shared by the clones of 'this'.
+  const std::vector<std::shared_ptr<const BloomFilter<>>> bloomFilters_;
+  const std::shared_ptr<const Filter> other_;
+};
+
 /// Represents a combination of two of more filters with
 /// OR semantics. The filter passes if at least one of the contained filters
 /// passes.
@@ -18,6 +18,7 @@
 #include "velox/common/base/Exceptions.h"
 #include "velox/external/date/tz.h"
 #include "velox/type/tz/TimeZoneMap.h"
+#include "velox/type/tz/TimeZoneTransitions.h"
 
 namespace facebook::velox {
 namespace {
@@ -51,6 +52,11 @@ void Timestamp::toGMT(const date::time_zone& zone) {
     VELOX_UNSUPPORTED(
         "Timestamp out of bound for time zone adjustment {} seconds", seconds_);
   }
+  int64_t utcSeconds;
+  if (util::TimeZoneTransitions::get(zone).toUtc(seconds_, utcSeconds)) {
+    seconds_ = utcSeconds;
+    return;
+  }
   date::local_time<std::chrono::seconds> localTime{
       std::chrono::seconds(seconds_)};
   std::chrono::time_point<std::chrono::system_clock, std::chrono::seconds>
@@ -65,7 +71,7 @@ void Timestamp::toGMT(int16_t tzID) {
     seconds_ -= getPrestoTZOffsetInSeconds(tzID);
   } else {
     // Other ids go this path.
-    toGMT(*date::locate_zone(util::getTimeZoneName(tzID)));
+    toGMT(util::TimeZoneTransitions::get(tzID).zone());
   }
 }
 
@@ -102,6 +108,12 @@ Timestamp::toTimePoint() const {
 }
 
 void Timestamp::toTimezone(const date::time_zone& zone) {
+  int64_t offset;
+  if (util::TimeZoneTransitions::get(zone).offsetAtUtc(seconds_, offset)) {
+    // Truncates the local time in milliseconds like the conversion below.
+    seconds_ = (toMillis() + offset * 1'000) / 1'000;
+    return;
+  }
   auto tp = toTimePoint();
   auto epoch = zone.to_local(tp).time_since_epoch();
   seconds_ = std::chrono::duration_cast<std::chrono::seconds>(epoch).count();
@@ -114,7 +126,7 @@ void Timestamp::toTimezone(int16_t tzID) {
     seconds_ += getPrestoTZOffsetInSeconds(tzID);
   } else {
     // Other ids go this path.
-    toTimezone(*date::locate_zone(util::getTimeZoneName(tzID)));
+    toTimezone(util::TimeZoneTransitions::get(tzID).zone());
   }
 }
 
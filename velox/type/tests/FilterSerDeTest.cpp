@@ -156,6 +156,18 @@ TEST_F(FilterSerDeTest, multiFilter) {
   testSerde(multiRange);
 }
 
+TEST_F(FilterSerDeTest, bloomFilterValues) {
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(100);
+  for (int64_t i = 0; i < 10; ++i) {
+    bloomFilter->insert(BloomFilterValues::hashInt64(i));
+  }
+  BloomFilterValues filter(bloomFilter, false);
+  testSerde(filter);
+  testSerde(*filter.clone(true));
+  testSerde(*filter.mergeWith(between(0, 5).get()));
+}
+
 TEST_F(FilterSerDeTest, timestampFilter) {
   Timestamp hi(100000, 2000);
   Timestamp lo(-123, 99999);
@@ -950,6 +950,55 @@ TEST(FilterTest, bytesValues) {
   EXPECT_FALSE(filter->testBytesRange(std::nullopt, "Banana", false));
 }
 
+TEST(FilterTest, bloomFilterValues) {
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(1'000);
+  for (int64_t i = 0; i < 100; ++i) {
+    bloomFilter->insert(BloomFilterValues::hashInt64(i * 7));
+    auto value = fmt::format("value-{}", i * 7);
+    bloomFilter->insert(
+        BloomFilterValues::hashBytes(value.data(), value.size()));
+  }
+  auto filter = std::make_unique<BloomFilterValues>(bloomFilter, false);
+  EXPECT_FALSE(filter->testNull());
+
+  int32_t numFalsePositives = 0;
+  for (int64_t i = 0; i < 700; ++i) {
+    auto value = fmt::format("value-{}", i);
+    if (i % 7 == 0) {
+      EXPECT_TRUE(filter->testInt64(i));
+      EXPECT_TRUE(filter->testBytes(value.data(), value.size()));
+    } else {
+      numFalsePositives += filter->testInt64(i);
+      numFalsePositives += filter->testBytes(value.data(), value.size());
+    }
+  }
+  EXPECT_LT(numFalsePositives, 60);
+
+  EXPECT_TRUE(filter->testInt64Range(0, 100, false));
+  EXPECT_TRUE(filter->testInt64Range(7, 7, false));
+  EXPECT_TRUE(filter->testBytesRange("a", "z", false));
+  EXPECT_TRUE(filter->testBytesRange("value-7", "value-7", false));
+
+  // Merging with another filter ANDs the filters.
+  auto merged = filter->mergeWith(between(0, 100).get());
+  EXPECT_EQ(merged->kind(), FilterKind::kBloomFilterValues);
+  EXPECT_TRUE(merged->testInt64(70));
+  EXPECT_FALSE(merged->testInt64(140));
+  EXPECT_FALSE(merged->testInt64Range(200, 300, false));
+  EXPECT_FALSE(merged->testNull());
+
+  merged = filter->mergeWith(isNotNull().get());
+  EXPECT_EQ(merged->kind(), FilterKind::kBloomFilterValues);
+  EXPECT_FALSE(merged->testNull());
+  merged = filter->mergeWith(isNull().get());
+  EXPECT_EQ(merged->kind(), FilterKind::kAlwaysFalse);
+
+  auto nullAllowedFilter = filter->clone(true);
+  EXPECT_TRUE(nullAllowedFilter->testNull());
+  EXPECT_TRUE(nullAllowedFilter->testInt64(7));
+}
+
 TEST(FilterTest, negatedBytesValues) {
   // create a filter
   std::vector<std::string> values(
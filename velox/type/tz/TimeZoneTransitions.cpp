@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/type/tz/TimeZoneTransitions.h"
+
+#include <folly/Synchronized.h>
+#include <folly/container/F14Map.h>
+#include <algorithm>
+#include <memory>
+#include "velox/common/base/Exceptions.h"
+#include "velox/external/date/tz.h"
+#include "velox/type/tz/TimeZoneMap.h"
+
+namespace facebook::velox::util {
+
+namespace {
+// The table starts and ends this many seconds beyond the range it converts,
+// which is more than any difference of two offsets. A local time in the range
+// is therefore never in an interval that starts before the table.
+constexpr int64_t kMargin = 2 * 86'400;
+
+struct TableCache {
+  using TablePtr = std::unique_ptr<TimeZoneTransitions>;
+  folly::F14FastMap<const date::time_zone*, TablePtr> byZone;
+  folly::F14FastMap<int64_t, const TimeZoneTransitions*> byId;
+};
+
+folly::Synchronized<TableCache>& tableCache() {
+  static folly::Synchronized<TableCache> cache;
+  return cache;
+}
+
+const TimeZoneTransitions& getLocked(
+    TableCache& cache,
+    const date::time_zone* zone) {
+  auto& table = cache.byZone[zone];
+  if (!table) {
+    table = std::make_unique<TimeZoneTransitions>(*zone);
+  }
+  return *table;
+}
+} // namespace
+
+TimeZoneTransitions::TimeZoneTransitions(const date::time_zone& zone)
+    : zone_(zone) {
+  constexpr int64_t kEnd = kMaxSeconds + kMargin;
+  auto begin = kMinSeconds - kMargin;
+  while (begin < kEnd) {
+    const auto info =
+        zone.get_info(date::sys_seconds(std::chrono::seconds(begin)));
+    const int32_t offset = info.offset.count();
+    // Intervals that differ in abbreviation or daylight saving but not in
+    // offset are merged.
+    if (offsets_.empty() || offsets_.back() != offset) {
+      utcBegins_.push_back(begin);
+      localBegins_.push_back(begin + offset);
+      offsets_.push_back(offset);
+    }
+    const auto end = info.end.time_since_epoch().count();
+    VELOX_CHECK_GT(end, begin, "Bad time zone interval in {}", zone.name());
+    begin = std::min(end, kEnd);
+  }
+  utcBegins_.push_back(kEnd);
+
+  // The table finds the interval of a local time by its start. Zones where
+  // the starts are not in order, if any, are converted by the zone itself.
+  if (!std::is_sorted(localBegins_.begin(), localBegins_.end())) {
+    utcBegins_.clear();
+    localBegins_.clear();
+    offsets_.clear();
+  }
+}
+
+// static
+const TimeZoneTransitions& TimeZoneTransitions::get(
+    const date::time_zone& zone) {
+  thread_local const TimeZoneTransitions* last = nullptr;
+  if (last != nullptr && &last->zone() == &zone) {
+    return *last;
+  }
+  last = &getLocked(*tableCache().wlock(), &zone);
+  return *last;
+}
+
+// static
+const TimeZoneTransitions& TimeZoneTransitions::get(int64_t timeZoneID) {
+  thread_local int64_t lastId = -1;
+  thread_local const TimeZoneTransitions* last = nullptr;
+  if (last != nullptr && lastId == timeZoneID) {
+    return *last;
+  }
+  // Resolves the name before locking: the tz database has its own locking.
+  const TimeZoneTransitions* table = nullptr;
+  tableCache().withRLock([&](const auto& cache) {
+    auto it = cache.byId.find(timeZoneID);
+    if (it != cache.byId.end()) {
+      table = it->second;
+    }
+  });
+  if (table == nullptr) {
+    const auto* zone = date::locate_zone(getTimeZoneName(timeZoneID));
+    auto cache = tableCache().wlock();
+    table = &getLocked(*cache, zone);
+    cache->byId[timeZoneID] = table;
+  }
+  lastId = timeZoneID;
+  last = table;
+  return *table;
+}
+
+bool TimeZoneTransitions::offsetAtUtc(int64_t utcSeconds, int64_t& offset)
+    const {
+  if (utcSeconds < kMinSeconds || utcSeconds >= kMaxSeconds ||
+      offsets_.empty()) {
+    return false;
+  }
+  const auto it =
+      std::upper_bound(utcBegins_.begin(), utcBegins_.end(), utcSeconds);
+  offset = offsets_[it - utcBegins_.begin() - 1];
+  return true;
+}
+
+bool TimeZoneTransitions::toUtc(int64_t localSeconds, int64_t& utcSeconds)
+    const {
+  if (localSeconds < kMinSeconds || localSeconds >= kMaxSeconds ||
+      offsets_.empty()) {
+    return false;
+  }
+  // The last interval that starts at or before 'localSeconds' is the later
+  // one if the local time is ambiguous.
+  const auto i = std::upper_bound(
+                     localBegins_.begin(), localBegins_.end(), localSeconds) -
+      localBegins_.begin() - 1;
+  const auto utc = localSeconds - offsets_[i];
+  // The local time was skipped if it is past the end of the interval.
+  utcSeconds = std::min(utc, utcBegins_[i + 1]);
+  return true;
+}
+
+} // namespace facebook::velox::util
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace date {
+class time_zone;
+} // namespace date
+
+namespace facebook::velox::util {
+
+/// The UTC offsets of a time zone between 1900 and 2100 as a sorted table of
+/// transitions, built once per zone from the tz database and kept for the
+/// lifetime of the process. Converts timestamps in this range with a binary
+/// search over the table, without the locks and the sys_info construction of
+/// date::time_zone. Times outside the range are converted by the zone itself.
+class TimeZoneTransitions {
+ public:
+  /// The first and last second, local or UTC, converted using the table.
+  static constexpr int64_t kMinSeconds = -2'208'988'800; // 1900-01-01
+  static constexpr int64_t kMaxSeconds = 4'102'444'800; // 2100-01-01
+
+  explicit TimeZoneTransitions(const date::time_zone& zone);
+
+  /// Returns the table of 'zone'. Returns the table of the previous call of
+  /// the same thread without locking if 'zone' is the same.
+  static const TimeZoneTransitions& get(const date::time_zone& zone);
+
+  /// Returns the table of the zone with Presto time zone id 'timeZoneID'.
+  /// Throws if the id is not known or is a fixed offset rather than a zone.
+  static const TimeZoneTransitions& get(int64_t timeZoneID);
+
+  const date::time_zone& zone() const {
+    return zone_;
+  }
+
+  /// Returns true if 'utcSeconds' is in the range of the table and sets
+  /// 'offset' to the offset of the zone at that time.
+  bool offsetAtUtc(int64_t utcSeconds, int64_t& offset) const;
+
+  /// Returns true if 'localSeconds' is in the range of the table and sets
+  /// 'utcSeconds' to the corresponding UTC time. Resolves local times like
+  /// date::time_zone::to_sys() with date::choose::latest: an ambiguous local
+  /// time maps to the later of its UTC times and a local time skipped by a
+  /// transition maps to the transition.
+  bool toUtc(int64_t localSeconds, int64_t& utcSeconds) const;
+
+  /// Number of intervals of constant offset in the table.
+  int32_t numIntervals() const {
+    return offsets_.size();
+  }
+
+ private:
+  const date::time_zone& zone_;
+
+  // Interval i starts at utcBegins_[i] and ends at utcBegins_[i + 1], which
+  // has one more element than 'offsets_'. The zone has offset offsets_[i]
+  // during the interval, which starts at local time localBegins_[i].
+  std::vector<int64_t> utcBegins_;
+  std::vector<int64_t> localBegins_;
+  std::vector<int32_t> offsets_;
+};
+
+} // namespace facebook::velox::util
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+
+#include "velox/external/date/tz.h"
+#include "velox/type/tz/TimeZoneMap.h"
+#include "velox/type/tz/TimeZoneTransitions.h"
+
+namespace facebook::velox::util {
+namespace {
+
+// Checks the table of 'zoneName' against the tz database every 'step'
+// seconds of its range and around each of its transitions.
+void testZone(const std::string& zoneName, int64_t step) {
+  const auto* zone = date::locate_zone(zoneName);
+  const auto& table = TimeZoneTransitions::get(*zone);
+  EXPECT_EQ(&table.zone(), zone);
+  EXPECT_EQ(&table, &TimeZoneTransitions::get(*zone));
+
+  auto expectSame = [&](int64_t seconds) {
+    int64_t offset;
+    ASSERT_TRUE(table.offsetAtUtc(seconds, offset));
+    EXPECT_EQ(
+        zone->get_info(date::sys_seconds(std::chrono::seconds(seconds)))
+            .offset.count(),
+        offset)
+        << zoneName << " " << seconds;
+
+    int64_t utc;
+    ASSERT_TRUE(table.toUtc(seconds, utc));
+    EXPECT_EQ(
+        zone->to_sys(
+                date::local_seconds(std::chrono::seconds(seconds)),
+                date::choose::latest)
+            .time_since_epoch()
+            .count(),
+        utc)
+        << zoneName << " " << seconds;
+  };
+
+  for (auto seconds = TimeZoneTransitions::kMinSeconds;
+       seconds < TimeZoneTransitions::kMaxSeconds;
+       seconds += step) {
+    expectSame(seconds);
+  }
+
+  auto info = zone->get_info(date::sys_seconds(
+      std::chrono::seconds(TimeZoneTransitions::kMinSeconds)));
+  while (info.end.time_since_epoch().count() <
+         TimeZoneTransitions::kMaxSeconds - 7'200) {
+    const auto transition = info.end.time_since_epoch().count();
+    for (auto delta = -7'200; delta <= 7'200; delta += 900) {
+      expectSame(transition + delta);
+    }
+    info = zone->get_info(info.end);
+  }
+}
+
+TEST(TimeZoneTransitionsTest, zones) {
+  for (const auto* zoneName :
+       {"America/Los_Angeles",
+        "America/Sao_Paulo",
+        "Europe/Moscow",
+        "Asia/Kolkata",
+        "Australia/Lord_Howe",
+        "Pacific/Apia",
+        "UTC"}) {
+    testZone(zoneName, 3'600 * 7 + 13);
+  }
+}
+
+TEST(TimeZoneTransitionsTest, dst) {
+  const auto& table =
+      TimeZoneTransitions::get(*date::locate_zone("America/Los_Angeles"));
+  EXPECT_GT(table.numIntervals(), 2 * 100);
+
+  // 2021-03-14 02:30 does not exist and maps to the transition at 10:00 UTC.
+  int64_t utc;
+  ASSERT_TRUE(table.toUtc(1615689000, utc));
+  EXPECT_EQ(1615716000, utc);
+
+  // 2021-11-07 01:30 is ambiguous and maps to the later time, in PST.
+  ASSERT_TRUE(table.toUtc(1636248600, utc));
+  EXPECT_EQ(1636277400, utc);
+
+  int64_t offset;
+  ASSERT_TRUE(table.offsetAtUtc(1636277400, offset));
+  EXPECT_EQ(-8 * 3'600, offset);
+  ASSERT_TRUE(table.offsetAtUtc(1636277400 - 3'601, offset));
+  EXPECT_EQ(-7 * 3'600, offset);
+}
+
+TEST(TimeZoneTransitionsTest, outOfRange) {
+  const auto& table = TimeZoneTransitions::get(*date::locate_zone("UTC"));
+  int64_t result;
+  EXPECT_FALSE(
+      table.offsetAtUtc(TimeZoneTransitions::kMinSeconds - 1, result));
+  EXPECT_FALSE(table.toUtc(TimeZoneTransitions::kMaxSeconds, result));
+}
+
+TEST(TimeZoneTransitionsTest, timeZoneId) {
+  const auto& table = TimeZoneTransitions::get(1825);
+  EXPECT_EQ("America/Los_Angeles", table.zone().name());
+  EXPECT_EQ(&table, &TimeZoneTransitions::get(1825));
+  EXPECT_EQ(
+      &table,
+      &TimeZoneTransitions::get(*date::locate_zone("America/Los_Angeles")));
+  EXPECT_THROW(TimeZoneTransitions::get(99999999), std::runtime_error);
+}
+
+} // namespace
+} // namespace facebook::velox::util
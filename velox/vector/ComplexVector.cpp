@@ -483,36 +483,64 @@ void ArrayVectorBase::copyRangesImpl(
       totalCount += range.count;
     }
     outRanges.reserve(totalCount);
+    // A flat source needs no per-row virtual calls: its nulls are copied a
+    // range at a time and its offsets and sizes are read directly.
+    const bool isFlatSource = source == sourceValue;
+    const uint64_t* sourceNulls = isFlatSource ? source->rawNulls() : nullptr;
+    uint64_t* targetNulls =
+        isFlatSource && setNotNulls ? mutableRawNulls() : nullptr;
+    const auto* sourceOffsets = sourceArray->rawOffsets();
+    const auto* sourceSizes = sourceArray->rawSizes();
     for (auto& range : ranges) {
-      for (vector_size_t i = 0; i < range.count; ++i) {
-        if (source->isNullAt(range.sourceIndex + i)) {
-          setNull(range.targetIndex + i, true);
+      if (targetNulls) {
+        if (sourceNulls) {
+          bits::copyBits(
+              sourceNulls,
+              range.sourceIndex,
+              targetNulls,
+              range.targetIndex,
+              range.count);
         } else {
-          if (setNotNulls) {
-            setNull(range.targetIndex + i, false);
+          bits::fillBits(
+              targetNulls,
+              range.targetIndex,
+              range.targetIndex + range.count,
+              bits::kNotNull);
+        }
+      }
+      for (vector_size_t i = 0; i < range.count; ++i) {
+        const auto sourceIndex = range.sourceIndex + i;
+        if (isFlatSource) {
+          if (sourceNulls && bits::isBitNull(sourceNulls, sourceIndex)) {
+            continue;
           }
-          vector_size_t wrappedIndex =
-              source->wrappedIndex(range.sourceIndex + i);
-          vector_size_t copySize = sourceArray->sizeAt(wrappedIndex);
-
-          if (copySize > 0) {
-            auto copyOffset = sourceArray->offsetAt(wrappedIndex);
-
-            // If we're copying two adjacent ranges, merge them.  This only
-            // works if they're consecutive.
-            if (!outRanges.empty() &&
-                (outRanges.back().sourceIndex + outRanges.back().count ==
-                 copyOffset)) {
-              outRanges.back().count += copySize;
-            } else {
-              outRanges.push_back({copyOffset, childSize, copySize});
-            }
+        } else if (source->isNullAt(sourceIndex)) {
+          setNull(range.targetIndex + i, true);
+          continue;
+        } else if (setNotNulls) {
+          setNull(range.targetIndex + i, false);
+        }
+        const vector_size_t wrappedIndex =
+            isFlatSource ? sourceIndex : source->wrappedIndex(sourceIndex);
+        const vector_size_t copySize = sourceSizes[wrappedIndex];
+
+        if (copySize > 0) {
+          const auto copyOffset = sourceOffsets[wrappedIndex];
+
+          // If we're copying two adjacent ranges, merge them.  This only
+          // works if they're consecutive.
+          if (!outRanges.empty() &&
+              (outRanges.back().sourceIndex + outRanges.back().count ==
+               copyOffset)) {
+            outRanges.back().count += copySize;
+          } else {
+            outRanges.push_back({copyOffset, childSize, copySize});
           }
-
-          mutableOffsets[range.targetIndex + i] = childSize;
-          mutableSizes[range.targetIndex + i] = copySize;
-          childSize += copySize;
         }
+
+        mutableOffsets[range.targetIndex + i] = childSize;
+        mutableSizes[range.targetIndex + i] = copySize;
+        childSize += copySize;
       }
     }
 
@@ -286,6 +286,13 @@ void FlatVector<T>::copyValuesAndNulls(
       bits::fillBits(
           rawNulls, targetIndex, targetIndex + count, bits::kNotNull);
     }
+  } else if (
+      source->encoding() == VectorEncoding::Simple::DICTIONARY &&
+      source->typeKind() != TypeKind::UNKNOWN &&
+      source->valueVector()->isFlatEncoding() &&
+      source->valueVector()->values()) {
+    copyFromDictionaryOverFlat(
+        source, targetIndex, sourceIndex, count, rawNulls);
   } else {
     auto sourceVector = source->asUnchecked<SimpleVector<T>>();
     for (int32_t i = 0; i < count; ++i) {
@@ -301,6 +308,61 @@ void FlatVector<T>::copyValuesAndNulls(
   }
 }
 
+template <typename T>
+void FlatVector<T>::copyFromDictionaryOverFlat(
+    const BaseVector* source,
+    vector_size_t targetIndex,
+    vector_size_t sourceIndex,
+    vector_size_t count,
+    uint64_t* rawNulls) {
+  const auto indicesBuffer = source->wrapInfo();
+  const auto* indices = indicesBuffer->as<vector_size_t>() + sourceIndex;
+  const auto* base = source->valueVector()->asUnchecked<FlatVector<T>>();
+  const T* baseValues = base->rawValues();
+  const uint64_t* baseNulls = base->rawNulls();
+  // Nulls added by the dictionary. The indices of these rows may be
+  // arbitrary, so the values are gathered only for the non-null rows.
+  const uint64_t* wrapNulls = source->rawNulls();
+  T* target = rawValues_ + targetIndex;
+
+  if (!wrapNulls) {
+    vector_size_t i = 0;
+    if constexpr (
+        std::is_arithmetic_v<T> && (sizeof(T) == 4 || sizeof(T) == 8)) {
+      constexpr vector_size_t kBatchSize = xsimd::batch<T>::size;
+      for (; i + kBatchSize <= count; i += kBatchSize) {
+        simd::gather(baseValues, indices + i).store_unaligned(target + i);
+      }
+    }
+    for (; i < count; ++i) {
+      target[i] = baseValues[indices[i]];
+    }
+  } else {
+    for (vector_size_t i = 0; i < count; ++i) {
+      if (!bits::isBitNull(wrapNulls, sourceIndex + i)) {
+        target[i] = baseValues[indices[i]];
+      }
+    }
+  }
+
+  if (!rawNulls) {
+    return;
+  }
+  if (wrapNulls) {
+    bits::copyBits(wrapNulls, sourceIndex, rawNulls, targetIndex, count);
+  } else {
+    bits::fillBits(rawNulls, targetIndex, targetIndex + count, bits::kNotNull);
+  }
+  if (baseNulls) {
+    for (vector_size_t i = 0; i < count; ++i) {
+      if (!bits::isBitNull(rawNulls, targetIndex + i) &&
+          bits::isBitNull(baseNulls, indices[i])) {
+        bits::setNull(rawNulls, targetIndex + i);
+      }
+    }
+  }
+}
+
 template <typename T>
 VectorPtr FlatVector<T>::slice(vector_size_t offset, vector_size_t length)
     const {
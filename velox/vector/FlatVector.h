@@ -442,6 +442,16 @@ class FlatVector final : public SimpleVector<T> {
       vector_size_t sourceIndex,
       vector_size_t count);
 
+  // Copies 'count' rows of a dictionary 'source' over a flat base by gathering
+  // the base values at the dictionary indices. 'rawNulls' is the mutable nulls
+  // buffer of 'this' or nullptr if neither 'this' nor 'source' has nulls.
+  void copyFromDictionaryOverFlat(
+      const BaseVector* source,
+      vector_size_t targetIndex,
+      vector_size_t sourceIndex,
+      vector_size_t count,
+      uint64_t* rawNulls);
+
   // Ensures that the values buffer has space for 'newSize' elements and is
   // mutable. Sets elements between the old and new sizes to 'initialValue' if
   // the new size > old size.
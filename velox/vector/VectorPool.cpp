@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/vector/VectorPool.h"
+#include "velox/vector/ComplexVector.h"
 
 namespace facebook::velox {
 
@@ -47,12 +48,40 @@ FOLLY_ALWAYS_INLINE int32_t toCacheIndex(const TypePtr& type) {
 
   return -1;
 }
+
+FOLLY_ALWAYS_INLINE bool isComplexKind(TypeKind kind) {
+  return kind == TypeKind::ROW || kind == TypeKind::ARRAY ||
+      kind == TypeKind::MAP;
+}
 } // namespace
 
+VectorPool::TypePool* VectorPool::complexTypePool(
+    const TypePtr& type,
+    bool create) {
+  auto it = complexVectors_.find(type);
+  if (it != complexVectors_.end()) {
+    return &it->second;
+  }
+  if (!create || complexVectors_.size() >= kMaxComplexTypes) {
+    return nullptr;
+  }
+  return &complexVectors_[type];
+}
+
 VectorPtr VectorPool::get(const TypePtr& type, vector_size_t size) {
-  auto cacheIndex = toCacheIndex(type);
-  if (cacheIndex >= 0 && size <= kMaxRecycleSize) {
-    return vectors_[cacheIndex].pop(type, size, *pool_);
+  if (size <= kMaxRecycleSize) {
+    const auto cacheIndex = toCacheIndex(type);
+    if (cacheIndex >= 0 || isComplexKind(type->kind())) {
+      ++stats_.numGets;
+      auto* typePool = cacheIndex >= 0 ? &vectors_[cacheIndex]
+                                       : complexTypePool(type, false);
+      if (typePool) {
+        if (typePool->size > 0) {
+          ++stats_.numReused;
+        }
+        return typePool->pop(type, size, *pool_);
+      }
+    }
   }
   return BaseVector::create(type, size, pool_);
 }
@@ -65,11 +94,21 @@ bool VectorPool::release(VectorPtr& vector) {
     return false;
   }
 
+  TypePool* typePool = nullptr;
   auto cacheIndex = toCacheIndex(vector->type());
-  if (cacheIndex < 0) {
+  if (cacheIndex >= 0) {
+    typePool = &vectors_[cacheIndex];
+  } else if (isComplexKind(vector->typeKind())) {
+    if (vector->retainedSize() > kMaxComplexRetainedBytes) {
+      return false;
+    }
+    typePool = complexTypePool(vector->type(), true);
+  }
+  if (typePool == nullptr || !typePool->maybePushBack(vector)) {
     return false;
   }
-  return vectors_[cacheIndex].maybePushBack(vector);
+  ++stats_.numReleased;
+  return true;
 }
 
 size_t VectorPool::release(std::vector<VectorPtr>& vectors) {
@@ -86,10 +125,24 @@ size_t VectorPool::release(std::vector<VectorPtr>& vectors) {
 
 bool VectorPool::TypePool::maybePushBack(VectorPtr& vector) {
   // Check that this is a Flat Vector with an initialized, unique, and mutable
-  // values Buffer and an uninitialized or unique and mutable nulls Buffer.
-  if (!vector->isWritable() || !vector->isFlatEncoding() || !vector->values()) {
+  // values Buffer and an uninitialized or unique and mutable nulls Buffer, or
+  // a recursively writable Row, Array or Map Vector.
+  if (!vector->isWritable()) {
     return false;
   }
+  switch (vector->encoding()) {
+    case VectorEncoding::Simple::FLAT:
+      if (!vector->values()) {
+        return false;
+      }
+      break;
+    case VectorEncoding::Simple::ROW:
+    case VectorEncoding::Simple::ARRAY:
+    case VectorEncoding::Simple::MAP:
+      break;
+    default:
+      return false;
+  }
   if (size >= kNumPerType) {
     return false;
   }
@@ -123,6 +176,15 @@ VectorPtr VectorPool::TypePool::pop(
     if (result->size() != vectorSize) {
       result->resize(vectorSize);
     }
+    if (result->encoding() == VectorEncoding::Simple::ROW) {
+      // Children are reset to size 0 on release. Size them like
+      // BaseVector::create does.
+      for (auto& child : result->asUnchecked<RowVector>()->children()) {
+        if (child && child->size() != vectorSize) {
+          child->resize(vectorSize);
+        }
+      }
+    }
     return result;
   }
   return BaseVector::create(type, vectorSize, &pool);
@@ -20,33 +20,54 @@
 
 namespace facebook::velox {
 
-/// A thread-level cache of pre-allocated flat vectors of different types.
+/// A thread-level cache of pre-allocated vectors of different types.
 /// Keeps up to 10 recyclable vectors of each type. A vector is
-/// recyclable if it is flat and recursively singly-referenced.
-/// Only singleton built-in types are supported. Decimal types, fixed-size array
-/// type, complex and custom types are not supported. Calling 'get' for an
-/// unsupported type already returns a newly allocated vector. Calling 'release'
-/// for an unsupported type is a no-op.
+/// recyclable if it is flat, or a row, array or map, and recursively
+/// singly-referenced. Flat vectors are cached for singleton built-in types.
+/// Row, array and map vectors are cached by type instance for up to 16
+/// distinct types. Their children and the first string buffer of string
+/// vectors are kept for reuse. Decimal types, fixed-size array type and
+/// custom types are not supported. Calling 'get' for an unsupported type
+/// returns a newly allocated vector. Calling 'release' for an unsupported type
+/// is a no-op.
 class VectorPool {
  public:
+  struct Stats {
+    /// Number of calls to 'get' for a supported type and size.
+    uint64_t numGets{0};
+    /// Number of calls to 'get' served with a recycled vector.
+    uint64_t numReused{0};
+    /// Number of vectors moved back into the pool.
+    uint64_t numReleased{0};
+  };
+
   explicit VectorPool(memory::MemoryPool* pool) : pool_{pool} {}
 
   /// Gets a possibly recycled vector of 'type and 'size'. Allocates from
-  /// 'pool_' if no pre-allocated vector or type is a complex type.
+  /// 'pool_' if no pre-allocated vector or type is not supported.
   VectorPtr get(const TypePtr& type, vector_size_t size);
 
-  /// Moves vector into 'this' if it is flat, recursively singly referenced and
-  /// there is space. The function returns true if 'vector' is not null and has
-  /// been returned back to this pool, otherwise returns false.
+  /// Moves vector into 'this' if it is recyclable and there is space. The
+  /// function returns true if 'vector' is not null and has been returned back
+  /// to this pool, otherwise returns false.
   bool release(VectorPtr& vector);
 
   size_t release(std::vector<VectorPtr>& vectors);
 
+  const Stats& stats() const {
+    return stats_;
+  }
+
  private:
   /// Max number of elements for a vector to be recyclable. The larger
   /// the batch the less the win from recycling.
   static constexpr vector_size_t kMaxRecycleSize = 64 * 1024;
   static constexpr int32_t kNumPerType = 10;
+  /// Max number of distinct row, array and map types to cache vectors for.
+  static constexpr int32_t kMaxComplexTypes = 16;
+  /// Max retained bytes of a recyclable row, array or map vector. Bounds the
+  /// memory held by nested children.
+  static constexpr uint64_t kMaxComplexRetainedBytes = 8 << 20;
 
   struct TypePool {
     int32_t size{0};
@@ -60,6 +81,10 @@ class VectorPool {
         memory::MemoryPool& pool);
   };
 
+  // Returns the pool for row, array or map 'type' or nullptr if 'type' is not
+  // cached and there is no space for it.
+  TypePool* complexTypePool(const TypePtr& type, bool create);
+
   memory::MemoryPool* const pool_;
 
   static constexpr int32_t kNumCachedVectorTypes =
@@ -67,6 +92,12 @@ class VectorPool {
 
   /// Caches of pre-allocated vectors indexed by typeKind.
   std::array<TypePool, kNumCachedVectorTypes> vectors_;
+
+  /// Caches of pre-allocated row, array and map vectors keyed on the type
+  /// instance.
+  folly::F14FastMap<TypePtr, TypePool> complexVectors_;
+
+  Stats stats_;
 };
 
 /// A simple vector ptr wrapper with an associated vector pool. It releases
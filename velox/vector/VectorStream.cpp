@@ -23,6 +23,29 @@ void VectorSerializer::append(const RowVectorPtr& vector) {
   append(vector, folly::Range(&allRows, 1));
 }
 
+void VectorSerde::appendScattered(
+    const RowVectorPtr& vector,
+    folly::Range<const uint32_t*> partitions,
+    folly::Range<VectorSerializer* const*> serializers) {
+  VELOX_CHECK_EQ(partitions.size(), vector->size());
+  std::vector<std::vector<IndexRange>> ranges(serializers.size());
+  for (vector_size_t row = 0; row < partitions.size(); ++row) {
+    auto& partitionRanges = ranges[partitions[row]];
+    if (!partitionRanges.empty() &&
+        partitionRanges.back().begin + partitionRanges.back().size == row) {
+      ++partitionRanges.back().size;
+    } else {
+      partitionRanges.push_back({row, 1});
+    }
+  }
+  for (auto i = 0; i < serializers.size(); ++i) {
+    if (!ranges[i].empty()) {
+      serializers[i]->append(
+          vector, folly::Range(ranges[i].data(), ranges[i].size()));
+    }
+  }
+}
+
 namespace {
 
 std::unique_ptr<VectorSerde>& getVectorSerdeImpl() {
@@ -110,6 +133,25 @@ void VectorStreamGroup::append(const RowVectorPtr& vector) {
   serializer_->append(vector);
 }
 
+// static
+void VectorStreamGroup::appendScattered(
+    const RowVectorPtr& vector,
+    folly::Range<const uint32_t*> partitions,
+    folly::Range<VectorStreamGroup* const*> groups) {
+  if (groups.empty()) {
+    return;
+  }
+  std::vector<VectorSerializer*> serializers;
+  serializers.reserve(groups.size());
+  for (auto* group : groups) {
+    VELOX_CHECK_EQ(group->serde_, groups[0]->serde_);
+    VELOX_CHECK_NOT_NULL(group->serializer_);
+    serializers.push_back(group->serializer_.get());
+  }
+  groups[0]->serde_->appendScattered(
+      vector, partitions, folly::Range(serializers.data(), serializers.size()));
+}
+
 void VectorStreamGroup::flush(OutputStream* out) {
   serializer_->flush(out);
 }
@@ -81,6 +81,16 @@ class VectorSerde {
       StreamArena* streamArena,
       const Options* options = nullptr) = 0;
 
+  /// Appends each row 'i' of 'vector' to 'serializers[partitions[i]]'.
+  /// 'serializers' must be created by this serde for the type of 'vector'. A
+  /// serde may serialize one column at a time into all the serializers, so
+  /// that the per column overhead is not paid once per serializer. The default
+  /// implementation appends the rows of each serializer separately.
+  virtual void appendScattered(
+      const RowVectorPtr& vector,
+      folly::Range<const uint32_t*> partitions,
+      folly::Range<VectorSerializer* const*> serializers);
+
   virtual void deserialize(
       ByteStream* source,
       velox::memory::MemoryPool* pool,
@@ -138,6 +148,14 @@ class VectorStreamGroup : public StreamArena {
 
   void append(const RowVectorPtr& vector);
 
+  /// Appends each row 'i' of 'vector' to 'groups[partitions[i]]'. All of
+  /// 'groups' must have a stream tree for the type of 'vector' and the same
+  /// serde. See VectorSerde::appendScattered.
+  static void appendScattered(
+      const RowVectorPtr& vector,
+      folly::Range<const uint32_t*> partitions,
+      folly::Range<VectorStreamGroup* const*> groups);
+
   // Writes the contents to 'stream' in wire format.
   void flush(OutputStream* stream);
 
@@ -756,6 +756,16 @@ TypePtr importFromArrow(const ArrowSchema& arrowSchema) {
     case 'Z':
       return VARBINARY();
 
+    // String and binary views.
+    case 'v':
+      if (format[1] == 'u') {
+        return VARCHAR();
+      }
+      if (format[1] == 'z') {
+        return VARBINARY();
+      }
+      break;
+
     case 't': // temporal types.
       // Mapping it to ttn for now.
       if (format[1] == 't' && format[2] == 'n') {
@@ -790,6 +800,15 @@ TypePtr importFromArrow(const ArrowSchema& arrowSchema) {
           VELOX_CHECK_NOT_NULL(arrowSchema.children[0]);
           return ARRAY(importFromArrow(*arrowSchema.children[0]));
 
+        // List view, i.e. a list with offsets and sizes like ArrayVector.
+        case 'v':
+          if (format[2] != 'l') {
+            break;
+          }
+          VELOX_CHECK_EQ(arrowSchema.n_children, 1);
+          VELOX_CHECK_NOT_NULL(arrowSchema.children[0]);
+          return ARRAY(importFromArrow(*arrowSchema.children[0]));
+
         // Map.
         case 'm': {
           VELOX_CHECK_EQ(arrowSchema.n_children, 1);
@@ -946,6 +965,97 @@ VectorPtr createStringFlatVector(
       optionalNullCount(nullCount));
 }
 
+// Layout of an element of an Arrow string or binary view array. Strings of up
+// to 12 bytes are inlined in the element, like in StringView. Longer strings
+// are in the data buffer 'bufferIndex' at 'offset'.
+struct ArrowStringView {
+  int32_t size;
+  char prefix[4];
+  int32_t bufferIndex;
+  int32_t offset;
+};
+
+static_assert(sizeof(ArrowStringView) == sizeof(StringView));
+static_assert(StringView::kInlineSize == 12);
+constexpr int32_t kArrowStringViewInlineSize = StringView::kInlineSize;
+
+// Imports an Arrow string or binary view array. The buffers are 'nulls', the
+// views, the data buffers and the sizes of the data buffers. The views are
+// wrapped as the StringViews of the vector if all strings are inlined.
+// Otherwise the views of the strings that are not inlined are converted to
+// StringViews pointing to the data buffers and only the views are copied.
+VectorPtr createStringViewFlatVector(
+    memory::MemoryPool* pool,
+    const TypePtr& type,
+    BufferPtr nulls,
+    const ArrowArray& arrowArray,
+    WrapInBufferViewFunc wrapInBufferView) {
+  VELOX_USER_CHECK_GE(
+      arrowArray.n_buffers,
+      3,
+      "Expecting at least three buffers as input for string view types.");
+  const auto length = arrowArray.length;
+  const auto* views =
+      static_cast<const ArrowStringView*>(arrowArray.buffers[1]);
+  bool allInline = true;
+  for (auto i = 0; i < length; ++i) {
+    if (views[i].size > kArrowStringViewInlineSize) {
+      allInline = false;
+      break;
+    }
+  }
+  if (allInline) {
+    return std::make_shared<FlatVector<StringView>>(
+        pool,
+        type,
+        nulls,
+        length,
+        wrapInBufferView(views, length * sizeof(StringView)),
+        std::vector<BufferPtr>(),
+        SimpleVectorStats<StringView>{},
+        std::nullopt,
+        optionalNullCount(arrowArray.null_count));
+  }
+
+  const auto numDataBuffers = arrowArray.n_buffers - 3;
+  const auto* dataBuffers =
+      reinterpret_cast<const char* const*>(arrowArray.buffers + 2);
+  const auto* dataBufferSizes = static_cast<const int64_t*>(
+      arrowArray.buffers[arrowArray.n_buffers - 1]);
+  std::vector<BufferPtr> stringViewBuffers;
+  stringViewBuffers.reserve(numDataBuffers);
+  for (auto i = 0; i < numDataBuffers; ++i) {
+    stringViewBuffers.push_back(
+        wrapInBufferView(dataBuffers[i], dataBufferSizes[i]));
+  }
+
+  BufferPtr stringViews = AlignedBuffer::allocate<StringView>(length, pool);
+  auto* rawStringViews = stringViews->asMutable<StringView>();
+  const auto* rawNulls = nulls ? nulls->as<uint64_t>() : nullptr;
+  for (auto i = 0; i < length; ++i) {
+    const auto& view = views[i];
+    if (rawNulls && bits::isBitNull(rawNulls, i)) {
+      rawStringViews[i] = StringView();
+    } else if (view.size <= kArrowStringViewInlineSize) {
+      std::memcpy(&rawStringViews[i], &view, sizeof(StringView));
+    } else {
+      VELOX_USER_CHECK_LT(view.bufferIndex, numDataBuffers);
+      rawStringViews[i] =
+          StringView(dataBuffers[view.bufferIndex] + view.offset, view.size);
+    }
+  }
+  return std::make_shared<FlatVector<StringView>>(
+      pool,
+      type,
+      nulls,
+      length,
+      stringViews,
+      std::move(stringViewBuffers),
+      SimpleVectorStats<StringView>{},
+      std::nullopt,
+      optionalNullCount(arrowArray.null_count));
+}
+
 VectorPtr importFromArrowImpl(
     ArrowSchema& arrowSchema,
     ArrowArray& arrowArray,
@@ -1019,6 +1129,36 @@ ArrayVectorPtr createArrayVector(
       optionalNullCount(arrowArray.null_count));
 }
 
+// Imports an Arrow list view, which has the offsets and sizes of ArrayVector.
+// Both are wrapped.
+ArrayVectorPtr createArrayVectorFromListView(
+    memory::MemoryPool* pool,
+    const TypePtr& type,
+    BufferPtr nulls,
+    const ArrowSchema& arrowSchema,
+    const ArrowArray& arrowArray,
+    bool isViewer,
+    WrapInBufferViewFunc wrapInBufferView) {
+  static_assert(sizeof(vector_size_t) == sizeof(int32_t));
+  VELOX_CHECK_EQ(arrowArray.n_buffers, 3);
+  VELOX_CHECK_EQ(arrowArray.n_children, 1);
+  auto offsets = wrapInBufferView(
+      arrowArray.buffers[1], arrowArray.length * sizeof(vector_size_t));
+  auto sizes = wrapInBufferView(
+      arrowArray.buffers[2], arrowArray.length * sizeof(vector_size_t));
+  auto elements = importFromArrowImpl(
+      *arrowSchema.children[0], *arrowArray.children[0], pool, isViewer);
+  return std::make_shared<ArrayVector>(
+      pool,
+      type,
+      std::move(nulls),
+      arrowArray.length,
+      std::move(offsets),
+      std::move(sizes),
+      std::move(elements),
+      optionalNullCount(arrowArray.null_count));
+}
+
 MapVectorPtr createMapVector(
     memory::MemoryPool* pool,
     const TypePtr& type,
@@ -1120,10 +1260,26 @@ VectorPtr importFromArrowImpl(
 
   // String data types (VARCHAR and VARBINARY).
   if (type->isVarchar() || type->isVarbinary()) {
+    if (arrowSchema.format[0] == 'v') {
+      return createStringViewFlatVector(
+          pool, type, nulls, arrowArray, wrapInBufferView);
+    }
     VELOX_USER_CHECK_EQ(
         arrowArray.n_buffers,
         3,
         "Expecting three buffers as input for string types.");
+    // Large strings and binaries have 64 bit offsets.
+    if (arrowSchema.format[0] == 'U' || arrowSchema.format[0] == 'Z') {
+      return createStringFlatVector(
+          pool,
+          type,
+          nulls,
+          arrowArray.length,
+          static_cast<const int64_t*>(arrowArray.buffers[1]), // offsets
+          static_cast<const char*>(arrowArray.buffers[2]), // values
+          arrowArray.null_count,
+          wrapInBufferView);
+    }
     return createStringFlatVector(
         pool,
         type,
@@ -1145,6 +1301,16 @@ VectorPtr importFromArrowImpl(
         isViewer);
   }
   if (type->isArray()) {
+    if (arrowSchema.format[1] == 'v') {
+      return createArrayVectorFromListView(
+          pool,
+          type,
+          nulls,
+          arrowSchema,
+          arrowArray,
+          isViewer,
+          wrapInBufferView);
+    }
     return createArrayVector(
         pool, type, nulls, arrowSchema, arrowArray, isViewer, wrapInBufferView);
   }
@@ -109,6 +109,13 @@ TypePtr importFromArrow(const ArrowSchema& arrowSchema);
 /// allocations are required, unless for arrays of varchars (or varbinaries) and
 /// complex types written out of order.
 ///
+/// String data is never copied: the StringViews of strings, large strings and
+/// binaries point into the Arrow data buffer, and string and binary views
+/// ('vu' and 'vz') are wrapped as they are if all strings are inlined, and
+/// converted to StringViews into the Arrow data buffers otherwise. The
+/// offsets of lists and maps are wrapped and list views ('+vl') are wrapped
+/// as the offsets and sizes of an ArrayVector.
+///
 /// The new Velox vector returned contains only references to the underlying
 /// buffers, so it's the client's responsibility to ensure the buffer's
 /// lifetime.
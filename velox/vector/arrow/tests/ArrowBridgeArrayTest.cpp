@@ -928,6 +928,167 @@ class ArrowBridgeArrayImportTest : public ArrowBridgeArrayExportTest {
         });
   }
 
+  void testImportLargeString() {
+    std::vector<std::optional<std::string>> inputValues = {
+        "short", std::nullopt, "a string which is not inlined", ""};
+    const int64_t length = inputValues.size();
+    ArrowContextHolder holder;
+    holder.nulls = AlignedBuffer::allocate<uint64_t>(length, pool_.get());
+    holder.offsets = AlignedBuffer::allocate<int64_t>(length + 1, pool_.get());
+    auto rawNulls = holder.nulls->asMutable<uint64_t>();
+    auto rawOffsets = holder.offsets->asMutable<int64_t>();
+    std::string data;
+    int64_t nullCount = 0;
+    rawOffsets[0] = 0;
+    for (auto i = 0; i < length; ++i) {
+      if (inputValues[i].has_value()) {
+        bits::clearNull(rawNulls, i);
+        data += *inputValues[i];
+      } else {
+        bits::setNull(rawNulls, i);
+        ++nullCount;
+      }
+      rawOffsets[i + 1] = data.size();
+    }
+    holder.buffers[0] = rawNulls;
+    holder.buffers[1] = rawOffsets;
+    holder.buffers[2] = data.data();
+
+    auto arrowArray = makeArrowArray(holder.buffers, 3, length, nullCount);
+    auto arrowSchema = makeArrowSchema("U");
+    auto output = importFromArrow(arrowSchema, arrowArray, pool_.get());
+    ASSERT_EQ(*output->type(), *VARCHAR());
+    assertVectorContent(inputValues, output, nullCount);
+  }
+
+  // Imports 'inputValues' as a string view array. Puts the strings that are
+  // not inlined alternately in 2 data buffers.
+  void testImportStringView(
+      const char* format,
+      const std::vector<std::optional<std::string>>& inputValues) {
+    struct View {
+      int32_t size;
+      char prefix[4];
+      int32_t bufferIndex;
+      int32_t offset;
+    };
+    static_assert(sizeof(View) == 16);
+
+    const int64_t length = inputValues.size();
+    auto nulls = AlignedBuffer::allocate<uint64_t>(length, pool_.get());
+    auto views = AlignedBuffer::allocate<View>(length, pool_.get());
+    auto rawNulls = nulls->asMutable<uint64_t>();
+    auto rawViews = views->asMutable<View>();
+    std::string data[2];
+    int64_t nullCount = 0;
+    bool allInline = true;
+    for (auto i = 0; i < length; ++i) {
+      auto& view = rawViews[i];
+      std::memset(&view, 0, sizeof(View));
+      if (!inputValues[i].has_value()) {
+        bits::setNull(rawNulls, i);
+        ++nullCount;
+        continue;
+      }
+      bits::clearNull(rawNulls, i);
+      const auto& value = *inputValues[i];
+      view.size = value.size();
+      if (value.size() <= 12) {
+        // Inlined strings take the place of the prefix, buffer index and
+        // offset.
+        std::memcpy(
+            reinterpret_cast<char*>(&view) + sizeof(int32_t),
+            value.data(),
+            value.size());
+        continue;
+      }
+      allInline = false;
+      std::memcpy(view.prefix, value.data(), 4);
+      view.bufferIndex = i % 2;
+      view.offset = data[i % 2].size();
+      data[i % 2] += value;
+    }
+    const int64_t dataSizes[2] = {
+        (int64_t)data[0].size(), (int64_t)data[1].size()};
+    const void* buffers[5] = {
+        rawNulls, rawViews, data[0].data(), data[1].data(), dataSizes};
+
+    auto arrowArray = makeArrowArray(buffers, 5, length, nullCount);
+    auto arrowSchema = makeArrowSchema(format);
+    auto output = importFromArrow(arrowSchema, arrowArray, pool_.get());
+    assertVectorContent(inputValues, output, nullCount);
+    if (length == 0) {
+      return;
+    }
+
+    auto* flat = output->asFlatVector<StringView>();
+    if (allInline) {
+      // The views are wrapped.
+      EXPECT_EQ(flat->rawValues(), reinterpret_cast<StringView*>(rawViews));
+      EXPECT_TRUE(flat->stringBuffers().empty());
+    } else {
+      // The data buffers are wrapped.
+      ASSERT_EQ(flat->stringBuffers().size(), 2);
+      EXPECT_EQ(flat->stringBuffers()[0]->as<char>(), data[0].data());
+      EXPECT_EQ(flat->stringBuffers()[1]->as<char>(), data[1].data());
+    }
+  }
+
+  void testImportStringView() {
+    testImportStringView("vu", {});
+    testImportStringView("vu", {"inlined", std::nullopt, "", "twelve bytes"});
+    testImportStringView(
+        "vu",
+        {
+            "hello world",
+            "larger string which should not be inlined...",
+            std::nullopt,
+            "thirteen byte",
+            "another larger string which is not inlined",
+            "",
+        });
+    testImportStringView(
+        "vz", {std::nullopt, "varbinary which is not inlined", "a"});
+  }
+
+  void testImportListView() {
+    ArrowContextHolder elementsHolder;
+    auto elements = fillArrowArray(
+        std::vector<std::optional<int32_t>>{5, 9, 9, 1, 2}, elementsHolder);
+
+    // [1, 2], null, [], [5]. The elements are not in the order of the lists.
+    auto nulls = AlignedBuffer::allocate<bool>(4, pool_.get(), bits::kNotNull);
+    bits::setNull(nulls->asMutable<uint64_t>(), 1);
+    auto offsets = makeBuffer<int32_t>({3, 0, 0, 0});
+    auto sizes = makeBuffer<int32_t>({2, 0, 0, 1});
+    const void* buffers[3] = {
+        nulls->as<void>(), offsets->as<void>(), sizes->as<void>()};
+    auto arrowArray = makeArrowArray(buffers, 3, 4, 1);
+    ArrowArray* children[1] = {&elements};
+    arrowArray.n_children = 1;
+    arrowArray.children = children;
+
+    auto elementsSchema = makeArrowSchema("i");
+    auto arrowSchema = makeArrowSchema("+vl");
+    ArrowSchema* childSchemas[1] = {&elementsSchema};
+    arrowSchema.n_children = 1;
+    arrowSchema.children = childSchemas;
+
+    auto output = importFromArrow(arrowSchema, arrowArray, pool_.get());
+    ASSERT_EQ(*output->type(), *ARRAY(INTEGER()));
+    auto expected = vectorMaker_.arrayVectorNullable<int32_t>(
+        {{{1, 2}}, std::nullopt, {{}}, {{5}}});
+    ASSERT_EQ(output->size(), expected->size());
+    for (auto i = 0; i < expected->size(); ++i) {
+      EXPECT_TRUE(expected->equalValueAt(output.get(), i, i));
+    }
+
+    // The offsets and sizes are wrapped.
+    auto* arrays = output->as<ArrayVector>();
+    EXPECT_EQ(arrays->rawOffsets(), offsets->as<vector_size_t>());
+    EXPECT_EQ(arrays->rawSizes(), sizes->as<vector_size_t>());
+  }
+
  private:
   void testImportRowFull() {
     // Manually create a ROW type.
@@ -1184,6 +1345,18 @@ TEST_F(ArrowBridgeArrayImportAsViewerTest, string) {
   testImportString();
 }
 
+TEST_F(ArrowBridgeArrayImportAsViewerTest, largeString) {
+  testImportLargeString();
+}
+
+TEST_F(ArrowBridgeArrayImportAsViewerTest, stringView) {
+  testImportStringView();
+}
+
+TEST_F(ArrowBridgeArrayImportAsViewerTest, listView) {
+  testImportListView();
+}
+
 TEST_F(ArrowBridgeArrayImportAsViewerTest, row) {
   testImportRow();
 }
@@ -1231,6 +1404,18 @@ TEST_F(ArrowBridgeArrayImportAsOwnerTest, string) {
   testImportString();
 }
 
+TEST_F(ArrowBridgeArrayImportAsOwnerTest, largeString) {
+  testImportLargeString();
+}
+
+TEST_F(ArrowBridgeArrayImportAsOwnerTest, stringView) {
+  testImportStringView();
+}
+
+TEST_F(ArrowBridgeArrayImportAsOwnerTest, listView) {
+  testImportListView();
+}
+
 TEST_F(ArrowBridgeArrayImportAsOwnerTest, row) {
   testImportRow();
 }
@@ -347,6 +347,86 @@ BENCHMARK_MULTI(copyStructNonContiguous) {
   return kIter * kSize;
 }
 
+BENCHMARK_MULTI(copyBigintDictionaryEncoded) {
+  folly::BenchmarkSuspender suspender;
+  std::shared_ptr<memory::MemoryPool> pool{memory::addDefaultLeafMemoryPool()};
+  test::VectorMaker vectorMaker{pool.get()};
+
+  const vector_size_t size = 10'000;
+  auto values =
+      vectorMaker.flatVector<int64_t>(size, [](auto row) { return row; });
+  auto indices = makeIndices(
+      size, pool.get(), [size](auto row) { return (row * 13) % size; });
+  auto dictionary =
+      BaseVector::wrapInDictionary(BufferPtr(nullptr), indices, size, values);
+  SelectivityVector selected(size);
+  suspender.dismiss();
+
+  return runBenchmark(dictionary, selected, BIGINT(), pool.get());
+}
+
+BENCHMARK_MULTI(copyBigintDictionaryEncodedWithNulls) {
+  folly::BenchmarkSuspender suspender;
+  std::shared_ptr<memory::MemoryPool> pool{memory::addDefaultLeafMemoryPool()};
+  test::VectorMaker vectorMaker{pool.get()};
+
+  const vector_size_t size = 10'000;
+  auto values = vectorMaker.flatVector<int64_t>(
+      size, [](auto row) { return row; }, test::VectorMaker::nullEvery(7));
+  auto indices = makeIndices(
+      size, pool.get(), [size](auto row) { return (row * 13) % size; });
+  auto dictionary =
+      BaseVector::wrapInDictionary(BufferPtr(nullptr), indices, size, values);
+  SelectivityVector selected(size);
+  suspender.dismiss();
+
+  return runBenchmark(dictionary, selected, BIGINT(), pool.get());
+}
+
+BENCHMARK_MULTI(copyVarcharDictionaryEncoded) {
+  folly::BenchmarkSuspender suspender;
+  std::shared_ptr<memory::MemoryPool> pool{memory::addDefaultLeafMemoryPool()};
+  test::VectorMaker vectorMaker{pool.get()};
+
+  const vector_size_t size = 10'000;
+  std::string string(50, 'x');
+  auto values = vectorMaker.flatVector<StringView>(
+      size, [&](auto) { return StringView(string); });
+  auto indices = makeIndices(
+      size, pool.get(), [size](auto row) { return (row * 13) % size; });
+  auto dictionary =
+      BaseVector::wrapInDictionary(BufferPtr(nullptr), indices, size, values);
+  SelectivityVector selected(size);
+  suspender.dismiss();
+
+  return runBenchmark(dictionary, selected, VARCHAR(), pool.get());
+}
+
+BENCHMARK_MULTI(copyArrayNonContiguous) {
+  folly::BenchmarkSuspender suspender;
+  std::shared_ptr<memory::MemoryPool> pool{memory::addDefaultLeafMemoryPool()};
+  test::VectorMaker vectorMaker{pool.get()};
+  constexpr vector_size_t kSize = 2'000;
+  auto source = vectorMaker.arrayVector<int32_t>(
+      kSize,
+      [](auto row) { return row % 10; },
+      [](auto row) { return row % 23; },
+      [](auto row) { return row % 13 == 0; });
+  BaseVector::CopyRange ranges[kSize / 4];
+  for (int i = 0; i < kSize; i += 4) {
+    ranges[i / 4] = {i, i / 2, 2};
+  }
+  suspender.dismiss();
+  constexpr int kIter = 100;
+  for (int i = 0; i < kIter; ++i) {
+    folly::BenchmarkSuspender createSuspender;
+    auto target = BaseVector::create(source->type(), kSize / 2, pool.get());
+    createSuspender.dismiss();
+    target->copyRanges(source.get(), {std::begin(ranges), std::end(ranges)});
+  }
+  return kIter * kSize / 2;
+}
+
 } // namespace
 } // namespace facebook::velox
 
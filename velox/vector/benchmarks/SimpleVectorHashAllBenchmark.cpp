@@ -17,6 +17,7 @@
 #include <folly/Benchmark.h>
 #include <folly/init/Init.h>
 
+#include "velox/common/base/HashKernels.h"
 #include "velox/vector/SimpleVector.h"
 #include "velox/vector/tests/VectorTestUtils.h"
 #include "velox/vector/tests/utils/VectorMaker.h"
@@ -156,6 +157,135 @@ void BM_Constant_hashAll(uint32_t iterations, size_t numRows) {
   vectorBenchmark<int64_t>(
       iterations, numRows, 1, false, VectorEncoding::Simple::CONSTANT);
 }
+
+// Flat buffers for the hashing::hashFlat() kernels shared by VectorHasher,
+// PrestoHasher and the Spark hash functions. Every 'nullEvery'th row is null
+// if 'nullEvery' is not 0.
+template <typename T>
+struct FlatColumn {
+  std::vector<T> values;
+  std::vector<uint64_t> nulls;
+  std::vector<uint64_t> hashes;
+
+  FlatColumn(size_t numRows, int32_t nullEvery)
+      : values(numRows),
+        nulls(bits::nwords(numRows), bits::kNotNull64),
+        hashes(numRows) {
+    for (size_t i = 0; i < numRows; ++i) {
+      values[i] = static_cast<T>(i * 0x9E3779B97F4A7C15UL);
+      if (nullEvery != 0 && i % nullEvery == 0) {
+        bits::setNull(nulls.data(), i);
+      }
+    }
+  }
+
+  const uint64_t* rawNulls(int32_t nullEvery) const {
+    return nullEvery == 0 ? nullptr : nulls.data();
+  }
+};
+
+// Per-row hashing with null checks, as VectorHasher did for flat vectors.
+void BM_Flat_rowByRow_hash(
+    uint32_t iterations,
+    size_t numRows,
+    int32_t nullEvery) {
+  folly::BenchmarkSuspender suspender;
+  FlatColumn<int64_t> column(numRows, nullEvery);
+  const auto* nulls = column.rawNulls(nullEvery);
+  suspender.dismiss();
+
+  for (size_t k = 0; k < iterations; ++k) {
+    for (size_t row = 0; row < numRows; ++row) {
+      auto hash = nulls && bits::isBitNull(nulls, row)
+          ? 0
+          : folly::hasher<int64_t>()(column.values[row]);
+      column.hashes[row] = bits::hashMix(column.hashes[row], hash);
+    }
+    folly::doNotOptimizeAway(column.hashes);
+  }
+}
+
+void BM_Flat_hashFlat_hash(
+    uint32_t iterations,
+    size_t numRows,
+    int32_t nullEvery) {
+  folly::BenchmarkSuspender suspender;
+  FlatColumn<int64_t> column(numRows, nullEvery);
+  const auto* nulls = column.rawNulls(nullEvery);
+  suspender.dismiss();
+
+  for (size_t k = 0; k < iterations; ++k) {
+    hashing::hashFlat(
+        column.values.data(),
+        nulls,
+        nullptr,
+        0,
+        numRows,
+        column.hashes.data(),
+        [](int64_t value, uint64_t hash) {
+          return bits::hashMix(hash, folly::hasher<int64_t>()(value));
+        },
+        [](uint64_t hash) { return bits::hashMix(hash, 0); });
+    folly::doNotOptimizeAway(column.hashes);
+  }
+}
+
+void BM_Murmur3_int32_scalar(uint32_t iterations, size_t numRows) {
+  folly::BenchmarkSuspender suspender;
+  FlatColumn<int32_t> column(numRows, 0);
+  std::vector<uint32_t> hashes(numRows, 42);
+  suspender.dismiss();
+
+  for (size_t k = 0; k < iterations; ++k) {
+    hashing::hashFlat(
+        column.values.data(),
+        nullptr,
+        nullptr,
+        0,
+        numRows,
+        hashes.data(),
+        [](int32_t value, uint32_t seed) {
+          return hashing::Murmur3_32::hashInt32(value, seed);
+        },
+        [](uint32_t seed) { return seed; });
+    folly::doNotOptimizeAway(hashes);
+  }
+}
+
+void BM_Murmur3_int32_simd(uint32_t iterations, size_t numRows) {
+  folly::BenchmarkSuspender suspender;
+  FlatColumn<int32_t> column(numRows, 0);
+  std::vector<uint32_t> hashes(numRows, 42);
+  suspender.dismiss();
+
+  for (size_t k = 0; k < iterations; ++k) {
+    hashing::Murmur3_32::hashInt32Values(
+        column.values.data(), numRows, hashes.data());
+    folly::doNotOptimizeAway(hashes);
+  }
+}
+
+void BM_XxHash64_int64(uint32_t iterations, size_t numRows) {
+  folly::BenchmarkSuspender suspender;
+  FlatColumn<int64_t> column(numRows, 0);
+  std::vector<uint64_t> hashes(numRows, 42);
+  suspender.dismiss();
+
+  for (size_t k = 0; k < iterations; ++k) {
+    hashing::hashFlat(
+        column.values.data(),
+        nullptr,
+        nullptr,
+        0,
+        numRows,
+        hashes.data(),
+        [](int64_t value, uint64_t seed) {
+          return hashing::XxHash64::hashInt64(value, seed);
+        },
+        [](uint64_t seed) { return seed; });
+    folly::doNotOptimizeAway(hashes);
+  }
+}
 } // namespace
 
 // 100k rows===============
@@ -464,6 +594,32 @@ BENCHMARK_RELATIVE_NAMED_PARAM(
     2000000);
 BENCHMARK_DRAW_LINE();
 
+// Flat buffer hashing kernels===============
+BENCHMARK_NAMED_PARAM(BM_Flat_rowByRow_hash, 100k_rows_no_nulls, 100000, 0);
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    BM_Flat_hashFlat_hash,
+    100k_rows_no_nulls,
+    100000,
+    0);
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM(
+    BM_Flat_rowByRow_hash,
+    100k_rows_10pct_nulls,
+    100000,
+    10);
+BENCHMARK_RELATIVE_NAMED_PARAM(
+    BM_Flat_hashFlat_hash,
+    100k_rows_10pct_nulls,
+    100000,
+    10);
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK_NAMED_PARAM(BM_Murmur3_int32_scalar, 100k_rows, 100000);
+BENCHMARK_RELATIVE_NAMED_PARAM(BM_Murmur3_int32_simd, 100k_rows, 100000);
+BENCHMARK_RELATIVE_NAMED_PARAM(BM_XxHash64_int64, 100k_rows, 100000);
+BENCHMARK_DRAW_LINE();
+
 } // namespace facebook::velox::test
 
 int main(int argc, char** argv) {
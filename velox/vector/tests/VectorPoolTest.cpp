@@ -146,4 +146,58 @@ TEST_F(VectorPoolTest, customTypes) {
   ASSERT_EQ(1'000, vector->size());
   ASSERT_TRUE(isJsonType(vector->type()));
 }
+TEST_F(VectorPoolTest, complexTypes) {
+  VectorPool vectorPool(pool());
+  auto rowType = ROW({"a", "b"}, {BIGINT(), ARRAY(VARCHAR())});
+
+  // Nothing is cached for a type before a vector of the type is released.
+  auto vector = vectorPool.get(rowType, 1'000);
+  ASSERT_EQ(1'000, vector->size());
+  auto* child = vector->as<RowVector>()->childAt(1).get();
+  ASSERT_EQ(1, vectorPool.stats().numGets);
+  ASSERT_EQ(0, vectorPool.stats().numReused);
+
+  // The row vector and its children are recycled.
+  auto* rawVector = vector.get();
+  ASSERT_TRUE(vectorPool.release(vector));
+  ASSERT_EQ(vector, nullptr);
+  vector = vectorPool.get(rowType, 500);
+  ASSERT_EQ(rawVector, vector.get());
+  ASSERT_EQ(500, vector->size());
+  ASSERT_EQ(child, vector->as<RowVector>()->childAt(1).get());
+  for (auto& rowChild : vector->as<RowVector>()->children()) {
+    ASSERT_EQ(500, rowChild->size());
+  }
+  ASSERT_EQ(2, vectorPool.stats().numGets);
+  ASSERT_EQ(1, vectorPool.stats().numReused);
+  ASSERT_EQ(1, vectorPool.stats().numReleased);
+
+  // Arrays and maps come back empty.
+  auto array = makeArrayVector<int64_t>(
+      100, [](auto row) { return row % 5; }, [](auto row) { return row; });
+  auto* rawArray = array.get();
+  auto arrayType = array->type();
+  ASSERT_TRUE(vectorPool.release(array));
+  array = vectorPool.get(arrayType, 100);
+  ASSERT_EQ(rawArray, array.get());
+  for (auto i = 0; i < array->size(); ++i) {
+    ASSERT_EQ(0, array->as<ArrayVector>()->sizeAt(i));
+  }
+  ASSERT_EQ(0, array->as<ArrayVector>()->elements()->size());
+
+  auto map = makeMapVector<int32_t, int32_t>(
+      10,
+      [](auto row) { return row; },
+      [](auto row) { return row; },
+      [](auto row) { return row; });
+  auto mapType = map->type();
+  ASSERT_TRUE(vectorPool.release(map));
+  ASSERT_EQ(0, vectorPool.get(mapType, 10)->as<MapVector>()->sizeAt(9));
+
+  // A vector with shared children is not recycled.
+  auto elements = makeFlatVector<int64_t>({1, 2, 3});
+  array = makeArrayVector({0, 1}, elements);
+  ASSERT_FALSE(vectorPool.release(array));
+  ASSERT_NE(array, nullptr);
+}
 } // namespace facebook::velox::test
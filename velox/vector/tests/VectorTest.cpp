@@ -1120,6 +1120,57 @@ TEST_F(VectorTest, copyToAllNullsFlatVector) {
   }
 }
 
+TEST_F(VectorTest, copyRangesFromDictionary) {
+  const vector_size_t size = 1'000;
+  auto test = [&](const VectorPtr& base) {
+    auto indices = makeIndices(size, [](auto row) { return (row * 7) % size; });
+    auto wrapNulls = makeNulls(size, [](auto row) { return row % 11 == 0; });
+    for (const auto& nulls : {BufferPtr(nullptr), wrapNulls}) {
+      auto source = BaseVector::wrapInDictionary(nulls, indices, size, base);
+      auto target = BaseVector::create(base->type(), size, pool());
+      std::vector<BaseVector::CopyRange> ranges = {
+          {0, 0, 17}, {100, 17, 300}, {500, 317, 500}};
+      target->copyRanges(source.get(), ranges);
+      for (const auto& range : ranges) {
+        for (auto i = 0; i < range.count; ++i) {
+          ASSERT_TRUE(target->equalValueAt(
+              source.get(), range.targetIndex + i, range.sourceIndex + i))
+              << "at " << range.targetIndex + i;
+        }
+      }
+    }
+  };
+
+  test(makeFlatVector<int64_t>(size, folly::identity));
+  test(makeFlatVector<double>(
+      size, [](auto row) { return row * 0.5; }, nullEvery(5)));
+  test(makeFlatVector<int16_t>(
+      size, [](auto row) { return row; }, nullEvery(3)));
+  test(makeFlatVector<StringView>(
+      size,
+      [](auto row) { return StringView(std::string(row % 20, 'x')); },
+      nullEvery(7)));
+}
+
+TEST_F(VectorTest, copyRangesFromFlatArray) {
+  auto source = makeArrayVector<int32_t>(
+      100,
+      [](auto row) { return row % 5; },
+      [](auto row) { return row; },
+      nullEvery(3));
+  auto target = BaseVector::create(source->type(), 60, pool());
+  std::vector<BaseVector::CopyRange> ranges = {
+      {0, 0, 10}, {20, 10, 30}, {90, 40, 10}, {55, 50, 10}};
+  target->copyRanges(source.get(), ranges);
+  for (const auto& range : ranges) {
+    for (auto i = 0; i < range.count; ++i) {
+      ASSERT_TRUE(target->equalValueAt(
+          source.get(), range.targetIndex + i, range.sourceIndex + i))
+          << "at " << range.targetIndex + i;
+    }
+  }
+}
+
 TEST_F(VectorTest, wrapInConstant) {
   // wrap flat vector
   const vector_size_t size = 1'000;